@@ -192,6 +192,9 @@ class BuildExt(setuptools.command.build_ext.build_ext):
     #: Preferred BOOST root
     BOOST_ROOT: ClassVar[Optional[str]] = None
 
+    #: Build the benchmarks of the C++ extension
+    BUILD_BENCHMARKS: ClassVar[Optional[bool]] = None
+
     #: Build the unit tests of the C++ extension
     BUILD_INITTESTS: ClassVar[Optional[bool]] = None
 
@@ -375,6 +378,9 @@ class BuildExt(setuptools.command.build_ext.build_ext):
             str(extdir), "-DPYTHON_EXECUTABLE=" + sys.executable
         ] + self.set_cmake_user_options()
 
+        if self.BUILD_BENCHMARKS:
+            cmake_args.append("-DBUILD_BENCHMARKS=ON")
+
         build_args = ['--config', cfg]
 
         is_windows = platform.system() == "Windows"
@@ -419,7 +425,7 @@ class BuildExt(setuptools.command.build_ext.build_ext):
             self.spawn(['cmake', str(WORKING_DIRECTORY)] + cmake_args)
         if not self.dry_run:  # type: ignore
             cmake_cmd = ['cmake', '--build', '.']
-            if self.BUILD_INITTESTS is None:
+            if self.BUILD_INITTESTS is None and self.BUILD_BENCHMARKS is None:
                 cmake_cmd += ['--target', 'core']
             self.spawn(cmake_cmd + build_args)
         os.chdir(str(WORKING_DIRECTORY))
@@ -430,6 +436,8 @@ class Build(distutils.command.build.build):
     user_options = distutils.command.build.build.user_options
     user_options += [
         ('boost-root=', None, 'Preferred Boost installation prefix'),
+        ('build-benchmarks', None,
+         "Build the benchmarks of the C++ extension"),
         ('build-unittests', None, "Build the unit tests of the C++ extension"),
         ('conda-forge', None, "Generation of the conda-forge package"),
         ('code-coverage', None, 'Enable coverage reporting'),
@@ -451,6 +459,7 @@ class Build(distutils.command.build.build):
         """Set default values for all the options that this command supports"""
         super().initialize_options()
         self.boost_root = None
+        self.build_benchmarks = None
         self.build_unittests = None
         self.conda_forge = None
         self.code_coverage = None
@@ -478,6 +487,8 @@ class Build(distutils.command.build.build):
         """A command's raison d'etre: carry out the action"""
         if self.boost_root is not None:
             BuildExt.BOOST_ROOT = self.boost_root
+        if self.build_benchmarks is not None:
+            BuildExt.BUILD_BENCHMARKS = self.build_benchmarks
         if self.build_unittests is not None:
             BuildExt.BUILD_INITTESTS = self.build_unittests
         if self.code_coverage is not None:
@@ -2,20 +2,91 @@
 #
 # All rights reserved. Use of this source code is governed by a
 # BSD-style license that can be found in the LICENSE file.
-from . import geodetic
-from . import geohash
+import importlib
+import sys
+from typing import TYPE_CHECKING, Any, List
+
 from . import version
-from ._geohash import GeoHash
-from .binning import Binning2D
 from .core import Axis, TemporalAxis, dateutils
-from .grid import Grid2D, Grid3D, Grid4D
-from .histogram2d import Histogram2D
-from .interpolator.bicubic import bicubic
-from .interpolator.bivariate import bivariate
-from .interpolator.quadrivariate import quadrivariate
-from .interpolator.trivariate import trivariate
-from .rtree import RTree
-from .statistics import DescriptiveStatistics, StreamingHistogram
+from .threads import (available_cpus, get_num_threads, num_threads,
+                      set_num_threads)
+
+#: Attributes of the package, imported from their module on first access:
+#: importing the package only loads the classes and functions of the library
+#: used.
+_LAZY_ATTRIBUTES = {
+    "geodetic": ".geodetic",
+    "geohash": ".geohash",
+    "GeoHash": "._geohash",
+    "bicubic_async": ".asynchronous",
+    "bivariate_async": ".asynchronous",
+    "quadrivariate_async": ".asynchronous",
+    "trivariate_async": ".asynchronous",
+    "Binning2D": ".binning",
+    "Binning3D": ".binning",
+    "ChunkedGrid3D": ".grid",
+    "ChunkedGrid4D": ".grid",
+    "Grid2D": ".grid",
+    "Grid3D": ".grid",
+    "Grid4D": ".grid",
+    "Histogram2D": ".histogram2d",
+    "bicubic": ".interpolator.bicubic",
+    "precompute_bicubic": ".interpolator.bicubic",
+    "bivariate": ".interpolator.bivariate",
+    "bivariate_plan": ".interpolator.bivariate",
+    "prepare_bivariate": ".interpolator.bivariate",
+    "quadrivariate": ".interpolator.quadrivariate",
+    "regridding_plan": ".interpolator.regridding",
+    "trivariate": ".interpolator.trivariate",
+    "Pipeline": ".pipeline",
+    "RTree": ".rtree",
+    "ShardedRTree": ".rtree",
+    "TemporalRTree": ".rtree",
+    "DescriptiveStatistics": ".statistics",
+    "StreamingHistogram": ".statistics",
+}
+
+
+def _import_attribute(name: str) -> Any:
+    """Import an attribute of the package from its module."""
+    module = importlib.import_module(_LAZY_ATTRIBUTES[name], __name__)
+    # The submodules are set as attributes of the package by their import.
+    value = module if name == module.__name__.rpartition(".")[2] else getattr(
+        module, name)
+    globals()[name] = value
+    return value
+
+
+if TYPE_CHECKING or sys.version_info < (3, 7):
+    # The attributes of a module can be imported on demand from Python 3.7
+    # (PEP 562).
+    from . import geodetic, geohash
+    from ._geohash import GeoHash
+    from .asynchronous import (bicubic_async, bivariate_async,
+                               quadrivariate_async, trivariate_async)
+    from .binning import Binning2D, Binning3D
+    from .grid import ChunkedGrid3D, ChunkedGrid4D, Grid2D, Grid3D, Grid4D
+    from .histogram2d import Histogram2D
+    from .interpolator.bicubic import bicubic, precompute_bicubic
+    from .interpolator.bivariate import (bivariate, bivariate_plan,
+                                         prepare_bivariate)
+    from .interpolator.quadrivariate import quadrivariate
+    from .interpolator.regridding import regridding_plan
+    from .interpolator.trivariate import trivariate
+    from .pipeline import Pipeline
+    from .rtree import RTree, ShardedRTree, TemporalRTree
+    from .statistics import DescriptiveStatistics, StreamingHistogram
+else:
+
+    def __getattr__(name: str) -> Any:
+        if name not in _LAZY_ATTRIBUTES:
+            raise AttributeError(
+                f"module {__name__!r} has no attribute {name!r}")
+        return _import_attribute(name)
+
+    def __dir__() -> List[str]:
+        return sorted(set(globals()) | set(_LAZY_ATTRIBUTES))
+
 
 __version__ = version.release()
 __date__ = version.date()
@@ -0,0 +1,119 @@
+# Copyright (c) 2022 CNES
+#
+# All rights reserved. Use of this source code is governed by a
+# BSD-style license that can be found in the LICENSE file.
+"""
+Asynchronous calls
+------------------
+"""
+from typing import Any, Callable, Optional
+import concurrent.futures
+import threading
+from .interpolator.bicubic import bicubic
+from .interpolator.bivariate import bivariate
+from .interpolator.quadrivariate import quadrivariate
+from .interpolator.trivariate import trivariate
+
+#: Executor running the calls submitted without an executor.
+_EXECUTOR: Optional[concurrent.futures.ThreadPoolExecutor] = None
+
+#: Lock protecting the creation of the executor.
+_LOCK = threading.Lock()
+
+
+def _default_executor() -> concurrent.futures.Executor:
+    """Gets the executor running the calls submitted without an executor."""
+    global _EXECUTOR  # pylint: disable=global-statement
+    with _LOCK:
+        if _EXECUTOR is None:
+            _EXECUTOR = concurrent.futures.ThreadPoolExecutor(
+                max_workers=1, thread_name_prefix="pyinterp")
+        return _EXECUTOR
+
+
+def submit(function: Callable[..., Any],
+           *args,
+           executor: Optional[concurrent.futures.Executor] = None,
+           **kwargs) -> concurrent.futures.Future:
+    """Calls a function of the library in the background.
+
+    The computations of the library run without the GIL: while they run, the
+    calling thread can read the next batch of data, and the threads of the
+    library use all the CPUs. The arguments are referenced by the future
+    until it completes: the arrays passed, and the output buffer given by
+    ``out``, must not be modified in the meantime.
+
+    A coroutine awaits the result with ``await asyncio.wrap_future(future)``.
+
+    Args:
+        function (callable): Function called.
+        *args: Positional arguments of the function.
+        executor (concurrent.futures.Executor, optional): Executor running the
+            call. Defaults to a background thread shared by the calls of the
+            library, which run one after the other, each one using the
+            threads set by :py:func:`pyinterp.set_num_threads`.
+        **kwargs: Keyword arguments of the function.
+    Returns:
+        concurrent.futures.Future: The future completing with the result of
+        the function.
+
+    Example:
+        >>> future = pyinterp.asynchronous.submit(tree.query, coordinates)
+        >>> chunk = read_next_chunk()
+        >>> distances, values = future.result()
+    """
+    if executor is None:
+        executor = _default_executor()
+    return executor.submit(function, *args, **kwargs)
+
+
+def bicubic_async(*args,
+                  executor: Optional[concurrent.futures.Executor] = None,
+                  **kwargs) -> concurrent.futures.Future:
+    """Calls :py:func:`pyinterp.bicubic` in the background (see
+    :py:func:`submit`).
+
+    Returns:
+        concurrent.futures.Future: The future completing with the values
+        interpolated.
+    """
+    return submit(bicubic, *args, executor=executor, **kwargs)
+
+
+def bivariate_async(*args,
+                    executor: Optional[concurrent.futures.Executor] = None,
+                    **kwargs) -> concurrent.futures.Future:
+    """Calls :py:func:`pyinterp.bivariate` in the background (see
+    :py:func:`submit`).
+
+    Returns:
+        concurrent.futures.Future: The future completing with the values
+        interpolated.
+    """
+    return submit(bivariate, *args, executor=executor, **kwargs)
+
+
+def quadrivariate_async(*args,
+                        executor: Optional[concurrent.futures.Executor] = None,
+                        **kwargs) -> concurrent.futures.Future:
+    """Calls :py:func:`pyinterp.quadrivariate` in the background (see
+    :py:func:`submit`).
+
+    Returns:
+        concurrent.futures.Future: The future completing with the values
+        interpolated.
+    """
+    return submit(quadrivariate, *args, executor=executor, **kwargs)
+
+
+def trivariate_async(*args,
+                     executor: Optional[concurrent.futures.Executor] = None,
+                     **kwargs) -> concurrent.futures.Future:
+    """Calls :py:func:`pyinterp.trivariate` in the background (see
+    :py:func:`submit`).
+
+    Returns:
+        concurrent.futures.Future: The future completing with the values
+        interpolated.
+    """
+    return submit(trivariate, *args, executor=executor, **kwargs)
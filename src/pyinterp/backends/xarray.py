@@ -8,7 +8,8 @@ XArray
 
 Build interpolation objects from xarray.DataArray instances
 """
-from typing import Dict, Optional, Tuple, Union
+from typing import Any, Dict, Optional, Tuple, Union
+import dask
 import numpy as np
 import xarray as xr
 from .. import cf
@@ -147,6 +148,20 @@ def _coords(
     return tuple(coords[dim] for dim in dims)
 
 
+def _dates_to_cast(
+    mesh: grid.Grid3D, datetime64: Optional[Tuple[str, core.TemporalAxis]]
+) -> Optional[Tuple[str, core.TemporalAxis]]:
+    """Get the time axis used to convert the dates provided to the trivariate
+    and quadrivariate interpolations.
+
+    The core library converts the dates itself when they are read, without
+    copying them, if the Z-axis of the grid is a time axis.
+    """
+    if datetime64 is not None and isinstance(mesh.z, core.TemporalAxis):
+        return None
+    return datetime64
+
+
 class Grid2D(grid.Grid2D):
     """Builds a Grid2D from the Xarray data provided.
     """
@@ -301,7 +316,9 @@ class Grid3D(grid.Grid3D):
             np.ndarray: the interpolated values
         """
         return interpolator.trivariate(
-            self, *_coords(coords, self._dims, self._datetime64), *args,
+            self,
+            *_coords(coords, self._dims,
+                     _dates_to_cast(self, self._datetime64)), *args,
             **kwargs)
 
     def bicubic(self, coords: dict, *args, **kwargs) -> np.ndarray:
@@ -408,7 +425,9 @@ class Grid4D(grid.Grid4D):
             np.ndarray: the interpolated values
         """
         return interpolator.quadrivariate(
-            self, *_coords(coords, self._dims, self._datetime64), *args,
+            self,
+            *_coords(coords, self._dims,
+                     _dates_to_cast(self, self._datetime64)), *args,
             **kwargs)
 
     def bicubic(self, coords: dict, *args, **kwargs) -> np.ndarray:
@@ -430,6 +449,127 @@ class Grid4D(grid.Grid4D):
             **kwargs)
 
 
+def _interpolate_block(block: xr.DataArray, coords: Dict, **kwargs: Any
+                       ) -> np.ndarray:
+    """Interpolates the points located in a block of a data array."""
+    increasing_axes = kwargs.pop("increasing_axes")
+    geodetic = kwargs.pop("geodetic")
+    return RegularGridInterpolator(block,
+                                   increasing_axes=increasing_axes,
+                                   geodetic=geodetic)(coords, **kwargs)
+
+
+class _BlockInterpolator:
+    """Interpolates a data array backed by dask block by block, without
+    loading the whole array into memory.
+
+    The points to interpolate are routed to the chunks holding their nearest
+    grid nodes. Each chunk is read with the halo of cells required by the
+    interpolation method, and its points are interpolated by the library in
+    a task of the dask scheduler: only the blocks processed by the running
+    tasks are held in memory.
+    """
+    def __init__(self, array: xr.DataArray, increasing_axes: bool,
+                 geodetic: bool):
+        self._array = array
+        self._increasing_axes = increasing_axes
+        self._geodetic = geodetic
+        self._xy = _dims_from_data_array(array, geodetic, ndims=array.ndim)
+        chunks = array.chunks or tuple((size, ) for size in array.shape)
+        #: Indexes of the first node of each chunk, and the size of the axis.
+        self._bounds = {
+            dim: np.cumsum((0, ) + tuple(item))
+            for dim, item in zip(array.dims, chunks)
+        }
+        #: Axes locating the nearest nodes of the points.
+        self._axes = {}
+        for dim in array.dims:
+            values = array.coords[dim].values
+            if "datetime64" in values.dtype.name or \
+                    "timedelta64" in values.dtype.name:
+                self._axes[dim] = core.TemporalAxis(values)
+            else:
+                self._axes[dim] = core.Axis(values,
+                                            is_circle=geodetic
+                                            and dim == self._xy[0])
+
+    def _halo(self, method: str, bicubic_kwargs: Dict) -> Dict[str, int]:
+        """Gets the number of cells read around the chunks."""
+        halo = dict.fromkeys(self._array.dims, 1)
+        if method == "bicubic":
+            x, y = self._xy
+            halo[x] = bicubic_kwargs.get("nx", 3)
+            halo[y] = bicubic_kwargs.get("ny", 3)
+            fill_holes = bicubic_kwargs.get("fill_holes")
+            if fill_holes is not None:
+                halo[x] += fill_holes[0]
+                halo[y] += fill_holes[1]
+        return halo
+
+    def _indexer(self, dim: str, chunk: int,
+                 halo: int) -> Union[slice, np.ndarray]:
+        """Gets the indexes of the nodes of a chunk extended by its halo."""
+        bounds = self._bounds[dim]
+        size = bounds[-1]
+        start = bounds[chunk] - halo
+        stop = bounds[chunk + 1] + halo
+        axis = self._axes[dim]
+        if isinstance(axis, core.Axis) and axis.is_circle and (start < 0 or
+                                                               stop > size):
+            if stop - start >= size:
+                return slice(None)
+            # The halo of a chunk located at the end of a circle wraps
+            # around the axis.
+            return np.arange(start, stop) % size
+        return slice(max(start, 0), min(stop, size))
+
+    def __call__(self, coords: Dict, method: str, bicubic_kwargs: Dict,
+                 **kwargs: Any) -> np.ndarray:
+        dims = self._array.dims
+        values = [np.asarray(item) for item in _coords(coords, dims)]
+        shape = values[0].shape
+        values = [item.ravel() for item in values]
+        size = values[0].size
+
+        # Number of the chunk holding the nearest node of each point.
+        key = np.zeros(size, dtype=np.int64)
+        for dim, item in zip(dims, values):
+            bounds = self._bounds[dim]
+            index = self._axes[dim].find_index(item, bounded=True)
+            key *= len(bounds) - 1
+            key += np.searchsorted(bounds, index, side="right") - 1
+
+        order = np.argsort(key, kind="stable")
+        keys, first = np.unique(key[order], return_index=True)
+        last = np.append(first[1:], size)
+        halo = self._halo(method, bicubic_kwargs)
+        tasks = []
+        for number, start, stop in zip(keys, first, last):
+            chunk = np.unravel_index(
+                number, tuple(len(self._bounds[dim]) - 1 for dim in dims))
+            block = self._array.isel({
+                dim: self._indexer(dim, int(ix), halo[dim])
+                for dim, ix in zip(dims, chunk)
+            })
+            selected = order[start:stop]
+            tasks.append(
+                dask.delayed(_interpolate_block)(
+                    block,
+                    {dim: item[selected]
+                     for dim, item in zip(dims, values)},
+                    method=method,
+                    bicubic_kwargs=bicubic_kwargs,
+                    increasing_axes=self._increasing_axes,
+                    geodetic=self._geodetic,
+                    **kwargs))
+
+        result = np.empty(size)
+        for start, stop, interpolated in zip(first, last,
+                                             dask.compute(*tasks)):
+            result[order[start:stop]] = interpolated
+        return result.reshape(shape)
+
+
 class RegularGridInterpolator:
     """Interpolation on a regular grid in arbitrary dimensions
 
@@ -440,7 +580,8 @@ class RegularGridInterpolator:
     def __init__(self,
                  array: xr.DataArray,
                  increasing_axes: bool = True,
-                 geodetic: bool = True):
+                 geodetic: bool = True,
+                 chunked: bool = False):
         """Initialize a new RegularGridInterpolator.
 
         Args:
@@ -466,13 +607,34 @@ class RegularGridInterpolator:
 
                 If this option is false, the axes will be considered Cartesian.
                 Default to ``True``.
+            chunked (bool, optional): If true, the array is not loaded into
+                memory: the points are interpolated chunk by chunk, each
+                chunk of the dask array being read with the halo of cells
+                required by the interpolation method. Default to ``False``.
 
         Raises:
             ValueError: if the provided data array doesn't define a
                 longitude/latitude axis if ``geodetic`` is True
             NotImplementedError: if the number of dimensions in the array is
                 less than 2 or more than 4.
+
+        .. note::
+
+            In chunked mode, the points are grouped by chunk, and the points
+            of each chunk are interpolated in a task of the dask scheduler,
+            which loads the chunk and its halo. The memory used is then
+            bounded by the size of the chunks read by the tasks running
+            concurrently, whatever the size of the array.
         """
+        self._array = array
+        self._blocks = None
+        if chunked:
+            if not 2 <= len(array.shape) <= 4:
+                raise NotImplementedError(
+                    "Only the 2D, 3D or 4D grids can be interpolated.")
+            self._blocks = _BlockInterpolator(array, increasing_axes,
+                                              geodetic)
+            return
         if len(array.shape) == 2:
             self._grid = Grid2D(array,
                                 increasing_axes=increasing_axes,
@@ -499,7 +661,7 @@ class RegularGridInterpolator:
         Returns:
             int: Number of array dimensions
         """
-        return self._grid.array.ndim
+        return self._array.ndim
 
     @property
     def grid(self) -> Union[Grid2D, Grid3D, Grid4D]:
@@ -507,7 +669,13 @@ class RegularGridInterpolator:
 
         Returns:
             Grid2D, Grid3D, Grid4D: the regular grid
+
+        Raises:
+            AttributeError: if the interpolator is chunked.
         """
+        if self._blocks is not None:
+            raise AttributeError("the grid of a chunked interpolator is read "
+                                 "on demand")
         return self._grid
 
     def __call__(self,
@@ -540,6 +708,12 @@ class RegularGridInterpolator:
         Returns:
             numpy.ndarray: New array on the new coordinates.
         """
+        if self._blocks is not None:
+            return self._blocks(coords,
+                                method,
+                                bicubic_kwargs or dict(),
+                                bounds_error=bounds_error,
+                                num_threads=num_threads)
         if method == 'bicubic':
             bicubic_kwargs = bicubic_kwargs or dict()
             return self._grid.bicubic(coords,
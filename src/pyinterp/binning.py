@@ -13,6 +13,14 @@ import numpy as np
 from . import core
 from . import geodetic
 
+#: Prefix of the core classes calculating the given statistics.
+_STATISTICS = {
+    "count": "Count",
+    "mean": "Mean",
+    "variance": "Variance",
+    "full": "",
+}
+
 
 class Binning2D:
     """
@@ -23,7 +31,9 @@ class Binning2D:
                  x: core.Axis,
                  y: core.Axis,
                  wgs: Optional[geodetic.System] = None,
-                 dtype: Optional[np.dtype] = np.dtype("float64")):
+                 dtype: Optional[np.dtype] = np.dtype("float64"),
+                 sparse: bool = False,
+                 statistics: str = "full"):
         """
         Initializes the grid used to calculate the statistics.
 
@@ -38,6 +48,23 @@ class Binning2D:
                 considered as Cartesian coordinates. Otherwise, ``x`` and ``y``
                 are considered to represents the longitudes and latitudes.
             dtype (numpy.dtype, optional): Data type of the instance to create.
+            sparse (bool, optional): If true, only the bins holding values are
+                stored, which saves memory when most of the bins of the grid
+                stay empty, for example for a global grid of very high
+                resolution. The statistics are still returned as dense
+                arrays. Defaults to ``False``.
+            statistics (str, optional): Statistics calculated in each bin:
+
+                    * ``count`` : the count and the sum of weights.
+                    * ``mean`` : the statistics above, the mean, the
+                      minimum, the maximum and the sum.
+                    * ``variance`` : the statistics above and the variance.
+                    * ``full`` : all the statistics, including the skewness
+                      and the kurtosis.
+
+                The bins of the lower levels use less memory and are updated
+                faster. The statistics not calculated are NaN. Defaults to
+                ``full``.
 
         .. note ::
 
@@ -52,12 +79,16 @@ class Binning2D:
             defined, the coordinates of the axes must be shifted by half a grid
             step, 0.5 in this example.
         """
+        if statistics not in _STATISTICS:
+            raise ValueError(f"statistics {statistics!r} is not handled")
+        prefix = _STATISTICS[statistics]
         if dtype == np.dtype("float64"):
-            self._instance = core.Binning2DFloat64(x, y, wgs)
+            instance = getattr(core, f"Binning2D{prefix}Float64")
         elif dtype == np.dtype("float32"):
-            self._instance = core.Binning2DFloat32(x, y, wgs)
+            instance = getattr(core, f"Binning2D{prefix}Float32")
         else:
             raise ValueError(f"dtype {dtype} not handled by the object")
+        self._instance = instance(x, y, wgs, sparse)
         self.dtype = dtype
 
     @property
@@ -75,6 +106,20 @@ class Binning2D:
         """Gets the geodetic system handled of the grid"""
         return self._instance.wgs
 
+    @property
+    def sparse(self) -> bool:
+        """True if only the bins holding values are stored"""
+        return self._instance.sparse
+
+    @property
+    def statistics(self) -> str:
+        """Gets the statistics calculated in each bin"""
+        name = type(self._instance).__name__
+        for key, prefix in _STATISTICS.items():
+            if prefix and name.startswith(f"Binning2D{prefix}"):
+                return key
+        return "full"
+
     def clear(self) -> None:
         """Clears the data inside each bin."""
         self._instance.clear()
@@ -102,7 +147,8 @@ class Binning2D:
              x: np.ndarray,
              y: np.ndarray,
              z: np.ndarray,
-             simple: bool = True) -> None:
+             simple: bool = True,
+             num_threads: int = 0) -> None:
         """Push new samples into the defined bins.
 
         Args:
@@ -113,6 +159,12 @@ class Binning2D:
             simple (bool, optional): If true, a simple binning 2D is used
                 otherwise a linear binning 2d is applied. See the full
                 description of the algorithm below.
+            num_threads (int, optional): The number of threads to use for the
+                computation. The samples are split between the threads, each
+                thread computing its own statistics, merged at the end. If 0
+                all CPUs are used. If 1 is given, no parallel computing code
+                is used at all, which is useful for debugging. Defaults to
+                ``0``.
 
         .. _bilinear_binning:
 
@@ -150,7 +202,59 @@ class Binning2D:
         x = np.asarray(x).ravel()
         y = np.asarray(y).ravel()
         z = np.asarray(z).ravel()
-        self._instance.push(x, y, z, simple)
+        self._instance.push(x, y, z, simple, num_threads)
+
+    def push_kernel(self,
+                    x: np.ndarray,
+                    y: np.ndarray,
+                    z: np.ndarray,
+                    radius: int = 1,
+                    wf: str = "gaussian",
+                    arg: Optional[float] = None,
+                    num_threads: int = 0) -> None:
+        """Push new samples into the defined bins, spreading each sample over
+        the bins surrounding its nearest bin.
+
+        The weight given to a bin is the product of the window function
+        evaluated for the distances, expressed in numbers of bins, between the
+        sample and the bin along each axis: the weights of the
+        :math:`(2r + 1)^2` bins covered are computed from two tables of
+        :math:`2r + 1` values. The window radius is :math:`r + \\frac{1}{2}`
+        bins. The geodetic system, if defined, is not used by this method.
+
+        Args:
+            x (numpy.ndarray): X coordinates of the samples
+            y (numpy.ndarray): Y coordinates of the samples
+            z (numpy.ndarray): New samples to push into the
+                defined bins.
+            radius (int, optional): The number of bins :math:`r` covered on
+                each side of the nearest bin. Defaults to ``1``.
+            wf (str, optional): The window function weighting the bins. See
+                :py:meth:`RTree.window_function
+                <pyinterp.RTree.window_function>` for the functions
+                available. Defaults to ``gaussian``, whose standard deviation
+                is :math:`\\frac{r}{2}` bins unless otherwise specified by
+                ``arg``.
+            arg (float, optional): The optional argument of the window
+                function.
+            num_threads (int, optional): The number of threads to use for the
+                computation. If 0 all CPUs are used. If 1 is given, no parallel
+                computing code is used at all, which is useful for debugging.
+                Defaults to ``0``.
+        """
+        if radius < 0:
+            raise ValueError("radius must be positive")
+        name = "".join(item.capitalize() for item in wf.split("_"))
+        if not hasattr(core.WindowFunction, name):
+            raise ValueError(f"Window function {wf!r} is not defined")
+        if arg is None:
+            arg = dict(lanczos=1, parzen=0).get(wf, 0)
+        x = np.asarray(x).ravel()
+        y = np.asarray(y).ravel()
+        z = np.asarray(z).ravel()
+        self._instance.push_kernel(x, y, z, getattr(core.WindowFunction,
+                                                    name), radius, arg,
+                                   num_threads)
 
     def push_delayed(self,
                      x: Union[np.ndarray, da.Array],
@@ -181,9 +285,14 @@ class Binning2D:
         y = da.asarray(y)
         z = da.asarray(z)
 
-        def _process_block(x, y, z, x_axis, y_axis, wgs, simple):
-            binning = Binning2D(x_axis, y_axis, wgs)
-            binning.push(x, y, z, simple)
+        def _process_block(x, y, z, x_axis, y_axis, wgs, simple, sparse,
+                           statistics):
+            binning = Binning2D(x_axis,
+                                y_axis,
+                                wgs,
+                                sparse=sparse,
+                                statistics=statistics)
+            binning.push(x, y, z, simple, num_threads=1)
             return np.array([binning], dtype="object")
 
         return da.map_blocks(_process_block,
@@ -194,6 +303,8 @@ class Binning2D:
                              self.y,
                              self.wgs,
                              simple,
+                             self.sparse,
+                             self.statistics,
                              dtype="object").sum()
 
     def variable(self, statistics: str = 'mean') -> np.ndarray:
@@ -228,3 +339,164 @@ class Binning2D:
         except AttributeError:
             raise ValueError(
                 f"The statistical variable {statistics} is unknown.")
+
+
+class Binning3D(Binning2D):
+    """
+    Group a number of more or less continuous values into a smaller number of
+    "bins" located on a 3D grid, whose third axis is, for example, a time
+    axis.
+    """
+    def __init__(self,
+                 x: core.Axis,
+                 y: core.Axis,
+                 z: Union[core.Axis, core.TemporalAxis],
+                 wgs: Optional[geodetic.System] = None,
+                 dtype: Optional[np.dtype] = np.dtype("float64"),
+                 sparse: bool = False):
+        """
+        Initializes the grid used to calculate the statistics.
+
+        Args:
+            x (pyinterp.Axis) : Definition of the bin centers for the X axis
+                of the grid.
+            y (pyinterp.Axis) : Definition of the bin centers for the Y axis
+                of the grid.
+            z (pyinterp.Axis, pyinterp.TemporalAxis) : Definition of the bin
+                centers for the Z axis of the grid.
+            wgs (pyinterp.geodetic.System, optional): WGS of the coordinate
+                system used to manipulate geographic coordinates. If this
+                parameter is not set, the handled coordinates will be
+                considered as Cartesian coordinates. Otherwise, ``x`` and ``y``
+                are considered to represents the longitudes and latitudes.
+            dtype (numpy.dtype, optional): Data type of the instance to create.
+            sparse (bool, optional): If true, only the bins holding values are
+                stored. Defaults to ``False``.
+
+        .. note ::
+
+            With a time axis, for example one date per month, the samples of
+            all the months are binned in a single pass, to compute monthly
+            climatologies.
+        """
+        prefix = "Temporal" if isinstance(z, core.TemporalAxis) else ""
+        if dtype == np.dtype("float64"):
+            instance = getattr(core, f"{prefix}Binning3DFloat64")
+        elif dtype == np.dtype("float32"):
+            instance = getattr(core, f"{prefix}Binning3DFloat32")
+        else:
+            raise ValueError(f"dtype {dtype} not handled by the object")
+        self._instance = instance(x, y, z, wgs, sparse)
+        self.dtype = dtype
+
+    @property
+    def z(self) -> Union[core.Axis, core.TemporalAxis]:
+        """Gets the bin centers for the Z Axis of the grid"""
+        return self._instance.z
+
+    def __repr__(self) -> str:
+        """Called by the ``repr()`` built-in function to compute the string
+        representation of this instance
+        """
+        result = [
+            "<%s.%s>" % (self.__class__.__module__, self.__class__.__name__)
+        ]
+        result.append("Axis:")
+        result.append(f"  x: {self._instance.x}")
+        result.append(f"  y: {self._instance.y}")
+        result.append(f"  z: {self._instance.z}")
+        return "\n".join(result)
+
+    def push(self,  # type: ignore
+             x: np.ndarray,
+             y: np.ndarray,
+             z: np.ndarray,
+             values: np.ndarray,
+             simple: bool = True,
+             num_threads: int = 0) -> None:
+        """Push new samples into the defined bins.
+
+        Each sample is spread over the X and Y axes, as done by
+        :py:meth:`Binning2D.push <pyinterp.Binning2D.push>`, in the nearest
+        bin of the Z axis.
+
+        Args:
+            x (numpy.ndarray): X coordinates of the samples
+            y (numpy.ndarray): Y coordinates of the samples
+            z (numpy.ndarray): Z coordinates of the samples. With a time
+                axis, the dates are converted to the resolution of the axis.
+            values (numpy.ndarray): New samples to push into the defined bins.
+            simple (bool, optional): If true, a simple binning 2D is used
+                otherwise a linear binning 2d is applied.
+            num_threads (int, optional): The number of threads to use for the
+                computation. If 0 all CPUs are used. If 1 is given, no parallel
+                computing code is used at all, which is useful for debugging.
+                Defaults to ``0``.
+        """
+        x = np.asarray(x).ravel()
+        y = np.asarray(y).ravel()
+        z = np.asarray(z).ravel()
+        values = np.asarray(values).ravel()
+        self._instance.push(x, y, z, values, simple, num_threads)
+
+    def push_kernel(self, *args, **kwargs) -> None:  # type: ignore
+        """The kernel binning is only available in two dimensions."""
+        raise NotImplementedError(
+            "the kernel binning is not supported by Binning3D")
+
+    def push_delayed(  # type: ignore
+            self,
+            x: Union[np.ndarray, da.Array],
+            y: Union[np.ndarray, da.Array],
+            z: Union[np.ndarray, da.Array],
+            values: Union[np.ndarray, da.Array],
+            simple: bool = True) -> da.Array:
+        """Push new samples into the defined bins from dask array.
+
+        Args:
+            x (numpy.ndarray, dask.Array): X coordinates of the samples
+            y (numpy.ndarray, dask.Array): Y coordinates of the samples
+            z (numpy.ndarray, dask.Array): Z coordinates of the samples
+            values (numpy.ndarray, dask.Array): New samples to push into the
+                defined bins.
+            simple (bool, optional): If true, a simple binning 2D is used
+                otherwise a linear binning 2d is applied.
+        Returns:
+            The calculation graph producing the update of the grid from the
+            provided samples. Running the graph will return an instance of this
+            class containing the statistics calculated for all processed
+            samples.
+
+        .. seealso ::
+
+            :py:meth:`push <pyinterp.Binning3D.push>`
+        """
+        x = da.asarray(x)
+        y = da.asarray(y)
+        z = da.asarray(z)
+        values = da.asarray(values)
+
+        def _process_block(x, y, z, values, x_axis, y_axis, z_axis, wgs,
+                           simple, dtype, sparse):
+            binning = Binning3D(x_axis,
+                                y_axis,
+                                z_axis,
+                                wgs,
+                                dtype=dtype,
+                                sparse=sparse)
+            binning.push(x, y, z, values, simple, num_threads=1)
+            return np.array([binning], dtype="object")
+
+        return da.map_blocks(_process_block,
+                             x.ravel(),
+                             y.ravel(),
+                             z.ravel(),
+                             values.ravel(),
+                             self.x,
+                             self.y,
+                             self.z,
+                             self.wgs,
+                             simple,
+                             self.dtype,
+                             self.sparse,
+                             dtype="object").sum()
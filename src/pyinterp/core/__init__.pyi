@@ -1,9 +1,11 @@
-from typing import Any, ClassVar, List, Optional, Tuple, overload
+from typing import (Any, Callable, ClassVar, Iterable, List, Optional,
+                    Tuple, Union, overload)
 import numpy
 from . import dateutils
 from . import geodetic
 from . import geohash
 from . import fill
+from . import profiling
 
 
 class Axis:
@@ -135,6 +137,17 @@ class Bilinear2D(BivariateInterpolator2D):
         ...
 
 
+class Bilinear2DFloat32(BivariateInterpolator2DFloat32):
+    def __init__(self) -> None:
+        ...
+
+    def __getstate__(self) -> tuple:
+        ...
+
+    def __setstate__(self, arg0: tuple) -> None:
+        ...
+
+
 class Bilinear3D(BivariateInterpolator3D):
     def __init__(self) -> None:
         ...
@@ -146,11 +159,12 @@ class Bilinear3D(BivariateInterpolator3D):
         ...
 
 
-class Binning2DFloat32:
+class Binning2DCountFloat32:
     def __init__(self,
                  x: Axis,
                  y: Axis,
-                 wgs: Optional[geodetic.System] = ...) -> None:
+                 wgs: Optional[geodetic.System] = ...,
+                 sparse: bool = ...) -> None:
         ...
 
     def clear(self) -> None:
@@ -168,6 +182,9 @@ class Binning2DFloat32:
     def mean(self) -> numpy.ndarray[numpy.float32]:
         ...
 
+    def merge(self, state: tuple) -> None:
+        ...
+
     def min(self) -> numpy.ndarray[numpy.float32]:
         ...
 
@@ -178,6 +195,16 @@ class Binning2DFloat32:
              simple: bool = ...) -> None:
         ...
 
+    def push_kernel(self,
+                    x: numpy.ndarray[numpy.float32],
+                    y: numpy.ndarray[numpy.float32],
+                    z: numpy.ndarray[numpy.float32],
+                    wf: WindowFunction = ...,
+                    radius: int = ...,
+                    arg: float = ...,
+                    num_threads: int = ...) -> None:
+        ...
+
     def skewness(self) -> numpy.ndarray[numpy.float32]:
         ...
 
@@ -193,12 +220,16 @@ class Binning2DFloat32:
     def __getstate__(self) -> tuple:
         ...
 
-    def __iadd__(self, arg0: Binning2DFloat32) -> Binning2DFloat32:
+    def __iadd__(self, arg0: Binning2DCountFloat32) -> Binning2DCountFloat32:
         ...
 
     def __setstate__(self, arg0: tuple) -> None:
         ...
 
+    @property
+    def sparse(self) -> bool:
+        ...
+
     @property
     def wgs(self) -> Optional[geodetic.System]:
         ...
@@ -212,11 +243,12 @@ class Binning2DFloat32:
         ...
 
 
-class Binning2DFloat64:
+class Binning2DCountFloat64:
     def __init__(self,
                  x: Axis,
                  y: Axis,
-                 wgs: Optional[geodetic.System] = ...) -> None:
+                 wgs: Optional[geodetic.System] = ...,
+                 sparse: bool = ...) -> None:
         ...
 
     def clear(self) -> None:
@@ -234,6 +266,9 @@ class Binning2DFloat64:
     def mean(self) -> numpy.ndarray[numpy.float64]:
         ...
 
+    def merge(self, state: tuple) -> None:
+        ...
+
     def min(self) -> numpy.ndarray[numpy.float64]:
         ...
 
@@ -244,6 +279,16 @@ class Binning2DFloat64:
              simple: bool = ...) -> None:
         ...
 
+    def push_kernel(self,
+                    x: numpy.ndarray[numpy.float64],
+                    y: numpy.ndarray[numpy.float64],
+                    z: numpy.ndarray[numpy.float64],
+                    wf: WindowFunction = ...,
+                    radius: int = ...,
+                    arg: float = ...,
+                    num_threads: int = ...) -> None:
+        ...
+
     def skewness(self) -> numpy.ndarray[numpy.float64]:
         ...
 
@@ -259,12 +304,16 @@ class Binning2DFloat64:
     def __getstate__(self) -> tuple:
         ...
 
-    def __iadd__(self, arg0: Binning2DFloat64) -> Binning2DFloat64:
+    def __iadd__(self, arg0: Binning2DCountFloat64) -> Binning2DCountFloat64:
         ...
 
     def __setstate__(self, arg0: tuple) -> None:
         ...
 
+    @property
+    def sparse(self) -> bool:
+        ...
+
     @property
     def wgs(self) -> Optional[geodetic.System]:
         ...
@@ -278,21 +327,15 @@ class Binning2DFloat64:
         ...
 
 
-class BivariateInterpolator2D:
-    def __init__(self, *args, **kwargs) -> None:
-        ...
-
-
-class BivariateInterpolator3D:
-    def __init__(self, *args, **kwargs) -> None:
+class Binning2DFloat32:
+    def __init__(self,
+                 x: Axis,
+                 y: Axis,
+                 wgs: Optional[geodetic.System] = ...,
+                 sparse: bool = ...) -> None:
         ...
 
-
-class DescriptiveStatisticsFloat32:
-    def __init__(self,
-                 values: numpy.ndarray[numpy.float32],
-                 weights: Optional[numpy.ndarray[numpy.float32]] = ...,
-                 axis: Optional[List[int]] = ...) -> None:
+    def clear(self) -> None:
         ...
 
     def count(self) -> numpy.ndarray[numpy.uint64]:
@@ -307,9 +350,29 @@ class DescriptiveStatisticsFloat32:
     def mean(self) -> numpy.ndarray[numpy.float32]:
         ...
 
+    def merge(self, state: tuple) -> None:
+        ...
+
     def min(self) -> numpy.ndarray[numpy.float32]:
         ...
 
+    def push(self,
+             x: numpy.ndarray[numpy.float32],
+             y: numpy.ndarray[numpy.float32],
+             z: numpy.ndarray[numpy.float32],
+             simple: bool = ...) -> None:
+        ...
+
+    def push_kernel(self,
+                    x: numpy.ndarray[numpy.float32],
+                    y: numpy.ndarray[numpy.float32],
+                    z: numpy.ndarray[numpy.float32],
+                    wf: WindowFunction = ...,
+                    radius: int = ...,
+                    arg: float = ...,
+                    num_threads: int = ...) -> None:
+        ...
+
     def skewness(self) -> numpy.ndarray[numpy.float32]:
         ...
 
@@ -322,28 +385,41 @@ class DescriptiveStatisticsFloat32:
     def variance(self, ddof: int = ...) -> numpy.ndarray[numpy.float32]:
         ...
 
-    def __add__(
-            self, other: DescriptiveStatisticsFloat32
-    ) -> DescriptiveStatisticsFloat32:
-        ...
-
     def __getstate__(self) -> tuple:
         ...
 
-    def __iadd__(
-            self, other: DescriptiveStatisticsFloat32
-    ) -> DescriptiveStatisticsFloat32:
+    def __iadd__(self, arg0: Binning2DFloat32) -> Binning2DFloat32:
         ...
 
     def __setstate__(self, arg0: tuple) -> None:
         ...
 
+    @property
+    def sparse(self) -> bool:
+        ...
 
-class DescriptiveStatisticsFloat64:
+    @property
+    def wgs(self) -> Optional[geodetic.System]:
+        ...
+
+    @property
+    def x(self) -> Axis:
+        ...
+
+    @property
+    def y(self) -> Axis:
+        ...
+
+
+class Binning2DFloat64:
     def __init__(self,
-                 values: numpy.ndarray[numpy.float64],
-                 weights: Optional[numpy.ndarray[numpy.float64]] = ...,
-                 axis: Optional[List[int]] = ...) -> None:
+                 x: Axis,
+                 y: Axis,
+                 wgs: Optional[geodetic.System] = ...,
+                 sparse: bool = ...) -> None:
+        ...
+
+    def clear(self) -> None:
         ...
 
     def count(self) -> numpy.ndarray[numpy.uint64]:
@@ -358,9 +434,29 @@ class DescriptiveStatisticsFloat64:
     def mean(self) -> numpy.ndarray[numpy.float64]:
         ...
 
+    def merge(self, state: tuple) -> None:
+        ...
+
     def min(self) -> numpy.ndarray[numpy.float64]:
         ...
 
+    def push(self,
+             x: numpy.ndarray[numpy.float64],
+             y: numpy.ndarray[numpy.float64],
+             z: numpy.ndarray[numpy.float64],
+             simple: bool = ...) -> None:
+        ...
+
+    def push_kernel(self,
+                    x: numpy.ndarray[numpy.float64],
+                    y: numpy.ndarray[numpy.float64],
+                    z: numpy.ndarray[numpy.float64],
+                    wf: WindowFunction = ...,
+                    radius: int = ...,
+                    arg: float = ...,
+                    num_threads: int = ...) -> None:
+        ...
+
     def skewness(self) -> numpy.ndarray[numpy.float64]:
         ...
 
@@ -373,102 +469,105 @@ class DescriptiveStatisticsFloat64:
     def variance(self, ddof: int = ...) -> numpy.ndarray[numpy.float64]:
         ...
 
-    def __add__(
-            self, other: DescriptiveStatisticsFloat64
-    ) -> DescriptiveStatisticsFloat64:
-        ...
-
     def __getstate__(self) -> tuple:
         ...
 
-    def __iadd__(
-            self, other: DescriptiveStatisticsFloat64
-    ) -> DescriptiveStatisticsFloat64:
+    def __iadd__(self, arg0: Binning2DFloat64) -> Binning2DFloat64:
         ...
 
     def __setstate__(self, arg0: tuple) -> None:
         ...
 
-
-class GeoHash:
-    def __init__(self,
-                 longitude: float,
-                 latitude: float,
-                 precision: int = ...) -> None:
+    @property
+    def sparse(self) -> bool:
         ...
 
-    def area(self, wgs: Optional[geodetic.System] = ...) -> float:
+    @property
+    def wgs(self) -> Optional[geodetic.System]:
         ...
 
-    def bounding_box(self) -> geodetic.Box:
+    @property
+    def x(self) -> Axis:
         ...
 
-    def center(self) -> geodetic.Point:
+    @property
+    def y(self) -> Axis:
         ...
 
-    @staticmethod
-    def error_with_precision(precision: int) -> Tuple[float, float]:
-        ...
 
-    @staticmethod
-    def from_string(code: str, round: bool = False) -> GeoHash:
+class Binning2DMeanFloat32:
+    def __init__(self,
+                 x: Axis,
+                 y: Axis,
+                 wgs: Optional[geodetic.System] = ...,
+                 sparse: bool = ...) -> None:
         ...
 
-    @staticmethod
-    def grid_properties(box: geodetic.Box,
-                        precision: int = 1) -> Tuple[GeoHash, int, int]:
+    def clear(self) -> None:
         ...
 
-    def neighbors(self) -> List[GeoHash]:
+    def count(self) -> numpy.ndarray[numpy.uint64]:
         ...
 
-    def number_of_bits(self) -> int:
+    def kurtosis(self) -> numpy.ndarray[numpy.float32]:
         ...
 
-    def precision(self) -> int:
+    def max(self) -> numpy.ndarray[numpy.float32]:
         ...
 
-    def reduce(self) -> Tuple[float, float, int]:
+    def mean(self) -> numpy.ndarray[numpy.float32]:
         ...
 
-
-class Grid2DFloat32:
-    def __init__(self, x: Axis, y: Axis,
-                 array: numpy.ndarray[numpy.float32]) -> None:
+    def merge(self, state: tuple) -> None:
         ...
 
-    def __getstate__(self) -> tuple:
+    def min(self) -> numpy.ndarray[numpy.float32]:
         ...
 
-    def __setstate__(self, arg0: tuple) -> None:
+    def push(self,
+             x: numpy.ndarray[numpy.float32],
+             y: numpy.ndarray[numpy.float32],
+             z: numpy.ndarray[numpy.float32],
+             simple: bool = ...) -> None:
         ...
 
-    @property
-    def array(self) -> numpy.ndarray[numpy.float32]:
+    def push_kernel(self,
+                    x: numpy.ndarray[numpy.float32],
+                    y: numpy.ndarray[numpy.float32],
+                    z: numpy.ndarray[numpy.float32],
+                    wf: WindowFunction = ...,
+                    radius: int = ...,
+                    arg: float = ...,
+                    num_threads: int = ...) -> None:
         ...
 
-    @property
-    def x(self) -> Axis:
+    def skewness(self) -> numpy.ndarray[numpy.float32]:
         ...
 
-    @property
-    def y(self) -> Axis:
+    def sum(self) -> numpy.ndarray[numpy.float32]:
         ...
 
+    def sum_of_weights(self) -> numpy.ndarray[numpy.float32]:
+        ...
 
-class Grid2DFloat64:
-    def __init__(self, x: Axis, y: Axis,
-                 array: numpy.ndarray[numpy.float64]) -> None:
+    def variance(self, ddof: int = ...) -> numpy.ndarray[numpy.float32]:
         ...
 
     def __getstate__(self) -> tuple:
         ...
 
+    def __iadd__(self, arg0: Binning2DMeanFloat32) -> Binning2DMeanFloat32:
+        ...
+
     def __setstate__(self, arg0: tuple) -> None:
         ...
 
     @property
-    def array(self) -> numpy.ndarray[numpy.float64]:
+    def sparse(self) -> bool:
+        ...
+
+    @property
+    def wgs(self) -> Optional[geodetic.System]:
         ...
 
     @property
@@ -480,131 +579,163 @@ class Grid2DFloat64:
         ...
 
 
-class Grid2DInt8:
-    def __init__(self, x: Axis, y: Axis,
-                 array: numpy.ndarray[numpy.int8]) -> None:
+class Binning2DMeanFloat64:
+    def __init__(self,
+                 x: Axis,
+                 y: Axis,
+                 wgs: Optional[geodetic.System] = ...,
+                 sparse: bool = ...) -> None:
         ...
 
-    def __getstate__(self) -> tuple:
+    def clear(self) -> None:
         ...
 
-    def __setstate__(self, arg0: tuple) -> None:
+    def count(self) -> numpy.ndarray[numpy.uint64]:
         ...
 
-    @property
-    def array(self) -> numpy.ndarray[numpy.int8]:
+    def kurtosis(self) -> numpy.ndarray[numpy.float64]:
         ...
 
-    @property
-    def x(self) -> Axis:
+    def max(self) -> numpy.ndarray[numpy.float64]:
         ...
 
-    @property
-    def y(self) -> Axis:
+    def mean(self) -> numpy.ndarray[numpy.float64]:
         ...
 
-
-class Grid3DFloat32:
-    def __init__(self, x: Axis, y: Axis, z: Axis,
-                 array: numpy.ndarray[numpy.float32]) -> None:
+    def merge(self, state: tuple) -> None:
         ...
 
-    def __getstate__(self) -> tuple:
+    def min(self) -> numpy.ndarray[numpy.float64]:
         ...
 
-    def __setstate__(self, arg0: tuple) -> None:
+    def push(self,
+             x: numpy.ndarray[numpy.float64],
+             y: numpy.ndarray[numpy.float64],
+             z: numpy.ndarray[numpy.float64],
+             simple: bool = ...) -> None:
         ...
 
-    @property
-    def array(self) -> numpy.ndarray[numpy.float32]:
+    def push_kernel(self,
+                    x: numpy.ndarray[numpy.float64],
+                    y: numpy.ndarray[numpy.float64],
+                    z: numpy.ndarray[numpy.float64],
+                    wf: WindowFunction = ...,
+                    radius: int = ...,
+                    arg: float = ...,
+                    num_threads: int = ...) -> None:
         ...
 
-    @property
-    def x(self) -> Axis:
+    def skewness(self) -> numpy.ndarray[numpy.float64]:
         ...
 
-    @property
-    def y(self) -> Axis:
+    def sum(self) -> numpy.ndarray[numpy.float64]:
         ...
 
-    @property
-    def z(self) -> Axis:
+    def sum_of_weights(self) -> numpy.ndarray[numpy.float64]:
         ...
 
-
-class Grid3DFloat64:
-    def __init__(self, x: Axis, y: Axis, z: Axis,
-                 array: numpy.ndarray[numpy.float64]) -> None:
+    def variance(self, ddof: int = ...) -> numpy.ndarray[numpy.float64]:
         ...
 
     def __getstate__(self) -> tuple:
         ...
 
+    def __iadd__(self, arg0: Binning2DMeanFloat64) -> Binning2DMeanFloat64:
+        ...
+
     def __setstate__(self, arg0: tuple) -> None:
         ...
 
     @property
-    def array(self) -> numpy.ndarray[numpy.float64]:
+    def sparse(self) -> bool:
         ...
 
     @property
-    def x(self) -> Axis:
+    def wgs(self) -> Optional[geodetic.System]:
         ...
 
     @property
-    def y(self) -> Axis:
+    def x(self) -> Axis:
         ...
 
     @property
-    def z(self) -> Axis:
+    def y(self) -> Axis:
         ...
 
 
-class Grid3DInt8:
-    def __init__(self, x: Axis, y: Axis, z: Axis,
-                 array: numpy.ndarray[numpy.int8]) -> None:
+class Binning2DVarianceFloat32:
+    def __init__(self,
+                 x: Axis,
+                 y: Axis,
+                 wgs: Optional[geodetic.System] = ...,
+                 sparse: bool = ...) -> None:
         ...
 
-    def __getstate__(self) -> tuple:
+    def clear(self) -> None:
         ...
 
-    def __setstate__(self, arg0: tuple) -> None:
+    def count(self) -> numpy.ndarray[numpy.uint64]:
         ...
 
-    @property
-    def array(self) -> numpy.ndarray[numpy.int8]:
+    def kurtosis(self) -> numpy.ndarray[numpy.float32]:
         ...
 
-    @property
-    def x(self) -> Axis:
+    def max(self) -> numpy.ndarray[numpy.float32]:
         ...
 
-    @property
-    def y(self) -> Axis:
+    def mean(self) -> numpy.ndarray[numpy.float32]:
         ...
 
-    @property
-    def z(self) -> Axis:
+    def merge(self, state: tuple) -> None:
         ...
 
+    def min(self) -> numpy.ndarray[numpy.float32]:
+        ...
 
-class Grid4DFloat32:
-    def __init__(self, x: Axis, y: Axis, z: Axis, u: Axis,
-                 array: numpy.ndarray[numpy.float32]) -> None:
+    def push(self,
+             x: numpy.ndarray[numpy.float32],
+             y: numpy.ndarray[numpy.float32],
+             z: numpy.ndarray[numpy.float32],
+             simple: bool = ...) -> None:
+        ...
+
+    def push_kernel(self,
+                    x: numpy.ndarray[numpy.float32],
+                    y: numpy.ndarray[numpy.float32],
+                    z: numpy.ndarray[numpy.float32],
+                    wf: WindowFunction = ...,
+                    radius: int = ...,
+                    arg: float = ...,
+                    num_threads: int = ...) -> None:
+        ...
+
+    def skewness(self) -> numpy.ndarray[numpy.float32]:
+        ...
+
+    def sum(self) -> numpy.ndarray[numpy.float32]:
+        ...
+
+    def sum_of_weights(self) -> numpy.ndarray[numpy.float32]:
+        ...
+
+    def variance(self, ddof: int = ...) -> numpy.ndarray[numpy.float32]:
         ...
 
     def __getstate__(self) -> tuple:
         ...
 
+    def __iadd__(self, arg0: Binning2DVarianceFloat32) -> Binning2DVarianceFloat32:
+        ...
+
     def __setstate__(self, arg0: tuple) -> None:
         ...
 
     @property
-    def array(self) -> numpy.ndarray[numpy.float32]:
+    def sparse(self) -> bool:
         ...
 
     @property
-    def u(self) -> Axis:
+    def wgs(self) -> Optional[geodetic.System]:
         ...
 
     @property
@@ -615,60 +746,80 @@ class Grid4DFloat32:
     def y(self) -> Axis:
         ...
 
-    @property
-    def z(self) -> Axis:
+
+class Binning2DVarianceFloat64:
+    def __init__(self,
+                 x: Axis,
+                 y: Axis,
+                 wgs: Optional[geodetic.System] = ...,
+                 sparse: bool = ...) -> None:
         ...
 
+    def clear(self) -> None:
+        ...
 
-class Grid4DFloat64:
-    def __init__(self, x: Axis, y: Axis, z: Axis, u: Axis,
-                 array: numpy.ndarray[numpy.float64]) -> None:
+    def count(self) -> numpy.ndarray[numpy.uint64]:
         ...
 
-    def __getstate__(self) -> tuple:
+    def kurtosis(self) -> numpy.ndarray[numpy.float64]:
         ...
 
-    def __setstate__(self, arg0: tuple) -> None:
+    def max(self) -> numpy.ndarray[numpy.float64]:
         ...
 
-    @property
-    def array(self) -> numpy.ndarray[numpy.float64]:
+    def mean(self) -> numpy.ndarray[numpy.float64]:
         ...
 
-    @property
-    def u(self) -> Axis:
+    def merge(self, state: tuple) -> None:
         ...
 
-    @property
-    def x(self) -> Axis:
+    def min(self) -> numpy.ndarray[numpy.float64]:
         ...
 
-    @property
-    def y(self) -> Axis:
+    def push(self,
+             x: numpy.ndarray[numpy.float64],
+             y: numpy.ndarray[numpy.float64],
+             z: numpy.ndarray[numpy.float64],
+             simple: bool = ...) -> None:
         ...
 
-    @property
-    def z(self) -> Axis:
+    def push_kernel(self,
+                    x: numpy.ndarray[numpy.float64],
+                    y: numpy.ndarray[numpy.float64],
+                    z: numpy.ndarray[numpy.float64],
+                    wf: WindowFunction = ...,
+                    radius: int = ...,
+                    arg: float = ...,
+                    num_threads: int = ...) -> None:
         ...
 
+    def skewness(self) -> numpy.ndarray[numpy.float64]:
+        ...
 
-class Grid4DInt8:
-    def __init__(self, x: Axis, y: Axis, z: Axis, u: Axis,
-                 array: numpy.ndarray[numpy.int8]) -> None:
+    def sum(self) -> numpy.ndarray[numpy.float64]:
+        ...
+
+    def sum_of_weights(self) -> numpy.ndarray[numpy.float64]:
+        ...
+
+    def variance(self, ddof: int = ...) -> numpy.ndarray[numpy.float64]:
         ...
 
     def __getstate__(self) -> tuple:
         ...
 
+    def __iadd__(self, arg0: Binning2DVarianceFloat64) -> Binning2DVarianceFloat64:
+        ...
+
     def __setstate__(self, arg0: tuple) -> None:
         ...
 
     @property
-    def array(self) -> numpy.ndarray[numpy.int8]:
+    def sparse(self) -> bool:
         ...
 
     @property
-    def u(self) -> Axis:
+    def wgs(self) -> Optional[geodetic.System]:
         ...
 
     @property
@@ -679,13 +830,14 @@ class Grid4DInt8:
     def y(self) -> Axis:
         ...
 
-    @property
-    def z(self) -> Axis:
-        ...
-
 
-class Histogram2DFloat32:
-    def __init__(self, x: Axis, y: Axis, bins: Optional[int] = ...) -> None:
+class Binning3DFloat32:
+    def __init__(self,
+                 x: Axis,
+                 y: Axis,
+                 z: Axis,
+                 wgs: Optional[geodetic.System] = ...,
+                 sparse: bool = ...) -> None:
         ...
 
     def clear(self) -> None:
@@ -694,9 +846,6 @@ class Histogram2DFloat32:
     def count(self) -> numpy.ndarray[numpy.uint64]:
         ...
 
-    def histograms(self, *args, **kwargs) -> Any:
-        ...
-
     def kurtosis(self) -> numpy.ndarray[numpy.float32]:
         ...
 
@@ -706,35 +855,50 @@ class Histogram2DFloat32:
     def mean(self) -> numpy.ndarray[numpy.float32]:
         ...
 
+    def merge(self, state: tuple) -> None:
+        ...
+
     def min(self) -> numpy.ndarray[numpy.float32]:
         ...
 
-    def push(self, x: numpy.ndarray[numpy.float32],
+    def push(self,
+             x: numpy.ndarray[numpy.float32],
              y: numpy.ndarray[numpy.float32],
-             z: numpy.ndarray[numpy.float32]) -> None:
+             z: numpy.ndarray[numpy.float64],
+             values: numpy.ndarray[numpy.float32],
+             simple: bool = ...,
+             num_threads: int = ...) -> None:
         ...
 
-    def quantile(self, q: float = ...) -> numpy.ndarray[numpy.float32]:
+    def skewness(self) -> numpy.ndarray[numpy.float32]:
         ...
 
-    def skewness(self) -> numpy.ndarray[numpy.float32]:
+    def sum(self) -> numpy.ndarray[numpy.float32]:
         ...
 
     def sum_of_weights(self) -> numpy.ndarray[numpy.float32]:
         ...
 
-    def variance(self) -> numpy.ndarray[numpy.float32]:
+    def variance(self, ddof: int = ...) -> numpy.ndarray[numpy.float32]:
         ...
 
     def __getstate__(self) -> tuple:
         ...
 
-    def __iadd__(self, arg0: Histogram2DFloat32) -> Histogram2DFloat32:
+    def __iadd__(self, arg0: Binning3DFloat32) -> Binning3DFloat32:
         ...
 
     def __setstate__(self, arg0: tuple) -> None:
         ...
 
+    @property
+    def sparse(self) -> bool:
+        ...
+
+    @property
+    def wgs(self) -> Optional[geodetic.System]:
+        ...
+
     @property
     def x(self) -> Axis:
         ...
@@ -743,9 +907,18 @@ class Histogram2DFloat32:
     def y(self) -> Axis:
         ...
 
+    @property
+    def z(self) -> Axis:
+        ...
+
 
-class Histogram2DFloat64:
-    def __init__(self, x: Axis, y: Axis, bins: Optional[int] = ...) -> None:
+class Binning3DFloat64:
+    def __init__(self,
+                 x: Axis,
+                 y: Axis,
+                 z: Axis,
+                 wgs: Optional[geodetic.System] = ...,
+                 sparse: bool = ...) -> None:
         ...
 
     def clear(self) -> None:
@@ -754,9 +927,6 @@ class Histogram2DFloat64:
     def count(self) -> numpy.ndarray[numpy.uint64]:
         ...
 
-    def histograms(self, *args, **kwargs) -> Any:
-        ...
-
     def kurtosis(self) -> numpy.ndarray[numpy.float64]:
         ...
 
@@ -766,233 +936,252 @@ class Histogram2DFloat64:
     def mean(self) -> numpy.ndarray[numpy.float64]:
         ...
 
+    def merge(self, state: tuple) -> None:
+        ...
+
     def min(self) -> numpy.ndarray[numpy.float64]:
         ...
 
-    def push(self, x: numpy.ndarray[numpy.float64],
+    def push(self,
+             x: numpy.ndarray[numpy.float64],
              y: numpy.ndarray[numpy.float64],
-             z: numpy.ndarray[numpy.float64]) -> None:
+             z: numpy.ndarray[numpy.float64],
+             values: numpy.ndarray[numpy.float64],
+             simple: bool = ...,
+             num_threads: int = ...) -> None:
         ...
 
-    def quantile(self, q: float = ...) -> numpy.ndarray[numpy.float64]:
+    def skewness(self) -> numpy.ndarray[numpy.float64]:
         ...
 
-    def skewness(self) -> numpy.ndarray[numpy.float64]:
+    def sum(self) -> numpy.ndarray[numpy.float64]:
         ...
 
     def sum_of_weights(self) -> numpy.ndarray[numpy.float64]:
         ...
 
-    def variance(self) -> numpy.ndarray[numpy.float64]:
+    def variance(self, ddof: int = ...) -> numpy.ndarray[numpy.float64]:
         ...
 
     def __getstate__(self) -> tuple:
         ...
 
-    def __iadd__(self, arg0: Histogram2DFloat64) -> Histogram2DFloat64:
+    def __iadd__(self, arg0: Binning3DFloat64) -> Binning3DFloat64:
         ...
 
     def __setstate__(self, arg0: tuple) -> None:
         ...
 
     @property
-    def x(self) -> Axis:
+    def sparse(self) -> bool:
         ...
 
     @property
-    def y(self) -> Axis:
+    def wgs(self) -> Optional[geodetic.System]:
         ...
 
-
-class InverseDistanceWeighting2D(BivariateInterpolator2D):
-    def __init__(self, p: int = ...) -> None:
+    @property
+    def x(self) -> Axis:
         ...
 
-    def __getstate__(self) -> tuple:
+    @property
+    def y(self) -> Axis:
         ...
 
-    def __setstate__(self, arg0: tuple) -> None:
+    @property
+    def z(self) -> Axis:
         ...
 
 
-class InverseDistanceWeighting3D(BivariateInterpolator3D):
-    def __init__(self, p: int = ...) -> None:
+class BivariateInterpolator2D:
+    def __init__(self, *args, **kwargs) -> None:
         ...
 
-    def __getstate__(self) -> tuple:
-        ...
 
-    def __setstate__(self, arg0: tuple) -> None:
+class BivariateInterpolator2DFloat32:
+    def __init__(self, *args, **kwargs) -> None:
         ...
 
 
-class Nearest2D(BivariateInterpolator2D):
-    def __init__(self) -> None:
+class BivariateInterpolator3D:
+    def __init__(self, *args, **kwargs) -> None:
         ...
 
-    def __getstate__(self) -> tuple:
-        ...
 
-    def __setstate__(self, arg0: tuple) -> None:
+class ChunkedGrid3DFloat32:
+    def __init__(self,
+                 x: Axis,
+                 y: Axis,
+                 z: Axis,
+                 chunks: Tuple[int, int, int],
+                 reader: Callable[[tuple], numpy.ndarray],
+                 cache_size: int = ...) -> None:
         ...
 
-
-class Nearest3D(BivariateInterpolator3D):
-    def __init__(self) -> None:
+    def cached(self) -> int:
         ...
 
-    def __getstate__(self) -> tuple:
+    def clear_cache(self) -> None:
         ...
 
-    def __setstate__(self, arg0: tuple) -> None:
+    @property
+    def cache_size(self) -> int:
         ...
 
-
-class RTree3DFloat32:
-    def __init__(self, system: Optional[geodetic.System]) -> None:
+    @property
+    def chunks(self) -> Tuple[int, int, int]:
         ...
 
-    def bounds(self) -> tuple:
+    @property
+    def x(self) -> Axis:
         ...
 
-    def clear(self) -> None:
+    @property
+    def y(self) -> Axis:
         ...
 
-    def insert(self, coordinates: numpy.ndarray[numpy.float32],
-               values: numpy.ndarray[numpy.float32]) -> None:
+    @property
+    def z(self) -> Axis:
         ...
 
-    def inverse_distance_weighting(self,
-                                   coordinates: numpy.ndarray[numpy.float32],
-                                   radius: Optional[float],
-                                   k: int = ...,
-                                   p: int = ...,
-                                   within: bool = ...,
-                                   num_threads: int = ...) -> tuple:
-        ...
 
-    def packing(self, coordinates: numpy.ndarray[numpy.float32],
-                values: numpy.ndarray[numpy.float32]) -> None:
+class ChunkedGrid3DFloat64:
+    def __init__(self,
+                 x: Axis,
+                 y: Axis,
+                 z: Axis,
+                 chunks: Tuple[int, int, int],
+                 reader: Callable[[tuple], numpy.ndarray],
+                 cache_size: int = ...) -> None:
         ...
 
-    def query(self,
-              coordinates: numpy.ndarray[numpy.float32],
-              k: int = ...,
-              within: bool = ...,
-              num_threads: int = ...) -> tuple:
+    def cached(self) -> int:
         ...
 
-    def radial_basis_function(self,
-                              coordinates: numpy.ndarray[numpy.float32],
-                              radius: Optional[float],
-                              k: int = ...,
-                              rbf: RadialBasisFunction = ...,
-                              epsilon: Optional[float] = ...,
-                              smooth: float = ...,
-                              within: bool = ...,
-                              num_threads: int = ...) -> tuple:
+    def clear_cache(self) -> None:
         ...
 
-    def window_function(self,
-                        coordinates: numpy.ndarray[numpy.float32],
-                        radius: float,
-                        k: int = ...,
-                        wf: WindowFunction = ...,
-                        arg: Optional[float] = ...,
-                        within: bool = ...,
-                        num_threads: int = ...) -> tuple:
+    @property
+    def cache_size(self) -> int:
         ...
 
-    def __bool__(self) -> bool:
+    @property
+    def chunks(self) -> Tuple[int, int, int]:
         ...
 
-    def __getstate__(self) -> tuple:
+    @property
+    def x(self) -> Axis:
         ...
 
-    def __len__(self) -> int:
+    @property
+    def y(self) -> Axis:
         ...
 
-    def __setstate__(self, arg0: tuple) -> None:
+    @property
+    def z(self) -> Axis:
         ...
 
 
-class RTree3DFloat64:
-    def __init__(self, system: Optional[geodetic.System]) -> None:
+class ChunkedGrid4DFloat32:
+    def __init__(self,
+                 x: Axis,
+                 y: Axis,
+                 z: Axis,
+                 u: Axis,
+                 chunks: Tuple[int, int, int, int],
+                 reader: Callable[[tuple], numpy.ndarray],
+                 cache_size: int = ...) -> None:
         ...
 
-    def bounds(self) -> tuple:
+    def cached(self) -> int:
         ...
 
-    def clear(self) -> None:
+    def clear_cache(self) -> None:
         ...
 
-    def insert(self, coordinates: numpy.ndarray[numpy.float64],
-               values: numpy.ndarray[numpy.float64]) -> None:
+    @property
+    def cache_size(self) -> int:
         ...
 
-    def inverse_distance_weighting(self,
-                                   coordinates: numpy.ndarray[numpy.float64],
-                                   radius: Optional[float],
-                                   k: int = ...,
-                                   p: int = ...,
-                                   within: bool = ...,
-                                   num_threads: int = ...) -> tuple:
+    @property
+    def chunks(self) -> Tuple[int, int, int, int]:
         ...
 
-    def packing(self, coordinates: numpy.ndarray[numpy.float64],
-                values: numpy.ndarray[numpy.float64]) -> None:
+    @property
+    def u(self) -> Axis:
         ...
 
-    def query(self,
-              coordinates: numpy.ndarray[numpy.float64],
-              k: int = ...,
-              within: bool = ...,
-              num_threads: int = ...) -> tuple:
+    @property
+    def x(self) -> Axis:
         ...
 
-    def radial_basis_function(self,
-                              coordinates: numpy.ndarray[numpy.float64],
-                              radius: Optional[float],
-                              k: int = ...,
-                              rbf: RadialBasisFunction = ...,
-                              epsilon: Optional[float] = ...,
-                              smooth: float = ...,
-                              within: bool = ...,
-                              num_threads: int = ...) -> tuple:
+    @property
+    def y(self) -> Axis:
         ...
 
-    def window_function(self,
-                        coordinates: numpy.ndarray[numpy.float64],
-                        radius: float,
-                        k: int = ...,
-                        wf: WindowFunction = ...,
-                        arg: Optional[float] = ...,
-                        within: bool = ...,
-                        num_threads: int = ...) -> tuple:
+    @property
+    def z(self) -> Axis:
         ...
 
-    def __bool__(self) -> bool:
+    @property
+    def u(self) -> Axis:
         ...
 
-    def __getstate__(self) -> tuple:
+
+class ChunkedGrid4DFloat64:
+    def __init__(self,
+                 x: Axis,
+                 y: Axis,
+                 z: Axis,
+                 u: Axis,
+                 chunks: Tuple[int, int, int, int],
+                 reader: Callable[[tuple], numpy.ndarray],
+                 cache_size: int = ...) -> None:
         ...
 
-    def __len__(self) -> int:
+    def cached(self) -> int:
         ...
 
-    def __setstate__(self, arg0: tuple) -> None:
+    def clear_cache(self) -> None:
         ...
 
+    @property
+    def cache_size(self) -> int:
+        ...
 
-class RadialBasisFunction:
+    @property
+    def chunks(self) -> Tuple[int, int, int, int]:
+        ...
+
+    @property
+    def u(self) -> Axis:
+        ...
+
+    @property
+    def x(self) -> Axis:
+        ...
+
+    @property
+    def y(self) -> Axis:
+        ...
+
+    @property
+    def z(self) -> Axis:
+        ...
+
+    @property
+    def u(self) -> Axis:
+        ...
+
+
+class CovarianceFunction:
     __doc__: ClassVar[str] = ...  # read-only
     __members__: ClassVar[dict] = ...  # read-only
-    Cubic: ClassVar[RadialBasisFunction] = ...
-    Gaussian: ClassVar[RadialBasisFunction] = ...
-    InverseMultiquadric: ClassVar[RadialBasisFunction] = ...
-    Linear: ClassVar[RadialBasisFunction] = ...
-    Multiquadric: ClassVar[RadialBasisFunction] = ...
-    ThinPlate: ClassVar[RadialBasisFunction] = ...
+    Gaussian: ClassVar[CovarianceFunction] = ...
+    Matern12: ClassVar[CovarianceFunction] = ...
+    Matern32: ClassVar[CovarianceFunction] = ...
+    Matern52: ClassVar[CovarianceFunction] = ...
+    Spherical: ClassVar[CovarianceFunction] = ...
     __entries: ClassVar[dict] = ...
 
     def __init__(self, value: int) -> None:
@@ -1028,15 +1217,12 @@ class RadialBasisFunction:
         ...
 
 
-class StreamingHistogramFloat32:
+class DescriptiveStatisticsFloat32:
     def __init__(self,
                  values: numpy.ndarray[numpy.float32],
                  weights: Optional[numpy.ndarray[numpy.float32]] = ...,
                  axis: Optional[List[int]] = ...,
-                 bin_count: Optional[int] = ...) -> None:
-        ...
-
-    def bins(self, *args, **kwargs) -> Any:
+                 num_threads: int = ...) -> None:
         ...
 
     def count(self) -> numpy.ndarray[numpy.uint64]:
@@ -1054,49 +1240,59 @@ class StreamingHistogramFloat32:
     def min(self) -> numpy.ndarray[numpy.float32]:
         ...
 
-    def quantile(self, q: float = ...) -> numpy.ndarray[numpy.float32]:
+    @overload
+    @staticmethod
+    def rolling(grid: Grid3DFloat32,
+                window: int,
+                center: bool = ...,
+                min_periods: int = ...,
+                num_threads: int = ...) -> DescriptiveStatisticsFloat32:
         ...
 
-    def resize(self, arg0: int) -> None:
+    @overload
+    @staticmethod
+    def rolling(grid: TemporalGrid3DFloat32,
+                window: int,
+                center: bool = ...,
+                min_periods: int = ...,
+                num_threads: int = ...) -> DescriptiveStatisticsFloat32:
         ...
 
-    def size(self) -> numpy.ndarray[numpy.uint64]:
+    def skewness(self) -> numpy.ndarray[numpy.float32]:
         ...
 
-    def skewness(self) -> numpy.ndarray[numpy.float32]:
+    def sum(self) -> numpy.ndarray[numpy.float32]:
         ...
 
     def sum_of_weights(self) -> numpy.ndarray[numpy.float32]:
         ...
 
-    def variance(self) -> numpy.ndarray[numpy.float32]:
+    def variance(self, ddof: int = ...) -> numpy.ndarray[numpy.float32]:
         ...
 
-    def __add__(self,
-                other: StreamingHistogramFloat32) -> StreamingHistogramFloat32:
+    def __add__(
+            self, other: DescriptiveStatisticsFloat32
+    ) -> DescriptiveStatisticsFloat32:
         ...
 
     def __getstate__(self) -> tuple:
         ...
 
     def __iadd__(
-            self,
-            other: StreamingHistogramFloat32) -> StreamingHistogramFloat32:
+            self, other: DescriptiveStatisticsFloat32
+    ) -> DescriptiveStatisticsFloat32:
         ...
 
     def __setstate__(self, arg0: tuple) -> None:
         ...
 
 
-class StreamingHistogramFloat64:
+class DescriptiveStatisticsFloat64:
     def __init__(self,
                  values: numpy.ndarray[numpy.float64],
                  weights: Optional[numpy.ndarray[numpy.float64]] = ...,
                  axis: Optional[List[int]] = ...,
-                 bin_count: Optional[int] = ...) -> None:
-        ...
-
-    def bins(self, *args, **kwargs) -> Any:
+                 num_threads: int = ...) -> None:
         ...
 
     def count(self) -> numpy.ndarray[numpy.uint64]:
@@ -1114,127 +1310,137 @@ class StreamingHistogramFloat64:
     def min(self) -> numpy.ndarray[numpy.float64]:
         ...
 
-    def quantile(self, q: float = ...) -> numpy.ndarray[numpy.float64]:
+    @overload
+    @staticmethod
+    def rolling(grid: Grid3DFloat64,
+                window: int,
+                center: bool = ...,
+                min_periods: int = ...,
+                num_threads: int = ...) -> DescriptiveStatisticsFloat64:
         ...
 
-    def resize(self, arg0: int) -> None:
+    @overload
+    @staticmethod
+    def rolling(grid: TemporalGrid3DFloat64,
+                window: int,
+                center: bool = ...,
+                min_periods: int = ...,
+                num_threads: int = ...) -> DescriptiveStatisticsFloat64:
         ...
 
-    def size(self) -> numpy.ndarray[numpy.uint64]:
+    def skewness(self) -> numpy.ndarray[numpy.float64]:
         ...
 
-    def skewness(self) -> numpy.ndarray[numpy.float64]:
+    def sum(self) -> numpy.ndarray[numpy.float64]:
         ...
 
     def sum_of_weights(self) -> numpy.ndarray[numpy.float64]:
         ...
 
-    def variance(self) -> numpy.ndarray[numpy.float64]:
+    def variance(self, ddof: int = ...) -> numpy.ndarray[numpy.float64]:
         ...
 
-    def __add__(self,
-                other: StreamingHistogramFloat64) -> StreamingHistogramFloat64:
+    def __add__(
+            self, other: DescriptiveStatisticsFloat64
+    ) -> DescriptiveStatisticsFloat64:
         ...
 
     def __getstate__(self) -> tuple:
         ...
 
     def __iadd__(
-            self,
-            other: StreamingHistogramFloat64) -> StreamingHistogramFloat64:
+            self, other: DescriptiveStatisticsFloat64
+    ) -> DescriptiveStatisticsFloat64:
         ...
 
     def __setstate__(self, arg0: tuple) -> None:
         ...
 
 
-class TemporalAxis(AxisInt64):
-    __hash__: ClassVar[None] = ...
-
-    def __init__(self, values: numpy.ndarray) -> None:
-        ...
-
-    def back(self) -> numpy.ndarray:
-        ...
-
-    def dtype(self) -> numpy.dtype:
-        ...
-
-    def find_index(self,
-                   coordinates: numpy.ndarray,
-                   bounded: bool = ...) -> numpy.ndarray[numpy.int64]:
+class GeoHash:
+    def __init__(self,
+                 longitude: float,
+                 latitude: float,
+                 precision: int = ...) -> None:
         ...
 
-    def find_indexes(self,
-                     coordinates: numpy.ndarray) -> numpy.ndarray[numpy.int64]:
+    def area(self, wgs: Optional[geodetic.System] = ...) -> float:
         ...
 
-    def flip(self, inplace: bool = ...) -> TemporalAxis:
+    def bounding_box(self) -> geodetic.Box:
         ...
 
-    def front(self) -> numpy.ndarray:
+    def center(self) -> geodetic.Point:
         ...
 
-    def increment(self) -> numpy.ndarray:
+    @staticmethod
+    def error_with_precision(precision: int) -> Tuple[float, float]:
         ...
 
-    def is_ascending(self) -> bool:
+    @staticmethod
+    def from_string(code: str, round: bool = False) -> GeoHash:
         ...
 
-    def is_regular(self) -> bool:
+    @staticmethod
+    def grid_properties(box: geodetic.Box,
+                        precision: int = 1) -> Tuple[GeoHash, int, int]:
         ...
 
-    def max_value(self) -> numpy.ndarray:
+    def neighbors(self) -> List[GeoHash]:
         ...
 
-    def min_value(self) -> numpy.ndarray:
+    def number_of_bits(self) -> int:
         ...
 
-    def safe_cast(self, values: numpy.ndarray) -> numpy.ndarray:
+    def precision(self) -> int:
         ...
 
-    def __eq__(self, other: TemporalAxis) -> bool:
+    def reduce(self) -> Tuple[float, float, int]:
         ...
 
-    @overload
-    def __getitem__(self, index: int) -> numpy.ndarray:
-        ...
 
-    @overload
-    def __getitem__(self, indices: slice) -> numpy.ndarray:
+class Grid2DFloat16:
+    def __init__(self,
+                 x: Axis, y: Axis,
+                 array: numpy.ndarray[numpy.uint16],
+                 scale_factor: float = ...,
+                 add_offset: float = ...,
+                 fill_value: Optional[int] = ...) -> None:
         ...
 
     def __getstate__(self) -> tuple:
         ...
 
-    def __len__(self) -> int:
+    def __setstate__(self, arg0: tuple) -> None:
         ...
 
-    def __ne__(self, other: TemporalAxis) -> bool:
+    @property
+    def add_offset(self) -> float:
         ...
 
-    def __setstate__(self, arg0: tuple) -> None:
+    @property
+    def array(self) -> numpy.ndarray[numpy.uint16]:
         ...
 
-
-class TemporalBilinear3D(TemporalBivariateInterpolator3D):
-    def __init__(self) -> None:
+    @property
+    def fill_value(self) -> Optional[int]:
         ...
 
-    def __getstate__(self) -> tuple:
+    @property
+    def scale_factor(self) -> float:
         ...
 
-    def __setstate__(self, arg0: tuple) -> None:
+    @property
+    def x(self) -> Axis:
         ...
 
-
-class TemporalBivariateInterpolator3D:
-    def __init__(self, *args, **kwargs) -> None:
+    @property
+    def y(self) -> Axis:
         ...
 
 
-class TemporalGrid3DFloat32:
-    def __init__(self, x: Axis, y: Axis, z: AxisInt64,
+class Grid2DFloat32:
+    def __init__(self, x: Axis, y: Axis,
                  array: numpy.ndarray[numpy.float32]) -> None:
         ...
 
@@ -1244,6 +1450,9 @@ class TemporalGrid3DFloat32:
     def __setstate__(self, arg0: tuple) -> None:
         ...
 
+    def view(self, x: slice, y: slice) -> Grid2DFloat32:
+        ...
+
     @property
     def array(self) -> numpy.ndarray[numpy.float32]:
         ...
@@ -1256,13 +1465,9 @@ class TemporalGrid3DFloat32:
     def y(self) -> Axis:
         ...
 
-    @property
-    def z(self) -> AxisInt64:
-        ...
-
 
-class TemporalGrid3DFloat64:
-    def __init__(self, x: Axis, y: Axis, z: AxisInt64,
+class Grid2DFloat64:
+    def __init__(self, x: Axis, y: Axis,
                  array: numpy.ndarray[numpy.float64]) -> None:
         ...
 
@@ -1272,6 +1477,9 @@ class TemporalGrid3DFloat64:
     def __setstate__(self, arg0: tuple) -> None:
         ...
 
+    def view(self, x: slice, y: slice) -> Grid2DFloat64:
+        ...
+
     @property
     def array(self) -> numpy.ndarray[numpy.float64]:
         ...
@@ -1284,13 +1492,9 @@ class TemporalGrid3DFloat64:
     def y(self) -> Axis:
         ...
 
-    @property
-    def z(self) -> AxisInt64:
-        ...
-
 
-class TemporalGrid3DInt8:
-    def __init__(self, x: Axis, y: Axis, z: AxisInt64,
+class Grid2DInt8:
+    def __init__(self, x: Axis, y: Axis,
                  array: numpy.ndarray[numpy.int8]) -> None:
         ...
 
@@ -1300,6 +1504,9 @@ class TemporalGrid3DInt8:
     def __setstate__(self, arg0: tuple) -> None:
         ...
 
+    def view(self, x: slice, y: slice) -> Grid2DInt8:
+        ...
+
     @property
     def array(self) -> numpy.ndarray[numpy.int8]:
         ...
@@ -1312,14 +1519,14 @@ class TemporalGrid3DInt8:
     def y(self) -> Axis:
         ...
 
-    @property
-    def z(self) -> AxisInt64:
-        ...
-
 
-class TemporalGrid4DFloat32:
-    def __init__(self, x: Axis, y: Axis, z: AxisInt64, u: Axis,
-                 array: numpy.ndarray[numpy.float32]) -> None:
+class Grid2DInt16:
+    def __init__(self,
+                 x: Axis, y: Axis,
+                 array: numpy.ndarray[numpy.int16],
+                 scale_factor: float = ...,
+                 add_offset: float = ...,
+                 fill_value: Optional[int] = ...) -> None:
         ...
 
     def __getstate__(self) -> tuple:
@@ -1329,29 +1536,37 @@ class TemporalGrid4DFloat32:
         ...
 
     @property
-    def array(self) -> numpy.ndarray[numpy.float32]:
+    def add_offset(self) -> float:
         ...
 
     @property
-    def u(self) -> Axis:
+    def array(self) -> numpy.ndarray[numpy.int16]:
         ...
 
     @property
-    def x(self) -> Axis:
+    def fill_value(self) -> Optional[int]:
         ...
 
     @property
-    def y(self) -> Axis:
+    def scale_factor(self) -> float:
         ...
 
     @property
-    def z(self) -> AxisInt64:
+    def x(self) -> Axis:
         ...
 
+    @property
+    def y(self) -> Axis:
+        ...
 
-class TemporalGrid4DFloat64:
-    def __init__(self, x: Axis, y: Axis, z: AxisInt64, u: Axis,
-                 array: numpy.ndarray[numpy.float64]) -> None:
+
+class Grid3DFloat16:
+    def __init__(self,
+                 x: Axis, y: Axis, z: Axis,
+                 array: numpy.ndarray[numpy.uint16],
+                 scale_factor: float = ...,
+                 add_offset: float = ...,
+                 fill_value: Optional[int] = ...) -> None:
         ...
 
     def __getstate__(self) -> tuple:
@@ -1361,11 +1576,19 @@ class TemporalGrid4DFloat64:
         ...
 
     @property
-    def array(self) -> numpy.ndarray[numpy.float64]:
+    def add_offset(self) -> float:
         ...
 
     @property
-    def u(self) -> Axis:
+    def array(self) -> numpy.ndarray[numpy.uint16]:
+        ...
+
+    @property
+    def fill_value(self) -> Optional[int]:
+        ...
+
+    @property
+    def scale_factor(self) -> float:
         ...
 
     @property
@@ -1377,13 +1600,13 @@ class TemporalGrid4DFloat64:
         ...
 
     @property
-    def z(self) -> AxisInt64:
+    def z(self) -> Axis:
         ...
 
 
-class TemporalGrid4DInt8:
-    def __init__(self, x: Axis, y: Axis, z: AxisInt64, u: Axis,
-                 array: numpy.ndarray[numpy.int8]) -> None:
+class Grid3DFloat32:
+    def __init__(self, x: Axis, y: Axis, z: Axis,
+                 array: numpy.ndarray[numpy.float32]) -> None:
         ...
 
     def __getstate__(self) -> tuple:
@@ -1392,12 +1615,11 @@ class TemporalGrid4DInt8:
     def __setstate__(self, arg0: tuple) -> None:
         ...
 
-    @property
-    def array(self) -> numpy.ndarray[numpy.int8]:
+    def view(self, x: slice, y: slice, z: slice) -> Grid3DFloat32:
         ...
 
     @property
-    def u(self) -> Axis:
+    def array(self) -> numpy.ndarray[numpy.float32]:
         ...
 
     @property
@@ -1409,493 +1631,3875 @@ class TemporalGrid4DInt8:
         ...
 
     @property
-    def z(self) -> AxisInt64:
+    def z(self) -> Axis:
         ...
 
 
-class TemporalInverseDistanceWeighting3D(TemporalBivariateInterpolator3D):
-    def __init__(self, p: int = ...) -> None:
+class Grid3DFloat64:
+    def __init__(self, x: Axis, y: Axis, z: Axis,
+                 array: numpy.ndarray[numpy.float64]) -> None:
+        ...
+
+    def __getstate__(self) -> tuple:
+        ...
+
+    def __setstate__(self, arg0: tuple) -> None:
+        ...
+
+    def view(self, x: slice, y: slice, z: slice) -> Grid3DFloat64:
+        ...
+
+    @property
+    def array(self) -> numpy.ndarray[numpy.float64]:
+        ...
+
+    @property
+    def x(self) -> Axis:
+        ...
+
+    @property
+    def y(self) -> Axis:
+        ...
+
+    @property
+    def z(self) -> Axis:
+        ...
+
+
+class Grid3DInt8:
+    def __init__(self, x: Axis, y: Axis, z: Axis,
+                 array: numpy.ndarray[numpy.int8]) -> None:
+        ...
+
+    def __getstate__(self) -> tuple:
+        ...
+
+    def __setstate__(self, arg0: tuple) -> None:
+        ...
+
+    def view(self, x: slice, y: slice, z: slice) -> Grid3DInt8:
+        ...
+
+    @property
+    def array(self) -> numpy.ndarray[numpy.int8]:
+        ...
+
+    @property
+    def x(self) -> Axis:
+        ...
+
+    @property
+    def y(self) -> Axis:
+        ...
+
+    @property
+    def z(self) -> Axis:
+        ...
+
+
+class Grid3DInt16:
+    def __init__(self,
+                 x: Axis, y: Axis, z: Axis,
+                 array: numpy.ndarray[numpy.int16],
+                 scale_factor: float = ...,
+                 add_offset: float = ...,
+                 fill_value: Optional[int] = ...) -> None:
+        ...
+
+    def __getstate__(self) -> tuple:
+        ...
+
+    def __setstate__(self, arg0: tuple) -> None:
+        ...
+
+    @property
+    def add_offset(self) -> float:
+        ...
+
+    @property
+    def array(self) -> numpy.ndarray[numpy.int16]:
+        ...
+
+    @property
+    def fill_value(self) -> Optional[int]:
+        ...
+
+    @property
+    def scale_factor(self) -> float:
+        ...
+
+    @property
+    def x(self) -> Axis:
+        ...
+
+    @property
+    def y(self) -> Axis:
+        ...
+
+    @property
+    def z(self) -> Axis:
+        ...
+
+
+class Grid4DFloat32:
+    def __init__(self, x: Axis, y: Axis, z: Axis, u: Axis,
+                 array: numpy.ndarray[numpy.float32]) -> None:
+        ...
+
+    def __getstate__(self) -> tuple:
+        ...
+
+    def __setstate__(self, arg0: tuple) -> None:
+        ...
+
+    @property
+    def array(self) -> numpy.ndarray[numpy.float32]:
+        ...
+
+    @property
+    def u(self) -> Axis:
+        ...
+
+    @property
+    def x(self) -> Axis:
+        ...
+
+    @property
+    def y(self) -> Axis:
+        ...
+
+    @property
+    def z(self) -> Axis:
+        ...
+
+
+class Grid4DFloat64:
+    def __init__(self, x: Axis, y: Axis, z: Axis, u: Axis,
+                 array: numpy.ndarray[numpy.float64]) -> None:
+        ...
+
+    def __getstate__(self) -> tuple:
+        ...
+
+    def __setstate__(self, arg0: tuple) -> None:
+        ...
+
+    @property
+    def array(self) -> numpy.ndarray[numpy.float64]:
+        ...
+
+    @property
+    def u(self) -> Axis:
+        ...
+
+    @property
+    def x(self) -> Axis:
+        ...
+
+    @property
+    def y(self) -> Axis:
+        ...
+
+    @property
+    def z(self) -> Axis:
+        ...
+
+
+class Grid4DInt8:
+    def __init__(self, x: Axis, y: Axis, z: Axis, u: Axis,
+                 array: numpy.ndarray[numpy.int8]) -> None:
+        ...
+
+    def __getstate__(self) -> tuple:
+        ...
+
+    def __setstate__(self, arg0: tuple) -> None:
+        ...
+
+    @property
+    def array(self) -> numpy.ndarray[numpy.int8]:
+        ...
+
+    @property
+    def u(self) -> Axis:
+        ...
+
+    @property
+    def x(self) -> Axis:
+        ...
+
+    @property
+    def y(self) -> Axis:
+        ...
+
+    @property
+    def z(self) -> Axis:
+        ...
+
+
+class Histogram2DFloat32:
+    def __init__(self,
+                 x: Axis,
+                 y: Axis,
+                 bins: Optional[int] = ...,
+                 sparse: bool = ...) -> None:
+        ...
+
+    def clear(self) -> None:
+        ...
+
+    def count(self) -> numpy.ndarray[numpy.uint64]:
+        ...
+
+    def histograms(self, *args, **kwargs) -> Any:
+        ...
+
+    def kurtosis(self) -> numpy.ndarray[numpy.float32]:
+        ...
+
+    def max(self) -> numpy.ndarray[numpy.float32]:
+        ...
+
+    def mean(self) -> numpy.ndarray[numpy.float32]:
+        ...
+
+    def merge(self, state: tuple) -> None:
+        ...
+
+    def min(self) -> numpy.ndarray[numpy.float32]:
+        ...
+
+    def push(self, x: numpy.ndarray[numpy.float32],
+             y: numpy.ndarray[numpy.float32],
+             z: numpy.ndarray[numpy.float32]) -> None:
         ...
 
-    def __getstate__(self) -> tuple:
-        ...
+    def quantile(self, q: float = ...) -> numpy.ndarray[numpy.float32]:
+        ...
+
+    def quantiles(self,
+                  q: numpy.ndarray[numpy.float32],
+                  num_threads: int = ...) -> numpy.ndarray[numpy.float32]:
+        ...
+
+    def skewness(self) -> numpy.ndarray[numpy.float32]:
+        ...
+
+    def sum_of_weights(self) -> numpy.ndarray[numpy.float32]:
+        ...
+
+    def variance(self) -> numpy.ndarray[numpy.float32]:
+        ...
+
+    def __getstate__(self) -> tuple:
+        ...
+
+    def __iadd__(self, arg0: Histogram2DFloat32) -> Histogram2DFloat32:
+        ...
+
+    def __setstate__(self, arg0: tuple) -> None:
+        ...
+
+    @property
+    def sparse(self) -> bool:
+        ...
+
+    @property
+    def x(self) -> Axis:
+        ...
+
+    @property
+    def y(self) -> Axis:
+        ...
+
+
+class Histogram2DFloat64:
+    def __init__(self,
+                 x: Axis,
+                 y: Axis,
+                 bins: Optional[int] = ...,
+                 sparse: bool = ...) -> None:
+        ...
+
+    def clear(self) -> None:
+        ...
+
+    def count(self) -> numpy.ndarray[numpy.uint64]:
+        ...
+
+    def histograms(self, *args, **kwargs) -> Any:
+        ...
+
+    def kurtosis(self) -> numpy.ndarray[numpy.float64]:
+        ...
+
+    def max(self) -> numpy.ndarray[numpy.float64]:
+        ...
+
+    def mean(self) -> numpy.ndarray[numpy.float64]:
+        ...
+
+    def merge(self, state: tuple) -> None:
+        ...
+
+    def min(self) -> numpy.ndarray[numpy.float64]:
+        ...
+
+    def push(self, x: numpy.ndarray[numpy.float64],
+             y: numpy.ndarray[numpy.float64],
+             z: numpy.ndarray[numpy.float64]) -> None:
+        ...
+
+    def quantile(self, q: float = ...) -> numpy.ndarray[numpy.float64]:
+        ...
+
+    def quantiles(self,
+                  q: numpy.ndarray[numpy.float64],
+                  num_threads: int = ...) -> numpy.ndarray[numpy.float64]:
+        ...
+
+    def skewness(self) -> numpy.ndarray[numpy.float64]:
+        ...
+
+    def sum_of_weights(self) -> numpy.ndarray[numpy.float64]:
+        ...
+
+    def variance(self) -> numpy.ndarray[numpy.float64]:
+        ...
+
+    def __getstate__(self) -> tuple:
+        ...
+
+    def __iadd__(self, arg0: Histogram2DFloat64) -> Histogram2DFloat64:
+        ...
+
+    def __setstate__(self, arg0: tuple) -> None:
+        ...
+
+    @property
+    def sparse(self) -> bool:
+        ...
+
+    @property
+    def x(self) -> Axis:
+        ...
+
+    @property
+    def y(self) -> Axis:
+        ...
+
+
+class InterpolationPlan:
+    def __init__(self, nx: int, ny: int,
+                 indptr: numpy.ndarray[numpy.int64],
+                 indices: numpy.ndarray[numpy.int64],
+                 weights: numpy.ndarray[numpy.float64]) -> None:
+        ...
+
+    @overload
+    def apply(
+        self,
+        array: numpy.ndarray[numpy.float64],
+        normalize: bool = ...,
+        num_threads: int = ...,
+        out: Optional[numpy.ndarray[numpy.float64]] = ...
+    ) -> numpy.ndarray[numpy.float64]:
+        ...
+
+    @overload
+    def apply(
+        self,
+        array: numpy.ndarray[numpy.float32],
+        normalize: bool = ...,
+        num_threads: int = ...,
+        out: Optional[numpy.ndarray[numpy.float64]] = ...
+    ) -> numpy.ndarray[numpy.float64]:
+        ...
+
+    def __getstate__(self) -> tuple:
+        ...
+
+    def __len__(self) -> int:
+        ...
+
+    def __setstate__(self, arg0: tuple) -> None:
+        ...
+
+    @property
+    def indices(self) -> numpy.ndarray[numpy.int64]:
+        ...
+
+    @property
+    def indptr(self) -> numpy.ndarray[numpy.int64]:
+        ...
+
+    @property
+    def shape(self) -> Tuple[int, int]:
+        ...
+
+    @property
+    def weights(self) -> numpy.ndarray[numpy.float64]:
+        ...
+
+
+class InverseDistanceWeighting2D(BivariateInterpolator2D):
+    def __init__(self, p: int = ...) -> None:
+        ...
+
+    def __getstate__(self) -> tuple:
+        ...
+
+    def __setstate__(self, arg0: tuple) -> None:
+        ...
+
+
+class InverseDistanceWeighting2DFloat32(BivariateInterpolator2DFloat32):
+    def __init__(self, p: int = ...) -> None:
+        ...
+
+    def __getstate__(self) -> tuple:
+        ...
+
+    def __setstate__(self, arg0: tuple) -> None:
+        ...
+
+
+class InverseDistanceWeighting3D(BivariateInterpolator3D):
+    def __init__(self, p: int = ...) -> None:
+        ...
+
+    def __getstate__(self) -> tuple:
+        ...
+
+    def __setstate__(self, arg0: tuple) -> None:
+        ...
+
+
+class Nearest2D(BivariateInterpolator2D):
+    def __init__(self) -> None:
+        ...
+
+    def __getstate__(self) -> tuple:
+        ...
+
+    def __setstate__(self, arg0: tuple) -> None:
+        ...
+
+
+class Nearest2DFloat32(BivariateInterpolator2DFloat32):
+    def __init__(self) -> None:
+        ...
+
+    def __getstate__(self) -> tuple:
+        ...
+
+    def __setstate__(self, arg0: tuple) -> None:
+        ...
+
+
+class Nearest3D(BivariateInterpolator3D):
+    def __init__(self) -> None:
+        ...
+
+    def __getstate__(self) -> tuple:
+        ...
+
+    def __setstate__(self, arg0: tuple) -> None:
+        ...
+
+
+class PipelineFloat32:
+    def __init__(self,
+                 binning: List[Binning2DFloat32] = ...,
+                 histograms: List[Histogram2DFloat32] = ...,
+                 simple: bool = ...,
+                 num_threads: int = ...) -> None:
+        ...
+
+    def run(self, chunks: Iterable[Tuple[numpy.ndarray, numpy.ndarray,
+                                         numpy.ndarray]]) -> None:
+        ...
+
+    def __len__(self) -> int:
+        ...
+
+
+class PipelineFloat64:
+    def __init__(self,
+                 binning: List[Binning2DFloat64] = ...,
+                 histograms: List[Histogram2DFloat64] = ...,
+                 simple: bool = ...,
+                 num_threads: int = ...) -> None:
+        ...
+
+    def run(self, chunks: Iterable[Tuple[numpy.ndarray, numpy.ndarray,
+                                         numpy.ndarray]]) -> None:
+        ...
+
+    def __len__(self) -> int:
+        ...
+
+
+class PreparedBivariate:
+    def __init__(self,
+                 grid: Union[Grid2DFloat64, Grid2DFloat32, Grid2DInt8,
+                             Grid2DInt16, Grid2DFloat16, TiledGrid2DFloat64,
+                             TiledGrid2DFloat32],
+                 interpolator: Union[BivariateInterpolator2D,
+                                     BivariateInterpolator2DFloat32],
+                 bounds_error: bool = ...,
+                 num_threads: int = ...,
+                 fill_holes: Optional[Tuple[int, int]] = ...) -> None:
+        ...
+
+    def __call__(self,
+                 x: numpy.ndarray,
+                 y: numpy.ndarray,
+                 out: Optional[numpy.ndarray] = ...) -> numpy.ndarray:
+        ...
+
+
+class RTree3DFloat32:
+    def __init__(self, system: Optional[geodetic.System]) -> None:
+        ...
+
+    def bounds(self) -> tuple:
+        ...
+
+    def clear(self) -> None:
+        ...
+
+    def compact_radial_basis_function(
+            self,
+            coordinates: numpy.ndarray,
+            radius: float,
+            smooth: float = ...,
+            max_iterations: int = ...,
+            tolerance: float = ...,
+            num_threads: int = ...) -> tuple:
+        ...
+
+    def insert(self,
+               coordinates: numpy.ndarray,
+               values: numpy.ndarray[numpy.float32],
+               num_threads: int = ...) -> None:
+        ...
+
+    def inverse_distance_weighting(
+            self,
+            coordinates: numpy.ndarray,
+            radius: Optional[float],
+            k: int = ...,
+            p: int = ...,
+            within: bool = ...,
+            num_threads: int = ...,
+            out: Optional[Tuple[numpy.ndarray, numpy.ndarray]] = ...,
+            eps: float = ...) -> tuple:
+        ...
+
+    def kriging(self,
+                coordinates: numpy.ndarray,
+                radius: Optional[float],
+                k: int = ...,
+                covariance: CovarianceFunction = ...,
+                sigma: float = ...,
+                lambda_: float = ...,
+                nugget: float = ...,
+                within: bool = ...,
+                num_threads: int = ...) -> tuple:
+        ...
+
+    def packing(self, coordinates: numpy.ndarray,
+                values: numpy.ndarray[numpy.float32]) -> None:
+        ...
+
+    def remove(self,
+               predicate: Callable[[
+                   numpy.ndarray[numpy.float32], numpy.ndarray[numpy.float32]
+               ], numpy.ndarray[numpy.bool_]],
+               num_threads: int = ...) -> int:
+        ...
+
+    def query(
+            self,
+            coordinates: numpy.ndarray,
+            k: int = ...,
+            within: bool = ...,
+            num_threads: int = ...,
+            out: Optional[Tuple[numpy.ndarray, numpy.ndarray]] = ...,
+            eps: float = ...) -> tuple:
+        ...
+
+    def radial_basis_function(self,
+                              coordinates: numpy.ndarray,
+                              radius: Optional[float],
+                              k: int = ...,
+                              rbf: RadialBasisFunction = ...,
+                              epsilon: Optional[float] = ...,
+                              smooth: float = ...,
+                              within: bool = ...,
+                              num_threads: int = ...) -> tuple:
+        ...
+
+    def window_function(self,
+                        coordinates: numpy.ndarray,
+                        radius: float,
+                        k: int = ...,
+                        wf: WindowFunction = ...,
+                        arg: Optional[float] = ...,
+                        within: bool = ...,
+                        table_size: int = ...,
+                        num_threads: int = ...,
+                        eps: float = ...) -> tuple:
+        ...
+
+    def __bool__(self) -> bool:
+        ...
+
+    def __getstate__(self) -> tuple:
+        ...
+
+    def __len__(self) -> int:
+        ...
+
+    def __setstate__(self, arg0: tuple) -> None:
+        ...
+
+
+class RTree3DFloat32Float64:
+    def __init__(self, system: Optional[geodetic.System]) -> None:
+        ...
+
+    def bounds(self) -> tuple:
+        ...
+
+    def clear(self) -> None:
+        ...
+
+    def compact_radial_basis_function(
+            self,
+            coordinates: numpy.ndarray,
+            radius: float,
+            smooth: float = ...,
+            max_iterations: int = ...,
+            tolerance: float = ...,
+            num_threads: int = ...) -> tuple:
+        ...
+
+    def insert(self,
+               coordinates: numpy.ndarray,
+               values: numpy.ndarray[numpy.float64],
+               num_threads: int = ...) -> None:
+        ...
+
+    def inverse_distance_weighting(
+            self,
+            coordinates: numpy.ndarray,
+            radius: Optional[float],
+            k: int = ...,
+            p: int = ...,
+            within: bool = ...,
+            num_threads: int = ...,
+            out: Optional[Tuple[numpy.ndarray, numpy.ndarray]] = ...,
+            eps: float = ...) -> tuple:
+        ...
+
+    def kriging(self,
+                coordinates: numpy.ndarray,
+                radius: Optional[float],
+                k: int = ...,
+                covariance: CovarianceFunction = ...,
+                sigma: float = ...,
+                lambda_: float = ...,
+                nugget: float = ...,
+                within: bool = ...,
+                num_threads: int = ...) -> tuple:
+        ...
+
+    def packing(self, coordinates: numpy.ndarray,
+                values: numpy.ndarray[numpy.float64]) -> None:
+        ...
+
+    def remove(self,
+               predicate: Callable[[
+                   numpy.ndarray[numpy.float64], numpy.ndarray[numpy.float64]
+               ], numpy.ndarray[numpy.bool_]],
+               num_threads: int = ...) -> int:
+        ...
+
+    def query(
+            self,
+            coordinates: numpy.ndarray,
+            k: int = ...,
+            within: bool = ...,
+            num_threads: int = ...,
+            out: Optional[Tuple[numpy.ndarray, numpy.ndarray]] = ...,
+            eps: float = ...) -> tuple:
+        ...
+
+    def radial_basis_function(self,
+                              coordinates: numpy.ndarray,
+                              radius: Optional[float],
+                              k: int = ...,
+                              rbf: RadialBasisFunction = ...,
+                              epsilon: Optional[float] = ...,
+                              smooth: float = ...,
+                              within: bool = ...,
+                              num_threads: int = ...) -> tuple:
+        ...
+
+    def window_function(self,
+                        coordinates: numpy.ndarray,
+                        radius: float,
+                        k: int = ...,
+                        wf: WindowFunction = ...,
+                        arg: Optional[float] = ...,
+                        within: bool = ...,
+                        table_size: int = ...,
+                        num_threads: int = ...,
+                        eps: float = ...) -> tuple:
+        ...
+
+    def __bool__(self) -> bool:
+        ...
+
+    def __getstate__(self) -> tuple:
+        ...
+
+    def __len__(self) -> int:
+        ...
+
+    def __setstate__(self, arg0: tuple) -> None:
+        ...
+
+
+class RTree3DFloat64:
+    def __init__(self, system: Optional[geodetic.System]) -> None:
+        ...
+
+    def bounds(self) -> tuple:
+        ...
+
+    def clear(self) -> None:
+        ...
+
+    def compact_radial_basis_function(
+            self,
+            coordinates: numpy.ndarray,
+            radius: float,
+            smooth: float = ...,
+            max_iterations: int = ...,
+            tolerance: float = ...,
+            num_threads: int = ...) -> tuple:
+        ...
+
+    def insert(self,
+               coordinates: numpy.ndarray,
+               values: numpy.ndarray[numpy.float64],
+               num_threads: int = ...) -> None:
+        ...
+
+    def inverse_distance_weighting(
+            self,
+            coordinates: numpy.ndarray,
+            radius: Optional[float],
+            k: int = ...,
+            p: int = ...,
+            within: bool = ...,
+            num_threads: int = ...,
+            out: Optional[Tuple[numpy.ndarray, numpy.ndarray]] = ...,
+            eps: float = ...) -> tuple:
+        ...
+
+    def kriging(self,
+                coordinates: numpy.ndarray,
+                radius: Optional[float],
+                k: int = ...,
+                covariance: CovarianceFunction = ...,
+                sigma: float = ...,
+                lambda_: float = ...,
+                nugget: float = ...,
+                within: bool = ...,
+                num_threads: int = ...) -> tuple:
+        ...
+
+    def packing(self, coordinates: numpy.ndarray,
+                values: numpy.ndarray[numpy.float64]) -> None:
+        ...
+
+    def remove(self,
+               predicate: Callable[[
+                   numpy.ndarray[numpy.float64], numpy.ndarray[numpy.float64]
+               ], numpy.ndarray[numpy.bool_]],
+               num_threads: int = ...) -> int:
+        ...
+
+    def query(
+            self,
+            coordinates: numpy.ndarray,
+            k: int = ...,
+            within: bool = ...,
+            num_threads: int = ...,
+            out: Optional[Tuple[numpy.ndarray, numpy.ndarray]] = ...,
+            eps: float = ...) -> tuple:
+        ...
+
+    def radial_basis_function(self,
+                              coordinates: numpy.ndarray,
+                              radius: Optional[float],
+                              k: int = ...,
+                              rbf: RadialBasisFunction = ...,
+                              epsilon: Optional[float] = ...,
+                              smooth: float = ...,
+                              within: bool = ...,
+                              num_threads: int = ...) -> tuple:
+        ...
+
+    def window_function(self,
+                        coordinates: numpy.ndarray,
+                        radius: float,
+                        k: int = ...,
+                        wf: WindowFunction = ...,
+                        arg: Optional[float] = ...,
+                        within: bool = ...,
+                        table_size: int = ...,
+                        num_threads: int = ...,
+                        eps: float = ...) -> tuple:
+        ...
+
+    def __bool__(self) -> bool:
+        ...
+
+    def __getstate__(self) -> tuple:
+        ...
+
+    def __len__(self) -> int:
+        ...
+
+    def __setstate__(self, arg0: tuple) -> None:
+        ...
+
+
+class RadialBasisFunction:
+    __doc__: ClassVar[str] = ...  # read-only
+    __members__: ClassVar[dict] = ...  # read-only
+    Cubic: ClassVar[RadialBasisFunction] = ...
+    Gaussian: ClassVar[RadialBasisFunction] = ...
+    InverseMultiquadric: ClassVar[RadialBasisFunction] = ...
+    Linear: ClassVar[RadialBasisFunction] = ...
+    Multiquadric: ClassVar[RadialBasisFunction] = ...
+    ThinPlate: ClassVar[RadialBasisFunction] = ...
+    __entries: ClassVar[dict] = ...
+
+    def __init__(self, value: int) -> None:
+        ...
+
+    def __eq__(self, other: object) -> bool:
+        ...
+
+    def __getstate__(self) -> int:
+        ...
+
+    def __hash__(self) -> int:
+        ...
+
+    def __index__(self) -> int:
+        ...
+
+    def __int__(self) -> int:
+        ...
+
+    def __ne__(self, other: object) -> bool:
+        ...
+
+    def __setstate__(self, state: int) -> None:
+        ...
+
+    @property
+    def name(self) -> str:
+        ...
+
+    @property
+    def value(self) -> int:
+        ...
+
+
+class ShardedRTree3DFloat32:
+    def __init__(self, system: Optional[geodetic.System],
+                 precision: int) -> None:
+        ...
+
+    def clear(self) -> None:
+        ...
+
+    def inverse_distance_weighting(self,
+                                   coordinates: numpy.ndarray,
+                                   radius: Optional[float] = ...,
+                                   k: int = ...,
+                                   p: int = ...,
+                                   num_threads: int = ...) -> tuple:
+        ...
+
+    def keys(self) -> List[int]:
+        ...
+
+    def load(self, key: int, path: str) -> None:
+        ...
+
+    def packing(self,
+                coordinates: numpy.ndarray,
+                values: numpy.ndarray[numpy.float32],
+                num_threads: int = ...) -> None:
+        ...
+
+    def query(self,
+              coordinates: numpy.ndarray,
+              k: int = ...,
+              radius: Optional[float] = ...,
+              num_threads: int = ...) -> tuple:
+        ...
+
+    def save(self, key: int, path: str) -> None:
+        ...
+
+    def shard_size(self, key: int) -> int:
+        ...
+
+    def shards(self) -> int:
+        ...
+
+    def __bool__(self) -> bool:
+        ...
+
+    def __len__(self) -> int:
+        ...
+
+    @property
+    def precision(self) -> int:
+        ...
+
+
+class ShardedRTree3DFloat64:
+    def __init__(self, system: Optional[geodetic.System],
+                 precision: int) -> None:
+        ...
+
+    def clear(self) -> None:
+        ...
+
+    def inverse_distance_weighting(self,
+                                   coordinates: numpy.ndarray,
+                                   radius: Optional[float] = ...,
+                                   k: int = ...,
+                                   p: int = ...,
+                                   num_threads: int = ...) -> tuple:
+        ...
+
+    def keys(self) -> List[int]:
+        ...
+
+    def load(self, key: int, path: str) -> None:
+        ...
+
+    def packing(self,
+                coordinates: numpy.ndarray,
+                values: numpy.ndarray[numpy.float64],
+                num_threads: int = ...) -> None:
+        ...
+
+    def query(self,
+              coordinates: numpy.ndarray,
+              k: int = ...,
+              radius: Optional[float] = ...,
+              num_threads: int = ...) -> tuple:
+        ...
+
+    def save(self, key: int, path: str) -> None:
+        ...
+
+    def shard_size(self, key: int) -> int:
+        ...
+
+    def shards(self) -> int:
+        ...
+
+    def __bool__(self) -> bool:
+        ...
+
+    def __len__(self) -> int:
+        ...
+
+    @property
+    def precision(self) -> int:
+        ...
+
+
+class StreamingHistogramFloat32:
+    def __init__(self,
+                 values: numpy.ndarray[numpy.float32],
+                 weights: Optional[numpy.ndarray[numpy.float32]] = ...,
+                 axis: Optional[List[int]] = ...,
+                 bin_count: Optional[int] = ...) -> None:
+        ...
+
+    def bins(self, *args, **kwargs) -> Any:
+        ...
+
+    def count(self) -> numpy.ndarray[numpy.uint64]:
+        ...
+
+    def kurtosis(self) -> numpy.ndarray[numpy.float32]:
+        ...
+
+    def max(self) -> numpy.ndarray[numpy.float32]:
+        ...
+
+    def mean(self) -> numpy.ndarray[numpy.float32]:
+        ...
+
+    def min(self) -> numpy.ndarray[numpy.float32]:
+        ...
+
+    def quantile(self, q: float = ...) -> numpy.ndarray[numpy.float32]:
+        ...
+
+    def quantiles(self,
+                  q: numpy.ndarray[numpy.float32],
+                  num_threads: int = ...) -> numpy.ndarray[numpy.float32]:
+        ...
+
+    def resize(self, arg0: int) -> None:
+        ...
+
+    def size(self) -> numpy.ndarray[numpy.uint64]:
+        ...
+
+    def skewness(self) -> numpy.ndarray[numpy.float32]:
+        ...
+
+    def sum_of_weights(self) -> numpy.ndarray[numpy.float32]:
+        ...
+
+    def variance(self) -> numpy.ndarray[numpy.float32]:
+        ...
+
+    def __add__(self,
+                other: StreamingHistogramFloat32) -> StreamingHistogramFloat32:
+        ...
+
+    def __getstate__(self) -> tuple:
+        ...
+
+    def __iadd__(
+            self,
+            other: StreamingHistogramFloat32) -> StreamingHistogramFloat32:
+        ...
+
+    def __setstate__(self, arg0: tuple) -> None:
+        ...
+
+
+class StreamingHistogramFloat64:
+    def __init__(self,
+                 values: numpy.ndarray[numpy.float64],
+                 weights: Optional[numpy.ndarray[numpy.float64]] = ...,
+                 axis: Optional[List[int]] = ...,
+                 bin_count: Optional[int] = ...) -> None:
+        ...
+
+    def bins(self, *args, **kwargs) -> Any:
+        ...
+
+    def count(self) -> numpy.ndarray[numpy.uint64]:
+        ...
+
+    def kurtosis(self) -> numpy.ndarray[numpy.float64]:
+        ...
+
+    def max(self) -> numpy.ndarray[numpy.float64]:
+        ...
+
+    def mean(self) -> numpy.ndarray[numpy.float64]:
+        ...
+
+    def min(self) -> numpy.ndarray[numpy.float64]:
+        ...
+
+    def quantile(self, q: float = ...) -> numpy.ndarray[numpy.float64]:
+        ...
+
+    def quantiles(self,
+                  q: numpy.ndarray[numpy.float64],
+                  num_threads: int = ...) -> numpy.ndarray[numpy.float64]:
+        ...
+
+    def resize(self, arg0: int) -> None:
+        ...
+
+    def size(self) -> numpy.ndarray[numpy.uint64]:
+        ...
+
+    def skewness(self) -> numpy.ndarray[numpy.float64]:
+        ...
+
+    def sum_of_weights(self) -> numpy.ndarray[numpy.float64]:
+        ...
+
+    def variance(self) -> numpy.ndarray[numpy.float64]:
+        ...
+
+    def __add__(self,
+                other: StreamingHistogramFloat64) -> StreamingHistogramFloat64:
+        ...
+
+    def __getstate__(self) -> tuple:
+        ...
+
+    def __iadd__(
+            self,
+            other: StreamingHistogramFloat64) -> StreamingHistogramFloat64:
+        ...
+
+    def __setstate__(self, arg0: tuple) -> None:
+        ...
+
+
+class TemporalAxis(AxisInt64):
+    __hash__: ClassVar[None] = ...
+
+    def __init__(self, values: numpy.ndarray) -> None:
+        ...
+
+    def back(self) -> numpy.ndarray:
+        ...
+
+    def dtype(self) -> numpy.dtype:
+        ...
+
+    def find_index(self,
+                   coordinates: numpy.ndarray,
+                   bounded: bool = ...) -> numpy.ndarray[numpy.int64]:
+        ...
+
+    def find_indexes(self,
+                     coordinates: numpy.ndarray) -> numpy.ndarray[numpy.int64]:
+        ...
+
+    def flip(self, inplace: bool = ...) -> TemporalAxis:
+        ...
+
+    def front(self) -> numpy.ndarray:
+        ...
+
+    def increment(self) -> numpy.ndarray:
+        ...
+
+    def is_ascending(self) -> bool:
+        ...
+
+    def is_regular(self) -> bool:
+        ...
+
+    def max_value(self) -> numpy.ndarray:
+        ...
+
+    def min_value(self) -> numpy.ndarray:
+        ...
+
+    def safe_cast(self, values: numpy.ndarray) -> numpy.ndarray:
+        ...
+
+    def __eq__(self, other: TemporalAxis) -> bool:
+        ...
+
+    @overload
+    def __getitem__(self, index: int) -> numpy.ndarray:
+        ...
+
+    @overload
+    def __getitem__(self, indices: slice) -> numpy.ndarray:
+        ...
+
+    def __getstate__(self) -> tuple:
+        ...
+
+    def __len__(self) -> int:
+        ...
+
+    def __ne__(self, other: TemporalAxis) -> bool:
+        ...
+
+    def __setstate__(self, arg0: tuple) -> None:
+        ...
+
+
+class TemporalBilinear3D(TemporalBivariateInterpolator3D):
+    def __init__(self) -> None:
+        ...
+
+    def __getstate__(self) -> tuple:
+        ...
+
+    def __setstate__(self, arg0: tuple) -> None:
+        ...
+
+
+class TemporalBinning3DFloat32:
+    def __init__(self,
+                 x: Axis,
+                 y: Axis,
+                 z: AxisInt64,
+                 wgs: Optional[geodetic.System] = ...,
+                 sparse: bool = ...) -> None:
+        ...
+
+    def clear(self) -> None:
+        ...
+
+    def count(self) -> numpy.ndarray[numpy.uint64]:
+        ...
+
+    def kurtosis(self) -> numpy.ndarray[numpy.float32]:
+        ...
+
+    def max(self) -> numpy.ndarray[numpy.float32]:
+        ...
+
+    def mean(self) -> numpy.ndarray[numpy.float32]:
+        ...
+
+    def merge(self, state: tuple) -> None:
+        ...
+
+    def min(self) -> numpy.ndarray[numpy.float32]:
+        ...
+
+    def push(self,
+             x: numpy.ndarray[numpy.float32],
+             y: numpy.ndarray[numpy.float32],
+             z: numpy.ndarray,
+             values: numpy.ndarray[numpy.float32],
+             simple: bool = ...,
+             num_threads: int = ...) -> None:
+        ...
+
+    def skewness(self) -> numpy.ndarray[numpy.float32]:
+        ...
+
+    def sum(self) -> numpy.ndarray[numpy.float32]:
+        ...
+
+    def sum_of_weights(self) -> numpy.ndarray[numpy.float32]:
+        ...
+
+    def variance(self, ddof: int = ...) -> numpy.ndarray[numpy.float32]:
+        ...
+
+    def __getstate__(self) -> tuple:
+        ...
+
+    def __iadd__(self, arg0: TemporalBinning3DFloat32) -> TemporalBinning3DFloat32:
+        ...
+
+    def __setstate__(self, arg0: tuple) -> None:
+        ...
+
+    @property
+    def sparse(self) -> bool:
+        ...
+
+    @property
+    def wgs(self) -> Optional[geodetic.System]:
+        ...
+
+    @property
+    def x(self) -> Axis:
+        ...
+
+    @property
+    def y(self) -> Axis:
+        ...
+
+    @property
+    def z(self) -> AxisInt64:
+        ...
+
+
+class TemporalBinning3DFloat64:
+    def __init__(self,
+                 x: Axis,
+                 y: Axis,
+                 z: AxisInt64,
+                 wgs: Optional[geodetic.System] = ...,
+                 sparse: bool = ...) -> None:
+        ...
+
+    def clear(self) -> None:
+        ...
+
+    def count(self) -> numpy.ndarray[numpy.uint64]:
+        ...
+
+    def kurtosis(self) -> numpy.ndarray[numpy.float64]:
+        ...
+
+    def max(self) -> numpy.ndarray[numpy.float64]:
+        ...
+
+    def mean(self) -> numpy.ndarray[numpy.float64]:
+        ...
+
+    def merge(self, state: tuple) -> None:
+        ...
+
+    def min(self) -> numpy.ndarray[numpy.float64]:
+        ...
+
+    def push(self,
+             x: numpy.ndarray[numpy.float64],
+             y: numpy.ndarray[numpy.float64],
+             z: numpy.ndarray,
+             values: numpy.ndarray[numpy.float64],
+             simple: bool = ...,
+             num_threads: int = ...) -> None:
+        ...
+
+    def skewness(self) -> numpy.ndarray[numpy.float64]:
+        ...
+
+    def sum(self) -> numpy.ndarray[numpy.float64]:
+        ...
+
+    def sum_of_weights(self) -> numpy.ndarray[numpy.float64]:
+        ...
+
+    def variance(self, ddof: int = ...) -> numpy.ndarray[numpy.float64]:
+        ...
+
+    def __getstate__(self) -> tuple:
+        ...
+
+    def __iadd__(self, arg0: TemporalBinning3DFloat64) -> TemporalBinning3DFloat64:
+        ...
+
+    def __setstate__(self, arg0: tuple) -> None:
+        ...
+
+    @property
+    def sparse(self) -> bool:
+        ...
+
+    @property
+    def wgs(self) -> Optional[geodetic.System]:
+        ...
+
+    @property
+    def x(self) -> Axis:
+        ...
+
+    @property
+    def y(self) -> Axis:
+        ...
+
+    @property
+    def z(self) -> AxisInt64:
+        ...
+
+
+class TemporalBivariateInterpolator3D:
+    def __init__(self, *args, **kwargs) -> None:
+        ...
+
+
+class TemporalChunkedGrid3DFloat32:
+    def __init__(self,
+                 x: Axis,
+                 y: Axis,
+                 z: TemporalAxis,
+                 chunks: Tuple[int, int, int],
+                 reader: Callable[[tuple], numpy.ndarray],
+                 cache_size: int = ...) -> None:
+        ...
+
+    def cached(self) -> int:
+        ...
+
+    def clear_cache(self) -> None:
+        ...
+
+    @property
+    def cache_size(self) -> int:
+        ...
+
+    @property
+    def chunks(self) -> Tuple[int, int, int]:
+        ...
+
+    @property
+    def x(self) -> Axis:
+        ...
+
+    @property
+    def y(self) -> Axis:
+        ...
+
+    @property
+    def z(self) -> TemporalAxis:
+        ...
+
+
+class TemporalChunkedGrid3DFloat64:
+    def __init__(self,
+                 x: Axis,
+                 y: Axis,
+                 z: TemporalAxis,
+                 chunks: Tuple[int, int, int],
+                 reader: Callable[[tuple], numpy.ndarray],
+                 cache_size: int = ...) -> None:
+        ...
+
+    def cached(self) -> int:
+        ...
+
+    def clear_cache(self) -> None:
+        ...
+
+    @property
+    def cache_size(self) -> int:
+        ...
+
+    @property
+    def chunks(self) -> Tuple[int, int, int]:
+        ...
+
+    @property
+    def x(self) -> Axis:
+        ...
+
+    @property
+    def y(self) -> Axis:
+        ...
+
+    @property
+    def z(self) -> TemporalAxis:
+        ...
+
+
+class TemporalChunkedGrid4DFloat32:
+    def __init__(self,
+                 x: Axis,
+                 y: Axis,
+                 z: TemporalAxis,
+                 u: Axis,
+                 chunks: Tuple[int, int, int, int],
+                 reader: Callable[[tuple], numpy.ndarray],
+                 cache_size: int = ...) -> None:
+        ...
+
+    def cached(self) -> int:
+        ...
+
+    def clear_cache(self) -> None:
+        ...
+
+    @property
+    def cache_size(self) -> int:
+        ...
+
+    @property
+    def chunks(self) -> Tuple[int, int, int, int]:
+        ...
+
+    @property
+    def u(self) -> Axis:
+        ...
+
+    @property
+    def x(self) -> Axis:
+        ...
+
+    @property
+    def y(self) -> Axis:
+        ...
+
+    @property
+    def z(self) -> TemporalAxis:
+        ...
+
+    @property
+    def u(self) -> Axis:
+        ...
+
+
+class TemporalChunkedGrid4DFloat64:
+    def __init__(self,
+                 x: Axis,
+                 y: Axis,
+                 z: TemporalAxis,
+                 u: Axis,
+                 chunks: Tuple[int, int, int, int],
+                 reader: Callable[[tuple], numpy.ndarray],
+                 cache_size: int = ...) -> None:
+        ...
+
+    def cached(self) -> int:
+        ...
+
+    def clear_cache(self) -> None:
+        ...
+
+    @property
+    def cache_size(self) -> int:
+        ...
+
+    @property
+    def chunks(self) -> Tuple[int, int, int, int]:
+        ...
+
+    @property
+    def u(self) -> Axis:
+        ...
+
+    @property
+    def x(self) -> Axis:
+        ...
+
+    @property
+    def y(self) -> Axis:
+        ...
+
+    @property
+    def z(self) -> TemporalAxis:
+        ...
+
+    @property
+    def u(self) -> Axis:
+        ...
+
+
+class TemporalGrid3DFloat16:
+    def __init__(self,
+                 x: Axis, y: Axis, z: AxisInt64,
+                 array: numpy.ndarray[numpy.uint16],
+                 scale_factor: float = ...,
+                 add_offset: float = ...,
+                 fill_value: Optional[int] = ...) -> None:
+        ...
+
+    def __getstate__(self) -> tuple:
+        ...
+
+    def __setstate__(self, arg0: tuple) -> None:
+        ...
+
+    @property
+    def add_offset(self) -> float:
+        ...
+
+    @property
+    def array(self) -> numpy.ndarray[numpy.uint16]:
+        ...
+
+    @property
+    def fill_value(self) -> Optional[int]:
+        ...
+
+    @property
+    def scale_factor(self) -> float:
+        ...
+
+    @property
+    def x(self) -> Axis:
+        ...
+
+    @property
+    def y(self) -> Axis:
+        ...
+
+    @property
+    def z(self) -> AxisInt64:
+        ...
+
+
+class TemporalGrid3DFloat32:
+    def __init__(self, x: Axis, y: Axis, z: AxisInt64,
+                 array: numpy.ndarray[numpy.float32]) -> None:
+        ...
+
+    def __getstate__(self) -> tuple:
+        ...
+
+    def __setstate__(self, arg0: tuple) -> None:
+        ...
+
+    def view(self, x: slice, y: slice, z: slice) -> TemporalGrid3DFloat32:
+        ...
+
+    @property
+    def array(self) -> numpy.ndarray[numpy.float32]:
+        ...
+
+    @property
+    def x(self) -> Axis:
+        ...
+
+    @property
+    def y(self) -> Axis:
+        ...
+
+    @property
+    def z(self) -> AxisInt64:
+        ...
+
+
+class TemporalGrid3DFloat64:
+    def __init__(self, x: Axis, y: Axis, z: AxisInt64,
+                 array: numpy.ndarray[numpy.float64]) -> None:
+        ...
+
+    def __getstate__(self) -> tuple:
+        ...
+
+    def __setstate__(self, arg0: tuple) -> None:
+        ...
+
+    def view(self, x: slice, y: slice, z: slice) -> TemporalGrid3DFloat64:
+        ...
+
+    @property
+    def array(self) -> numpy.ndarray[numpy.float64]:
+        ...
+
+    @property
+    def x(self) -> Axis:
+        ...
+
+    @property
+    def y(self) -> Axis:
+        ...
+
+    @property
+    def z(self) -> AxisInt64:
+        ...
+
+
+class TemporalGrid3DInt8:
+    def __init__(self, x: Axis, y: Axis, z: AxisInt64,
+                 array: numpy.ndarray[numpy.int8]) -> None:
+        ...
+
+    def __getstate__(self) -> tuple:
+        ...
+
+    def __setstate__(self, arg0: tuple) -> None:
+        ...
+
+    def view(self, x: slice, y: slice, z: slice) -> TemporalGrid3DInt8:
+        ...
+
+    @property
+    def array(self) -> numpy.ndarray[numpy.int8]:
+        ...
+
+    @property
+    def x(self) -> Axis:
+        ...
+
+    @property
+    def y(self) -> Axis:
+        ...
+
+    @property
+    def z(self) -> AxisInt64:
+        ...
+
+
+class TemporalGrid3DInt16:
+    def __init__(self,
+                 x: Axis, y: Axis, z: AxisInt64,
+                 array: numpy.ndarray[numpy.int16],
+                 scale_factor: float = ...,
+                 add_offset: float = ...,
+                 fill_value: Optional[int] = ...) -> None:
+        ...
+
+    def __getstate__(self) -> tuple:
+        ...
+
+    def __setstate__(self, arg0: tuple) -> None:
+        ...
+
+    @property
+    def add_offset(self) -> float:
+        ...
+
+    @property
+    def array(self) -> numpy.ndarray[numpy.int16]:
+        ...
+
+    @property
+    def fill_value(self) -> Optional[int]:
+        ...
+
+    @property
+    def scale_factor(self) -> float:
+        ...
+
+    @property
+    def x(self) -> Axis:
+        ...
+
+    @property
+    def y(self) -> Axis:
+        ...
+
+    @property
+    def z(self) -> AxisInt64:
+        ...
+
+
+class TemporalGrid4DFloat32:
+    def __init__(self, x: Axis, y: Axis, z: AxisInt64, u: Axis,
+                 array: numpy.ndarray[numpy.float32]) -> None:
+        ...
+
+    def __getstate__(self) -> tuple:
+        ...
+
+    def __setstate__(self, arg0: tuple) -> None:
+        ...
+
+    @property
+    def array(self) -> numpy.ndarray[numpy.float32]:
+        ...
+
+    @property
+    def u(self) -> Axis:
+        ...
+
+    @property
+    def x(self) -> Axis:
+        ...
+
+    @property
+    def y(self) -> Axis:
+        ...
+
+    @property
+    def z(self) -> AxisInt64:
+        ...
+
+
+class TemporalGrid4DFloat64:
+    def __init__(self, x: Axis, y: Axis, z: AxisInt64, u: Axis,
+                 array: numpy.ndarray[numpy.float64]) -> None:
+        ...
+
+    def __getstate__(self) -> tuple:
+        ...
+
+    def __setstate__(self, arg0: tuple) -> None:
+        ...
+
+    @property
+    def array(self) -> numpy.ndarray[numpy.float64]:
+        ...
+
+    @property
+    def u(self) -> Axis:
+        ...
+
+    @property
+    def x(self) -> Axis:
+        ...
+
+    @property
+    def y(self) -> Axis:
+        ...
+
+    @property
+    def z(self) -> AxisInt64:
+        ...
+
+
+class TemporalGrid4DInt8:
+    def __init__(self, x: Axis, y: Axis, z: AxisInt64, u: Axis,
+                 array: numpy.ndarray[numpy.int8]) -> None:
+        ...
+
+    def __getstate__(self) -> tuple:
+        ...
+
+    def __setstate__(self, arg0: tuple) -> None:
+        ...
+
+    @property
+    def array(self) -> numpy.ndarray[numpy.int8]:
+        ...
+
+    @property
+    def u(self) -> Axis:
+        ...
+
+    @property
+    def x(self) -> Axis:
+        ...
+
+    @property
+    def y(self) -> Axis:
+        ...
+
+    @property
+    def z(self) -> AxisInt64:
+        ...
+
+
+class TemporalInverseDistanceWeighting3D(TemporalBivariateInterpolator3D):
+    def __init__(self, p: int = ...) -> None:
+        ...
+
+    def __getstate__(self) -> tuple:
+        ...
+
+    def __setstate__(self, arg0: tuple) -> None:
+        ...
+
+
+class TemporalNearest3D(TemporalBivariateInterpolator3D):
+    def __init__(self) -> None:
+        ...
+
+    def __getstate__(self) -> tuple:
+        ...
+
+    def __setstate__(self, arg0: tuple) -> None:
+        ...
+
+
+class TemporalRTree3DFloat32:
+    def __init__(self, system: Optional[geodetic.System],
+                 period: int) -> None:
+        ...
+
+    def clear(self) -> None:
+        ...
+
+    def inverse_distance_weighting(self,
+                                   coordinates: numpy.ndarray,
+                                   times: numpy.ndarray[numpy.int64],
+                                   window: int,
+                                   radius: Optional[float] = ...,
+                                   k: int = ...,
+                                   p: int = ...,
+                                   num_threads: int = ...) -> tuple:
+        ...
+
+    def packing(self,
+                coordinates: numpy.ndarray,
+                times: numpy.ndarray[numpy.int64],
+                values: numpy.ndarray[numpy.float32],
+                num_threads: int = ...) -> None:
+        ...
+
+    def partitions(self) -> int:
+        ...
+
+    def query(self,
+              coordinates: numpy.ndarray,
+              times: numpy.ndarray[numpy.int64],
+              window: int,
+              k: int = ...,
+              num_threads: int = ...) -> tuple:
+        ...
+
+    def __bool__(self) -> bool:
+        ...
+
+    def __len__(self) -> int:
+        ...
+
+    @property
+    def period(self) -> int:
+        ...
+
+
+class TemporalRTree3DFloat64:
+    def __init__(self, system: Optional[geodetic.System],
+                 period: int) -> None:
+        ...
+
+    def clear(self) -> None:
+        ...
+
+    def inverse_distance_weighting(self,
+                                   coordinates: numpy.ndarray,
+                                   times: numpy.ndarray[numpy.int64],
+                                   window: int,
+                                   radius: Optional[float] = ...,
+                                   k: int = ...,
+                                   p: int = ...,
+                                   num_threads: int = ...) -> tuple:
+        ...
+
+    def packing(self,
+                coordinates: numpy.ndarray,
+                times: numpy.ndarray[numpy.int64],
+                values: numpy.ndarray[numpy.float64],
+                num_threads: int = ...) -> None:
+        ...
+
+    def partitions(self) -> int:
+        ...
+
+    def query(self,
+              coordinates: numpy.ndarray,
+              times: numpy.ndarray[numpy.int64],
+              window: int,
+              k: int = ...,
+              num_threads: int = ...) -> tuple:
+        ...
+
+    def __bool__(self) -> bool:
+        ...
+
+    def __len__(self) -> int:
+        ...
+
+    @property
+    def period(self) -> int:
+        ...
+
+
+class TiledGrid2DFloat32:
+    def __init__(self, x: Axis, y: Axis,
+                 array: numpy.ndarray[numpy.float32]) -> None:
+        ...
+
+    def __getstate__(self) -> tuple:
+        ...
+
+    def __setstate__(self, arg0: tuple) -> None:
+        ...
+
+    @property
+    def array(self) -> numpy.ndarray[numpy.float32]:
+        ...
+
+    @property
+    def x(self) -> Axis:
+        ...
+
+    @property
+    def y(self) -> Axis:
+        ...
+
+
+class TiledGrid2DFloat64:
+    def __init__(self, x: Axis, y: Axis,
+                 array: numpy.ndarray[numpy.float64]) -> None:
+        ...
+
+    def __getstate__(self) -> tuple:
+        ...
+
+    def __setstate__(self, arg0: tuple) -> None:
+        ...
+
+    @property
+    def array(self) -> numpy.ndarray[numpy.float64]:
+        ...
+
+    @property
+    def x(self) -> Axis:
+        ...
+
+    @property
+    def y(self) -> Axis:
+        ...
+
+
+class WindowFunction:
+    __doc__: ClassVar[str] = ...  # read-only
+    __members__: ClassVar[dict] = ...  # read-only
+    Blackman: ClassVar[WindowFunction] = ...
+    BlackmanHarris: ClassVar[WindowFunction] = ...
+    Boxcar: ClassVar[WindowFunction] = ...
+    FlatTop: ClassVar[WindowFunction] = ...
+    Gaussian: ClassVar[WindowFunction] = ...
+    Hamming: ClassVar[WindowFunction] = ...
+    Lanczos: ClassVar[WindowFunction] = ...
+    Nuttall: ClassVar[WindowFunction] = ...
+    Parzen: ClassVar[WindowFunction] = ...
+    ParzenSWOT: ClassVar[WindowFunction] = ...
+    __entries: ClassVar[dict] = ...
+
+    def __init__(self, value: int) -> None:
+        ...
+
+    def __eq__(self, other: object) -> bool:
+        ...
+
+    def __getstate__(self) -> int:
+        ...
+
+    def __hash__(self) -> int:
+        ...
+
+    def __index__(self) -> int:
+        ...
+
+    def __int__(self) -> int:
+        ...
+
+    def __ne__(self, other: object) -> bool:
+        ...
+
+    def __setstate__(self, state: int) -> None:
+        ...
+
+    @property
+    def name(self) -> str:
+        ...
+
+    @property
+    def value(self) -> int:
+        ...
+
+
+def available_cpus() -> int:
+    ...
+
+
+@overload
+def bicubic_float16(
+        grid: Grid2DFloat16,
+        x: numpy.ndarray,
+        y: numpy.ndarray,
+        nx: int = ...,
+        ny: int = ...,
+        fitting_model: str = ...,
+        boundary: str = ...,
+        bounds_error: bool = ...,
+        num_threads: int = ...,
+        out: Optional[numpy.ndarray[numpy.float64]] = ...,
+        fill_holes: Optional[Tuple[int, int]] = ...
+) -> numpy.ndarray[numpy.float64]:
+    ...
+
+
+@overload
+def bicubic_float16(
+        grid: Grid3DFloat16,
+        x: numpy.ndarray,
+        y: numpy.ndarray,
+        z: numpy.ndarray[numpy.float64],
+        nx: int = ...,
+        ny: int = ...,
+        fitting_model: str = ...,
+        boundary: str = ...,
+        bounds_error: bool = ...,
+        num_threads: int = ...,
+        out: Optional[numpy.ndarray[numpy.float64]] = ...
+) -> numpy.ndarray[numpy.float64]:
+    ...
+
+
+@overload
+def bicubic_float16(
+        grid: TemporalGrid3DFloat16,
+        x: numpy.ndarray,
+        y: numpy.ndarray,
+        z: numpy.ndarray[numpy.int64],
+        nx: int = ...,
+        ny: int = ...,
+        fitting_model: str = ...,
+        boundary: str = ...,
+        bounds_error: bool = ...,
+        num_threads: int = ...,
+        out: Optional[numpy.ndarray[numpy.float64]] = ...
+) -> numpy.ndarray[numpy.float64]:
+    ...
+
+
+@overload
+def bicubic_float32(
+        grid: Grid2DFloat32,
+        x: numpy.ndarray,
+        y: numpy.ndarray,
+        nx: int = ...,
+        ny: int = ...,
+        fitting_model: str = ...,
+        boundary: str = ...,
+        bounds_error: bool = ...,
+        num_threads: int = ...,
+        out: Optional[numpy.ndarray[numpy.float64]] = ...,
+        fill_holes: Optional[Tuple[int, int]] = ...
+) -> numpy.ndarray[numpy.float64]:
+    ...
+
+
+@overload
+def bicubic_float32(
+        grid: TiledGrid2DFloat32,
+        x: numpy.ndarray,
+        y: numpy.ndarray,
+        nx: int = ...,
+        ny: int = ...,
+        fitting_model: str = ...,
+        boundary: str = ...,
+        bounds_error: bool = ...,
+        num_threads: int = ...,
+        out: Optional[numpy.ndarray[numpy.float64]] = ...,
+        fill_holes: Optional[Tuple[int, int]] = ...
+) -> numpy.ndarray[numpy.float64]:
+    ...
+
+
+@overload
+def bicubic_float32(
+        grid: Grid3DFloat32,
+        x: numpy.ndarray,
+        y: numpy.ndarray,
+        z: numpy.ndarray[numpy.float64],
+        nx: int = ...,
+        ny: int = ...,
+        fitting_model: str = ...,
+        boundary: str = ...,
+        bounds_error: bool = ...,
+        num_threads: int = ...,
+        out: Optional[numpy.ndarray[numpy.float64]] = ...
+) -> numpy.ndarray[numpy.float64]:
+    ...
+
+
+@overload
+def bicubic_float32(
+        grid: ChunkedGrid3DFloat32,
+        x: numpy.ndarray,
+        y: numpy.ndarray,
+        z: numpy.ndarray[numpy.float64],
+        nx: int = ...,
+        ny: int = ...,
+        fitting_model: str = ...,
+        boundary: str = ...,
+        bounds_error: bool = ...,
+        num_threads: int = ...,
+        out: Optional[numpy.ndarray[numpy.float64]] = ...
+) -> numpy.ndarray[numpy.float64]:
+    ...
+
+
+@overload
+def bicubic_float32(
+        grid: TemporalGrid3DFloat32,
+        x: numpy.ndarray,
+        y: numpy.ndarray,
+        z: numpy.ndarray[numpy.int64],
+        nx: int = ...,
+        ny: int = ...,
+        fitting_model: str = ...,
+        boundary: str = ...,
+        bounds_error: bool = ...,
+        num_threads: int = ...,
+        out: Optional[numpy.ndarray[numpy.float64]] = ...
+) -> numpy.ndarray[numpy.float64]:
+    ...
+
+
+@overload
+def bicubic_float32(
+        grid: TemporalChunkedGrid3DFloat32,
+        x: numpy.ndarray,
+        y: numpy.ndarray,
+        z: numpy.ndarray[numpy.int64],
+        nx: int = ...,
+        ny: int = ...,
+        fitting_model: str = ...,
+        boundary: str = ...,
+        bounds_error: bool = ...,
+        num_threads: int = ...,
+        out: Optional[numpy.ndarray[numpy.float64]] = ...
+) -> numpy.ndarray[numpy.float64]:
+    ...
+
+
+@overload
+def bicubic_float32(
+        grid: Grid4DFloat32,
+        x: numpy.ndarray,
+        y: numpy.ndarray,
+        z: numpy.ndarray[numpy.float64],
+        u: numpy.ndarray,
+        nx: int = ...,
+        ny: int = ...,
+        fitting_model: str = ...,
+        boundary: str = ...,
+        bounds_error: bool = ...,
+        num_threads: int = ...,
+        out: Optional[numpy.ndarray[numpy.float64]] = ...
+) -> numpy.ndarray[numpy.float64]:
+    ...
+
+
+@overload
+def bicubic_float32(
+        grid: ChunkedGrid4DFloat32,
+        x: numpy.ndarray,
+        y: numpy.ndarray,
+        z: numpy.ndarray[numpy.float64],
+        u: numpy.ndarray,
+        nx: int = ...,
+        ny: int = ...,
+        fitting_model: str = ...,
+        boundary: str = ...,
+        bounds_error: bool = ...,
+        num_threads: int = ...,
+        out: Optional[numpy.ndarray[numpy.float64]] = ...
+) -> numpy.ndarray[numpy.float64]:
+    ...
+
+
+@overload
+def bicubic_float32(
+        grid: TemporalGrid4DFloat32,
+        x: numpy.ndarray,
+        y: numpy.ndarray,
+        z: numpy.ndarray[numpy.int64],
+        u: numpy.ndarray,
+        nx: int = ...,
+        ny: int = ...,
+        fitting_model: str = ...,
+        boundary: str = ...,
+        bounds_error: bool = ...,
+        num_threads: int = ...,
+        out: Optional[numpy.ndarray[numpy.float64]] = ...
+) -> numpy.ndarray[numpy.float64]:
+    ...
+
+
+@overload
+def bicubic_float32(
+        grid: TemporalChunkedGrid4DFloat32,
+        x: numpy.ndarray,
+        y: numpy.ndarray,
+        z: numpy.ndarray[numpy.int64],
+        u: numpy.ndarray,
+        nx: int = ...,
+        ny: int = ...,
+        fitting_model: str = ...,
+        boundary: str = ...,
+        bounds_error: bool = ...,
+        num_threads: int = ...,
+        out: Optional[numpy.ndarray[numpy.float64]] = ...
+) -> numpy.ndarray[numpy.float64]:
+    ...
+
+
+@overload
+def bicubic_float64(
+        grid: Grid2DFloat64,
+        x: numpy.ndarray,
+        y: numpy.ndarray,
+        nx: int = ...,
+        ny: int = ...,
+        fitting_model: str = ...,
+        boundary: str = ...,
+        bounds_error: bool = ...,
+        num_threads: int = ...,
+        out: Optional[numpy.ndarray[numpy.float64]] = ...,
+        fill_holes: Optional[Tuple[int, int]] = ...
+) -> numpy.ndarray[numpy.float64]:
+    ...
+
+
+@overload
+def bicubic_float64(
+        grid: TiledGrid2DFloat64,
+        x: numpy.ndarray,
+        y: numpy.ndarray,
+        nx: int = ...,
+        ny: int = ...,
+        fitting_model: str = ...,
+        boundary: str = ...,
+        bounds_error: bool = ...,
+        num_threads: int = ...,
+        out: Optional[numpy.ndarray[numpy.float64]] = ...,
+        fill_holes: Optional[Tuple[int, int]] = ...
+) -> numpy.ndarray[numpy.float64]:
+    ...
+
+
+@overload
+def bicubic_float64(
+        grid: Grid3DFloat64,
+        x: numpy.ndarray,
+        y: numpy.ndarray,
+        z: numpy.ndarray[numpy.float64],
+        nx: int = ...,
+        ny: int = ...,
+        fitting_model: str = ...,
+        boundary: str = ...,
+        bounds_error: bool = ...,
+        num_threads: int = ...,
+        out: Optional[numpy.ndarray[numpy.float64]] = ...
+) -> numpy.ndarray[numpy.float64]:
+    ...
+
+
+@overload
+def bicubic_float64(
+        grid: ChunkedGrid3DFloat64,
+        x: numpy.ndarray,
+        y: numpy.ndarray,
+        z: numpy.ndarray[numpy.float64],
+        nx: int = ...,
+        ny: int = ...,
+        fitting_model: str = ...,
+        boundary: str = ...,
+        bounds_error: bool = ...,
+        num_threads: int = ...,
+        out: Optional[numpy.ndarray[numpy.float64]] = ...
+) -> numpy.ndarray[numpy.float64]:
+    ...
+
+
+@overload
+def bicubic_float64(
+        grid: TemporalGrid3DFloat64,
+        x: numpy.ndarray,
+        y: numpy.ndarray,
+        z: numpy.ndarray[numpy.int64],
+        nx: int = ...,
+        ny: int = ...,
+        fitting_model: str = ...,
+        boundary: str = ...,
+        bounds_error: bool = ...,
+        num_threads: int = ...,
+        out: Optional[numpy.ndarray[numpy.float64]] = ...
+) -> numpy.ndarray[numpy.float64]:
+    ...
+
+
+@overload
+def bicubic_float64(
+        grid: TemporalChunkedGrid3DFloat64,
+        x: numpy.ndarray,
+        y: numpy.ndarray,
+        z: numpy.ndarray[numpy.int64],
+        nx: int = ...,
+        ny: int = ...,
+        fitting_model: str = ...,
+        boundary: str = ...,
+        bounds_error: bool = ...,
+        num_threads: int = ...,
+        out: Optional[numpy.ndarray[numpy.float64]] = ...
+) -> numpy.ndarray[numpy.float64]:
+    ...
+
+
+@overload
+def bicubic_float64(
+        grid: Grid4DFloat64,
+        x: numpy.ndarray,
+        y: numpy.ndarray,
+        z: numpy.ndarray[numpy.float64],
+        u: numpy.ndarray,
+        nx: int = ...,
+        ny: int = ...,
+        fitting_model: str = ...,
+        boundary: str = ...,
+        bounds_error: bool = ...,
+        num_threads: int = ...,
+        out: Optional[numpy.ndarray[numpy.float64]] = ...
+) -> numpy.ndarray[numpy.float64]:
+    ...
+
+
+@overload
+def bicubic_float64(
+        grid: ChunkedGrid4DFloat64,
+        x: numpy.ndarray,
+        y: numpy.ndarray,
+        z: numpy.ndarray[numpy.float64],
+        u: numpy.ndarray,
+        nx: int = ...,
+        ny: int = ...,
+        fitting_model: str = ...,
+        boundary: str = ...,
+        bounds_error: bool = ...,
+        num_threads: int = ...,
+        out: Optional[numpy.ndarray[numpy.float64]] = ...
+) -> numpy.ndarray[numpy.float64]:
+    ...
+
+
+@overload
+def bicubic_float64(
+        grid: TemporalGrid4DFloat64,
+        x: numpy.ndarray,
+        y: numpy.ndarray,
+        z: numpy.ndarray[numpy.int64],
+        u: numpy.ndarray,
+        nx: int = ...,
+        ny: int = ...,
+        fitting_model: str = ...,
+        boundary: str = ...,
+        bounds_error: bool = ...,
+        num_threads: int = ...,
+        out: Optional[numpy.ndarray[numpy.float64]] = ...
+) -> numpy.ndarray[numpy.float64]:
+    ...
+
+
+@overload
+def bicubic_float64(
+        grid: TemporalChunkedGrid4DFloat64,
+        x: numpy.ndarray,
+        y: numpy.ndarray,
+        z: numpy.ndarray[numpy.int64],
+        u: numpy.ndarray,
+        nx: int = ...,
+        ny: int = ...,
+        fitting_model: str = ...,
+        boundary: str = ...,
+        bounds_error: bool = ...,
+        num_threads: int = ...,
+        out: Optional[numpy.ndarray[numpy.float64]] = ...
+) -> numpy.ndarray[numpy.float64]:
+    ...
+
+
+def bicubic_gradient_float16(
+        grid: Grid2DFloat16,
+        x: numpy.ndarray,
+        y: numpy.ndarray,
+        nx: int = ...,
+        ny: int = ...,
+        fitting_model: str = ...,
+        boundary: str = ...,
+        bounds_error: bool = ...,
+        num_threads: int = ...,
+        out: Optional[numpy.ndarray[numpy.float64]] = ...,
+        out_dx: Optional[numpy.ndarray[numpy.float64]] = ...,
+        out_dy: Optional[numpy.ndarray[numpy.float64]] = ...,
+        fill_holes: Optional[Tuple[int, int]] = ...
+) -> Tuple[numpy.ndarray[numpy.float64], numpy.ndarray[numpy.float64],
+           numpy.ndarray[numpy.float64]]:
+    ...
+
+
+@overload
+def bicubic_gradient_float32(
+        grid: Grid2DFloat32,
+        x: numpy.ndarray,
+        y: numpy.ndarray,
+        nx: int = ...,
+        ny: int = ...,
+        fitting_model: str = ...,
+        boundary: str = ...,
+        bounds_error: bool = ...,
+        num_threads: int = ...,
+        out: Optional[numpy.ndarray[numpy.float64]] = ...,
+        out_dx: Optional[numpy.ndarray[numpy.float64]] = ...,
+        out_dy: Optional[numpy.ndarray[numpy.float64]] = ...,
+        fill_holes: Optional[Tuple[int, int]] = ...
+) -> Tuple[numpy.ndarray[numpy.float64], numpy.ndarray[numpy.float64],
+           numpy.ndarray[numpy.float64]]:
+    ...
+
+
+@overload
+def bicubic_gradient_float32(
+        grid: TiledGrid2DFloat32,
+        x: numpy.ndarray,
+        y: numpy.ndarray,
+        nx: int = ...,
+        ny: int = ...,
+        fitting_model: str = ...,
+        boundary: str = ...,
+        bounds_error: bool = ...,
+        num_threads: int = ...,
+        out: Optional[numpy.ndarray[numpy.float64]] = ...,
+        out_dx: Optional[numpy.ndarray[numpy.float64]] = ...,
+        out_dy: Optional[numpy.ndarray[numpy.float64]] = ...,
+        fill_holes: Optional[Tuple[int, int]] = ...
+) -> Tuple[numpy.ndarray[numpy.float64], numpy.ndarray[numpy.float64],
+           numpy.ndarray[numpy.float64]]:
+    ...
+
+
+@overload
+def bicubic_gradient_float64(
+        grid: Grid2DFloat64,
+        x: numpy.ndarray,
+        y: numpy.ndarray,
+        nx: int = ...,
+        ny: int = ...,
+        fitting_model: str = ...,
+        boundary: str = ...,
+        bounds_error: bool = ...,
+        num_threads: int = ...,
+        out: Optional[numpy.ndarray[numpy.float64]] = ...,
+        out_dx: Optional[numpy.ndarray[numpy.float64]] = ...,
+        out_dy: Optional[numpy.ndarray[numpy.float64]] = ...,
+        fill_holes: Optional[Tuple[int, int]] = ...
+) -> Tuple[numpy.ndarray[numpy.float64], numpy.ndarray[numpy.float64],
+           numpy.ndarray[numpy.float64]]:
+    ...
+
+
+@overload
+def bicubic_gradient_float64(
+        grid: TiledGrid2DFloat64,
+        x: numpy.ndarray,
+        y: numpy.ndarray,
+        nx: int = ...,
+        ny: int = ...,
+        fitting_model: str = ...,
+        boundary: str = ...,
+        bounds_error: bool = ...,
+        num_threads: int = ...,
+        out: Optional[numpy.ndarray[numpy.float64]] = ...,
+        out_dx: Optional[numpy.ndarray[numpy.float64]] = ...,
+        out_dy: Optional[numpy.ndarray[numpy.float64]] = ...,
+        fill_holes: Optional[Tuple[int, int]] = ...
+) -> Tuple[numpy.ndarray[numpy.float64], numpy.ndarray[numpy.float64],
+           numpy.ndarray[numpy.float64]]:
+    ...
+
+
+def bicubic_gradient_int16(
+        grid: Grid2DInt16,
+        x: numpy.ndarray,
+        y: numpy.ndarray,
+        nx: int = ...,
+        ny: int = ...,
+        fitting_model: str = ...,
+        boundary: str = ...,
+        bounds_error: bool = ...,
+        num_threads: int = ...,
+        out: Optional[numpy.ndarray[numpy.float64]] = ...,
+        out_dx: Optional[numpy.ndarray[numpy.float64]] = ...,
+        out_dy: Optional[numpy.ndarray[numpy.float64]] = ...,
+        fill_holes: Optional[Tuple[int, int]] = ...
+) -> Tuple[numpy.ndarray[numpy.float64], numpy.ndarray[numpy.float64],
+           numpy.ndarray[numpy.float64]]:
+    ...
+
+
+@overload
+def bicubic_int16(
+        grid: Grid2DInt16,
+        x: numpy.ndarray,
+        y: numpy.ndarray,
+        nx: int = ...,
+        ny: int = ...,
+        fitting_model: str = ...,
+        boundary: str = ...,
+        bounds_error: bool = ...,
+        num_threads: int = ...,
+        out: Optional[numpy.ndarray[numpy.float64]] = ...,
+        fill_holes: Optional[Tuple[int, int]] = ...
+) -> numpy.ndarray[numpy.float64]:
+    ...
+
+
+@overload
+def bicubic_int16(
+        grid: Grid3DInt16,
+        x: numpy.ndarray,
+        y: numpy.ndarray,
+        z: numpy.ndarray[numpy.float64],
+        nx: int = ...,
+        ny: int = ...,
+        fitting_model: str = ...,
+        boundary: str = ...,
+        bounds_error: bool = ...,
+        num_threads: int = ...,
+        out: Optional[numpy.ndarray[numpy.float64]] = ...
+) -> numpy.ndarray[numpy.float64]:
+    ...
+
+
+@overload
+def bicubic_int16(
+        grid: TemporalGrid3DInt16,
+        x: numpy.ndarray,
+        y: numpy.ndarray,
+        z: numpy.ndarray[numpy.int64],
+        nx: int = ...,
+        ny: int = ...,
+        fitting_model: str = ...,
+        boundary: str = ...,
+        bounds_error: bool = ...,
+        num_threads: int = ...,
+        out: Optional[numpy.ndarray[numpy.float64]] = ...
+) -> numpy.ndarray[numpy.float64]:
+    ...
+
+
+def bilinear_gradient_float16(
+        grid: Grid2DFloat16,
+        x: numpy.ndarray,
+        y: numpy.ndarray,
+        bounds_error: bool = ...,
+        num_threads: int = ...,
+        out: Optional[numpy.ndarray[numpy.float64]] = ...,
+        out_dx: Optional[numpy.ndarray[numpy.float64]] = ...,
+        out_dy: Optional[numpy.ndarray[numpy.float64]] = ...,
+        fill_holes: Optional[Tuple[int, int]] = ...
+) -> Tuple[numpy.ndarray[numpy.float64], numpy.ndarray[numpy.float64],
+           numpy.ndarray[numpy.float64]]:
+    ...
+
+
+@overload
+def bilinear_gradient_float32(
+        grid: Grid2DFloat32,
+        x: numpy.ndarray,
+        y: numpy.ndarray,
+        bounds_error: bool = ...,
+        num_threads: int = ...,
+        out: Optional[numpy.ndarray[numpy.float64]] = ...,
+        out_dx: Optional[numpy.ndarray[numpy.float64]] = ...,
+        out_dy: Optional[numpy.ndarray[numpy.float64]] = ...,
+        fill_holes: Optional[Tuple[int, int]] = ...
+) -> Tuple[numpy.ndarray[numpy.float64], numpy.ndarray[numpy.float64],
+           numpy.ndarray[numpy.float64]]:
+    ...
+
+
+@overload
+def bilinear_gradient_float32(
+        grid: TiledGrid2DFloat32,
+        x: numpy.ndarray,
+        y: numpy.ndarray,
+        bounds_error: bool = ...,
+        num_threads: int = ...,
+        out: Optional[numpy.ndarray[numpy.float64]] = ...,
+        out_dx: Optional[numpy.ndarray[numpy.float64]] = ...,
+        out_dy: Optional[numpy.ndarray[numpy.float64]] = ...,
+        fill_holes: Optional[Tuple[int, int]] = ...
+) -> Tuple[numpy.ndarray[numpy.float64], numpy.ndarray[numpy.float64],
+           numpy.ndarray[numpy.float64]]:
+    ...
+
+
+@overload
+def bilinear_gradient_float64(
+        grid: Grid2DFloat64,
+        x: numpy.ndarray,
+        y: numpy.ndarray,
+        bounds_error: bool = ...,
+        num_threads: int = ...,
+        out: Optional[numpy.ndarray[numpy.float64]] = ...,
+        out_dx: Optional[numpy.ndarray[numpy.float64]] = ...,
+        out_dy: Optional[numpy.ndarray[numpy.float64]] = ...,
+        fill_holes: Optional[Tuple[int, int]] = ...
+) -> Tuple[numpy.ndarray[numpy.float64], numpy.ndarray[numpy.float64],
+           numpy.ndarray[numpy.float64]]:
+    ...
+
+
+@overload
+def bilinear_gradient_float64(
+        grid: TiledGrid2DFloat64,
+        x: numpy.ndarray,
+        y: numpy.ndarray,
+        bounds_error: bool = ...,
+        num_threads: int = ...,
+        out: Optional[numpy.ndarray[numpy.float64]] = ...,
+        out_dx: Optional[numpy.ndarray[numpy.float64]] = ...,
+        out_dy: Optional[numpy.ndarray[numpy.float64]] = ...,
+        fill_holes: Optional[Tuple[int, int]] = ...
+) -> Tuple[numpy.ndarray[numpy.float64], numpy.ndarray[numpy.float64],
+           numpy.ndarray[numpy.float64]]:
+    ...
+
+
+def bilinear_gradient_int16(
+        grid: Grid2DInt16,
+        x: numpy.ndarray,
+        y: numpy.ndarray,
+        bounds_error: bool = ...,
+        num_threads: int = ...,
+        out: Optional[numpy.ndarray[numpy.float64]] = ...,
+        out_dx: Optional[numpy.ndarray[numpy.float64]] = ...,
+        out_dy: Optional[numpy.ndarray[numpy.float64]] = ...,
+        fill_holes: Optional[Tuple[int, int]] = ...
+) -> Tuple[numpy.ndarray[numpy.float64], numpy.ndarray[numpy.float64],
+           numpy.ndarray[numpy.float64]]:
+    ...
+
+
+def bilinear_gradient_int8(
+        grid: Grid2DInt8,
+        x: numpy.ndarray,
+        y: numpy.ndarray,
+        bounds_error: bool = ...,
+        num_threads: int = ...,
+        out: Optional[numpy.ndarray[numpy.float64]] = ...,
+        out_dx: Optional[numpy.ndarray[numpy.float64]] = ...,
+        out_dy: Optional[numpy.ndarray[numpy.float64]] = ...,
+        fill_holes: Optional[Tuple[int, int]] = ...
+) -> Tuple[numpy.ndarray[numpy.float64], numpy.ndarray[numpy.float64],
+           numpy.ndarray[numpy.float64]]:
+    ...
+
+
+def bivariate_float16(
+        grid: Grid2DFloat16,
+        x: numpy.ndarray,
+        y: numpy.ndarray,
+        interpolator: BivariateInterpolator2D,
+        bounds_error: bool = ...,
+        num_threads: int = ...,
+        out: Optional[numpy.ndarray[numpy.float64]] = ...,
+        fill_holes: Optional[Tuple[int, int]] = ...
+) -> numpy.ndarray[numpy.float64]:
+    ...
+
+
+@overload
+def bivariate_float32(
+        grid: Grid2DFloat32,
+        x: numpy.ndarray,
+        y: numpy.ndarray,
+        interpolator: BivariateInterpolator2D,
+        bounds_error: bool = ...,
+        num_threads: int = ...,
+        out: Optional[numpy.ndarray[numpy.float64]] = ...,
+        fill_holes: Optional[Tuple[int, int]] = ...
+) -> numpy.ndarray[numpy.float64]:
+    ...
+
+
+@overload
+def bivariate_float32(
+        grid: TiledGrid2DFloat32,
+        x: numpy.ndarray,
+        y: numpy.ndarray,
+        interpolator: BivariateInterpolator2D,
+        bounds_error: bool = ...,
+        num_threads: int = ...,
+        out: Optional[numpy.ndarray[numpy.float64]] = ...,
+        fill_holes: Optional[Tuple[int, int]] = ...
+) -> numpy.ndarray[numpy.float64]:
+    ...
+
+
+@overload
+def bivariate_float32(
+        grid: Grid2DFloat32,
+        x: numpy.ndarray,
+        y: numpy.ndarray,
+        interpolator: BivariateInterpolator2DFloat32,
+        bounds_error: bool = ...,
+        num_threads: int = ...,
+        out: Optional[numpy.ndarray[numpy.float32]] = ...,
+        fill_holes: Optional[Tuple[int, int]] = ...
+) -> numpy.ndarray[numpy.float32]:
+    ...
+
+
+@overload
+def bivariate_float32(
+        grid: TiledGrid2DFloat32,
+        x: numpy.ndarray,
+        y: numpy.ndarray,
+        interpolator: BivariateInterpolator2DFloat32,
+        bounds_error: bool = ...,
+        num_threads: int = ...,
+        out: Optional[numpy.ndarray[numpy.float32]] = ...,
+        fill_holes: Optional[Tuple[int, int]] = ...
+) -> numpy.ndarray[numpy.float32]:
+    ...
+
+
+@overload
+def bivariate_float64(
+        grid: Grid2DFloat64,
+        x: numpy.ndarray,
+        y: numpy.ndarray,
+        interpolator: BivariateInterpolator2D,
+        bounds_error: bool = ...,
+        num_threads: int = ...,
+        out: Optional[numpy.ndarray[numpy.float64]] = ...,
+        fill_holes: Optional[Tuple[int, int]] = ...
+) -> numpy.ndarray[numpy.float64]:
+    ...
+
+
+@overload
+def bivariate_float64(
+        grid: TiledGrid2DFloat64,
+        x: numpy.ndarray,
+        y: numpy.ndarray,
+        interpolator: BivariateInterpolator2D,
+        bounds_error: bool = ...,
+        num_threads: int = ...,
+        out: Optional[numpy.ndarray[numpy.float64]] = ...,
+        fill_holes: Optional[Tuple[int, int]] = ...
+) -> numpy.ndarray[numpy.float64]:
+    ...
+
+
+def bivariate_int16(
+        grid: Grid2DInt16,
+        x: numpy.ndarray,
+        y: numpy.ndarray,
+        interpolator: BivariateInterpolator2D,
+        bounds_error: bool = ...,
+        num_threads: int = ...,
+        out: Optional[numpy.ndarray[numpy.float64]] = ...,
+        fill_holes: Optional[Tuple[int, int]] = ...
+) -> numpy.ndarray[numpy.float64]:
+    ...
+
+
+def bivariate_int8(
+        grid: Grid2DInt8,
+        x: numpy.ndarray,
+        y: numpy.ndarray,
+        interpolator: BivariateInterpolator2D,
+        bounds_error: bool = ...,
+        num_threads: int = ...,
+        out: Optional[numpy.ndarray[numpy.float64]] = ...,
+        fill_holes: Optional[Tuple[int, int]] = ...
+) -> numpy.ndarray[numpy.float64]:
+    ...
+
+
+def bivariate_plan(x_axis: Axis,
+                   y_axis: Axis,
+                   x: numpy.ndarray,
+                   y: numpy.ndarray,
+                   interpolator: BivariateInterpolator2D,
+                   bounds_error: bool = ...,
+                   num_threads: int = ...) -> InterpolationPlan:
+    ...
+
+
+def conservative_plan(source_x: Axis,
+                      source_y: Axis,
+                      target_x: Axis,
+                      target_y: Axis,
+                      wgs: Optional[geodetic.System] = ...,
+                      num_threads: int = ...) -> InterpolationPlan:
+    ...
+
+
+def get_num_threads() -> int:
+    ...
+
+
+@overload
+def quadrivariate_float32(
+        grid: Grid4DFloat32,
+        x: numpy.ndarray,
+        y: numpy.ndarray,
+        z: numpy.ndarray[numpy.float64],
+        u: numpy.ndarray,
+        interpolator: BivariateInterpolator3D,
+        z_method: Optional[str] = ...,
+        u_method: Optional[str] = ...,
+        bounds_error: bool = ...,
+        num_threads: int = ...,
+        out: Optional[numpy.ndarray[numpy.float64]] = ...
+) -> numpy.ndarray[numpy.float64]:
+    ...
+
+
+@overload
+def quadrivariate_float32(
+        grid: ChunkedGrid4DFloat32,
+        x: numpy.ndarray,
+        y: numpy.ndarray,
+        z: numpy.ndarray[numpy.float64],
+        u: numpy.ndarray,
+        interpolator: BivariateInterpolator3D,
+        z_method: Optional[str] = ...,
+        u_method: Optional[str] = ...,
+        bounds_error: bool = ...,
+        num_threads: int = ...,
+        out: Optional[numpy.ndarray[numpy.float64]] = ...
+) -> numpy.ndarray[numpy.float64]:
+    ...
+
+
+@overload
+def quadrivariate_float32(
+        grid: TemporalGrid4DFloat32,
+        x: numpy.ndarray,
+        y: numpy.ndarray,
+        z: numpy.ndarray,
+        u: numpy.ndarray,
+        interpolator: TemporalBivariateInterpolator3D,
+        z_method: Optional[str] = ...,
+        u_method: Optional[str] = ...,
+        bounds_error: bool = ...,
+        num_threads: int = ...,
+        out: Optional[numpy.ndarray[numpy.float64]] = ...
+) -> numpy.ndarray[numpy.float64]:
+    ...
+
+
+@overload
+def quadrivariate_float32(
+        grid: TemporalChunkedGrid4DFloat32,
+        x: numpy.ndarray,
+        y: numpy.ndarray,
+        z: numpy.ndarray,
+        u: numpy.ndarray,
+        interpolator: TemporalBivariateInterpolator3D,
+        z_method: Optional[str] = ...,
+        u_method: Optional[str] = ...,
+        bounds_error: bool = ...,
+        num_threads: int = ...,
+        out: Optional[numpy.ndarray[numpy.float64]] = ...
+) -> numpy.ndarray[numpy.float64]:
+    ...
+
+
+@overload
+def quadrivariate_float64(
+        grid: Grid4DFloat64,
+        x: numpy.ndarray,
+        y: numpy.ndarray,
+        z: numpy.ndarray[numpy.float64],
+        u: numpy.ndarray,
+        interpolator: BivariateInterpolator3D,
+        z_method: Optional[str] = ...,
+        u_method: Optional[str] = ...,
+        bounds_error: bool = ...,
+        num_threads: int = ...,
+        out: Optional[numpy.ndarray[numpy.float64]] = ...
+) -> numpy.ndarray[numpy.float64]:
+    ...
+
+
+@overload
+def quadrivariate_float64(
+        grid: ChunkedGrid4DFloat64,
+        x: numpy.ndarray,
+        y: numpy.ndarray,
+        z: numpy.ndarray[numpy.float64],
+        u: numpy.ndarray,
+        interpolator: BivariateInterpolator3D,
+        z_method: Optional[str] = ...,
+        u_method: Optional[str] = ...,
+        bounds_error: bool = ...,
+        num_threads: int = ...,
+        out: Optional[numpy.ndarray[numpy.float64]] = ...
+) -> numpy.ndarray[numpy.float64]:
+    ...
+
+
+@overload
+def quadrivariate_float64(
+        grid: TemporalGrid4DFloat64,
+        x: numpy.ndarray,
+        y: numpy.ndarray,
+        z: numpy.ndarray,
+        u: numpy.ndarray,
+        interpolator: TemporalBivariateInterpolator3D,
+        z_method: Optional[str] = ...,
+        u_method: Optional[str] = ...,
+        bounds_error: bool = ...,
+        num_threads: int = ...,
+        out: Optional[numpy.ndarray[numpy.float64]] = ...
+) -> numpy.ndarray[numpy.float64]:
+    ...
+
+
+@overload
+def quadrivariate_float64(
+        grid: TemporalChunkedGrid4DFloat64,
+        x: numpy.ndarray,
+        y: numpy.ndarray,
+        z: numpy.ndarray,
+        u: numpy.ndarray,
+        interpolator: TemporalBivariateInterpolator3D,
+        z_method: Optional[str] = ...,
+        u_method: Optional[str] = ...,
+        bounds_error: bool = ...,
+        num_threads: int = ...,
+        out: Optional[numpy.ndarray[numpy.float64]] = ...
+) -> numpy.ndarray[numpy.float64]:
+    ...
+
+
+def set_num_threads(num_threads: int = ..., pin: bool = ...) -> None:
+    ...
+
+
+@overload
+def spline_float16(
+        grid: Grid2DFloat16,
+        x: numpy.ndarray,
+        y: numpy.ndarray,
+        nx: int = ...,
+        ny: int = ...,
+        fitting_model: str = ...,
+        boundary: str = ...,
+        bounds_error: bool = ...,
+        num_threads: int = ...,
+        out: Optional[numpy.ndarray[numpy.float64]] = ...,
+        fill_holes: Optional[Tuple[int, int]] = ...
+) -> numpy.ndarray[numpy.float64]:
+    ...
+
+
+@overload
+def spline_float16(
+        grid: Grid3DFloat16,
+        x: numpy.ndarray,
+        y: numpy.ndarray,
+        z: numpy.ndarray[numpy.float64],
+        nx: int = ...,
+        ny: int = ...,
+        fitting_model: str = ...,
+        boundary: str = ...,
+        bounds_error: bool = ...,
+        num_threads: int = ...,
+        out: Optional[numpy.ndarray[numpy.float64]] = ...
+) -> numpy.ndarray[numpy.float64]:
+    ...
+
+
+@overload
+def spline_float16(
+        grid: TemporalGrid3DFloat16,
+        x: numpy.ndarray,
+        y: numpy.ndarray,
+        z: numpy.ndarray[numpy.int64],
+        nx: int = ...,
+        ny: int = ...,
+        fitting_model: str = ...,
+        boundary: str = ...,
+        bounds_error: bool = ...,
+        num_threads: int = ...,
+        out: Optional[numpy.ndarray[numpy.float64]] = ...
+) -> numpy.ndarray[numpy.float64]:
+    ...
+
+
+@overload
+def spline_float32(
+        grid: Grid2DFloat32,
+        x: numpy.ndarray,
+        y: numpy.ndarray,
+        nx: int = ...,
+        ny: int = ...,
+        fitting_model: str = ...,
+        boundary: str = ...,
+        bounds_error: bool = ...,
+        num_threads: int = ...,
+        out: Optional[numpy.ndarray[numpy.float64]] = ...,
+        fill_holes: Optional[Tuple[int, int]] = ...
+) -> numpy.ndarray[numpy.float64]:
+    ...
+
+
+@overload
+def spline_float32(
+        grid: TiledGrid2DFloat32,
+        x: numpy.ndarray,
+        y: numpy.ndarray,
+        nx: int = ...,
+        ny: int = ...,
+        fitting_model: str = ...,
+        boundary: str = ...,
+        bounds_error: bool = ...,
+        num_threads: int = ...,
+        out: Optional[numpy.ndarray[numpy.float64]] = ...,
+        fill_holes: Optional[Tuple[int, int]] = ...
+) -> numpy.ndarray[numpy.float64]:
+    ...
+
 
-    def __setstate__(self, arg0: tuple) -> None:
-        ...
+@overload
+def spline_float32(
+        grid: Grid3DFloat32,
+        x: numpy.ndarray,
+        y: numpy.ndarray,
+        z: numpy.ndarray[numpy.float64],
+        nx: int = ...,
+        ny: int = ...,
+        fitting_model: str = ...,
+        boundary: str = ...,
+        bounds_error: bool = ...,
+        num_threads: int = ...,
+        out: Optional[numpy.ndarray[numpy.float64]] = ...
+) -> numpy.ndarray[numpy.float64]:
+    ...
 
 
-class TemporalNearest3D(TemporalBivariateInterpolator3D):
-    def __init__(self) -> None:
-        ...
+@overload
+def spline_float32(
+        grid: ChunkedGrid3DFloat32,
+        x: numpy.ndarray,
+        y: numpy.ndarray,
+        z: numpy.ndarray[numpy.float64],
+        nx: int = ...,
+        ny: int = ...,
+        fitting_model: str = ...,
+        boundary: str = ...,
+        bounds_error: bool = ...,
+        num_threads: int = ...,
+        out: Optional[numpy.ndarray[numpy.float64]] = ...
+) -> numpy.ndarray[numpy.float64]:
+    ...
 
-    def __getstate__(self) -> tuple:
-        ...
 
-    def __setstate__(self, arg0: tuple) -> None:
-        ...
+@overload
+def spline_float32(
+        grid: TemporalGrid3DFloat32,
+        x: numpy.ndarray,
+        y: numpy.ndarray,
+        z: numpy.ndarray[numpy.int64],
+        nx: int = ...,
+        ny: int = ...,
+        fitting_model: str = ...,
+        boundary: str = ...,
+        bounds_error: bool = ...,
+        num_threads: int = ...,
+        out: Optional[numpy.ndarray[numpy.float64]] = ...
+) -> numpy.ndarray[numpy.float64]:
+    ...
 
 
-class WindowFunction:
-    __doc__: ClassVar[str] = ...  # read-only
-    __members__: ClassVar[dict] = ...  # read-only
-    Blackman: ClassVar[WindowFunction] = ...
-    BlackmanHarris: ClassVar[WindowFunction] = ...
-    Boxcar: ClassVar[WindowFunction] = ...
-    FlatTop: ClassVar[WindowFunction] = ...
-    Hamming: ClassVar[WindowFunction] = ...
-    Lanczos: ClassVar[WindowFunction] = ...
-    Nuttall: ClassVar[WindowFunction] = ...
-    Parzen: ClassVar[WindowFunction] = ...
-    ParzenSWOT: ClassVar[WindowFunction] = ...
-    __entries: ClassVar[dict] = ...
+@overload
+def spline_float32(
+        grid: TemporalChunkedGrid3DFloat32,
+        x: numpy.ndarray,
+        y: numpy.ndarray,
+        z: numpy.ndarray[numpy.int64],
+        nx: int = ...,
+        ny: int = ...,
+        fitting_model: str = ...,
+        boundary: str = ...,
+        bounds_error: bool = ...,
+        num_threads: int = ...,
+        out: Optional[numpy.ndarray[numpy.float64]] = ...
+) -> numpy.ndarray[numpy.float64]:
+    ...
 
-    def __init__(self, value: int) -> None:
-        ...
 
-    def __eq__(self, other: object) -> bool:
-        ...
+@overload
+def spline_float32(
+        grid: Grid4DFloat32,
+        x: numpy.ndarray,
+        y: numpy.ndarray,
+        z: numpy.ndarray[numpy.float64],
+        u: numpy.ndarray,
+        nx: int = ...,
+        ny: int = ...,
+        fitting_model: str = ...,
+        boundary: str = ...,
+        bounds_error: bool = ...,
+        num_threads: int = ...,
+        out: Optional[numpy.ndarray[numpy.float64]] = ...
+) -> numpy.ndarray[numpy.float64]:
+    ...
 
-    def __getstate__(self) -> int:
-        ...
 
-    def __hash__(self) -> int:
-        ...
+@overload
+def spline_float32(
+        grid: ChunkedGrid4DFloat32,
+        x: numpy.ndarray,
+        y: numpy.ndarray,
+        z: numpy.ndarray[numpy.float64],
+        u: numpy.ndarray,
+        nx: int = ...,
+        ny: int = ...,
+        fitting_model: str = ...,
+        boundary: str = ...,
+        bounds_error: bool = ...,
+        num_threads: int = ...,
+        out: Optional[numpy.ndarray[numpy.float64]] = ...
+) -> numpy.ndarray[numpy.float64]:
+    ...
 
-    def __index__(self) -> int:
-        ...
 
-    def __int__(self) -> int:
-        ...
+@overload
+def spline_float32(
+        grid: TemporalGrid4DFloat32,
+        x: numpy.ndarray,
+        y: numpy.ndarray,
+        z: numpy.ndarray[numpy.int64],
+        u: numpy.ndarray,
+        nx: int = ...,
+        ny: int = ...,
+        fitting_model: str = ...,
+        boundary: str = ...,
+        bounds_error: bool = ...,
+        num_threads: int = ...,
+        out: Optional[numpy.ndarray[numpy.float64]] = ...
+) -> numpy.ndarray[numpy.float64]:
+    ...
 
-    def __ne__(self, other: object) -> bool:
-        ...
 
-    def __setstate__(self, state: int) -> None:
-        ...
+@overload
+def spline_float32(
+        grid: TemporalChunkedGrid4DFloat32,
+        x: numpy.ndarray,
+        y: numpy.ndarray,
+        z: numpy.ndarray[numpy.int64],
+        u: numpy.ndarray,
+        nx: int = ...,
+        ny: int = ...,
+        fitting_model: str = ...,
+        boundary: str = ...,
+        bounds_error: bool = ...,
+        num_threads: int = ...,
+        out: Optional[numpy.ndarray[numpy.float64]] = ...
+) -> numpy.ndarray[numpy.float64]:
+    ...
 
-    @property
-    def name(self) -> str:
-        ...
 
-    @property
-    def value(self) -> int:
-        ...
+@overload
+def spline_float64(
+        grid: Grid2DFloat64,
+        x: numpy.ndarray,
+        y: numpy.ndarray,
+        nx: int = ...,
+        ny: int = ...,
+        fitting_model: str = ...,
+        boundary: str = ...,
+        bounds_error: bool = ...,
+        num_threads: int = ...,
+        out: Optional[numpy.ndarray[numpy.float64]] = ...,
+        fill_holes: Optional[Tuple[int, int]] = ...
+) -> numpy.ndarray[numpy.float64]:
+    ...
 
 
 @overload
-def bicubic_float32(grid: Grid2DFloat32,
-                    x: numpy.ndarray[numpy.float64],
-                    y: numpy.ndarray[numpy.float64],
-                    nx: int = ...,
-                    ny: int = ...,
-                    fitting_model: str = ...,
-                    boundary: str = ...,
-                    bounds_error: bool = ...,
-                    num_threads: int = ...) -> numpy.ndarray[numpy.float64]:
+def spline_float64(
+        grid: TiledGrid2DFloat64,
+        x: numpy.ndarray,
+        y: numpy.ndarray,
+        nx: int = ...,
+        ny: int = ...,
+        fitting_model: str = ...,
+        boundary: str = ...,
+        bounds_error: bool = ...,
+        num_threads: int = ...,
+        out: Optional[numpy.ndarray[numpy.float64]] = ...,
+        fill_holes: Optional[Tuple[int, int]] = ...
+) -> numpy.ndarray[numpy.float64]:
     ...
 
 
 @overload
-def bicubic_float32(grid: Grid3DFloat32,
-                    x: numpy.ndarray[numpy.float64],
-                    y: numpy.ndarray[numpy.float64],
-                    z: numpy.ndarray[numpy.float64],
-                    nx: int = ...,
-                    ny: int = ...,
-                    fitting_model: str = ...,
-                    boundary: str = ...,
-                    bounds_error: bool = ...,
-                    num_threads: int = ...) -> numpy.ndarray[numpy.float64]:
+def spline_float64(
+        grid: Grid3DFloat64,
+        x: numpy.ndarray,
+        y: numpy.ndarray,
+        z: numpy.ndarray[numpy.float64],
+        nx: int = ...,
+        ny: int = ...,
+        fitting_model: str = ...,
+        boundary: str = ...,
+        bounds_error: bool = ...,
+        num_threads: int = ...,
+        out: Optional[numpy.ndarray[numpy.float64]] = ...
+) -> numpy.ndarray[numpy.float64]:
     ...
 
 
 @overload
-def bicubic_float32(grid: TemporalGrid3DFloat32,
-                    x: numpy.ndarray[numpy.float64],
-                    y: numpy.ndarray[numpy.float64],
-                    z: numpy.ndarray[numpy.int64],
-                    nx: int = ...,
-                    ny: int = ...,
-                    fitting_model: str = ...,
-                    boundary: str = ...,
-                    bounds_error: bool = ...,
-                    num_threads: int = ...) -> numpy.ndarray[numpy.float64]:
+def spline_float64(
+        grid: ChunkedGrid3DFloat64,
+        x: numpy.ndarray,
+        y: numpy.ndarray,
+        z: numpy.ndarray[numpy.float64],
+        nx: int = ...,
+        ny: int = ...,
+        fitting_model: str = ...,
+        boundary: str = ...,
+        bounds_error: bool = ...,
+        num_threads: int = ...,
+        out: Optional[numpy.ndarray[numpy.float64]] = ...
+) -> numpy.ndarray[numpy.float64]:
     ...
 
 
 @overload
-def bicubic_float32(grid: Grid4DFloat32,
-                    x: numpy.ndarray[numpy.float64],
-                    y: numpy.ndarray[numpy.float64],
-                    z: numpy.ndarray[numpy.float64],
-                    u: numpy.ndarray[numpy.float64],
-                    nx: int = ...,
-                    ny: int = ...,
-                    fitting_model: str = ...,
-                    boundary: str = ...,
-                    bounds_error: bool = ...,
-                    num_threads: int = ...) -> numpy.ndarray[numpy.float64]:
+def spline_float64(
+        grid: TemporalGrid3DFloat64,
+        x: numpy.ndarray,
+        y: numpy.ndarray,
+        z: numpy.ndarray[numpy.int64],
+        nx: int = ...,
+        ny: int = ...,
+        fitting_model: str = ...,
+        boundary: str = ...,
+        bounds_error: bool = ...,
+        num_threads: int = ...,
+        out: Optional[numpy.ndarray[numpy.float64]] = ...
+) -> numpy.ndarray[numpy.float64]:
     ...
 
 
 @overload
-def bicubic_float32(grid: TemporalGrid4DFloat32,
-                    x: numpy.ndarray[numpy.float64],
-                    y: numpy.ndarray[numpy.float64],
-                    z: numpy.ndarray[numpy.int64],
-                    u: numpy.ndarray[numpy.float64],
-                    nx: int = ...,
-                    ny: int = ...,
-                    fitting_model: str = ...,
-                    boundary: str = ...,
-                    bounds_error: bool = ...,
-                    num_threads: int = ...) -> numpy.ndarray[numpy.float64]:
+def spline_float64(
+        grid: TemporalChunkedGrid3DFloat64,
+        x: numpy.ndarray,
+        y: numpy.ndarray,
+        z: numpy.ndarray[numpy.int64],
+        nx: int = ...,
+        ny: int = ...,
+        fitting_model: str = ...,
+        boundary: str = ...,
+        bounds_error: bool = ...,
+        num_threads: int = ...,
+        out: Optional[numpy.ndarray[numpy.float64]] = ...
+) -> numpy.ndarray[numpy.float64]:
     ...
 
 
 @overload
-def bicubic_float64(grid: Grid2DFloat64,
-                    x: numpy.ndarray[numpy.float64],
-                    y: numpy.ndarray[numpy.float64],
-                    nx: int = ...,
-                    ny: int = ...,
-                    fitting_model: str = ...,
-                    boundary: str = ...,
-                    bounds_error: bool = ...,
-                    num_threads: int = ...) -> numpy.ndarray[numpy.float64]:
+def spline_float64(
+        grid: Grid4DFloat64,
+        x: numpy.ndarray,
+        y: numpy.ndarray,
+        z: numpy.ndarray[numpy.float64],
+        u: numpy.ndarray,
+        nx: int = ...,
+        ny: int = ...,
+        fitting_model: str = ...,
+        boundary: str = ...,
+        bounds_error: bool = ...,
+        num_threads: int = ...,
+        out: Optional[numpy.ndarray[numpy.float64]] = ...
+) -> numpy.ndarray[numpy.float64]:
     ...
 
 
 @overload
-def bicubic_float64(grid: Grid3DFloat64,
-                    x: numpy.ndarray[numpy.float64],
-                    y: numpy.ndarray[numpy.float64],
-                    z: numpy.ndarray[numpy.float64],
-                    nx: int = ...,
-                    ny: int = ...,
-                    fitting_model: str = ...,
-                    boundary: str = ...,
-                    bounds_error: bool = ...,
-                    num_threads: int = ...) -> numpy.ndarray[numpy.float64]:
+def spline_float64(
+        grid: ChunkedGrid4DFloat64,
+        x: numpy.ndarray,
+        y: numpy.ndarray,
+        z: numpy.ndarray[numpy.float64],
+        u: numpy.ndarray,
+        nx: int = ...,
+        ny: int = ...,
+        fitting_model: str = ...,
+        boundary: str = ...,
+        bounds_error: bool = ...,
+        num_threads: int = ...,
+        out: Optional[numpy.ndarray[numpy.float64]] = ...
+) -> numpy.ndarray[numpy.float64]:
     ...
 
 
 @overload
-def bicubic_float64(grid: TemporalGrid3DFloat64,
-                    x: numpy.ndarray[numpy.float64],
-                    y: numpy.ndarray[numpy.float64],
-                    z: numpy.ndarray[numpy.int64],
-                    nx: int = ...,
-                    ny: int = ...,
-                    fitting_model: str = ...,
-                    boundary: str = ...,
-                    bounds_error: bool = ...,
-                    num_threads: int = ...) -> numpy.ndarray[numpy.float64]:
+def spline_float64(
+        grid: TemporalGrid4DFloat64,
+        x: numpy.ndarray,
+        y: numpy.ndarray,
+        z: numpy.ndarray[numpy.int64],
+        u: numpy.ndarray,
+        nx: int = ...,
+        ny: int = ...,
+        fitting_model: str = ...,
+        boundary: str = ...,
+        bounds_error: bool = ...,
+        num_threads: int = ...,
+        out: Optional[numpy.ndarray[numpy.float64]] = ...
+) -> numpy.ndarray[numpy.float64]:
     ...
 
 
 @overload
-def bicubic_float64(grid: Grid4DFloat64,
-                    x: numpy.ndarray[numpy.float64],
-                    y: numpy.ndarray[numpy.float64],
-                    z: numpy.ndarray[numpy.float64],
-                    u: numpy.ndarray[numpy.float64],
-                    nx: int = ...,
-                    ny: int = ...,
-                    fitting_model: str = ...,
-                    boundary: str = ...,
-                    bounds_error: bool = ...,
-                    num_threads: int = ...) -> numpy.ndarray[numpy.float64]:
+def spline_float64(
+        grid: TemporalChunkedGrid4DFloat64,
+        x: numpy.ndarray,
+        y: numpy.ndarray,
+        z: numpy.ndarray[numpy.int64],
+        u: numpy.ndarray,
+        nx: int = ...,
+        ny: int = ...,
+        fitting_model: str = ...,
+        boundary: str = ...,
+        bounds_error: bool = ...,
+        num_threads: int = ...,
+        out: Optional[numpy.ndarray[numpy.float64]] = ...
+) -> numpy.ndarray[numpy.float64]:
+    ...
+
+
+def spline_gradient_float16(
+        grid: Grid2DFloat16,
+        x: numpy.ndarray,
+        y: numpy.ndarray,
+        nx: int = ...,
+        ny: int = ...,
+        fitting_model: str = ...,
+        boundary: str = ...,
+        bounds_error: bool = ...,
+        num_threads: int = ...,
+        out: Optional[numpy.ndarray[numpy.float64]] = ...,
+        out_dx: Optional[numpy.ndarray[numpy.float64]] = ...,
+        out_dy: Optional[numpy.ndarray[numpy.float64]] = ...,
+        fill_holes: Optional[Tuple[int, int]] = ...
+) -> Tuple[numpy.ndarray[numpy.float64], numpy.ndarray[numpy.float64],
+           numpy.ndarray[numpy.float64]]:
     ...
 
 
 @overload
-def bicubic_float64(grid: TemporalGrid4DFloat64,
-                    x: numpy.ndarray[numpy.float64],
-                    y: numpy.ndarray[numpy.float64],
-                    z: numpy.ndarray[numpy.int64],
-                    u: numpy.ndarray[numpy.float64],
-                    nx: int = ...,
-                    ny: int = ...,
-                    fitting_model: str = ...,
-                    boundary: str = ...,
-                    bounds_error: bool = ...,
-                    num_threads: int = ...) -> numpy.ndarray[numpy.float64]:
+def spline_gradient_float32(
+        grid: Grid2DFloat32,
+        x: numpy.ndarray,
+        y: numpy.ndarray,
+        nx: int = ...,
+        ny: int = ...,
+        fitting_model: str = ...,
+        boundary: str = ...,
+        bounds_error: bool = ...,
+        num_threads: int = ...,
+        out: Optional[numpy.ndarray[numpy.float64]] = ...,
+        out_dx: Optional[numpy.ndarray[numpy.float64]] = ...,
+        out_dy: Optional[numpy.ndarray[numpy.float64]] = ...,
+        fill_holes: Optional[Tuple[int, int]] = ...
+) -> Tuple[numpy.ndarray[numpy.float64], numpy.ndarray[numpy.float64],
+           numpy.ndarray[numpy.float64]]:
     ...
 
 
-def bivariate_float32(grid: Grid2DFloat32,
-                      x: numpy.ndarray[numpy.float64],
-                      y: numpy.ndarray[numpy.float64],
-                      interpolator: BivariateInterpolator2D,
-                      bounds_error: bool = ...,
-                      num_threads: int = ...) -> numpy.ndarray[numpy.float64]:
+@overload
+def spline_gradient_float32(
+        grid: TiledGrid2DFloat32,
+        x: numpy.ndarray,
+        y: numpy.ndarray,
+        nx: int = ...,
+        ny: int = ...,
+        fitting_model: str = ...,
+        boundary: str = ...,
+        bounds_error: bool = ...,
+        num_threads: int = ...,
+        out: Optional[numpy.ndarray[numpy.float64]] = ...,
+        out_dx: Optional[numpy.ndarray[numpy.float64]] = ...,
+        out_dy: Optional[numpy.ndarray[numpy.float64]] = ...,
+        fill_holes: Optional[Tuple[int, int]] = ...
+) -> Tuple[numpy.ndarray[numpy.float64], numpy.ndarray[numpy.float64],
+           numpy.ndarray[numpy.float64]]:
     ...
 
 
-def bivariate_float64(grid: Grid2DFloat64,
-                      x: numpy.ndarray[numpy.float64],
-                      y: numpy.ndarray[numpy.float64],
-                      interpolator: BivariateInterpolator2D,
-                      bounds_error: bool = ...,
-                      num_threads: int = ...) -> numpy.ndarray[numpy.float64]:
+@overload
+def spline_gradient_float64(
+        grid: Grid2DFloat64,
+        x: numpy.ndarray,
+        y: numpy.ndarray,
+        nx: int = ...,
+        ny: int = ...,
+        fitting_model: str = ...,
+        boundary: str = ...,
+        bounds_error: bool = ...,
+        num_threads: int = ...,
+        out: Optional[numpy.ndarray[numpy.float64]] = ...,
+        out_dx: Optional[numpy.ndarray[numpy.float64]] = ...,
+        out_dy: Optional[numpy.ndarray[numpy.float64]] = ...,
+        fill_holes: Optional[Tuple[int, int]] = ...
+) -> Tuple[numpy.ndarray[numpy.float64], numpy.ndarray[numpy.float64],
+           numpy.ndarray[numpy.float64]]:
     ...
 
 
-def bivariate_int8(grid: Grid2DInt8,
-                   x: numpy.ndarray[numpy.float64],
-                   y: numpy.ndarray[numpy.float64],
-                   interpolator: BivariateInterpolator2D,
-                   bounds_error: bool = ...,
-                   num_threads: int = ...) -> numpy.ndarray[numpy.float64]:
+@overload
+def spline_gradient_float64(
+        grid: TiledGrid2DFloat64,
+        x: numpy.ndarray,
+        y: numpy.ndarray,
+        nx: int = ...,
+        ny: int = ...,
+        fitting_model: str = ...,
+        boundary: str = ...,
+        bounds_error: bool = ...,
+        num_threads: int = ...,
+        out: Optional[numpy.ndarray[numpy.float64]] = ...,
+        out_dx: Optional[numpy.ndarray[numpy.float64]] = ...,
+        out_dy: Optional[numpy.ndarray[numpy.float64]] = ...,
+        fill_holes: Optional[Tuple[int, int]] = ...
+) -> Tuple[numpy.ndarray[numpy.float64], numpy.ndarray[numpy.float64],
+           numpy.ndarray[numpy.float64]]:
+    ...
+
+
+def spline_gradient_int16(
+        grid: Grid2DInt16,
+        x: numpy.ndarray,
+        y: numpy.ndarray,
+        nx: int = ...,
+        ny: int = ...,
+        fitting_model: str = ...,
+        boundary: str = ...,
+        bounds_error: bool = ...,
+        num_threads: int = ...,
+        out: Optional[numpy.ndarray[numpy.float64]] = ...,
+        out_dx: Optional[numpy.ndarray[numpy.float64]] = ...,
+        out_dy: Optional[numpy.ndarray[numpy.float64]] = ...,
+        fill_holes: Optional[Tuple[int, int]] = ...
+) -> Tuple[numpy.ndarray[numpy.float64], numpy.ndarray[numpy.float64],
+           numpy.ndarray[numpy.float64]]:
     ...
 
 
 @overload
-def quadrivariate_float32(
-        grid: Grid4DFloat32,
-        x: numpy.ndarray[numpy.float64],
-        y: numpy.ndarray[numpy.float64],
+def spline_int16(
+        grid: Grid2DInt16,
+        x: numpy.ndarray,
+        y: numpy.ndarray,
+        nx: int = ...,
+        ny: int = ...,
+        fitting_model: str = ...,
+        boundary: str = ...,
+        bounds_error: bool = ...,
+        num_threads: int = ...,
+        out: Optional[numpy.ndarray[numpy.float64]] = ...,
+        fill_holes: Optional[Tuple[int, int]] = ...
+) -> numpy.ndarray[numpy.float64]:
+    ...
+
+
+@overload
+def spline_int16(
+        grid: Grid3DInt16,
+        x: numpy.ndarray,
+        y: numpy.ndarray,
+        z: numpy.ndarray[numpy.float64],
+        nx: int = ...,
+        ny: int = ...,
+        fitting_model: str = ...,
+        boundary: str = ...,
+        bounds_error: bool = ...,
+        num_threads: int = ...,
+        out: Optional[numpy.ndarray[numpy.float64]] = ...
+) -> numpy.ndarray[numpy.float64]:
+    ...
+
+
+@overload
+def spline_int16(
+        grid: TemporalGrid3DInt16,
+        x: numpy.ndarray,
+        y: numpy.ndarray,
+        z: numpy.ndarray[numpy.int64],
+        nx: int = ...,
+        ny: int = ...,
+        fitting_model: str = ...,
+        boundary: str = ...,
+        bounds_error: bool = ...,
+        num_threads: int = ...,
+        out: Optional[numpy.ndarray[numpy.float64]] = ...
+) -> numpy.ndarray[numpy.float64]:
+    ...
+
+
+def threads_pinned() -> bool:
+    ...
+
+
+@overload
+def trivariate_float16(
+        grid: Grid3DFloat16,
+        x: numpy.ndarray,
+        y: numpy.ndarray,
         z: numpy.ndarray[numpy.float64],
-        u: numpy.ndarray[numpy.float64],
         interpolator: BivariateInterpolator3D,
         z_method: Optional[str] = ...,
-        u_method: Optional[str] = ...,
         bounds_error: bool = ...,
-        num_threads: int = ...) -> numpy.ndarray[numpy.float64]:
+        num_threads: int = ...,
+        out: Optional[numpy.ndarray[numpy.float64]] = ...
+) -> numpy.ndarray[numpy.float64]:
     ...
 
 
 @overload
-def quadrivariate_float32(
-        grid: TemporalGrid4DFloat32,
-        x: numpy.ndarray[numpy.float64],
-        y: numpy.ndarray[numpy.float64],
-        z: numpy.ndarray[numpy.int64],
-        u: numpy.ndarray[numpy.float64],
+def trivariate_float16(
+        grids: List[Grid3DFloat16],
+        x: numpy.ndarray,
+        y: numpy.ndarray,
+        z: numpy.ndarray[numpy.float64],
+        interpolator: BivariateInterpolator3D,
+        z_method: Optional[str] = ...,
+        bounds_error: bool = ...,
+        num_threads: int = ...,
+        out: Optional[numpy.ndarray[numpy.float64]] = ...
+) -> numpy.ndarray[numpy.float64]:
+    ...
+
+
+@overload
+def trivariate_float16(
+        grid: TemporalGrid3DFloat16,
+        x: numpy.ndarray,
+        y: numpy.ndarray,
+        z: numpy.ndarray,
         interpolator: TemporalBivariateInterpolator3D,
         z_method: Optional[str] = ...,
-        u_method: Optional[str] = ...,
         bounds_error: bool = ...,
-        num_threads: int = ...) -> numpy.ndarray[numpy.float64]:
+        num_threads: int = ...,
+        out: Optional[numpy.ndarray[numpy.float64]] = ...
+) -> numpy.ndarray[numpy.float64]:
     ...
 
 
 @overload
-def quadrivariate_float64(
-        grid: Grid4DFloat64,
-        x: numpy.ndarray[numpy.float64],
-        y: numpy.ndarray[numpy.float64],
+def trivariate_float16(
+        grids: List[TemporalGrid3DFloat16],
+        x: numpy.ndarray,
+        y: numpy.ndarray,
+        z: numpy.ndarray,
+        interpolator: TemporalBivariateInterpolator3D,
+        z_method: Optional[str] = ...,
+        bounds_error: bool = ...,
+        num_threads: int = ...,
+        out: Optional[numpy.ndarray[numpy.float64]] = ...
+) -> numpy.ndarray[numpy.float64]:
+    ...
+
+
+@overload
+def trivariate_float32(
+        grid: Grid3DFloat32,
+        x: numpy.ndarray,
+        y: numpy.ndarray,
         z: numpy.ndarray[numpy.float64],
-        u: numpy.ndarray[numpy.float64],
         interpolator: BivariateInterpolator3D,
         z_method: Optional[str] = ...,
-        u_method: Optional[str] = ...,
         bounds_error: bool = ...,
-        num_threads: int = ...) -> numpy.ndarray[numpy.float64]:
+        num_threads: int = ...,
+        out: Optional[numpy.ndarray[numpy.float64]] = ...
+) -> numpy.ndarray[numpy.float64]:
     ...
 
 
 @overload
-def quadrivariate_float64(
-        grid: TemporalGrid4DFloat64,
-        x: numpy.ndarray[numpy.float64],
-        y: numpy.ndarray[numpy.float64],
-        z: numpy.ndarray[numpy.int64],
-        u: numpy.ndarray[numpy.float64],
-        interpolator: TemporalBivariateInterpolator3D,
+def trivariate_float32(
+        grids: List[Grid3DFloat32],
+        x: numpy.ndarray,
+        y: numpy.ndarray,
+        z: numpy.ndarray[numpy.float64],
+        interpolator: BivariateInterpolator3D,
         z_method: Optional[str] = ...,
-        u_method: Optional[str] = ...,
         bounds_error: bool = ...,
-        num_threads: int = ...) -> numpy.ndarray[numpy.float64]:
+        num_threads: int = ...,
+        out: Optional[numpy.ndarray[numpy.float64]] = ...
+) -> numpy.ndarray[numpy.float64]:
     ...
 
 
 @overload
-def spline_float32(grid: Grid2DFloat32,
-                   x: numpy.ndarray[numpy.float64],
-                   y: numpy.ndarray[numpy.float64],
-                   nx: int = ...,
-                   ny: int = ...,
-                   fitting_model: str = ...,
-                   boundary: str = ...,
-                   bounds_error: bool = ...,
-                   num_threads: int = ...) -> numpy.ndarray[numpy.float64]:
+def trivariate_float32(
+        grid: ChunkedGrid3DFloat32,
+        x: numpy.ndarray,
+        y: numpy.ndarray,
+        z: numpy.ndarray[numpy.float64],
+        interpolator: BivariateInterpolator3D,
+        z_method: Optional[str] = ...,
+        bounds_error: bool = ...,
+        num_threads: int = ...,
+        out: Optional[numpy.ndarray[numpy.float64]] = ...
+) -> numpy.ndarray[numpy.float64]:
     ...
 
 
 @overload
-def spline_float32(grid: Grid3DFloat32,
-                   x: numpy.ndarray[numpy.float64],
-                   y: numpy.ndarray[numpy.float64],
-                   z: numpy.ndarray[numpy.float64],
-                   nx: int = ...,
-                   ny: int = ...,
-                   fitting_model: str = ...,
-                   boundary: str = ...,
-                   bounds_error: bool = ...,
-                   num_threads: int = ...) -> numpy.ndarray[numpy.float64]:
+def trivariate_float32(
+        grid: TemporalGrid3DFloat32,
+        x: numpy.ndarray,
+        y: numpy.ndarray,
+        z: numpy.ndarray,
+        interpolator: TemporalBivariateInterpolator3D,
+        z_method: Optional[str] = ...,
+        bounds_error: bool = ...,
+        num_threads: int = ...,
+        out: Optional[numpy.ndarray[numpy.float64]] = ...
+) -> numpy.ndarray[numpy.float64]:
     ...
 
 
 @overload
-def spline_float32(grid: TemporalGrid3DFloat32,
-                   x: numpy.ndarray[numpy.float64],
-                   y: numpy.ndarray[numpy.float64],
-                   z: numpy.ndarray[numpy.int64],
-                   nx: int = ...,
-                   ny: int = ...,
-                   fitting_model: str = ...,
-                   boundary: str = ...,
-                   bounds_error: bool = ...,
-                   num_threads: int = ...) -> numpy.ndarray[numpy.float64]:
+def trivariate_float32(
+        grids: List[TemporalGrid3DFloat32],
+        x: numpy.ndarray,
+        y: numpy.ndarray,
+        z: numpy.ndarray,
+        interpolator: TemporalBivariateInterpolator3D,
+        z_method: Optional[str] = ...,
+        bounds_error: bool = ...,
+        num_threads: int = ...,
+        out: Optional[numpy.ndarray[numpy.float64]] = ...
+) -> numpy.ndarray[numpy.float64]:
     ...
 
 
 @overload
-def spline_float32(grid: Grid4DFloat32,
-                   x: numpy.ndarray[numpy.float64],
-                   y: numpy.ndarray[numpy.float64],
-                   z: numpy.ndarray[numpy.float64],
-                   u: numpy.ndarray[numpy.float64],
-                   nx: int = ...,
-                   ny: int = ...,
-                   fitting_model: str = ...,
-                   boundary: str = ...,
-                   bounds_error: bool = ...,
-                   num_threads: int = ...) -> numpy.ndarray[numpy.float64]:
+def trivariate_float32(
+        grid: TemporalChunkedGrid3DFloat32,
+        x: numpy.ndarray,
+        y: numpy.ndarray,
+        z: numpy.ndarray,
+        interpolator: TemporalBivariateInterpolator3D,
+        z_method: Optional[str] = ...,
+        bounds_error: bool = ...,
+        num_threads: int = ...,
+        out: Optional[numpy.ndarray[numpy.float64]] = ...
+) -> numpy.ndarray[numpy.float64]:
     ...
 
 
 @overload
-def spline_float32(grid: TemporalGrid4DFloat32,
-                   x: numpy.ndarray[numpy.float64],
-                   y: numpy.ndarray[numpy.float64],
-                   z: numpy.ndarray[numpy.int64],
-                   u: numpy.ndarray[numpy.float64],
-                   nx: int = ...,
-                   ny: int = ...,
-                   fitting_model: str = ...,
-                   boundary: str = ...,
-                   bounds_error: bool = ...,
-                   num_threads: int = ...) -> numpy.ndarray[numpy.float64]:
+def trivariate_float64(
+        grid: Grid3DFloat64,
+        x: numpy.ndarray,
+        y: numpy.ndarray,
+        z: numpy.ndarray[numpy.float64],
+        interpolator: BivariateInterpolator3D,
+        z_method: Optional[str] = ...,
+        bounds_error: bool = ...,
+        num_threads: int = ...,
+        out: Optional[numpy.ndarray[numpy.float64]] = ...
+) -> numpy.ndarray[numpy.float64]:
     ...
 
 
 @overload
-def spline_float64(grid: Grid2DFloat64,
-                   x: numpy.ndarray[numpy.float64],
-                   y: numpy.ndarray[numpy.float64],
-                   nx: int = ...,
-                   ny: int = ...,
-                   fitting_model: str = ...,
-                   boundary: str = ...,
-                   bounds_error: bool = ...,
-                   num_threads: int = ...) -> numpy.ndarray[numpy.float64]:
+def trivariate_float64(
+        grids: List[Grid3DFloat64],
+        x: numpy.ndarray,
+        y: numpy.ndarray,
+        z: numpy.ndarray[numpy.float64],
+        interpolator: BivariateInterpolator3D,
+        z_method: Optional[str] = ...,
+        bounds_error: bool = ...,
+        num_threads: int = ...,
+        out: Optional[numpy.ndarray[numpy.float64]] = ...
+) -> numpy.ndarray[numpy.float64]:
     ...
 
 
 @overload
-def spline_float64(grid: Grid3DFloat64,
-                   x: numpy.ndarray[numpy.float64],
-                   y: numpy.ndarray[numpy.float64],
-                   z: numpy.ndarray[numpy.float64],
-                   nx: int = ...,
-                   ny: int = ...,
-                   fitting_model: str = ...,
-                   boundary: str = ...,
-                   bounds_error: bool = ...,
-                   num_threads: int = ...) -> numpy.ndarray[numpy.float64]:
+def trivariate_float64(
+        grid: ChunkedGrid3DFloat64,
+        x: numpy.ndarray,
+        y: numpy.ndarray,
+        z: numpy.ndarray[numpy.float64],
+        interpolator: BivariateInterpolator3D,
+        z_method: Optional[str] = ...,
+        bounds_error: bool = ...,
+        num_threads: int = ...,
+        out: Optional[numpy.ndarray[numpy.float64]] = ...
+) -> numpy.ndarray[numpy.float64]:
     ...
 
 
 @overload
-def spline_float64(grid: TemporalGrid3DFloat64,
-                   x: numpy.ndarray[numpy.float64],
-                   y: numpy.ndarray[numpy.float64],
-                   z: numpy.ndarray[numpy.int64],
-                   nx: int = ...,
-                   ny: int = ...,
-                   fitting_model: str = ...,
-                   boundary: str = ...,
-                   bounds_error: bool = ...,
-                   num_threads: int = ...) -> numpy.ndarray[numpy.float64]:
+def trivariate_float64(
+        grid: TemporalGrid3DFloat64,
+        x: numpy.ndarray,
+        y: numpy.ndarray,
+        z: numpy.ndarray,
+        interpolator: TemporalBivariateInterpolator3D,
+        z_method: Optional[str] = ...,
+        bounds_error: bool = ...,
+        num_threads: int = ...,
+        out: Optional[numpy.ndarray[numpy.float64]] = ...
+) -> numpy.ndarray[numpy.float64]:
     ...
 
 
 @overload
-def spline_float64(grid: Grid4DFloat64,
-                   x: numpy.ndarray[numpy.float64],
-                   y: numpy.ndarray[numpy.float64],
-                   z: numpy.ndarray[numpy.float64],
-                   u: numpy.ndarray[numpy.float64],
-                   nx: int = ...,
-                   ny: int = ...,
-                   fitting_model: str = ...,
-                   boundary: str = ...,
-                   bounds_error: bool = ...,
-                   num_threads: int = ...) -> numpy.ndarray[numpy.float64]:
+def trivariate_float64(
+        grids: List[TemporalGrid3DFloat64],
+        x: numpy.ndarray,
+        y: numpy.ndarray,
+        z: numpy.ndarray,
+        interpolator: TemporalBivariateInterpolator3D,
+        z_method: Optional[str] = ...,
+        bounds_error: bool = ...,
+        num_threads: int = ...,
+        out: Optional[numpy.ndarray[numpy.float64]] = ...
+) -> numpy.ndarray[numpy.float64]:
     ...
 
 
 @overload
-def spline_float64(grid: TemporalGrid4DFloat64,
-                   x: numpy.ndarray[numpy.float64],
-                   y: numpy.ndarray[numpy.float64],
-                   z: numpy.ndarray[numpy.int64],
-                   u: numpy.ndarray[numpy.float64],
-                   nx: int = ...,
-                   ny: int = ...,
-                   fitting_model: str = ...,
-                   boundary: str = ...,
-                   bounds_error: bool = ...,
-                   num_threads: int = ...) -> numpy.ndarray[numpy.float64]:
+def trivariate_float64(
+        grid: TemporalChunkedGrid3DFloat64,
+        x: numpy.ndarray,
+        y: numpy.ndarray,
+        z: numpy.ndarray,
+        interpolator: TemporalBivariateInterpolator3D,
+        z_method: Optional[str] = ...,
+        bounds_error: bool = ...,
+        num_threads: int = ...,
+        out: Optional[numpy.ndarray[numpy.float64]] = ...
+) -> numpy.ndarray[numpy.float64]:
     ...
 
 
 @overload
-def trivariate_float32(grid: Grid3DFloat32,
-                       x: numpy.ndarray[numpy.float64],
-                       y: numpy.ndarray[numpy.float64],
-                       z: numpy.ndarray[numpy.float64],
-                       interpolator: BivariateInterpolator3D,
-                       z_method: Optional[str] = ...,
-                       bounds_error: bool = ...,
-                       num_threads: int = ...) -> numpy.ndarray[numpy.float64]:
+def trivariate_int16(
+        grid: Grid3DInt16,
+        x: numpy.ndarray,
+        y: numpy.ndarray,
+        z: numpy.ndarray[numpy.float64],
+        interpolator: BivariateInterpolator3D,
+        z_method: Optional[str] = ...,
+        bounds_error: bool = ...,
+        num_threads: int = ...,
+        out: Optional[numpy.ndarray[numpy.float64]] = ...
+) -> numpy.ndarray[numpy.float64]:
     ...
 
 
 @overload
-def trivariate_float32(grid: TemporalGrid3DFloat32,
-                       x: numpy.ndarray[numpy.float64],
-                       y: numpy.ndarray[numpy.float64],
-                       z: numpy.ndarray[numpy.int64],
-                       interpolator: TemporalBivariateInterpolator3D,
-                       z_method: Optional[str] = ...,
-                       bounds_error: bool = ...,
-                       num_threads: int = ...) -> numpy.ndarray[numpy.float64]:
+def trivariate_int16(
+        grids: List[Grid3DInt16],
+        x: numpy.ndarray,
+        y: numpy.ndarray,
+        z: numpy.ndarray[numpy.float64],
+        interpolator: BivariateInterpolator3D,
+        z_method: Optional[str] = ...,
+        bounds_error: bool = ...,
+        num_threads: int = ...,
+        out: Optional[numpy.ndarray[numpy.float64]] = ...
+) -> numpy.ndarray[numpy.float64]:
     ...
 
 
 @overload
-def trivariate_float64(grid: Grid3DFloat64,
-                       x: numpy.ndarray[numpy.float64],
-                       y: numpy.ndarray[numpy.float64],
-                       z: numpy.ndarray[numpy.float64],
-                       interpolator: BivariateInterpolator3D,
-                       z_method: Optional[str] = ...,
-                       bounds_error: bool = ...,
-                       num_threads: int = ...) -> numpy.ndarray[numpy.float64]:
+def trivariate_int16(
+        grid: TemporalGrid3DInt16,
+        x: numpy.ndarray,
+        y: numpy.ndarray,
+        z: numpy.ndarray,
+        interpolator: TemporalBivariateInterpolator3D,
+        z_method: Optional[str] = ...,
+        bounds_error: bool = ...,
+        num_threads: int = ...,
+        out: Optional[numpy.ndarray[numpy.float64]] = ...
+) -> numpy.ndarray[numpy.float64]:
     ...
 
 
 @overload
-def trivariate_float64(grid: TemporalGrid3DFloat64,
-                       x: numpy.ndarray[numpy.float64],
-                       y: numpy.ndarray[numpy.float64],
-                       z: numpy.ndarray[numpy.int64],
-                       interpolator: TemporalBivariateInterpolator3D,
-                       z_method: Optional[str] = ...,
-                       bounds_error: bool = ...,
-                       num_threads: int = ...) -> numpy.ndarray[numpy.float64]:
+def trivariate_int16(
+        grids: List[TemporalGrid3DInt16],
+        x: numpy.ndarray,
+        y: numpy.ndarray,
+        z: numpy.ndarray,
+        interpolator: TemporalBivariateInterpolator3D,
+        z_method: Optional[str] = ...,
+        bounds_error: bool = ...,
+        num_threads: int = ...,
+        out: Optional[numpy.ndarray[numpy.float64]] = ...
+) -> numpy.ndarray[numpy.float64]:
     ...
@@ -0,0 +1,67 @@
+// Copyright (c) 2022 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <optional>
+
+#include "pyinterp/binning.hpp"
+#include "utils.hpp"
+
+namespace bench = pyinterp::benchmarks;
+
+/// Number of samples pushed by iteration.
+constexpr int64_t kSamples = 1000000;
+
+/// Binning strategies benchmarked.
+enum Strategy : int64_t {
+  kNearest = 0,  //!< Samples assigned to the nearest bin.
+  kLinear = 1,   //!< Samples spread over the four bins around them.
+};
+
+// Samples scattered over a grid, binned in a Cartesian space or on the
+// surface of the WGS84 spheroid. The benchmark goes through
+// Binning2D::ingest, which does not need the Python interpreter.
+template <typename T>
+static void binning(benchmark::State& state) {
+  const auto size = state.range(0);
+  const auto simple = state.range(1) == kNearest;
+  const auto geographic = state.range(2) != 0;
+  const auto num_threads = static_cast<size_t>(state.range(3));
+  auto x_axis = geographic ? std::make_shared<pyinterp::Axis<double>>(
+                                 -180, 180 - 360.0 / size, size, 1e-6, true)
+                           : std::make_shared<pyinterp::Axis<double>>(
+                                 0, size - 1, size, 1e-6, false);
+  auto y_axis = geographic ? std::make_shared<pyinterp::Axis<double>>(
+                                 -80, 80, size, 1e-6, false)
+                           : std::make_shared<pyinterp::Axis<double>>(
+                                 0, size - 1, size, 1e-6, false);
+  auto wgs = geographic ? std::optional<pyinterp::geodetic::System>(
+                              pyinterp::detail::geodetic::System())
+                        : std::nullopt;
+  const auto x = geographic ? bench::uniform<T>(kSamples, T(-180), T(180))
+                            : bench::uniform<T>(kSamples, T(0), T(size - 1));
+  const auto y =
+      geographic
+          ? bench::uniform<T>(kSamples, T(-80), T(80), bench::kSeed + 1)
+          : bench::uniform<T>(kSamples, T(0), T(size - 1), bench::kSeed + 1);
+  const auto z = bench::uniform<T>(kSamples, T(0), T(1), bench::kSeed + 2);
+
+  for (auto _ : state) {
+    auto binning = pyinterp::Binning2D<T>(x_axis, y_axis, wgs);
+    binning.ingest(x, y, z, simple, num_threads);
+    benchmark::ClobberMemory();
+  }
+  bench::set_items_processed(state, kSamples);
+}
+
+BENCHMARK_TEMPLATE(binning, double)
+    ->ArgNames({"size", "linear", "geographic", "threads"})
+    ->ArgsProduct({{256, 2048}, {kNearest, kLinear}, {0, 1}, {1, 4}})
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(binning, float)
+    ->ArgNames({"size", "linear", "geographic", "threads"})
+    ->ArgsProduct({{256, 2048}, {kNearest, kLinear}, {0, 1}, {1, 4}})
+    ->UseRealTime();
@@ -0,0 +1,97 @@
+// Copyright (c) 2022 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+#include "pyinterp/detail/geometry/rtree.hpp"
+#include "pyinterp/detail/thread.hpp"
+#include "utils.hpp"
+
+namespace bench = pyinterp::benchmarks;
+namespace detail = pyinterp::detail;
+namespace geometry = pyinterp::detail::geometry;
+
+/// Number of points searched by iteration.
+constexpr int64_t kQueries = 10000;
+
+// The points indexed are Cartesian coordinates, as the ECEF coordinates
+// handled by the Python RTree.
+template <typename T>
+using RTree = geometry::RTree<T, T, 3>;
+
+// Builds "size" points scattered in the unit cube.
+template <typename T>
+static auto make_points(const int64_t size)
+    -> std::vector<typename RTree<T>::value_t> {
+  const auto x = bench::uniform<T>(size, T(0), T(1));
+  const auto y = bench::uniform<T>(size, T(0), T(1), bench::kSeed + 1);
+  const auto z = bench::uniform<T>(size, T(0), T(1), bench::kSeed + 2);
+  auto result = std::vector<typename RTree<T>::value_t>();
+  result.reserve(size);
+  for (int64_t ix = 0; ix < size; ++ix) {
+    result.emplace_back(typename RTree<T>::point_t(x(ix), y(ix), z(ix)),
+                        static_cast<T>(ix));
+  }
+  return result;
+}
+
+// Construction of the static index.
+template <typename T>
+static void packing(benchmark::State& state) {
+  const auto size = state.range(0);
+  const auto num_threads = static_cast<size_t>(state.range(1));
+  const auto points = make_points<T>(size);
+
+  for (auto _ : state) {
+    auto rtree = RTree<T>();
+    rtree.packing(points, num_threads);
+    benchmark::DoNotOptimize(rtree.size());
+  }
+  bench::set_items_processed(state, size);
+}
+
+// Search for the k nearest neighbors of points scattered in the indexed
+// domain.
+template <typename T>
+static void query(benchmark::State& state) {
+  const auto size = state.range(0);
+  const auto k = static_cast<uint32_t>(state.range(1));
+  const auto num_threads = static_cast<size_t>(state.range(2));
+  auto rtree = RTree<T>();
+  rtree.packing(make_points<T>(size));
+  const auto queries = make_points<T>(kQueries);
+  auto result = pyinterp::Vector<T>(kQueries);
+
+  for (auto _ : state) {
+    detail::dispatch(
+        [&](const size_t start, const size_t end) {
+          for (auto ix = start; ix < end; ++ix) {
+            auto nearest = rtree.query(queries[ix].first, k);
+            result(ix) = nearest.back().second;
+          }
+        },
+        kQueries, num_threads);
+    benchmark::DoNotOptimize(result.data());
+  }
+  bench::set_items_processed(state, kQueries);
+}
+
+BENCHMARK_TEMPLATE(packing, double)
+    ->ArgNames({"size", "threads"})
+    ->ArgsProduct({{100000, 1000000}, {1, 4}})
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(packing, float)
+    ->ArgNames({"size", "threads"})
+    ->ArgsProduct({{100000, 1000000}, {1, 4}})
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(query, double)
+    ->ArgNames({"size", "k", "threads"})
+    ->ArgsProduct({{100000, 1000000}, {1, 8}, {1, 4}})
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(query, float)
+    ->ArgNames({"size", "k", "threads"})
+    ->ArgsProduct({{100000, 1000000}, {1, 8}, {1, 4}})
+    ->UseRealTime();
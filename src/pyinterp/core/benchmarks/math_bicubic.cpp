@@ -0,0 +1,79 @@
+// Copyright (c) 2022 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+
+#include "pyinterp/detail/math/bicubic.hpp"
+#include "pyinterp/detail/thread.hpp"
+#include "utils.hpp"
+
+namespace bench = pyinterp::benchmarks;
+namespace detail = pyinterp::detail;
+
+/// Number of points interpolated by iteration.
+constexpr int64_t kPoints = 100000;
+
+// Interpolation of points scattered over a grid: search of the cells in the
+// axes, loading of the window of "2 * half_window" by "2 * half_window"
+// values around the point, then bicubic interpolation of the window.
+template <typename T>
+static void bicubic(benchmark::State& state) {
+  const auto size = state.range(0);
+  const auto x_axis = bench::make_axis<double>(size, state.range(1));
+  const auto y_axis = bench::make_axis<double>(size, state.range(1));
+  const auto half_window = state.range(2);
+  const auto num_threads = static_cast<size_t>(state.range(3));
+  const auto grid = bench::make_field<T>(size, size);
+  const auto x = bench::uniform<double>(kPoints, 0, size - 1);
+  const auto y = bench::uniform<double>(kPoints, 0, size - 1, bench::kSeed + 1);
+  auto result = pyinterp::Vector<double>(kPoints);
+
+  for (auto _ : state) {
+    detail::dispatch(
+        [&](const size_t start, const size_t end) {
+          auto frame = detail::math::Frame2D(half_window, half_window);
+          auto interpolator = detail::math::Bicubic(frame, "bicubic");
+          for (auto ix = static_cast<int64_t>(start);
+               ix < static_cast<int64_t>(end); ++ix) {
+            auto x_indexes = x_axis.find_indexes(x(ix));
+            auto y_indexes = y_axis.find_indexes(y(ix));
+            if (!x_indexes || !y_indexes) {
+              result(ix) = 0;
+              continue;
+            }
+            // The window is shifted to stay inside the grid.
+            const auto ix0 = std::clamp<int64_t>(
+                std::get<0>(*x_indexes) - half_window + 1, 0,
+                size - 2 * half_window);
+            const auto iy0 = std::clamp<int64_t>(
+                std::get<0>(*y_indexes) - half_window + 1, 0,
+                size - 2 * half_window);
+            for (int64_t jx = 0; jx < 2 * half_window; ++jx) {
+              frame.x(jx) = x_axis(ix0 + jx);
+              frame.y(jx) = y_axis(iy0 + jx);
+              for (int64_t jy = 0; jy < 2 * half_window; ++jy) {
+                frame.q(jx, jy) = static_cast<double>(grid(ix0 + jx, iy0 + jy));
+              }
+            }
+            result(ix) = interpolator.interpolate(x(ix), y(ix), frame);
+          }
+        },
+        kPoints, num_threads);
+    benchmark::DoNotOptimize(result.data());
+  }
+  bench::set_items_processed(state, kPoints);
+}
+
+BENCHMARK_TEMPLATE(bicubic, double)
+    ->ArgNames({"size", "irregular", "window", "threads"})
+    ->ArgsProduct(
+        {{256, 4096}, {bench::kRegular, bench::kIrregular}, {2, 3}, {1, 4}})
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(bicubic, float)
+    ->ArgNames({"size", "irregular", "window", "threads"})
+    ->ArgsProduct(
+        {{256, 4096}, {bench::kRegular, bench::kIrregular}, {2, 3}, {1, 4}})
+    ->UseRealTime();
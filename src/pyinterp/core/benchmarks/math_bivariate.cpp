@@ -0,0 +1,72 @@
+// Copyright (c) 2022 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+#include <benchmark/benchmark.h>
+
+#include <boost/geometry.hpp>
+
+#include "pyinterp/detail/geometry/point.hpp"
+#include "pyinterp/detail/math/bivariate.hpp"
+#include "pyinterp/detail/thread.hpp"
+#include "utils.hpp"
+
+namespace bench = pyinterp::benchmarks;
+namespace detail = pyinterp::detail;
+namespace geometry = pyinterp::detail::geometry;
+
+/// Number of points interpolated by iteration.
+constexpr int64_t kPoints = 100000;
+
+// Interpolation of points scattered over a grid: search of the cells in the
+// axes, then bilinear interpolation of the values of their corners.
+template <typename T>
+static void bivariate(benchmark::State& state) {
+  const auto size = state.range(0);
+  const auto x_axis = bench::make_axis<double>(size, state.range(1));
+  const auto y_axis = bench::make_axis<double>(size, state.range(1));
+  const auto num_threads = static_cast<size_t>(state.range(2));
+  const auto grid = bench::make_field<T>(size, size);
+  const auto x = bench::uniform<double>(kPoints, 0, size - 1);
+  const auto y = bench::uniform<double>(kPoints, 0, size - 1, bench::kSeed + 1);
+  const auto interpolator = detail::math::Bilinear<geometry::Point2D, T>();
+  auto result = pyinterp::Vector<T>(kPoints);
+
+  for (auto _ : state) {
+    detail::dispatch(
+        [&](const size_t start, const size_t end) {
+          for (auto ix = static_cast<int64_t>(start);
+               ix < static_cast<int64_t>(end); ++ix) {
+            auto x_indexes = x_axis.find_indexes(x(ix));
+            auto y_indexes = y_axis.find_indexes(y(ix));
+            if (!x_indexes || !y_indexes) {
+              result(ix) = T(0);
+              continue;
+            }
+            auto [ix0, ix1] = *x_indexes;
+            auto [iy0, iy1] = *y_indexes;
+            result(ix) = interpolator.evaluate(
+                geometry::Point2D<T>(static_cast<T>(x(ix)),
+                                     static_cast<T>(y(ix))),
+                geometry::Point2D<T>(static_cast<T>(x_axis(ix0)),
+                                     static_cast<T>(y_axis(iy0))),
+                geometry::Point2D<T>(static_cast<T>(x_axis(ix1)),
+                                     static_cast<T>(y_axis(iy1))),
+                grid(ix0, iy0), grid(ix0, iy1), grid(ix1, iy0),
+                grid(ix1, iy1));
+          }
+        },
+        kPoints, num_threads);
+    benchmark::DoNotOptimize(result.data());
+  }
+  bench::set_items_processed(state, kPoints);
+}
+
+BENCHMARK_TEMPLATE(bivariate, double)
+    ->ArgNames({"size", "irregular", "threads"})
+    ->ArgsProduct({{256, 4096}, {bench::kRegular, bench::kIrregular}, {1, 4}})
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(bivariate, float)
+    ->ArgNames({"size", "irregular", "threads"})
+    ->ArgsProduct({{256, 4096}, {bench::kRegular, bench::kIrregular}, {1, 4}})
+    ->UseRealTime();
@@ -0,0 +1,83 @@
+// Copyright (c) 2022 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+#include <benchmark/benchmark.h>
+
+#include <random>
+
+#include "pyinterp/detail/math/gauss_seidel.hpp"
+#include "utils.hpp"
+
+namespace bench = pyinterp::benchmarks;
+namespace math = pyinterp::detail::math;
+
+// Builds a grid whose values are undefined, and replaced by zero, with a
+// probability of 30%.
+template <typename T>
+static auto build_grid(const int64_t size, pyinterp::Matrix<bool>& mask)
+    -> pyinterp::Matrix<T> {
+  auto generator = std::mt19937(bench::kSeed);
+  auto distribution = std::uniform_real_distribution<double>(0, 1);
+  auto grid = bench::make_field<T>(size, size);
+  mask.resize(size, size);
+  for (int64_t iy = 0; iy < size; ++iy) {
+    for (int64_t ix = 0; ix < size; ++ix) {
+      mask(ix, iy) = distribution(generator) < 0.3;
+      if (mask(ix, iy)) {
+        grid(ix, iy) = T(0);
+      }
+    }
+  }
+  return grid;
+}
+
+// One iteration of the red-black ordering. The pixels are not retired: the
+// cost of an iteration does not depend on the convergence.
+template <typename T>
+static void red_black(benchmark::State& state) {
+  const auto size = state.range(0);
+  const auto num_threads = static_cast<size_t>(state.range(1));
+  auto mask = pyinterp::Matrix<bool>();
+  auto grid = build_grid<T>(size, mask);
+  auto cells = math::red_black_cells(grid, mask, true);
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(math::red_black_gauss_seidel(
+        grid, cells, T(1.5), T(1e-4), false, num_threads));
+  }
+  bench::set_items_processed(state, mask.count());
+}
+
+// One iteration of the lexicographic ordering.
+template <typename T>
+static void lexicographic(benchmark::State& state) {
+  const auto size = state.range(0);
+  const auto num_threads = static_cast<size_t>(state.range(1));
+  auto mask = pyinterp::Matrix<bool>();
+  auto grid = build_grid<T>(size, mask);
+  auto strips = math::lexicographic_cells(grid, mask, true, num_threads);
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(math::lexicographic_gauss_seidel(
+        grid, strips, T(1.5), T(1e-4), false));
+  }
+  bench::set_items_processed(state, mask.count());
+}
+
+BENCHMARK_TEMPLATE(red_black, double)
+    ->ArgNames({"size", "threads"})
+    ->ArgsProduct({{256, 2048}, {1, 4}})
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(red_black, float)
+    ->ArgNames({"size", "threads"})
+    ->ArgsProduct({{256, 2048}, {1, 4}})
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(lexicographic, double)
+    ->ArgNames({"size", "threads"})
+    ->ArgsProduct({{256, 2048}, {1, 4}})
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(lexicographic, float)
+    ->ArgNames({"size", "threads"})
+    ->ArgsProduct({{256, 2048}, {1, 4}})
+    ->UseRealTime();
@@ -0,0 +1,67 @@
+// Copyright (c) 2022 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+#include <benchmark/benchmark.h>
+
+#include <cmath>
+#include <limits>
+
+#include "pyinterp/detail/math/loess.hpp"
+#include "pyinterp/detail/thread.hpp"
+#include "utils.hpp"
+
+namespace bench = pyinterp::benchmarks;
+namespace detail = pyinterp::detail;
+
+template <typename T>
+using RowMajor = Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic,
+                               Eigen::RowMajor>;
+
+// LOESS filter applied to the pixels of a grid, laid out as a C-contiguous
+// numpy array, whose window does not cross the boundaries of the grid. A
+// tenth of the values of the grid are undefined.
+template <typename T>
+static void loess(benchmark::State& state) {
+  const auto size = state.range(0);
+  const auto half_window = state.range(1);
+  const auto num_threads = static_cast<size_t>(state.range(2));
+  auto values = RowMajor<T>(bench::make_field<T>(size, size));
+  for (int64_t ix = 0; ix < values.size(); ix += 10) {
+    values.data()[ix] = std::numeric_limits<T>::quiet_NaN();
+  }
+  const auto kernel =
+      detail::math::LoessKernel<T>(half_window, half_window, 1.0, 1.0);
+  const auto inner = size - 2 * half_window;
+  auto result = pyinterp::Matrix<T>(inner, inner);
+
+  for (auto _ : state) {
+    detail::dispatch(
+        [&](const size_t start, const size_t end) {
+          for (auto ix = static_cast<int64_t>(start);
+               ix < static_cast<int64_t>(end); ++ix) {
+            for (int64_t iy = 0; iy < inner; ++iy) {
+              auto value = T(0);
+              auto weight = T(0);
+              for (auto dx = -half_window; dx <= half_window; ++dx) {
+                kernel.accumulate(dx, &values(ix + half_window + dx, iy), 1,
+                                  value, weight);
+              }
+              result(ix, iy) = value / weight;
+            }
+          }
+        },
+        inner, num_threads);
+    benchmark::DoNotOptimize(result.data());
+  }
+  bench::set_items_processed(state, inner * inner);
+}
+
+BENCHMARK_TEMPLATE(loess, double)
+    ->ArgNames({"size", "window", "threads"})
+    ->ArgsProduct({{256, 1024}, {3, 10}, {1, 4}})
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(loess, float)
+    ->ArgNames({"size", "window", "threads"})
+    ->ArgsProduct({{256, 1024}, {3, 10}, {1, 4}})
+    ->UseRealTime();
@@ -0,0 +1,71 @@
+// Copyright (c) 2022 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+#include <benchmark/benchmark.h>
+
+#include "pyinterp/detail/math/streaming_histogram.hpp"
+#include "utils.hpp"
+
+namespace bench = pyinterp::benchmarks;
+namespace math = pyinterp::detail::math;
+
+/// Number of values pushed by iteration.
+constexpr int64_t kValues = 100000;
+
+// Insertion of the values one at a time: the bins are trimmed after each
+// value.
+template <typename T>
+static void push(benchmark::State& state) {
+  const auto bin_count = static_cast<size_t>(state.range(0));
+  const auto values = bench::uniform<T>(kValues, T(0), T(1));
+
+  for (auto _ : state) {
+    auto histogram = math::StreamingHistogram<T>(bin_count, false);
+    for (int64_t ix = 0; ix < kValues; ++ix) {
+      histogram(values(ix));
+    }
+    benchmark::DoNotOptimize(histogram.bins().data());
+  }
+  bench::set_items_processed(state, kValues);
+}
+
+// Insertion of the values by batches, merged into the bins in a single pass.
+template <typename T>
+static void buffer(benchmark::State& state) {
+  const auto bin_count = static_cast<size_t>(state.range(0));
+  const auto values = bench::uniform<T>(kValues, T(0), T(1));
+
+  for (auto _ : state) {
+    auto histogram = math::StreamingHistogram<T>(bin_count, false);
+    for (int64_t ix = 0; ix < kValues; ++ix) {
+      histogram.buffer(values(ix));
+    }
+    histogram.flush();
+    benchmark::DoNotOptimize(histogram.bins().data());
+  }
+  bench::set_items_processed(state, kValues);
+}
+
+// Computation of a quantile of a compressed histogram.
+template <typename T>
+static void quantile(benchmark::State& state) {
+  const auto bin_count = static_cast<size_t>(state.range(0));
+  const auto values = bench::uniform<T>(kValues, T(0), T(1));
+  auto histogram = math::StreamingHistogram<T>(bin_count, false);
+  for (int64_t ix = 0; ix < kValues; ++ix) {
+    histogram.buffer(values(ix));
+  }
+  histogram.flush();
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(histogram.quantile(T(0.5)));
+  }
+}
+
+BENCHMARK_TEMPLATE(push, double)->ArgName("bins")->Arg(100)->Arg(1000);
+BENCHMARK_TEMPLATE(push, float)->ArgName("bins")->Arg(100)->Arg(1000);
+BENCHMARK_TEMPLATE(buffer, double)->ArgName("bins")->Arg(100)->Arg(1000);
+BENCHMARK_TEMPLATE(buffer, float)->ArgName("bins")->Arg(100)->Arg(1000);
+BENCHMARK_TEMPLATE(quantile, double)->ArgName("bins")->Arg(100)->Arg(1000);
+BENCHMARK_TEMPLATE(quantile, float)->ArgName("bins")->Arg(100)->Arg(1000);
@@ -0,0 +1,90 @@
+// Copyright (c) 2022 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+#include <benchmark/benchmark.h>
+
+#include <boost/geometry.hpp>
+#include <vector>
+
+#include "pyinterp/detail/geometry/point.hpp"
+#include "pyinterp/detail/math/trivariate.hpp"
+#include "pyinterp/detail/thread.hpp"
+#include "utils.hpp"
+
+namespace bench = pyinterp::benchmarks;
+namespace detail = pyinterp::detail;
+namespace geometry = pyinterp::detail::geometry;
+
+/// Number of points interpolated by iteration.
+constexpr int64_t kPoints = 100000;
+
+/// Number of values of the Z axis.
+constexpr int64_t kLayers = 8;
+
+// Interpolation of points scattered over a 3D grid: bilinear interpolation on
+// the two layers framing the point, then linear interpolation along Z.
+template <typename T>
+static void trivariate(benchmark::State& state) {
+  const auto size = state.range(0);
+  const auto x_axis = bench::make_axis<double>(size, state.range(1));
+  const auto y_axis = bench::make_axis<double>(size, state.range(1));
+  const auto z_axis = bench::make_axis<double>(kLayers, state.range(1));
+  const auto num_threads = static_cast<size_t>(state.range(2));
+  auto grid = std::vector<pyinterp::Matrix<T>>();
+  for (int64_t iz = 0; iz < kLayers; ++iz) {
+    grid.emplace_back(bench::make_field<T>(size, size).array() + T(iz));
+  }
+  const auto x = bench::uniform<double>(kPoints, 0, size - 1);
+  const auto y = bench::uniform<double>(kPoints, 0, size - 1, bench::kSeed + 1);
+  const auto z =
+      bench::uniform<double>(kPoints, 0, kLayers - 1, bench::kSeed + 2);
+  const auto interpolator = detail::math::Bilinear<geometry::Point3D, T>();
+  auto result = pyinterp::Vector<T>(kPoints);
+
+  for (auto _ : state) {
+    detail::dispatch(
+        [&](const size_t start, const size_t end) {
+          for (auto ix = static_cast<int64_t>(start);
+               ix < static_cast<int64_t>(end); ++ix) {
+            auto x_indexes = x_axis.find_indexes(x(ix));
+            auto y_indexes = y_axis.find_indexes(y(ix));
+            auto z_indexes = z_axis.find_indexes(z(ix));
+            if (!x_indexes || !y_indexes || !z_indexes) {
+              result(ix) = T(0);
+              continue;
+            }
+            auto [ix0, ix1] = *x_indexes;
+            auto [iy0, iy1] = *y_indexes;
+            auto [iz0, iz1] = *z_indexes;
+            const auto& q0 = grid[iz0];
+            const auto& q1 = grid[iz1];
+            result(ix) = detail::math::trivariate<geometry::Point3D, T>(
+                geometry::Point3D<T>(static_cast<T>(x(ix)),
+                                     static_cast<T>(y(ix)),
+                                     static_cast<T>(z(ix))),
+                geometry::Point3D<T>(static_cast<T>(x_axis(ix0)),
+                                     static_cast<T>(y_axis(iy0)),
+                                     static_cast<T>(z_axis(iz0))),
+                geometry::Point3D<T>(static_cast<T>(x_axis(ix1)),
+                                     static_cast<T>(y_axis(iy1)),
+                                     static_cast<T>(z_axis(iz1))),
+                q0(ix0, iy0), q0(ix0, iy1), q0(ix1, iy0), q0(ix1, iy1),
+                q1(ix0, iy0), q1(ix0, iy1), q1(ix1, iy0), q1(ix1, iy1),
+                &interpolator);
+          }
+        },
+        kPoints, num_threads);
+    benchmark::DoNotOptimize(result.data());
+  }
+  bench::set_items_processed(state, kPoints);
+}
+
+BENCHMARK_TEMPLATE(trivariate, double)
+    ->ArgNames({"size", "irregular", "threads"})
+    ->ArgsProduct({{256, 1024}, {bench::kRegular, bench::kIrregular}, {1, 4}})
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(trivariate, float)
+    ->ArgNames({"size", "irregular", "threads"})
+    ->ArgsProduct({{256, 1024}, {bench::kRegular, bench::kIrregular}, {1, 4}})
+    ->UseRealTime();
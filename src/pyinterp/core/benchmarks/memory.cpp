@@ -0,0 +1,143 @@
+// Copyright (c) 2022 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+#include "pyinterp/detail/geometry/rtree.hpp"
+#include "pyinterp/detail/math/frame.hpp"
+#include "pyinterp/detail/profiling.hpp"
+#include "pyinterp/detail/thread.hpp"
+#include "utils.hpp"
+
+namespace bench = pyinterp::benchmarks;
+namespace detail = pyinterp::detail;
+namespace geometry = pyinterp::detail::geometry;
+namespace profiling = pyinterp::detail::profiling;
+
+/// Number of points searched by iteration.
+constexpr int64_t kQueries = 10000;
+
+template <typename T>
+using RTree = geometry::RTree<T, T, 3>;
+
+// Builds "size" points scattered in the unit cube.
+template <typename T>
+static auto make_points(const int64_t size)
+    -> std::vector<typename RTree<T>::value_t> {
+  const auto x = bench::uniform<T>(size, T(0), T(1));
+  const auto y = bench::uniform<T>(size, T(0), T(1), bench::kSeed + 1);
+  const auto z = bench::uniform<T>(size, T(0), T(1), bench::kSeed + 2);
+  auto result = std::vector<typename RTree<T>::value_t>();
+  result.reserve(size);
+  for (int64_t ix = 0; ix < size; ++ix) {
+    result.emplace_back(typename RTree<T>::point_t(x(ix), y(ix), z(ix)),
+                        static_cast<T>(ix));
+  }
+  return result;
+}
+
+// Starts the accounting of the memory allocated by the benchmarked code.
+static auto start_accounting() -> void {
+  profiling::enable(true);
+  profiling::reset();
+}
+
+// Stops the accounting and records, in the reports, the memory allocated by
+// an iteration of the benchmark, and the peak of memory held at the same
+// time.
+static auto stop_accounting(benchmark::State& state,
+                            const profiling::Counter counter) -> void {
+  const auto item = profiling::snapshot()[counter];
+  profiling::enable(false);
+  const auto iterations = static_cast<double>(state.iterations());
+  state.counters["allocations"] =
+      static_cast<double>(item.allocations) / iterations;
+  state.counters["bytes"] = benchmark::Counter(
+      static_cast<double>(item.bytes) / iterations,
+      benchmark::Counter::kDefaults, benchmark::Counter::kIs1024);
+  state.counters["peak_bytes"] =
+      benchmark::Counter(static_cast<double>(item.peak_bytes),
+                         benchmark::Counter::kDefaults,
+                         benchmark::Counter::kIs1024);
+}
+
+// Frames allocated by the interpolation of a block of points: one per thread,
+// reused for all the points of the block.
+static void frame(benchmark::State& state) {
+  const auto size = state.range(0);
+  const auto num_threads = static_cast<size_t>(state.range(1));
+
+  start_accounting();
+  for (auto _ : state) {
+    detail::dispatch(
+        [&](const size_t /*start*/, const size_t /*end*/) {
+          auto frame = detail::math::Frame3D<double>(size, size, 1);
+          benchmark::DoNotOptimize(frame.x()->data());
+        },
+        kQueries, num_threads);
+  }
+  stop_accounting(state, profiling::kLoadFrame);
+}
+
+// Lists of the k nearest neighbors returned by the RTree.
+template <typename T>
+static void query(benchmark::State& state) {
+  const auto k = static_cast<uint32_t>(state.range(0));
+  const auto num_threads = static_cast<size_t>(state.range(1));
+  auto rtree = RTree<T>();
+  rtree.packing(make_points<T>(100000));
+  const auto queries = make_points<T>(kQueries);
+
+  start_accounting();
+  for (auto _ : state) {
+    detail::dispatch(
+        [&](const size_t start, const size_t end) {
+          for (auto ix = start; ix < end; ++ix) {
+            benchmark::DoNotOptimize(rtree.query(queries[ix].first, k));
+          }
+        },
+        kQueries, num_threads);
+  }
+  stop_accounting(state, profiling::kRTreeQuery);
+  bench::set_items_processed(state, kQueries);
+}
+
+// Matrices of the coordinates and values of the k nearest neighbors.
+template <typename T>
+static void nearest(benchmark::State& state) {
+  const auto k = static_cast<uint32_t>(state.range(0));
+  const auto num_threads = static_cast<size_t>(state.range(1));
+  auto rtree = RTree<T>();
+  rtree.packing(make_points<T>(100000));
+  const auto queries = make_points<T>(kQueries);
+
+  start_accounting();
+  for (auto _ : state) {
+    detail::dispatch(
+        [&](const size_t start, const size_t end) {
+          for (auto ix = start; ix < end; ++ix) {
+            benchmark::DoNotOptimize(
+                rtree.nearest(queries[ix].first, T(1), k));
+          }
+        },
+        kQueries, num_threads);
+  }
+  stop_accounting(state, profiling::kRTreeQuery);
+  bench::set_items_processed(state, kQueries);
+}
+
+BENCHMARK(frame)
+    ->ArgNames({"size", "threads"})
+    ->ArgsProduct({{2, 8}, {1, 4}})
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(query, double)
+    ->ArgNames({"k", "threads"})
+    ->ArgsProduct({{1, 16}, {1, 4}})
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(nearest, double)
+    ->ArgNames({"k", "threads"})
+    ->ArgsProduct({{1, 16}, {1, 4}})
+    ->UseRealTime();
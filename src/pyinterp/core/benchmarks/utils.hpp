@@ -0,0 +1,77 @@
+// Copyright (c) 2022 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+#pragma once
+#include <benchmark/benchmark.h>
+
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "pyinterp/detail/axis.hpp"
+#include "pyinterp/eigen.hpp"
+
+namespace pyinterp::benchmarks {
+
+/// Kind of the axes of the grids benchmarked.
+enum AxisKind : int64_t {
+  kRegular = 0,    //!< Evenly spaced values.
+  kIrregular = 1,  //!< Values with a varying spacing.
+};
+
+/// Seed of the random number generators: the data benchmarked are the same
+/// from one run, and one commit, to the next.
+constexpr uint32_t kSeed = 42;
+
+/// Builds an axis of "size" values covering [0, size - 1].
+template <typename T>
+auto make_axis(const int64_t size, const int64_t kind) -> detail::Axis<T> {
+  if (kind == kRegular) {
+    return detail::Axis<T>(0, static_cast<T>(size - 1), static_cast<T>(size),
+                           T(1e-6), false);
+  }
+  auto values = Vector<T>(size);
+  for (int64_t ix = 0; ix < size; ++ix) {
+    // The step varies between 0.5 and 1.5.
+    values(ix) = static_cast<T>(ix) +
+                 static_cast<T>(0.25 * std::sin(static_cast<double>(ix)));
+  }
+  values(size - 1) = static_cast<T>(size - 1);
+  return detail::Axis<T>(values, T(1e-6), false);
+}
+
+/// Draws "size" values uniformly distributed in [min, max).
+template <typename T>
+auto uniform(const int64_t size, const T min, const T max,
+             const uint32_t seed = kSeed) -> Vector<T> {
+  auto generator = std::mt19937(seed);
+  auto distribution = std::uniform_real_distribution<T>(min, max);
+  auto result = Vector<T>(size);
+  for (int64_t ix = 0; ix < size; ++ix) {
+    result(ix) = distribution(generator);
+  }
+  return result;
+}
+
+/// Builds a smooth field sampled on a grid of nx by ny values.
+template <typename T>
+auto make_field(const int64_t nx, const int64_t ny) -> Matrix<T> {
+  auto result = Matrix<T>(nx, ny);
+  for (int64_t iy = 0; iy < ny; ++iy) {
+    for (int64_t ix = 0; ix < nx; ++ix) {
+      result(ix, iy) =
+          static_cast<T>(std::sin(ix * 0.02) * std::cos(iy * 0.03));
+    }
+  }
+  return result;
+}
+
+/// Records the number of items processed per second in the reports.
+inline auto set_items_processed(benchmark::State& state, const int64_t items)
+    -> void {
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * items);
+}
+
+}  // namespace pyinterp::benchmarks
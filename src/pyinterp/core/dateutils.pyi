@@ -1,7 +1,8 @@
 import numpy
 
 
-def date(array: numpy.ndarray) -> numpy.ndarray:
+def date(array: numpy.ndarray,
+         num_threads: int = ...) -> numpy.ndarray:
     ...
 
 
@@ -9,17 +10,21 @@ def datetime(array: numpy.ndarray) -> numpy.ndarray:
     ...
 
 
-def timedelta_since_january(array: numpy.ndarray) -> numpy.ndarray:
+def timedelta_since_january(array: numpy.ndarray,
+                            num_threads: int = ...) -> numpy.ndarray:
     ...
 
 
-def isocalendar(array: numpy.ndarray) -> numpy.ndarray:
+def isocalendar(array: numpy.ndarray,
+                num_threads: int = ...) -> numpy.ndarray:
     ...
 
 
-def time(array: numpy.ndarray) -> numpy.ndarray:
+def time(array: numpy.ndarray,
+         num_threads: int = ...) -> numpy.ndarray:
     ...
 
 
-def weekday(array: numpy.ndarray) -> numpy.ndarray:
+def weekday(array: numpy.ndarray,
+            num_threads: int = ...) -> numpy.ndarray:
     ...
@@ -1,4 +1,4 @@
-from typing import ClassVar, Tuple, overload
+from typing import Callable, ClassVar, Optional, Tuple, overload
 import numpy
 from . import (
     Grid2DFloat32,
@@ -7,6 +7,8 @@ from . import (
     Grid3DFloat64,
     TemporalGrid3DFloat32,
     TemporalGrid3DFloat64,
+    TiledGrid2DFloat32,
+    TiledGrid2DFloat64,
 )
 
 
@@ -111,6 +113,80 @@ def gauss_seidel_float64(grid: numpy.ndarray[numpy.float64],
     ...
 
 
+def gauss_seidel_tile_float32(
+        tile: numpy.ndarray[numpy.float32],
+        exchange: Callable[[], None],
+        origin: Tuple[int, int],
+        shape: Tuple[int, int],
+        reduce: Optional[Callable[[float], float]] = ...,
+        first_guess: FirstGuess = ...,
+        is_circle: bool = ...,
+        max_iterations: int = ...,
+        epsilon: float = ...,
+        relaxation: float = ...,
+        num_thread: int = ...) -> Tuple[int, float]:
+    ...
+
+
+def gauss_seidel_tile_float64(
+        tile: numpy.ndarray[numpy.float64],
+        exchange: Callable[[], None],
+        origin: Tuple[int, int],
+        shape: Tuple[int, int],
+        reduce: Optional[Callable[[float], float]] = ...,
+        first_guess: FirstGuess = ...,
+        is_circle: bool = ...,
+        max_iterations: int = ...,
+        epsilon: float = ...,
+        relaxation: float = ...,
+        num_thread: int = ...) -> Tuple[int, float]:
+    ...
+
+
+@overload
+def loess_3d_float32(grid: Grid3DFloat32,
+                     nx: int = ...,
+                     ny: int = ...,
+                     nz: int = ...,
+                     value_type: ValueType = ...,
+                     separable: bool = ...,
+                     num_threads: int = ...) -> numpy.ndarray[numpy.float32]:
+    ...
+
+
+@overload
+def loess_3d_float32(grid: TemporalGrid3DFloat32,
+                     nx: int = ...,
+                     ny: int = ...,
+                     nz: int = ...,
+                     value_type: ValueType = ...,
+                     separable: bool = ...,
+                     num_threads: int = ...) -> numpy.ndarray[numpy.float32]:
+    ...
+
+
+@overload
+def loess_3d_float64(grid: Grid3DFloat64,
+                     nx: int = ...,
+                     ny: int = ...,
+                     nz: int = ...,
+                     value_type: ValueType = ...,
+                     separable: bool = ...,
+                     num_threads: int = ...) -> numpy.ndarray[numpy.float64]:
+    ...
+
+
+@overload
+def loess_3d_float64(grid: TemporalGrid3DFloat64,
+                     nx: int = ...,
+                     ny: int = ...,
+                     nz: int = ...,
+                     value_type: ValueType = ...,
+                     separable: bool = ...,
+                     num_threads: int = ...) -> numpy.ndarray[numpy.float64]:
+    ...
+
+
 @overload
 def loess_float32(grid: Grid2DFloat32,
                   nx: int = ...,
@@ -120,6 +196,15 @@ def loess_float32(grid: Grid2DFloat32,
     ...
 
 
+@overload
+def loess_float32(grid: TiledGrid2DFloat32,
+                  nx: int = ...,
+                  ny: int = ...,
+                  value_type: ValueType = ...,
+                  num_threads: int = ...) -> numpy.ndarray[numpy.float32]:
+    ...
+
+
 @overload
 def loess_float32(grid: Grid3DFloat32,
                   nx: int = ...,
@@ -147,6 +232,15 @@ def loess_float64(grid: Grid2DFloat64,
     ...
 
 
+@overload
+def loess_float64(grid: TiledGrid2DFloat64,
+                  nx: int = ...,
+                  ny: int = ...,
+                  value_type: ValueType = ...,
+                  num_threads: int = ...) -> numpy.ndarray[numpy.float64]:
+    ...
+
+
 @overload
 def loess_float64(grid: Grid3DFloat64,
                   nx: int = ...,
@@ -163,3 +257,21 @@ def loess_float64(grid: TemporalGrid3DFloat64,
                   value_type: ValueType = ...,
                   num_threads: int = ...) -> numpy.ndarray[numpy.float64]:
     ...
+
+
+def spectral_float32(grid: numpy.ndarray[numpy.float32],
+                     first_guess: FirstGuess = ...,
+                     is_circle: bool = ...,
+                     max_iterations: int = ...,
+                     epsilon: float = ...,
+                     num_thread: int = ...) -> Tuple[int, float]:
+    ...
+
+
+def spectral_float64(grid: numpy.ndarray[numpy.float64],
+                     first_guess: FirstGuess = ...,
+                     is_circle: bool = ...,
+                     max_iterations: int = ...,
+                     epsilon: float = ...,
+                     num_thread: int = ...) -> Tuple[int, float]:
+    ...
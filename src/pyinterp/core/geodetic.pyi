@@ -1,4 +1,4 @@
-from typing import Any, ClassVar, Optional, overload
+from typing import Any, ClassVar, List, Optional, Tuple, overload
 import numpy
 from .. import geodetic
 
@@ -98,6 +98,64 @@ class Coordinates:
         ...
 
 
+class MultiPolygon:
+    __hash__: ClassVar[None] = ...
+
+    def __init__(self, polygons: Optional[list] = ...) -> None:
+        ...
+
+    def append(self, polygon: Polygon) -> None:
+        ...
+
+    def area(self, wgs: Optional[System] = ...) -> float:
+        ...
+
+    @overload
+    def covered_by(self, point: Point) -> bool:
+        ...
+
+    @overload
+    def covered_by(self,
+                   lon: numpy.ndarray[numpy.float64],
+                   lat: numpy.ndarray[numpy.float64],
+                   num_threads: int = ...) -> numpy.ndarray[numpy.int8]:
+        ...
+
+    def envelope(self) -> Box:
+        ...
+
+    @staticmethod
+    def read_wkt(wkt: str) -> MultiPolygon:
+        ...
+
+    def which_polygon(self,
+                      lon: numpy.ndarray[numpy.float64],
+                      lat: numpy.ndarray[numpy.float64],
+                      num_threads: int = ...) -> numpy.ndarray[numpy.int64]:
+        ...
+
+    def wkt(self) -> str:
+        ...
+
+    def __eq__(self, other: MultiPolygon) -> bool:
+        ...
+
+    def __getitem__(self, index: int) -> Polygon:
+        ...
+
+    def __getstate__(self) -> tuple:
+        ...
+
+    def __len__(self) -> int:
+        ...
+
+    def __ne__(self, other: MultiPolygon) -> bool:
+        ...
+
+    def __setstate__(self, arg0: tuple) -> None:
+        ...
+
+
 class Point:
     __hash__: ClassVar[None] = ...
     lat: float
@@ -196,6 +254,32 @@ class Polygon:
         ...
 
 
+class PreparedPolygon:
+    def __init__(self, polygon: Polygon) -> None:
+        ...
+
+    @overload
+    def covered_by(self, point: Point) -> bool:
+        ...
+
+    @overload
+    def covered_by(self,
+                   lon: numpy.ndarray[numpy.float64],
+                   lat: numpy.ndarray[numpy.float64],
+                   num_threads: int = ...) -> numpy.ndarray[numpy.int8]:
+        ...
+
+    def __getstate__(self) -> tuple:
+        ...
+
+    def __setstate__(self, arg0: tuple) -> None:
+        ...
+
+    @property
+    def polygon(self) -> Polygon:
+        ...
+
+
 class System(_System):
     __hash__: ClassVar[None] = ...
 
@@ -277,6 +361,27 @@ def coordinate_distances(
     ...
 
 
+@overload
+def crossovers(
+    lon1: numpy.ndarray[numpy.float64], lat1: numpy.ndarray[numpy.float64],
+    lon2: numpy.ndarray[numpy.float64], lat2: numpy.ndarray[numpy.float64]
+) -> Tuple[numpy.ndarray[numpy.float64], numpy.ndarray[numpy.float64],
+           numpy.ndarray[numpy.float64], numpy.ndarray[numpy.float64]]:
+    ...
+
+
+@overload
+def crossovers(
+    tracks: List[Tuple[numpy.ndarray[numpy.float64],
+                       numpy.ndarray[numpy.float64]]],
+    pairs: numpy.ndarray[numpy.int64],
+    num_threads: int = ...
+) -> Tuple[numpy.ndarray[numpy.int64], numpy.ndarray[numpy.float64],
+           numpy.ndarray[numpy.float64], numpy.ndarray[numpy.float64],
+           numpy.ndarray[numpy.float64]]:
+    ...
+
+
 def normalize_longitudes(lon: numpy.ndarray[numpy.float64],
                          min_lon: float = ...) -> None:
     ...
@@ -8,14 +8,178 @@ from . import int64
 from .. import geodetic
 
 
+class IndexFloat32:
+    def __init__(self, precision: int,
+                 system: Optional[geodetic.System]) -> None:
+        ...
+
+    def cells(self) -> int:
+        ...
+
+    def packing(self,
+                lon: numpy.ndarray[numpy.float64],
+                lat: numpy.ndarray[numpy.float64],
+                values: numpy.ndarray[numpy.float32],
+                num_threads: int = ...) -> None:
+        ...
+
+    def query(self,
+              lon: numpy.ndarray[numpy.float64],
+              lat: numpy.ndarray[numpy.float64],
+              k: int = ...,
+              radius: Optional[float] = ...,
+              num_threads: int = ...) -> tuple:
+        ...
+
+    def save(self, path: str) -> None:
+        ...
+
+    def within(self,
+               lon: numpy.ndarray[numpy.float64],
+               lat: numpy.ndarray[numpy.float64],
+               radius: float,
+               num_threads: int = ...) -> tuple:
+        ...
+
+    @staticmethod
+    def load(path: str) -> "IndexFloat32":
+        ...
+
+    def __bool__(self) -> bool:
+        ...
+
+    def __getstate__(self) -> tuple:
+        ...
+
+    def __len__(self) -> int:
+        ...
+
+    def __setstate__(self, arg0: tuple) -> None:
+        ...
+
+    @property
+    def precision(self) -> int:
+        ...
+
+
+class IndexFloat64:
+    def __init__(self, precision: int,
+                 system: Optional[geodetic.System]) -> None:
+        ...
+
+    def cells(self) -> int:
+        ...
+
+    def packing(self,
+                lon: numpy.ndarray[numpy.float64],
+                lat: numpy.ndarray[numpy.float64],
+                values: numpy.ndarray[numpy.float64],
+                num_threads: int = ...) -> None:
+        ...
+
+    def query(self,
+              lon: numpy.ndarray[numpy.float64],
+              lat: numpy.ndarray[numpy.float64],
+              k: int = ...,
+              radius: Optional[float] = ...,
+              num_threads: int = ...) -> tuple:
+        ...
+
+    def save(self, path: str) -> None:
+        ...
+
+    def within(self,
+               lon: numpy.ndarray[numpy.float64],
+               lat: numpy.ndarray[numpy.float64],
+               radius: float,
+               num_threads: int = ...) -> tuple:
+        ...
+
+    @staticmethod
+    def load(path: str) -> "IndexFloat64":
+        ...
+
+    def __bool__(self) -> bool:
+        ...
+
+    def __getstate__(self) -> tuple:
+        ...
+
+    def __len__(self) -> int:
+        ...
+
+    def __setstate__(self, arg0: tuple) -> None:
+        ...
+
+    @property
+    def precision(self) -> int:
+        ...
+
+
+class IndexInt64:
+    def __init__(self, precision: int,
+                 system: Optional[geodetic.System]) -> None:
+        ...
+
+    def cells(self) -> int:
+        ...
+
+    def packing(self,
+                lon: numpy.ndarray[numpy.float64],
+                lat: numpy.ndarray[numpy.float64],
+                values: numpy.ndarray[numpy.int64],
+                num_threads: int = ...) -> None:
+        ...
+
+    def query(self,
+              lon: numpy.ndarray[numpy.float64],
+              lat: numpy.ndarray[numpy.float64],
+              k: int = ...,
+              radius: Optional[float] = ...,
+              num_threads: int = ...) -> tuple:
+        ...
+
+    def save(self, path: str) -> None:
+        ...
+
+    def within(self,
+               lon: numpy.ndarray[numpy.float64],
+               lat: numpy.ndarray[numpy.float64],
+               radius: float,
+               num_threads: int = ...) -> tuple:
+        ...
+
+    @staticmethod
+    def load(path: str) -> "IndexInt64":
+        ...
+
+    def __bool__(self) -> bool:
+        ...
+
+    def __getstate__(self) -> tuple:
+        ...
+
+    def __len__(self) -> int:
+        ...
+
+    def __setstate__(self, arg0: tuple) -> None:
+        ...
+
+    @property
+    def precision(self) -> int:
+        ...
+
+
 def area(hash: numpy.ndarray,
-         wgs: Optional[geodetic.System] = ...) -> numpy.ndarray[numpy.float64]:
+         wgs: Optional[geodetic.System] = ...,
+         num_threads: int = ...) -> numpy.ndarray[numpy.float64]:
     ...
 
 
 @overload
 def bounding_boxes(box: Optional[geodetic.Box] = ...,
-                   precision: int = ...) -> numpy.ndarray:
+                   precision: int = ...,
+                   num_threads: int = ...) -> numpy.ndarray:
     ...
 
 
@@ -28,14 +192,16 @@ def bounding_boxes(box: geodetic.Polygon = ...,
 
 def decode(
     hash: numpy.ndarray,
-    round: bool = ...
+    round: bool = ...,
+    num_threads: int = ...
 ) -> Tuple[numpy.ndarray[numpy.float64], numpy.ndarray[numpy.float64]]:
     ...
 
 
 def encode(lon: numpy.ndarray[numpy.float64],
            lat: numpy.ndarray[numpy.float64],
-           precision: int = ...) -> numpy.ndarray:
+           precision: int = ...,
+           num_threads: int = ...) -> numpy.ndarray:
     ...
 
 
@@ -45,3 +211,9 @@ def transform(hash: numpy.ndarray, precision: int = ...) -> numpy.ndarray:
 
 def where(hash: numpy.ndarray) -> dict:
     ...
+
+
+def where_arrays(
+    hash: numpy.ndarray
+) -> Tuple[numpy.ndarray, numpy.ndarray[numpy.int64]]:
+    ...
@@ -1,21 +1,45 @@
-from typing import Tuple, overload
+from typing import Optional, Tuple, overload
 import numpy
 from .. import geodetic
 
 
+def area(hash: numpy.ndarray[numpy.uint64],
+         precision: int = ...,
+         wgs: Optional[geodetic.System] = ...,
+         num_threads: int = ...) -> numpy.ndarray[numpy.float64]:
+    ...
+
+
+def bounding_boxes(polygon: geodetic.Polygon,
+                   precision: int = ...,
+                   num_threads: int = ...) -> numpy.ndarray[numpy.uint64]:
+    ...
+
+
 def decode(
     hash: numpy.ndarray[numpy.uint64],
     precision: int = ...,
-    round: bool = ...
+    round: bool = ...,
+    num_threads: int = ...
 ) -> Tuple[numpy.ndarray[numpy.float64], numpy.ndarray[numpy.float64]]:
     ...
 
 
 def encode(lon: numpy.ndarray[numpy.float64],
            lat: numpy.ndarray[numpy.float64],
-           precision: int = ...) -> numpy.ndarray[numpy.uint64]:
+           precision: int = ...,
+           num_threads: int = ...) -> numpy.ndarray[numpy.uint64]:
     ...
 
 
+@overload
 def neighbors(hash: int, precision: int = ...) -> numpy.ndarray[numpy.uint64]:
     ...
+
+
+@overload
+def neighbors(hash: numpy.ndarray[numpy.uint64],
+              precision: int = ...,
+              rings: int = ...,
+              num_threads: int = ...) -> numpy.ndarray[numpy.uint64]:
+    ...
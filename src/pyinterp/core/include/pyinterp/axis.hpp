@@ -156,26 +156,41 @@ class Axis : public detail::Axis<T>,
       -> pybind11::array_t<int64_t> {
     detail::check_array_ndim("coordinates", 1, coordinates);
 
-    auto size = coordinates.size();
+    // The coordinates are processed as a contiguous vector.
+    auto values = pybind11::array_t<T, pybind11::array::c_style |
+                                           pybind11::array::forcecast>::
+        ensure(coordinates);
+    if (!values) {
+      throw pybind11::error_already_set();
+    }
+    auto size = values.size();
     auto result =
         pybind11::array_t<int64_t>(pybind11::array::ShapeContainer({size, 2}));
-    auto _result = result.mutable_unchecked<2>();
-    auto _coordinates = coordinates.template unchecked<1>();
+    auto* ptr = result.mutable_data();
 
     {
       pybind11::gil_scoped_release release;
-      for (pybind11::ssize_t ix = 0; ix < size; ++ix) {
-        auto indexes = detail::Axis<T>::find_indexes(_coordinates(ix));
-        if (indexes) {
-          std::tie(_result(ix, 0), _result(ix, 1)) = *indexes;
-        } else {
-          _result(ix, 0) = _result(ix, 1) = -1;
-        }
-      }
+      // The columns of the result are views on the interleaved indexes.
+      detail::Axis<T>::find_indexes(
+          Eigen::Map<const Vector<T>>(values.data(), size),
+          Eigen::Map<Vector<int64_t>, 0, Eigen::InnerStride<2>>(ptr, size),
+          Eigen::Map<Vector<int64_t>, 0, Eigen::InnerStride<2>>(ptr + 1, size));
     }
     return result;
   }
 
+  /// Returns a view on the elements [start, stop) of this axis, sharing the
+  /// values of this axis.
+  ///
+  /// @param start index of the first element of the view
+  /// @param stop index following the last element of the view
+  [[nodiscard]] virtual auto view(const int64_t start, const int64_t stop) const
+      -> std::shared_ptr<Axis<T>> {
+    auto result = std::make_shared<Axis<T>>(*this);
+    result->narrow(start, stop);
+    return result;
+  }
+
   /// @copydoc detail::Axis::operator std::string() const
   virtual explicit operator std::string() const {
     auto ss = std::stringstream();
@@ -206,11 +221,12 @@ class Axis : public detail::Axis<T>,
                                     this->is_circle());
       }
     }
-    // Irregular
+    // Irregular, the values of a slice are copied.
     {
-      auto ptr = dynamic_cast<detail::axis::container::Irregular<T>*>(
-          this->handler().get());
-      if (ptr != nullptr) {
+      auto ptr = this->handler().get();
+      if (dynamic_cast<detail::axis::container::Irregular<T>*>(ptr) !=
+              nullptr ||
+          dynamic_cast<detail::axis::container::Slice<T>*>(ptr) != nullptr) {
         auto values = pybind11::array_t<T>(ptr->size());
         auto _values = values.template mutable_unchecked<1>();
         for (auto ix = 0LL; ix < ptr->size(); ++ix) {
@@ -241,12 +257,13 @@ class Axis : public detail::Axis<T>,
         return Axis();
         break;
       case detail::axis::IRREGULAR: {
+        // The values unpickled out-of-band may be read-only.
         auto ndarray = state[1].cast<pybind11::array_t<T>>();
-        return Axis(
-            std::shared_ptr<detail::axis::container::Abstract<T>>(
-                new detail::axis::container::Irregular<T>(Eigen::Map<Vector<T>>(
-                    ndarray.mutable_data(), ndarray.size()))),
-            state[2].cast<bool>());
+        return Axis(detail::axis::intern(
+                        std::make_shared<detail::axis::container::Irregular<T>>(
+                            Eigen::Map<const Vector<T>>(ndarray.data(),
+                                                        ndarray.size()))),
+                    state[2].cast<bool>());
       }
       case detail::axis::REGULAR:
         return Axis(std::shared_ptr<detail::axis::container::Abstract<T>>(
@@ -6,28 +6,47 @@
 #include <pybind11/numpy.h>
 
 #include <Eigen/Core>
-#include <boost/geometry.hpp>
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 #include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include "pyinterp/axis.hpp"
 #include "pyinterp/detail/broadcast.hpp"
-#include "pyinterp/detail/geometry/point.hpp"
+#include "pyinterp/detail/cell_grid.hpp"
 #include "pyinterp/detail/math/binning.hpp"
 #include "pyinterp/detail/math/descriptive_statistics.hpp"
+#include "pyinterp/detail/math/window_functions.hpp"
+#include "pyinterp/detail/numpy.hpp"
+#include "pyinterp/detail/serialization.hpp"
+#include "pyinterp/detail/thread.hpp"
 #include "pyinterp/eigen.hpp"
 #include "pyinterp/geodetic/system.hpp"
+#include "pyinterp/temporal_axis.hpp"
 
 namespace pyinterp {
 
 /// Group a number of more or less continuous values into a smaller number of
 /// "bins" located on a grid.
-template <typename T>
+///
+/// @tparam T Type of the values binned.
+/// @tparam Level Statistics calculated in each bin. The lower levels store
+/// smaller accumulators and skip the calculation of the higher moments; the
+/// statistics they do not calculate are NaN.
+template <typename T, detail::math::StatisticsLevel Level =
+                          detail::math::StatisticsLevel::kFull>
 class Binning2D {
  public:
   /// Statistics handled by this object.
-  using Accumulators = detail::math::Accumulators<T>;
-  using DescriptiveStatistics = detail::math::DescriptiveStatistics<T>;
+  using Accumulators = detail::math::Accumulators<T, Level>;
+  using DescriptiveStatistics = detail::math::DescriptiveStatistics<T, Level>;
 
   /// Default constructor
   ///
@@ -37,12 +56,11 @@ class Binning2D {
   /// coordinates. If this parameter is not set, the handled coordinates will be
   /// considered as Cartesian coordinates. Otherwise, "x" and "y" are considered
   /// to represents the longitudes and latitudes on a grid.
+  /// @param sparse If true, only the bins holding values are stored, which
+  /// saves memory when most of the bins of the grid stay empty.
   Binning2D(std::shared_ptr<Axis<double>> x, std::shared_ptr<Axis<double>> y,
-            std::optional<geodetic::System> wgs)
-      : x_(std::move(x)),
-        y_(std::move(y)),
-        acc_(x_->size(), y_->size()),
-        wgs_(std::move(wgs)) {}
+            std::optional<geodetic::System> wgs, const bool sparse = false)
+      : Binning2D(std::move(x), std::move(y), std::move(wgs), sparse, 1) {}
 
   /// Default destructor
   virtual ~Binning2D() = default;
@@ -68,37 +86,82 @@ class Binning2D {
   auto operator=(Binning2D&& rhs) noexcept -> Binning2D& = delete;
 
   /// Inserts new values in the grid from Z values for X, Y data coordinates.
+  ///
+  /// With several threads, each thread bins a contiguous part of the samples
+  /// into private statistics, which are then merged into the grid.
+  ///
+  /// @param x X coordinates of the samples.
+  /// @param y Y coordinates of the samples.
+  /// @param z Values of the samples.
+  /// @param simple If true, the nearest binning is used, otherwise the linear
+  /// binning.
+  /// @param num_threads The number of threads to use for the computation. If 0
+  /// all CPUs are used. If 1 is given, no parallel computing code is used at
+  /// all, which is useful for debugging.
   void push(const pybind11::array_t<T>& x, const pybind11::array_t<T>& y,
-            const pybind11::array_t<T>& z, const bool simple) {
+            const pybind11::array_t<T>& z, const bool simple,
+            const size_t num_threads) {
     detail::check_array_ndim("x", 1, x, "y", 1, y, "z", 1, z);
     detail::check_ndarray_shape("x", x, "y", y, "z", z);
+    push_samples(x, y, z, simple, num_threads,
+                 [](const pybind11::ssize_t) -> int64_t { return 0; });
+  }
 
-    if (simple) {
-      // Nearest
-      push_nearest(x, y, z);
-    } else if (!wgs_) {
-      // Cartesian linear
-      push_linear<detail::geometry::Point2D,
-                  boost::geometry::strategy::area::cartesian<>>(
-          x, y, z, boost::geometry::strategy::area::cartesian<>());
-    } else {
-      // Geographic linear
-      auto strategy = boost::geometry::strategy::area::geographic<
-          boost::geometry::strategy::vincenty, 5>(
-          boost::geometry::srs::spheroid(wgs_->semi_major_axis(),
-                                         wgs_->semi_minor_axis()));
-      push_linear<detail::geometry::GeographicPoint2D,
-                  boost::geometry::strategy::area::geographic<
-                      boost::geometry::strategy::vincenty, 5>>(x, y, z,
-                                                               strategy);
-    }
+  /// Inserts new values in the grid from Z values for X, Y data coordinates,
+  /// held by contiguous buffers. Unlike push, this method does not use the
+  /// Python interpreter: it must be called without the GIL.
+  ///
+  /// @param x X coordinates of the samples.
+  /// @param y Y coordinates of the samples.
+  /// @param z Values of the samples.
+  /// @param simple If true, the nearest binning is used, otherwise the linear
+  /// binning.
+  /// @param num_threads The number of threads to use for the computation.
+  void ingest(const Eigen::Ref<const Vector<T>>& x,
+              const Eigen::Ref<const Vector<T>>& y,
+              const Eigen::Ref<const Vector<T>>& z, const bool simple,
+              const size_t num_threads) {
+    detail::check_eigen_shape("x", x, "y", y, "z", z);
+    push_samples(x, y, z, x.size(), simple, num_threads,
+                 [](const pybind11::ssize_t) -> int64_t { return 0; });
   }
 
-  /// Reset the statistics.
-  void clear() {
-    acc_ = std::move(Matrix<DescriptiveStatistics>(x_->size(), y_->size()));
+  /// Inserts new values in the grid from Z values for X, Y data coordinates,
+  /// spreading each sample over the (2r + 1)² bins surrounding its nearest
+  /// bin. The weight given to a bin is the product of the window function
+  /// evaluated for the distances, in numbers of bins, between the sample and
+  /// the bin along each axis; the window radius is r + 1/2.
+  ///
+  /// @param x X coordinates of the samples.
+  /// @param y Y coordinates of the samples.
+  /// @param z Values of the samples.
+  /// @param wf The window function.
+  /// @param radius The number of bins r spread over on each side of the
+  /// nearest bin.
+  /// @param arg The optional argument of the window function.
+  /// @param num_threads The number of threads to use for the computation. If 0
+  /// all CPUs are used. If 1 is given, no parallel computing code is used at
+  /// all, which is useful for debugging.
+  void push_kernel(const pybind11::array_t<T>& x,
+                   const pybind11::array_t<T>& y,
+                   const pybind11::array_t<T>& z,
+                   const detail::math::window::Function wf,
+                   const uint32_t radius, const double arg,
+                   const size_t num_threads) {
+    detail::check_array_ndim("x", 1, x, "y", 1, y, "z", 1, z);
+    detail::check_ndarray_shape("x", x, "y", y, "z", z);
+    auto _x = x.template unchecked<1>();
+    auto _y = y.template unchecked<1>();
+    auto _z = z.template unchecked<1>();
+
+    pybind11::gil_scoped_release release;
+    push_window(_x, _y, _z, x.size(), wf, radius, arg, num_threads,
+                [](const pybind11::ssize_t) -> int64_t { return 0; });
   }
 
+  /// Reset the statistics.
+  void clear() { acc_.clear(); }
+
   /// Compute the count of points within each bin.
   [[nodiscard]] auto count() const -> pybind11::array_t<uint64_t> {
     return calculate_statistics<decltype(&DescriptiveStatistics::count),
@@ -162,17 +225,23 @@ class Binning2D {
     return wgs_;
   }
 
+  /// Returns true if only the bins holding values are stored.
+  [[nodiscard]] inline auto sparse() const noexcept -> bool {
+    return acc_.sparse();
+  }
+
   /// Pickle support: get state of this instance
   [[nodiscard]] auto getstate() const -> pybind11::tuple {
     return pybind11::make_tuple(
         x_->getstate(), y_->getstate(),
-        wgs_.has_value() ? wgs_->getstate() : pybind11::make_tuple(), acc());
+        wgs_.has_value() ? wgs_->getstate() : pybind11::make_tuple(),
+        marshal(), acc_.sparse());
   }
 
   /// Pickle support: set state of this instance
   static auto setstate(const pybind11::tuple& state)
-      -> std::unique_ptr<Binning2D<T>> {
-    if (state.size() != 4) {
+      -> std::unique_ptr<Binning2D> {
+    if (state.size() != 4 && state.size() != 5) {
       throw std::invalid_argument("invalid state");
     }
 
@@ -185,27 +254,27 @@ class Binning2D {
     *y = Axis<double>::setstate(state[1].cast<pybind11::tuple>());
 
     // Unmarshalling WGS system
-    auto wgs = std::optional<geodetic::System>();
-    auto wgs_state = state[2].cast<pybind11::tuple>();
-    if (!wgs_state.empty()) {
-      *wgs = geodetic::System::setstate(wgs_state);
-    }
-
-    // Unmarshalling computed statistics
-    auto acc = state[3].cast<Matrix<Accumulators>>();
-    if (acc.rows() != x->size() || acc.cols() != y->size()) {
-      throw std::invalid_argument("invalid state");
-    }
+    auto wgs = wgs_setstate(state[2]);
 
     // Unmarshalling instance
-    auto result = std::make_unique<Binning2D<T>>(x, y, wgs);
-    {
-      auto gil = pybind11::gil_scoped_release();
-      result->acc_ = std::move(acc.template cast<DescriptiveStatistics>());
-    }
+    // The previous versions did not store the storage mode.
+    auto sparse = state.size() == 5 && state[4].cast<bool>();
+    auto result = std::make_unique<Binning2D>(x, y, wgs, sparse);
+    result->unmarshal(state[3]);
     return result;
   }
 
+  /// Merges the statistics of the state of another instance, returned by
+  /// getstate(), without creating this instance: the statistics are read
+  /// directly from the serialized buffer.
+  auto merge(const pybind11::tuple& state) -> void {
+    if (state.size() != 4 && state.size() != 5) {
+      throw std::invalid_argument("invalid state");
+    }
+    check_state(state[0], state[1], state[2]);
+    unmarshal(state[3]);
+  }
+
   /// Aggregation of statistics
   auto operator+=(const Binning2D& other) -> Binning2D& {
     if (*x_ != *(other.x_) || *y_ != *(other.y_)) {
@@ -218,22 +287,187 @@ class Binning2D {
           "Unable to combine different geodetic system");
     }
 
-    for (Eigen::Index ix = 0; ix < acc_.rows(); ++ix) {
-      for (Eigen::Index iy = 0; iy < acc_.cols(); ++iy) {
-        auto& lhs = acc_(ix, iy);
-        auto& rhs = other.acc_(ix, iy);
-
-        // Statistics are defined only in the other instance.
-        if (lhs.count() == 0 && rhs.count() != 0) {
-          lhs = rhs;
-          // If the statistics are defined in both instances they can be
-          // combined.
-        } else if (lhs.count() != 0 && rhs.count() != 0) {
-          lhs += rhs;
+    other.acc_.for_each(
+        [this](const uint64_t index, const DescriptiveStatistics& item) {
+          if (item.count() != 0) {
+            merge(acc_[index], item);
+          }
+        });
+    return *this;
+  }
+
+ protected:
+  /// Constructor of the grids having a third dimension: the statistics of
+  /// the layers of the grid along this dimension are stored one after the
+  /// other along the Y axis, the bin (ix, iy) of the layer iz being the bin
+  /// (ix, iy + iz * ny) of the storage.
+  ///
+  /// @param layers Number of layers of the grid.
+  Binning2D(std::shared_ptr<Axis<double>> x, std::shared_ptr<Axis<double>> y,
+            std::optional<geodetic::System> wgs, const bool sparse,
+            const int64_t layers)
+      : x_(std::move(x)),
+        y_(std::move(y)),
+        acc_(x_->size(), y_->size() * layers, sparse),
+        wgs_(std::move(wgs)) {}
+
+  /// Gets the shape of the statistics computed.
+  [[nodiscard]] virtual auto shape() const -> std::vector<pybind11::ssize_t> {
+    return {x_->size(), y_->size()};
+  }
+
+  /// Bins the samples with the nearest or the linear binning.
+  ///
+  /// @param layer Function returning the layer of the grid in which the
+  /// sample of the given index is binned, or -1 if the sample is not binned.
+  /// It is called without the GIL, by several threads.
+  template <typename Layer>
+  void push_samples(const pybind11::array_t<T>& x,
+                    const pybind11::array_t<T>& y,
+                    const pybind11::array_t<T>& z, const bool simple,
+                    const size_t num_threads, const Layer& layer) {
+    auto _x = x.template unchecked<1>();
+    auto _y = y.template unchecked<1>();
+    auto _z = z.template unchecked<1>();
+
+    pybind11::gil_scoped_release release;
+    push_samples(_x, _y, _z, x.size(), simple, num_threads, layer);
+  }
+
+  /// Bins the samples read by the given accessors, without the GIL.
+  ///
+  /// @param size Number of samples.
+  /// @param layer Function returning the layer of the grid in which the
+  /// sample of the given index is binned, or -1 if the sample is not binned.
+  template <typename Accessor, typename Layer>
+  void push_samples(const Accessor& x, const Accessor& y, const Accessor& z,
+                    const pybind11::ssize_t size, const bool simple,
+                    const size_t num_threads, const Layer& layer) {
+    if (simple) {
+      // Nearest
+      push_nearest(x, y, z, size, num_threads, layer);
+    } else if (!wgs_) {
+      // Cartesian linear
+      const auto& y_axis = static_cast<pyinterp::detail::Axis<double>&>(*y_);
+      push_linear(
+          x, y, z, size,
+          [&y_axis](const double xi, const double yi, const double x0,
+                    const double x1, const int64_t iy0, const int64_t iy1) {
+            return detail::math::bilinear_binning_2d<double>(
+                xi, yi, x0, y_axis(iy0), x1, y_axis(iy1));
+          },
+          num_threads, layer);
+    } else {
+      // Geographic linear
+      const auto& y_axis = static_cast<pyinterp::detail::Axis<double>&>(*y_);
+      auto latitudes = std::vector<double>(y_axis.size());
+      for (int64_t iy = 0; iy < y_axis.size(); ++iy) {
+        latitudes[iy] = y_axis(iy);
+      }
+      const auto weights = detail::math::GeographicBinning2D<double>(
+          std::sqrt(wgs_->first_eccentricity_squared()), latitudes);
+      push_linear(x, y, z, size, weights, num_threads, layer);
+    }
+  }
+
+  /// Checks that the state of another instance, returned by getstate(),
+  /// defines the same grid and geodetic system.
+  ///
+  /// @param x State of the X axis.
+  /// @param y State of the Y axis.
+  /// @param wgs State of the geodetic system.
+  auto check_state(const pybind11::handle& x, const pybind11::handle& y,
+                   const pybind11::handle& wgs) const -> void {
+    if (*x_ != Axis<double>::setstate(x.cast<pybind11::tuple>()) ||
+        *y_ != Axis<double>::setstate(y.cast<pybind11::tuple>())) {
+      throw std::invalid_argument("Unable to combine different grids");
+    }
+    auto wgs_state = wgs.cast<pybind11::tuple>();
+    if (wgs_.has_value() == wgs_state.empty() ||
+        (wgs_.has_value() &&
+         *wgs_ != geodetic::System::setstate(wgs_state))) {
+      throw std::invalid_argument(
+          "Unable to combine different geodetic system");
+    }
+  }
+
+  /// Unmarshalling of a geodetic system.
+  static auto wgs_setstate(const pybind11::handle& state)
+      -> std::optional<geodetic::System> {
+    auto result = std::optional<geodetic::System>();
+    auto wgs_state = state.cast<pybind11::tuple>();
+    if (!wgs_state.empty()) {
+      result = geodetic::System::setstate(wgs_state);
+    }
+    return result;
+  }
+
+  /// Serializes the statistics: a header listing the bins holding values,
+  /// followed by the contiguous array of their accumulators. The empty bins
+  /// are not written. The buffer is returned as a vector of bytes, pickled
+  /// out-of-band by the protocol 5.
+  [[nodiscard]] auto marshal() const -> pybind11::array_t<uint8_t> {
+    auto buffer = std::string();
+    {
+      auto gil = pybind11::gil_scoped_release();
+      const auto cells = acc_.indexes([](const DescriptiveStatistics& item) {
+        return item.count() != 0;
+      });
+      auto writer = detail::serialization::Writer();
+      writer.reserve(4 * sizeof(int64_t) +
+                     cells.size() * (sizeof(uint64_t) + sizeof(Accumulators)));
+      detail::serialization::write_grid_header(writer, acc_.rows(),
+                                               acc_.cols(), cells);
+      for (const auto& ix : cells) {
+        writer.write(static_cast<const Accumulators&>(acc_[ix]));
+      }
+      buffer = std::move(writer).str();
+    }
+    return detail::numpy::to_bytes_array(std::move(buffer));
+  }
+
+  /// Merges the statistics serialized by marshal() into this instance. The
+  /// formats of the previous versions, the serialized buffer stored in a
+  /// bytes object or a matrix of accumulators, are also accepted.
+  auto unmarshal(const pybind11::object& data) -> void {
+    if (pybind11::isinstance<pybind11::array_t<uint8_t>>(data)) {
+      auto array =
+          data.cast<pybind11::array_t<uint8_t, pybind11::array::c_style>>();
+      unmarshal(std::string_view(reinterpret_cast<const char*>(array.data()),
+                                 static_cast<size_t>(array.size())));
+      return;
+    }
+    // The matrices of accumulators were only written by the grids
+    // calculating all the statistics.
+    if constexpr (Level == detail::math::StatisticsLevel::kFull) {
+      if (!pybind11::isinstance<pybind11::bytes>(data)) {
+        auto acc = data.cast<Matrix<Accumulators>>();
+        if (acc.rows() != acc_.rows() || acc.cols() != acc_.cols()) {
+          throw std::invalid_argument("invalid state");
+        }
+        auto gil = pybind11::gil_scoped_release();
+        for (Eigen::Index ix = 0; ix < acc.size(); ++ix) {
+          auto item = DescriptiveStatistics(acc.data()[ix]);
+          if (item.count() != 0) {
+            merge(acc_[ix], item);
+          }
         }
+        return;
       }
     }
-    return *this;
+
+    unmarshal(data.cast<std::string_view>());
+  }
+
+  /// Merges the statistics read from a serialized buffer.
+  auto unmarshal(const std::string_view& buffer) -> void {
+    auto gil = pybind11::gil_scoped_release();
+    auto reader = detail::serialization::Reader(buffer);
+    const auto cells = detail::serialization::read_grid_header(
+        reader, acc_.rows(), acc_.cols());
+    for (const auto& ix : cells) {
+      merge(acc_[ix], DescriptiveStatistics(reader.read<Accumulators>()));
+    }
   }
 
  private:
@@ -242,7 +476,7 @@ class Binning2D {
   std::shared_ptr<Axis<double>> y_;
 
   /// Statistics grid
-  Matrix<DescriptiveStatistics> acc_;
+  detail::CellGrid<DescriptiveStatistics> acc_;
 
   /// Geodetic coordinate system required to calculate areas (optional if the
   /// user wishes to handle Cartesian coordinates).
@@ -252,109 +486,538 @@ class Binning2D {
   template <typename Func, typename Type = T, typename... Args>
   [[nodiscard]] auto calculate_statistics(const Func& func, Args... args) const
       -> pybind11::array_t<Type> {
-    pybind11::array_t<Type> z({x_->size(), y_->size()});
-    auto _z = z.template mutable_unchecked<2>();
+    pybind11::array_t<Type> z(shape());
+    auto* _z = z.mutable_data();
     {
       pybind11::gil_scoped_release release;
 
-      for (Eigen::Index ix = 0; ix < acc_.rows(); ++ix) {
-        for (Eigen::Index iy = 0; iy < acc_.cols(); ++iy) {
-          _z(ix, iy) = (acc_(ix, iy).*func)(args...);
-        }
+      // The bins not stored by a sparse grid are empty.
+      if (acc_.sparse()) {
+        std::fill_n(_z, z.size(),
+                    static_cast<Type>((acc_.empty().*func)(args...)));
       }
+      // The layers of the grid are stored along the Y axis, but are the
+      // last dimension of the statistics.
+      const auto rows = static_cast<uint64_t>(acc_.rows());
+      const auto ny = static_cast<uint64_t>(y_->size());
+      const auto layers = static_cast<uint64_t>(acc_.cols()) / ny;
+      acc_.for_each(
+          [&](const uint64_t index, const DescriptiveStatistics& item) {
+            const auto ix = index % rows;
+            const auto iy = (index / rows) % ny;
+            const auto iz = (index / rows) / ny;
+            _z[(ix * ny + iy) * layers + iz] = (item.*func)(args...);
+          });
     }
     return z;
   }
 
-  /// Insertion of data on the nearest bin.
-  void push_nearest(const pybind11::array_t<T>& x,
-                    const pybind11::array_t<T>& y,
-                    const pybind11::array_t<T>& z) {
-    auto _x = x.template unchecked<1>();
-    auto _y = y.template unchecked<1>();
-    auto _z = z.template unchecked<1>();
+  /// Minimum number of samples binned by a thread.
+  static constexpr size_t kMinShardSize = 4096;
 
-    {
-      pybind11::gil_scoped_release release;
+  /// Combines the statistics of a bin with those of another one.
+  static inline void merge(DescriptiveStatistics& lhs,
+                           const DescriptiveStatistics& rhs) {
+    // Statistics are defined only in the other instance.
+    if (lhs.count() == 0 && rhs.count() != 0) {
+      lhs = rhs;
+      // If the statistics are defined in both instances they can be
+      // combined.
+    } else if (lhs.count() != 0 && rhs.count() != 0) {
+      lhs += rhs;
+    }
+  }
 
-      const auto& x_axis = static_cast<pyinterp::detail::Axis<double>&>(*x_);
-      const auto& y_axis = static_cast<pyinterp::detail::Axis<double>&>(*y_);
+  /// Bins the samples [0, size) with the given number of threads.
+  ///
+  /// The samples are split into one contiguous part (shard) per thread. The
+  /// worker, called as worker(bin, start, end), bins the samples [start, end)
+  /// into the statistics returned by bin(ix, iy). The statistics of the first
+  /// shard are those of the grid; the others are private to their thread and
+  /// merged at the end, in the order of the samples:
+  ///
+  /// * If the grid has fewer bins than samples per shard, each shard is a
+  ///   dense statistics grid, and the shards are merged by a tree reduction:
+  ///   at each level, the rows of the pairs of shards are merged in parallel.
+  /// * Otherwise, most of the bins of a shard would be empty: each shard is a
+  ///   hash table of the bins updated, sorted by bin before being merged in
+  ///   parallel, row by row, into the grid. A sparse grid cannot store new
+  ///   bins concurrently: the shards are then merged by a single thread.
+  template <typename Worker>
+  void push_shards(const size_t size, size_t num_threads,
+                   const Worker& worker) {
+    if (num_threads == 0) {
+      num_threads = detail::get_num_threads();
+    }
+    const auto shards = std::max<size_t>(
+        std::min(num_threads, size / kMinShardSize), 1);
+    auto grid = [this](const int64_t ix, const int64_t iy)
+        -> DescriptiveStatistics& { return acc_(ix, iy); };
+
+    if (shards == 1) {
+      worker(grid, 0, size);
+      return;
+    }
 
-      for (pybind11::ssize_t idx = 0; idx < x.size(); ++idx) {
-        auto value = _z(idx);
+    const auto rows = acc_.rows();
+    const auto cols = acc_.cols();
+    auto range = [&](const size_t shard) {
+      return std::make_pair(shard * size / shards,
+                            (shard + 1) * size / shards);
+    };
 
-        if (!std::isnan(value)) {
-          auto ix = x_axis.find_index(_x(idx), true);
-          auto iy = y_axis.find_index(_y(idx), true);
+    if (!acc_.sparse() && static_cast<size_t>(rows * cols) <= size / shards) {
+      auto partial = std::vector<Matrix<DescriptiveStatistics>>(shards - 1);
+      detail::dispatch(
+          [&](const size_t start, const size_t end) {
+            for (auto shard = start; shard < end; ++shard) {
+              auto [first, last] = range(shard);
+              if (shard == 0) {
+                worker(grid, first, last);
+                continue;
+              }
+              auto& item = partial[shard - 1];
+              item = Matrix<DescriptiveStatistics>(rows, cols);
+              worker(
+                  [&item](const int64_t ix, const int64_t iy)
+                      -> DescriptiveStatistics& { return item(ix, iy); },
+                  first, last);
+            }
+          },
+          shards, num_threads);
 
-          if (ix != -1 && iy != -1) {
-            acc_(ix, iy)(value);
+      auto cell = [&](const size_t shard, const Eigen::Index ix,
+                      const Eigen::Index iy) -> DescriptiveStatistics& {
+        return shard == 0 ? acc_(ix, iy) : partial[shard - 1](ix, iy);
+      };
+      for (size_t step = 1; step < shards; step *= 2) {
+        detail::dispatch(
+            [&](const size_t start, const size_t end) {
+              for (auto ix = static_cast<Eigen::Index>(start);
+                   ix < static_cast<Eigen::Index>(end); ++ix) {
+                for (size_t shard = 0; shard + step < shards;
+                     shard += 2 * step) {
+                  for (Eigen::Index iy = 0; iy < cols; ++iy) {
+                    merge(cell(shard, ix, iy), cell(shard + step, ix, iy));
+                  }
+                }
+              }
+            },
+            rows, num_threads);
+      }
+      return;
+    }
+
+    using Bin = std::pair<int64_t, DescriptiveStatistics>;
+    auto partial = std::vector<std::vector<Bin>>(shards - 1);
+    detail::dispatch(
+        [&](const size_t start, const size_t end) {
+          for (auto shard = start; shard < end; ++shard) {
+            auto [first, last] = range(shard);
+            if (shard == 0) {
+              worker(grid, first, last);
+              continue;
+            }
+            auto bins = std::unordered_map<int64_t, DescriptiveStatistics>();
+            worker(
+                [&bins, cols](const int64_t ix, const int64_t iy)
+                    -> DescriptiveStatistics& { return bins[ix * cols + iy]; },
+                first, last);
+            auto& item = partial[shard - 1];
+            item.assign(bins.begin(), bins.end());
+            std::sort(item.begin(), item.end(),
+                      [](const Bin& lhs, const Bin& rhs) {
+                        return lhs.first < rhs.first;
+                      });
           }
+        },
+        shards, num_threads);
+
+    if (acc_.sparse()) {
+      for (const auto& item : partial) {
+        for (const auto& [index, statistics] : item) {
+          merge(acc_(index / cols, index % cols), statistics);
         }
       }
+      return;
     }
+
+    detail::dispatch(
+        [&](const size_t start, const size_t end) {
+          auto compare = [](const Bin& bin, const int64_t index) {
+            return bin.first < index;
+          };
+          for (const auto& item : partial) {
+            auto it = std::lower_bound(item.begin(), item.end(),
+                                       static_cast<int64_t>(start) * cols,
+                                       compare);
+            const auto last = std::lower_bound(
+                it, item.end(), static_cast<int64_t>(end) * cols, compare);
+            for (; it != last; ++it) {
+              merge(acc_(it->first / cols, it->first % cols), it->second);
+            }
+          }
+        },
+        rows, num_threads);
+  }
+
+  /// Insertion of data on the nearest bin.
+  template <typename Accessor, typename Layer>
+  void push_nearest(const Accessor& _x, const Accessor& _y, const Accessor& _z,
+                    const pybind11::ssize_t size, const size_t num_threads,
+                    const Layer& layer) {
+    const auto& x_axis = static_cast<pyinterp::detail::Axis<double>&>(*x_);
+    const auto& y_axis = static_cast<pyinterp::detail::Axis<double>&>(*y_);
+    const auto ny = y_axis.size();
+
+    push_shards(size, num_threads,
+                [&](const auto& bin, const size_t start, const size_t end) {
+                  for (auto idx = static_cast<pybind11::ssize_t>(start);
+                       idx < static_cast<pybind11::ssize_t>(end); ++idx) {
+                    auto value = _z(idx);
+
+                    if (!std::isnan(value)) {
+                      auto ix = x_axis.find_index(_x(idx), true);
+                      auto iy = y_axis.find_index(_y(idx), true);
+                      auto iz = layer(idx);
+
+                      if (ix != -1 && iy != -1 && iz != -1) {
+                        bin(ix, iy + iz * ny)(value);
+                      }
+                    }
+                  }
+                });
+  }
+
+  /// Number of intervals of the tables of the window functions used by the
+  /// kernel binning.
+  static constexpr size_t kKernelTableSize = 1024;
+
+  /// Locates a coordinate on an axis.
+  ///
+  /// @return The index of the nearest bin and the position of the coordinate
+  /// expressed as a fractional index, or nothing if the coordinate is
+  /// outside the axis.
+  static auto fractional_index(const detail::Axis<double>& axis,
+                               const double coordinate)
+      -> std::optional<std::pair<int64_t, double>> {
+    const auto ix = axis.find_index(coordinate, true);
+    if (ix == -1) {
+      return {};
+    }
+    auto delta = axis.normalize_coordinate(coordinate) - axis(ix);
+    if (axis.is_angle()) {
+      delta = detail::math::normalize_angle(delta, -180.0, 360.0);
+    }
+    if (axis.size() == 1) {
+      return std::make_pair(ix, static_cast<double>(ix));
+    }
+    if (axis.is_regular()) {
+      return std::make_pair(ix, static_cast<double>(ix) +
+                                    delta / axis.increment());
+    }
+    // The spacing of an irregular axis is the one of the interval, on the
+    // side of the nearest bin where the coordinate is located.
+    auto jx = ix + 1;
+    if (jx == axis.size() || (ix > 0 && (axis(jx) - axis(ix)) * delta < 0)) {
+      jx = ix - 1;
+    }
+    return std::make_pair(
+        ix, static_cast<double>(ix) + delta * static_cast<double>(jx - ix) /
+                                          (axis(jx) - axis(ix)));
+  }
+
+  /// Insertion of data on the bins surrounding the nearest bin, weighted by
+  /// a window function.
+  template <typename Accessor, typename Layer>
+  void push_window(const Accessor& _x, const Accessor& _y, const Accessor& _z,
+                   const pybind11::ssize_t size,
+                   const detail::math::window::Function function,
+                   const uint32_t radius, const double arg,
+                   const size_t num_threads, const Layer& layer) {
+    const auto& x_axis = static_cast<pyinterp::detail::Axis<double>&>(*x_);
+    const auto& y_axis = static_cast<pyinterp::detail::Axis<double>&>(*y_);
+    const auto ny = y_axis.size();
+    const auto width = 2 * static_cast<size_t>(radius) + 1;
+
+    // The weights are separable: the window function, tabulated once, is
+    // evaluated for the 2r + 1 bins of each axis, then the weight of a bin
+    // is the product of the weights of its row and column.
+    const auto table = detail::math::WindowFunctionTable<double>(
+        detail::math::WindowFunction<double>(function), radius + 0.5, arg,
+        kKernelTableSize);
+    auto spread = [&](const detail::Axis<double>& axis,
+                      const std::pair<int64_t, double>& position,
+                      std::vector<int64_t>& indexes, std::vector<T>& weights) {
+      for (size_t kx = 0; kx < width; ++kx) {
+        auto jx = position.first - radius + static_cast<int64_t>(kx);
+        weights[kx] =
+            static_cast<T>(table(std::abs(position.second - jx)));
+        if (axis.is_circle()) {
+          jx = (jx % axis.size() + axis.size()) % axis.size();
+        } else if (jx < 0 || jx >= axis.size()) {
+          jx = -1;
+        }
+        indexes[kx] = jx;
+      }
+    };
+
+    push_shards(
+        size, num_threads,
+        [&](const auto& bin, const size_t start, const size_t end) {
+          auto x_indexes = std::vector<int64_t>(width);
+          auto y_indexes = std::vector<int64_t>(width);
+          auto x_weights = std::vector<T>(width);
+          auto y_weights = std::vector<T>(width);
+          for (auto idx = static_cast<pybind11::ssize_t>(start);
+               idx < static_cast<pybind11::ssize_t>(end); ++idx) {
+            auto value = _z(idx);
+            if (std::isnan(value)) {
+              continue;
+            }
+            auto iz = layer(idx);
+            if (iz == -1) {
+              continue;
+            }
+            auto x_position = fractional_index(x_axis, _x(idx));
+            auto y_position = fractional_index(y_axis, _y(idx));
+            if (!x_position.has_value() || !y_position.has_value()) {
+              continue;
+            }
+            spread(x_axis, *x_position, x_indexes, x_weights);
+            spread(y_axis, *y_position, y_indexes, y_weights);
+
+            auto offset = iz * ny;
+            for (size_t kx = 0; kx < width; ++kx) {
+              if (x_indexes[kx] == -1) {
+                continue;
+              }
+              for (size_t ky = 0; ky < width; ++ky) {
+                if (y_indexes[ky] != -1) {
+                  update_acc(bin(x_indexes[kx], y_indexes[ky] + offset), value,
+                             x_weights[kx] * y_weights[ky]);
+                }
+              }
+            }
+          }
+        });
   }
 
   /// Update statistics for the linear binning (ignore zero weights).
-  void update_acc(const int64_t ix, const int64_t iy, const T& value,
-                  const T& weight) {
+  static void update_acc(DescriptiveStatistics& acc, const T& value,
+                         const T& weight) {
     if (!detail::math::is_almost_zero(weight,
                                       std::numeric_limits<T>::epsilon())) {
-      acc_(ix, iy)(value, weight);
+      acc(value, weight);
     }
   }
 
-  /// Set bins with nearest binning.
-  template <template <class> class Point, typename Strategy>
-  void push_linear(const pybind11::array_t<T>& x, const pybind11::array_t<T>& y,
-                   const pybind11::array_t<T>& z, const Strategy& strategy) {
-    auto _x = x.template unchecked<1>();
-    auto _y = y.template unchecked<1>();
-    auto _z = z.template unchecked<1>();
+  /// Set bins with linear binning.
+  ///
+  /// @param weights Function computing the weights of the four corners of
+  /// the cell containing the sample (x, y), whose corners are (x0, iy0) and
+  /// (x1, iy1), in the order returned by detail::math::binning_2d.
+  template <typename Accessor, typename Weights, typename Layer>
+  void push_linear(const Accessor& _x, const Accessor& _y, const Accessor& _z,
+                   const pybind11::ssize_t size, const Weights& weights,
+                   const size_t num_threads, const Layer& layer) {
+    const auto& x_axis = static_cast<pyinterp::detail::Axis<double>&>(*x_);
+    const auto& y_axis = static_cast<pyinterp::detail::Axis<double>&>(*y_);
+    const auto ny = y_axis.size();
 
-    {
-      pybind11::gil_scoped_release release;
+    push_shards(
+        size, num_threads,
+        [&](const auto& bin, const size_t start, const size_t end) {
+          for (auto idx = static_cast<pybind11::ssize_t>(start);
+               idx < static_cast<pybind11::ssize_t>(end); ++idx) {
+            auto value = _z(idx);
+            if (std::isnan(value)) {
+              continue;
+            }
+            auto iz = layer(idx);
+            if (iz == -1) {
+              continue;
+            }
 
-      const auto& x_axis = static_cast<pyinterp::detail::Axis<double>&>(*x_);
-      const auto& y_axis = static_cast<pyinterp::detail::Axis<double>&>(*y_);
+            auto x_indexes = x_axis.find_indexes(_x(idx));
+            auto y_indexes = y_axis.find_indexes(_y(idx));
 
-      for (pybind11::ssize_t idx = 0; idx < x.size(); ++idx) {
-        auto value = _z(idx);
-        if (std::isnan(value)) {
-          continue;
-        }
+            if (x_indexes.has_value() && y_indexes.has_value()) {
+              auto [ix0, ix1] = *x_indexes;
+              auto [iy0, iy1] = *y_indexes;
+              auto offset = iz * ny;
 
-        auto x_indexes = x_axis.find_indexes(_x(idx));
-        auto y_indexes = y_axis.find_indexes(_y(idx));
+              auto x0 = x_axis(ix0);
+              auto x1 = x_axis(ix1);
+              auto xi = _x(idx);
+              // On a circle, the sample and the second corner of the cell
+              // are moved to within half a turn of the first corner.
+              if (x_axis.is_angle()) {
+                xi = detail::math::normalize_angle<double>(xi, x0, 360.0);
+                x1 = detail::math::normalize_angle<double>(x1, x0, 360.0);
+              }
 
-        if (x_indexes.has_value() && y_indexes.has_value()) {
-          auto [ix0, ix1] = *x_indexes;
-          auto [iy0, iy1] = *y_indexes;
+              auto w = weights(xi, _y(idx), x0, x1, iy0, iy1);
 
-          auto x0 = x_axis(ix0);
+              update_acc(bin(ix0, iy0 + offset), value,
+                         static_cast<T>(std::get<0>(w)));
+              update_acc(bin(ix0, iy1 + offset), value,
+                         static_cast<T>(std::get<1>(w)));
+              update_acc(bin(ix1, iy1 + offset), value,
+                         static_cast<T>(std::get<2>(w)));
+              update_acc(bin(ix1, iy0 + offset), value,
+                         static_cast<T>(std::get<3>(w)));
+            }
+          }
+        });
+  }
+};
 
-          auto weights = detail::math::binning_2d<Point, Strategy, double>(
-              Point<double>(x_axis.is_angle()
-                                ? detail::math::normalize_angle<double>(
-                                      _x(idx), x0, 360.0)
-                                : _x(idx),
-                            _y(idx)),
-              Point<double>(x0, y_axis(iy0)),
-              Point<double>(x_axis(ix1), y_axis(iy1)), strategy);
+/// Group a number of more or less continuous values into a smaller number of
+/// "bins" located on a 3D grid, whose third axis is, for example, a time
+/// axis: the samples are routed to their bins in a single pass, instead of
+/// binning the samples of each layer of the grid separately.
+///
+/// The samples are spread over the X and Y axes, with the nearest or the
+/// linear binning, and are binned in the nearest layer along the third axis.
+///
+/// @tparam T Type of the values binned.
+/// @tparam AxisType Type of the coordinates of the third axis.
+template <typename T, typename AxisType>
+class Binning3D : public Binning2D<T> {
+ public:
+  /// Default constructor
+  ///
+  /// @param x Definition of the bin centers for the X axis of the grid.
+  /// @param y Definition of the bin centers for the Y axis of the grid.
+  /// @param z Definition of the bin centers for the Z axis of the grid.
+  /// @param wgs WGS of the coordinate system used to manipulate geographic
+  /// coordinates. If this parameter is not set, the handled coordinates will be
+  /// considered as Cartesian coordinates. Otherwise, "x" and "y" are considered
+  /// to represents the longitudes and latitudes on a grid.
+  /// @param sparse If true, only the bins holding values are stored.
+  Binning3D(std::shared_ptr<Axis<double>> x, std::shared_ptr<Axis<double>> y,
+            std::shared_ptr<Axis<AxisType>> z,
+            std::optional<geodetic::System> wgs, const bool sparse = false)
+      : Binning2D<T>(std::move(x), std::move(y), std::move(wgs), sparse,
+                     z->size()),
+        z_(std::move(z)) {}
 
-          update_acc(ix0, iy0, value, static_cast<T>(std::get<0>(weights)));
-          update_acc(ix0, iy1, value, static_cast<T>(std::get<1>(weights)));
-          update_acc(ix1, iy1, value, static_cast<T>(std::get<2>(weights)));
-          update_acc(ix1, iy0, value, static_cast<T>(std::get<3>(weights)));
-        }
+  /// Inserts new values in the grid from the values of the samples located
+  /// at the X, Y, Z coordinates.
+  ///
+  /// @param x X coordinates of the samples.
+  /// @param y Y coordinates of the samples.
+  /// @param z Z coordinates of the samples. The dates located on a time axis
+  /// are converted to the resolution of the axis when they are read.
+  /// @param values Values of the samples.
+  /// @param simple If true, the nearest binning is used, otherwise the linear
+  /// binning.
+  /// @param num_threads The number of threads to use for the computation. If 0
+  /// all CPUs are used. If 1 is given, no parallel computing code is used at
+  /// all, which is useful for debugging.
+  void push(const pybind11::array_t<T>& x, const pybind11::array_t<T>& y,
+            const AxisCoordinates<AxisType>& z,
+            const pybind11::array_t<T>& values, const bool simple,
+            const size_t num_threads) {
+    detail::check_array_ndim("x", 1, x, "y", 1, y, "z", 1, z, "values", 1,
+                             values);
+    detail::check_ndarray_shape("x", x, "y", y, "z", z, "values", values);
+    auto _z = coordinates_reader(*z_, "z", z);
+    const auto& z_axis = static_cast<const detail::Axis<AxisType>&>(*z_);
+    this->push_samples(x, y, values, simple, num_threads,
+                       [&](const pybind11::ssize_t idx) -> int64_t {
+                         return z_axis.find_index(_z(idx), true);
+                       });
+  }
+
+  /// Gets the Z-Axis
+  [[nodiscard]] inline auto z() const -> std::shared_ptr<Axis<AxisType>> {
+    return z_;
+  }
+
+  /// Pickle support: get state of this instance
+  [[nodiscard]] auto getstate() const -> pybind11::tuple {
+    const auto& wgs = this->wgs();
+    return pybind11::make_tuple(
+        this->x()->getstate(), this->y()->getstate(), z_getstate(),
+        wgs.has_value() ? wgs->getstate() : pybind11::make_tuple(),
+        this->marshal(), this->sparse());
+  }
+
+  /// Pickle support: set state of this instance
+  static auto setstate(const pybind11::tuple& state)
+      -> std::unique_ptr<Binning3D<T, AxisType>> {
+    if (state.size() != 6) {
+      throw std::invalid_argument("invalid state");
+    }
+    auto result = std::make_unique<Binning3D<T, AxisType>>(
+        std::make_shared<Axis<double>>(
+            Axis<double>::setstate(state[0].cast<pybind11::tuple>())),
+        std::make_shared<Axis<double>>(
+            Axis<double>::setstate(state[1].cast<pybind11::tuple>())),
+        z_setstate(state[2].cast<pybind11::tuple>()),
+        Binning2D<T>::wgs_setstate(state[3]), state[5].cast<bool>());
+    result->unmarshal(state[4]);
+    return result;
+  }
+
+  /// Merges the statistics of the state of another instance, returned by
+  /// getstate(), without creating this instance: the statistics are read
+  /// directly from the serialized buffer.
+  auto merge(const pybind11::tuple& state) -> void {
+    if (state.size() != 6) {
+      throw std::invalid_argument("invalid state");
+    }
+    this->check_state(state[0], state[1], state[3]);
+    if (*z_ != *z_setstate(state[2].cast<pybind11::tuple>())) {
+      throw std::invalid_argument("Unable to combine different grids");
+    }
+    this->unmarshal(state[4]);
+  }
+
+  /// Aggregation of statistics
+  auto operator+=(const Binning3D& other) -> Binning3D& {
+    if (*z_ != *(other.z_)) {
+      throw std::invalid_argument("Unable to combine different grids");
+    }
+    Binning2D<T>::operator+=(other);
+    return *this;
+  }
+
+ protected:
+  /// @copydoc Binning2D::shape() const
+  [[nodiscard]] auto shape() const -> std::vector<pybind11::ssize_t> override {
+    return {this->x()->size(), this->y()->size(), z_->size()};
+  }
+
+ private:
+  /// Z-Axis
+  std::shared_ptr<Axis<AxisType>> z_;
+
+  /// Pickle support of the Z-Axis: the type of the dates handled by a time
+  /// axis is kept.
+  [[nodiscard]] auto z_getstate() const -> pybind11::tuple {
+    if constexpr (std::is_same_v<AxisType, int64_t>) {
+      const auto* temporal = dynamic_cast<const TemporalAxis*>(z_.get());
+      if (temporal != nullptr) {
+        return temporal->getstate();
       }
     }
+    return z_->getstate();
   }
 
-  /// Returns the matrix of raw statistics.
-  inline auto acc() const -> Matrix<Accumulators> {
-    auto gil = pybind11::gil_scoped_release();
-    return acc_.template cast<Accumulators>();
+  /// Unmarshalling of the Z-Axis: the state of a time axis holds the state
+  /// of its values, while the state of the other axes starts with the
+  /// identification of their type.
+  static auto z_setstate(const pybind11::tuple& state)
+      -> std::shared_ptr<Axis<AxisType>> {
+    if constexpr (std::is_same_v<AxisType, int64_t>) {
+      if (!state.empty() && pybind11::isinstance<pybind11::tuple>(state[0])) {
+        return std::make_shared<TemporalAxis>(TemporalAxis::setstate(state));
+      }
+    }
+    return std::make_shared<Axis<AxisType>>(Axis<AxisType>::setstate(state));
   }
 };
 
@@ -6,11 +6,19 @@
 #include <pybind11/numpy.h>
 #include <pybind11/stl.h>
 
+#include <algorithm>
+#include <array>
 #include <cctype>
+#include <functional>
+#include <string>
+#include <type_traits>
+#include <utility>
 
 #include "pyinterp/detail/geometry/point.hpp"
 #include "pyinterp/detail/math/bivariate.hpp"
+#include "pyinterp/detail/numpy.hpp"
 #include "pyinterp/detail/thread.hpp"
+#include "pyinterp/fill.hpp"
 #include "pyinterp/grid.hpp"
 
 namespace pyinterp {
@@ -68,12 +76,18 @@ class InverseDistanceWeighting
 };
 
 /// Bivariate interpolation for a given point.
-template <template <class> class Point, typename Coordinate, typename Type>
-inline auto _bivariate(
-    const Grid2D<Type>& grid, const Coordinate& x, const Coordinate& y,
-    const Axis<double>& x_axis, const Axis<double>& y_axis,
-    const BivariateInterpolator<Point, Coordinate>* interpolator,
-    const bool bounds_error) -> Coordinate {
+///
+/// @tparam Grid Type of the grid, a Grid2D, a PackedGrid2D or a
+/// TiledGrid2D.
+/// @tparam Interpolator Type of the interpolator, either the abstract class or
+/// one of the built-in implementations, whose calls are inlined.
+template <template <class> class Point, typename Coordinate, typename Type,
+          typename Grid, typename Interpolator>
+inline auto _bivariate(const Grid& grid, const Coordinate& x,
+                       const Coordinate& y, const Axis<double>& x_axis,
+                       const Axis<double>& y_axis,
+                       const Interpolator* interpolator,
+                       const bool bounds_error) -> Coordinate {
   auto x_indexes = x_axis.find_indexes(x);
   auto y_indexes = y_axis.find_indexes(y);
 
@@ -102,57 +116,334 @@ inline auto _bivariate(
   return std::numeric_limits<Coordinate>::quiet_NaN();
 }
 
-/// Interpolation of bivariate function.
+/// Number of points processed at once by the interpolation on regular grids.
+constexpr size_t kBivariateBatchSize = 64;
+
+/// Calculates the grid cells of a batch of points, on axes that are regular
+/// and sorted in ascending order, by an affine transformation of the
+/// coordinates. The cell of a point that is not framed by two elements of an
+/// axis is set to -1.
+///
+/// @param index Function returning the index of the jth point of the batch.
+/// @param size Number of points of the batch, at most kBivariateBatchSize.
+template <typename Input, typename Index>
+inline auto _regular_cells(
+    const Axis<double>& x_axis, const Axis<double>& y_axis, const Input& x,
+    const Input& y, const Index& index, const size_t size,
+    std::array<int64_t, kBivariateBatchSize>& x_cells,
+    std::array<int64_t, kBivariateBatchSize>& y_cells) -> void {
+  const auto x_min = x_axis.min_value();
+  const auto y_min = y_axis.min_value();
+  auto xn = std::array<double, kBivariateBatchSize>();
+  auto yn = std::array<double, kBivariateBatchSize>();
+
+  for (size_t jx = 0; jx < size; ++jx) {
+    const auto ix = index(jx);
+    xn[jx] = x_axis.normalize_coordinate(x(ix), x_min);
+    yn[jx] = y_axis.normalize_coordinate(y(ix), y_min);
+  }
+  x_axis.regular_container()->find_cells(xn.data(), x_cells.data(), size);
+  y_axis.regular_container()->find_cells(yn.data(), y_cells.data(), size);
+}
+
+/// Bivariate interpolation of the points [start, end) on a grid whose axes
+/// are regular and sorted in ascending order.
+///
+/// The grid cells containing the points are calculated in batches by an
+/// affine transformation of the coordinates. The points that are not framed by
+/// two elements of each axis (outside the grid, or between the last and the
+/// first element of a circle) are handled by the generic function.
+///
+/// @tparam Grid Type of the grid, a Grid2D, a PackedGrid2D or a
+/// TiledGrid2D.
+/// @tparam Interpolator Type of the interpolator
+template <template <class> class Point, typename Coordinate, typename Type,
+          typename Grid, typename Interpolator, typename Input,
+          typename Output>
+auto _bivariate_regular(const Grid& grid, const Input& x,
+                        const Input& y, Output& result, const size_t start,
+                        const size_t end, const Axis<double>& x_axis,
+                        const Axis<double>& y_axis,
+                        const Interpolator& interpolator,
+                        const bool bounds_error) -> void {
+  const auto& x_regular = *x_axis.regular_container();
+  const auto& y_regular = *y_axis.regular_container();
+
+  auto x_cells = std::array<int64_t, kBivariateBatchSize>();
+  auto y_cells = std::array<int64_t, kBivariateBatchSize>();
+
+  for (auto first = start; first < end; first += kBivariateBatchSize) {
+    const auto size = std::min(end - first, kBivariateBatchSize);
+
+    _regular_cells(
+        x_axis, y_axis, x, y, [first](size_t jx) { return first + jx; }, size,
+        x_cells, y_cells);
+
+    for (size_t jx = 0; jx < size; ++jx) {
+      const auto ix = first + jx;
+      const auto ix0 = x_cells[jx];
+      const auto iy0 = y_cells[jx];
+
+      if (ix0 == -1 || iy0 == -1) {
+        result(ix) = _bivariate<Point, Coordinate, Type>(
+            grid, x(ix), y(ix), x_axis, y_axis, &interpolator, bounds_error);
+        continue;
+      }
+
+      const auto x0 = x_regular.coordinate_value(ix0);
+      auto p = Point<Coordinate>(x_axis.normalize_coordinate(x(ix), x0), y(ix));
+      auto p0 = Point<Coordinate>(x0, y_regular.coordinate_value(iy0));
+      auto p1 = Point<Coordinate>(x_regular.coordinate_value(ix0 + 1),
+                                  y_regular.coordinate_value(iy0 + 1));
+
+      result(ix) = interpolator.evaluate(
+          p, p0, p1, static_cast<Coordinate>(grid.value(ix0, iy0)),
+          static_cast<Coordinate>(grid.value(ix0, iy0 + 1)),
+          static_cast<Coordinate>(grid.value(ix0 + 1, iy0)),
+          static_cast<Coordinate>(grid.value(ix0 + 1, iy0 + 1)));
+    }
+  }
+}
+
+/// Interpolation of bivariate function. The coordinates are read in place,
+/// whatever their type and their strides (see detail::numpy::ArrayReader).
 ///
 /// @tparam Coordinate The type of data used by the interpolators.
 /// @tparam Type The type of data used by the numerical grid.
-template <template <class> class Point, typename Coordinate, typename Type>
-auto bivariate(const Grid2D<Type>& grid, const pybind11::array_t<Coordinate>& x,
-               const pybind11::array_t<Coordinate>& y,
+/// @tparam Grid Type of the grid, a Grid2D, a PackedGrid2D, a TiledGrid2D,
+/// or a view filling their undefined values.
+template <template <class> class Point, typename Coordinate, typename Type,
+          typename Grid>
+auto _bivariate_grid(
+    const Grid& grid, const pybind11::array& x, const pybind11::array& y,
+    const BivariateInterpolator<Point, Coordinate>* interpolator,
+    const bool bounds_error, const size_t num_threads,
+    const std::optional<pybind11::array>& out)
+    -> pybind11::array_t<Coordinate> {
+  auto size = x.size();
+  auto result = detail::numpy::output_array<Coordinate>("out", out, {size});
+  auto _x = detail::numpy::ArrayReader<Coordinate>(x);
+  auto _y = detail::numpy::ArrayReader<Coordinate>(y);
+  auto _result = result.template mutable_unchecked<1>();
+
+  {
+    pybind11::gil_scoped_release release;
+
+    // The dimensions and the shapes are read from the array structures.
+    pyinterp::detail::check_array_ndim("x", 1, x, "y", 1, y);
+    pyinterp::detail::check_ndarray_shape("x", x, "y", y);
+
+    const auto& x_axis = *grid.x();
+    const auto& y_axis = *grid.y();
+
+    // The grid cells of the regular grids are calculated with a specialized
+    // kernel.
+    const auto regular = x_axis.regular_container() != nullptr &&
+                         y_axis.regular_container() != nullptr &&
+                         x_axis.is_ascending() && y_axis.is_ascending();
+
+    detail::math::visit(interpolator, [&](const auto* concrete) {
+      detail::dispatch(
+          [&](size_t start, size_t end) {
+            if (regular) {
+              _bivariate_regular<Point, Coordinate, Type>(
+                  grid, _x, _y, _result, start, end, x_axis, y_axis, *concrete,
+                  bounds_error);
+              return;
+            }
+            for (size_t ix = start; ix < end; ++ix) {
+              _result(ix) = _bivariate<Point, Coordinate, Type>(
+                  grid, _x(ix), _y(ix), x_axis, y_axis, concrete,
+                  bounds_error);
+            }
+          },
+          size, num_threads);
+    });
+  }
+  return result;
+}
+
+/// Interpolation of bivariate function.
+///
+/// @param fill_holes If set, half-windows (nx, ny) of the LOESS filter
+/// estimating the undefined values of the grid read by the interpolation.
+/// @tparam Grid Type of the grid, a Grid2D, a PackedGrid2D or a
+/// TiledGrid2D.
+template <template <class> class Point, typename Coordinate, typename Type,
+          typename Grid = Grid2D<Type>>
+auto bivariate(const Grid& grid, const pybind11::array& x,
+               const pybind11::array& y,
                const BivariateInterpolator<Point, Coordinate>* interpolator,
-               const bool bounds_error, const size_t num_threads)
+               const bool bounds_error, const size_t num_threads,
+               const std::optional<pybind11::array>& out,
+               const std::optional<std::pair<uint32_t, uint32_t>>& fill_holes)
     -> pybind11::array_t<Coordinate> {
-  pyinterp::detail::check_array_ndim("x", 1, x, "y", 1, y);
-  pyinterp::detail::check_ndarray_shape("x", x, "y", y);
+  const auto& handle = make_handle(grid);
+  if (fill_holes) {
+    auto filled = fill::LoessFilledGrid(handle, fill_holes->first,
+                                        fill_holes->second);
+    return _bivariate_grid<Point, Coordinate, Type>(
+        filled, x, y, interpolator, bounds_error, num_threads, out);
+  }
+  return _bivariate_grid<Point, Coordinate, Type>(
+      handle, x, y, interpolator, bounds_error, num_threads, out);
+}
 
+/// Bilinear interpolation of bivariate function, computing in the same pass
+/// the partial derivatives of the interpolated function.
+///
+/// @tparam Grid Type of the grid, a Grid2D, a PackedGrid2D, a TiledGrid2D,
+/// or a view filling their undefined values.
+/// @return A tuple (values, dx, dy).
+template <template <class> class Point, typename Type, typename Grid>
+auto _bilinear_gradient(const Grid& grid, const pybind11::array& x,
+                        const pybind11::array& y, const bool bounds_error,
+                        const size_t num_threads,
+                        const std::optional<pybind11::array>& out,
+                        const std::optional<pybind11::array>& out_dx,
+                        const std::optional<pybind11::array>& out_dy)
+    -> pybind11::tuple {
   auto size = x.size();
-  auto result =
-      pybind11::array_t<Coordinate>(pybind11::array::ShapeContainer{size});
-  auto _x = x.template unchecked<1>();
-  auto _y = y.template unchecked<1>();
+  auto result = detail::numpy::output_array<double>("out", out, {size});
+  auto dx = detail::numpy::output_array<double>("out_dx", out_dx, {size});
+  auto dy = detail::numpy::output_array<double>("out_dy", out_dy, {size});
+  auto _x = detail::numpy::ArrayReader<double>(x);
+  auto _y = detail::numpy::ArrayReader<double>(y);
   auto _result = result.template mutable_unchecked<1>();
+  auto _dx = dx.template mutable_unchecked<1>();
+  auto _dy = dy.template mutable_unchecked<1>();
 
   {
     pybind11::gil_scoped_release release;
 
-    // Captures the detected exceptions in the calculation function
-    // (only the last exception captured is kept)
-    auto except = std::exception_ptr(nullptr);
+    // The dimensions and the shapes are read from the array structures.
+    pyinterp::detail::check_array_ndim("x", 1, x, "y", 1, y);
+    pyinterp::detail::check_ndarray_shape("x", x, "y", y);
 
-    // Access to the shared pointer outside the loop to avoid data races
     const auto& x_axis = *grid.x();
     const auto& y_axis = *grid.y();
+    const auto interpolator = detail::math::Bilinear<Point, double>();
 
     detail::dispatch(
         [&](size_t start, size_t end) {
-          try {
-            for (size_t ix = start; ix < end; ++ix) {
-              _result(ix) = _bivariate(grid, _x(ix), _y(ix), x_axis, y_axis,
-                                       interpolator, bounds_error);
+          for (size_t ix = start; ix < end; ++ix) {
+            auto xi = _x(ix);
+            auto yi = _y(ix);
+            auto x_indexes = x_axis.find_indexes(xi);
+            auto y_indexes = y_axis.find_indexes(yi);
+
+            if (!x_indexes.has_value() || !y_indexes.has_value()) {
+              if (bounds_error) {
+                if (!x_indexes.has_value()) {
+                  Grid2D<Type>::index_error(x_axis, xi, "x");
+                }
+                Grid2D<Type>::index_error(y_axis, yi, "y");
+              }
+              _result(ix) = _dx(ix) = _dy(ix) =
+                  std::numeric_limits<double>::quiet_NaN();
+              continue;
             }
-          } catch (...) {
-            except = std::current_exception();
+            auto [ix0, ix1] = *x_indexes;
+            auto [iy0, iy1] = *y_indexes;
+
+            auto x0 = x_axis(ix0);
+            _result(ix) = interpolator.gradient(
+                Point<double>(x_axis.normalize_coordinate(xi, x0), yi),
+                Point<double>(x0, y_axis(iy0)),
+                Point<double>(x_axis(ix1), y_axis(iy1)),
+                static_cast<double>(grid.value(ix0, iy0)),
+                static_cast<double>(grid.value(ix0, iy1)),
+                static_cast<double>(grid.value(ix1, iy0)),
+                static_cast<double>(grid.value(ix1, iy1)), _dx(ix), _dy(ix));
           }
         },
         size, num_threads);
+  }
+  return pybind11::make_tuple(result, dx, dy);
+}
 
-    if (except != nullptr) {
-      std::rethrow_exception(except);
-    }
+/// Bilinear interpolation of bivariate function, computing in the same pass
+/// the partial derivatives of the interpolated function.
+///
+/// @param fill_holes If set, half-windows (nx, ny) of the LOESS filter
+/// estimating the undefined values of the grid read by the interpolation.
+/// @tparam Grid Type of the grid, a Grid2D, a PackedGrid2D or a
+/// TiledGrid2D.
+template <template <class> class Point, typename Type,
+          typename Grid = Grid2D<Type>>
+auto bilinear_gradient(
+    const Grid& grid, const pybind11::array& x, const pybind11::array& y,
+    const bool bounds_error, const size_t num_threads,
+    const std::optional<pybind11::array>& out,
+    const std::optional<pybind11::array>& out_dx,
+    const std::optional<pybind11::array>& out_dy,
+    const std::optional<std::pair<uint32_t, uint32_t>>& fill_holes)
+    -> pybind11::tuple {
+  const auto& handle = make_handle(grid);
+  if (fill_holes) {
+    auto filled = fill::LoessFilledGrid(handle, fill_holes->first,
+                                        fill_holes->second);
+    return _bilinear_gradient<Point, Type>(filled, x, y, bounds_error,
+                                           num_threads, out, out_dx, out_dy);
   }
-  return result;
+  return _bilinear_gradient<Point, Type>(handle, x, y, bounds_error,
+                                         num_threads, out, out_dx, out_dy);
 }
 
+/// Bivariate interpolation of a grid prepared once.
+///
+/// The grid, the interpolator and the options of the interpolation are bound
+/// when the instance is created: the interpolation of a set of points then
+/// costs a single call to the library, without resolving the function
+/// handling the grid or creating the interpolator again.
+class PreparedBivariate {
+ public:
+  /// Function interpolating the points (x, y) in the array "out", if
+  /// provided.
+  using Function = std::function<pybind11::array(
+      const pybind11::array&, const pybind11::array&,
+      const std::optional<pybind11::array>&)>;
+
+  /// Default constructor
+  ///
+  /// @param function Function interpolating the points.
+  explicit PreparedBivariate(Function function)
+      : function_(std::move(function)) {}
+
+  /// Prepares the interpolation of a grid. The grid and the interpolator
+  /// must outlive the instance created.
+  ///
+  /// @tparam Grid Type of the grid, a Grid2D, a PackedGrid2D or a
+  /// TiledGrid2D.
+  template <template <class> class Point, typename Coordinate, typename Type,
+            typename Grid = Grid2D<Type>>
+  static auto make(
+      const Grid& grid,
+      const BivariateInterpolator<Point, Coordinate>* interpolator,
+      const bool bounds_error, const size_t num_threads,
+      const std::optional<std::pair<uint32_t, uint32_t>>& fill_holes)
+      -> PreparedBivariate {
+    return PreparedBivariate(
+        [&grid, interpolator, bounds_error, num_threads, fill_holes](
+            const pybind11::array& x, const pybind11::array& y,
+            const std::optional<pybind11::array>& out) -> pybind11::array {
+          return bivariate<Point, Coordinate, Type, Grid>(
+              grid, x, y, interpolator, bounds_error, num_threads, out,
+              fill_holes);
+        });
+  }
+
+  /// Interpolates the points (x, y).
+  auto operator()(const pybind11::array& x, const pybind11::array& y,
+                  const std::optional<pybind11::array>& out) const
+      -> pybind11::array {
+    return function_(x, y, out);
+  }
+
+ private:
+  Function function_;
+};
+
 template <template <class> class Point, typename T>
 void implement_bivariate_interpolator(pybind11::module& m,
                                       const std::string& prefix,
@@ -212,14 +503,21 @@ void implement_bivariate_interpolator(pybind11::module& m,
           }));
 }
 
-template <template <class> class Point, typename Coordinate, typename Type>
+template <template <class> class Point, typename Coordinate, typename Type,
+          typename Grid = Grid2D<Type>>
 void implement_bivariate(pybind11::module& m, const std::string& suffix) {
   auto function_suffix = suffix;
   function_suffix[0] = static_cast<char>(std::tolower(function_suffix[0]));
+  // The interpolators of float32 values select the single precision
+  // computation.
+  const auto single_precision = std::is_same_v<Coordinate, float>;
+  const auto dtype = std::string(single_precision ? "float32" : "float64");
   m.def(("bivariate_" + function_suffix).c_str(),
-        &bivariate<Point, Coordinate, Type>, pybind11::arg("grid"),
+        &bivariate<Point, Coordinate, Type, Grid>, pybind11::arg("grid"),
         pybind11::arg("x"), pybind11::arg("y"), pybind11::arg("interpolator"),
         pybind11::arg("bounds_error") = false, pybind11::arg("num_threads") = 0,
+        pybind11::arg("out") = pybind11::none(),
+        pybind11::arg("fill_holes") = pybind11::none(),
         (R"__doc__(
 Interpolate the values provided on the defined bivariate function.
 
@@ -229,7 +527,9 @@ Args:
          R"__doc__(): Grid containing the values to be interpolated.
     x (numpy.ndarray): X-values.
     y (numpy.ndarray): Y-values.
-    interpolator (pyinterp.core.BivariateInterpolator2D): 2D interpolator
+    interpolator (pyinterp.core.BivariateInterpolator2D)__doc__" +
+         std::string(single_precision ? "Float32" : "") +
+         R"__doc__(): 2D interpolator
       used to interpolate.
     bounds_error (bool, optional): If True, when interpolated values are
       requested outside of the domain of the input axes (x,y), a ValueError
@@ -238,10 +538,77 @@ Args:
         computation. If 0 all CPUs are used. If 1 is given, no parallel
         computing code is used at all, which is useful for debugging.
         Defaults to ``0``.
+    out (numpy.ndarray, optional): C-contiguous array of shape ``(n, )`` and
+        of type )__doc__" +
+         dtype + R"__doc__( in which the interpolated values are written. If
+        None, a new array is allocated. Defaults to ``None``.
+    fill_holes (tuple, optional): Half-windows ``(nx, ny)`` of the LOESS
+        filter estimating the undefined values read by the interpolation,
+        as :py:func:`pyinterp.fill.loess` would fill them. Only the
+        values read are estimated. If None, the undefined values are used
+        as is. Defaults to ``None``.
 Returns:
-    numpy.ndarray: Values interpolated.
-)__doc__")
+    numpy.ndarray: Values interpolated, i.e. ``out`` if provided.
+)__doc__" +
+         std::string(single_precision ? R"__doc__(
+.. note::
+
+    The coordinates, the weights and the sums are calculated in single
+    precision. The cells framing the points are the cells found by the double
+    precision computation, but the positions of the points in their cells are
+    rounded to about ``eps * |x| / dx``, where ``eps`` is the machine epsilon
+    of float32 (``1.19e-7``) and ``dx`` the step of the axis. The bilinear
+    interpolation of values ``q`` therefore differs from the double precision
+    result by less than ``eps * (|x| / dx + |y| / dy) * max(|dq|) + 4 * eps *
+    max(|q|)``, ``dq`` being the differences between the values of the cell.
+)__doc__"
+                                      : ""))
             .c_str());
+  if constexpr (!std::is_same_v<Coordinate, float>) {
+    m.def(("bilinear_gradient_" + function_suffix).c_str(),
+          &bilinear_gradient<Point, Type, Grid>, pybind11::arg("grid"),
+          pybind11::arg("x"), pybind11::arg("y"),
+          pybind11::arg("bounds_error") = false,
+          pybind11::arg("num_threads") = 0,
+          pybind11::arg("out") = pybind11::none(),
+          pybind11::arg("out_dx") = pybind11::none(),
+          pybind11::arg("out_dy") = pybind11::none(),
+          pybind11::arg("fill_holes") = pybind11::none(),
+          (R"__doc__(
+Bilinear interpolation of the values provided, computing in the same pass the
+partial derivatives of the interpolated function.
+
+Args:
+    grid (pyinterp.core.Grid2D)__doc__" +
+           suffix +
+           R"__doc__(): Grid containing the values to be interpolated.
+    x (numpy.ndarray): X-values.
+    y (numpy.ndarray): Y-values.
+    bounds_error (bool, optional): If True, when interpolated values are
+      requested outside of the domain of the input axes (x,y), a ValueError
+      is raised. If False, then value is set to NaN.
+    num_threads (int, optional): The number of threads to use for the
+        computation. If 0 all CPUs are used. If 1 is given, no parallel
+        computing code is used at all, which is useful for debugging.
+        Defaults to ``0``.
+    out (numpy.ndarray, optional): C-contiguous array of shape ``(n, )`` and
+        of type float64 in which the interpolated values are written.
+        Defaults to ``None``.
+    out_dx (numpy.ndarray, optional): Array receiving the partial
+        derivatives with respect to x. Defaults to ``None``.
+    out_dy (numpy.ndarray, optional): Array receiving the partial
+        derivatives with respect to y. Defaults to ``None``.
+    fill_holes (tuple, optional): Half-windows ``(nx, ny)`` of the LOESS
+        filter estimating the undefined values read by the interpolation.
+        Defaults to ``None``.
+Returns:
+    tuple: Values interpolated and their partial derivatives with respect to
+    x and y, i.e. ``(out, out_dx, out_dy)`` if provided. The derivatives are
+    constant along each axis of a cell, and are expressed in units of the
+    values per unit of the axes.
+)__doc__")
+              .c_str());
+  }
 }
 
 }  // namespace pyinterp
@@ -0,0 +1,816 @@
+// Copyright (c) 2022 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+#pragma once
+#include <pybind11/numpy.h>
+#include <pybind11/stl.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <memory>
+#include <numeric>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "pyinterp/axis.hpp"
+#include "pyinterp/detail/broadcast.hpp"
+#include "pyinterp/detail/math/bicubic_coefficients.hpp"
+#include "pyinterp/detail/thread.hpp"
+#include "pyinterp/detail/tile_cache.hpp"
+
+namespace pyinterp {
+
+/// Function reading a block of values of a chunked array.
+///
+/// The function receives the index of the first item of the block and the
+/// number of items of the block along each dimension, and returns the values
+/// of the block in row-major order.
+template <typename DataType, size_t Dimension>
+using ChunkReader = std::function<std::vector<DataType>(
+    const std::array<int64_t, Dimension>&,
+    const std::array<int64_t, Dimension>&)>;
+
+/// Array split into chunks of fixed shape, read on demand by a user-supplied
+/// reader. The chunks read are kept in a cache of limited size, shared by the
+/// threads and by the copies of the instance, so that only the chunks holding
+/// the values requested are resident.
+///
+/// @tparam DataType Array data type
+/// @tparam Dimension Number of dimensions of the array.
+template <typename DataType, size_t Dimension>
+class ChunkedArray {
+  /// Values of a chunk, in row-major order.
+  struct Tile;
+
+ public:
+  /// Index or shape of the array.
+  using Index = std::array<int64_t, Dimension>;
+
+  /// Type of the function reading the chunks.
+  using Reader = ChunkReader<DataType, Dimension>;
+
+  /// Default constructor
+  ///
+  /// @param shape Shape of the array.
+  /// @param chunks Shape of the chunks. The chunks of the last row of each
+  /// dimension may be smaller.
+  /// @param reader Function reading the chunks.
+  /// @param cache_size Maximum number of chunks kept in memory.
+  ChunkedArray(const Index& shape, const Index& chunks, Reader reader,
+               const size_t cache_size)
+      : shape_(shape),
+        chunks_(chunks),
+        reader_(std::make_shared<const Reader>(std::move(reader))),
+        cache_(std::make_shared<detail::TileCache<Tile>>(cache_size)) {
+    for (size_t ix = 0; ix < Dimension; ++ix) {
+      if (chunks_[ix] < 1) {
+        throw std::invalid_argument(
+            "the shape of the chunks must be strictly positive");
+      }
+      count_[ix] = (shape_[ix] + chunks_[ix] - 1) / chunks_[ix];
+    }
+  }
+
+  /// Gets the shape of the array.
+  [[nodiscard]] inline auto shape() const noexcept -> const Index& {
+    return shape_;
+  }
+
+  /// Gets the shape of the chunks.
+  [[nodiscard]] inline auto chunks() const noexcept -> const Index& {
+    return chunks_;
+  }
+
+  /// Gets the maximum number of chunks kept in memory.
+  [[nodiscard]] inline auto cache_size() const noexcept -> size_t {
+    return cache_->capacity();
+  }
+
+  /// Gets the number of chunks currently held in memory.
+  [[nodiscard]] inline auto cached() const -> size_t { return cache_->size(); }
+
+  /// Releases the chunks held in memory.
+  inline auto clear_cache() const -> void { cache_->clear(); }
+
+  /// Gets the number of chunks of the array.
+  [[nodiscard]] inline auto num_chunks() const noexcept -> uint64_t {
+    auto result = uint64_t(1);
+    for (auto item : count_) {
+      result *= static_cast<uint64_t>(item);
+    }
+    return result;
+  }
+
+  /// Gets the key identifying the chunk holding the item of the given index.
+  [[nodiscard]] inline auto key(const Index& index) const noexcept
+      -> uint64_t {
+    auto result = uint64_t(0);
+    for (size_t ix = 0; ix < Dimension; ++ix) {
+      result = result * count_[ix] + index[ix] / chunks_[ix];
+    }
+    return result;
+  }
+
+  /// Reads the chunk identified by the given key, if it is not cached.
+  inline auto prefetch(uint64_t key) const -> void {
+    const auto tile_key = key;
+    auto chunk = Index();
+    for (auto ix = static_cast<int64_t>(Dimension) - 1; ix >= 0; --ix) {
+      chunk[ix] = static_cast<int64_t>(key % count_[ix]);
+      key /= count_[ix];
+    }
+    tile(chunk, tile_key);
+  }
+
+  /// Reads the values of the array from a thread. The accessor keeps the
+  /// chunk read last, so that the values of a chunk are read without
+  /// locking the cache as long as the indexes requested fall in this chunk.
+  /// An instance must not be shared between threads.
+  class Accessor {
+   public:
+    /// Default constructor
+    explicit Accessor(const ChunkedArray& array) : array_(array) {}
+
+    /// Gets the value of the item (ix, iy, ...).
+    template <typename... Indexes>
+    inline auto operator()(Indexes... indexes) const -> DataType {
+      static_assert(sizeof...(Indexes) == Dimension,
+                    "the number of indexes must match the dimension");
+      const auto index = Index{static_cast<int64_t>(indexes)...};
+      auto chunk = Index();
+      for (size_t ix = 0; ix < Dimension; ++ix) {
+        chunk[ix] = index[ix] / array_.chunks_[ix];
+      }
+      const auto key = array_.key(index);
+      if (tile_ == nullptr || key != key_) {
+        tile_ = array_.tile(chunk, key);
+        key_ = key;
+      }
+      auto offset = int64_t(0);
+      for (size_t ix = 0; ix < Dimension; ++ix) {
+        offset += (index[ix] - chunk[ix] * array_.chunks_[ix]) *
+                  tile_->strides[ix];
+      }
+      return tile_->values[offset];
+    }
+
+   private:
+    const ChunkedArray& array_;
+    mutable std::shared_ptr<const Tile> tile_{};
+    mutable uint64_t key_{0};
+  };
+
+ private:
+  struct Tile {
+    Index strides;
+    std::vector<DataType> values;
+  };
+
+  Index shape_;
+  Index chunks_;
+  Index count_{};
+  std::shared_ptr<const Reader> reader_;
+  std::shared_ptr<detail::TileCache<Tile>> cache_;
+
+  /// Gets the chunk of the given position, reading it if it is not cached.
+  auto tile(const Index& chunk, const uint64_t key) const
+      -> std::shared_ptr<const Tile> {
+    return cache_->get(key, [&]() -> Tile {
+      auto start = Index();
+      auto shape = Index();
+      auto tile = Tile();
+      auto size = int64_t(1);
+      for (auto ix = static_cast<int64_t>(Dimension) - 1; ix >= 0; --ix) {
+        start[ix] = chunk[ix] * chunks_[ix];
+        shape[ix] = std::min(chunks_[ix], shape_[ix] - start[ix]);
+        tile.strides[ix] = size;
+        size *= shape[ix];
+      }
+      tile.values = (*reader_)(start, shape);
+      if (static_cast<int64_t>(tile.values.size()) != size) {
+        throw std::invalid_argument(
+            "the reader returned " + std::to_string(tile.values.size()) +
+            " values for a chunk of " + std::to_string(size) + " values");
+      }
+      return tile;
+    });
+  }
+};
+
+/// Cartesian Grid 3D whose values are read by chunks, on demand.
+///
+/// @tparam DataType Grid data type
+/// @tparam AxisType Axis data type
+/// @tparam Dimension Total number of dimensions handled by this instance.
+template <typename DataType, typename AxisType, size_t Dimension = 3>
+class ChunkedGrid3D {
+ public:
+  /// Type of the chunked array holding the values.
+  using Array = ChunkedArray<DataType, Dimension>;
+
+  /// Default constructor
+  ///
+  /// @param x X-Axis
+  /// @param y Y-Axis
+  /// @param z Z-Axis
+  /// @param chunks Shape of the chunks.
+  /// @param reader Function reading the chunks.
+  /// @param cache_size Maximum number of chunks kept in memory.
+  ChunkedGrid3D(std::shared_ptr<Axis<double>> x,
+                std::shared_ptr<Axis<double>> y,
+                std::shared_ptr<Axis<AxisType>> z,
+                const typename Array::Index& chunks,
+                typename Array::Reader reader, const size_t cache_size)
+      : ChunkedGrid3D(x, y, z, {x->size(), y->size(), z->size()}, chunks,
+                      std::move(reader), cache_size) {}
+
+  /// Gets the X-Axis
+  [[nodiscard]] inline auto x() const noexcept
+      -> const std::shared_ptr<Axis<double>>& {
+    return x_;
+  }
+
+  /// Gets the Y-Axis
+  [[nodiscard]] inline auto y() const noexcept
+      -> const std::shared_ptr<Axis<double>>& {
+    return y_;
+  }
+
+  /// Gets the Z-Axis
+  [[nodiscard]] inline auto z() const noexcept
+      -> const std::shared_ptr<Axis<AxisType>>& {
+    return z_;
+  }
+
+  /// Gets the array holding the values of the grid.
+  [[nodiscard]] inline auto array() const noexcept -> const Array& {
+    return array_;
+  }
+
+  /// The coefficients of the bicubic interpolation are not precomputed for
+  /// the chunked grids: returns a null pointer.
+  [[nodiscard]] inline auto bicubic_coefficients() const noexcept
+      -> std::shared_ptr<const detail::math::BicubicCoefficients> {
+    return nullptr;
+  }
+
+  /// Grid read by a thread: the axes are those of the grid and the chunk
+  /// read last is kept by the accessor.
+  class Accessor {
+   public:
+    /// Default constructor
+    explicit Accessor(const ChunkedGrid3D& grid)
+        : grid_(grid), values_(grid.array_) {}
+
+    /// Gets the X-Axis
+    [[nodiscard]] inline auto x() const noexcept
+        -> const std::shared_ptr<Axis<double>>& {
+      return grid_.x_;
+    }
+
+    /// Gets the Y-Axis
+    [[nodiscard]] inline auto y() const noexcept
+        -> const std::shared_ptr<Axis<double>>& {
+      return grid_.y_;
+    }
+
+    /// Gets the Z-Axis
+    [[nodiscard]] inline auto z() const noexcept
+        -> const std::shared_ptr<Axis<AxisType>>& {
+      return grid_.z_;
+    }
+
+    /// Gets the grid value for the coordinate pixel (ix, iy, ...).
+    template <typename... Index>
+    inline auto value(Index&&... index) const -> DataType {
+      return values_(std::forward<Index>(index)...);
+    }
+
+   private:
+    const ChunkedGrid3D& grid_;
+    typename Array::Accessor values_;
+  };
+
+  /// Gets an accessor reading the values of the grid from a thread.
+  [[nodiscard]] inline auto accessor() const -> Accessor {
+    return Accessor(*this);
+  }
+
+ protected:
+  std::shared_ptr<Axis<double>> x_;
+  std::shared_ptr<Axis<double>> y_;
+  std::shared_ptr<Axis<AxisType>> z_;
+  Array array_;
+
+  /// Builds a grid from the shape of the array.
+  ChunkedGrid3D(std::shared_ptr<Axis<double>> x,
+                std::shared_ptr<Axis<double>> y,
+                std::shared_ptr<Axis<AxisType>> z,
+                const typename Array::Index& shape,
+                const typename Array::Index& chunks,
+                typename Array::Reader reader, const size_t cache_size)
+      : x_(std::move(x)),
+        y_(std::move(y)),
+        z_(std::move(z)),
+        array_(shape, chunks, std::move(reader), cache_size) {}
+};
+
+/// Cartesian Grid 4D whose values are read by chunks, on demand.
+///
+/// @tparam DataType Grid data type
+/// @tparam AxisType Axis data type
+template <typename DataType, typename AxisType>
+class ChunkedGrid4D : public ChunkedGrid3D<DataType, AxisType, 4> {
+ public:
+  using Base = ChunkedGrid3D<DataType, AxisType, 4>;
+
+  /// Default constructor
+  ///
+  /// @param x X-Axis
+  /// @param y Y-Axis
+  /// @param z Z-Axis
+  /// @param u U-Axis
+  /// @param chunks Shape of the chunks.
+  /// @param reader Function reading the chunks.
+  /// @param cache_size Maximum number of chunks kept in memory.
+  ChunkedGrid4D(std::shared_ptr<Axis<double>> x,
+                std::shared_ptr<Axis<double>> y,
+                std::shared_ptr<Axis<AxisType>> z,
+                std::shared_ptr<Axis<double>> u,
+                const typename Base::Array::Index& chunks,
+                typename Base::Array::Reader reader, const size_t cache_size)
+      : Base(x, y, z, {x->size(), y->size(), z->size(), u->size()}, chunks,
+             std::move(reader), cache_size),
+        u_(std::move(u)) {}
+
+  /// Gets the U-Axis
+  [[nodiscard]] inline auto u() const noexcept
+      -> const std::shared_ptr<Axis<double>>& {
+    return u_;
+  }
+
+  /// Grid read by a thread: the axes are those of the grid and the chunk
+  /// read last is kept by the accessor.
+  class Accessor : public Base::Accessor {
+   public:
+    /// Default constructor
+    explicit Accessor(const ChunkedGrid4D& grid)
+        : Base::Accessor(grid), u_(grid.u_) {}
+
+    /// Gets the U-Axis
+    [[nodiscard]] inline auto u() const noexcept
+        -> const std::shared_ptr<Axis<double>>& {
+      return u_;
+    }
+
+   private:
+    std::shared_ptr<Axis<double>> u_;
+  };
+
+  /// Gets an accessor reading the values of the grid from a thread.
+  [[nodiscard]] inline auto accessor() const -> Accessor {
+    return Accessor(*this);
+  }
+
+ protected:
+  std::shared_ptr<Axis<double>> u_;
+};
+
+/// The values of the regular grids are read directly by the threads.
+template <typename Grid>
+inline auto make_accessor(const Grid& grid) -> const Grid& {
+  return grid;
+}
+
+/// Each thread reads the values of a chunked grid through its own accessor.
+template <typename DataType, typename AxisType>
+inline auto make_accessor(const ChunkedGrid3D<DataType, AxisType>& grid) ->
+    typename ChunkedGrid3D<DataType, AxisType>::Accessor {
+  return grid.accessor();
+}
+
+/// Each thread reads the values of a chunked grid through its own accessor.
+template <typename DataType, typename AxisType>
+inline auto make_accessor(const ChunkedGrid4D<DataType, AxisType>& grid) ->
+    typename ChunkedGrid4D<DataType, AxisType>::Accessor {
+  return grid.accessor();
+}
+
+/// Order in which the points interpolated on a regular grid are visited.
+///
+/// The points are grouped by the layer, i.e. the cell of the z-axis (and of
+/// the u-axis for a 4D grid), framing them, keeping their input order within
+/// a layer. The threads then interpolate the points of a few layers, whose
+/// slabs of values stay in cache, instead of jumping between the layers of
+/// scattered points.
+class LayerOrder {
+ public:
+  /// Default constructor
+  ///
+  /// @param size Number of points interpolated.
+  /// @param layer Function returning, for a point, the index of the layer
+  /// framing it, or nothing if the point is outside the grid.
+  /// @param num_threads The number of threads used to locate the points.
+  template <typename Layer>
+  LayerOrder(const size_t size, const Layer& layer, const size_t num_threads)
+      : order_(size) {
+    auto keys = std::vector<int64_t>(size);
+    detail::dispatch(
+        [&](size_t start, size_t end) {
+          for (auto ix = start; ix < end; ++ix) {
+            keys[ix] = layer(ix).value_or(-1);
+          }
+        },
+        size, num_threads);
+
+    // The points outside the grid are grouped after the layers.
+    auto outside = int64_t(0);
+    for (auto item : keys) {
+      outside = std::max(outside, item + 1);
+    }
+    for (auto& item : keys) {
+      item = item == -1 ? outside : item;
+    }
+
+    if (outside <= static_cast<int64_t>(
+                       std::max<size_t>(size, size_t(1) << 16))) {
+      // Counting sort of the points by layer.
+      auto offsets = std::vector<size_t>(outside + 2, 0);
+      for (auto item : keys) {
+        ++offsets[item + 1];
+      }
+      std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+      for (size_t ix = 0; ix < size; ++ix) {
+        order_[offsets[keys[ix]]++] = ix;
+      }
+    } else {
+      std::iota(order_.begin(), order_.end(), size_t(0));
+      std::stable_sort(
+          order_.begin(), order_.end(),
+          [&](size_t lhs, size_t rhs) { return keys[lhs] < keys[rhs]; });
+    }
+
+    for (size_t ix = 0; ix < size; ++ix) {
+      if (ix == 0 || keys[order_[ix]] != keys[order_[ix - 1]]) {
+        offsets_.push_back(ix);
+      }
+    }
+    offsets_.push_back(size);
+  }
+
+  /// Calls the function for the points of rank [start, end) in the order of
+  /// the layers.
+  template <typename Function>
+  inline auto for_each(const size_t start, const size_t end,
+                       Function&& function) const -> void {
+    for (auto ix = start; ix < end; ++ix) {
+      function(order_[ix]);
+    }
+  }
+
+  /// Calls the function, for each layer, with the index and the number of
+  /// the points of rank [start, end) framed by this layer.
+  template <typename Function>
+  auto for_each_layer(const size_t start, const size_t end,
+                      Function&& function) const -> void {
+    auto group = static_cast<size_t>(
+        std::upper_bound(offsets_.begin(), offsets_.end(), start) -
+        offsets_.begin() - 1);
+    for (auto ix = start; ix < end; ++group) {
+      const auto last = std::min(offsets_[group + 1], end);
+      function(order_.data() + ix, last - ix);
+      ix = last;
+    }
+  }
+
+ private:
+  /// Index of the points, sorted by layer.
+  std::vector<size_t> order_;
+  /// Rank of the first point of each layer, followed by the number of points.
+  std::vector<size_t> offsets_{};
+};
+
+/// Order in which the points interpolated on a chunked grid are visited.
+///
+/// The points are grouped by the chunk holding the first vertex of the cell
+/// framing them, so that each chunk is read once even if the points are
+/// scattered. While the points of a group are interpolated, the chunk of the
+/// next group is read by another thread.
+///
+/// @tparam Array Type of the chunked array
+template <typename Array>
+class ChunkOrder {
+ public:
+  /// Default constructor
+  ///
+  /// @param array Array read.
+  /// @param size Number of points interpolated.
+  /// @param cell Function returning, for a point, the index of the first
+  /// vertex of the cell framing it, or nothing if the point is outside the
+  /// grid.
+  /// @param num_threads The number of threads used to locate the points.
+  template <typename Cell>
+  ChunkOrder(const Array& array, const size_t size, const Cell& cell,
+             const size_t num_threads)
+      : array_(array), order_(size) {
+    // The points outside the grid are grouped after the chunks.
+    const auto outside = array.num_chunks();
+    auto keys = std::vector<uint64_t>(size);
+    detail::dispatch(
+        [&](size_t start, size_t end) {
+          for (auto ix = start; ix < end; ++ix) {
+            auto index = cell(ix);
+            keys[ix] = index.has_value() ? array.key(*index) : outside;
+          }
+        },
+        size, num_threads);
+
+    if (outside <= std::max<uint64_t>(size, uint64_t(1) << 16)) {
+      // Counting sort of the points by chunk.
+      auto offsets = std::vector<size_t>(outside + 2, 0);
+      for (auto item : keys) {
+        ++offsets[item + 1];
+      }
+      std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+      for (size_t ix = 0; ix < size; ++ix) {
+        order_[offsets[keys[ix]]++] = ix;
+      }
+    } else {
+      // Too many chunks to be counted: the points are sorted by key.
+      std::iota(order_.begin(), order_.end(), size_t(0));
+      std::stable_sort(
+          order_.begin(), order_.end(),
+          [&](size_t lhs, size_t rhs) { return keys[lhs] < keys[rhs]; });
+    }
+
+    for (size_t ix = 0; ix < size; ++ix) {
+      const auto key = keys[order_[ix]];
+      if (ix == 0 || key != keys_.back()) {
+        offsets_.push_back(ix);
+        keys_.push_back(key < outside ? std::optional<uint64_t>(key)
+                                      : std::nullopt);
+      }
+    }
+    offsets_.push_back(size);
+  }
+
+  /// Calls the function for the points of rank [start, end) in the order of
+  /// the chunks.
+  template <typename Function>
+  auto for_each(const size_t start, const size_t end,
+                Function&& function) const -> void {
+    auto prefetch = std::future<void>();
+    auto group = static_cast<size_t>(
+        std::upper_bound(offsets_.begin(), offsets_.end(), start) -
+        offsets_.begin() - 1);
+    for (auto ix = start; ix < end; ++group) {
+      const auto last = std::min(offsets_[group + 1], end);
+      if (prefetch.valid()) {
+        prefetch.wait();
+      }
+      if (last < end && keys_[group + 1].has_value()) {
+        // A chunk that cannot be read is reported when its values are read.
+        prefetch = std::async(std::launch::async,
+                              [this, key = *keys_[group + 1]]() {
+                                try {
+                                  array_.prefetch(key);
+                                } catch (...) {
+                                }
+                              });
+      }
+      for (; ix < last; ++ix) {
+        function(order_[ix]);
+      }
+    }
+  }
+
+ private:
+  const Array& array_;
+  /// Index of the points, sorted by chunk.
+  std::vector<size_t> order_;
+  /// Rank of the first point of each group, followed by the number of points.
+  std::vector<size_t> offsets_{};
+  /// Chunk of each group, or nothing for the points outside the grid.
+  std::vector<std::optional<uint64_t>> keys_{};
+};
+
+/// The points interpolated on a regular grid are visited layer by layer.
+template <typename Grid, typename Cell, typename Layer>
+inline auto make_order(const Grid& /*grid*/, const size_t size,
+                       const Cell& /*cell*/, const Layer& layer,
+                       const size_t num_threads) -> LayerOrder {
+  return {size, layer, num_threads};
+}
+
+/// The points interpolated on a chunked grid are visited chunk by chunk.
+template <typename DataType, typename AxisType, typename Cell, typename Layer>
+inline auto make_order(const ChunkedGrid3D<DataType, AxisType>& grid,
+                       const size_t size, const Cell& cell,
+                       const Layer& /*layer*/, const size_t num_threads)
+    -> ChunkOrder<ChunkedArray<DataType, 3>> {
+  return {grid.array(), size, cell, num_threads};
+}
+
+/// The points interpolated on a chunked grid are visited chunk by chunk.
+template <typename DataType, typename AxisType, typename Cell, typename Layer>
+inline auto make_order(const ChunkedGrid4D<DataType, AxisType>& grid,
+                       const size_t size, const Cell& cell,
+                       const Layer& /*layer*/, const size_t num_threads)
+    -> ChunkOrder<ChunkedArray<DataType, 4>> {
+  return {grid.array(), size, cell, num_threads};
+}
+
+/// Visits the points of rank [start, end) of a regular grid layer by layer:
+/// "layer" is called with the index and the number of the points of each
+/// layer.
+template <typename Layer, typename Point>
+inline auto for_each_layer(const LayerOrder& order, const size_t start,
+                           const size_t end, Layer&& layer,
+                           Point&& /*point*/) -> void {
+  order.for_each_layer(start, end, std::forward<Layer>(layer));
+}
+
+/// The points of a chunked grid are not grouped by layer: "point" is called
+/// for each point of rank [start, end).
+template <typename Array, typename Layer, typename Point>
+inline auto for_each_layer(const ChunkOrder<Array>& order, const size_t start,
+                           const size_t end, Layer&& /*layer*/,
+                           Point&& point) -> void {
+  order.for_each(start, end, std::forward<Point>(point));
+}
+
+/// Wraps a Python callable into a chunk reader. The callable receives a tuple
+/// of slices selecting the chunk, such as ``array[key]`` for a NumPy, Dask,
+/// Zarr or xarray array, and returns the values of the chunk.
+template <typename DataType, size_t Dimension>
+auto python_chunk_reader(pybind11::function function)
+    -> ChunkReader<DataType, Dimension> {
+  // The callable is shared by the copies of the reader, whose copies do not
+  // have to hold the GIL.
+  auto callable = std::shared_ptr<pybind11::function>(
+      new pybind11::function(std::move(function)),
+      [](pybind11::function* ptr) {
+        pybind11::gil_scoped_acquire acquire;
+        delete ptr;
+      });
+  return [callable](const std::array<int64_t, Dimension>& start,
+                    const std::array<int64_t, Dimension>& shape)
+             -> std::vector<DataType> {
+    pybind11::gil_scoped_acquire acquire;
+    try {
+      auto key = pybind11::tuple(Dimension);
+      for (size_t ix = 0; ix < Dimension; ++ix) {
+        key[ix] = pybind11::slice(start[ix], start[ix] + shape[ix], 1);
+      }
+      auto values = pybind11::array_t<DataType, pybind11::array::c_style |
+                                                    pybind11::array::forcecast>(
+          (*callable)(key));
+      if (values.ndim() != static_cast<pybind11::ssize_t>(Dimension) ||
+          !std::equal(shape.begin(), shape.end(), values.shape(),
+                      [](auto lhs, auto rhs) { return lhs == rhs; })) {
+        throw std::invalid_argument(
+            "the reader returned an array of shape " +
+            detail::ndarray_shape(values) + " for a chunk of " +
+            std::to_string(Dimension) + " dimensions");
+      }
+      return std::vector<DataType>(values.data(),
+                                   values.data() + values.size());
+    } catch (pybind11::error_already_set& ex) {
+      // The Python exception is converted, so that it can be rethrown from
+      // the thread interpolating the values.
+      throw std::runtime_error(ex.what());
+    }
+  };
+}
+
+/// Implementations of Cartesian grids read by chunks.
+///
+/// @tparam DataType Grid data type
+/// @tparam AxisType Axis data type
+template <typename DataType, typename AxisType>
+void implement_chunked_grid(pybind11::module& m, const std::string& prefix,
+                            const std::string& suffix) {
+  using Grid3D = ChunkedGrid3D<DataType, AxisType>;
+  using Grid4D = ChunkedGrid4D<DataType, AxisType>;
+
+  pybind11::class_<Grid3D>(
+      m, (prefix + "ChunkedGrid3D" + suffix).c_str(),
+      ((prefix.length() ? prefix + " " : std::string()) +
+       "Cartesian Grid 3D whose values are read by chunks, on demand.")
+          .c_str())
+      .def(pybind11::init([](std::shared_ptr<Axis<double>> x,
+                             std::shared_ptr<Axis<double>> y,
+                             std::shared_ptr<Axis<AxisType>> z,
+                             const std::array<int64_t, 3>& chunks,
+                             pybind11::function reader,
+                             const size_t cache_size) {
+             return Grid3D(std::move(x), std::move(y), std::move(z), chunks,
+                           python_chunk_reader<DataType, 3>(std::move(reader)),
+                           cache_size);
+           }),
+           pybind11::arg("x"), pybind11::arg("y"), pybind11::arg("z"),
+           pybind11::arg("chunks"), pybind11::arg("reader"),
+           pybind11::arg("cache_size") = 64,
+           (R"__doc__(
+Default constructor
+
+Args:
+    x (pyinterp.core.Axis): X-Axis
+    y (pyinterp.core.Axis): Y-Axis
+    z (pyinterp.core.)__doc__" +
+            prefix + R"__doc__(Axis): Z-Axis
+    chunks (tuple): Shape of the chunks.
+    reader (callable): Function called with a tuple of slices selecting a
+        chunk, and returning the values of this chunk.
+    cache_size (int, optional): Maximum number of chunks kept in memory.
+        Defaults to ``64``.
+)__doc__")
+               .c_str())
+      .def_property_readonly(
+          "x", [](const Grid3D& self) { return self.x(); }, "X-Axis")
+      .def_property_readonly(
+          "y", [](const Grid3D& self) { return self.y(); }, "Y-Axis")
+      .def_property_readonly(
+          "z", [](const Grid3D& self) { return self.z(); }, "Z-Axis")
+      .def_property_readonly(
+          "chunks", [](const Grid3D& self) { return self.array().chunks(); },
+          "Shape of the chunks.")
+      .def_property_readonly(
+          "cache_size",
+          [](const Grid3D& self) { return self.array().cache_size(); },
+          "Maximum number of chunks kept in memory.")
+      .def(
+          "cached", [](const Grid3D& self) { return self.array().cached(); },
+          "Returns the number of chunks currently held in memory.")
+      .def(
+          "clear_cache",
+          [](const Grid3D& self) { self.array().clear_cache(); },
+          "Releases the chunks held in memory.");
+
+  pybind11::class_<Grid4D>(
+      m, (prefix + "ChunkedGrid4D" + suffix).c_str(),
+      ((prefix.length() ? prefix + " " : std::string()) +
+       "Cartesian Grid 4D whose values are read by chunks, on demand.")
+          .c_str())
+      .def(pybind11::init([](std::shared_ptr<Axis<double>> x,
+                             std::shared_ptr<Axis<double>> y,
+                             std::shared_ptr<Axis<AxisType>> z,
+                             std::shared_ptr<Axis<double>> u,
+                             const std::array<int64_t, 4>& chunks,
+                             pybind11::function reader,
+                             const size_t cache_size) {
+             return Grid4D(std::move(x), std::move(y), std::move(z),
+                           std::move(u), chunks,
+                           python_chunk_reader<DataType, 4>(std::move(reader)),
+                           cache_size);
+           }),
+           pybind11::arg("x"), pybind11::arg("y"), pybind11::arg("z"),
+           pybind11::arg("u"), pybind11::arg("chunks"),
+           pybind11::arg("reader"), pybind11::arg("cache_size") = 64,
+           (R"__doc__(
+Default constructor
+
+Args:
+    x (pyinterp.core.Axis): X-Axis
+    y (pyinterp.core.Axis): Y-Axis
+    z (pyinterp.core.)__doc__" +
+            prefix + R"__doc__(Axis): Z-Axis
+    u (pyinterp.core.Axis): U-Axis
+    chunks (tuple): Shape of the chunks.
+    reader (callable): Function called with a tuple of slices selecting a
+        chunk, and returning the values of this chunk.
+    cache_size (int, optional): Maximum number of chunks kept in memory.
+        Defaults to ``64``.
+)__doc__")
+               .c_str())
+      .def_property_readonly(
+          "x", [](const Grid4D& self) { return self.x(); }, "X-Axis")
+      .def_property_readonly(
+          "y", [](const Grid4D& self) { return self.y(); }, "Y-Axis")
+      .def_property_readonly(
+          "z", [](const Grid4D& self) { return self.z(); }, "Z-Axis")
+      .def_property_readonly(
+          "u", [](const Grid4D& self) { return self.u(); }, "U-Axis")
+      .def_property_readonly(
+          "chunks", [](const Grid4D& self) { return self.array().chunks(); },
+          "Shape of the chunks.")
+      .def_property_readonly(
+          "cache_size",
+          [](const Grid4D& self) { return self.array().cache_size(); },
+          "Maximum number of chunks kept in memory.")
+      .def(
+          "cached", [](const Grid4D& self) { return self.array().cached(); },
+          "Returns the number of chunks currently held in memory.")
+      .def(
+          "clear_cache",
+          [](const Grid4D& self) { self.array().clear_cache(); },
+          "Releases the chunks held in memory.");
+}
+
+}  // namespace pyinterp
@@ -4,12 +4,15 @@
 // BSD-style license that can be found in the LICENSE file.
 #pragma once
 
+#include <algorithm>
 #include <array>
 #include <cmath>
 #include <cstdint>
 #include <iomanip>
+#include <limits>
 #include <regex>
 #include <sstream>
+#include <stdexcept>
 #include <tuple>
 
 namespace pyinterp::dateutils {
@@ -43,6 +46,12 @@ constexpr int kYDayMinimum = -366;
 constexpr std::array<int, 13> kDaysInMonth({-1, 31, 28, 31, 30, 31, 30, 31, 31,
                                             30, 31, 30, 31});
 
+/// Number of days elapsed since the first January, at the beginning of each
+/// month of a non-leap year.
+constexpr std::array<unsigned, 13> kDaysBeforeMonth({0, 0, 31, 59, 90, 120, 151,
+                                                     181, 212, 243, 273, 304,
+                                                     334});
+
 /// Handles numpy encoded dates.
 class DType {
  public:
@@ -281,6 +290,97 @@ class DType {
   }
 };
 
+/// Converts the dates, or the durations, encoded in 64-bit integers from a
+/// clock resolution into another, as numpy does when it casts a datetime64
+/// array. Only the resolutions of fixed length, from the week to the
+/// attosecond, are converted this way: the length of the years and the months
+/// varies.
+class ResolutionCast {
+ public:
+  /// Default constructor: the values are not modified.
+  ResolutionCast() = default;
+
+  /// Build the conversion between two resolutions.
+  ///
+  /// @param from Resolution of the values converted.
+  /// @param to Resolution of the values returned.
+  /// @throw std::invalid_argument if one of the resolutions has not a fixed
+  /// length, or if the ratio between them cannot be represented by a 64-bit
+  /// integer.
+  ResolutionCast(const DType& from, const DType& to) {
+    if (!is_fixed(from) || !is_fixed(to)) {
+      throw std::invalid_argument("Cannot convert " +
+                                  static_cast<std::string>(from) + " to " +
+                                  static_cast<std::string>(to) +
+                                  " without a calendar");
+    }
+    auto coarse = std::min(from.resolution(), to.resolution());
+    auto fine = std::max(from.resolution(), to.resolution());
+    auto factor = int64_t(1);
+    for (auto item = coarse + 1; item <= fine; ++item) {
+      auto ratio = subdivisions(static_cast<DType::Resolution>(item));
+      if (factor > std::numeric_limits<int64_t>::max() / ratio) {
+        throw std::invalid_argument(
+            "Cannot convert " + static_cast<std::string>(from) + " to " +
+            static_cast<std::string>(to) + ": the ratio is too large");
+      }
+      factor *= ratio;
+    }
+    if (from.resolution() < to.resolution()) {
+      multiplier_ = factor;
+    } else {
+      divisor_ = factor;
+    }
+  }
+
+  /// Returns true if the values of the resolution can be converted.
+  [[nodiscard]] static constexpr auto is_fixed(const DType& dtype) noexcept
+      -> bool {
+    return dtype.resolution() >= DType::kWeek;
+  }
+
+  /// Converts a value. The values converted to a coarser resolution are
+  /// rounded down, and NaT is kept.
+  constexpr auto operator()(const int64_t value) const noexcept -> int64_t {
+    if (value == kNaT) {
+      return value;
+    }
+    if (divisor_ == 1) {
+      return value * multiplier_;
+    }
+    auto quotient = value / divisor_;
+    return value % divisor_ < 0 ? quotient - 1 : quotient;
+  }
+
+ private:
+  /// Value encoding "Not a Time".
+  static constexpr int64_t kNaT = std::numeric_limits<int64_t>::min();
+
+  /// Factor applied to the values converted to a finer resolution.
+  int64_t multiplier_{1};
+
+  /// Divisor applied to the values converted to a coarser resolution.
+  int64_t divisor_{1};
+
+  /// Get the number of units of a resolution in the unit of the coarser
+  /// resolution.
+  static constexpr auto subdivisions(const DType::Resolution resolution)
+      -> int64_t {
+    switch (resolution) {
+      case DType::kDay:
+        return kDaysInWeek;
+      case DType::kHour:
+        return kHoursInDay;
+      case DType::kMinute:
+        return kMinutesInHour;
+      case DType::kSecond:
+        return kSecondsInMinute;
+      default:
+        return kMillisecond;
+    }
+  }
+};
+
 /// Handle a date encoded in a 64-bit integer for a given clock resolution (
 /// Clock resolution must be in range kSecond to kAttosecond)
 class FractionalSeconds {
@@ -297,11 +397,25 @@ class FractionalSeconds {
   /// 1970
   [[nodiscard]] constexpr auto days_since_epoch(const int64_t datetime64)
       const noexcept -> std::tuple<int64_t, int64_t, int64_t> {
-    auto [seconds, fractional] = epoch(datetime64);
+    return days_since_epoch(datetime64, order_of_magnitude_);
+  }
+
+  /// Get the number of days, seconds and the fractional part elapsed since
+  /// 1970 for a date encoded with the given order of magnitude.
+  ///
+  /// The calculation has no branch, and the divisions are replaced by
+  /// multiplications by the compiler if the order of magnitude is a
+  /// constant, which allows the loops over arrays of dates to be vectorized.
+  [[nodiscard]] static constexpr auto days_since_epoch(
+      const int64_t datetime64, const int64_t order_of_magnitude) noexcept
+      -> std::tuple<int64_t, int64_t, int64_t> {
+    auto seconds = datetime64 / order_of_magnitude;
+    auto fractional = datetime64 % order_of_magnitude;
+    const auto borrow = static_cast<int64_t>(fractional < 0);
+    fractional += borrow * order_of_magnitude;
+    seconds -= borrow;
     auto days = seconds / kSecondsInDay;
-    if (seconds % kSecondsInDay < 0) {
-      --days;
-    }
+    days -= static_cast<int64_t>(seconds % kSecondsInDay < 0);
     return std::make_tuple(days, seconds, fractional);
   }
 
@@ -343,30 +457,6 @@ class FractionalSeconds {
 
  private:
   int64_t order_of_magnitude_;
-
-  /// Get the number of seconds elapsed since 1970
-  [[nodiscard]] constexpr auto seconds(const int64_t datetime64) const noexcept
-      -> int64_t {
-    return datetime64 / order_of_magnitude_;
-  }
-
-  /// Get the fractional part of the date
-  [[nodiscard]] constexpr auto fractional(
-      const int64_t datetime64) const noexcept -> int64_t {
-    return datetime64 % order_of_magnitude_;
-  }
-
-  /// Get the number of seconds elapsed since 1970 and the fractional part
-  [[nodiscard]] constexpr auto epoch(const int64_t datetime64) const noexcept
-      -> std::tuple<int64_t, int64_t> {
-    auto sec = seconds(datetime64);
-    auto frac = fractional(datetime64);
-    if (frac < 0) {
-      frac += order_of_magnitude_;
-      sec -= 1;
-    }
-    return std::make_tuple(sec, frac);
-  }
 };
 
 /// Represents a year, month, day in a calendar.
@@ -393,9 +483,7 @@ struct ISOCalendar {
 /// Get the number of hours, minutes and seconds elapsed in the day
 constexpr auto time_from_seconds(const int64_t seconds) noexcept -> Time {
   auto seconds_in_day = seconds % kSecondsInDay;
-  if (seconds_in_day < 0) {
-    seconds_in_day += kSecondsInDay;
-  }
+  seconds_in_day += static_cast<int64_t>(seconds_in_day < 0) * kSecondsInDay;
   const auto seconds_in_hour = seconds_in_day % kSecondsInHour;
 
   return {static_cast<unsigned>(seconds_in_day / kSecondsInHour),
@@ -563,17 +651,8 @@ constexpr auto is_leap_year(const int year) -> int {
 
 /// Get the number of days since the first January
 constexpr auto days_since_january(const Date& date) -> unsigned {
-  unsigned result = date.day - 1;
-
-  if (date.month > 2) {
-    result += is_leap_year(date.year);
-  }
-
-  for (size_t ix = 1; ix < date.month; ++ix) {
-    result += kDaysInMonth[ix];
-  }
-
-  return result;
+  return date.day - 1 + kDaysBeforeMonth[date.month] +
+         static_cast<unsigned>(date.month > 2 && is_leap_year(date.year));
 }
 
 /// Get the week day of the week; Sunday is 0 ... Saturday is 6
@@ -7,13 +7,19 @@
 #include <pybind11/numpy.h>
 #include <pybind11/stl.h>
 
+#include <algorithm>
 #include <memory>
 #include <optional>
+#include <stdexcept>
+#include <vector>
 
 #include "pyinterp/detail/broadcast.hpp"
 #include "pyinterp/detail/math/descriptive_statistics.hpp"
+#include "pyinterp/detail/math/rolling_statistics.hpp"
 #include "pyinterp/detail/numpy.hpp"
+#include "pyinterp/detail/thread.hpp"
 #include "pyinterp/eigen.hpp"
+#include "pyinterp/grid.hpp"
 
 namespace pyinterp {
 
@@ -36,7 +42,8 @@ class DescriptiveStatistics {
   DescriptiveStatistics(
       pybind11::array_t<T, pybind11::array::c_style>& values,
       std::optional<pybind11::array_t<T, pybind11::array::c_style>>& weights,
-      std::optional<std::list<pybind11::ssize_t>>& axis) {
+      std::optional<std::list<pybind11::ssize_t>>& axis,
+      const size_t num_threads) {
     // Check if the given axis is valid.
     if (axis) {
       detail::numpy::check_axis_bounds(values, *axis);
@@ -50,19 +57,17 @@ class DescriptiveStatistics {
     if (!axis) {
       // Compute the statistics for the whole array.
       shape_ = {1};
-      accumulators_ =
-          std::move(weights ? push(values, *weights) : push(values));
+      accumulators_ = std::move(weights ? push(values, *weights, num_threads)
+                                        : push(values, num_threads));
     } else {
       // Compute the statistics on a reduced dimension.
-      if (!weights) {
-        // If no weights are specified, the weights are set to ones.
-        weights = std::move(detail::numpy::ones_like(values));
+      for (pybind11::ssize_t ix = 0; ix < values.ndim(); ++ix) {
+        if (std::find(axis->begin(), axis->end(), ix) == axis->end()) {
+          shape_.push_back(values.shape(ix));
+        }
       }
-      auto [shape, strides, adjusted_strides] =
-          detail::numpy::reduced_properties(values, *axis);
-      shape_ = std::move(shape);
-      accumulators_ =
-          std::move(push(values, *weights, strides, adjusted_strides));
+      accumulators_ = std::move(
+          push(values, weights ? &*weights : nullptr, *axis, num_threads));
     }
   }
 
@@ -143,6 +148,62 @@ class DescriptiveStatistics {
         std::move(shape));
   }
 
+  /// Calculates the statistics of the values of a 3D grid within a window
+  /// sliding along its third axis, for example a time axis. The window slides
+  /// incrementally: the cost does not depend on its size. The series of the
+  /// cells of the grid are processed in parallel.
+  ///
+  /// @param grid Grid whose values are processed. NaNs are ignored.
+  /// @param window Number of values of the window.
+  /// @param center If true, the window is centered on each value, otherwise
+  /// it ends at each value.
+  /// @param min_periods Minimum number of valid values of a window for its
+  /// statistics to be defined.
+  /// @param num_threads The number of threads to use.
+  /// @return The statistics of the window of each value of the grid.
+  template <typename AxisType>
+  static auto rolling(const Grid3D<T, AxisType>& grid, const int64_t window,
+                      const bool center, const uint64_t min_periods,
+                      const size_t num_threads)
+      -> std::unique_ptr<DescriptiveStatistics<T>> {
+    if (window < 1) {
+      throw std::invalid_argument("window must be strictly positive");
+    }
+    if (min_periods > static_cast<uint64_t>(window)) {
+      throw std::invalid_argument(
+          "min_periods must not be greater than window");
+    }
+    // The centered windows of even size hold one more value before the
+    // current one.
+    const auto before = center ? window / 2 : window - 1;
+    const auto after = window - 1 - before;
+    const auto nx = grid.x()->size();
+    const auto ny = grid.y()->size();
+    const auto nz = grid.z()->size();
+    auto accumulators = Vector<Accumulators>(nx * ny * nz);
+    {
+      pybind11::gil_scoped_release release;
+      detail::dispatch(
+          [&](const size_t start, const size_t end) {
+            auto worker = detail::math::RollingStatistics<T>(before, after,
+                                                              min_periods);
+            for (auto ix = start; ix < end; ++ix) {
+              const auto i = static_cast<int64_t>(ix) / ny;
+              const auto j = static_cast<int64_t>(ix) % ny;
+              auto* result = accumulators.data() + ix * nz;
+              worker(
+                  nz, [&](const int64_t k) { return grid.value(i, j, k); },
+                  [result](const int64_t k, const Accumulators& item) {
+                    result[k] = item;
+                  });
+            }
+          },
+          static_cast<size_t>(nx * ny), num_threads);
+    }
+    return std::make_unique<DescriptiveStatistics<T>>(
+        std::move(accumulators), std::vector<pybind11::ssize_t>{nx, ny, nz});
+  }
+
  private:
   Vector<Accumulators> accumulators_;
   std::vector<pybind11::ssize_t> shape_{};
@@ -154,72 +215,140 @@ class DescriptiveStatistics {
                            std::multiplies<>());
   }
 
-  /// Push values to the accumulators when the user wants to
-  /// calculate statistics on the whole array. NaNs are ignored.
-  auto push(pybind11::array_t<T, pybind11::array::c_style>& arr)
-      -> Vector<Accumulators> {
-    auto* ptr_arr = detail::numpy::get_data_pointer<T>(arr.ptr());
-    auto result = Vector<Accumulators>(1);
-    auto& item = result[0];
-
-    {
-      pybind11::gil_scoped_release release;
+  /// Number of values processed by a thread at a time when the statistics
+  /// are calculated on the whole array.
+  static constexpr size_t kChunkSize = 64 * Accumulators::kBlockSize;
+
+  /// Calculates the statistics of the chunks of the array in parallel, then
+  /// combines them in order, so that the result does not depend on the
+  /// number of threads.
+  template <typename Function>
+  static auto reduce(const size_t size, const size_t num_threads,
+                     const Function& function) -> Vector<Accumulators> {
+    auto chunks = std::vector<Accumulators>((size + kChunkSize - 1) /
+                                            kChunkSize);
+    detail::dispatch(
+        [&](const size_t start, const size_t end) {
+          for (auto ix = start; ix < end; ++ix) {
+            function(ix * kChunkSize, std::min((ix + 1) * kChunkSize, size),
+                     chunks[ix]);
+          }
+        },
+        chunks.size(), num_threads);
 
-      std::for_each(ptr_arr, ptr_arr + arr.size(), [&item](const T& value) {
-        if (!std::isnan(value)) {
-          item(value);
-        }
-      });
+    auto result = Vector<Accumulators>(1);
+    for (const auto& item : chunks) {
+      result[0] += item;
     }
     return result;
   }
 
-  /// Push values and weights to the accumulators when the user wants to
+  /// Push values to the accumulators when the user wants to
   /// calculate statistics on the whole array. NaNs are ignored.
   auto push(pybind11::array_t<T, pybind11::array::c_style>& arr,
-            pybind11::array_t<T, pybind11::array::c_style>& weights)
-      -> Vector<Accumulators> {
+            const size_t num_threads) -> Vector<Accumulators> {
     auto* ptr_arr = detail::numpy::get_data_pointer<T>(arr.ptr());
-    auto* ptr_weights = detail::numpy::get_data_pointer<T>(weights.ptr());
-    auto result = Vector<Accumulators>(1);
-    auto& item = result[0];
-
-    {
-      pybind11::gil_scoped_release release;
+    pybind11::gil_scoped_release release;
 
-      for (auto ix = 0; ix < arr.size(); ++ix) {
-        const auto xi = ptr_arr[ix];
-        if (!std::isnan(xi)) {
-          item(xi, ptr_weights[ix]);
-        }
-      }
-    }
-    return result;
+    return reduce(arr.size(), num_threads,
+                  [ptr_arr](const size_t start, const size_t end,
+                            Accumulators& item) {
+                    item.push(ptr_arr + start, ptr_arr + end);
+                  });
   }
 
   /// Push values and weights to the accumulators when the user wants to
-  /// calculate statistics on a reduced array. NaNs are ignored.
+  /// calculate statistics on the whole array. NaNs are ignored.
   auto push(pybind11::array_t<T, pybind11::array::c_style>& arr,
             pybind11::array_t<T, pybind11::array::c_style>& weights,
-            const Vector<pybind11::ssize_t>& strides,
-            const Vector<pybind11::ssize_t>& adjusted_strides)
-      -> Vector<Accumulators> {
+            const size_t num_threads) -> Vector<Accumulators> {
     auto* ptr_arr = detail::numpy::get_data_pointer<T>(arr.ptr());
     auto* ptr_weights = detail::numpy::get_data_pointer<T>(weights.ptr());
-    auto result = Vector<Accumulators>(size());
-    auto indexes = Eigen::Matrix<pybind11::ssize_t, -1, 1>(arr.ndim());
+    pybind11::gil_scoped_release release;
+
+    return reduce(arr.size(), num_threads,
+                  [ptr_arr, ptr_weights](const size_t start, const size_t end,
+                                         Accumulators& item) {
+                    for (auto ix = start; ix < end; ++ix) {
+                      const auto xi = ptr_arr[ix];
+                      if (!std::isnan(xi)) {
+                        item(xi, ptr_weights[ix]);
+                      }
+                    }
+                  });
+  }
 
-    {
-      pybind11::gil_scoped_release release;
+  /// Push values, and weights if provided, to the accumulators when the user
+  /// wants to calculate statistics on a reduced array. NaNs are ignored.
+  ///
+  /// The reduced values are distributed between the threads. Each thread
+  /// reads runs of values contiguous in memory: if the innermost axes are
+  /// reduced, a run contributes to a single reduced value; otherwise, it
+  /// contributes to consecutive reduced values.
+  auto push(pybind11::array_t<T, pybind11::array::c_style>& arr,
+            pybind11::array_t<T, pybind11::array::c_style>* weights,
+            const std::list<pybind11::ssize_t>& axis,
+            const size_t num_threads) -> Vector<Accumulators> {
+    const auto* ptr_arr = detail::numpy::get_data_pointer<T>(arr.ptr());
+    const auto* ptr_weights =
+        weights != nullptr ? detail::numpy::get_data_pointer<T>(weights->ptr())
+                           : nullptr;
+    const auto layout = detail::numpy::reduced_layout(arr, axis);
+    const auto runs = layout.runs();
+    const auto inner_size = layout.inner_size;
+    auto result = Vector<Accumulators>(size());
 
-      for (auto ix = 0; ix < arr.size(); ++ix) {
-        const auto xi = ptr_arr[ix];
-        if (!std::isnan(xi)) {
-          detail::numpy::unravel(ix, strides, indexes);
-          auto jx = (indexes.array() * adjusted_strides.array()).sum();
-          result[jx](xi, ptr_weights[ix]);
+    // Push the value at the given offset into the accumulator.
+    auto push_value = [&](Accumulators& item, const pybind11::ssize_t offset) {
+      const auto xi = ptr_arr[offset];
+      if (!std::isnan(xi)) {
+        if (ptr_weights == nullptr) {
+          item(xi);
+        } else {
+          item(xi, ptr_weights[offset]);
+        }
+      }
+    };
+
+    auto worker = [&](const size_t start, const size_t end) {
+      if (layout.inner_reduced) {
+        for (auto ix = start; ix < end; ++ix) {
+          auto& item = result[static_cast<Eigen::Index>(ix)];
+          const auto base = layout.kept_offset(static_cast<int64_t>(ix));
+          for (pybind11::ssize_t jx = 0; jx < runs; ++jx) {
+            const auto first = base + layout.run_offset(jx);
+            if (ptr_weights == nullptr) {
+              item.push(ptr_arr + first, ptr_arr + first + inner_size);
+            } else {
+              for (auto kx = first; kx < first + inner_size; ++kx) {
+                push_value(item, kx);
+              }
+            }
+          }
+        }
+      } else {
+        // The reduced values [ix, ix + size) have consecutive positions in
+        // the innermost group, starting at the position `inner`.
+        auto ix = static_cast<int64_t>(start);
+        while (ix < static_cast<int64_t>(end)) {
+          const auto inner = ix % inner_size;
+          const auto size =
+              std::min(inner_size - inner, static_cast<int64_t>(end) - ix);
+          const auto base = layout.kept_offset(ix / inner_size) + inner;
+          for (pybind11::ssize_t jx = 0; jx < runs; ++jx) {
+            const auto first = base + layout.run_offset(jx);
+            for (int64_t kx = 0; kx < size; ++kx) {
+              push_value(result[ix + kx], first + kx);
+            }
+          }
+          ix += size;
         }
       }
+    };
+
+    {
+      pybind11::gil_scoped_release release;
+      detail::dispatch(worker, result.size(), num_threads);
     }
     return result;
   }
@@ -4,9 +4,13 @@
 // BSD-style license that can be found in the LICENSE file.
 #pragma once
 #include <Eigen/Core>
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <cmath>
 #include <limits>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <stdexcept>
 #include <string>
@@ -15,7 +19,9 @@
 #include <vector>
 
 #include "pyinterp/detail/axis/container.hpp"
+#include "pyinterp/detail/axis/intern.hpp"
 #include "pyinterp/detail/math.hpp"
+#include "pyinterp/detail/profiling.hpp"
 #include "pyinterp/eigen.hpp"
 
 namespace pyinterp::axis {
@@ -30,6 +36,99 @@ enum Boundary : uint8_t {
 
 }  // namespace pyinterp::axis
 
+namespace pyinterp::detail::axis {
+
+/// Tables of the indexes of the windows built around the elements of an
+/// axis. A table extends the indexes [0, size) of the axis by a margin on
+/// both sides, where the indexes located outside the axis are replaced
+/// according to a boundary handling mode: the indexes of a window are then
+/// read from a contiguous slice of the table.
+///
+/// The tables are built on demand, and rebuilt with a wider margin when a
+/// larger window is requested. The tables built are kept until this object
+/// is destroyed, which allows reading them without locking.
+class BoundaryTables {
+ public:
+  /// Indexes of an axis extended by a margin.
+  struct Table {
+    /// Number of indexes added on each side of the axis.
+    int64_t margin;
+    /// True if all the indexes of the margins are defined.
+    bool complete;
+    /// The indexes, -1 if the boundary handling does not define the index.
+    std::vector<int64_t> indexes;
+  };
+
+  /// Returns the table extending the indexes of an axis by at least
+  /// "margin" indexes on both sides.
+  ///
+  /// @param size Size of the axis.
+  /// @param margin Minimum number of indexes added on each side.
+  /// @param is_circle True if the axis is a circle: the indexes wrap around
+  /// the axis whatever the boundary handling.
+  /// @param boundary How to handle boundaries.
+  auto get(const int64_t size, const int64_t margin, const bool is_circle,
+           const ::pyinterp::axis::Boundary boundary) -> const Table& {
+    const auto mode = is_circle ? ::pyinterp::axis::kWrap : boundary;
+    auto& slot = slots_.at(static_cast<size_t>(mode));
+    const auto* table = slot.load(std::memory_order_acquire);
+    if (table != nullptr && table->margin >= margin) {
+      return *table;
+    }
+    auto lock = std::lock_guard<std::mutex>(mutex_);
+    table = slot.load(std::memory_order_relaxed);
+    if (table == nullptr || table->margin < margin) {
+      // The margin grows geometrically to limit the number of tables built.
+      tables_.emplace_back(std::make_unique<Table>(build(
+          size,
+          table == nullptr ? margin : std::max(margin, 2 * table->margin),
+          mode)));
+      table = tables_.back().get();
+      slot.store(table, std::memory_order_release);
+    }
+    return *table;
+  }
+
+ private:
+  /// Serializes the construction of the tables.
+  std::mutex mutex_{};
+  /// Last table built for each boundary handling mode.
+  std::array<std::atomic<const Table*>, 4> slots_{};
+  /// All the tables built.
+  std::vector<std::unique_ptr<Table>> tables_{};
+
+  /// Builds the table of an axis.
+  static auto build(const int64_t size, const int64_t margin,
+                    const ::pyinterp::axis::Boundary boundary) -> Table {
+    auto result = Table{margin, true,
+                        std::vector<int64_t>(size + 2 * margin)};
+    for (auto ix = -margin; ix < size + margin; ++ix) {
+      auto index = ix;
+      if (ix < 0 || ix >= size) {
+        switch (boundary) {
+          case ::pyinterp::axis::kExpand:
+            index = ix < 0 ? 0 : size - 1;
+            break;
+          case ::pyinterp::axis::kWrap:
+            index = math::remainder(ix, size);
+            break;
+          case ::pyinterp::axis::kSym:
+            index = ix < 0 ? math::remainder(-ix, size)
+                           : size - 2 - math::remainder(ix - size, size);
+            break;
+          default:
+            index = -1;
+        }
+        result.complete &= index >= 0 && index < size;
+      }
+      result.indexes[ix + margin] = index;
+    }
+    return result;
+  }
+};
+
+}  // namespace pyinterp::detail::axis
+
 namespace pyinterp::detail {
 
 /// A coordinate axis is a Variable that specifies one of the coordinates
@@ -147,6 +246,14 @@ class Axis {
     return dynamic_cast<axis::container::Regular<T>*>(axis_.get()) != nullptr;
   }
 
+  /// Get the container of this axis if its values are spaced regularly.
+  ///
+  /// @return the container or nullptr if this axis is not regular
+  [[nodiscard]] inline auto regular_container() const noexcept
+      -> const axis::container::Regular<T>* {
+    return dynamic_cast<const axis::container::Regular<T>*>(axis_.get());
+  }
+
   /// Returns true if this axis represents a circle.
   [[nodiscard]] constexpr auto is_circle() const noexcept -> bool {
     return is_circle_;
@@ -177,7 +284,63 @@ class Axis {
   }
 
   /// Reverse the order of elements in this axis
-  auto flip() -> void { axis_->flip(); }
+  auto flip() -> void {
+    // The irregular containers are shared by the axes holding the same
+    // values: the flipped values are stored in a new container.
+    auto ptr = std::dynamic_pointer_cast<axis::container::Irregular<T>>(axis_);
+    if (ptr != nullptr) {
+      auto flipped = std::make_shared<axis::container::Irregular<T>>(*ptr);
+      flipped->flip();
+      axis_ = axis::intern(std::move(flipped));
+      return;
+    }
+    // The slices are shared by the copies of a view.
+    auto slice = std::dynamic_pointer_cast<axis::container::Slice<T>>(axis_);
+    if (slice != nullptr) {
+      auto flipped = std::make_shared<axis::container::Slice<T>>(*slice);
+      flipped->flip();
+      axis_ = std::move(flipped);
+      return;
+    }
+    axis_->flip();
+  }
+
+  /// Restricts this axis to the elements [start, stop). The values of an
+  /// irregular axis are not copied: the axis becomes a view on the container
+  /// of the original axis, which is kept alive. The axis no longer represents
+  /// a circle if some elements are removed, but the coordinates of an angle
+  /// are still normalized.
+  ///
+  /// @param start index of the first element kept
+  /// @param stop index following the last element kept
+  /// @throw std::invalid_argument if the interval is empty or not included
+  /// in [0, size()).
+  auto narrow(const int64_t start, const int64_t stop) -> void {
+    if (start < 0 || stop > size() || start >= stop) {
+      throw std::invalid_argument(
+          "the interval [" + std::to_string(start) + ", " +
+          std::to_string(stop) + ") is empty or out of range of the axis");
+    }
+    if (start == 0 && stop == size()) {
+      return;
+    }
+    if (auto regular =
+            std::dynamic_pointer_cast<axis::container::Regular<T>>(axis_)) {
+      auto result = std::make_shared<axis::container::Regular<T>>(*regular);
+      result->narrow(start, stop - start);
+      axis_ = std::move(result);
+    } else if (auto slice = std::dynamic_pointer_cast<
+                   axis::container::Slice<T>>(axis_)) {
+      axis_ = std::make_shared<axis::container::Slice<T>>(
+          slice->slice(start, stop - start));
+    } else {
+      axis_ = std::make_shared<axis::container::Slice<T>>(
+          std::dynamic_pointer_cast<axis::container::Irregular<T>>(axis_),
+          start, stop - start);
+    }
+    is_circle_ = false;
+    boundary_tables_ = std::make_shared<axis::BoundaryTables>();
+  }
 
   /// Get increment value if is_regular()
   ///
@@ -196,7 +359,8 @@ class Axis {
   /// @param rhs an other axis to compare
   /// @return if axis are equals
   constexpr auto operator==(Axis const& rhs) const -> bool {
-    return *axis_ == *rhs.axis_ && is_circle_ == rhs.is_circle_;
+    return is_circle_ == rhs.is_circle_ &&
+           (axis_ == rhs.axis_ || *axis_ == *rhs.axis_);
   }
 
   /// compare two variables instances
@@ -283,44 +447,47 @@ class Axis {
   /// the tuple (i0, i1)
   [[nodiscard]] auto find_indexes(T coordinate) const
       -> std::optional<std::tuple<int64_t, int64_t>> {
+    auto scope = profiling::Scope(profiling::kAxisFindIndexes);
     coordinate = normalize_coordinate(coordinate);
-    auto length = size();
-    auto i0 = find_index(coordinate, false);
+    return frame_indexes(coordinate, find_index(coordinate, false));
+  }
 
-    /// If the value is outside the circle, then the value is between the last
-    /// and first index.
-    if (i0 == -1) {
-      return is_circle_ ? std::make_tuple(static_cast<int64_t>(length - 1), 0LL)
-                        : std::optional<std::tuple<int64_t, int64_t>>();
+  /// Given a set of coordinate positions, find grids elements around each of
+  /// them, as find_indexes(T) does.
+  ///
+  /// The search for each coordinate starts from the index found for the
+  /// previous one, which makes it very efficient when the coordinates are
+  /// sorted or almost sorted, as for along-track data.
+  ///
+  /// @param coordinates positions in this coordinate system
+  /// @param i0 indexes i0 found, or -1 if the coordinate is outside the axis
+  /// definition domain.
+  /// @param i1 indexes i1 found, or -1 if the coordinate is outside the axis
+  /// definition domain.
+  /// @throw std::invalid_argument if the sizes of the arrays differ.
+  auto find_indexes(const Eigen::Ref<const Vector<T>>& coordinates,
+                    Eigen::Ref<Vector<int64_t>, 0, Eigen::InnerStride<>> i0,
+                    Eigen::Ref<Vector<int64_t>, 0, Eigen::InnerStride<>> i1)
+      const -> void {
+    if (coordinates.size() != i0.size() || coordinates.size() != i1.size()) {
+      throw std::invalid_argument(
+          "coordinates, i0 and i1 could not be broadcast together");
     }
-
-    // Given the delta between the found coordinate and the given coordinate,
-    // chose the other index that frames the coordinate
-    auto delta = coordinate - (*this)(i0);
-    auto i1 = i0;
-    if (delta == 0) {
-      // The requested coordinate is located on an element of the axis.
-      i1 == length - 1 ? --i0 : ++i1;
-    } else {
-      if (delta < 0) {
-        // The found point is located after the coordinate provided.
-        is_ascending() ? --i0 : ++i0;
-        if (is_circle_) {
-          i0 = math::remainder(i0, length);
-        }
+    auto scope = profiling::Scope(profiling::kAxisFindIndexes);
+    auto hint = int64_t(-1);
+    for (Eigen::Index ix = 0; ix < coordinates.size(); ++ix) {
+      auto coordinate = normalize_coordinate(coordinates[ix]);
+      auto index = axis_->find_index_with_hint(coordinate, false, hint);
+      if (index != -1) {
+        hint = index;
+      }
+      auto indexes = frame_indexes(coordinate, index);
+      if (indexes) {
+        std::tie(i0[ix], i1[ix]) = *indexes;
       } else {
-        // The found point is located before the coordinate provided.
-        is_ascending() ? ++i1 : --i1;
-        if (is_circle_) {
-          i1 = math::remainder(i1, length);
-        }
+        i0[ix] = i1[ix] = -1;
       }
     }
-
-    if (i0 >= 0 && i0 < length && i1 >= 0 && i1 < length) {
-      return std::make_tuple(i0, i1);
-    }
-    return std::optional<std::tuple<int64_t, int64_t>>{};
   }
 
   /// Create a table of "size" indices located on either side of the required
@@ -340,69 +507,47 @@ class Axis {
       throw std::invalid_argument("The size must not be zero.");
     }
 
-    // Axis size
-    auto len = this->size();
-
     // Searches the initial indexes and populate the result
     auto indexes = find_indexes(coordinate);
     if (!indexes) {
       return {};
     }
     auto result = std::vector<int64_t>(size << 1U);
-    std::tie(result[size - 1], result[size]) = *indexes;
-
-    // Offset in relation to the first indexes found
-    uint32_t shift = 1;
-
-    // Construction of window indexes based on the initial indexes found
-    while (shift < size) {
-      int64_t before = std::get<0>(*indexes) - shift;
-      if (before < 0) {
-        if (!is_circle_) {
-          switch (boundary) {
-            case ::pyinterp::axis::kExpand:
-              before = 0;
-              break;
-            case ::pyinterp::axis::kWrap:
-              before = math::remainder(len + before, len);
-              break;
-            case ::pyinterp::axis::kSym:
-              before = math::remainder(-before, len);
-              break;
-            default:
-              return {};
-          }
-        } else {
-          before = math::remainder(before, len);
-        }
-      }
-      int64_t after = std::get<1>(*indexes) + shift;
-      if (after >= len) {
-        if (!is_circle_) {
-          switch (boundary) {
-            case ::pyinterp::axis::kExpand:
-              after = len - 1;
-              break;
-            case ::pyinterp::axis::kWrap:
-              after = math::remainder(after, len);
-              break;
-            case ::pyinterp::axis::kSym:
-              after = len - 2 - math::remainder(after - len, len);
-              break;
-            default:
-              return {};
-          }
-        } else {
-          after = math::remainder(after, len);
-        }
-      }
-      result[size - shift - 1] = before;
-      result[size + shift] = after;
-      ++shift;
+    if (!window_indexes(*indexes, size, boundary, result.data())) {
+      return {};
     }
     return result;
   }
 
+  /// Create a table of "size" indices located on either side of the grid
+  /// elements (i0, i1) framing a position, as returned by find_indexes. The
+  /// table is written into a buffer provided by the caller, which allows
+  /// reusing it between calls.
+  ///
+  /// @param indexes Indexes of the grid elements framing the position.
+  /// @param size Size of the half window to be built.
+  /// @param boundary How to handle boundaries (this parameter is not used if
+  /// the manipulated axis is a circle.)
+  /// @param result Buffer of size "2*size" receiving the indices of the
+  /// window.
+  /// @return false if the window cannot be built with the boundary
+  /// handling requested. In this case, the content of the buffer is undefined.
+  auto window_indexes(const std::tuple<int64_t, int64_t>& indexes,
+                      uint32_t size, ::pyinterp::axis::Boundary boundary,
+                      int64_t* result) const -> bool {
+    // The "size" indexes located before i0, i0 included, and after i1, i1
+    // included, are read from the table of the boundary handling requested.
+    const auto& table =
+        boundary_tables_->get(this->size(), size, is_circle_, boundary);
+    const auto* first = table.indexes.data() + table.margin;
+    const auto* before = first + std::get<0>(indexes) - (size - 1);
+    const auto* after = first + std::get<1>(indexes);
+    std::copy(before, before + size, result);
+    std::copy(after, after + size, result + size);
+    auto* last = result + (size << 1U);
+    return table.complete || std::find(result, last, -1) == last;
+  }
+
   /// Get a string representation of a coordinate handled by this axis.
   ///
   /// @param value Value to be converted to string
@@ -442,6 +587,58 @@ class Axis {
   std::shared_ptr<axis::container::Abstract<T>> axis_{
       std::make_shared<axis::container::Undefined<T>>()};
 
+  /// The tables of the window indexes, which only depend on the size of the
+  /// axis: they are shared by the copies of this axis.
+  std::shared_ptr<axis::BoundaryTables> boundary_tables_{
+      std::make_shared<axis::BoundaryTables>()};
+
+  /// Given the index of the axis element containing a normalized coordinate,
+  /// find the grid elements around it.
+  ///
+  /// @param coordinate normalized position in this coordinate system
+  /// @param i0 index of the element containing the coordinate, or -1.
+  /// @return None if coordinate is outside the axis definition domain otherwise
+  /// the tuple (i0, i1)
+  [[nodiscard]] auto frame_indexes(const T coordinate, int64_t i0) const
+      -> std::optional<std::tuple<int64_t, int64_t>> {
+    auto length = size();
+
+    /// If the value is outside the circle, then the value is between the last
+    /// and first index.
+    if (i0 == -1) {
+      return is_circle_ ? std::make_tuple(static_cast<int64_t>(length - 1), 0LL)
+                        : std::optional<std::tuple<int64_t, int64_t>>();
+    }
+
+    // Given the delta between the found coordinate and the given coordinate,
+    // chose the other index that frames the coordinate
+    auto delta = coordinate - (*this)(i0);
+    auto i1 = i0;
+    if (delta == 0) {
+      // The requested coordinate is located on an element of the axis.
+      i1 == length - 1 ? --i0 : ++i1;
+    } else {
+      if (delta < 0) {
+        // The found point is located after the coordinate provided.
+        is_ascending() ? --i0 : ++i0;
+        if (is_circle_) {
+          i0 = math::remainder(i0, length);
+        }
+      } else {
+        // The found point is located before the coordinate provided.
+        is_ascending() ? ++i1 : --i1;
+        if (is_circle_) {
+          i1 = math::remainder(i1, length);
+        }
+      }
+    }
+
+    if (i0 >= 0 && i0 < length && i1 >= 0 && i1 < length) {
+      return std::make_tuple(i0, i1);
+    }
+    return std::optional<std::tuple<int64_t, int64_t>>{};
+  }
+
   /// Computes axis's properties
   void compute_properties(T epsilon) {
     // An axis can be represented by an empty set of values
@@ -512,9 +709,10 @@ class Axis {
       axis_ = std::make_shared<axis::container::Regular<T>>(
           values[0], values[values.size() - 1], static_cast<T>(values.size()));
     } else {
-      // Avoid data copy if possible.
-      axis_ = std::make_shared<axis::container::Irregular<T>>(
-          move ? std::move(values) : values);
+      // Avoid data copy if possible. The axes holding the same values share
+      // the same container.
+      axis_ = axis::intern(std::make_shared<axis::container::Irregular<T>>(
+          move ? std::move(values) : values));
     }
     compute_properties(epsilon);
   }
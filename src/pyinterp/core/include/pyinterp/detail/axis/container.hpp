@@ -6,8 +6,11 @@
 #include <Eigen/Core>
 #include <algorithm>
 #include <cmath>
+#include <functional>
 #include <limits>
+#include <memory>
 #include <stdexcept>
+#include <utility>
 
 #include "pyinterp/detail/math.hpp"
 #include "pyinterp/eigen.hpp"
@@ -100,6 +103,22 @@ class Abstract {
   [[nodiscard]] virtual auto find_index(T coordinate, bool bounded) const
       -> int64_t = 0;
 
+  /// Search for the index corresponding to the requested value, knowing the
+  /// index found for a nearby value. Containers that need to search for the
+  /// index check first the cells next to the hint, which is efficient when
+  /// the requested values are sorted or almost sorted.
+  ///
+  /// @param coordinate position in this coordinate system
+  /// @param bounded see find_index(T, bool)
+  /// @param hint index found for a previous value, or -1 if unknown.
+  /// @return index of the requested value it or -1 if outside this coordinate
+  /// system area.
+  [[nodiscard]] virtual auto find_index_with_hint(T coordinate, bool bounded,
+                                                  int64_t /* hint */) const
+      -> int64_t {
+    return find_index(coordinate, bounded);
+  }
+
   /// compare two variables instances
   ///
   /// @param rhs A variable to compare
@@ -196,6 +215,10 @@ class Undefined : public Abstract<T> {
   }
 };
 
+/// Forward declaration
+template <typename T>
+class Slice;
+
 /// Represents a container for an irregularly spaced axis
 ///
 /// @tparam T type of data handled by this container
@@ -212,6 +235,8 @@ class Irregular : public Abstract<T> {
     }
     this->is_ascending_ = this->calculate_is_ascending();
     make_edges();
+    make_lookup_table();
+    make_hash();
   }
 
   /// Destructor
@@ -242,6 +267,13 @@ class Irregular : public Abstract<T> {
     std::reverse(points_.data(), points_.data() + points_.size());
     this->is_ascending_ = !this->is_ascending_;
     make_edges();
+    make_lookup_table();
+    make_hash();
+  }
+
+  /// Returns the hash of the values of the axis, computed at construction.
+  [[nodiscard]] constexpr auto hash() const noexcept -> size_t {
+    return hash_;
   }
 
   /// @copydoc Abstract::is_monotonic() const
@@ -292,25 +324,66 @@ class Irregular : public Abstract<T> {
   [[nodiscard]] constexpr auto find_index(const T coordinate,
                                           const bool bounded) const
       -> int64_t override {
+    auto low = int64_t(0);
     auto high = size();
     if (this->is_ascending_) {
-      return this->find_index_ascending(coordinate, bounded, high);
+      return this->find_index_ascending(coordinate, bounded, low, high);
     }
-    return this->find_index_descending(coordinate, bounded, high);
+    return this->find_index_descending(coordinate, bounded, low, high);
+  }
+
+  /// @copydoc Abstract::find_index_with_hint(T,bool,int64_t) const
+  [[nodiscard]] auto find_index_with_hint(const T coordinate,
+                                          const bool bounded,
+                                          const int64_t hint) const
+      -> int64_t override {
+    for (auto index : {hint, hint + 1, hint - 1}) {
+      if (contains(index, coordinate)) {
+        return index;
+      }
+    }
+    return find_index(coordinate, bounded);
   }
 
   /// @copydoc Abstract::operator==(const Abstract&) const
   auto operator==(const Abstract<T>& rhs) const noexcept -> bool override {
     const auto ptr = dynamic_cast<const Irregular<T>*>(&rhs);
-    if (ptr != nullptr) {
+    if (ptr == this) {
+      return true;
+    }
+    if (ptr != nullptr && ptr->hash_ == hash_) {
       return ptr->points_.size() == points_.size() && ptr->points_ == points_;
     }
-    return false;
+    // A slice holding the same values is equal to this container.
+    const auto slice = dynamic_cast<const Slice<T>*>(&rhs);
+    return slice != nullptr && *slice == *this;
   }
 
  private:
+  /// Minimum number of points from which the lookup table is built.
+  static constexpr int64_t kLookupTableMinSize = 32;
+
   Vector<T> points_{};
   Vector<T> edges_{};
+  /// The domain covered by the edges is divided into buckets of equal width.
+  /// This table stores, for each bucket boundary, the index of the cell
+  /// containing it, which restricts the search to a few cells.
+  Vector<int64_t> lookup_{};
+  /// Lower bound of the first bucket.
+  double lookup_origin_{};
+  /// Inverse of the width of the buckets.
+  double lookup_scale_{};
+  /// Hash of the values of the axis.
+  size_t hash_{};
+
+  /// Computes the hash of the values of the axis.
+  void make_hash() {
+    hash_ = std::hash<Eigen::Index>()(points_.size());
+    for (Eigen::Index ix = 0; ix < points_.size(); ++ix) {
+      hash_ ^= std::hash<T>()(points_[ix]) + 0x9e3779b97f4a7c15ULL +
+               (hash_ << 6U) + (hash_ >> 2U);
+    }
+  }
 
   /// Computes the edges, if the axis data are not spaced regularly.
   void make_edges() {
@@ -325,13 +398,91 @@ class Irregular : public Abstract<T> {
     edges_[n] = 2 * points_[n - 1] - edges_[n - 1];
   }
 
+  /// Checks if the cell "index" contains the requested value, i.e. if
+  /// find_index would return this index.
+  [[nodiscard]] constexpr auto contains(const int64_t index,
+                                        const T coordinate) const -> bool {
+    auto n = size();
+    if (index < 0 || index >= n) {
+      return false;
+    }
+    if (this->is_ascending_) {
+      return (index == 0 ? coordinate >= edges_[0]
+                         : edges_[index] <= coordinate) &&
+             (index == n - 1 ? coordinate <= edges_[n]
+                             : edges_[index + 1] > coordinate);
+    }
+    return (index == 0 ? coordinate <= edges_[0]
+                       : edges_[index] >= coordinate) &&
+           (index == n - 1 ? coordinate >= edges_[n]
+                           : edges_[index + 1] < coordinate);
+  }
+
+  /// Builds the lookup table if the axis is large enough.
+  void make_lookup_table() {
+    auto n = size();
+    lookup_.resize(0);
+    if (n < kLookupTableMinSize) {
+      return;
+    }
+    auto first = static_cast<double>(std::min(edges_[0], edges_[n]));
+    auto last = static_cast<double>(std::max(edges_[0], edges_[n]));
+    lookup_origin_ = first;
+    lookup_scale_ = static_cast<double>(n) / (last - first);
+    if (!std::isfinite(lookup_scale_)) {
+      return;
+    }
+
+    // The table is filled by binary search, before being used.
+    auto lookup = Vector<int64_t>(n + 1);
+    for (int64_t ix = 0; ix <= n; ++ix) {
+      auto value =
+          static_cast<T>(first + static_cast<double>(ix) / lookup_scale_);
+      lookup[ix] = this->is_ascending_
+                       ? find_index_ascending(value, true, 0, n)
+                       : find_index_descending(value, true, 0, n);
+    }
+    lookup_ = std::move(lookup);
+  }
+
+  /// Restricts the interval [low, high) of the cells to search for the
+  /// requested value, using the lookup table. The interval is left unchanged
+  /// if the value is not located in the bucket expected.
+  constexpr auto narrow(const T coordinate, int64_t& low, int64_t& high) const
+      -> void {
+    const auto buckets = static_cast<int64_t>(lookup_.size()) - 1;
+    const auto position =
+        (static_cast<double>(coordinate) - lookup_origin_) * lookup_scale_;
+    auto bucket = int64_t(0);
+    if (position >= buckets) {
+      bucket = buckets - 1;
+    } else if (position > 0) {
+      bucket = static_cast<int64_t>(position);
+    }
+    auto first = std::min(lookup_[bucket], lookup_[bucket + 1]);
+    auto last = std::max(lookup_[bucket], lookup_[bucket + 1]);
+
+    // Checks that the value is framed by the cells found: the previous
+    // calculation is subject to rounding errors.
+    auto before = [&](const int64_t index) {
+      return this->is_ascending_ ? edges_[index] <= coordinate
+                                 : edges_[index] >= coordinate;
+    };
+    if ((first > 0 && !before(first)) ||
+        (last < high - 1 && before(last + 1))) {
+      return;
+    }
+    low = first;
+    high = last + 1;
+  }
+
   /// Search for the index corresponding to the requested value if the axis is
   /// sorted in ascending order.
   [[nodiscard]] constexpr auto find_index_ascending(const T coordinate,
                                                     const bool bounded,
+                                                    int64_t low,
                                                     int64_t high) const
       -> int64_t {
-    int64_t low = 0;
     int64_t mid = 0;
 
     if (coordinate < edges_[0]) {
@@ -342,6 +493,10 @@ class Irregular : public Abstract<T> {
       return bounded ? high - 1 : -1;
     }
 
+    if (lookup_.size() != 0) {
+      narrow(coordinate, low, high);
+    }
+
     while (high > low + 1) {
       // low and high are strictly positive
       mid = (low + high) >> 1;  // NOLINT
@@ -359,9 +514,9 @@ class Irregular : public Abstract<T> {
   /// sorted in descending order.
   [[nodiscard]] constexpr auto find_index_descending(const T coordinate,
                                                      const bool bounded,
+                                                     int64_t low,
                                                      int64_t high) const
       -> int64_t {
-    int64_t low = 0;
     int64_t mid = 0;
 
     if (coordinate < edges_[this->edges_.size() - 1]) {
@@ -372,6 +527,10 @@ class Irregular : public Abstract<T> {
       return bounded ? 0 : -1;
     }
 
+    if (lookup_.size() != 0) {
+      narrow(coordinate, low, high);
+    }
+
     while (high > low + 1) {
       // low and high are strictly positive
       mid = (low + high) >> 1;  // NOLINT
@@ -386,6 +545,207 @@ class Irregular : public Abstract<T> {
   }
 };
 
+/// Represents a contiguous part of an irregularly spaced axis. The values are
+/// read from the container of the parent axis, which is kept alive: creating
+/// a slice does not copy them.
+///
+/// @tparam T type of data handled by this container
+template <typename T>
+class Slice : public Abstract<T> {
+ public:
+  /// Creation of a slice of an irregular container.
+  ///
+  /// @param parent the container holding the values
+  /// @param offset index, in the parent container, of the first value
+  /// @param size number of values of the slice
+  Slice(std::shared_ptr<const Irregular<T>> parent, const int64_t offset,
+        const int64_t size)
+      : parent_(std::move(parent)), offset_(offset), size_(size) {
+    if (size_ <= 0 || offset_ < 0 || offset_ + size_ > parent_->size()) {
+      throw std::invalid_argument("slice out of range of the container.");
+    }
+    this->is_ascending_ = parent_->is_ascending();
+    make_edges();
+  }
+
+  /// Destructor
+  ~Slice() override = default;
+
+  /// Copy constructor
+  ///
+  /// @param rhs right value
+  Slice(const Slice& rhs) = default;
+
+  /// Move constructor
+  ///
+  /// @param rhs right value
+  Slice(Slice&& rhs) noexcept = default;
+
+  /// Copy assignment operator
+  ///
+  /// @param rhs right value
+  auto operator=(const Slice& rhs) -> Slice& = default;
+
+  /// Move assignment operator
+  ///
+  /// @param rhs right value
+  auto operator=(Slice&& rhs) noexcept -> Slice& = default;
+
+  /// Returns a slice of this slice, reading the values from the same parent.
+  ///
+  /// @param offset index, in this slice, of the first value
+  /// @param size number of values of the new slice
+  [[nodiscard]] auto slice(const int64_t offset, const int64_t size) const
+      -> Slice {
+    if (size <= 0 || offset < 0 || offset + size > size_) {
+      throw std::invalid_argument("slice out of range of the container.");
+    }
+    auto result =
+        Slice(parent_,
+              reversed_ ? offset_ + size_ - offset - size : offset_ + offset,
+              size);
+    if (reversed_) {
+      result.flip();
+    }
+    return result;
+  }
+
+  /// @copydoc Abstract::flip()
+  auto flip() -> void override {
+    reversed_ = !reversed_;
+    this->is_ascending_ = !this->is_ascending_;
+  }
+
+  /// @copydoc Abstract::coordinate_value(const int64_t) const
+  [[nodiscard]] constexpr auto coordinate_value(const int64_t index) const
+      -> T override {
+    return parent_->coordinate_value(to_parent(index));
+  }
+
+  /// @copydoc Abstract::min_value() const
+  [[nodiscard]] constexpr auto min_value() const -> T override {
+    return this->is_ascending_ ? front() : back();
+  }
+
+  /// @copydoc Abstract::max_value() const
+  [[nodiscard]] constexpr auto max_value() const -> T override {
+    return this->is_ascending_ ? back() : front();
+  }
+
+  /// @copydoc Abstract::size() const
+  [[nodiscard]] constexpr auto size() const noexcept -> int64_t override {
+    return size_;
+  }
+
+  /// @copydoc Abstract::front() const
+  [[nodiscard]] constexpr auto front() const -> T override {
+    return coordinate_value(0);
+  }
+
+  /// @copydoc Abstract::back() const
+  [[nodiscard]] constexpr auto back() const -> T override {
+    return coordinate_value(size_ - 1);
+  }
+
+  /// @copydoc Abstract::find_index(double,bool) const
+  [[nodiscard]] auto find_index(const T coordinate, const bool bounded) const
+      -> int64_t override {
+    return find_index_with_hint(coordinate, bounded, -1);
+  }
+
+  /// @copydoc Abstract::find_index_with_hint(T,bool,int64_t) const
+  [[nodiscard]] auto find_index_with_hint(const T coordinate,
+                                          const bool bounded,
+                                          const int64_t hint) const
+      -> int64_t override {
+    // The cells of the slice are those of the parent, except the first and
+    // the last ones, whose outer edges are those of a standalone axis.
+    const auto ascending = parent_->is_ascending();
+    if (ascending ? coordinate < front_edge_ : coordinate > front_edge_) {
+      return bounded ? to_slice(offset_) : -1;
+    }
+    if (ascending ? coordinate > back_edge_ : coordinate < back_edge_) {
+      return bounded ? to_slice(offset_ + size_ - 1) : -1;
+    }
+    auto index = parent_->find_index_with_hint(
+        coordinate, true, hint == -1 ? -1 : to_parent(hint));
+    return to_slice(std::clamp(index, offset_, offset_ + size_ - 1));
+  }
+
+  /// @copydoc Abstract::operator==(const Abstract&) const
+  auto operator==(const Abstract<T>& rhs) const noexcept -> bool override {
+    if (dynamic_cast<const Slice<T>*>(&rhs) == nullptr &&
+        dynamic_cast<const Irregular<T>*>(&rhs) == nullptr) {
+      return false;
+    }
+    if (rhs.size() != size_) {
+      return false;
+    }
+    for (int64_t ix = 0; ix < size_; ++ix) {
+      if (rhs.coordinate_value(ix) != coordinate_value(ix)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+ private:
+  /// The container holding the values.
+  std::shared_ptr<const Irregular<T>> parent_;
+  /// Index, in the parent container, of the first value of the slice.
+  int64_t offset_;
+  /// Number of values of the slice.
+  int64_t size_;
+  /// True if the values are read in the reverse order of the parent.
+  bool reversed_{false};
+  /// Outer edges of the first and last values of the slice, in the order of
+  /// the parent container.
+  T front_edge_{};
+  T back_edge_{};
+
+  /// Converts an index of this slice into an index of the parent container.
+  [[nodiscard]] constexpr auto to_parent(const int64_t index) const noexcept
+      -> int64_t {
+    return offset_ + (reversed_ ? size_ - 1 - index : index);
+  }
+
+  /// Converts an index of the parent container into an index of this slice.
+  [[nodiscard]] constexpr auto to_slice(const int64_t index) const noexcept
+      -> int64_t {
+    return reversed_ ? offset_ + size_ - 1 - index : index - offset_;
+  }
+
+  /// Computes the outer edges of the slice as Irregular::make_edges does. The
+  /// cell of a slice holding a single value is as wide as the nearest cell of
+  /// the parent.
+  void make_edges() {
+    const auto& parent = *parent_;
+    const auto first = offset_;
+    const auto last = offset_ + size_ - 1;
+    if (size_ == 1) {
+      auto half = T(0);
+      if (parent.size() > 1) {
+        const auto neighbor = first + 1 < parent.size() ? first + 1 : first - 1;
+        half = std::abs(parent.coordinate_value(neighbor) -
+                        parent.coordinate_value(first)) /
+               2;
+      }
+      const auto value = parent.coordinate_value(first);
+      front_edge_ = parent.is_ascending() ? value - half : value + half;
+      back_edge_ = parent.is_ascending() ? value + half : value - half;
+      return;
+    }
+    front_edge_ = 2 * parent.coordinate_value(first) -
+                  (parent.coordinate_value(first) +
+                   parent.coordinate_value(first + 1)) /
+                      2;
+    back_edge_ = 2 * parent.coordinate_value(last) -
+                 (parent.coordinate_value(last - 1) +
+                  parent.coordinate_value(last)) /
+                     2;
+  }
+};
+
 /// Represents a container for an regularly spaced axis
 ///
 /// @tparam T type of data handled by this container
@@ -437,6 +797,19 @@ class AbstractRegular : public Abstract<T> {
   /// @return increment value
   [[nodiscard]] auto constexpr step() const -> T { return step_; }
 
+  /// Restricts the container to a contiguous part of its values. The step
+  /// is kept as is, and not recomputed from the bounds of the new interval.
+  ///
+  /// @param offset index of the first value kept
+  /// @param size number of values kept
+  auto narrow(const int64_t offset, const int64_t size) -> void {
+    if (size <= 0 || offset < 0 || offset + size > size_) {
+      throw std::invalid_argument("slice out of range of the container.");
+    }
+    start_ = coordinate_value(offset);
+    size_ = size;
+  }
+
   /// @copydoc Abstract::flip()
   auto flip() -> void override {
     start_ = back();
@@ -446,7 +819,7 @@ class AbstractRegular : public Abstract<T> {
 
   /// @copydoc Abstract::coordinate_value(const int64_t) const
   [[nodiscard]] constexpr auto coordinate_value(
-      const int64_t index) const noexcept -> T override {
+      const int64_t index) const noexcept -> T final {
     return static_cast<T>(start_ + index * step_);
   }
 
@@ -531,6 +904,41 @@ class Regular<T, typename std::enable_if<std::is_floating_point_v<T>>::type>
     return index;
   }
 
+  /// Search, for a batch of coordinates, the index of the first element of
+  /// the cell containing each coordinate, i.e. the index i such that
+  /// @code
+  /// coordinate_value(i) <= coordinate < coordinate_value(i + 1)
+  /// @endcode
+  /// The last element of the container is considered to belong to the last
+  /// cell. The container must be sorted in ascending order.
+  ///
+  /// The indexes are calculated without any branching, which allows the
+  /// compiler to vectorize this loop.
+  ///
+  /// @param coordinates positions in this coordinate system
+  /// @param cells indexes found, or -1 if the coordinate is not framed by two
+  /// elements of this container.
+  /// @param size number of coordinates to process
+  auto find_cells(const T* coordinates, int64_t* cells,
+                  const size_t size) const noexcept -> void {
+    const auto last = this->size_ - 1;
+    const auto upper = static_cast<T>(this->size_);
+    for (size_t ix = 0; ix < size; ++ix) {
+      const auto coordinate = coordinates[ix];
+      const auto position = (coordinate - this->start_) * inv_step_;
+      // The undefined coordinates and those far outside the container are
+      // not converted to an integer, which would be undefined behavior.
+      const auto inside = position > T(-1) && position < upper;
+      auto index = static_cast<int64_t>(std::round(inside ? position : T(0)));
+      const auto delta =
+          coordinate - static_cast<T>(this->start_ + index * this->step_);
+      // The element found is located after the coordinate, or is the last
+      // element of the container: the cell starts at the previous element.
+      index -= static_cast<int64_t>(delta < 0 || (delta == 0 && index == last));
+      cells[ix] = (inside && index >= 0 && index < last) ? index : -1;
+    }
+  }
+
   /// @copydoc Abstract::flip()
   auto flip() -> void override {
     AbstractRegular<T>::flip();
@@ -0,0 +1,107 @@
+// Copyright (c) 2022 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+#pragma once
+#include <algorithm>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#include "pyinterp/detail/axis/container.hpp"
+
+namespace pyinterp::detail::axis {
+
+/// Process-wide table of the irregular containers in use, indexed by the hash
+/// of their values. The axes built from the same values share the same
+/// container, which saves memory and makes their comparison immediate. The
+/// table does not own the containers: an entry expires when the last axis
+/// using it is destroyed.
+///
+/// The containers shared are never modified: an axis that must be modified
+/// builds its own copy.
+///
+/// @tparam T type of data handled by the containers
+template <typename T>
+class InternTable {
+ public:
+  /// Type of the containers handled by this table.
+  using container_t = container::Irregular<T>;
+
+  /// Returns the table shared by the whole process.
+  static auto instance() -> InternTable& {
+    static auto table = InternTable();
+    return table;
+  }
+
+  /// Returns the container, already known, holding the same values as the
+  /// given one, or registers the given container if the table does not hold
+  /// such a container yet.
+  ///
+  /// @param item The container to intern.
+  /// @return The container shared by the axes holding these values.
+  auto intern(std::shared_ptr<container_t> item)
+      -> std::shared_ptr<container_t> {
+    auto lock = std::lock_guard<std::mutex>(mutex_);
+    auto range = items_.equal_range(item->hash());
+    for (auto it = range.first; it != range.second;) {
+      auto other = it->second.lock();
+      if (!other) {
+        it = items_.erase(it);
+        continue;
+      }
+      if (*other == *item) {
+        return other;
+      }
+      ++it;
+    }
+    if (items_.size() >= purge_size_) {
+      purge();
+    }
+    items_.emplace(item->hash(), item);
+    return item;
+  }
+
+  /// Returns the number of containers alive held by the table.
+  [[nodiscard]] auto size() -> size_t {
+    auto lock = std::lock_guard<std::mutex>(mutex_);
+    purge();
+    return items_.size();
+  }
+
+ private:
+  /// Minimum number of entries from which the expired entries are removed.
+  static constexpr size_t kMinPurgeSize = 64;
+
+  /// Protects the table against concurrent accesses.
+  std::mutex mutex_{};
+  /// The containers registered, indexed by their hash.
+  std::unordered_multimap<size_t, std::weak_ptr<container_t>> items_{};
+  /// Number of entries from which the next purge is done.
+  size_t purge_size_{kMinPurgeSize};
+
+  InternTable() = default;
+
+  /// Removes the expired entries. The next purge is done once the number of
+  /// entries alive has doubled, so that the cost of the purges stays
+  /// proportional to the number of insertions.
+  void purge() {
+    for (auto it = items_.begin(); it != items_.end();) {
+      it = it->second.expired() ? items_.erase(it) : std::next(it);
+    }
+    purge_size_ = std::max(kMinPurgeSize, 2 * items_.size());
+  }
+};
+
+/// Returns the container shared by the axes holding the same values as the
+/// given one.
+///
+/// @param item The container to intern.
+template <typename T>
+inline auto intern(std::shared_ptr<container::Irregular<T>> item)
+    -> std::shared_ptr<container::Irregular<T>> {
+  return InternTable<T>::instance().intern(std::move(item));
+}
+
+}  // namespace pyinterp::detail::axis
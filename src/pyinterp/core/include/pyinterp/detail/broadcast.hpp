@@ -131,7 +131,7 @@ void check_array_ndim(const std::string& name, const int64_t ndim,
 /// different from the expected one.
 template <typename Array, typename... Args>
 void check_array_ndim(const std::string& name, const int64_t ndim,
-                      const Array& a, Args... args) {
+                      const Array& a, const Args&... args) {
   static_assert(sizeof...(Args) % 3 == 0,
                 "number of parameters is expected to be a multiple of 3");
   check_array_ndim(name, ndim, a);
@@ -175,7 +175,7 @@ void check_ndarray_shape(const std::string& name1, const Array1& a1,
 template <typename Array1, typename Array2, typename... Args>
 void check_ndarray_shape(const std::string& name1, const Array1& a1,
                          const std::string& name2, const Array2& a2,
-                         Args... args) {
+                         const Args&... args) {
   static_assert(sizeof...(Args) % 2 == 0,
                 "an even number of parameters is expected");
   check_ndarray_shape(name1, a1, name2, a2);
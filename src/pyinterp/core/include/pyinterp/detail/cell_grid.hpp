@@ -0,0 +1,189 @@
+// Copyright (c) 2022 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "pyinterp/detail/first_touch.hpp"
+
+namespace pyinterp::detail {
+
+/// Grid of statistics, stored densely or sparsely.
+///
+/// A dense grid allocates all its cells. A sparse grid only stores the cells
+/// used, in a hash table keyed by the index of the cell: a grid of fine
+/// resolution covering the globe, whose cells are mostly empty, then only
+/// costs the memory of the cells holding values. The cells not stored are
+/// copies of the empty cell given to the constructor.
+///
+/// The cells are indexed in column-major order, as the elements of an Eigen
+/// matrix. The cells of a dense grid are initialized in parallel, so that its
+/// memory is spread over the NUMA nodes of the threads updating it.
+///
+/// @tparam Cell Statistics stored in each cell.
+template <typename Cell>
+class CellGrid {
+ public:
+  /// Default constructor
+  ///
+  /// @param rows Number of rows of the grid.
+  /// @param cols Number of columns of the grid.
+  /// @param sparse True if only the cells used are stored.
+  /// @param empty Value of the cells not yet used.
+  CellGrid(const int64_t rows, const int64_t cols, const bool sparse,
+           Cell empty = Cell())
+      : rows_(rows), cols_(cols), sparse_(sparse), empty_(std::move(empty)) {
+    if (!sparse_) {
+      dense_ = FirstTouchArray<Cell>(static_cast<size_t>(rows_ * cols_),
+                                     empty_);
+    }
+  }
+
+  /// Gets the number of rows of the grid.
+  [[nodiscard]] constexpr auto rows() const noexcept -> int64_t {
+    return rows_;
+  }
+
+  /// Gets the number of columns of the grid.
+  [[nodiscard]] constexpr auto cols() const noexcept -> int64_t {
+    return cols_;
+  }
+
+  /// Gets the number of cells of the grid.
+  [[nodiscard]] constexpr auto size() const noexcept -> int64_t {
+    return rows_ * cols_;
+  }
+
+  /// Returns true if only the cells used are stored.
+  [[nodiscard]] constexpr auto sparse() const noexcept -> bool {
+    return sparse_;
+  }
+
+  /// Gets the value of the cells not yet used.
+  [[nodiscard]] constexpr auto empty() const noexcept -> const Cell& {
+    return empty_;
+  }
+
+  /// Gets the index of the cell (ix, iy).
+  [[nodiscard]] constexpr auto index(const int64_t ix,
+                                     const int64_t iy) const noexcept
+      -> uint64_t {
+    return static_cast<uint64_t>(ix + iy * rows_);
+  }
+
+  /// Gets the cell of the given index, stored first if needed.
+  inline auto operator[](const uint64_t index) -> Cell& {
+    if (!sparse_) {
+      return dense_[index];
+    }
+    auto it = sparse_cells_.find(index);
+    if (it == sparse_cells_.end()) {
+      it = sparse_cells_.emplace(index, empty_).first;
+    }
+    return it->second;
+  }
+
+  /// Gets the cell (ix, iy), stored first if needed.
+  inline auto operator()(const int64_t ix, const int64_t iy) -> Cell& {
+    return (*this)[index(ix, iy)];
+  }
+
+  /// Gets the cell of the given index, or a null pointer if it is not
+  /// stored. Unlike operator[], the grid is not modified: the cells of a
+  /// sparse grid can be searched by several threads.
+  [[nodiscard]] inline auto find(const uint64_t index) -> Cell* {
+    if (!sparse_) {
+      return &dense_[index];
+    }
+    auto it = sparse_cells_.find(index);
+    return it == sparse_cells_.end() ? nullptr : &it->second;
+  }
+
+  /// Gets the cell of the given index, or the empty cell if it is not
+  /// stored.
+  [[nodiscard]] inline auto operator[](const uint64_t index) const
+      -> const Cell& {
+    if (!sparse_) {
+      return dense_[index];
+    }
+    auto it = sparse_cells_.find(index);
+    return it == sparse_cells_.end() ? empty_ : it->second;
+  }
+
+  /// Gets the cell (ix, iy), or the empty cell if it is not stored.
+  [[nodiscard]] inline auto operator()(const int64_t ix,
+                                       const int64_t iy) const -> const Cell& {
+    return (*this)[index(ix, iy)];
+  }
+
+  /// Calls function(index, cell) for each cell stored, in no particular
+  /// order.
+  template <typename Function>
+  auto for_each(const Function& function) -> void {
+    if (!sparse_) {
+      for (size_t ix = 0; ix < dense_.size(); ++ix) {
+        function(static_cast<uint64_t>(ix), dense_[ix]);
+      }
+      return;
+    }
+    for (auto& item : sparse_cells_) {
+      function(item.first, item.second);
+    }
+  }
+
+  /// Calls function(index, cell) for each cell stored, in no particular
+  /// order.
+  template <typename Function>
+  auto for_each(const Function& function) const -> void {
+    if (!sparse_) {
+      for (size_t ix = 0; ix < dense_.size(); ++ix) {
+        function(static_cast<uint64_t>(ix), dense_[ix]);
+      }
+      return;
+    }
+    for (const auto& item : sparse_cells_) {
+      function(item.first, item.second);
+    }
+  }
+
+  /// Gets the indexes, in increasing order, of the cells stored satisfying
+  /// the given predicate.
+  template <typename Predicate>
+  [[nodiscard]] auto indexes(const Predicate& predicate) const
+      -> std::vector<uint64_t> {
+    auto result = std::vector<uint64_t>();
+    for_each([&](const uint64_t index, const Cell& cell) {
+      if (predicate(cell)) {
+        result.push_back(index);
+      }
+    });
+    if (sparse_) {
+      std::sort(result.begin(), result.end());
+    }
+    return result;
+  }
+
+  /// Resets all the cells to the empty value.
+  auto clear() -> void {
+    if (!sparse_) {
+      dense_.fill(empty_);
+      return;
+    }
+    sparse_cells_.clear();
+  }
+
+ private:
+  int64_t rows_;
+  int64_t cols_;
+  bool sparse_;
+  Cell empty_;
+  FirstTouchArray<Cell> dense_{};
+  std::unordered_map<uint64_t, Cell> sparse_cells_{};
+};
+
+}  // namespace pyinterp::detail
@@ -0,0 +1,168 @@
+// Copyright (c) 2022 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "pyinterp/detail/thread.hpp"
+
+namespace pyinterp::detail {
+
+/// Fixed-size array whose items are constructed in parallel.
+///
+/// The operating system maps a page of memory to the NUMA node of the thread
+/// that first writes it. A std::vector constructs its items from the calling
+/// thread, which places the whole array on a single node; the threads running
+/// on the other nodes then access remote memory. The items of this array are
+/// constructed by the threads of the pool, in contiguous parts, so that its
+/// pages are spread over the nodes of the CPUs used by the parallel
+/// algorithms.
+///
+/// @tparam T Type of the items stored.
+template <typename T>
+class FirstTouchArray {
+ public:
+  /// Arrays smaller than this size, in bytes, are constructed by the calling
+  /// thread: they fit in a few pages and the cost of the dispatch would
+  /// exceed the gain.
+  static constexpr size_t kMinParallelBytes = 1U << 20U;
+
+  /// Default constructor
+  FirstTouchArray() = default;
+
+  /// Creates an array of "size" copies of "value".
+  FirstTouchArray(const size_t size, const T& value) {
+    construct(size, [&value](T* first, T* last, size_t /*offset*/) {
+      std::uninitialized_fill(first, last, value);
+    });
+  }
+
+  /// Copy constructor
+  FirstTouchArray(const FirstTouchArray& rhs) {
+    construct(rhs.size_, [&rhs](T* first, T* last, const size_t offset) {
+      std::uninitialized_copy(rhs.data_ + offset,
+                              rhs.data_ + offset + (last - first), first);
+    });
+  }
+
+  /// Move constructor
+  FirstTouchArray(FirstTouchArray&& rhs) noexcept
+      : data_(std::exchange(rhs.data_, nullptr)),
+        size_(std::exchange(rhs.size_, 0)) {}
+
+  /// Copy assignment operator
+  auto operator=(const FirstTouchArray& rhs) -> FirstTouchArray& {
+    if (this != &rhs) {
+      *this = FirstTouchArray(rhs);
+    }
+    return *this;
+  }
+
+  /// Move assignment operator
+  auto operator=(FirstTouchArray&& rhs) noexcept -> FirstTouchArray& {
+    if (this != &rhs) {
+      release();
+      data_ = std::exchange(rhs.data_, nullptr);
+      size_ = std::exchange(rhs.size_, 0);
+    }
+    return *this;
+  }
+
+  /// Destructor
+  ~FirstTouchArray() { release(); }
+
+  /// Gets the number of items.
+  [[nodiscard]] constexpr auto size() const noexcept -> size_t {
+    return size_;
+  }
+
+  /// Gets the item at the given index.
+  constexpr auto operator[](const size_t index) noexcept -> T& {
+    return data_[index];
+  }
+
+  /// Gets the item at the given index.
+  constexpr auto operator[](const size_t index) const noexcept -> const T& {
+    return data_[index];
+  }
+
+  /// Gets an iterator to the first item.
+  constexpr auto begin() noexcept -> T* { return data_; }
+
+  /// Gets an iterator past the last item.
+  constexpr auto end() noexcept -> T* { return data_ + size_; }
+
+  /// Assigns the value to all the items, using the same partition of the
+  /// array between threads as the construction.
+  auto fill(const T& value) -> void {
+    for_each_part([&value](T* first, T* last, size_t /*offset*/) {
+      std::fill(first, last, value);
+    });
+  }
+
+ private:
+  T* data_{nullptr};
+  size_t size_{0};
+
+  /// Calls function(first, last, offset) for the parts of the array,
+  /// processed in parallel if the array is large.
+  template <typename Function>
+  auto for_each_part(const Function& function) -> void {
+    if (size_ * sizeof(T) < kMinParallelBytes) {
+      function(data_, data_ + size_, 0);
+      return;
+    }
+    dispatch(
+        [&](const size_t start, const size_t end) {
+          function(data_ + start, data_ + end, start);
+        },
+        size_, 0);
+  }
+
+  /// Allocates the array, without touching its memory, then constructs its
+  /// items with function(first, last, offset). If the construction of a part
+  /// fails, the parts already constructed are destroyed.
+  template <typename Function>
+  auto construct(const size_t size, const Function& function) -> void {
+    if (size == 0) {
+      return;
+    }
+    data_ = std::allocator<T>().allocate(size);
+    size_ = size;
+    auto mutex = std::mutex();
+    auto done = std::vector<std::pair<T*, T*>>();
+    try {
+      for_each_part([&](T* first, T* last, const size_t offset) {
+        function(first, last, offset);
+        auto lock = std::unique_lock<std::mutex>(mutex);
+        done.emplace_back(first, last);
+      });
+    } catch (...) {
+      for (const auto& item : done) {
+        std::destroy(item.first, item.second);
+      }
+      std::allocator<T>().deallocate(data_, size_);
+      data_ = nullptr;
+      size_ = 0;
+      throw;
+    }
+  }
+
+  /// Destroys the items and frees the memory.
+  auto release() noexcept -> void {
+    if (data_ != nullptr) {
+      std::destroy(data_, data_ + size_);
+      std::allocator<T>().deallocate(data_, size_);
+      data_ = nullptr;
+      size_ = 0;
+    }
+  }
+};
+
+}  // namespace pyinterp::detail
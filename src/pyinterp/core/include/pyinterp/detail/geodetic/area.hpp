@@ -0,0 +1,75 @@
+// Copyright (c) 2022 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+#pragma once
+#include <cmath>
+
+#include "pyinterp/detail/geodetic/system.hpp"
+#include "pyinterp/detail/math.hpp"
+
+namespace pyinterp::detail::geodetic {
+
+/// Computes the function q defining the authalic latitude of a spheroid:
+///
+///   q(φ) = (1 - e²) [sin φ / (1 - e² sin² φ) + tanh⁻¹(e sin φ) / e]
+///
+/// The area between the equator and the parallel φ, per radian of longitude,
+/// is a²q(φ)/2.
+///
+/// @param lat Latitude in degrees.
+/// @param e First eccentricity of the spheroid.
+template <typename T>
+inline auto authalic_q(const T& lat, const T& e) -> T {
+  const auto sin_phi = math::sind(lat);
+  if (e == 0) {
+    return 2 * sin_phi;
+  }
+  const auto e_sin_phi = e * sin_phi;
+  return (1 - e * e) * (sin_phi / (1 - e_sin_phi * e_sin_phi) +
+                        std::atanh(e_sin_phi) / e);
+}
+
+/// Area of the regions of a spheroid bounded by two meridians and two
+/// parallels.
+///
+/// The area between the parallels \f$\varphi_1\f$ and \f$\varphi_2\f$ over a
+/// longitude span \f$\Delta\lambda\f$ is
+/// \f$\Delta\lambda\frac{a^2}{2}\left[q(\varphi_2)-q(\varphi_1)\right]\f$
+/// (see authalic_q).
+class RectangleArea {
+ public:
+  /// Default constructor
+  ///
+  /// @param system The geodetic system of the spheroid.
+  explicit RectangleArea(const System& system)
+      : e_(std::sqrt(system.first_eccentricity_squared())),
+        scale_(math::sqr(system.semi_major_axis()) * 0.5) {}
+
+  /// Returns the area, per radian of longitude, between the equator and a
+  /// parallel.
+  ///
+  /// @param lat Latitude of the parallel, in degrees.
+  [[nodiscard]] inline auto primitive(const double lat) const -> double {
+    return scale_ * authalic_q(lat, e_);
+  }
+
+  /// Returns the area, in square meters, of a region.
+  ///
+  /// @param lat_min Southern latitude of the region, in degrees.
+  /// @param lat_max Northern latitude of the region, in degrees.
+  /// @param lon_span Longitude span of the region, in degrees.
+  [[nodiscard]] inline auto operator()(const double lat_min,
+                                       const double lat_max,
+                                       const double lon_span) const -> double {
+    return math::radians(lon_span) * (primitive(lat_max) - primitive(lat_min));
+  }
+
+ private:
+  /// First eccentricity.
+  double e_;
+  /// Half of the square of the semi-major axis.
+  double scale_;
+};
+
+}  // namespace pyinterp::detail::geodetic
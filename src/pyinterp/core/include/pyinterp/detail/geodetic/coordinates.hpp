@@ -3,11 +3,14 @@
 // All rights reserved. Use of this source code is governed by a
 // BSD-style license that can be found in the LICENSE file.
 #pragma once
+#include <Eigen/Core>
+#include <algorithm>
 #include <optional>
 
 #include "pyinterp/detail/geodetic/system.hpp"
 #include "pyinterp/detail/geometry/point.hpp"
 #include "pyinterp/detail/math.hpp"
+#include "pyinterp/eigen.hpp"
 
 namespace pyinterp::detail::geodetic {
 
@@ -131,7 +134,139 @@ class Coordinates {
     return target.ecef_to_lla(lla_to_ecef(lla));
   }
 
+  /// Converts a set of Cartesian coordinates, stored as one vector per
+  /// component, to geographic longitudes, latitudes and altitudes.
+  ///
+  /// The points are processed by blocks of kBlockSize elements, using
+  /// coefficient-wise expressions that Eigen vectorizes.
+  template <typename T>
+  void ecef_to_lla(const Eigen::Ref<const Vector<T>>& x,
+                   const Eigen::Ref<const Vector<T>>& y,
+                   const Eigen::Ref<const Vector<T>>& z,
+                   Eigen::Ref<Vector<T>> lon, Eigen::Ref<Vector<T>> lat,
+                   Eigen::Ref<Vector<T>> alt) const {
+    Block bx, by, bz, blon, blat, balt;
+    for (Eigen::Index ix = 0; ix < x.size(); ix += kBlockSize) {
+      const auto n = std::min(kBlockSize, x.size() - ix);
+      bx = x.segment(ix, n).template cast<double>().array();
+      by = y.segment(ix, n).template cast<double>().array();
+      bz = z.segment(ix, n).template cast<double>().array();
+      ecef_to_lla(bx, by, bz, blon, blat, balt);
+      lon.segment(ix, n) = blon.template cast<T>().matrix();
+      lat.segment(ix, n) = blat.template cast<T>().matrix();
+      alt.segment(ix, n) = balt.template cast<T>().matrix();
+    }
+  }
+
+  /// Converts a set of geographic coordinates, stored as one vector per
+  /// component, to Cartesian coordinates.
+  template <typename T>
+  void lla_to_ecef(const Eigen::Ref<const Vector<T>>& lon,
+                   const Eigen::Ref<const Vector<T>>& lat,
+                   const Eigen::Ref<const Vector<T>>& alt,
+                   Eigen::Ref<Vector<T>> x, Eigen::Ref<Vector<T>> y,
+                   Eigen::Ref<Vector<T>> z) const {
+    Block blon, blat, balt, bx, by, bz;
+    for (Eigen::Index ix = 0; ix < lon.size(); ix += kBlockSize) {
+      const auto n = std::min(kBlockSize, lon.size() - ix);
+      blon = lon.segment(ix, n).template cast<double>().array();
+      blat = lat.segment(ix, n).template cast<double>().array();
+      balt = alt.segment(ix, n).template cast<double>().array();
+      lla_to_ecef(blon, blat, balt, bx, by, bz);
+      x.segment(ix, n) = bx.template cast<T>().matrix();
+      y.segment(ix, n) = by.template cast<T>().matrix();
+      z.segment(ix, n) = bz.template cast<T>().matrix();
+    }
+  }
+
+  /// Transform a set of points between two coordinate systems defined by the
+  /// Coordinates instances this and target. Each block of points is converted
+  /// to Cartesian coordinates and back in a single pass, the intermediate
+  /// coordinates never leave the cache.
+  template <typename T>
+  void transform(const Coordinates& target,
+                 const Eigen::Ref<const Vector<T>>& lon1,
+                 const Eigen::Ref<const Vector<T>>& lat1,
+                 const Eigen::Ref<const Vector<T>>& alt1,
+                 Eigen::Ref<Vector<T>> lon2, Eigen::Ref<Vector<T>> lat2,
+                 Eigen::Ref<Vector<T>> alt2) const {
+    Block blon, blat, balt, bx, by, bz;
+    for (Eigen::Index ix = 0; ix < lon1.size(); ix += kBlockSize) {
+      const auto n = std::min(kBlockSize, lon1.size() - ix);
+      blon = lon1.segment(ix, n).template cast<double>().array();
+      blat = lat1.segment(ix, n).template cast<double>().array();
+      balt = alt1.segment(ix, n).template cast<double>().array();
+      lla_to_ecef(blon, blat, balt, bx, by, bz);
+      target.ecef_to_lla(bx, by, bz, blon, blat, balt);
+      lon2.segment(ix, n) = blon.template cast<T>().matrix();
+      lat2.segment(ix, n) = blat.template cast<T>().matrix();
+      alt2.segment(ix, n) = balt.template cast<T>().matrix();
+    }
+  }
+
  private:
+  /// Number of points converted together by the batch conversions.
+  static constexpr Eigen::Index kBlockSize = 256;
+
+  /// Buffer holding one component of a block of points. Its storage is
+  /// allocated on the stack.
+  using Block = Eigen::Array<double, Eigen::Dynamic, 1, Eigen::ColMajor,
+                             kBlockSize, 1>;
+
+  /// Batch version of the scalar ecef_to_lla. Both estimates of the
+  /// latitude of the scalar version are computed and the most accurate one
+  /// is selected for each point, so the block is processed without branches.
+  void ecef_to_lla(const Block& x, const Block& y, const Block& z, Block& lon,
+                   Block& lat, Block& alt) const {
+    const Block zp = z.abs();
+    const Block w2 = x.square() + y.square();
+    const Block w = w2.sqrt();
+    const Block inv_r2 = (w2 + z.square()).inverse();
+    const Block inv_r = inv_r2.sqrt();
+    const Block s2 = z.square() * inv_r2;
+    const Block c2 = w2 * inv_r2;
+
+    Block u = a2_ * inv_r;
+    Block v = a3_ - a4_ * inv_r;
+
+    const Block s1 = (zp * inv_r) * (1.0 + c2 * (a1_ + u + s2 * v) * inv_r);
+    const Block c1 = (w * inv_r) * (1.0 - s2 * (a5_ - u - c2 * v) * inv_r);
+    const auto mask = c2 > 0.3;
+    const Block s =
+        mask.select(s1, (1.0 - c1.square()).max(0.0).sqrt()).eval();
+    const Block c =
+        mask.select((1.0 - s1.square()).max(0.0).sqrt(), c1).eval();
+
+    const Block g = 1.0 - e2_ * s.square();
+    const Block rg = a_ / g.sqrt();
+    const Block rf = a6_ * rg;
+    u = w - rg * c;
+    v = zp - rf * s;
+    const Block f = c * u + s * v;
+    const Block m = c * v - s * u;
+    const Block p = m / (rf / g + f);
+
+    lat = s.binaryExpr(c, [](double a, double b) { return std::atan2(a, b); });
+    lat = (z < 0.0).select(-(lat + p), lat + p) * (180.0 / math::pi<double>());
+    lon = y.binaryExpr(x,
+                       [](double a, double b) { return math::atan2d(a, b); });
+    alt = f + m * p * 0.5;
+  }
+
+  /// Batch version of the scalar lla_to_ecef.
+  void lla_to_ecef(const Block& lon, const Block& lat, const Block& alt,
+                   Block& x, Block& y, Block& z) const {
+    const Block lambda = lon * (math::pi<double>() / 180.0);
+    const Block phi = lat * (math::pi<double>() / 180.0);
+    const Block cosy = phi.cos();
+    const Block siny = phi.sin();
+    const Block n = a_ / (1.0 - e2_ * siny.square()).sqrt();
+    const Block r = (n + alt) * cosy;
+    x = r * lambda.cos();
+    y = r * lambda.sin();
+    z = (n * (1.0 - e2_) + alt) * siny;
+  }
+
   double a_, f_, e2_, a1_, a2_, a3_, a4_, a5_, a6_;
 };
 
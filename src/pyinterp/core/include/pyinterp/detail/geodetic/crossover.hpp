@@ -0,0 +1,252 @@
+// Copyright (c) 2022 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+#pragma once
+#include <Eigen/Core>
+#include <Eigen/Geometry>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "pyinterp/detail/math.hpp"
+
+namespace pyinterp::detail::geodetic {
+
+/// Crossover point between two tracks.
+struct Crossover {
+  /// Longitude of the crossover, in degrees.
+  double lon;
+  /// Latitude of the crossover, in degrees.
+  double lat;
+  /// Position of the crossover along the first track: the integer part is
+  /// the index of the first point of the segment crossed, the fractional
+  /// part the position of the crossover within the segment.
+  double index1;
+  /// Position of the crossover along the second track.
+  double index2;
+};
+
+/// Segment of a track, joining two consecutive points along the great
+/// circle passing through them.
+class TrackSegment {
+ public:
+  /// Builds the segment joining the points of index ix and ix + 1.
+  TrackSegment(const Eigen::Vector3d &a, const Eigen::Vector3d &b,
+               const double lon_a, const double lon_b, const int64_t ix)
+      : a_(a), b_(b), normal_(a.cross(b).normalized()), index_(ix) {
+    lat_min_ = std::min(a.z(), b.z());
+    lat_max_ = std::max(a.z(), b.z());
+    // The top of the great circle, if it is located between the ends of the
+    // segment, is the northernmost point of the segment; its antipode is the
+    // southernmost point.
+    Eigen::Vector3d top = Eigen::Vector3d::UnitZ() - normal_.z() * normal_;
+    if (top.norm() > 0) {
+      top.normalize();
+      if (contains(top)) {
+        lat_max_ = top.z();
+      } else if (contains(-top)) {
+        lat_min_ = -top.z();
+      }
+    }
+    // Along a segment that does not pass through a pole, the longitude
+    // varies monotonically by less than 180 degrees.
+    const auto dlon = math::normalize_angle(lon_b - lon_a, -180.0, 360.0);
+    if (lat_max_ >= 1 - kEpsilon || lat_min_ <= kEpsilon - 1 ||
+        std::abs(dlon) >= 180 - kEpsilon) {
+      west_ = -180;
+      width_ = 360;
+    } else {
+      west_ = dlon < 0 ? lon_b : lon_a;
+      width_ = std::abs(dlon);
+    }
+  }
+
+  /// Returns the index of the first point of the segment.
+  [[nodiscard]] constexpr auto index() const noexcept -> int64_t {
+    return index_;
+  }
+
+  /// Returns the sine of the southernmost latitude of the segment.
+  [[nodiscard]] constexpr auto lat_min() const noexcept -> double {
+    return lat_min_;
+  }
+
+  /// Returns the sine of the northernmost latitude of the segment.
+  [[nodiscard]] constexpr auto lat_max() const noexcept -> double {
+    return lat_max_;
+  }
+
+  /// Test if the range of longitudes of two segments overlap.
+  [[nodiscard]] auto overlaps(const TrackSegment &other) const -> bool {
+    const auto delta = math::normalize_angle(other.west_ - west_, 0.0, 360.0);
+    return delta <= width_ + kEpsilon || delta >= 360 - other.width_ - kEpsilon;
+  }
+
+  /// Test if a point, located on the great circle of the segment, is
+  /// located between its ends.
+  [[nodiscard]] auto contains(const Eigen::Vector3d &point) const -> bool {
+    return a_.cross(point).dot(normal_) >= -kEpsilon &&
+           point.cross(b_).dot(normal_) >= -kEpsilon;
+  }
+
+  /// Returns the position of a point of the segment, from 0 at its first
+  /// end to 1 at its last end.
+  [[nodiscard]] auto position(const Eigen::Vector3d &point) const -> double {
+    return std::atan2(a_.cross(point).norm(), a_.dot(point)) /
+           std::atan2(a_.cross(b_).norm(), a_.dot(b_));
+  }
+
+  /// Calculates the intersection between two segments.
+  ///
+  /// @return True if the segments intersect.
+  auto intersection(const TrackSegment &other, Crossover &crossover) const
+      -> bool {
+    Eigen::Vector3d line = normal_.cross(other.normal_);
+    const auto norm = line.norm();
+    // Segments located on the same great circle are not intersected.
+    if (!(norm > 1e-15)) {
+      return false;
+    }
+    line /= norm;
+    if (!(contains(line) && other.contains(line))) {
+      line = -line;
+      if (!(contains(line) && other.contains(line))) {
+        return false;
+      }
+    }
+    crossover.lon = math::degrees(std::atan2(line.y(), line.x()));
+    crossover.lat = math::degrees(std::asin(std::clamp(line.z(), -1.0, 1.0)));
+    crossover.index1 =
+        static_cast<double>(index_) + std::clamp(position(line), 0.0, 1.0);
+    crossover.index2 = static_cast<double>(other.index_) +
+                       std::clamp(other.position(line), 0.0, 1.0);
+    return true;
+  }
+
+ private:
+  /// Tolerance of the comparisons, so that the crossovers located on the
+  /// ends of the segments are found.
+  static constexpr double kEpsilon = 1e-12;
+
+  /// Unit vectors of the ends of the segment.
+  Eigen::Vector3d a_, b_;
+  /// Unit normal of the plane of the great circle of the segment.
+  Eigen::Vector3d normal_;
+  /// Index of the first point of the segment.
+  int64_t index_;
+  /// Sines of the latitude range of the segment.
+  double lat_min_{}, lat_max_{};
+  /// Western longitude of the segment and width of its longitude range.
+  double west_{}, width_{};
+};
+
+/// Builds the segments of a track, sorted by increasing southernmost
+/// latitude. The segments whose ends are undefined, identical or antipodal
+/// are ignored.
+inline auto track_segments(const Eigen::Ref<const Eigen::VectorXd> &lon,
+                           const Eigen::Ref<const Eigen::VectorXd> &lat)
+    -> std::vector<TrackSegment> {
+  auto unit_vector = [](const double x, const double y) -> Eigen::Vector3d {
+    const auto cos_lat = std::cos(math::radians(y));
+    return {cos_lat * std::cos(math::radians(x)),
+            cos_lat * std::sin(math::radians(x)), std::sin(math::radians(y))};
+  };
+  auto result = std::vector<TrackSegment>();
+  if (lon.size() < 2) {
+    return result;
+  }
+  result.reserve(static_cast<size_t>(lon.size() - 1));
+  auto a = unit_vector(lon(0), lat(0));
+  for (Eigen::Index ix = 1; ix < lon.size(); ++ix) {
+    auto b = unit_vector(lon(ix), lat(ix));
+    if (a.allFinite() && b.allFinite() && a.cross(b).norm() > 1e-15) {
+      result.emplace_back(a, b, lon(ix - 1), lon(ix), ix - 1);
+    }
+    a = b;
+  }
+  std::sort(result.begin(), result.end(),
+            [](const auto &lhs, const auto &rhs) {
+              return lhs.lat_min() < rhs.lat_min();
+            });
+  return result;
+}
+
+/// Searches for the crossover points between two tracks.
+///
+/// The tracks are polylines whose segments follow the great circles joining
+/// consecutive points, on the sphere. A sweep line moves from south to north
+/// over the latitude ranges of the segments of both tracks: a segment is
+/// only intersected with the segments of the other track crossed by the line
+/// at the same time and whose longitude range overlaps.
+///
+/// @param lon1 Longitudes of the points of the first track, in degrees.
+/// @param lat1 Latitudes of the points of the first track, in degrees.
+/// @param lon2 Longitudes of the points of the second track, in degrees.
+/// @param lat2 Latitudes of the points of the second track, in degrees.
+/// @return The crossover points, sorted by position along the first track.
+inline auto crossovers(const Eigen::Ref<const Eigen::VectorXd> &lon1,
+                       const Eigen::Ref<const Eigen::VectorXd> &lat1,
+                       const Eigen::Ref<const Eigen::VectorXd> &lon2,
+                       const Eigen::Ref<const Eigen::VectorXd> &lat2)
+    -> std::vector<Crossover> {
+  const auto track1 = track_segments(lon1, lat1);
+  const auto track2 = track_segments(lon2, lat2);
+
+  // Segments of each track crossed by the sweep line.
+  auto active1 = std::vector<const TrackSegment *>();
+  auto active2 = std::vector<const TrackSegment *>();
+  auto result = std::vector<Crossover>();
+  auto crossover = Crossover{};
+
+  // Intersects a segment with the active segments of the other track,
+  // removing those left behind by the sweep line.
+  auto sweep = [&](const TrackSegment &segment,
+                   std::vector<const TrackSegment *> &active, bool first) {
+    for (size_t ix = 0; ix < active.size();) {
+      const auto *item = active[ix];
+      if (item->lat_max() < segment.lat_min()) {
+        active[ix] = active.back();
+        active.pop_back();
+        continue;
+      }
+      if (segment.overlaps(*item) &&
+          (first ? segment.intersection(*item, crossover)
+                 : item->intersection(segment, crossover))) {
+        result.push_back(crossover);
+      }
+      ++ix;
+    }
+  };
+
+  auto it1 = track1.begin();
+  auto it2 = track2.begin();
+  while (it1 != track1.end() || it2 != track2.end()) {
+    if (it2 == track2.end() ||
+        (it1 != track1.end() && it1->lat_min() <= it2->lat_min())) {
+      sweep(*it1, active2, true);
+      active1.push_back(&*it1++);
+    } else {
+      sweep(*it2, active1, false);
+      active2.push_back(&*it2++);
+    }
+  }
+
+  // A crossover located on a point shared by two segments is found twice.
+  std::sort(result.begin(), result.end(), [](const auto &lhs, const auto &rhs) {
+    return lhs.index1 < rhs.index1 ||
+           (lhs.index1 == rhs.index1 && lhs.index2 < rhs.index2);
+  });
+  result.erase(std::unique(result.begin(), result.end(),
+                           [](const auto &lhs, const auto &rhs) {
+                             constexpr auto kEpsilon = 1e-9;
+                             return std::abs(lhs.index1 - rhs.index1) <
+                                        kEpsilon &&
+                                    std::abs(lhs.index2 - rhs.index2) <
+                                        kEpsilon;
+                           }),
+               result.end());
+  return result;
+}
+
+}  // namespace pyinterp::detail::geodetic
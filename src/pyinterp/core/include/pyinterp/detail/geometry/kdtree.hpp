@@ -0,0 +1,535 @@
+// Copyright (c) 2022 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+#pragma once
+#include <algorithm>
+#include <array>
+#include <boost/geometry.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "pyinterp/detail/geometry/box.hpp"
+#include "pyinterp/detail/geometry/point.hpp"
+#include "pyinterp/detail/thread.hpp"
+
+namespace pyinterp::detail::geometry {
+
+/// Immutable K-d tree storing the points in a contiguous array.
+///
+/// The tree is implicit: the points are reordered so that the node covering
+/// the range [first, last) of the array is its median point, at the index
+/// (first + last) / 2, which splits the range along the dimension of largest
+/// spread. The ranges of at most kLeafSize points are the leaves of the tree,
+/// scanned linearly. Apart from the points, the tree only stores the split
+/// dimension of each node.
+///
+/// These two arrays can be written to a file (see save()) that load() maps
+/// read-only in memory: the tree is then opened without reading or copying
+/// the points, and the pages of the file are shared by all processes opening
+/// it.
+///
+/// @tparam CoordinateType The class of storage for a point's coordinates.
+/// @tparam Type The type of data stored in the tree.
+/// @tparam N Number of dimensions in the Cartesian space handled.
+template <typename CoordinateType, typename Type, size_t N>
+class KDTree {
+ public:
+  /// Type of the point handled by this instance.
+  using point_t = geometry::PointND<CoordinateType, N>;
+
+  /// Type of distances between two points.
+  using distance_t =
+      typename boost::geometry::default_distance_result<point_t,
+                                                        point_t>::type;
+
+  /// Value handled by this object
+  using value_t = std::pair<point_t, Type>;
+
+  /// Type of query results: the distance to the point found and its index in
+  /// the tree.
+  using result_t = std::pair<distance_t, size_t>;
+
+  /// Default constructor
+  KDTree() = default;
+
+  /// Builds the tree from the provided values.
+  ///
+  /// @param values Points to index.
+  /// @param num_threads The number of threads used to build the subtrees. If
+  /// 0 all CPUs are used.
+  explicit KDTree(std::vector<value_t> values, const size_t num_threads = 1) {
+    auto storage = std::make_shared<Storage>();
+    storage->values = std::move(values);
+    storage->axes.resize(storage->values.size());
+    build(storage->values, storage->axes, num_threads);
+    values_ = storage->values.data();
+    axes_ = storage->axes.data();
+    size_ = storage->values.size();
+    storage_ = std::move(storage);
+  }
+
+  /// Returns the number of points stored in the tree.
+  [[nodiscard]] auto size() const noexcept -> size_t { return size_; }
+
+  /// Query if the tree is empty.
+  [[nodiscard]] auto empty() const noexcept -> bool { return size_ == 0; }
+
+  /// Returns an iterator to the first value stored, in the order of the tree.
+  [[nodiscard]] auto begin() const noexcept -> const value_t * {
+    return values_;
+  }
+
+  /// Returns an iterator past the last value stored.
+  [[nodiscard]] auto end() const noexcept -> const value_t * {
+    return values_ + size_;
+  }
+
+  /// Returns the value stored at the given index.
+  auto operator[](const size_t ix) const noexcept -> const value_t & {
+    return values_[ix];
+  }
+
+  /// Returns the box able to contain all values stored in the tree.
+  [[nodiscard]] auto bounds() const -> BoxND<CoordinateType, N> {
+    auto result = BoxND<CoordinateType, N>();
+    boost::geometry::assign_inverse(result);
+    std::for_each(begin(), end(), [&result](const auto &item) {
+      boost::geometry::expand(result, item.first);
+    });
+    return result;
+  }
+
+  /// Writes the tree to a file.
+  ///
+  /// @param path Path to the file to create.
+  /// @param metadata User data stored in the header of the file.
+  /// @note The file stores the memory representation of the tree: it can only
+  /// be loaded on a machine with the same architecture.
+  auto save(const std::string &path, const std::string &metadata) const
+      -> void {
+    auto header = FileHeader{};
+    std::memcpy(header.magic, kMagic, sizeof(header.magic));
+    header.version = kVersion;
+    header.dimensions = N;
+    header.coordinate_size = sizeof(CoordinateType);
+    header.value_size = sizeof(Type);
+    header.size = size_;
+    header.metadata_size = metadata.size();
+    header.values_offset = align(sizeof(FileHeader) + metadata.size());
+    header.axes_offset = header.values_offset + size_ * sizeof(value_t);
+
+    auto stream = std::ofstream(path, std::ios::binary | std::ios::trunc);
+    if (!stream) {
+      throw std::runtime_error("unable to create the file: " + path);
+    }
+    stream.exceptions(std::ios::failbit | std::ios::badbit);
+    stream.write(reinterpret_cast<const char *>(&header), sizeof(FileHeader));
+    stream.write(metadata.data(),
+                 static_cast<std::streamsize>(metadata.size()));
+    auto padding = std::string(
+        header.values_offset - sizeof(FileHeader) - metadata.size(), '\0');
+    stream.write(padding.data(), static_cast<std::streamsize>(padding.size()));
+    stream.write(reinterpret_cast<const char *>(values_),
+                 static_cast<std::streamsize>(size_ * sizeof(value_t)));
+    stream.write(reinterpret_cast<const char *>(axes_),
+                 static_cast<std::streamsize>(size_));
+  }
+
+  /// Opens a tree written by save(). The file is mapped read-only in memory
+  /// and must not be modified while the tree is in use.
+  ///
+  /// @param path Path to the file to open.
+  /// @return The tree and the user data stored in the header of the file.
+  static auto load(const std::string &path)
+      -> std::pair<KDTree, std::string> {
+    namespace bip = boost::interprocess;
+    auto region = std::shared_ptr<bip::mapped_region>();
+    try {
+      auto file = bip::file_mapping(path.c_str(), bip::read_only);
+      region = std::make_shared<bip::mapped_region>(file, bip::read_only);
+    } catch (const bip::interprocess_exception &ex) {
+      throw std::runtime_error("unable to open the file: " + path + ": " +
+                               ex.what());
+    }
+    const auto *base = static_cast<const char *>(region->get_address());
+    const auto file_size = region->get_size();
+
+    auto header = FileHeader{};
+    if (file_size < sizeof(FileHeader)) {
+      throw std::invalid_argument("invalid index file: " + path);
+    }
+    std::memcpy(&header, base, sizeof(FileHeader));
+    if (std::memcmp(header.magic, kMagic, sizeof(header.magic)) != 0 ||
+        header.version != kVersion) {
+      throw std::invalid_argument("invalid index file: " + path);
+    }
+    if (header.dimensions != N ||
+        header.coordinate_size != sizeof(CoordinateType) ||
+        header.value_size != sizeof(Type)) {
+      throw std::invalid_argument(
+          "the index file does not match the type of the tree: " + path);
+    }
+    if (header.size > file_size || header.metadata_size > file_size ||
+        header.values_offset < sizeof(FileHeader) + header.metadata_size ||
+        header.values_offset % alignof(value_t) != 0 ||
+        header.axes_offset != header.values_offset +
+                                  header.size * sizeof(value_t) ||
+        header.axes_offset + header.size != file_size) {
+      throw std::invalid_argument("invalid index file: " + path);
+    }
+
+    auto result = KDTree();
+    result.values_ =
+        reinterpret_cast<const value_t *>(base + header.values_offset);
+    result.axes_ = reinterpret_cast<const uint8_t *>(base + header.axes_offset);
+    result.size_ = header.size;
+    result.storage_ = std::move(region);
+    return std::make_pair(
+        std::move(result),
+        std::string(base + sizeof(FileHeader), header.metadata_size));
+  }
+
+  /// Search for the K nearest neighbors of a given point.
+  ///
+  /// @param point Point of interest
+  /// @param k The number of nearest neighbors to search.
+  /// @return the k nearest neighbors sorted by increasing distance.
+  auto nearest(const point_t &point, const uint32_t k) const
+      -> std::vector<result_t> {
+    auto result = std::vector<result_t>();
+    nearest(point, k, result);
+    return result;
+  }
+
+  /// Search for the K nearest neighbors of a given point, reusing the memory
+  /// of the provided vector.
+  ///
+  /// @param point Point of interest
+  /// @param k The number of nearest neighbors to search.
+  /// @param heap Vector receiving the k nearest neighbors sorted by
+  /// increasing distance.
+  auto nearest(const point_t &point, const uint32_t k,
+               std::vector<result_t> &heap) const -> void {
+    nearest(point, k, std::numeric_limits<distance_t>::max(), heap);
+  }
+
+  /// Search for the K nearest neighbors of a given point located within a
+  /// radius, reusing the memory of the provided vector. The subtrees located
+  /// beyond the radius are not explored.
+  ///
+  /// @param point Point of interest
+  /// @param k The number of nearest neighbors to search.
+  /// @param radius The maximum distance between the point and its neighbors.
+  /// @param heap Vector receiving the k nearest neighbors sorted by
+  /// increasing distance.
+  /// @param removed If not null, flags indexed like the points: the flagged
+  /// points are ignored.
+  /// @param eps Tolerance of an approximate search: the subtrees that cannot
+  /// contain a point closer than the worst candidate divided by (1 + eps) are
+  /// not explored. The i-th neighbor returned is then at most (1 + eps) times
+  /// farther than the true i-th nearest neighbor. If 0, the search is exact.
+  auto nearest(const point_t &point, const uint32_t k, const distance_t radius,
+               std::vector<result_t> &heap, const uint8_t *removed = nullptr,
+               const distance_t eps = 0) const -> void {
+    nearest_if(
+        point, k, radius, heap,
+        [removed](const size_t ix) {
+          return removed == nullptr || removed[ix] == 0;
+        },
+        eps);
+  }
+
+  /// Search for the K nearest neighbors of a given point located within a
+  /// radius, among the points selected by a predicate.
+  ///
+  /// @param point Point of interest
+  /// @param k The number of nearest neighbors to search.
+  /// @param radius The maximum distance between the point and its neighbors.
+  /// @param heap Vector receiving the k nearest neighbors sorted by
+  /// increasing distance.
+  /// @param accept Predicate called with the index of a point in the tree,
+  /// returning false if the point must be ignored.
+  /// @param eps Tolerance of an approximate search, see nearest.
+  template <typename Predicate>
+  auto nearest_if(const point_t &point, const uint32_t k,
+                  const distance_t radius, std::vector<result_t> &heap,
+                  const Predicate &accept, const distance_t eps = 0) const
+      -> void {
+    heap.clear();
+    if (k == 0 || empty()) {
+      return;
+    }
+    heap.reserve(k);
+
+    // Squared radius of the search, infinite if the radius is unbounded.
+    const auto bound = square(radius);
+
+    // Max-heap of the squared distances of the best candidates.
+    auto visit = [&](const size_t ix) {
+      if (!accept(ix)) {
+        return;
+      }
+      auto distance = squared_distance(point, values_[ix].first);
+      if (distance > bound) {
+        return;
+      }
+      if (heap.size() < k) {
+        heap.emplace_back(distance, ix);
+        std::push_heap(heap.begin(), heap.end());
+      } else if (distance < heap.front().first) {
+        std::pop_heap(heap.begin(), heap.end());
+        heap.back() = {distance, ix};
+        std::push_heap(heap.begin(), heap.end());
+      }
+    };
+    // A subtree is explored if it can contain a point within the radius and
+    // closer than the worst candidate, shrunk by the tolerance of the search.
+    const auto scale = square(1 + eps);
+    auto explore = [&](const distance_t diff) {
+      const auto distance = diff * diff;
+      return heap.size() < k ? distance <= bound
+                             : distance * scale <= heap.front().first;
+    };
+    traverse(point, 0, size_, visit, explore);
+
+    std::sort_heap(heap.begin(), heap.end());
+    for (auto &item : heap) {
+      item.first = std::sqrt(item.first);
+    }
+  }
+
+  /// Search for the points located within a radius of a given point.
+  ///
+  /// @param point Point of interest
+  /// @param radius distance within which neighbors are returned
+  /// @param removed If not null, flags indexed like the points: the flagged
+  /// points are ignored.
+  /// @return the points found, in the order of the tree.
+  auto within(const point_t &point, const distance_t radius,
+              const uint8_t *removed = nullptr) const
+      -> std::vector<result_t> {
+    auto result = std::vector<result_t>();
+    auto visit = [&](const size_t ix) {
+      if (removed != nullptr && removed[ix] != 0) {
+        return;
+      }
+      auto distance =
+          std::sqrt(squared_distance(point, values_[ix].first));
+      if (distance <= radius) {
+        result.emplace_back(distance, ix);
+      }
+    };
+    auto explore = [&](const distance_t diff) {
+      return std::abs(diff) <= radius;
+    };
+    traverse(point, 0, size_, visit, explore);
+    return result;
+  }
+
+ private:
+  /// Maximum number of points in a leaf of the tree.
+  static constexpr size_t kLeafSize = 8;
+
+  /// Identifier of the files written by save().
+  static constexpr char kMagic[8] = {'P', 'Y', 'I', 'K', 'D', 'T', 'R', 'E'};
+
+  /// Version of the layout of the files written by save().
+  static constexpr uint32_t kVersion = 1;
+
+  /// Header of the files written by save(), followed by the user data, then,
+  /// at aligned offsets, by the points and the split dimensions of the tree.
+  struct FileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t dimensions;
+    uint32_t coordinate_size;
+    uint32_t value_size;
+    uint64_t size;
+    uint64_t metadata_size;
+    uint64_t values_offset;
+    uint64_t axes_offset;
+  };
+
+  /// Memory owned by a tree built from a vector of values.
+  struct Storage {
+    std::vector<value_t> values;
+    std::vector<uint8_t> axes;
+  };
+
+  /// Memory holding the arrays of the tree: a Storage or a mapped file.
+  std::shared_ptr<const void> storage_{};
+
+  /// Points stored in the tree.
+  const value_t *values_{nullptr};
+
+  /// Split dimension of the nodes, indexed like the points.
+  const uint8_t *axes_{nullptr};
+
+  /// Number of points stored in the tree.
+  size_t size_{0};
+
+  /// Rounds an offset of the files up to a multiple of the page-friendly
+  /// alignment of the arrays.
+  static constexpr auto align(const uint64_t offset) -> uint64_t {
+    constexpr auto alignment = uint64_t(64);
+    static_assert(alignment % alignof(value_t) == 0);
+    return (offset + alignment - 1) / alignment * alignment;
+  }
+
+  /// Calculates the squared Euclidean distance between two points, summing
+  /// the dimensions in the same order as boost::geometry::distance.
+  static auto squared_distance(const point_t &lhs, const point_t &rhs)
+      -> distance_t {
+    return squared_distance(lhs, rhs, std::make_index_sequence<N>{});
+  }
+
+  template <size_t... Ix>
+  static auto squared_distance(const point_t &lhs, const point_t &rhs,
+                               std::index_sequence<Ix...> /*unused*/)
+      -> distance_t {
+    auto result = distance_t(0);
+    ((result += square(static_cast<distance_t>(boost::geometry::get<Ix>(lhs)) -
+                       static_cast<distance_t>(boost::geometry::get<Ix>(rhs)))),
+     ...);
+    return result;
+  }
+
+  static constexpr auto square(const distance_t value) -> distance_t {
+    return value * value;
+  }
+
+  /// Builds the whole tree. The nodes of the first levels are split level by
+  /// level, each level in parallel, until there are enough independent
+  /// subtrees to keep all the threads busy; these subtrees are then built
+  /// concurrently.
+  static auto build(std::vector<value_t> &values, std::vector<uint8_t> &axes,
+                    const size_t num_threads) -> void {
+    auto ranges = std::vector<std::pair<size_t, size_t>>{{0, values.size()}};
+    if (num_threads != 1) {
+      const auto num_subtrees =
+          4 * (num_threads == 0 ? get_num_threads() : num_threads);
+      auto children = std::vector<std::pair<size_t, size_t>>();
+      while (!ranges.empty() && ranges.size() < num_subtrees) {
+        children.resize(2 * ranges.size());
+        dispatch(
+            [&](size_t start, size_t end) {
+              for (auto ix = start; ix < end; ++ix) {
+                auto [first, last] = ranges[ix];
+                auto mid = last;
+                if (last - first > kLeafSize) {
+                  mid = split(values, axes, first, last);
+                }
+                children[2 * ix] = {first, mid};
+                children[2 * ix + 1] = {std::min(mid + 1, last), last};
+              }
+            },
+            ranges.size(), num_threads, kDynamic);
+        // Leaves are complete: they are not processed any further.
+        ranges.clear();
+        std::copy_if(
+            children.begin(), children.end(), std::back_inserter(ranges),
+            [](const auto &item) {
+              return item.second - item.first > kLeafSize;
+            });
+      }
+    }
+    dispatch(
+        [&](size_t start, size_t end) {
+          for (auto ix = start; ix < end; ++ix) {
+            build(values, axes, ranges[ix].first, ranges[ix].second);
+          }
+        },
+        ranges.size(), num_threads, kDynamic);
+  }
+
+  /// Builds the subtree covering the points [first, last).
+  static auto build(std::vector<value_t> &values, std::vector<uint8_t> &axes,
+                    size_t first, size_t last) -> void {
+    while (last - first > kLeafSize) {
+      const auto mid = split(values, axes, first, last);
+      build(values, axes, first, mid);
+      first = mid + 1;
+    }
+  }
+
+  /// Splits the node covering the points [first, last) along the dimension of
+  /// largest spread of its points and returns the position of the median.
+  static auto split(std::vector<value_t> &values, std::vector<uint8_t> &axes,
+                    const size_t first, const size_t last) -> size_t {
+    auto lower = std::array<CoordinateType, N>();
+    auto upper = std::array<CoordinateType, N>();
+    lower.fill(std::numeric_limits<CoordinateType>::max());
+    upper.fill(std::numeric_limits<CoordinateType>::lowest());
+    for (auto ix = first; ix < last; ++ix) {
+      for (size_t jx = 0; jx < N; ++jx) {
+        const auto value = point::get(values[ix].first, jx);
+        lower[jx] = std::min(lower[jx], value);
+        upper[jx] = std::max(upper[jx], value);
+      }
+    }
+    auto axis = size_t(0);
+    for (size_t jx = 1; jx < N; ++jx) {
+      if (upper[jx] - lower[jx] > upper[axis] - lower[axis]) {
+        axis = jx;
+      }
+    }
+
+    const auto mid = first + (last - first) / 2;
+    std::nth_element(values.begin() + first, values.begin() + mid,
+                     values.begin() + last,
+                     [axis](const value_t &lhs, const value_t &rhs) {
+                       return point::get(lhs.first, axis) <
+                              point::get(rhs.first, axis);
+                     });
+    axes[mid] = static_cast<uint8_t>(axis);
+    return mid;
+  }
+
+  /// Visits the points of the subtree covering [first, last) that may
+  /// satisfy the query. The nearest child of a node is visited first, the
+  /// other child only if explore(diff) is true, diff being the signed
+  /// distance between the point of interest and the split plane.
+  template <typename Visit, typename Explore>
+  auto traverse(const point_t &point, size_t first, size_t last, Visit &visit,
+                const Explore &explore) const -> void {
+    while (last - first > kLeafSize) {
+      const auto mid = first + (last - first) / 2;
+      const auto axis = axes_[mid];
+      const auto diff =
+          static_cast<distance_t>(point::get(point, axis)) -
+          static_cast<distance_t>(point::get(values_[mid].first, axis));
+      visit(mid);
+      if (diff < 0) {
+        traverse(point, first, mid, visit, explore);
+        if (!explore(diff)) {
+          return;
+        }
+        first = mid + 1;
+      } else {
+        traverse(point, mid + 1, last, visit, explore);
+        if (!explore(diff)) {
+          return;
+        }
+        last = mid;
+      }
+    }
+    for (auto ix = first; ix < last; ++ix) {
+      visit(ix);
+    }
+  }
+};
+
+}  // namespace pyinterp::detail::geometry
@@ -5,18 +5,33 @@
 #pragma once
 #include <Eigen/Core>
 #include <algorithm>
+#include <array>
 #include <boost/geometry.hpp>
 #include <optional>
 
 #include "pyinterp/detail/geometry/box.hpp"
+#include "pyinterp/detail/geometry/kdtree.hpp"
 #include "pyinterp/detail/geometry/point.hpp"
+#include "pyinterp/detail/math/batched_lu.hpp"
+#include "pyinterp/detail/math/kriging.hpp"
 #include "pyinterp/detail/math/radial_basis_functions.hpp"
 #include "pyinterp/detail/math/window_functions.hpp"
+#include "pyinterp/detail/profiling.hpp"
+#include "pyinterp/detail/thread.hpp"
 
 namespace pyinterp::detail::geometry {
 
 /// Index points in the Cartesian space at N dimensions.
 ///
+/// The points inserted one by one are stored in a R*Tree. The points loaded
+/// with the packing algorithm are stored in an immutable K-d tree, laid out in
+/// a contiguous array, which is much faster to query.
+///
+/// Once the K-d tree is built, the points inserted are buffered in the R*Tree,
+/// used as a small delta index, and the points removed are flagged in the
+/// K-d tree. The queries merge the results of both indexes. When the delta
+/// grows too large, all the points are packed into a new K-d tree.
+///
 /// @tparam CoordinateType The class of storage for a point's coordinates.
 /// @tparam Type The type of data stored in the tree.
 /// @tparam N Number of dimensions in the Cartesian space handled.
@@ -33,6 +48,12 @@ class RTree {
   /// Type of query results.
   using result_t = std::pair<distance_t, Type>;
 
+  /// Type of the list of query results, whose memory is accounted by the
+  /// profiler.
+  using results_t =
+      std::vector<result_t,
+                  profiling::Allocator<result_t, profiling::kRTreeQuery>>;
+
   /// Value handled by this object
   using value_t = std::pair<point_t, Type>;
 
@@ -40,10 +61,54 @@ class RTree {
   using rtree_t =
       boost::geometry::index::rtree<value_t, boost::geometry::index::rstar<16>>;
 
+  /// Static index used after packing
+  using kdtree_t = KDTree<CoordinateType, Type, N>;
+
   /// Type of the implicit conversion between the type of coordinates and values
   using promotion_t =
       decltype(std::declval<CoordinateType>() + std::declval<Type>());
 
+  /// Cache of the RBF interpolants, identified by the address of their nodes
+  /// in the index.
+  using rbf_cache_t = math::RBFCache<promotion_t, const value_t *>;
+
+  /// Cache of the kriging systems, identified by the address of their nodes
+  /// in the index.
+  using kriging_cache_t = math::KrigingCache<promotion_t, const value_t *>;
+
+  /// Number of query points whose RBF interpolants are solved together.
+  static constexpr size_t kRBFBatchSize = 8;
+
+  /// Buffers of the neighborhoods of a block of query points, whose RBF
+  /// systems are solved together. An instance is used by a single thread.
+  struct RBFBatch {
+    /// Allocates the buffers of neighborhoods of k points.
+    explicit RBFBatch(const uint32_t k) : solver(k) {
+      for (size_t ix = 0; ix < kRBFBatchSize; ++ix) {
+        coordinates[ix].resize(N, k);
+        values[ix].resize(k);
+      }
+    }
+
+    /// Solver of the systems of the block
+    math::BatchedLU<promotion_t, kRBFBatchSize> solver;
+    /// Coordinates of the neighbors of each point
+    std::array<Matrix<promotion_t>, kRBFBatchSize> coordinates;
+    /// Values of the neighbors of each point
+    std::array<Vector<promotion_t>, kRBFBatchSize> values;
+    /// Sorted addresses of the neighbors of each point
+    std::array<std::vector<const value_t *>, kRBFBatchSize> keys;
+  };
+
+  /// Interpolant defined over all the points of the index by a compactly
+  /// supported radial basis function.
+  struct CompactInterpolant {
+    /// Points of the index, in the order of the weights.
+    std::shared_ptr<const kdtree_t> index;
+    /// Weights of the points.
+    Vector<promotion_t> weights;
+  };
+
   /// Default constructor
   RTree() : tree_(new rtree_t{}) {}
 
@@ -71,34 +136,157 @@ class RTree {
     if (empty()) {
       return {};
     }
-    return tree_->bounds();
+    if (!kdtree_) {
+      return tree_->bounds();
+    }
+    auto result = geometry::BoxND<CoordinateType, N>();
+    boost::geometry::assign_inverse(result);
+    for_each([&result](const auto &item) {
+      boost::geometry::expand(result, item.first);
+    });
+    return result;
   }
 
   /// Returns the number of points of this mesh
   ///
   /// @return the number of points
-  [[nodiscard]] constexpr auto size() const -> size_t { return tree_->size(); }
+  [[nodiscard]] constexpr auto size() const -> size_t {
+    return kdtree_ ? kdtree_->size() - num_removed_ + tree_->size()
+                   : tree_->size();
+  }
 
   /// Query if the container is empty.
   ///
   /// @return true if the container is empty.
-  [[nodiscard]] constexpr auto empty() const -> bool { return tree_->empty(); }
+  [[nodiscard]] constexpr auto empty() const -> bool { return size() == 0; }
 
   /// Removes all values stored in the container.
-  inline auto clear() -> void { tree_->clear(); }
+  inline auto clear() -> void {
+    tree_->clear();
+    kdtree_.reset();
+    reset_removed();
+  }
 
   /// The tree is created using packing algorithm (The old data is erased before
   /// construction.)
   ///
   /// @param points
-  inline auto packing(const std::vector<value_t> &points) -> void {
-    *tree_ = rtree_t(points);
+  /// @param num_threads The number of threads used to build the index. If 0
+  /// all CPUs are used.
+  inline auto packing(std::vector<value_t> points,
+                      const size_t num_threads = 1) -> void {
+    tree_->clear();
+    kdtree_ = std::make_shared<kdtree_t>(std::move(points), num_threads);
+    reset_removed();
   }
 
   /// Insert new data into the search tree
   ///
   /// @param point
-  inline auto insert(const value_t &value) -> void { tree_->insert(value); }
+  inline auto insert(const value_t &value) -> void {
+    tree_->insert(value);
+    if (kdtree_) {
+      fold(1);
+    }
+  }
+
+  /// Insert a batch of new data into the search tree. The points inserted into
+  /// an empty container are packed.
+  ///
+  /// @param values Values to insert.
+  /// @param num_threads The number of threads used to repack the index, if
+  /// needed. If 0 all CPUs are used.
+  inline auto insert(std::vector<value_t> values, const size_t num_threads = 1)
+      -> void {
+    if (!kdtree_ && tree_->empty()) {
+      packing(std::move(values), num_threads);
+      return;
+    }
+    tree_->insert(values.begin(), values.end());
+    if (kdtree_) {
+      fold(num_threads);
+    }
+  }
+
+  /// Removes the values selected by a predicate.
+  ///
+  /// @param predicate Function called once for each value stored, in the
+  /// order of for_each, returning true if the value must be removed.
+  /// @param num_threads The number of threads used to repack the index, if
+  /// needed. If 0 all CPUs are used.
+  /// @return the number of values removed.
+  template <typename Predicate>
+  auto remove(Predicate &&predicate, const size_t num_threads = 1) -> size_t {
+    auto result = size_t(0);
+    if (kdtree_) {
+      // The points of the static index are only flagged.
+      for (size_t ix = 0; ix < kdtree_->size(); ++ix) {
+        if (is_removed(ix) || !predicate((*kdtree_)[ix])) {
+          continue;
+        }
+        if (removed_.empty()) {
+          removed_.resize(kdtree_->size(), 0);
+        }
+        removed_[ix] = 1;
+        ++num_removed_;
+        ++result;
+      }
+    }
+    auto expired = std::vector<value_t>();
+    std::for_each(tree_->begin(), tree_->end(), [&](const auto &item) {
+      if (predicate(item)) {
+        expired.push_back(item);
+      }
+    });
+    result += tree_->remove(expired.begin(), expired.end());
+    if (kdtree_) {
+      fold(num_threads);
+    }
+    return result;
+  }
+
+  /// Writes the points of the container to a file, in the layout of the
+  /// static index, so that load() can map it in memory.
+  ///
+  /// @param path Path to the file to create.
+  /// @param metadata User data stored in the header of the file.
+  auto save(const std::string &path, const std::string &metadata) const
+      -> void {
+    if (kdtree_ && tree_->empty() && num_removed_ == 0) {
+      kdtree_->save(path, metadata);
+    } else {
+      kdtree_t(values()).save(path, metadata);
+    }
+  }
+
+  /// Replaces the values of the container by the static index stored in a
+  /// file written by save(). The file is mapped read-only in memory instead
+  /// of being read.
+  ///
+  /// @param path Path to the file to open.
+  /// @return The user data stored in the header of the file.
+  auto load(const std::string &path) -> std::string {
+    auto [kdtree, metadata] = kdtree_t::load(path);
+    tree_->clear();
+    kdtree_ = std::make_shared<kdtree_t>(std::move(kdtree));
+    reset_removed();
+    return metadata;
+  }
+
+  /// Calls a function for each value stored in the container.
+  ///
+  /// @param func Function called with each value stored.
+  template <typename Function>
+  auto for_each(Function &&func) const -> void {
+    if (kdtree_) {
+      for (size_t ix = 0; ix < kdtree_->size(); ++ix) {
+        if (!is_removed(ix)) {
+          func((*kdtree_)[ix]);
+        }
+      }
+    }
+    std::for_each(tree_->begin(), tree_->end(), func);
+  }
 
   /// Search for the K nearest neighbors of a given point.
   ///
@@ -106,13 +294,12 @@ class RTree {
   /// @param k The number of nearest neighbors to search.
   /// @return the k nearest neighbors:
   auto query(const point_t &point, const uint32_t k) const
-      -> std::vector<result_t> {
-    auto result = std::vector<result_t>();
-    std::for_each(
-        tree_->qbegin(boost::geometry::index::nearest(point, k)), tree_->qend(),
-        [&point, &result](const auto &item) {
-          result.emplace_back(std::make_pair(
-              boost::geometry::distance(point, item.first), item.second));
+      -> results_t {
+    auto result = results_t();
+    result.reserve(k);
+    for_each_nearest(
+        point, k, [&result](const distance_t distance, const auto &item) {
+          result.emplace_back(std::make_pair(distance, item.second));
         });
     return result;
   }
@@ -123,8 +310,18 @@ class RTree {
   /// @param radius distance within which neighbors are returned
   /// @return the k nearest neighbors
   auto query_ball(const point_t &point, const distance_t radius) const
-      -> std::vector<result_t> {
-    auto result = std::vector<result_t>();
+      -> results_t {
+    auto scope = profiling::Scope(profiling::kRTreeQuery);
+    auto result = results_t();
+    if (kdtree_) {
+      for (const auto &item : kdtree_->within(point, radius, removed())) {
+        result.emplace_back(
+            std::make_pair(item.first, (*kdtree_)[item.second].second));
+      }
+      if (tree_->empty()) {
+        return result;
+      }
+    }
     std::for_each(
         tree_->qbegin(boost::geometry::index::satisfies([&](const auto &item) {
           return boost::geometry::distance(item.first, point) <= radius;
@@ -143,28 +340,61 @@ class RTree {
   /// @return the k nearest neighbors if the point is within by its
   /// neighbors.
   auto query_within(const point_t &point, const uint32_t k) const
-      -> std::vector<result_t> {
-    auto result = std::vector<result_t>();
-    auto points = boost::geometry::model::multi_point<point_t>();
-    points.reserve(k);
+      -> results_t {
+    auto result = results_t();
+    result.reserve(k);
+    auto envelope = inverse_box();
 
-    std::for_each(
-        tree_->qbegin(boost::geometry::index::nearest(point, k)), tree_->qend(),
-        [&points, &point, &result](const auto &item) {
-          points.emplace_back(item.first);
-          result.emplace_back(std::make_pair(
-              boost::geometry::distance(point, item.first), item.second));
-        });
+    for_each_nearest(point, k, [&envelope, &result](const distance_t distance,
+                                                    const auto &item) {
+      boost::geometry::expand(envelope, item.first);
+      result.emplace_back(std::make_pair(distance, item.second));
+    });
 
     // Are found points located around the requested point?
-    if (!boost::geometry::covered_by(
-            point, boost::geometry::return_envelope<
-                       boost::geometry::model::box<point_t>>(points))) {
+    if (!boost::geometry::covered_by(point, envelope)) {
       return {};
     }
     return result;
   }
 
+  /// Search for the K nearest neighbors of a given point, writing their
+  /// distances and values into the provided buffers. This method does not
+  /// allocate memory when the points are stored in the static index.
+  ///
+  /// @param point Point of interest
+  /// @param k The number of nearest neighbors to search.
+  /// @param within If true, no neighbors are returned if the point is not
+  /// located within its neighbors.
+  /// @param distances Buffer of at least k elements receiving the distances to
+  /// the neighbors, sorted by increasing distance.
+  /// @param values Buffer of at least k elements receiving the values of the
+  /// neighbors.
+  /// @param radius The maximum distance between the point and its neighbors.
+  /// @param eps Tolerance of an approximate search, see for_each_nearest.
+  /// @return the number of neighbors written to the buffers.
+  auto query(const point_t &point, const uint32_t k, const bool within,
+             distance_t *distances, Type *values,
+             const distance_t radius = std::numeric_limits<distance_t>::max(),
+             const distance_t eps = 0) const -> uint32_t {
+    auto count = 0U;
+    auto envelope = inverse_box();
+
+    for_each_nearest(point, k, radius, eps, [&](const distance_t distance,
+                                                const auto &item) {
+      if (within) {
+        boost::geometry::expand(envelope, item.first);
+      }
+      distances[count] = distance;
+      values[count] = item.second;
+      ++count;
+    });
+    if (within && !boost::geometry::covered_by(point, envelope)) {
+      return 0;
+    }
+    return count;
+  }
+
   /// Interpolation of the value at the requested position.
   ///
   /// @param point Point of interrest
@@ -175,35 +405,42 @@ class RTree {
   /// @param within If true, the method ensures that the neighbors found are
   /// located around the point of interest. In other words, this parameter
   /// ensures that the calculated values will not be extrapolated.
+  /// @param eps Tolerance of an approximate search of the neighbors, see
+  /// for_each_nearest.
   /// @return a tuple containing the interpolated value and the number of
   /// neighbors used in the calculation.
   auto inverse_distance_weighting(const point_t &point, distance_t radius,
-                                  uint32_t k, uint32_t p, bool within) const
+                                  uint32_t k, uint32_t p, bool within,
+                                  distance_t eps = 0) const
       -> std::pair<distance_t, uint32_t> {
     distance_t result = 0;
     distance_t total_weight = 0;
 
-    // We're looking for the nearest k points.
-    auto nearest = within ? query_within(point, k) : query(point, k);
+    // We're looking for the nearest k points. The test "within" is done on
+    // the k nearest points, wherever they are; otherwise, only the points
+    // located within the radius are searched.
+    auto &buffer = RTree::buffer(k);
+    auto count =
+        query(point, k, within, buffer.distances.data(), buffer.values.data(),
+              within ? std::numeric_limits<distance_t>::max() : radius, eps);
     uint32_t neighbors = 0;
 
     // For each point, the distance between the point requested and the point
     // found is calculated and the information required for the Inverse distance
     // weighting interpolation method is updated.
-    for (const auto &item : nearest) {
-      const auto distance = item.first;
+    for (auto ix = 0U; ix < count; ++ix) {
+      const auto distance = buffer.distances[ix];
       if (distance < 1e-6) {
         // If the user has requested a grid point, the mesh value is returned.
-        return std::make_pair(item.second, k);
+        return std::make_pair(buffer.values[ix], k);
       }
 
       if (distance <= radius) {
         // If the neighbor found is within an acceptable radius it can be taken
         // into account in the calculation.
-        auto wk =
-            static_cast<Type>(1 / std::pow(distance, static_cast<Type>(p)));
+        auto wk = static_cast<Type>(RTree::inverse_power(distance, p));
         total_weight += wk;
-        result += item.second * wk;
+        result += buffer.values[ix] * wk;
         ++neighbors;
       }
     }
@@ -229,27 +466,16 @@ class RTree {
   auto nearest(const point_t &point, const distance_t radius,
                const uint32_t k) const
       -> std::tuple<Matrix<promotion_t>, Vector<promotion_t>> {
+    auto memory = profiling::Allocation(
+        profiling::kRTreeQuery, (N + 1) * k * sizeof(promotion_t));
     auto coordinates = Matrix<promotion_t>(N, k);
     auto values = Vector<promotion_t>(k);
-    auto jx = 0U;
-
-    std::for_each(
-        tree_->qbegin(boost::geometry::index::nearest(point, k)), tree_->qend(),
-        [&](const auto &item) {
-          if (boost::geometry::distance(point, item.first) <= radius) {
-            // If the point is not too far away, it is inserted and
-            // its coordinates and value are stored.
-            for (size_t ix = 0; ix < N; ++ix) {
-              coordinates(ix, jx) = geometry::point::get(item.first, ix);
-            }
-            values(jx++) = item.second;
-          }
-        });
+    auto count = nearest(point, radius, k, false, coordinates, values);
 
     // The arrays are resized according to the number of selected points. This
     // number can be zero.
-    coordinates.conservativeResize(N, jx);
-    values.conservativeResize(jx);
+    coordinates.conservativeResize(N, count);
+    values.conservativeResize(count);
     return std::make_tuple(coordinates, values);
   }
 
@@ -265,41 +491,63 @@ class RTree {
   auto nearest_within(const point_t &point, const distance_t radius,
                       const uint32_t k) const
       -> std::tuple<Matrix<promotion_t>, Vector<promotion_t>> {
-    auto points = boost::geometry::model::multi_point<point_t>();
+    auto memory = profiling::Allocation(
+        profiling::kRTreeQuery, (N + 1) * k * sizeof(promotion_t));
     auto coordinates = Matrix<promotion_t>(N, k);
     auto values = Vector<promotion_t>(k);
-    auto jx = 0U;
+    auto count = nearest(point, radius, k, true, coordinates, values);
+
+    // The arrays are resized according to the number of selected points. This
+    // number can be zero.
+    coordinates.conservativeResize(N, count);
+    values.conservativeResize(count);
+    return std::make_tuple(coordinates, values);
+  }
 
-    // List of selected points ()
-    points.reserve(k);
+  /// Search for the nearest K neighbors of a given point located within a
+  /// radius, writing their coordinates and values into the provided buffers.
+  ///
+  /// @param point Point of interest
+  /// @param radius The maximum radius of the search.
+  /// @param k The number of nearest neighbors to search.
+  /// @param within If true, no neighbors are returned if the point is not
+  /// located within its selected neighbors.
+  /// @param coordinates Matrix of at least k columns receiving the coordinates
+  /// of the selected points in its first columns.
+  /// @param values Vector of at least k elements receiving the values of the
+  /// selected points.
+  /// @param items If not null, array of at least k elements receiving the
+  /// address of the selected points in the index.
+  /// @return the number of selected points.
+  auto nearest(const point_t &point, const distance_t radius, const uint32_t k,
+               const bool within, Matrix<promotion_t> &coordinates,
+               Vector<promotion_t> &values,
+               const value_t **items = nullptr) const -> Eigen::Index {
+    auto envelope = inverse_box();
+    auto jx = Eigen::Index(0);
 
-    std::for_each(
-        tree_->qbegin(boost::geometry::index::nearest(point, k)), tree_->qend(),
-        [&](const auto &item) {
-          if (boost::geometry::distance(point, item.first) <= radius) {
-            // If the point is not too far away, it is inserted and
-            // its coordinates and value are stored.
-            points.emplace_back(item.first);
-            for (size_t ix = 0; ix < N; ++ix) {
-              coordinates(ix, jx) = geometry::point::get(item.first, ix);
-            }
-            values(jx++) = item.second;
-          }
-        });
+    // Only the points located within the radius are searched.
+    for_each_nearest(point, k, radius,
+                     [&](const distance_t /*distance*/, const auto &item) {
+                       if (within) {
+                         boost::geometry::expand(envelope, item.first);
+                       }
+                       for (size_t ix = 0; ix < N; ++ix) {
+                         coordinates(ix, jx) =
+                             geometry::point::get(item.first, ix);
+                       }
+                       if (items != nullptr) {
+                         items[jx] = &item;
+                       }
+                       values(jx++) = item.second;
+                     });
 
     // If the point is not covered by its closest neighbors, an empty set will
     // be returned.
-    if (!boost::geometry::covered_by(
-            point, boost::geometry::return_envelope<
-                       boost::geometry::model::box<point_t>>(points))) {
-      jx = 0;
+    if (within && !boost::geometry::covered_by(point, envelope)) {
+      return 0;
     }
-
-    // The arrays are resized according to the number of selected points. This
-    // number can be zero.
-    coordinates.conservativeResize(N, jx);
-    values.conservativeResize(jx);
-    return std::make_tuple(coordinates, values);
+    return jx;
   }
 
   /// Interpolate the value of a point using a Radial Basis Function.
@@ -312,24 +560,250 @@ class RTree {
   /// @param within If true, the method ensures that the neighbors found are
   /// located around the point of interest. In other words, this parameter
   /// ensures that the calculated values will not be extrapolated.
+  /// @param cache If not null, the interpolants solved are stored in this
+  /// cache, and reused for the points whose neighbors are the same. The cache
+  /// must not outlive the current state of the index, nor be shared between
+  /// different RBF instances.
   /// @return A pair containing the interpolated value and the number of
   /// neighbors used in the calculation.
   auto radial_basis_function(const point_t &point,
                              const math::RBF<promotion_t> &rbf,
-                             distance_t radius, uint32_t k, bool within) const
+                             distance_t radius, uint32_t k, bool within,
+                             rbf_cache_t *cache = nullptr) const
       -> std::pair<promotion_t, uint32_t> {
-    auto [coordinates, values] =
-        within ? nearest_within(point, radius, k) : nearest(point, radius, k);
-    if (values.size() == 0) {
+    auto &buffer = RTree::buffer(k);
+    auto count = nearest(point, radius, k, within, buffer.coordinates,
+                         buffer.points, buffer.items.data());
+    if (count == 0) {
       return std::make_pair(std::numeric_limits<promotion_t>::quiet_NaN(), 0);
     }
     auto xi = Eigen::Matrix<promotion_t, N, 1>();
     for (size_t ix = 0; ix < N; ++ix) {
       xi(ix, 0) = geometry::point::get(point, ix);
     }
-    auto interpolated = rbf.interpolate(coordinates, values, xi);
-    return std::make_pair(interpolated(0),
-                          static_cast<uint32_t>(values.size()));
+    auto solve = [&]() {
+      return rbf.fit(buffer.coordinates.leftCols(count),
+                     buffer.points.head(count));
+    };
+    if (cache == nullptr) {
+      return std::make_pair(rbf.evaluate(solve(), xi)(0),
+                            static_cast<uint32_t>(count));
+    }
+    return std::make_pair(
+        rbf.evaluate(cache->get(RTree::key(count), solve), xi)(0),
+        static_cast<uint32_t>(count));
+  }
+
+  /// Interpolate the values of a block of points using a Radial Basis
+  /// Function.
+  ///
+  /// The neighborhoods of the points are gathered first, then the linear
+  /// systems of the points whose interpolant is not cached are solved
+  /// together by a batched solver, padded to k nodes. The systems found
+  /// singular are solved again, one by one, by a LU decomposition with full
+  /// pivoting.
+  ///
+  /// @param points Points of interest
+  /// @param size Number of points, at most kRBFBatchSize.
+  /// @param rbf The radial basis function to be used.
+  /// @param radius The maximum radius of the search.
+  /// @param k The number of nearest neighbors to be used for calculating the
+  /// interpolated value.
+  /// @param within If true, the method ensures that the neighbors found are
+  /// located around the point of interest.
+  /// @param cache Cache of the interpolants solved, shared by the blocks
+  /// interpolated by the calling thread.
+  /// @param batch Buffers of the neighborhoods, allocated for k neighbors.
+  /// @param values Array of size elements receiving the interpolated values.
+  /// @param neighbors Array of size elements receiving the number of
+  /// neighbors used in the calculation.
+  auto radial_basis_function(const point_t *points, const size_t size,
+                             const math::RBF<promotion_t> &rbf,
+                             distance_t radius, uint32_t k, bool within,
+                             rbf_cache_t &cache, RBFBatch &batch,
+                             promotion_t *values, uint32_t *neighbors) const
+      -> void {
+    assert(size <= kRBFBatchSize);
+    // Lane solving the system of each point, or -1 if the point does not
+    // need to be solved.
+    auto lanes = std::array<int, kRBFBatchSize>();
+    auto counts = std::array<Eigen::Index, kRBFBatchSize>();
+    auto epsilon = std::array<promotion_t, kRBFBatchSize>();
+    auto pending = false;
+
+    for (size_t ix = 0; ix < size; ++ix) {
+      auto &buffer = RTree::buffer(k);
+      auto &coordinates = batch.coordinates[ix];
+      lanes[ix] = -1;
+      counts[ix] = nearest(points[ix], radius, k, within, coordinates,
+                           batch.values[ix], buffer.items.data());
+      neighbors[ix] = static_cast<uint32_t>(counts[ix]);
+      if (counts[ix] == 0) {
+        values[ix] = std::numeric_limits<promotion_t>::quiet_NaN();
+        continue;
+      }
+      batch.keys[ix] = RTree::key(counts[ix]);
+      const auto *interpolant = cache.find(batch.keys[ix]);
+      if (interpolant != nullptr) {
+        values[ix] = rbf.evaluate(*interpolant, RTree::column(points[ix]))(0);
+        continue;
+      }
+      // The points of the block sharing the same neighbors are solved once.
+      lanes[ix] = static_cast<int>(ix);
+      for (size_t jx = 0; jx < ix; ++jx) {
+        if (lanes[jx] == static_cast<int>(jx) &&
+            batch.keys[jx] == batch.keys[ix]) {
+          lanes[ix] = static_cast<int>(jx);
+          break;
+        }
+      }
+      if (lanes[ix] == static_cast<int>(ix)) {
+        batch.solver.set(ix,
+                         rbf.system(coordinates.leftCols(counts[ix]),
+                                    epsilon[ix]),
+                         batch.values[ix].head(counts[ix]));
+        pending = true;
+      }
+    }
+    if (!pending) {
+      return;
+    }
+
+    const auto regular = batch.solver.solve();
+    for (size_t ix = 0; ix < size; ++ix) {
+      if (lanes[ix] != static_cast<int>(ix)) {
+        continue;
+      }
+      auto xk = batch.coordinates[ix].leftCols(counts[ix]);
+      auto solution = typename math::RBF<promotion_t>::Interpolant();
+      if (regular[ix]) {
+        solution = {xk, batch.solver.solution(ix, counts[ix]), epsilon[ix]};
+      } else {
+        solution = rbf.fit(xk, batch.values[ix].head(counts[ix]));
+      }
+      const auto &interpolant =
+          cache.put(batch.keys[ix], std::move(solution));
+      for (size_t jx = ix; jx < size; ++jx) {
+        if (lanes[jx] == static_cast<int>(ix)) {
+          values[jx] = rbf.evaluate(interpolant, RTree::column(points[jx]))(0);
+        }
+      }
+    }
+  }
+
+  /// Estimate the value of a point by ordinary kriging.
+  ///
+  /// @param point Point of interest
+  /// @param kriging The kriging model to be used.
+  /// @param radius The maximum radius of the search.
+  /// @param k The number of nearest neighbors to be used for calculating the
+  /// estimated value.
+  /// @param within If true, the method ensures that the neighbors found are
+  /// located around the point of interest. In other words, this parameter
+  /// ensures that the calculated values will not be extrapolated.
+  /// @param cache If not null, the kriging systems factorized are stored in
+  /// this cache, and reused for the points whose neighbors are the same. The
+  /// cache must not outlive the current state of the index, nor be shared
+  /// between different kriging models.
+  /// @return A tuple containing the estimated value, the variance of the
+  /// estimation error and the number of neighbors used in the calculation.
+  auto kriging(const point_t &point, const math::Kriging<promotion_t> &kriging,
+               distance_t radius, uint32_t k, bool within,
+               kriging_cache_t *cache = nullptr) const
+      -> std::tuple<promotion_t, promotion_t, uint32_t> {
+    auto &buffer = RTree::buffer(k);
+    auto count = nearest(point, radius, k, within, buffer.coordinates,
+                         buffer.points, buffer.items.data());
+    if (count == 0) {
+      return std::make_tuple(std::numeric_limits<promotion_t>::quiet_NaN(),
+                             std::numeric_limits<promotion_t>::quiet_NaN(), 0);
+    }
+    auto xi = Eigen::Matrix<promotion_t, N, 1>();
+    for (size_t ix = 0; ix < N; ++ix) {
+      xi(ix, 0) = geometry::point::get(point, ix);
+    }
+    auto solve = [&]() {
+      return kriging.fit(buffer.coordinates.leftCols(count),
+                         buffer.points.head(count));
+    };
+    auto [value, variance] =
+        cache == nullptr
+            ? kriging.evaluate(solve(), xi)
+            : kriging.evaluate(cache->get(RTree::key(count), solve), xi);
+    return std::make_tuple(value, variance, static_cast<uint32_t>(count));
+  }
+
+  /// Solves the interpolant defined over all the points of the index by a
+  /// compactly supported radial basis function. The neighbors of each point
+  /// are searched within the support radius of the function.
+  ///
+  /// @param rbf The radial basis function to be used.
+  /// @param max_iterations Maximum number of iterations of the solver.
+  /// @param tolerance Relative residual error below which the solution is
+  /// accepted.
+  /// @param num_threads The number of threads to use for the computation. If
+  /// 0 all CPUs are used.
+  /// @return The interpolant, to be evaluated by compact_radial_basis_function.
+  auto fit_compact_radial_basis_function(
+      const math::CompactRBF<promotion_t> &rbf,
+      const Eigen::Index max_iterations, const promotion_t tolerance,
+      const size_t num_threads) const
+      -> CompactInterpolant {
+    auto index = std::shared_ptr<const kdtree_t>(kdtree_);
+    if (!index || !tree_->empty() || num_removed_ != 0) {
+      // The points of the dynamic index are numbered by a static index.
+      index = std::make_shared<kdtree_t>(values(), num_threads);
+    }
+    auto size = index->size();
+    if (size == 0) {
+      return {std::move(index), Vector<promotion_t>()};
+    }
+    auto neighbors =
+        std::vector<typename math::CompactRBF<promotion_t>::Neighbors>(size);
+    auto values = Vector<promotion_t>(size);
+
+    dispatch(
+        [&](size_t start, size_t end) {
+          for (auto ix = start; ix < end; ++ix) {
+            const auto &item = (*index)[ix];
+            for (const auto &[distance, jx] :
+                 index->within(item.first, rbf.support())) {
+              neighbors[ix].emplace_back(static_cast<Eigen::Index>(jx),
+                                         static_cast<promotion_t>(distance));
+            }
+            values(ix) = static_cast<promotion_t>(item.second);
+          }
+        },
+        size, num_threads);
+    auto weights = rbf.fit(neighbors, values, max_iterations, tolerance);
+    return {std::move(index), std::move(weights)};
+  }
+
+  /// Interpolate the value of a point using an interpolant solved by
+  /// fit_compact_radial_basis_function.
+  ///
+  /// @param point Point of interest
+  /// @param rbf The radial basis function used to solve the interpolant.
+  /// @param interpolant The interpolant solved.
+  /// @return A pair containing the interpolated value and the number of
+  /// neighbors used in the calculation. The value is undefined if no point is
+  /// located within the support radius.
+  static auto compact_radial_basis_function(
+      const point_t &point, const math::CompactRBF<promotion_t> &rbf,
+      const CompactInterpolant &interpolant)
+      -> std::pair<promotion_t, uint32_t> {
+    auto result = promotion_t(0);
+    auto neighbors = uint32_t(0);
+    for (const auto &[distance, ix] :
+         interpolant.index->within(point, rbf.support())) {
+      result += interpolant.weights(static_cast<Eigen::Index>(ix)) *
+                rbf(static_cast<promotion_t>(distance));
+      ++neighbors;
+    }
+    return neighbors != 0
+               ? std::make_pair(result, neighbors)
+               : std::make_pair(std::numeric_limits<promotion_t>::quiet_NaN(),
+                                neighbors);
   }
 
   /// Interpolate the value of a point using a Window Function.
@@ -342,24 +816,210 @@ class RTree {
   /// @param within If true, the method ensures that the neighbors found are
   /// located around the point of interest. In other words, this parameter
   /// ensures that the calculated values will not be extrapolated.
+  /// @param eps Tolerance of an approximate search of the neighbors, see
+  /// for_each_nearest.
   /// @return A pair containing the interpolated value and the number of
   /// neighbors used in the calculation.
   auto window_function(const point_t &point,
                        const math::WindowFunction<distance_t> &wf,
                        const distance_t arg, distance_t radius, uint32_t k,
-                       bool within) const -> std::pair<distance_t, uint32_t> {
+                       bool within, distance_t eps = 0) const
+      -> std::pair<distance_t, uint32_t> {
+    return weighted_average(point, k, within, eps,
+                            [&](const distance_t distance) -> distance_t {
+                              return wf(distance, radius, arg);
+                            });
+  }
+
+  /// Interpolation of the value at the requested position by a window
+  /// function tabulated for the radius of the search and its argument.
+  ///
+  /// @param point Point of interest
+  /// @param wf The window function tabulated.
+  /// @param k The number of nearest neighbors to be used for calculating the
+  /// interpolated value.
+  /// @param within If true, the method ensures that the neighbors found are
+  /// located around the point of interest.
+  /// @param eps Tolerance of an approximate search of the neighbors, see
+  /// for_each_nearest.
+  /// @return A pair containing the interpolated value and the number of
+  /// neighbors used in the calculation.
+  auto window_function(const point_t &point,
+                       const math::WindowFunctionTable<distance_t> &wf,
+                       uint32_t k, bool within, distance_t eps = 0) const
+      -> std::pair<distance_t, uint32_t> {
+    return weighted_average(point, k, within, eps, wf);
+  }
+
+  /// Calls a function with the distance and the value of the K nearest
+  /// neighbors of a given point, sorted by increasing distance. This method
+  /// does not allocate memory when the points are stored in the static index.
+  ///
+  /// @param point Point of interest
+  /// @param k The number of nearest neighbors to search.
+  /// @param func Function called with the distance and the value of each
+  /// neighbor.
+  template <typename Function>
+  auto for_each_nearest(const point_t &point, const uint32_t k,
+                        Function &&func) const -> void {
+    for_each_nearest(point, k, std::numeric_limits<distance_t>::max(),
+                     std::forward<Function>(func));
+  }
+
+  /// Calls a function with the distance and the value of the K nearest
+  /// neighbors of a given point located within a radius, sorted by increasing
+  /// distance. The parts of the index located beyond the radius are not
+  /// explored.
+  ///
+  /// @param point Point of interest
+  /// @param k The number of nearest neighbors to search.
+  /// @param radius The maximum distance between the point and its neighbors.
+  /// @param func Function called with the distance and the value of each
+  /// neighbor.
+  template <typename Function>
+  auto for_each_nearest(const point_t &point, const uint32_t k,
+                        const distance_t radius, Function &&func) const
+      -> void {
+    for_each_nearest(point, k, radius, 0, std::forward<Function>(func));
+  }
+
+  /// Calls a function with the distance and the value of K approximate
+  /// nearest neighbors of a given point located within a radius, sorted by
+  /// increasing distance.
+  ///
+  /// The parts of the static index that cannot contain a point closer than
+  /// the worst candidate divided by (1 + eps) are not explored: the i-th
+  /// neighbor found is at most (1 + eps) times farther than the true i-th
+  /// nearest neighbor. The points of the dynamic index are searched exactly.
+  ///
+  /// @param point Point of interest
+  /// @param k The number of nearest neighbors to search.
+  /// @param radius The maximum distance between the point and its neighbors.
+  /// @param eps Tolerance of the search. If 0, the search is exact.
+  /// @param func Function called with the distance and the value of each
+  /// neighbor.
+  template <typename Function>
+  auto for_each_nearest(const point_t &point, const uint32_t k,
+                        const distance_t radius, const distance_t eps,
+                        Function &&func) const -> void {
+    auto scope = profiling::Scope(profiling::kRTreeQuery);
+    if (kdtree_) {
+      // The candidates of the search are stored in a buffer reused by all the
+      // queries of the thread.
+      thread_local auto candidates =
+          std::vector<typename kdtree_t::result_t>();
+      kdtree_->nearest(point, k, radius, candidates, removed(), eps);
+      if (tree_->empty()) {
+        for (const auto &item : candidates) {
+          func(item.first, (*kdtree_)[item.second]);
+        }
+        return;
+      }
+      // The neighbors found in both indexes are merged.
+      thread_local auto merged =
+          std::vector<std::pair<distance_t, const value_t *>>();
+      merged.clear();
+      for (const auto &item : candidates) {
+        merged.emplace_back(item.first, &(*kdtree_)[item.second]);
+      }
+      const auto middle = static_cast<std::ptrdiff_t>(merged.size());
+      for_each_nearest_delta(
+          point, k, radius, [](const distance_t distance, const auto &item) {
+            merged.emplace_back(distance, &item);
+          });
+      std::inplace_merge(merged.begin(), merged.begin() + middle, merged.end(),
+                         [](const auto &lhs, const auto &rhs) {
+                           return lhs.first < rhs.first;
+                         });
+      merged.resize(std::min(merged.size(), static_cast<size_t>(k)));
+      for (const auto &item : merged) {
+        func(item.first, *item.second);
+      }
+      return;
+    }
+    for_each_nearest_delta(point, k, radius, std::forward<Function>(func));
+  }
+
+ protected:
+  /// Geographic index used to store data and their searches.
+  std::shared_ptr<rtree_t> tree_;
+
+  /// Static index built by the packing algorithm, or nullptr if the values
+  /// are stored in the dynamic index.
+  std::shared_ptr<kdtree_t> kdtree_{};
+
+ private:
+  /// Minimum number of changes buffered before the index is repacked.
+  static constexpr size_t kMinDeltaSize = 4096;
+
+  /// The index is repacked when the number of changes buffered exceeds this
+  /// fraction of the static index.
+  static constexpr size_t kDeltaRatio = 8;
+
+  /// Flags of the points of the static index that have been removed, empty
+  /// if no points have been removed.
+  std::vector<uint8_t> removed_{};
+
+  /// Number of points of the static index that have been removed.
+  size_t num_removed_{0};
+
+  /// Calls a function with the distance and the value of the K nearest
+  /// neighbors of a given point located within a radius, found in the
+  /// R*Tree.
+  template <typename Function>
+  auto for_each_nearest_delta(const point_t &point, const uint32_t k,
+                              const distance_t radius, Function &&func) const
+      -> void {
+    auto callback = [&point, &func, radius](const auto &item) {
+      auto distance = boost::geometry::distance(point, item.first);
+      if (distance <= radius) {
+        func(distance, item);
+      }
+    };
+    if (radius == std::numeric_limits<distance_t>::max()) {
+      std::for_each(tree_->qbegin(boost::geometry::index::nearest(point, k)),
+                    tree_->qend(), callback);
+      return;
+    }
+    // The nodes not intersecting the box bounding the search radius are
+    // pruned. The points of the box located beyond the radius are farther
+    // than all the points located within it, so they can only take the last
+    // places of the k nearest neighbors.
+    auto box = boost::geometry::model::box<point_t>();
+    for (size_t ix = 0; ix < N; ++ix) {
+      const auto coordinate =
+          static_cast<distance_t>(geometry::point::get(point, ix));
+      geometry::point::set(box.min_corner(),
+                           static_cast<CoordinateType>(coordinate - radius),
+                           ix);
+      geometry::point::set(box.max_corner(),
+                           static_cast<CoordinateType>(coordinate + radius),
+                           ix);
+    }
+    std::for_each(tree_->qbegin(boost::geometry::index::nearest(point, k) &&
+                                boost::geometry::index::intersects(box)),
+                  tree_->qend(), callback);
+  }
+
+  /// Calculates the average of the values of the K nearest neighbors of a
+  /// point, weighted by a function of their distance.
+  template <typename Weight>
+  auto weighted_average(const point_t &point, uint32_t k, bool within,
+                        distance_t eps, const Weight &weight) const
+      -> std::pair<distance_t, uint32_t> {
     distance_t result = 0;
     distance_t total_weight = 0;
 
-    auto nearest = within ? query_within(point, k) : query(point, k);
+    auto &buffer = RTree::buffer(k);
+    auto count = query(point, k, within, buffer.distances.data(),
+                       buffer.values.data(),
+                       std::numeric_limits<distance_t>::max(), eps);
     uint32_t neighbors = 0;
 
-    for (const auto &item : nearest) {
-      const auto distance = item.first;
-
-      auto wk = wf(distance, radius, arg);
+    for (auto ix = 0U; ix < count; ++ix) {
+      auto wk = weight(buffer.distances[ix]);
       total_weight += wk;
-      result += item.second * wk;
+      result += buffer.values[ix] * wk;
       ++neighbors;
     }
 
@@ -370,9 +1030,114 @@ class RTree {
                                 static_cast<uint32_t>(0));
   }
 
- protected:
-  /// Geographic index used to store data and their searches.
-  std::shared_ptr<rtree_t> tree_;
+  /// Returns the flags of the points removed from the static index, or
+  /// nullptr if no points have been removed.
+  [[nodiscard]] auto removed() const noexcept -> const uint8_t * {
+    return removed_.empty() ? nullptr : removed_.data();
+  }
+
+  /// Returns true if the point of the static index has been removed.
+  [[nodiscard]] auto is_removed(const size_t ix) const noexcept -> bool {
+    return !removed_.empty() && removed_[ix] != 0;
+  }
+
+  /// Forgets the points removed from the static index.
+  auto reset_removed() -> void {
+    removed_.clear();
+    num_removed_ = 0;
+  }
+
+  /// Returns a copy of the values stored in the container.
+  [[nodiscard]] auto values() const -> std::vector<value_t> {
+    auto result = std::vector<value_t>();
+    result.reserve(size());
+    for_each([&result](const auto &item) { result.push_back(item); });
+    return result;
+  }
+
+  /// Packs all the values into a new static index if the changes buffered
+  /// since the last packing are too many.
+  auto fold(const size_t num_threads) -> void {
+    if (tree_->size() + num_removed_ <=
+        std::max(kMinDeltaSize, kdtree_->size() / kDeltaRatio)) {
+      return;
+    }
+    packing(values(), num_threads);
+  }
+
+  /// Buffers reused by the queries of a thread.
+  struct Buffer {
+    std::vector<distance_t> distances;
+    std::vector<Type> values;
+    Matrix<promotion_t> coordinates;
+    Vector<promotion_t> points;
+    std::vector<const value_t *> items;
+    std::vector<const value_t *> key;
+  };
+
+  /// Returns the buffers of the calling thread, able to hold k neighbors.
+  static auto buffer(const uint32_t k) -> Buffer & {
+    thread_local auto result = Buffer();
+    if (result.distances.size() < k) {
+      result.distances.resize(k);
+      result.values.resize(k);
+      result.coordinates.resize(N, k);
+      result.points.resize(k);
+      result.items.resize(k);
+    }
+    return result;
+  }
+
+  /// Returns the coordinates of a point as a column vector.
+  static auto column(const point_t &point) -> Eigen::Matrix<promotion_t, N, 1> {
+    auto result = Eigen::Matrix<promotion_t, N, 1>();
+    for (size_t ix = 0; ix < N; ++ix) {
+      result(ix, 0) = geometry::point::get(point, ix);
+    }
+    return result;
+  }
+
+  /// Returns the key identifying the neighbors written into the buffer of
+  /// the calling thread by the last search, regardless of their distance to
+  /// the point.
+  static auto key(const Eigen::Index count)
+      -> const std::vector<const value_t *> & {
+    auto &buffer = RTree::buffer(0);
+    buffer.key.assign(buffer.items.begin(), buffer.items.begin() + count);
+    std::sort(buffer.key.begin(), buffer.key.end());
+    return buffer.key;
+  }
+
+  /// Calculates 1 / x^p. The power parameter is an integer, usually 2, so
+  /// the power is computed by multiplications rather than by std::pow.
+  static constexpr auto inverse_power(const distance_t x, uint32_t p)
+      -> distance_t {
+    switch (p) {
+      case 1:
+        return 1 / x;
+      case 2:
+        return 1 / (x * x);
+      default:
+        break;
+    }
+    auto result = distance_t(1);
+    auto base = x;
+    while (p != 0) {
+      if (p & 1U) {
+        result *= base;
+      }
+      base *= base;
+      p >>= 1U;
+    }
+    return 1 / result;
+  }
+
+  /// Returns an empty box that can be expanded to the envelope of points.
+  static auto inverse_box() -> boost::geometry::model::box<point_t> {
+    auto result = boost::geometry::model::box<point_t>();
+    boost::geometry::assign_inverse(result);
+    return result;
+  }
 };
 
 }  // namespace pyinterp::detail::geometry
@@ -0,0 +1,222 @@
+// Copyright (c) 2022 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <map>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "pyinterp/detail/geometry/kdtree.hpp"
+
+namespace pyinterp::detail::geometry {
+
+/// Spatial index split into shards identified by an integer key.
+///
+/// Each shard is a static K-d tree built from the points sharing the same
+/// key, or mapped in memory from a file written by save(): a process can only
+/// open the shards it serves. A search visits the shards chosen by the caller
+/// and merges the neighbors found in each of them: the shards are explored
+/// within the distance to the farthest of the K best candidates found so far,
+/// so that the shards visited last are usually pruned at once.
+///
+/// @tparam CoordinateType The class of storage for a point's coordinates.
+/// @tparam Type The type of data stored in the index.
+/// @tparam N Number of dimensions in the Cartesian space handled.
+template <typename CoordinateType, typename Type, size_t N>
+class ShardedIndex {
+ public:
+  /// Static index of a shard
+  using kdtree_t = KDTree<CoordinateType, Type, N>;
+
+  /// Type of point coordinates
+  using point_t = typename kdtree_t::point_t;
+
+  /// Type of distances between two points
+  using distance_t = typename kdtree_t::distance_t;
+
+  /// Value handled by this object
+  using value_t = typename kdtree_t::value_t;
+
+  /// Neighbor found by a search: its distance to the point of interest and
+  /// the value stored in the index.
+  using neighbor_t = std::pair<distance_t, const value_t *>;
+
+  /// Returns the number of points stored in the index.
+  [[nodiscard]] auto size() const noexcept -> size_t { return size_; }
+
+  /// Query if the index is empty.
+  [[nodiscard]] auto empty() const noexcept -> bool { return size_ == 0; }
+
+  /// Returns the number of shards of the index.
+  [[nodiscard]] auto shards() const noexcept -> size_t {
+    return shards_.size();
+  }
+
+  /// Returns the keys of the shards, sorted in ascending order.
+  [[nodiscard]] auto keys() const -> std::vector<uint64_t> {
+    auto result = std::vector<uint64_t>();
+    result.reserve(shards_.size());
+    for (const auto &item : shards_) {
+      result.push_back(item.first);
+    }
+    return result;
+  }
+
+  /// Returns the number of points stored in a shard, 0 if the shard does not
+  /// exist.
+  [[nodiscard]] auto shard_size(const uint64_t key) const -> size_t {
+    auto it = shards_.find(key);
+    return it == shards_.end() ? 0 : it->second.size();
+  }
+
+  /// Removes all points stored in the index.
+  auto clear() -> void {
+    shards_.clear();
+    size_ = 0;
+  }
+
+  /// Replaces the content of the index by the provided points.
+  ///
+  /// @param values Points to index.
+  /// @param keys Keys of the shards storing the points.
+  /// @param num_threads The number of threads used to build each shard.
+  auto packing(std::vector<value_t> values, const std::vector<uint64_t> &keys,
+               const size_t num_threads) -> void {
+    if (values.size() != keys.size()) {
+      throw std::invalid_argument(
+          "values and keys could not be broadcast together");
+    }
+    clear();
+    auto order = std::vector<size_t>(values.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(),
+                     [&](const auto lhs, const auto rhs) {
+                       return keys[lhs] < keys[rhs];
+                     });
+    auto first = order.begin();
+    while (first != order.end()) {
+      const auto key = keys[*first];
+      auto last = std::find_if(first, order.end(), [&](const auto ix) {
+        return keys[ix] != key;
+      });
+      auto shard = std::vector<value_t>();
+      shard.reserve(static_cast<size_t>(std::distance(first, last)));
+      std::for_each(first, last,
+                    [&](const auto ix) { shard.push_back(values[ix]); });
+      shards_.emplace(key, kdtree_t(std::move(shard), num_threads));
+      first = last;
+    }
+    size_ = values.size();
+  }
+
+  /// Writes a shard to a file that load() maps in memory.
+  ///
+  /// @param key Key of the shard to write.
+  /// @param path Path to the file to create.
+  /// @param metadata User data stored in the header of the file.
+  auto save(const uint64_t key, const std::string &path,
+            const std::string &metadata) const -> void {
+    auto it = shards_.find(key);
+    if (it == shards_.end()) {
+      throw std::invalid_argument("the index has no shard " +
+                                  std::to_string(key));
+    }
+    it->second.save(path, metadata);
+  }
+
+  /// Opens a shard written by save(), replacing the shard of the same key if
+  /// it exists. The file is mapped read-only in memory.
+  ///
+  /// @param key Key of the shard.
+  /// @param path Path to the file to open.
+  /// @return The user data stored in the header of the file.
+  auto load(const uint64_t key, const std::string &path) -> std::string {
+    auto [kdtree, metadata] = kdtree_t::load(path);
+    size_ -= shard_size(key);
+    size_ += kdtree.size();
+    shards_[key] = std::move(kdtree);
+    return metadata;
+  }
+
+  /// Search for the K nearest neighbors of a given point located within a
+  /// radius, in one shard, and merges them with the neighbors already found.
+  ///
+  /// @param point Point of interest
+  /// @param key Key of the shard to explore. Nothing is done if the shard
+  /// does not exist.
+  /// @param k The number of nearest neighbors to search.
+  /// @param radius The maximum distance between the point and its neighbors.
+  /// @param neighbors The K best neighbors found so far, sorted by increasing
+  /// distance, updated with those of the shard.
+  auto nearest(const point_t &point, const uint64_t key, const uint32_t k,
+               const distance_t radius,
+               std::vector<neighbor_t> &neighbors) const -> void {
+    auto it = shards_.find(key);
+    if (k == 0 || it == shards_.end()) {
+      return;
+    }
+    // The candidates of the searches are stored in buffers reused by all the
+    // queries of the thread.
+    thread_local auto candidates = std::vector<typename kdtree_t::result_t>();
+    thread_local auto merged = std::vector<neighbor_t>();
+
+    // The shard is only searched for points closer than the worst of the K
+    // neighbors already found.
+    const auto bound = neighbors.size() < k ? radius : neighbors.back().first;
+    const auto &kdtree = it->second;
+    kdtree.nearest(point, k, bound, candidates);
+    if (candidates.empty()) {
+      return;
+    }
+    merged.clear();
+    auto lhs = neighbors.begin();
+    auto rhs = candidates.begin();
+    while (merged.size() < k &&
+           (lhs != neighbors.end() || rhs != candidates.end())) {
+      if (rhs == candidates.end() ||
+          (lhs != neighbors.end() && lhs->first <= rhs->first)) {
+        merged.push_back(*lhs++);
+      } else {
+        merged.emplace_back(rhs->first, &kdtree[rhs->second]);
+        ++rhs;
+      }
+    }
+    neighbors.swap(merged);
+  }
+
+  /// Search for the K nearest neighbors of a given point located within a
+  /// radius, among the points stored in the given shards.
+  ///
+  /// @param point Point of interest
+  /// @param first Iterator to the first key of the shards to explore.
+  /// @param last Iterator past the last key of the shards to explore.
+  /// @param k The number of nearest neighbors to search.
+  /// @param radius The maximum distance between the point and its neighbors.
+  /// @param neighbors Vector receiving the K nearest neighbors sorted by
+  /// increasing distance.
+  template <typename Iterator>
+  auto nearest(const point_t &point, Iterator first, Iterator last,
+               const uint32_t k, const distance_t radius,
+               std::vector<neighbor_t> &neighbors) const -> void {
+    neighbors.clear();
+    for (; first != last; ++first) {
+      nearest(point, *first, k, radius, neighbors);
+    }
+  }
+
+ private:
+  /// Number of points stored
+  size_t size_{0};
+
+  /// Static indexes of the shards, by key.
+  std::map<uint64_t, kdtree_t> shards_{};
+};
+
+}  // namespace pyinterp::detail::geometry
@@ -0,0 +1,267 @@
+// Copyright (c) 2022 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <map>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "pyinterp/detail/geometry/kdtree.hpp"
+
+namespace pyinterp::detail::geometry {
+
+/// Spatio-temporal index of observations dated by an integer time.
+///
+/// The observations are split into partitions covering consecutive periods
+/// of time, [key * period, (key + 1) * period), each indexed by a static K-d
+/// tree. A search of the neighbors observed within a time window only
+/// explores the partitions overlapping the window: one index covers a long
+/// period of time without slowing down the queries restricted to a few
+/// hours. The observations of the partitions at the edges of the window are
+/// filtered by their time during the search.
+///
+/// @tparam CoordinateType The class of storage for a point's coordinates.
+/// @tparam Type The type of data stored in the index.
+/// @tparam N Number of dimensions in the Cartesian space handled.
+template <typename CoordinateType, typename Type, size_t N>
+class TemporalIndex {
+ public:
+  /// Observation stored in the index.
+  struct Observation {
+    /// Time of the observation
+    int64_t time;
+    /// Value observed
+    Type value;
+  };
+
+  /// Static index of a partition
+  using kdtree_t = KDTree<CoordinateType, Observation, N>;
+
+  /// Type of point coordinates
+  using point_t = typename kdtree_t::point_t;
+
+  /// Type of distances between two points
+  using distance_t = typename kdtree_t::distance_t;
+
+  /// Value handled by this object
+  using value_t = typename kdtree_t::value_t;
+
+  /// Default constructor
+  ///
+  /// @param period Duration of the partitions, in the unit of the times
+  /// stored.
+  explicit TemporalIndex(const int64_t period) : period_(period) {
+    if (period <= 0) {
+      throw std::invalid_argument("the period must be a positive duration");
+    }
+  }
+
+  /// Returns the duration of the partitions.
+  [[nodiscard]] constexpr auto period() const noexcept -> int64_t {
+    return period_;
+  }
+
+  /// Returns the number of observations stored in the index.
+  [[nodiscard]] auto size() const noexcept -> size_t { return size_; }
+
+  /// Query if the index is empty.
+  [[nodiscard]] auto empty() const noexcept -> bool { return size_ == 0; }
+
+  /// Returns the number of partitions of the index.
+  [[nodiscard]] auto partitions() const noexcept -> size_t {
+    return partitions_.size();
+  }
+
+  /// Removes all observations stored in the index.
+  auto clear() -> void {
+    partitions_.clear();
+    size_ = 0;
+  }
+
+  /// Replaces the content of the index by the provided observations.
+  ///
+  /// @param values Observations to index.
+  /// @param num_threads The number of threads used to build each partition.
+  auto packing(std::vector<value_t> values, const size_t num_threads)
+      -> void {
+    clear();
+    std::stable_sort(values.begin(), values.end(),
+                     [this](const auto &lhs, const auto &rhs) {
+                       return key(lhs.second.time) < key(rhs.second.time);
+                     });
+    auto first = values.begin();
+    while (first != values.end()) {
+      const auto partition = key(first->second.time);
+      auto last = std::find_if(first, values.end(), [&](const auto &item) {
+        return key(item.second.time) != partition;
+      });
+      partitions_.emplace(
+          partition, kdtree_t(std::vector<value_t>(first, last), num_threads));
+      first = last;
+    }
+    size_ = values.size();
+  }
+
+  /// Calls a function with the distance and the observation of the K
+  /// nearest neighbors of a given point, observed within a time window and
+  /// located within a radius, sorted by increasing distance.
+  ///
+  /// @param point Point of interest
+  /// @param time Time of the point of interest.
+  /// @param window Half-width of the time window: the neighbors are
+  /// observed in [time - window, time + window].
+  /// @param k The number of nearest neighbors to search.
+  /// @param radius The maximum distance between the point and its neighbors.
+  /// @param func Function called with the distance and the observation of
+  /// each neighbor.
+  template <typename Function>
+  auto for_each_nearest(const point_t &point, const int64_t time,
+                        const int64_t window, const uint32_t k,
+                        const distance_t radius, Function &&func) const
+      -> void {
+    if (k == 0) {
+      return;
+    }
+    // The candidates of the searches are stored in buffers reused by all the
+    // queries of the thread.
+    thread_local auto candidates =
+        std::vector<typename kdtree_t::result_t>();
+    thread_local auto merged =
+        std::vector<std::pair<distance_t, const Observation *>>();
+    merged.clear();
+
+    const auto t0 = time - window;
+    const auto t1 = time + window;
+    auto bound = radius;
+    for (auto it = partitions_.lower_bound(key(t0));
+         it != partitions_.end() && it->first <= key(t1); ++it) {
+      const auto &kdtree = it->second;
+      const auto start = it->first * period_;
+      // The observations of the partitions located inside the window are
+      // not filtered.
+      const auto inside = start >= t0 && start + (period_ - 1) <= t1;
+      kdtree.nearest_if(point, k, bound, candidates, [&](const size_t ix) {
+        return inside || std::abs(kdtree[ix].second.time - time) <= window;
+      });
+      for (const auto &item : candidates) {
+        merged.emplace_back(item.first, &kdtree[item.second].second);
+      }
+      // Only the k nearest neighbors found so far are kept: the following
+      // partitions are searched within the distance to the farthest one.
+      std::sort(merged.begin(), merged.end(),
+                [](const auto &lhs, const auto &rhs) {
+                  return lhs.first < rhs.first;
+                });
+      if (merged.size() >= k) {
+        merged.resize(k);
+        bound = merged.back().first;
+      }
+    }
+    for (const auto &item : merged) {
+      func(item.first, *item.second);
+    }
+  }
+
+  /// Search for the K nearest neighbors of a given point observed within a
+  /// time window, writing their distances and values into the provided
+  /// buffers.
+  ///
+  /// @param point Point of interest
+  /// @param time Time of the point of interest.
+  /// @param window Half-width of the time window.
+  /// @param k The number of nearest neighbors to search.
+  /// @param distances Buffer of at least k elements receiving the distances to
+  /// the neighbors, sorted by increasing distance.
+  /// @param values Buffer of at least k elements receiving the values of the
+  /// neighbors.
+  /// @param radius The maximum distance between the point and its neighbors.
+  /// @return the number of neighbors written to the buffers.
+  auto query(const point_t &point, const int64_t time, const int64_t window,
+             const uint32_t k, distance_t *distances, Type *values,
+             const distance_t radius =
+                 std::numeric_limits<distance_t>::max()) const -> uint32_t {
+    auto count = 0U;
+    for_each_nearest(point, time, window, k, radius,
+                     [&](const distance_t distance, const auto &item) {
+                       distances[count] = distance;
+                       values[count] = item.value;
+                       ++count;
+                     });
+    return count;
+  }
+
+  /// Interpolation of the value at the requested position and time by
+  /// inverse distance weighting of the neighbors observed within a time
+  /// window.
+  ///
+  /// @param point Point of interest
+  /// @param time Time of the point of interest.
+  /// @param window Half-width of the time window.
+  /// @param radius The maximum radius of the search.
+  /// @param k The number of nearest neighbors to be used for calculating the
+  /// interpolated value.
+  /// @param p the power parameter.
+  /// @return a pair containing the interpolated value and the number of
+  /// neighbors used in the calculation.
+  auto inverse_distance_weighting(const point_t &point, const int64_t time,
+                                  const int64_t window, const distance_t radius,
+                                  const uint32_t k, const uint32_t p) const
+      -> std::pair<distance_t, uint32_t> {
+    distance_t result = 0;
+    distance_t total_weight = 0;
+
+    thread_local auto distances = std::vector<distance_t>();
+    thread_local auto values = std::vector<Type>();
+    if (distances.size() < k) {
+      distances.resize(k);
+      values.resize(k);
+    }
+    auto count = query(point, time, window, k, distances.data(), values.data(),
+                       radius);
+    uint32_t neighbors = 0;
+
+    for (auto ix = 0U; ix < count; ++ix) {
+      const auto distance = distances[ix];
+      if (distance < 1e-6) {
+        // If the user has requested an observed point, its value is returned.
+        return std::make_pair(static_cast<distance_t>(values[ix]), k);
+      }
+      const auto wk = 1 / std::pow(distance, static_cast<distance_t>(p));
+      total_weight += wk;
+      result += static_cast<distance_t>(values[ix]) * wk;
+      ++neighbors;
+    }
+
+    return total_weight != 0
+               ? std::make_pair(static_cast<distance_t>(result / total_weight),
+                                neighbors)
+               : std::make_pair(std::numeric_limits<distance_t>::quiet_NaN(),
+                                static_cast<uint32_t>(0));
+  }
+
+ private:
+  /// Duration of the partitions
+  int64_t period_;
+
+  /// Number of observations stored
+  size_t size_{0};
+
+  /// Static indexes of the partitions, by key.
+  std::map<int64_t, kdtree_t> partitions_{};
+
+  /// Returns the key of the partition containing a time.
+  [[nodiscard]] constexpr auto key(const int64_t time) const noexcept
+      -> int64_t {
+    const auto quotient = time / period_;
+    return quotient - static_cast<int64_t>(time % period_ < 0);
+  }
+};
+
+}  // namespace pyinterp::detail::geometry
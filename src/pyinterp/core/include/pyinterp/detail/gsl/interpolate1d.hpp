@@ -72,16 +72,38 @@ class Interpolate1D {
     return gsl_spline_eval_integ(workspace_.get(), a, b, acc_);
   }
 
- private:
-  std::unique_ptr<gsl_spline, std::function<void(gsl_spline*)>> workspace_;
-  Accelerator acc_;
-
-  /// Initializes the interpolation object
-  inline auto init(const Eigen::VectorXd& xa,
-                   const Eigen::VectorXd& ya) noexcept -> void {
+  /// Initializes the interpolation object. The tabulated values are copied,
+  /// so the function can then be evaluated several times without calling
+  /// this method again. The vectors, e.g. the columns or the coordinates of a
+  /// fixed-size frame, are read without being copied into temporaries.
+  inline auto init(const Eigen::Ref<const Eigen::VectorXd>& xa,
+                   const Eigen::Ref<const Eigen::VectorXd>& ya) noexcept
+      -> void {
     acc_.reset();
     gsl_spline_init(workspace_.get(), xa.data(), ya.data(), xa.size());
   }
+
+  /// Return the interpolated value of y for a given point x, using the
+  /// function defined by the last call to init.
+  [[nodiscard]] inline auto interpolate(const double x) -> double {
+    return gsl_spline_eval(workspace_.get(), x, acc_);
+  }
+
+  /// Return the derivative d of an interpolated function for a given point x,
+  /// using the function defined by the last call to init.
+  [[nodiscard]] inline auto derivative(const double x) -> double {
+    return gsl_spline_eval_deriv(workspace_.get(), x, acc_);
+  }
+
+  /// Return the second derivative d of an interpolated function for a given
+  /// point x, using the function defined by the last call to init.
+  [[nodiscard]] inline auto second_derivative(const double x) -> double {
+    return gsl_spline_eval_deriv2(workspace_.get(), x, acc_);
+  }
+
+ private:
+  std::unique_ptr<gsl_spline, std::function<void(gsl_spline*)>> workspace_;
+  Accelerator acc_;
 };
 
 }  // namespace pyinterp::detail::gsl
@@ -43,27 +43,54 @@ class Interpolate2D {
   }
 
   /// Return the interpolated value of z for a given point x, y
-  [[nodiscard]] inline auto evaluate(const Eigen::VectorXd& xa,
-                                     const Eigen::VectorXd& ya,
-                                     const Eigen::MatrixXd& za, const double x,
-                                     const double y) -> double {
+  [[nodiscard]] inline auto evaluate(
+      const Eigen::Ref<const Eigen::VectorXd>& xa,
+      const Eigen::Ref<const Eigen::VectorXd>& ya,
+      const Eigen::Ref<const Eigen::MatrixXd>& za, const double x,
+      const double y) -> double {
     init(xa, ya, za);
+    return evaluate(x, y);
+  }
+
+  /// Initializes the interpolation object. The tabulated values are copied,
+  /// so the function can then be evaluated several times without calling
+  /// this method again. The values of the fixed-size frames are read without
+  /// being copied into temporaries.
+  inline auto init(const Eigen::Ref<const Eigen::VectorXd>& xa,
+                   const Eigen::Ref<const Eigen::VectorXd>& ya,
+                   const Eigen::Ref<const Eigen::MatrixXd>& za) noexcept
+      -> void {
+    xacc_.reset();
+    yacc_.reset();
+    gsl_spline2d_init(workspace_.get(), xa.data(), ya.data(), za.data(),
+                      xa.size(), ya.size());
+  }
+
+  /// Return the interpolated value of z for a given point x, y, using the
+  /// function defined by the last call to init.
+  [[nodiscard]] inline auto evaluate(const double x, const double y)
+      -> double {
     return gsl_spline2d_eval(workspace_.get(), x, y, xacc_, yacc_);
   }
 
+  /// Return the partial derivative of z with respect to x for a given point
+  /// x, y, using the function defined by the last call to init.
+  [[nodiscard]] inline auto derivative_x(const double x, const double y)
+      -> double {
+    return gsl_spline2d_eval_deriv_x(workspace_.get(), x, y, xacc_, yacc_);
+  }
+
+  /// Return the partial derivative of z with respect to y for a given point
+  /// x, y, using the function defined by the last call to init.
+  [[nodiscard]] inline auto derivative_y(const double x, const double y)
+      -> double {
+    return gsl_spline2d_eval_deriv_y(workspace_.get(), x, y, xacc_, yacc_);
+  }
+
  private:
   std::unique_ptr<gsl_spline2d, std::function<void(gsl_spline2d*)>> workspace_;
   Accelerator xacc_;
   Accelerator yacc_;
-
-  /// Initializes the interpolation object
-  inline auto init(const Eigen::VectorXd& xa, const Eigen::VectorXd& ya,
-                   const Eigen::MatrixXd& za) noexcept -> void {
-    xacc_.reset();
-    xacc_.reset();
-    gsl_spline2d_init(workspace_.get(), xa.data(), ya.data(), za.data(),
-                      xa.size(), ya.size());
-  }
 };
 
 }  // namespace pyinterp::detail::gsl
\ No newline at end of file
@@ -0,0 +1,217 @@
+// Copyright (c) 2022 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include "pyinterp/detail/cell_grid.hpp"
+#include "pyinterp/detail/math/streaming_histogram.hpp"
+
+namespace pyinterp::detail {
+
+/// Grid of streaming histograms whose bins are stored in a shared arena.
+///
+/// A grid of math::StreamingHistogram allocates the bins of each cell on the
+/// heap, and reallocates them as they grow: millions of small blocks, slow to
+/// create, to destroy and to traverse. Here, each cell only stores the
+/// statistics of its histogram and the slot of its bins in an arena made of
+/// large blocks, a slot holding the maximum number of bins of the histograms.
+/// The slots are allocated when the cells are first used, and reused once the
+/// grid is cleared.
+///
+/// The histograms are updated through a math::StreamingHistogram working
+/// copy: load() copies the state of a cell into it, and store() writes it
+/// back.
+///
+/// @tparam T Type of the values of the histograms.
+template <typename T>
+class HistogramGrid {
+ public:
+  /// Histogram handled by the cells of the grid.
+  using StreamingHistogram = math::StreamingHistogram<T>;
+
+  /// Slot of the cells not yet used.
+  static constexpr uint64_t kNoSlot = std::numeric_limits<uint64_t>::max();
+
+  /// Statistics of the histogram of a cell.
+  struct Cell {
+    /// Number of samples pushed
+    uint64_t count{0};
+    /// Minimum of the samples
+    T min{};
+    /// Maximum of the samples
+    T max{};
+    /// Number of bins used
+    uint32_t size{0};
+    /// True if the bins hold the samples pushed
+    bool exact{true};
+    /// Slot of the bins in the arena
+    uint64_t slot{kNoSlot};
+  };
+
+  /// Default constructor
+  ///
+  /// @param rows Number of rows of the grid.
+  /// @param cols Number of columns of the grid.
+  /// @param sparse True if only the cells used are stored.
+  /// @param bin_count Maximum number of bins of the histograms.
+  HistogramGrid(const int64_t rows, const int64_t cols, const bool sparse,
+                const size_t bin_count)
+      : cells_(rows, cols, sparse),
+        bin_count_(bin_count),
+        capacity_(std::max<size_t>(bin_count, 1)),
+        slots_per_block_(std::max<size_t>(kBlockBins / capacity_, 1)) {}
+
+  /// Gets the number of rows of the grid.
+  [[nodiscard]] constexpr auto rows() const noexcept -> int64_t {
+    return cells_.rows();
+  }
+
+  /// Gets the number of columns of the grid.
+  [[nodiscard]] constexpr auto cols() const noexcept -> int64_t {
+    return cells_.cols();
+  }
+
+  /// Gets the number of cells of the grid.
+  [[nodiscard]] constexpr auto size() const noexcept -> int64_t {
+    return cells_.size();
+  }
+
+  /// Returns true if only the cells used are stored.
+  [[nodiscard]] constexpr auto sparse() const noexcept -> bool {
+    return cells_.sparse();
+  }
+
+  /// Gets the maximum number of bins of the histograms.
+  [[nodiscard]] constexpr auto bin_count() const noexcept -> size_t {
+    return bin_count_;
+  }
+
+  /// Gets the index of the cell (ix, iy).
+  [[nodiscard]] constexpr auto index(const int64_t ix,
+                                     const int64_t iy) const noexcept
+      -> uint64_t {
+    return cells_.index(ix, iy);
+  }
+
+  /// Gets the number of slots allocated in the arena.
+  [[nodiscard]] constexpr auto slots() const noexcept -> size_t {
+    return slots_;
+  }
+
+  /// Stores the cell of the given index and allocates the slot of its bins,
+  /// if needed. The cells updated by several threads must be reserved
+  /// beforehand, by a single thread.
+  auto reserve(const uint64_t index) -> void {
+    auto& cell = cells_[index];
+    if (cell.slot == kNoSlot) {
+      cell.slot = allocate();
+    }
+  }
+
+  /// Copies the histogram of a cell into the provided working copy, whose
+  /// memory is reused.
+  auto load(const Cell& cell, StreamingHistogram& histogram) const -> void {
+    if (histogram.bin_count() != bin_count_) {
+      histogram = StreamingHistogram(bin_count_, false);
+    }
+    const auto* first = cell.slot == kNoSlot ? nullptr : bins(cell.slot);
+    histogram.assign(cell.count, cell.min, cell.max, cell.exact, first,
+                     first + cell.size);
+  }
+
+  /// Copies the histogram of the cell of the given index into the provided
+  /// working copy. The cells not stored hold an empty histogram.
+  auto load(const uint64_t index, StreamingHistogram& histogram) const
+      -> void {
+    load(cells_[index], histogram);
+  }
+
+  /// Writes a histogram to the cell of the given index. The values buffered
+  /// by the histogram are merged into its bins first, and its bins are
+  /// compressed if it holds more bins than the histograms of the grid.
+  auto store(const uint64_t index, StreamingHistogram& histogram) -> void {
+    auto* cell = cells_.find(index);
+    if (cell == nullptr || cell->slot == kNoSlot) {
+      reserve(index);
+      cell = cells_.find(index);
+    }
+    histogram.flush();
+    if (histogram.bin_count() != bin_count_) {
+      histogram.resize(bin_count_);
+    }
+    const auto& items = histogram.bins();
+    std::copy(items.begin(), items.end(), bins(cell->slot));
+    *cell = Cell{histogram.count(),
+                 histogram.min(),
+                 histogram.max(),
+                 static_cast<uint32_t>(items.size()),
+                 histogram.exact(),
+                 cell->slot};
+  }
+
+  /// Gets the bins of a cell.
+  [[nodiscard]] auto bins(const Cell& cell) const -> const math::Bin<T>* {
+    return cell.slot == kNoSlot ? nullptr : bins(cell.slot);
+  }
+
+  /// Calls function(index, cell) for each cell stored, in no particular
+  /// order.
+  template <typename Function>
+  auto for_each(const Function& function) const -> void {
+    cells_.for_each(function);
+  }
+
+  /// Gets the indexes, in increasing order, of the cells holding values.
+  [[nodiscard]] auto indexes() const -> std::vector<uint64_t> {
+    return cells_.indexes([](const Cell& cell) { return cell.size != 0; });
+  }
+
+  /// Resets all the histograms. The memory of the arena is kept to store
+  /// the next values.
+  auto clear() -> void {
+    cells_.clear();
+    slots_ = 0;
+  }
+
+ private:
+  /// Number of bins of the blocks of the arena.
+  static constexpr size_t kBlockBins = 1U << 16U;
+
+  /// Statistics of the cells
+  CellGrid<Cell> cells_;
+  /// Maximum number of bins of the histograms
+  size_t bin_count_;
+  /// Number of bins of a slot: a histogram always keeps at least one bin.
+  size_t capacity_;
+  /// Number of slots of a block
+  size_t slots_per_block_;
+  /// Number of slots allocated
+  size_t slots_{0};
+  /// Blocks of the arena
+  std::vector<std::unique_ptr<math::Bin<T>[]>> blocks_{};
+
+  /// Allocates a new slot, and the block holding it if needed.
+  auto allocate() -> uint64_t {
+    if (slots_ == blocks_.size() * slots_per_block_) {
+      // The bins are not initialized: the pages of the block are only mapped
+      // when the slots are written.
+      blocks_.emplace_back(new math::Bin<T>[slots_per_block_ * capacity_]);
+    }
+    return slots_++;
+  }
+
+  /// Gets the bins of a slot.
+  [[nodiscard]] inline auto bins(const uint64_t slot) const noexcept
+      -> math::Bin<T>* {
+    return blocks_[slot / slots_per_block_].get() +
+           (slot % slots_per_block_) * capacity_;
+  }
+};
+
+}  // namespace pyinterp::detail
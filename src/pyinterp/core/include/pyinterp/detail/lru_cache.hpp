@@ -0,0 +1,89 @@
+// Copyright (c) 2022 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+#pragma once
+#include <algorithm>
+#include <iterator>
+#include <list>
+#include <utility>
+
+namespace pyinterp::detail {
+
+/// Least recently used cache holding a few values that are expensive to
+/// compute. The entries are searched linearly: the cache is meant to hold a
+/// small number of values. An instance is not thread-safe: each thread must
+/// use its own cache.
+///
+/// @tparam Key The type of the keys identifying the values.
+/// @tparam Value The type of the cached values.
+template <typename Key, typename Value>
+class LRUCache {
+ public:
+  /// Default constructor
+  ///
+  /// @param capacity Maximum number of values kept in the cache. At least one
+  /// value is kept.
+  explicit LRUCache(const size_t capacity)
+      : capacity_(std::max(capacity, size_t(1))) {}
+
+  /// Get the value of a key, computing it if it is not cached.
+  ///
+  /// @param key Key of the value.
+  /// @param compute Function returning the value of the key.
+  /// @return the value of the key.
+  template <typename Function>
+  auto get(const Key& key, Function&& compute) -> const Value& {
+    const auto* value = find(key);
+    if (value != nullptr) {
+      return *value;
+    }
+    return put(key, compute());
+  }
+
+  /// Search for the value of a key.
+  ///
+  /// @param key Key of the value.
+  /// @return the value of the key, or nullptr if it is not cached.
+  auto find(const Key& key) -> const Value* {
+    for (auto it = entries_.begin(); it != entries_.end(); ++it) {
+      if (it->first == key) {
+        // The entry found becomes the most recently used.
+        entries_.splice(entries_.begin(), entries_, it);
+        return &it->second;
+      }
+    }
+    return nullptr;
+  }
+
+  /// Stores the value of a key that is not cached.
+  ///
+  /// @param key Key of the value.
+  /// @param value Value of the key.
+  /// @return the value stored.
+  auto put(const Key& key, Value value) -> const Value& {
+    if (entries_.size() == capacity_) {
+      // The least recently used entry is recycled to keep its buffers.
+      entries_.splice(entries_.begin(), entries_, std::prev(entries_.end()));
+      entries_.front().first = key;
+      entries_.front().second = std::move(value);
+      return entries_.front().second;
+    }
+    entries_.emplace_front(key, std::move(value));
+    return entries_.front().second;
+  }
+
+  /// Get the number of values cached.
+  [[nodiscard]] auto size() const noexcept -> size_t {
+    return entries_.size();
+  }
+
+ private:
+  /// Maximum number of values kept in the cache
+  size_t capacity_;
+
+  /// Values cached, from the most to the least recently used.
+  std::list<std::pair<Key, Value>> entries_{};
+};
+
+}  // namespace pyinterp::detail
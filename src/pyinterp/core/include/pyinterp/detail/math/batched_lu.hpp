@@ -0,0 +1,189 @@
+// Copyright (c) 2022 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+#pragma once
+#include <Eigen/Core>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "pyinterp/eigen.hpp"
+
+namespace pyinterp::detail::math {
+
+/// Solves a batch of small dense linear systems A x = b by Gaussian
+/// elimination with partial pivoting.
+///
+/// The systems of the batch are interleaved: the element (i, j) of the
+/// matrices is stored in Lanes consecutive values, one per system. Each step
+/// of the elimination then updates the same element of all the systems, in a
+/// loop over contiguous values that the compiler vectorizes, instead of
+/// factorizing the matrices one by one with loops too short to reach the peak
+/// throughput of the processor.
+///
+/// The systems smaller than the size of the batch are padded with the
+/// identity, which leaves their solution unchanged.
+///
+/// @tparam T The type of the values of the systems.
+/// @tparam Lanes The number of systems solved at once.
+template <typename T, size_t Lanes = 8>
+class BatchedLU {
+ public:
+  /// Default constructor
+  ///
+  /// @param size The maximum size of the systems solved.
+  explicit BatchedLU(const Eigen::Index size)
+      : size_(size),
+        a_(static_cast<size_t>(size * size) * Lanes),
+        b_(static_cast<size_t>(size) * Lanes) {}
+
+  /// Get the number of systems solved at once.
+  static constexpr auto lanes() noexcept -> size_t { return Lanes; }
+
+  /// Get the maximum size of the systems solved.
+  [[nodiscard]] constexpr auto size() const noexcept -> Eigen::Index {
+    return size_;
+  }
+
+  /// Sets the system solved by a lane of the batch.
+  ///
+  /// @param lane Index of the system in the batch.
+  /// @param A Square matrix of the system, of size at most size().
+  /// @param b Right-hand side of the system.
+  auto set(const size_t lane, const Eigen::Ref<const Matrix<T>>& A,
+           const Eigen::Ref<const Vector<T>>& b) -> void {
+    const auto n = A.rows();
+    for (Eigen::Index ix = 0; ix < size_; ++ix) {
+      for (Eigen::Index jx = 0; jx < size_; ++jx) {
+        a(ix, jx)[lane] = ix < n && jx < n ? A(ix, jx) : T(ix == jx);
+      }
+      rhs(ix)[lane] = ix < n ? b(ix) : T(0);
+    }
+  }
+
+  /// Solves the systems of the batch, in place. The lanes not set by the
+  /// caller hold the systems of a previous batch: their results are
+  /// meaningless.
+  ///
+  /// @return For each lane, false if its matrix is singular to working
+  /// precision: its solution is then undefined.
+  auto solve() -> std::array<bool, Lanes> {
+    auto regular = std::array<bool, Lanes>();
+    auto scale = std::array<T, Lanes>();
+    regular.fill(true);
+    scale.fill(T(0));
+    for (Eigen::Index ix = 0; ix < size_; ++ix) {
+      for (Eigen::Index jx = 0; jx < size_; ++jx) {
+        const auto* item = a(ix, jx);
+        for (size_t lane = 0; lane < Lanes; ++lane) {
+          scale[lane] = std::max(scale[lane], std::abs(item[lane]));
+        }
+      }
+    }
+    const auto epsilon = std::numeric_limits<T>::epsilon() * size_;
+
+    auto factor = std::array<T, Lanes>();
+    for (Eigen::Index kx = 0; kx < size_; ++kx) {
+      // The pivot of each system is searched and swapped independently.
+      for (size_t lane = 0; lane < Lanes; ++lane) {
+        auto pivot = kx;
+        for (Eigen::Index ix = kx + 1; ix < size_; ++ix) {
+          if (std::abs(a(ix, kx)[lane]) > std::abs(a(pivot, kx)[lane])) {
+            pivot = ix;
+          }
+        }
+        if (pivot != kx) {
+          for (Eigen::Index jx = kx; jx < size_; ++jx) {
+            std::swap(a(kx, jx)[lane], a(pivot, jx)[lane]);
+          }
+          std::swap(rhs(kx)[lane], rhs(pivot)[lane]);
+        }
+        if (!(std::abs(a(kx, kx)[lane]) > epsilon * scale[lane])) {
+          // The singular system is eliminated with a unit pivot so that its
+          // values remain finite.
+          regular[lane] = false;
+          a(kx, kx)[lane] = T(1);
+        }
+      }
+
+      // Elimination of the column below the pivot, for all the systems.
+      const auto* pivot_row = a(kx, 0);
+      const auto* pivot_rhs = rhs(kx);
+      const auto diagonal = static_cast<size_t>(kx) * Lanes;
+      for (Eigen::Index ix = kx + 1; ix < size_; ++ix) {
+        auto* row = a(ix, 0);
+        auto* row_rhs = rhs(ix);
+        for (size_t lane = 0; lane < Lanes; ++lane) {
+          factor[lane] = row[diagonal + lane] / pivot_row[diagonal + lane];
+        }
+        for (Eigen::Index jx = kx + 1; jx < size_; ++jx) {
+          const auto offset = static_cast<size_t>(jx) * Lanes;
+          for (size_t lane = 0; lane < Lanes; ++lane) {
+            row[offset + lane] -= factor[lane] * pivot_row[offset + lane];
+          }
+        }
+        for (size_t lane = 0; lane < Lanes; ++lane) {
+          row_rhs[lane] -= factor[lane] * pivot_rhs[lane];
+        }
+      }
+    }
+
+    // Back substitution, the solution replacing the right-hand sides.
+    for (auto ix = size_ - 1; ix >= 0; --ix) {
+      const auto* row = a(ix, 0);
+      auto* x = rhs(ix);
+      for (Eigen::Index jx = ix + 1; jx < size_; ++jx) {
+        const auto offset = static_cast<size_t>(jx) * Lanes;
+        const auto* xj = rhs(jx);
+        for (size_t lane = 0; lane < Lanes; ++lane) {
+          x[lane] -= row[offset + lane] * xj[lane];
+        }
+      }
+      const auto offset = static_cast<size_t>(ix) * Lanes;
+      for (size_t lane = 0; lane < Lanes; ++lane) {
+        x[lane] /= row[offset + lane];
+      }
+    }
+    return regular;
+  }
+
+  /// Gets the solution of a system solved by the last call to solve.
+  ///
+  /// @param lane Index of the system in the batch.
+  /// @param n Size of the system.
+  [[nodiscard]] auto solution(const size_t lane, const Eigen::Index n) const
+      -> Vector<T> {
+    auto result = Vector<T>(n);
+    for (Eigen::Index ix = 0; ix < n; ++ix) {
+      result(ix) = b_[static_cast<size_t>(ix) * Lanes + lane];
+    }
+    return result;
+  }
+
+ private:
+  /// Maximum size of the systems
+  Eigen::Index size_;
+
+  /// Matrices of the systems, interleaved.
+  std::vector<T> a_;
+
+  /// Right-hand sides of the systems, interleaved.
+  std::vector<T> b_;
+
+  /// Get the values of the element (i, j) of the matrices.
+  inline auto a(const Eigen::Index ix, const Eigen::Index jx) -> T* {
+    return a_.data() + static_cast<size_t>(ix * size_ + jx) * Lanes;
+  }
+
+  /// Get the values of the element i of the right-hand sides.
+  inline auto rhs(const Eigen::Index ix) -> T* {
+    return b_.data() + static_cast<size_t>(ix) * Lanes;
+  }
+};
+
+}  // namespace pyinterp::detail::math
@@ -18,17 +18,49 @@ class Bicubic {
  public:
   /// Default constructor
   ///
-  /// @param xr Calculation window.
+  /// @param xr Calculation window, a Frame2D of any window size.
   /// @param kind method of calculation
-  explicit Bicubic(const Frame2D& xr, const std::string& kind)
-      : interpolator_(xr.x()->size(), xr.y()->size(),
+  template <typename Frame>
+  explicit Bicubic(const Frame& xr, const std::string& kind)
+      : interpolator_(xr.x_values().size(), xr.y_values().size(),
                       Bicubic::parse_interp2d_type(kind), gsl::Accelerator(),
                       gsl::Accelerator()) {}
 
   /// Return the interpolated value of y for a given point x
-  auto interpolate(const double x, const double y, const Frame2D& xr)
+  template <typename Frame>
+  auto interpolate(const double x, const double y, const Frame& xr) -> double {
+    return interpolator_.evaluate(xr.x_values(), xr.y_values(), xr.q_values(),
+                                  x, y);
+  }
+
+  /// Computes the interpolation coefficients of the frame provided.
+  template <typename Frame>
+  auto fit(const Frame& xr) -> void {
+    interpolator_.init(xr.x_values(), xr.y_values(), xr.q_values());
+  }
+
+  /// Return the interpolated value of y for a given point x, using the
+  /// coefficients computed by the last call to fit.
+  auto interpolate(const double x, const double y) -> double {
+    return interpolator_.evaluate(x, y);
+  }
+
+  /// Return the interpolated value and its partial derivatives for a given
+  /// point, using the coefficients computed by the last call to fit.
+  ///
+  /// @param dx Partial derivative with respect to x.
+  /// @param dy Partial derivative with respect to y.
+  auto gradient(const double x, const double y, double& dx, double& dy)
       -> double {
-    return interpolator_.evaluate(*(xr.x()), *(xr.y()), *(xr.q()), x, y);
+    dx = interpolator_.derivative_x(x, y);
+    dy = interpolator_.derivative_y(x, y);
+    return interpolator_.evaluate(x, y);
+  }
+
+  /// Returns true if the interpolation method is a bicubic polynomial on each
+  /// cell of the frame.
+  static inline auto is_piecewise_bicubic(const std::string& kind) -> bool {
+    return parse_interp2d_type(kind) != nullptr;
   }
 
  private:
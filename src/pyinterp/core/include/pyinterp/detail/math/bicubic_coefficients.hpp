@@ -0,0 +1,175 @@
+// Copyright (c) 2022 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+#pragma once
+#include <Eigen/Core>
+#include <Eigen/LU>
+#include <cmath>
+#include <limits>
+#include <string>
+#include <utility>
+
+#include "pyinterp/detail/axis.hpp"
+#include "pyinterp/detail/math/frame.hpp"
+
+namespace pyinterp::detail::math {
+
+/// Coefficients of the bicubic polynomials interpolating each cell of a grid.
+///
+/// They are computed once for all the cells of the grid, so that the
+/// interpolation of a point only requires the evaluation of the polynomial of
+/// the cell containing it. In the cell [x0, x1] x [y0, y1], the interpolated
+/// value is sum(a_ij * t^i * u^j) with t = (x - x0) / (x1 - x0) and
+/// u = (y - y0) / (y1 - y0).
+///
+/// The 16 coefficients of a cell are stored contiguously: the interpolation of
+/// a point reads two cache lines.
+class BicubicCoefficients {
+ public:
+  /// Number of coefficients stored for each cell.
+  static constexpr Eigen::Index kSize = 16;
+
+  /// Default constructor
+  ///
+  /// @param x_size Number of points of the x-axis.
+  /// @param y_size Number of points of the y-axis.
+  /// @param layers Number of layers (z-values) of the grid.
+  /// @param nx Half size of the window used in abscissa to fit the cells.
+  /// @param ny Half size of the window used in ordinate to fit the cells.
+  /// @param fitting_model Interpolation method used to fit the cells.
+  /// @param boundary Handling of the boundaries used to fit the cells.
+  BicubicCoefficients(const Eigen::Index x_size, const Eigen::Index y_size,
+                      const Eigen::Index layers, const Eigen::Index nx,
+                      const Eigen::Index ny, std::string fitting_model,
+                      const ::pyinterp::axis::Boundary boundary)
+      : x_size_(x_size),
+        y_size_(y_size),
+        nx_(nx),
+        ny_(ny),
+        fitting_model_(std::move(fitting_model)),
+        boundary_(boundary),
+        coefficients_(kSize, x_size * y_size * layers) {
+    coefficients_.setConstant(std::numeric_limits<double>::quiet_NaN());
+  }
+
+  /// Returns true if the coefficients were fitted with the given parameters.
+  [[nodiscard]] inline auto matches(
+      const Eigen::Index nx, const Eigen::Index ny,
+      const std::string& fitting_model,
+      const ::pyinterp::axis::Boundary boundary) const noexcept -> bool {
+    return nx == nx_ && ny == ny_ && fitting_model == fitting_model_ &&
+           boundary == boundary_;
+  }
+
+  /// Get the coefficients of the cell (ix, jx) of the layer kx, i.e. the cell
+  /// whose first corner is the grid point (ix, jx).
+  [[nodiscard]] inline auto cell(const Eigen::Index ix, const Eigen::Index jx,
+                                 const Eigen::Index kx) const noexcept
+      -> const double* {
+    return coefficients_.col((kx * x_size_ + ix) * y_size_ + jx).data();
+  }
+
+  /// Get the coefficients of the cell (ix, jx) of the layer kx.
+  inline auto cell(const Eigen::Index ix, const Eigen::Index jx,
+                   const Eigen::Index kx) noexcept -> double* {
+    return coefficients_.col((kx * x_size_ + ix) * y_size_ + jx).data();
+  }
+
+  /// Get the memory used by the coefficients, in bytes.
+  [[nodiscard]] inline auto nbytes() const noexcept -> size_t {
+    return static_cast<size_t>(coefficients_.size()) * sizeof(double);
+  }
+
+  /// Computes the coefficients of the central cell of a frame, i.e. the cell
+  /// framing the point used to load it.
+  ///
+  /// The interpolator is evaluated on a 4x4 grid of points covering the cell,
+  /// which exactly determines the coefficients of the polynomial if the
+  /// interpolation method is bicubic on each cell.
+  ///
+  /// @param interpolator Interpolator used
+  /// @param frame Frame loaded
+  /// @param coefficients Buffer of size 16 receiving the coefficients.
+  /// @tparam Frame Frame2D of any window size.
+  template <typename Interpolator, typename Frame>
+  static auto fit(Interpolator& interpolator, const Frame& frame,
+                  double* coefficients) -> void {
+    // Inverse of the Vandermonde matrix of the points 0, 1/3, 2/3, 1.
+    static const Eigen::Matrix4d inverse = []() -> Eigen::Matrix4d {
+      auto vandermonde = Eigen::Matrix4d();
+      for (Eigen::Index ix = 0; ix < 4; ++ix) {
+        for (Eigen::Index jx = 0; jx < 4; ++jx) {
+          vandermonde(ix, jx) = std::pow(ix / 3.0, static_cast<double>(jx));
+        }
+      }
+      return vandermonde.inverse();
+    }();
+
+    const auto x0 = frame.x(frame.nx() - 1);
+    const auto dx = frame.x(frame.nx()) - x0;
+    const auto y0 = frame.y(frame.ny() - 1);
+    const auto dy = frame.y(frame.ny()) - y0;
+
+    auto values = Eigen::Matrix4d();
+    interpolator.fit(frame);
+    for (Eigen::Index ix = 0; ix < 4; ++ix) {
+      for (Eigen::Index jx = 0; jx < 4; ++jx) {
+        values(ix, jx) =
+            interpolator.interpolate(x0 + dx * ix / 3.0, y0 + dy * jx / 3.0);
+      }
+    }
+    auto result = Eigen::Map<Eigen::Matrix4d>(coefficients);
+    result = inverse * values * inverse.transpose();
+  }
+
+  /// Evaluates the polynomial of a cell.
+  ///
+  /// @param coefficients Coefficients of the cell.
+  /// @param t Normalized abscissa of the point in the cell
+  /// @param u Normalized ordinate of the point in the cell
+  /// @return The interpolated value.
+  static constexpr auto evaluate(const double* coefficients, const double t,
+                                 const double u) noexcept -> double {
+    auto result = 0.0;
+    for (auto ix = 3; ix >= 0; --ix) {
+      const auto* a = coefficients + ix;
+      result = result * t + (((a[12] * u + a[8]) * u + a[4]) * u + a[0]);
+    }
+    return result;
+  }
+
+  /// Evaluates the polynomial of a cell and its partial derivatives.
+  ///
+  /// @param coefficients Coefficients of the cell.
+  /// @param t Normalized abscissa of the point in the cell
+  /// @param u Normalized ordinate of the point in the cell
+  /// @param dt Partial derivative with respect to t.
+  /// @param du Partial derivative with respect to u.
+  /// @return The interpolated value.
+  static constexpr auto gradient(const double* coefficients, const double t,
+                                 const double u, double& dt,
+                                 double& du) noexcept -> double {
+    auto result = 0.0;
+    dt = 0.0;
+    du = 0.0;
+    for (auto ix = 3; ix >= 0; --ix) {
+      const auto* a = coefficients + ix;
+      dt = dt * t + result;
+      result = result * t + (((a[12] * u + a[8]) * u + a[4]) * u + a[0]);
+      du = du * t + ((3 * a[12] * u + 2 * a[8]) * u + a[4]);
+    }
+    return result;
+  }
+
+ private:
+  Eigen::Index x_size_;
+  Eigen::Index y_size_;
+  Eigen::Index nx_;
+  Eigen::Index ny_;
+  std::string fitting_model_;
+  ::pyinterp::axis::Boundary boundary_;
+  Eigen::Matrix<double, kSize, Eigen::Dynamic> coefficients_;
+};
+
+}  // namespace pyinterp::detail::math
@@ -5,7 +5,12 @@
 #pragma once
 #include <boost/geometry.hpp>
 #include <boost/geometry/geometries/geometries.hpp>
+#include <cmath>
 #include <tuple>
+#include <vector>
+
+#include "pyinterp/detail/geodetic/area.hpp"
+#include "pyinterp/detail/math.hpp"
 
 namespace pyinterp::detail::math {
 
@@ -106,4 +111,83 @@ auto binning_2d(const Point<T>& pij, const Point<T>& p00, const Point<T>& p11,
                          area_c / total_area, area_a / total_area);
 }
 
+/// Linear binning 2D of a point located in a cell of a Cartesian grid.
+///
+/// The areas of the rectangles of the figure drawn for binning_2d are
+/// computed directly, without building the polygons.
+///
+/// @param x X-coordinate of the query point
+/// @param y Y-coordinate of the query point
+/// @param x0 X-coordinate of the point p00
+/// @param y0 Y-coordinate of the point p00
+/// @param x1 X-coordinate of the point p11
+/// @param y1 Y-coordinate of the point p11
+/// @return the weights of the grid points, in the order returned by
+/// binning_2d
+template <typename T>
+constexpr auto bilinear_binning_2d(const T& x, const T& y, const T& x0,
+                                   const T& y0, const T& x1, const T& y1)
+    -> std::tuple<T, T, T, T> {
+  const auto tx = (x - x0) / (x1 - x0);
+  const auto ty = (y - y0) / (y1 - y0);
+  return std::make_tuple((1 - tx) * (1 - ty), (1 - tx) * ty, tx * ty,
+                         tx * (1 - ty));
+}
+
+/// Linear binning 2D of a point located in a cell of a geographic grid.
+///
+/// The cells of the grid are bounded by two meridians and two parallels. The
+/// area of such a cell on the spheroid is proportional to its extent in
+/// longitude and to the difference, between its parallels, of the function
+/// defining the authalic latitude (see geodetic::authalic_q).
+///
+/// Therefore, the weights are computed in closed form: the values of q at the
+/// parallels of the grid are tabulated, and the areas of the polygons of
+/// binning_2d are not computed with a geographic strategy.
+///
+/// @tparam T Floating point type.
+template <typename T>
+class GeographicBinning2D {
+ public:
+  /// Default constructor
+  ///
+  /// @param e First eccentricity of the spheroid.
+  /// @param latitudes Latitudes of the parallels of the grid, in degrees.
+  GeographicBinning2D(const T& e, const std::vector<T>& latitudes) : e_(e) {
+    q_.reserve(latitudes.size());
+    for (const auto& item : latitudes) {
+      q_.push_back(q(item));
+    }
+  }
+
+  /// Computes the weights of the grid points.
+  ///
+  /// @param lon Longitude of the query point, between lon0 and lon1.
+  /// @param lat Latitude of the query point.
+  /// @param lon0 Longitude of the point p00.
+  /// @param lon1 Longitude of the point p11, within half a turn of lon0.
+  /// @param iy0 Index of the parallel of the point p00.
+  /// @param iy1 Index of the parallel of the point p11.
+  /// @return the weights of the grid points, in the order returned by
+  /// binning_2d
+  inline auto operator()(const T& lon, const T& lat, const T& lon0,
+                         const T& lon1, const int64_t iy0,
+                         const int64_t iy1) const -> std::tuple<T, T, T, T> {
+    return bilinear_binning_2d<T>(lon, q(lat), lon0, q_[iy0], lon1, q_[iy1]);
+  }
+
+  /// Computes the function q of the authalic latitude.
+  ///
+  /// @param lat Latitude in degrees.
+  [[nodiscard]] inline auto q(const T& lat) const -> T {
+    return geodetic::authalic_q(lat, e_);
+  }
+
+ private:
+  /// First eccentricity of the spheroid.
+  T e_;
+  /// Values of q at the parallels of the grid.
+  std::vector<T> q_{};
+};
+
 }  // namespace pyinterp::detail::math
@@ -93,6 +93,27 @@ struct Bilinear : public Bivariate<Point, T> {
     return (T(1) - t) * (T(1) - u) * q00 + t * (T(1) - u) * q10 +
            (T(1) - t) * u * q01 + t * u * q11;
   }
+
+  /// Performs the bilinear interpolation and computes the partial
+  /// derivatives of the interpolated function, constant along each axis of
+  /// the cell.
+  ///
+  /// @param dx Partial derivative with respect to x.
+  /// @param dy Partial derivative with respect to y.
+  /// @return interpolated value at coordinate (x, y)
+  constexpr auto gradient(const Point<T>& p, const Point<T>& p0,
+                          const Point<T>& p1, const T& q00, const T& q01,
+                          const T& q10, const T& q11, T& dx, T& dy) const
+      -> T {
+    auto wx = boost::geometry::get<0>(p1) - boost::geometry::get<0>(p0);
+    auto wy = boost::geometry::get<1>(p1) - boost::geometry::get<1>(p0);
+    auto t = (boost::geometry::get<0>(p) - boost::geometry::get<0>(p0)) / wx;
+    auto u = (boost::geometry::get<1>(p) - boost::geometry::get<1>(p0)) / wy;
+    dx = ((T(1) - u) * (q10 - q00) + u * (q11 - q01)) / wx;
+    dy = ((T(1) - t) * (q01 - q00) + t * (q11 - q10)) / wy;
+    return (T(1) - t) * (T(1) - u) * q00 + t * (T(1) - u) * q10 +
+           (T(1) - t) * u * q01 + t * u * q11;
+  }
 };
 
 /// Inverse distance weighting interpolation
@@ -246,4 +267,29 @@ struct Nearest : public Bivariate<Point, T> {
   }
 };
 
+/// Calls a function with the interpolator cast to its concrete type if it is
+/// one of the interpolators implemented by this library. The function is then
+/// instantiated for this type and the calls to "evaluate" are resolved at
+/// compile time. The other interpolators, defined in Python, are passed to the
+/// function as a pointer to the abstract class.
+///
+/// @param interpolator Interpolator to visit
+/// @param function Generic function called with a pointer to the interpolator
+template <template <class> class Point, typename T, typename Function>
+auto visit(const Bivariate<Point, T>* interpolator, const Function& function)
+    -> void {
+  if (const auto* ptr = dynamic_cast<const Bilinear<Point, T>*>(interpolator)) {
+    function(ptr);
+  } else if (const auto* ptr =
+                 dynamic_cast<const Nearest<Point, T>*>(interpolator)) {
+    function(ptr);
+  } else if (const auto* ptr =
+                 dynamic_cast<const InverseDistanceWeighting<Point, T>*>(
+                     interpolator)) {
+    function(ptr);
+  } else {
+    function(interpolator);
+  }
+}
+
 }  // namespace pyinterp::detail::math
@@ -1,210 +1,507 @@
-// Copyright (c) 2022 CNES
-//
-// All rights reserved. Use of this source code is governed by a
-// BSD-style license that can be found in the LICENSE file.
-#pragma once
-#include <cmath>
-#include <cstring>
-#include <memory>
-
-namespace pyinterp::detail::math {
-
-/// Handled accumulators
-template <typename T>
-struct Accumulators {
-  uint64_t count;
-  T sum_of_weights;
-  T mean;
-  T min;
-  T max;
-  T sum;
-  T mom2;
-  T mom3;
-  T mom4;
-};
-
-/// Univariate descriptive statistics
-/// Reference: Numerically stable, scalable formulas for parallel and online
-/// computation of higher-order multivariate central moments with arbitrary
-/// weights
-/// https://doi.org/10.1007/s00180-015-0637-z
-template <typename T>
-class DescriptiveStatistics {
- public:
-  /// Default constructor
-  DescriptiveStatistics() { clear(); };
-
-  /// Create of a new object from statistical incremental values
-  explicit DescriptiveStatistics(Accumulators<T> acc) : acc_(std::move(acc)) {}
-
-  /// Returns the raw statistical incremental values
-  explicit operator const Accumulators<T>&() const { return acc_; }
-
-  /// Reset the accumulator
-  constexpr auto clear() noexcept -> void {
-    std::memset(&acc_, 0, sizeof(Accumulators<T>));
-  }
-
-  /// Push a new value into the accumulator
-  constexpr auto operator()(const T& value) noexcept -> void {
-    const auto r = acc_.sum_of_weights;
-
-    if (r == 0) {
-      *this = std::move(DescriptiveStatistics(value, 1));
-    } else {
-      acc_.sum_of_weights += 1;
-      acc_.count += 1;
-      acc_.sum += value;
-
-      const auto inv_n = 1 / acc_.sum_of_weights;
-      const auto delta = value - acc_.mean;
-      const auto A = delta * inv_n;
-
-      acc_.mean += A;
-      acc_.mom4 +=
-          A * (A * A * delta * r *
-                   (acc_.sum_of_weights * (acc_.sum_of_weights - 3.) + 3.) +
-               6. * A * acc_.mom2 - 4. * acc_.mom3);
-
-      const auto B = value - acc_.mean;
-
-      acc_.mom3 +=
-          A * (B * delta * (acc_.sum_of_weights - 2.) - 3. * acc_.mom2);
-      acc_.mom2 += delta * B;
-
-      if (value < acc_.min) {
-        acc_.min = value;
-      } else if (value > acc_.max) {
-        acc_.max = value;
-      }
-    }
-  }
-
-  /// push a new value into the accumulator associated with a weight
-  constexpr auto operator()(const T& value, const T& weight) noexcept -> void {
-    if (acc_.sum_of_weights == 0) {
-      *this = std::move(DescriptiveStatistics(value, weight));
-    } else {
-      this->operator+=(DescriptiveStatistics(value, weight));
-    }
-  }
-
-  /// Returns the number of samples pushed into the accumulator.
-  [[nodiscard]] constexpr auto count() const noexcept -> uint64_t {
-    return acc_.count;
-  }
-
-  /// Returns the sum of weights pushed into the accumulator.
-  [[nodiscard]] constexpr auto sum_of_weights() const noexcept -> const T& {
-    return acc_.sum_of_weights;
-  }
-
-  /// Returns the sum of the values pushed into the accumulator.
-  [[nodiscard]] constexpr auto sum() const noexcept -> const T& {
-    return acc_.sum;
-  }
-
-  /// Returns the mean of the samples
-  [[nodiscard]] constexpr auto mean() const noexcept -> T {
-    return acc_.count == 0 ? std::numeric_limits<T>::quiet_NaN() : acc_.mean;
-  }
-
-  /// Returns the min of the samples
-  [[nodiscard]] constexpr auto min() const noexcept -> T {
-    return acc_.count == 0 ? std::numeric_limits<T>::quiet_NaN() : acc_.min;
-  }
-
-  /// Returns the max of the samples
-  [[nodiscard]] constexpr auto max() const noexcept -> T {
-    return acc_.count == 0 ? std::numeric_limits<T>::quiet_NaN() : acc_.max;
-  }
-
-  /// Returns the variance of the samples
-  [[nodiscard]] constexpr auto variance(const int ddof = 0) const noexcept
-      -> T {
-    const auto cardinal = acc_.sum_of_weights - ddof;
-    return cardinal <= 0 ? std::numeric_limits<T>::quiet_NaN()
-                         : acc_.mom2 / cardinal;
-  }
-
-  /// Returns the standard deviation of the samples
-  [[nodiscard]] inline auto std(const int ddof = 0) const noexcept -> T {
-    return std::sqrt(variance(ddof));
-  }
-
-  /// Returns the skewness of the samples
-  [[nodiscard]] inline auto skewness() const noexcept -> T {
-    return acc_.mom2 == 0 ? std::numeric_limits<T>::quiet_NaN()
-                          : std::sqrt(acc_.sum_of_weights) * acc_.mom3 /
-                                std::pow(acc_.mom2, T(1.5));
-  }
-
-  /// Returns the kurtosis of the samples
-  [[nodiscard]] constexpr auto kurtosis() const noexcept -> T {
-    return acc_.mom2 == 0
-               ? std::numeric_limits<T>::quiet_NaN()
-               : acc_.sum_of_weights * acc_.mom4 / (acc_.mom2 * acc_.mom2) -
-                     T(3);
-  }
-
-  /// Combines two accumulators.
-  constexpr auto operator+=(const DescriptiveStatistics& rhs) noexcept
-      -> DescriptiveStatistics& {
-    auto w = acc_.sum_of_weights + rhs.acc_.sum_of_weights;
-
-    if (rhs.acc_.min < acc_.min) {
-      acc_.min = rhs.acc_.min;
-    }
-
-    if (rhs.acc_.max > acc_.max) {
-      acc_.max = rhs.acc_.max;
-    }
-
-    const auto delta = rhs.acc_.mean - acc_.mean;
-    const auto delta_w = delta / w;
-    const auto delta2_w2 = delta_w * delta_w;
-
-    const auto w2 = acc_.sum_of_weights * acc_.sum_of_weights;
-    const auto ww = acc_.sum_of_weights * rhs.acc_.sum_of_weights;
-    const auto rhs_w2 = rhs.acc_.sum_of_weights * rhs.acc_.sum_of_weights;
-
-    acc_.mom4 += rhs.acc_.mom4 +
-                 ww * (w2 - ww + rhs_w2) * delta * delta_w * delta2_w2 +
-                 6. * (w2 * rhs.acc_.mom2 + rhs_w2 * acc_.mom2) * delta2_w2 +
-                 4. *
-                     (acc_.sum_of_weights * rhs.acc_.mom3 -
-                      rhs.acc_.sum_of_weights * acc_.mom3) *
-                     delta_w;
-
-    acc_.mom3 += rhs.acc_.mom3 +
-                 ww * (acc_.sum_of_weights - rhs.acc_.sum_of_weights) * delta *
-                     delta2_w2 +
-                 3. *
-                     (acc_.sum_of_weights * rhs.acc_.mom2 -
-                      rhs.acc_.sum_of_weights * acc_.mom2) *
-                     delta_w;
-
-    acc_.mom2 += rhs.acc_.mom2 + ww * delta * delta_w;
-
-    acc_.mean += rhs.acc_.sum_of_weights * delta_w;
-
-    acc_.sum_of_weights = w;
-
-    acc_.count += rhs.acc_.count;
-
-    acc_.sum += rhs.acc_.sum;
-
-    return *this;
-  }
-
- private:
-  Accumulators<T> acc_{};
-
-  DescriptiveStatistics(const T& value, const T& weight) {
-    auto weighted_value = weight * value;
-    acc_ = std::move(Accumulators<T>{1, weight, value, weighted_value,
-                                     weighted_value, weighted_value, 0, 0, 0});
-  }
-};
-
-}  // namespace pyinterp::detail::math
+// Copyright (c) 2022 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+
+namespace pyinterp::detail::math {
+
+/// Statistics calculated by an accumulator. Each level computes the
+/// statistics of the previous one.
+enum class StatisticsLevel : uint8_t {
+  kCount,     //!< Count and sum of weights
+  kMean,      //!< Mean, minimum, maximum and sum
+  kVariance,  //!< Variance
+  kFull,      //!< Skewness and kurtosis
+};
+
+/// Handled accumulators
+template <typename T, StatisticsLevel Level = StatisticsLevel::kFull>
+struct Accumulators {
+  uint64_t count;
+  T sum_of_weights;
+  T mean;
+  T min;
+  T max;
+  T sum;
+  T mom2;
+  T mom3;
+  T mom4;
+};
+
+/// Accumulators of the counts
+template <typename T>
+struct Accumulators<T, StatisticsLevel::kCount> {
+  uint64_t count;
+  T sum_of_weights;
+};
+
+/// Accumulators of the means
+template <typename T>
+struct Accumulators<T, StatisticsLevel::kMean> {
+  uint64_t count;
+  T sum_of_weights;
+  T mean;
+  T min;
+  T max;
+  T sum;
+};
+
+/// Accumulators of the variances
+template <typename T>
+struct Accumulators<T, StatisticsLevel::kVariance> {
+  uint64_t count;
+  T sum_of_weights;
+  T mean;
+  T min;
+  T max;
+  T sum;
+  T mom2;
+};
+
+/// Univariate descriptive statistics
+/// Reference: Numerically stable, scalable formulas for parallel and online
+/// computation of higher-order multivariate central moments with arbitrary
+/// weights
+/// https://doi.org/10.1007/s00180-015-0637-z
+///
+/// @tparam T Type of the values.
+/// @tparam Level Statistics calculated: the accumulators of the lower levels
+/// are smaller and their update skips the moments not calculated. The
+/// statistics not calculated are NaN.
+template <typename T, StatisticsLevel Level = StatisticsLevel::kFull>
+class DescriptiveStatistics {
+ public:
+  /// Accumulators handled by this object.
+  using accumulators_t = Accumulators<T, Level>;
+
+  /// Number of values whose moments are calculated together by `push`.
+  static constexpr size_t kBlockSize = 256;
+
+  /// Number of partial sums updated in parallel, one per SIMD lane.
+  static constexpr size_t kLanes = 8;
+
+  /// Default constructor
+  DescriptiveStatistics() { clear(); };
+
+  /// Create of a new object from statistical incremental values
+  explicit DescriptiveStatistics(accumulators_t acc) : acc_(std::move(acc)) {}
+
+  /// Returns the raw statistical incremental values
+  explicit operator const accumulators_t&() const { return acc_; }
+
+  /// Reset the accumulator
+  constexpr auto clear() noexcept -> void {
+    std::memset(&acc_, 0, sizeof(accumulators_t));
+  }
+
+  /// Push a new value into the accumulator
+  constexpr auto operator()(const T& value) noexcept -> void {
+    const auto r = acc_.sum_of_weights;
+
+    if (r == 0) {
+      *this = std::move(DescriptiveStatistics(value, 1));
+    } else {
+      acc_.sum_of_weights += 1;
+      acc_.count += 1;
+      if constexpr (kHasMean) {
+        acc_.sum += value;
+
+        const auto inv_n = 1 / acc_.sum_of_weights;
+        const auto delta = value - acc_.mean;
+        const auto A = delta * inv_n;
+
+        acc_.mean += A;
+        if constexpr (kHasMoments) {
+          acc_.mom4 +=
+              A * (A * A * delta * r *
+                       (acc_.sum_of_weights * (acc_.sum_of_weights - 3.) +
+                        3.) +
+                   6. * A * acc_.mom2 - 4. * acc_.mom3);
+        }
+        if constexpr (kHasVariance) {
+          const auto B = value - acc_.mean;
+
+          if constexpr (kHasMoments) {
+            acc_.mom3 += A * (B * delta * (acc_.sum_of_weights - 2.) -
+                              3. * acc_.mom2);
+          }
+          acc_.mom2 += delta * B;
+        }
+
+        if (value < acc_.min) {
+          acc_.min = value;
+        } else if (value > acc_.max) {
+          acc_.max = value;
+        }
+      }
+    }
+  }
+
+  /// push a new value into the accumulator associated with a weight
+  constexpr auto operator()(const T& value, const T& weight) noexcept -> void {
+    if (acc_.sum_of_weights == 0) {
+      *this = std::move(DescriptiveStatistics(value, weight));
+    } else {
+      this->operator+=(DescriptiveStatistics(value, weight));
+    }
+  }
+
+  /// Push the values of the range [first, last) into the accumulator. NaNs
+  /// are ignored.
+  ///
+  /// The moments of each block of kBlockSize values are calculated in two
+  /// passes, around the mean of the block, with independent partial sums
+  /// that the compiler can vectorize. The blocks are then combined with the
+  /// accumulator using the parallel merge formula. The result is the same as
+  /// pushing the values one by one, with a rounding error at least as small.
+  auto push(const T* first, const T* last) -> void {
+    while (first != last) {
+      const auto size =
+          std::min(static_cast<size_t>(last - first), kBlockSize);
+      *this += block(first, size);
+      first += size;
+    }
+  }
+
+  /// Returns the number of samples pushed into the accumulator.
+  [[nodiscard]] constexpr auto count() const noexcept -> uint64_t {
+    return acc_.count;
+  }
+
+  /// Returns the sum of weights pushed into the accumulator.
+  [[nodiscard]] constexpr auto sum_of_weights() const noexcept -> const T& {
+    return acc_.sum_of_weights;
+  }
+
+  /// Returns the sum of the values pushed into the accumulator.
+  [[nodiscard]] constexpr auto sum() const noexcept -> T {
+    if constexpr (kHasMean) {
+      return acc_.sum;
+    } else {
+      return std::numeric_limits<T>::quiet_NaN();
+    }
+  }
+
+  /// Returns the mean of the samples
+  [[nodiscard]] constexpr auto mean() const noexcept -> T {
+    if constexpr (kHasMean) {
+      return acc_.count == 0 ? std::numeric_limits<T>::quiet_NaN()
+                             : acc_.mean;
+    } else {
+      return std::numeric_limits<T>::quiet_NaN();
+    }
+  }
+
+  /// Returns the min of the samples
+  [[nodiscard]] constexpr auto min() const noexcept -> T {
+    if constexpr (kHasMean) {
+      return acc_.count == 0 ? std::numeric_limits<T>::quiet_NaN() : acc_.min;
+    } else {
+      return std::numeric_limits<T>::quiet_NaN();
+    }
+  }
+
+  /// Returns the max of the samples
+  [[nodiscard]] constexpr auto max() const noexcept -> T {
+    if constexpr (kHasMean) {
+      return acc_.count == 0 ? std::numeric_limits<T>::quiet_NaN() : acc_.max;
+    } else {
+      return std::numeric_limits<T>::quiet_NaN();
+    }
+  }
+
+  /// Returns the variance of the samples
+  [[nodiscard]] constexpr auto variance(const int ddof = 0) const noexcept
+      -> T {
+    if constexpr (kHasVariance) {
+      const auto cardinal = acc_.sum_of_weights - ddof;
+      return cardinal <= 0 ? std::numeric_limits<T>::quiet_NaN()
+                           : acc_.mom2 / cardinal;
+    } else {
+      return std::numeric_limits<T>::quiet_NaN();
+    }
+  }
+
+  /// Returns the standard deviation of the samples
+  [[nodiscard]] inline auto std(const int ddof = 0) const noexcept -> T {
+    return std::sqrt(variance(ddof));
+  }
+
+  /// Returns the skewness of the samples
+  [[nodiscard]] inline auto skewness() const noexcept -> T {
+    if constexpr (kHasMoments) {
+      return acc_.mom2 == 0 ? std::numeric_limits<T>::quiet_NaN()
+                            : std::sqrt(acc_.sum_of_weights) * acc_.mom3 /
+                                  std::pow(acc_.mom2, T(1.5));
+    } else {
+      return std::numeric_limits<T>::quiet_NaN();
+    }
+  }
+
+  /// Returns the kurtosis of the samples
+  [[nodiscard]] constexpr auto kurtosis() const noexcept -> T {
+    if constexpr (kHasMoments) {
+      return acc_.mom2 == 0
+                 ? std::numeric_limits<T>::quiet_NaN()
+                 : acc_.sum_of_weights * acc_.mom4 / (acc_.mom2 * acc_.mom2) -
+                       T(3);
+    } else {
+      return std::numeric_limits<T>::quiet_NaN();
+    }
+  }
+
+  /// Combines two accumulators.
+  constexpr auto operator+=(const DescriptiveStatistics& rhs) noexcept
+      -> DescriptiveStatistics& {
+    // An empty accumulator has no minimum nor maximum to compare with.
+    if (rhs.acc_.count == 0) {
+      return *this;
+    }
+    if (acc_.count == 0) {
+      return *this = rhs;
+    }
+
+    auto w = acc_.sum_of_weights + rhs.acc_.sum_of_weights;
+
+    if constexpr (kHasMean) {
+      if (rhs.acc_.min < acc_.min) {
+        acc_.min = rhs.acc_.min;
+      }
+
+      if (rhs.acc_.max > acc_.max) {
+        acc_.max = rhs.acc_.max;
+      }
+
+      const auto delta = rhs.acc_.mean - acc_.mean;
+      const auto delta_w = delta / w;
+
+      if constexpr (kHasVariance) {
+        const auto delta2_w2 = delta_w * delta_w;
+
+        const auto w2 = acc_.sum_of_weights * acc_.sum_of_weights;
+        const auto ww = acc_.sum_of_weights * rhs.acc_.sum_of_weights;
+        const auto rhs_w2 = rhs.acc_.sum_of_weights * rhs.acc_.sum_of_weights;
+
+        if constexpr (kHasMoments) {
+          acc_.mom4 +=
+              rhs.acc_.mom4 +
+              ww * (w2 - ww + rhs_w2) * delta * delta_w * delta2_w2 +
+              6. * (w2 * rhs.acc_.mom2 + rhs_w2 * acc_.mom2) * delta2_w2 +
+              4. *
+                  (acc_.sum_of_weights * rhs.acc_.mom3 -
+                   rhs.acc_.sum_of_weights * acc_.mom3) *
+                  delta_w;
+
+          acc_.mom3 += rhs.acc_.mom3 +
+                       ww * (acc_.sum_of_weights - rhs.acc_.sum_of_weights) *
+                           delta * delta2_w2 +
+                       3. *
+                           (acc_.sum_of_weights * rhs.acc_.mom2 -
+                            rhs.acc_.sum_of_weights * acc_.mom2) *
+                           delta_w;
+        }
+
+        acc_.mom2 += rhs.acc_.mom2 + ww * delta * delta_w;
+      }
+
+      acc_.mean += rhs.acc_.sum_of_weights * delta_w;
+
+      acc_.sum += rhs.acc_.sum;
+    }
+
+    acc_.sum_of_weights = w;
+
+    acc_.count += rhs.acc_.count;
+
+    return *this;
+  }
+
+  /// Removes the statistics of a subset of the samples pushed into this
+  /// accumulator, by inverting the formulas used to combine them. The
+  /// minimum and the maximum cannot be updated this way: they remain those
+  /// of all the samples pushed. Each removal adds rounding errors: the
+  /// statistics should be recomputed from the samples from time to time.
+  constexpr auto operator-=(const DescriptiveStatistics& rhs) noexcept
+      -> DescriptiveStatistics& {
+    if (rhs.acc_.count == 0) {
+      return *this;
+    }
+    if (rhs.acc_.count >= acc_.count) {
+      clear();
+      return *this;
+    }
+
+    const auto w = acc_.sum_of_weights;
+    const auto w_rhs = rhs.acc_.sum_of_weights;
+    const auto w_lhs = w - w_rhs;
+
+    if constexpr (kHasMean) {
+      // Mean of the remaining samples, and its distance to the mean of the
+      // samples removed, as defined by operator+=.
+      const auto mean = acc_.mean - w_rhs * (rhs.acc_.mean - acc_.mean) / w_lhs;
+      const auto delta = rhs.acc_.mean - mean;
+      const auto delta_w = delta / w;
+
+      if constexpr (kHasVariance) {
+        const auto ww = w_lhs * w_rhs;
+        const auto mom2 = std::max<T>(
+            acc_.mom2 - rhs.acc_.mom2 - ww * delta * delta_w, T(0));
+
+        if constexpr (kHasMoments) {
+          const auto delta2_w2 = delta_w * delta_w;
+          const auto w2 = w_lhs * w_lhs;
+          const auto rhs_w2 = w_rhs * w_rhs;
+          const auto mom3 =
+              acc_.mom3 - rhs.acc_.mom3 -
+              ww * (w_lhs - w_rhs) * delta * delta2_w2 -
+              3. * (w_lhs * rhs.acc_.mom2 - w_rhs * mom2) * delta_w;
+
+          acc_.mom4 -=
+              rhs.acc_.mom4 +
+              ww * (w2 - ww + rhs_w2) * delta * delta_w * delta2_w2 +
+              6. * (w2 * rhs.acc_.mom2 + rhs_w2 * mom2) * delta2_w2 +
+              4. * (w_lhs * rhs.acc_.mom3 - w_rhs * mom3) * delta_w;
+          acc_.mom3 = mom3;
+        }
+
+        acc_.mom2 = mom2;
+      }
+
+      acc_.mean = mean;
+
+      acc_.sum -= rhs.acc_.sum;
+    }
+
+    acc_.sum_of_weights = w_lhs;
+
+    acc_.count -= rhs.acc_.count;
+
+    return *this;
+  }
+
+ private:
+  /// True if the mean, the minimum, the maximum and the sum are calculated.
+  static constexpr bool kHasMean = Level >= StatisticsLevel::kMean;
+  /// True if the variance is calculated.
+  static constexpr bool kHasVariance = Level >= StatisticsLevel::kVariance;
+  /// True if the skewness and the kurtosis are calculated.
+  static constexpr bool kHasMoments = Level == StatisticsLevel::kFull;
+
+  accumulators_t acc_{};
+
+  DescriptiveStatistics(const T& value, const T& weight) {
+    acc_.count = 1;
+    acc_.sum_of_weights = weight;
+    if constexpr (kHasMean) {
+      auto weighted_value = weight * value;
+      acc_.mean = value;
+      acc_.min = weighted_value;
+      acc_.max = weighted_value;
+      acc_.sum = weighted_value;
+    }
+  }
+
+  /// Calculates the statistics of a block of values, NaNs excluded.
+  static auto block(const T* values, const size_t size)
+      -> DescriptiveStatistics {
+    auto count = std::array<uint64_t, kLanes>{};
+    auto sum = std::array<T, kLanes>{};
+    auto min = std::array<T, kLanes>{};
+    auto max = std::array<T, kLanes>{};
+    min.fill(std::numeric_limits<T>::infinity());
+    max.fill(-std::numeric_limits<T>::infinity());
+
+    // The lanes are updated independently, the remaining values are
+    // accumulated in the first one. A comparison with a NaN is always false,
+    // so they are never selected as min or max.
+    const auto full = size - size % kLanes;
+    for (size_t ix = 0; ix < full; ix += kLanes) {
+      for (size_t jx = 0; jx < kLanes; ++jx) {
+        const auto value = values[ix + jx];
+        const auto valid = value == value;
+        count[jx] += valid;
+        if constexpr (kHasMean) {
+          sum[jx] += valid ? value : T(0);
+          min[jx] = value < min[jx] ? value : min[jx];
+          max[jx] = value > max[jx] ? value : max[jx];
+        }
+      }
+    }
+    for (auto ix = full; ix < size; ++ix) {
+      const auto value = values[ix];
+      const auto valid = value == value;
+      count[0] += valid;
+      if constexpr (kHasMean) {
+        sum[0] += valid ? value : T(0);
+        min[0] = value < min[0] ? value : min[0];
+        max[0] = value > max[0] ? value : max[0];
+      }
+    }
+
+    auto result = DescriptiveStatistics();
+    auto& acc = result.acc_;
+    for (size_t jx = 0; jx < kLanes; ++jx) {
+      acc.count += count[jx];
+    }
+    if (acc.count == 0) {
+      return result;
+    }
+    acc.sum_of_weights = static_cast<T>(acc.count);
+    if constexpr (kHasMean) {
+      for (size_t jx = 0; jx < kLanes; ++jx) {
+        acc.sum += sum[jx];
+      }
+      acc.mean = acc.sum / acc.sum_of_weights;
+      acc.min = *std::min_element(min.begin(), min.end());
+      acc.max = *std::max_element(max.begin(), max.end());
+    }
+
+    // Second pass: central moments around the mean of the block.
+    if constexpr (kHasVariance) {
+      auto mom2 = std::array<T, kLanes>{};
+      auto mom3 = std::array<T, kLanes>{};
+      auto mom4 = std::array<T, kLanes>{};
+      const auto mean = acc.mean;
+      for (size_t ix = 0; ix < full; ix += kLanes) {
+        for (size_t jx = 0; jx < kLanes; ++jx) {
+          const auto value = values[ix + jx];
+          const auto delta = value == value ? value - mean : T(0);
+          const auto delta2 = delta * delta;
+          mom2[jx] += delta2;
+          if constexpr (kHasMoments) {
+            mom3[jx] += delta2 * delta;
+            mom4[jx] += delta2 * delta2;
+          }
+        }
+      }
+      for (auto ix = full; ix < size; ++ix) {
+        const auto value = values[ix];
+        const auto delta = value == value ? value - mean : T(0);
+        const auto delta2 = delta * delta;
+        mom2[0] += delta2;
+        if constexpr (kHasMoments) {
+          mom3[0] += delta2 * delta;
+          mom4[0] += delta2 * delta2;
+        }
+      }
+      for (size_t jx = 0; jx < kLanes; ++jx) {
+        acc.mom2 += mom2[jx];
+        if constexpr (kHasMoments) {
+          acc.mom3 += mom3[jx];
+          acc.mom4 += mom4[jx];
+        }
+      }
+    }
+    return result;
+  }
+};
+
+}  // namespace pyinterp::detail::math
@@ -0,0 +1,42 @@
+// Copyright (c) 2022 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+#pragma once
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+namespace pyinterp::detail::math {
+
+/// Converts an IEEE 754 half-precision floating-point number, given by its
+/// bits, into a single-precision floating-point number.
+///
+/// @param bits Bits of the half-precision number.
+/// @return the number converted, exactly.
+inline auto float16_to_float32(const uint16_t bits) noexcept -> float {
+  const auto sign = static_cast<uint32_t>(bits & 0x8000U) << 16U;
+  const auto exponent = static_cast<uint32_t>(bits >> 10U) & 0x1fU;
+  const auto mantissa = static_cast<uint32_t>(bits & 0x3ffU);
+
+  // Subnormal numbers are not normalized in single precision: they are
+  // computed from their mantissa.
+  if (exponent == 0) {
+    const auto value = std::ldexp(static_cast<float>(mantissa), -24);
+    return sign != 0 ? -value : value;
+  }
+
+  auto result = sign | (mantissa << 13U);
+  if (exponent == 0x1f) {
+    // Infinity or NaN
+    result |= 0x7f800000U;
+  } else {
+    result |= (exponent + (127 - 15)) << 23U;
+  }
+  auto value = float();
+  std::memcpy(&value, &result, sizeof(value));
+  return value;
+}
+
+}  // namespace pyinterp::detail::math
@@ -4,9 +4,13 @@
 // BSD-style license that can be found in the LICENSE file.
 #pragma once
 #include <Eigen/Core>
+#include <array>
+#include <cassert>
+#include <cstdint>
 #include <memory>
 
 #include "pyinterp/detail/math.hpp"
+#include "pyinterp/detail/profiling.hpp"
 #include "pyinterp/eigen.hpp"
 
 namespace pyinterp::detail::math {
@@ -24,6 +28,8 @@ class CoordsXY {
     auto ny = y_size << 1U;
     x_->resize(nx);
     y_->resize(ny);
+    x_indexes_.resize(nx);
+    y_indexes_.resize(ny);
   }
 
   /// Creates a new instance from existing coordinates
@@ -86,6 +92,18 @@ class CoordsXY {
     return y_;
   }
 
+  /// Get the x-coordinates of the window.
+  [[nodiscard]] inline auto x_values() const noexcept
+      -> const Eigen::VectorXd & {
+    return *x_;
+  }
+
+  /// Get the y-coordinates of the window.
+  [[nodiscard]] inline auto y_values() const noexcept
+      -> const Eigen::VectorXd & {
+    return *y_;
+  }
+
   /// Get the ith x-axis.
   [[nodiscard]] inline auto x(const Eigen::Index ix) const -> double {
     return (*x_)(ix);
@@ -108,9 +126,62 @@ class CoordsXY {
     return math::normalize_angle(xi, (*x_)(0), 360.0);
   }
 
+  /// Get the indexes of the grid elements loaded along the x-axis.
+  constexpr auto x_indexes() noexcept -> Vector<int64_t> & {
+    return x_indexes_;
+  }
+
+  /// Get the indexes of the grid elements loaded along the y-axis.
+  constexpr auto y_indexes() noexcept -> Vector<int64_t> & {
+    return y_indexes_;
+  }
+
+  /// Returns true if the frame holds the grid values located by the stored
+  /// indexes, which can then be reused by the next point processed.
+  [[nodiscard]] constexpr auto is_loaded() const noexcept -> bool {
+    return loaded_;
+  }
+
+  /// Sets whether the frame holds the grid values located by the stored
+  /// indexes.
+  constexpr auto is_loaded(const bool value) noexcept -> void {
+    loaded_ = value;
+  }
+
+  /// Returns true if the values of the frame have been modified by the last
+  /// load. Otherwise, the interpolation coefficients computed for the
+  /// previous point are still valid.
+  [[nodiscard]] constexpr auto is_updated() const noexcept -> bool {
+    return updated_;
+  }
+
+  /// Sets whether the values of the frame have been modified by the last
+  /// load.
+  constexpr auto is_updated(const bool value) noexcept -> void {
+    updated_ = value;
+  }
+
+ protected:
+  /// Records, in the profiler, the memory held by the frame: its coordinates,
+  /// their indexes, and the given number of bytes allocated by the derived
+  /// class. The copies of the frame share this record.
+  auto account(const size_t bytes) -> void {
+    if (profiling::enabled()) {
+      auto size = static_cast<size_t>(x_->size() + y_->size());
+      memory_ = std::make_shared<profiling::Allocation>(
+          profiling::kLoadFrame,
+          size * (sizeof(double) + sizeof(int64_t)) + bytes);
+    }
+  }
+
  private:
   std::shared_ptr<Eigen::VectorXd> x_{};
   std::shared_ptr<Eigen::VectorXd> y_{};
+  Vector<int64_t> x_indexes_{};
+  Vector<int64_t> y_indexes_{};
+  bool loaded_{false};
+  bool updated_{false};
+  std::shared_ptr<profiling::Allocation> memory_{};
 };
 
 /// Set of coordinates/values used for interpolation
@@ -129,7 +200,17 @@ class CoordsXY {
 /// Array2D({{x1, x2, ..., xn}, {y1, y2, ..., yn}},
 ///         {q11, q12, ..., q21, q22, ...., qnn})
 /// @endcode
-class Frame2D : public CoordsXY {
+///
+/// @tparam XSize Number of values of the window along the x-axis, or
+/// Eigen::Dynamic if the window size is chosen at runtime.
+/// @tparam YSize Number of values of the window along the y-axis.
+template <int XSize = Eigen::Dynamic, int YSize = XSize>
+class Frame2D;
+
+/// Frame whose window size is chosen at runtime. Its values are allocated on
+/// the heap, and can be shared with the layers of the 3D and 4D frames.
+template <>
+class Frame2D<Eigen::Dynamic, Eigen::Dynamic> : public CoordsXY {
  public:
   /// Default constructor
   Frame2D() = delete;
@@ -138,6 +219,7 @@ class Frame2D : public CoordsXY {
   Frame2D(const Eigen::Index x_size, const Eigen::Index y_size)
       : CoordsXY(x_size, y_size), q_(new Eigen::MatrixXd) {
     q_->resize(x()->size(), y()->size());
+    account(static_cast<size_t>(q_->size()) * sizeof(double));
   }
 
   /// Creates a new Array from existing coordinates/values
@@ -180,6 +262,12 @@ class Frame2D : public CoordsXY {
     return q_;
   }
 
+  /// Get the values of the window.
+  [[nodiscard]] inline auto q_values() const noexcept
+      -> const Eigen::MatrixXd & {
+    return *q_;
+  }
+
   /// Get the value at coordinate (ix, jx).
   [[nodiscard]] inline auto q(const Eigen::Index ix,
                               const Eigen::Index jx) const -> double {
@@ -199,11 +287,186 @@ class Frame2D : public CoordsXY {
   std::shared_ptr<Eigen::MatrixXd> q_{};
 };
 
+/// Set of coordinates used for interpolation, whose window sizes are
+/// compile-time constants. The coordinates are stored in the instance, so
+/// that a frame declared in a function lives on the stack.
+///
+/// @tparam XSize Number of values of the window along the x-axis.
+/// @tparam YSize Number of values of the window along the y-axis.
+template <int XSize, int YSize>
+class FixedCoordsXY {
+ public:
+  static_assert(XSize > 0 && XSize % 2 == 0 && YSize > 0 && YSize % 2 == 0,
+                "the window sizes must be positive and even");
+
+  /// Type of the x-coordinates
+  using XVector = Eigen::Matrix<double, XSize, 1>;
+
+  /// Type of the y-coordinates
+  using YVector = Eigen::Matrix<double, YSize, 1>;
+
+  /// Default constructor
+  FixedCoordsXY() = delete;
+
+  /// Creates a new instance
+  ///
+  /// @param x_size Half size of the window in abscissa, i.e. XSize / 2.
+  /// @param y_size Half size of the window in ordinate, i.e. YSize / 2.
+  FixedCoordsXY([[maybe_unused]] const Eigen::Index x_size,
+                [[maybe_unused]] const Eigen::Index y_size) {
+    assert(x_size << 1U == XSize && y_size << 1U == YSize);
+  }
+
+  /// Creates a new instance from existing coordinates
+  FixedCoordsXY(const XVector &x, const YVector &y) : x_(x), y_(y) {}
+
+  /// Get the half size of the window in abscissa.
+  [[nodiscard]] constexpr auto nx() const noexcept -> Eigen::Index {
+    return XSize >> 1;
+  }
+
+  /// Get the half size of the window in ordinate.
+  [[nodiscard]] constexpr auto ny() const noexcept -> Eigen::Index {
+    return YSize >> 1;
+  }
+
+  /// Get the x-coordinates of the window.
+  [[nodiscard]] constexpr auto x_values() const noexcept -> const XVector & {
+    return x_;
+  }
+
+  /// Get the y-coordinates of the window.
+  [[nodiscard]] constexpr auto y_values() const noexcept -> const YVector & {
+    return y_;
+  }
+
+  /// Get the ith x-axis.
+  [[nodiscard]] inline auto x(const Eigen::Index ix) const -> double {
+    return x_(ix);
+  }
+
+  /// Get the ith y-axis.
+  [[nodiscard]] inline auto y(const Eigen::Index jx) const -> double {
+    return y_(jx);
+  }
+
+  /// Set the ith x-axis.
+  inline auto x(const Eigen::Index ix) -> double & { return x_(ix); }
+
+  /// Set the ith y-axis.
+  inline auto y(const Eigen::Index jx) -> double & { return y_(jx); }
+
+  /// Normalizes the angle with respect to the first value of the X axis of this
+  /// array.
+  [[nodiscard]] inline auto normalize_angle(const double xi) const -> double {
+    return math::normalize_angle(xi, x_(0), 360.0);
+  }
+
+  /// Get the indexes of the grid elements loaded along the x-axis.
+  constexpr auto x_indexes() noexcept -> Eigen::Matrix<int64_t, XSize, 1> & {
+    return x_indexes_;
+  }
+
+  /// Get the indexes of the grid elements loaded along the y-axis.
+  constexpr auto y_indexes() noexcept -> Eigen::Matrix<int64_t, YSize, 1> & {
+    return y_indexes_;
+  }
+
+  /// Returns true if the frame holds the grid values located by the stored
+  /// indexes, which can then be reused by the next point processed.
+  [[nodiscard]] constexpr auto is_loaded() const noexcept -> bool {
+    return loaded_;
+  }
+
+  /// Sets whether the frame holds the grid values located by the stored
+  /// indexes.
+  constexpr auto is_loaded(const bool value) noexcept -> void {
+    loaded_ = value;
+  }
+
+  /// Returns true if the values of the frame have been modified by the last
+  /// load.
+  [[nodiscard]] constexpr auto is_updated() const noexcept -> bool {
+    return updated_;
+  }
+
+  /// Sets whether the values of the frame have been modified by the last
+  /// load.
+  constexpr auto is_updated(const bool value) noexcept -> void {
+    updated_ = value;
+  }
+
+ private:
+  XVector x_{};
+  YVector y_{};
+  Eigen::Matrix<int64_t, XSize, 1> x_indexes_{};
+  Eigen::Matrix<int64_t, YSize, 1> y_indexes_{};
+  bool loaded_{false};
+  bool updated_{false};
+};
+
+/// Frame whose window size is a compile-time constant, selected by the
+/// bindings for the common window sizes. Its values are stored in a
+/// fixed-size matrix, so the loops reading and fitting them have constant
+/// trip counts. Unlike the dynamic frame, it is not recorded by the memory
+/// profiler, because it does not allocate memory.
+template <int XSize, int YSize>
+class Frame2D : public FixedCoordsXY<XSize, YSize> {
+ public:
+  /// Type of the values of the window
+  using QMatrix = Eigen::Matrix<double, XSize, YSize>;
+
+  /// Default constructor
+  Frame2D() = delete;
+
+  /// Creates a new instance
+  Frame2D(const Eigen::Index x_size, const Eigen::Index y_size)
+      : FixedCoordsXY<XSize, YSize>(x_size, y_size) {}
+
+  /// Creates a new instance from existing coordinates/values
+  Frame2D(const typename FixedCoordsXY<XSize, YSize>::XVector &x,
+          const typename FixedCoordsXY<XSize, YSize>::YVector &y,
+          const QMatrix &q)
+      : FixedCoordsXY<XSize, YSize>(x, y), q_(q) {}
+
+  /// Get the values of the window.
+  [[nodiscard]] constexpr auto q_values() const noexcept -> const QMatrix & {
+    return q_;
+  }
+
+  /// Get the value at coordinate (ix, jx).
+  [[nodiscard]] inline auto q(const Eigen::Index ix,
+                              const Eigen::Index jx) const -> double {
+    return q_(ix, jx);
+  }
+
+  /// Get the value at coordinate (ix, jx).
+  inline auto q(const Eigen::Index ix, const Eigen::Index jx) -> double & {
+    return q_(ix, jx);
+  }
+
+  /// Returns true if this instance does not contains at least one Not A Number
+  /// (NaN).
+  [[nodiscard]] inline auto is_valid() const -> bool { return !q_.hasNaN(); }
+
+ private:
+  QMatrix q_{};
+};
+
 /// Set of coordinates/values used for 3D-interpolation
 ///
 /// @tparam Z-Axis type
+/// @tparam XSize Number of values of the window along the x-axis, or
+/// Eigen::Dynamic if the window size is chosen at runtime.
+/// @tparam YSize Number of values of the window along the y-axis.
+template <typename T, int XSize = Eigen::Dynamic, int YSize = XSize>
+class Frame3D;
+
+/// 3D frame whose window size is chosen at runtime.
+///
+/// @tparam Z-Axis type
 template <typename T>
-class Frame3D : public CoordsXY {
+class Frame3D<T, Eigen::Dynamic, Eigen::Dynamic> : public CoordsXY {
  public:
   /// Default constructor
   Frame3D() = delete;
@@ -214,16 +477,20 @@ class Frame3D : public CoordsXY {
       : CoordsXY(x_size, y_size), z_() {
     auto nz = z_size << 1U;
     z_.resize(nz);
+    z_indexes_.resize(nz);
     q_.resize(nz);
 
     for (auto iz = 0U; iz < nz; ++iz) {
       q_(iz) = std::make_shared<Eigen::MatrixXd>(x()->size(), y()->size());
     }
+    account(static_cast<size_t>(nz) *
+            (sizeof(T) + sizeof(int64_t) +
+             static_cast<size_t>(x()->size() * y()->size()) * sizeof(double)));
   }
 
   /// Get the set of coordinates/values for the ith z-layer
-  [[nodiscard]] auto frame_2d(const Eigen::Index iz) const -> Frame2D {
-    return Frame2D(x(), y(), q_(iz));
+  [[nodiscard]] auto frame_2d(const Eigen::Index iz) const -> Frame2D<> {
+    return Frame2D<>(x(), y(), q_(iz));
   }
 
   /// Default destructor
@@ -270,6 +537,11 @@ class Frame3D : public CoordsXY {
   /// Set the ith z-axis.
   inline auto z(const Eigen::Index ix) -> T & { return z_(ix); }
 
+  /// Get the indexes of the grid elements loaded along the z-axis.
+  constexpr auto z_indexes() noexcept -> Vector<int64_t> & {
+    return z_indexes_;
+  }
+
   /// Get the value at coordinate (ix, jx, kx).
   inline auto q(const Eigen::Index ix, const Eigen::Index jx,
                 const Eigen::Index kx) -> double & {
@@ -289,9 +561,85 @@ class Frame3D : public CoordsXY {
 
  private:
   Vector<T> z_;
+  Vector<int64_t> z_indexes_;
   Vector<std::shared_ptr<Eigen::MatrixXd>> q_;
 };
 
+/// 3D frame whose window size is a compile-time constant. It holds the two
+/// layers framing the z-coordinate, i.e. its half window along the z-axis is
+/// 1, the size used by the bicubic interpolation of the 3D grids.
+///
+/// @tparam Z-Axis type
+template <typename T, int XSize, int YSize>
+class Frame3D : public FixedCoordsXY<XSize, YSize> {
+ public:
+  /// Type of the values of a layer
+  using QMatrix = Eigen::Matrix<double, XSize, YSize>;
+
+  /// Default constructor
+  Frame3D() = delete;
+
+  /// Creates a new instance
+  ///
+  /// @param z_size Half size of the window along the z-axis, i.e. 1.
+  Frame3D(const Eigen::Index x_size, const Eigen::Index y_size,
+          [[maybe_unused]] const Eigen::Index z_size)
+      : FixedCoordsXY<XSize, YSize>(x_size, y_size) {
+    assert(z_size == 1);
+  }
+
+  /// Get the set of coordinates/values for the ith z-layer. The values are
+  /// copied, which costs less than fitting them.
+  [[nodiscard]] auto frame_2d(const Eigen::Index iz) const
+      -> Frame2D<XSize, YSize> {
+    return Frame2D<XSize, YSize>(this->x_values(), this->y_values(), q_[iz]);
+  }
+
+  /// Get the half size of the window in z.
+  [[nodiscard]] constexpr auto nz() const noexcept -> Eigen::Index {
+    return 1;
+  }
+
+  /// Get z-coordinates
+  constexpr auto z() noexcept -> Eigen::Matrix<T, 2, 1> & { return z_; }
+
+  /// Get z-coordinates
+  [[nodiscard]] constexpr auto z() const noexcept
+      -> const Eigen::Matrix<T, 2, 1> & {
+    return z_;
+  }
+
+  /// Get the ith z-axis.
+  [[nodiscard]] inline auto z(const Eigen::Index ix) const -> T {
+    return z_(ix);
+  }
+
+  /// Set the ith z-axis.
+  inline auto z(const Eigen::Index ix) -> T & { return z_(ix); }
+
+  /// Get the indexes of the grid elements loaded along the z-axis.
+  constexpr auto z_indexes() noexcept -> Eigen::Matrix<int64_t, 2, 1> & {
+    return z_indexes_;
+  }
+
+  /// Get the value at coordinate (ix, jx, kx).
+  inline auto q(const Eigen::Index ix, const Eigen::Index jx,
+                const Eigen::Index kx) -> double & {
+    return q_[kx](ix, jx);
+  }
+
+  /// Returns true if this instance does not contains at least one Not A Number
+  /// (NaN).
+  [[nodiscard]] inline auto is_valid() const -> bool {
+    return !q_[0].hasNaN() && !q_[1].hasNaN();
+  }
+
+ private:
+  Eigen::Matrix<T, 2, 1> z_{};
+  Eigen::Matrix<int64_t, 2, 1> z_indexes_{};
+  std::array<QMatrix, 2> q_{};
+};
+
 /// Set of coordinates/values used for 4D-interpolation
 ///
 /// @tparam Z-Axis type
@@ -309,6 +657,8 @@ class Frame4D : public CoordsXY {
     auto nu = u_size << 1U;
     z_.resize(nz);
     u_.resize(nu);
+    z_indexes_.resize(nz);
+    u_indexes_.resize(nu);
     q_.resize(nz, nu);
 
     for (auto iz = 0U; iz < nz; ++iz) {
@@ -317,12 +667,16 @@ class Frame4D : public CoordsXY {
             std::make_shared<Eigen::MatrixXd>(x()->size(), y()->size());
       }
     }
+    account(static_cast<size_t>(nz) * (sizeof(T) + sizeof(int64_t)) +
+            static_cast<size_t>(nu) * (sizeof(double) + sizeof(int64_t)) +
+            static_cast<size_t>(nz * nu * x()->size() * y()->size()) *
+                sizeof(double));
   }
 
   /// Get the set of coordinates/values for the ith z-layer
   [[nodiscard]] auto frame_2d(const Eigen::Index iz,
-                              const Eigen::Index iu) const -> Frame2D {
-    return Frame2D(x(), y(), q_(iz, iu));
+                              const Eigen::Index iu) const -> Frame2D<> {
+    return Frame2D<>(x(), y(), q_(iz, iu));
   }
 
   /// Default destructor
@@ -390,6 +744,16 @@ class Frame4D : public CoordsXY {
   /// Set the ith u-axis.
   inline auto u(const Eigen::Index ix) -> double & { return u_(ix); }
 
+  /// Get the indexes of the grid elements loaded along the z-axis.
+  constexpr auto z_indexes() noexcept -> Vector<int64_t> & {
+    return z_indexes_;
+  }
+
+  /// Get the indexes of the grid elements loaded along the u-axis.
+  constexpr auto u_indexes() noexcept -> Vector<int64_t> & {
+    return u_indexes_;
+  }
+
   /// Get the value at coordinate (ix, jx, kx, lx).
   inline auto q(const Eigen::Index ix, const Eigen::Index jx,
                 const Eigen::Index kx, const Eigen::Index lx) -> double & {
@@ -412,6 +776,8 @@ class Frame4D : public CoordsXY {
  private:
   Vector<T> z_;
   Eigen::VectorXd u_;
+  Vector<int64_t> z_indexes_;
+  Vector<int64_t> u_indexes_;
   Matrix<std::shared_ptr<Eigen::MatrixXd>> q_;
 };
 
@@ -0,0 +1,486 @@
+// Copyright (c) 2022 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+#pragma once
+#include <Eigen/Core>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <exception>
+#include <numeric>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+#include "pyinterp/detail/thread.hpp"
+#include "pyinterp/eigen.hpp"
+
+namespace pyinterp::detail::math {
+
+/// Get the index of the previous pixel along an axis. The axis is either
+/// periodic or mirrored at its ends.
+constexpr auto previous_index(const int64_t ix, const int64_t size,
+                              const bool is_circle) noexcept -> int64_t {
+  return ix == 0 ? (is_circle ? size - 1 : 1) : ix - 1;
+}
+
+/// Get the index of the next pixel along an axis. The axis is either periodic
+/// or mirrored at its ends.
+constexpr auto next_index(const int64_t ix, const int64_t size,
+                          const bool is_circle) noexcept -> int64_t {
+  return ix == size - 1 ? (is_circle ? 0 : size - 2) : ix + 1;
+}
+
+/// Undefined pixel of the grid, with the positions of its four neighbors in
+/// the buffer of the grid. The periodicity of the X axis and the mirroring of
+/// the ends of the axes are resolved once for all the iterations.
+struct ActiveCell {
+  /// Position of the pixel.
+  int64_t index;
+  /// Positions of the previous and next pixels along the X axis, then along
+  /// the Y axis.
+  std::array<int64_t, 4> neighbors;
+};
+
+/// Builds the description of the undefined pixel (ix, iy).
+///
+/// @param shape Number of pixels of the grid along the X and Y axes.
+/// @param strides Distances between two consecutive pixels of the buffer of
+/// the grid along the X and Y axes.
+/// @param is_circle True if the X axis of the grid defines a circle.
+inline auto active_cell(const int64_t ix, const int64_t iy,
+                        const std::array<int64_t, 2>& shape,
+                        const std::array<int64_t, 2>& strides,
+                        const bool is_circle) noexcept -> ActiveCell {
+  auto position = [&strides](const int64_t ix, const int64_t iy) -> int64_t {
+    return ix * strides[0] + iy * strides[1];
+  };
+  return {position(ix, iy),
+          {position(previous_index(ix, shape[0], is_circle), iy),
+           position(next_index(ix, shape[0], is_circle), iy),
+           position(ix, previous_index(iy, shape[1], false)),
+           position(ix, next_index(iy, shape[1], false))}};
+}
+
+/// Get the shape and the strides of a grid.
+template <typename Grid>
+inline auto grid_layout(const Grid& grid)
+    -> std::array<std::array<int64_t, 2>, 2> {
+  return {{{static_cast<int64_t>(grid.rows()),
+            static_cast<int64_t>(grid.cols())},
+           {static_cast<int64_t>(grid.innerStride()),
+            static_cast<int64_t>(grid.outerStride())}}};
+}
+
+/// Updates the value of an undefined pixel from its four neighbors.
+///
+/// @return the residual of the pixel.
+template <typename Type>
+inline auto relax(Type* data, const ActiveCell& cell, const Type relaxation)
+    -> Type {
+  auto residual =
+      (Type(0.25) * (data[cell.neighbors[0]] + data[cell.neighbors[1]] +
+                     data[cell.neighbors[2]] + data[cell.neighbors[3]]) -
+       data[cell.index]) *
+      relaxation;
+  data[cell.index] += residual;
+  return residual;
+}
+
+/// Undefined pixels of a band of rows of the grid, processed by one thread of
+/// the lexicographic ordering, in the order of processing.
+struct Strip {
+  /// Undefined pixels of the band.
+  std::vector<ActiveCell> cells{};
+  /// The pixels of the column ix are the items [columns[ix], columns[ix + 1])
+  /// of the list.
+  std::vector<size_t> columns{};
+};
+
+/// Lists the undefined pixels of the grid processed by the lexicographic
+/// ordering: the grid is cut into bands of rows along the Y axis, one for each
+/// thread, and each band is processed column by column.
+///
+/// @param grid The grid to be processed
+/// @param mask Matrix describing the undefined pixels of the grid.
+/// @param is_circle True if the X axis of the grid defines a circle.
+/// @param num_threads The number of threads to use for the computation.
+template <typename Grid>
+auto lexicographic_cells(const Grid& grid, const Matrix<bool>& mask,
+                         const bool is_circle, const size_t num_threads)
+    -> std::vector<Strip> {
+  const auto [shape, strides] = grid_layout(grid);
+  auto result = std::vector<Strip>(std::max(num_threads, size_t(1)));
+  auto shift = shape[1] / static_cast<int64_t>(result.size());
+
+  for (size_t index = 0; index < result.size(); ++index) {
+    auto& strip = result[index];
+    auto y_start = static_cast<int64_t>(index) * shift;
+    auto y_end = index == result.size() - 1 ? shape[1] : y_start + shift;
+    strip.columns.reserve(shape[0] + 1);
+    strip.columns.push_back(0);
+    for (int64_t ix = 0; ix < shape[0]; ++ix) {
+      for (auto iy = y_start; iy < y_end; ++iy) {
+        if (mask(ix, iy)) {
+          strip.cells.push_back(active_cell(ix, iy, shape, strides, is_circle));
+        }
+      }
+      strip.columns.push_back(strip.cells.size());
+    }
+  }
+  return result;
+}
+
+///  Replaces all undefined values (NaN) in a grid using the Gauss-Seidel
+///  method by relaxation, with the lexicographic ordering.
+///
+/// Each band of rows is processed by a thread, which waits until the previous
+/// band has processed a column before processing it.
+///
+/// @param grid The grid to be processed
+/// @param strips Undefined pixels of each band, as returned by
+/// lexicographic_cells.
+/// @param relaxation Relaxation constant
+/// @param tolerance Residual value below which a pixel has converged.
+/// @param retire If true, the pixels that have converged are removed from the
+/// lists: they are no longer updated by the next iterations.
+/// @return maximum residual value and number of pixels that have not
+/// converged.
+template <typename Type, typename Grid>
+auto lexicographic_gauss_seidel(Grid& grid, std::vector<Strip>& strips,
+                                const Type relaxation, const Type tolerance,
+                                const bool retire)
+    -> std::tuple<Type, size_t> {
+  auto* data = grid.data();
+  auto num_threads = strips.size();
+
+  // Maximum residual values and number of pixels that have not converged for
+  // each thread.
+  std::vector<Type> max_residuals(num_threads);
+  std::vector<size_t> unconverged(num_threads);
+
+  // Captures the detected exceptions in the calculation function
+  // (only the last exception captured is kept)
+  auto except = std::exception_ptr(nullptr);
+
+  // Thread worker responsible for processing a band of rows of the grid.
+  //
+  // @param strip Undefined pixels of the band.
+  // @param max_residual Maximum residual of this strip.
+  // @param count Number of pixels of this strip that have not converged.
+  // @param pipe_out Last column processed in this band.
+  // @param pipe_in Last column processed in the previous band.
+  auto worker = [&](Strip* strip, Type* max_residual, size_t* count,
+                    std::atomic<int64_t>* pipe_out,
+                    std::atomic<int64_t>* pipe_in) -> void {
+    // Initialization of the maximum value of the residuals of the treated
+    // strips.
+    *max_residual = Type(0);
+    *count = 0;
+
+    try {
+      auto& cells = strip->cells;
+      auto& columns = strip->columns;
+      auto x_size = static_cast<int64_t>(columns.size()) - 1;
+      auto retained = size_t(0);
+
+      for (int64_t ix = 0; ix < x_size; ++ix) {
+        // If necessary, check that this column has been processed in the
+        // previous band.
+        if (pipe_in) {
+          while (*pipe_in < ix) {
+            std::this_thread::sleep_for(std::chrono::nanoseconds(5));
+          }
+        }
+
+        auto first = columns[ix];
+        auto last = columns[ix + 1];
+        columns[ix] = retained;
+        for (auto item = first; item < last; ++item) {
+          auto residual = std::fabs(relax(data, cells[item], relaxation));
+          *max_residual = std::max(*max_residual, residual);
+          if (!(residual < tolerance)) {
+            ++*count;
+          } else if (retire) {
+            continue;
+          }
+          cells[retained++] = cells[item];
+        }
+
+        // If necessary, the other thread responsible for processing the next
+        // band is notified.
+        if (pipe_out) {
+          *pipe_out = ix;
+        }
+      }
+      columns[x_size] = retained;
+      cells.resize(retained);
+    } catch (...) {
+      except = std::current_exception();
+    }
+  };
+
+  if (num_threads == 1) {
+    worker(&strips[0], &max_residuals[0], &unconverged[0], nullptr, nullptr);
+  } else {
+    std::vector<std::atomic<int64_t>> pipeline(num_threads);
+    std::vector<std::thread> threads;
+
+    for (auto& item : pipeline) {
+      item = -1;
+    }
+    for (size_t index = 0; index < num_threads; ++index) {
+      threads.emplace_back(
+          worker, &strips[index], &max_residuals[index], &unconverged[index],
+          index == num_threads - 1 ? nullptr : &pipeline[index],
+          index == 0 ? nullptr : &pipeline[index - 1]);
+    }
+    for (auto&& item : threads) {
+      item.join();
+    }
+  }
+  if (except != nullptr) {
+    std::rethrow_exception(except);
+  }
+  return std::make_tuple(
+      *std::max_element(max_residuals.begin(), max_residuals.end()),
+      std::accumulate(unconverged.begin(), unconverged.end(), size_t(0)));
+}
+
+/// Number of colors used by the red-black ordering.
+constexpr size_t kColors = 4;
+
+/// Undefined pixels of a grid grouped by color.
+using ColoredCells = std::array<std::vector<ActiveCell>, kColors>;
+
+/// Groups the undefined pixels of the grid by color, so that no pixel has a
+/// neighbor of the same color: the pixels of the same color can then be
+/// updated in parallel.
+///
+/// The pixels are colored as a checkerboard. If the X axis is a circle with an
+/// odd number of pixels, the last column would have the same color as the
+/// first one: it uses two additional colors.
+///
+/// @param grid The grid to be processed
+/// @param mask Matrix describing the undefined pixels of the grid.
+/// @param is_circle True if the X axis of the grid defines a circle.
+/// @return the undefined pixels of each color, sorted in memory order.
+template <typename Grid>
+auto red_black_cells(const Grid& grid, const Matrix<bool>& mask,
+                     const bool is_circle) -> ColoredCells {
+  const auto [shape, strides] = grid_layout(grid);
+  auto odd_circle = is_circle && (shape[0] & 1) == 1;
+  auto result = ColoredCells();
+
+  auto push_back = [&](const int64_t ix, const int64_t iy) {
+    if (mask(ix, iy)) {
+      auto color =
+          odd_circle && ix == shape[0] - 1 ? 2 + (iy & 1) : (ix + iy) & 1;
+      result[color].push_back(active_cell(ix, iy, shape, strides, is_circle));
+    }
+  };
+
+  // The pixels are listed in the order of the buffer of the grid.
+  if (strides[0] <= strides[1]) {
+    for (int64_t iy = 0; iy < shape[1]; ++iy) {
+      for (int64_t ix = 0; ix < shape[0]; ++ix) {
+        push_back(ix, iy);
+      }
+    }
+  } else {
+    for (int64_t ix = 0; ix < shape[0]; ++ix) {
+      for (int64_t iy = 0; iy < shape[1]; ++iy) {
+        push_back(ix, iy);
+      }
+    }
+  }
+  return result;
+}
+
+/// Updates the undefined pixels of a color in parallel.
+///
+/// @param data Buffer of the grid to be processed.
+/// @param color The undefined pixels of the color.
+/// @param relaxation Relaxation constant
+/// @param tolerance Residual value below which a pixel has converged.
+/// @param retire If true, the pixels that have converged are removed from the
+/// list: they are no longer updated by the next iterations.
+/// @param num_threads The number of threads to use for the computation.
+/// @return maximum residual value and number of pixels that have not
+/// converged.
+template <typename Type>
+auto relax_color(Type* data, std::vector<ActiveCell>& color,
+                 const Type relaxation, const Type tolerance,
+                 const bool retire, const size_t num_threads)
+    -> std::tuple<Type, size_t> {
+  if (color.empty()) {
+    return std::make_tuple(Type(0), size_t(0));
+  }
+  // Maximum residual value and number of pixels that have not converged for
+  // each block of pixels processed.
+  auto blocks = std::min(color.size(), std::max(num_threads, size_t(1)) * 8);
+  auto max_residuals = std::vector<Type>(blocks, Type(0));
+  auto retained = std::vector<size_t>(blocks, 0);
+
+  detail::dispatch(
+      [&](const size_t start, const size_t end) {
+        for (auto block = start; block < end; ++block) {
+          auto& max_residual = max_residuals[block];
+          auto first = block * color.size() / blocks;
+          auto last = (block + 1) * color.size() / blocks;
+          auto count = size_t(0);
+          for (auto item = first; item < last; ++item) {
+            auto residual = std::fabs(relax(data, color[item], relaxation));
+            max_residual = std::max(max_residual, residual);
+            if (!(residual < tolerance)) {
+              if (retire) {
+                color[first + count] = color[item];
+              }
+              ++count;
+            }
+          }
+          retained[block] = count;
+        }
+      },
+      blocks, num_threads);
+
+  auto unconverged =
+      std::accumulate(retained.begin(), retained.end(), size_t(0));
+
+  // The pixels retained by each block are gathered at the beginning of the
+  // list.
+  if (retire) {
+    auto position = size_t(0);
+    for (size_t block = 0; block < blocks; ++block) {
+      auto first = color.begin() + block * color.size() / blocks;
+      position = static_cast<size_t>(
+          std::move(first, first + retained[block], color.begin() + position) -
+          color.begin());
+    }
+    color.resize(position);
+  }
+  return std::make_tuple(
+      *std::max_element(max_residuals.begin(), max_residuals.end()),
+      unconverged);
+}
+
+/// Performs one iteration of the Gauss-Seidel method using the red-black
+/// ordering: all the pixels of a color are updated in parallel, then those of
+/// the next color.
+///
+/// @param grid The grid to be processed
+/// @param cells The undefined pixels grouped by color, as returned by
+/// red_black_cells.
+/// @param relaxation Relaxation constant
+/// @param tolerance Residual value below which a pixel has converged.
+/// @param retire If true, the pixels that have converged are removed from the
+/// lists: they are no longer updated by the next iterations.
+/// @param num_threads The number of threads to use for the computation.
+/// @return maximum residual value and number of pixels that have not
+/// converged.
+template <typename Type, typename Grid>
+auto red_black_gauss_seidel(Grid& grid, ColoredCells& cells,
+                            const Type relaxation, const Type tolerance,
+                            const bool retire, const size_t num_threads)
+    -> std::tuple<Type, size_t> {
+  auto* data = grid.data();
+  auto result = Type(0);
+  auto unconverged = size_t(0);
+
+  for (auto& color : cells) {
+    auto [residual, count] =
+        relax_color(data, color, relaxation, tolerance, retire, num_threads);
+    result = std::max(result, residual);
+    unconverged += count;
+  }
+  return std::make_tuple(result, unconverged);
+}
+
+/// Get the number of colors used by the red-black ordering of a grid: the
+/// checkerboard needs two additional colors if the X axis is a circle with an
+/// odd number of pixels.
+constexpr auto red_black_colors(const int64_t x_size,
+                                const bool is_circle) noexcept -> size_t {
+  return is_circle && (x_size & 1) == 1 ? kColors : 2;
+}
+
+/// Groups by color, as red_black_cells does for the whole grid, the undefined
+/// pixels of a tile of a grid decomposed into tiles.
+///
+/// The buffer of the tile holds its pixels surrounded by a halo of one pixel:
+/// the pixels of the neighboring tiles, or of the other end of the X axis if
+/// it is a circle. The pixels on the mirrored edges of the grid use the pixels
+/// of the tile instead of the halo. The colors are those of the pixels in the
+/// whole grid: updating a color of all the tiles, then exchanging their
+/// halos, performs the same computation as updating this color in the whole
+/// grid.
+///
+/// @param tile The tile to be processed, including its halo.
+/// @param mask Matrix describing the undefined pixels of the tile, without
+/// its halo.
+/// @param origin Position of the first pixel of the tile in the grid.
+/// @param shape Number of pixels of the grid along the X and Y axes.
+/// @param is_circle True if the X axis of the grid defines a circle.
+/// @return the undefined pixels of each color, sorted in memory order.
+template <typename Grid>
+auto tile_cells(const Grid& tile, const Matrix<bool>& mask,
+                const std::array<int64_t, 2>& origin,
+                const std::array<int64_t, 2>& shape, const bool is_circle)
+    -> ColoredCells {
+  const auto [_, strides] = grid_layout(tile);
+  auto odd_circle = red_black_colors(shape[0], is_circle) == kColors;
+  auto result = ColoredCells();
+
+  // Get the positions, in the tile, of the neighbors of a pixel along an
+  // axis. The neighbors are read from the halo, except on the mirrored edges
+  // of the grid.
+  auto neighbors = [&](const int64_t index, const int64_t axis,
+                       const bool circle) -> std::array<int64_t, 2> {
+    if (circle) {
+      return {index, index + 2};
+    }
+    auto position = index + origin[axis];
+    return {previous_index(position, shape[axis], false) - origin[axis] + 1,
+            next_index(position, shape[axis], false) - origin[axis] + 1};
+  };
+  auto push_back = [&](const int64_t ix, const int64_t iy) {
+    if (mask(ix, iy)) {
+      auto gx = ix + origin[0];
+      auto gy = iy + origin[1];
+      auto color =
+          odd_circle && gx == shape[0] - 1 ? 2 + (gy & 1) : (gx + gy) & 1;
+      auto x_neighbors = neighbors(ix, 0, is_circle);
+      auto y_neighbors = neighbors(iy, 1, false);
+      auto position = [&strides](const int64_t ix, const int64_t iy) {
+        return ix * strides[0] + iy * strides[1];
+      };
+      result[color].push_back(
+          {position(ix + 1, iy + 1),
+           {position(x_neighbors[0], iy + 1), position(x_neighbors[1], iy + 1),
+            position(ix + 1, y_neighbors[0]),
+            position(ix + 1, y_neighbors[1])}});
+    }
+  };
+
+  // The pixels are listed in the order of the buffer of the tile.
+  if (strides[0] <= strides[1]) {
+    for (int64_t iy = 0; iy < mask.cols(); ++iy) {
+      for (int64_t ix = 0; ix < mask.rows(); ++ix) {
+        push_back(ix, iy);
+      }
+    }
+  } else {
+    for (int64_t ix = 0; ix < mask.rows(); ++ix) {
+      for (int64_t iy = 0; iy < mask.cols(); ++iy) {
+        push_back(ix, iy);
+      }
+    }
+  }
+  return result;
+}
+
+}  // namespace pyinterp::detail::math
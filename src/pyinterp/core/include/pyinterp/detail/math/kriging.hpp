@@ -0,0 +1,214 @@
+// Copyright (c) 2022 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+#pragma once
+#include <Eigen/Core>
+#include <Eigen/LU>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "pyinterp/detail/lru_cache.hpp"
+#include "pyinterp/eigen.hpp"
+
+namespace pyinterp::detail::math {
+
+namespace covariance {
+
+/// Known covariance functions.
+enum Function : uint8_t {
+  kMatern12,
+  kMatern32,
+  kMatern52,
+  kGaussian,
+  kSpherical,
+};
+
+/// Matérn covariance function with ν = 1/2 (exponential).
+template <typename T>
+auto matern_12(const T& d, const T& sigma, const T& lambda) -> T {
+  return sigma * std::exp(-d / lambda);
+}
+
+/// Matérn covariance function with ν = 3/2.
+template <typename T>
+auto matern_32(const T& d, const T& sigma, const T& lambda) -> T {
+  auto ratio = std::sqrt(T(3)) * d / lambda;
+  return sigma * (1 + ratio) * std::exp(-ratio);
+}
+
+/// Matérn covariance function with ν = 5/2.
+template <typename T>
+auto matern_52(const T& d, const T& sigma, const T& lambda) -> T {
+  auto ratio = std::sqrt(T(5)) * d / lambda;
+  return sigma * (1 + ratio + ratio * ratio / 3) * std::exp(-ratio);
+}
+
+/// Gaussian covariance function.
+template <typename T>
+auto gaussian(const T& d, const T& sigma, const T& lambda) -> T {
+  auto ratio = d / lambda;
+  return sigma * std::exp(-ratio * ratio / 2);
+}
+
+/// Spherical covariance function.
+template <typename T>
+auto spherical(const T& d, const T& sigma, const T& lambda) -> T {
+  if (d < lambda) {
+    auto ratio = d / lambda;
+    return sigma * (1 - ratio * (T(1.5) - ratio * ratio / 2));
+  }
+  return T(0);
+}
+
+}  // namespace covariance
+
+/// Ordinary kriging: the value at a point is estimated by the linear
+/// combination of the values of the nodes minimizing the variance of the
+/// error, under the constraint that the weights sum to one. The spatial
+/// structure of the data is described by a covariance function of the
+/// distance between points.
+template <typename T>
+class Kriging {
+ public:
+  /// Pointer to the covariance function used.
+  using PtrCovarianceFunction = T (*)(const T&, const T&, const T&);
+
+  /// Kriging system of a set of nodes. The factorization of the system is
+  /// independent of the point to estimate, so that it can be reused by all
+  /// the points selecting the same nodes.
+  struct Model {
+    /// Coordinates of the nodes
+    Matrix<T> xk;
+    /// Factorization of the kriging matrix, bordered by the unbiasedness
+    /// constraint.
+    Eigen::FullPivLU<Matrix<T>> lu;
+    /// Solution of the system for the values of the nodes. The estimate at a
+    /// point is the dot product of this vector with the covariances between
+    /// the point and the nodes, bordered by 1.
+    Vector<T> alpha;
+  };
+
+  /// Default constructor
+  ///
+  /// @param sigma Variance of the process (sill of the covariance function).
+  /// @param lambda Length scale of the covariance function.
+  /// @param nugget Variance of the measurement noise, added to the variance
+  /// of the nodes.
+  /// @param function The covariance function.
+  Kriging(const T& sigma, const T& lambda, const T& nugget,
+          const covariance::Function function)
+      : sigma_(sigma), lambda_(lambda), nugget_(nugget) {
+    if (!(sigma > 0) || !(lambda > 0)) {
+      throw std::invalid_argument("sigma and lambda must be strictly positive");
+    }
+    if (nugget < 0) {
+      throw std::invalid_argument("nugget must be positive");
+    }
+    switch (function) {
+      case covariance::Function::kMatern12:
+        function_ = &covariance::matern_12;
+        break;
+      case covariance::Function::kMatern32:
+        function_ = &covariance::matern_32;
+        break;
+      case covariance::Function::kMatern52:
+        function_ = &covariance::matern_52;
+        break;
+      case covariance::Function::kGaussian:
+        function_ = &covariance::gaussian;
+        break;
+      case covariance::Function::kSpherical:
+        function_ = &covariance::spherical;
+        break;
+      default:
+        throw std::invalid_argument("Covariance function unknown: " +
+                                    std::to_string(static_cast<int>(function)));
+    }
+  }
+
+  /// Calculates the covariance between two points.
+  ///
+  /// @param d Distance between the points.
+  [[nodiscard]] auto operator()(const T& d) const -> T {
+    return function_(d, sigma_, lambda_);
+  }
+
+  /// Builds and factorizes the kriging system of the nodes provided.
+  ///
+  /// @param xk Coordinates of the nodes
+  /// @param yk Values of the nodes
+  /// @return the kriging system of the nodes.
+  [[nodiscard]] auto fit(const Eigen::Ref<const Matrix<T>>& xk,
+                         const Eigen::Ref<const Vector<T>>& yk) const
+      -> Model {
+    const auto size = xk.cols();
+    auto A = Matrix<T>(size + 1, size + 1);
+    for (Eigen::Index ix = 0; ix < size; ++ix) {
+      A(ix, ix) = (*this)(0) + nugget_;
+      for (Eigen::Index jx = ix + 1; jx < size; ++jx) {
+        A(ix, jx) = A(jx, ix) = (*this)((xk.col(ix) - xk.col(jx)).norm());
+      }
+      A(ix, size) = A(size, ix) = T(1);
+    }
+    A(size, size) = T(0);
+
+    auto rhs = Vector<T>(size + 1);
+    rhs << yk, T(0);
+
+    auto result = Model{xk, Eigen::FullPivLU<Matrix<T>>(A), Vector<T>()};
+    result.alpha = result.lu.solve(rhs);
+    return result;
+  }
+
+  /// Estimates the value at a point.
+  ///
+  /// @param model Kriging system calculated by fit.
+  /// @param xi Coordinates of the point.
+  /// @return a pair containing the estimated value and the variance of the
+  /// estimation error.
+  [[nodiscard]] auto evaluate(const Model& model,
+                              const Eigen::Ref<const Vector<T>>& xi) const
+      -> std::pair<T, T> {
+    const auto size = model.xk.cols();
+    auto c0 = Vector<T>(size + 1);
+    for (Eigen::Index ix = 0; ix < size; ++ix) {
+      c0(ix) = (*this)((model.xk.col(ix) - xi).norm());
+    }
+    c0(size) = T(1);
+
+    // Only a back-substitution is needed to get the kriging weights and the
+    // Lagrange multiplier.
+    const Vector<T> weights = model.lu.solve(c0);
+    const auto variance = (*this)(0) - weights.dot(c0);
+    return std::make_pair(c0.dot(model.alpha), std::max(variance, T(0)));
+  }
+
+ private:
+  /// Variance of the process
+  T sigma_;
+
+  /// Length scale of the covariance function
+  T lambda_;
+
+  /// Variance of the measurement noise
+  T nugget_;
+
+  /// Covariance function used
+  PtrCovarianceFunction function_;
+};
+
+/// Least recently used cache of the kriging systems solved for sets of nodes,
+/// keyed by the sorted identifiers of the nodes.
+///
+/// @tparam T The type of the estimated values.
+/// @tparam Key The type of the identifiers of the nodes.
+template <typename T, typename Key>
+using KrigingCache = LRUCache<std::vector<Key>, typename Kriging<T>::Model>;
+
+}  // namespace pyinterp::detail::math
@@ -0,0 +1,144 @@
+// Copyright (c) 2022 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+#pragma once
+#include <Eigen/Core>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#include "pyinterp/detail/math.hpp"
+#include "pyinterp/eigen.hpp"
+
+namespace pyinterp::detail::math {
+
+/// Tri-cube weight function: w(d) = (1 - |d|^3)^3 if |d| <= 1, otherwise 0.
+///
+/// @param d Normalized distance to the center of the window.
+template <typename T>
+constexpr auto tricube(const T d) noexcept -> T {
+  auto x = std::fabs(d);
+  if (x > 1) {
+    return T(0);
+  }
+  x = T(1) - x * x * x;
+  return x * x * x;
+}
+
+/// Weights of the tri-cube function on a window of a grid whose axes are
+/// regular.
+///
+/// The distance between two pixels depends only on the difference of their
+/// indexes: the weights are computed once for all the pixels of the grid.
+template <typename T>
+class LoessKernel {
+ public:
+  /// Default constructor
+  ///
+  /// @param nx Half size of the window along the X axis.
+  /// @param ny Half size of the window along the Y axis.
+  /// @param x_step Step of the X axis.
+  /// @param y_step Step of the Y axis.
+  LoessKernel(const int64_t nx, const int64_t ny, const double x_step,
+              const double y_step)
+      : nx_(nx),
+        ny_(ny),
+        x_scale_(x_step / static_cast<double>(nx)),
+        y_scale_(y_step / static_cast<double>(ny)),
+        weights_(ny * 2 + 1, nx * 2 + 1) {
+    for (int64_t dx = -nx; dx <= nx; ++dx) {
+      for (int64_t dy = -ny; dy <= ny; ++dy) {
+        weights_(dy + ny, dx + nx) = compute(dx, dy);
+      }
+    }
+  }
+
+  /// Get the weight of a pixel shifted by (dx, dy) from the center of the
+  /// window.
+  [[nodiscard]] inline auto operator()(const int64_t dx,
+                                       const int64_t dy) const noexcept -> T {
+    if (dx < -nx_ || dx > nx_ || dy < -ny_ || dy > ny_) {
+      return compute(dx, dy);
+    }
+    return weights_(dy + ny_, dx + nx_);
+  }
+
+  /// Accumulates the weighted values of a column of the window: the pixels
+  /// shifted by dx along the X axis, and by -ny to ny along the Y axis.
+  ///
+  /// @param dx Shift of the column along the X axis.
+  /// @param values Pointer to the value of the first pixel of the column.
+  /// @param stride Number of elements between two pixels of the column.
+  /// @param value Sum of the weighted values of the defined pixels.
+  /// @param weight Sum of the weights of the defined pixels.
+  inline auto accumulate(const int64_t dx, const T* values,
+                         const int64_t stride, T& value, T& weight) const
+      noexcept -> void {
+    const auto* kernel = weights_.col(dx + nx_).data();
+    const auto size = weights_.rows();
+
+    // Independent partial sums: the additions do not wait for each other.
+    T partial_value[kLanes]{};
+    T partial_weight[kLanes]{};
+    Eigen::Index ix = 0;
+    for (; ix + kLanes <= size; ix += kLanes) {
+      for (Eigen::Index lane = 0; lane < kLanes; ++lane) {
+        add(kernel[ix + lane], values[(ix + lane) * stride],
+            partial_value[lane], partial_weight[lane]);
+      }
+    }
+    for (; ix < size; ++ix) {
+      add(kernel[ix], values[ix * stride], partial_value[0],
+          partial_weight[0]);
+    }
+    for (Eigen::Index lane = 0; lane < kLanes; ++lane) {
+      value += partial_value[lane];
+      weight += partial_weight[lane];
+    }
+  }
+
+ private:
+  /// Number of partial sums computed by accumulate.
+  static constexpr Eigen::Index kLanes = 4;
+
+  int64_t nx_;
+  int64_t ny_;
+  double x_scale_;
+  double y_scale_;
+  Matrix<T> weights_;
+
+  /// Adds a weighted value to a sum if it is defined. The undefined values
+  /// are cleared by a bit mask rather than tested: on grids with many
+  /// undefined values, the branches would be mispredicted.
+  static inline auto add(T wi, T zi, T& value, T& weight) noexcept -> void {
+    using Bits = std::conditional_t<sizeof(T) == 8, uint64_t, uint32_t>;
+    const auto mask = Bits(0) - static_cast<Bits>(zi == zi);
+    wi = masked(wi, mask);
+    zi = masked(zi, mask);
+    value += wi * zi;
+    weight += wi;
+  }
+
+  /// Applies a bit mask to a value.
+  template <typename Bits>
+  static inline auto masked(const T x, const Bits mask) noexcept -> T {
+    static_assert(sizeof(Bits) == sizeof(T));
+    auto bits = Bits(0);
+    std::memcpy(&bits, &x, sizeof(T));
+    bits &= mask;
+    auto result = T(0);
+    std::memcpy(&result, &bits, sizeof(T));
+    return result;
+  }
+
+  /// Computes the weight of a pixel shifted by (dx, dy).
+  [[nodiscard]] inline auto compute(const int64_t dx, const int64_t dy) const
+      -> T {
+    return static_cast<T>(
+        tricube(std::sqrt(sqr(x_scale_ * dx) + sqr(y_scale_ * dy))));
+  }
+};
+
+}  // namespace pyinterp::detail::math
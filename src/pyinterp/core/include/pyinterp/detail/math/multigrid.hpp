@@ -0,0 +1,543 @@
+// Copyright (c) 2022 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+#pragma once
+#include <Eigen/Core>
+#include <array>
+#include <cstdint>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "pyinterp/detail/math/gauss_seidel.hpp"
+#include "pyinterp/detail/thread.hpp"
+#include "pyinterp/eigen.hpp"
+
+namespace pyinterp::detail::math {
+
+/// Geometric multigrid solver of the Laplace equation on the masked pixels of
+/// a grid, the other pixels defining the boundary conditions.
+///
+/// Each V-cycle smooths the high-frequency components of the error with a few
+/// Gauss-Seidel sweeps, then solves the residual equation on a grid twice as
+/// coarse, and so on recursively. The low-frequency components of the error,
+/// which the relaxation alone reduces very slowly, are thus eliminated on the
+/// coarse grids for a cost proportional to the number of pixels.
+///
+/// The pixel (kx, jx) of a coarse grid is the pixel (2 * kx, 2 * jx) of the
+/// finer grid, and is undefined if the latter is undefined. The corrections
+/// are interpolated bilinearly from a coarse grid to the finer grid, and the
+/// operator of a coarse grid is the Galerkin product of the operator of the
+/// finer grid by this interpolation: the coarse grid correction remains
+/// accurate near the boundaries of the undefined areas, whatever their shape.
+///
+/// @tparam Type Type of the values of the grid.
+template <typename Type>
+class Multigrid {
+ public:
+  /// Default constructor
+  ///
+  /// @param grid The grid to be processed
+  /// @param mask Matrix describing the undefined pixels of the grid.
+  /// @param is_circle True if the X axis of the grid defines a circle.
+  /// @param num_threads The number of threads to use for the computation.
+  template <typename Grid>
+  Multigrid(const Grid& grid, const Matrix<bool>& mask, const bool is_circle,
+            const size_t num_threads)
+      : mask_(mask),
+        is_circle_(is_circle),
+        cells_(red_black_cells(grid, mask, is_circle)),
+        num_threads_(num_threads) {
+    while (true) {
+      const auto& fine = levels_.empty() ? mask_ : levels_.back().mask;
+      auto x_size = (fine.rows() + 1) >> 1;
+      auto y_size = (fine.cols() + 1) >> 1;
+      if (x_size < kMinSize || y_size < kMinSize) {
+        break;
+      }
+      auto coarse = Level(fine, x_size, y_size, is_circle_);
+      if (coarse.cells.empty()) {
+        break;
+      }
+      galerkin_product(coarse);
+      levels_.emplace_back(std::move(coarse));
+    }
+  }
+
+  /// Get the number of grids used by the solver, including the grid to solve.
+  [[nodiscard]] inline auto levels() const noexcept -> size_t {
+    return levels_.size() + 1;
+  }
+
+  /// Performs one V-cycle.
+  ///
+  /// @param grid The grid to be processed, with the same layout as the grid
+  /// given to the constructor.
+  /// @return the maximum residual of the last relaxation of the grid, i.e. the
+  /// largest change of a pixel during this sweep.
+  template <typename Grid>
+  auto v_cycle(Grid& grid) -> Type {
+    auto residual = Type(0);
+    if (levels_.empty()) {
+      for (size_t it = 0; it < 2 * kSmoothingSweeps; ++it) {
+        residual = relax(grid);
+      }
+      return residual;
+    }
+
+    for (size_t it = 0; it < kSmoothingSweeps; ++it) {
+      relax(grid);
+    }
+    auto& coarse = levels_.front();
+    restrict_residual(mask_, coarse,
+                      [&](const int64_t ix, const int64_t iy) -> Type {
+                        return residual_at(grid, ix, iy);
+                      });
+    cycle(0);
+    prolongate(coarse, mask_, grid);
+    for (size_t it = 0; it < kSmoothingSweeps; ++it) {
+      residual = relax(grid);
+    }
+    return residual;
+  }
+
+ private:
+  /// Minimum size of the axes of the coarsest grid.
+  static constexpr int64_t kMinSize = 3;
+
+  /// Number of relaxation sweeps before and after the coarse grid correction.
+  static constexpr size_t kSmoothingSweeps = 2;
+
+  /// Number of coefficients of the operator of a coarse grid: each pixel is
+  /// coupled with its eight neighbors.
+  static constexpr int64_t kStencil = 9;
+
+  /// Index of the coefficient of the pixel itself in the stencil.
+  static constexpr int64_t kCenter = 4;
+
+  /// Number of colors used to relax the coarse grids.
+  static constexpr size_t kCoarseColors = 6;
+
+  /// Pixels of an axis with their weights: the coarse pixels interpolated to
+  /// a fine pixel, or the fine pixels restricted to a coarse pixel.
+  struct Weights {
+    std::array<int64_t, 4> index{};
+    std::array<Type, 4> weight{};
+    int64_t size{0};
+
+    /// Adds a pixel, merging its weight with the one of the same pixel if it
+    /// is already stored.
+    inline auto add(const int64_t ix, const Type value) -> void {
+      for (int64_t item = 0; item < size; ++item) {
+        if (index[item] == ix) {
+          weight[item] += value;
+          return;
+        }
+      }
+      index[size] = ix;
+      weight[size++] = value;
+    }
+  };
+
+  /// Undefined pixel of a coarse grid.
+  struct Cell {
+    int64_t ix;
+    int64_t iy;
+  };
+
+  /// Coarse grid handled by the solver.
+  struct Level {
+    /// Builds the coarse grid of a fine grid.
+    ///
+    /// @param fine Undefined pixels of the fine grid.
+    /// @param x_size Number of pixels of the coarse grid along the X axis.
+    /// @param y_size Number of pixels of the coarse grid along the Y axis.
+    /// @param is_circle True if the X axis of the grid is periodic.
+    Level(const Matrix<bool>& fine, const int64_t x_size, const int64_t y_size,
+          const bool is_circle)
+        : mask(x_size, y_size),
+          is_circle(is_circle),
+          x_parents(interpolation(fine.rows(), x_size, is_circle)),
+          y_parents(interpolation(fine.cols(), y_size, false)),
+          x_children(transpose(x_parents, x_size)),
+          y_children(transpose(y_parents, y_size)),
+          error(Matrix<Type>::Zero(x_size, y_size)),
+          source(Matrix<Type>::Zero(x_size, y_size)),
+          residual(Matrix<Type>::Zero(x_size, y_size)) {
+      auto odd_circle = is_circle && (x_size & 1) == 1;
+      for (int64_t jx = 0; jx < y_size; ++jx) {
+        for (int64_t kx = 0; kx < x_size; ++kx) {
+          mask(kx, jx) = fine(kx << 1, jx << 1);
+          if (mask(kx, jx)) {
+            // No pixel is coupled with a pixel of the same color by the
+            // nine-point stencil.
+            auto color = odd_circle && kx == x_size - 1
+                             ? 4 + (jx & 1)
+                             : (kx & 1) + ((jx & 1) << 1);
+            colors[color].push_back(cells.size());
+            cells.push_back({kx, jx});
+          }
+        }
+      }
+      stencil = Matrix<Type>::Zero(kStencil, cells.size());
+    }
+
+    /// Undefined pixels of the grid.
+    Matrix<bool> mask;
+    /// True if the X axis of the grid is periodic.
+    bool is_circle;
+    /// Interpolation of the pixels of the finer grid along each axis.
+    std::vector<Weights> x_parents;
+    std::vector<Weights> y_parents;
+    /// Restriction of the pixels of the finer grid along each axis.
+    std::vector<Weights> x_children;
+    std::vector<Weights> y_children;
+    /// Correction computed on this grid.
+    Matrix<Type> error;
+    /// Residual of the finer grid, restricted to this grid.
+    Matrix<Type> source;
+    /// Residual of the correction.
+    Matrix<Type> residual;
+    /// Undefined pixels of the grid.
+    std::vector<Cell> cells{};
+    /// Indexes of the undefined pixels grouped by color.
+    std::array<std::vector<size_t>, kCoarseColors> colors{};
+    /// Coefficients of the operator for each undefined pixel.
+    Matrix<Type> stencil{};
+
+    /// Get the index of the pixel kx + dx along the X axis, or -1 if it is
+    /// outside the grid.
+    [[nodiscard]] inline auto x_neighbor(const int64_t kx,
+                                         const int64_t dx) const noexcept
+        -> int64_t {
+      auto size = static_cast<int64_t>(mask.rows());
+      auto result = kx + dx;
+      if (result < 0 || result >= size) {
+        return is_circle ? (result + size) % size : -1;
+      }
+      return result;
+    }
+
+    /// Get the index of the pixel jx + dy along the Y axis, or -1 if it is
+    /// outside the grid.
+    [[nodiscard]] inline auto y_neighbor(const int64_t jx,
+                                         const int64_t dy) const noexcept
+        -> int64_t {
+      auto result = jx + dy;
+      return result < 0 || result >= mask.cols() ? -1 : result;
+    }
+
+    /// Get the shift, between -1 and 1, from the pixel kx to its neighbor
+    /// along the X axis.
+    [[nodiscard]] inline auto x_shift(const int64_t kx,
+                                      const int64_t other) const noexcept
+        -> int64_t {
+      auto size = static_cast<int64_t>(mask.rows());
+      auto result = other - kx;
+      if (result > 1) {
+        return result - size;
+      }
+      if (result < -1) {
+        return result + size;
+      }
+      return result;
+    }
+  };
+
+  /// Undefined pixels of the grid to solve.
+  Matrix<bool> mask_;
+  /// True if the X axis of the grid to solve is periodic.
+  bool is_circle_;
+  /// Undefined pixels of the grid to solve grouped by color.
+  ColoredCells cells_;
+  /// Coarse grids, from the finest to the coarsest.
+  std::vector<Level> levels_{};
+  /// The number of threads to use for the computation.
+  size_t num_threads_;
+
+  /// Builds the linear interpolation of a fine axis from a coarse axis.
+  static auto interpolation(const int64_t fine_size, const int64_t coarse_size,
+                            const bool is_circle) -> std::vector<Weights> {
+    auto result = std::vector<Weights>(fine_size);
+    for (int64_t ix = 0; ix < fine_size; ++ix) {
+      auto& item = result[ix];
+      if ((ix & 1) == 0) {
+        item.add(ix >> 1, Type(1));
+        continue;
+      }
+      auto next = (ix >> 1) + 1;
+      if (next == coarse_size) {
+        next = is_circle ? 0 : coarse_size - 1;
+      }
+      item.add(ix >> 1, Type(0.5));
+      item.add(next, Type(0.5));
+    }
+    return result;
+  }
+
+  /// Builds the restriction of a fine axis to a coarse axis, i.e. the
+  /// transpose of the interpolation.
+  static auto transpose(const std::vector<Weights>& parents,
+                        const int64_t coarse_size) -> std::vector<Weights> {
+    auto result = std::vector<Weights>(coarse_size);
+    for (int64_t ix = 0; ix < static_cast<int64_t>(parents.size()); ++ix) {
+      const auto& item = parents[ix];
+      for (int64_t jx = 0; jx < item.size; ++jx) {
+        result[item.index[jx]].add(ix, item.weight[jx]);
+      }
+    }
+    return result;
+  }
+
+  /// Calls the function for each coefficient of the row (ix, iy) of the
+  /// operator of the grid to solve or, if level is not null, of a coarse grid.
+  template <typename Function>
+  auto row(const Level* level, const Matrix<int64_t>& indexes,
+           const int64_t ix, const int64_t iy, const Function& function) const
+      -> void {
+    if (level == nullptr) {
+      // Five-point stencil of the Laplace operator. The defined pixels are
+      // fixed: they do not take part in the correction.
+      const auto x_size = mask_.rows();
+      const auto y_size = mask_.cols();
+      function(ix, iy, Type(4));
+      for (const auto& [kx, jx] :
+           {std::make_pair(previous_index(ix, x_size, is_circle_), iy),
+            std::make_pair(next_index(ix, x_size, is_circle_), iy),
+            std::make_pair(ix, previous_index(iy, y_size, false)),
+            std::make_pair(ix, next_index(iy, y_size, false))}) {
+        if (mask_(kx, jx)) {
+          function(kx, jx, Type(-1));
+        }
+      }
+      return;
+    }
+    auto coefficients = level->stencil.col(indexes(ix, iy));
+    for (int64_t slot = 0; slot < kStencil; ++slot) {
+      if (coefficients(slot) != 0) {
+        function(level->x_neighbor(ix, slot % 3 - 1),
+                 level->y_neighbor(iy, slot / 3 - 1), coefficients(slot));
+      }
+    }
+  }
+
+  /// Computes the operator of a coarse grid: A_coarse = P^T A_fine P, where P
+  /// is the interpolation from the coarse grid to the finer grid.
+  auto galerkin_product(Level& coarse) const -> void {
+    const auto* fine = levels_.empty() ? nullptr : &levels_.back();
+    const auto& fine_mask = fine == nullptr ? mask_ : fine->mask;
+
+    // Position of the undefined pixels of the fine grid in its stencil.
+    auto indexes = Matrix<int64_t>();
+    if (fine != nullptr) {
+      indexes.resize(fine_mask.rows(), fine_mask.cols());
+      for (size_t item = 0; item < fine->cells.size(); ++item) {
+        indexes(fine->cells[item].ix, fine->cells[item].iy) =
+            static_cast<int64_t>(item);
+      }
+    }
+
+    detail::dispatch(
+        [&](const size_t start, const size_t end) {
+          for (auto item = start; item < end; ++item) {
+            const auto& cell = coarse.cells[item];
+            const auto& cx = coarse.x_children[cell.ix];
+            const auto& cy = coarse.y_children[cell.iy];
+            auto coefficients = coarse.stencil.col(item);
+
+            for (int64_t ix = 0; ix < cx.size; ++ix) {
+              for (int64_t iy = 0; iy < cy.size; ++iy) {
+                if (!fine_mask(cx.index[ix], cy.index[iy])) {
+                  continue;
+                }
+                auto weight = cx.weight[ix] * cy.weight[iy];
+                row(fine, indexes, cx.index[ix], cy.index[iy],
+                    [&](const int64_t qx, const int64_t qy, const Type value) {
+                      const auto& px = coarse.x_parents[qx];
+                      const auto& py = coarse.y_parents[qy];
+                      for (int64_t jx = 0; jx < px.size; ++jx) {
+                        for (int64_t jy = 0; jy < py.size; ++jy) {
+                          if (!coarse.mask(px.index[jx], py.index[jy])) {
+                            continue;
+                          }
+                          auto slot = coarse.x_shift(cell.ix, px.index[jx]) +
+                                      (py.index[jy] - cell.iy) * 3 + kCenter;
+                          coefficients(slot) +=
+                              weight * value * px.weight[jx] * py.weight[jy];
+                        }
+                      }
+                    });
+              }
+            }
+          }
+        },
+        coarse.cells.size(), num_threads_);
+  }
+
+  /// Get the residual of the Laplace equation at the pixel (ix, iy) of the
+  /// grid to solve.
+  template <typename Grid>
+  inline auto residual_at(const Grid& grid, const int64_t ix,
+                          const int64_t iy) const -> Type {
+    const auto x_size = mask_.rows();
+    const auto y_size = mask_.cols();
+    return grid(previous_index(ix, x_size, is_circle_), iy) +
+           grid(next_index(ix, x_size, is_circle_), iy) +
+           grid(ix, previous_index(iy, y_size, false)) +
+           grid(ix, next_index(iy, y_size, false)) - Type(4) * grid(ix, iy);
+  }
+
+  /// Relaxes the grid to solve.
+  template <typename Grid>
+  inline auto relax(Grid& grid) -> Type {
+    return std::get<0>(red_black_gauss_seidel<Type>(
+        grid, cells_, Type(1), Type(0), false, num_threads_));
+  }
+
+  /// Applies the operator of a coarse grid, without its diagonal, to the
+  /// correction of the undefined pixel "item".
+  static inline auto off_diagonal(const Level& level, const size_t item)
+      -> Type {
+    const auto& cell = level.cells[item];
+    const auto* coefficients = level.stencil.col(item).data();
+    const auto x_size = static_cast<int64_t>(level.mask.rows());
+    auto result = Type(0);
+
+    // Inside the grid, the neighbors are read without testing the
+    // boundaries: the coefficients of the defined pixels are zero.
+    if (cell.ix > 0 && cell.ix < x_size - 1 && cell.iy > 0 &&
+        cell.iy < level.mask.cols() - 1) {
+      const auto* error = &level.error(cell.ix, cell.iy);
+      for (int64_t dy = -1; dy <= 1; ++dy) {
+        for (int64_t dx = -1; dx <= 1; ++dx) {
+          result += coefficients[(dy + 1) * 3 + dx + 1] *
+                    error[dy * x_size + dx];
+        }
+      }
+      return result - coefficients[kCenter] * error[0];
+    }
+    for (int64_t slot = 0; slot < kStencil; ++slot) {
+      if (slot != kCenter && coefficients[slot] != 0) {
+        result += coefficients[slot] *
+                  level.error(level.x_neighbor(cell.ix, slot % 3 - 1),
+                              level.y_neighbor(cell.iy, slot / 3 - 1));
+      }
+    }
+    return result;
+  }
+
+  /// Relaxes the correction of a coarse grid.
+  auto smooth(Level& level) const -> void {
+    for (const auto& color : level.colors) {
+      detail::dispatch(
+          [&](const size_t start, const size_t end) {
+            for (auto item = start; item < end; ++item) {
+              const auto& cell = level.cells[color[item]];
+              level.error(cell.ix, cell.iy) =
+                  (level.source(cell.ix, cell.iy) -
+                   off_diagonal(level, color[item])) /
+                  level.stencil(kCenter, color[item]);
+            }
+          },
+          color.size(), num_threads_);
+    }
+  }
+
+  /// Solves the residual equation of the coarse grid "ix" with a V-cycle.
+  auto cycle(const size_t ix) -> void {
+    auto& level = levels_[ix];
+    level.error.setZero();
+
+    // On the coarsest grid, the residual equation is solved by relaxation.
+    if (ix + 1 == levels_.size()) {
+      auto sweeps = static_cast<size_t>(level.mask.rows() + level.mask.cols());
+      for (size_t it = 0; it < sweeps; ++it) {
+        smooth(level);
+      }
+      return;
+    }
+
+    for (size_t it = 0; it < kSmoothingSweeps; ++it) {
+      smooth(level);
+    }
+    detail::dispatch(
+        [&](const size_t start, const size_t end) {
+          for (auto item = start; item < end; ++item) {
+            const auto& cell = level.cells[item];
+            level.residual(cell.ix, cell.iy) =
+                level.source(cell.ix, cell.iy) - off_diagonal(level, item) -
+                level.stencil(kCenter, item) * level.error(cell.ix, cell.iy);
+          }
+        },
+        level.cells.size(), num_threads_);
+
+    auto& coarse = levels_[ix + 1];
+    restrict_residual(level.mask, coarse,
+                      [&](const int64_t kx, const int64_t jx) -> Type {
+                        return level.residual(kx, jx);
+                      });
+    cycle(ix + 1);
+    prolongate(coarse, level.mask, level.error);
+    for (size_t it = 0; it < kSmoothingSweeps; ++it) {
+      smooth(level);
+    }
+  }
+
+  /// Restricts the residual of the fine grid to the coarse grid, and stores
+  /// it as the source of the coarse grid.
+  template <typename Residual>
+  auto restrict_residual(const Matrix<bool>& fine_mask, Level& coarse,
+                         const Residual& residual) const -> void {
+    detail::dispatch(
+        [&](const size_t start, const size_t end) {
+          for (auto item = start; item < end; ++item) {
+            const auto& cell = coarse.cells[item];
+            const auto& cx = coarse.x_children[cell.ix];
+            const auto& cy = coarse.y_children[cell.iy];
+            auto value = Type(0);
+            for (int64_t ix = 0; ix < cx.size; ++ix) {
+              for (int64_t iy = 0; iy < cy.size; ++iy) {
+                if (fine_mask(cx.index[ix], cy.index[iy])) {
+                  value += cx.weight[ix] * cy.weight[iy] *
+                           residual(cx.index[ix], cy.index[iy]);
+                }
+              }
+            }
+            coarse.source(cell.ix, cell.iy) = value;
+          }
+        },
+        coarse.cells.size(), num_threads_);
+  }
+
+  /// Interpolates the correction computed on the coarse grid and adds it to
+  /// the undefined pixels of the finer grid.
+  template <typename Grid>
+  auto prolongate(const Level& coarse, const Matrix<bool>& fine_mask,
+                  Grid& grid) const -> void {
+    detail::dispatch(
+        [&](const size_t start, const size_t end) {
+          for (auto iy = static_cast<int64_t>(start);
+               iy < static_cast<int64_t>(end); ++iy) {
+            const auto& py = coarse.y_parents[iy];
+            for (int64_t ix = 0; ix < fine_mask.rows(); ++ix) {
+              if (!fine_mask(ix, iy)) {
+                continue;
+              }
+              const auto& px = coarse.x_parents[ix];
+              auto value = Type(0);
+              for (int64_t jx = 0; jx < px.size; ++jx) {
+                for (int64_t jy = 0; jy < py.size; ++jy) {
+                  value += px.weight[jx] * py.weight[jy] *
+                           coarse.error(px.index[jx], py.index[jy]);
+                }
+              }
+              grid(ix, iy) += value;
+            }
+          }
+        },
+        fine_mask.cols(), num_threads_);
+  }
+};
+
+}  // namespace pyinterp::detail::math
@@ -4,10 +4,18 @@
 // BSD-style license that can be found in the LICENSE file.
 #pragma once
 #include <Eigen/Core>
+#include <Eigen/IterativeLinearSolvers>
 #include <Eigen/LU>
+#include <Eigen/SparseCore>
+#include <algorithm>
 #include <cmath>
 #include <functional>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
 
+#include "pyinterp/detail/lru_cache.hpp"
 #include "pyinterp/eigen.hpp"
 
 namespace pyinterp::detail::math {
@@ -71,6 +79,16 @@ class RBF {
     }
   }
 
+  /// Interpolant defined by a set of nodes.
+  struct Interpolant {
+    /// Coordinates of the nodes
+    Matrix<T> xk;
+    /// Weights of the nodes, solution of the linear system
+    Vector<T> weights;
+    /// Adjustable constant used by the radial function
+    T epsilon;
+  };
+
   /// Calculates the interpolated values
   ///
   /// @param xk Coordinates of the nodes
@@ -81,12 +99,39 @@ class RBF {
                                  const Eigen::Ref<const Vector<T>>& yk,
                                  const Eigen::Ref<const Matrix<T>>& xi) const
       -> Vector<T> {
+    return evaluate(fit(xk, yk), xi);
+  }
+
+  /// Solves the linear system defining the interpolant of the nodes provided.
+  ///
+  /// @param xk Coordinates of the nodes
+  /// @param yk Values of the nodes
+  /// @return the interpolant, which can be evaluated for any number of
+  /// coordinates.
+  [[nodiscard]] auto fit(const Eigen::Ref<const Matrix<T>>& xk,
+                         const Eigen::Ref<const Vector<T>>& yk) const
+      -> Interpolant {
+    auto epsilon = T(0);
+    auto A = system(xk, epsilon);
+    return {xk, RBF<T>::solve_linear_system(A, yk), epsilon};
+  }
+
+  /// Builds the matrix of the linear system defining the interpolant of the
+  /// nodes provided, so that the systems of several sets of nodes can be
+  /// solved together.
+  ///
+  /// @param xk Coordinates of the nodes
+  /// @param epsilon Adjustable constant used by the radial function for these
+  /// nodes.
+  /// @return the matrix of the system, whose solution for the values of the
+  /// nodes are the weights of the interpolant.
+  [[nodiscard]] auto system(const Eigen::Ref<const Matrix<T>>& xk,
+                            T& epsilon) const -> Matrix<T> {
     // Matrix of distances between the coordinates provided.
     const auto r = RBF::distance_matrix(xk, xk);
 
     // Default epsilon to approximate average distance between nodes
-    const auto epsilon =
-        std::isnan(epsilon_) ? 1 / RBF<T>::average(r) : epsilon_;
+    epsilon = std::isnan(epsilon_) ? 1 / RBF<T>::average(r) : epsilon_;
 
     // TODO(fbriol)
     auto A = function_(r, epsilon);
@@ -95,9 +140,20 @@ class RBF {
     if (smooth_) {
       A -= Matrix<T>::Identity(xk.cols(), xk.cols()) * smooth_;
     }
+    return A;
+  }
 
-    return function_(distance_matrix(xk, xi), epsilon) *
-           RBF<T>::solve_linear_system(A, yk);
+  /// Evaluates an interpolant
+  ///
+  /// @param interpolant Interpolant calculated by fit.
+  /// @param xi Coordinates to evaluate the interpolant at.
+  /// @return interpolated values for each coordinates provided.
+  [[nodiscard]] auto evaluate(const Interpolant& interpolant,
+                              const Eigen::Ref<const Matrix<T>>& xi) const
+      -> Vector<T> {
+    return function_(distance_matrix(interpolant.xk, xi),
+                     interpolant.epsilon) *
+           interpolant.weights;
   }
 
  private:
@@ -189,4 +245,126 @@ class RBF {
   }
 };
 
+/// Least recently used cache of the interpolants solved for sets of nodes.
+///
+/// Neighboring query points often select the same nodes. Finding the
+/// interpolant of these nodes in the cache avoids solving the linear system
+/// again, leaving only its evaluation. The key is the sorted identifiers of
+/// the nodes.
+///
+/// @tparam T The type of the interpolated values.
+/// @tparam Key The type of the identifiers of the nodes.
+template <typename T, typename Key>
+using RBFCache = LRUCache<std::vector<Key>, typename RBF<T>::Interpolant>;
+
+/// Radial basis function interpolation over all the nodes of a data set,
+/// using the compactly supported Wendland function
+/// φ(r) = (1 - r/ρ)⁴(4r/ρ + 1) for r < ρ and 0 beyond the support radius ρ.
+///
+/// Since each node only interacts with the nodes of its support, the
+/// interpolation matrix is sparse and positive definite: its size grows with
+/// the number of nodes times the number of neighbors, and the linear system
+/// is solved once, by the conjugate gradient method, for all the points to
+/// interpolate.
+template <typename T>
+class CompactRBF {
+ public:
+  /// Neighbors of a node: index of the neighbor and distance to the node.
+  using Neighbors = std::vector<std::pair<Eigen::Index, T>>;
+
+  /// Default constructor
+  ///
+  /// @param support Radius of the support of the function.
+  /// @param smooth Values greater than zero increase the smoothness of the
+  /// approximation. 0 is for interpolation (default), the function will
+  /// always go through the nodal points in this case.
+  CompactRBF(const T& support, const T& smooth)
+      : support_(support), smooth_(smooth) {
+    if (!(support > 0)) {
+      throw std::invalid_argument(
+          "the support radius must be strictly positive");
+    }
+    if (smooth < 0) {
+      throw std::invalid_argument("smooth must be positive");
+    }
+  }
+
+  /// Get the radius of the support of the function.
+  [[nodiscard]] constexpr auto support() const noexcept -> T {
+    return support_;
+  }
+
+  /// Evaluates the radial function.
+  ///
+  /// @param r Distance between two points.
+  [[nodiscard]] auto operator()(const T& r) const noexcept -> T {
+    const auto q = r / support_;
+    if (q >= 1) {
+      return T(0);
+    }
+    const auto p = (1 - q) * (1 - q);
+    return p * p * (4 * q + 1);
+  }
+
+  /// Solves the weights of the nodes.
+  ///
+  /// @param neighbors For each node, the nodes located within the support
+  /// radius, including the node itself.
+  /// @param yk Values of the nodes
+  /// @param max_iterations Maximum number of iterations of the conjugate
+  /// gradient.
+  /// @param tolerance Relative residual error below which the solution is
+  /// accepted.
+  /// @return the weights of the nodes.
+  [[nodiscard]] auto fit(std::vector<Neighbors>& neighbors,
+                         const Eigen::Ref<const Vector<T>>& yk,
+                         const Eigen::Index max_iterations,
+                         const T& tolerance) const -> Vector<T> {
+    const auto size = static_cast<Eigen::Index>(neighbors.size());
+    assert(size == yk.size());
+
+    auto entries = Eigen::VectorXi(size);
+    for (Eigen::Index ix = 0; ix < size; ++ix) {
+      entries(ix) = static_cast<int>(neighbors[ix].size());
+    }
+
+    // The matrix is symmetric: the neighbors of a node fill its column.
+    auto A = Eigen::SparseMatrix<T>(size, size);
+    A.reserve(entries);
+    for (Eigen::Index ix = 0; ix < size; ++ix) {
+      auto& column = neighbors[ix];
+      std::sort(column.begin(), column.end());
+      for (const auto& [jx, distance] : column) {
+        A.insert(jx, ix) = (*this)(distance) + (jx == ix ? smooth_ : T(0));
+      }
+      // The memory of the neighbors is released as the matrix is built.
+      Neighbors().swap(column);
+    }
+    A.makeCompressed();
+
+    auto solver =
+        Eigen::ConjugateGradient<Eigen::SparseMatrix<T>,
+                                 Eigen::Lower | Eigen::Upper>();
+    solver.setMaxIterations(max_iterations);
+    solver.setTolerance(tolerance);
+    solver.compute(A);
+    Vector<T> result = solver.solve(yk);
+    if (solver.info() != Eigen::Success) {
+      throw std::runtime_error(
+          "the conjugate gradient did not converge after " +
+          std::to_string(solver.iterations()) +
+          " iterations, the estimated error is " +
+          std::to_string(solver.error()));
+    }
+    return result;
+  }
+
+ private:
+  /// Radius of the support of the function
+  T support_;
+
+  /// Smooth factor
+  T smooth_;
+};
+
 }  // namespace pyinterp::detail::math
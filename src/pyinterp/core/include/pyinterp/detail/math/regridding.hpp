@@ -0,0 +1,82 @@
+// Copyright (c) 2022 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace pyinterp::detail::math {
+
+/// Computes the edges of the cells centered on the values of an axis: the
+/// middles of the consecutive values, and the first and last values moved
+/// away by half of the distance to their neighbor.
+///
+/// @param centers Values of the axis.
+/// @return The size + 1 edges of the cells.
+template <typename T>
+auto cell_edges(const std::vector<T>& centers) -> std::vector<T> {
+  const auto size = centers.size();
+  if (size < 2) {
+    throw std::invalid_argument(
+        "an axis must contain at least two values to define cells");
+  }
+  auto result = std::vector<T>(size + 1);
+  for (size_t ix = 1; ix < size; ++ix) {
+    result[ix] = (centers[ix - 1] + centers[ix]) / 2;
+  }
+  result[0] = centers[0] - (centers[1] - centers[0]) / 2;
+  result[size] =
+      centers[size - 1] + (centers[size - 1] - centers[size - 2]) / 2;
+  return result;
+}
+
+/// Computes the lengths of the intersections of an interval with the cells
+/// of an axis.
+///
+/// @param edges Edges of the cells of the axis, sorted in ascending order.
+/// @param lo Lower bound of the interval.
+/// @param hi Upper bound of the interval.
+/// @param period Period of the axis (e.g. 360 for a longitude axis covering
+/// the whole circle), or zero if the axis is not periodic. The edges of a
+/// periodic axis cover one period.
+/// @return The indexes of the cells intersected and the lengths of the
+/// intersections.
+template <typename T>
+auto cell_overlaps(const std::vector<T>& edges, T lo, T hi, const T period)
+    -> std::vector<std::pair<int64_t, T>> {
+  auto result = std::vector<std::pair<int64_t, T>>();
+  if (period != 0) {
+    // The lower bound is moved into the first period of the axis.
+    const auto shift = std::floor((lo - edges.front()) / period) * period;
+    lo -= shift;
+    hi -= shift;
+  }
+  const auto cells = static_cast<int64_t>(edges.size()) - 1;
+
+  // An interval crossing the end of a periodic axis continues at its start.
+  for (auto offset = T(0);; offset += period) {
+    auto ix = static_cast<int64_t>(
+                  std::upper_bound(edges.begin(), edges.end(), lo - offset) -
+                  edges.begin()) -
+              1;
+    for (ix = std::max(ix, int64_t(0)); ix < cells && edges[ix] + offset < hi;
+         ++ix) {
+      const auto length = std::min(hi, edges[ix + 1] + offset) -
+                          std::max(lo, edges[ix] + offset);
+      if (length > 0) {
+        result.emplace_back(ix, length);
+      }
+    }
+    if (period == 0 || hi <= edges.back() + offset) {
+      break;
+    }
+  }
+  return result;
+}
+
+}  // namespace pyinterp::detail::math
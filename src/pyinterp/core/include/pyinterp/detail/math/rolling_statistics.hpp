@@ -0,0 +1,134 @@
+// Copyright (c) 2022 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <deque>
+
+#include "pyinterp/detail/math/descriptive_statistics.hpp"
+
+namespace pyinterp::detail::math {
+
+/// Statistics of the values of a series within a window sliding along it.
+///
+/// The values entering the window are pushed into an accumulator, and those
+/// leaving it are removed with DescriptiveStatistics::operator-=: the cost is
+/// proportional to the length of the series, whatever the size of the
+/// window. The extrema are maintained by monotonic queues of the indexes of
+/// the values. Once as many values as the window holds have been removed, the
+/// accumulator is recomputed from the values of the window, which bounds the
+/// rounding errors of the removals and keeps the cost linear.
+///
+/// @tparam T Type of the values.
+template <typename T>
+class RollingStatistics {
+ public:
+  /// Statistics calculated.
+  using statistics_t = DescriptiveStatistics<T>;
+
+  /// Default constructor
+  ///
+  /// @param before Number of values of the window before the current one.
+  /// @param after Number of values of the window after the current one.
+  /// @param min_periods Minimum number of valid values of a window for its
+  /// statistics to be defined. The statistics of the other windows are
+  /// empty.
+  RollingStatistics(const int64_t before, const int64_t after,
+                    const uint64_t min_periods)
+      : before_(before), after_(after), min_periods_(min_periods) {}
+
+  /// Calculates the statistics of the windows centered on each value of a
+  /// series. NaNs are ignored.
+  ///
+  /// @param size Length of the series.
+  /// @param value Function returning the value of the given index.
+  /// @param write Function called as write(index, statistics) with the
+  /// statistics of the window of each value, in order.
+  template <typename Reader, typename Writer>
+  auto operator()(const int64_t size, const Reader& value,
+                  const Writer& write) -> void {
+    const auto window = before_ + after_ + 1;
+    auto acc = statistics_t();
+    auto removed = int64_t(0);
+    auto first = int64_t(0);
+    auto last = int64_t(0);
+    min_.clear();
+    max_.clear();
+
+    for (int64_t ix = 0; ix < size; ++ix) {
+      const auto lower = std::max<int64_t>(ix - before_, 0);
+      const auto upper = std::min<int64_t>(ix + after_ + 1, size);
+
+      for (; last < upper; ++last) {
+        const auto xi = value(last);
+        if (!std::isnan(xi)) {
+          acc(xi);
+          while (!min_.empty() && value(min_.back()) >= xi) {
+            min_.pop_back();
+          }
+          min_.push_back(last);
+          while (!max_.empty() && value(max_.back()) <= xi) {
+            max_.pop_back();
+          }
+          max_.push_back(last);
+        }
+      }
+
+      for (; first < lower; ++first) {
+        const auto xi = value(first);
+        if (!std::isnan(xi)) {
+          auto item = statistics_t();
+          item(xi);
+          acc -= item;
+          ++removed;
+        }
+      }
+      while (!min_.empty() && min_.front() < lower) {
+        min_.pop_front();
+      }
+      while (!max_.empty() && max_.front() < lower) {
+        max_.pop_front();
+      }
+
+      if (removed >= window) {
+        acc.clear();
+        for (auto jx = lower; jx < upper; ++jx) {
+          const auto xi = value(jx);
+          if (!std::isnan(xi)) {
+            acc(xi);
+          }
+        }
+        removed = 0;
+      }
+
+      if (acc.count() == 0 || acc.count() < min_periods_) {
+        write(ix, statistics_t());
+      } else {
+        // The extrema of the accumulator are those of all the values pushed.
+        auto result = static_cast<const Accumulators<T>&>(acc);
+        result.min = value(min_.front());
+        result.max = value(max_.front());
+        write(ix, statistics_t(result));
+      }
+    }
+  }
+
+ private:
+  /// Number of values of the window before the current one.
+  int64_t before_;
+  /// Number of values of the window after the current one.
+  int64_t after_;
+  /// Minimum number of valid values of a window.
+  uint64_t min_periods_;
+  /// Indexes of the increasing values of the window, candidates to be its
+  /// minimum.
+  std::deque<int64_t> min_{};
+  /// Indexes of the decreasing values of the window, candidates to be its
+  /// maximum.
+  std::deque<int64_t> max_{};
+};
+
+}  // namespace pyinterp::detail::math
@@ -0,0 +1,370 @@
+// Copyright (c) 2022 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+#pragma once
+#include <Eigen/Core>
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstdint>
+#include <unsupported/Eigen/FFT>
+#include <vector>
+
+#include "pyinterp/detail/math/gauss_seidel.hpp"
+#include "pyinterp/detail/thread.hpp"
+#include "pyinterp/eigen.hpp"
+
+namespace pyinterp::detail::math {
+
+/// Solver of the Laplace equation on the masked pixels of a grid, the other
+/// pixels defining the boundary conditions, by the conjugate gradient method
+/// preconditioned by a fast Poisson solver.
+///
+/// The operator solved is the five-point Laplacian used by the Gauss-Seidel
+/// method, the X axis being periodic or mirrored at its ends, and the Y axis
+/// mirrored. On the whole grid, this operator is diagonalized by a Fourier
+/// transform along the X axis (a mirrored axis being the half of a periodic
+/// axis twice as long), which leaves a tridiagonal system along the Y axis for
+/// each wave number: the Poisson equation is solved exactly for a cost
+/// proportional to N log N. Restricted to the masked pixels, the inverse of
+/// this operator corrects the low-frequency components of the error, which
+/// the relaxation reduces very slowly; it is framed by two Jacobi sweeps
+/// correcting the high-frequency components near the defined pixels. With
+/// this preconditioner, the conjugate gradient method converges in a few
+/// tens of iterations.
+///
+/// The operator is not symmetric at the mirrored ends of the axes, whose
+/// pixels count their inner neighbor twice, but it is self-adjoint for the
+/// scalar product weighting these pixels by one half, used by the conjugate
+/// gradient method.
+///
+/// @tparam Type Type of the values of the grid.
+template <typename Type>
+class SpectralPoisson {
+ public:
+  /// Default constructor
+  ///
+  /// @param grid The grid to be processed, whose masked pixels hold the first
+  /// guess of the solution.
+  /// @param mask Matrix describing the undefined pixels of the grid.
+  /// @param is_circle True if the X axis of the grid defines a circle.
+  /// @param num_threads The number of threads to use for the computation.
+  template <typename Grid>
+  SpectralPoisson(const Grid& grid, const Matrix<bool>& mask,
+                  const bool is_circle, const size_t num_threads)
+      : x_size_(grid.rows()),
+        y_size_(grid.cols()),
+        is_circle_(is_circle),
+        nfft_(is_circle ? x_size_ : 2 * (x_size_ - 1)),
+        spectrum_size_(nfft_ / 2 + 1),
+        work_(x_size_, y_size_),
+        spectrum_(spectrum_size_ * y_size_),
+        num_threads_(num_threads) {
+    const auto [shape, strides] = grid_layout(grid);
+    const auto work_strides = std::array<int64_t, 2>{1, x_size_};
+    for (int64_t iy = 0; iy < y_size_; ++iy) {
+      for (int64_t ix = 0; ix < x_size_; ++ix) {
+        if (mask(ix, iy)) {
+          positions_.push_back(active_cell(ix, iy, shape, strides, is_circle));
+          cells_.push_back(
+              active_cell(ix, iy, shape, work_strides, is_circle));
+          weights_.push_back(weight(ix, x_size_, is_circle) *
+                             weight(iy, y_size_, false));
+        }
+      }
+    }
+    const auto size = cells_.size();
+    residuals_.resize(size);
+    directions_.resize(size);
+    products_.resize(size);
+    preconditioned_.resize(size);
+    buffer_.resize(size);
+
+    // Residuals of the first guess.
+    const auto* data = grid.data();
+    for (size_t item = 0; item < size; ++item) {
+      const auto& cell = positions_[item];
+      residuals_[item] = data[cell.neighbors[0]] + data[cell.neighbors[1]] +
+                         data[cell.neighbors[2]] + data[cell.neighbors[3]] -
+                         4 * data[cell.index];
+    }
+    precondition(residuals_, preconditioned_);
+    directions_ = preconditioned_;
+    rho_ = dot(residuals_, preconditioned_);
+  }
+
+  /// Get the number of undefined pixels of the grid.
+  [[nodiscard]] inline auto size() const noexcept -> size_t {
+    return cells_.size();
+  }
+
+  /// Performs one iteration of the conjugate gradient method.
+  ///
+  /// @param grid The grid to be processed, with the same layout as the grid
+  /// given to the constructor.
+  /// @return the maximum residual of the grid updated, expressed as the
+  /// change of a pixel that a Gauss-Seidel sweep would perform.
+  template <typename Grid>
+  auto iterate(Grid& grid) -> Type {
+    if (rho_ == 0) {
+      return max_residual();
+    }
+    apply(directions_, products_);
+    const auto curvature = dot(directions_, products_);
+    if (curvature <= 0) {
+      return max_residual();
+    }
+    const auto alpha = rho_ / curvature;
+    auto* data = grid.data();
+    for (size_t item = 0; item < cells_.size(); ++item) {
+      data[positions_[item].index] += alpha * directions_[item];
+      residuals_[item] -= alpha * products_[item];
+    }
+
+    precondition(residuals_, preconditioned_);
+    const auto rho = dot(residuals_, preconditioned_);
+    const auto beta = rho / rho_;
+    rho_ = rho;
+    for (size_t item = 0; item < cells_.size(); ++item) {
+      directions_[item] = preconditioned_[item] + beta * directions_[item];
+    }
+    return max_residual();
+  }
+
+ private:
+  /// Number of pixels along the X axis.
+  int64_t x_size_;
+  /// Number of pixels along the Y axis.
+  int64_t y_size_;
+  /// True if the X axis of the grid defines a circle.
+  bool is_circle_;
+  /// Length of the Fourier transforms along the X axis.
+  int64_t nfft_;
+  /// Number of wave numbers of the half spectrum of the transforms.
+  int64_t spectrum_size_;
+  /// Undefined pixels, with their neighbors, in the buffer of the grid.
+  std::vector<ActiveCell> positions_{};
+  /// Undefined pixels, with their neighbors, in the work buffer.
+  std::vector<ActiveCell> cells_{};
+  /// Weights of the undefined pixels in the scalar product.
+  std::vector<Type> weights_{};
+  /// Residuals of the undefined pixels.
+  std::vector<Type> residuals_{};
+  /// Search directions.
+  std::vector<Type> directions_{};
+  /// Product of the operator by the search directions.
+  std::vector<Type> products_{};
+  /// Preconditioned residuals.
+  std::vector<Type> preconditioned_{};
+  /// Residuals of the steps of the preconditioner.
+  std::vector<Type> buffer_{};
+  /// Scalar product of the residuals by the preconditioned residuals.
+  Type rho_{0};
+  /// Values of the whole grid handled by the operators.
+  Matrix<Type> work_;
+  /// Fourier transforms of the rows of the work buffer.
+  std::vector<std::complex<Type>> spectrum_;
+  /// The number of threads to use for the computation.
+  size_t num_threads_;
+
+  /// Get the weight of a pixel along an axis in the scalar product.
+  static constexpr auto weight(const int64_t ix, const int64_t size,
+                               const bool is_circle) noexcept -> Type {
+    return !is_circle && (ix == 0 || ix == size - 1) ? Type(0.5) : Type(1);
+  }
+
+  /// Calculates the scalar product of two vectors. The sum is computed by a
+  /// single thread, so that the results do not depend on the number of
+  /// threads.
+  [[nodiscard]] auto dot(const std::vector<Type>& lhs,
+                         const std::vector<Type>& rhs) const -> Type {
+    auto result = Type(0);
+    for (size_t item = 0; item < lhs.size(); ++item) {
+      result += weights_[item] * lhs[item] * rhs[item];
+    }
+    return result;
+  }
+
+  /// Get the maximum residual of the undefined pixels.
+  [[nodiscard]] auto max_residual() const -> Type {
+    auto result = Type(0);
+    for (const auto& item : residuals_) {
+      result = std::max(result, std::abs(item));
+    }
+    return Type(0.25) * result;
+  }
+
+  /// Copies the values of the undefined pixels into the work buffer, the
+  /// other pixels being set to zero.
+  auto scatter(const std::vector<Type>& values) -> void {
+    work_.setZero();
+    auto* data = work_.data();
+    for (size_t item = 0; item < cells_.size(); ++item) {
+      data[cells_[item].index] = values[item];
+    }
+  }
+
+  /// Calculates the product of the operator by a vector.
+  auto apply(const std::vector<Type>& values, std::vector<Type>& result)
+      -> void {
+    scatter(values);
+    const auto* data = work_.data();
+    dispatch(
+        [&](const size_t start, const size_t end) {
+          for (auto item = start; item < end; ++item) {
+            const auto& cell = cells_[item];
+            result[item] = 4 * data[cell.index] - data[cell.neighbors[0]] -
+                           data[cell.neighbors[1]] - data[cell.neighbors[2]] -
+                           data[cell.neighbors[3]];
+          }
+        },
+        cells_.size(), num_threads_);
+  }
+
+  /// Applies the preconditioner to the residuals: a Jacobi sweep, the
+  /// correction of the remaining residuals by the fast Poisson solver, then a
+  /// second Jacobi sweep, which keeps the preconditioner symmetric.
+  auto precondition(const std::vector<Type>& values, std::vector<Type>& result)
+      -> void {
+    const auto size = cells_.size();
+    for (size_t item = 0; item < size; ++item) {
+      result[item] = Type(0.25) * values[item];
+    }
+    apply(result, buffer_);
+    for (size_t item = 0; item < size; ++item) {
+      buffer_[item] = values[item] - buffer_[item];
+    }
+    solve(buffer_, buffer_);
+    for (size_t item = 0; item < size; ++item) {
+      result[item] += buffer_[item];
+    }
+    apply(result, buffer_);
+    for (size_t item = 0; item < size; ++item) {
+      result[item] += Type(0.25) * (values[item] - buffer_[item]);
+    }
+  }
+
+  /// Solves the Poisson equation on the whole grid, whose right-hand side is
+  /// the given vector on the undefined pixels, and zero elsewhere, and
+  /// returns the solution on the undefined pixels. The solution is defined up
+  /// to a constant, the component of the right-hand side which has no
+  /// solution being discarded.
+  auto solve(const std::vector<Type>& values, std::vector<Type>& result)
+      -> void {
+    scatter(values);
+
+    // Fourier transforms of the rows of the grid.
+    dispatch(
+        [&](const size_t start, const size_t end) {
+          auto fft = Eigen::FFT<Type>();
+          fft.SetFlag(Eigen::FFT<Type>::HalfSpectrum);
+          auto line = std::vector<Type>(nfft_);
+          for (auto iy = static_cast<int64_t>(start);
+               iy < static_cast<int64_t>(end); ++iy) {
+            load_line(iy, line);
+            fft.fwd(&spectrum_[iy * spectrum_size_], line.data(), nfft_);
+          }
+        },
+        y_size_, num_threads_);
+
+    // Tridiagonal systems along the Y axis.
+    dispatch(
+        [&](const size_t start, const size_t end) {
+          auto factors = std::vector<Type>(y_size_);
+          for (auto kx = static_cast<int64_t>(start);
+               kx < static_cast<int64_t>(end); ++kx) {
+            solve_line(kx, factors);
+          }
+        },
+        spectrum_size_, num_threads_);
+
+    // Inverse transforms.
+    dispatch(
+        [&](const size_t start, const size_t end) {
+          auto fft = Eigen::FFT<Type>();
+          fft.SetFlag(Eigen::FFT<Type>::HalfSpectrum);
+          auto line = std::vector<Type>(nfft_);
+          for (auto iy = static_cast<int64_t>(start);
+               iy < static_cast<int64_t>(end); ++iy) {
+            fft.inv(line.data(), &spectrum_[iy * spectrum_size_], nfft_);
+            std::copy(line.begin(), line.begin() + x_size_, &work_(0, iy));
+          }
+        },
+        y_size_, num_threads_);
+
+    const auto* data = work_.data();
+    for (size_t item = 0; item < cells_.size(); ++item) {
+      result[item] = data[cells_[item].index];
+    }
+  }
+
+  /// Loads the row iy of the work buffer, extended symmetrically if the X
+  /// axis is mirrored.
+  auto load_line(const int64_t iy, std::vector<Type>& line) const -> void {
+    std::copy(&work_(0, iy), &work_(0, iy) + x_size_, line.begin());
+    if (!is_circle_) {
+      for (int64_t ix = x_size_; ix < nfft_; ++ix) {
+        line[ix] = work_(nfft_ - ix, iy);
+      }
+    }
+  }
+
+  /// Solves the tridiagonal system along the Y axis of the wave number kx,
+  /// whose rows are -u[j-1] + (2 + mu) * u[j] - u[j+1] = f[j], the mirrored
+  /// ends counting their inner neighbor twice.
+  auto solve_line(const int64_t kx, std::vector<Type>& factors) -> void {
+    auto f = [&](const int64_t iy) -> std::complex<Type>& {
+      return spectrum_[iy * spectrum_size_ + kx];
+    };
+    const auto last = y_size_ - 1;
+
+    if (kx == 0) {
+      // The operator of the constant mode along X is singular: the component
+      // of the right-hand side orthogonal to its range is discarded, and the
+      // equation is integrated from the first pixel. The mean of the solution
+      // is then removed.
+      auto mean = std::complex<Type>(0);
+      for (int64_t iy = 0; iy < y_size_; ++iy) {
+        mean += weight(iy, y_size_, false) * f(iy);
+      }
+      mean /= static_cast<Type>(last);
+      auto gradient = (f(0) - mean) * Type(-0.5);
+      auto value = std::complex<Type>(0);
+      f(0) = value;
+      for (int64_t iy = 1; iy < y_size_; ++iy) {
+        value += gradient;
+        gradient -= f(iy) - mean;
+        f(iy) = value;
+      }
+      mean = 0;
+      for (int64_t iy = 0; iy < y_size_; ++iy) {
+        mean += weight(iy, y_size_, false) * f(iy);
+      }
+      mean /= static_cast<Type>(last);
+      for (int64_t iy = 0; iy < y_size_; ++iy) {
+        f(iy) -= mean;
+      }
+      return;
+    }
+
+    const auto diagonal = static_cast<Type>(
+        4 - 2 * std::cos(2 * M_PI * static_cast<double>(kx) /
+                         static_cast<double>(nfft_)));
+    // Thomas algorithm: elimination of the lower diagonal, then back
+    // substitution.
+    factors[0] = Type(-2) / diagonal;
+    f(0) /= diagonal;
+    for (int64_t iy = 1; iy < y_size_; ++iy) {
+      const auto lower = iy == last ? Type(-2) : Type(-1);
+      const auto pivot = diagonal - lower * factors[iy - 1];
+      factors[iy] = Type(-1) / pivot;
+      f(iy) = (f(iy) - lower * f(iy - 1)) / pivot;
+    }
+    for (auto iy = last - 1; iy >= 0; --iy) {
+      f(iy) -= factors[iy] * f(iy + 1);
+    }
+  }
+};
+
+}  // namespace pyinterp::detail::math
@@ -0,0 +1,302 @@
+// Copyright (c) 2022 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+#pragma once
+#include <Eigen/Core>
+#include <algorithm>
+#include <cmath>
+#include <optional>
+#include <stdexcept>
+#include <string>
+
+namespace pyinterp::detail::math {
+
+/// Fitting models of the splines computed by Spline1D.
+enum class SplineKind { kCSpline, kAkima, kSteffen };
+
+/// Cubic spline interpolating a 1-D function, computed without GSL.
+///
+/// The natural cubic, Akima and Steffen splines are computed with the
+/// algorithms of the GSL functions gsl_interp_cspline, gsl_interp_akima and
+/// gsl_interp_steffen, and give the same results. The coefficients of the
+/// polynomial of each interval are stored in arrays allocated once, by the
+/// constructor, and the evaluation functions can be inlined in the calling
+/// loops.
+class Spline1D {
+ public:
+  /// Default constructor
+  ///
+  /// @param size Number of points of the function interpolated.
+  /// @param kind Fitting model.
+  Spline1D(const Eigen::Index size, const SplineKind kind)
+      : kind_(kind),
+        x_(size),
+        y_(size),
+        b_(size),
+        c_(size),
+        d_(size),
+        work_(work_size(size, kind)) {
+    if (size < min_size(kind)) {
+      throw std::runtime_error(
+          "insufficient number of points for interpolation type");
+    }
+  }
+
+  /// Returns the fitting model handled natively, if any, for the given name
+  /// of a GSL interpolation type.
+  static inline auto parse(const std::string& kind)
+      -> std::optional<SplineKind> {
+    if (kind == "c_spline") {
+      return SplineKind::kCSpline;
+    }
+    if (kind == "akima") {
+      return SplineKind::kAkima;
+    }
+    if (kind == "steffen") {
+      return SplineKind::kSteffen;
+    }
+    return {};
+  }
+
+  /// Return the minimum number of points required by the fitting model.
+  static constexpr auto min_size(const SplineKind kind) -> Eigen::Index {
+    return kind == SplineKind::kAkima ? 5 : 3;
+  }
+
+  /// Computes the spline interpolating the tabulated values. The values are
+  /// copied, so the function can then be evaluated several times without
+  /// calling this method again.
+  ///
+  /// @param xa X-coordinates, in strictly ascending order.
+  /// @param ya Values of the function.
+  template <typename VectorX, typename VectorY>
+  auto init(const VectorX& xa, const VectorY& ya) -> void {
+    const auto size = x_.size();
+    for (Eigen::Index ix = 0; ix < size; ++ix) {
+      x_(ix) = xa(ix);
+      y_(ix) = ya(ix);
+      if (ix != 0 && !(x_(ix) > x_(ix - 1))) {
+        throw std::runtime_error(
+            "x values must be strictly increasing (GSL error #4)");
+      }
+    }
+    switch (kind_) {
+      case SplineKind::kCSpline:
+        init_cspline();
+        break;
+      case SplineKind::kAkima:
+        init_akima();
+        break;
+      case SplineKind::kSteffen:
+        init_steffen();
+        break;
+    }
+  }
+
+  /// Return the interpolated value of y for a given point x, using the
+  /// function defined by the last call to init.
+  [[nodiscard]] inline auto interpolate(const double x) const -> double {
+    return evaluate<0>(x);
+  }
+
+  /// Return the derivative of the interpolated function for a given point x.
+  [[nodiscard]] inline auto derivative(const double x) const -> double {
+    return evaluate<1>(x);
+  }
+
+  /// Return the second derivative of the interpolated function for a given
+  /// point x.
+  [[nodiscard]] inline auto second_derivative(const double x) const
+      -> double {
+    return evaluate<2>(x);
+  }
+
+  /// Return the value, the derivative or the second derivative of the
+  /// interpolated function for a given point x.
+  ///
+  /// @tparam Order Order of the derivative evaluated.
+  template <int Order>
+  [[nodiscard]] inline auto evaluate(const double x) const -> double {
+    const auto size = x_.size();
+    if (x < x_(0) || x > x_(size - 1)) {
+      throw std::runtime_error("interpolation error (GSL error #1)");
+    }
+    // Index of the interval containing x: the last interval for the upper
+    // bound of the function.
+    auto lo = Eigen::Index(0);
+    auto hi = size - 1;
+    while (hi > lo + 1) {
+      const auto mid = (hi + lo) >> 1;
+      if (x_(mid) > x) {
+        hi = mid;
+      } else {
+        lo = mid;
+      }
+    }
+    const auto dx = x - x_(lo);
+    const auto b = b_(lo);
+    const auto c = c_(lo);
+    const auto d = d_(lo);
+    if constexpr (Order == 0) {
+      return y_(lo) + dx * (b + dx * (c + dx * d));
+    } else if constexpr (Order == 1) {
+      return b + dx * (2 * c + 3 * d * dx);
+    } else {
+      return 2 * c + 6 * d * dx;
+    }
+  }
+
+ private:
+  SplineKind kind_;
+  /// Tabulated function.
+  Eigen::VectorXd x_;
+  Eigen::VectorXd y_;
+  /// Coefficients of the polynomial y + b dx + c dx² + d dx³ of each
+  /// interval.
+  Eigen::VectorXd b_;
+  Eigen::VectorXd c_;
+  Eigen::VectorXd d_;
+  /// Workspace used to compute the coefficients.
+  Eigen::VectorXd work_;
+
+  /// Gets the size of the workspace used by the fitting model.
+  static constexpr auto work_size(const Eigen::Index size,
+                                  const SplineKind kind) -> Eigen::Index {
+    switch (kind) {
+      case SplineKind::kCSpline:
+        return 5 * size;
+      case SplineKind::kAkima:
+        return size + 4;
+      default:
+        return size;
+    }
+  }
+
+  /// Natural cubic spline: the second derivatives are the solution of a
+  /// symmetric tridiagonal system, solved by a LDLt decomposition.
+  auto init_cspline() -> void {
+    const auto size = x_.size();
+    const auto max_index = size - 1;
+    const auto sys_size = max_index - 1;
+    auto diag = work_.segment(0, sys_size);
+    auto offdiag = work_.segment(size, sys_size);
+    auto g = work_.segment(2 * size, sys_size);
+    auto alpha = work_.segment(3 * size, sys_size);
+    auto gamma = work_.segment(4 * size, sys_size);
+
+    c_(0) = 0;
+    c_(max_index) = 0;
+    for (Eigen::Index ix = 0; ix < sys_size; ++ix) {
+      const auto h_i = x_(ix + 1) - x_(ix);
+      const auto h_ip1 = x_(ix + 2) - x_(ix + 1);
+      const auto ydiff_i = y_(ix + 1) - y_(ix);
+      const auto ydiff_ip1 = y_(ix + 2) - y_(ix + 1);
+      const auto g_i = h_i != 0 ? 1 / h_i : 0;
+      const auto g_ip1 = h_ip1 != 0 ? 1 / h_ip1 : 0;
+      offdiag(ix) = h_ip1;
+      diag(ix) = 2 * (h_ip1 + h_i);
+      g(ix) = 3 * (ydiff_ip1 * g_ip1 - ydiff_i * g_i);
+    }
+
+    if (sys_size == 1) {
+      c_(1) = g(0) / diag(0);
+    } else {
+      // Decomposition A = L.D.Lt: lower diagonal of L = gamma, diagonal of
+      // D = alpha. The right-hand side is updated in place.
+      alpha(0) = diag(0);
+      gamma(0) = offdiag(0) / alpha(0);
+      for (Eigen::Index ix = 1; ix < sys_size - 1; ++ix) {
+        alpha(ix) = diag(ix) - offdiag(ix - 1) * gamma(ix - 1);
+        gamma(ix) = offdiag(ix) / alpha(ix);
+      }
+      alpha(sys_size - 1) =
+          diag(sys_size - 1) - offdiag(sys_size - 2) * gamma(sys_size - 2);
+      for (Eigen::Index ix = 1; ix < sys_size; ++ix) {
+        g(ix) = g(ix) - gamma(ix - 1) * g(ix - 1);
+      }
+      c_(sys_size) = g(sys_size - 1) / alpha(sys_size - 1);
+      for (auto ix = sys_size - 2; ix >= 0; --ix) {
+        c_(ix + 1) = g(ix) / alpha(ix) - gamma(ix) * c_(ix + 2);
+      }
+    }
+
+    for (Eigen::Index ix = 0; ix < max_index; ++ix) {
+      const auto dx = x_(ix + 1) - x_(ix);
+      const auto dy = y_(ix + 1) - y_(ix);
+      b_(ix) = (dy / dx) - dx * (c_(ix + 1) + 2 * c_(ix)) / 3;
+      d_(ix) = (c_(ix + 1) - c_(ix)) / (3 * dx);
+    }
+  }
+
+  /// Akima spline, with the non-periodic boundary conditions of GSL.
+  auto init_akima() -> void {
+    const auto size = x_.size();
+    // Slopes of the intervals, stored in the workspace: two slopes are
+    // extrapolated at each end.
+    auto m = [this](const Eigen::Index ix) -> double& { return work_(ix + 2); };
+    for (Eigen::Index ix = 0; ix < size - 1; ++ix) {
+      m(ix) = (y_(ix + 1) - y_(ix)) / (x_(ix + 1) - x_(ix));
+    }
+    m(-2) = 3 * m(0) - 2 * m(1);
+    m(-1) = 2 * m(0) - m(1);
+    m(size - 1) = 2 * m(size - 2) - m(size - 3);
+    m(size) = 3 * m(size - 2) - 2 * m(size - 3);
+
+    for (Eigen::Index ix = 0; ix < size - 1; ++ix) {
+      const auto ne =
+          std::fabs(m(ix + 1) - m(ix)) + std::fabs(m(ix - 1) - m(ix - 2));
+      if (ne == 0) {
+        b_(ix) = m(ix);
+        c_(ix) = 0;
+        d_(ix) = 0;
+        continue;
+      }
+      const auto h_i = x_(ix + 1) - x_(ix);
+      const auto ne_next =
+          std::fabs(m(ix + 2) - m(ix + 1)) + std::fabs(m(ix) - m(ix - 1));
+      const auto alpha_i = std::fabs(m(ix - 1) - m(ix - 2)) / ne;
+      auto tl_ip1 = m(ix);
+      if (ne_next != 0) {
+        const auto alpha_ip1 = std::fabs(m(ix) - m(ix - 1)) / ne_next;
+        tl_ip1 = (1 - alpha_ip1) * m(ix) + alpha_ip1 * m(ix + 1);
+      }
+      b_(ix) = (1 - alpha_i) * m(ix - 1) + alpha_i * m(ix);
+      c_(ix) = (3 * m(ix) - 2 * b_(ix) - tl_ip1) / h_i;
+      d_(ix) = (b_(ix) + tl_ip1 - 2 * m(ix)) / (h_i * h_i);
+    }
+  }
+
+  /// Steffen's monotonic spline.
+  auto init_steffen() -> void {
+    const auto size = x_.size();
+    auto copysign = [](const double x, const double y) -> double {
+      return (x < 0 && y > 0) || (x > 0 && y < 0) ? -x : x;
+    };
+    // Derivatives of the function at the points.
+    auto& y_prime = work_;
+    y_prime(0) = (y_(1) - y_(0)) / (x_(1) - x_(0));
+    for (Eigen::Index ix = 1; ix < size - 1; ++ix) {
+      const auto hi = x_(ix + 1) - x_(ix);
+      const auto him1 = x_(ix) - x_(ix - 1);
+      const auto si = (y_(ix + 1) - y_(ix)) / hi;
+      const auto sim1 = (y_(ix) - y_(ix - 1)) / him1;
+      const auto pi = (sim1 * hi + si * him1) / (him1 + hi);
+      y_prime(ix) = (copysign(1.0, sim1) + copysign(1.0, si)) *
+                    std::min(std::fabs(sim1),
+                             std::min(std::fabs(si), 0.5 * std::fabs(pi)));
+    }
+    y_prime(size - 1) =
+        (y_(size - 1) - y_(size - 2)) / (x_(size - 1) - x_(size - 2));
+
+    for (Eigen::Index ix = 0; ix < size - 1; ++ix) {
+      const auto hi = x_(ix + 1) - x_(ix);
+      const auto si = (y_(ix + 1) - y_(ix)) / hi;
+      b_(ix) = y_prime(ix);
+      c_(ix) = (3 * si - 2 * y_prime(ix) - y_prime(ix + 1)) / hi;
+      d_(ix) = (y_prime(ix) + y_prime(ix + 1) - 2 * si) / hi / hi;
+    }
+  }
+};
+
+}  // namespace pyinterp::detail::math
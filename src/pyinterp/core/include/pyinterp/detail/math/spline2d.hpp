@@ -6,9 +6,13 @@
 #include <gsl/gsl_interp.h>
 
 #include <Eigen/Core>
+#include <optional>
+#include <string>
+#include <vector>
 
 #include "pyinterp/detail/gsl/interpolate1d.hpp"
 #include "pyinterp/detail/math/frame.hpp"
+#include "pyinterp/detail/math/spline1d.hpp"
 
 namespace pyinterp::detail::math {
 
@@ -17,54 +21,182 @@ class Spline2D {
  public:
   /// Default constructor
   ///
-  /// @param xr Calculation window.
+  /// @param xr Calculation window, a Frame2D of any window size.
   /// @param type method of calculation
-  explicit Spline2D(const Frame2D &xr, const std::string &kind)
-      : column_(xr.y()->size()),
-        x_interpolator_(xr.x()->size(), Spline2D::parse_interp_type(kind),
-                        gsl::Accelerator()),
-        y_interpolator_(xr.y()->size(), Spline2D::parse_interp_type(kind),
-                        gsl::Accelerator()) {}
+  ///
+  /// The cubic, Akima and Steffen splines are computed by Spline1D, whose
+  /// buffers are allocated here, once for all the frames fitted. The other
+  /// methods use the GSL interpolators.
+  template <typename Frame>
+  explicit Spline2D(const Frame &xr, const std::string &kind)
+      : column_(xr.y_values().size()), native_(Spline1D::parse(kind)) {
+    const auto x_size = xr.x_values().size();
+    const auto y_size = xr.y_values().size();
+    if (native_) {
+      x_splines_.reserve(y_size);
+      for (Eigen::Index ix = 0; ix < y_size; ++ix) {
+        x_splines_.emplace_back(x_size, *native_);
+      }
+      y_spline_.emplace(y_size, *native_);
+      return;
+    }
+    const auto *type = Spline2D::parse_interp_type(kind);
+    x_interpolators_.reserve(y_size);
+    for (Eigen::Index ix = 0; ix < y_size; ++ix) {
+      x_interpolators_.emplace_back(x_size, type, gsl::Accelerator());
+    }
+    y_interpolator_.emplace(y_size, type, gsl::Accelerator());
+  }
 
   /// Return the interpolated value of y for a given point x
-  auto interpolate(const double x, const double y, const Frame2D &xr)
-      -> double {
-    return evaluate(&gsl::Interpolate1D::interpolate, x, y, xr);
+  template <typename Frame>
+  auto interpolate(const double x, const double y, const Frame &xr) -> double {
+    fit(xr);
+    return interpolate(x, y);
   }
 
   /// Return the derivative for a given point x
-  auto derivative(const double x, const double y, const Frame2D &xr) -> double {
-    return evaluate(&gsl::Interpolate1D::derivative, x, y, xr);
+  template <typename Frame>
+  auto derivative(const double x, const double y, const Frame &xr) -> double {
+    fit(xr);
+    return derivative(x, y);
   }
 
   /// Return the second derivative for a given point x
-  auto second_derivative(const double x, const double y, const Frame2D &xr)
+  template <typename Frame>
+  auto second_derivative(const double x, const double y, const Frame &xr)
+      -> double {
+    fit(xr);
+    return second_derivative(x, y);
+  }
+
+  /// Computes the splines interpolating the columns of the frame provided.
+  template <typename Frame>
+  auto fit(const Frame &xr) -> void {
+    for (Eigen::Index ix = 0; ix < xr.y_values().size(); ++ix) {
+      if (native_) {
+        x_splines_[ix].init(xr.x_values(), xr.q_values().col(ix));
+      } else {
+        x_interpolators_[ix].init(xr.x_values(), xr.q_values().col(ix));
+      }
+    }
+    y_ = xr.y_values();
+  }
+
+  /// Return the interpolated value of y for a given point x, using the
+  /// splines computed by the last call to fit.
+  auto interpolate(const double x, const double y) -> double {
+    if (native_) {
+      return evaluate<0>(x, y);
+    }
+    return evaluate(&gsl::Interpolate1D::interpolate, x, y);
+  }
+
+  /// Return the derivative for a given point x, using the splines computed by
+  /// the last call to fit.
+  auto derivative(const double x, const double y) -> double {
+    if (native_) {
+      return evaluate<1>(x, y);
+    }
+    return evaluate(&gsl::Interpolate1D::derivative, x, y);
+  }
+
+  /// Return the second derivative for a given point x, using the splines
+  /// computed by the last call to fit.
+  auto second_derivative(const double x, const double y) -> double {
+    if (native_) {
+      return evaluate<2>(x, y);
+    }
+    return evaluate(&gsl::Interpolate1D::second_derivative, x, y);
+  }
+
+  /// Return the interpolated value and its partial derivatives for a given
+  /// point, using the splines computed by the last call to fit. The splines
+  /// of the columns are evaluated once for the three results.
+  ///
+  /// @param dx Partial derivative with respect to x.
+  /// @param dy Partial derivative with respect to y.
+  auto gradient(const double x, const double y, double &dx, double &dy)
       -> double {
-    return evaluate(&gsl::Interpolate1D::second_derivative, x, y, xr);
+    x_derivatives_.resize(column_.size());
+    if (native_) {
+      for (Eigen::Index ix = 0; ix < column_.size(); ++ix) {
+        column_(ix) = x_splines_[ix].evaluate<0>(x);
+        x_derivatives_(ix) = x_splines_[ix].evaluate<1>(x);
+      }
+      y_spline_->init(y_, column_);
+      auto result = y_spline_->evaluate<0>(y);
+      dy = y_spline_->evaluate<1>(y);
+      y_spline_->init(y_, x_derivatives_);
+      dx = y_spline_->evaluate<0>(y);
+      return result;
+    }
+    for (Eigen::Index ix = 0; ix < column_.size(); ++ix) {
+      column_(ix) = x_interpolators_[ix].interpolate(x);
+      x_derivatives_(ix) = x_interpolators_[ix].derivative(x);
+    }
+    y_interpolator_->init(y_, column_);
+    auto result = y_interpolator_->interpolate(y);
+    dy = y_interpolator_->derivative(y);
+    y_interpolator_->init(y_, x_derivatives_);
+    dx = y_interpolator_->interpolate(y);
+    return result;
+  }
+
+  /// Returns true if the interpolation method is a bicubic polynomial on each
+  /// cell of the frame, i.e. if the splines are cubic and depend linearly on
+  /// the interpolated values.
+  static inline auto is_piecewise_bicubic(const std::string &kind) -> bool {
+    return kind == "linear" || kind == "c_spline" ||
+           kind == "c_spline_periodic";
   }
 
  private:
-  using InterpolateFunction = double (gsl::Interpolate1D::*)(
-      const Eigen::VectorXd &, const Eigen::VectorXd &, const double);
+  using InterpolateFunction = double (gsl::Interpolate1D::*)(const double);
   /// Column of the interpolation window (interpolation according to Y
   /// coordinates)
   Eigen::VectorXd column_;
 
-  /// GSL interpolators
-  gsl::Interpolate1D x_interpolator_;
-  gsl::Interpolate1D y_interpolator_;
+  /// Partial derivatives with respect to X of the splines of the columns,
+  /// allocated by the first call to gradient.
+  Eigen::VectorXd x_derivatives_;
+
+  /// Y-coordinates of the frame used by the last call to fit.
+  Eigen::VectorXd y_;
+
+  /// Fitting model computed without GSL, if the method is handled by
+  /// Spline1D.
+  std::optional<SplineKind> native_;
+
+  /// Splines computed without GSL: one per column of the frame for the
+  /// interpolation according to X coordinates, and one for the resulting
+  /// column.
+  std::vector<Spline1D> x_splines_{};
+  std::optional<Spline1D> y_spline_{};
+
+  /// GSL interpolators used by the other methods.
+  std::vector<gsl::Interpolate1D> x_interpolators_{};
+  std::optional<gsl::Interpolate1D> y_interpolator_{};
+
+  /// Evaluation of the splines computed without GSL.
+  template <int Order>
+  auto evaluate(const double x, const double y) -> double {
+    for (Eigen::Index ix = 0; ix < column_.size(); ++ix) {
+      column_(ix) = x_splines_[ix].evaluate<Order>(x);
+    }
+    y_spline_->init(y_, column_);
+    return y_spline_->evaluate<Order>(y);
+  }
 
   /// Evaluation of the GSL function performing the calculation.
-  auto evaluate(
-      const std::function<double(gsl::Interpolate1D &, const Eigen::VectorXd &,
-                                 const Eigen::VectorXd &, const double)>
-          &function,
-      const double x, const double y, const Frame2D &xr) -> double {
+  auto evaluate(const InterpolateFunction function, const double x,
+                const double y) -> double {
     // Spline interpolation as function of X-coordinate
-    for (Eigen::Index ix = 0; ix < xr.y()->size(); ++ix) {
-      column_(ix) = function(x_interpolator_, *(xr.x()), xr.q()->col(ix), x);
+    for (Eigen::Index ix = 0; ix < column_.size(); ++ix) {
+      column_(ix) = (x_interpolators_[ix].*function)(x);
     }
-    return function(y_interpolator_, *(xr.y()), column_, y);
+    y_interpolator_->init(y_, column_);
+    return ((*y_interpolator_).*function)(y);
   }
 
   static inline auto parse_interp_type(const std::string &kind)
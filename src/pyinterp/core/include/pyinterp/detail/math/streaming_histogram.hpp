@@ -3,14 +3,18 @@
 // All rights reserved. Use of this source code is governed by a
 // BSD-style license that can be found in the LICENSE file.
 #pragma once
+#include <algorithm>
 #include <cmath>
-#include <functional>
+#include <cstdint>
+#include <iterator>
 #include <numeric>
 #include <optional>
-#include <sstream>
+#include <string>
+#include <string_view>
+#include <tuple>
 #include <vector>
 
-#include "pyinterp/detail/isviewstream.hpp"
+#include "pyinterp/detail/serialization.hpp"
 
 namespace pyinterp::detail::math {
 
@@ -28,13 +32,14 @@ struct Bin {
 };
 
 /// Handle the calculation of differences between bins
-template <typename T>
+///
+/// @tparam WeightedDiff True if the differences between the bins are weighted
+/// by the logarithm of their smallest weight.
+template <typename T, bool WeightedDiff>
 class BinDifferences {
  public:
   /// Default constructor
-  BinDifferences(std::vector<Bin<T>>& bins, const bool weighted_diff)
-      : calculate_(weighted_diff ? &BinDifferences::weighted
-                                 : &BinDifferences::simple) {
+  explicit BinDifferences(const std::vector<Bin<T>>& bins) {
     for (size_t index = 1; index < bins.size(); ++index) {
       auto diff = calculate(bins[index], bins[index - 1]);
       if (diff < diff_) {
@@ -52,28 +57,47 @@ class BinDifferences {
     return index_;
   }
 
+  /// Get the difference between the provided bins.
+  static auto calculate(const Bin<T>& lhs, const Bin<T>& rhs) -> T {
+    if constexpr (WeightedDiff) {
+      return (lhs.value - rhs.value) *
+             std::log(1e-5 + std::min(lhs.weight, rhs.weight));
+    } else {
+      return lhs.value - rhs.value;
+    }
+  }
+
  private:
-  std::function<T(const Bin<T>&, const Bin<T>&)> calculate_;
   size_t index_{std::numeric_limits<size_t>::max()};
   T diff_{std::numeric_limits<T>::max()};
-
-  /// Simple difference calculation.
-  constexpr static auto simple(const Bin<T>& lhs, const Bin<T>& rhs) -> T {
-    return lhs.value - rhs.value;
-  }
-
-  /// Weighted difference calculation.
-  constexpr static auto weighted(const Bin<T>& lhs, const Bin<T>& rhs) -> T {
-    return BinDifferences::simple(lhs, rhs) *
-           std::log(1e-5 + std::min(lhs.weight, rhs.weight));
-  }
-
-  /// Get the difference between the provided bins.
-  constexpr auto calculate(const Bin<T>& lhs, const Bin<T>& rhs) const -> T {
-    return calculate_(lhs, rhs);
-  }
 };
 
+/// Sorts quantiles in increasing order, as expected by
+/// StreamingHistogram::quantiles.
+///
+/// @param q Quantiles to sort.
+/// @param size Number of quantiles.
+/// @return the positions of the sorted quantiles in the sequence provided,
+/// and their values.
+template <typename T>
+auto sort_quantiles(const T* q, const size_t size)
+    -> std::tuple<std::vector<size_t>, std::vector<T>> {
+  std::for_each(q, q + size, [](const T& item) {
+    if (!(item >= 0 && item <= 1)) {
+      throw std::invalid_argument("Quantile must be in the range [0, 1]");
+    }
+  });
+  auto order = std::vector<size_t>(size);
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(
+      order.begin(), order.end(),
+      [q](const size_t lhs, const size_t rhs) { return q[lhs] < q[rhs]; });
+  auto sorted = std::vector<T>(size);
+  std::transform(order.begin(), order.end(), sorted.begin(),
+                 [q](const size_t ix) { return q[ix]; });
+  return std::make_tuple(std::move(order), std::move(sorted));
+}
+
 /// Streaming Histogram implementation
 template <typename T>
 class StreamingHistogram {
@@ -87,43 +111,48 @@ class StreamingHistogram {
 
   /// Create of a new object from serialized data.
   explicit StreamingHistogram(const std::string_view& state) {
-    auto ss = isviewstream(state);
-    ss.exceptions(std::stringstream::failbit);
-    auto size = size_t(0);
-
-    try {
-      ss.read(reinterpret_cast<char*>(&weighted_diff_), sizeof(bool));
-      ss.read(reinterpret_cast<char*>(&bin_count_), sizeof(size_t));
-      ss.read(reinterpret_cast<char*>(&count_), sizeof(uint64_t));
-      ss.read(reinterpret_cast<char*>(&min_), sizeof(T));
-      ss.read(reinterpret_cast<char*>(&max_), sizeof(T));
-      ss.read(reinterpret_cast<char*>(&size), sizeof(size_t));
-      bins_.resize(size);
-      ss.read(reinterpret_cast<char*>(bins_.data()), size * sizeof(Bin<T>));
-    } catch (const std::ios_base::failure& e) {
-      throw std::invalid_argument("invalid state");
-    }
+    auto reader = serialization::Reader(state);
+    unmarshal(reader);
+    // The states written by the previous versions do not store whether the
+    // bins are exact: they are considered as compressed.
+    exact_ = reader.empty() ? false : reader.read<bool>();
+  }
+
+  /// Create of a new object from the data written by marshal().
+  explicit StreamingHistogram(serialization::Reader& reader) {
+    unmarshal(reader);
+    exact_ = reader.read<bool>();
   }
 
   /// Serialize the state of the histogram.
   explicit operator std::string() const {
-    auto ss = std::stringstream();
-    ss.exceptions(std::stringstream::failbit);
-    ss.write(reinterpret_cast<const char*>(&weighted_diff_), sizeof(bool));
-    ss.write(reinterpret_cast<const char*>(&bin_count_), sizeof(size_t));
-    ss.write(reinterpret_cast<const char*>(&count_), sizeof(uint64_t));
-    ss.write(reinterpret_cast<const char*>(&min_), sizeof(T));
-    ss.write(reinterpret_cast<const char*>(&max_), sizeof(T));
-    auto size = bins_.size();
-    ss.write(reinterpret_cast<const char*>(&size), sizeof(size_t));
-    ss.write(reinterpret_cast<const char*>(bins_.data()),
-             size * sizeof(Bin<T>));
-    return ss.str();
+    auto writer = serialization::Writer();
+    marshal(writer);
+    return std::move(writer).str();
+  }
+
+  /// Serialize the state of the histogram, the values buffered excepted, at
+  /// the end of the given buffer.
+  auto marshal(serialization::Writer& writer) const -> void {
+    writer.write(weighted_diff_);
+    writer.write(bin_count_);
+    writer.write(count_);
+    writer.write(min_);
+    writer.write(max_);
+    writer.write(bins_.size());
+    writer.write(bins_.data(), bins_.size());
+    writer.write(exact_);
+  }
+
+  /// Get the maximum number of bins in the histogram.
+  [[nodiscard]] constexpr auto bin_count() const noexcept -> size_t {
+    return bin_count_;
   }
 
   /// Set the maximum number of bins in the histogram.
   inline auto resize(const size_t bin_count) -> void {
     bin_count_ = bin_count;
+    flush();
     trim();
   }
 
@@ -137,6 +166,27 @@ class StreamingHistogram {
     *this = std::move(StreamingHistogram(bin_count_, weighted_diff_));
   }
 
+  /// Replaces the state of the histogram, keeping its properties and its
+  /// memory.
+  ///
+  /// @param count Number of samples pushed.
+  /// @param min Minimum of the samples.
+  /// @param max Maximum of the samples.
+  /// @param exact True if the bins hold the samples pushed.
+  /// @param first Pointer to the first bin, sorted by value.
+  /// @param last Pointer past the last bin.
+  auto assign(const uint64_t count, const T& min, const T& max,
+              const bool exact, const Bin<T>* first, const Bin<T>* last)
+      -> void {
+    count_ = count;
+    min_ = count != 0 ? min : std::numeric_limits<T>::max();
+    max_ = count != 0 ? max : std::numeric_limits<T>::min();
+    exact_ = exact;
+    bins_.assign(first, last);
+    buffer_.clear();
+    cumulative_.clear();
+  }
+
   /// Push a new value into the histogram.
   inline auto operator()(const T& value, const T& weight = T(1)) -> void {
     ++count_;
@@ -151,8 +201,53 @@ class StreamingHistogram {
     trim();
   }
 
+  /// Push a new value into the staging buffer of the histogram. The buffered
+  /// values are merged into the bins, in a single pass, when the buffer holds
+  /// as many values as the histogram can hold bins or when flush() is called:
+  /// the bins are trimmed once per batch instead of once per value.
+  ///
+  /// @note The bins, the statistics derived from them and the serialized
+  /// state only take the buffered values into account after the next call to
+  /// flush().
+  inline auto buffer(const T& value, const T& weight = T(1)) -> void {
+    ++count_;
+    auto weighted_value = weight * value;
+    if (weighted_value < min_) {
+      min_ = weighted_value;
+    }
+    if (weighted_value > max_) {
+      max_ = weighted_value;
+    }
+    if (buffer_.empty()) {
+      buffer_.reserve(std::max<size_t>(bin_count_, 1));
+    }
+    buffer_.emplace_back(Bin<T>{value, weight});
+    if (buffer_.size() >= bin_count_) {
+      flush();
+    }
+  }
+
+  /// Merges the buffered values into the bins of the histogram.
+  inline auto flush() -> void {
+    if (buffer_.empty()) {
+      return;
+    }
+    std::stable_sort(
+        buffer_.begin(), buffer_.end(),
+        [](const Bin<T>& lhs, const Bin<T>& rhs) {
+          return lhs.value < rhs.value;
+        });
+    merge_bins(buffer_);
+    // The staging memory is released, so that a grid of histograms does not
+    // keep a buffer per cell once the values have been pushed.
+    buffer_ = std::vector<Bin<T>>();
+    trim();
+  }
+
   /// Merges the provided histogram into the current one.
   inline auto operator+=(const StreamingHistogram<T>& other) -> void {
+    flush();
+    exact_ = exact_ && other.exact_;
     count_ += other.count_;
     if (other.min_ < min_) {
       min_ = other.min_;
@@ -160,9 +255,7 @@ class StreamingHistogram {
     if (other.max_ > max_) {
       max_ = other.max_;
     }
-    for (const auto& item : other.bins_) {
-      update_bins(item.value, item.weight);
-    }
+    merge_bins(other.bins_);
     trim();
   }
 
@@ -176,44 +269,55 @@ class StreamingHistogram {
         [](T a, const Bin<T>& b) -> T { return a + b.weight; });
   }
 
+  /// Returns true if the bins hold the values pushed, i.e. if the histogram
+  /// has never been compressed.
+  [[nodiscard]] constexpr auto exact() const noexcept -> bool {
+    return exact_;
+  }
+
   /// Returns the number of bins in the histogram.
   [[nodiscard]] constexpr auto size() const noexcept -> size_t {
     return bins_.size();
   }
 
   /// Calculate the quantile of the distribution
+  ///
+  /// As long as the histogram has not been compressed, the bins hold the
+  /// values pushed: the quantile is interpolated between the values, each
+  /// one placed at the middle of its weight in the cumulative distribution.
+  /// Afterwards, the tails are extrapolated between the extreme bins and the
+  /// bounds of the distribution, as described by Ben-Haim and Tom-Tov.
+  ///
+  /// The cumulative weights of the bins are cached by the first call, so
+  /// that the next ones only perform a binary search.
   [[nodiscard]] auto quantile(const T& quantile) const -> T {
     if (bins_.empty()) {
       return std::numeric_limits<T>::quiet_NaN();
     }
+    check_quantile(quantile);
+    const auto& cumulative = cumulative_weights();
+    auto first = size_t(0);
+    return interpolate(cumulative, cumulative.back() * quantile, first);
+  }
 
-    if (quantile < 0.0 || quantile > 1.0) {
-      throw std::invalid_argument("Quantile must be in the range [0, 1]");
-    }
-
-    auto weights = sum_of_weights();
-    auto qw = weights * quantile;
-
-    if (qw <= (bins_.front().weight * 0.5)) {  // left values
-      auto ratio = qw / (bins_.front().weight * 0.5);
-      return min_ + (ratio * (bins_.front().value - min_));
-    }
-
-    if (qw >= (weights - (bins_.back().weight * 0.5))) {  // right values
-      auto base = qw - (weights - (bins_.back().weight * 0.5));
-      auto ratio = base / (bins_.back().weight * 0.5);
-      return bins_.back().value + (ratio * (max_ - bins_.back().value));
+  /// Calculate several quantiles of the distribution in a single pass: the
+  /// search of the bins surrounding a quantile starts from those of the
+  /// previous one.
+  ///
+  /// @param q Quantiles to compute, sorted in increasing order.
+  /// @param size Number of quantiles to compute.
+  /// @param result Buffer of at least size elements receiving the quantiles.
+  auto quantiles(const T* q, const size_t size, T* result) const -> void {
+    if (bins_.empty()) {
+      std::fill_n(result, size, std::numeric_limits<T>::quiet_NaN());
+      return;
     }
-
-    auto ix = size_t(0);
-    auto mb = qw - bins_.front().weight * 0.5;
-    while (mb - (bins_[ix].weight + bins_[ix + 1].weight) * 0.5 > 0 &&
-           ix < bins_.size() - 1) {
-      mb -= (bins_[ix].weight + bins_[ix + 1].weight) * 0.5;
-      ix += 1;
+    std::for_each(q, q + size, check_quantile);
+    const auto& cumulative = cumulative_weights();
+    auto first = size_t(0);
+    for (size_t ix = 0; ix < size; ++ix) {
+      result[ix] = interpolate(cumulative, cumulative.back() * q[ix], first);
     }
-    auto ratio = mb / ((bins_[ix].weight + bins_[ix + 1].weight) * 0.5);
-    return bins_[ix].value + (ratio * (bins_[ix + 1].value - bins_[ix].value));
   }
 
   /// Calculates the mean of the distribution.
@@ -251,9 +355,102 @@ class StreamingHistogram {
   T min_{std::numeric_limits<T>::max()};
   T max_{std::numeric_limits<T>::min()};
   std::vector<Bin<T>> bins_{};
+  /// True until the bins are compressed for the first time.
+  bool exact_{true};
+  /// Values pushed by buffer() not yet merged into the bins (not serialized).
+  std::vector<Bin<T>> buffer_{};
+  /// Cumulative weights of the bins, computed on demand by quantile() and
+  /// cleared when the bins change (not serialized). Concurrent calls to
+  /// quantile() on the same instance are therefore not thread-safe.
+  mutable std::vector<T> cumulative_{};
+
+  /// Reads the state written by marshal(), the exact flag excepted.
+  auto unmarshal(serialization::Reader& reader) -> void {
+    weighted_diff_ = reader.read<bool>();
+    bin_count_ = reader.read<size_t>();
+    count_ = reader.read<uint64_t>();
+    min_ = reader.read<T>();
+    max_ = reader.read<T>();
+    const auto size = reader.read<size_t>();
+    if (size > reader.size() / sizeof(Bin<T>)) {
+      throw std::invalid_argument("invalid state");
+    }
+    bins_.resize(size);
+    reader.read(bins_.data(), size);
+  }
+
+  /// Raise an exception if a quantile is not in [0, 1].
+  static auto check_quantile(const T& quantile) -> void {
+    if (quantile < 0.0 || quantile > 1.0) {
+      throw std::invalid_argument("Quantile must be in the range [0, 1]");
+    }
+  }
+
+  /// Interpolates the value whose cumulative weight is qw.
+  ///
+  /// @param cumulative Cumulative weights of the bins.
+  /// @param qw Cumulative weight of the value searched.
+  /// @param first Index of a bin whose middle is located before qw, updated
+  /// with the index of the bin preceding qw.
+  auto interpolate(const std::vector<T>& cumulative, const T& qw,
+                   size_t& first) const -> T {
+    const auto weights = cumulative.back();
+
+    // Position of the middle of a bin in the cumulative distribution.
+    auto center = [&](const size_t ix) -> T {
+      return cumulative[ix] - bins_[ix].weight * 0.5;
+    };
+
+    if (qw <= center(0)) {  // left values
+      if (exact_) {
+        return bins_.front().value;
+      }
+      auto ratio = qw / (bins_.front().weight * 0.5);
+      return min_ + (ratio * (bins_.front().value - min_));
+    }
+
+    auto last = bins_.size() - 1;
+    if (qw >= center(last)) {  // right values
+      if (exact_) {
+        return bins_.back().value;
+      }
+      auto base = qw - (weights - (bins_.back().weight * 0.5));
+      auto ratio = base / (bins_.back().weight * 0.5);
+      return bins_.back().value + (ratio * (max_ - bins_.back().value));
+    }
+
+    // Binary search for the bins surrounding qw: center(ix) < qw <= center(jx)
+    auto ix = first;
+    auto jx = last;
+    while (jx - ix > 1) {
+      const auto mid = (ix + jx) >> 1U;
+      if (center(mid) < qw) {
+        ix = mid;
+      } else {
+        jx = mid;
+      }
+    }
+    first = ix;
+    auto ratio = (qw - center(ix)) / (center(jx) - center(ix));
+    return bins_[ix].value + (ratio * (bins_[jx].value - bins_[ix].value));
+  }
+
+  /// Get the cumulative weights of the bins.
+  auto cumulative_weights() const -> const std::vector<T>& {
+    if (cumulative_.size() != bins_.size()) {
+      cumulative_.resize(bins_.size());
+      auto sum = T(0);
+      for (size_t ix = 0; ix < bins_.size(); ++ix) {
+        sum += bins_[ix].weight;
+        cumulative_[ix] = sum;
+      }
+    }
+    return cumulative_;
+  }
 
   /// Update the histogram with the provided value.
   auto update_bins(const T& value, const T& weight) -> void {
+    cumulative_.clear();
     if (bins_.empty()) {
       bins_.emplace_back(Bin<T>{value, weight});
       return;
@@ -286,22 +483,138 @@ class StreamingHistogram {
     bins_.insert(bins_.begin() + index, {value, weight});
   }
 
+  /// Merges a sorted sequence of bins into the bins of the histogram. The
+  /// merged bins are placed after the existing bins of equal value.
+  auto merge_bins(const std::vector<Bin<T>>& sorted) -> void {
+    cumulative_.clear();
+    auto result = std::vector<Bin<T>>();
+    result.reserve(bins_.size() + sorted.size());
+    std::merge(bins_.begin(), bins_.end(), sorted.begin(), sorted.end(),
+               std::back_inserter(result),
+               [](const Bin<T>& lhs, const Bin<T>& rhs) {
+                 return lhs.value < rhs.value;
+               });
+    bins_ = std::move(result);
+  }
+
+  /// Replace the bins (qi, ki), (qi+1, ki+1) by the bin
+  /// ((qi * ki + qi+1 * ki+1) / (ki + ki+1), ki + ki+1)
+  static auto merge_pair(Bin<T>& item0, const Bin<T>& item1) -> void {
+    item0 = {(item0.value * item0.weight + item1.value * item1.weight) /
+                 (item0.weight + item1.weight),
+             item0.weight + item1.weight};
+  }
+
   /// Compress the histogram if necessary.
   auto trim() -> void {
-    while (bins_.size() > bin_count_) {
-      // Find a point qi that minimizes qi+1 - qi
-      auto ix = BinDifferences<T>(bins_, weighted_diff_).index();
+    // The difference between bins is selected once, then inlined in the
+    // loops of the compression.
+    weighted_diff_ ? compress<true>() : compress<false>();
+  }
+
+  /// Compress the histogram with the given calculation of the differences
+  /// between bins.
+  template <bool WeightedDiff>
+  auto compress() -> void {
+    if (bins_.size() > bin_count_) {
+      exact_ = false;
+      cumulative_.clear();
+    }
+    if (bins_.size() <= bin_count_ + 1) {
+      // Only one bin to remove: a linear scan is enough.
+      if (bins_.size() > bin_count_) {
+        // Find a point qi that minimizes qi+1 - qi
+        auto ix = BinDifferences<T, WeightedDiff>(bins_).index();
+        merge_pair(bins_[ix], bins_[ix + 1]);
+        bins_.erase(bins_.begin() + ix + 1);
+      }
+      return;
+    }
+    trim_heap<WeightedDiff>();
+  }
+
+  /// Removes the excess bins using a min-heap of the differences between
+  /// adjacent bins. The bins are merged in the same order as by repeated
+  /// linear scans (the leftmost pair wins on ties), in O(n log n) instead of
+  /// O(n²).
+  template <bool WeightedDiff>
+  auto trim_heap() -> void {
+    using Differences = BinDifferences<T, WeightedDiff>;
+    constexpr auto npos = std::numeric_limits<size_t>::max();
+    const auto size = bins_.size();
+
+    // Doubly linked list of the remaining bins. The stamp of a bin is
+    // incremented each time the difference with its right neighbor changes,
+    // to discard the outdated entries of the heap.
+    auto prev = std::vector<size_t>(size);
+    auto next = std::vector<size_t>(size);
+    auto stamp = std::vector<uint32_t>(size, 0);
+    auto alive = std::vector<bool>(size, true);
+    for (size_t ix = 0; ix < size; ++ix) {
+      prev[ix] = ix == 0 ? npos : ix - 1;
+      next[ix] = ix + 1 == size ? npos : ix + 1;
+    }
+
+    using Item = std::tuple<T, size_t, uint32_t>;
+    auto greater = [](const Item& lhs, const Item& rhs) {
+      return std::get<0>(lhs) > std::get<0>(rhs) ||
+             (std::get<0>(lhs) == std::get<0>(rhs) &&
+              std::get<1>(lhs) > std::get<1>(rhs));
+    };
+    auto heap = std::vector<Item>();
+    heap.reserve(size);
+
+    auto push = [&](const size_t ix) {
+      auto diff = Differences::calculate(bins_[next[ix]], bins_[ix]);
+      if (!std::isnan(diff)) {
+        heap.emplace_back(diff, ix, stamp[ix]);
+        std::push_heap(heap.begin(), heap.end(), greater);
+      }
+    };
+
+    for (size_t ix = 0; ix + 1 < size; ++ix) {
+      auto diff = Differences::calculate(bins_[ix + 1], bins_[ix]);
+      if (!std::isnan(diff)) {
+        heap.emplace_back(diff, ix, 0);
+      }
+    }
+    std::make_heap(heap.begin(), heap.end(), greater);
+
+    auto remaining = size;
+    while (remaining > bin_count_ && !heap.empty()) {
+      std::pop_heap(heap.begin(), heap.end(), greater);
+      const auto [diff, ix, item_stamp] = heap.back();
+      heap.pop_back();
+      if (!alive[ix] || item_stamp != stamp[ix]) {
+        continue;
+      }
+      const auto jx = next[ix];
+      merge_pair(bins_[ix], bins_[jx]);
+      alive[jx] = false;
+      next[ix] = next[jx];
+      if (next[ix] != npos) {
+        prev[next[ix]] = ix;
+      }
+      --remaining;
 
-      // Replace the bins (qi, ki), (qi+1, ki+1)
-      auto& item0 = bins_[ix];
-      const auto& item1 = bins_[++ix];
+      ++stamp[ix];
+      if (next[ix] != npos) {
+        push(ix);
+      }
+      if (prev[ix] != npos) {
+        ++stamp[prev[ix]];
+        push(prev[ix]);
+      }
+    }
 
-      // by the bin ((qi * ki + qi+1 * ki+1) / (ki + ki+1), ki + ki+1)
-      item0 = {(item0.value * item0.weight + item1.value * item1.weight) /
-                   (item0.weight + item1.weight),
-               item0.weight + item1.weight};
-      bins_.erase(bins_.begin() + ix);
+    auto result = std::vector<Bin<T>>();
+    result.reserve(remaining);
+    for (size_t ix = 0; ix < size; ++ix) {
+      if (alive[ix]) {
+        result.push_back(bins_[ix]);
+      }
     }
+    bins_ = std::move(result);
   }
 
   /// Calculates a moment of order n
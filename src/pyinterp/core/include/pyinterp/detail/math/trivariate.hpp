@@ -78,16 +78,20 @@ constexpr auto get_z_interpolation_method(
 /// @param q011 Point value for the coordinate (x0, y1, z1)
 /// @param q101 Point value for the coordinate (x1, y0, z1)
 /// @param q111 Point value for the coordinate (x1, y1, z1)
+/// @param bivariate Interpolator used on the planes z0 and z1
+/// @param interpolator Interpolation performed along the Z-axis
 /// @return interpolated value at coordinate (x, y, z)
+/// @tparam Interpolator Type of the bivariate interpolator, either the
+/// abstract class or a concrete implementation whose calls are inlined
 template <template <class> class Point = geometry::TemporalEquatorial2D,
-          typename T>
+          typename T,
+          typename Interpolator = Bivariate<geometry::TemporalEquatorial2D, T>>
 constexpr auto trivariate(
     const geometry::TemporalEquatorial2D<T>& p,
     const geometry::TemporalEquatorial2D<T>& p0,
     const geometry::TemporalEquatorial2D<T>& p1, const T& q000, const T& q010,
     const T& q100, const T& q110, const T& q001, const T& q011, const T& q101,
-    const T& q111,
-    const Bivariate<geometry::TemporalEquatorial2D, T>* bivariate,
+    const T& q111, const Interpolator* bivariate,
     const z_method_t<int64_t, T>& interpolator = &linear<int64_t, T>) -> T {
   auto z0 = bivariate->evaluate(p, p0, p1, q000, q010, q100, q110);
   auto z1 = bivariate->evaluate(p, p0, p1, q001, q011, q101, q111);
@@ -107,13 +111,18 @@ constexpr auto trivariate(
 /// @param q011 Point value for the coordinate (x0, y1, z1)
 /// @param q101 Point value for the coordinate (x1, y0, z1)
 /// @param q111 Point value for the coordinate (x1, y1, z1)
+/// @param bivariate Interpolator used on the planes z0 and z1
+/// @param interpolator Interpolation performed along the Z-axis
 /// @return interpolated value at coordinate (x, y, z)
-template <template <class> class Point, typename T>
+/// @tparam Interpolator Type of the bivariate interpolator, either the
+/// abstract class or a concrete implementation whose calls are inlined
+template <template <class> class Point, typename T,
+          typename Interpolator = Bivariate<Point, T>>
 constexpr auto trivariate(const Point<T>& p, const Point<T>& p0,
                           const Point<T>& p1, const T& q000, const T& q010,
                           const T& q100, const T& q110, const T& q001,
                           const T& q011, const T& q101, const T& q111,
-                          const Bivariate<Point, T>* bivariate,
+                          const Interpolator* bivariate,
                           const z_method_t<T, T>& interpolator = &linear<T, T>)
     -> T {
   auto z0 = bivariate->evaluate(p, p0, p1, q000, q010, q100, q110);
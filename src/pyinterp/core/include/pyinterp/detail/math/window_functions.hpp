@@ -1,7 +1,10 @@
 #pragma once
+#include <algorithm>
+#include <cmath>
 #include <cstdint>
 #include <stdexcept>
 #include <string>
+#include <vector>
 
 #include "pyinterp/detail/math.hpp"
 
@@ -15,6 +18,7 @@ enum Function : uint8_t {
   kBlackmanHarris,
   kBoxcar,
   kFlatTop,
+  kGaussian,
   kHamming,
   kLanczos,
   kNuttall,
@@ -22,6 +26,18 @@ enum Function : uint8_t {
   kParzenSWOT,
 };
 
+/// Gaussian window function truncated at the radius. The argument is the
+/// standard deviation of the Gaussian; if it is not strictly positive, the
+/// standard deviation is half of the radius.
+template <typename T>
+constexpr auto gaussian(const T& d, const T& r, const T& sigma) -> T {
+  if (d <= r) {
+    auto ratio = d / (sigma > 0 ? sigma : r / 2);
+    return std::exp(T(-0.5) * ratio * ratio);
+  }
+  return T(0);
+}
+
 /// Hamming window function.
 template <typename T>
 constexpr auto hamming(const T& d, const T& r, const T& /*unused*/) -> T {
@@ -144,7 +160,7 @@ class WindowFunction {
   /// Default constructor
   ///
   /// @param function The window function to use.
-  explicit WindowFunction(const window::Function wf) {
+  explicit WindowFunction(const window::Function wf) : wf_(wf) {
     switch (wf) {
       case window::Function::kBlackman:
         function_ = &window::blackman;
@@ -158,6 +174,9 @@ class WindowFunction {
       case window::Function::kFlatTop:
         function_ = &window::flat_top;
         break;
+      case window::Function::kGaussian:
+        function_ = &window::gaussian;
+        break;
       case window::Function::kLanczos:
         function_ = &window::lanczos;
         break;
@@ -190,9 +209,94 @@ class WindowFunction {
     return (this->function_)(data, r, arg);
   }
 
+  /// Returns the distance beyond which the window function is null.
+  ///
+  /// @param r The radius of the window function.
+  /// @param arg The optional argument to the window function.
+  [[nodiscard]] constexpr auto support(const T& r, const T& arg = T(0)) const
+      -> T {
+    return wf_ == window::Function::kLanczos ? arg * r : r;
+  }
+
  private:
+  /// The window function identifier.
+  window::Function wf_;
+
   /// The window function to use.
   PtrWindowFunction function_;
 };
 
+/// Window function tabulated for a given radius and argument. The window is
+/// sampled at regular intervals over its support, then evaluated by linear
+/// interpolation between the samples, which avoids the calculation of the
+/// trigonometric functions. The error decreases with the square of the
+/// number of samples. The distances located beyond the support are
+/// evaluated by the window function.
+template <typename T>
+class WindowFunctionTable {
+ public:
+  /// Default constructor
+  ///
+  /// @param wf The window function to tabulate.
+  /// @param r The radius of the window function.
+  /// @param arg The optional argument to the window function.
+  /// @param size The number of intervals of the table.
+  WindowFunctionTable(const WindowFunction<T>& wf, const T& r, const T& arg,
+                      const size_t size)
+      : wf_(wf), r_(r), arg_(arg) {
+    if (size == 0) {
+      throw std::invalid_argument(
+          "the size of the table must be strictly positive");
+    }
+    auto extent = std::max(wf.support(r, arg), r);
+    if (!(extent > 0) || !std::isfinite(extent)) {
+      throw std::invalid_argument(
+          "the support of the window function must be finite and strictly "
+          "positive");
+    }
+    table_.resize(size + 1);
+    for (size_t ix = 0; ix <= size; ++ix) {
+      table_[ix] = wf(extent * static_cast<T>(ix) / static_cast<T>(size), r,
+                      arg);
+    }
+    scale_ = static_cast<T>(size) / extent;
+  }
+
+  /// Evaluates the window function for a distance.
+  ///
+  /// @param d The distance to evaluate.
+  /// @return The weight of the distance.
+  [[nodiscard]] auto operator()(const T& d) const -> T {
+    auto x = d * scale_;
+    // The comparison also rejects the undefined distances.
+    if (!(x < static_cast<T>(table_.size() - 1))) {
+      return wf_(d, r_, arg_);
+    }
+    auto ix = static_cast<size_t>(x);
+    auto t = x - static_cast<T>(ix);
+    return table_[ix] + t * (table_[ix + 1] - table_[ix]);
+  }
+
+  /// Returns the number of intervals of the table.
+  [[nodiscard]] auto size() const noexcept -> size_t {
+    return table_.size() - 1;
+  }
+
+ private:
+  /// The window function tabulated.
+  WindowFunction<T> wf_;
+
+  /// The radius of the window function.
+  T r_;
+
+  /// The optional argument to the window function.
+  T arg_;
+
+  /// Number of intervals per unit of distance.
+  T scale_;
+
+  /// The values of the window function at the nodes of the table.
+  std::vector<T> table_{};
+};
+
 }  // namespace pyinterp::detail::math
\ No newline at end of file
@@ -0,0 +1,74 @@
+// Copyright (c) 2022 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+#pragma once
+#include <array>
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+
+namespace pyinterp::detail {
+
+/// Values computed on demand for a set of keys, shared by all the threads.
+///
+/// The keys are spread over shards protected by their own lock, so that the
+/// threads looking up different keys rarely wait for each other. A value is
+/// computed without holding the lock: two threads may compute the same value
+/// concurrently, the first one inserted is kept.
+///
+/// @tparam Value The type of the values stored.
+template <typename Value>
+class MemoCache {
+ public:
+  /// Get the value of a key, computing it if it is not cached.
+  ///
+  /// @param key Key of the value.
+  /// @param compute Function returning the value of the key.
+  /// @return the value of the key.
+  template <typename Function>
+  auto get(const uint64_t key, Function&& compute) -> Value {
+    auto& shard = shards_[shard_index(key)];
+    {
+      auto lock = std::lock_guard<std::mutex>(shard.mutex);
+      auto it = shard.values.find(key);
+      if (it != shard.values.end()) {
+        return it->second;
+      }
+    }
+    auto value = compute();
+
+    auto lock = std::lock_guard<std::mutex>(shard.mutex);
+    return shard.values.emplace(key, std::move(value)).first->second;
+  }
+
+  /// Get the number of values cached.
+  [[nodiscard]] auto size() const -> size_t {
+    auto result = size_t(0);
+    for (const auto& shard : shards_) {
+      auto lock = std::lock_guard<std::mutex>(shard.mutex);
+      result += shard.values.size();
+    }
+    return result;
+  }
+
+ private:
+  /// Number of shards: a power of two.
+  static constexpr size_t kShards = 64;
+
+  /// Values whose keys fall into the same shard.
+  struct Shard {
+    mutable std::mutex mutex;
+    std::unordered_map<uint64_t, Value> values;
+  };
+
+  std::array<Shard, kShards> shards_{};
+
+  /// Get the shard of a key. The keys are mixed by a multiplicative hash, so
+  /// that consecutive keys fall into different shards.
+  static constexpr auto shard_index(const uint64_t key) noexcept -> size_t {
+    return static_cast<size_t>((key * 0x9E3779B97F4A7C15ULL) >> 58U);
+  }
+};
+
+}  // namespace pyinterp::detail
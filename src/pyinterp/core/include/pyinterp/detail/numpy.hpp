@@ -5,8 +5,20 @@
 #pragma once
 #include <pybind11/numpy.h>
 
+#include <algorithm>
+#include <array>
+#include <cstring>
 #include <list>
+#include <numeric>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
+#include "pyinterp/detail/broadcast.hpp"
 #include "pyinterp/eigen.hpp"
 
 namespace pyinterp::detail::numpy {
@@ -89,6 +101,100 @@ template <typename T>
   return {reduced_shape, strides, adjusted_strides};
 }
 
+/// Layout of a C-contiguous tensor reduced over some of its axes.
+///
+/// The consecutive axes that are all kept, or all reduced, are merged into
+/// groups: the tensor is then seen as alternating groups of kept and reduced
+/// axes. The values of the innermost group are contiguous in memory. If this
+/// group is reduced, they all contribute to the same reduced value; otherwise,
+/// they contribute to consecutive reduced values.
+struct ReducedLayout {
+  /// Shape of the kept groups, innermost group excluded.
+  std::vector<pybind11::ssize_t> kept_shape{};
+  /// Strides, in number of items, of the kept groups, innermost excluded.
+  std::vector<pybind11::ssize_t> kept_strides{};
+  /// Shape of the reduced groups, innermost group excluded.
+  std::vector<pybind11::ssize_t> reduced_shape{};
+  /// Strides, in number of items, of the reduced groups, innermost excluded.
+  std::vector<pybind11::ssize_t> reduced_strides{};
+  /// Size of the innermost group.
+  pybind11::ssize_t inner_size{1};
+  /// True if the innermost group is reduced.
+  bool inner_reduced{false};
+
+  /// Get the number of runs of inner_size values contributing to each
+  /// reduced value, if the innermost group is reduced, or to each run of
+  /// inner_size consecutive reduced values otherwise.
+  [[nodiscard]] auto runs() const -> pybind11::ssize_t {
+    return std::accumulate(reduced_shape.begin(), reduced_shape.end(),
+                           static_cast<pybind11::ssize_t>(1),
+                           std::multiplies<>());
+  }
+
+  /// Get the offset of the first value of the given kept index, the
+  /// innermost group excluded.
+  [[nodiscard]] auto kept_offset(const pybind11::ssize_t index) const
+      -> pybind11::ssize_t {
+    return offset(index, kept_shape, kept_strides);
+  }
+
+  /// Get the offset of the given run relative to the first value of a kept
+  /// index.
+  [[nodiscard]] auto run_offset(const pybind11::ssize_t index) const
+      -> pybind11::ssize_t {
+    return offset(index, reduced_shape, reduced_strides);
+  }
+
+ private:
+  /// Converts a flat index into an offset in memory.
+  static auto offset(pybind11::ssize_t index,
+                     const std::vector<pybind11::ssize_t>& shape,
+                     const std::vector<pybind11::ssize_t>& strides)
+      -> pybind11::ssize_t {
+    auto result = pybind11::ssize_t(0);
+    for (auto ix = static_cast<int64_t>(shape.size()) - 1; ix >= 0; --ix) {
+      const auto dim = shape[ix];
+      result += (index % dim) * strides[ix];
+      index /= dim;
+    }
+    return result;
+  }
+};
+
+/// Get the layout of a C-contiguous tensor reduced over the given axes.
+template <typename T>
+[[nodiscard]] auto reduced_layout(
+    const pybind11::array_t<T, pybind11::array::c_style>& arr,
+    const std::list<pybind11::ssize_t>& axes) -> ReducedLayout {
+  // Groups of consecutive axes of the same kind: (size, reduced).
+  auto groups = std::vector<std::pair<pybind11::ssize_t, bool>>();
+  for (pybind11::ssize_t ix = 0; ix < arr.ndim(); ++ix) {
+    const auto reduced = std::find(axes.begin(), axes.end(), ix) != axes.end();
+    if (!groups.empty() && groups.back().second == reduced) {
+      groups.back().first *= arr.shape(ix);
+    } else {
+      groups.emplace_back(arr.shape(ix), reduced);
+    }
+  }
+
+  auto result = ReducedLayout();
+  if (groups.empty()) {
+    return result;
+  }
+  std::tie(result.inner_size, result.inner_reduced) = groups.back();
+
+  auto stride = result.inner_size;
+  for (auto ix = static_cast<int64_t>(groups.size()) - 2; ix >= 0; --ix) {
+    const auto& [size, reduced] = groups[ix];
+    auto& shape = reduced ? result.reduced_shape : result.kept_shape;
+    auto& strides = reduced ? result.reduced_strides : result.kept_strides;
+    shape.insert(shape.begin(), size);
+    strides.insert(strides.begin(), stride);
+    stride *= size;
+  }
+  return result;
+}
+
 /// Returns an array of ones with the same shape as a given array.
 template <typename T>
 [[nodiscard]] auto ones_like(
@@ -107,4 +213,165 @@ template <typename T>
   return reinterpret_cast<T*>(pybind11::detail::array_proxy(ptr)->data);
 }
 
-}  // namespace pyinterp::detail::numpy
\ No newline at end of file
+/// Reads a vector or a matrix of numbers in place, whatever its strides,
+/// converting its items to T when they are read.
+///
+/// A pybind11::array_t<T> copies the arrays of another type, and the
+/// c_style ones copy the non-contiguous arrays (e.g. a column of a matrix or
+/// a field of a structured array). The vectors of float32 or float64 are read
+/// here without copy, each thread converting the values it reads. The arrays
+/// of the other types are converted once, when the reader is created.
+///
+/// The reader holds a reference to the array read: it must be created and
+/// destroyed with the GIL held.
+///
+/// @tparam T Type of the values returned, float or double.
+template <typename T>
+class ArrayReader {
+ public:
+  static_assert(std::is_floating_point_v<T>,
+                "the values read are floating-point numbers");
+
+  /// Default constructor
+  ///
+  /// @param array Vector or matrix to read.
+  explicit ArrayReader(const pybind11::array& array) {
+    auto values = array;
+    if (pybind11::isinstance<pybind11::array_t<double>>(values)) {
+      kind_ = kFloat64;
+    } else if (pybind11::isinstance<pybind11::array_t<float>>(values)) {
+      kind_ = kFloat32;
+    } else {
+      values = array.cast<pybind11::array_t<T>>();
+      kind_ = kNative;
+    }
+    data_ = static_cast<const char*>(values.data());
+    const auto ndim = std::min<pybind11::ssize_t>(values.ndim(), 2);
+    for (pybind11::ssize_t ix = 0; ix < ndim; ++ix) {
+      strides_[ix] = values.strides(ix);
+    }
+    array_ = std::move(values);
+  }
+
+  /// Get the item ix of a vector.
+  inline auto operator()(const pybind11::ssize_t ix) const noexcept -> T {
+    return read(data_ + ix * strides_[0]);
+  }
+
+  /// Get the item (ix, jx) of a matrix.
+  inline auto operator()(const pybind11::ssize_t ix,
+                         const pybind11::ssize_t jx) const noexcept -> T {
+    return read(data_ + ix * strides_[0] + jx * strides_[1]);
+  }
+
+  /// Get the first items of the row ix of a matrix. The row is read in place
+  /// if its items are contiguous and of type T, otherwise its items are
+  /// converted into the buffer provided.
+  ///
+  /// @param ix Index of the row.
+  /// @param size Number of items to read.
+  /// @param buffer Buffer of at least "size" items.
+  inline auto row(const pybind11::ssize_t ix, const pybind11::ssize_t size,
+                  T* buffer) const noexcept -> Eigen::Map<const Vector<T>> {
+    const auto* first = data_ + ix * strides_[0];
+    if (kind_ == kNative &&
+        strides_[1] == static_cast<pybind11::ssize_t>(sizeof(T))) {
+      return {reinterpret_cast<const T*>(first), size};
+    }
+    for (pybind11::ssize_t jx = 0; jx < size; ++jx) {
+      buffer[jx] = read(first + jx * strides_[1]);
+    }
+    return {buffer, size};
+  }
+
+ private:
+  /// Type of the items stored in the array read.
+  enum Kind { kFloat32, kFloat64 };
+
+  /// Type of the items that can be read without conversion.
+  static constexpr Kind kNative =
+      std::is_same_v<T, float> ? kFloat32 : kFloat64;
+
+  /// The array read, kept alive during the reading.
+  pybind11::array array_{};
+  /// Type of the items stored.
+  Kind kind_{kFloat64};
+  /// Address of the first item.
+  const char* data_{nullptr};
+  /// Number of bytes between two rows, and between two columns.
+  std::array<pybind11::ssize_t, 2> strides_{};
+
+  /// Reads an item. The items of a structured array may not be aligned.
+  inline auto read(const char* ptr) const noexcept -> T {
+    if (kind_ == kFloat64) {
+      auto value = 0.0;
+      std::memcpy(&value, ptr, sizeof(value));
+      return static_cast<T>(value);
+    }
+    auto value = 0.0F;
+    std::memcpy(&value, ptr, sizeof(value));
+    return static_cast<T>(value);
+  }
+};
+
+/// Moves a serialized buffer into a vector of bytes, without copying it.
+///
+/// Unlike the bytes objects, the numpy arrays are transferred out-of-band by
+/// the pickle protocol 5: the states holding such vectors are exchanged
+/// between processes without extra copies.
+inline auto to_bytes_array(std::string&& buffer)
+    -> pybind11::array_t<uint8_t> {
+  auto* ptr = new std::string(std::move(buffer));
+  auto capsule = pybind11::capsule(
+      ptr, [](void* data) { delete static_cast<std::string*>(data); });
+  return pybind11::array_t<uint8_t>(
+      {static_cast<pybind11::ssize_t>(ptr->size())},
+      reinterpret_cast<const uint8_t*>(ptr->data()), capsule);
+}
+
+/// Get the array receiving the result of a computation.
+///
+/// If the user does not provide an array, a new one is allocated. Otherwise,
+/// the values are written in place into the array provided, which must have
+/// the expected type and shape, be C-contiguous and writeable: no copy or
+/// conversion is made, so that the caller sees the result in its own buffer
+/// (for example, a buffer in shared memory). This array must not overlap the
+/// input arrays.
+///
+/// @param name name of the parameter holding the array provided
+/// @param out array provided by the user, if any
+/// @param shape expected shape of the result
+/// @throw std::invalid_argument if the array provided is not suitable
+template <typename T>
+[[nodiscard]] auto output_array(
+    const std::string& name, const std::optional<pybind11::array>& out,
+    const std::vector<pybind11::ssize_t>& shape) -> pybind11::array_t<T> {
+  if (!out) {
+    return pybind11::array_t<T>(shape);
+  }
+  const auto& array = *out;
+  if (!pybind11::isinstance<pybind11::array_t<T, pybind11::array::c_style>>(
+          array)) {
+    throw std::invalid_argument(
+        name + " must be a C-contiguous array of type " +
+        std::string(pybind11::str(pybind11::dtype::of<T>())));
+  }
+  if (!array.writeable()) {
+    throw std::invalid_argument(name + " must be writeable");
+  }
+  auto match = array.ndim() == static_cast<pybind11::ssize_t>(shape.size());
+  for (size_t ix = 0; match && ix < shape.size(); ++ix) {
+    match = array.shape(static_cast<pybind11::ssize_t>(ix)) == shape[ix];
+  }
+  if (!match) {
+    auto expected = std::string("(");
+    for (const auto& item : shape) {
+      expected += std::to_string(item) + ", ";
+    }
+    throw std::invalid_argument(name + " has shape " + ndarray_shape(array) +
+                                ", expected " + expected + ")");
+  }
+  return pybind11::reinterpret_borrow<pybind11::array_t<T>>(array);
+}
+
+}  // namespace pyinterp::detail::numpy
@@ -0,0 +1,261 @@
+// Copyright (c) 2022 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+#pragma once
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#define PYINTERP_HAS_RDTSC
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define PYINTERP_HAS_RDTSC
+#endif
+
+namespace pyinterp::detail::profiling {
+
+/// Hot paths of the library instrumented by the profiler.
+enum Counter : uint8_t {
+  kAxisFindIndexes,  //!< Search of the cells framing coordinates on an axis.
+  kDispatch,         //!< Parallel execution of a range of items.
+  kDispatchStartup,  //!< Delay before a worker starts a parallel task.
+  kFillGaussSeidel,  //!< Gauss-Seidel relaxation sweeps.
+  kFillLoess,        //!< LOESS filtering of the columns of a grid.
+  kFillMultigrid,    //!< Multigrid V-cycles.
+  kFillSpectral,     //!< Iterations of the spectral Poisson solver.
+  kLoadFrame,        //!< Loading of the interpolation frames.
+  kRTreeQuery,       //!< Searches of neighbors in a RTree.
+  kHistogramMarshal, //!< Serialization of streaming histograms.
+  kCounterCount,     //!< Number of counters.
+};
+
+/// Values accumulated by a counter.
+struct Statistics {
+  /// Number of times the instrumented code has been executed.
+  uint64_t calls;
+  /// Time spent in the instrumented code, in ticks of the timer.
+  uint64_t ticks;
+  /// Time spent in the instrumented code, in seconds.
+  double seconds;
+  /// Number of memory blocks allocated by the instrumented code.
+  uint64_t allocations;
+  /// Number of bytes allocated by the instrumented code.
+  uint64_t bytes;
+  /// Largest number of bytes held at the same time by the instrumented code,
+  /// all threads included.
+  uint64_t peak_bytes;
+};
+
+/// Values accumulated by all the counters.
+using Snapshot = std::array<Statistics, kCounterCount>;
+
+/// Process-wide switch of the profiler. When it is off, the only cost of an
+/// instrumented section is the relaxed load of this flag.
+inline std::atomic<bool> active{false};
+
+/// Get the name of a counter.
+auto name(Counter counter) -> const char*;
+
+/// Turns on or off the profiler.
+auto enable(bool value) -> void;
+
+/// Returns true if the profiler is turned on.
+inline auto enabled() noexcept -> bool {
+  return active.load(std::memory_order_relaxed);
+}
+
+/// Reads the timer of the profiler: the time stamp counter of the CPU if it
+/// is available, the steady clock in nanoseconds otherwise.
+inline auto ticks() noexcept -> uint64_t {
+#ifdef PYINTERP_HAS_RDTSC
+  return __rdtsc();
+#else
+  return static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::steady_clock::now().time_since_epoch())
+          .count());
+#endif
+}
+
+/// Adds an execution of an instrumented section to the counters of the
+/// calling thread.
+///
+/// @param counter Counter updated.
+/// @param elapsed Time spent in the section, in ticks of the timer.
+auto record(Counter counter, uint64_t elapsed) -> void;
+
+/// Adds a memory block allocated by an instrumented section to the counters
+/// of the calling thread.
+///
+/// @param counter Counter updated.
+/// @param bytes Size of the block, in bytes.
+auto allocate(Counter counter, size_t bytes) -> void;
+
+/// Releases a memory block recorded by allocate.
+///
+/// @param counter Counter updated.
+/// @param bytes Size of the block, in bytes.
+auto deallocate(Counter counter, size_t bytes) -> void;
+
+/// Get the values accumulated by all the threads since the last reset.
+auto snapshot() -> Snapshot;
+
+/// Sets all the counters to zero.
+auto reset() -> void;
+
+/// Measures the execution of the scope in which it is declared, if the
+/// profiler is turned on when the scope is entered. The timings of nested
+/// scopes are included in the timings of the scopes enclosing them.
+class Scope {
+ public:
+  /// Starts the measurement.
+  explicit Scope(const Counter counter) noexcept
+      : counter_(counter), active_(enabled()) {
+    if (active_) {
+      start_ = ticks();
+    }
+  }
+
+  /// Records the measurement.
+  ~Scope() {
+    if (active_) {
+      record(counter_, ticks() - start_);
+    }
+  }
+
+  /// Copy constructor
+  Scope(const Scope&) = delete;
+
+  /// Move constructor
+  Scope(Scope&&) = delete;
+
+  /// Copy assignment operator
+  auto operator=(const Scope&) -> Scope& = delete;
+
+  /// Move assignment operator
+  auto operator=(Scope&&) -> Scope& = delete;
+
+ private:
+  Counter counter_;
+  bool active_;
+  uint64_t start_{0};
+};
+
+/// Records the memory held by an instrumented section, from the declaration
+/// of this object to the end of its scope, if the profiler is turned on when
+/// it is declared. It accounts for the buffers whose allocation cannot be
+/// intercepted, such as the Eigen matrices.
+class Allocation {
+ public:
+  /// Records the allocation of the block.
+  Allocation(const Counter counter, const size_t bytes) noexcept
+      : counter_(counter), bytes_(enabled() ? bytes : 0) {
+    if (bytes_ != 0) {
+      allocate(counter_, bytes_);
+    }
+  }
+
+  /// Records the release of the block.
+  ~Allocation() {
+    if (bytes_ != 0) {
+      deallocate(counter_, bytes_);
+    }
+  }
+
+  /// Copy constructor
+  Allocation(const Allocation&) = delete;
+
+  /// Move constructor
+  Allocation(Allocation&&) = delete;
+
+  /// Copy assignment operator
+  auto operator=(const Allocation&) -> Allocation& = delete;
+
+  /// Move assignment operator
+  auto operator=(Allocation&&) -> Allocation& = delete;
+
+ private:
+  Counter counter_;
+  size_t bytes_;
+};
+
+/// Allocator of the standard containers recording, in a counter, the memory
+/// they hold. The state of the profiler is read when the allocator is
+/// created: the blocks allocated by a container are all released with the
+/// same accounting, even if the profiler is turned on or off in between.
+///
+/// @tparam T Type of the elements allocated.
+/// @tparam C Counter updated.
+template <typename T, Counter C>
+class Allocator {
+ public:
+  /// Type of the elements allocated.
+  using value_type = T;
+
+  /// The allocator follows the blocks moved or swapped between containers,
+  /// so that they are released with the accounting of their allocation.
+  using propagate_on_container_move_assignment = std::true_type;
+  using propagate_on_container_swap = std::true_type;
+
+  /// Default constructor
+  Allocator() noexcept : active_(enabled()) {}
+
+  /// Creates an allocator of another type sharing the same accounting.
+  template <typename U>
+  Allocator(const Allocator<U, C>& rhs) noexcept  // NOLINT
+      : active_(rhs.active()) {}
+
+  /// Allocates a block able to hold n elements.
+  [[nodiscard]] auto allocate(const size_t n) -> T* {
+    auto* result = std::allocator<T>().allocate(n);
+    if (active_) {
+      profiling::allocate(C, n * sizeof(T));
+    }
+    return result;
+  }
+
+  /// Releases a block allocated by this allocator.
+  auto deallocate(T* ptr, const size_t n) noexcept -> void {
+    if (active_) {
+      profiling::deallocate(C, n * sizeof(T));
+    }
+    std::allocator<T>().deallocate(ptr, n);
+  }
+
+  /// Returns true if the allocations are recorded.
+  [[nodiscard]] constexpr auto active() const noexcept -> bool {
+    return active_;
+  }
+
+  /// Rebinds the allocator to another type of elements.
+  template <typename U>
+  struct rebind {
+    using other = Allocator<U, C>;
+  };
+
+ private:
+  bool active_;
+};
+
+/// The blocks allocated by any allocator can be released by another: they
+/// all come from the standard allocator.
+template <typename T, typename U, Counter C>
+constexpr auto operator==(const Allocator<T, C>& /*lhs*/,
+                          const Allocator<U, C>& /*rhs*/) noexcept -> bool {
+  return true;
+}
+
+template <typename T, typename U, Counter C>
+constexpr auto operator!=(const Allocator<T, C>& /*lhs*/,
+                          const Allocator<U, C>& /*rhs*/) noexcept -> bool {
+  return false;
+}
+
+}  // namespace pyinterp::detail::profiling
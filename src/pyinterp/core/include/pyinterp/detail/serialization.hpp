@@ -0,0 +1,137 @@
+// Copyright (c) 2022 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+#pragma once
+#include <cstdint>
+#include <cstring>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace pyinterp::detail::serialization {
+
+/// Appends the binary representation of trivially copyable values to a
+/// buffer.
+class Writer {
+ public:
+  /// Appends a value.
+  template <typename T>
+  auto write(const T& value) -> void {
+    write(&value, 1);
+  }
+
+  /// Appends an array of values.
+  template <typename T>
+  auto write(const T* values, const size_t count) -> void {
+    static_assert(std::is_trivially_copyable_v<T>);
+    buffer_.append(reinterpret_cast<const char*>(values), count * sizeof(T));
+  }
+
+  /// Reserves memory for the given number of bytes.
+  auto reserve(const size_t size) -> void { buffer_.reserve(size); }
+
+  /// Returns the buffer written.
+  [[nodiscard]] auto str() && -> std::string { return std::move(buffer_); }
+
+ private:
+  std::string buffer_{};
+};
+
+/// Reads the values written by a Writer, directly from the buffer that holds
+/// them.
+class Reader {
+ public:
+  /// Default constructor
+  explicit Reader(const std::string_view& buffer) : buffer_(buffer) {}
+
+  /// Reads a value.
+  template <typename T>
+  auto read() -> T {
+    auto result = T();
+    read(&result, 1);
+    return result;
+  }
+
+  /// Reads an array of values.
+  template <typename T>
+  auto read(T* values, const size_t count) -> void {
+    static_assert(std::is_trivially_copyable_v<T>);
+    if (count > buffer_.size() / sizeof(T)) {
+      throw std::invalid_argument("invalid state");
+    }
+    const auto size = count * sizeof(T);
+    std::memcpy(values, buffer_.data(), size);
+    buffer_.remove_prefix(size);
+  }
+
+  /// Returns the number of bytes not read.
+  [[nodiscard]] auto size() const noexcept -> size_t { return buffer_.size(); }
+
+  /// Returns true if all the buffer has been read.
+  [[nodiscard]] auto empty() const noexcept -> bool { return buffer_.empty(); }
+
+ private:
+  std::string_view buffer_;
+};
+
+/// Tag written at the beginning of the serialized grids. The previous formats
+/// began with the number of rows, which cannot be negative.
+constexpr int64_t kGridTag = -1;
+
+/// Writes the header of a grid of statistics in which only the listed cells
+/// are serialized, the others being empty. If all cells are listed, their
+/// indexes are not written.
+///
+/// @param writer Buffer to write.
+/// @param rows Number of rows of the grid.
+/// @param cols Number of columns of the grid.
+/// @param cells Indexes, in increasing order, of the serialized cells in the
+/// storage of the grid.
+inline auto write_grid_header(Writer& writer, const int64_t rows,
+                              const int64_t cols,
+                              const std::vector<uint64_t>& cells) -> void {
+  writer.write(kGridTag);
+  writer.write(rows);
+  writer.write(cols);
+  writer.write(static_cast<uint64_t>(cells.size()));
+  if (cells.size() != static_cast<uint64_t>(rows * cols)) {
+    writer.write(cells.data(), cells.size());
+  }
+}
+
+/// Reads the header written by write_grid_header.
+///
+/// @param reader Buffer to read.
+/// @param rows Expected number of rows of the grid.
+/// @param cols Expected number of columns of the grid.
+/// @return the indexes of the serialized cells.
+inline auto read_grid_header(Reader& reader, const int64_t rows,
+                             const int64_t cols) -> std::vector<uint64_t> {
+  const auto size = static_cast<uint64_t>(rows * cols);
+  if (reader.read<int64_t>() != kGridTag || reader.read<int64_t>() != rows ||
+      reader.read<int64_t>() != cols) {
+    throw std::invalid_argument("invalid state");
+  }
+  const auto count = reader.read<uint64_t>();
+  if (count > size) {
+    throw std::invalid_argument("invalid state");
+  }
+  auto result = std::vector<uint64_t>(count);
+  if (count == size) {
+    std::iota(result.begin(), result.end(), uint64_t(0));
+    return result;
+  }
+  reader.read(result.data(), count);
+  for (size_t ix = 0; ix < count; ++ix) {
+    if (result[ix] >= size || (ix != 0 && result[ix] <= result[ix - 1])) {
+      throw std::invalid_argument("invalid state");
+    }
+  }
+  return result;
+}
+
+}  // namespace pyinterp::detail::serialization
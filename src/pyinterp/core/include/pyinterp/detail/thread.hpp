@@ -3,47 +3,156 @@
 // All rights reserved. Use of this source code is governed by a
 // BSD-style license that can be found in the LICENSE file.
 #pragma once
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
 #include <thread>
 #include <vector>
 
 namespace pyinterp::detail {
 
+/// Strategy used to distribute the items of a range between the threads.
+enum Schedule : uint8_t {
+  kStatic,   //!< One part of the range per thread, with block stealing.
+  kDynamic,  //!< Fixed-size blocks handed out on demand.
+  kGuided,   //!< Blocks handed out on demand, decreasing in size.
+};
+
+/// Pool of persistent worker threads shared by all the parallel algorithms of
+/// the library.
+///
+/// The process-wide instance is created the first time it is accessed and its
+/// workers are kept alive until the end of the process, so that the cost of
+/// creating threads is not paid on every call.
+class ThreadPool {
+ public:
+  /// Type of the tasks executed by the workers.
+  using Task = std::function<void()>;
+
+  /// Creates a new pool.
+  ///
+  /// @param num_workers Number of worker threads to start.
+  /// @param pin If true, each worker is bound to one of the CPUs the process
+  /// may run on, the workers being spread over the NUMA nodes. This option is
+  /// ignored on the platforms other than Linux.
+  explicit ThreadPool(size_t num_workers, bool pin = false);
+
+  /// Stops and joins all the workers.
+  ~ThreadPool();
+
+  /// Copy constructor
+  ThreadPool(const ThreadPool&) = delete;
+
+  /// Move constructor
+  ThreadPool(ThreadPool&&) = delete;
+
+  /// Copy assignment operator
+  auto operator=(const ThreadPool&) -> ThreadPool& = delete;
+
+  /// Move assignment operator
+  auto operator=(ThreadPool&&) -> ThreadPool& = delete;
+
+  /// Get the number of worker threads.
+  [[nodiscard]] inline auto size() const noexcept -> size_t {
+    return workers_.size();
+  }
+
+  /// Returns true if the workers are bound to CPUs.
+  [[nodiscard]] inline auto pinned() const noexcept -> bool { return pinned_; }
+
+  /// Queues a task to be executed by the first available worker.
+  auto submit(Task task) -> void;
+
+  /// Get the process-wide pool. The pool is created the first time this
+  /// method is called.
+  static auto instance() -> std::shared_ptr<ThreadPool>;
+
+  /// Sets the number of worker threads of the process-wide pool. The tasks
+  /// already submitted to the previous pool are completed before its workers
+  /// are released.
+  ///
+  /// @param num_workers Number of worker threads. If 0, the default size is
+  /// used.
+  /// @param pin If true, the workers are bound to CPUs.
+  static auto resize(size_t num_workers, bool pin = false) -> void;
+
+  /// Get the default number of worker threads: one less than the number of
+  /// threads set by set_num_threads, since the calling thread always takes
+  /// part in the computation.
+  static auto default_size() -> size_t;
+
+ private:
+  std::vector<std::thread> workers_{};
+  std::deque<Task> tasks_{};
+  std::mutex mutex_{};
+  std::condition_variable condition_{};
+  bool stop_{false};
+  bool pinned_{false};
+
+  /// Loop executed by each worker.
+  auto run() -> void;
+};
+
+/// Get the number of CPUs the process may run on: the CPUs of its affinity
+/// mask, limited by the CPU quota of its control group, if any. The value is
+/// computed once, the first time this function is called.
+auto available_cpus() -> size_t;
+
+/// Get the number of threads used by the parallel algorithms when the caller
+/// requests 0 threads. Unless set_num_threads has been called, this is the
+/// number of CPUs available.
+auto get_num_threads() -> size_t;
+
+/// Sets the number of threads used by the parallel algorithms when the caller
+/// requests 0 threads, and resizes the process-wide pool accordingly.
+///
+/// @param num_threads Number of threads. If 0, the number of CPUs available
+/// is used.
+/// @param pin If true, the workers of the pool are bound to CPUs.
+auto set_num_threads(size_t num_threads, bool pin = false) -> void;
+
+/// Executes the worker on all the blocks of the range [0, size) using the
+/// process-wide thread pool.
+///
+/// @param worker Function called for each block of the range.
+/// @param size Size of the range to process.
+/// @param num_threads Number of threads taking part in the computation.
+/// @param schedule Strategy used to distribute the blocks between threads.
+void parallel_for(const std::function<void(size_t, size_t)>& worker,
+                  size_t size, size_t num_threads, Schedule schedule);
+
 /// Automates the cutting of vectors to be processed in thread.
 ///
+/// With the static schedule, the range is split into one contiguous part per
+/// thread, and each part is cut into smaller blocks. A thread that has
+/// processed all the blocks of its part steals the remaining blocks of the
+/// others, so that imbalanced workloads do not leave CPUs idle. The dynamic
+/// and guided schedules hand out blocks from a shared cursor, which suits
+/// calculations whose cost varies greatly from one item to another. In all
+/// cases, the worker can be called several times by the same thread.
+///
+/// The worker does not need to capture its own exceptions: the first one
+/// thrown is kept and rethrown to the caller once all threads are idle, and
+/// the blocks not yet started are cancelled.
+///
 /// @param worker Lambda function called in each thread launched
 /// @param size Size of all vectors to be processed
 /// @param num_threads The number of threads to use for the computation. If 0
-/// all CPUs are used. If 1 is given, no parallel computing code is used at all,
-/// which is useful for debugging.
+/// the number of threads returned by get_num_threads is used. If 1 is given,
+/// no parallel computing code is used at all, which is useful for debugging.
+/// @param schedule Strategy used to distribute the items between threads.
 /// @tparam Lambda Lambda function
 template <typename Lambda>
-void dispatch(const Lambda& worker, size_t size, size_t num_threads) {
+void dispatch(const Lambda& worker, size_t size, size_t num_threads,
+              const Schedule schedule = kStatic) {
   if (num_threads == 1) {
     worker(0, size);
     return;
   }
-
-  if (num_threads == 0) {
-    num_threads = std::thread::hardware_concurrency();
-  }
-
-  // List of threads responsible for parallelizing the calculation
-  std::vector<std::thread> threads(num_threads);
-
-  // Access index to the vectors required for calculation
-  size_t start = 0;
-  size_t shift = size / num_threads;
-
-  // Launch and join threads
-  for (auto it = std::begin(threads); it != std::end(threads) - 1; ++it) {
-    *it = std::thread(worker, start, start + shift);
-    start += shift;
-  }
-  threads.back() = std::thread(worker, start, size);
-
-  for (auto&& item : threads) {
-    item.join();
-  }
+  parallel_for(std::cref(worker), size, num_threads, schedule);
 }
 
 }  // namespace pyinterp::detail
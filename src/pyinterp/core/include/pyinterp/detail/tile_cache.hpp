@@ -0,0 +1,108 @@
+// Copyright (c) 2022 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+
+namespace pyinterp::detail {
+
+/// Least recently used cache of the tiles of an array too large to be held in
+/// memory. Unlike LRUCache, an instance is shared by all the threads: the
+/// tiles are handed out as shared pointers, so that a tile evicted from the
+/// cache stays valid as long as a thread reads it.
+///
+/// @tparam Tile The type of the cached tiles.
+template <typename Tile>
+class TileCache {
+ public:
+  /// Default constructor
+  ///
+  /// @param capacity Maximum number of tiles kept in the cache. At least one
+  /// tile is kept.
+  explicit TileCache(const size_t capacity)
+      : capacity_(std::max(capacity, size_t(1))) {}
+
+  /// Get the tile identified by a key, loading it if it is not cached.
+  ///
+  /// The tile is loaded without holding the lock of the cache, so that the
+  /// threads reading the cached tiles are not blocked by a slow reader. Two
+  /// threads may load the same tile concurrently: the first one inserted is
+  /// kept.
+  ///
+  /// @param key Key of the tile.
+  /// @param load Function returning the tile of the key.
+  /// @return the tile of the key.
+  template <typename Function>
+  auto get(const uint64_t key, Function&& load) -> std::shared_ptr<const Tile> {
+    {
+      auto lock = std::lock_guard<std::mutex>(mutex_);
+      if (auto tile = find(key)) {
+        return tile;
+      }
+    }
+    auto tile = std::make_shared<const Tile>(load());
+
+    auto lock = std::lock_guard<std::mutex>(mutex_);
+    if (auto cached = find(key)) {
+      return cached;
+    }
+    entries_.emplace_front(key, std::move(tile));
+    index_.emplace(key, entries_.begin());
+    if (entries_.size() > capacity_) {
+      index_.erase(entries_.back().first);
+      entries_.pop_back();
+    }
+    return entries_.front().second;
+  }
+
+  /// Get the maximum number of tiles kept in the cache.
+  [[nodiscard]] auto capacity() const noexcept -> size_t { return capacity_; }
+
+  /// Get the number of tiles cached.
+  [[nodiscard]] auto size() const -> size_t {
+    auto lock = std::lock_guard<std::mutex>(mutex_);
+    return entries_.size();
+  }
+
+  /// Removes all the tiles from the cache.
+  auto clear() -> void {
+    auto lock = std::lock_guard<std::mutex>(mutex_);
+    index_.clear();
+    entries_.clear();
+  }
+
+ private:
+  using Entries = std::list<std::pair<uint64_t, std::shared_ptr<const Tile>>>;
+
+  /// Maximum number of tiles kept in the cache
+  size_t capacity_;
+
+  /// Protects the entries of the cache.
+  mutable std::mutex mutex_{};
+
+  /// Tiles cached, from the most to the least recently used.
+  Entries entries_{};
+
+  /// Position of the tiles in the list of entries.
+  std::unordered_map<uint64_t, typename Entries::iterator> index_{};
+
+  /// Searches for a tile, which becomes the most recently used. The lock must
+  /// be held by the caller.
+  auto find(const uint64_t key) -> std::shared_ptr<const Tile> {
+    auto it = index_.find(key);
+    if (it == index_.end()) {
+      return nullptr;
+    }
+    entries_.splice(entries_.begin(), entries_, it->second);
+    return it->second->second;
+  }
+};
+
+}  // namespace pyinterp::detail
@@ -8,15 +8,29 @@
 #include <pybind11/stl.h>
 
 #include <Eigen/Core>
-#include <atomic>
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <type_traits>
 #include <boost/accumulators/accumulators.hpp>
 #include <boost/accumulators/statistics/mean.hpp>
 #include <boost/accumulators/statistics/stats.hpp>
 
 #include "pyinterp/detail/math.hpp"
+#include "pyinterp/detail/math/gauss_seidel.hpp"
+#include "pyinterp/detail/math/loess.hpp"
+#include "pyinterp/detail/math/multigrid.hpp"
+#include "pyinterp/detail/math/spectral_poisson.hpp"
+#include "pyinterp/detail/memo_cache.hpp"
+#include "pyinterp/detail/profiling.hpp"
 #include "pyinterp/detail/thread.hpp"
 #include "pyinterp/eigen.hpp"
 #include "pyinterp/grid.hpp"
+#include "pyinterp/tiled_grid.hpp"
 
 namespace pyinterp {
 namespace detail {
@@ -33,180 +47,195 @@ namespace detail {
 template <typename Type>
 void set_zonal_average(pybind11::EigenDRef<Matrix<Type>>& grid,
                        Matrix<bool>& mask, const size_t num_threads) {
-  // Captures the detected exceptions in the calculation function
-  // (only the last exception captured is kept)
-  auto except = std::exception_ptr(nullptr);
-
   detail::dispatch(
       [&](size_t y_start, size_t y_end) {
-        try {
-          // Calculation of longitude band means.
-          for (auto iy = static_cast<int64_t>(y_start);
-               iy < static_cast<int64_t>(y_end); ++iy) {
-            auto acc = boost::accumulators::accumulator_set<
-                Type,
-                boost::accumulators::stats<boost::accumulators::tag::count,
-                                           boost::accumulators::tag::mean>>();
-            for (int64_t ix = 0; ix < grid.rows(); ++ix) {
-              if (!mask(ix, iy)) {
-                acc(grid(ix, iy));
-              }
+        // Calculation of longitude band means.
+        for (auto iy = static_cast<int64_t>(y_start);
+             iy < static_cast<int64_t>(y_end); ++iy) {
+          auto acc = boost::accumulators::accumulator_set<
+              Type,
+              boost::accumulators::stats<boost::accumulators::tag::count,
+                                         boost::accumulators::tag::mean>>();
+          for (int64_t ix = 0; ix < grid.rows(); ++ix) {
+            if (!mask(ix, iy)) {
+              acc(grid(ix, iy));
             }
+          }
 
-            // The masked value is replaced by the average of the longitude band
-            // if it is defined; otherwise it is replaced by zero.
-            auto first_guess = boost::accumulators::count(acc)
-                                   ? boost::accumulators::mean(acc)
-                                   : Type(0);
-            for (int64_t ix = 0; ix < grid.rows(); ++ix) {
-              if (mask(ix, iy)) {
-                grid(ix, iy) = first_guess;
-              }
+          // The masked value is replaced by the average of the longitude band
+          // if it is defined; otherwise it is replaced by zero.
+          auto first_guess = boost::accumulators::count(acc)
+                                 ? boost::accumulators::mean(acc)
+                                 : Type(0);
+          for (int64_t ix = 0; ix < grid.rows(); ++ix) {
+            if (mask(ix, iy)) {
+              grid(ix, iy) = first_guess;
             }
           }
-        } catch (...) {
-          except = std::current_exception();
         }
       },
       grid.cols(), num_threads);
+}
+
+}  // namespace detail
+
+namespace fill {
+
+/// Type of first guess grid.
+enum FirstGuess {
+  kZero,          //!< Use 0.0 as an initial guess
+  kZonalAverage,  //!< Use zonal average in x direction
+};
+
+/// Order in which the Gauss-Seidel method updates the undefined values.
+enum Ordering {
+  kLexicographic,  //!< Row by row, the rows being processed in a pipeline
+  kRedBlack,       //!< By color of a checkerboard, each color in parallel
+};
+
+/// State of the Gauss-Seidel method after an iteration.
+struct Iteration {
+  /// Number of iterations performed.
+  size_t iteration;
+  /// Maximum residual value of the iteration.
+  double max_residual;
+  /// Number of undefined values whose residual is not lower than epsilon.
+  size_t unconverged;
+  /// Wall time spent by the iteration, in seconds.
+  double elapsed;
+};
+
+/// Function called between the iterations of the Gauss-Seidel method. If it
+/// returns true, the iterations are stopped.
+using IterationCallback = std::function<bool(const Iteration&)>;
+
+/// Function writing the halo of a tile of a grid decomposed into tiles: the
+/// pixels surrounding the tile, copied from the neighboring tiles.
+using HaloExchange = std::function<void()>;
+
+/// Function combining the maximum residuals of all the tiles of a grid
+/// decomposed into tiles, e.g. by a reduction across processes.
+using ResidualReduction = std::function<double(double)>;
 
-  if (except != nullptr) {
-    std::rethrow_exception(except);
+/// Replaces the undefined values of the grid by the first guess chosen.
+///
+/// @param grid The grid to be processed
+/// @param mask Matrix describing the undefined pixels of the grid.
+/// @param first_guess Type of first guess.
+/// @param num_threads The number of threads to use for the computation.
+template <typename Type>
+void set_first_guess(pybind11::EigenDRef<Matrix<Type>>& grid,
+                     Matrix<bool>& mask, const FirstGuess first_guess,
+                     const size_t num_threads) {
+  switch (first_guess) {
+    case FirstGuess::kZero:
+      grid = (mask.array()).select(0, grid);
+      break;
+    case FirstGuess::kZonalAverage:
+      detail::set_zonal_average(grid, mask, num_threads);
+      break;
+    default:
+      throw std::invalid_argument("Invalid guess type: " +
+                                  std::to_string(first_guess));
   }
 }
 
-///  Replaces all undefined values (NaN) in a grid using the Gauss-Seidel
-///  method by relaxation.
+/// Runs the iterations of the Gauss-Seidel method on a grid whose undefined
+/// values have been replaced by a first guess.
 ///
 /// @param grid The grid to be processed
+/// @param mask Matrix describing the undefined pixels of the grid.
 /// @param is_circle True if the X axis of the grid defines a circle.
+/// @param max_iterations Maximum number of iterations to be used by relaxation.
+/// @param epsilon Tolerance for ending relaxation before the maximum number of
+/// iterations limit.
 /// @param relaxation Relaxation constant
-/// @return maximum residual value
-template <typename Type>
-auto gauss_seidel(pybind11::EigenDRef<pyinterp::Matrix<Type>>& grid,
-                  Matrix<bool>& mask, const bool is_circle,
-                  const Type relaxation, const size_t num_threads) -> Type {
-  // Maximum residual values for each thread.
-  std::vector<Type> max_residuals(num_threads);
-
-  // Shape of the grid
-  auto x_size = grid.rows();
-  auto y_size = grid.cols();
-
-  // Captures the detected exceptions in the calculation function
-  // (only the last exception captured is kept)
-  auto except = std::exception_ptr(nullptr);
-
-  // Gets the index of the pixel (ix, iy) in the matrix.
-  auto coordinates = [](const int64_t ix, const int64_t iy,
-                        const int64_t size) -> int64_t {
-    return iy * size + ix;
-  };
-
-  // Thread worker responsible for processing several strips along the y-axis
-  // of the grid.
-  //
-  // @param y_start First index y of the band to be processed.
-  // @param y_end Last index y, excluded, of the band to be processed.
-  // @param max_residual Maximum residual of this strip.
-  // @param pipe_out Last index to be processed on in this band.
-  // @param pipe_in Last index processed in the previous band.
-  auto worker = [&](int64_t y_start, int64_t y_end, Type* max_residual,
-                    std::atomic<int64_t>* pipe_out,
-                    std::atomic<int64_t>* pipe_in) -> void {
-    // Modifies the value of a masked pixel.
-    auto cell_fill = [&grid, &relaxation, &max_residual](
-                         int64_t ix0, int64_t ix, int64_t ix1, int64_t iy0,
-                         int64_t iy, int64_t iy1) {
-      auto residual = (Type(0.25) * (grid(ix0, iy) + grid(ix1, iy) +
-                                     grid(ix, iy0) + grid(ix, iy1)) -
-                       grid(ix, iy)) *
-                      relaxation;
-      grid(ix, iy) += residual;
-      *max_residual = std::max(*max_residual, std::fabs(residual));
-    };
-
-    // Initialization of the maximum value of the residuals of the treated
-    // strips.
-    *max_residual = Type(0);
-
-    try {
-      for (auto ix = 0; ix < x_size; ++ix) {
-        //
-        auto ix0 = ix == 0 ? (is_circle ? x_size - 1 : 1) : ix - 1;
-        auto ix1 = ix == x_size - 1 ? (is_circle ? 0 : x_size - 2) : ix + 1;
-
-        // If necessary, check that the last index required for this block has
-        // been processed in the previous band.
-        if (pipe_in) {
-          auto next_coordinates = coordinates(ix, y_start, y_size);
-          while (*pipe_in < next_coordinates) {
-            std::this_thread::sleep_for(std::chrono::nanoseconds(5));
-          }
-        }
+/// @param ordering Order in which the undefined values are updated.
+/// @param retire If true, the undefined values that have converged are no
+/// longer updated by the next iterations.
+/// @param callback If set, function called between the iterations.
+/// @param callback_interval Number of iterations between two calls of the
+/// callback.
+/// @param num_threads The number of threads to use for the computation.
+/// @return A tuple containing the number of iterations performed and the
+/// maximum residual value.
+template <typename Type, typename Grid>
+auto gauss_seidel_iterations(Grid& grid, const Matrix<bool>& mask,
+                             const bool is_circle, const size_t max_iterations,
+                             const Type epsilon, const Type relaxation,
+                             const Ordering ordering, const bool retire,
+                             const IterationCallback& callback,
+                             const size_t callback_interval,
+                             const size_t num_threads)
+    -> std::tuple<size_t, Type> {
+  // Initialization of the function results.
+  size_t iteration = 0;
+  Type max_residual = 0;
 
-        for (auto iy = y_start; iy < y_end; ++iy) {
-          auto iy0 = iy == 0 ? 1 : iy - 1;
-          auto iy1 = iy == y_size - 1 ? y_size - 2 : iy + 1;
-          if (mask(ix, iy)) {
-            cell_fill(ix0, ix, ix1, iy0, iy, iy1);
-          }
+  // Runs the iterations on the undefined pixels listed by the ordering.
+  auto iterate = [&](auto cells, const auto& sweep) -> void {
+    // Copy of the lists of all the undefined pixels, if they are retired.
+    auto all_cells = retire ? cells : decltype(cells)();
+    auto checking = false;
+
+    for (size_t it = 0; it < max_iterations; ++it) {
+      ++iteration;
+      auto start = std::chrono::steady_clock::now();
+      auto [residual, unconverged] = sweep(cells, retire && !checking);
+      max_residual = residual;
+
+      auto converged = max_residual < epsilon && (!retire || checking);
+      if (callback && (iteration % callback_interval == 0 || converged ||
+                       it + 1 == max_iterations)) {
+        auto elapsed = std::chrono::duration<double>(
+                           std::chrono::steady_clock::now() - start)
+                           .count();
+        if (callback(Iteration{iteration, static_cast<double>(max_residual),
+                               unconverged, elapsed})) {
+          break;
         }
-
-        // If necessary, the other thread responsible for processing the next
-        // band is notified.
-        if (pipe_out) {
-          *pipe_out = coordinates(ix, y_end, y_size);
+      }
+      if (max_residual < epsilon) {
+        if (converged) {
+          break;
         }
+        // The retired pixels are checked by an iteration over all the
+        // undefined pixels.
+        cells = all_cells;
+        checking = true;
+      } else {
+        checking = false;
       }
-    } catch (...) {
-      except = std::current_exception();
     }
   };
 
-  if (num_threads == 1) {
-    worker(0, y_size, &max_residuals[0], nullptr, nullptr);
-  } else {
-    assert(num_threads >= 2);
-    std::vector<std::atomic<int64_t>> pipeline(num_threads);
-    std::vector<std::thread> threads;
-
-    int64_t start = 0;
-    int64_t shift = y_size / num_threads;
-
-    for (auto& item : pipeline) {
-      item = std::numeric_limits<int>::min();
-    }
-
-    for (size_t index = 0; index < num_threads - 1; ++index) {
-      threads.emplace_back(std::thread(
-          worker, start, start + shift, &max_residuals[index], &pipeline[index],
-          index == 0 ? nullptr : &pipeline[index - 1]));
-      start += shift;
-    }
-    threads.emplace_back(std::thread(worker, start, y_size,
-                                     &max_residuals[num_threads - 1], nullptr,
-                                     &pipeline[num_threads - 2]));
-    for (auto&& item : threads) {
-      item.join();
-    }
-  }
-  if (except != nullptr) {
-    std::rethrow_exception(except);
+  switch (ordering) {
+    case Ordering::kLexicographic:
+      iterate(detail::math::lexicographic_cells(grid, mask, is_circle,
+                                                num_threads),
+              [&](auto& cells, const bool retired) {
+                auto scope = detail::profiling::Scope(
+                    detail::profiling::kFillGaussSeidel);
+                return detail::math::lexicographic_gauss_seidel<Type>(
+                    grid, cells, relaxation, epsilon, retired);
+              });
+      break;
+    case Ordering::kRedBlack:
+      iterate(detail::math::red_black_cells(grid, mask, is_circle),
+              [&](auto& cells, const bool retired) {
+                auto scope = detail::profiling::Scope(
+                    detail::profiling::kFillGaussSeidel);
+                return detail::math::red_black_gauss_seidel<Type>(
+                    grid, cells, relaxation, epsilon, retired, num_threads);
+              });
+      break;
+    default:
+      throw std::invalid_argument("Invalid ordering: " +
+                                  std::to_string(ordering));
   }
-  return *std::max_element(max_residuals.begin(), max_residuals.end());
+  return std::make_tuple(iteration, max_residual);
 }
 
-}  // namespace detail
-
-namespace fill {
-
-/// Type of first guess grid.
-enum FirstGuess {
-  kZero,          //!< Use 0.0 as an initial guess
-  kZonalAverage,  //!< Use zonal average in x direction
-};
-
 /// Replaces all undefined values (NaN) in a grid using the Gauss-Seidel
 /// method by relaxation.
 ///
@@ -216,6 +245,22 @@ enum FirstGuess {
 /// @param epsilon Tolerance for ending relaxation before the maximum number of
 /// iterations limit.
 /// @param relaxation Relaxation constant
+/// @param ordering Order in which the undefined values are updated. The
+/// lexicographic ordering pipelines the rows of the grid between threads,
+/// which limits the number of threads working at the same time. The red-black
+/// ordering updates all the pixels of a color in parallel, without waiting
+/// between threads, but gives slightly different results.
+/// @param retire If true, the undefined values whose residual is lower than
+/// epsilon are no longer updated by the next iterations, which speeds up the
+/// iterations when most of the values have converged. Once all the values
+/// updated have converged, a last iteration over all the undefined values
+/// checks the result; if it fails, the iterations resume from all the
+/// undefined values.
+/// @param callback If set, function called every callback_interval
+/// iterations, and after the last one, with the state of the iterations. If
+/// it returns true, the iterations are stopped.
+/// @param callback_interval Number of iterations between two calls of the
+/// callback.
 /// @param num_threads The number of threads to use for the computation. If 0
 /// all CPUs are used. If 1 is given, no parallel computing code is used at all,
 /// which is useful for debugging.
@@ -225,8 +270,14 @@ template <typename Type>
 auto gauss_seidel(pybind11::EigenDRef<Matrix<Type>>& grid,
                   const FirstGuess first_guess, const bool is_circle,
                   const size_t max_iterations, const Type epsilon,
-                  const Type relaxation, size_t num_threads)
+                  const Type relaxation, const Ordering ordering,
+                  const bool retire, const IterationCallback& callback,
+                  const size_t callback_interval, size_t num_threads)
     -> std::tuple<size_t, Type> {
+  if (callback_interval == 0) {
+    throw std::invalid_argument("callback_interval must be >= 1");
+  }
+
   /// If the grid doesn't have an undefined value, this routine has nothing more
   /// to do.
   if (!grid.hasNaN()) {
@@ -235,33 +286,363 @@ auto gauss_seidel(pybind11::EigenDRef<Matrix<Type>>& grid,
 
   /// Calculation of the maximum number of threads if the user chooses.
   if (num_threads == 0) {
-    num_threads = std::thread::hardware_concurrency();
+    num_threads = detail::get_num_threads();
   }
 
   /// Calculation of the position of the undefined values on the grid.
   auto mask = Matrix<bool>(grid.array().isNaN());
+  auto memory = detail::profiling::Allocation(
+      detail::profiling::kFillGaussSeidel,
+      static_cast<size_t>(mask.size()) * sizeof(bool));
 
   /// Calculation of the first guess with the chosen method
-  switch (first_guess) {
-    case FirstGuess::kZero:
-      grid = (mask.array()).select(0, grid);
+  set_first_guess(grid, mask, first_guess, num_threads);
+
+  return gauss_seidel_iterations<Type>(
+      grid, mask, is_circle, max_iterations, epsilon, relaxation, ordering,
+      retire, callback, callback_interval, num_threads);
+}
+
+/// Replaces all undefined values (NaN) in a tile of a grid decomposed into
+/// tiles, processed by different threads or processes, using the Gauss-Seidel
+/// method by relaxation.
+///
+/// The pixels are updated with the red-black ordering, and the halos of the
+/// tiles are exchanged after each color: the iterations perform the same
+/// computation as the red-black ordering on the whole grid. The tiles must
+/// therefore iterate together: all of them call the exchange function the
+/// same number of times, and the reduction function, if any, once per
+/// iteration.
+///
+/// @param tile The tile to be processed, surrounded by a halo of one pixel
+/// along each side.
+/// @param exchange Function writing the halo of the tile from the
+/// neighboring tiles, called after the first guess and after each color. If
+/// the X axis is a circle, the halos along the X axis are read from the other
+/// end of the grid, possibly from the tile itself. The halos on the other
+/// edges of the grid are not used.
+/// @param origin Position of the first pixel of the tile in the grid.
+/// @param shape Number of pixels of the grid along the X and Y axes.
+/// @param reduce If set, function returning the maximum residual of all the
+/// tiles from the maximum residual of this tile.
+/// @param first_guess Type of first guess, computed from the pixels of the
+/// tile.
+/// @param is_circle True if the X axis of the grid defines a circle.
+/// @param max_iterations Maximum number of iterations to be used by relaxation.
+/// @param epsilon Tolerance for ending relaxation before the maximum number of
+/// iterations limit.
+/// @param relaxation Relaxation constant
+/// @param num_threads The number of threads to use for the computation. If 0
+/// all CPUs are used. If 1 is given, no parallel computing code is used at all,
+/// which is useful for debugging.
+/// @return A tuple containing the number of iterations performed and the
+/// maximum residual value.
+template <typename Type>
+auto gauss_seidel_tile(pybind11::EigenDRef<Matrix<Type>>& tile,
+                       const HaloExchange& exchange,
+                       const std::array<int64_t, 2>& origin,
+                       const std::array<int64_t, 2>& shape,
+                       const ResidualReduction& reduce,
+                       const FirstGuess first_guess, const bool is_circle,
+                       const size_t max_iterations, const Type epsilon,
+                       const Type relaxation, size_t num_threads)
+    -> std::tuple<size_t, Type> {
+  if (!exchange) {
+    throw std::invalid_argument("the halo exchange function must be set");
+  }
+  if (tile.rows() < 3 || tile.cols() < 3) {
+    throw std::invalid_argument(
+        "the tile must hold at least one pixel surrounded by its halo");
+  }
+  const auto x_size = static_cast<int64_t>(tile.rows()) - 2;
+  const auto y_size = static_cast<int64_t>(tile.cols()) - 2;
+  if (origin[0] < 0 || origin[1] < 0 || origin[0] + x_size > shape[0] ||
+      origin[1] + y_size > shape[1] || shape[1] < 2 ||
+      (!is_circle && shape[0] < 2)) {
+    throw std::invalid_argument("the tile does not fit in the grid");
+  }
+  if (num_threads == 0) {
+    num_threads = detail::get_num_threads();
+  }
+
+  auto interior =
+      pybind11::EigenDRef<Matrix<Type>>(tile.block(1, 1, x_size, y_size));
+  auto mask = Matrix<bool>(interior.array().isNaN());
+  auto memory = detail::profiling::Allocation(
+      detail::profiling::kFillGaussSeidel,
+      static_cast<size_t>(mask.size()) * sizeof(bool));
+  set_first_guess(interior, mask, first_guess, num_threads);
+  exchange();
+
+  auto cells = detail::math::tile_cells(tile, mask, origin, shape, is_circle);
+  auto colors = detail::math::red_black_colors(shape[0], is_circle);
+  auto* data = tile.data();
+  size_t iteration = 0;
+  Type max_residual = 0;
+
+  for (size_t it = 0; it < max_iterations; ++it) {
+    ++iteration;
+    max_residual = 0;
+    for (size_t color = 0; color < colors; ++color) {
+      {
+        auto scope =
+            detail::profiling::Scope(detail::profiling::kFillGaussSeidel);
+        max_residual = std::max(
+            max_residual,
+            std::get<0>(detail::math::relax_color(
+                data, cells[color], relaxation, Type(0), false, num_threads)));
+      }
+      exchange();
+    }
+    if (reduce) {
+      max_residual = static_cast<Type>(reduce(max_residual));
+    }
+    if (max_residual < epsilon) {
       break;
-    case FirstGuess::kZonalAverage:
-      detail::set_zonal_average(grid, mask, num_threads);
+    }
+  }
+  return std::make_tuple(iteration, max_residual);
+}
+
+/// Replaces all undefined values (NaN) in a 3D grid using the Gauss-Seidel
+/// method by relaxation.
+///
+/// The layers of the grid (one per value of the Z axis) are filled
+/// independently of each other, in parallel. Each layer is relaxed by a single
+/// thread.
+///
+/// @param grid The grid to be processed
+/// @param first_guess Type of first guess.
+/// @param max_iterations Maximum number of iterations to be used by relaxation
+/// for each layer.
+/// @param epsilon Tolerance for ending relaxation before the maximum number of
+/// iterations limit.
+/// @param relaxation Relaxation constant
+/// @param ordering Order in which the undefined values are updated.
+/// @param retire If true, the undefined values that have converged are no
+/// longer updated by the next iterations.
+/// @param warm_start If true, the first guess of a layer is the solution found
+/// for the previous layer, which reduces the number of iterations if the
+/// layers are similar. The layers are then split into one contiguous block
+/// per thread, the first layer of each block being initialized with the first
+/// guess chosen.
+/// @param callback If set, function called between the iterations of each
+/// layer, from the thread processing it.
+/// @param callback_interval Number of iterations between two calls of the
+/// callback.
+/// @param num_threads The number of threads to use for the computation. If 0
+/// all CPUs are used. If 1 is given, no parallel computing code is used at all,
+/// which is useful for debugging.
+/// @return A tuple containing the grid filled, the number of iterations
+/// performed and the maximum residual value for each layer.
+template <typename Type, typename AxisType>
+auto gauss_seidel(const Grid3D<Type, AxisType>& grid,
+                  const FirstGuess first_guess, const size_t max_iterations,
+                  const Type epsilon, const Type relaxation,
+                  const Ordering ordering, const bool retire,
+                  const bool warm_start, const IterationCallback& callback,
+                  const size_t callback_interval, size_t num_threads)
+    -> std::tuple<pybind11::array_t<Type>, Vector<size_t>, Vector<Type>> {
+  if (callback_interval == 0) {
+    throw std::invalid_argument("callback_interval must be >= 1");
+  }
+  const auto x_size = grid.x()->size();
+  const auto y_size = grid.y()->size();
+  const auto z_size = grid.z()->size();
+  const auto is_circle = grid.x()->is_circle();
+  auto result = pybind11::array_t<Type>(
+      pybind11::array::ShapeContainer{x_size, y_size, z_size});
+  auto _result = result.template mutable_unchecked<3>();
+  auto iterations = Vector<size_t>(z_size);
+  auto residuals = Vector<Type>(z_size);
+
+  if (num_threads == 0) {
+    num_threads = detail::get_num_threads();
+  }
+
+  // Fills the layers [start, end) in order.
+  auto fill_layers = [&](const int64_t start, const int64_t end) {
+    auto layer = Matrix<Type>(x_size, y_size);
+    auto mask = Matrix<bool>(x_size, y_size);
+    auto view = pybind11::EigenDRef<Matrix<Type>>(layer);
+    auto memory = detail::profiling::Allocation(
+        detail::profiling::kFillGaussSeidel,
+        static_cast<size_t>(x_size * y_size) * (sizeof(Type) + sizeof(bool)));
+
+    for (auto iz = start; iz < end; ++iz) {
+      // With a warm start, the undefined values keep the solution of the
+      // previous layer.
+      const auto keep = warm_start && iz != start;
+      for (int64_t ix = 0; ix < x_size; ++ix) {
+        for (int64_t iy = 0; iy < y_size; ++iy) {
+          const auto value = grid.value(ix, iy, iz);
+          mask(ix, iy) = std::isnan(value);
+          if (!(keep && mask(ix, iy))) {
+            layer(ix, iy) = value;
+          }
+        }
+      }
+
+      iterations(iz) = 0;
+      residuals(iz) = Type(0);
+      if (mask.any()) {
+        if (!keep) {
+          set_first_guess(view, mask, first_guess, 1);
+        }
+        std::tie(iterations(iz), residuals(iz)) =
+            gauss_seidel_iterations<Type>(layer, mask, is_circle,
+                                          max_iterations, epsilon, relaxation,
+                                          ordering, retire, callback,
+                                          callback_interval, 1);
+      }
+
+      for (int64_t ix = 0; ix < x_size; ++ix) {
+        for (int64_t iy = 0; iy < y_size; ++iy) {
+          _result(ix, iy, iz) = layer(ix, iy);
+        }
+      }
+    }
+  };
+
+  {
+    pybind11::gil_scoped_release release;
+    if (warm_start) {
+      // One block of contiguous layers per thread: the result does not depend
+      // on the scheduling of the blocks.
+      const auto blocks = std::max<int64_t>(
+          std::min(z_size, static_cast<int64_t>(num_threads)), 1);
+      detail::dispatch(
+          [&](const size_t start, const size_t end) {
+            for (auto block = static_cast<int64_t>(start);
+                 block < static_cast<int64_t>(end); ++block) {
+              fill_layers(block * z_size / blocks,
+                          (block + 1) * z_size / blocks);
+            }
+          },
+          blocks, num_threads);
+    } else {
+      detail::dispatch(
+          [&](const size_t start, const size_t end) {
+            for (auto iz = static_cast<int64_t>(start);
+                 iz < static_cast<int64_t>(end); ++iz) {
+              fill_layers(iz, iz + 1);
+            }
+          },
+          z_size, num_threads, detail::kDynamic);
+    }
+  }
+  return std::make_tuple(result, iterations, residuals);
+}
+
+/// Replaces all undefined values (NaN) in a grid by solving the Laplace
+/// equation with a multigrid method.
+///
+/// Each iteration performs a V-cycle: a few Gauss-Seidel sweeps on the grid,
+/// then the correction of the remaining error on coarser grids. The number of
+/// iterations needed to reach the tolerance hardly depends on the size of the
+/// undefined areas, unlike the Gauss-Seidel method.
+///
+/// @param grid The grid to be processed
+/// @param first_guess Type of first guess.
+/// @param is_circle True if the X axis of the grid defines a circle.
+/// @param max_iterations Maximum number of V-cycles.
+/// @param epsilon Tolerance for ending the cycles before the maximum number of
+/// iterations limit: maximum change of a pixel during the last Gauss-Seidel
+/// sweep of a cycle.
+/// @param num_threads The number of threads to use for the computation. If 0
+/// all CPUs are used. If 1 is given, no parallel computing code is used at all,
+/// which is useful for debugging.
+/// @return A tuple containing the number of iterations performed and the
+/// maximum residual value.
+template <typename Type>
+auto multigrid(pybind11::EigenDRef<Matrix<Type>>& grid,
+               const FirstGuess first_guess, const bool is_circle,
+               const size_t max_iterations, const Type epsilon,
+               size_t num_threads) -> std::tuple<size_t, Type> {
+  if (!grid.hasNaN()) {
+    return std::make_tuple(0, Type(0));
+  }
+  if (num_threads == 0) {
+    num_threads = detail::get_num_threads();
+  }
+
+  auto mask = Matrix<bool>(grid.array().isNaN());
+  set_first_guess(grid, mask, first_guess, num_threads);
+
+  auto solver =
+      detail::math::Multigrid<Type>(grid, mask, is_circle, num_threads);
+  size_t iteration = 0;
+  Type max_residual = 0;
+
+  for (size_t it = 0; it < max_iterations; ++it) {
+    ++iteration;
+    {
+      auto scope = detail::profiling::Scope(detail::profiling::kFillMultigrid);
+      max_residual = solver.v_cycle(grid);
+    }
+    if (max_residual < epsilon) {
       break;
-    default:
-      throw std::invalid_argument("Invalid guess type: " +
-                                  std::to_string(first_guess));
+    }
   }
+  return std::make_tuple(iteration, max_residual);
+}
 
-  // Initialization of the function results.
+/// Replaces all undefined values (NaN) in a grid by solving the Laplace
+/// equation with the conjugate gradient method, preconditioned by a fast
+/// Poisson solver: a Fourier transform along the X axis, then a tridiagonal
+/// system along the Y axis.
+///
+/// The equation solved is the one solved by the Gauss-Seidel method, but the
+/// number of iterations needed to reach the tolerance is a few tens instead
+/// of thousands on large undefined areas. Each iteration costs a few
+/// relaxation sweeps of the whole grid.
+///
+/// @param grid The grid to be processed
+/// @param first_guess Type of first guess.
+/// @param is_circle True if the X axis of the grid defines a circle.
+/// @param max_iterations Maximum number of iterations.
+/// @param epsilon Tolerance for ending the iterations before the maximum
+/// number of iterations limit: maximum change of a pixel that a Gauss-Seidel
+/// sweep of the grid would perform.
+/// @param num_threads The number of threads to use for the computation. If 0
+/// all CPUs are used. If 1 is given, no parallel computing code is used at all,
+/// which is useful for debugging.
+/// @return A tuple containing the number of iterations performed and the
+/// maximum residual value.
+template <typename Type>
+auto spectral(pybind11::EigenDRef<Matrix<Type>>& grid,
+              const FirstGuess first_guess, const bool is_circle,
+              const size_t max_iterations, const Type epsilon,
+              size_t num_threads) -> std::tuple<size_t, Type> {
+  if (!grid.hasNaN()) {
+    return std::make_tuple(0, Type(0));
+  }
+  if (grid.cols() < 2 || (!is_circle && grid.rows() < 2)) {
+    throw std::invalid_argument(
+        "the grid must have at least two pixels along the mirrored axes");
+  }
+  if (num_threads == 0) {
+    num_threads = detail::get_num_threads();
+  }
+
+  auto mask = Matrix<bool>(grid.array().isNaN());
+  set_first_guess(grid, mask, first_guess, num_threads);
+  if (mask.all()) {
+    // Without boundary conditions, the first guess is a solution.
+    return std::make_tuple(0, Type(0));
+  }
+
+  auto solver =
+      detail::math::SpectralPoisson<Type>(grid, mask, is_circle, num_threads);
   size_t iteration = 0;
   Type max_residual = 0;
 
   for (size_t it = 0; it < max_iterations; ++it) {
     ++iteration;
-    max_residual = detail::gauss_seidel<Type>(grid, mask, is_circle, relaxation,
-                                              num_threads);
+    {
+      auto scope = detail::profiling::Scope(detail::profiling::kFillSpectral);
+      max_residual = solver.iterate(grid);
+    }
     if (max_residual < epsilon) {
       break;
     }
@@ -276,6 +657,14 @@ inline auto frame_index(const int64_t index, const int64_t size,
   // Index in the center of the window
   auto center = static_cast<int64_t>(frame.size() / 2);
 
+  // Most windows do not cross the boundaries of the axis: their indexes are
+  // consecutive.
+  auto first = index - center;
+  if (first >= 0 && first + static_cast<int64_t>(frame.size()) <= size) {
+    std::iota(frame.begin(), frame.end(), first);
+    return;
+  }
+
   for (int64_t ix = 0; ix < static_cast<int64_t>(frame.size()); ++ix) {
     auto idx = index - center + ix;
 
@@ -321,10 +710,272 @@ enum ValueType {
   kAll         //!< Smooth and fill values
 };
 
+/// Returns the tri-cube weights of the LOESS filter precomputed for the axes
+/// of a grid, or a null pointer if the distance between two pixels does not
+/// only depend on the difference of their indexes: an axis is not regular, or
+/// the window along a circle contains the same pixel twice.
+template <typename Type>
+auto loess_kernel(const Axis<double>& x_axis, const Axis<double>& y_axis,
+                  const uint32_t nx, const uint32_t ny)
+    -> std::unique_ptr<detail::math::LoessKernel<Type>> {
+  if (!x_axis.is_regular() || !y_axis.is_regular() ||
+      (x_axis.is_angle() &&
+       (!x_axis.is_circle() || static_cast<int64_t>(nx) * 2 >= x_axis.size()))) {
+    return nullptr;
+  }
+  return std::make_unique<detail::math::LoessKernel<Type>>(
+      nx, ny, x_axis.increment(), y_axis.increment());
+}
+
+/// Applies the LOESS filter to the pixels of the column ix of a grid.
+///
+/// @param x_axis X-Axis of the grid.
+/// @param y_axis Y-Axis of the grid.
+/// @param kernel Weights precomputed for the axes of the grid, or a null
+/// pointer if the weights are computed from the coordinates of the pixels.
+/// @param nx Number of points of the half-window along the X axis.
+/// @param ny Number of points of the half-window along the Y axis.
+/// @param value_type Type of values processed by the filter
+/// @param ix Index of the column processed.
+/// @param values Function returning the value of the pixel (wx, wy).
+/// @param y_stride Number of elements between two consecutive values of a
+/// column of the grid, or zero if the values of a column are not stored with
+/// a constant stride.
+/// @param store Function storing the value computed for the pixel iy.
+template <typename Type, typename Values, typename Store>
+auto loess_column(const Axis<double>& x_axis, const Axis<double>& y_axis,
+                  const detail::math::LoessKernel<Type>* kernel,
+                  const uint32_t nx, const uint32_t ny,
+                  const ValueType value_type, const int64_t ix,
+                  const Values& values, const int64_t y_stride,
+                  const Store& store) -> void {
+  auto scope = detail::profiling::Scope(detail::profiling::kFillLoess);
+  auto x_frame = std::vector<int64_t>(nx * 2 + 1);
+  auto y_frame = std::vector<int64_t>(ny * 2 + 1);
+  auto x_shift = std::vector<int64_t>(nx * 2 + 1);
+  auto x = x_axis(ix);
+
+  // We retrieve the indexes framing the current value.
+  frame_index(ix, x_axis.size(), x_axis.is_angle(), x_frame);
+
+  // Read the first value of the calculated window.
+  const auto x0 = x_axis(x_frame[0]);
+
+  // The current value is normalized to the first value in the
+  // window.
+  if (x_axis.is_angle()) {
+    x = detail::math::normalize_angle(x, x0, 360.0);
+  }
+
+  // Shift of the columns of the window relative to the current value.
+  for (size_t wx = 0; wx < x_frame.size(); ++wx) {
+    x_shift[wx] = x_axis.is_angle() ? static_cast<int64_t>(wx) - nx
+                                    : x_frame[wx] - ix;
+  }
+
+  for (int64_t iy = 0; iy < y_axis.size(); ++iy) {
+    auto z = values(ix, iy);
+
+    // If the current value is masked.
+    const auto undefined = std::isnan(z);
+    if (value_type == kAll || (value_type == kDefined && !undefined) ||
+        (value_type == kUndefined && undefined)) {
+      // Initialization of values to calculate the extrapolated
+      // value.
+      auto value = Type(0);
+      auto weight = Type(0);
+
+      if (kernel != nullptr && y_stride != 0 && iy >= ny &&
+          iy + ny < y_axis.size()) {
+        // The window does not cross the boundaries of the Y axis: the values
+        // of each column of the window are read from memory in one go.
+        for (size_t wx = 0; wx < x_frame.size(); ++wx) {
+          kernel->accumulate(x_shift[wx], &values(x_frame[wx], iy - ny),
+                             y_stride, value, weight);
+        }
+      } else if (kernel != nullptr) {
+        frame_index(iy, y_axis.size(), false, y_frame);
+        for (size_t wx = 0; wx < x_frame.size(); ++wx) {
+          for (auto wy : y_frame) {
+            auto zi = values(x_frame[wx], wy);
+            if (!std::isnan(zi)) {
+              auto wi = (*kernel)(x_shift[wx], wy - iy);
+              value += wi * zi;
+              weight += wi;
+            }
+          }
+        }
+      } else {
+        auto y = y_axis(iy);
+
+        // We retrieve the indexes framing the current value.
+        frame_index(iy, y_axis.size(), false, y_frame);
+
+        // For all the coordinates of the frame.
+        for (auto wx : x_frame) {
+          auto xi = x_axis(wx);
+
+          // We normalize the window's coordinates to its first value.
+          if (x_axis.is_angle()) {
+            xi = detail::math::normalize_angle(xi, x0, 360.0);
+          }
+
+          for (auto wy : y_frame) {
+            auto zi = values(wx, wy);
+
+            // If the value is not masked, its weight is calculated from
+            // the tri-cube weight function
+            if (!std::isnan(zi)) {
+              auto wi = detail::math::tricube(
+                  std::sqrt(detail::math::sqr(((xi - x)) / nx) +
+                            detail::math::sqr(((y_axis(wy) - y)) / ny)));
+              value += static_cast<Type>(wi * zi);
+              weight += static_cast<Type>(wi);
+            }
+          }
+        }
+      }
+
+      // Finally, we calculate the extrapolated value if possible,
+      // otherwise we will recopy the masked original value.
+      if (weight != 0) {
+        z = value / weight;
+      }
+    }
+    store(iy, z);
+  }
+}
+
+/// Computes the LOESS estimate of the pixel (ix, iy) of a grid, from the
+/// defined values of its window, as loess_column does for a whole column.
+///
+/// @param x_axis X-Axis of the grid.
+/// @param y_axis Y-Axis of the grid.
+/// @param kernel Weights precomputed for the axes of the grid, or a null
+/// pointer if the weights are computed from the coordinates of the pixels.
+/// @param nx Number of points of the half-window along the X axis.
+/// @param ny Number of points of the half-window along the Y axis.
+/// @param ix Index of the pixel along the X axis.
+/// @param iy Index of the pixel along the Y axis.
+/// @param values Function returning the value of the pixel (wx, wy).
+/// @return The estimate, or NaN if the window holds no defined value.
+template <typename Type, typename Values>
+auto loess_value(const Axis<double>& x_axis, const Axis<double>& y_axis,
+                 const detail::math::LoessKernel<Type>* kernel,
+                 const uint32_t nx, const uint32_t ny, const int64_t ix,
+                 const int64_t iy, const Values& values) -> Type {
+  auto scope = detail::profiling::Scope(detail::profiling::kFillLoess);
+  auto x_frame = std::vector<int64_t>(nx * 2 + 1);
+  auto y_frame = std::vector<int64_t>(ny * 2 + 1);
+  frame_index(ix, x_axis.size(), x_axis.is_angle(), x_frame);
+  frame_index(iy, y_axis.size(), false, y_frame);
+
+  // The coordinates of the window are normalized to its first value.
+  const auto x0 = x_axis(x_frame[0]);
+  const auto x = x_axis.is_angle()
+                     ? detail::math::normalize_angle(x_axis(ix), x0, 360.0)
+                     : x_axis(ix);
+  const auto y = y_axis(iy);
+
+  auto value = Type(0);
+  auto weight = Type(0);
+  for (size_t wx = 0; wx < x_frame.size(); ++wx) {
+    auto xi = x_axis(x_frame[wx]);
+    if (x_axis.is_angle()) {
+      xi = detail::math::normalize_angle(xi, x0, 360.0);
+    }
+    const auto x_shift = x_axis.is_angle() ? static_cast<int64_t>(wx) - nx
+                                           : x_frame[wx] - ix;
+    for (auto wy : y_frame) {
+      auto zi = static_cast<Type>(values(x_frame[wx], wy));
+      if (std::isnan(zi)) {
+        continue;
+      }
+      auto wi = kernel != nullptr
+                    ? (*kernel)(x_shift, wy - iy)
+                    : static_cast<Type>(detail::math::tricube(std::sqrt(
+                          detail::math::sqr((xi - x) / nx) +
+                          detail::math::sqr((y_axis(wy) - y) / ny))));
+      value += wi * zi;
+      weight += wi;
+    }
+  }
+  return weight != 0 ? value / weight : std::numeric_limits<Type>::quiet_NaN();
+}
+
+/// View of a 2D grid whose undefined values are replaced, when they are read,
+/// by their LOESS estimate. Only the pixels read by an interpolation are
+/// estimated, and their estimates are shared by the threads: the filled grid
+/// is never materialized.
+///
+/// @tparam Grid Type of the grid, the handle of a Grid2D, a PackedGrid2D or a
+/// TiledGrid2D.
+template <typename Grid>
+class LoessFilledGrid {
+ public:
+  /// Default constructor
+  ///
+  /// @param grid Grid read.
+  /// @param nx Number of points of the half-window along the X axis.
+  /// @param ny Number of points of the half-window along the Y axis.
+  LoessFilledGrid(const Grid& grid, const uint32_t nx, const uint32_t ny)
+      : grid_(grid), x_(&*grid.x()), y_(&*grid.y()), nx_(nx), ny_(ny) {
+    check_windows_size("nx", nx, "ny", ny);
+    kernel_ = loess_kernel<double>(*x_, *y_, nx, ny);
+  }
+
+  /// Gets the X-Axis
+  [[nodiscard]] constexpr auto x() const noexcept -> const Axis<double>* {
+    return x_;
+  }
+
+  /// Gets the Y-Axis
+  [[nodiscard]] constexpr auto y() const noexcept -> const Axis<double>* {
+    return y_;
+  }
+
+  /// Gets the value of the pixel (ix, iy), or its LOESS estimate if it is
+  /// undefined.
+  [[nodiscard]] inline auto value(const int64_t ix, const int64_t iy) const
+      -> double {
+    const auto z = static_cast<double>(grid_.value(ix, iy));
+    if (!std::isnan(z)) {
+      return z;
+    }
+    return cache_.get(static_cast<uint64_t>(ix * y_->size() + iy), [&]() {
+      return loess_value<double>(
+          *x_, *y_, kernel_.get(), nx_, ny_, ix, iy,
+          [this](const int64_t wx, const int64_t wy) -> double {
+            return static_cast<double>(grid_.value(wx, wy));
+          });
+    });
+  }
+
+  /// The coefficients precomputed for the grid are not used: they are
+  /// undefined around the undefined values.
+  [[nodiscard]] inline auto bicubic_coefficients() const noexcept
+      -> std::shared_ptr<const detail::math::BicubicCoefficients> {
+    return nullptr;
+  }
+
+ private:
+  const Grid& grid_;
+  const Axis<double>* x_;
+  const Axis<double>* y_;
+  uint32_t nx_;
+  uint32_t ny_;
+  std::unique_ptr<detail::math::LoessKernel<double>> kernel_{};
+  /// Estimates of the undefined pixels already read.
+  mutable detail::MemoCache<double> cache_{};
+};
+
 /// Fills undefined values using a locally weighted regression function or
 /// LOESS. The weight function used for LOESS is the tri-cube weight
 /// function, w(x)=(1-|d|^{3})^{3}
 ///
+/// If the axes of the grid are regular, the weights of the window are
+/// computed once for all the pixels of the grid.
+///
 /// @param grid Grid Function on a uniform 2-dimensional grid to be filled.
 /// @param nx Number of points of the half-window to be taken into account
 /// along the longitude axis.
@@ -335,103 +986,43 @@ enum ValueType {
 /// 0 all CPUs are used. If 1 is given, no parallel computing code is used
 /// at all, which is useful for debugging.
 /// @return The grid will have all the NaN filled with extrapolated values.
-template <typename Type>
-auto loess(const Grid2D<Type>& grid, const uint32_t nx, const uint32_t ny,
-           const ValueType value_type, const size_t num_threads)
+/// @tparam Grid Type of the grid, either a Grid2D or a TiledGrid2D.
+template <typename Type, typename Grid>
+auto loess_2d(const Grid& grid, const uint32_t nx, const uint32_t ny,
+              const ValueType value_type, const size_t num_threads)
     -> pybind11::array_t<Type> {
   check_windows_size("nx", nx, "ny", ny);
   auto result = pybind11::array_t<Type>(
       pybind11::array::ShapeContainer{grid.x()->size(), grid.y()->size()});
   auto _result = result.template mutable_unchecked<2>();
+  const auto kernel = loess_kernel<Type>(*grid.x(), *grid.y(), nx, ny);
 
-  // Captures the detected exceptions in the calculation function
-  // (only the last exception captured is kept)
-  auto except = std::exception_ptr(nullptr);
+  // The columns of a tiled grid are not contiguous in memory: their values
+  // are read one by one.
+  auto y_stride = int64_t(0);
+  if constexpr (std::is_same_v<Grid, Grid2D<Type>>) {
+    y_stride = static_cast<int64_t>(grid.array().strides(1) / sizeof(Type));
+  }
 
   auto worker = [&](const size_t start, const size_t end) {
-    try {
-      // Access to the shared pointer outside the loop to avoid data races
-      const auto& x_axis = *grid.x();
-      const auto& y_axis = *grid.y();
-      auto x_frame = std::vector<int64_t>(nx * 2 + 1);
-      auto y_frame = std::vector<int64_t>(ny * 2 + 1);
-
-      for (size_t ix = start; ix < end; ++ix) {
-        auto x = x_axis(ix);
-
-        // We retrieve the indexes framing the current value.
-        frame_index(ix, x_axis.size(), x_axis.is_angle(), x_frame);
-
-        // Read the first value of the calculated window.
-        const auto x0 = x_axis(x_frame[0]);
-
-        // The current value is normalized to the first value in the
-        // window.
-        if (x_axis.is_angle()) {
-          x = detail::math::normalize_angle(x, x0, 360.0);
-        }
-
-        for (int64_t iy = 0; iy < y_axis.size(); ++iy) {
-          auto z = grid.value(ix, iy);
-
-          // If the current value is masked.
-          const auto undefined = std::isnan(z);
-          if (value_type == kAll || (value_type == kDefined && !undefined) ||
-              (value_type == kUndefined && undefined)) {
-            auto y = y_axis(iy);
-
-            // We retrieve the indexes framing the current value.
-            frame_index(iy, y_axis.size(), false, y_frame);
-
-            // Initialization of values to calculate the extrapolated
-            // value.
-            auto value = Type(0);
-            auto weight = Type(0);
-
-            // For all the coordinates of the frame.
-            for (auto wx : x_frame) {
-              auto xi = x_axis(wx);
-
-              // We normalize the window's coordinates to its first value.
-              if (x_axis.is_angle()) {
-                xi = detail::math::normalize_angle(xi, x0, 360.0);
-              }
-
-              for (auto wy : y_frame) {
-                auto zi = grid.value(wx, wy);
-
-                // If the value is not masked, its weight is calculated from
-                // the tri-cube weight function
-                if (!std::isnan(zi)) {
-                  const auto power = 3.0;
-                  auto d =
-                      std::sqrt(detail::math::sqr(((xi - x)) / nx) +
-                                detail::math::sqr(((y_axis(wy) - y)) / ny));
-                  auto wi = d <= 1 ? std::pow((1.0 - std::pow(d, power)), power)
-                                   : 0.0;
-                  value += static_cast<Type>(wi * zi);
-                  weight += static_cast<Type>(wi);
-                }
-              }
-            }
-
-            // Finally, we calculate the extrapolated value if possible,
-            // otherwise we will recopy the masked original value.
-            if (weight != 0) {
-              z = value / weight;
-            }
-          }
-          _result(ix, iy) = z;
-        }
-      }
-    } catch (...) {
-      except = std::current_exception();
+    const auto& x_axis = *grid.x();
+    const auto& y_axis = *grid.y();
+
+    for (size_t ix = start; ix < end; ++ix) {
+      loess_column(
+          x_axis, y_axis, kernel.get(), nx, ny, value_type, ix,
+          [&](const int64_t wx, const int64_t wy) -> const Type& {
+            return grid.value(wx, wy);
+          },
+          y_stride,
+          [&](const int64_t iy, const Type z) { _result(ix, iy) = z; });
     }
   };
 
   {
     pybind11::gil_scoped_release release;
-    detail::dispatch(worker, grid.x()->size(), num_threads);
+    detail::dispatch(worker, grid.x()->size(), num_threads,
+                     detail::kDynamic);
   }
   return result;
 }
@@ -444,98 +1035,306 @@ auto loess(const Grid3D<Type, AxisType>& grid, const uint32_t nx,
   auto result = pybind11::array_t<Type>(pybind11::array::ShapeContainer{
       grid.x()->size(), grid.y()->size(), grid.z()->size()});
   auto _result = result.template mutable_unchecked<3>();
-
-  // Captures the detected exceptions in the calculation function
-  // (only the last exception captured is kept)
-  auto except = std::exception_ptr(nullptr);
+  const auto kernel = loess_kernel<Type>(*grid.x(), *grid.y(), nx, ny);
+  const auto y_stride =
+      static_cast<int64_t>(grid.array().strides(1) / sizeof(Type));
 
   auto worker = [&](const size_t start, const size_t end) {
-    try {
-      // Access to the shared pointer outside the loop to avoid data races
-      const auto& x_axis = *grid.x();
-      const auto& y_axis = *grid.y();
-      auto x_frame = std::vector<int64_t>(nx * 2 + 1);
-      auto y_frame = std::vector<int64_t>(ny * 2 + 1);
-
-      for (size_t iz = start; iz < end; ++iz) {
-        for (int64_t ix = 0; ix < x_axis.size(); ++ix) {
-          auto x = x_axis(ix);
+    const auto& x_axis = *grid.x();
+    const auto& y_axis = *grid.y();
+
+    for (size_t iz = start; iz < end; ++iz) {
+      for (int64_t ix = 0; ix < x_axis.size(); ++ix) {
+        loess_column(
+            x_axis, y_axis, kernel.get(), nx, ny, value_type, ix,
+            [&](const int64_t wx, const int64_t wy) -> const Type& {
+              return grid.value(wx, wy, iz);
+            },
+            y_stride,
+            [&](const int64_t iy, const Type z) { _result(ix, iy, iz) = z; });
+      }
+    }
+  };
 
-          // We retrieve the indexes framing the current value.
-          frame_index(ix, x_axis.size(), x_axis.is_angle(), x_frame);
+  {
+    pybind11::gil_scoped_release release;
+    detail::dispatch(worker, grid.z()->size(), num_threads,
+                     detail::kDynamic);
+  }
+  return result;
+}
 
-          // Read the first value of the calculated window.
-          const auto x0 = x_axis(x_frame[0]);
+/// Windows of the LOESS filter along an axis: for each pixel of the axis,
+/// the indexes of the pixels of its window, and their distances to this
+/// pixel, normalized by the half size of the window.
+struct LoessWindows {
+  /// Number of pixels of a window
+  int64_t size;
+  /// Indexes of the pixels of the windows, stored window after window.
+  std::vector<int64_t> index;
+  /// Normalized distances of the pixels of the windows.
+  std::vector<double> distance;
+};
 
-          // The current value is normalized to the first value in the
-          // window.
-          if (x_axis.is_angle()) {
-            x = detail::math::normalize_angle(x, x0, 360.0);
-          }
+/// Computes the windows of the LOESS filter along an axis.
+///
+/// @param size Number of pixels of the axis.
+/// @param half Number of points of the half-window.
+/// @param is_angle True if the windows wrap around the axis.
+/// @param distance Function returning the distance distance(i, j, x0)
+/// between the pixels i and j, x0 being the index of the first pixel of the
+/// window of i.
+template <typename Distance>
+auto loess_windows(const int64_t size, const uint32_t half,
+                   const bool is_angle, const Distance& distance)
+    -> LoessWindows {
+  auto result = LoessWindows{static_cast<int64_t>(half) * 2 + 1, {}, {}};
+  result.index.resize(size * result.size);
+  result.distance.resize(size * result.size);
+  auto frame = std::vector<int64_t>(result.size);
+  for (int64_t ix = 0; ix < size; ++ix) {
+    frame_index(ix, size, is_angle, frame);
+    for (int64_t kx = 0; kx < result.size; ++kx) {
+      result.index[ix * result.size + kx] = frame[kx];
+      result.distance[ix * result.size + kx] =
+          distance(ix, frame[kx], frame[0]) / half;
+    }
+  }
+  return result;
+}
 
-          for (int64_t iy = 0; iy < y_axis.size(); ++iy) {
-            auto z = grid.value(ix, iy, iz);
+/// Computes the windows of the LOESS filter along the X or Y axis of a
+/// grid: the distances are computed from the coordinates of the pixels.
+inline auto loess_windows(const Axis<double>& axis, const uint32_t half)
+    -> LoessWindows {
+  return loess_windows(
+      axis.size(), half, axis.is_angle(),
+      [&axis](const int64_t ix, const int64_t jx, const int64_t x0) {
+        if (!axis.is_angle()) {
+          return axis(jx) - axis(ix);
+        }
+        // The coordinates of the window are normalized to its first value.
+        const auto origin = axis(x0);
+        return detail::math::normalize_angle(axis(jx), origin, 360.0) -
+               detail::math::normalize_angle(axis(ix), origin, 360.0);
+      });
+}
 
-            // If the current value is masked.
-            const auto undefined = std::isnan(z);
-            if (value_type == kAll || (value_type == kDefined && !undefined) ||
-                (value_type == kUndefined && undefined)) {
-              auto y = y_axis(iy);
+/// Windows of the spatio-temporal LOESS filter of a 3D grid.
+struct LoessWindows3D {
+  /// Windows along the X axis
+  LoessWindows x;
+  /// Windows along the Y axis
+  LoessWindows y;
+  /// Windows along the Z axis
+  LoessWindows z;
+};
 
-              // We retrieve the indexes framing the current value.
-              frame_index(iy, y_axis.size(), false, y_frame);
+/// Sums the windows of the pixels processed by the spatio-temporal LOESS
+/// filter, whose weights are the tri-cube weights of the distances to the
+/// pixels, in parallel over the (X, Z) columns of the grid.
+template <typename Type, typename AxisType, typename Processed>
+auto loess_3d_direct(const Grid3D<Type, AxisType>& grid,
+                     const LoessWindows3D& windows, const Processed& processed,
+                     Type* result, const size_t num_threads) -> void {
+  const auto y_size = grid.y()->size();
+  const auto z_size = grid.z()->size();
+  const auto& x_windows = windows.x;
+  const auto& y_windows = windows.y;
+  const auto& z_windows = windows.z;
 
-              // Initialization of values to calculate the extrapolated
-              // value.
+  detail::dispatch(
+      [&](const size_t start, const size_t end) {
+        auto scope = detail::profiling::Scope(detail::profiling::kFillLoess);
+        for (auto item = start; item < end; ++item) {
+          const auto ix = static_cast<int64_t>(item) / z_size;
+          const auto iz = static_cast<int64_t>(item) % z_size;
+          const auto* wx = &x_windows.index[ix * x_windows.size];
+          const auto* dx = &x_windows.distance[ix * x_windows.size];
+          const auto* wz = &z_windows.index[iz * z_windows.size];
+          const auto* dz = &z_windows.distance[iz * z_windows.size];
+          for (int64_t iy = 0; iy < y_size; ++iy) {
+            auto z = grid.value(ix, iy, iz);
+            if (processed(z)) {
+              const auto* wy = &y_windows.index[iy * y_windows.size];
+              const auto* dy = &y_windows.distance[iy * y_windows.size];
               auto value = Type(0);
               auto weight = Type(0);
-
-              // For all the coordinates of the frame.
-              for (auto wx : x_frame) {
-                auto xi = x_axis(wx);
-
-                // We normalize the window's coordinates to its first value.
-                if (x_axis.is_angle()) {
-                  xi = detail::math::normalize_angle(xi, x0, 360.0);
-                }
-
-                for (auto wy : y_frame) {
-                  auto zi = grid.value(wx, wy, iz);
-
-                  // If the value is not masked, its weight is calculated
-                  // from the tri-cube weight function
-                  if (!std::isnan(zi)) {
-                    const auto power = 3.0;
-                    auto d =
-                        std::sqrt(detail::math::sqr(((xi - x)) / nx) +
-                                  detail::math::sqr(((y_axis(wy) - y)) / ny));
-                    auto wi = d <= 1
-                                  ? std::pow((1.0 - std::pow(d, power)), power)
-                                  : 0.0;
-                    value += static_cast<Type>(wi * zi);
-                    weight += static_cast<Type>(wi);
+              for (int64_t kx = 0; kx < x_windows.size; ++kx) {
+                for (int64_t ky = 0; ky < y_windows.size; ++ky) {
+                  const auto dxy =
+                      detail::math::sqr(dx[kx]) + detail::math::sqr(dy[ky]);
+                  for (int64_t kz = 0; kz < z_windows.size; ++kz) {
+                    const auto zi = grid.value(wx[kx], wy[ky], wz[kz]);
+                    if (!std::isnan(zi)) {
+                      const auto wi = static_cast<Type>(detail::math::tricube(
+                          std::sqrt(dxy + detail::math::sqr(dz[kz]))));
+                      value += wi * zi;
+                      weight += wi;
+                    }
                   }
                 }
               }
-
-              // Finally, we calculate the extrapolated value if possible,
-              // otherwise we will recopy the masked original value.
               if (weight != 0) {
                 z = value / weight;
               }
             }
-            _result(ix, iy, iz) = z;
+            result[(ix * y_size + iy) * z_size + iz] = z;
           }
         }
-      }
-    } catch (...) {
-      except = std::current_exception();
-    }
+      },
+      static_cast<size_t>(grid.x()->size() * z_size), num_threads,
+      detail::kDynamic);
+}
+
+/// Applies the separable spatio-temporal LOESS filter, whose weights are the
+/// products of the tri-cube weights of the distances along each axis. The
+/// weighted sums of the windows are computed by three passes of 1D filters,
+/// along Z, Y and X: the partial sums of a pass are shared by all the
+/// windows containing them.
+template <typename Type, typename AxisType, typename Processed>
+auto loess_3d_separable(const Grid3D<Type, AxisType>& grid,
+                        const LoessWindows3D& windows,
+                        const Processed& processed, Type* result,
+                        const size_t num_threads) -> void {
+  const auto x_size = grid.x()->size();
+  const auto y_size = grid.y()->size();
+  const auto z_size = grid.z()->size();
+  const auto columns = static_cast<size_t>(x_size * y_size);
+
+  // Weighted sums of the values, and sums of the weights, of the defined
+  // pixels, updated in place by each pass. The undefined pixels contribute
+  // to neither.
+  auto values = std::vector<Type>(columns * z_size);
+  auto weights = std::vector<Type>(columns * z_size);
+  detail::dispatch(
+      [&](const size_t start, const size_t end) {
+        for (auto item = start; item < end; ++item) {
+          const auto ix = static_cast<int64_t>(item) / y_size;
+          const auto iy = static_cast<int64_t>(item) % y_size;
+          for (int64_t iz = 0; iz < z_size; ++iz) {
+            const auto z = grid.value(ix, iy, iz);
+            const auto defined = !std::isnan(z);
+            values[item * z_size + iz] = defined ? z : Type(0);
+            weights[item * z_size + iz] = defined ? Type(1) : Type(0);
+          }
+        }
+      },
+      columns, num_threads);
+
+  // Applies the 1D filter of an axis to the lines of the partial sums. The
+  // line item starts at the offset first(item), its pixels being separated
+  // by stride.
+  auto pass = [&](const LoessWindows& axis_windows, const int64_t lines,
+                  const int64_t stride, const auto& first) {
+    const auto length = static_cast<int64_t>(axis_windows.index.size()) /
+                        axis_windows.size;
+    auto kernel = std::vector<Type>(axis_windows.distance.size());
+    std::transform(axis_windows.distance.begin(), axis_windows.distance.end(),
+                   kernel.begin(), [](const double d) {
+                     return static_cast<Type>(detail::math::tricube(d));
+                   });
+    detail::dispatch(
+        [&](const size_t start, const size_t end) {
+          auto scope = detail::profiling::Scope(detail::profiling::kFillLoess);
+          auto line_values = std::vector<Type>(length);
+          auto line_weights = std::vector<Type>(length);
+          for (auto item = start; item < end; ++item) {
+            auto* value = values.data() + first(static_cast<int64_t>(item));
+            auto* weight = weights.data() + first(static_cast<int64_t>(item));
+            for (int64_t ix = 0; ix < length; ++ix) {
+              const auto* index = &axis_windows.index[ix * axis_windows.size];
+              const auto* wi = &kernel[ix * axis_windows.size];
+              auto sum_values = Type(0);
+              auto sum_weights = Type(0);
+              for (int64_t kx = 0; kx < axis_windows.size; ++kx) {
+                sum_values += wi[kx] * value[index[kx] * stride];
+                sum_weights += wi[kx] * weight[index[kx] * stride];
+              }
+              line_values[ix] = sum_values;
+              line_weights[ix] = sum_weights;
+            }
+            for (int64_t ix = 0; ix < length; ++ix) {
+              value[ix * stride] = line_values[ix];
+              weight[ix * stride] = line_weights[ix];
+            }
+          }
+        },
+        static_cast<size_t>(lines), num_threads);
+  };
+
+  // Along Z, for each (X, Y) column.
+  pass(windows.z, x_size * y_size, 1,
+       [z_size](const int64_t item) { return item * z_size; });
+  // Along Y, for each (X, Z) column.
+  pass(windows.y, x_size * z_size, z_size,
+       [y_size, z_size](const int64_t item) {
+         return (item / z_size) * y_size * z_size + item % z_size;
+       });
+  // Along X, for each (Y, Z) column.
+  pass(windows.x, y_size * z_size, y_size * z_size,
+       [](const int64_t item) { return item; });
+
+  detail::dispatch(
+      [&](const size_t start, const size_t end) {
+        for (auto item = start; item < end; ++item) {
+          const auto ix = static_cast<int64_t>(item) / y_size;
+          const auto iy = static_cast<int64_t>(item) % y_size;
+          for (int64_t iz = 0; iz < z_size; ++iz) {
+            const auto offset = item * z_size + iz;
+            auto z = grid.value(ix, iy, iz);
+            if (processed(z) && weights[offset] != 0) {
+              z = values[offset] / weights[offset];
+            }
+            result[offset] = z;
+          }
+        }
+      },
+      columns, num_threads);
+}
+
+/// Spatio-temporal LOESS filter of a 3D grid: the window of each pixel
+/// extends along the X, Y and Z axes, the latter being for example a time
+/// axis.
+///
+/// The distances along the X and Y axes are computed from the coordinates
+/// of the pixels, as done by loess; the distance along the Z axis is the
+/// number of steps between the pixels.
+///
+/// @param separable If true, the weight of a pixel of the window is the
+/// product of the tri-cube weights of its distances along each axis, and the
+/// cost per pixel is proportional to nx + ny + nz instead of nx * ny * nz.
+/// Otherwise, the weight is the tri-cube weight of the distance to the pixel.
+template <typename Type, typename AxisType>
+auto loess_3d(const Grid3D<Type, AxisType>& grid, const uint32_t nx,
+              const uint32_t ny, const uint32_t nz, const ValueType value_type,
+              const bool separable, const size_t num_threads)
+    -> pybind11::array_t<Type> {
+  check_windows_size("nx", nx, "ny", ny, "nz", nz);
+  auto result = pybind11::array_t<Type>(pybind11::array::ShapeContainer{
+      grid.x()->size(), grid.y()->size(), grid.z()->size()});
+  auto* _result = result.mutable_data();
+
+  // Returns true if the pixel is processed by the filter.
+  auto processed = [value_type](const Type z) {
+    const auto undefined = std::isnan(z);
+    return value_type == kAll || (value_type == kDefined && !undefined) ||
+           (value_type == kUndefined && undefined);
   };
 
   {
     pybind11::gil_scoped_release release;
-    detail::dispatch(worker, grid.z()->size(), num_threads);
+    const auto windows = LoessWindows3D{
+        loess_windows(*grid.x(), nx), loess_windows(*grid.y(), ny),
+        loess_windows(grid.z()->size(), nz, false,
+                      [](const int64_t iz, const int64_t jz, const int64_t) {
+                        return static_cast<double>(jz - iz);
+                      })};
+    if (separable) {
+      loess_3d_separable(grid, windows, processed, _result, num_threads);
+    } else {
+      loess_3d_direct(grid, windows, processed, _result, num_threads);
+    }
   }
   return result;
 }
@@ -5,9 +5,11 @@
 #include <Eigen/Core>
 #include <cstdint>
 #include <string>
+#include <tuple>
 
 #include "pyinterp/axis.hpp"
 #include "pyinterp/detail/math/frame.hpp"
+#include "pyinterp/detail/profiling.hpp"
 #include "pyinterp/grid.hpp"
 
 namespace pyinterp {
@@ -20,79 +22,149 @@ auto index_error(const std::string& axis, const std::string& value, size_t n)
                               " axis");
 }
 
-/// Loads the interpolation frame into memory
-template <typename DataType>
-auto load_frame(const Grid2D<DataType>& grid, const double x, const double y,
+/// Stores into "indexes" the window of grid elements framing the coordinate
+/// on the axis, unless the buffer already holds the window framing the same
+/// cell.
+///
+/// @param axis Axis to search.
+/// @param coordinate Coordinate to frame.
+/// @param boundary How to handle boundaries.
+/// @param reuse True if the buffer holds the window of the last point loaded.
+/// @param indexes Buffer of size "2*n" receiving the indexes of the window.
+/// @param updated Set to true if the buffer has been modified.
+/// @return false if the coordinate cannot be framed.
+/// @tparam Indexes Type of the buffer, a dynamic or a fixed-size vector.
+template <typename T, typename Indexes>
+auto update_indexes(const detail::Axis<T>& axis, const T coordinate,
+                    const axis::Boundary boundary, const bool reuse,
+                    Indexes& indexes, bool& updated) -> bool {
+  const auto size = static_cast<uint32_t>(indexes.size() >> 1);
+  const auto cell = axis.find_indexes(coordinate);
+  if (!cell) {
+    return false;
+  }
+  if (reuse && std::get<0>(*cell) == indexes[size - 1] &&
+      std::get<1>(*cell) == indexes[size]) {
+    return true;
+  }
+  updated = true;
+  return axis.window_indexes(*cell, size, boundary, indexes.data());
+}
+
+/// Loads the interpolation frame into memory. The indexes of the grid
+/// elements are stored in the frame, so that the values are not read again if
+/// the next point processed falls in the same cell.
+///
+/// @tparam Grid Type of the grid, a Grid2D, a PackedGrid2D or a
+/// TiledGrid2D.
+/// @tparam XSize Number of values of the window along the x-axis, or
+/// Eigen::Dynamic. The loops reading the fixed-size windows are unrolled.
+/// @tparam YSize Number of values of the window along the y-axis.
+template <typename Grid, int XSize, int YSize>
+auto load_frame(const Grid& grid, const double x, const double y,
                 const axis::Boundary boundary, const bool bounds_error,
-                detail::math::Frame2D& frame) -> bool {
+                detail::math::Frame2D<XSize, YSize>& frame) -> bool {
+  auto scope = detail::profiling::Scope(detail::profiling::kLoadFrame);
   const auto& x_axis = *grid.x();
   const auto& y_axis = *grid.y();
-  const auto y_indexes =
-      y_axis.find_indexes(y, static_cast<uint32_t>(frame.ny()), boundary);
-  const auto x_indexes =
-      x_axis.find_indexes(x, static_cast<uint32_t>(frame.nx()), boundary);
+  auto& x_indexes = frame.x_indexes();
+  auto& y_indexes = frame.y_indexes();
+  auto reuse = frame.is_loaded();
+  auto updated = false;
 
-  if (x_indexes.empty() || y_indexes.empty()) {
+  // The buffers are modified as soon as a window is searched.
+  frame.is_loaded(false);
+  if (!update_indexes(x_axis, x, boundary, reuse, x_indexes, updated)) {
+    if (bounds_error) {
+      index_error("x", x_axis.coordinate_repr(x), frame.nx());
+    }
+    return false;
+  }
+  if (!update_indexes(y_axis, y, boundary, reuse, y_indexes, updated)) {
     if (bounds_error) {
-      if (x_indexes.empty()) {
-        index_error("x", x_axis.coordinate_repr(x), frame.nx());
-      }
       index_error("y", y_axis.coordinate_repr(y), frame.ny());
     }
     return false;
   }
+  frame.is_loaded(true);
+  frame.is_updated(updated);
+  if (!updated) {
+    return frame.is_valid();
+  }
 
   auto x0 = x_axis(x_indexes[0]);
 
-  for (Eigen::Index jx = 0; jx < frame.y()->size(); ++jx) {
+  for (Eigen::Index jx = 0; jx < frame.y_values().size(); ++jx) {
     frame.y(jx) = y_axis(y_indexes[jx]);
   }
 
-  for (Eigen::Index ix = 0; ix < frame.x()->size(); ++ix) {
+  for (Eigen::Index ix = 0; ix < frame.x_values().size(); ++ix) {
     const auto index = x_indexes[ix];
 
     frame.x(ix) = x_axis.is_angle()
                       ? detail::math::normalize_angle(x_axis(index), x0, 360.0)
                       : x_axis(index);
 
-    for (Eigen::Index jx = 0; jx < frame.y()->size(); ++jx) {
+    for (Eigen::Index jx = 0; jx < frame.y_values().size(); ++jx) {
       frame.q(ix, jx) = static_cast<double>(grid.value(index, y_indexes[jx]));
     }
   }
   return frame.is_valid();
 }
 
-/// Loads the interpolation frame into memory
-template <typename DataType, typename AxisType>
-auto load_frame(const Grid3D<DataType, AxisType>& grid, const double x,
-                const double y, const AxisType z, const axis::Boundary boundary,
-                const bool bounds_error, detail::math::Frame3D<AxisType>& frame)
-    -> bool {
+/// Loads the interpolation frame into memory. The indexes of the grid
+/// elements are stored in the frame, so that the values are not read again if
+/// the next point processed falls in the same cell.
+///
+/// @tparam Grid Type of the grid, or of the accessor reading a chunked grid.
+/// @tparam XSize Number of values of the window along the x-axis, or
+/// Eigen::Dynamic.
+/// @tparam YSize Number of values of the window along the y-axis.
+template <typename DataType, typename AxisType, typename Grid, int XSize,
+          int YSize>
+auto load_frame(const Grid& grid, const double x, const double y,
+                const AxisType z, const axis::Boundary boundary,
+                const bool bounds_error,
+                detail::math::Frame3D<AxisType, XSize, YSize>& frame) -> bool {
+  auto scope = detail::profiling::Scope(detail::profiling::kLoadFrame);
   const auto& x_axis = *grid.x();
   const auto& y_axis = *grid.y();
   const auto& z_axis = *grid.z();
-  const auto z_indexes =
-      z_axis.find_indexes(z, static_cast<uint32_t>(frame.nz()), boundary);
-  const auto y_indexes =
-      y_axis.find_indexes(y, static_cast<uint32_t>(frame.ny()), boundary);
-  const auto x_indexes =
-      x_axis.find_indexes(x, static_cast<uint32_t>(frame.nx()), boundary);
-
-  if (x_indexes.empty() || y_indexes.empty() || z_indexes.empty()) {
+  auto& x_indexes = frame.x_indexes();
+  auto& y_indexes = frame.y_indexes();
+  auto& z_indexes = frame.z_indexes();
+  auto reuse = frame.is_loaded();
+  auto updated = false;
+
+  // The buffers are modified as soon as a window is searched.
+  frame.is_loaded(false);
+  if (!update_indexes(x_axis, x, boundary, reuse, x_indexes, updated)) {
+    if (bounds_error) {
+      index_error("x", x_axis.coordinate_repr(x), frame.nx());
+    }
+    return false;
+  }
+  if (!update_indexes(y_axis, y, boundary, reuse, y_indexes, updated)) {
+    if (bounds_error) {
+      index_error("y", y_axis.coordinate_repr(y), frame.ny());
+    }
+    return false;
+  }
+  if (!update_indexes(z_axis, z, boundary, reuse, z_indexes, updated)) {
     if (bounds_error) {
-      if (x_indexes.empty()) {
-        index_error("x", x_axis.coordinate_repr(x), frame.nx());
-      } else if (y_indexes.empty()) {
-        index_error("y", y_axis.coordinate_repr(y), frame.ny());
-      }
       index_error("z", z_axis.coordinate_repr(z), frame.nz());
     }
     return false;
   }
+  frame.is_loaded(true);
+  frame.is_updated(updated);
+  if (!updated) {
+    return frame.is_valid();
+  }
 
   auto x0 = x_axis(x_indexes[0]);
 
-  for (Eigen::Index jx = 0; jx < frame.y()->size(); ++jx) {
+  for (Eigen::Index jx = 0; jx < frame.y_values().size(); ++jx) {
     frame.y(jx) = y_axis(y_indexes[jx]);
   }
 
@@ -100,14 +172,14 @@ auto load_frame(const Grid3D<DataType, AxisType>& grid, const double x,
     frame.z(kx) = z_axis(z_indexes[kx]);
   }
 
-  for (Eigen::Index ix = 0; ix < frame.x()->size(); ++ix) {
+  for (Eigen::Index ix = 0; ix < frame.x_values().size(); ++ix) {
     const auto x_index = x_indexes[ix];
 
     frame.x(ix) = x_axis.is_angle() ? detail::math::normalize_angle(
                                           x_axis(x_index), x0, 360.0)
                                     : x_axis(x_index);
 
-    for (Eigen::Index jx = 0; jx < frame.y()->size(); ++jx) {
+    for (Eigen::Index jx = 0; jx < frame.y_values().size(); ++jx) {
       const auto y_index = y_indexes[jx];
 
       for (Eigen::Index kx = 0; kx < frame.z().size(); ++kx) {
@@ -119,43 +191,63 @@ auto load_frame(const Grid3D<DataType, AxisType>& grid, const double x,
   return frame.is_valid();
 }
 
-/// Loads the interpolation frame into memory
-template <typename DataType, typename AxisType>
-auto load_frame(const Grid4D<DataType, AxisType>& grid, const double x,
-                const double y, const AxisType z, const double u,
+/// Loads the interpolation frame into memory. The indexes of the grid
+/// elements are stored in the frame, so that the values are not read again if
+/// the next point processed falls in the same cell.
+///
+/// @tparam Grid Type of the grid, or of the accessor reading a chunked grid.
+template <typename DataType, typename AxisType, typename Grid>
+auto load_frame(const Grid& grid, const double x, const double y,
+                const AxisType z, const double u,
                 const axis::Boundary boundary, const bool bounds_error,
                 detail::math::Frame4D<AxisType>& frame) -> bool {
+  auto scope = detail::profiling::Scope(detail::profiling::kLoadFrame);
   const auto& x_axis = *grid.x();
   const auto& y_axis = *grid.y();
   const auto& z_axis = *grid.z();
   const auto& u_axis = *grid.u();
-  const auto u_indexes =
-      u_axis.find_indexes(u, static_cast<uint32_t>(frame.nu()), boundary);
-  const auto z_indexes =
-      z_axis.find_indexes(z, static_cast<uint32_t>(frame.nz()), boundary);
-  const auto y_indexes =
-      y_axis.find_indexes(y, static_cast<uint32_t>(frame.ny()), boundary);
-  const auto x_indexes =
-      x_axis.find_indexes(x, static_cast<uint32_t>(frame.nx()), boundary);
-
-  if (x_indexes.empty() || y_indexes.empty() || z_indexes.empty() ||
-      u_indexes.empty()) {
+  auto& x_indexes = frame.x_indexes();
+  auto& y_indexes = frame.y_indexes();
+  auto& z_indexes = frame.z_indexes();
+  auto& u_indexes = frame.u_indexes();
+  auto reuse = frame.is_loaded();
+  auto updated = false;
+
+  // The buffers are modified as soon as a window is searched.
+  frame.is_loaded(false);
+  if (!update_indexes(x_axis, x, boundary, reuse, x_indexes, updated)) {
+    if (bounds_error) {
+      index_error("x", x_axis.coordinate_repr(x), frame.nx());
+    }
+    return false;
+  }
+  if (!update_indexes(y_axis, y, boundary, reuse, y_indexes, updated)) {
+    if (bounds_error) {
+      index_error("y", y_axis.coordinate_repr(y), frame.ny());
+    }
+    return false;
+  }
+  if (!update_indexes(z_axis, z, boundary, reuse, z_indexes, updated)) {
+    if (bounds_error) {
+      index_error("z", z_axis.coordinate_repr(z), frame.nz());
+    }
+    return false;
+  }
+  if (!update_indexes(u_axis, u, boundary, reuse, u_indexes, updated)) {
     if (bounds_error) {
-      if (x_indexes.empty()) {
-        index_error("x", x_axis.coordinate_repr(x), frame.nx());
-      } else if (y_indexes.empty()) {
-        index_error("y", y_axis.coordinate_repr(y), frame.ny());
-      } else if (z_indexes.empty()) {
-        index_error("z", z_axis.coordinate_repr(z), frame.nz());
-      }
       index_error("u", u_axis.coordinate_repr(u), frame.nu());
     }
     return false;
   }
+  frame.is_loaded(true);
+  frame.is_updated(updated);
+  if (!updated) {
+    return frame.is_valid();
+  }
 
   auto x0 = x_axis(x_indexes[0]);
 
-  for (Eigen::Index jx = 0; jx < frame.y()->size(); ++jx) {
+  for (Eigen::Index jx = 0; jx < frame.y_values().size(); ++jx) {
     frame.y(jx) = y_axis(y_indexes[jx]);
   }
 
@@ -167,14 +259,14 @@ auto load_frame(const Grid4D<DataType, AxisType>& grid, const double x,
     frame.u(lx) = u_axis(u_indexes[lx]);
   }
 
-  for (Eigen::Index ix = 0; ix < frame.x()->size(); ++ix) {
+  for (Eigen::Index ix = 0; ix < frame.x_values().size(); ++ix) {
     const auto x_index = x_indexes[ix];
 
     frame.x(ix) = x_axis.is_angle() ? detail::math::normalize_angle(
                                           x_axis(x_index), x0, 360.0)
                                     : x_axis(x_index);
 
-    for (Eigen::Index jx = 0; jx < frame.y()->size(); ++jx) {
+    for (Eigen::Index jx = 0; jx < frame.y_values().size(); ++jx) {
       const auto y_index = y_indexes[jx];
 
       for (Eigen::Index kx = 0; kx < frame.z().size(); ++kx) {
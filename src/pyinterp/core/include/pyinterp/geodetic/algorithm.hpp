@@ -3,6 +3,7 @@
 #include <pybind11/numpy.h>
 
 #include <Eigen/Core>
+#include <algorithm>
 #include <boost/geometry/algorithms/area.hpp>
 #include <boost/geometry/algorithms/covered_by.hpp>
 #include <boost/geometry/srs/spheroid.hpp>
@@ -19,13 +20,26 @@
 #include <optional>
 
 #include "pyinterp/detail/broadcast.hpp"
+#include "pyinterp/detail/math.hpp"
 #include "pyinterp/detail/thread.hpp"
 #include "pyinterp/geodetic/system.hpp"
 
 namespace pyinterp::geodetic {
 
 /// Distance calculation strategy.
-enum DistanceStrategy { kAndoyer = 0x0, kThomas = 0x1, kVincenty = 0x2 };
+///
+/// kHaversine and kFlat are approximations on the sphere having the mean
+/// radius of the spheroid: the haversine formula computes the great circle
+/// distance with a relative error up to 0.5%, the flat approximation
+/// (equirectangular projection) is only accurate for points a few tens of
+/// kilometers apart.
+enum DistanceStrategy {
+  kAndoyer = 0x0,
+  kThomas = 0x1,
+  kVincenty = 0x2,
+  kHaversine = 0x3,
+  kFlat = 0x4,
+};
 
 using Andoyer = boost::geometry::strategy::distance::andoyer<
     boost::geometry::srs::spheroid<double>>;
@@ -34,6 +48,42 @@ using Thomas = boost::geometry::strategy::distance::thomas<
 using Vincenty = boost::geometry::strategy::distance::vincenty<
     boost::geometry::srs::spheroid<double>>;
 
+/// Radius of the sphere used by the spherical approximations of the
+/// distance.
+[[nodiscard]] inline auto sphere_radius(const std::optional<System> &wgs)
+    -> double {
+  return wgs.has_value() ? wgs->mean_radius()
+                         : detail::geodetic::System().mean_radius();
+}
+
+/// Calculate the distances between coordinates, in meters, with one of the
+/// spherical approximations kHaversine or kFlat. The expressions are
+/// evaluated coefficient-wise, so Eigen vectorizes them.
+inline void spherical_distances(const Eigen::Ref<const Eigen::ArrayXd> &lon1,
+                                const Eigen::Ref<const Eigen::ArrayXd> &lat1,
+                                const Eigen::Ref<const Eigen::ArrayXd> &lon2,
+                                const Eigen::Ref<const Eigen::ArrayXd> &lat2,
+                                const DistanceStrategy strategy,
+                                const double radius,
+                                Eigen::Ref<Eigen::ArrayXd> result) {
+  constexpr auto kRadians = detail::math::pi<double>() / 180.0;
+  constexpr auto kTwoPi = detail::math::two_pi<double>();
+  if (strategy == kHaversine) {
+    const Eigen::ArrayXd h =
+        ((lat2 - lat1) * (kRadians * 0.5)).sin().square() +
+        (lat1 * kRadians).cos() * (lat2 * kRadians).cos() *
+            ((lon2 - lon1) * (kRadians * 0.5)).sin().square();
+    result = (2 * radius) * h.min(1.0).sqrt().asin();
+  } else {
+    // The difference of longitudes is reduced to [-π, π].
+    Eigen::ArrayXd dx = (lon2 - lon1) * kRadians;
+    dx -= kTwoPi * (dx / kTwoPi).round();
+    dx *= ((lat1 + lat2) * (kRadians * 0.5)).cos();
+    result =
+        radius * (dx.square() + ((lat2 - lat1) * kRadians).square()).sqrt();
+  }
+}
+
 /// Calculate the area
 template <typename Geometry>
 [[nodiscard]] inline auto area(const Geometry &geometry,
@@ -63,27 +113,15 @@ template <typename Geometry1, typename Geometry2>
   {
     pybind11::gil_scoped_release release;
 
-    // Captures the detected exceptions in the calculation function
-    // (only the last exception captured is kept)
-    auto except = std::exception_ptr(nullptr);
-
     detail::dispatch(
         [&](size_t start, size_t end) {
-          try {
-            for (auto ix = static_cast<int64_t>(start);
-                 ix < static_cast<int64_t>(end); ++ix) {
-              _result(ix) = static_cast<int8_t>(boost::geometry::covered_by(
-                  Geometry1(lon(ix), lat(ix)), geometry2));
-            }
-          } catch (...) {
-            except = std::current_exception();
+          for (auto ix = static_cast<int64_t>(start);
+               ix < static_cast<int64_t>(end); ++ix) {
+            _result(ix) = static_cast<int8_t>(boost::geometry::covered_by(
+                Geometry1(lon(ix), lat(ix)), geometry2));
           }
         },
-        size, num_threads);
-
-    if (except != nullptr) {
-      std::rethrow_exception(except);
-    }
+        size, num_threads, detail::kGuided);
   }
   return result;
 }
@@ -109,6 +147,19 @@ template <typename Geometry1, typename Geometry2>
       return boost::geometry::distance(geometry1, geometry2,
                                        Vincenty(spheroid));
       break;
+    case kHaversine:
+    case kFlat: {
+      auto result = Eigen::ArrayXd(1);
+      spherical_distances(
+          Eigen::ArrayXd::Constant(1, boost::geometry::get<0>(geometry1)),
+          Eigen::ArrayXd::Constant(1, boost::geometry::get<1>(geometry1)),
+          Eigen::ArrayXd::Constant(1, boost::geometry::get<0>(geometry2)),
+          Eigen::ArrayXd::Constant(1, boost::geometry::get<1>(geometry2)),
+          strategy, sphere_radius(wgs), result);
+      return result(0);
+    }
+    default:
+      break;
   }
   throw std::invalid_argument("unknown strategy: " +
                               std::to_string(static_cast<int>(strategy)));
@@ -137,28 +188,52 @@ template <typename Geometry, typename Strategy>
   {
     pybind11::gil_scoped_release release;
 
-    // Captures the detected exceptions in the calculation function
-    // (only the last exception captured is kept)
-    auto except = std::exception_ptr(nullptr);
+    detail::dispatch(
+        [&](size_t start, size_t end) {
+          for (auto ix = static_cast<int64_t>(start);
+               ix < static_cast<int64_t>(end); ++ix) {
+            _result(ix) = boost::geometry::distance(
+                Geometry(lon1(ix), lat1(ix)), Geometry(lon2(ix), lat2(ix)),
+                strategy);
+          }
+        },
+        size, num_threads, detail::kGuided);
+  }
+  return result;
+}
+
+/// Calculate the distance between coordinates with one of the spherical
+/// approximations.
+[[nodiscard]] inline auto coordinate_distances(
+    const Eigen::Ref<const Eigen::VectorXd> &lon1,
+    const Eigen::Ref<const Eigen::VectorXd> &lat1,
+    const Eigen::Ref<const Eigen::VectorXd> &lon2,
+    const Eigen::Ref<const Eigen::VectorXd> &lat2,
+    const DistanceStrategy strategy, const double radius,
+    const size_t num_threads) -> pybind11::array_t<double> {
+  auto size = lon1.size();
+  auto result =
+      pybind11::array_t<double>(pybind11::array::ShapeContainer{{size}});
+  auto _result = Eigen::Map<Eigen::ArrayXd>(result.mutable_data(), size);
+
+  {
+    pybind11::gil_scoped_release release;
 
     detail::dispatch(
         [&](size_t start, size_t end) {
-          try {
-            for (auto ix = static_cast<int64_t>(start);
-                 ix < static_cast<int64_t>(end); ++ix) {
-              _result(ix) = boost::geometry::distance(
-                  Geometry(lon1(ix), lat1(ix)), Geometry(lon2(ix), lat2(ix)),
-                  strategy);
-            }
-          } catch (...) {
-            except = std::current_exception();
+          // The points are processed by blocks to bound the size of the
+          // temporary arrays.
+          constexpr auto kBlockSize = Eigen::Index(4096);
+          for (auto ix = static_cast<Eigen::Index>(start);
+               ix < static_cast<Eigen::Index>(end); ix += kBlockSize) {
+            auto n = std::min(kBlockSize, static_cast<Eigen::Index>(end) - ix);
+            spherical_distances(
+                lon1.segment(ix, n).array(), lat1.segment(ix, n).array(),
+                lon2.segment(ix, n).array(), lat2.segment(ix, n).array(),
+                strategy, radius, _result.segment(ix, n));
           }
         },
         size, num_threads);
-
-    if (except != nullptr) {
-      std::rethrow_exception(except);
-    }
   }
   return result;
 }
@@ -191,6 +266,13 @@ template <typename Geometry>
       return coordinate_distances<Geometry, Vincenty>(
           lon1, lat1, lon2, lat2, Vincenty(spheroid), num_threads);
       break;
+    case kHaversine:
+    case kFlat:
+      return coordinate_distances(lon1, lat1, lon2, lat2, strategy,
+                                  sphere_radius(wgs), num_threads);
+      break;
+    default:
+      break;
   }
   throw std::invalid_argument("unknown strategy: " +
                               std::to_string(static_cast<int>(strategy)));
@@ -40,36 +40,23 @@ class Coordinates : public detail::geodetic::Coordinates {
     auto lon = pybind11::array_t<T>(pybind11::array::ShapeContainer{{size}});
     auto lat = pybind11::array_t<T>(pybind11::array::ShapeContainer{{size}});
     auto alt = pybind11::array_t<T>(pybind11::array::ShapeContainer{{size}});
-    auto _lon = lon.template mutable_unchecked<1>();
-    auto _lat = lat.template mutable_unchecked<1>();
-    auto _alt = alt.template mutable_unchecked<1>();
+    auto _lon = Eigen::Map<Vector<T>>(lon.mutable_data(), size);
+    auto _lat = Eigen::Map<Vector<T>>(lat.mutable_data(), size);
+    auto _alt = Eigen::Map<Vector<T>>(alt.mutable_data(), size);
 
     {
       pybind11::gil_scoped_release release;
 
-      // Captures the detected exceptions in the calculation function
-      // (only the last exception captured is kept)
-      auto except = std::exception_ptr(nullptr);
-
       detail::dispatch(
           [&](size_t start, size_t end) {
-            try {
-              for (size_t ix = start; ix < end; ++ix) {
-                auto lla = detail::geodetic::Coordinates::ecef_to_lla(
-                    detail::geometry::Point3D<T>{x(ix), y(ix), z(ix)});
-                _lon(ix) = boost::geometry::get<0>(lla);
-                _lat(ix) = boost::geometry::get<1>(lla);
-                _alt(ix) = boost::geometry::get<2>(lla);
-              }
-            } catch (...) {
-              except = std::current_exception();
-            }
+            auto n = static_cast<Eigen::Index>(end - start);
+            auto ix = static_cast<Eigen::Index>(start);
+            detail::geodetic::Coordinates::ecef_to_lla<T>(
+                x.segment(ix, n), y.segment(ix, n), z.segment(ix, n),
+                _lon.segment(ix, n), _lat.segment(ix, n),
+                _alt.segment(ix, n));
           },
           size, num_threads);
-
-      if (except != nullptr) {
-        std::rethrow_exception(except);
-      }
     }
     return pybind11::make_tuple(lon, lat, alt);
   }
@@ -87,37 +74,22 @@ class Coordinates : public detail::geodetic::Coordinates {
     auto x = pybind11::array_t<T>(pybind11::array::ShapeContainer{{size}});
     auto y = pybind11::array_t<T>(pybind11::array::ShapeContainer{{size}});
     auto z = pybind11::array_t<T>(pybind11::array::ShapeContainer{{size}});
-    auto x_ = x.template mutable_unchecked<1>();
-    auto y_ = y.template mutable_unchecked<1>();
-    auto z_ = z.template mutable_unchecked<1>();
+    auto x_ = Eigen::Map<Vector<T>>(x.mutable_data(), size);
+    auto y_ = Eigen::Map<Vector<T>>(y.mutable_data(), size);
+    auto z_ = Eigen::Map<Vector<T>>(z.mutable_data(), size);
 
     {
       pybind11::gil_scoped_release release;
 
-      // Captures the detected exceptions in the calculation function
-      // (only the last exception captured is kept)
-      auto except = std::exception_ptr(nullptr);
-
       detail::dispatch(
           [&](size_t start, size_t end) {
-            try {
-              for (size_t ix = start; ix < end; ++ix) {
-                auto ecef = detail::geodetic::Coordinates::lla_to_ecef(
-                    detail::geometry::EquatorialPoint3D<T>{lon(ix), lat(ix),
-                                                           alt(ix)});
-                x_(ix) = boost::geometry::get<0>(ecef);
-                y_(ix) = boost::geometry::get<1>(ecef);
-                z_(ix) = boost::geometry::get<2>(ecef);
-              }
-            } catch (...) {
-              except = std::current_exception();
-            }
+            auto n = static_cast<Eigen::Index>(end - start);
+            auto ix = static_cast<Eigen::Index>(start);
+            detail::geodetic::Coordinates::lla_to_ecef<T>(
+                lon.segment(ix, n), lat.segment(ix, n), alt.segment(ix, n),
+                x_.segment(ix, n), y_.segment(ix, n), z_.segment(ix, n));
           },
           size, num_threads);
-
-      if (except != nullptr) {
-        std::rethrow_exception(except);
-      }
     }
     return pybind11::make_tuple(x, y, z);
   }
@@ -135,37 +107,23 @@ class Coordinates : public detail::geodetic::Coordinates {
     auto lon2 = pybind11::array_t<T>(pybind11::array::ShapeContainer{{size}});
     auto lat2 = pybind11::array_t<T>(pybind11::array::ShapeContainer{{size}});
     auto alt2 = pybind11::array_t<T>(pybind11::array::ShapeContainer{{size}});
-    auto _lon2 = lon2.template mutable_unchecked<1>();
-    auto _lat2 = lat2.template mutable_unchecked<1>();
-    auto _alt2 = alt2.template mutable_unchecked<1>();
+    auto _lon2 = Eigen::Map<Vector<T>>(lon2.mutable_data(), size);
+    auto _lat2 = Eigen::Map<Vector<T>>(lat2.mutable_data(), size);
+    auto _alt2 = Eigen::Map<Vector<T>>(alt2.mutable_data(), size);
 
     {
       pybind11::gil_scoped_release release;
 
-      // Captures the detected exceptions in the calculation function
-      // (only the last exception captured is kept)
-      auto except = std::exception_ptr(nullptr);
-
       detail::dispatch(
           [&](size_t start, size_t end) {
-            try {
-              for (size_t ix = start; ix < end; ++ix) {
-                auto lla = detail::geodetic::Coordinates::transform(
-                    target, detail::geometry::EquatorialPoint3D<T>{
-                                lon1(ix), lat1(ix), alt1(ix)});
-                _lon2(ix) = boost::geometry::get<0>(lla);
-                _lat2(ix) = boost::geometry::get<1>(lla);
-                _alt2(ix) = boost::geometry::get<2>(lla);
-              }
-            } catch (...) {
-              except = std::current_exception();
-            }
+            auto n = static_cast<Eigen::Index>(end - start);
+            auto ix = static_cast<Eigen::Index>(start);
+            detail::geodetic::Coordinates::transform<T>(
+                target, lon1.segment(ix, n), lat1.segment(ix, n),
+                alt1.segment(ix, n), _lon2.segment(ix, n),
+                _lat2.segment(ix, n), _alt2.segment(ix, n));
           },
           size, num_threads);
-
-      if (except != nullptr) {
-        std::rethrow_exception(except);
-      }
     }
     return pybind11::make_tuple(lon2, lat2, alt2);
   }
@@ -0,0 +1,120 @@
+// Copyright (c) 2022 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+#pragma once
+#include <Eigen/Core>
+#include <stdexcept>
+#include <tuple>
+#include <vector>
+
+#include "pyinterp/detail/broadcast.hpp"
+#include "pyinterp/detail/geodetic/crossover.hpp"
+#include "pyinterp/detail/thread.hpp"
+#include "pyinterp/eigen.hpp"
+
+namespace pyinterp::geodetic {
+
+/// Coordinates of a track: longitudes and latitudes in degrees.
+using Track = std::tuple<Eigen::VectorXd, Eigen::VectorXd>;
+
+/// Crossover points found: longitudes, latitudes, positions along the first
+/// and the second track.
+using Crossovers = std::tuple<Eigen::VectorXd, Eigen::VectorXd,
+                              Eigen::VectorXd, Eigen::VectorXd>;
+
+/// Searches for the crossover points between two tracks.
+///
+/// @param lon1 Longitudes of the points of the first track, in degrees.
+/// @param lat1 Latitudes of the points of the first track, in degrees.
+/// @param lon2 Longitudes of the points of the second track, in degrees.
+/// @param lat2 Latitudes of the points of the second track, in degrees.
+/// @return The longitudes, latitudes and positions of the crossovers along
+/// both tracks, sorted by position along the first track.
+inline auto crossovers(const Eigen::Ref<const Eigen::VectorXd> &lon1,
+                       const Eigen::Ref<const Eigen::VectorXd> &lat1,
+                       const Eigen::Ref<const Eigen::VectorXd> &lon2,
+                       const Eigen::Ref<const Eigen::VectorXd> &lat2)
+    -> Crossovers {
+  detail::check_eigen_shape("lon1", lon1, "lat1", lat1);
+  detail::check_eigen_shape("lon2", lon2, "lat2", lat2);
+  auto items = detail::geodetic::crossovers(lon1, lat1, lon2, lat2);
+  const auto size = static_cast<Eigen::Index>(items.size());
+  auto result = Crossovers(Eigen::VectorXd(size), Eigen::VectorXd(size),
+                           Eigen::VectorXd(size), Eigen::VectorXd(size));
+  for (Eigen::Index ix = 0; ix < size; ++ix) {
+    const auto &item = items[static_cast<size_t>(ix)];
+    std::get<0>(result)(ix) = item.lon;
+    std::get<1>(result)(ix) = item.lat;
+    std::get<2>(result)(ix) = item.index1;
+    std::get<3>(result)(ix) = item.index2;
+  }
+  return result;
+}
+
+/// Searches, in parallel, for the crossover points between pairs of tracks.
+///
+/// @param tracks Coordinates of the tracks.
+/// @param pairs Matrix of shape (n, 2) holding the indices of the tracks to
+/// intersect.
+/// @param num_threads The number of threads to use for the computation. If
+/// 0 all CPUs are used.
+/// @return The index of the pair of each crossover, followed by the
+/// longitudes, latitudes and positions of the crossovers along both tracks.
+/// The crossovers are sorted by pair, then by position along the first track.
+inline auto crossovers(const std::vector<Track> &tracks,
+                       const Eigen::Ref<const Matrix<int64_t>> &pairs,
+                       const size_t num_threads)
+    -> std::tuple<Vector<int64_t>, Eigen::VectorXd, Eigen::VectorXd,
+                  Eigen::VectorXd, Eigen::VectorXd> {
+  if (pairs.cols() != 2) {
+    throw std::invalid_argument("pairs must be a matrix of shape (n, 2)");
+  }
+  const auto num_tracks = static_cast<int64_t>(tracks.size());
+  if ((pairs.array() < 0).any() || (pairs.array() >= num_tracks).any()) {
+    throw std::invalid_argument("pairs refer to tracks that do not exist");
+  }
+  for (const auto &item : tracks) {
+    detail::check_eigen_shape("lon", std::get<0>(item), "lat",
+                              std::get<1>(item));
+  }
+  const auto size = static_cast<size_t>(pairs.rows());
+  auto items = std::vector<std::vector<detail::geodetic::Crossover>>(size);
+  detail::dispatch(
+      [&](size_t start, size_t end) {
+        for (auto ix = start; ix < end; ++ix) {
+          const auto &lhs = tracks[pairs(ix, 0)];
+          const auto &rhs = tracks[pairs(ix, 1)];
+          items[ix] = detail::geodetic::crossovers(
+              std::get<0>(lhs), std::get<1>(lhs), std::get<0>(rhs),
+              std::get<1>(rhs));
+        }
+      },
+      size, num_threads, detail::kDynamic);
+
+  auto offsets = std::vector<Eigen::Index>(size + 1, 0);
+  for (size_t ix = 0; ix < size; ++ix) {
+    offsets[ix + 1] =
+        offsets[ix] + static_cast<Eigen::Index>(items[ix].size());
+  }
+  const auto total = offsets.back();
+  auto index = Vector<int64_t>(total);
+  auto lon = Eigen::VectorXd(total);
+  auto lat = Eigen::VectorXd(total);
+  auto index1 = Eigen::VectorXd(total);
+  auto index2 = Eigen::VectorXd(total);
+  for (size_t ix = 0; ix < size; ++ix) {
+    auto jx = offsets[ix];
+    for (const auto &item : items[ix]) {
+      index(jx) = static_cast<int64_t>(ix);
+      lon(jx) = item.lon;
+      lat(jx) = item.lat;
+      index1(jx) = item.index1;
+      index2(jx++) = item.index2;
+    }
+  }
+  return std::make_tuple(std::move(index), std::move(lon), std::move(lat),
+                         std::move(index1), std::move(index2));
+}
+
+}  // namespace pyinterp::geodetic
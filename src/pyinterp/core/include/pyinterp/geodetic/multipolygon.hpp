@@ -0,0 +1,129 @@
+// Copyright (c) 2022 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+#pragma once
+#include <pybind11/eigen.h>
+#include <pybind11/numpy.h>
+
+#include <Eigen/Core>
+#include <boost/geometry.hpp>
+#include <string>
+
+#include "pyinterp/geodetic/algorithm.hpp"
+#include "pyinterp/geodetic/point.hpp"
+#include "pyinterp/geodetic/polygon.hpp"
+
+namespace pyinterp::geodetic {
+
+/// Forward declaration
+class Box;
+
+/// A collection of polygons.
+class MultiPolygon : public boost::geometry::model::multi_polygon<Polygon> {
+ public:
+  using Base = boost::geometry::model::multi_polygon<Polygon>;
+  using Base::multi_polygon;
+
+  /// Create a new instance from Python
+  explicit MultiPolygon(const pybind11::list& polygons);
+
+  /// Returns the polygon at the given index
+  [[nodiscard]] auto get(int64_t index) const -> const Polygon& {
+    if (index < 0) {
+      index += static_cast<int64_t>(size());
+    }
+    if (index < 0 || index >= static_cast<int64_t>(size())) {
+      throw std::out_of_range("polygon index out of range");
+    }
+    return (*this)[static_cast<size_t>(index)];
+  }
+
+  /// Appends a polygon to the collection
+  inline auto append(const Polygon& polygon) -> void {
+    push_back(polygon);
+  }
+
+  /// Calculates the envelope of the polygons.
+  [[nodiscard]] auto envelope() const -> Box;
+
+  /// Calculate the area
+  [[nodiscard]] auto area(const std::optional<System>& wgs) const -> double {
+    return geodetic::area(*this, wgs);
+  }
+
+  /// @brief Test if the given point is inside or on border of one of the
+  /// polygons
+  [[nodiscard]] auto covered_by(const Point& point) const -> bool {
+    return boost::geometry::covered_by(point, *this);
+  }
+
+  /// @brief Test if the coordinates of the points provided are located inside
+  /// or at the edge of one of the polygons.
+  ///
+  /// @param lon Longitudes coordinates in degrees to check
+  /// @param lat Latitude coordinates in degrees to check
+  /// @return Returns a vector containing a flag equal to 1 if the coordinate is
+  /// located in a polygon or at its edge otherwise 0.
+  [[nodiscard]] auto covered_by(const Eigen::Ref<const Eigen::VectorXd>& lon,
+                                const Eigen::Ref<const Eigen::VectorXd>& lat,
+                                const size_t num_threads) const
+      -> pybind11::array_t<int8_t> {
+    return geodetic::covered_by<Point, MultiPolygon>(*this, lon, lat,
+                                                     num_threads);
+  }
+
+  /// @brief Returns, for each point, the index of the first polygon covering
+  /// it, or -1 if no polygon covers it.
+  ///
+  /// An R*Tree indexes the envelopes of the polygons and the edges of each
+  /// polygon are indexed by a PreparedPolygon, so all the points are located
+  /// in a single parallel pass.
+  ///
+  /// @param lon Longitudes coordinates in degrees to locate
+  /// @param lat Latitude coordinates in degrees to locate
+  /// @param num_threads The number of threads to use for the computation.
+  [[nodiscard]] auto which_polygon(const Eigen::Ref<const Eigen::VectorXd>& lon,
+                                   const Eigen::Ref<const Eigen::VectorXd>& lat,
+                                   size_t num_threads) const
+      -> pybind11::array_t<int64_t>;
+
+  /// Get a tuple that fully encodes the state of this instance
+  [[nodiscard]] auto getstate() const -> pybind11::tuple {
+    auto result = pybind11::tuple(size());
+    for (size_t ix = 0; ix < size(); ++ix) {
+      result[ix] = (*this)[ix].getstate();
+    }
+    return result;
+  }
+
+  /// Create a new instance from a registered state of an instance of this
+  /// object.
+  static auto setstate(const pybind11::tuple& state) -> MultiPolygon {
+    auto result = MultiPolygon();
+    for (const auto item : state) {
+      result.push_back(Polygon::setstate(item.cast<pybind11::tuple>()));
+    }
+    return result;
+  }
+
+  /// Converts a MultiPolygon into a string with the same meaning as that of
+  /// this instance.
+  [[nodiscard]] auto to_string() const -> std::string {
+    std::stringstream ss;
+    ss << boost::geometry::dsv(*this);
+    return ss.str();
+  }
+};
+
+}  // namespace pyinterp::geodetic
+
+namespace boost::geometry::traits {
+namespace pg = pyinterp::geodetic;
+
+template <>
+struct tag<pg::MultiPolygon> {
+  using type = multi_polygon_tag;
+};
+
+}  // namespace boost::geometry::traits
@@ -0,0 +1,105 @@
+// Copyright (c) 2022 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+#pragma once
+#include <pybind11/numpy.h>
+
+#include <Eigen/Core>
+#include <cstdint>
+#include <vector>
+
+#include "pyinterp/geodetic/point.hpp"
+#include "pyinterp/geodetic/polygon.hpp"
+
+namespace pyinterp::geodetic {
+
+/// Polygon prepared for the point-in-polygon tests of many points.
+///
+/// The edges of the polygon are distributed in slabs of longitude. The
+/// winding algorithm used by Boost.Geometry only takes into account the edges
+/// whose longitude range contains the longitude of the tested point or its
+/// antipodal longitude: the test only visits the edges of two slabs instead
+/// of all the edges of the polygon, and gives the result of
+/// boost::geometry::covered_by. The index is immutable once built, so it can
+/// be shared between threads.
+class PreparedPolygon {
+ public:
+  /// Builds the index of the edges of the given polygon.
+  explicit PreparedPolygon(Polygon polygon);
+
+  /// Returns the indexed polygon.
+  [[nodiscard]] inline auto polygon() const noexcept -> const Polygon& {
+    return polygon_;
+  }
+
+  /// Returns the number of slabs of longitude of the index.
+  [[nodiscard]] inline auto slabs() const noexcept -> size_t {
+    return offsets_.size() - 1;
+  }
+
+  /// Test if the given point is inside or on border of the polygon.
+  [[nodiscard]] auto covered_by(const Point& point) const -> bool {
+    auto candidates = std::vector<uint32_t>();
+    return relate(point, candidates) >= 0;
+  }
+
+  /// Test if the coordinates of the points provided are located inside or at
+  /// the edge of the polygon.
+  ///
+  /// @param lon Longitudes coordinates in degrees to check
+  /// @param lat Latitude coordinates in degrees to check
+  /// @param num_threads The number of threads to use for the computation.
+  /// @return Returns a vector containing a flag equal to 1 if the coordinate
+  /// is located in the Polygon or at the edge otherwise 0.
+  [[nodiscard]] auto covered_by(const Eigen::Ref<const Eigen::VectorXd>& lon,
+                                const Eigen::Ref<const Eigen::VectorXd>& lat,
+                                size_t num_threads) const
+      -> pybind11::array_t<int8_t>;
+
+  /// Get a tuple that fully encodes the state of this instance
+  [[nodiscard]] auto getstate() const -> pybind11::tuple {
+    return polygon_.getstate();
+  }
+
+  /// Create a new instance from a registered state of an instance of this
+  /// object.
+  static auto setstate(const pybind11::tuple& state) -> PreparedPolygon {
+    return PreparedPolygon(Polygon::setstate(state));
+  }
+
+ private:
+  /// The indexed polygon.
+  Polygon polygon_;
+
+  /// The edges are numbered ring by ring, the outer ring first, then the
+  /// inner rings. Item r is the index of the first edge of the ring r, the
+  /// last item is the number of edges.
+  std::vector<uint32_t> rings_;
+
+  /// Edges that must be visited for all the points: the edges ending at a
+  /// pole and the edges joining two antipodal meridians.
+  std::vector<uint32_t> always_;
+
+  /// Edges of each slab of longitude, sorted by edge index. The edges of
+  /// slab i are items[offsets[i]:offsets[i + 1]].
+  std::vector<uint32_t> offsets_;
+  std::vector<uint32_t> items_;
+
+  /// Returns the points of the ring r.
+  [[nodiscard]] auto ring(size_t r) const -> const Polygon::ring_type& {
+    const auto& base = static_cast<const Polygon::Base&>(polygon_);
+    return r == 0 ? base.outer() : base.inners()[r - 1];
+  }
+
+  /// Returns the slab containing the given longitude.
+  [[nodiscard]] auto slab(double lon) const -> size_t;
+
+  /// Returns 1 if the point is inside the polygon, 0 if it is on its border
+  /// and -1 if it is outside, as boost::geometry::detail::within does.
+  /// candidates is a buffer reused between the calls.
+  [[nodiscard]] auto relate(const Point& point,
+                            std::vector<uint32_t>& candidates) const -> int;
+};
+
+}  // namespace pyinterp::geodetic
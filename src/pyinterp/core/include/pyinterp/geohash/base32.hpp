@@ -54,19 +54,27 @@ class Base32 {
     return std::make_tuple(hash, static_cast<uint32_t>(it - buffer));
   }
 
-  // Encode bits of 64-bit word into a string.
+  // Encode bits of 64-bit word into a string. The characters are written two
+  // by two, looked up in a table indexed by 10 bits of the word.
   constexpr static auto encode(uint64_t hash, char* const buffer,
                                const size_t count) -> void {
-    auto* it = buffer + count - 1;
-    while (it >= buffer) {
-      *(it--) = encode_[hash & 0x1fU];
-      hash >>= 5U;
+    auto* it = buffer + count;
+    while (it - buffer >= 2) {
+      it -= 2;
+      const auto& pair = pairs_[hash & 0x3ffU];
+      it[0] = pair[0];
+      it[1] = pair[1];
+      hash >>= 10U;
+    }
+    if (it != buffer) {
+      *(--it) = encode_[hash & 0x1fU];
     }
   }
 
  private:
   static const char kInvalid_;
   static const std::array<char, 32> encode_;
+  static const std::array<std::array<char, 2>, 1024> pairs_;
   std::array<char, std::numeric_limits<uint8_t>::max() + 1> decode_{};
 
   // Reports whether byte is part of the encoding.
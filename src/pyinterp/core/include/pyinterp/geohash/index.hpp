@@ -0,0 +1,761 @@
+// Copyright (c) 2022 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+#pragma once
+#include <pybind11/eigen.h>
+#include <pybind11/numpy.h>
+
+#include <Eigen/Core>
+#include <algorithm>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <optional>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "pyinterp/detail/broadcast.hpp"
+#include "pyinterp/detail/geodetic/coordinates.hpp"
+#include "pyinterp/detail/geometry/point.hpp"
+#include "pyinterp/detail/math.hpp"
+#include "pyinterp/detail/thread.hpp"
+#include "pyinterp/eigen.hpp"
+#include "pyinterp/geodetic/system.hpp"
+#include "pyinterp/geohash/int64.hpp"
+
+namespace pyinterp::geohash {
+
+/// Spatial index storing the points in the cells of a geohash grid.
+///
+/// The points are sorted by the geohash code of the cell containing them and
+/// stored in a compressed sparse row layout: the sorted codes of the cells
+/// that are not empty, the offsets of their first point, and the packed
+/// points. The index is built by one parallel sort and takes much less memory
+/// than a tree; the three arrays can be written to a file (see save()) that
+/// load() maps read-only in memory.
+///
+/// The nearest neighbors of a point are searched in its cell, then in rings
+/// of cells around it, until the distance between the point and the cells
+/// not yet explored exceeds the distance of the K-th neighbor found. The
+/// distances are the Euclidean distances between the ECEF coordinates of
+/// the points, like for the RTree. The index is efficient for quasi-uniform
+/// observation networks, whose cells hold a few points: near the poles, the
+/// cells become narrower and the searches explore more of them.
+///
+/// @tparam Type The type of data stored in the index.
+template <typename Type>
+class Index {
+ public:
+  /// Type of the ECEF coordinates of the points.
+  using point_t = detail::geometry::Point3D<double>;
+
+  /// Value handled by this object
+  using value_t = std::pair<point_t, Type>;
+
+  /// Default constructor
+  ///
+  /// @param precision The number of bits of the geohash codes defining the
+  /// cells of the index.
+  /// @param wgs The geodetic system used to calculate the ECEF coordinates
+  /// of the points.
+  Index(const uint32_t precision,
+        const std::optional<detail::geodetic::System> &wgs)
+      : coordinates_(wgs.value_or(detail::geodetic::System())),
+        precision_(precision) {
+    if (precision < 1 || precision > 64) {
+      throw std::invalid_argument("precision must be within [1, 64]");
+    }
+    auto lat_bits = precision >> 1U;
+    auto lon_bits = precision - lat_bits;
+    nlon_ = uint64_t(1) << lon_bits;
+    nlat_ = uint64_t(1) << lat_bits;
+    std::tie(dlon_, dlat_) = int64::error_with_precision(precision);
+  }
+
+  /// Returns the number of bits of the geohash codes defining the cells.
+  [[nodiscard]] auto precision() const noexcept -> uint32_t {
+    return precision_;
+  }
+
+  /// Returns the number of points stored in the index.
+  [[nodiscard]] auto size() const noexcept -> size_t { return size_; }
+
+  /// Returns the number of cells holding at least one point.
+  [[nodiscard]] auto cells() const noexcept -> size_t { return cells_size_; }
+
+  /// Returns the geodetic system used to calculate the ECEF coordinates.
+  [[nodiscard]] auto system() const -> geodetic::System {
+    return geodetic::System(coordinates_.system());
+  }
+
+  /// Builds the index from the provided points. The old data is erased.
+  ///
+  /// @param lon Longitudes of the points, in degrees.
+  /// @param lat Latitudes of the points, in degrees.
+  /// @param values Values associated with the points.
+  /// @param num_threads The number of threads to use for the computation. If
+  /// 0 all CPUs are used.
+  auto packing(const Eigen::Ref<const Eigen::VectorXd> &lon,
+               const Eigen::Ref<const Eigen::VectorXd> &lat,
+               const Eigen::Ref<const Vector<Type>> &values,
+               const size_t num_threads) -> void {
+    detail::check_eigen_shape("lon", lon, "lat", lat, "values", values);
+    if (!lon.allFinite() || !lat.allFinite()) {
+      throw std::invalid_argument("lon, lat must not contain undefined values");
+    }
+    const auto size = static_cast<size_t>(lon.size());
+
+    // Points are sorted by cell, then by position in the input.
+    auto keys = std::vector<std::pair<uint64_t, size_t>>(size);
+    detail::dispatch(
+        [&](size_t start, size_t end) {
+          for (size_t ix = start; ix < end; ++ix) {
+            keys[ix] = std::make_pair(encode(lon(ix), lat(ix)), ix);
+          }
+        },
+        size, num_threads);
+    sort(keys, num_threads);
+
+    auto storage = std::make_shared<Storage>();
+    storage->points.resize(size);
+    detail::dispatch(
+        [&](size_t start, size_t end) {
+          for (size_t ix = start; ix < end; ++ix) {
+            const auto item = keys[ix].second;
+            storage->points[ix] =
+                std::make_pair(ecef(lon(item), lat(item)), values(item));
+          }
+        },
+        size, num_threads);
+
+    for (size_t ix = 0; ix < size; ++ix) {
+      if (ix == 0 || keys[ix].first != keys[ix - 1].first) {
+        storage->cells.push_back(keys[ix].first);
+        storage->offsets.push_back(ix);
+      }
+    }
+    storage->offsets.push_back(size);
+    attach(std::move(storage));
+  }
+
+  /// Search for the K nearest neighbors of the given points.
+  ///
+  /// @param lon Longitudes of the points, in degrees.
+  /// @param lat Latitudes of the points, in degrees.
+  /// @param k The number of nearest neighbors to search.
+  /// @param radius The maximum distance between a point and its neighbors.
+  /// @param num_threads The number of threads to use for the computation. If
+  /// 0 all CPUs are used.
+  /// @return A tuple containing the distances and the values of the
+  /// neighbors found, sorted by increasing distance, in matrices of shape
+  /// (n, k). The missing neighbors are filled with -1.
+  auto query(const Eigen::Ref<const Eigen::VectorXd> &lon,
+             const Eigen::Ref<const Eigen::VectorXd> &lat, const uint32_t k,
+             const std::optional<double> &radius,
+             const size_t num_threads) const
+      -> std::tuple<Eigen::MatrixXd, Matrix<Type>> {
+    detail::check_eigen_shape("lon", lon, "lat", lat);
+    const auto size = static_cast<size_t>(lon.size());
+    const auto max_distance =
+        radius.value_or(std::numeric_limits<double>::infinity());
+    if (!(max_distance >= 0)) {
+      throw std::invalid_argument("radius must be positive");
+    }
+    auto distances = Eigen::MatrixXd(size, k);
+    auto values = Matrix<Type>(size, k);
+
+    // The points are processed in the order of their cells, so that
+    // consecutive searches explore the same cells.
+    auto order = std::vector<std::pair<uint64_t, size_t>>(size);
+    detail::dispatch(
+        [&](size_t start, size_t end) {
+          for (size_t ix = start; ix < end; ++ix) {
+            order[ix] = std::make_pair(
+                std::isfinite(lon(ix)) && std::isfinite(lat(ix))
+                    ? encode(lon(ix), lat(ix))
+                    : std::numeric_limits<uint64_t>::max(),
+                ix);
+          }
+        },
+        size, num_threads);
+    sort(order, num_threads);
+
+    detail::dispatch(
+        [&](size_t start, size_t end) {
+          thread_local auto heap = std::vector<std::pair<double, size_t>>();
+          for (size_t item = start; item < end; ++item) {
+            const auto ix = order[item].second;
+            nearest(lon(ix), lat(ix), k, max_distance, heap);
+            auto jx = Eigen::Index(0);
+            for (const auto &neighbor : heap) {
+              distances(ix, jx) = std::sqrt(neighbor.first);
+              values(ix, jx++) = points_[neighbor.second].second;
+            }
+            // The rest of the result is filled with invalid values.
+            for (; jx < k; ++jx) {
+              distances(ix, jx) = -1;
+              values(ix, jx) = Type(-1);
+            }
+          }
+        },
+        size, num_threads, detail::kDynamic);
+    return std::make_tuple(std::move(distances), std::move(values));
+  }
+
+  /// Search for all the points located within a radius of the given points.
+  ///
+  /// @param lon Longitudes of the points, in degrees.
+  /// @param lat Latitudes of the points, in degrees.
+  /// @param radius The maximum distance between a point and its neighbors.
+  /// @param num_threads The number of threads to use for the computation. If
+  /// 0 all CPUs are used.
+  /// @return A tuple containing, for each pair found, the index of the
+  /// provided point, the value of the neighbor and the distance between
+  /// them. The pairs are sorted by index, then by increasing distance.
+  auto within(const Eigen::Ref<const Eigen::VectorXd> &lon,
+              const Eigen::Ref<const Eigen::VectorXd> &lat,
+              const double radius, const size_t num_threads) const
+      -> std::tuple<Vector<int64_t>, Vector<Type>, Eigen::VectorXd> {
+    detail::check_eigen_shape("lon", lon, "lat", lat);
+    if (!(radius >= 0) || !std::isfinite(radius)) {
+      throw std::invalid_argument("radius must be a positive finite number");
+    }
+    const auto size = static_cast<size_t>(lon.size());
+    const auto bound = radius * radius;
+
+    // The points are processed in the order of their cells, so that
+    // consecutive searches explore the same cells.
+    auto order = std::vector<std::pair<uint64_t, size_t>>(size);
+    detail::dispatch(
+        [&](size_t start, size_t end) {
+          for (size_t ix = start; ix < end; ++ix) {
+            order[ix] = std::make_pair(
+                std::isfinite(lon(ix)) && std::isfinite(lat(ix))
+                    ? encode(lon(ix), lat(ix))
+                    : std::numeric_limits<uint64_t>::max(),
+                ix);
+          }
+        },
+        size, num_threads);
+    sort(order, num_threads);
+
+    // Each block of points processed by a thread stores its pairs, grouped
+    // by point: the number of pairs of each point gives the position of its
+    // group in the result.
+    using pair_t = std::tuple<size_t, double, size_t>;
+    auto counts = std::vector<size_t>(size + 1, 0);
+    auto blocks = std::vector<std::vector<pair_t>>();
+    auto mutex = std::mutex();
+    detail::dispatch(
+        [&](size_t start, size_t end) {
+          auto block = std::vector<pair_t>();
+          for (size_t item = start; item < end; ++item) {
+            const auto ix = order[item].second;
+            const auto first = block.size();
+            explore(
+                lon(ix), lat(ix),
+                [&](const size_t jx, const double distance) {
+                  if (distance <= bound) {
+                    block.emplace_back(ix, distance, jx);
+                  }
+                },
+                [&]() { return bound; });
+            std::sort(block.begin() + static_cast<std::ptrdiff_t>(first),
+                      block.end());
+            counts[ix + 1] = block.size() - first;
+          }
+          auto lock = std::lock_guard<std::mutex>(mutex);
+          blocks.emplace_back(std::move(block));
+        },
+        size, num_threads, detail::kDynamic);
+    std::partial_sum(counts.begin(), counts.end(), counts.begin());
+
+    auto indexes = Vector<int64_t>(counts.back());
+    auto values = Vector<Type>(counts.back());
+    auto distances = Eigen::VectorXd(counts.back());
+    detail::dispatch(
+        [&](size_t start, size_t end) {
+          for (size_t ix = start; ix < end; ++ix) {
+            const auto &block = blocks[ix];
+            for (size_t jx = 0; jx < block.size();) {
+              const auto point = std::get<0>(block[jx]);
+              for (auto kx = counts[point]; kx < counts[point + 1];
+                   ++kx, ++jx) {
+                const auto &pair = block[jx];
+                indexes(kx) = static_cast<int64_t>(point);
+                values(kx) = points_[std::get<2>(pair)].second;
+                distances(kx) = std::sqrt(std::get<1>(pair));
+              }
+            }
+          }
+        },
+        blocks.size(), num_threads);
+    return std::make_tuple(std::move(indexes), std::move(values),
+                           std::move(distances));
+  }
+
+  /// Writes the index to a file that load() maps in memory.
+  ///
+  /// @param path Path to the file to create.
+  /// @note The file stores the memory representation of the index: it can
+  /// only be loaded on a machine with the same architecture.
+  auto save(const std::string &path) const -> void {
+    auto header = FileHeader{};
+    std::memcpy(header.magic, kMagic, sizeof(header.magic));
+    header.version = kVersion;
+    header.precision = precision_;
+    header.value_size = sizeof(Type);
+    header.semi_major_axis = coordinates_.system().semi_major_axis();
+    header.flattening = coordinates_.system().flattening();
+    header.cells = cells_size_;
+    header.size = size_;
+    header.cells_offset = align(sizeof(FileHeader));
+    header.offsets_offset =
+        align(header.cells_offset + cells_size_ * sizeof(uint64_t));
+    header.points_offset =
+        align(header.offsets_offset + (cells_size_ + 1) * sizeof(uint64_t));
+
+    auto stream = std::ofstream(path, std::ios::binary | std::ios::trunc);
+    if (!stream) {
+      throw std::runtime_error("unable to create the file: " + path);
+    }
+    stream.exceptions(std::ios::failbit | std::ios::badbit);
+    auto position = uint64_t(0);
+    auto write = [&](const uint64_t offset, const void *data,
+                     const uint64_t size) {
+      auto padding = std::string(offset - position, '\0');
+      stream.write(padding.data(),
+                   static_cast<std::streamsize>(padding.size()));
+      stream.write(static_cast<const char *>(data),
+                   static_cast<std::streamsize>(size));
+      position = offset + size;
+    };
+    write(0, &header, sizeof(FileHeader));
+    write(header.cells_offset, cells_, cells_size_ * sizeof(uint64_t));
+    write(header.offsets_offset, offsets_,
+          (cells_size_ + 1) * sizeof(uint64_t));
+    write(header.points_offset, points_, size_ * sizeof(value_t));
+  }
+
+  /// Opens an index written by save(). The file is mapped read-only in memory
+  /// and must not be modified while the index is in use.
+  ///
+  /// @param path Path to the file to open.
+  static auto load(const std::string &path) -> Index {
+    namespace bip = boost::interprocess;
+    auto region = std::shared_ptr<bip::mapped_region>();
+    try {
+      auto file = bip::file_mapping(path.c_str(), bip::read_only);
+      region = std::make_shared<bip::mapped_region>(file, bip::read_only);
+    } catch (const bip::interprocess_exception &ex) {
+      throw std::runtime_error("unable to open the file: " + path + ": " +
+                               ex.what());
+    }
+    const auto *base = static_cast<const char *>(region->get_address());
+    const auto file_size = region->get_size();
+
+    auto header = FileHeader{};
+    if (file_size < sizeof(FileHeader)) {
+      throw std::invalid_argument("invalid index file: " + path);
+    }
+    std::memcpy(&header, base, sizeof(FileHeader));
+    if (std::memcmp(header.magic, kMagic, sizeof(header.magic)) != 0 ||
+        header.version != kVersion || header.precision < 1 ||
+        header.precision > 64) {
+      throw std::invalid_argument("invalid index file: " + path);
+    }
+    if (header.value_size != sizeof(Type)) {
+      throw std::invalid_argument(
+          "the index file does not match the type of the index: " + path);
+    }
+    if (header.cells > header.size || header.size > file_size ||
+        header.cells_offset != align(sizeof(FileHeader)) ||
+        header.offsets_offset !=
+            align(header.cells_offset + header.cells * sizeof(uint64_t)) ||
+        header.points_offset !=
+            align(header.offsets_offset +
+                  (header.cells + 1) * sizeof(uint64_t)) ||
+        header.points_offset + header.size * sizeof(value_t) != file_size) {
+      throw std::invalid_argument("invalid index file: " + path);
+    }
+
+    auto result = Index(header.precision,
+                        detail::geodetic::System(header.semi_major_axis,
+                                                 header.flattening));
+    result.cells_ =
+        reinterpret_cast<const uint64_t *>(base + header.cells_offset);
+    result.offsets_ =
+        reinterpret_cast<const uint64_t *>(base + header.offsets_offset);
+    result.points_ =
+        reinterpret_cast<const value_t *>(base + header.points_offset);
+    result.cells_size_ = header.cells;
+    result.size_ = header.size;
+    result.storage_ = std::move(region);
+    return result;
+  }
+
+  /// Get a tuple that fully encodes the state of this instance
+  [[nodiscard]] auto getstate() const -> pybind11::tuple {
+    auto cells = Vector<uint64_t>(cells_size_);
+    auto offsets = Vector<uint64_t>(cells_size_ + 1);
+    auto x = Eigen::Matrix<double, Eigen::Dynamic, 3, Eigen::RowMajor>(size_,
+                                                                       3);
+    auto u = Vector<Type>(size_);
+    std::copy(cells_, cells_ + cells_size_, cells.data());
+    std::copy(offsets_, offsets_ + cells_size_ + 1, offsets.data());
+    for (size_t ix = 0; ix < size_; ++ix) {
+      x(ix, 0) = boost::geometry::get<0>(points_[ix].first);
+      x(ix, 1) = boost::geometry::get<1>(points_[ix].first);
+      x(ix, 2) = boost::geometry::get<2>(points_[ix].first);
+      u(ix) = points_[ix].second;
+    }
+    return pybind11::make_tuple(system().getstate(), precision_, cells,
+                                offsets, x, u);
+  }
+
+  /// Create a new instance from a registered state of an instance of this
+  /// object.
+  static auto setstate(const pybind11::tuple &state) -> Index {
+    if (state.size() != 6) {
+      throw std::runtime_error("invalid state");
+    }
+    auto system = geodetic::System::setstate(state[0].cast<pybind11::tuple>());
+    auto precision = state[1].cast<uint32_t>();
+    auto cells = state[2].cast<Vector<uint64_t>>();
+    auto offsets = state[3].cast<Vector<uint64_t>>();
+    auto x = state[4].cast<Eigen::MatrixXd>();
+    auto u = state[5].cast<Vector<Type>>();
+    if (offsets.size() != cells.size() + 1 || x.cols() != 3 ||
+        x.rows() != u.size() || offsets(0) != 0 ||
+        offsets(cells.size()) != static_cast<uint64_t>(u.size())) {
+      throw std::runtime_error("invalid state");
+    }
+
+    auto storage = std::make_shared<Storage>();
+    storage->cells.assign(cells.data(), cells.data() + cells.size());
+    storage->offsets.assign(offsets.data(), offsets.data() + offsets.size());
+    storage->points.resize(u.size());
+    for (Eigen::Index ix = 0; ix < u.size(); ++ix) {
+      storage->points[ix] =
+          std::make_pair(point_t(x(ix, 0), x(ix, 1), x(ix, 2)), u(ix));
+    }
+    auto result = Index(precision, system);
+    result.attach(std::move(storage));
+    return result;
+  }
+
+ private:
+  /// Identifier of the files written by save().
+  static constexpr char kMagic[8] = {'P', 'Y', 'I', 'G', 'H', 'I', 'D', 'X'};
+
+  /// Version of the layout of the files written by save().
+  static constexpr uint32_t kVersion = 1;
+
+  /// Header of the files written by save(), followed, at aligned offsets, by
+  /// the codes of the cells, the offsets of their points and the points.
+  struct FileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t precision;
+    uint32_t value_size;
+    uint32_t reserved;
+    double semi_major_axis;
+    double flattening;
+    uint64_t cells;
+    uint64_t size;
+    uint64_t cells_offset;
+    uint64_t offsets_offset;
+    uint64_t points_offset;
+  };
+
+  /// Memory owned by an index built from arrays.
+  struct Storage {
+    std::vector<uint64_t> cells;
+    std::vector<uint64_t> offsets;
+    std::vector<value_t> points;
+  };
+
+  /// System for converting Geodetic coordinates into Cartesian coordinates.
+  detail::geodetic::Coordinates coordinates_;
+
+  /// Number of bits of the geohash codes.
+  uint32_t precision_;
+
+  /// Number of cells of the grid along the longitudes and the latitudes.
+  uint64_t nlon_{}, nlat_{};
+
+  /// Size of the cells in longitude and latitude, in degrees.
+  double dlon_{}, dlat_{};
+
+  /// Memory holding the arrays of the index: a Storage or a mapped file.
+  std::shared_ptr<const void> storage_{};
+
+  /// Sorted codes of the cells holding at least one point.
+  const uint64_t *cells_{nullptr};
+
+  /// Index of the first point of each cell, followed by the number of points.
+  const uint64_t *offsets_{nullptr};
+
+  /// Points sorted by cell.
+  const value_t *points_{nullptr};
+
+  /// Number of cells holding at least one point.
+  size_t cells_size_{0};
+
+  /// Number of points stored.
+  size_t size_{0};
+
+  /// Uses the arrays of the storage provided.
+  auto attach(std::shared_ptr<Storage> storage) -> void {
+    cells_ = storage->cells.data();
+    offsets_ = storage->offsets.data();
+    points_ = storage->points.data();
+    cells_size_ = storage->cells.size();
+    size_ = storage->points.size();
+    storage_ = std::move(storage);
+  }
+
+  /// Rounds an offset of the files up to a multiple of the page-friendly
+  /// alignment of the arrays.
+  static constexpr auto align(const uint64_t offset) -> uint64_t {
+    constexpr auto alignment = uint64_t(64);
+    static_assert(alignment % alignof(value_t) == 0);
+    return (offset + alignment - 1) / alignment * alignment;
+  }
+
+  /// Returns the geohash code of the cell containing a point.
+  [[nodiscard]] auto encode(const double lon, const double lat) const
+      -> uint64_t {
+    return int64::encode({detail::math::normalize_angle(lon, -180.0, 360.0),
+                          std::clamp(lat, -90.0, 90.0)},
+                         precision_);
+  }
+
+  /// Returns the ECEF coordinates of a point located on the ellipsoid.
+  [[nodiscard]] auto ecef(const double lon, const double lat) const
+      -> point_t {
+    return coordinates_.lla_to_ecef(
+        detail::geometry::EquatorialPoint3D<double>{lon, lat, 0});
+  }
+
+  /// Returns the ECEF Z coordinate of the points of the ellipsoid located at
+  /// the given latitude. It increases with the latitude.
+  [[nodiscard]] auto z(const double lat) const -> double {
+    return boost::geometry::get<2>(ecef(0, lat));
+  }
+
+  /// Sorts the keys in parallel: the chunks handled by each thread are
+  /// sorted, then merged two by two.
+  static auto sort(std::vector<std::pair<uint64_t, size_t>> &keys,
+                   size_t num_threads) -> void {
+    if (num_threads == 0) {
+      num_threads = detail::get_num_threads();
+    }
+    const auto chunks = std::max<size_t>(
+        std::min<size_t>(num_threads, keys.size() / kMinChunkSize), 1);
+    auto bounds = std::vector<size_t>(chunks + 1);
+    for (size_t ix = 0; ix <= chunks; ++ix) {
+      bounds[ix] = keys.size() * ix / chunks;
+    }
+    detail::dispatch(
+        [&](size_t start, size_t end) {
+          for (size_t ix = start; ix < end; ++ix) {
+            std::sort(keys.begin() + bounds[ix], keys.begin() + bounds[ix + 1]);
+          }
+        },
+        chunks, num_threads);
+    for (size_t width = 1; width < chunks; width *= 2) {
+      detail::dispatch(
+          [&](size_t start, size_t end) {
+            for (size_t ix = start; ix < end; ++ix) {
+              const auto first = 2 * width * ix;
+              const auto middle = std::min(first + width, chunks);
+              const auto last = std::min(first + 2 * width, chunks);
+              std::inplace_merge(keys.begin() + bounds[first],
+                                 keys.begin() + bounds[middle],
+                                 keys.begin() + bounds[last]);
+            }
+          },
+          (chunks + 2 * width - 1) / (2 * width), num_threads);
+    }
+  }
+
+  /// Minimum number of keys sorted by a thread.
+  static constexpr size_t kMinChunkSize = 65536;
+
+  /// Searches for the K nearest neighbors of a point located within a
+  /// radius.
+  ///
+  /// @param heap Vector receiving the squared distances and the indices of
+  /// the neighbors, sorted by increasing distance.
+  auto nearest(const double lon, const double lat, const uint32_t k,
+               const double radius,
+               std::vector<std::pair<double, size_t>> &heap) const -> void {
+    heap.clear();
+    if (k == 0) {
+      return;
+    }
+    // Inserts the points into the max-heap of the best candidates.
+    const auto bound = radius * radius;
+    explore(
+        lon, lat,
+        [&](const size_t item, const double distance) {
+          if (distance > bound) {
+            return;
+          }
+          if (heap.size() < k) {
+            heap.emplace_back(distance, item);
+            std::push_heap(heap.begin(), heap.end());
+          } else if (distance < heap.front().first) {
+            std::pop_heap(heap.begin(), heap.end());
+            heap.back() = std::make_pair(distance, item);
+            std::push_heap(heap.begin(), heap.end());
+          }
+        },
+        [&]() { return heap.size() == k ? heap.front().first : bound; });
+    std::sort_heap(heap.begin(), heap.end());
+  }
+
+  /// Calls a function with the index and the squared distance of the points
+  /// stored in the cells surrounding a point: its cell first, then blocks of
+  /// cells growing by one cell in each direction, until the points located
+  /// outside the block are farther than the squared distance returned by
+  /// limit().
+  template <typename Visitor, typename Limit>
+  auto explore(double lon, double lat, const Visitor &visitor,
+               const Limit &limit) const -> void {
+    if (size_ == 0 || !std::isfinite(lon) || !std::isfinite(lat)) {
+      return;
+    }
+    lon = detail::math::normalize_angle(lon, -180.0, 360.0);
+    lat = std::clamp(lat, -90.0, 90.0);
+    const auto point = ecef(lon, lat);
+    const auto rho = std::hypot(boost::geometry::get<0>(point),
+                                boost::geometry::get<1>(point));
+    const auto zq = boost::geometry::get<2>(point);
+
+    // Cell of the point in the grid.
+    const auto ix = std::min(
+        static_cast<uint64_t>(std::floor((lon + 180) / dlon_)), nlon_ - 1);
+    const auto jx = std::min(
+        static_cast<uint64_t>(std::floor((lat + 90) / dlat_)), nlat_ - 1);
+
+    // Visits the points of the cells located in a column, between two rows.
+    auto visit = [&](const int64_t di, const uint64_t first,
+                     const uint64_t last) {
+      auto column = (static_cast<int64_t>(ix) + di) %
+                    static_cast<int64_t>(nlon_);
+      column = column < 0 ? column + static_cast<int64_t>(nlon_) : column;
+      for (auto row = first; row <= last; ++row) {
+        auto code = int64::encode(
+            {-180 + (static_cast<double>(column) + 0.5) * dlon_,
+             -90 + (static_cast<double>(row) + 0.5) * dlat_},
+            precision_);
+        auto it = std::lower_bound(cells_, cells_ + cells_size_, code);
+        if (it == cells_ + cells_size_ || *it != code) {
+          continue;
+        }
+        const auto cell = static_cast<size_t>(it - cells_);
+        for (auto item = offsets_[cell]; item < offsets_[cell + 1]; ++item) {
+          visitor(static_cast<size_t>(item),
+                  squared_distance(point, points_[item].first));
+        }
+      }
+    };
+
+    // The block of cells explored covers the rows [south, north] and the
+    // columns [ix - west, ix + east].
+    auto south = jx;
+    auto north = jx;
+    auto west = int64_t(0);
+    auto east = int64_t(0);
+    visit(0, jx, jx);
+
+    while (true) {
+      // Lower bound of the distance between the point and the points located
+      // outside the block. The points beyond a row of cells lie beyond the
+      // plane of constant Z passing through the edge of the row, the points
+      // beyond a column lie beyond the meridian half-plane of its edge.
+      auto outside = std::numeric_limits<double>::infinity();
+      if (south > 0) {
+        outside = std::min(
+            outside, zq - z(-90 + static_cast<double>(south) * dlat_));
+      }
+      if (north < nlat_ - 1) {
+        outside = std::min(
+            outside, z(-90 + static_cast<double>(north + 1) * dlat_) - zq);
+      }
+      const auto covered = static_cast<uint64_t>(west + east + 1) >= nlon_;
+      if (!covered) {
+        auto half_plane = [rho](const double angle) {
+          return angle < detail::math::pi_2<double>() ? rho * std::sin(angle)
+                                                       : rho;
+        };
+        auto x = lon + 180;
+        outside = std::min(
+            {outside,
+             half_plane(detail::math::radians(
+                 x - static_cast<double>(static_cast<int64_t>(ix) - west) *
+                         dlon_)),
+             half_plane(detail::math::radians(
+                 static_cast<double>(static_cast<int64_t>(ix) + east + 1) *
+                     dlon_ -
+                 x))});
+      }
+      outside = std::max(outside, 0.0);
+      if (outside * outside >= limit() ||
+          (south == 0 && north == nlat_ - 1 && covered)) {
+        break;
+      }
+
+      // The block is extended by one cell in each direction: the new columns
+      // are explored in the rows already covered, then the new rows.
+      auto new_west = west;
+      auto new_east = east;
+      if (!covered) {
+        ++new_west;
+        visit(-new_west, south, north);
+        if (static_cast<uint64_t>(new_west + east + 1) < nlon_) {
+          ++new_east;
+          visit(new_east, south, north);
+        }
+      }
+      if (south > 0) {
+        --south;
+        for (auto di = -new_west; di <= new_east; ++di) {
+          visit(di, south, south);
+        }
+      }
+      if (north < nlat_ - 1) {
+        ++north;
+        for (auto di = -new_west; di <= new_east; ++di) {
+          visit(di, north, north);
+        }
+      }
+      west = new_west;
+      east = new_east;
+    }
+  }
+
+  /// Calculates the squared Euclidean distance between two points.
+  static auto squared_distance(const point_t &lhs, const point_t &rhs)
+      -> double {
+    auto dx = boost::geometry::get<0>(lhs) - boost::geometry::get<0>(rhs);
+    auto dy = boost::geometry::get<1>(lhs) - boost::geometry::get<1>(rhs);
+    auto dz = boost::geometry::get<2>(lhs) - boost::geometry::get<2>(rhs);
+    return dx * dx + dy * dy + dz * dz;
+  }
+};
+
+}  // namespace pyinterp::geohash
@@ -11,7 +11,9 @@
 #include <unordered_map>
 
 #include "pyinterp/detail/broadcast.hpp"
+#include "pyinterp/detail/geodetic/area.hpp"
 #include "pyinterp/detail/math.hpp"
+#include "pyinterp/detail/thread.hpp"
 #include "pyinterp/eigen.hpp"
 #include "pyinterp/geodetic/box.hpp"
 #include "pyinterp/geodetic/point.hpp"
@@ -37,16 +39,23 @@ namespace pyinterp::geohash::int64 {
 [[nodiscard]] auto encode(const geodetic::Point& point, uint32_t precision)
     -> uint64_t;
 
-// Encode points into geohash with the given precision
+// Encode points into geohash with the given precision, using num_threads
+// threads (all CPUs if 0).
 [[nodiscard]] inline auto encode(const Eigen::Ref<const Eigen::VectorXd>& lon,
                                  const Eigen::Ref<const Eigen::VectorXd>& lat,
-                                 uint32_t precision) -> Vector<uint64_t> {
+                                 uint32_t precision, size_t num_threads = 1)
+    -> Vector<uint64_t> {
   detail::check_eigen_shape("lon", lon, "lat", lat);
   auto size = lon.size();
   auto result = Vector<uint64_t>(size);
-  for (Eigen::Index ix = 0; ix < size; ++ix) {
-    result(ix) = encode({lon[ix], lat[ix]}, precision);
-  }
+  detail::dispatch(
+      [&](size_t start, size_t end) {
+        for (auto ix = static_cast<Eigen::Index>(start);
+             ix < static_cast<Eigen::Index>(end); ++ix) {
+          result(ix) = encode({lon[ix], lat[ix]}, precision);
+        }
+      },
+      static_cast<size_t>(size), num_threads);
   return result;
 }
 
@@ -64,20 +73,27 @@ namespace pyinterp::geohash::int64 {
   return round ? bbox.round() : bbox.centroid();
 }
 
-// Decode hashes into a geographic points with the given bit depth.
+// Decode hashes into a geographic points with the given bit depth, using
+// num_threads threads (all CPUs if 0).
 // If round is true, the coordinates of the points will be rounded to the
 // accuracy defined by the GeoHash.
 [[nodiscard]] inline auto decode(const Eigen::Ref<const Vector<uint64_t>>& hash,
-                                 const uint32_t precision, const bool center)
+                                 const uint32_t precision, const bool center,
+                                 size_t num_threads = 1)
     -> std::tuple<Eigen::VectorXd, Eigen::VectorXd> {
   auto lon = Eigen::VectorXd(hash.size());
   auto lat = Eigen::VectorXd(hash.size());
 
-  for (Eigen::Index ix = 0; ix < hash.size(); ++ix) {
-    auto point = decode(hash(ix), precision, center);
-    lon[ix] = point.lon();
-    lat[ix] = point.lat();
-  }
+  detail::dispatch(
+      [&](size_t start, size_t end) {
+        for (auto ix = static_cast<Eigen::Index>(start);
+             ix < static_cast<Eigen::Index>(end); ++ix) {
+          auto point = decode(hash(ix), precision, center);
+          lon[ix] = point.lon();
+          lat[ix] = point.lat();
+        }
+      },
+      static_cast<size_t>(hash.size()), num_threads);
   return std::make_tuple(lon, lat);
 }
 
@@ -89,6 +105,18 @@ namespace pyinterp::geohash::int64 {
 [[nodiscard]] auto neighbors(uint64_t hash, uint32_t precision)
     -> Eigen::Matrix<uint64_t, 8, 1>;
 
+// Returns, for each hash, the sorted codes of the cells located at most
+// "rings" cells away from it in longitude and latitude, the cell itself
+// included. The rows of the result hold (2 * rings + 1)^2 items: the cells
+// counted more than once, when the rings go around the globe, and the cells
+// beyond the poles are removed, and the unused items at the end of the rows
+// are set to the largest 64-bit integer.
+[[nodiscard]] auto neighbors(const Eigen::Ref<const Vector<uint64_t>>& hash,
+                             uint32_t precision, uint32_t rings,
+                             size_t num_threads)
+    -> Eigen::Matrix<uint64_t, Eigen::Dynamic, Eigen::Dynamic,
+                     Eigen::RowMajor>;
+
 // Returns the property of the grid covering the given box: geohash of the
 // minimum corner point, number of boxes in longitudes and latitudes.
 [[nodiscard]] auto grid_properties(const geodetic::Box& box, uint32_t precision)
@@ -110,15 +138,36 @@ namespace pyinterp::geohash::int64 {
   return count(geodetic::Box(box).normalize().split(), precision);
 }
 
-// Returns the area covered by the GeoHash
+// Returns the area covered by the GeoHash. The cells being bounded by
+// meridians and parallels, the area is computed in closed form.
 [[nodiscard]] inline auto area(uint64_t hash, uint32_t precision,
                                const std::optional<geodetic::System>& wgs)
     -> double {
-  return bounding_box(hash, precision).area(wgs);
+  const auto box = bounding_box(hash, precision);
+  return detail::geodetic::RectangleArea(wgs.value_or(geodetic::System()))(
+      box.min_corner().lat(), box.max_corner().lat(),
+      box.max_corner().lon() - box.min_corner().lon());
 }
 
+// Returns the areas covered by the GeoHash codes, using num_threads threads
+// (all CPUs if 0). The areas of the cells only depend on their row of
+// latitudes: when the codes outnumber the rows, the area of each row is
+// computed once.
+[[nodiscard]] auto area(const Eigen::Ref<const Vector<uint64_t>>& hash,
+                        uint32_t precision,
+                        const std::optional<geodetic::System>& wgs,
+                        size_t num_threads) -> Eigen::VectorXd;
+
 // Returns all the GeoHash codes within the box.
 [[nodiscard]] auto bounding_boxes(const geodetic::Box& box, uint32_t precision)
     -> Vector<uint64_t>;
 
-}  // namespace pyinterp::geohash::int64
\ No newline at end of file
+// Returns the sorted GeoHash codes of the cells intersecting the polygon.
+// The cells crossed by the boundary of the polygon are refined from a coarse
+// grid, the other cells being kept or discarded with all the cells they
+// contain.
+[[nodiscard]] auto bounding_boxes(const geodetic::Polygon& polygon,
+                                  uint32_t precision, size_t num_threads)
+    -> Vector<uint64_t>;
+
+}  // namespace pyinterp::geohash::int64
\ No newline at end of file
@@ -11,6 +11,7 @@
 #include <unordered_map>
 #include <vector>
 
+#include "pyinterp/detail/geodetic/area.hpp"
 #include "pyinterp/eigen.hpp"
 #include "pyinterp/geodetic/box.hpp"
 #include "pyinterp/geodetic/point.hpp"
@@ -65,10 +66,12 @@ auto allocate_array(size_t size, uint32_t precision) -> Array;
 auto encode(const geodetic::Point& point, char* buffer, uint32_t precision)
     -> void;
 
-/// Encode points into geohash with the given bit depth
+/// Encode points into geohash with the given bit depth, using num_threads
+/// threads (all CPUs if 0).
 [[nodiscard]] auto encode(const Eigen::Ref<const Eigen::VectorXd>& lon,
                           const Eigen::Ref<const Eigen::VectorXd>& lat,
-                          uint32_t precision) -> pybind11::array;
+                          uint32_t precision, size_t num_threads = 1)
+    -> pybind11::array;
 
 /// Returns the region encoded
 [[nodiscard]] auto bounding_box(const char* hash, size_t count)
@@ -80,10 +83,11 @@ auto encode(const geodetic::Point& point, char* buffer, uint32_t precision)
 [[nodiscard]] auto decode(const char* hash, size_t count, bool round)
     -> geodetic::Point;
 
-/// Decode hashes into a spherical equatorial points. If round is true, the
-/// coordinates of the points will be rounded to the accuracy defined by the
-/// GeoHash.
-[[nodiscard]] auto decode(const pybind11::array& hash, bool round)
+/// Decode hashes into a spherical equatorial points, using num_threads
+/// threads (all CPUs if 0). If round is true, the coordinates of the points
+/// will be rounded to the accuracy defined by the GeoHash.
+[[nodiscard]] auto decode(const pybind11::array& hash, bool round,
+                          size_t num_threads = 1)
     -> std::tuple<Eigen::VectorXd, Eigen::VectorXd>;
 
 /// Returns all neighbors hash clockwise from north around northwest at the
@@ -97,18 +101,24 @@ auto encode(const geodetic::Point& point, char* buffer, uint32_t precision)
 [[nodiscard]] inline auto area(const char* const hash, size_t count,
                                const std::optional<geodetic::System>& wgs)
     -> double {
-  return bounding_box(hash, count).area(wgs);
+  const auto box = bounding_box(hash, count);
+  return detail::geodetic::RectangleArea(wgs.value_or(geodetic::System()))(
+      box.min_corner().lat(), box.max_corner().lat(),
+      box.max_corner().lon() - box.min_corner().lon());
 }
 
-/// Returns the area covered by the GeoHash codes
+/// Returns the area covered by the GeoHash codes, using num_threads threads
+/// (all CPUs if 0).
 [[nodiscard]] auto area(const pybind11::array& hash,
-                        const std::optional<geodetic::System>& wgs)
-    -> Eigen::MatrixXd;
+                        const std::optional<geodetic::System>& wgs,
+                        size_t num_threads) -> Eigen::VectorXd;
 
 /// Returns all GeoHash within the given region
 [[nodiscard]] auto bounding_boxes(const std::optional<geodetic::Box>& box,
-                                  uint32_t precision) -> pybind11::array;
+                                  uint32_t precision, size_t num_threads = 1)
+    -> pybind11::array;
 
+/// Returns the sorted GeoHash of the cells intersecting the polygon
 [[nodiscard]] auto bounding_boxes(const geodetic::Polygon& polygon,
                                   uint32_t precision, size_t num_threads)
     -> pybind11::array;
@@ -118,6 +128,12 @@ auto encode(const geodetic::Point& point, char* buffer, uint32_t precision)
     std::string,
     std::tuple<std::tuple<int64_t, int64_t>, std::tuple<int64_t, int64_t>>>;
 
+/// Returns the different GeoHash boxes, in the order of their first
+/// occurrence, and a matrix of shape (n, 4) holding their first and last
+/// rows and their first and last columns.
+[[nodiscard]] auto where_arrays(const pybind11::array& hash)
+    -> std::tuple<pybind11::array, Matrix<int64_t>>;
+
 /// Transforms the given codes from one precision to another. If the given
 /// precision is higher than the precision of the given codes, the result
 /// contains a zoom in, otherwise it contains a zoom out.
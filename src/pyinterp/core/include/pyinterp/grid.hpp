@@ -5,8 +5,14 @@
 #pragma once
 #include <pybind11/numpy.h>
 
+#include <memory>
+#include <string>
+#include <tuple>
+#include <utility>
+
 #include "pyinterp/axis.hpp"
 #include "pyinterp/detail/broadcast.hpp"
+#include "pyinterp/detail/math/bicubic_coefficients.hpp"
 
 namespace pyinterp {
 
@@ -54,14 +60,18 @@ class Grid2D {
   auto operator=(Grid2D&& rhs) noexcept -> Grid2D& = default;
 
   /// Gets the X-Axis
+  ///
+  /// The axes are returned by reference: the threads reading them during an
+  /// interpolation do not touch the reference count of the shared pointer
+  /// holding them.
   [[nodiscard]] inline auto x() const noexcept
-      -> std::shared_ptr<Axis<double>> {
+      -> const std::shared_ptr<Axis<double>>& {
     return x_;
   }
 
   /// Gets the Y-Axis
   [[nodiscard]] inline auto y() const noexcept
-      -> std::shared_ptr<Axis<double>> {
+      -> const std::shared_ptr<Axis<double>>& {
     return y_;
   }
 
@@ -76,6 +86,39 @@ class Grid2D {
     return ptr_(std::forward<Index>(index)...);
   }
 
+  /// Gets the coefficients precomputed for the bicubic interpolation of this
+  /// grid, or a null pointer if they have not been computed.
+  [[nodiscard]] inline auto bicubic_coefficients() const noexcept
+      -> std::shared_ptr<const detail::math::BicubicCoefficients> {
+    return bicubic_coefficients_;
+  }
+
+  /// Sets the coefficients precomputed for the bicubic interpolation of this
+  /// grid. They are shared by the copies of this instance, but are not
+  /// pickled. A null pointer releases them.
+  inline auto bicubic_coefficients(
+      std::shared_ptr<const detail::math::BicubicCoefficients>
+          coefficients) noexcept -> void {
+    bicubic_coefficients_ = std::move(coefficients);
+  }
+
+  /// Returns a view on the region of this grid selected by slices of the
+  /// indexes of its axes. The view shares the values of this grid and those
+  /// of its irregular axes: creating it does not copy them. The coefficients
+  /// precomputed for the bicubic interpolation are not shared.
+  ///
+  /// @param x Indexes of the X-Axis selected.
+  /// @param y Indexes of the Y-Axis selected.
+  [[nodiscard]] auto view(const pybind11::slice& x,
+                          const pybind11::slice& y) const -> Grid2D {
+    auto [x0, x1] = slice_range(x, *x_, "x");
+    auto [y0, y1] = slice_range(y, *y_, "y");
+    return Grid2D(x_->view(x0, x1), y_->view(y0, y1),
+                  array_[pybind11::make_tuple(pybind11::slice(x0, x1, 1),
+                                              pybind11::slice(y0, y1, 1))]
+                      .template cast<pybind11::array_t<DataType>>());
+  }
+
   /// Throws an exception indicating that the value searched on the axis is
   /// outside the domain axis.
   ///
@@ -114,6 +157,35 @@ class Grid2D {
   std::shared_ptr<Axis<double>> y_;
   pybind11::array_t<DataType> array_;
   pybind11::detail::unchecked_reference<DataType, Dimension> ptr_;
+  std::shared_ptr<const detail::math::BicubicCoefficients>
+      bicubic_coefficients_{};
+
+  /// Returns the interval [start, stop) of the indexes of an axis selected by
+  /// a slice.
+  ///
+  /// @param slice Indexes selected.
+  /// @param axis Axis involved.
+  /// @param axis_label The name of the axis
+  template <typename AxisType>
+  static auto slice_range(const pybind11::slice& slice,
+                          const Axis<AxisType>& axis,
+                          const std::string& axis_label)
+      -> std::tuple<pybind11::ssize_t, pybind11::ssize_t> {
+    pybind11::ssize_t start;
+    pybind11::ssize_t stop;
+    pybind11::ssize_t step;
+    pybind11::ssize_t slicelength;
+
+    if (!slice.compute(axis.size(), &start, &stop, &step, &slicelength)) {
+      throw pybind11::error_already_set();
+    }
+    if (step != 1 || slicelength == 0) {
+      throw std::invalid_argument("the slice of the axis " + axis_label +
+                                  " must select contiguous indexes in "
+                                  "ascending order");
+    }
+    return std::make_tuple(start, stop);
+  }
 
   /// End of the recursive call of the function "check_shape"
   void check_shape(const size_t idx) {}
@@ -150,10 +222,30 @@ class Grid3D : public Grid2D<DataType, Dimension> {
 
   /// Gets the Y-Axis
   [[nodiscard]] inline auto z() const noexcept
-      -> std::shared_ptr<Axis<AxisType>> {
+      -> const std::shared_ptr<Axis<AxisType>>& {
     return z_;
   }
 
+  /// Returns a view on the region of this grid selected by slices of the
+  /// indexes of its axes.
+  ///
+  /// @param x Indexes of the X-Axis selected.
+  /// @param y Indexes of the Y-Axis selected.
+  /// @param z Indexes of the Z-Axis selected.
+  /// @see Grid2D::view
+  [[nodiscard]] auto view(const pybind11::slice& x, const pybind11::slice& y,
+                          const pybind11::slice& z) const -> Grid3D {
+    auto [x0, x1] = this->slice_range(x, *this->x_, "x");
+    auto [y0, y1] = this->slice_range(y, *this->y_, "y");
+    auto [z0, z1] = this->slice_range(z, *z_, "z");
+    return Grid3D(this->x_->view(x0, x1), this->y_->view(y0, y1),
+                  z_->view(z0, z1),
+                  this->array_[pybind11::make_tuple(pybind11::slice(x0, x1, 1),
+                                                    pybind11::slice(y0, y1, 1),
+                                                    pybind11::slice(z0, z1, 1))]
+                      .template cast<pybind11::array_t<DataType>>());
+  }
+
   /// Pickle support: get state of this instance
   [[nodiscard]] auto getstate() const -> pybind11::tuple override {
     return pybind11::make_tuple(this->x_->getstate(), this->y_->getstate(),
@@ -197,7 +289,7 @@ class Grid4D : public Grid3D<DataType, AxisType, 4> {
 
   /// Gets the U-Axis
   [[nodiscard]] inline auto u() const noexcept
-      -> std::shared_ptr<Axis<double>> {
+      -> const std::shared_ptr<Axis<double>>& {
     return u_;
   }
 
@@ -228,6 +320,132 @@ class Grid4D : public Grid3D<DataType, AxisType, 4> {
   std::shared_ptr<Axis<double>> u_;
 };
 
+/// Read-only handle on a Cartesian grid 2D, through which the threads
+/// interpolating the grid read it once the GIL is released.
+///
+/// The handle holds raw pointers to the axes of the grid and an unchecked
+/// reference to its values: copying it or reading through it never touches
+/// the reference count of the shared pointers holding the axes, nor that of
+/// the numpy array holding the values. Any number of threads can share it
+/// without synchronization. The grid must outlive the handle, which is the
+/// case for the duration of an interpolation. The precomputed coefficients
+/// are held by a shared pointer, so that they remain valid if new ones are
+/// set on the grid during the interpolation.
+///
+/// @tparam DataType Grid data type
+/// @tparam Dimension Total number of dimensions handled by the grid.
+template <typename DataType, pybind11::ssize_t Dimension = 2>
+class GridHandle2D {
+ public:
+  /// Creates the handle of a grid. The GIL must be held.
+  explicit GridHandle2D(const Grid2D<DataType, Dimension>& grid)
+      : x_(grid.x().get()),
+        y_(grid.y().get()),
+        ptr_(grid.array().template unchecked<Dimension>()),
+        bicubic_coefficients_(grid.bicubic_coefficients()) {}
+
+  /// Gets the X-Axis
+  [[nodiscard]] constexpr auto x() const noexcept -> const Axis<double>* {
+    return x_;
+  }
+
+  /// Gets the Y-Axis
+  [[nodiscard]] constexpr auto y() const noexcept -> const Axis<double>* {
+    return y_;
+  }
+
+  /// Gets the grid value for the coordinate pixel (ix, iy, ...).
+  template <typename... Index>
+  inline auto value(Index&&... index) const noexcept -> const DataType& {
+    return ptr_(std::forward<Index>(index)...);
+  }
+
+  /// Gets the coefficients precomputed for the bicubic interpolation of the
+  /// grid, or a null pointer if they have not been computed.
+  [[nodiscard]] inline auto bicubic_coefficients() const noexcept
+      -> const std::shared_ptr<const detail::math::BicubicCoefficients>& {
+    return bicubic_coefficients_;
+  }
+
+ private:
+  const Axis<double>* x_;
+  const Axis<double>* y_;
+  pybind11::detail::unchecked_reference<DataType, Dimension> ptr_;
+  std::shared_ptr<const detail::math::BicubicCoefficients>
+      bicubic_coefficients_;
+};
+
+/// Read-only handle on a Cartesian grid 3D.
+///
+/// @tparam DataType Grid data type
+/// @tparam AxisType Axis data type
+/// @tparam Dimension Total number of dimensions handled by the grid.
+/// @see GridHandle2D
+template <typename DataType, typename AxisType, pybind11::ssize_t Dimension = 3>
+class GridHandle3D : public GridHandle2D<DataType, Dimension> {
+ public:
+  /// Creates the handle of a grid. The GIL must be held.
+  explicit GridHandle3D(const Grid3D<DataType, AxisType, Dimension>& grid)
+      : GridHandle2D<DataType, Dimension>(grid), z_(grid.z().get()) {}
+
+  /// Gets the Z-Axis
+  [[nodiscard]] constexpr auto z() const noexcept -> const Axis<AxisType>* {
+    return z_;
+  }
+
+ private:
+  const Axis<AxisType>* z_;
+};
+
+/// Read-only handle on a Cartesian grid 4D.
+///
+/// @tparam DataType Grid data type
+/// @tparam AxisType Axis data type
+/// @see GridHandle2D
+template <typename DataType, typename AxisType>
+class GridHandle4D : public GridHandle3D<DataType, AxisType, 4> {
+ public:
+  /// Creates the handle of a grid. The GIL must be held.
+  explicit GridHandle4D(const Grid4D<DataType, AxisType>& grid)
+      : GridHandle3D<DataType, AxisType, 4>(grid), u_(grid.u().get()) {}
+
+  /// Gets the U-Axis
+  [[nodiscard]] constexpr auto u() const noexcept -> const Axis<double>* {
+    return u_;
+  }
+
+ private:
+  const Axis<double>* u_;
+};
+
+/// The grids whose values are not held by a numpy array, or whose values are
+/// decoded when they are read, are read directly by the threads.
+template <typename Grid>
+inline auto make_handle(const Grid& grid) -> const Grid& {
+  return grid;
+}
+
+/// Creates the read-only handle of a grid 2D.
+template <typename DataType>
+inline auto make_handle(const Grid2D<DataType>& grid)
+    -> GridHandle2D<DataType> {
+  return GridHandle2D<DataType>(grid);
+}
+
+/// Creates the read-only handle of a grid 3D.
+template <typename DataType, typename AxisType>
+inline auto make_handle(const Grid3D<DataType, AxisType>& grid)
+    -> GridHandle3D<DataType, AxisType> {
+  return GridHandle3D<DataType, AxisType>(grid);
+}
+
+/// Creates the read-only handle of a grid 4D.
+template <typename DataType, typename AxisType>
+inline auto make_handle(const Grid4D<DataType, AxisType>& grid)
+    -> GridHandle4D<DataType, AxisType> {
+  return GridHandle4D<DataType, AxisType>(grid);
+}
+
 /// Implementations of Cartesian grids with N dimensions.
 ///
 /// @tparam DataType Grid data type
@@ -292,6 +510,22 @@ Gets the values handled by this instance
 
 Returns:
     numpy.ndarray: values
+)__doc__")
+      .def("view", &Grid3D<DataType, AxisType>::view, pybind11::arg("x"),
+           pybind11::arg("y"), pybind11::arg("z"),
+           R"__doc__(
+Returns a view on the region of this grid selected by slices of the indexes of
+its axes.
+
+The view shares the values of this grid and those of its irregular axes:
+creating it does not copy them.
+
+Args:
+    x (slice): Indexes of the X-Axis selected.
+    y (slice): Indexes of the Y-Axis selected.
+    z (slice): Indexes of the Z-Axis selected.
+Returns:
+    The grid of the region selected.
 )__doc__")
       .def(pybind11::pickle(
           [](const Grid3D<DataType, AxisType>& self) {
@@ -419,6 +653,22 @@ Gets the values handled by this instance
 
 Returns:
     numpy.ndarray: values
+)__doc__")
+      .def("view", &Grid2D<DataType>::view, pybind11::arg("x"),
+           pybind11::arg("y"),
+           R"__doc__(
+Returns a view on the region of this grid selected by slices of the indexes of
+its axes.
+
+The view shares the values of this grid and those of its irregular axes:
+creating it does not copy them. The coefficients of the bicubic interpolation
+precomputed for this grid are not shared.
+
+Args:
+    x (slice): Indexes of the X-Axis selected.
+    y (slice): Indexes of the Y-Axis selected.
+Returns:
+    The grid of the region selected.
 )__doc__")
       .def(pybind11::pickle(
           [](const Grid2D<DataType>& self) { return self.getstate(); },
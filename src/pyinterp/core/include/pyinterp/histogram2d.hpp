@@ -7,15 +7,21 @@
 #include <pybind11/stl.h>
 
 #include <Eigen/Core>
+#include <algorithm>
 #include <boost/geometry.hpp>
 #include <iostream>
+#include <numeric>
 #include <optional>
+#include <thread>
+#include <vector>
 
 #include "pyinterp/axis.hpp"
 #include "pyinterp/detail/broadcast.hpp"
-#include "pyinterp/detail/isviewstream.hpp"
+#include "pyinterp/detail/histogram_grid.hpp"
 #include "pyinterp/detail/math/binning.hpp"
 #include "pyinterp/detail/math/streaming_histogram.hpp"
+#include "pyinterp/detail/serialization.hpp"
+#include "pyinterp/detail/thread.hpp"
 #include "pyinterp/eigen.hpp"
 
 namespace pyinterp {
@@ -32,17 +38,15 @@ class Histogram2D {
   ///
   /// @param x Definition of the bin centers for the X axis of the grid.
   /// @param y Definition of the bin centers for the Y axis of the grid.
+  /// @param bin_count Maximum number of bins of the histograms.
+  /// @param sparse If true, only the histograms holding values are stored,
+  /// which saves memory when most of the bins of the grid stay empty.
   Histogram2D(std::shared_ptr<Axis<double>> x, std::shared_ptr<Axis<double>> y,
-              const std::optional<size_t>& bin_count)
-      : x_(std::move(x)), y_(std::move(y)), histogram_(x_->size(), y_->size()) {
-    if (bin_count) {
-      for (int ix = 0; ix < histogram_.rows(); ++ix) {
-        for (int jx = 0; jx < histogram_.cols(); ++jx) {
-          histogram_(ix, jx).resize(*bin_count);
-        }
-      }
-    }
-  }
+              const std::optional<size_t>& bin_count, const bool sparse = false)
+      : x_(std::move(x)),
+        y_(std::move(y)),
+        histogram_(x_->size(), y_->size(), sparse,
+                   bin_count.value_or(StreamingHistogram().bin_count())) {}
 
   /// Default destructor
   virtual ~Histogram2D() = default;
@@ -69,8 +73,20 @@ class Histogram2D {
 
   /// Inserts new values in the grid from Z values for X, Y data
   /// coordinates.
+  ///
+  /// With several threads, the bins of the grid are partitioned between the
+  /// threads, each bin being updated by a single thread with its samples in
+  /// their original order: the result does not depend on the number of
+  /// threads.
+  ///
+  /// @param x X coordinates of the samples.
+  /// @param y Y coordinates of the samples.
+  /// @param z Values of the samples.
+  /// @param num_threads The number of threads to use for the computation. If 0
+  /// all CPUs are used. If 1 is given, no parallel computing code is used at
+  /// all, which is useful for debugging.
   void push(const pybind11::array_t<T>& x, const pybind11::array_t<T>& y,
-            const pybind11::array_t<T>& z) {
+            const pybind11::array_t<T>& z, size_t num_threads) {
     detail::check_array_ndim("x", 1, x, "y", 1, y, "z", 1, z);
     detail::check_ndarray_shape("x", x, "y", y, "z", z);
 
@@ -78,35 +94,27 @@ class Histogram2D {
     auto _y = y.template unchecked<1>();
     auto _z = z.template unchecked<1>();
 
-    {
-      pybind11::gil_scoped_release release;
-
-      const auto& x_axis = static_cast<pyinterp::detail::Axis<double>&>(*x_);
-      const auto& y_axis = static_cast<pyinterp::detail::Axis<double>&>(*y_);
-
-      for (pybind11::ssize_t idx = 0; idx < x.size(); ++idx) {
-        auto value = _z(idx);
-
-        if (!std::isnan(value)) {
-          auto ix = x_axis.find_index(_x(idx), true);
-          auto iy = y_axis.find_index(_y(idx), true);
+    pybind11::gil_scoped_release release;
+    push_samples(_x, _y, _z, x.size(), num_threads);
+  }
 
-          if (ix != -1 && iy != -1) {
-            histogram_(ix, iy)(value);
-          }
-        }
-      }
-    }
+  /// Inserts new values in the grid from Z values for X, Y data
+  /// coordinates, held by contiguous buffers. Unlike push, this method does
+  /// not use the Python interpreter: it must be called without the GIL.
+  ///
+  /// @param x X coordinates of the samples.
+  /// @param y Y coordinates of the samples.
+  /// @param z Values of the samples.
+  /// @param num_threads The number of threads to use for the computation.
+  void ingest(const Eigen::Ref<const Vector<T>>& x,
+              const Eigen::Ref<const Vector<T>>& y,
+              const Eigen::Ref<const Vector<T>>& z, const size_t num_threads) {
+    detail::check_eigen_shape("x", x, "y", y, "z", z);
+    push_samples(x, y, z, x.size(), num_threads);
   }
 
   /// Reset the statistics.
-  void clear() {
-    for (Eigen::Index ix = 0; ix < histogram_.rows(); ++ix) {
-      for (Eigen::Index jx = 0; jx < histogram_.cols(); ++jx) {
-        histogram_(ix, jx).clear();
-      }
-    }
-  }
+  void clear() { histogram_.clear(); }
 
   /// Compute the count of points within each bin.
   [[nodiscard]] auto count() const -> pybind11::array_t<uint64_t> {
@@ -144,6 +152,56 @@ class Histogram2D {
     return calculate_statistics(&StreamingHistogram::quantile, q);
   }
 
+  /// Compute several quantiles of values for points within each bin. The
+  /// quantiles of a bin are computed in a single pass over its histogram,
+  /// and the bins are processed in parallel.
+  ///
+  /// @param q Quantiles to compute.
+  /// @param num_threads The number of threads to use for the computation.
+  /// @return an array of shape (nx, ny, len(q)).
+  [[nodiscard]] auto quantiles(
+      const pybind11::array_t<T, pybind11::array::c_style |
+                                     pybind11::array::forcecast>& q,
+      const size_t num_threads) const -> pybind11::array_t<T> {
+    detail::check_array_ndim("q", 1, q);
+    auto order = std::vector<size_t>();
+    auto sorted = std::vector<T>();
+    std::tie(order, sorted) = detail::math::sort_quantiles(q.data(), q.size());
+    const auto size = sorted.size();
+    auto result = pybind11::array_t<T>(pybind11::array::ShapeContainer(
+        {x_->size(), y_->size(), static_cast<pybind11::ssize_t>(size)}));
+    auto _result = result.template mutable_unchecked<3>();
+    {
+      auto gil = pybind11::gil_scoped_release();
+
+      // The histograms not stored by a sparse grid are empty.
+      if (histogram_.sparse()) {
+        std::fill_n(_result.mutable_data(0, 0, 0), _result.size(),
+                    std::numeric_limits<T>::quiet_NaN());
+      }
+      auto cells = std::vector<std::pair<uint64_t, const Cell*>>();
+      histogram_.for_each([&](const uint64_t index, const Cell& cell) {
+        cells.emplace_back(index, &cell);
+      });
+      const auto rows = histogram_.rows();
+      detail::dispatch(
+          [&](const size_t start, const size_t end) {
+            auto item = StreamingHistogram(histogram_.bin_count(), false);
+            auto values = std::vector<T>(size);
+            for (auto ix = start; ix < end; ++ix) {
+              const auto index = cells[ix].first;
+              histogram_.load(*cells[ix].second, item);
+              item.quantiles(sorted.data(), size, values.data());
+              for (size_t jx = 0; jx < size; ++jx) {
+                _result(index % rows, index / rows, order[jx]) = values[jx];
+              }
+            }
+          },
+          cells.size(), num_threads);
+    }
+    return result;
+  }
+
   /// Compute the skewness of values for points within each bin.
   [[nodiscard]] auto skewness() const -> pybind11::array_t<T> {
     return calculate_statistics(&StreamingHistogram::skewness);
@@ -163,15 +221,21 @@ class Histogram2D {
     return y_;
   }
 
+  /// Returns true if only the histograms holding values are stored.
+  [[nodiscard]] inline auto sparse() const noexcept -> bool {
+    return histogram_.sparse();
+  }
+
   /// Pickle support: get state of this instance
   [[nodiscard]] auto getstate() const -> pybind11::tuple {
-    return pybind11::make_tuple(x_->getstate(), y_->getstate(), marshal());
+    return pybind11::make_tuple(x_->getstate(), y_->getstate(), marshal(),
+                                histogram_.sparse());
   }
 
   /// Pickle support: set state of this instance
   static auto setstate(const pybind11::tuple& state)
       -> std::unique_ptr<Histogram2D<T>> {
-    if (state.size() != 3) {
+    if (state.size() != 3 && state.size() != 4) {
       throw std::invalid_argument("invalid state");
     }
 
@@ -184,44 +248,54 @@ class Histogram2D {
     *y = Axis<double>::setstate(state[1].cast<pybind11::tuple>());
 
     // Unmarshalling instance
-    auto result = std::make_unique<Histogram2D<T>>(x, y, 40);
+    // The previous versions did not store the storage mode.
+    auto sparse = state.size() == 4 && state[3].cast<bool>();
+    auto result =
+        std::make_unique<Histogram2D<T>>(x, y, std::nullopt, sparse);
     auto marshal_data = state[2].cast<pybind11::bytes>();
-    Histogram2D::unmarshal(marshal_data.cast<std::string_view>(),
-                           result->histogram_);
+    result->unmarshal(marshal_data.cast<std::string_view>(), true);
     return result;
   }
 
+  /// Merges the statistics of the state of another instance, returned by
+  /// getstate(), without creating this instance: the histograms are read
+  /// directly from the serialized buffer.
+  auto merge(const pybind11::tuple& state) -> void {
+    if (state.size() != 3 && state.size() != 4) {
+      throw std::invalid_argument("invalid state");
+    }
+    if (*x_ != Axis<double>::setstate(state[0].cast<pybind11::tuple>()) ||
+        *y_ != Axis<double>::setstate(state[1].cast<pybind11::tuple>())) {
+      throw std::invalid_argument("Unable to combine different grids");
+    }
+    auto marshal_data = state[2].cast<pybind11::bytes>();
+    unmarshal(marshal_data.cast<std::string_view>(), false);
+  }
+
   /// Aggregation of statistics
   auto operator+=(const Histogram2D& other) -> Histogram2D& {
     if (*x_ != *(other.x_) || *y_ != *(other.y_)) {
       throw std::invalid_argument("Unable to combine different grids");
     }
-    for (Eigen::Index ix = 0; ix < histogram_.rows(); ++ix) {
-      for (Eigen::Index iy = 0; iy < histogram_.cols(); ++iy) {
-        auto& lhs = histogram_(ix, iy);
-        auto& rhs = other.histogram_(ix, iy);
-
-        // Statistics are defined only in the other instance.
-        if (lhs.size() == 0 && rhs.size() != 0) {
-          lhs = rhs;
-          // If the statistics are defined in both instances they can be
-          // combined.
-        } else if (lhs.size() != 0 && rhs.size() != 0) {
-          lhs += rhs;
-        }
+    auto lhs = StreamingHistogram();
+    auto rhs = StreamingHistogram();
+    other.histogram_.for_each([&](const uint64_t index, const Cell& cell) {
+      if (cell.size != 0) {
+        other.histogram_.load(cell, rhs);
+        histogram_.load(index, lhs);
+        merge(lhs, rhs);
+        histogram_.store(index, lhs);
       }
-    }
+    });
     return *this;
   }
 
   /// Returns the histogram for each bin.
   auto histograms() const -> pybind11::array_t<detail::math::Bin<T>> {
     auto bins_count = size_t(0);
-    for (Eigen::Index ix = 0; ix < histogram_.rows(); ++ix) {
-      for (Eigen::Index iy = 0; iy < histogram_.cols(); ++iy) {
-        bins_count = std::max(bins_count, histogram_(ix, iy).size());
-      }
-    }
+    histogram_.for_each([&](const uint64_t, const Cell& cell) {
+      bins_count = std::max<size_t>(bins_count, cell.size);
+    });
     auto result =
         pybind11::array_t<detail::math::Bin<T>>(pybind11::array::ShapeContainer(
             {x_->size(), y_->size(),
@@ -229,31 +303,149 @@ class Histogram2D {
     auto _result = result.template mutable_unchecked<3>();
     {
       auto gil = pybind11::gil_scoped_release();
+      const auto empty =
+          detail::math::Bin<T>{std::numeric_limits<T>::quiet_NaN(), T(0)};
 
-      for (Eigen::Index ix = 0; ix < histogram_.rows(); ++ix) {
-        for (Eigen::Index iy = 0; iy < histogram_.cols(); ++iy) {
-          auto iz = size_t(0);
-          auto& bins = histogram_(ix, iy).bins();
-          for (iz = 0; iz < bins.size(); ++iz) {
-            _result(ix, iy, iz) = bins[iz];
-          }
-          for (; iz < bins_count; ++iz) {
-            _result(ix, iy, iz) =
-                detail::math::Bin<T>{std::numeric_limits<T>::quiet_NaN(), T(0)};
-          }
-        }
+      // The histograms not stored by a sparse grid are empty.
+      if (histogram_.sparse()) {
+        std::fill_n(_result.mutable_data(0, 0, 0), _result.size(), empty);
       }
+      const auto rows = histogram_.rows();
+      histogram_.for_each([&](const uint64_t index, const Cell& cell) {
+        const auto ix = static_cast<pybind11::ssize_t>(index % rows);
+        const auto iy = static_cast<pybind11::ssize_t>(index / rows);
+        const auto* bins = histogram_.bins(cell);
+        auto iz = size_t(0);
+        for (iz = 0; iz < cell.size; ++iz) {
+          _result(ix, iy, iz) = bins[iz];
+        }
+        for (; iz < bins_count; ++iz) {
+          _result(ix, iy, iz) = empty;
+        }
+      });
     }
     return result;
   }
 
  private:
+  /// Minimum number of samples inserted in parallel.
+  static constexpr size_t kMinParallelSize = 4096;
+
+  /// Number of samples whose bins are sorted at once.
+  static constexpr size_t kChunkSize = 1 << 20;
+
+  /// Number of parts of the grid processed by each thread.
+  static constexpr size_t kPartsPerThread = 8;
+
   /// Grid axis
   std::shared_ptr<Axis<double>> x_;
   std::shared_ptr<Axis<double>> y_;
 
+  /// Statistics of a bin of the grid
+  using Cell = typename detail::HistogramGrid<T>::Cell;
+
   /// Statistics grid
-  Matrix<StreamingHistogram> histogram_;
+  detail::HistogramGrid<T> histogram_;
+
+  /// Inserts the samples read by the given accessors, without the GIL.
+  ///
+  /// @param size Number of samples.
+  template <typename Accessor>
+  void push_samples(const Accessor& _x, const Accessor& _y, const Accessor& _z,
+                    const pybind11::ssize_t size, size_t num_threads) {
+    const auto& x_axis = static_cast<pyinterp::detail::Axis<double>&>(*x_);
+    const auto& y_axis = static_cast<pyinterp::detail::Axis<double>&>(*y_);
+
+    // Index of the bin containing a sample, or -1 if the sample is not
+    // binned.
+    auto find_bin = [&](const pybind11::ssize_t idx) -> int64_t {
+      if (!std::isnan(_z(idx))) {
+        auto ix = x_axis.find_index(_x(idx), true);
+        auto iy = y_axis.find_index(_y(idx), true);
+
+        if (ix != -1 && iy != -1) {
+          return static_cast<int64_t>(histogram_.index(ix, iy));
+        }
+      }
+      return -1;
+    };
+
+    if (num_threads == 0) {
+      num_threads = detail::get_num_threads();
+    }
+    if (static_cast<size_t>(size) < kMinParallelSize) {
+      num_threads = 1;
+    }
+
+    // The bins are split into contiguous parts, more numerous than the
+    // threads to balance the load. The samples are processed by chunks:
+    // the bins of the samples are searched in parallel, then the samples
+    // are sorted by part, keeping their order, with a counting sort. Each
+    // part sorts its samples by bin, still keeping their order, and updates
+    // the histogram of each bin once, through a working copy.
+    const auto bins = histogram_.size();
+    const auto parts = std::min<int64_t>(
+        bins, static_cast<int64_t>(num_threads * kPartsPerThread));
+    auto cells = std::vector<int64_t>();
+    auto order = std::vector<size_t>();
+    auto offsets = std::vector<size_t>(parts + 1);
+
+    for (size_t first = 0; first < static_cast<size_t>(size);
+         first += kChunkSize) {
+      const auto count =
+          std::min(kChunkSize, static_cast<size_t>(size) - first);
+      cells.resize(count);
+      detail::dispatch(
+          [&](const size_t start, const size_t end) {
+            for (auto ix = start; ix < end; ++ix) {
+              cells[ix] =
+                  find_bin(static_cast<pybind11::ssize_t>(first + ix));
+            }
+          },
+          count, num_threads);
+
+      std::fill(offsets.begin(), offsets.end(), 0);
+      for (auto cell : cells) {
+        if (cell != -1) {
+          ++offsets[cell * parts / bins + 1];
+        }
+      }
+      std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+      order.resize(offsets.back());
+      auto cursor = std::vector<size_t>(offsets.begin(), offsets.end() - 1);
+      for (size_t ix = 0; ix < count; ++ix) {
+        if (cells[ix] != -1) {
+          order[cursor[cells[ix] * parts / bins]++] = ix;
+          // The storage of the new bins cannot be allocated concurrently:
+          // it is allocated before the bins are updated by the threads.
+          histogram_.reserve(cells[ix]);
+        }
+      }
+
+      detail::dispatch(
+          [&](const size_t start, const size_t end) {
+            auto histogram = StreamingHistogram();
+            for (auto part = start; part < end; ++part) {
+              const auto last = order.begin() + offsets[part + 1];
+              auto it = order.begin() + offsets[part];
+              std::stable_sort(it, last, [&](const size_t lhs,
+                                             const size_t rhs) {
+                return cells[lhs] < cells[rhs];
+              });
+              while (it != last) {
+                const auto cell = cells[*it];
+                histogram_.load(cell, histogram);
+                for (; it != last && cells[*it] == cell; ++it) {
+                  histogram.buffer(
+                      _z(static_cast<pybind11::ssize_t>(first + *it)));
+                }
+                histogram_.store(cell, histogram);
+              }
+            }
+          },
+          parts, num_threads, detail::kDynamic);
+    }
+  }
 
   /// Calculation of a given statistical variable.
   template <typename Func, typename Type = T, typename... Args>
@@ -264,59 +456,121 @@ class Histogram2D {
     {
       pybind11::gil_scoped_release release;
 
-      for (Eigen::Index ix = 0; ix < histogram_.rows(); ++ix) {
-        for (Eigen::Index iy = 0; iy < histogram_.cols(); ++iy) {
-          _z(ix, iy) = (histogram_(ix, iy).*func)(args...);
-        }
+      // The histograms not stored by a sparse grid are empty.
+      auto item = StreamingHistogram(histogram_.bin_count(), false);
+      if (histogram_.sparse()) {
+        std::fill_n(_z.mutable_data(0, 0), _z.size(),
+                    static_cast<Type>((item.*func)(args...)));
       }
+      const auto rows = histogram_.rows();
+      histogram_.for_each([&](const uint64_t index, const Cell& cell) {
+        histogram_.load(cell, item);
+        _z(index % rows, index / rows) = (item.*func)(args...);
+      });
     }
     return z;
   }
 
+  /// Combines the statistics of a bin with those of another one.
+  static inline void merge(StreamingHistogram& lhs,
+                           const StreamingHistogram& rhs) {
+    // Statistics are defined only in the other instance.
+    if (lhs.size() == 0 && rhs.size() != 0) {
+      lhs = rhs;
+      // If the statistics are defined in both instances they can be
+      // combined.
+    } else if (lhs.size() != 0 && rhs.size() != 0) {
+      lhs += rhs;
+    }
+  }
+
+  /// Serializes the histograms: a header listing the bins holding values,
+  /// the maximum number of bins of the histograms, then the histograms of the
+  /// bins listed. The empty bins are not written.
   [[nodiscard]] auto marshal() const -> pybind11::bytes {
-    auto gil = pybind11::gil_scoped_release();
-    auto ss = std::stringstream();
-    ss.exceptions(std::stringstream::failbit);
-    auto rows = histogram_.rows();
-    ss.write(reinterpret_cast<const char*>(&rows), sizeof(rows));
-    auto cols = histogram_.cols();
-    ss.write(reinterpret_cast<const char*>(&cols), sizeof(cols));
-    for (int ix = 0; ix < histogram_.rows(); ++ix) {
-      for (int jx = 0; jx < histogram_.cols(); ++jx) {
-        auto marshal_hist = static_cast<std::string>(histogram_(ix, jx));
-        auto size = marshal_hist.size();
-        ss.write(reinterpret_cast<const char*>(&size), sizeof(size));
-        ss.write(marshal_hist.c_str(), static_cast<std::streamsize>(size));
+    auto buffer = std::string();
+    {
+      auto gil = pybind11::gil_scoped_release();
+      const auto cells = histogram_.indexes();
+      auto writer = detail::serialization::Writer();
+      detail::serialization::write_grid_header(writer, histogram_.rows(),
+                                               histogram_.cols(), cells);
+      writer.write(histogram_.bin_count());
+      auto item = StreamingHistogram();
+      for (const auto& ix : cells) {
+        histogram_.load(ix, item);
+        item.marshal(writer);
       }
+      buffer = std::move(writer).str();
     }
-    return ss.str();
+    return buffer;
   }
 
-  static auto unmarshal(const std::string_view& data,
-                        Matrix<StreamingHistogram>& histogram) -> void {
+  /// Merges the histograms serialized by marshal() into this instance. The
+  /// format of the previous versions, storing all the histograms, is also
+  /// accepted.
+  ///
+  /// @param data Serialized histograms.
+  /// @param restore True if this instance is empty and must be restored from
+  /// the serialized data: the histograms are then copied with their
+  /// maximum number of bins.
+  auto unmarshal(const std::string_view& data, const bool restore) -> void {
     auto gil = pybind11::gil_scoped_release();
-    auto ss = detail::isviewstream(data);
-    ss.exceptions(std::stringstream::failbit);
-
-    try {
-      auto rows = Eigen::Index(0);
-      auto cols = Eigen::Index(0);
-      ss.read(reinterpret_cast<char*>(&rows), sizeof(rows));
-      ss.read(reinterpret_cast<char*>(&cols), sizeof(cols));
-      if (rows != histogram.rows() || cols != histogram.cols()) {
+    auto reader = detail::serialization::Reader(data);
+    auto lhs = StreamingHistogram();
+
+    // Previous format: the number of rows and columns, then the size and the
+    // serialized state of each histogram.
+    if (reader.read<int64_t>() != detail::serialization::kGridTag) {
+      reader = detail::serialization::Reader(data);
+      if (reader.read<Eigen::Index>() != histogram_.rows() ||
+          reader.read<Eigen::Index>() != histogram_.cols()) {
         throw std::invalid_argument("invalid state");
       }
-      for (int ix = 0; ix < rows; ++ix) {
-        for (int jx = 0; jx < cols; ++jx) {
-          auto size = size_t(0);
-          ss.read(reinterpret_cast<char*>(&size), sizeof(size));
+      for (int ix = 0; ix < histogram_.rows(); ++ix) {
+        for (int jx = 0; jx < histogram_.cols(); ++jx) {
+          const auto size = reader.read<size_t>();
+          if (size > reader.size()) {
+            throw std::invalid_argument("invalid state");
+          }
           auto marshal_hist = std::string(size, '\0');
-          ss.read(marshal_hist.data(), static_cast<std::streamsize>(size));
-          histogram(ix, jx) = std::move(StreamingHistogram(marshal_hist));
+          reader.read(marshal_hist.data(), size);
+          auto item = StreamingHistogram(marshal_hist);
+          // All the histograms of the grid have the same maximum number of
+          // bins, that of the empty histograms.
+          if (restore && ix == 0 && jx == 0) {
+            histogram_ = detail::HistogramGrid<T>(
+                histogram_.rows(), histogram_.cols(), histogram_.sparse(),
+                item.bin_count());
+          }
+          if (item.size() != 0) {
+            const auto index = histogram_.index(ix, jx);
+            histogram_.load(index, lhs);
+            merge(lhs, item);
+            histogram_.store(index, lhs);
+          }
         }
       }
-    } catch (std::ios_base::failure&) {
-      throw std::invalid_argument("invalid state");
+      return;
+    }
+
+    reader = detail::serialization::Reader(data);
+    const auto cells = detail::serialization::read_grid_header(
+        reader, histogram_.rows(), histogram_.cols());
+    const auto bin_count = reader.read<size_t>();
+    if (restore) {
+      histogram_ = detail::HistogramGrid<T>(
+          histogram_.rows(), histogram_.cols(), histogram_.sparse(), bin_count);
+    }
+    for (const auto& ix : cells) {
+      auto item = StreamingHistogram(reader);
+      if (restore) {
+        histogram_.store(ix, item);
+      } else {
+        histogram_.load(ix, lhs);
+        merge(lhs, item);
+        histogram_.store(ix, lhs);
+      }
     }
   }
 };
@@ -0,0 +1,409 @@
+// Copyright (c) 2022 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+#pragma once
+#include <pybind11/eigen.h>
+#include <pybind11/numpy.h>
+#include <pybind11/pybind11.h>
+
+#include <Eigen/Core>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "pyinterp/axis.hpp"
+#include "pyinterp/bivariate.hpp"
+#include "pyinterp/detail/broadcast.hpp"
+#include "pyinterp/detail/math/binning.hpp"
+#include "pyinterp/detail/math/regridding.hpp"
+#include "pyinterp/detail/numpy.hpp"
+#include "pyinterp/detail/thread.hpp"
+#include "pyinterp/eigen.hpp"
+#include "pyinterp/geodetic/system.hpp"
+
+namespace pyinterp {
+
+/// Interpolation of a fixed set of points from the values of grids sharing
+/// the same axes.
+///
+/// The plan holds, for each point, the indexes of the grid values used by the
+/// interpolation and their weights, as the rows of a sparse matrix in CSR
+/// format. Applying the plan to the values of a grid is a sparse matrix-vector
+/// product: the cells framing the points are searched, and the weights
+/// computed, once for all the grids interpolated.
+class InterpolationPlan {
+ public:
+  /// Creates a plan from its CSR representation.
+  ///
+  /// @param nx Number of values of the grid along the X axis.
+  /// @param ny Number of values of the grid along the Y axis.
+  /// @param indptr Positions of the first entry of each row, and of the end of
+  /// the last row.
+  /// @param indices Flat indexes of the grid values (ix * ny + iy).
+  /// @param weights Weights of the grid values.
+  InterpolationPlan(const int64_t nx, const int64_t ny, Vector<int64_t> indptr,
+                    Vector<int64_t> indices, Vector<double> weights)
+      : nx_(nx),
+        ny_(ny),
+        indptr_(std::move(indptr)),
+        indices_(std::move(indices)),
+        weights_(std::move(weights)) {
+    if (indptr_.size() == 0 || indptr_(0) != 0 ||
+        indptr_(indptr_.size() - 1) != indices_.size() ||
+        indices_.size() != weights_.size()) {
+      throw std::invalid_argument("invalid CSR representation");
+    }
+    for (Eigen::Index ix = 0; ix < indices_.size(); ++ix) {
+      if (indices_(ix) < 0 || indices_(ix) >= nx_ * ny_) {
+        throw std::invalid_argument("grid index out of range");
+      }
+    }
+  }
+
+  /// Gets the number of points interpolated.
+  [[nodiscard]] inline auto size() const noexcept -> int64_t {
+    return indptr_.size() - 1;
+  }
+
+  /// Gets the shape of the grids handled by the plan.
+  [[nodiscard]] inline auto shape() const noexcept
+      -> std::tuple<int64_t, int64_t> {
+    return {nx_, ny_};
+  }
+
+  /// Gets the positions of the first entry of each row.
+  [[nodiscard]] inline auto indptr() const noexcept -> const Vector<int64_t>& {
+    return indptr_;
+  }
+
+  /// Gets the flat indexes of the grid values.
+  [[nodiscard]] inline auto indices() const noexcept
+      -> const Vector<int64_t>& {
+    return indices_;
+  }
+
+  /// Gets the weights of the grid values.
+  [[nodiscard]] inline auto weights() const noexcept -> const Vector<double>& {
+    return weights_;
+  }
+
+  /// Interpolates the values of a grid. The points outside the grid are set
+  /// to NaN.
+  ///
+  /// @param array Values of the grid, of shape (nx, ny).
+  /// @param normalize If true, the undefined values of the grid are ignored:
+  /// the weights of the defined values are divided by their sum. The points
+  /// using only undefined values are set to NaN.
+  /// @param num_threads The number of threads to use for the computation.
+  /// @param out Array in which the interpolated values are written.
+  template <typename T>
+  auto apply(const pybind11::array_t<T, pybind11::array::c_style>& array,
+             const bool normalize, const size_t num_threads,
+             const std::optional<pybind11::array>& out) const
+      -> pybind11::array_t<double> {
+    detail::check_array_ndim("array", 2, array);
+    if (array.shape(0) != nx_ || array.shape(1) != ny_) {
+      throw std::invalid_argument(
+          "array must have the shape of the grids handled by the plan: (" +
+          std::to_string(nx_) + ", " + std::to_string(ny_) + ")");
+    }
+    auto result = detail::numpy::output_array<double>("out", out, {size()});
+    const auto* values = array.data();
+    auto* _result = result.mutable_data();
+    {
+      pybind11::gil_scoped_release release;
+      detail::dispatch(
+          [&](const size_t start, const size_t end) {
+            for (auto ix = static_cast<int64_t>(start);
+                 ix < static_cast<int64_t>(end); ++ix) {
+              const auto first = indptr_(ix);
+              const auto last = indptr_(ix + 1);
+              if (first == last) {
+                _result[ix] = std::numeric_limits<double>::quiet_NaN();
+                continue;
+              }
+              auto value = 0.0;
+              if (!normalize) {
+                for (auto jx = first; jx < last; ++jx) {
+                  value +=
+                      weights_(jx) * static_cast<double>(values[indices_(jx)]);
+                }
+                _result[ix] = value;
+                continue;
+              }
+              auto sum_of_weights = 0.0;
+              for (auto jx = first; jx < last; ++jx) {
+                const auto item = static_cast<double>(values[indices_(jx)]);
+                if (!std::isnan(item)) {
+                  value += weights_(jx) * item;
+                  sum_of_weights += weights_(jx);
+                }
+              }
+              _result[ix] = sum_of_weights != 0
+                                ? value / sum_of_weights
+                                : std::numeric_limits<double>::quiet_NaN();
+            }
+          },
+          size(), num_threads);
+    }
+    return result;
+  }
+
+  /// Get a tuple that fully encodes the state of this instance
+  [[nodiscard]] auto getstate() const -> pybind11::tuple {
+    return pybind11::make_tuple(nx_, ny_, indptr_, indices_, weights_);
+  }
+
+  /// Create a new instance from a registered state of an instance
+  static auto setstate(const pybind11::tuple& state) -> InterpolationPlan {
+    if (state.size() != 5) {
+      throw std::runtime_error("invalid state");
+    }
+    return {state[0].cast<int64_t>(), state[1].cast<int64_t>(),
+            state[2].cast<Vector<int64_t>>(), state[3].cast<Vector<int64_t>>(),
+            state[4].cast<Vector<double>>()};
+  }
+
+ private:
+  int64_t nx_;
+  int64_t ny_;
+  Vector<int64_t> indptr_;
+  Vector<int64_t> indices_;
+  Vector<double> weights_;
+};
+
+/// Builds the plan of the bivariate interpolation of points on grids defined
+/// by the given axes.
+///
+/// The interpolator must be linear in the grid values, which is the case of
+/// the built-in interpolators. The weight of each corner of the cell framing a
+/// point is obtained by interpolating the indicator of this corner. A corner
+/// whose value is ignored by the interpolator (e.g. the corners other than the
+/// nearest one) is not stored, so that an undefined value propagates to the
+/// result exactly as with the direct interpolation.
+///
+/// @tparam Point A type of point defining a point in space.
+/// @tparam Coordinate The type of data used by the interpolators.
+template <template <class> class Point, typename Coordinate>
+auto bivariate_plan(
+    const Axis<double>& x_axis, const Axis<double>& y_axis,
+    const pybind11::array& x, const pybind11::array& y,
+    const BivariateInterpolator<Point, Coordinate>* interpolator,
+    const bool bounds_error, const size_t num_threads) -> InterpolationPlan {
+  pyinterp::detail::check_array_ndim("x", 1, x, "y", 1, y);
+  pyinterp::detail::check_ndarray_shape("x", x, "y", y);
+
+  auto size = x.size();
+  auto _x = detail::numpy::ArrayReader<Coordinate>(x);
+  auto _y = detail::numpy::ArrayReader<Coordinate>(y);
+  const auto ny = static_cast<int64_t>(y_axis.size());
+
+  // Each point uses at most the four corners of its cell: the entries are
+  // computed in parallel in fixed slots, then packed.
+  auto counts = Vector<int64_t>(size);
+  auto slot_indices = Matrix<int64_t>(size, 4);
+  auto slot_weights = Matrix<double>(size, 4);
+
+  {
+    pybind11::gil_scoped_release release;
+
+    detail::math::visit(interpolator, [&](const auto* concrete) {
+      detail::dispatch(
+          [&](const size_t start, const size_t end) {
+            auto q = std::array<Coordinate, 4>();
+            for (auto ix = static_cast<int64_t>(start);
+                 ix < static_cast<int64_t>(end); ++ix) {
+              counts(ix) = 0;
+              auto xi = _x(ix);
+              auto yi = _y(ix);
+              auto x_indexes = x_axis.find_indexes(xi);
+              auto y_indexes = y_axis.find_indexes(yi);
+              if (!x_indexes.has_value() || !y_indexes.has_value()) {
+                if (bounds_error) {
+                  if (!x_indexes.has_value()) {
+                    Grid2D<double>::index_error(x_axis, xi, "x");
+                  }
+                  Grid2D<double>::index_error(y_axis, yi, "y");
+                }
+                continue;
+              }
+              auto [ix0, ix1] = *x_indexes;
+              auto [iy0, iy1] = *y_indexes;
+
+              auto x0 = x_axis(ix0);
+              auto p = Point<Coordinate>(x_axis.normalize_coordinate(xi, x0),
+                                         yi);
+              auto p0 = Point<Coordinate>(x0, y_axis(iy0));
+              auto p1 = Point<Coordinate>(x_axis(ix1), y_axis(iy1));
+
+              // Corners in the order of the arguments of "evaluate".
+              const auto corners = std::array<int64_t, 4>{
+                  ix0 * ny + iy0, ix0 * ny + iy1, ix1 * ny + iy0,
+                  ix1 * ny + iy1};
+              for (size_t jx = 0; jx < 4; ++jx) {
+                q.fill(0);
+                q[jx] = std::numeric_limits<Coordinate>::quiet_NaN();
+                if (!std::isnan(concrete->evaluate(p, p0, p1, q[0], q[1], q[2],
+                                                   q[3]))) {
+                  continue;
+                }
+                q[jx] = 1;
+                auto& count = counts(ix);
+                slot_indices(ix, count) = corners[jx];
+                slot_weights(ix, count) = static_cast<double>(
+                    concrete->evaluate(p, p0, p1, q[0], q[1], q[2], q[3]));
+                ++count;
+              }
+            }
+          },
+          size, num_threads);
+    });
+  }
+
+  auto indptr = Vector<int64_t>(size + 1);
+  indptr(0) = 0;
+  for (Eigen::Index ix = 0; ix < static_cast<Eigen::Index>(size); ++ix) {
+    indptr(ix + 1) = indptr(ix) + counts(ix);
+  }
+  auto indices = Vector<int64_t>(indptr(size));
+  auto weights = Vector<double>(indptr(size));
+  for (Eigen::Index ix = 0; ix < static_cast<Eigen::Index>(size); ++ix) {
+    for (int64_t jx = 0; jx < counts(ix); ++jx) {
+      indices(indptr(ix) + jx) = slot_indices(ix, jx);
+      weights(indptr(ix) + jx) = slot_weights(ix, jx);
+    }
+  }
+  return {static_cast<int64_t>(x_axis.size()), ny, std::move(indptr),
+          std::move(indices), std::move(weights)};
+}
+
+/// Builds the plan of the first-order conservative regridding between two
+/// grids.
+///
+/// The values of a grid are the means of the field over cells centered on
+/// the values of its axes and bounded by the middles of the consecutive
+/// values. The value of a target cell is the mean of the values of the source
+/// cells it intersects, weighted by the areas of the intersections; the
+/// weights of a target cell partially covered by the source grid sum to the
+/// covered fraction of its area.
+///
+/// The cells are rectangles, therefore the area of an intersection is the
+/// product of its extents along the two axes. If a geodetic system is given,
+/// the axes are longitudes and latitudes: the area of a cell bounded by two
+/// meridians and two parallels on the spheroid is proportional to its extent
+/// in longitude and to the difference of the function q of the authalic
+/// latitude between its parallels (see detail::math::GeographicBinning2D).
+///
+/// @param source_x X-Axis of the source grid, sorted in ascending order.
+/// @param source_y Y-Axis of the source grid, sorted in ascending order.
+/// @param target_x X-Axis of the target grid.
+/// @param target_y Y-Axis of the target grid.
+/// @param wgs Geodetic system of the geographic grids.
+/// @param num_threads The number of threads to use for the computation.
+/// @return The plan computing the values of the target cells, in the order of
+/// the flattened target grid (ix * ny + iy).
+inline auto conservative_plan(const Axis<double>& source_x,
+                              const Axis<double>& source_y,
+                              const Axis<double>& target_x,
+                              const Axis<double>& target_y,
+                              const std::optional<geodetic::System>& wgs,
+                              const size_t num_threads) -> InterpolationPlan {
+  if (!source_x.is_ascending() || !source_y.is_ascending()) {
+    throw std::invalid_argument(
+        "the axes of the source grid must be sorted in ascending order");
+  }
+
+  auto edges = [](const Axis<double>& axis) {
+    auto values = std::vector<double>(axis.size());
+    for (int64_t ix = 0; ix < axis.size(); ++ix) {
+      values[ix] = axis(ix);
+    }
+    return detail::math::cell_edges(values);
+  };
+
+  // On the spheroid, the latitudes are replaced by the function q of the
+  // authalic latitude, in which the areas are proportional to the extents.
+  auto authalic = [&wgs](std::vector<double> values) {
+    if (wgs) {
+      const auto binning = detail::math::GeographicBinning2D<double>(
+          std::sqrt(wgs->first_eccentricity_squared()), {});
+      for (auto& item : values) {
+        item = binning.q(std::clamp(item, -90.0, 90.0));
+      }
+    }
+    return values;
+  };
+
+  // Fractions of the extent of each target cell covered by the source cells
+  // along an axis.
+  auto fractions = [](const std::vector<double>& source,
+                      const std::vector<double>& target, const double period) {
+    auto result =
+        std::vector<std::vector<std::pair<int64_t, double>>>(target.size() - 1);
+    for (size_t ix = 0; ix < result.size(); ++ix) {
+      const auto lo = std::min(target[ix], target[ix + 1]);
+      const auto hi = std::max(target[ix], target[ix + 1]);
+      if (hi <= lo) {
+        continue;
+      }
+      result[ix] = detail::math::cell_overlaps(source, lo, hi, period);
+      for (auto& item : result[ix]) {
+        item.second /= hi - lo;
+      }
+    }
+    return result;
+  };
+
+  const auto fx = fractions(edges(source_x), edges(target_x),
+                            source_x.is_circle() ? 360.0 : 0.0);
+  const auto fy =
+      fractions(authalic(edges(source_y)), authalic(edges(target_y)), 0.0);
+
+  const auto nx = target_x.size();
+  const auto ny = target_y.size();
+  const auto source_ny = source_y.size();
+  auto indptr = Vector<int64_t>(nx * ny + 1);
+  indptr(0) = 0;
+  for (int64_t ix = 0; ix < nx; ++ix) {
+    for (int64_t jx = 0; jx < ny; ++jx) {
+      const auto row = ix * ny + jx;
+      indptr(row + 1) = indptr(row) + static_cast<int64_t>(fx[ix].size() *
+                                                           fy[jx].size());
+    }
+  }
+  auto indices = Vector<int64_t>(indptr(nx * ny));
+  auto weights = Vector<double>(indptr(nx * ny));
+
+  {
+    pybind11::gil_scoped_release release;
+    detail::dispatch(
+        [&](const size_t start, const size_t end) {
+          for (auto ix = static_cast<int64_t>(start);
+               ix < static_cast<int64_t>(end); ++ix) {
+            auto position = indptr(ix * ny);
+            for (int64_t jx = 0; jx < ny; ++jx) {
+              for (const auto& [kx, wx] : fx[ix]) {
+                for (const auto& [ky, wy] : fy[jx]) {
+                  indices(position) = kx * source_ny + ky;
+                  weights(position) = wx * wy;
+                  ++position;
+                }
+              }
+            }
+          }
+        },
+        nx, num_threads);
+  }
+  return {source_x.size(), source_ny, std::move(indptr), std::move(indices),
+          std::move(weights)};
+}
+
+}  // namespace pyinterp
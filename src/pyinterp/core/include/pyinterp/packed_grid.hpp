@@ -0,0 +1,395 @@
+// Copyright (c) 2022 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+#pragma once
+#include <pybind11/numpy.h>
+#include <pybind11/stl.h>
+
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <string>
+#include <type_traits>
+
+#include "pyinterp/detail/math/float16.hpp"
+#include "pyinterp/grid.hpp"
+
+namespace pyinterp {
+
+/// Decoding of the values of a grid stored with a reduced precision.
+///
+/// The values are unpacked according to the CF conventions: the value of an
+/// item is ``packed * scale_factor + add_offset`` and the items equal to the
+/// fill value are undefined.
+///
+/// @tparam T Type of the packed values: int16_t for the values packed into
+/// integers, uint16_t for the bits of half-precision floating-point numbers.
+template <typename T>
+class Packing {
+ public:
+  /// Type of the packed values
+  using Storage = T;
+
+  /// Default constructor
+  ///
+  /// @param scale_factor Factor multiplying the packed values.
+  /// @param add_offset Offset added to the packed values.
+  /// @param fill_value Packed value of the undefined items.
+  Packing(const double scale_factor, const double add_offset,
+          const std::optional<Storage>& fill_value)
+      : scale_factor_(scale_factor),
+        add_offset_(add_offset),
+        fill_value_(fill_value) {}
+
+  /// Gets the factor multiplying the packed values.
+  [[nodiscard]] inline auto scale_factor() const noexcept -> double {
+    return scale_factor_;
+  }
+
+  /// Gets the offset added to the packed values.
+  [[nodiscard]] inline auto add_offset() const noexcept -> double {
+    return add_offset_;
+  }
+
+  /// Gets the packed value of the undefined items.
+  [[nodiscard]] inline auto fill_value() const noexcept
+      -> const std::optional<Storage>& {
+    return fill_value_;
+  }
+
+  /// Decodes a packed value.
+  [[nodiscard]] inline auto decode(const Storage value) const noexcept
+      -> double {
+    if (fill_value_.has_value() && value == *fill_value_) {
+      return std::numeric_limits<double>::quiet_NaN();
+    }
+    return unpack(value) * scale_factor_ + add_offset_;
+  }
+
+  /// Pickle support: get state of this instance
+  [[nodiscard]] auto getstate() const -> pybind11::tuple {
+    return pybind11::make_tuple(scale_factor_, add_offset_, fill_value_);
+  }
+
+  /// Pickle support: set state of this instance
+  static auto setstate(const pybind11::tuple& tuple) -> Packing {
+    if (tuple.size() != 3) {
+      throw std::runtime_error("invalid state");
+    }
+    return Packing(tuple[0].cast<double>(), tuple[1].cast<double>(),
+                   tuple[2].cast<std::optional<Storage>>());
+  }
+
+ private:
+  double scale_factor_;
+  double add_offset_;
+  std::optional<Storage> fill_value_;
+
+  /// Converts a packed value into a real number.
+  static inline auto unpack(const Storage value) noexcept -> double {
+    if constexpr (std::is_same_v<Storage, uint16_t>) {
+      return static_cast<double>(detail::math::float16_to_float32(value));
+    } else {
+      return static_cast<double>(value);
+    }
+  }
+};
+
+/// Values packed into 16-bit integers.
+using ScaledInt16 = Packing<int16_t>;
+
+/// Values stored as half-precision floating-point numbers.
+using Float16 = Packing<uint16_t>;
+
+/// Cartesian Grid 2D whose values are decoded when they are read, so that the
+/// grid occupies the memory of its packed values only.
+///
+/// @tparam Codec Decoding of the values
+/// @tparam Dimension Total number of dimensions handled by this instance.
+template <typename Codec, pybind11::ssize_t Dimension = 2>
+class PackedGrid2D : public Grid2D<typename Codec::Storage, Dimension> {
+ public:
+  using Base = Grid2D<typename Codec::Storage, Dimension>;
+
+  /// Default constructor
+  PackedGrid2D(std::shared_ptr<Axis<double>> x,
+               std::shared_ptr<Axis<double>> y,
+               pybind11::array_t<typename Codec::Storage> array, Codec codec)
+      : Base(std::move(x), std::move(y), std::move(array)),
+        codec_(std::move(codec)) {}
+
+  /// Gets the decoding of the values
+  [[nodiscard]] inline auto codec() const noexcept -> const Codec& {
+    return codec_;
+  }
+
+  /// Gets the decoded grid value for the coordinate pixel (ix, iy, ...).
+  template <typename... Index>
+  inline auto value(Index&&... index) const noexcept -> double {
+    return codec_.decode(Base::value(std::forward<Index>(index)...));
+  }
+
+  /// Pickle support: get state of this instance
+  [[nodiscard]] auto getstate() const -> pybind11::tuple override {
+    return pybind11::make_tuple(Base::getstate(), codec_.getstate());
+  }
+
+  /// Pickle support: set state of this instance
+  static auto setstate(const pybind11::tuple& tuple) -> PackedGrid2D {
+    if (tuple.size() != 2) {
+      throw std::runtime_error("invalid state");
+    }
+    auto grid = Base::setstate(tuple[0].cast<pybind11::tuple>());
+    return PackedGrid2D(grid.x(), grid.y(), grid.array(),
+                        Codec::setstate(tuple[1].cast<pybind11::tuple>()));
+  }
+
+ private:
+  Codec codec_;
+};
+
+/// Cartesian Grid 3D whose values are decoded when they are read.
+///
+/// @tparam Codec Decoding of the values
+/// @tparam AxisType Axis data type
+template <typename Codec, typename AxisType>
+class PackedGrid3D : public Grid3D<typename Codec::Storage, AxisType> {
+ public:
+  using Base = Grid3D<typename Codec::Storage, AxisType>;
+
+  /// Default constructor
+  PackedGrid3D(const std::shared_ptr<Axis<double>>& x,
+               const std::shared_ptr<Axis<double>>& y,
+               std::shared_ptr<Axis<AxisType>> z,
+               pybind11::array_t<typename Codec::Storage> array, Codec codec)
+      : Base(x, y, std::move(z), std::move(array)), codec_(std::move(codec)) {}
+
+  /// Gets the decoding of the values
+  [[nodiscard]] inline auto codec() const noexcept -> const Codec& {
+    return codec_;
+  }
+
+  /// Gets the decoded grid value for the coordinate pixel (ix, iy, ...).
+  template <typename... Index>
+  inline auto value(Index&&... index) const noexcept -> double {
+    return codec_.decode(Base::value(std::forward<Index>(index)...));
+  }
+
+  /// Pickle support: get state of this instance
+  [[nodiscard]] auto getstate() const -> pybind11::tuple override {
+    return pybind11::make_tuple(Base::getstate(), codec_.getstate());
+  }
+
+  /// Pickle support: set state of this instance
+  static auto setstate(const pybind11::tuple& tuple) -> PackedGrid3D {
+    if (tuple.size() != 2) {
+      throw std::runtime_error("invalid state");
+    }
+    auto grid = Base::setstate(tuple[0].cast<pybind11::tuple>());
+    return PackedGrid3D(grid.x(), grid.y(), grid.z(), grid.array(),
+                        Codec::setstate(tuple[1].cast<pybind11::tuple>()));
+  }
+
+ private:
+  Codec codec_;
+};
+
+/// Defines the properties describing the decoding of the values of a packed
+/// grid.
+template <typename Grid, typename Storage>
+auto implement_packing_properties(pybind11::class_<Grid>& cls) -> void {
+  cls.def_property_readonly(
+         "scale_factor",
+         [](const Grid& self) { return self.codec().scale_factor(); },
+         R"__doc__(
+Gets the factor multiplying the packed values.
+
+Returns:
+    float: scale factor.
+)__doc__")
+      .def_property_readonly(
+          "add_offset",
+          [](const Grid& self) { return self.codec().add_offset(); },
+          R"__doc__(
+Gets the offset added to the packed values.
+
+Returns:
+    float: offset.
+)__doc__")
+      .def_property_readonly(
+          "fill_value",
+          [](const Grid& self) -> std::optional<Storage> {
+            return self.codec().fill_value();
+          },
+          R"__doc__(
+Gets the packed value of the undefined items, if any.
+
+Returns:
+    int, optional: fill value.
+)__doc__")
+      .def_property_readonly(
+          "array", [](const Grid& self) { return self.array(); },
+          R"__doc__(
+Gets the packed values handled by this instance
+
+Returns:
+    numpy.ndarray: values
+)__doc__")
+      .def(pybind11::pickle(
+          [](const Grid& self) { return self.getstate(); },
+          [](const pybind11::tuple& state) { return Grid::setstate(state); }));
+}
+
+/// Documentation of the packed values given to the constructors.
+template <typename Storage>
+inline auto packed_values_doc() -> std::string {
+  if constexpr (std::is_same_v<Storage, uint16_t>) {
+    return "the bits of the half-precision floating-point\n"
+           "        values, i.e. a ``numpy.float16`` array viewed as "
+           "``numpy.uint16``.";
+  } else {
+    return "the packed values.";
+  }
+}
+
+/// Implementations of Cartesian grids 3D whose values are packed.
+///
+/// @tparam Storage Type of the packed values
+/// @tparam AxisType Axis data type
+template <typename Storage, typename AxisType>
+void implement_packed_ndgrid(pybind11::module& m, const std::string& prefix,
+                             const std::string& suffix) {
+  using Codec = Packing<Storage>;
+  using Grid = PackedGrid3D<Codec, AxisType>;
+
+  std::string help =
+      "Cartesian Grid 3D whose values are decoded when they are read";
+  if (prefix.length()) {
+    help = prefix + " " + help;
+  }
+  auto cls =
+      pybind11::class_<Grid>(m, (prefix + "Grid3D" + suffix).c_str(),
+                             help.c_str());
+  cls.def(pybind11::init([](const std::shared_ptr<Axis<double>>& x,
+                            const std::shared_ptr<Axis<double>>& y,
+                            std::shared_ptr<Axis<AxisType>> z,
+                            pybind11::array_t<Storage> array,
+                            const double scale_factor, const double add_offset,
+                            const std::optional<Storage>& fill_value) {
+            return Grid(x, y, std::move(z), std::move(array),
+                        Codec(scale_factor, add_offset, fill_value));
+          }),
+          pybind11::arg("x"), pybind11::arg("y"), pybind11::arg("z"),
+          pybind11::arg("array"), pybind11::arg("scale_factor") = 1.0,
+          pybind11::arg("add_offset") = 0.0,
+          pybind11::arg("fill_value") = pybind11::none(),
+          (R"__doc__(
+Default constructor
+
+Args:
+    x (pyinterp.core.Axis): X-Axis
+    y (pyinterp.core.Axis): Y-Axis
+    z (pyinterp.core.)__doc__" +
+           prefix + R"__doc__(Axis): Z-Axis
+    array (numpy.ndarray): Trivariate function: )__doc__" +
+           packed_values_doc<Storage>() + R"__doc__(
+    scale_factor (float, optional): Factor multiplying the packed values.
+        Defaults to ``1``.
+    add_offset (float, optional): Offset added to the packed values. Defaults
+        to ``0``.
+    fill_value (int, optional): Packed value of the undefined items.
+)__doc__")
+              .c_str())
+      .def_property_readonly(
+          "x", [](const Grid& self) { return self.x(); },
+          R"__doc__(
+Gets the X-Axis handled by this instance
+
+Returns:
+    pyinterp.core.Axis: X-Axis
+)__doc__")
+      .def_property_readonly(
+          "y", [](const Grid& self) { return self.y(); },
+          R"__doc__(
+Gets the Y-Axis handled by this instance
+
+Returns:
+    pyinterp.core.Axis: Y-Axis
+)__doc__")
+      .def_property_readonly(
+          "z", [](const Grid& self) { return self.z(); },
+          (R"__doc__(
+Gets the Z-Axis handled by this instance
+
+Returns:
+    pyinterp.core.)__doc__" +
+           prefix +
+           R"__doc__(Axis: Z-Axis
+)__doc__")
+              .c_str());
+  implement_packing_properties<Grid, Storage>(cls);
+}
+
+/// Implementations of Cartesian grids whose values are packed.
+///
+/// @tparam Storage Type of the packed values
+template <typename Storage>
+void implement_packed_grid(pybind11::module& m, const std::string& suffix) {
+  using Codec = Packing<Storage>;
+  using Grid = PackedGrid2D<Codec>;
+
+  auto cls = pybind11::class_<Grid>(
+      m, ("Grid2D" + suffix).c_str(),
+      "Cartesian Grid 2D whose values are decoded when they are read");
+  cls.def(pybind11::init([](std::shared_ptr<Axis<double>> x,
+                            std::shared_ptr<Axis<double>> y,
+                            pybind11::array_t<Storage> array,
+                            const double scale_factor, const double add_offset,
+                            const std::optional<Storage>& fill_value) {
+            return Grid(std::move(x), std::move(y), std::move(array),
+                        Codec(scale_factor, add_offset, fill_value));
+          }),
+          pybind11::arg("x"), pybind11::arg("y"), pybind11::arg("array"),
+          pybind11::arg("scale_factor") = 1.0,
+          pybind11::arg("add_offset") = 0.0,
+          pybind11::arg("fill_value") = pybind11::none(),
+          (R"__doc__(
+Default constructor
+
+Args:
+    x (pyinterp.core.Axis): X-Axis
+    y (pyinterp.core.Axis): Y-Axis
+    array (numpy.ndarray): Bivariate function: )__doc__" +
+           packed_values_doc<Storage>() + R"__doc__(
+    scale_factor (float, optional): Factor multiplying the packed values.
+        Defaults to ``1``.
+    add_offset (float, optional): Offset added to the packed values. Defaults
+        to ``0``.
+    fill_value (int, optional): Packed value of the undefined items.
+)__doc__")
+              .c_str())
+      .def_property_readonly(
+          "x", [](const Grid& self) { return self.x(); },
+          R"__doc__(
+Gets the X-Axis handled by this instance
+
+Returns:
+    pyinterp.core.Axis: X-Axis
+)__doc__")
+      .def_property_readonly(
+          "y", [](const Grid& self) { return self.y(); },
+          R"__doc__(
+Gets the Y-Axis handled by this instance
+
+Returns:
+    pyinterp.core.Axis: Y-Axis
+)__doc__");
+  implement_packing_properties<Grid, Storage>(cls);
+
+  implement_packed_ndgrid<Storage, double>(m, "", suffix);
+  implement_packed_ndgrid<Storage, int64_t>(m, "Temporal", suffix);
+}
+
+}  // namespace pyinterp
@@ -0,0 +1,177 @@
+// Copyright (c) 2022 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+#pragma once
+#include <pybind11/numpy.h>
+#include <pybind11/pybind11.h>
+
+#include <Eigen/Core>
+#include <algorithm>
+#include <future>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "pyinterp/binning.hpp"
+#include "pyinterp/detail/broadcast.hpp"
+#include "pyinterp/detail/thread.hpp"
+#include "pyinterp/eigen.hpp"
+#include "pyinterp/histogram2d.hpp"
+
+namespace pyinterp {
+
+/// Feeds the samples of a sequence of chunks into several Binning2D and
+/// Histogram2D.
+///
+/// Pushing thousands of small chunks from Python converts every chunk, and
+/// takes and releases the GIL, once per statistic. The pipeline reads the
+/// chunks from a Python iterator and double-buffers them: while a worker
+/// thread ingests a chunk, without the GIL, the next chunk is read from the
+/// iterator and converted into contiguous arrays. All the statistics are
+/// updated concurrently from the same chunk.
+///
+/// @tparam T Type of the values binned.
+template <typename T>
+class Pipeline {
+ public:
+  /// Default constructor
+  ///
+  /// @param binning Binned statistics updated by the pipeline.
+  /// @param histograms Histograms updated by the pipeline.
+  /// @param simple If true, the nearest binning is used by the binned
+  /// statistics, otherwise the linear binning.
+  /// @param num_threads The number of threads to use for the computation. If 0
+  /// all CPUs are used. If 1 is given, no parallel computing code is used at
+  /// all, which is useful for debugging.
+  Pipeline(std::vector<Binning2D<T>*> binning,
+           std::vector<Histogram2D<T>*> histograms, const bool simple,
+           const size_t num_threads)
+      : binning_(std::move(binning)),
+        histograms_(std::move(histograms)),
+        simple_(simple),
+        num_threads_(num_threads == 0 ? detail::get_num_threads()
+                                      : num_threads) {
+    if (binning_.empty() && histograms_.empty()) {
+      throw std::invalid_argument("the pipeline has no statistics to update");
+    }
+    // The statistics are updated concurrently: each must appear once.
+    check_items(binning_);
+    check_items(histograms_);
+  }
+
+  /// Gets the number of statistics updated by the pipeline.
+  [[nodiscard]] inline auto size() const noexcept -> size_t {
+    return binning_.size() + histograms_.size();
+  }
+
+  /// Ingests all the chunks of samples.
+  ///
+  /// @param chunks Iterable of (x, y, z) tuples: the coordinates and values
+  /// of the samples of each chunk, as one-dimensional arrays.
+  void run(const pybind11::iterable& chunks) {
+    auto it = pybind11::iter(chunks);
+    auto current = next_chunk(it);
+    while (current) {
+      auto ingestion = std::async(std::launch::async,
+                                  [this, &current]() { ingest(*current); });
+
+      // The next chunk is read while the current one is ingested.
+      auto next = std::optional<Chunk>();
+      try {
+        next = next_chunk(it);
+      } catch (...) {
+        pybind11::gil_scoped_release release;
+        ingestion.wait();
+        throw;
+      }
+      {
+        pybind11::gil_scoped_release release;
+        ingestion.get();
+      }
+      current = std::move(next);
+    }
+  }
+
+ private:
+  /// Contiguous arrays holding the samples of a chunk.
+  using Array = pybind11::array_t<T, pybind11::array::c_style |
+                                         pybind11::array::forcecast>;
+
+  /// Samples of a chunk.
+  struct Chunk {
+    Array x;
+    Array y;
+    Array z;
+  };
+
+  std::vector<Binning2D<T>*> binning_;
+  std::vector<Histogram2D<T>*> histograms_;
+  bool simple_;
+  size_t num_threads_;
+
+  /// Checks that the statistics updated are defined and distinct.
+  template <typename Statistics>
+  static void check_items(const std::vector<Statistics*>& items) {
+    for (auto it = items.begin(); it != items.end(); ++it) {
+      if (*it == nullptr) {
+        throw std::invalid_argument("the statistics must not be None");
+      }
+      if (std::find(items.begin(), it, *it) != it) {
+        throw std::invalid_argument(
+            "the same statistics cannot be updated twice by a pipeline");
+      }
+    }
+  }
+
+  /// Reads and converts the next chunk of the iterator, with the GIL.
+  ///
+  /// @return the chunk read, or nothing if the iterator is exhausted.
+  static auto next_chunk(const pybind11::iterator& it)
+      -> std::optional<Chunk> {
+    auto item =
+        pybind11::reinterpret_steal<pybind11::object>(PyIter_Next(it.ptr()));
+    if (!item) {
+      if (PyErr_Occurred() != nullptr) {
+        throw pybind11::error_already_set();
+      }
+      return std::nullopt;
+    }
+    auto samples = item.cast<pybind11::sequence>();
+    if (samples.size() != 3) {
+      throw std::invalid_argument(
+          "each chunk must be a tuple of three arrays: x, y, z");
+    }
+    auto result = Chunk{samples[0].cast<Array>(), samples[1].cast<Array>(),
+                        samples[2].cast<Array>()};
+    detail::check_array_ndim("x", 1, result.x, "y", 1, result.y, "z", 1,
+                             result.z);
+    detail::check_ndarray_shape("x", result.x, "y", result.y, "z", result.z);
+    return result;
+  }
+
+  /// Ingests the samples of a chunk into all the statistics, without the
+  /// GIL. The threads are shared between the statistics, updated
+  /// concurrently.
+  void ingest(const Chunk& chunk) const {
+    const auto x = Eigen::Map<const Vector<T>>(chunk.x.data(), chunk.x.size());
+    const auto y = Eigen::Map<const Vector<T>>(chunk.y.data(), chunk.y.size());
+    const auto z = Eigen::Map<const Vector<T>>(chunk.z.data(), chunk.z.size());
+    const auto threads = std::max<size_t>(num_threads_ / size(), 1);
+
+    detail::dispatch(
+        [&](const size_t start, const size_t end) {
+          for (auto ix = start; ix < end; ++ix) {
+            if (ix < binning_.size()) {
+              binning_[ix]->ingest(x, y, z, simple_, threads);
+            } else {
+              histograms_[ix - binning_.size()]->ingest(x, y, z, threads);
+            }
+          }
+        },
+        size(), std::min(size(), num_threads_), detail::kDynamic);
+  }
+};
+
+}  // namespace pyinterp
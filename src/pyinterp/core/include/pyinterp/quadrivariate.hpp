@@ -6,13 +6,18 @@
 #include <pybind11/numpy.h>
 #include <pybind11/stl.h>
 
+#include <algorithm>
+#include <array>
 #include <cctype>
 
 #include "pyinterp/bivariate.hpp"
+#include "pyinterp/chunked_grid.hpp"
 #include "pyinterp/detail/geometry/point.hpp"
 #include "pyinterp/detail/math/trivariate.hpp"
 #include "pyinterp/detail/thread.hpp"
 #include "pyinterp/grid.hpp"
+#include "pyinterp/temporal_axis.hpp"
+#include "pyinterp/trivariate.hpp"
 
 namespace pyinterp {
 
@@ -33,15 +38,58 @@ constexpr auto get_u_interpolation_method(const std::string& method)
   throw std::invalid_argument("unknown interpolation method: " + method);
 }
 
+/// Interpolates the values of a grid in a cell: the trivariate interpolations
+/// on the layers iu0 and iu1 of the u-axis are blended along this axis.
+template <template <class> class Point, typename Coordinate, typename AxisType,
+          typename Grid, typename Interpolator>
+inline auto _quadrivariate_value(
+    const Grid& grid, const TrivariateCell<Point, Coordinate>& cell,
+    const Coordinate& u, const int64_t iu0, const int64_t iu1,
+    const Axis<double>& u_axis, const Interpolator* interpolator,
+    const detail::math::z_method_t<AxisType, Coordinate>&
+        z_interpolation_method,
+    const detail::math::z_method_t<Coordinate, Coordinate>&
+        u_interpolation_method) -> Coordinate {
+  const auto& [ix0, ix1, iy0, iy1, iz0, iz1, p, p0, p1] = cell;
+
+  auto u0 = pyinterp::detail::math::trivariate<Point, Coordinate>(
+      p, p0, p1, static_cast<Coordinate>(grid.value(ix0, iy0, iz0, iu0)),
+      static_cast<Coordinate>(grid.value(ix0, iy1, iz0, iu0)),
+      static_cast<Coordinate>(grid.value(ix1, iy0, iz0, iu0)),
+      static_cast<Coordinate>(grid.value(ix1, iy1, iz0, iu0)),
+      static_cast<Coordinate>(grid.value(ix0, iy0, iz1, iu0)),
+      static_cast<Coordinate>(grid.value(ix0, iy1, iz1, iu0)),
+      static_cast<Coordinate>(grid.value(ix1, iy0, iz1, iu0)),
+      static_cast<Coordinate>(grid.value(ix1, iy1, iz1, iu0)), interpolator,
+      z_interpolation_method);
+
+  auto u1 = pyinterp::detail::math::trivariate<Point, Coordinate>(
+      p, p0, p1, static_cast<Coordinate>(grid.value(ix0, iy0, iz0, iu1)),
+      static_cast<Coordinate>(grid.value(ix0, iy1, iz0, iu1)),
+      static_cast<Coordinate>(grid.value(ix1, iy0, iz0, iu1)),
+      static_cast<Coordinate>(grid.value(ix1, iy1, iz0, iu1)),
+      static_cast<Coordinate>(grid.value(ix0, iy0, iz1, iu1)),
+      static_cast<Coordinate>(grid.value(ix0, iy1, iz1, iu1)),
+      static_cast<Coordinate>(grid.value(ix1, iy0, iz1, iu1)),
+      static_cast<Coordinate>(grid.value(ix1, iy1, iz1, iu1)), interpolator,
+      z_interpolation_method);
+
+  return u_interpolation_method(u, u_axis(iu0), u_axis(iu1), u0, u1);
+}
+
 /// Quadrivariate interpolation for a given point.
+///
+/// @tparam Grid Type of the grid, or of the accessor reading a chunked grid.
+/// @tparam Interpolator Type of the interpolator, either the abstract class or
+/// one of the built-in implementations, whose calls are inlined.
 template <template <class> class Point, typename Coordinate, typename AxisType,
-          typename Type>
+          typename Type, typename Grid, typename Interpolator>
 inline auto _quadrivariate(
-    const Grid4D<Type, AxisType>& grid, const Coordinate& x,
+    const Grid& grid, const Coordinate& x,
     const Coordinate& y, const AxisType& z, const Coordinate& u,
     const Axis<double>& x_axis, const Axis<double>& y_axis,
     const Axis<AxisType>& z_axis, const Axis<double>& u_axis,
-    const Bivariate4D<Point, Coordinate>* interpolator,
+    const Interpolator* interpolator,
     const detail::math::z_method_t<AxisType, Coordinate>&
         z_interpolation_method,
     const detail::math::z_method_t<Coordinate, Coordinate>&
@@ -61,33 +109,15 @@ inline auto _quadrivariate(
 
     // The fourth coordinate is not used by the 3D interpolator.
     auto x0 = x_axis(ix0);
-    auto p = Point<Coordinate>(x_axis.normalize_coordinate(x, x0), y, z);
-    auto p0 = Point<Coordinate>(x0, y_axis(iy0), z_axis(iz0));
-    auto p1 = Point<Coordinate>(x_axis(ix1), y_axis(iy1), z_axis(iz1));
-
-    auto u0 = pyinterp::detail::math::trivariate<Point, Coordinate>(
-        p, p0, p1, static_cast<Coordinate>(grid.value(ix0, iy0, iz0, iu0)),
-        static_cast<Coordinate>(grid.value(ix0, iy1, iz0, iu0)),
-        static_cast<Coordinate>(grid.value(ix1, iy0, iz0, iu0)),
-        static_cast<Coordinate>(grid.value(ix1, iy1, iz0, iu0)),
-        static_cast<Coordinate>(grid.value(ix0, iy0, iz1, iu0)),
-        static_cast<Coordinate>(grid.value(ix0, iy1, iz1, iu0)),
-        static_cast<Coordinate>(grid.value(ix1, iy0, iz1, iu0)),
-        static_cast<Coordinate>(grid.value(ix1, iy1, iz1, iu0)), interpolator,
-        z_interpolation_method);
-
-    auto u1 = pyinterp::detail::math::trivariate<Point, Coordinate>(
-        p, p0, p1, static_cast<Coordinate>(grid.value(ix0, iy0, iz0, iu1)),
-        static_cast<Coordinate>(grid.value(ix0, iy1, iz0, iu1)),
-        static_cast<Coordinate>(grid.value(ix1, iy0, iz0, iu1)),
-        static_cast<Coordinate>(grid.value(ix1, iy1, iz0, iu1)),
-        static_cast<Coordinate>(grid.value(ix0, iy0, iz1, iu1)),
-        static_cast<Coordinate>(grid.value(ix0, iy1, iz1, iu1)),
-        static_cast<Coordinate>(grid.value(ix1, iy0, iz1, iu1)),
-        static_cast<Coordinate>(grid.value(ix1, iy1, iz1, iu1)), interpolator,
-        z_interpolation_method);
-
-    return u_interpolation_method(u, u_axis(iu0), u_axis(iu1), u0, u1);
+    return _quadrivariate_value<Point, Coordinate, AxisType>(
+        grid,
+        TrivariateCell<Point, Coordinate>{
+            ix0, ix1, iy0, iy1, iz0, iz1,
+            Point<Coordinate>(x_axis.normalize_coordinate(x, x0), y, z),
+            Point<Coordinate>(x0, y_axis(iy0), z_axis(iz0)),
+            Point<Coordinate>(x_axis(ix1), y_axis(iy1), z_axis(iz1))},
+        u, iu0, iu1, u_axis, interpolator, z_interpolation_method,
+        u_interpolation_method);
   }
 
   if (bounds_error) {
@@ -105,27 +135,101 @@ inline auto _quadrivariate(
   return std::numeric_limits<Coordinate>::quiet_NaN();
 }
 
+/// Quadrivariate interpolation of the points of a layer, i.e. framed by the
+/// same cells of the z and u axes, on a grid whose x and y axes are regular
+/// and sorted in ascending order.
+///
+/// The z and u axes are searched once for the layer and the cells of the x
+/// and y axes are calculated in batches by the kernel of the bivariate
+/// interpolation on regular grids (see _trivariate_layer). The points that
+/// are not framed by the grid are handled by _quadrivariate.
+///
+/// @param indexes Index of the points of the layer.
+/// @param size Number of points of the layer.
+template <template <class> class Point, typename Coordinate, typename AxisType,
+          typename Type, typename Grid, typename Interpolator, typename Input,
+          typename ZInput, typename Output>
+auto _quadrivariate_layer(
+    const Grid& grid, const Input& x, const Input& y, const ZInput& z,
+    const Input& u, Output& result, const size_t* indexes, const size_t size,
+    const Axis<double>& x_axis, const Axis<double>& y_axis,
+    const Axis<AxisType>& z_axis, const Axis<double>& u_axis,
+    const Interpolator& interpolator,
+    const detail::math::z_method_t<AxisType, Coordinate>&
+        z_interpolation_method,
+    const detail::math::z_method_t<Coordinate, Coordinate>&
+        u_interpolation_method,
+    const bool bounds_error) -> void {
+  const auto& x_regular = *x_axis.regular_container();
+  const auto& y_regular = *y_axis.regular_container();
+  const auto z_indexes = z_axis.find_indexes(z(indexes[0]));
+  const auto u_indexes = u_axis.find_indexes(u(indexes[0]));
+
+  auto x_cells = std::array<int64_t, kBivariateBatchSize>();
+  auto y_cells = std::array<int64_t, kBivariateBatchSize>();
+
+  for (size_t first = 0; first < size; first += kBivariateBatchSize) {
+    const auto count = std::min(size - first, kBivariateBatchSize);
+    const auto* batch = indexes + first;
+
+    _regular_cells(
+        x_axis, y_axis, x, y, [batch](size_t jx) { return batch[jx]; }, count,
+        x_cells, y_cells);
+
+    for (size_t jx = 0; jx < count; ++jx) {
+      const auto ix = batch[jx];
+      const auto ix0 = x_cells[jx];
+      const auto iy0 = y_cells[jx];
+
+      if (!z_indexes || !u_indexes || ix0 == -1 || iy0 == -1) {
+        result(ix) = _quadrivariate<Point, Coordinate, AxisType, Type>(
+            grid, x(ix), y(ix), z(ix), u(ix), x_axis, y_axis, z_axis, u_axis,
+            &interpolator, z_interpolation_method, u_interpolation_method,
+            bounds_error);
+        continue;
+      }
+
+      const auto [iz0, iz1] = *z_indexes;
+      const auto [iu0, iu1] = *u_indexes;
+      const auto x0 = x_regular.coordinate_value(ix0);
+      result(ix) = _quadrivariate_value<Point, Coordinate, AxisType>(
+          grid,
+          TrivariateCell<Point, Coordinate>{
+              ix0, ix0 + 1, iy0, iy0 + 1, iz0, iz1,
+              Point<Coordinate>(x_axis.normalize_coordinate(x(ix), x0), y(ix),
+                                z(ix)),
+              Point<Coordinate>(x0, y_regular.coordinate_value(iy0),
+                                z_axis(iz0)),
+              Point<Coordinate>(x_regular.coordinate_value(ix0 + 1),
+                                y_regular.coordinate_value(iy0 + 1),
+                                z_axis(iz1))},
+          u(ix), iu0, iu1, u_axis, &interpolator, z_interpolation_method,
+          u_interpolation_method);
+    }
+  }
+}
+
 /// Interpolation of quadrivariate function.
 ///
 /// @tparam Point A type of point defining a point in space.
 /// @tparam Coordinate Coordinate data type
 /// @tparam AxisType Axis data type
 /// @tparam Type Grid data type
+/// @tparam Grid Grid type, either a Grid4D or a ChunkedGrid4D
+/// @tparam ZArray Type of the vector of the Z-values: the dates located on a
+/// time axis are converted to the resolution of the axis when they are read.
 template <template <class> class Point, typename Coordinate, typename AxisType,
-          typename Type>
-auto quadrivariate(const Grid4D<Type, AxisType>& grid,
-                   const pybind11::array_t<Coordinate>& x,
-                   const pybind11::array_t<Coordinate>& y,
-                   const pybind11::array_t<AxisType>& z,
-                   const pybind11::array_t<Coordinate>& u,
+          typename Type, typename Grid = Grid4D<Type, AxisType>,
+          typename ZArray = pybind11::array_t<AxisType>>
+auto quadrivariate(const Grid& grid, const pybind11::array& x,
+                   const pybind11::array& y, const ZArray& z,
+                   const pybind11::array& u,
                    const Bivariate4D<Point, Coordinate>* interpolator,
                    const std::optional<std::string>& z_method,
                    const std::optional<std::string>& u_method,
-                   const bool bounds_error, const size_t num_threads)
+                   const bool bounds_error, const size_t num_threads,
+                   const std::optional<pybind11::array>& out)
     -> pybind11::array_t<Coordinate> {
-  pyinterp::detail::check_array_ndim("x", 1, x, "y", 1, y, "z", 1, z, "u", 1,
-                                     u);
-  pyinterp::detail::check_ndarray_shape("x", x, "y", y, "z", z, "u", u);
   auto z_interpolation_method =
       pyinterp::detail::math::get_z_interpolation_method(
           interpolator, z_method.value_or("linear"));
@@ -133,45 +237,86 @@ auto quadrivariate(const Grid4D<Type, AxisType>& grid,
       get_u_interpolation_method<Coordinate>(u_method.value_or("linear"));
 
   auto size = x.size();
-  auto result =
-      pybind11::array_t<Coordinate>(pybind11::array::ShapeContainer{size});
-  auto _x = x.template unchecked<1>();
-  auto _y = y.template unchecked<1>();
-  auto _z = z.template unchecked<1>();
-  auto _u = u.template unchecked<1>();
+  auto result = detail::numpy::output_array<Coordinate>("out", out, {size});
+  auto _x = detail::numpy::ArrayReader<Coordinate>(x);
+  auto _y = detail::numpy::ArrayReader<Coordinate>(y);
+  // The reader of the z-coordinates expects a vector.
+  pyinterp::detail::check_array_ndim("z", 1, z);
+  auto _z = coordinates_reader(*grid.z(), "z", z);
+  auto _u = detail::numpy::ArrayReader<Coordinate>(u);
   auto _result = result.template mutable_unchecked<1>();
+  const auto& handle = make_handle(grid);
 
   {
     pybind11::gil_scoped_release release;
 
-    // Captures the detected exceptions in the calculation function
-    // (only the last exception captured is kept)
-    auto except = std::exception_ptr(nullptr);
+    // The dimensions and the shapes are read from the array structures.
+    pyinterp::detail::check_array_ndim("x", 1, x, "y", 1, y, "u", 1, u);
+    pyinterp::detail::check_ndarray_shape("x", x, "y", y, "z", z, "u", u);
 
-    // Access to the shared pointer outside the loop to avoid data races
-    const auto& x_axis = *grid.x();
-    const auto& y_axis = *grid.y();
-    const auto& z_axis = *grid.z();
-    const auto& u_axis = *grid.u();
+    const auto& x_axis = *handle.x();
+    const auto& y_axis = *handle.y();
+    const auto& z_axis = *handle.z();
+    const auto& u_axis = *handle.u();
 
-    detail::dispatch(
-        [&](size_t start, size_t end) {
-          try {
-            for (size_t ix = start; ix < end; ++ix) {
-              _result(ix) = _quadrivariate<Point, Coordinate, AxisType, Type>(
-                  grid, _x(ix), _y(ix), _z(ix), _u(ix), x_axis, y_axis, z_axis,
-                  u_axis, interpolator, z_interpolation_method,
-                  u_interpolation_method, bounds_error);
-            }
-          } catch (...) {
-            except = std::current_exception();
+    // The points interpolated on a chunked grid are grouped by chunk, the
+    // points interpolated on a regular grid by layer.
+    auto order = make_order(
+        handle, size,
+        [&](size_t ix) -> std::optional<std::array<int64_t, 4>> {
+          auto x_indexes = x_axis.find_indexes(_x(ix));
+          auto y_indexes = y_axis.find_indexes(_y(ix));
+          auto z_indexes = z_axis.find_indexes(_z(ix));
+          auto u_indexes = u_axis.find_indexes(_u(ix));
+          if (x_indexes && y_indexes && z_indexes && u_indexes) {
+            return std::array<int64_t, 4>{x_indexes->first, y_indexes->first,
+                                          z_indexes->first, u_indexes->first};
           }
+          return std::nullopt;
         },
-        size, num_threads);
+        [&](size_t ix) -> std::optional<int64_t> {
+          auto z_indexes = z_axis.find_indexes(_z(ix));
+          auto u_indexes = u_axis.find_indexes(_u(ix));
+          if (z_indexes && u_indexes) {
+            return z_indexes->first * u_axis.size() + u_indexes->first;
+          }
+          return std::nullopt;
+        },
+        num_threads);
 
-    if (except != nullptr) {
-      std::rethrow_exception(except);
-    }
+    // On a regular grid whose x and y axes are regular, the points of each
+    // layer are interpolated by a specialized kernel.
+    const auto regular = x_axis.regular_container() != nullptr &&
+                         y_axis.regular_container() != nullptr &&
+                         x_axis.is_ascending() && y_axis.is_ascending();
+
+    detail::math::visit(interpolator, [&](const auto* concrete) {
+      detail::dispatch(
+          [&](size_t start, size_t end) {
+            auto&& values = make_accessor(handle);
+            auto point = [&](size_t ix) {
+              _result(ix) = _quadrivariate<Point, Coordinate, AxisType, Type>(
+                  values, _x(ix), _y(ix), _z(ix), _u(ix), x_axis, y_axis,
+                  z_axis, u_axis, concrete, z_interpolation_method,
+                  u_interpolation_method, bounds_error);
+            };
+            if (!regular) {
+              order.for_each(start, end, point);
+              return;
+            }
+            for_each_layer(
+                order, start, end,
+                [&](const size_t* indexes, size_t count) {
+                  _quadrivariate_layer<Point, Coordinate, AxisType, Type>(
+                      values, _x, _y, _z, _u, _result, indexes, count, x_axis,
+                      y_axis, z_axis, u_axis, *concrete,
+                      z_interpolation_method, u_interpolation_method,
+                      bounds_error);
+                },
+                point);
+          },
+          size, num_threads);
+    });
   }
   return result;
 }
@@ -189,12 +334,14 @@ void implement_quadrivariate(pybind11::module& m, const std::string& prefix,
   auto function_suffix = suffix;
   function_suffix[0] = static_cast<char>(std::tolower(function_suffix[0]));
   m.def(("quadrivariate_" + function_suffix).c_str(),
-        &quadrivariate<Point, Coordinate, AxisType, Type>,
+        &quadrivariate<Point, Coordinate, AxisType, Type,
+                       Grid4D<Type, AxisType>, AxisCoordinates<AxisType>>,
         pybind11::arg("grid"), pybind11::arg("x"), pybind11::arg("y"),
         pybind11::arg("z"), pybind11::arg("u"), pybind11::arg("interpolator"),
         pybind11::arg("z_method") = pybind11::none(),
         pybind11::arg("u_method") = pybind11::none(),
         pybind11::arg("bounds_error") = false, pybind11::arg("num_threads") = 0,
+        pybind11::arg("out") = pybind11::none(),
         (R"__doc__(
 Interpolate the values provided on the defined trivariate function.
 
@@ -223,8 +370,31 @@ Args:
         computation. If 0 all CPUs are used. If 1 is given, no parallel
         computing code is used at all, which is useful for debugging.
         Defaults to ``0``.
+    out (numpy.ndarray, optional): C-contiguous array of shape ``(n, )`` and
+        of type float64 in which the interpolated values are written. If
+        None, a new array is allocated. Defaults to ``None``.
 Returns:
-    numpy.ndarray: Values interpolated.
+    numpy.ndarray: Values interpolated, i.e. ``out`` if provided.
+)__doc__")
+            .c_str());
+  m.def(("quadrivariate_" + function_suffix).c_str(),
+        &quadrivariate<Point, Coordinate, AxisType, Type,
+                       ChunkedGrid4D<Type, AxisType>,
+                       AxisCoordinates<AxisType>>,
+        pybind11::arg("grid"), pybind11::arg("x"), pybind11::arg("y"),
+        pybind11::arg("z"), pybind11::arg("u"), pybind11::arg("interpolator"),
+        pybind11::arg("z_method") = pybind11::none(),
+        pybind11::arg("u_method") = pybind11::none(),
+        pybind11::arg("bounds_error") = false, pybind11::arg("num_threads") = 0,
+        pybind11::arg("out") = pybind11::none(),
+        (R"__doc__(
+Interpolate the values provided on the defined quadrivariate function, whose
+values are read by chunks. Only the chunks framing the points are read.
+
+Args:
+    grid (pyinterp.core.)__doc__" +
+         prefix + "ChunkedGrid4D" + suffix +
+         R"__doc__(): Grid containing the values to be interpolated.
 )__doc__")
             .c_str());
 }
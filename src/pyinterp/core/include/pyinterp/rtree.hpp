@@ -3,27 +3,43 @@
 // All rights reserved. Use of this source code is governed by a
 // BSD-style license that can be found in the LICENSE file.
 #pragma once
+#include <pybind11/eigen.h>
 #include <pybind11/numpy.h>
 
 #include <Eigen/Core>
+#include <algorithm>
+#include <array>
+#include <cstring>
 #include <functional>
+#include <numeric>
+#include <optional>
+#include <string>
+#include <tuple>
 
 #include "pyinterp/detail/broadcast.hpp"
 #include "pyinterp/detail/geodetic/coordinates.hpp"
 #include "pyinterp/detail/geodetic/system.hpp"
 #include "pyinterp/detail/geometry/rtree.hpp"
+#include "pyinterp/detail/numpy.hpp"
 #include "pyinterp/detail/thread.hpp"
 #include "pyinterp/eigen.hpp"
 #include "pyinterp/geodetic/system.hpp"
+#include "pyinterp/geohash/int64.hpp"
 
 namespace pyinterp {
 
+/// Pair of arrays, provided by the user, receiving the results of a query.
+using OutputPair = std::optional<std::tuple<pybind11::array, pybind11::array>>;
+
 /// Type of radial functions exposed in the Python module.
 using RadialBasisFunction = detail::math::RadialBasisFunction;
 
 /// Type of window functions exposed in the Python module.
 using WindowFunction = detail::math::window::Function;
 
+/// Type of covariance functions exposed in the Python module.
+using CovarianceFunction = detail::math::covariance::Function;
+
 /// RTree spatial index for geodetic point
 ///
 /// @note
@@ -56,13 +72,22 @@ class RTree : public detail::geometry::RTree<CoordinateType, Type, N> {
   using promotion_t =
       typename detail::geometry::RTree<CoordinateType, Type, N>::promotion_t;
 
+  /// Cache of the RBF interpolants.
+  using rbf_cache_t =
+      typename detail::geometry::RTree<CoordinateType, Type, N>::rbf_cache_t;
+
+  /// Cache of the kriging systems.
+  using kriging_cache_t = typename detail::geometry::RTree<CoordinateType, Type,
+                                                          N>::kriging_cache_t;
+
+  /// Type of the geodetic coordinates provided by the user. The Cartesian
+  /// coordinates are calculated in this precision, then rounded to the
+  /// precision of the index.
+  using geodetic_t = promotion_t;
+
   /// Pointer on the method converting LLA coordinates to ECEF.
   using Converter = point_t (RTree<CoordinateType, Type, N>::*)(
-      const Eigen::Map<const Vector<CoordinateType>> &) const;
-
-  /// Pointer on the method to Search for the nearest K nearest neighbors
-  using Requester = std::vector<result_t> (RTree<CoordinateType, Type, N>::*)(
-      const point_t &, const uint32_t) const;
+      const Eigen::Map<const Vector<geodetic_t>> &) const;
 
   /// Default constructor
   explicit RTree(const std::optional<detail::geodetic::System> &wgs)
@@ -79,23 +104,22 @@ class RTree : public detail::geometry::RTree<CoordinateType, Type, N> {
       return pybind11::make_tuple();
     }
 
-    auto x0 = std::numeric_limits<CoordinateType>::max();
-    auto x1 = std::numeric_limits<CoordinateType>::min();
-    auto y0 = std::numeric_limits<CoordinateType>::max();
-    auto y1 = std::numeric_limits<CoordinateType>::min();
-    auto z0 = std::numeric_limits<CoordinateType>::max();
-    auto z1 = std::numeric_limits<CoordinateType>::min();
-
-    std::for_each(this->tree_->begin(), this->tree_->end(),
-                  [&](const auto &item) {
-                    auto lla = to_lla(item.first);
-                    x0 = std::min(x0, boost::geometry::get<0>(lla));
-                    x1 = std::max(x1, boost::geometry::get<0>(lla));
-                    y0 = std::min(y0, boost::geometry::get<1>(lla));
-                    y1 = std::max(y1, boost::geometry::get<1>(lla));
-                    z0 = std::min(z0, boost::geometry::get<2>(lla));
-                    z1 = std::max(z1, boost::geometry::get<2>(lla));
-                  });
+    auto x0 = std::numeric_limits<geodetic_t>::max();
+    auto x1 = std::numeric_limits<geodetic_t>::min();
+    auto y0 = std::numeric_limits<geodetic_t>::max();
+    auto y1 = std::numeric_limits<geodetic_t>::min();
+    auto z0 = std::numeric_limits<geodetic_t>::max();
+    auto z1 = std::numeric_limits<geodetic_t>::min();
+
+    this->for_each([&](const auto &item) {
+      auto lla = to_lla(item.first);
+      x0 = std::min(x0, boost::geometry::get<0>(lla));
+      x1 = std::max(x1, boost::geometry::get<0>(lla));
+      y0 = std::min(y0, boost::geometry::get<1>(lla));
+      y1 = std::max(y1, boost::geometry::get<1>(lla));
+      z0 = std::min(z0, boost::geometry::get<2>(lla));
+      z1 = std::max(z1, boost::geometry::get<2>(lla));
+    });
 
     return pybind11::make_tuple(pybind11::make_tuple(x0, y0, z0),
                                 pybind11::make_tuple(x1, y1, z1));
@@ -104,9 +128,11 @@ class RTree : public detail::geometry::RTree<CoordinateType, Type, N> {
   /// Populates the RTree with coordinates using the packaging algorithm
   ///
   /// @param coordinates Coordinates to be copied
-  void packing(const pybind11::array_t<CoordinateType, pybind11::array::c_style>
-                   &coordinates,
-               const pybind11::array_t<Type> &values) {
+  /// @param values Values associated with the coordinates
+  /// @param num_threads The number of threads to use for the computation
+  void packing(const pybind11::array &coordinates,
+               const pybind11::array_t<Type> &values,
+               const size_t num_threads = 0) {
     detail::check_array_ndim("coordinates", 2, coordinates);
     detail::check_array_ndim("values", 1, values);
     if (coordinates.shape(0) != values.size()) {
@@ -118,11 +144,11 @@ class RTree : public detail::geometry::RTree<CoordinateType, Type, N> {
     switch (coordinates.shape(1)) {
       case N - 1:
         _packing<N - 1>(&RTree<CoordinateType, Type, N>::from_lon_lat,
-                        coordinates, values);
+                        coordinates, values, num_threads);
         break;
       case N:
         _packing<N>(&RTree<CoordinateType, Type, N>::from_lon_lat_alt,
-                    coordinates, values);
+                    coordinates, values, num_threads);
         break;
       default:
         throw std::invalid_argument(
@@ -133,9 +159,11 @@ class RTree : public detail::geometry::RTree<CoordinateType, Type, N> {
   /// Insert new data into the search tree
   ///
   /// @param coordinates Coordinates to be copied
-  void insert(const pybind11::array_t<CoordinateType, pybind11::array::c_style>
-                  &coordinates,
-              const pybind11::array_t<CoordinateType> &values) {
+  /// @param values Values associated with the coordinates
+  /// @param num_threads The number of threads to use for the computation
+  void insert(const pybind11::array &coordinates,
+              const pybind11::array_t<Type> &values,
+              const size_t num_threads = 0) {
     detail::check_array_ndim("coordinates", 2, coordinates);
     detail::check_array_ndim("values", 1, values);
     if (coordinates.shape(0) != values.size()) {
@@ -147,11 +175,11 @@ class RTree : public detail::geometry::RTree<CoordinateType, Type, N> {
     switch (coordinates.shape(1)) {
       case N - 1:
         _insert<N - 1>(&RTree<CoordinateType, Type, N>::from_lon_lat,
-                       coordinates, values);
+                       coordinates, values, num_threads);
         break;
       case N:
         _insert<N>(&RTree<CoordinateType, Type, N>::from_lon_lat_alt,
-                   coordinates, values);
+                   coordinates, values, num_threads);
         break;
       default:
         throw std::invalid_argument(
@@ -159,19 +187,59 @@ class RTree : public detail::geometry::RTree<CoordinateType, Type, N> {
     }
   }
 
+  /// Removes the values selected by a predicate
+  ///
+  /// @param predicate Function called with the coordinates (longitudes,
+  /// latitudes, altitudes and other coordinates) and the values stored,
+  /// returning a boolean vector flagging the values to remove.
+  /// @param num_threads The number of threads to use for the computation
+  /// @return the number of values removed.
+  auto remove(const pybind11::function &predicate, const size_t num_threads = 0)
+      -> size_t {
+    auto size = this->size();
+    auto coordinates = Matrix<geodetic_t>(size, N);
+    auto values = Vector<Type>(size);
+    {
+      auto ix = Eigen::Index(0);
+      auto gil = pybind11::gil_scoped_release();
+      this->for_each([&](const auto &item) {
+        auto lla = to_lla(item.first);
+        coordinates(ix, 0) = boost::geometry::get<0>(lla);
+        coordinates(ix, 1) = boost::geometry::get<1>(lla);
+        coordinates(ix, 2) = boost::geometry::get<2>(lla);
+        for (auto jx = 3UL; jx < N; ++jx) {
+          coordinates(ix, jx) = detail::geometry::point::get(item.first, jx);
+        }
+        values(ix++) = item.second;
+      });
+    }
+    auto mask = predicate(coordinates, values).template cast<Vector<bool>>();
+    if (static_cast<size_t>(mask.size()) != size) {
+      throw std::invalid_argument(
+          "the predicate must return a boolean vector of size " +
+          std::to_string(size) + ", got " + std::to_string(mask.size()));
+    }
+    auto gil = pybind11::gil_scoped_release();
+    auto ix = Eigen::Index(0);
+    return detail::geometry::RTree<CoordinateType, Type, N>::remove(
+        [&](const auto & /*item*/) -> bool { return mask(ix++); },
+        num_threads);
+  }
+
   /// Search for the nearest K nearest neighbors of a given coordinates.
-  auto query(const pybind11::array_t<CoordinateType, pybind11::array::c_style>
-                 &coordinates,
-             const uint32_t k, const bool within,
-             const size_t num_threads) const -> pybind11::tuple {
+  auto query(const pybind11::array &coordinates, const uint32_t k,
+             const bool within, const size_t num_threads,
+             const OutputPair &out = std::nullopt,
+             const distance_t eps = 0) const -> pybind11::tuple {
     detail::check_array_ndim("coordinates", 2, coordinates);
+    check_eps(eps);
     switch (coordinates.shape(1)) {
       case N - 1:
         return _query<N - 1>(&RTree<CoordinateType, Type, N>::from_lon_lat,
-                             coordinates, k, within, num_threads);
+                             coordinates, k, within, num_threads, out, eps);
       case N:
         return _query<N>(&RTree<CoordinateType, Type, N>::from_lon_lat,
-                         coordinates, k, within, num_threads);
+                         coordinates, k, within, num_threads, out, eps);
       default:
         throw std::invalid_argument(
             RTree<CoordinateType, Type, N>::invalid_shape());
@@ -180,24 +248,25 @@ class RTree : public detail::geometry::RTree<CoordinateType, Type, N> {
 
   /// TODO
   auto inverse_distance_weighting(
-      const pybind11::array_t<CoordinateType, pybind11::array::c_style>
-          &coordinates,
+      const pybind11::array &coordinates,
       const std::optional<distance_t> &radius, const uint32_t k,
-      const uint32_t p, const bool within, const size_t num_threads) const
+      const uint32_t p, const bool within, const size_t num_threads,
+      const OutputPair &out = std::nullopt, const distance_t eps = 0) const
       -> pybind11::tuple {
     detail::check_array_ndim("coordinates", 2, coordinates);
+    check_eps(eps);
 
     switch (coordinates.shape(1)) {
       case N - 1:
         return _inverse_distance_weighting<N - 1>(
             &RTree<CoordinateType, Type, N>::from_lon_lat, coordinates,
             radius.value_or(std::numeric_limits<distance_t>::max()), k, p,
-            within, num_threads);
+            within, num_threads, out, eps);
       case N:
         return _inverse_distance_weighting<N>(
             &RTree<CoordinateType, Type, N>::from_lon_lat, coordinates,
             radius.value_or(std::numeric_limits<distance_t>::max()), k, p,
-            within, num_threads);
+            within, num_threads, out, eps);
       default:
         throw std::invalid_argument(
             RTree<CoordinateType, Type, N>::invalid_shape());
@@ -206,8 +275,7 @@ class RTree : public detail::geometry::RTree<CoordinateType, Type, N> {
 
   /// TODO
   auto radial_basis_function(
-      const pybind11::array_t<CoordinateType, pybind11::array::c_style>
-          &coordinates,
+      const pybind11::array &coordinates,
       const std::optional<distance_t> &radius, const uint32_t k,
       const RadialBasisFunction rbf, const std::optional<promotion_t> &epsilon,
       const promotion_t smooth, const bool within,
@@ -232,23 +300,74 @@ class RTree : public detail::geometry::RTree<CoordinateType, Type, N> {
     }
   }
 
+  /// Estimation of the values at the requested positions by ordinary
+  /// kriging.
+  auto kriging(const pybind11::array &coordinates,
+               const std::optional<distance_t> &radius, const uint32_t k,
+               const CovarianceFunction covariance, const promotion_t sigma,
+               const promotion_t lambda, const promotion_t nugget,
+               const bool within, const size_t num_threads) const
+      -> pybind11::tuple {
+    detail::check_array_ndim("coordinates", 2, coordinates);
+    switch (coordinates.shape(1)) {
+      case N - 1:
+        return _kriging<N - 1>(
+            &RTree<CoordinateType, Type, N>::from_lon_lat, coordinates,
+            radius.value_or(std::numeric_limits<distance_t>::max()), k,
+            covariance, sigma, lambda, nugget, within, num_threads);
+      case N:
+        return _kriging<N>(
+            &RTree<CoordinateType, Type, N>::from_lon_lat_alt, coordinates,
+            radius.value_or(std::numeric_limits<distance_t>::max()), k,
+            covariance, sigma, lambda, nugget, within, num_threads);
+      default:
+        throw std::invalid_argument(
+            RTree<CoordinateType, Type, N>::invalid_shape());
+    }
+  }
+
+  /// Interpolation of the values at the requested positions by a radial basis
+  /// function with compact support solved over all the points of the index.
+  auto compact_radial_basis_function(
+      const pybind11::array &coordinates,
+      const promotion_t radius, const promotion_t smooth,
+      const Eigen::Index max_iterations, const promotion_t tolerance,
+      const size_t num_threads) const -> pybind11::tuple {
+    detail::check_array_ndim("coordinates", 2, coordinates);
+    switch (coordinates.shape(1)) {
+      case N - 1:
+        return _compact_rbf<N - 1>(
+            &RTree<CoordinateType, Type, N>::from_lon_lat, coordinates, radius,
+            smooth, max_iterations, tolerance, num_threads);
+      case N:
+        return _compact_rbf<N>(
+            &RTree<CoordinateType, Type, N>::from_lon_lat_alt, coordinates,
+            radius, smooth, max_iterations, tolerance, num_threads);
+      default:
+        throw std::invalid_argument(
+            RTree<CoordinateType, Type, N>::invalid_shape());
+    }
+  }
+
   /// TODO
   auto window_function(
-      const pybind11::array_t<CoordinateType, pybind11::array::c_style>
-          &coordinates,
+      const pybind11::array &coordinates,
       const distance_t &radius, const uint32_t k, const WindowFunction wf,
       const std::optional<distance_t> &arg, const bool within,
-      const size_t num_threads) const -> pybind11::tuple {
+      const size_t table_size, const size_t num_threads,
+      const distance_t eps = 0) const -> pybind11::tuple {
     detail::check_array_ndim("coordinates", 2, coordinates);
+    check_eps(eps);
     switch (coordinates.shape(1)) {
       case N - 1:
         return _window_function<N - 1>(
             &RTree<CoordinateType, Type, N>::from_lon_lat, coordinates, radius,
-            k, wf, arg.value_or(0), within, num_threads);
+            k, wf, arg.value_or(0), within, table_size, num_threads, eps);
       case N:
         return _window_function<N>(
             &RTree<CoordinateType, Type, N>::from_lon_lat_alt, coordinates,
-            radius, k, wf, arg.value_or(0), within, num_threads);
+            radius, k, wf, arg.value_or(0), within, table_size, num_threads,
+            eps);
       default:
         throw std::invalid_argument(
             RTree<CoordinateType, Type, N>::invalid_shape());
@@ -264,14 +383,13 @@ class RTree : public detail::geometry::RTree<CoordinateType, Type, N> {
     auto _x = x.template mutable_unchecked<2>();
     auto _u = u.template mutable_unchecked<1>();
     size_t ix = 0;
-    std::for_each(this->tree_->begin(), this->tree_->end(),
-                  [&](const auto &item) {
-                    for (auto jx = 0UL; jx < N; ++jx) {
-                      _x(ix, jx) = detail::geometry::point::get(item.first, jx);
-                    }
-                    _u(ix) = item.second;
-                    ++ix;
-                  });
+    this->for_each([&](const auto &item) {
+      for (auto jx = 0UL; jx < N; ++jx) {
+        _x(ix, jx) = detail::geometry::point::get(item.first, jx);
+      }
+      _u(ix) = item.second;
+      ++ix;
+    });
     auto system = geodetic::System(this->coordinates_.system());
     return pybind11::make_tuple(system.getstate(), x, u);
   }
@@ -291,8 +409,8 @@ class RTree : public detail::geometry::RTree<CoordinateType, Type, N> {
       throw std::runtime_error("invalid state");
     }
 
-    auto _x = x.template mutable_unchecked<2>();
-    auto _u = u.template mutable_unchecked<1>();
+    auto _x = x.template unchecked<2>();
+    auto _u = u.template unchecked<1>();
 
     auto vector =
         std::vector<typename RTree<CoordinateType, Type, N>::value_t>();
@@ -307,12 +425,47 @@ class RTree : public detail::geometry::RTree<CoordinateType, Type, N> {
       vector.emplace_back(std::make_pair(point, _u(ix)));
     }
     auto result = RTree<CoordinateType, Type, N>(system);
-    static_cast<detail::geometry::RTree<CoordinateType, Type, N>>(result)
-        .packing(vector);
+    result.detail::geometry::RTree<CoordinateType, Type, N>::packing(
+        std::move(vector));
+    return result;
+  }
+
+  /// Writes the index to a file that load() maps in memory.
+  ///
+  /// @param path Path to the file to create.
+  void save(const std::string &path) const {
+    const auto system = coordinates_.system();
+    const auto parameters =
+        std::array<double, 2>{system.semi_major_axis(), system.flattening()};
+    auto metadata = std::string(sizeof(parameters), '\0');
+    std::memcpy(metadata.data(), parameters.data(), sizeof(parameters));
+    detail::geometry::RTree<CoordinateType, Type, N>::save(path, metadata);
+  }
+
+  /// Opens an index written by save(). The file is mapped read-only in
+  /// memory: the index is usable immediately and the memory pages holding it
+  /// are shared between the processes opening the same file.
+  ///
+  /// @param path Path to the file to open.
+  static auto load(const std::string &path) -> RTree<CoordinateType, Type, N> {
+    auto result = RTree<CoordinateType, Type, N>(std::nullopt);
+    auto metadata =
+        result.detail::geometry::RTree<CoordinateType, Type, N>::load(path);
+    auto parameters = std::array<double, 2>();
+    if (metadata.size() != sizeof(parameters)) {
+      throw std::invalid_argument("invalid index file: " + path);
+    }
+    std::memcpy(parameters.data(), metadata.data(), sizeof(parameters));
+    result.coordinates_ = detail::geodetic::Coordinates(
+        detail::geodetic::System(parameters[0], parameters[1]));
     return result;
   }
 
  private:
+  /// Number of RBF interpolants, or kriging systems, kept by each block of
+  /// query points.
+  static constexpr size_t kCacheSize = 16;
+
   /// System for converting Geodetic coordinates into Cartesian coordinates.
   detail::geodetic::Coordinates coordinates_;
 
@@ -320,10 +473,10 @@ class RTree : public detail::geometry::RTree<CoordinateType, Type, N> {
   /// latitude in degrees, altitude in meters, then the other coordinates
   /// defined in a Euclidean space.
   auto from_lon_lat_alt(
-      const Eigen::Map<const Vector<CoordinateType>> &coordinates) const
+      const Eigen::Map<const Vector<geodetic_t>> &coordinates) const
       -> point_t {
     auto ecef = coordinates_.lla_to_ecef(
-        detail::geometry::EquatorialPoint3D<CoordinateType>{
+        detail::geometry::EquatorialPoint3D<geodetic_t>{
             coordinates(0), coordinates(1), coordinates(2)});
     auto result = point_t();
 
@@ -340,11 +493,11 @@ class RTree : public detail::geometry::RTree<CoordinateType, Type, N> {
   /// Create the cartesian point for the given coordinates: longitude and
   /// latitude in degrees, then the other coordinated defined in a Euclidean
   /// space.
-  auto from_lon_lat(const Eigen::Map<const Vector<CoordinateType>> &coordinates)
+  auto from_lon_lat(const Eigen::Map<const Vector<geodetic_t>> &coordinates)
       const -> point_t {
     auto ecef = coordinates_.lla_to_ecef(
-        detail::geometry::EquatorialPoint3D<CoordinateType>{coordinates(0),
-                                                            coordinates(1), 0});
+        detail::geometry::EquatorialPoint3D<geodetic_t>{coordinates(0),
+                                                        coordinates(1), 0});
     auto result = point_t();
 
     boost::geometry::set<0>(result, boost::geometry::get<0>(ecef));
@@ -360,8 +513,8 @@ class RTree : public detail::geometry::RTree<CoordinateType, Type, N> {
   /// Create the geographic point (latitude, longitude, and altitude) from the
   /// cartesian coordinates
   auto to_lla(const point_t &point) const
-      -> detail::geometry::EquatorialPoint3D<CoordinateType> {
-    return coordinates_.ecef_to_lla(detail::geometry::Point3D<CoordinateType>(
+      -> detail::geometry::EquatorialPoint3D<geodetic_t> {
+    return coordinates_.ecef_to_lla(detail::geometry::Point3D<geodetic_t>(
         boost::geometry::get<0>(point), boost::geometry::get<1>(point),
         boost::geometry::get<2>(point)));
   }
@@ -378,115 +531,156 @@ class RTree : public detail::geometry::RTree<CoordinateType, Type, N> {
            "altitudes and other coordinates";
   }
 
+  /// Raise an exception if the tolerance of an approximate search is
+  /// invalid.
+  static auto check_eps(const distance_t eps) -> void {
+    if (!(eps >= 0)) {
+      throw std::invalid_argument("eps must be a positive number");
+    }
+  }
+
   /// Packing coordinates
   ///
   /// @param coordinates Coordinates to be copied
   template <size_t M>
-  void _packing(Converter converter,
-                const pybind11::array_t<CoordinateType> &coordinates,
-                const pybind11::array_t<Type> &values) {
-    auto _coordinates = coordinates.template unchecked<2>();
+  void _packing(Converter converter, const pybind11::array &coordinates,
+                const pybind11::array_t<Type> &values,
+                const size_t num_threads) {
+    auto _coordinates = detail::numpy::ArrayReader<geodetic_t>(coordinates);
     auto _values = values.template unchecked<1>();
-    auto observations = coordinates.shape(0);
-    auto vector =
-        std::vector<typename RTree<CoordinateType, Type, N>::value_t>();
-
-    vector.reserve(observations);
-
-    for (auto ix = 0; ix < observations; ++ix) {
-      vector.emplace_back(
-          std::make_pair(std::invoke(converter, *this,
-                                     Eigen::Map<const Vector<CoordinateType>>(
-                                         &_coordinates(ix, 0), M)),
-                         _values(ix)));
-    }
-    detail::geometry::RTree<CoordinateType, Type, N>::packing(vector);
+    auto vector = std::vector<typename RTree<CoordinateType, Type, N>::value_t>(
+        coordinates.shape(0));
+
+    detail::dispatch(
+        [&](size_t start, size_t end) {
+          auto buffer = std::array<geodetic_t, M>();
+          for (size_t ix = start; ix < end; ++ix) {
+            vector[ix] = std::make_pair(
+                std::invoke(converter, *this,
+                            _coordinates.row(ix, M, buffer.data())),
+                _values(ix));
+          }
+        },
+        vector.size(), num_threads);
+    detail::geometry::RTree<CoordinateType, Type, N>::packing(
+        std::move(vector), num_threads);
   }
 
   /// Insert coordinates
   ///
   /// @param coordinates Coordinates to be copied
   template <size_t M>
-  void _insert(Converter converter,
-               const pybind11::array_t<CoordinateType> &coordinates,
-               const pybind11::array_t<Type> &values) {
-    auto _coordinates = coordinates.template unchecked<2>();
+  void _insert(Converter converter, const pybind11::array &coordinates,
+               const pybind11::array_t<Type> &values,
+               const size_t num_threads) {
+    auto _coordinates = detail::numpy::ArrayReader<geodetic_t>(coordinates);
     auto _values = values.template unchecked<1>();
+    auto vector = std::vector<typename RTree<CoordinateType, Type, N>::value_t>(
+        coordinates.shape(0));
+
+    detail::dispatch(
+        [&](size_t start, size_t end) {
+          auto buffer = std::array<geodetic_t, M>();
+          for (size_t ix = start; ix < end; ++ix) {
+            vector[ix] = std::make_pair(
+                std::invoke(converter, *this,
+                            _coordinates.row(ix, M, buffer.data())),
+                _values(ix));
+          }
+        },
+        vector.size(), num_threads);
+    detail::geometry::RTree<CoordinateType, Type, N>::insert(std::move(vector),
+                                                             num_threads);
+  }
 
-    for (auto ix = 0; ix < coordinates.shape(0); ++ix) {
-      detail::geometry::RTree<CoordinateType, Type, N>::insert(
-          std::make_pair(std::invoke(converter, *this,
-                                     Eigen::Map<const Vector<CoordinateType>>(
-                                         &_coordinates(ix, 0), M)),
-                         _values(ix)));
-    }
+  /// Returns the order in which the query points are processed. The points
+  /// are sorted along the Z-order curve described by their geohash so that
+  /// consecutive searches, and therefore the chunks handled by each thread,
+  /// explore the same nodes of the tree. The results are written at the
+  /// original position of each point.
+  template <typename Accessor>
+  static auto curve_order(const Accessor &coordinates,
+                          const pybind11::ssize_t size,
+                          const size_t num_threads) -> std::vector<size_t> {
+    auto codes = std::vector<uint64_t>(size);
+    detail::dispatch(
+        [&](size_t start, size_t end) {
+          for (size_t ix = start; ix < end; ++ix) {
+            auto lon = static_cast<double>(coordinates(ix, 0));
+            auto lat = static_cast<double>(coordinates(ix, 1));
+            codes[ix] =
+                std::isfinite(lon) && std::isfinite(lat)
+                    ? geohash::int64::encode(
+                          {detail::math::normalize_angle(lon, -180.0, 360.0),
+                           std::clamp(lat, -90.0, 90.0)},
+                          64)
+                    : std::numeric_limits<uint64_t>::max();
+          }
+        },
+        size, num_threads);
+
+    auto result = std::vector<size_t>(size);
+    std::iota(result.begin(), result.end(), 0);
+    std::sort(result.begin(), result.end(), [&codes](auto lhs, auto rhs) {
+      return codes[lhs] < codes[rhs];
+    });
+    return result;
   }
 
   /// Search for the nearest K nearest neighbors of a given coordinates.
   template <size_t M>
   auto _query(Converter converter,
-              const pybind11::array_t<CoordinateType> &coordinates,
-              const uint32_t k, const bool within,
-              const size_t num_threads) const -> pybind11::tuple {
-    Requester requester =
-        within ? &detail::geometry::RTree<CoordinateType, Type, N>::query_within
-               : &detail::geometry::RTree<CoordinateType, Type, N>::query;
-
-    auto _coordinates = coordinates.template unchecked<2>();
+              const pybind11::array &coordinates,
+              const uint32_t k, const bool within, const size_t num_threads,
+              const OutputPair &out, const distance_t eps) const
+      -> pybind11::tuple {
+    auto _coordinates = detail::numpy::ArrayReader<geodetic_t>(coordinates);
     auto size = coordinates.shape(0);
 
-    // Allocation of result matrices.
-    auto distance =
-        pybind11::array_t<distance_t>(pybind11::array::ShapeContainer{
-            size, static_cast<pybind11::ssize_t>(k)});
-    auto value = pybind11::array_t<Type>(pybind11::array::ShapeContainer{
-        size, static_cast<pybind11::ssize_t>(k)});
+    // Allocation of result matrices, unless the user provides them.
+    auto shape = std::vector<pybind11::ssize_t>{
+        size, static_cast<pybind11::ssize_t>(k)};
+    auto distance = detail::numpy::output_array<distance_t>(
+        "out[0]", out ? std::get<0>(*out) : std::optional<pybind11::array>(),
+        shape);
+    auto value = detail::numpy::output_array<Type>(
+        "out[1]", out ? std::get<1>(*out) : std::optional<pybind11::array>(),
+        shape);
 
     auto _distance = distance.template mutable_unchecked<2>();
     auto _value = value.template mutable_unchecked<2>();
 
     {
       pybind11::gil_scoped_release release;
-
-      // Captures the detected exceptions in the calculation function
-      // (only the last exception captured is kept)
-      auto except = std::exception_ptr(nullptr);
+      const auto order = curve_order(_coordinates, size, num_threads);
 
       detail::dispatch(
           [&](size_t start, size_t end) {
-            try {
-              auto point = point_t();
-
-              for (size_t ix = start; ix < end; ++ix) {
-                point = std::move(
-                    std::invoke(converter, *this,
-                                Eigen::Map<const Vector<CoordinateType>>(
-                                    &_coordinates(ix, 0), M)));
-
-                auto nearest = std::invoke(requester, *this, point, k);
-                auto jx = 0ULL;
-
-                // Fill in the calculation result for all neighbors found
-                for (; jx < nearest.size(); ++jx) {
-                  _distance(ix, jx) = nearest[jx].first;
-                  _value(ix, jx) = nearest[jx].second;
-                }
-
-                // The rest of the result is filled with invalid values.
-                for (; jx < k; ++jx) {
-                  _distance(ix, jx) = -1;
-                  _value(ix, jx) = Type(-1);
-                }
+            auto point = point_t();
+            auto buffer = std::array<geodetic_t, M>();
+
+            for (size_t item = start; item < end; ++item) {
+              const auto ix = order[item];
+              point = std::move(
+                  std::invoke(converter, *this,
+                              _coordinates.row(ix, M, buffer.data())));
+
+              // The neighbors found are written directly into the rows of the
+              // result matrices.
+              auto jx = static_cast<uint32_t>(
+                  detail::geometry::RTree<CoordinateType, Type, N>::query(
+                      point, k, within, _distance.mutable_data(ix, 0),
+                      _value.mutable_data(ix, 0),
+                      std::numeric_limits<distance_t>::max(), eps));
+
+              // The rest of the result is filled with invalid values.
+              for (; jx < k; ++jx) {
+                _distance(ix, jx) = -1;
+                _value(ix, jx) = Type(-1);
               }
-            } catch (...) {
-              except = std::current_exception();
             }
           },
-          size, num_threads);
-
-      if (except != nullptr) {
-        std::rethrow_exception(except);
-      }
+          size, num_threads, detail::kDynamic);
     }
     return pybind11::make_tuple(distance, value);
   }
@@ -494,53 +688,46 @@ class RTree : public detail::geometry::RTree<CoordinateType, Type, N> {
   /// Inverse distance weighting interpolation
   template <size_t M>
   auto _inverse_distance_weighting(
-      Converter converter, const pybind11::array_t<CoordinateType> &coordinates,
+      Converter converter, const pybind11::array &coordinates,
       const distance_t radius, const uint32_t k, const uint32_t p,
-      const bool within, const size_t num_threads) const -> pybind11::tuple {
-    auto _coordinates = coordinates.template unchecked<2>();
+      const bool within, const size_t num_threads, const OutputPair &out,
+      const distance_t eps) const -> pybind11::tuple {
+    auto _coordinates = detail::numpy::ArrayReader<geodetic_t>(coordinates);
     auto size = coordinates.shape(0);
 
-    // Allocation of result vectors.
-    auto data =
-        pybind11::array_t<distance_t>(pybind11::array::ShapeContainer{size});
-    auto neighbors =
-        pybind11::array_t<uint32_t>(pybind11::array::ShapeContainer{size});
+    // Allocation of result vectors, unless the user provides them.
+    auto data = detail::numpy::output_array<distance_t>(
+        "out[0]", out ? std::get<0>(*out) : std::optional<pybind11::array>(),
+        {size});
+    auto neighbors = detail::numpy::output_array<uint32_t>(
+        "out[1]", out ? std::get<1>(*out) : std::optional<pybind11::array>(),
+        {size});
 
     auto _data = data.template mutable_unchecked<1>();
     auto _neighbors = neighbors.template mutable_unchecked<1>();
 
     {
       pybind11::gil_scoped_release release;
-
-      // Captures the detected exceptions in the calculation function
-      // (only the last exception captured is kept)
-      auto except = std::exception_ptr(nullptr);
+      const auto order = curve_order(_coordinates, size, num_threads);
 
       detail::dispatch(
           [&](size_t start, size_t end) {
-            try {
-              auto point = point_t();
-
-              for (size_t ix = start; ix < end; ++ix) {
-                point = std::move(
-                    std::invoke(converter, *this,
-                                Eigen::Map<const Vector<CoordinateType>>(
-                                    &_coordinates(ix, 0), M)));
-
-                auto result = detail::geometry::RTree<CoordinateType, Type, N>::
-                    inverse_distance_weighting(point, radius, k, p, within);
-                _data(ix) = result.first;
-                _neighbors(ix) = result.second;
-              }
-            } catch (...) {
-              except = std::current_exception();
+            auto point = point_t();
+            auto buffer = std::array<geodetic_t, M>();
+
+            for (size_t item = start; item < end; ++item) {
+              const auto ix = order[item];
+              point = std::move(
+                  std::invoke(converter, *this,
+                              _coordinates.row(ix, M, buffer.data())));
+
+              auto result = detail::geometry::RTree<CoordinateType, Type, N>::
+                  inverse_distance_weighting(point, radius, k, p, within, eps);
+              _data(ix) = result.first;
+              _neighbors(ix) = result.second;
             }
           },
-          size, num_threads);
-
-      if (except != nullptr) {
-        std::rethrow_exception(except);
-      }
+          size, num_threads, detail::kDynamic);
     }
     return pybind11::make_tuple(data, neighbors);
   }
@@ -548,12 +735,12 @@ class RTree : public detail::geometry::RTree<CoordinateType, Type, N> {
   /// Radial basis function interpolation
   template <size_t M>
   auto _rbf(Converter converter,
-            const pybind11::array_t<CoordinateType> &coordinates,
+            const pybind11::array &coordinates,
             const distance_t radius, const uint32_t k,
             const RadialBasisFunction rbf, const promotion_t epsilon,
             const promotion_t smooth, const bool within,
             const size_t num_threads) const -> pybind11::tuple {
-    auto _coordinates = coordinates.template unchecked<2>();
+    auto _coordinates = detail::numpy::ArrayReader<geodetic_t>(coordinates);
     auto size = coordinates.shape(0);
 
     // Construction of the interpolator.
@@ -570,39 +757,155 @@ class RTree : public detail::geometry::RTree<CoordinateType, Type, N> {
 
     {
       pybind11::gil_scoped_release release;
-
-      // Captures the detected exceptions in the calculation function
-      // (only the last exception captured is kept)
-      auto except = std::exception_ptr(nullptr);
+      const auto order = curve_order(_coordinates, size, num_threads);
 
       detail::dispatch(
           [&](size_t start, size_t end) {
-            try {
-              auto point = point_t();
-
-              for (size_t ix = start; ix < end; ++ix) {
-                point = std::move(
-                    std::invoke(converter, *this,
-                                Eigen::Map<const Vector<CoordinateType>>(
-                                    &_coordinates(ix, 0), M)));
-
-                auto result = detail::geometry::RTree<
-                    CoordinateType, Type, N>::radial_basis_function(point,
-                                                                    rbf_handler,
-                                                                    radius, k,
-                                                                    within);
-                _data(ix) = result.first;
-                _neighbors(ix) = result.second;
+            using Base = detail::geometry::RTree<CoordinateType, Type, N>;
+            constexpr auto kBatchSize = Base::kRBFBatchSize;
+            auto points = std::array<point_t, kBatchSize>();
+            auto values = std::array<promotion_t, kBatchSize>();
+            auto counts = std::array<uint32_t, kBatchSize>();
+            auto buffer = std::array<geodetic_t, M>();
+
+            // Consecutive points along the curve often select the same
+            // neighbors: their interpolants are solved only once. The
+            // systems of the other points are solved by blocks.
+            auto cache = rbf_cache_t(kCacheSize);
+            auto batch = typename Base::RBFBatch(k);
+
+            for (size_t first = start; first < end; first += kBatchSize) {
+              const auto count = std::min(end - first, kBatchSize);
+              for (size_t jx = 0; jx < count; ++jx) {
+                points[jx] = std::invoke(
+                    converter, *this,
+                    _coordinates.row(order[first + jx], M, buffer.data()));
+              }
+
+              Base::radial_basis_function(points.data(), count, rbf_handler,
+                                          radius, k, within, cache, batch,
+                                          values.data(), counts.data());
+              for (size_t jx = 0; jx < count; ++jx) {
+                const auto ix = order[first + jx];
+                _data(ix) = values[jx];
+                _neighbors(ix) = counts[jx];
               }
-            } catch (...) {
-              except = std::current_exception();
             }
           },
-          size, num_threads);
+          size, num_threads, detail::kDynamic);
+    }
+    return pybind11::make_tuple(data, neighbors);
+  }
 
-      if (except != nullptr) {
-        std::rethrow_exception(except);
-      }
+  /// Ordinary kriging
+  template <size_t M>
+  auto _kriging(Converter converter,
+                const pybind11::array &coordinates,
+                const distance_t radius, const uint32_t k,
+                const CovarianceFunction covariance, const promotion_t sigma,
+                const promotion_t lambda, const promotion_t nugget,
+                const bool within, const size_t num_threads) const
+      -> pybind11::tuple {
+    auto _coordinates = detail::numpy::ArrayReader<geodetic_t>(coordinates);
+    auto size = coordinates.shape(0);
+
+    // Construction of the estimator.
+    auto kriging_handler =
+        detail::math::Kriging<promotion_t>(sigma, lambda, nugget, covariance);
+
+    // Allocation of result vectors.
+    auto data =
+        pybind11::array_t<promotion_t>(pybind11::array::ShapeContainer{size});
+    auto variance =
+        pybind11::array_t<promotion_t>(pybind11::array::ShapeContainer{size});
+    auto neighbors =
+        pybind11::array_t<uint32_t>(pybind11::array::ShapeContainer{size});
+
+    auto _data = data.template mutable_unchecked<1>();
+    auto _variance = variance.template mutable_unchecked<1>();
+    auto _neighbors = neighbors.template mutable_unchecked<1>();
+
+    {
+      pybind11::gil_scoped_release release;
+      const auto order = curve_order(_coordinates, size, num_threads);
+
+      detail::dispatch(
+          [&](size_t start, size_t end) {
+            auto point = point_t();
+            auto buffer = std::array<geodetic_t, M>();
+
+            // The kriging systems of the neighborhoods shared by consecutive
+            // points along the curve are factorized only once.
+            auto cache = kriging_cache_t(kCacheSize);
+
+            for (size_t item = start; item < end; ++item) {
+              const auto ix = order[item];
+              point = std::move(
+                  std::invoke(converter, *this,
+                              _coordinates.row(ix, M, buffer.data())));
+
+              std::tie(_data(ix), _variance(ix), _neighbors(ix)) =
+                  detail::geometry::RTree<CoordinateType, Type, N>::kriging(
+                      point, kriging_handler, radius, k, within, &cache);
+            }
+          },
+          size, num_threads, detail::kDynamic);
+    }
+    return pybind11::make_tuple(data, variance, neighbors);
+  }
+
+  /// Compactly supported radial basis function interpolation
+  template <size_t M>
+  auto _compact_rbf(Converter converter,
+                    const pybind11::array &coordinates,
+                    const promotion_t radius, const promotion_t smooth,
+                    const Eigen::Index max_iterations,
+                    const promotion_t tolerance,
+                    const size_t num_threads) const -> pybind11::tuple {
+    auto _coordinates = detail::numpy::ArrayReader<geodetic_t>(coordinates);
+    auto size = coordinates.shape(0);
+
+    // Construction of the interpolator.
+    auto rbf_handler = detail::math::CompactRBF<promotion_t>(radius, smooth);
+
+    // Allocation of result vectors.
+    auto data =
+        pybind11::array_t<promotion_t>(pybind11::array::ShapeContainer{size});
+    auto neighbors =
+        pybind11::array_t<uint32_t>(pybind11::array::ShapeContainer{size});
+
+    auto _data = data.template mutable_unchecked<1>();
+    auto _neighbors = neighbors.template mutable_unchecked<1>();
+
+    {
+      pybind11::gil_scoped_release release;
+
+      // The linear system is solved once for all the points to interpolate.
+      const auto interpolant =
+          detail::geometry::RTree<CoordinateType, Type, N>::
+              fit_compact_radial_basis_function(rbf_handler, max_iterations,
+                                                tolerance, num_threads);
+      const auto order = curve_order(_coordinates, size, num_threads);
+
+      detail::dispatch(
+          [&](size_t start, size_t end) {
+            auto point = point_t();
+            auto buffer = std::array<geodetic_t, M>();
+
+            for (size_t item = start; item < end; ++item) {
+              const auto ix = order[item];
+              point = std::move(
+                  std::invoke(converter, *this,
+                              _coordinates.row(ix, M, buffer.data())));
+
+              auto result = detail::geometry::RTree<CoordinateType, Type, N>::
+                  compact_radial_basis_function(point, rbf_handler,
+                                                interpolant);
+              _data(ix) = result.first;
+              _neighbors(ix) = result.second;
+            }
+          },
+          size, num_threads, detail::kDynamic);
     }
     return pybind11::make_tuple(data, neighbors);
   }
@@ -610,12 +913,13 @@ class RTree : public detail::geometry::RTree<CoordinateType, Type, N> {
   /// Window function interpolation
   template <size_t M>
   auto _window_function(Converter converter,
-                        const pybind11::array_t<CoordinateType> &coordinates,
+                        const pybind11::array &coordinates,
                         const distance_t radius, const uint32_t k,
                         const WindowFunction wf, const distance_t arg,
-                        const bool within, const size_t num_threads) const
+                        const bool within, const size_t table_size,
+                        const size_t num_threads, const distance_t eps) const
       -> pybind11::tuple {
-    auto _coordinates = coordinates.template unchecked<2>();
+    auto _coordinates = detail::numpy::ArrayReader<geodetic_t>(coordinates);
     auto size = coordinates.shape(0);
 
     // Allocation of result vectors.
@@ -626,45 +930,43 @@ class RTree : public detail::geometry::RTree<CoordinateType, Type, N> {
 
     auto wf_handler = detail::math::WindowFunction<distance_t>(wf);
 
+    // The table is built once, then shared by all threads.
+    auto wf_table =
+        table_size != 0
+            ? std::make_optional(detail::math::WindowFunctionTable<distance_t>(
+                  wf_handler, radius, arg, table_size))
+            : std::nullopt;
+
     auto _data = data.template mutable_unchecked<1>();
     auto _neighbors = neighbors.template mutable_unchecked<1>();
 
     {
       pybind11::gil_scoped_release release;
-
-      // Captures the detected exceptions in the calculation function
-      // (only the last exception captured is kept)
-      auto except = std::exception_ptr(nullptr);
+      const auto order = curve_order(_coordinates, size, num_threads);
 
       detail::dispatch(
           [&](size_t start, size_t end) {
-            try {
-              auto point = point_t();
-
-              for (size_t ix = start; ix < end; ++ix) {
-                point = std::move(
-                    std::invoke(converter, *this,
-                                Eigen::Map<const Vector<CoordinateType>>(
-                                    &_coordinates(ix, 0), M)));
-
-                auto result =
-                    detail::geometry::RTree<CoordinateType, Type,
-                                            N>::window_function(point,
-                                                                wf_handler, arg,
-                                                                radius, k,
-                                                                within);
-                _data(ix) = result.first;
-                _neighbors(ix) = result.second;
-              }
-            } catch (...) {
-              except = std::current_exception();
+            auto point = point_t();
+            auto buffer = std::array<geodetic_t, M>();
+
+            for (size_t item = start; item < end; ++item) {
+              const auto ix = order[item];
+              point = std::move(
+                  std::invoke(converter, *this,
+                              _coordinates.row(ix, M, buffer.data())));
+
+              auto result =
+                  wf_table ? detail::geometry::RTree<CoordinateType, Type, N>::
+                                 window_function(point, *wf_table, k, within,
+                                                 eps)
+                           : detail::geometry::RTree<CoordinateType, Type, N>::
+                                 window_function(point, wf_handler, arg,
+                                                 radius, k, within, eps);
+              _data(ix) = result.first;
+              _neighbors(ix) = result.second;
             }
           },
-          size, num_threads);
-
-      if (except != nullptr) {
-        std::rethrow_exception(except);
-      }
+          size, num_threads, detail::kDynamic);
     }
     return pybind11::make_tuple(data, neighbors);
   }
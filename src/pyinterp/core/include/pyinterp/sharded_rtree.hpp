@@ -0,0 +1,364 @@
+// Copyright (c) 2022 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+#pragma once
+#include <pybind11/numpy.h>
+#include <pybind11/pybind11.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "pyinterp/detail/broadcast.hpp"
+#include "pyinterp/detail/geodetic/coordinates.hpp"
+#include "pyinterp/detail/geodetic/system.hpp"
+#include "pyinterp/detail/geometry/sharded_index.hpp"
+#include "pyinterp/detail/math.hpp"
+#include "pyinterp/detail/numpy.hpp"
+#include "pyinterp/detail/thread.hpp"
+#include "pyinterp/geohash/int64.hpp"
+
+namespace pyinterp {
+
+/// Spatial index of geodetic values sharded by geohash
+///
+/// The points are split into shards by the geohash, encoded as an integer
+/// with the given number of bits, of the cell containing them. A search
+/// explores the shard of the cell containing the point of interest, then the
+/// shards of the eight neighboring cells if the distance to the farthest of
+/// the K neighbors found, or the search radius, exceeds the distance from the
+/// point to the edges of its cell. The cells must therefore be larger than
+/// the distances searched: the neighbors located beyond the adjacent cells
+/// are not found.
+///
+/// Each shard can be written to its own file and mapped in memory: the
+/// processes of a cluster serving distinct regions only open the shards they
+/// need.
+///
+/// @tparam CoordinateType The class of storage for a point's coordinates.
+/// @tparam Type The type of data stored in the index.
+template <typename CoordinateType, typename Type>
+class ShardedRTree
+    : public detail::geometry::ShardedIndex<CoordinateType, Type, 3> {
+ public:
+  /// Base class
+  using base_t = detail::geometry::ShardedIndex<CoordinateType, Type, 3>;
+
+  /// Type of points handled by this instance
+  using point_t = typename base_t::point_t;
+
+  /// Type of distances between two points
+  using distance_t = typename base_t::distance_t;
+
+  /// Type of the geodetic coordinates provided by the user.
+  using geodetic_t = distance_t;
+
+  /// Default constructor
+  ///
+  /// @param wgs The geodetic system used to convert the coordinates.
+  /// @param precision Number of bits of the geohash identifying the shards.
+  ShardedRTree(const std::optional<detail::geodetic::System> &wgs,
+               const uint32_t precision)
+      : coordinates_(wgs.value_or(detail::geodetic::System())),
+        precision_(precision) {
+    if (precision < 1 || precision > 64) {
+      throw std::invalid_argument("precision must be within [1, 64]");
+    }
+  }
+
+  /// Returns the number of bits of the geohash identifying the shards.
+  [[nodiscard]] constexpr auto precision() const noexcept -> uint32_t {
+    return precision_;
+  }
+
+  /// Replaces the content of the index by the provided values.
+  ///
+  /// @param coordinates Matrix of the longitudes, latitudes and optionally
+  /// altitudes of the points.
+  /// @param values Values of the points.
+  /// @param num_threads The number of threads to use.
+  auto packing(const pybind11::array &coordinates,
+               const pybind11::array_t<Type> &values, const size_t num_threads)
+      -> void {
+    check_coordinates(coordinates);
+    detail::check_array_ndim("values", 1, values);
+    if (values.size() != coordinates.shape(0)) {
+      throw std::invalid_argument(
+          "coordinates and values could not be broadcast together");
+    }
+    auto _coordinates = detail::numpy::ArrayReader<geodetic_t>(coordinates);
+    auto _values = values.template unchecked<1>();
+    const auto altitude = coordinates.shape(1) == 3;
+    auto vector = std::vector<typename base_t::value_t>(coordinates.shape(0));
+    auto keys = std::vector<uint64_t>(vector.size());
+    {
+      auto gil = pybind11::gil_scoped_release();
+      detail::dispatch(
+          [&](size_t start, size_t end) {
+            for (size_t ix = start; ix < end; ++ix) {
+              vector[ix] = {to_ecef(_coordinates, ix, altitude), _values(ix)};
+              keys[ix] = geohash::int64::encode(to_point(_coordinates, ix),
+                                                precision_);
+            }
+          },
+          vector.size(), num_threads);
+      base_t::packing(std::move(vector), keys, num_threads);
+    }
+  }
+
+  /// Writes a shard to a file that load() maps in memory.
+  ///
+  /// @param key Geohash of the shard to write.
+  /// @param path Path to the file to create.
+  auto save(const uint64_t key, const std::string &path) const -> void {
+    base_t::save(key, path, metadata());
+  }
+
+  /// Opens a shard written by save(). The file is mapped read-only in memory
+  /// and must not be modified while the index is in use.
+  ///
+  /// @param key Geohash of the shard to open.
+  /// @param path Path to the file to open.
+  auto load(const uint64_t key, const std::string &path) -> void {
+    // The shard is only kept if it was written by an index identical to this
+    // one.
+    auto other = base_t();
+    if (other.load(key, path) != metadata()) {
+      throw std::invalid_argument(
+          "the shard does not match the geodetic system or the precision of "
+          "the index: " +
+          path);
+    }
+    base_t::load(key, path);
+  }
+
+  /// Search for the K nearest neighbors of the given points.
+  auto query(const pybind11::array &coordinates, const uint32_t k,
+             const std::optional<distance_t> &radius,
+             const size_t num_threads) const -> pybind11::tuple {
+    check_coordinates(coordinates);
+    auto _coordinates = detail::numpy::ArrayReader<geodetic_t>(coordinates);
+    const auto altitude = coordinates.shape(1) == 3;
+    const auto max_distance =
+        radius.value_or(std::numeric_limits<distance_t>::max());
+    auto size = coordinates.shape(0);
+
+    auto shape = std::vector<pybind11::ssize_t>{
+        size, static_cast<pybind11::ssize_t>(k)};
+    auto distance = pybind11::array_t<distance_t>(shape);
+    auto value = pybind11::array_t<Type>(shape);
+    auto _distance = distance.template mutable_unchecked<2>();
+    auto _value = value.template mutable_unchecked<2>();
+    {
+      auto gil = pybind11::gil_scoped_release();
+      detail::dispatch(
+          [&](size_t start, size_t end) {
+            auto neighbors = std::vector<typename base_t::neighbor_t>();
+            for (size_t ix = start; ix < end; ++ix) {
+              search(_coordinates, ix, altitude, k, max_distance, neighbors);
+              auto jx = 0U;
+              for (const auto &item : neighbors) {
+                _distance(ix, jx) = item.first;
+                _value(ix, jx) = item.second->second;
+                ++jx;
+              }
+              // The rest of the result is filled with invalid values.
+              for (; jx < k; ++jx) {
+                _distance(ix, jx) = -1;
+                _value(ix, jx) = Type(-1);
+              }
+            }
+          },
+          size, num_threads, detail::kDynamic);
+    }
+    return pybind11::make_tuple(distance, value);
+  }
+
+  /// Inverse distance weighting interpolation of the values at the given
+  /// points.
+  auto inverse_distance_weighting(const pybind11::array &coordinates,
+                                  const std::optional<distance_t> &radius,
+                                  const uint32_t k, const uint32_t p,
+                                  const size_t num_threads) const
+      -> pybind11::tuple {
+    check_coordinates(coordinates);
+    auto _coordinates = detail::numpy::ArrayReader<geodetic_t>(coordinates);
+    const auto altitude = coordinates.shape(1) == 3;
+    const auto max_distance =
+        radius.value_or(std::numeric_limits<distance_t>::max());
+    auto size = coordinates.shape(0);
+
+    auto data =
+        pybind11::array_t<distance_t>(pybind11::array::ShapeContainer{size});
+    auto neighbors =
+        pybind11::array_t<uint32_t>(pybind11::array::ShapeContainer{size});
+    auto _data = data.template mutable_unchecked<1>();
+    auto _neighbors = neighbors.template mutable_unchecked<1>();
+    {
+      auto gil = pybind11::gil_scoped_release();
+      detail::dispatch(
+          [&](size_t start, size_t end) {
+            auto items = std::vector<typename base_t::neighbor_t>();
+            for (size_t ix = start; ix < end; ++ix) {
+              search(_coordinates, ix, altitude, k, max_distance, items);
+              auto result = weighted_average(items, k, p);
+              _data(ix) = result.first;
+              _neighbors(ix) = result.second;
+            }
+          },
+          size, num_threads, detail::kDynamic);
+    }
+    return pybind11::make_tuple(data, neighbors);
+  }
+
+ private:
+  /// System for converting Geodetic coordinates into Cartesian coordinates.
+  detail::geodetic::Coordinates coordinates_;
+
+  /// Number of bits of the geohash identifying the shards.
+  uint32_t precision_;
+
+  /// Returns the user data stored in the files of the shards.
+  [[nodiscard]] auto metadata() const -> std::string {
+    const auto system = coordinates_.system();
+    const auto parameters =
+        std::array<double, 3>{system.semi_major_axis(), system.flattening(),
+                              static_cast<double>(precision_)};
+    auto result = std::string(sizeof(parameters), '\0');
+    std::memcpy(result.data(), parameters.data(), sizeof(parameters));
+    return result;
+  }
+
+  /// Search for the K nearest neighbors of the point of the given row of the
+  /// coordinates, in the shard of the cell containing it and, if needed, in
+  /// those of the neighboring cells.
+  auto search(const detail::numpy::ArrayReader<geodetic_t> &coordinates,
+              const size_t ix, const bool altitude, const uint32_t k,
+              const distance_t radius,
+              std::vector<typename base_t::neighbor_t> &neighbors) const
+      -> void {
+    const auto point = to_ecef(coordinates, ix, altitude);
+    const auto location = to_point(coordinates, ix);
+    const auto hash = geohash::int64::encode(location, precision_);
+    neighbors.clear();
+    base_t::nearest(point, hash, k, radius, neighbors);
+
+    const auto bound = neighbors.size() < k ? radius : neighbors.back().first;
+    if (bound <= margin(location, hash)) {
+      return;
+    }
+    const auto cells = geohash::int64::neighbors(hash, precision_);
+    for (Eigen::Index jx = 0; jx < cells.size(); ++jx) {
+      // Near the poles, several neighbors can be the same cell.
+      const auto cell = cells(jx);
+      if (cell != hash && std::find(cells.data(), cells.data() + jx, cell) ==
+                              cells.data() + jx) {
+        base_t::nearest(point, cell, k, radius, neighbors);
+      }
+    }
+  }
+
+  /// Returns a lower bound of the distance between a point and the points
+  /// located outside its cell: the chord of the angle between the point and
+  /// the nearest edge of the cell, on a sphere whose radius is the semi-minor
+  /// axis of the ellipsoid shrunk by twice its flattening, which covers the
+  /// difference between the geodetic and geocentric latitudes.
+  [[nodiscard]] auto margin(const geodetic::Point &location,
+                            const uint64_t hash) const -> distance_t {
+    const auto box = geohash::int64::bounding_box(hash, precision_);
+    const auto &min_corner = box.min_corner();
+    const auto &max_corner = box.max_corner();
+    auto angle = std::numeric_limits<double>::max();
+    // There is no cell beyond the poles.
+    if (min_corner.lat() > -90) {
+      angle = std::min(angle, location.lat() - min_corner.lat());
+    }
+    if (max_corner.lat() < 90) {
+      angle = std::min(angle, max_corner.lat() - location.lat());
+    }
+    angle = detail::math::radians(angle);
+    // Angle between the point and the great circles of the meridians
+    // bounding the cell.
+    const auto dlon = std::min(location.lon() - min_corner.lon(),
+                               max_corner.lon() - location.lon());
+    const auto sin_angle =
+        std::sin(detail::math::radians(dlon)) *
+        std::cos(detail::math::radians(location.lat()));
+    angle = std::min(angle, std::asin(std::min(sin_angle, 1.0)));
+    const auto system = coordinates_.system();
+    return static_cast<distance_t>(2 * system.semi_minor_axis() *
+                                   (1 - 2 * system.flattening()) *
+                                   std::sin(angle / 2));
+  }
+
+  /// Average of the values of the neighbors found, weighted by the inverse
+  /// of their distance to the power p.
+  static auto weighted_average(
+      const std::vector<typename base_t::neighbor_t> &neighbors,
+      const uint32_t k, const uint32_t p) -> std::pair<distance_t, uint32_t> {
+    distance_t result = 0;
+    distance_t total_weight = 0;
+    uint32_t count = 0;
+
+    for (const auto &item : neighbors) {
+      const auto distance = item.first;
+      const auto value = static_cast<distance_t>(item.second->second);
+      if (distance < 1e-6) {
+        // If the user has requested an observed point, its value is returned.
+        return std::make_pair(value, k);
+      }
+      const auto wk = 1 / std::pow(distance, static_cast<distance_t>(p));
+      total_weight += wk;
+      result += value * wk;
+      ++count;
+    }
+
+    return total_weight != 0
+               ? std::make_pair(static_cast<distance_t>(result / total_weight),
+                                count)
+               : std::make_pair(std::numeric_limits<distance_t>::quiet_NaN(),
+                                static_cast<uint32_t>(0));
+  }
+
+  /// Returns the longitude, within [-180, 180[, and the latitude of the row
+  /// of the coordinates provided.
+  static auto to_point(
+      const detail::numpy::ArrayReader<geodetic_t> &coordinates,
+      const size_t ix) -> geodetic::Point {
+    return {detail::math::normalize_angle<double>(coordinates(ix, 0), -180.0,
+                                                  360.0),
+            static_cast<double>(coordinates(ix, 1))};
+  }
+
+  /// Create the cartesian point of the row of the coordinates provided.
+  auto to_ecef(const detail::numpy::ArrayReader<geodetic_t> &coordinates,
+               const size_t ix, const bool altitude) const -> point_t {
+    auto ecef = coordinates_.lla_to_ecef(
+        detail::geometry::EquatorialPoint3D<geodetic_t>{
+            coordinates(ix, 0), coordinates(ix, 1),
+            altitude ? coordinates(ix, 2) : geodetic_t(0)});
+    return point_t(boost::geometry::get<0>(ecef),
+                   boost::geometry::get<1>(ecef),
+                   boost::geometry::get<2>(ecef));
+  }
+
+  /// Raise an exception if the coordinates are not a matrix of the
+  /// longitudes, latitudes and optionally altitudes.
+  static auto check_coordinates(const pybind11::array &coordinates) -> void {
+    detail::check_array_ndim("coordinates", 2, coordinates);
+    if (coordinates.shape(1) != 2 && coordinates.shape(1) != 3) {
+      throw std::invalid_argument(
+          "coordinates must be a matrix (n, 2) of longitudes and latitudes "
+          "or a matrix (n, 3) of longitudes, latitudes and altitudes");
+    }
+  }
+};
+
+}  // namespace pyinterp
@@ -9,10 +9,14 @@
 
 #include <memory>
 #include <optional>
+#include <tuple>
+#include <vector>
 
 #include "pyinterp/detail/broadcast.hpp"
 #include "pyinterp/detail/math/streaming_histogram.hpp"
 #include "pyinterp/detail/numpy.hpp"
+#include "pyinterp/detail/profiling.hpp"
+#include "pyinterp/detail/thread.hpp"
 #include "pyinterp/eigen.hpp"
 
 namespace pyinterp {
@@ -107,6 +111,40 @@ class StreamingHistogram {
     return calculate_statistics(&Accumulators::quantile, q);
   }
 
+  /// Returns several quantiles of samples, computed in a single pass over
+  /// each histogram. The histograms are processed in parallel.
+  [[nodiscard]] auto quantiles(
+      const pybind11::array_t<T, pybind11::array::c_style |
+                                     pybind11::array::forcecast>& q,
+      const size_t num_threads) const -> pybind11::array_t<T> {
+    detail::check_array_ndim("q", 1, q);
+    auto order = std::vector<size_t>();
+    auto sorted = std::vector<T>();
+    std::tie(order, sorted) = detail::math::sort_quantiles(q.data(), q.size());
+    const auto size = sorted.size();
+    auto shape = std::vector<pybind11::ssize_t>(shape_);
+    shape.push_back(static_cast<pybind11::ssize_t>(size));
+    auto result = pybind11::array_t<T>(shape);
+    auto* ptr_result = result.mutable_data();
+    {
+      pybind11::gil_scoped_release release;
+
+      detail::dispatch(
+          [&](const size_t start, const size_t end) {
+            auto values = std::vector<T>(size);
+            for (auto ix = start; ix < end; ++ix) {
+              accumulators_[ix].quantiles(sorted.data(), size, values.data());
+              auto* item = ptr_result + ix * size;
+              for (size_t jx = 0; jx < size; ++jx) {
+                item[order[jx]] = values[jx];
+              }
+            }
+          },
+          accumulators_.size(), num_threads);
+    }
+    return result;
+  }
+
   /// Returns the variance of samples.
   [[nodiscard]] auto variance() const -> pybind11::array_t<T> {
     return calculate_statistics(&Accumulators::variance);
@@ -221,9 +259,10 @@ class StreamingHistogram {
 
       std::for_each(ptr_arr, ptr_arr + arr.size(), [&item](const auto& value) {
         if (!std::isnan(value)) {
-          item(value);
+          item.buffer(value);
         }
       });
+      item.flush();
     }
   }
 
@@ -241,9 +280,10 @@ class StreamingHistogram {
       for (auto ix = 0; ix < arr.size(); ++ix) {
         const auto xi = ptr_arr[ix];
         if (!std::isnan(xi)) {
-          item(xi, ptr_weights[ix]);
+          item.buffer(xi, ptr_weights[ix]);
         }
       }
+      item.flush();
     }
   }
 
@@ -264,9 +304,12 @@ class StreamingHistogram {
         if (!std::isnan(xi)) {
           detail::numpy::unravel(ix, strides, indexes);
           auto jx = (indexes.array() * adjusted_strides.array()).sum();
-          accumulators_[jx](xi, ptr_weights[ix]);
+          accumulators_[jx].buffer(xi, ptr_weights[ix]);
         }
       }
+      std::for_each(accumulators_.data(),
+                    accumulators_.data() + accumulators_.size(),
+                    [](auto& item) { item.flush(); });
     }
   }
 
@@ -289,16 +332,23 @@ class StreamingHistogram {
 
   [[nodiscard]] auto marshal() const -> pybind11::bytes {
     auto gil = pybind11::gil_scoped_release();
+    auto scope = detail::profiling::Scope(detail::profiling::kHistogramMarshal);
     auto ss = std::stringstream();
     ss.exceptions(std::stringstream::failbit);
     auto size = accumulators_.size();
     ss.write(reinterpret_cast<const char*>(&size), sizeof(size));
     for (int ix = 0; ix < size; ++ix) {
       auto marshal_hist = static_cast<std::string>(accumulators_(ix));
+      auto memory = detail::profiling::Allocation(
+          detail::profiling::kHistogramMarshal, marshal_hist.size());
       auto size = marshal_hist.size();
       ss.write(reinterpret_cast<const char*>(&size), sizeof(size));
       ss.write(marshal_hist.c_str(), static_cast<std::streamsize>(size));
     }
+    // The buffer of the stream is copied into the serialized state.
+    auto memory = detail::profiling::Allocation(
+        detail::profiling::kHistogramMarshal,
+        2 * static_cast<size_t>(ss.tellp()));
     return ss.str();
   }
 
@@ -8,7 +8,10 @@
 
 #include <cstdint>
 #include <memory>
+#include <optional>
 #include <string>
+#include <type_traits>
+#include <utility>
 
 #include "pyinterp/axis.hpp"
 #include "pyinterp/dateutils.hpp"
@@ -100,6 +103,14 @@ class TemporalAxis : public Axis<int64_t> {
                        dtype_);
   }
 
+  /// @copydoc Axis::view(const int64_t, const int64_t) const
+  [[nodiscard]] auto view(const int64_t start, const int64_t stop) const
+      -> std::shared_ptr<Axis<int64_t>> override {
+    auto result = std::make_shared<TemporalAxis>(*this);
+    result->narrow(start, stop);
+    return result;
+  }
+
   /// @copydoc Axis::coordinates_values(const pybind11::slice&) const
   auto coordinate_values(const pybind11::slice& slice) const
       -> pybind11::array {
@@ -175,29 +186,32 @@ class TemporalAxis : public Axis<int64_t> {
   [[nodiscard]] auto safe_cast(const std::string& name,
                                const pybind11::array& coordinates) const
       -> pybind11::array {
-    auto dtype = detail::dtype(name, coordinates);
-
-    if (dtype.datetype() != dtype_.datetype()) {
-      throw std::runtime_error("Cannot cast " + name + " to " +
-                               static_cast<std::string>(dtype) +
-                               " because the time axis is defined in " +
-                               static_cast<std::string>(dtype_));
-    }
-
-    if (dtype_ < dtype) {
-      auto message = "implicit conversion turns " +
-                     static_cast<std::string>(dtype) + " into " +
-                     static_cast<std::string>(dtype_);
-      if (PyErr_WarnEx(PyExc_UserWarning, message.c_str(), 1) == -1) {
-        throw pybind11::error_already_set();
-      }
-    }
+    auto dtype = check_dtype(name, coordinates);
+    warn_precision_loss(dtype);
     if (dtype_ == dtype) {
       return coordinates;
     }
     return coordinates.attr("astype")(static_cast<std::string>(dtype_));
   }
 
+  /// Get the conversion of the dates of the vector in the same unit as the
+  /// time axis defined in this instance, which is applied when the dates are
+  /// read instead of copying the vector.
+  ///
+  /// @return the conversion, or std::nullopt if the dates cannot be converted
+  /// without a calendar (years or months): safe_cast must be used instead.
+  [[nodiscard]] auto resolution_cast(const std::string& name,
+                                     const pybind11::array& coordinates) const
+      -> std::optional<dateutils::ResolutionCast> {
+    auto dtype = check_dtype(name, coordinates);
+    if (!dateutils::ResolutionCast::is_fixed(dtype) ||
+        !dateutils::ResolutionCast::is_fixed(dtype_)) {
+      return std::nullopt;
+    }
+    warn_precision_loss(dtype);
+    return dateutils::ResolutionCast(dtype, dtype_);
+  }
+
   /// @copydoc detail::Axis::getstate() const
   [[nodiscard]] auto getstate() const -> pybind11::tuple {
     return pybind11::make_tuple(Axis<int64_t>::getstate(),
@@ -241,6 +255,33 @@ class TemporalAxis : public Axis<int64_t> {
  private:
   dateutils::DType dtype_;
 
+  /// Check that the vector holds dates of the same type as the time axis,
+  /// and returns their type.
+  [[nodiscard]] auto check_dtype(const std::string& name,
+                                 const pybind11::array& coordinates) const
+      -> dateutils::DType {
+    auto dtype = detail::dtype(name, coordinates);
+    if (dtype.datetype() != dtype_.datetype()) {
+      throw std::runtime_error("Cannot cast " + name + " to " +
+                               static_cast<std::string>(dtype) +
+                               " because the time axis is defined in " +
+                               static_cast<std::string>(dtype_));
+    }
+    return dtype;
+  }
+
+  /// Warn the user if the dates are converted to a coarser resolution.
+  auto warn_precision_loss(const dateutils::DType& dtype) const -> void {
+    if (dtype_ < dtype) {
+      auto message = "implicit conversion turns " +
+                     static_cast<std::string>(dtype) + " into " +
+                     static_cast<std::string>(dtype_);
+      if (PyErr_WarnEx(PyExc_UserWarning, message.c_str(), 1) == -1) {
+        throw pybind11::error_already_set();
+      }
+    }
+  }
+
   /// Construct a new instance from the base class.
   TemporalAxis(Axis<int64_t> base, const dateutils::DType& dtype)
       : Axis<int64_t>(std::move(base)), dtype_(dtype) {}
@@ -255,4 +296,82 @@ class TemporalAxis : public Axis<int64_t> {
   }
 };
 
+/// Reads the coordinates of the points located on a time axis, in the
+/// resolution of this axis. The dates are converted when they are read,
+/// which avoids copying the vector provided.
+class TemporalCoordinates {
+ public:
+  /// Default constructor
+  ///
+  /// @param axis Time axis of the grid.
+  /// @param name Name of the vector, used in the error messages.
+  /// @param coordinates Dates or durations to read. A vector of numbers is
+  /// considered as expressed in the unit of the axis.
+  TemporalCoordinates(const Axis<int64_t>& axis, const std::string& name,
+                      const pybind11::array& coordinates) {
+    auto values = pybind11::array(coordinates);
+    const auto kind = coordinates.dtype().kind();
+    if (kind == 'M' || kind == 'm') {
+      const auto* temporal = dynamic_cast<const TemporalAxis*>(&axis);
+      if (temporal == nullptr) {
+        throw std::invalid_argument(
+            name + " holds dates but the axis of the grid does not");
+      }
+      auto cast = temporal->resolution_cast(name, coordinates);
+      if (cast) {
+        cast_ = *cast;
+      } else {
+        values = temporal->safe_cast(name, coordinates);
+      }
+    } else {
+      values = coordinates.cast<pybind11::array_t<int64_t>>();
+    }
+    data_ = static_cast<const char*>(values.data());
+    stride_ = values.strides(0);
+    coordinates_ = std::move(values);
+  }
+
+  /// Get the coordinate of the point ix.
+  inline auto operator()(const pybind11::ssize_t ix) const noexcept
+      -> int64_t {
+    return cast_(*reinterpret_cast<const int64_t*>(data_ + ix * stride_));
+  }
+
+ private:
+  /// The vector read, kept alive during the reading.
+  pybind11::object coordinates_{};
+  /// Conversion of the values read.
+  dateutils::ResolutionCast cast_{};
+  /// Address of the first value.
+  const char* data_{nullptr};
+  /// Number of bytes between two values.
+  pybind11::ssize_t stride_{0};
+};
+
+/// Type of the vectors holding the coordinates of the points located on an
+/// axis: the dates located on a time axis are read in their own resolution.
+template <typename AxisType>
+using AxisCoordinates =
+    std::conditional_t<std::is_same_v<AxisType, int64_t>, pybind11::array,
+                       pybind11::array_t<AxisType>>;
+
+/// Get the function reading the coordinates of the points located on an
+/// axis.
+template <typename AxisType>
+inline auto coordinates_reader(const Axis<AxisType>& /* axis */,
+                               const std::string& /* name */,
+                               const pybind11::array_t<AxisType>& coordinates)
+    -> pybind11::detail::unchecked_reference<AxisType, 1> {
+  return coordinates.template unchecked<1>();
+}
+
+/// Get the function reading the coordinates of the points located on a time
+/// axis.
+inline auto coordinates_reader(const Axis<int64_t>& axis,
+                               const std::string& name,
+                               const pybind11::array& coordinates)
+    -> TemporalCoordinates {
+  return {axis, name, coordinates};
+}
+
 }  // namespace pyinterp
@@ -0,0 +1,216 @@
+// Copyright (c) 2022 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+#pragma once
+#include <pybind11/numpy.h>
+#include <pybind11/pybind11.h>
+
+#include <limits>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "pyinterp/detail/broadcast.hpp"
+#include "pyinterp/detail/geodetic/coordinates.hpp"
+#include "pyinterp/detail/geodetic/system.hpp"
+#include "pyinterp/detail/geometry/temporal_index.hpp"
+#include "pyinterp/detail/numpy.hpp"
+#include "pyinterp/detail/thread.hpp"
+
+namespace pyinterp {
+
+/// Spatio-temporal index of geodetic observations
+///
+/// The observations are dated by integer times, in a unit chosen by the
+/// caller, and split into partitions covering a fixed period of time. The
+/// searches are restricted to a time window around the time of each point of
+/// interest.
+///
+/// @tparam CoordinateType The class of storage for a point's coordinates.
+/// @tparam Type The type of data stored in the index.
+template <typename CoordinateType, typename Type>
+class TemporalRTree
+    : public detail::geometry::TemporalIndex<CoordinateType, Type, 3> {
+ public:
+  /// Base class
+  using base_t = detail::geometry::TemporalIndex<CoordinateType, Type, 3>;
+
+  /// Type of points handled by this instance
+  using point_t = typename base_t::point_t;
+
+  /// Type of distances between two points
+  using distance_t = typename base_t::distance_t;
+
+  /// Type of the geodetic coordinates provided by the user.
+  using geodetic_t = distance_t;
+
+  /// Default constructor
+  ///
+  /// @param wgs The geodetic system used to convert the coordinates.
+  /// @param period Duration of the partitions.
+  TemporalRTree(const std::optional<detail::geodetic::System> &wgs,
+                const int64_t period)
+      : base_t(period),
+        coordinates_(wgs.value_or(detail::geodetic::System())) {}
+
+  /// Replaces the content of the index by the provided observations.
+  ///
+  /// @param coordinates Matrix of the longitudes, latitudes and optionally
+  /// altitudes of the observations.
+  /// @param times Times of the observations.
+  /// @param values Values observed.
+  /// @param num_threads The number of threads to use.
+  auto packing(const pybind11::array &coordinates,
+               const pybind11::array_t<int64_t> &times,
+               const pybind11::array_t<Type> &values, const size_t num_threads)
+      -> void {
+    check_coordinates(coordinates);
+    detail::check_array_ndim("times", 1, times, "values", 1, values);
+    if (times.size() != coordinates.shape(0) ||
+        values.size() != coordinates.shape(0)) {
+      throw std::invalid_argument(
+          "coordinates, times and values could not be broadcast together");
+    }
+    auto _coordinates = detail::numpy::ArrayReader<geodetic_t>(coordinates);
+    auto _times = times.template unchecked<1>();
+    auto _values = values.template unchecked<1>();
+    const auto altitude = coordinates.shape(1) == 3;
+    auto vector = std::vector<typename base_t::value_t>(coordinates.shape(0));
+    {
+      auto gil = pybind11::gil_scoped_release();
+      detail::dispatch(
+          [&](size_t start, size_t end) {
+            for (size_t ix = start; ix < end; ++ix) {
+              vector[ix] = {to_ecef(_coordinates, ix, altitude),
+                            {_times(ix), _values(ix)}};
+            }
+          },
+          vector.size(), num_threads);
+      base_t::packing(std::move(vector), num_threads);
+    }
+  }
+
+  /// Search for the K nearest neighbors of the given points, observed within
+  /// a time window.
+  auto query(const pybind11::array &coordinates,
+             const pybind11::array_t<int64_t> &times, const int64_t window,
+             const uint32_t k, const size_t num_threads) const
+      -> pybind11::tuple {
+    check_query(coordinates, times, window);
+    auto _coordinates = detail::numpy::ArrayReader<geodetic_t>(coordinates);
+    auto _times = times.template unchecked<1>();
+    const auto altitude = coordinates.shape(1) == 3;
+    auto size = coordinates.shape(0);
+
+    auto shape = std::vector<pybind11::ssize_t>{
+        size, static_cast<pybind11::ssize_t>(k)};
+    auto distance = pybind11::array_t<distance_t>(shape);
+    auto value = pybind11::array_t<Type>(shape);
+    auto _distance = distance.template mutable_unchecked<2>();
+    auto _value = value.template mutable_unchecked<2>();
+    {
+      auto gil = pybind11::gil_scoped_release();
+      detail::dispatch(
+          [&](size_t start, size_t end) {
+            for (size_t ix = start; ix < end; ++ix) {
+              auto jx = base_t::query(to_ecef(_coordinates, ix, altitude),
+                                      _times(ix), window, k,
+                                      _distance.mutable_data(ix, 0),
+                                      _value.mutable_data(ix, 0));
+              // The rest of the result is filled with invalid values.
+              for (; jx < k; ++jx) {
+                _distance(ix, jx) = -1;
+                _value(ix, jx) = Type(-1);
+              }
+            }
+          },
+          size, num_threads, detail::kDynamic);
+    }
+    return pybind11::make_tuple(distance, value);
+  }
+
+  /// Inverse distance weighting interpolation of the observations made
+  /// within a time window.
+  auto inverse_distance_weighting(const pybind11::array &coordinates,
+                                  const pybind11::array_t<int64_t> &times,
+                                  const int64_t window,
+                                  const std::optional<distance_t> &radius,
+                                  const uint32_t k, const uint32_t p,
+                                  const size_t num_threads) const
+      -> pybind11::tuple {
+    check_query(coordinates, times, window);
+    auto _coordinates = detail::numpy::ArrayReader<geodetic_t>(coordinates);
+    auto _times = times.template unchecked<1>();
+    const auto altitude = coordinates.shape(1) == 3;
+    const auto max_distance =
+        radius.value_or(std::numeric_limits<distance_t>::max());
+    auto size = coordinates.shape(0);
+
+    auto data =
+        pybind11::array_t<distance_t>(pybind11::array::ShapeContainer{size});
+    auto neighbors =
+        pybind11::array_t<uint32_t>(pybind11::array::ShapeContainer{size});
+    auto _data = data.template mutable_unchecked<1>();
+    auto _neighbors = neighbors.template mutable_unchecked<1>();
+    {
+      auto gil = pybind11::gil_scoped_release();
+      detail::dispatch(
+          [&](size_t start, size_t end) {
+            for (size_t ix = start; ix < end; ++ix) {
+              auto result = base_t::inverse_distance_weighting(
+                  to_ecef(_coordinates, ix, altitude), _times(ix), window,
+                  max_distance, k, p);
+              _data(ix) = result.first;
+              _neighbors(ix) = result.second;
+            }
+          },
+          size, num_threads, detail::kDynamic);
+    }
+    return pybind11::make_tuple(data, neighbors);
+  }
+
+ private:
+  /// System for converting Geodetic coordinates into Cartesian coordinates.
+  detail::geodetic::Coordinates coordinates_;
+
+  /// Create the cartesian point of the row of the coordinates provided.
+  auto to_ecef(const detail::numpy::ArrayReader<geodetic_t> &coordinates,
+               const size_t ix, const bool altitude) const -> point_t {
+    auto ecef = coordinates_.lla_to_ecef(
+        detail::geometry::EquatorialPoint3D<geodetic_t>{
+            coordinates(ix, 0), coordinates(ix, 1),
+            altitude ? coordinates(ix, 2) : geodetic_t(0)});
+    return point_t(boost::geometry::get<0>(ecef),
+                   boost::geometry::get<1>(ecef),
+                   boost::geometry::get<2>(ecef));
+  }
+
+  /// Raise an exception if the coordinates are not a matrix of the
+  /// longitudes, latitudes and optionally altitudes.
+  static auto check_coordinates(const pybind11::array &coordinates) -> void {
+    detail::check_array_ndim("coordinates", 2, coordinates);
+    if (coordinates.shape(1) != 2 && coordinates.shape(1) != 3) {
+      throw std::invalid_argument(
+          "coordinates must be a matrix (n, 2) of longitudes and latitudes "
+          "or a matrix (n, 3) of longitudes, latitudes and altitudes");
+    }
+  }
+
+  /// Raise an exception if the arguments of a query are invalid.
+  static auto check_query(const pybind11::array &coordinates,
+                          const pybind11::array_t<int64_t> &times,
+                          const int64_t window) -> void {
+    check_coordinates(coordinates);
+    detail::check_array_ndim("times", 1, times);
+    if (times.size() != coordinates.shape(0)) {
+      throw std::invalid_argument(
+          "coordinates and times could not be broadcast together");
+    }
+    if (window < 0) {
+      throw std::invalid_argument("the time window must be positive");
+    }
+  }
+};
+
+}  // namespace pyinterp
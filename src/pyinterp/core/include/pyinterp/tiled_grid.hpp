@@ -0,0 +1,194 @@
+// Copyright (c) 2022 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+#pragma once
+#include <pybind11/numpy.h>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "pyinterp/axis.hpp"
+#include "pyinterp/detail/broadcast.hpp"
+#include "pyinterp/detail/math/bicubic_coefficients.hpp"
+
+namespace pyinterp {
+
+/// Cartesian Grid 2D whose values are copied into square tiles stored
+/// contiguously.
+///
+/// With the row-major layout of the NumPy arrays, two neighbouring values
+/// along the X axis are one row of the array apart: the window of a bicubic
+/// interpolation or of a LOESS filter reads a cache line per row, spread over
+/// the whole array. The tiles keep the values of a neighbourhood in a few
+/// kilobytes of memory.
+///
+/// @tparam DataType Grid data type
+template <typename DataType>
+class TiledGrid2D {
+ public:
+  /// Number of bits of the indexes inside a tile.
+  static constexpr int64_t kTileBits = 4;
+
+  /// Number of values of a tile along each axis.
+  static constexpr int64_t kTileSize = int64_t(1) << kTileBits;
+
+  /// Default constructor
+  ///
+  /// @param x X-Axis
+  /// @param y Y-Axis
+  /// @param array Values of the grid, copied into the tiles.
+  TiledGrid2D(std::shared_ptr<Axis<double>> x, std::shared_ptr<Axis<double>> y,
+              const pybind11::array_t<DataType>& array)
+      : x_(std::move(x)),
+        y_(std::move(y)),
+        y_tiles_((y_->size() + kTileSize - 1) >> kTileBits) {
+    detail::check_array_ndim("array", 2, array);
+    if (x_->size() != array.shape(0) || y_->size() != array.shape(1)) {
+      throw std::invalid_argument(
+          "x, y could not be broadcast together with shape (" +
+          std::to_string(x_->size()) + ", " + std::to_string(y_->size()) +
+          ") " + detail::ndarray_shape(array));
+    }
+    const auto x_tiles = (x_->size() + kTileSize - 1) >> kTileBits;
+    values_.resize(x_tiles * y_tiles_ * kTileSize * kTileSize);
+
+    auto _array = array.template unchecked<2>();
+    for (int64_t ix = 0; ix < x_->size(); ++ix) {
+      for (int64_t iy = 0; iy < y_->size(); ++iy) {
+        values_[offset(ix, iy)] = _array(ix, iy);
+      }
+    }
+  }
+
+  /// Gets the X-Axis
+  [[nodiscard]] inline auto x() const noexcept
+      -> const std::shared_ptr<Axis<double>>& {
+    return x_;
+  }
+
+  /// Gets the Y-Axis
+  [[nodiscard]] inline auto y() const noexcept
+      -> const std::shared_ptr<Axis<double>>& {
+    return y_;
+  }
+
+  /// Gets a copy of the values of the grid, in row-major order.
+  [[nodiscard]] auto array() const -> pybind11::array_t<DataType> {
+    auto result = pybind11::array_t<DataType>(
+        pybind11::array::ShapeContainer{x_->size(), y_->size()});
+    auto _result = result.template mutable_unchecked<2>();
+    for (int64_t ix = 0; ix < x_->size(); ++ix) {
+      for (int64_t iy = 0; iy < y_->size(); ++iy) {
+        _result(ix, iy) = values_[offset(ix, iy)];
+      }
+    }
+    return result;
+  }
+
+  /// Gets the grid value for the coordinate pixel (ix, iy).
+  inline auto value(const int64_t ix, const int64_t iy) const noexcept
+      -> const DataType& {
+    return values_[offset(ix, iy)];
+  }
+
+  /// The coefficients of the bicubic interpolation are not precomputed for
+  /// the tiled grids: returns a null pointer.
+  [[nodiscard]] inline auto bicubic_coefficients() const noexcept
+      -> std::shared_ptr<const detail::math::BicubicCoefficients> {
+    return nullptr;
+  }
+
+  /// Pickle support: get state of this instance
+  [[nodiscard]] auto getstate() const -> pybind11::tuple {
+    return pybind11::make_tuple(x_->getstate(), y_->getstate(), array());
+  }
+
+  /// Pickle support: set state of this instance
+  static auto setstate(const pybind11::tuple& tuple) -> TiledGrid2D {
+    if (tuple.size() != 3) {
+      throw std::runtime_error("invalid state");
+    }
+    return TiledGrid2D(
+        std::make_shared<Axis<double>>(
+            Axis<double>::setstate(tuple[0].cast<pybind11::tuple>())),
+        std::make_shared<Axis<double>>(
+            Axis<double>::setstate(tuple[1].cast<pybind11::tuple>())),
+        tuple[2].cast<pybind11::array_t<DataType>>());
+  }
+
+ private:
+  std::shared_ptr<Axis<double>> x_;
+  std::shared_ptr<Axis<double>> y_;
+  int64_t y_tiles_;
+  std::vector<DataType> values_{};
+
+  /// Gets the position of the value (ix, iy): the tiles are stored in
+  /// row-major order, as the values of each tile.
+  [[nodiscard]] inline auto offset(const int64_t ix,
+                                   const int64_t iy) const noexcept -> size_t {
+    constexpr auto mask = kTileSize - 1;
+    const auto tile = (ix >> kTileBits) * y_tiles_ + (iy >> kTileBits);
+    return static_cast<size_t>((tile << (2 * kTileBits)) +
+                               ((ix & mask) << kTileBits) + (iy & mask));
+  }
+};
+
+/// Implementations of Cartesian grids stored by tiles.
+///
+/// @tparam DataType Grid data type
+template <typename DataType>
+void implement_tiled_grid(pybind11::module& m, const std::string& suffix) {
+  pybind11::class_<TiledGrid2D<DataType>>(
+      m, ("TiledGrid2D" + suffix).c_str(),
+      "Cartesian Grid 2D whose values are stored by tiles")
+      .def(pybind11::init<std::shared_ptr<Axis<double>>,
+                          std::shared_ptr<Axis<double>>,
+                          const pybind11::array_t<DataType>&>(),
+           pybind11::arg("x"), pybind11::arg("y"), pybind11::arg("array"),
+           R"__doc__(
+Default constructor
+
+The values of the array are copied into square tiles of 16 x 16 values, so
+that the values of a neighborhood are close in memory.
+
+Args:
+    x (pyinterp.core.Axis): X-Axis
+    y (pyinterp.core.Axis): Y-Axis
+    array (numpy.ndarray): Bivariate function
+)__doc__")
+      .def_property_readonly(
+          "x", [](const TiledGrid2D<DataType>& self) { return self.x(); },
+          R"__doc__(
+Gets the X-Axis handled by this instance
+
+Returns:
+    pyinterp.core.Axis: X-Axis
+)__doc__")
+      .def_property_readonly(
+          "y", [](const TiledGrid2D<DataType>& self) { return self.y(); },
+          R"__doc__(
+Gets the Y-Axis handled by this instance
+
+Returns:
+    pyinterp.core.Axis: Y-Axis
+)__doc__")
+      .def_property_readonly(
+          "array",
+          [](const TiledGrid2D<DataType>& self) { return self.array(); },
+          R"__doc__(
+Gets a copy of the values handled by this instance
+
+Returns:
+    numpy.ndarray: values
+)__doc__")
+      .def(pybind11::pickle(
+          [](const TiledGrid2D<DataType>& self) { return self.getstate(); },
+          [](const pybind11::tuple& state) {
+            return TiledGrid2D<DataType>::setstate(state);
+          }));
+}
+
+}  // namespace pyinterp
@@ -6,13 +6,21 @@
 #include <pybind11/numpy.h>
 #include <pybind11/stl.h>
 
+#include <algorithm>
+#include <array>
 #include <cctype>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
 
 #include "pyinterp/bivariate.hpp"
+#include "pyinterp/chunked_grid.hpp"
 #include "pyinterp/detail/geometry/point.hpp"
 #include "pyinterp/detail/math/trivariate.hpp"
 #include "pyinterp/detail/thread.hpp"
 #include "pyinterp/grid.hpp"
+#include "pyinterp/temporal_axis.hpp"
 
 namespace pyinterp {
 
@@ -20,16 +28,31 @@ namespace pyinterp {
 template <template <class> class Point, typename T>
 using Bivariate3D = detail::math::Bivariate<Point, T>;
 
+/// Cell of a 3D grid framing a point: indexes of its corners and the point
+/// expressed in the coordinate system of the interpolator.
+template <template <class> class Point, typename Coordinate>
+struct TrivariateCell {
+  int64_t ix0;
+  int64_t ix1;
+  int64_t iy0;
+  int64_t iy1;
+  int64_t iz0;
+  int64_t iz1;
+  Point<Coordinate> p;
+  Point<Coordinate> p0;
+  Point<Coordinate> p1;
+};
+
+/// Search the cell framing a point, or raise an index error if the point is
+/// outside the grid and bounds_error is set.
 template <template <class> class Point, typename Coordinate, typename AxisType,
           typename Type>
-inline auto _trivariate(const Grid3D<Type, AxisType>& grid, const Coordinate& x,
-                        const Coordinate& y, const AxisType& z,
-                        const Axis<double>& x_axis, const Axis<double>& y_axis,
-                        const Axis<AxisType>& z_axis,
-                        const Bivariate3D<Point, Coordinate>* interpolator,
-                        const detail::math::z_method_t<AxisType, Coordinate>&
-                            z_interpolation_method,
-                        const bool bounds_error) -> Coordinate {
+inline auto _trivariate_cell(const Coordinate& x, const Coordinate& y,
+                             const AxisType& z, const Axis<double>& x_axis,
+                             const Axis<double>& y_axis,
+                             const Axis<AxisType>& z_axis,
+                             const bool bounds_error)
+    -> std::optional<TrivariateCell<Point, Coordinate>> {
   auto x_indexes = x_axis.find_indexes(x);
   auto y_indexes = y_axis.find_indexes(y);
   auto z_indexes = z_axis.find_indexes(z);
@@ -41,20 +64,16 @@ inline auto _trivariate(const Grid3D<Type, AxisType>& grid, const Coordinate& x,
 
     // The fourth coordinate is not used by the 3D interpolator.
     auto x0 = x_axis(ix0);
-    auto p = Point<Coordinate>(x_axis.normalize_coordinate(x, x0), y, z);
-    auto p0 = Point<Coordinate>(x0, y_axis(iy0), z_axis(iz0));
-    auto p1 = Point<Coordinate>(x_axis(ix1), y_axis(iy1), z_axis(iz1));
-
-    return pyinterp::detail::math::trivariate<Point, Coordinate>(
-        p, p0, p1, static_cast<Coordinate>(grid.value(ix0, iy0, iz0)),
-        static_cast<Coordinate>(grid.value(ix0, iy1, iz0)),
-        static_cast<Coordinate>(grid.value(ix1, iy0, iz0)),
-        static_cast<Coordinate>(grid.value(ix1, iy1, iz0)),
-        static_cast<Coordinate>(grid.value(ix0, iy0, iz1)),
-        static_cast<Coordinate>(grid.value(ix0, iy1, iz1)),
-        static_cast<Coordinate>(grid.value(ix1, iy0, iz1)),
-        static_cast<Coordinate>(grid.value(ix1, iy1, iz1)), interpolator,
-        z_interpolation_method);
+    return TrivariateCell<Point, Coordinate>{
+        ix0,
+        ix1,
+        iy0,
+        iy1,
+        iz0,
+        iz1,
+        Point<Coordinate>(x_axis.normalize_coordinate(x, x0), y, z),
+        Point<Coordinate>(x0, y_axis(iy0), z_axis(iz0)),
+        Point<Coordinate>(x_axis(ix1), y_axis(iy1), z_axis(iz1))};
   }
 
   if (bounds_error) {
@@ -66,7 +85,121 @@ inline auto _trivariate(const Grid3D<Type, AxisType>& grid, const Coordinate& x,
     }
     Grid3D<Type, AxisType>::index_error(z_axis, z, "z");
   }
-  return std::numeric_limits<Coordinate>::quiet_NaN();
+  return {};
+}
+
+/// Interpolates the values of a grid in a cell.
+template <template <class> class Point, typename Coordinate, typename AxisType,
+          typename Grid, typename Interpolator>
+inline auto _trivariate_value(
+    const Grid& grid, const TrivariateCell<Point, Coordinate>& cell,
+    const Interpolator* interpolator,
+    const detail::math::z_method_t<AxisType, Coordinate>&
+        z_interpolation_method) -> Coordinate {
+  return pyinterp::detail::math::trivariate<Point, Coordinate>(
+      cell.p, cell.p0, cell.p1,
+      static_cast<Coordinate>(grid.value(cell.ix0, cell.iy0, cell.iz0)),
+      static_cast<Coordinate>(grid.value(cell.ix0, cell.iy1, cell.iz0)),
+      static_cast<Coordinate>(grid.value(cell.ix1, cell.iy0, cell.iz0)),
+      static_cast<Coordinate>(grid.value(cell.ix1, cell.iy1, cell.iz0)),
+      static_cast<Coordinate>(grid.value(cell.ix0, cell.iy0, cell.iz1)),
+      static_cast<Coordinate>(grid.value(cell.ix0, cell.iy1, cell.iz1)),
+      static_cast<Coordinate>(grid.value(cell.ix1, cell.iy0, cell.iz1)),
+      static_cast<Coordinate>(grid.value(cell.ix1, cell.iy1, cell.iz1)),
+      interpolator, z_interpolation_method);
+}
+
+/// Trivariate interpolation for a given point.
+///
+/// @tparam Grid Type of the grid, or of the accessor reading a chunked grid.
+/// @tparam Interpolator Type of the interpolator, either the abstract class or
+/// one of the built-in implementations, whose calls are inlined.
+template <template <class> class Point, typename Coordinate, typename AxisType,
+          typename Type, typename Grid, typename Interpolator>
+inline auto _trivariate(const Grid& grid, const Coordinate& x,
+                        const Coordinate& y, const AxisType& z,
+                        const Axis<double>& x_axis, const Axis<double>& y_axis,
+                        const Axis<AxisType>& z_axis,
+                        const Interpolator* interpolator,
+                        const detail::math::z_method_t<AxisType, Coordinate>&
+                            z_interpolation_method,
+                        const bool bounds_error) -> Coordinate {
+  auto cell = _trivariate_cell<Point, Coordinate, AxisType, Type>(
+      x, y, z, x_axis, y_axis, z_axis, bounds_error);
+  if (!cell) {
+    return std::numeric_limits<Coordinate>::quiet_NaN();
+  }
+  return _trivariate_value<Point, Coordinate, AxisType>(
+      grid, *cell, interpolator, z_interpolation_method);
+}
+
+/// Trivariate interpolation of the points of a layer, i.e. framed by the same
+/// cell of the z-axis, on a grid whose x and y axes are regular and sorted in
+/// ascending order.
+///
+/// The z-axis is searched once for the layer and the cells of the x and y
+/// axes are calculated in batches by the kernel of the bivariate
+/// interpolation on regular grids. The values of the two slabs of the layer
+/// are then interpolated, and blended along the z-axis. The points that are
+/// not framed by the grid are handled by _trivariate.
+///
+/// @param indexes Index of the points of the layer.
+/// @param size Number of points of the layer.
+template <template <class> class Point, typename Coordinate, typename AxisType,
+          typename Type, typename Grid, typename Interpolator, typename Input,
+          typename ZInput, typename Output>
+auto _trivariate_layer(const Grid& grid, const Input& x, const Input& y,
+                       const ZInput& z, Output& result, const size_t* indexes,
+                       const size_t size, const Axis<double>& x_axis,
+                       const Axis<double>& y_axis,
+                       const Axis<AxisType>& z_axis,
+                       const Interpolator& interpolator,
+                       const detail::math::z_method_t<AxisType, Coordinate>&
+                           z_interpolation_method,
+                       const bool bounds_error) -> void {
+  const auto& x_regular = *x_axis.regular_container();
+  const auto& y_regular = *y_axis.regular_container();
+  const auto z_indexes = z_axis.find_indexes(z(indexes[0]));
+
+  auto x_cells = std::array<int64_t, kBivariateBatchSize>();
+  auto y_cells = std::array<int64_t, kBivariateBatchSize>();
+
+  for (size_t first = 0; first < size; first += kBivariateBatchSize) {
+    const auto count = std::min(size - first, kBivariateBatchSize);
+    const auto* batch = indexes + first;
+
+    _regular_cells(
+        x_axis, y_axis, x, y, [batch](size_t jx) { return batch[jx]; }, count,
+        x_cells, y_cells);
+
+    for (size_t jx = 0; jx < count; ++jx) {
+      const auto ix = batch[jx];
+      const auto ix0 = x_cells[jx];
+      const auto iy0 = y_cells[jx];
+
+      if (!z_indexes || ix0 == -1 || iy0 == -1) {
+        result(ix) = _trivariate<Point, Coordinate, AxisType, Type>(
+            grid, x(ix), y(ix), z(ix), x_axis, y_axis, z_axis, &interpolator,
+            z_interpolation_method, bounds_error);
+        continue;
+      }
+
+      const auto [iz0, iz1] = *z_indexes;
+      const auto x0 = x_regular.coordinate_value(ix0);
+      result(ix) = _trivariate_value<Point, Coordinate, AxisType>(
+          grid,
+          TrivariateCell<Point, Coordinate>{
+              ix0, ix0 + 1, iy0, iy0 + 1, iz0, iz1,
+              Point<Coordinate>(x_axis.normalize_coordinate(x(ix), x0), y(ix),
+                                z(ix)),
+              Point<Coordinate>(x0, y_regular.coordinate_value(iy0),
+                                z_axis(iz0)),
+              Point<Coordinate>(x_regular.coordinate_value(ix0 + 1),
+                                y_regular.coordinate_value(iy0 + 1),
+                                z_axis(iz1))},
+          &interpolator, z_interpolation_method);
+    }
+  }
 }
 
 /// Interpolation of bivariate function.
@@ -75,59 +208,178 @@ inline auto _trivariate(const Grid3D<Type, AxisType>& grid, const Coordinate& x,
 /// @tparam Coordinate Coordinate data type
 /// @tparam AxisType Axis data type
 /// @tparam Type Grid data type
+/// @tparam Grid Grid type, either a Grid3D or a ChunkedGrid3D
+/// @tparam ZArray Type of the vector of the Z-values: the dates located on a
+/// time axis are converted to the resolution of the axis when they are read.
 template <template <class> class Point, typename Coordinate, typename AxisType,
-          typename Type>
-auto trivariate(const Grid3D<Type, AxisType>& grid,
-                const pybind11::array_t<Coordinate>& x,
-                const pybind11::array_t<Coordinate>& y,
-                const pybind11::array_t<AxisType>& z,
+          typename Type, typename Grid = Grid3D<Type, AxisType>,
+          typename ZArray = pybind11::array_t<AxisType>>
+auto trivariate(const Grid& grid, const pybind11::array& x,
+                const pybind11::array& y, const ZArray& z,
                 const Bivariate3D<Point, Coordinate>* interpolator,
                 const std::optional<std::string>& z_method,
-                const bool bounds_error, const size_t num_threads)
+                const bool bounds_error, const size_t num_threads,
+                const std::optional<pybind11::array>& out)
     -> pybind11::array_t<Coordinate> {
-  pyinterp::detail::check_array_ndim("x", 1, x, "y", 1, y, "z", 1, z);
-  pyinterp::detail::check_ndarray_shape("x", x, "y", y, "z", z);
   auto z_interpolation_method =
       pyinterp::detail::math::get_z_interpolation_method(
           interpolator, z_method.value_or("linear"));
   auto size = x.size();
-  auto result =
-      pybind11::array_t<Coordinate>(pybind11::array::ShapeContainer{size});
-  auto _x = x.template unchecked<1>();
-  auto _y = y.template unchecked<1>();
-  auto _z = z.template unchecked<1>();
+  auto result = detail::numpy::output_array<Coordinate>("out", out, {size});
+  auto _x = detail::numpy::ArrayReader<Coordinate>(x);
+  auto _y = detail::numpy::ArrayReader<Coordinate>(y);
+  // The reader of the z-coordinates expects a vector.
+  pyinterp::detail::check_array_ndim("z", 1, z);
+  auto _z = coordinates_reader(*grid.z(), "z", z);
   auto _result = result.template mutable_unchecked<1>();
+  const auto& handle = make_handle(grid);
 
   {
     pybind11::gil_scoped_release release;
 
-    // Captures the detected exceptions in the calculation function
-    // (only the last exception captured is kept)
-    auto except = std::exception_ptr(nullptr);
-
-    // Access to the shared pointer outside the loop to avoid data races
-    const auto& x_axis = *grid.x();
-    const auto& y_axis = *grid.y();
-    const auto& z_axis = *grid.z();
-
-    detail::dispatch(
-        [&](size_t start, size_t end) {
-          try {
-            for (size_t ix = start; ix < end; ++ix) {
-              _result(ix) = _trivariate(grid, _x(ix), _y(ix), _z(ix), x_axis,
-                                        y_axis, z_axis, interpolator,
-                                        z_interpolation_method, bounds_error);
-            }
-          } catch (...) {
-            except = std::current_exception();
+    // The dimensions and the shapes are read from the array structures.
+    pyinterp::detail::check_array_ndim("x", 1, x, "y", 1, y);
+    pyinterp::detail::check_ndarray_shape("x", x, "y", y, "z", z);
+
+    const auto& x_axis = *handle.x();
+    const auto& y_axis = *handle.y();
+    const auto& z_axis = *handle.z();
+
+    // The points interpolated on a chunked grid are grouped by chunk, the
+    // points interpolated on a regular grid by layer.
+    auto order = make_order(
+        handle, size,
+        [&](size_t ix) -> std::optional<std::array<int64_t, 3>> {
+          auto x_indexes = x_axis.find_indexes(_x(ix));
+          auto y_indexes = y_axis.find_indexes(_y(ix));
+          auto z_indexes = z_axis.find_indexes(_z(ix));
+          if (x_indexes && y_indexes && z_indexes) {
+            return std::array<int64_t, 3>{
+                x_indexes->first, y_indexes->first, z_indexes->first};
           }
+          return std::nullopt;
         },
-        size, num_threads);
+        [&](size_t ix) -> std::optional<int64_t> {
+          auto z_indexes = z_axis.find_indexes(_z(ix));
+          if (z_indexes) {
+            return z_indexes->first;
+          }
+          return std::nullopt;
+        },
+        num_threads);
+
+    // On a regular grid whose x and y axes are regular, the points of each
+    // layer are interpolated by a specialized kernel.
+    const auto regular = x_axis.regular_container() != nullptr &&
+                         y_axis.regular_container() != nullptr &&
+                         x_axis.is_ascending() && y_axis.is_ascending();
+
+    detail::math::visit(interpolator, [&](const auto* concrete) {
+      detail::dispatch(
+          [&](size_t start, size_t end) {
+            auto&& values = make_accessor(handle);
+            auto point = [&](size_t ix) {
+              _result(ix) = _trivariate<Point, Coordinate, AxisType, Type>(
+                  values, _x(ix), _y(ix), _z(ix), x_axis, y_axis, z_axis,
+                  concrete, z_interpolation_method, bounds_error);
+            };
+            if (!regular) {
+              order.for_each(start, end, point);
+              return;
+            }
+            for_each_layer(
+                order, start, end,
+                [&](const size_t* indexes, size_t count) {
+                  _trivariate_layer<Point, Coordinate, AxisType, Type>(
+                      values, _x, _y, _z, _result, indexes, count, x_axis,
+                      y_axis, z_axis, *concrete, z_interpolation_method,
+                      bounds_error);
+                },
+                point);
+          },
+          size, num_threads);
+    });
+  }
+  return result;
+}
 
-    if (except != nullptr) {
-      std::rethrow_exception(except);
+/// Interpolation of several grids defined on the same axes.
+///
+/// The cell framing each point is searched once, then the values of all the
+/// grids are interpolated in this cell.
+///
+/// @tparam Point A type of point defining a point in space.
+/// @tparam Coordinate Coordinate data type
+/// @tparam AxisType Axis data type
+/// @tparam Type Grid data type
+/// @tparam Grid Grid type, either a Grid3D or a PackedGrid3D
+/// @tparam ZArray Type of the vector of the Z-values.
+template <template <class> class Point, typename Coordinate, typename AxisType,
+          typename Type, typename Grid = Grid3D<Type, AxisType>,
+          typename ZArray = pybind11::array_t<AxisType>>
+auto trivariate_fields(const std::vector<const Grid*>& grids,
+                       const pybind11::array& x, const pybind11::array& y,
+                       const ZArray& z,
+                       const Bivariate3D<Point, Coordinate>* interpolator,
+                       const std::optional<std::string>& z_method,
+                       const bool bounds_error, const size_t num_threads,
+                       const std::optional<pybind11::array>& out)
+    -> pybind11::array_t<Coordinate> {
+  if (grids.empty()) {
+    throw std::invalid_argument("grids must not be empty");
+  }
+  const auto& first = *grids.front();
+  for (const auto* item : grids) {
+    if (*item->x() != *first.x() || *item->y() != *first.y() ||
+        *item->z() != *first.z()) {
+      throw std::invalid_argument("grids must be defined on the same axes");
     }
   }
+  auto z_interpolation_method =
+      pyinterp::detail::math::get_z_interpolation_method(
+          interpolator, z_method.value_or("linear"));
+  auto size = x.size();
+  auto result = detail::numpy::output_array<Coordinate>(
+      "out", out,
+      {static_cast<pybind11::ssize_t>(grids.size()),
+       static_cast<pybind11::ssize_t>(size)});
+  auto _x = detail::numpy::ArrayReader<Coordinate>(x);
+  auto _y = detail::numpy::ArrayReader<Coordinate>(y);
+  // The reader of the z-coordinates expects a vector.
+  pyinterp::detail::check_array_ndim("z", 1, z);
+  auto _z = coordinates_reader(*first.z(), "z", z);
+  auto _result = result.template mutable_unchecked<2>();
+
+  {
+    pybind11::gil_scoped_release release;
+
+    // The dimensions and the shapes are read from the array structures.
+    pyinterp::detail::check_array_ndim("x", 1, x, "y", 1, y);
+    pyinterp::detail::check_ndarray_shape("x", x, "y", y, "z", z);
+
+    const auto& x_axis = *first.x();
+    const auto& y_axis = *first.y();
+    const auto& z_axis = *first.z();
+
+    detail::math::visit(interpolator, [&](const auto* concrete) {
+      detail::dispatch(
+          [&](size_t start, size_t end) {
+            for (auto ix = start; ix < end; ++ix) {
+              auto cell = _trivariate_cell<Point, Coordinate, AxisType, Type>(
+                  _x(ix), _y(ix), _z(ix), x_axis, y_axis, z_axis,
+                  bounds_error);
+              for (size_t jx = 0; jx < grids.size(); ++jx) {
+                _result(jx, ix) =
+                    cell ? _trivariate_value<Point, Coordinate, AxisType>(
+                               *grids[jx], *cell, concrete,
+                               z_interpolation_method)
+                         : std::numeric_limits<Coordinate>::quiet_NaN();
+              }
+            }
+          },
+          size, num_threads);
+    });
+  }
   return result;
 }
 
@@ -137,18 +389,21 @@ auto trivariate(const Grid3D<Type, AxisType>& grid,
 /// @tparam Coordinate Coordinate data type
 /// @tparam AxisType Axis data type
 /// @tparam Type Grid data type
+/// @tparam Grid Grid type, either a Grid3D or a PackedGrid3D
 template <template <class> class Point, typename Coordinate, typename AxisType,
-          typename Type>
+          typename Type, typename Grid = Grid3D<Type, AxisType>>
 void implement_trivariate(pybind11::module& m, const std::string& prefix,
                           const std::string& suffix) {
   auto function_suffix = suffix;
   function_suffix[0] = static_cast<char>(std::tolower(function_suffix[0]));
   m.def(("trivariate_" + function_suffix).c_str(),
-        &trivariate<Point, Coordinate, AxisType, Type>, pybind11::arg("grid"),
-        pybind11::arg("x"), pybind11::arg("y"), pybind11::arg("z"),
-        pybind11::arg("interpolator"),
+        &trivariate<Point, Coordinate, AxisType, Type, Grid,
+                    AxisCoordinates<AxisType>>,
+        pybind11::arg("grid"), pybind11::arg("x"), pybind11::arg("y"),
+        pybind11::arg("z"), pybind11::arg("interpolator"),
         pybind11::arg("z_method") = pybind11::none(),
         pybind11::arg("bounds_error") = false, pybind11::arg("num_threads") = 0,
+        pybind11::arg("out") = pybind11::none(),
         (R"__doc__(
 Interpolate the values provided on the defined trivariate function.
 
@@ -172,10 +427,78 @@ Args:
         computation. If 0 all CPUs are used. If 1 is given, no parallel
         computing code is used at all, which is useful for debugging.
         Defaults to ``0``.
+    out (numpy.ndarray, optional): C-contiguous array of shape ``(n, )`` and
+        of type float64 in which the interpolated values are written. If
+        None, a new array is allocated. Defaults to ``None``.
 Returns:
-    numpy.ndarray: Values interpolated.
+    numpy.ndarray: Values interpolated, i.e. ``out`` if provided.
 )__doc__")
             .c_str());
+  m.def(("trivariate_" + function_suffix).c_str(),
+        &trivariate_fields<Point, Coordinate, AxisType, Type, Grid,
+                           AxisCoordinates<AxisType>>,
+        pybind11::arg("grids"), pybind11::arg("x"), pybind11::arg("y"),
+        pybind11::arg("z"), pybind11::arg("interpolator"),
+        pybind11::arg("z_method") = pybind11::none(),
+        pybind11::arg("bounds_error") = false, pybind11::arg("num_threads") = 0,
+        pybind11::arg("out") = pybind11::none(),
+        (R"__doc__(
+Interpolate the values of several grids defined on the same axes. The cells
+framing the points are searched once for all the grids.
+
+Args:
+    grids (list): Grids of type pyinterp.core.)__doc__" +
+         prefix + "Grid3D" + suffix +
+         R"__doc__( containing the values to be
+        interpolated.
+    x (numpy.ndarray): X-values.
+    y (numpy.ndarray): Y-values.
+    z (numpy.ndarray): Z-values.
+    interpolator (pyinterp.core.)__doc__" +
+         prefix + R"__doc__(BivariateInterpolator3D): 3D interpolator
+        used to interpolate values on the surface (x, y, z).
+    z_method (str, optional): The method of interpolation to perform on
+      Z-axis. Supported are ``linear`` and ``nearest``. Default to
+      ``linear``.
+    bounds_error (bool, optional): If True, when interpolated values are
+      requested outside of the domain of the input axes (x,y,z), a ValueError
+      is raised. If False, then value is set to NaN.
+    num_threads (int, optional): The number of threads to use for the
+        computation. If 0 all CPUs are used. If 1 is given, no parallel
+        computing code is used at all, which is useful for debugging.
+        Defaults to ``0``.
+    out (numpy.ndarray, optional): C-contiguous array of shape
+        ``(len(grids), n)`` and of type float64 in which the interpolated
+        values are written. If None, a new array is allocated. Defaults to
+        ``None``.
+Returns:
+    numpy.ndarray: Values interpolated, one row per grid, i.e. ``out`` if
+    provided.
+)__doc__")
+            .c_str());
+  // The grids read by chunks hold unpacked values only.
+  if constexpr (std::is_same_v<Grid, Grid3D<Type, AxisType>>) {
+    m.def(("trivariate_" + function_suffix).c_str(),
+          &trivariate<Point, Coordinate, AxisType, Type,
+                      ChunkedGrid3D<Type, AxisType>,
+                      AxisCoordinates<AxisType>>,
+          pybind11::arg("grid"), pybind11::arg("x"), pybind11::arg("y"),
+          pybind11::arg("z"), pybind11::arg("interpolator"),
+          pybind11::arg("z_method") = pybind11::none(),
+          pybind11::arg("bounds_error") = false,
+          pybind11::arg("num_threads") = 0,
+          pybind11::arg("out") = pybind11::none(),
+          (R"__doc__(
+Interpolate the values provided on the defined trivariate function, whose
+values are read by chunks. Only the chunks framing the points are read.
+
+Args:
+    grid (pyinterp.core.)__doc__" +
+           prefix + "ChunkedGrid3D" + suffix +
+           R"__doc__(): Grid containing the values to be interpolated.
+)__doc__")
+              .c_str());
+  }
 }
 
 }  // namespace pyinterp
@@ -0,0 +1,120 @@
+// Copyright (c) 2022 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+#include "pyinterp/geodetic/multipolygon.hpp"
+
+#include <pybind11/pybind11.h>
+
+#include <algorithm>
+#include <boost/geometry/index/rtree.hpp>
+#include <boost/iterator/function_output_iterator.hpp>
+
+#include "pyinterp/detail/broadcast.hpp"
+#include "pyinterp/detail/math.hpp"
+#include "pyinterp/detail/thread.hpp"
+#include "pyinterp/geodetic/box.hpp"
+#include "pyinterp/geodetic/prepared_polygon.hpp"
+
+namespace pyinterp::geodetic {
+
+// The envelopes of the polygons are indexed in a Cartesian space where the
+// longitudes of the boxes start in [-180, 180[ and may extend up to 540: a
+// point is covered by a box if its normalized longitude, or this longitude
+// plus 360, is covered.
+using CartesianPoint =
+    boost::geometry::model::point<double, 2, boost::geometry::cs::cartesian>;
+using CartesianBox = boost::geometry::model::box<CartesianPoint>;
+using EnvelopeIndex =
+    boost::geometry::index::rtree<std::pair<CartesianBox, size_t>,
+                                  boost::geometry::index::rstar<16>>;
+
+MultiPolygon::MultiPolygon(const pybind11::list& polygons) {
+  try {
+    for (const auto item : polygons) {
+      push_back(item.cast<Polygon>());
+    }
+  } catch (const pybind11::cast_error&) {
+    throw std::invalid_argument(
+        "polygons must be a list of pyinterp.geodetic.Polygon");
+  }
+}
+
+/// Calculates the envelope of the polygons.
+auto MultiPolygon::envelope() const -> Box {
+  auto box = Box();
+  boost::geometry::envelope(*this, box);
+  return box;
+}
+
+// ---------------------------------------------------------------------------
+auto MultiPolygon::which_polygon(const Eigen::Ref<const Eigen::VectorXd>& lon,
+                                 const Eigen::Ref<const Eigen::VectorXd>& lat,
+                                 const size_t num_threads) const
+    -> pybind11::array_t<int64_t> {
+  detail::check_eigen_shape("lon", lon, "lat", lat);
+  auto size = lon.size();
+  auto result =
+      pybind11::array_t<int64_t>(pybind11::array::ShapeContainer{{size}});
+  auto _result = result.template mutable_unchecked<1>();
+
+  {
+    pybind11::gil_scoped_release release;
+
+    auto prepared = std::vector<PreparedPolygon>();
+    auto envelopes = std::vector<std::pair<CartesianBox, size_t>>();
+    prepared.reserve(this->size());
+    envelopes.reserve(this->size());
+    for (size_t ix = 0; ix < this->size(); ++ix) {
+      const auto& polygon = (*this)[ix];
+      prepared.emplace_back(polygon);
+      if (boost::geometry::is_empty(polygon)) {
+        continue;
+      }
+      auto box = Box();
+      boost::geometry::envelope(polygon, box);
+      const auto width = std::min(
+          box.max_corner().lon() - box.min_corner().lon(), 360.0);
+      const auto x0 =
+          detail::math::normalize_angle(box.min_corner().lon(), -180.0, 360.0);
+      envelopes.emplace_back(
+          CartesianBox({x0, box.min_corner().lat()},
+                       {x0 + width, box.max_corner().lat()}),
+          ix);
+    }
+    auto index = EnvelopeIndex(envelopes);
+
+    detail::dispatch(
+        [&](size_t start, size_t end) {
+          auto candidates = std::vector<size_t>();
+          for (auto ix = static_cast<int64_t>(start);
+               ix < static_cast<int64_t>(end); ++ix) {
+            const auto x =
+                detail::math::normalize_angle(lon(ix), -180.0, 360.0);
+            candidates.clear();
+            for (const auto& item : {CartesianPoint(x, lat(ix)),
+                                     CartesianPoint(x + 360.0, lat(ix))}) {
+              index.query(boost::geometry::index::intersects(item),
+                          boost::make_function_output_iterator(
+                              [&](const auto& value) {
+                                candidates.push_back(value.second);
+                              }));
+            }
+            // The first polygon of the collection covering the point wins.
+            std::sort(candidates.begin(), candidates.end());
+            _result(ix) = -1;
+            const auto point = Point(lon(ix), lat(ix));
+            for (auto jx : candidates) {
+              if (prepared[jx].covered_by(point)) {
+                _result(ix) = static_cast<int64_t>(jx);
+                break;
+              }
+            }
+          }
+        },
+        size, num_threads, detail::kGuided);
+  }
+  return result;
+}
+
+}  // namespace pyinterp::geodetic
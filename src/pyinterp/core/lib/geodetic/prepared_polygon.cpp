@@ -0,0 +1,188 @@
+// Copyright (c) 2022 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+#include "pyinterp/geodetic/prepared_polygon.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+
+#include "pyinterp/detail/broadcast.hpp"
+#include "pyinterp/detail/math.hpp"
+#include "pyinterp/detail/thread.hpp"
+
+namespace pyinterp::geodetic {
+
+// Strategy used by boost::geometry::covered_by for a point and a polygon.
+using Strategy =
+    boost::geometry::strategy::covered_by::services::default_strategy<
+        Point, Polygon>::type;
+
+// Minimum number of points of a closed ring. Boost considers the points as
+// outside of the smaller rings.
+static constexpr size_t kMinimumRingSize = 4;
+
+// Margin, in degrees, added to the longitude range of the edges so that the
+// edges whose ends are at the longitude of a point, within the tolerance of
+// the comparisons made by the winding strategy, are visited.
+static constexpr double kMargin = 1e-6;
+
+// ---------------------------------------------------------------------------
+PreparedPolygon::PreparedPolygon(Polygon polygon)
+    : polygon_(std::move(polygon)) {
+  const auto& base = static_cast<const Polygon::Base&>(polygon_);
+  const auto num_rings = base.inners().size() + 1;
+
+  rings_.reserve(num_rings + 1);
+  rings_.push_back(0);
+  for (size_t r = 0; r < num_rings; ++r) {
+    const auto size = ring(r).size();
+    const auto edges = size < kMinimumRingSize ? 0 : size - 1;
+    rings_.push_back(rings_.back() + static_cast<uint32_t>(edges));
+  }
+  const auto num_edges = rings_.back();
+
+  // The slabs hold a few edges on average.
+  const auto num_slabs =
+      std::clamp<size_t>(num_edges / 4, 1, static_cast<size_t>(1) << 16);
+  const auto width = 360.0 / static_cast<double>(num_slabs);
+
+  // Range of slabs covered by each edge, then the edges of each slab, stored
+  // in the CSR layout.
+  auto ranges = std::vector<std::pair<int64_t, int64_t>>(num_edges);
+  auto counts = std::vector<uint32_t>(num_slabs + 1, 0);
+  for (size_t r = 0; r < num_rings; ++r) {
+    const auto& points = ring(r);
+    for (auto ix = rings_[r]; ix < rings_[r + 1]; ++ix) {
+      const auto& p1 = points[ix - rings_[r]];
+      const auto& p2 = points[ix - rings_[r] + 1];
+      const auto lon1 = detail::math::normalize_angle(p1.lon(), -180.0, 360.0);
+      const auto delta =
+          detail::math::normalize_angle(p2.lon() - p1.lon(), -180.0, 360.0);
+      if (std::abs(p1.lat()) >= 90 - kMargin ||
+          std::abs(p2.lat()) >= 90 - kMargin ||
+          std::abs(delta) >= 180 - kMargin) {
+        always_.push_back(ix);
+        ranges[ix] = {0, -1};
+        continue;
+      }
+      const auto first = static_cast<int64_t>(
+          std::floor((std::min(lon1, lon1 + delta) - kMargin + 180) / width));
+      const auto last = std::min(
+          static_cast<int64_t>(std::floor(
+              (std::max(lon1, lon1 + delta) + kMargin + 180) / width)),
+          first + static_cast<int64_t>(num_slabs) - 1);
+      ranges[ix] = {first, last};
+      for (auto jx = first; jx <= last; ++jx) {
+        ++counts[detail::math::remainder(jx, static_cast<int64_t>(num_slabs))];
+      }
+    }
+  }
+
+  offsets_.resize(num_slabs + 1);
+  offsets_[0] = 0;
+  for (size_t ix = 0; ix < num_slabs; ++ix) {
+    offsets_[ix + 1] = offsets_[ix] + counts[ix];
+  }
+  items_.resize(offsets_.back());
+  std::copy(offsets_.begin(), offsets_.end() - 1, counts.begin());
+  for (uint32_t ix = 0; ix < num_edges; ++ix) {
+    for (auto jx = ranges[ix].first; jx <= ranges[ix].second; ++jx) {
+      auto slab =
+          detail::math::remainder(jx, static_cast<int64_t>(num_slabs));
+      items_[counts[slab]++] = ix;
+    }
+  }
+}
+
+// ---------------------------------------------------------------------------
+auto PreparedPolygon::slab(const double lon) const -> size_t {
+  const auto num_slabs = this->slabs();
+  const auto ix = static_cast<size_t>(
+      (detail::math::normalize_angle(lon, -180.0, 360.0) + 180) *
+      (static_cast<double>(num_slabs) / 360.0));
+  return std::min(ix, num_slabs - 1);
+}
+
+// ---------------------------------------------------------------------------
+auto PreparedPolygon::relate(const Point& point,
+                             std::vector<uint32_t>& candidates) const -> int {
+  // Edges whose longitude range may contain the longitude of the point or
+  // its antipodal longitude, sorted by index.
+  const auto s1 = slab(point.lon());
+  const auto s2 = slab(point.lon() + 180);
+  candidates.clear();
+  std::set_union(items_.begin() + offsets_[s1],
+                 items_.begin() + offsets_[s1 + 1],
+                 items_.begin() + offsets_[s2],
+                 items_.begin() + offsets_[s2 + 1],
+                 std::back_inserter(candidates));
+  if (!always_.empty()) {
+    const auto size = candidates.size();
+    candidates.insert(candidates.end(), always_.begin(), always_.end());
+    std::inplace_merge(candidates.begin(), candidates.begin() + size,
+                       candidates.end());
+  }
+
+  const auto strategy = Strategy();
+  auto it = candidates.begin();
+
+  // Relation between the point and the ring r, computed from the candidate
+  // edges of the ring: the other edges do not change the state of the
+  // winding strategy.
+  auto relate_ring = [&](const size_t r) -> int {
+    auto state = Strategy::state_type();
+    const auto& points = ring(r);
+    it = std::lower_bound(it, candidates.end(), rings_[r]);
+    for (; it != candidates.end() && *it < rings_[r + 1]; ++it) {
+      const auto jx = *it - rings_[r];
+      if (!strategy.apply(point, points[jx], points[jx + 1], state)) {
+        break;
+      }
+    }
+    return points.size() < kMinimumRingSize ? -1 : Strategy::result(state);
+  };
+
+  // Same logic as boost::geometry::detail::within::point_in_geometry.
+  const auto code = relate_ring(0);
+  if (code == 1) {
+    for (size_t r = 1; r < rings_.size() - 1; ++r) {
+      const auto inner = relate_ring(r);
+      if (inner != -1) {
+        return -inner;
+      }
+    }
+  }
+  return code;
+}
+
+// ---------------------------------------------------------------------------
+auto PreparedPolygon::covered_by(const Eigen::Ref<const Eigen::VectorXd>& lon,
+                                 const Eigen::Ref<const Eigen::VectorXd>& lat,
+                                 const size_t num_threads) const
+    -> pybind11::array_t<int8_t> {
+  detail::check_eigen_shape("lon", lon, "lat", lat);
+  auto size = lon.size();
+  auto result =
+      pybind11::array_t<int8_t>(pybind11::array::ShapeContainer{{size}});
+  auto _result = result.template mutable_unchecked<1>();
+
+  {
+    pybind11::gil_scoped_release release;
+
+    detail::dispatch(
+        [&](size_t start, size_t end) {
+          auto candidates = std::vector<uint32_t>();
+          for (auto ix = static_cast<int64_t>(start);
+               ix < static_cast<int64_t>(end); ++ix) {
+            _result(ix) = static_cast<int8_t>(
+                relate(Point(lon(ix), lat(ix)), candidates) >= 0);
+          }
+        },
+        size, num_threads);
+  }
+  return result;
+}
+
+}  // namespace pyinterp::geodetic
@@ -14,4 +14,20 @@ const std::array<char, 32> Base32::encode_ =
     std::array<char, 32>{{'0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'b',
                           'c', 'd', 'e', 'f', 'g', 'h', 'j', 'k', 'm', 'n', 'p',
                           'q', 'r', 's', 't', 'u', 'v', 'w', 'x', 'y', 'z'}};
+
+// Builds the table encoding 10 bits into two characters. The table is built
+// at compile time, so it is usable during the static initialization of the
+// other translation units.
+static constexpr auto make_pairs() -> std::array<std::array<char, 2>, 1024> {
+  constexpr char alphabet[] = "0123456789bcdefghjkmnpqrstuvwxyz";
+  auto result = std::array<std::array<char, 2>, 1024>{};
+  for (size_t ix = 0; ix < result.size(); ++ix) {
+    result[ix][0] = alphabet[ix >> 5U];
+    result[ix][1] = alphabet[ix & 0x1fU];
+  }
+  return result;
+}
+
+// Encoding of all pairs of characters
+const std::array<std::array<char, 2>, 1024> Base32::pairs_ = make_pairs();
 }  // namespace pyinterp::geohash
\ No newline at end of file
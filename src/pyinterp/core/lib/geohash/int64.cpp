@@ -4,8 +4,15 @@
 // BSD-style license that can be found in the LICENSE file.
 #include "pyinterp/geohash/int64.hpp"
 
+#include <algorithm>
 #include <array>
 #include <iostream>
+#include <limits>
+#include <mutex>
+#include <numeric>
+#include <vector>
+
+#include "pyinterp/detail/thread.hpp"
 
 // Ref: https://mmcloughlin.com/posts/geohash-assembly
 namespace pyinterp::geohash::int64 {
@@ -266,31 +273,85 @@ auto neighbors(const uint64_t hash, const uint32_t precision)
   auto box = bounding_box(hash, precision);
   auto center = box.centroid();
   auto [lon_delta, lat_delta] = box.delta(false);
+  // The neighbors of the cells located along the antimeridian are on the
+  // other side of it.
+  auto east = pyinterp::detail::math::normalize_angle(center.lon() + lon_delta,
+                                                      -180.0, 360.0);
+  auto west = pyinterp::detail::math::normalize_angle(center.lon() - lon_delta,
+                                                      -180.0, 360.0);
 
   return (Eigen::Matrix<uint64_t, 8, 1>() <<
               // N
               encode({center.lon(), center.lat() + lat_delta}, precision),
           // NE,
-          encode({center.lon() + lon_delta, center.lat() + lat_delta},
-                 precision),
+          encode({east, center.lat() + lat_delta}, precision),
           // E,
-          encode({center.lon() + lon_delta, center.lat()}, precision),
+          encode({east, center.lat()}, precision),
           // SE,
-          encode({center.lon() + lon_delta, center.lat() - lat_delta},
-                 precision),
+          encode({east, center.lat() - lat_delta}, precision),
           // S,
           encode({center.lon(), center.lat() - lat_delta}, precision),
           // SW,
-          encode({center.lon() - lon_delta, center.lat() - lat_delta},
-                 precision),
+          encode({west, center.lat() - lat_delta}, precision),
           // W,
-          encode({center.lon() - lon_delta, center.lat()}, precision),
+          encode({west, center.lat()}, precision),
           // NW
-          encode({center.lon() - lon_delta, center.lat() + lat_delta},
-                 precision))
+          encode({west, center.lat() + lat_delta}, precision))
       .finished();
 }
 
+// ---------------------------------------------------------------------------
+auto neighbors(const Eigen::Ref<const Vector<uint64_t>>& hash,
+               const uint32_t precision, const uint32_t rings,
+               const size_t num_threads)
+    -> Eigen::Matrix<uint64_t, Eigen::Dynamic, Eigen::Dynamic,
+                     Eigen::RowMajor> {
+  const auto lat_bits = precision >> 1U;
+  const auto lng_bits = precision - lat_bits;
+  const auto nlat = static_cast<int64_t>(uint64_t(1) << lat_bits);
+  const auto nlon = static_cast<int64_t>(uint64_t(1) << lng_bits);
+  const auto width = 2 * static_cast<int64_t>(rings) + 1;
+  auto result =
+      Eigen::Matrix<uint64_t, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>(
+          hash.size(), width * width);
+
+  // The indexes of the cell in latitude and longitude are the even and odd
+  // bits of the code: the neighbors are obtained by shifting these indexes
+  // and interleaving them again, without going through the coordinates.
+  pyinterp::detail::dispatch(
+      [&](size_t start, size_t end) {
+        for (auto ix = static_cast<Eigen::Index>(start);
+             ix < static_cast<Eigen::Index>(end); ++ix) {
+          auto [lat, lon] = deinterleaver(hash(ix) << (64U - precision));
+          const auto row = static_cast<int64_t>(static_cast<uint64_t>(lat) >>
+                                                (32U - lat_bits));
+          const auto column = static_cast<int64_t>(
+              static_cast<uint64_t>(lon) >> (32U - lng_bits));
+          auto* first = result.row(ix).data();
+          auto* last = first;
+          for (auto jx = std::max<int64_t>(row - rings, 0);
+               jx <= std::min<int64_t>(row + rings, nlat - 1); ++jx) {
+            for (auto kx = column - rings; kx <= column + rings; ++kx) {
+              // The longitudes wrap around the globe.
+              const auto item = ((kx % nlon) + nlon) % nlon;
+              *last++ = detail::interleave(
+                            static_cast<uint32_t>(static_cast<uint64_t>(jx)
+                                                  << (32U - lat_bits)),
+                            static_cast<uint32_t>(static_cast<uint64_t>(item)
+                                                  << (32U - lng_bits))) >>
+                        (64U - precision);
+            }
+          }
+          std::sort(first, last);
+          last = std::unique(first, last);
+          std::fill(last, first + result.cols(),
+                    std::numeric_limits<uint64_t>::max());
+        }
+      },
+      static_cast<size_t>(hash.size()), num_threads);
+  return result;
+}
+
 // ---------------------------------------------------------------------------
 auto grid_properties(const geodetic::Box& box, const uint32_t precision)
     -> std::tuple<uint64_t, size_t, size_t> {
@@ -311,6 +372,60 @@ auto grid_properties(const geodetic::Box& box, const uint32_t precision)
   return std::make_tuple(hash_sw, lon_step + lon_offset, lat_step + lat_offset);
 }
 
+// ---------------------------------------------------------------------------
+auto area(const Eigen::Ref<const Vector<uint64_t>>& hash,
+          const uint32_t precision, const std::optional<geodetic::System>& wgs,
+          const size_t num_threads) -> Eigen::VectorXd {
+  // Above this number of rows, the table of the areas of the rows would be
+  // too large to be worth computing.
+  constexpr auto kMaxCachedRows = int64_t(1) << 20U;
+
+  const auto lat_bits = precision >> 1U;
+  const auto [lon_span, lat_span] = error_with_precision(precision);
+  const auto nlat = static_cast<int64_t>(uint64_t(1) << lat_bits);
+  const auto rectangle = pyinterp::detail::geodetic::RectangleArea(
+      wgs.value_or(geodetic::System()));
+  auto result = Eigen::VectorXd(hash.size());
+
+  // Returns the row of latitudes of a cell.
+  auto row = [&](const uint64_t code) -> int64_t {
+    auto lat = std::get<0>(deinterleaver(code << (64U - precision)));
+    return static_cast<int64_t>(static_cast<uint64_t>(lat) >>
+                                (32U - lat_bits));
+  };
+
+  if (nlat <= std::min<int64_t>(hash.size(), kMaxCachedRows)) {
+    auto areas = std::vector<double>(nlat);
+    auto south = rectangle.primitive(-90);
+    for (int64_t ix = 0; ix < nlat; ++ix) {
+      auto north = rectangle.primitive(
+          ix == nlat - 1 ? 90 : -90 + static_cast<double>(ix + 1) * lat_span);
+      areas[ix] = pyinterp::detail::math::radians(lon_span) * (north - south);
+      south = north;
+    }
+    pyinterp::detail::dispatch(
+        [&](size_t start, size_t end) {
+          for (auto ix = static_cast<Eigen::Index>(start);
+               ix < static_cast<Eigen::Index>(end); ++ix) {
+            result(ix) = areas[row(hash(ix))];
+          }
+        },
+        static_cast<size_t>(hash.size()), num_threads);
+    return result;
+  }
+
+  pyinterp::detail::dispatch(
+      [&](size_t start, size_t end) {
+        for (auto ix = static_cast<Eigen::Index>(start);
+             ix < static_cast<Eigen::Index>(end); ++ix) {
+          auto lat = -90 + static_cast<double>(row(hash(ix))) * lat_span;
+          result(ix) = rectangle(lat, lat + lat_span, lon_span);
+        }
+      },
+      static_cast<size_t>(hash.size()), num_threads);
+  return result;
+}
+
 // ---------------------------------------------------------------------------
 auto bounding_boxes(const geodetic::Box& box, const uint32_t precision)
     -> Vector<uint64_t> {
@@ -344,4 +459,109 @@ auto bounding_boxes(const geodetic::Box& box, const uint32_t precision)
   return result;
 }
 
+// ---------------------------------------------------------------------------
+auto bounding_boxes(const geodetic::Polygon& polygon, const uint32_t precision,
+                    const size_t num_threads) -> Vector<uint64_t> {
+  // Number of bits of the cells tested first, and number of bits added at
+  // each refinement.
+  constexpr uint32_t start_bits = 10;
+  constexpr uint32_t step_bits = 2;
+
+  // Rings of the polygon: a cell crossed by none of them lies entirely inside
+  // or outside the polygon, depending on the position of its center.
+  using Linestring = boost::geometry::model::linestring<geodetic::Point>;
+  auto rings = std::vector<Linestring>();
+  const auto& outer = boost::geometry::exterior_ring(polygon);
+  rings.emplace_back(outer.begin(), outer.end());
+  for (const auto& item : boost::geometry::interior_rings(polygon)) {
+    rings.emplace_back(item.begin(), item.end());
+  }
+
+  // Ranges of codes, at the requested precision, covering the cells
+  // selected: the first code and the number of codes.
+  auto ranges = std::vector<std::pair<uint64_t, uint64_t>>();
+  auto mutex = std::mutex();
+
+  {
+    auto gil = pybind11::gil_scoped_release();
+
+    // The cells inside the polygon are kept at once, with all the cells they
+    // contain, and the cells outside are discarded. The cells crossed or
+    // touched by the rings are refined until the requested precision is
+    // reached, where they are kept if they intersect the polygon.
+    auto bits = std::min(precision, start_bits);
+    auto cells = std::vector<uint64_t>(size_t(1) << bits);
+    std::iota(cells.begin(), cells.end(), uint64_t(0));
+
+    while (!cells.empty()) {
+      const auto shift = precision - bits;
+      const auto step = std::min(step_bits, shift);
+      auto refined = std::vector<uint64_t>();
+
+      pyinterp::detail::dispatch(
+          [&](size_t start, size_t end) {
+            auto local_ranges = std::vector<std::pair<uint64_t, uint64_t>>();
+            auto local_refined = std::vector<uint64_t>();
+
+            for (auto ix = start; ix < end; ++ix) {
+              const auto code = cells[ix];
+              const auto box = bounding_box(code, bits);
+              if (shift == 0) {
+                if (boost::geometry::intersects(box, polygon)) {
+                  local_ranges.emplace_back(code, 1);
+                }
+              } else if (!std::any_of(rings.begin(), rings.end(),
+                                      [&box](const auto& ring) {
+                                        return boost::geometry::intersects(
+                                            box, ring);
+                                      }) &&
+                         boost::geometry::covered_by(box.centroid(),
+                                                     polygon)) {
+                local_ranges.emplace_back(code << shift, uint64_t(1) << shift);
+              } else if (boost::geometry::intersects(box, polygon)) {
+                // The cell is crossed by the rings, or touches them.
+                for (uint64_t jx = 0; jx < (uint64_t(1) << step); ++jx) {
+                  local_refined.push_back((code << step) | jx);
+                }
+              }
+            }
+
+            auto lock = std::lock_guard<std::mutex>(mutex);
+            ranges.insert(ranges.end(), local_ranges.begin(),
+                          local_ranges.end());
+            refined.insert(refined.end(), local_refined.begin(),
+                           local_refined.end());
+          },
+          cells.size(), num_threads, pyinterp::detail::kDynamic);
+
+      cells = std::move(refined);
+      bits += step;
+    }
+    std::sort(ranges.begin(), ranges.end());
+  }
+
+  // Offset of each range in the result.
+  auto offsets = std::vector<uint64_t>(ranges.size() + 1, 0);
+  for (size_t ix = 0; ix < ranges.size(); ++ix) {
+    offsets[ix + 1] = offsets[ix] + ranges[ix].second;
+  }
+  auto result = allocate_array(offsets.back());
+
+  {
+    auto gil = pybind11::gil_scoped_release();
+
+    pyinterp::detail::dispatch(
+        [&](size_t start, size_t end) {
+          for (auto ix = start; ix < end; ++ix) {
+            auto code = ranges[ix].first;
+            for (auto jx = offsets[ix]; jx < offsets[ix + 1]; ++jx) {
+              result(static_cast<Eigen::Index>(jx)) = code++;
+            }
+          }
+        },
+        ranges.size(), num_threads);
+  }
+  return result;
+}
+
 }  // namespace pyinterp::geohash::int64
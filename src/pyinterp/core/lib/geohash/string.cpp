@@ -4,6 +4,8 @@
 // BSD-style license that can be found in the LICENSE file.
 #include "pyinterp/geohash/string.hpp"
 
+#include <cstring>
+
 #include "pyinterp/detail/broadcast.hpp"
 #include "pyinterp/detail/thread.hpp"
 #include "pyinterp/eigen.hpp"
@@ -79,7 +81,8 @@ auto encode(const geodetic::Point& point, char* const buffer,
 // ---------------------------------------------------------------------------
 auto encode(const Eigen::Ref<const Eigen::VectorXd>& lon,
             const Eigen::Ref<const Eigen::VectorXd>& lat,
-            const uint32_t precision) -> pybind11::array {
+            const uint32_t precision, const size_t num_threads)
+    -> pybind11::array {
   detail::check_eigen_shape("lon", lon, "lat", lat);
   auto size = lon.size();
   auto array = allocate_array(size, precision);
@@ -88,10 +91,14 @@ auto encode(const Eigen::Ref<const Eigen::VectorXd>& lon,
   {
     auto gil = pybind11::gil_scoped_release();
 
-    for (Eigen::Index ix = 0; ix < size; ++ix) {
-      encode({lon[ix], lat[ix]}, buffer, precision);
-      buffer += precision;
-    }
+    detail::dispatch(
+        [&](size_t start, size_t end) {
+          for (auto ix = static_cast<Eigen::Index>(start);
+               ix < static_cast<Eigen::Index>(end); ++ix) {
+            encode({lon[ix], lat[ix]}, buffer + ix * precision, precision);
+          }
+        },
+        static_cast<size_t>(size), num_threads);
   }
   return array.pyarray();
 }
@@ -120,21 +127,26 @@ auto decode(const char* const hash, const size_t count, const bool round)
 }
 
 // ---------------------------------------------------------------------------
-auto decode(const pybind11::array& hash, const bool round)
+auto decode(const pybind11::array& hash, const bool round,
+            const size_t num_threads)
     -> std::tuple<Eigen::VectorXd, Eigen::VectorXd> {
   auto info = Array::get_info(hash, 1);
   auto count = info.strides[0];
   auto lon = Eigen::VectorXd(info.shape[0]);
   auto lat = Eigen::VectorXd(info.shape[0]);
-  auto* ptr = static_cast<char*>(info.ptr);
+  const auto* ptr = static_cast<const char*>(info.ptr);
   {
     auto gil = pybind11::gil_scoped_release();
-    for (auto ix = 0LL; ix < info.shape[0]; ++ix) {
-      auto point = decode(ptr, count, round);
-      lon[ix] = point.lon();
-      lat[ix] = point.lat();
-      ptr += count;
-    }
+    detail::dispatch(
+        [&](size_t start, size_t end) {
+          for (auto ix = static_cast<int64_t>(start);
+               ix < static_cast<int64_t>(end); ++ix) {
+            auto point = decode(ptr + ix * count, count, round);
+            lon[ix] = point.lon();
+            lat[ix] = point.lat();
+          }
+        },
+        static_cast<size_t>(info.shape[0]), num_threads);
   }
   return std::make_tuple(lon, lat);
 }
@@ -159,31 +171,36 @@ auto neighbors(const char* const hash, const size_t count) -> pybind11::array {
 
 // ---------------------------------------------------------------------------
 auto area(const pybind11::array& hash,
-          const std::optional<geodetic::System>& wgs) -> Eigen::MatrixXd {
+          const std::optional<geodetic::System>& wgs, const size_t num_threads)
+    -> Eigen::VectorXd {
   auto info = Array::get_info(hash, 1);
   auto count = info.strides[0];
-  auto result = Eigen::VectorXd(info.shape[0]);
-  auto* ptr = static_cast<char*>(info.ptr);
-  auto spheroid = wgs.has_value()
-                      ? boost::geometry::srs::spheroid(wgs->semi_major_axis(),
-                                                       wgs->semi_minor_axis())
-                      : boost::geometry::srs::spheroid<double>();
-  auto strategy = boost::geometry::strategy::area::geographic<
-      boost::geometry::strategy::vincenty, 5>(spheroid);
+  auto codes = Vector<uint64_t>(info.shape[0]);
+  auto precisions = Vector<uint32_t>(info.shape[0]);
+  const auto* ptr = static_cast<const char*>(info.ptr);
   {
     auto gil = pybind11::gil_scoped_release();
     for (auto ix = 0LL; ix < info.shape[0]; ++ix) {
-      result[ix] = boost::geometry::area(
-          static_cast<geodetic::Polygon>(bounding_box(ptr, count)), strategy);
+      std::tie(codes[ix], precisions[ix]) = base32.decode(ptr, count);
       ptr += count;
     }
+    // The codes of the same length are processed in a single batch.
+    if (info.shape[0] == 0 || (precisions.array() == precisions[0]).all()) {
+      return int64::area(codes, precisions.size() == 0 ? 5 : 5 * precisions[0],
+                         wgs, num_threads);
+    }
+    auto result = Eigen::VectorXd(info.shape[0]);
+    for (auto ix = 0LL; ix < info.shape[0]; ++ix) {
+      result[ix] = int64::area(codes[ix], 5 * precisions[ix], wgs);
+    }
+    return result;
   }
-  return result;
 }
 
 // ---------------------------------------------------------------------------
 auto bounding_boxes(const std::optional<geodetic::Box>& box,
-                    const uint32_t precision) -> pybind11::array {
+                    const uint32_t precision, const size_t num_threads)
+    -> pybind11::array {
   // Number of bits
   auto bits = precision * 5;
 
@@ -203,232 +220,162 @@ auto bounding_boxes(const std::optional<geodetic::Box>& box,
     auto gil = pybind11::gil_scoped_release();
 
     for (const auto& item : boxes) {
-      auto [hash_sw, lon_step, lat_step] = int64::grid_properties(item, bits);
-      const auto point_sw = int64::decode(hash_sw, bits, true);
-
-      for (size_t lat = 0; lat < lat_step; ++lat) {
-        const auto lat_shift =
-            static_cast<double>(lat) * std::get<1>(lng_lat_err);
+      size_t lat_step;
+      size_t lon_step;
+      uint64_t hash_sw;
 
-        for (size_t lon = 0; lon < lon_step; ++lon) {
-          const auto lon_shift =
-              static_cast<double>(lon) * std::get<0>(lng_lat_err);
+      std::tie(hash_sw, lon_step, lat_step) =
+          int64::grid_properties(item, bits);
+      const auto point_sw = int64::decode(hash_sw, bits, true);
 
-          Base32::encode(int64::encode({point_sw.lon() + lon_shift,
-                                        point_sw.lat() + lat_shift},
-                                       bits),
-                         buffer, precision);
-          buffer += precision;
-        }
-      }
+      // Each thread encodes rows of the grid.
+      detail::dispatch(
+          [&](size_t start, size_t end) {
+            for (auto lat = start; lat < end; ++lat) {
+              const auto lat_shift =
+                  static_cast<double>(lat) * std::get<1>(lng_lat_err);
+              auto* ptr = buffer + lat * lon_step * precision;
+
+              for (size_t lon = 0; lon < lon_step; ++lon) {
+                const auto lon_shift =
+                    static_cast<double>(lon) * std::get<0>(lng_lat_err);
+
+                Base32::encode(int64::encode({point_sw.lon() + lon_shift,
+                                              point_sw.lat() + lat_shift},
+                                             bits),
+                               ptr, precision);
+                ptr += precision;
+              }
+            }
+          },
+          lat_step, num_threads);
+      buffer += lat_step * lon_step * precision;
     }
   }
   return result.pyarray();
 }
 
-// ---------------------------------------------------------------------------
-// Calculates a grid containing for each cell a boolean indicating if the cell
-// of the grid is enclosed or not in the polygon.
-static auto mask_box(const geodetic::Box& box, const geodetic::Polygon& polygon,
-                     const std::tuple<double, double>& lng_lat_err,
-                     const uint32_t bits, const size_t num_threads)
-    -> Matrix<bool> {
-  size_t lat_step;
-  size_t lon_step;
-  uint64_t hash_sw;
-
-  // Calculate the grid properties
-  std::tie(hash_sw, lon_step, lat_step) = int64::grid_properties(box, bits);
-  const auto point_sw = int64::decode(hash_sw, bits, true);
-
-  // Allocate the grid result
-  auto result = Matrix<bool>(lon_step, lat_step);
-
-  // Captures the detected exceptions in the calculation function
-  // (only the last exception captured is kept)
-  auto except = std::exception_ptr(nullptr);
-
-  detail::dispatch(
-      [&](size_t start, size_t end) {
-        for (auto lat = static_cast<int64_t>(start);
-             lat < static_cast<int64_t>(end); ++lat) {
-          const auto lat_shift =
-              static_cast<double>(lat) * std::get<1>(lng_lat_err);
-
-          for (size_t lon = 0; lon < lon_step; ++lon) {
-            const auto lon_shift =
-                static_cast<double>(lon) * std::get<0>(lng_lat_err);
-
-            result(lon, lat) = boost::geometry::intersects(
-                int64::bounding_box(
-                    int64::encode(geodetic::Point(point_sw.lon() + lon_shift,
-                                                  point_sw.lat() + lat_shift),
-                                  bits),
-                    bits),
-                polygon);
-          }
-        }
-      },
-      lat_step, num_threads);
-
-  if (except != nullptr) {
-    std::rethrow_exception(except);
-  }
-
-  return result;
-}
-
-// ---------------------------------------------------------------------------
-static auto mask_boxes(const std::vector<geodetic::Box>& boxes,
-                       const geodetic::Polygon& polygon,
-                       const std::tuple<double, double>& lng_lat_err,
-                       const uint32_t precision, const size_t num_threads)
-    -> std::vector<Matrix<bool>> {
-  // Allocation of the vector storing the different codes of the matrix created
-  auto result = std::vector<Matrix<bool>>();
-
-  {
-    auto gil = pybind11::gil_scoped_release();
-
-    for (const auto& item : boxes) {
-      result.emplace_back(
-          mask_box(item, polygon, lng_lat_err, precision, num_threads));
-    }
-  }
-  return result;
-}
-
 // ---------------------------------------------------------------------------
 auto bounding_boxes(const geodetic::Polygon& polygon, const uint32_t precision,
                     const size_t num_threads) -> pybind11::array {
-  // Number of bits
-  auto bits = precision * 5;
-
-  // Bounding box of the grid to be created
-  const auto envelope = polygon.envelope();
-
-  // If the envelope cut the meridian, we need to split it into two
-  // bounding boxes.
-  auto split_box = [](const geodetic::Box& box) -> std::vector<geodetic::Box> {
-    auto boxes = box.normalize().split();
-    return {std::make_move_iterator(boxes.begin()),
-            std::make_move_iterator(boxes.end())};
-  };
-  auto boxes = split_box(envelope);
-
-  // Grid resolution in degrees
-  const auto lng_lat_err = int64::error_with_precision(bits);
-
-  // Calculates the intersection mask between the polygon and the GeoHash grid
-  // (multithreaded)
-  auto masks = mask_boxes(boxes, polygon, lng_lat_err, bits, num_threads);
-
-  // Count the number of cells that are enclosed by the polygon
-  auto size = size_t(0);
-  for (const auto& item : masks) {
-    size += static_cast<size_t>(
-        std::count(item.data(), item.data() + item.size(), true));
-  }
+  // Sorted codes of the cells intersecting the polygon.
+  const auto codes = int64::bounding_boxes(polygon, precision * 5, num_threads);
 
   // Allocates the result array
-  auto result = allocate_array(size, precision);
+  auto result = allocate_array(codes.size(), precision);
   auto* buffer = result.buffer();
 
-  // Finally, for each cell of the grid, if it is enclosed by the polygon,
-  // we add the code to the result array
   {
     auto gil = pybind11::gil_scoped_release();
 
-    for (auto ix = size_t(0); ix < masks.size(); ++ix) {
-      auto box = boxes[ix];
-      auto mask = masks[ix];
-
-      auto [hash_sw, lon_step, lat_step] = int64::grid_properties(box, bits);
-      const auto point_sw = int64::decode(hash_sw, bits, true);
-      for (size_t lat = 0; lat < lat_step; ++lat) {
-        const auto lat_shift =
-            static_cast<double>(lat) * std::get<1>(lng_lat_err);
-
-        for (size_t lon = 0; lon < lon_step; ++lon) {
-          if (mask(lon, lat)) {
-            const auto lon_shift =
-                static_cast<double>(lon) * std::get<0>(lng_lat_err);
-
-            Base32::encode(
-                int64::encode(geodetic::Point(point_sw.lon() + lon_shift,
-                                              point_sw.lat() + lat_shift),
-                              bits),
-                buffer, precision);
-            buffer += precision;
-            ++size;
+    detail::dispatch(
+        [&](size_t start, size_t end) {
+          for (auto ix = start; ix < end; ++ix) {
+            Base32::encode(codes(static_cast<Eigen::Index>(ix)),
+                           buffer + ix * precision, precision);
           }
+        },
+        static_cast<size_t>(codes.size()), num_threads);
+  }
+  return result.pyarray();
+}
+
+// ---------------------------------------------------------------------------
+// Scans the 2D array of codes and returns, for each distinct code in the order
+// of their first occurrence, the offset of this occurrence and the extent of
+// the code: first and last row, first and last column.
+static auto scan_codes(const char* const ptr, const int64_t rows,
+                       const int64_t cols, const int64_t chars)
+    -> std::tuple<std::vector<int64_t>, std::vector<std::array<int64_t, 4>>> {
+  auto first = std::vector<int64_t>();
+  auto extents = std::vector<std::array<int64_t, 4>>();
+
+  // The codes are identified by their decoded bits and their number of
+  // characters, so no string is allocated.
+  auto index = std::unordered_map<uint64_t, size_t>();
+  auto current = size_t(0);
+
+  for (int64_t ix = 0; ix < rows; ++ix) {
+    for (int64_t jx = 0; jx < cols; ++jx) {
+      const auto offset = ix * cols + jx;
+      const auto* code = ptr + offset * chars;
+
+      // The arrays are often sorted: a code identical to the previous one
+      // belongs to the same entry.
+      if (offset == 0 || std::memcmp(code, code - chars, chars) != 0) {
+        auto [bits, count] = base32.decode(code, chars);
+        auto key = (bits << 4U) | count;
+        auto it = index.find(key);
+        if (it == index.end()) {
+          it = index.emplace(key, first.size()).first;
+          first.push_back(offset);
+          extents.push_back({ix, ix, jx, jx});
         }
+        current = it->second;
       }
+      auto& extent = extents[current];
+      extent[0] = std::min(extent[0], ix);
+      extent[1] = std::max(extent[1], ix);
+      extent[2] = std::min(extent[2], jx);
+      extent[3] = std::max(extent[3], jx);
     }
   }
-  return result.pyarray();
+  return std::make_tuple(std::move(first), std::move(extents));
 }
 
 // ---------------------------------------------------------------------------
 auto where(const pybind11::array& hash) -> std::unordered_map<
     std::string,
     std::tuple<std::tuple<int64_t, int64_t>, std::tuple<int64_t, int64_t>>> {
-  // Index shifts of neighboring pixels
-  static const auto shift_row =
-      std::array<int64_t, 8>{-1, -1, -1, 0, 1, 0, 1, 1};
-  static const auto shift_col =
-      std::array<int64_t, 8>{-1, 1, 0, -1, -1, 1, 0, 1};
-
   auto result = std::unordered_map<
       std::string,
       std::tuple<std::tuple<int64_t, int64_t>, std::tuple<int64_t, int64_t>>>();
 
   auto info = Array::get_info(hash, 2);
-  auto rows = info.shape[0];
-  auto cols = info.shape[1];
   auto chars = info.strides[1];
-  auto* ptr = static_cast<char*>(info.ptr);
-  std::string current_code;
-  std::string neighboring_code;
-
-  assert(chars <= 12);
+  const auto* ptr = static_cast<const char*>(info.ptr);
 
   {
     auto gil = pybind11::gil_scoped_release();
 
-    for (int64_t ix = 0; ix < rows; ++ix) {
-      for (int64_t jx = 0; jx < cols; ++jx) {
-        current_code = std::string(ptr + (ix * cols + jx) * chars, chars);
-
-        auto it = result.find(current_code);
-        if (it == result.end()) {
-          result.emplace(std::make_pair(
-              current_code, std::make_tuple(std::make_tuple(ix, ix),
-                                            std::make_tuple(jx, jx))));
-          continue;
-        }
+    auto [first, extents] =
+        scan_codes(ptr, info.shape[0], info.shape[1], chars);
+    result.reserve(first.size());
+    for (size_t ix = 0; ix < first.size(); ++ix) {
+      const auto& extent = extents[ix];
+      result.emplace(std::string(ptr + first[ix] * chars, chars),
+                     std::make_tuple(std::make_tuple(extent[0], extent[1]),
+                                     std::make_tuple(extent[2], extent[3])));
+    }
+  }
+  return result;
+}
 
-        for (int64_t kx = 0; kx < 8; ++kx) {
-          const auto i = ix + shift_row[kx];
-          const auto j = jx + shift_col[kx];
+// ---------------------------------------------------------------------------
+auto where_arrays(const pybind11::array& hash)
+    -> std::tuple<pybind11::array, Matrix<int64_t>> {
+  auto info = Array::get_info(hash, 2);
+  auto chars = info.strides[1];
+  const auto* ptr = static_cast<const char*>(info.ptr);
 
-          if (i >= 0 && i < rows && j >= 0 && j < cols) {
-            neighboring_code = std::string(ptr + (i * cols + j) * chars, chars);
-            if (current_code == neighboring_code) {
-              auto& first = std::get<0>(it->second);
-              std::get<0>(first) = std::min(std::get<0>(first), i);
-              std::get<1>(first) = std::max(std::get<1>(first), i);
+  std::vector<int64_t> first;
+  std::vector<std::array<int64_t, 4>> extents;
+  {
+    auto gil = pybind11::gil_scoped_release();
+    std::tie(first, extents) =
+        scan_codes(ptr, info.shape[0], info.shape[1], chars);
+  }
 
-              auto& second = std::get<1>(it->second);
-              std::get<0>(second) = std::min(std::get<0>(second), j);
-              std::get<1>(second) = std::max(std::get<1>(second), j);
-            }
-          }
-        }
-      }
+  auto codes = allocate_array(first.size(), static_cast<uint32_t>(chars));
+  auto indexes = Matrix<int64_t>(first.size(), 4);
+  auto* buffer = codes.buffer();
+  for (size_t ix = 0; ix < first.size(); ++ix) {
+    std::memcpy(buffer + ix * chars, ptr + first[ix] * chars, chars);
+    for (Eigen::Index jx = 0; jx < 4; ++jx) {
+      indexes(static_cast<Eigen::Index>(ix), jx) = extents[ix][jx];
     }
   }
-  return result;
+  return std::make_tuple(codes.pyarray(), std::move(indexes));
 }
 
 // ---------------------------------------------------------------------------
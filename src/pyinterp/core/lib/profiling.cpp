@@ -0,0 +1,207 @@
+// Copyright (c) 2022 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+#include "pyinterp/detail/profiling.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace pyinterp::detail::profiling {
+namespace {
+
+/// Counters updated by one thread. Only the owning thread writes them, the
+/// other threads read them when a snapshot is taken: they do not need a
+/// lock, nor atomic read-modify-write operations.
+struct Slot {
+  std::array<std::atomic<uint64_t>, kCounterCount> calls{};
+  std::array<std::atomic<uint64_t>, kCounterCount> ticks{};
+  std::array<std::atomic<uint64_t>, kCounterCount> allocations{};
+  std::array<std::atomic<uint64_t>, kCounterCount> bytes{};
+
+  /// Adds a value to a counter of this slot.
+  static inline auto add(std::atomic<uint64_t>& counter, const uint64_t value)
+      -> void {
+    counter.store(counter.load(std::memory_order_relaxed) + value,
+                  std::memory_order_relaxed);
+  }
+};
+
+/// Known slots, and values of the counters at the last reset.
+class Registry {
+ public:
+  Registry()
+      : origin_ticks_(profiling::ticks()),
+        origin_time_(std::chrono::steady_clock::now()) {}
+
+  /// Creates the slot of the calling thread. The slot is shared with the
+  /// registry, which keeps the values counted by the threads that have
+  /// exited.
+  auto attach() -> std::shared_ptr<Slot> {
+    auto slot = std::make_shared<Slot>();
+    auto lock = std::unique_lock<std::mutex>(mutex_);
+    slots_.push_back(slot);
+    return slot;
+  }
+
+  /// Get the values counted since the last reset.
+  auto snapshot() -> Snapshot {
+    auto lock = std::unique_lock<std::mutex>(mutex_);
+    auto result = totals();
+    auto frequency = this->frequency();
+    for (size_t ix = 0; ix < kCounterCount; ++ix) {
+      result[ix].calls -= baseline_[ix].calls;
+      result[ix].ticks -= baseline_[ix].ticks;
+      result[ix].seconds = static_cast<double>(result[ix].ticks) / frequency;
+      result[ix].allocations -= baseline_[ix].allocations;
+      result[ix].bytes -= baseline_[ix].bytes;
+      result[ix].peak_bytes = static_cast<uint64_t>(
+          std::max<int64_t>(peak_[ix].load(std::memory_order_relaxed), 0));
+    }
+    return result;
+  }
+
+  /// The values counted so far become the new origin of the counters. The
+  /// memory still held becomes the new peak.
+  auto reset() -> void {
+    auto lock = std::unique_lock<std::mutex>(mutex_);
+    baseline_ = totals();
+    for (size_t ix = 0; ix < kCounterCount; ++ix) {
+      peak_[ix].store(live_[ix].load(std::memory_order_relaxed),
+                      std::memory_order_relaxed);
+    }
+  }
+
+  /// Updates the memory held by a counter, shared by all the threads.
+  auto hold(const Counter counter, const int64_t bytes) -> void {
+    auto live = live_[counter].fetch_add(bytes, std::memory_order_relaxed) +
+                bytes;
+    auto& peak = peak_[counter];
+    auto current = peak.load(std::memory_order_relaxed);
+    while (live > current &&
+           !peak.compare_exchange_weak(current, live,
+                                       std::memory_order_relaxed)) {
+    }
+  }
+
+ private:
+  std::mutex mutex_{};
+  std::vector<std::shared_ptr<Slot>> slots_{};
+  Snapshot baseline_{};
+  std::array<std::atomic<int64_t>, kCounterCount> live_{};
+  std::array<std::atomic<int64_t>, kCounterCount> peak_{};
+  uint64_t origin_ticks_;
+  std::chrono::steady_clock::time_point origin_time_;
+
+  /// Sums the counters of all the slots.
+  auto totals() const -> Snapshot {
+    auto result = Snapshot{};
+    for (const auto& slot : slots_) {
+      for (size_t ix = 0; ix < kCounterCount; ++ix) {
+        result[ix].calls += slot->calls[ix].load(std::memory_order_relaxed);
+        result[ix].ticks += slot->ticks[ix].load(std::memory_order_relaxed);
+        result[ix].allocations +=
+            slot->allocations[ix].load(std::memory_order_relaxed);
+        result[ix].bytes += slot->bytes[ix].load(std::memory_order_relaxed);
+      }
+    }
+    return result;
+  }
+
+  /// Number of ticks of the timer per second. The frequency of the time stamp
+  /// counter is measured against the steady clock since the creation of the
+  /// registry.
+  auto frequency() const -> double {
+#ifdef PYINTERP_HAS_RDTSC
+    auto elapsed = std::chrono::duration<double>(
+                       std::chrono::steady_clock::now() - origin_time_)
+                       .count();
+    auto ticks = profiling::ticks() - origin_ticks_;
+    if (elapsed > 0 && ticks > 0) {
+      return static_cast<double>(ticks) / elapsed;
+    }
+#endif
+    return 1e9;
+  }
+};
+
+/// Get the process-wide registry. It's never destroyed, so that the threads
+/// exiting after the end of the main function can still use it.
+auto registry() -> Registry& {
+  static auto* instance = new Registry();
+  return *instance;
+}
+
+/// Get the slot of the calling thread.
+auto local_slot() -> Slot& {
+  thread_local auto slot = registry().attach();
+  return *slot;
+}
+
+}  // namespace
+
+// ---------------------------------------------------------------------------
+auto name(const Counter counter) -> const char* {
+  switch (counter) {
+    case kAxisFindIndexes:
+      return "axis.find_indexes";
+    case kDispatch:
+      return "dispatch";
+    case kDispatchStartup:
+      return "dispatch.startup";
+    case kFillGaussSeidel:
+      return "fill.gauss_seidel";
+    case kFillLoess:
+      return "fill.loess";
+    case kFillMultigrid:
+      return "fill.multigrid";
+    case kFillSpectral:
+      return "fill.spectral";
+    case kLoadFrame:
+      return "load_frame";
+    case kRTreeQuery:
+      return "rtree.query";
+    case kHistogramMarshal:
+      return "streaming_histogram.marshal";
+    default:
+      return "unknown";
+  }
+}
+
+// ---------------------------------------------------------------------------
+auto enable(const bool value) -> void {
+  // The registry is created before the first measurement, which starts the
+  // calibration of the timer.
+  registry();
+  active.store(value, std::memory_order_relaxed);
+}
+
+// ---------------------------------------------------------------------------
+auto record(const Counter counter, const uint64_t elapsed) -> void {
+  auto& slot = local_slot();
+  Slot::add(slot.calls[counter], 1);
+  Slot::add(slot.ticks[counter], elapsed);
+}
+
+// ---------------------------------------------------------------------------
+auto allocate(const Counter counter, const size_t bytes) -> void {
+  auto& slot = local_slot();
+  Slot::add(slot.allocations[counter], 1);
+  Slot::add(slot.bytes[counter], bytes);
+  registry().hold(counter, static_cast<int64_t>(bytes));
+}
+
+// ---------------------------------------------------------------------------
+auto deallocate(const Counter counter, const size_t bytes) -> void {
+  registry().hold(counter, -static_cast<int64_t>(bytes));
+}
+
+// ---------------------------------------------------------------------------
+auto snapshot() -> Snapshot { return registry().snapshot(); }
+
+// ---------------------------------------------------------------------------
+auto reset() -> void { registry().reset(); }
+
+}  // namespace pyinterp::detail::profiling
@@ -0,0 +1,512 @@
+// Copyright (c) 2022 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+#include "pyinterp/detail/thread.hpp"
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cmath>
+#include <cstdlib>
+#include <exception>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+#include "pyinterp/detail/profiling.hpp"
+
+namespace pyinterp::detail {
+namespace {
+
+/// Number of threads set by set_num_threads, or 0 if it has not been set.
+std::atomic<size_t> num_threads_setting{0};
+
+#ifdef __linux__
+/// Reads the first line of a file, or returns an empty string if the file
+/// cannot be read.
+auto read_line(const std::string& path) -> std::string {
+  auto stream = std::ifstream(path);
+  auto line = std::string();
+  std::getline(stream, line);
+  return line;
+}
+
+/// Parses a list of CPUs, or of NUMA nodes, written by the kernel, such as
+/// "0-3,8,10-11".
+auto parse_list(const std::string& text) -> std::vector<int> {
+  auto result = std::vector<int>();
+  auto stream = std::istringstream(text);
+  auto item = std::string();
+  while (std::getline(stream, item, ',')) {
+    if (item.find_first_of("0123456789") == std::string::npos) {
+      continue;
+    }
+    auto dash = item.find('-');
+    auto first = std::atoi(item.substr(0, dash).c_str());
+    auto last = dash == std::string::npos
+                    ? first
+                    : std::atoi(item.substr(dash + 1).c_str());
+    for (auto cpu = first; cpu <= last; ++cpu) {
+      result.push_back(cpu);
+    }
+  }
+  return result;
+}
+
+/// Get the CPUs of the affinity mask of the process.
+auto affinity_cpus() -> std::vector<int> {
+  auto result = std::vector<int>();
+  cpu_set_t mask;
+  CPU_ZERO(&mask);
+  if (sched_getaffinity(0, sizeof(mask), &mask) == 0) {
+    for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+      if (CPU_ISSET(cpu, &mask)) {
+        result.push_back(cpu);
+      }
+    }
+  }
+  return result;
+}
+
+/// Get the number of CPUs granted by the CPU quota of the control group of
+/// the process (cgroup v2, then v1), or 0 if there is no quota.
+auto cgroup_cpus() -> size_t {
+  auto quota = 0.0;
+  auto period = 0.0;
+  auto line = read_line("/sys/fs/cgroup/cpu.max");
+  if (!line.empty()) {
+    // "<quota> <period>", or "max <period>" if there is no quota.
+    auto stream = std::istringstream(line);
+    auto text = std::string();
+    stream >> text >> period;
+    quota = text == "max" ? 0.0 : std::atof(text.c_str());
+  } else {
+    for (const auto& path :
+         {"/sys/fs/cgroup/cpu", "/sys/fs/cgroup/cpu,cpuacct"}) {
+      auto cfs_quota = read_line(std::string(path) + "/cpu.cfs_quota_us");
+      auto cfs_period = read_line(std::string(path) + "/cpu.cfs_period_us");
+      if (!cfs_quota.empty() && !cfs_period.empty()) {
+        // The quota is -1 if there is no quota.
+        quota = std::atof(cfs_quota.c_str());
+        period = std::atof(cfs_period.c_str());
+        break;
+      }
+    }
+  }
+  if (quota <= 0 || period <= 0) {
+    return 0;
+  }
+  return std::max<size_t>(static_cast<size_t>(std::ceil(quota / period)), 1);
+}
+
+/// Get the CPUs to which the workers are bound: the CPUs of the affinity
+/// mask, ordered so that consecutive CPUs belong to different NUMA nodes. The
+/// workers, and the memory they allocate, are thus spread over the nodes.
+auto placement_cpus() -> std::vector<int> {
+  auto node_of = std::map<int, int>();
+  for (auto node : parse_list(read_line("/sys/devices/system/node/possible"))) {
+    for (auto cpu : parse_list(read_line("/sys/devices/system/node/node" +
+                                         std::to_string(node) + "/cpulist"))) {
+      node_of[cpu] = node;
+    }
+  }
+  auto cpus = affinity_cpus();
+  auto nodes = std::map<int, std::vector<int>>();
+  for (auto cpu : cpus) {
+    auto it = node_of.find(cpu);
+    nodes[it == node_of.end() ? 0 : it->second].push_back(cpu);
+  }
+  auto result = std::vector<int>();
+  for (size_t rank = 0; result.size() < cpus.size(); ++rank) {
+    for (const auto& item : nodes) {
+      if (rank < item.second.size()) {
+        result.push_back(item.second[rank]);
+      }
+    }
+  }
+  return result;
+}
+
+/// Binds a thread to a CPU. Failures are ignored: the binding is only a
+/// hint for the scheduler.
+auto pin_thread(std::thread& thread, const int cpu) -> void {
+  cpu_set_t mask;
+  CPU_ZERO(&mask);
+  CPU_SET(cpu, &mask);
+  pthread_setaffinity_np(thread.native_handle(), sizeof(mask), &mask);
+}
+#endif
+
+}  // namespace
+
+// ---------------------------------------------------------------------------
+auto available_cpus() -> size_t {
+  static const auto result = []() -> size_t {
+    auto cpus = static_cast<size_t>(std::thread::hardware_concurrency());
+#ifdef __linux__
+    auto affinity = affinity_cpus().size();
+    if (affinity != 0) {
+      cpus = affinity;
+    }
+    auto quota = cgroup_cpus();
+    if (quota != 0) {
+      cpus = std::min(cpus, quota);
+    }
+#endif
+    return std::max<size_t>(cpus, 1);
+  }();
+  return result;
+}
+
+// ---------------------------------------------------------------------------
+auto get_num_threads() -> size_t {
+  auto result = num_threads_setting.load(std::memory_order_relaxed);
+  return result == 0 ? available_cpus() : result;
+}
+
+// ---------------------------------------------------------------------------
+auto set_num_threads(const size_t num_threads, const bool pin) -> void {
+  num_threads_setting.store(num_threads, std::memory_order_relaxed);
+  ThreadPool::resize(0, pin);
+}
+
+// ---------------------------------------------------------------------------
+ThreadPool::ThreadPool(const size_t num_workers,
+                       [[maybe_unused]] const bool pin) {
+  workers_.reserve(num_workers);
+  for (size_t ix = 0; ix < num_workers; ++ix) {
+    workers_.emplace_back([this]() { run(); });
+  }
+#ifdef __linux__
+  if (pin) {
+    // The first CPU is left to the calling thread, which takes part in all
+    // the computations.
+    auto cpus = placement_cpus();
+    for (size_t ix = 0; ix < num_workers && !cpus.empty(); ++ix) {
+      pin_thread(workers_[ix], cpus[(ix + 1) % cpus.size()]);
+    }
+    pinned_ = !cpus.empty();
+  }
+#endif
+}
+
+// ---------------------------------------------------------------------------
+ThreadPool::~ThreadPool() {
+  {
+    auto lock = std::unique_lock<std::mutex>(mutex_);
+    stop_ = true;
+  }
+  condition_.notify_all();
+  for (auto& item : workers_) {
+    // The caller of parallel_for holds the pool until its tasks are
+    // completed, including the nested calls made by the workers: the last
+    // reference is never released by one of the workers of the pool.
+    assert(item.get_id() != std::this_thread::get_id());
+    item.join();
+  }
+}
+
+// ---------------------------------------------------------------------------
+auto ThreadPool::submit(Task task) -> void {
+  {
+    auto lock = std::unique_lock<std::mutex>(mutex_);
+    tasks_.emplace_back(std::move(task));
+  }
+  condition_.notify_one();
+}
+
+// ---------------------------------------------------------------------------
+auto ThreadPool::run() -> void {
+  while (true) {
+    auto task = Task();
+    {
+      auto lock = std::unique_lock<std::mutex>(mutex_);
+      condition_.wait(lock, [this] { return stop_ || !tasks_.empty(); });
+      if (tasks_.empty()) {
+        return;
+      }
+      task = std::move(tasks_.front());
+      tasks_.pop_front();
+    }
+    task();
+  }
+}
+
+// ---------------------------------------------------------------------------
+auto ThreadPool::default_size() -> size_t {
+  auto num_threads = get_num_threads();
+  return num_threads > 1 ? num_threads - 1 : 0;
+}
+
+// Process-wide pool and the mutex protecting its access.
+static auto global_pool() -> std::shared_ptr<ThreadPool>& {
+  static auto pool = std::shared_ptr<ThreadPool>();
+  return pool;
+}
+
+static auto global_pool_mutex() -> std::mutex& {
+  static auto mutex = std::mutex();
+  return mutex;
+}
+
+// ---------------------------------------------------------------------------
+auto ThreadPool::instance() -> std::shared_ptr<ThreadPool> {
+  auto lock = std::unique_lock<std::mutex>(global_pool_mutex());
+  auto& pool = global_pool();
+  if (!pool) {
+    pool = std::make_shared<ThreadPool>(default_size());
+  }
+  return pool;
+}
+
+// ---------------------------------------------------------------------------
+auto ThreadPool::resize(const size_t num_workers, const bool pin) -> void {
+  auto pool = std::make_shared<ThreadPool>(
+      num_workers == 0 ? default_size() : num_workers, pin);
+  {
+    auto lock = std::unique_lock<std::mutex>(global_pool_mutex());
+    std::swap(global_pool(), pool);
+  }
+  // The previous pool, if any, is released here once the tasks still using it
+  // are completed.
+}
+
+namespace {
+
+/// Number of blocks built for each thread by the static schedule.
+constexpr size_t kStaticBlocksPerThread = 8;
+
+/// Number of blocks built for each thread by the dynamic schedule.
+constexpr size_t kDynamicBlocksPerThread = 32;
+
+/// Number of blocks of minimum size built for each thread by the guided
+/// schedule.
+constexpr size_t kGuidedBlocksPerThread = 64;
+
+/// Contiguous set of blocks initially assigned to one thread. The owner
+/// consumes its blocks from the front, the other threads steal them from the
+/// back.
+struct alignas(64) Partition {
+  std::mutex mutex;
+  size_t first{0};
+  size_t last{0};
+
+  /// Takes the next block owned by this partition.
+  inline auto pop_front(size_t& block) -> bool {
+    auto lock = std::unique_lock<std::mutex>(mutex);
+    if (first == last) {
+      return false;
+    }
+    block = first++;
+    return true;
+  }
+
+  /// Steals the last block of this partition.
+  inline auto pop_back(size_t& block) -> bool {
+    auto lock = std::unique_lock<std::mutex>(mutex);
+    if (first == last) {
+      return false;
+    }
+    block = --last;
+    return true;
+  }
+};
+
+/// State shared by all the threads processing the same range.
+class Job {
+ public:
+  Job(const std::function<void(size_t, size_t)>& worker, const size_t size,
+      const size_t num_threads, const Schedule schedule)
+      : worker_(&worker),
+        size_(size),
+        schedule_(schedule),
+        participants_(std::min(num_threads, size)),
+        partitions_(schedule == kStatic ? participants_ : 0),
+        remaining_(size) {
+    switch (schedule_) {
+      case kStatic:
+        blocks_ = std::min(size, participants_ * kStaticBlocksPerThread);
+        for (size_t ix = 0; ix < participants_; ++ix) {
+          partitions_[ix].first = ix * blocks_ / participants_;
+          partitions_[ix].last = (ix + 1) * blocks_ / participants_;
+        }
+        break;
+      case kDynamic:
+        grain_ = std::max(size / (participants_ * kDynamicBlocksPerThread),
+                          size_t(1));
+        break;
+      case kGuided:
+        grain_ = std::max(size / (participants_ * kGuidedBlocksPerThread),
+                          size_t(1));
+        break;
+      default:
+        throw std::invalid_argument("unknown schedule: " +
+                                    std::to_string(schedule));
+    }
+  }
+
+  /// Get the number of threads taking part in the computation.
+  [[nodiscard]] inline auto participants() const noexcept -> size_t {
+    return participants_;
+  }
+
+  /// Processes the blocks of the range until there are none left.
+  ///
+  /// @param id Identifier of the thread taking part in the computation,
+  /// between 0 and participants() - 1.
+  auto run(const size_t id) -> void {
+    if (schedule_ == kStatic) {
+      run_static(id);
+      return;
+    }
+    auto first = size_t(0);
+    auto last = size_t(0);
+    while (schedule_ == kDynamic ? next_dynamic(first, last)
+                                 : next_guided(first, last)) {
+      execute(first, last);
+    }
+  }
+
+  /// Waits until all blocks have been processed, or skipped after an error,
+  /// and rethrows the first exception raised by the worker, if any.
+  auto wait() -> void {
+    {
+      auto lock = std::unique_lock<std::mutex>(mutex_);
+      condition_.wait(lock, [this] { return remaining_ == 0; });
+    }
+    if (except_ != nullptr) {
+      std::rethrow_exception(except_);
+    }
+  }
+
+ private:
+  const std::function<void(size_t, size_t)>* worker_;
+  size_t size_;
+  Schedule schedule_;
+  size_t participants_;
+  /// Number of blocks built by the static schedule.
+  size_t blocks_{0};
+  /// Size of the blocks built by the dynamic schedule, or minimum size of the
+  /// blocks built by the guided schedule.
+  size_t grain_{0};
+  std::vector<Partition> partitions_;
+  /// First item not yet handed out by the dynamic or guided schedule.
+  std::atomic<size_t> cursor_{0};
+  /// Number of items not yet processed.
+  std::atomic<size_t> remaining_;
+  /// Set as soon as the worker has thrown an exception: the blocks not yet
+  /// started are then skipped.
+  std::atomic<bool> cancelled_{false};
+  /// First exception thrown by the worker.
+  std::exception_ptr except_{nullptr};
+  std::mutex mutex_{};
+  std::condition_variable condition_{};
+
+  /// Processes the blocks of the partition "id", then steals the blocks left
+  /// by the other threads.
+  auto run_static(const size_t id) -> void {
+    auto block = size_t(0);
+
+    while (partitions_[id].pop_front(block)) {
+      execute(block * size_ / blocks_, (block + 1) * size_ / blocks_);
+    }
+    for (size_t ix = 1; ix < participants_; ++ix) {
+      auto& partition = partitions_[(id + ix) % participants_];
+      while (partition.pop_back(block)) {
+        execute(block * size_ / blocks_, (block + 1) * size_ / blocks_);
+      }
+    }
+  }
+
+  /// Hands out the next block of fixed size.
+  inline auto next_dynamic(size_t& first, size_t& last) -> bool {
+    first = cursor_.fetch_add(grain_, std::memory_order_relaxed);
+    if (first >= size_) {
+      return false;
+    }
+    last = std::min(first + grain_, size_);
+    return true;
+  }
+
+  /// Hands out the next block, whose size is proportional to the number of
+  /// items remaining to be distributed.
+  inline auto next_guided(size_t& first, size_t& last) -> bool {
+    auto chunk = size_t(0);
+    first = cursor_.load(std::memory_order_relaxed);
+    do {
+      if (first >= size_) {
+        return false;
+      }
+      chunk = std::max((size_ - first) / (participants_ << 1U), grain_);
+    } while (!cursor_.compare_exchange_weak(first, first + chunk,
+                                            std::memory_order_relaxed));
+    last = std::min(first + chunk, size_);
+    return true;
+  }
+
+  /// Processes the items [first, last) of the range, unless the computation
+  /// has been cancelled by an error raised for another block.
+  auto execute(const size_t first, const size_t last) -> void {
+    if (!cancelled_.load(std::memory_order_relaxed)) {
+      try {
+        (*worker_)(first, last);
+      } catch (...) {
+        auto lock = std::unique_lock<std::mutex>(mutex_);
+        if (except_ == nullptr) {
+          except_ = std::current_exception();
+        }
+        cancelled_.store(true, std::memory_order_relaxed);
+      }
+    }
+    if (remaining_.fetch_sub(last - first, std::memory_order_acq_rel) ==
+        last - first) {
+      { auto lock = std::unique_lock<std::mutex>(mutex_); }
+      condition_.notify_all();
+    }
+  }
+};
+
+}  // namespace
+
+// ---------------------------------------------------------------------------
+void parallel_for(const std::function<void(size_t, size_t)>& worker,
+                  const size_t size, size_t num_threads,
+                  const Schedule schedule) {
+  if (size == 0) {
+    return;
+  }
+  auto scope = profiling::Scope(profiling::kDispatch);
+  auto pool = ThreadPool::instance();
+  if (num_threads == 0) {
+    num_threads = pool->size() + 1;
+  }
+
+  // The job is shared with the tasks submitted to the pool: a task starting
+  // after all the blocks have been processed must find a valid state.
+  auto job = std::make_shared<Job>(worker, size, num_threads, schedule);
+  const auto profile = profiling::enabled();
+  for (size_t ix = 1; ix < job->participants(); ++ix) {
+    const auto submitted = profile ? profiling::ticks() : 0;
+    pool->submit([job, ix, profile, submitted]() {
+      if (profile) {
+        profiling::record(profiling::kDispatchStartup,
+                          profiling::ticks() - submitted);
+      }
+      job->run(ix);
+    });
+  }
+
+  // The calling thread takes part in the computation.
+  job->run(0);
+  job->wait();
+}
+
+}  // namespace pyinterp::detail
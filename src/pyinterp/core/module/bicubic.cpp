@@ -7,12 +7,22 @@
 #include <pybind11/numpy.h>
 #include <pybind11/stl.h>
 
+#include <array>
 #include <cctype>
+#include <cmath>
+#include <memory>
+#include <type_traits>
+#include <utility>
 
+#include "pyinterp/chunked_grid.hpp"
 #include "pyinterp/detail/math/linear.hpp"
 #include "pyinterp/detail/math/spline2d.hpp"
+#include "pyinterp/detail/numpy.hpp"
 #include "pyinterp/detail/thread.hpp"
+#include "pyinterp/fill.hpp"
 #include "pyinterp/frame.hpp"
+#include "pyinterp/packed_grid.hpp"
+#include "pyinterp/tiled_grid.hpp"
 
 namespace py = pybind11;
 
@@ -36,211 +46,620 @@ static inline auto parse_axis_boundary(const std::string& boundary)
   throw std::invalid_argument("boundary '" + boundary + "' is not defined");
 }
 
-/// Evaluate the interpolation.
+/// Calls the function with the number of values of the windows framing the
+/// points. For the common half windows (2 and 3), it is a compile-time
+/// constant, so that the frames loaded have fixed sizes and are stored on the
+/// stack. The other windows are handled by the frames sized at runtime.
+///
+/// @param function Function called with a std::integral_constant<int, Size>,
+/// where Size is 4, 6 or Eigen::Dynamic.
+template <typename Function>
+static auto dispatch_window_size(const Eigen::Index nx, const Eigen::Index ny,
+                                 const Function& function) -> void {
+  if (nx == 2 && ny == 2) {
+    function(std::integral_constant<int, 4>());
+  } else if (nx == 3 && ny == 3) {
+    function(std::integral_constant<int, 6>());
+  } else {
+    function(std::integral_constant<int, Eigen::Dynamic>());
+  }
+}
+
+/// Get the number of cells of an axis.
+static inline auto cell_count(const detail::Axis<double>& axis) -> int64_t {
+  return axis.is_circle() ? axis.size() : axis.size() - 1;
+}
+
+/// Get the coordinate of the middle of the cell "index" of an axis.
+static inline auto cell_center(const detail::Axis<double>& axis,
+                               const int64_t index) -> double {
+  auto x0 = axis(index);
+  auto x1 = axis(detail::math::remainder(index + 1, axis.size()));
+  return x0 + 0.5 * (axis.is_angle()
+                         ? detail::math::normalize_angle(x1 - x0, -180.0, 360.0)
+                         : x1 - x0);
+}
+
+/// Locates the cell of an axis framing a coordinate, and the normalized
+/// position of the coordinate in this cell.
+///
+/// @param axis Axis to search
+/// @param coordinate Coordinate to locate
+/// @param index Index of the first point of the cell.
+/// @param position Position of the coordinate in the cell, between 0 and 1.
+/// @param width Width of the cell.
+/// @return false if the coordinate is outside the axis.
+static inline auto cell_position(const detail::Axis<double>& axis,
+                                 const double coordinate, int64_t& index,
+                                 double& position, double& width) -> bool {
+  auto indexes = axis.find_indexes(coordinate);
+  if (!indexes) {
+    return false;
+  }
+  auto x0 = axis(std::get<0>(*indexes));
+  auto delta = coordinate - x0;
+  width = axis(std::get<1>(*indexes)) - x0;
+  if (axis.is_angle()) {
+    delta = detail::math::normalize_angle(delta, -180.0, 360.0);
+    width = detail::math::normalize_angle(width, -180.0, 360.0);
+  }
+  index = std::get<0>(*indexes);
+  position = delta / width;
+  return true;
+}
+
+/// Locates the cell of an axis framing a coordinate, and the normalized
+/// position of the coordinate in this cell.
+static inline auto cell_position(const detail::Axis<double>& axis,
+                                 const double coordinate, int64_t& index,
+                                 double& position) -> bool {
+  auto width = 0.0;
+  return cell_position(axis, coordinate, index, position, width);
+}
+
+/// Checks that the coefficients of the cells of a grid can be precomputed.
+template <typename Interpolator>
+static auto check_precomputable(const detail::Axis<double>& x_axis,
+                                const detail::Axis<double>& y_axis,
+                                const std::string& fitting_model) -> void {
+  if (!Interpolator::is_piecewise_bicubic(fitting_model)) {
+    throw std::invalid_argument(
+        "the coefficients of the fitting model '" + fitting_model +
+        "' cannot be precomputed");
+  }
+  if (!x_axis.is_ascending() || !y_axis.is_ascending()) {
+    throw std::invalid_argument(
+        "the coefficients can only be precomputed for ascending axes");
+  }
+}
+
+/// Precomputes the coefficients of the polynomials interpolating each cell of
+/// the grid, and stores them in the grid.
 template <typename DataType, typename Interpolator>
-auto bicubic(const Grid2D<DataType>& grid, const py::array_t<double>& x,
-             const py::array_t<double>& y, Eigen::Index nx, Eigen::Index ny,
-             const std::string& fitting_model, const std::string& boundary,
-             const bool bounds_error, size_t num_threads)
-    -> py::array_t<double> {
-  detail::check_array_ndim("x", 1, x, "y", 1, y);
-  detail::check_ndarray_shape("x", x, "y", y);
+auto precompute_bicubic(Grid2D<DataType>& grid, Eigen::Index nx,
+                        Eigen::Index ny, const std::string& fitting_model,
+                        const std::string& boundary, size_t num_threads)
+    -> void {
+  auto boundary_type = parse_axis_boundary(boundary);
+  const auto& x_axis = *grid.x();
+  const auto& y_axis = *grid.y();
+  check_precomputable<Interpolator>(x_axis, y_axis, fitting_model);
+
+  auto coefficients = std::make_shared<detail::math::BicubicCoefficients>(
+      x_axis.size(), y_axis.size(), 1, nx, ny, fitting_model, boundary_type);
+  const auto handle = make_handle(grid);
+  {
+    py::gil_scoped_release release;
+
+    dispatch_window_size(nx, ny, [&](auto window_size) {
+      using Frame = detail::math::Frame2D<decltype(window_size)::value>;
+      detail::dispatch(
+          [&](const size_t start, const size_t end) {
+            auto frame = Frame(nx, ny);
+            auto interpolator = Interpolator(frame, fitting_model);
 
+            for (auto ix = static_cast<int64_t>(start);
+                 ix < static_cast<int64_t>(end); ++ix) {
+              for (int64_t jx = 0; jx < cell_count(y_axis); ++jx) {
+                // The cells that cannot be fitted keep undefined coefficients.
+                if (load_frame(handle, cell_center(x_axis, ix),
+                               cell_center(y_axis, jx), boundary_type, false,
+                               frame)) {
+                  detail::math::BicubicCoefficients::fit(
+                      interpolator, frame, coefficients->cell(ix, jx, 0));
+                }
+              }
+            }
+          },
+          cell_count(x_axis), num_threads);
+    });
+  }
+  grid.bicubic_coefficients(std::move(coefficients));
+}
+
+/// Precomputes the coefficients of the polynomials interpolating each cell of
+/// each layer of the grid, and stores them in the grid.
+template <typename DataType, typename AxisType, typename Interpolator>
+auto precompute_bicubic_3d(Grid3D<DataType, AxisType>& grid, Eigen::Index nx,
+                           Eigen::Index ny, const std::string& fitting_model,
+                           const std::string& boundary, size_t num_threads)
+    -> void {
+  auto boundary_type = parse_axis_boundary(boundary);
+  const auto& x_axis = *grid.x();
+  const auto& y_axis = *grid.y();
+  const auto& z_axis = *grid.z();
+  check_precomputable<Interpolator>(x_axis, y_axis, fitting_model);
+
+  auto x_cells = cell_count(x_axis);
+  auto coefficients = std::make_shared<detail::math::BicubicCoefficients>(
+      x_axis.size(), y_axis.size(), z_axis.size(), nx, ny, fitting_model,
+      boundary_type);
+  const auto handle = make_handle(grid);
+  {
+    py::gil_scoped_release release;
+
+    dispatch_window_size(nx, ny, [&](auto window_size) {
+      constexpr auto kSize = decltype(window_size)::value;
+      using Frame = detail::math::Frame3D<AxisType, kSize>;
+      using Layer = detail::math::Frame2D<kSize>;
+      detail::dispatch(
+          [&](const size_t start, const size_t end) {
+            auto frame = Frame(nx, ny, 1);
+            auto interpolator = Interpolator(Layer(nx, ny), fitting_model);
+
+            for (auto item = static_cast<int64_t>(start);
+                 item < static_cast<int64_t>(end); ++item) {
+              auto kx = item / x_cells;
+              auto ix = item % x_cells;
+              auto zk = z_axis(kx);
+
+              for (int64_t jx = 0; jx < cell_count(y_axis); ++jx) {
+                // The frame holds the layer kx and one of its neighbors.
+                if (load_frame<DataType, AxisType>(
+                        handle, cell_center(x_axis, ix),
+                        cell_center(y_axis, jx), zk, boundary_type, false,
+                        frame)) {
+                  detail::math::BicubicCoefficients::fit(
+                      interpolator,
+                      frame.frame_2d(frame.z_indexes()[0] == kx ? 0 : 1),
+                      coefficients->cell(ix, jx, kx));
+                }
+              }
+            }
+          },
+          x_cells * z_axis.size(), num_threads);
+    });
+  }
+  grid.bicubic_coefficients(std::move(coefficients));
+}
+
+/// Evaluate the interpolation.
+///
+/// @tparam Grid Grid type, a Grid2D, a PackedGrid2D, a TiledGrid2D, or a view
+/// filling their undefined values.
+template <typename DataType, typename Interpolator, typename Grid>
+auto _bicubic(const Grid& grid, const py::array& x, const py::array& y,
+              Eigen::Index nx, Eigen::Index ny,
+              const std::string& fitting_model, const std::string& boundary,
+              const bool bounds_error, size_t num_threads,
+              const std::optional<py::array>& out) -> py::array_t<double> {
   auto boundary_type = parse_axis_boundary(boundary);
   auto size = x.size();
-  auto result = py::array_t<double>(py::array::ShapeContainer{size});
+  auto result = detail::numpy::output_array<double>("out", out, {size});
 
-  auto _x = x.template unchecked<1>();
-  auto _y = y.template unchecked<1>();
+  auto _x = detail::numpy::ArrayReader<double>(x);
+  auto _y = detail::numpy::ArrayReader<double>(y);
   auto _result = result.template mutable_unchecked<1>();
   {
     py::gil_scoped_release release;
 
-    // Captures the detected exceptions in the calculation function
-    // (only the last exception captured is kept)
-    auto except = std::exception_ptr(nullptr);
+    // The dimensions and the shapes are read from the array structures.
+    detail::check_array_ndim("x", 1, x, "y", 1, y);
+    detail::check_ndarray_shape("x", x, "y", y);
 
-    // Access to the shared pointer outside the loop to avoid data races
     const auto is_angle = grid.x()->is_angle();
+    const auto& x_axis = *grid.x();
+    const auto& y_axis = *grid.y();
 
-    detail::dispatch(
-        [&](const size_t start, const size_t end) {
-          try {
-            auto frame = detail::math::Frame2D(nx, ny);
+    // Coefficients precomputed for the grid, used only if they were fitted
+    // with the parameters of this interpolation.
+    auto coefficients = grid.bicubic_coefficients();
+    if (coefficients != nullptr &&
+        !coefficients->matches(nx, ny, fitting_model, boundary_type)) {
+      coefficients.reset();
+    }
+
+    dispatch_window_size(nx, ny, [&](auto window_size) {
+      using Frame = detail::math::Frame2D<decltype(window_size)::value>;
+      detail::dispatch(
+          [&](const size_t start, const size_t end) {
+            auto frame = Frame(nx, ny);
             auto interpolator = Interpolator(frame, fitting_model);
+            auto i0 = int64_t(0);
+            auto j0 = int64_t(0);
+            auto t = 0.0;
+            auto u = 0.0;
 
             for (size_t ix = start; ix < end; ++ix) {
               auto xi = _x(ix);
               auto yi = _y(ix);
-              _result(ix) =
-                  // The grid instance is accessed as a constant reference, no
-                  // data race problem here.
-                  load_frame(grid, xi, yi, boundary_type, bounds_error, frame)
-                      ? interpolator.interpolate(
-                            is_angle ? frame.normalize_angle(xi) : xi, yi,
-                            frame)
-                      : std::numeric_limits<double>::quiet_NaN();
+
+              if (coefficients != nullptr &&
+                  cell_position(x_axis, xi, i0, t) &&
+                  cell_position(y_axis, yi, j0, u)) {
+                _result(ix) = detail::math::BicubicCoefficients::evaluate(
+                    coefficients->cell(i0, j0, 0), t, u);
+                // The cells that could not be fitted are undefined, unless the
+                // error raised by the frame must be reported.
+                if (!bounds_error || !std::isnan(_result(ix))) {
+                  continue;
+                }
+              }
+
+              // The grid instance is accessed as a constant reference, no data
+              // race problem here.
+              if (load_frame(grid, xi, yi, boundary_type, bounds_error,
+                             frame)) {
+                // The coefficients computed for the previous point are reused
+                // as long as the points fall in the same cell.
+                if (frame.is_updated()) {
+                  interpolator.fit(frame);
+                }
+                _result(ix) = interpolator.interpolate(
+                    is_angle ? frame.normalize_angle(xi) : xi, yi);
+              } else {
+                _result(ix) = std::numeric_limits<double>::quiet_NaN();
+              }
             }
-          } catch (...) {
-            except = std::current_exception();
-          }
-        },
-        size, num_threads);
+          },
+          size, num_threads, detail::kDynamic);
+    });
+  }
+  return result;
+}
 
-    if (except != nullptr) {
-      std::rethrow_exception(except);
+/// Evaluate the interpolation.
+///
+/// @param fill_holes If set, half-windows (nx, ny) of the LOESS filter
+/// estimating the undefined values of the grid read by the interpolation.
+/// @tparam Grid Grid type, a Grid2D, a PackedGrid2D or a TiledGrid2D
+template <typename DataType, typename Interpolator,
+          typename Grid = Grid2D<DataType>>
+auto bicubic(const Grid& grid, const py::array& x, const py::array& y,
+             Eigen::Index nx, Eigen::Index ny, const std::string& fitting_model,
+             const std::string& boundary, const bool bounds_error,
+             size_t num_threads, const std::optional<py::array>& out,
+             const std::optional<std::pair<uint32_t, uint32_t>>& fill_holes)
+    -> py::array_t<double> {
+  const auto& handle = make_handle(grid);
+  if (fill_holes) {
+    auto filled = fill::LoessFilledGrid(handle, fill_holes->first,
+                                        fill_holes->second);
+    return _bicubic<DataType, Interpolator>(filled, x, y, nx, ny,
+                                            fitting_model, boundary,
+                                            bounds_error, num_threads, out);
+  }
+  return _bicubic<DataType, Interpolator>(handle, x, y, nx, ny, fitting_model,
+                                          boundary, bounds_error, num_threads,
+                                          out);
+}
+
+/// Evaluate the interpolation and the partial derivatives of the function
+/// interpolated. The frame is loaded and fitted once for the three results.
+///
+/// @tparam Grid Grid type, a Grid2D, a PackedGrid2D, a TiledGrid2D, or a view
+/// filling their undefined values.
+/// @return A tuple (values, dx, dy).
+template <typename DataType, typename Interpolator, typename Grid>
+auto _bicubic_gradient(const Grid& grid, const py::array& x,
+                       const py::array& y, Eigen::Index nx, Eigen::Index ny,
+                       const std::string& fitting_model,
+                       const std::string& boundary, const bool bounds_error,
+                       size_t num_threads, const std::optional<py::array>& out,
+                       const std::optional<py::array>& out_dx,
+                       const std::optional<py::array>& out_dy) -> py::tuple {
+  auto boundary_type = parse_axis_boundary(boundary);
+  auto size = x.size();
+  auto result = detail::numpy::output_array<double>("out", out, {size});
+  auto dx = detail::numpy::output_array<double>("out_dx", out_dx, {size});
+  auto dy = detail::numpy::output_array<double>("out_dy", out_dy, {size});
+
+  auto _x = detail::numpy::ArrayReader<double>(x);
+  auto _y = detail::numpy::ArrayReader<double>(y);
+  auto _result = result.template mutable_unchecked<1>();
+  auto _dx = dx.template mutable_unchecked<1>();
+  auto _dy = dy.template mutable_unchecked<1>();
+  {
+    py::gil_scoped_release release;
+
+    // The dimensions and the shapes are read from the array structures.
+    detail::check_array_ndim("x", 1, x, "y", 1, y);
+    detail::check_ndarray_shape("x", x, "y", y);
+
+    const auto is_angle = grid.x()->is_angle();
+    const auto& x_axis = *grid.x();
+    const auto& y_axis = *grid.y();
+
+    auto coefficients = grid.bicubic_coefficients();
+    if (coefficients != nullptr &&
+        !coefficients->matches(nx, ny, fitting_model, boundary_type)) {
+      coefficients.reset();
     }
+
+    dispatch_window_size(nx, ny, [&](auto window_size) {
+      using Frame = detail::math::Frame2D<decltype(window_size)::value>;
+      detail::dispatch(
+          [&](const size_t start, const size_t end) {
+            auto frame = Frame(nx, ny);
+            auto interpolator = Interpolator(frame, fitting_model);
+            auto i0 = int64_t(0);
+            auto j0 = int64_t(0);
+            auto t = 0.0;
+            auto u = 0.0;
+            auto width = 0.0;
+            auto height = 0.0;
+
+            for (size_t ix = start; ix < end; ++ix) {
+              auto xi = _x(ix);
+              auto yi = _y(ix);
+
+              // The derivatives of the polynomial of the cell are computed with
+              // respect to the normalized position of the point in the cell.
+              if (coefficients != nullptr &&
+                  cell_position(x_axis, xi, i0, t, width) &&
+                  cell_position(y_axis, yi, j0, u, height)) {
+                _result(ix) = detail::math::BicubicCoefficients::gradient(
+                    coefficients->cell(i0, j0, 0), t, u, _dx(ix), _dy(ix));
+                _dx(ix) /= width;
+                _dy(ix) /= height;
+                if (!bounds_error || !std::isnan(_result(ix))) {
+                  continue;
+                }
+              }
+
+              if (load_frame(grid, xi, yi, boundary_type, bounds_error,
+                             frame)) {
+                if (frame.is_updated()) {
+                  interpolator.fit(frame);
+                }
+                _result(ix) = interpolator.gradient(
+                    is_angle ? frame.normalize_angle(xi) : xi, yi, _dx(ix),
+                    _dy(ix));
+              } else {
+                _result(ix) = _dx(ix) = _dy(ix) =
+                    std::numeric_limits<double>::quiet_NaN();
+              }
+            }
+          },
+          size, num_threads, detail::kDynamic);
+    });
   }
-  return result;
+  return py::make_tuple(result, dx, dy);
+}
+
+/// Evaluate the interpolation and the partial derivatives of the function
+/// interpolated.
+///
+/// @param fill_holes If set, half-windows (nx, ny) of the LOESS filter
+/// estimating the undefined values of the grid read by the interpolation.
+/// @tparam Grid Grid type, a Grid2D, a PackedGrid2D or a TiledGrid2D
+template <typename DataType, typename Interpolator,
+          typename Grid = Grid2D<DataType>>
+auto bicubic_gradient(
+    const Grid& grid, const py::array& x, const py::array& y, Eigen::Index nx,
+    Eigen::Index ny, const std::string& fitting_model,
+    const std::string& boundary, const bool bounds_error, size_t num_threads,
+    const std::optional<py::array>& out,
+    const std::optional<py::array>& out_dx,
+    const std::optional<py::array>& out_dy,
+    const std::optional<std::pair<uint32_t, uint32_t>>& fill_holes)
+    -> py::tuple {
+  const auto& handle = make_handle(grid);
+  if (fill_holes) {
+    auto filled = fill::LoessFilledGrid(handle, fill_holes->first,
+                                        fill_holes->second);
+    return _bicubic_gradient<DataType, Interpolator>(
+        filled, x, y, nx, ny, fitting_model, boundary, bounds_error,
+        num_threads, out, out_dx, out_dy);
+  }
+  return _bicubic_gradient<DataType, Interpolator>(
+      handle, x, y, nx, ny, fitting_model, boundary, bounds_error, num_threads,
+      out, out_dx, out_dy);
 }
 
 /// Evaluate the interpolation.
-template <typename DataType, typename AxisType, typename Interpolator>
-auto bicubic_3d(const Grid3D<DataType, AxisType>& grid,
-                const py::array_t<double>& x, const py::array_t<double>& y,
+///
+/// @tparam Grid Grid type, either a Grid3D or a ChunkedGrid3D
+template <typename DataType, typename AxisType, typename Interpolator,
+          typename Grid = Grid3D<DataType, AxisType>>
+auto bicubic_3d(const Grid& grid, const py::array& x, const py::array& y,
                 const py::array_t<AxisType>& z, Eigen::Index nx,
                 Eigen::Index ny, const std::string& fitting_model,
                 const std::string& boundary, const bool bounds_error,
-                size_t num_threads) -> py::array_t<double> {
-  detail::check_array_ndim("x", 1, x, "y", 1, y, "z", 1, z);
-  detail::check_ndarray_shape("x", x, "y", y, "z", z);
+                size_t num_threads, const std::optional<py::array>& out)
+    -> py::array_t<double> {
   auto boundary_type = parse_axis_boundary(boundary);
 
   auto size = x.size();
-  auto result = py::array_t<double>(py::array::ShapeContainer{size});
+  auto result = detail::numpy::output_array<double>("out", out, {size});
 
-  auto _x = x.template unchecked<1>();
-  auto _y = y.template unchecked<1>();
-  auto _z = z.template unchecked<1>();
+  auto _x = detail::numpy::ArrayReader<double>(x);
+  auto _y = detail::numpy::ArrayReader<double>(y);
   auto _result = result.template mutable_unchecked<1>();
+  const auto& handle = make_handle(grid);
   {
     py::gil_scoped_release release;
 
-    // Captures the detected exceptions in the calculation function
-    // (only the last exception captured is kept)
-    auto except = std::exception_ptr(nullptr);
+    // The dimensions and the shapes are read from the array structures.
+    detail::check_array_ndim("x", 1, x, "y", 1, y, "z", 1, z);
+    detail::check_ndarray_shape("x", x, "y", y, "z", z);
+    auto _z = z.template unchecked<1>();
 
-    // Access to the shared pointer outside the loop to avoid data races
-    const auto is_angle = grid.x()->is_angle();
+    const auto is_angle = handle.x()->is_angle();
+    const auto& x_axis = *handle.x();
+    const auto& y_axis = *handle.y();
+    const auto& z_axis = *handle.z();
 
-    detail::dispatch(
-        [&](const size_t start, const size_t end) {
-          try {
-            auto frame = detail::math::Frame3D<AxisType>(nx, ny, 1);
-            auto interpolator =
-                Interpolator(detail::math::Frame2D(nx, ny), fitting_model);
+    // Coefficients precomputed for the grid, used only if they were fitted
+    // with the parameters of this interpolation.
+    auto coefficients = handle.bicubic_coefficients();
+    if (coefficients != nullptr &&
+        !coefficients->matches(nx, ny, fitting_model, boundary_type)) {
+      coefficients.reset();
+    }
+
+    dispatch_window_size(nx, ny, [&](auto window_size) {
+      constexpr auto kSize = decltype(window_size)::value;
+      using Frame = detail::math::Frame3D<AxisType, kSize>;
+      using Layer = detail::math::Frame2D<kSize>;
+      detail::dispatch(
+          [&](const size_t start, const size_t end) {
+            auto&& values = make_accessor(handle);
+            auto frame = Frame(nx, ny, 1);
+            // One interpolator per layer of the frame, so that their
+            // coefficients can be reused as long as the points fall in the
+            // same cell.
+            auto layer = Layer(nx, ny);
+            auto interpolators =
+                std::array<Interpolator, 2>{Interpolator(layer, fitting_model),
+                                            Interpolator(layer, fitting_model)};
+            auto i0 = int64_t(0);
+            auto j0 = int64_t(0);
+            auto t = 0.0;
+            auto u = 0.0;
 
             for (size_t ix = start; ix < end; ++ix) {
               auto xi = _x(ix);
               auto yi = _y(ix);
               auto zi = _z(ix);
 
+              if (coefficients != nullptr &&
+                  cell_position(x_axis, xi, i0, t) &&
+                  cell_position(y_axis, yi, j0, u)) {
+                auto z_indexes = z_axis.find_indexes(zi);
+                if (z_indexes) {
+                  auto [k0, k1] = *z_indexes;
+                  _result(ix) = detail::math::linear<AxisType, double>(
+                      zi, z_axis(k0), z_axis(k1),
+                      detail::math::BicubicCoefficients::evaluate(
+                          coefficients->cell(i0, j0, k0), t, u),
+                      detail::math::BicubicCoefficients::evaluate(
+                          coefficients->cell(i0, j0, k1), t, u));
+                  // The cells that could not be fitted are undefined, unless
+                  // the error raised by the frame must be reported.
+                  if (!bounds_error || !std::isnan(_result(ix))) {
+                    continue;
+                  }
+                }
+              }
+
               if (load_frame<DataType, AxisType>(
-                      grid, xi, yi, zi, boundary_type, bounds_error, frame)) {
+                      values, xi, yi, zi, boundary_type, bounds_error, frame)) {
+                if (frame.is_updated()) {
+                  interpolators[0].fit(frame.frame_2d(0));
+                  interpolators[1].fit(frame.frame_2d(1));
+                }
                 xi = is_angle ? frame.normalize_angle(xi) : xi;
-                auto z0 = interpolator.interpolate(xi, yi, frame.frame_2d(0));
-                auto z1 = interpolator.interpolate(xi, yi, frame.frame_2d(1));
+                auto z0 = interpolators[0].interpolate(xi, yi);
+                auto z1 = interpolators[1].interpolate(xi, yi);
                 _result(ix) = detail::math::linear<AxisType, double>(
                     zi, frame.z(0), frame.z(1), z0, z1);
               } else {
                 _result(ix) = std::numeric_limits<double>::quiet_NaN();
               }
             }
-          } catch (...) {
-            except = std::current_exception();
-          }
-        },
-        size, num_threads);
-
-    if (except != nullptr) {
-      std::rethrow_exception(except);
-    }
+          },
+          size, num_threads, detail::kDynamic);
+    });
   }
   return result;
 }
 
 /// Evaluate the interpolation.
-template <typename DataType, typename AxisType, typename Interpolator>
-auto bicubic_4d(const Grid4D<DataType, AxisType>& grid,
-                const py::array_t<double>& x, const py::array_t<double>& y,
-                const py::array_t<AxisType>& z, const py::array_t<double>& u,
+///
+/// @tparam Grid Grid type, either a Grid4D or a ChunkedGrid4D
+template <typename DataType, typename AxisType, typename Interpolator,
+          typename Grid = Grid4D<DataType, AxisType>>
+auto bicubic_4d(const Grid& grid, const py::array& x, const py::array& y,
+                const py::array_t<AxisType>& z, const py::array& u,
                 Eigen::Index nx, Eigen::Index ny,
                 const std::string& fitting_model, const std::string& boundary,
-                const bool bounds_error, size_t num_threads)
-    -> py::array_t<double> {
-  detail::check_array_ndim("x", 1, x, "y", 1, y, "z", 1, z, "u", 1, u);
-  detail::check_ndarray_shape("x", x, "y", y, "z", z, "u", u);
+                const bool bounds_error, size_t num_threads,
+                const std::optional<py::array>& out) -> py::array_t<double> {
   auto boundary_type = parse_axis_boundary(boundary);
 
   auto size = x.size();
-  auto result = py::array_t<double>(py::array::ShapeContainer{size});
+  auto result = detail::numpy::output_array<double>("out", out, {size});
 
-  auto _x = x.template unchecked<1>();
-  auto _y = y.template unchecked<1>();
-  auto _z = z.template unchecked<1>();
-  auto _u = u.template unchecked<1>();
+  auto _x = detail::numpy::ArrayReader<double>(x);
+  auto _y = detail::numpy::ArrayReader<double>(y);
+  auto _u = detail::numpy::ArrayReader<double>(u);
   auto _result = result.template mutable_unchecked<1>();
+  const auto& handle = make_handle(grid);
   {
     py::gil_scoped_release release;
 
-    // Captures the detected exceptions in the calculation function
-    // (only the last exception captured is kept)
-    auto except = std::exception_ptr(nullptr);
+    // The dimensions and the shapes are read from the array structures.
+    detail::check_array_ndim("x", 1, x, "y", 1, y, "z", 1, z, "u", 1, u);
+    detail::check_ndarray_shape("x", x, "y", y, "z", z, "u", u);
+    auto _z = z.template unchecked<1>();
 
-    // Access to the shared pointer outside the loop to avoid data races
-    const auto is_angle = grid.x()->is_angle();
+    const auto is_angle = handle.x()->is_angle();
 
     detail::dispatch(
         [&](const size_t start, const size_t end) {
-          try {
-            auto frame = detail::math::Frame4D<AxisType>(nx, ny, 1, 1);
-            auto interpolator =
-                Interpolator(detail::math::Frame2D(nx, ny), fitting_model);
+          auto&& values = make_accessor(handle);
+          auto frame = detail::math::Frame4D<AxisType>(nx, ny, 1, 1);
+          // One interpolator per layer of the frame, so that their
+          // coefficients can be reused as long as the points fall in the
+          // same cell.
+          auto layer = detail::math::Frame2D(nx, ny);
+          auto interpolators =
+              std::array<Interpolator, 4>{Interpolator(layer, fitting_model),
+                                          Interpolator(layer, fitting_model),
+                                          Interpolator(layer, fitting_model),
+                                          Interpolator(layer, fitting_model)};
 
-            for (size_t ix = start; ix < end; ++ix) {
-              auto xi = _x(ix);
-              auto yi = _y(ix);
-              auto zi = _z(ix);
-              auto ui = _u(ix);
+          for (size_t ix = start; ix < end; ++ix) {
+            auto xi = _x(ix);
+            auto yi = _y(ix);
+            auto zi = _z(ix);
+            auto ui = _u(ix);
 
-              if (load_frame<DataType, AxisType>(grid, xi, yi, zi, ui,
-                                                 boundary_type, bounds_error,
-                                                 frame)) {
-                xi = is_angle ? frame.normalize_angle(xi) : xi;
-                auto z00 =
-                    interpolator.interpolate(xi, yi, frame.frame_2d(0, 0));
-                auto z10 =
-                    interpolator.interpolate(xi, yi, frame.frame_2d(1, 0));
-                auto z01 =
-                    interpolator.interpolate(xi, yi, frame.frame_2d(0, 1));
-                auto z11 =
-                    interpolator.interpolate(xi, yi, frame.frame_2d(1, 1));
-                _result(ix) = detail::math::linear<double>(
-                    ui, frame.u(0), frame.u(1),
-                    detail::math::linear<AxisType, double>(
-                        zi, frame.z(0), frame.z(1), z00, z10),
-                    detail::math::linear<AxisType, double>(
-                        zi, frame.z(0), frame.z(1), z01, z11));
-              } else {
-                _result(ix) = std::numeric_limits<double>::quiet_NaN();
+            if (load_frame<DataType, AxisType>(values, xi, yi, zi, ui,
+                                               boundary_type, bounds_error,
+                                               frame)) {
+              if (frame.is_updated()) {
+                interpolators[0].fit(frame.frame_2d(0, 0));
+                interpolators[1].fit(frame.frame_2d(1, 0));
+                interpolators[2].fit(frame.frame_2d(0, 1));
+                interpolators[3].fit(frame.frame_2d(1, 1));
               }
+              xi = is_angle ? frame.normalize_angle(xi) : xi;
+              auto z00 = interpolators[0].interpolate(xi, yi);
+              auto z10 = interpolators[1].interpolate(xi, yi);
+              auto z01 = interpolators[2].interpolate(xi, yi);
+              auto z11 = interpolators[3].interpolate(xi, yi);
+              _result(ix) = detail::math::linear<double>(
+                  ui, frame.u(0), frame.u(1),
+                  detail::math::linear<AxisType, double>(
+                      zi, frame.z(0), frame.z(1), z00, z10),
+                  detail::math::linear<AxisType, double>(
+                      zi, frame.z(0), frame.z(1), z01, z11));
+            } else {
+              _result(ix) = std::numeric_limits<double>::quiet_NaN();
             }
-          } catch (...) {
-            except = std::current_exception();
           }
         },
-        size, num_threads);
-
-    if (except != nullptr) {
-      std::rethrow_exception(except);
-    }
+        size, num_threads, detail::kDynamic);
   }
   return result;
 }
 
 }  // namespace pyinterp
 
-template <typename DataType, typename Interpolator>
+template <typename DataType, typename Interpolator,
+          typename Grid = pyinterp::Grid2D<DataType>>
 void implement_bicubic(py::module& m, const std::string& prefix,
                        const std::string& suffix,
                        const std::string& default_fitting_model) {
@@ -250,11 +669,12 @@ void implement_bicubic(py::module& m, const std::string& prefix,
   function_suffix[0] = static_cast<char>(std::tolower(function_suffix[0]));
 
   m.def((function_prefix + "_" + function_suffix).c_str(),
-        &pyinterp::bicubic<DataType, Interpolator>, py::arg("grid"),
+        &pyinterp::bicubic<DataType, Interpolator, Grid>, py::arg("grid"),
         py::arg("x"), py::arg("y"), py::arg("nx") = 3, py::arg("ny") = 3,
         py::arg("fitting_model") = default_fitting_model,
         py::arg("boundary") = "undef", py::arg("bounds_error") = false,
-        py::arg("num_threads") = 0,
+        py::arg("num_threads") = 0, py::arg("out") = py::none(),
+        py::arg("fill_holes") = py::none(),
         (prefix + R"__doc__( gridded 2D interpolation.
 
 Args:
@@ -279,13 +699,73 @@ Args:
         computation. If 0 all CPUs are used. If 1 is given, no parallel
         computing code is used at all, which is useful for debugging.
         Defaults to ``0``.
+    out (numpy.ndarray, optional): C-contiguous array of shape ``(n, )`` and
+        of type float64 in which the interpolated values are written. If
+        None, a new array is allocated. Defaults to ``None``.
+    fill_holes (tuple, optional): Half-windows ``(nx, ny)`` of the LOESS
+        filter estimating the undefined values read by the interpolation,
+        as :py:func:`pyinterp.fill.loess` would fill them. Only the
+        values read are estimated. If None, the undefined values are used
+        as is. Defaults to ``None``.
 Returns:
-    numpy.ndarray: Values interpolated
+    numpy.ndarray: Values interpolated, i.e. ``out`` if provided.
+  )__doc__")
+            .c_str());
+  m.def((function_prefix + "_gradient_" + function_suffix).c_str(),
+        &pyinterp::bicubic_gradient<DataType, Interpolator, Grid>,
+        py::arg("grid"), py::arg("x"), py::arg("y"), py::arg("nx") = 3,
+        py::arg("ny") = 3, py::arg("fitting_model") = default_fitting_model,
+        py::arg("boundary") = "undef", py::arg("bounds_error") = false,
+        py::arg("num_threads") = 0, py::arg("out") = py::none(),
+        py::arg("out_dx") = py::none(), py::arg("out_dy") = py::none(),
+        py::arg("fill_holes") = py::none(),
+        (prefix + R"__doc__( gridded 2D interpolation, computing in the same
+pass the partial derivatives of the function interpolated.
+
+The frame framing each point is loaded and fitted once for the value and its
+two derivatives.
+
+Args:
+    grid (pyinterp.core.Grid2D)__doc__" +
+         suffix +
+         R"__doc__(): Grid containing the values to be interpolated.
+    x (numpy.ndarray): X-values.
+    y (numpy.ndarray): Y-values.
+    nx (int, optional): The number of X coordinate values required to perform
+        the interpolation. Defaults to ``3``.
+    ny (int, optional): The number of Y coordinate values required to perform
+        the interpolation. Defaults to ``3``.
+    fitting_model (str, optional): Type of interpolation to be performed.
+        Defaults to `)__doc__" +
+         default_fitting_model + R"__doc__(`
+    boundary (str, optional): Type of axis boundary management. Defaults to
+        `undef`.
+    bounds_error (bool, optional): If True, when interpolated values are
+        requested outside of the domain of the input axes (x,y), a ValueError
+        is raised. If False, then value is set to NaN.
+    num_threads (int, optional): The number of threads to use for the
+        computation. If 0 all CPUs are used. If 1 is given, no parallel
+        computing code is used at all, which is useful for debugging.
+        Defaults to ``0``.
+    out (numpy.ndarray, optional): C-contiguous array of shape ``(n, )`` and
+        of type float64 in which the interpolated values are written.
+        Defaults to ``None``.
+    out_dx (numpy.ndarray, optional): Array receiving the partial
+        derivatives with respect to x. Defaults to ``None``.
+    out_dy (numpy.ndarray, optional): Array receiving the partial
+        derivatives with respect to y. Defaults to ``None``.
+    fill_holes (tuple, optional): Half-windows ``(nx, ny)`` of the LOESS
+        filter estimating the undefined values read by the interpolation.
+        Defaults to ``None``.
+Returns:
+    tuple: Values interpolated and their partial derivatives with respect to
+    x and y, i.e. ``(out, out_dx, out_dy)`` if provided.
   )__doc__")
             .c_str());
 }
 
-template <typename DataType, typename AxisType, typename Interpolator>
+template <typename DataType, typename AxisType, typename Interpolator,
+          typename Grid = pyinterp::Grid3D<DataType, AxisType>>
 void implement_bicubic_3d(py::module& m, const std::string& prefix,
                           const std::string& suffix,
                           const std::string& grid_prefix,
@@ -297,11 +777,12 @@ void implement_bicubic_3d(py::module& m, const std::string& prefix,
 
   m.def(
       (function_prefix + "_" + function_suffix).c_str(),
-      &pyinterp::bicubic_3d<DataType, AxisType, Interpolator>, py::arg("grid"),
+      &pyinterp::bicubic_3d<DataType, AxisType, Interpolator, Grid>,
+      py::arg("grid"),
       py::arg("x"), py::arg("y"), py::arg("z"), py::arg("nx") = 3,
       py::arg("ny") = 3, py::arg("fitting_model") = default_fitting_model,
       py::arg("boundary") = "undef", py::arg("bounds_error") = false,
-      py::arg("num_threads") = 0,
+      py::arg("num_threads") = 0, py::arg("out") = py::none(),
       (prefix + R"__doc__( gridded 3D interpolation.
 
 A )__doc__" +
@@ -334,10 +815,33 @@ Args:
         computation. If 0 all CPUs are used. If 1 is given, no parallel
         computing code is used at all, which is useful for debugging.
         Defaults to ``0``.
+    out (numpy.ndarray, optional): C-contiguous array of shape ``(n, )`` and
+        of type float64 in which the interpolated values are written. If
+        None, a new array is allocated. Defaults to ``None``.
 Returns:
-    numpy.ndarray: Values interpolated.
+    numpy.ndarray: Values interpolated, i.e. ``out`` if provided.
   )__doc__")
           .c_str());
+  // The grids read by chunks hold unpacked values only.
+  if constexpr (std::is_same_v<Grid, pyinterp::Grid3D<DataType, AxisType>>) {
+    m.def((function_prefix + "_" + function_suffix).c_str(),
+          &pyinterp::bicubic_3d<DataType, AxisType, Interpolator,
+                                pyinterp::ChunkedGrid3D<DataType, AxisType>>,
+          py::arg("grid"), py::arg("x"), py::arg("y"), py::arg("z"),
+          py::arg("nx") = 3, py::arg("ny") = 3,
+          py::arg("fitting_model") = default_fitting_model,
+          py::arg("boundary") = "undef", py::arg("bounds_error") = false,
+          py::arg("num_threads") = 0, py::arg("out") = py::none(),
+          (prefix + R"__doc__( gridded 3D interpolation of a grid whose
+values are read by chunks. Only the chunks framing the points are read.
+
+Args:
+    grid (pyinterp.core.)__doc__" +
+           grid_prefix + "ChunkedGrid3D" + suffix +
+           R"__doc__(): Grid containing the values to be interpolated.
+)__doc__")
+              .c_str());
+  }
 }
 
 template <typename DataType, typename AxisType, typename Interpolator>
@@ -356,7 +860,7 @@ void implement_bicubic_4d(py::module& m, const std::string& prefix,
       py::arg("x"), py::arg("y"), py::arg("z"), py::arg("u"), py::arg("nx") = 3,
       py::arg("ny") = 3, py::arg("fitting_model") = default_fitting_model,
       py::arg("boundary") = "undef", py::arg("bounds_error") = false,
-      py::arg("num_threads") = 0,
+      py::arg("num_threads") = 0, py::arg("out") = py::none(),
       (prefix + R"__doc__( gridded 4D interpolation
 
 A )__doc__" +
@@ -390,10 +894,112 @@ Args:
         computation. If 0 all CPUs are used. If 1 is given, no parallel
         computing code is used at all, which is useful for debugging.
         Defaults to ``0``.
+    out (numpy.ndarray, optional): C-contiguous array of shape ``(n, )`` and
+        of type float64 in which the interpolated values are written. If
+        None, a new array is allocated. Defaults to ``None``.
 Returns:
-    numpy.ndarray: Values interpolated.
+    numpy.ndarray: Values interpolated, i.e. ``out`` if provided.
   )__doc__")
           .c_str());
+  m.def((function_prefix + "_" + function_suffix).c_str(),
+        &pyinterp::bicubic_4d<DataType, AxisType, Interpolator,
+                              pyinterp::ChunkedGrid4D<DataType, AxisType>>,
+        py::arg("grid"), py::arg("x"), py::arg("y"), py::arg("z"),
+        py::arg("u"), py::arg("nx") = 3, py::arg("ny") = 3,
+        py::arg("fitting_model") = default_fitting_model,
+        py::arg("boundary") = "undef", py::arg("bounds_error") = false,
+        py::arg("num_threads") = 0, py::arg("out") = py::none(),
+        (prefix + R"__doc__( gridded 4D interpolation of a grid whose values are
+read by chunks. Only the chunks framing the points are read.
+
+Args:
+    grid (pyinterp.core.)__doc__" +
+         grid_prefix + "ChunkedGrid4D" + suffix +
+         R"__doc__(): Grid containing the values to be interpolated.
+)__doc__")
+            .c_str());
+}
+
+template <typename DataType, typename Interpolator>
+void implement_precompute(py::module& m, const std::string& prefix,
+                          const std::string& suffix,
+                          const std::string& default_fitting_model) {
+  auto function_prefix = prefix;
+  auto function_suffix = suffix;
+  function_prefix[0] = static_cast<char>(std::tolower(function_prefix[0]));
+  function_suffix[0] = static_cast<char>(std::tolower(function_suffix[0]));
+
+  auto name = "precompute_" + function_prefix + "_" + function_suffix;
+  auto doc = R"__doc__(
+Precomputes the coefficients of the polynomials interpolating each cell of the
+grid, and keeps them in the grid.
+
+The following )__doc__" +
+             function_prefix +
+             R"__doc__( interpolations of this grid performed with the same
+parameters only evaluate the polynomial of the cell containing each point. The
+memory used is 128 bytes per grid point. The coefficients must be computed
+again if the values of the grid are modified.
+
+Args:
+    grid: Grid containing the values to be interpolated.
+    nx (int, optional): The number of X coordinate values required to perform
+        the interpolation. Defaults to ``3``.
+    ny (int, optional): The number of Y coordinate values required to perform
+        the interpolation. Defaults to ``3``.
+    fitting_model (str, optional): Type of interpolation to be performed.
+        Defaults to `)__doc__" +
+             default_fitting_model + R"__doc__(`
+    boundary (str, optional): Type of axis boundary management. Defaults to
+        `undef`.
+    num_threads (int, optional): The number of threads to use for the
+        computation. If 0 all CPUs are used. If 1 is given, no parallel
+        computing code is used at all, which is useful for debugging.
+        Defaults to ``0``.
+)__doc__";
+
+  m.def(name.c_str(), &pyinterp::precompute_bicubic<DataType, Interpolator>,
+        py::arg("grid"), py::arg("nx") = 3, py::arg("ny") = 3,
+        py::arg("fitting_model") = default_fitting_model,
+        py::arg("boundary") = "undef", py::arg("num_threads") = 0,
+        doc.c_str());
+  m.def(name.c_str(),
+        &pyinterp::precompute_bicubic_3d<DataType, double, Interpolator>,
+        py::arg("grid"), py::arg("nx") = 3, py::arg("ny") = 3,
+        py::arg("fitting_model") = default_fitting_model,
+        py::arg("boundary") = "undef", py::arg("num_threads") = 0,
+        doc.c_str());
+  m.def(name.c_str(),
+        &pyinterp::precompute_bicubic_3d<DataType, int64_t, Interpolator>,
+        py::arg("grid"), py::arg("nx") = 3, py::arg("ny") = 3,
+        py::arg("fitting_model") = default_fitting_model,
+        py::arg("boundary") = "undef", py::arg("num_threads") = 0,
+        doc.c_str());
+}
+
+/// Interpolations of the grids whose values are packed.
+template <typename Storage, typename Codec>
+void implement_packed_bicubic(py::module& m, const std::string& suffix) {
+  using Bicubic = pyinterp::detail::math::Bicubic;
+  using Spline2D = pyinterp::detail::math::Spline2D;
+
+  implement_bicubic<Storage, Bicubic, pyinterp::PackedGrid2D<Codec>>(
+      m, "Bicubic", suffix, "bicubic");
+  implement_bicubic_3d<Storage, double, Bicubic,
+                       pyinterp::PackedGrid3D<Codec, double>>(
+      m, "Bicubic", suffix, "", "bicubic");
+  implement_bicubic_3d<Storage, int64_t, Bicubic,
+                       pyinterp::PackedGrid3D<Codec, int64_t>>(
+      m, "Bicubic", suffix, "Temporal", "bicubic");
+
+  implement_bicubic<Storage, Spline2D, pyinterp::PackedGrid2D<Codec>>(
+      m, "Spline", suffix, "c_spline");
+  implement_bicubic_3d<Storage, double, Spline2D,
+                       pyinterp::PackedGrid3D<Codec, double>>(
+      m, "Spline", suffix, "", "c_spline");
+  implement_bicubic_3d<Storage, int64_t, Spline2D,
+                       pyinterp::PackedGrid3D<Codec, int64_t>>(
+      m, "Spline", suffix, "Temporal", "c_spline");
 }
 
 void init_bicubic(py::module& m) {
@@ -446,4 +1052,29 @@ void init_bicubic(py::module& m) {
       m, "Spline", "Float32", "", "c_spline");
   implement_bicubic_4d<float, int64_t, pyinterp::detail::math::Spline2D>(
       m, "Spline", "Float32", "Temporal", "c_spline");
+
+  implement_packed_bicubic<int16_t, pyinterp::ScaledInt16>(m, "Int16");
+  implement_packed_bicubic<uint16_t, pyinterp::Float16>(m, "Float16");
+
+  implement_bicubic<double, pyinterp::detail::math::Bicubic,
+                    pyinterp::TiledGrid2D<double>>(m, "Bicubic", "Float64",
+                                                   "bicubic");
+  implement_bicubic<float, pyinterp::detail::math::Bicubic,
+                    pyinterp::TiledGrid2D<float>>(m, "Bicubic", "Float32",
+                                                  "bicubic");
+  implement_bicubic<double, pyinterp::detail::math::Spline2D,
+                    pyinterp::TiledGrid2D<double>>(m, "Spline", "Float64",
+                                                   "c_spline");
+  implement_bicubic<float, pyinterp::detail::math::Spline2D,
+                    pyinterp::TiledGrid2D<float>>(m, "Spline", "Float32",
+                                                  "c_spline");
+
+  implement_precompute<double, pyinterp::detail::math::Bicubic>(
+      m, "Bicubic", "Float64", "bicubic");
+  implement_precompute<float, pyinterp::detail::math::Bicubic>(
+      m, "Bicubic", "Float32", "bicubic");
+  implement_precompute<double, pyinterp::detail::math::Spline2D>(
+      m, "Spline", "Float64", "c_spline");
+  implement_precompute<float, pyinterp::detail::math::Spline2D>(
+      m, "Spline", "Float32", "c_spline");
 }
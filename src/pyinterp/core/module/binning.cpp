@@ -10,21 +10,30 @@
 
 namespace py = pybind11;
 
-template <typename Type>
+using StatisticsLevel = pyinterp::detail::math::StatisticsLevel;
+
+template <typename Type, StatisticsLevel Level = StatisticsLevel::kFull>
 void implement_binning_2d(py::module& m, const std::string& suffix) {
-  PYBIND11_NUMPY_DTYPE(pyinterp::detail::math::Accumulators<Type>, count,
-                       sum_of_weights, mean, min, max, sum, mom2, mom3, mom4);
+  using Binning2D = pyinterp::Binning2D<Type, Level>;
+
+  // The matrices of accumulators of the previous pickle format.
+  if constexpr (Level == StatisticsLevel::kFull) {
+    PYBIND11_NUMPY_DTYPE(pyinterp::detail::math::Accumulators<Type>, count,
+                         sum_of_weights, mean, min, max, sum, mom2, mom3,
+                         mom4);
+  }
 
-  py::class_<pyinterp::Binning2D<Type>>(m, ("Binning2D" + suffix).c_str(),
-                                        R"__doc__(
+  py::class_<Binning2D>(m, ("Binning2D" + suffix).c_str(),
+                        R"__doc__(
 Group a number of more or less continuous values into a smaller number of
 "bins" located on a grid.
 )__doc__")
       .def(py::init<std::shared_ptr<pyinterp::Axis<double>>,
                     std::shared_ptr<pyinterp::Axis<double>>,
-                    std::optional<pyinterp::geodetic::System>>(),
+                    std::optional<pyinterp::geodetic::System>, const bool>(),
            py::arg("x"), py::arg("y"),
            py::arg("wgs") = std::optional<pyinterp::geodetic::System>(),
+           py::arg("sparse") = false,
            R"__doc__(
 Default constructor
 
@@ -38,9 +47,12 @@ Args:
         set, the handled coordinates will be considered as Cartesian
         coordinates. Otherwise, ``x`` and ``y`` are considered to represents
         the longitudes and latitudes.
+    sparse (bool, optional): If true, only the bins holding values are
+        stored, which saves memory when most of the bins of the grid stay
+        empty. Defaults to ``False``.
 )__doc__")
       .def_property_readonly(
-          "x", [](const pyinterp::Binning2D<Type>& self) { return self.x(); },
+          "x", [](const Binning2D& self) { return self.x(); },
           R"__doc__(
 Gets the bin centers for the X Axis of the grid.
 
@@ -48,7 +60,7 @@ Returns:
     pyinterp.core.Axis: X-Axis.
 )__doc__")
       .def_property_readonly(
-          "y", [](const pyinterp::Binning2D<Type>& self) { return self.y(); },
+          "y", [](const Binning2D& self) { return self.y(); },
           R"__doc__(
 Gets the bin centers for the Y Axis of the grid.
 
@@ -57,51 +69,61 @@ Returns:
 )__doc__")
       .def_property_readonly(
           "wgs",
-          [](const pyinterp::Binning2D<Type>& self) { return self.wgs(); },
+          [](const Binning2D& self) { return self.wgs(); },
           R"__doc__(
 Gets the WGS system handled by this instance.
 
 Returns:
     pyinterp.core.geodetic.System: Geodetic system.
 )__doc__")
-      .def("clear", &pyinterp::Binning2D<Type>::clear, "Reset the statistics")
-      .def("count", &pyinterp::Binning2D<Type>::count,
+      .def_property_readonly(
+          "sparse",
+          [](const Binning2D& self) { return self.sparse(); },
+          R"__doc__(
+True if only the bins holding values are stored.
+
+Returns:
+    bool: Storage mode of the bins.
+)__doc__")
+      .def("clear", &Binning2D::clear, "Reset the statistics")
+      .def("count", &Binning2D::count,
            R"__doc__(
 Compute the count of points within each bin.
 
 Returns:
     numpy.ndarray: count of points within each bin.
 )__doc__")
-      .def("kurtosis", &pyinterp::Binning2D<Type>::kurtosis,
+      .def("kurtosis", &Binning2D::kurtosis,
            R"__doc__(
 Compute the kurtosis of values for points within each bin.
 
 Returns:
     numpy.ndarray: kurtosis of values for points within each bin.
 )__doc__")
-      .def("max", &pyinterp::Binning2D<Type>::max,
+      .def("max", &Binning2D::max,
            R"__doc__(
 Compute the maximum of values for points within each bin.
 
 Returns:
     numpy.ndarray: maximum of values for points within each bin.
 )__doc__")
-      .def("mean", &pyinterp::Binning2D<Type>::mean,
+      .def("mean", &Binning2D::mean,
            R"__doc__(
 Compute the mean of values for points within each bin.
 
 Returns:
     numpy.ndarray: mean of values for points within each bin.
 )__doc__")
-      .def("min", &pyinterp::Binning2D<Type>::min,
+      .def("min", &Binning2D::min,
            R"__doc__(
 Compute the minimum of values for points within each bin.
 
 Returns:
     numpy.ndarray: minimum of values for points within each bin.
 )__doc__")
-      .def("push", &pyinterp::Binning2D<Type>::push, py::arg("x"), py::arg("y"),
-           py::arg("z"), py::arg("simple") = true, R"__doc__(
+      .def("push", &Binning2D::push, py::arg("x"), py::arg("y"),
+           py::arg("z"), py::arg("simple") = true, py::arg("num_threads") = 0,
+           R"__doc__(
 Push new samples into the defined bins.
 
 Args:
@@ -110,29 +132,62 @@ Args:
     z (numpy.ndarray): New samples to push.
     simple (bool, optional):  If true, a simple binning 2D is used
     otherwise a linear binning 2d is applied.
+    num_threads (int, optional): The number of threads to use for the
+        computation. If 0 all CPUs are used. If 1 is given, no parallel
+        computing code is used at all, which is useful for debugging.
+        Defaults to ``0``.
 )__doc__")
-      .def("sum", &pyinterp::Binning2D<Type>::sum,
+      .def("push_kernel", &Binning2D::push_kernel, py::arg("x"), py::arg("y"),
+           py::arg("z"),
+           py::arg("wf") = pyinterp::detail::math::window::Function::kGaussian,
+           py::arg("radius") = 1, py::arg("arg") = 0,
+           py::arg("num_threads") = 0,
+           R"__doc__(
+Push new samples into the defined bins, spreading each sample over the bins
+surrounding its nearest bin.
+
+The weight given to a bin is the product of the window function evaluated for
+the distances, expressed in numbers of bins, between the sample and the bin
+along each axis. The window radius is ``radius + 0.5`` bins.
+
+Args:
+    x (numpy.ndarray): X coordinates of the values to push.
+    y (numpy.ndarray): Y coordinates of the values to push.
+    z (numpy.ndarray): New samples to push.
+    wf (pyinterp.core.WindowFunction, optional): The window function used
+        to weight the bins. Defaults to
+        :py:attr:`pyinterp.core.WindowFunction.Gaussian`.
+    radius (int, optional): The number of bins covered on each side of the
+        nearest bin. Defaults to ``1``.
+    arg (float, optional): The optional argument of the window function.
+        Defaults to ``0``.
+    num_threads (int, optional): The number of threads to use for the
+        computation. If 0 all CPUs are used. If 1 is given, no parallel
+        computing code is used at all, which is useful for debugging.
+        Defaults to ``0``.
+)__doc__")
+      .def("sum", &Binning2D::sum,
            R"__doc__(
 Compute the sum of values for points within each bin.
 
 Returns:
     numpy.ndarray: sum of values for points within each bin.
 )__doc__")
-      .def("sum_of_weights", &pyinterp::Binning2D<Type>::sum_of_weights,
+      .def("sum_of_weights", &Binning2D::sum_of_weights,
            R"__doc__(
 Compute the sum of weights for points within each bin.
 
 Returns:
     numpy.ndarray: sum of weights for points within each bin.
 )__doc__")
-      .def("skewness", &pyinterp::Binning2D<Type>::skewness,
+      .def("skewness", &Binning2D::skewness,
            R"__doc__(
 Compute the skewness of values for points within each bin.
 
 Returns:
     numpy.ndarray: skewness of values for points within each bin.
 )__doc__")
-      .def("variance", &pyinterp::Binning2D<Type>::variance,
+      .def("variance", &Binning2D::variance,
            py::arg("ddof") = 0,
            R"__doc__(
 Compute the variance of values for points within each bin.
@@ -145,16 +200,218 @@ Args:
 Returns:
     numpy.ndarray: variance of values for points within each bin.
 )__doc__")
-      .def("__iadd__", &pyinterp::Binning2D<Type>::operator+=,
+      .def("__iadd__", &Binning2D::operator+=,
            py::call_guard<py::gil_scoped_release>())
+      .def("merge", &Binning2D::merge, py::arg("state"),
+           R"__doc__(
+Merges the statistics of another instance from its pickled state, without
+creating the instance.
+
+Args:
+    state (tuple): State of the other instance, returned by ``__getstate__``.
+)__doc__")
       .def(py::pickle(
-          [](const pyinterp::Binning2D<Type>& self) { return self.getstate(); },
+          [](const Binning2D& self) { return self.getstate(); },
           [](const py::tuple& state) {
-            return pyinterp::Binning2D<Type>::setstate(state);
+            return Binning2D::setstate(state);
           }));
 }
 
+template <typename Type, typename AxisType>
+void implement_binning_3d(py::module& m, const std::string& prefix,
+                          const std::string& suffix) {
+  using Binning3D = pyinterp::Binning3D<Type, AxisType>;
+
+  py::class_<Binning3D>(m, (prefix + "Binning3D" + suffix).c_str(),
+                        R"__doc__(
+Group a number of more or less continuous values into a smaller number of
+"bins" located on a 3D grid.
+)__doc__")
+      .def(py::init<std::shared_ptr<pyinterp::Axis<double>>,
+                    std::shared_ptr<pyinterp::Axis<double>>,
+                    std::shared_ptr<pyinterp::Axis<AxisType>>,
+                    std::optional<pyinterp::geodetic::System>, const bool>(),
+           py::arg("x"), py::arg("y"), py::arg("z"),
+           py::arg("wgs") = std::optional<pyinterp::geodetic::System>(),
+           py::arg("sparse") = false,
+           R"__doc__(
+Default constructor
+
+Args:
+    x (pyinterp.core.Axis): Definition of the bin centers for the X axis of
+        the grid.
+    y (pyinterp.core.Axis): Definition of the bin centers for the Y axis of
+        the grid.
+    z (pyinterp.core.Axis): Definition of the bin centers for the Z axis of
+        the grid.
+    wgs (pyinterp.geodetic.System, optional): WGS of the coordinate system
+        used to manipulate geographic coordinates. If this parameter is not
+        set, the handled coordinates will be considered as Cartesian
+        coordinates. Otherwise, ``x`` and ``y`` are considered to represents
+        the longitudes and latitudes.
+    sparse (bool, optional): If true, only the bins holding values are
+        stored, which saves memory when most of the bins of the grid stay
+        empty. Defaults to ``False``.
+)__doc__")
+      .def_property_readonly(
+          "x", [](const Binning3D& self) { return self.x(); },
+          R"__doc__(
+Gets the bin centers for the X Axis of the grid.
+
+Returns:
+    pyinterp.core.Axis: X-Axis.
+)__doc__")
+      .def_property_readonly(
+          "y", [](const Binning3D& self) { return self.y(); },
+          R"__doc__(
+Gets the bin centers for the Y Axis of the grid.
+
+Returns:
+    pyinterp.core.Axis: Y-Axis.
+)__doc__")
+      .def_property_readonly(
+          "z", [](const Binning3D& self) { return self.z(); },
+          R"__doc__(
+Gets the bin centers for the Z Axis of the grid.
+
+Returns:
+    pyinterp.core.Axis: Z-Axis.
+)__doc__")
+      .def_property_readonly(
+          "wgs", [](const Binning3D& self) { return self.wgs(); },
+          R"__doc__(
+Gets the WGS system handled by this instance.
+
+Returns:
+    pyinterp.core.geodetic.System: Geodetic system.
+)__doc__")
+      .def_property_readonly(
+          "sparse", [](const Binning3D& self) { return self.sparse(); },
+          R"__doc__(
+True if only the bins holding values are stored.
+
+Returns:
+    bool: Storage mode of the bins.
+)__doc__")
+      .def("clear", &Binning3D::clear, "Reset the statistics")
+      .def("count", &Binning3D::count,
+           R"__doc__(
+Compute the count of points within each bin.
+
+Returns:
+    numpy.ndarray: count of points within each bin.
+)__doc__")
+      .def("kurtosis", &Binning3D::kurtosis,
+           R"__doc__(
+Compute the kurtosis of values for points within each bin.
+
+Returns:
+    numpy.ndarray: kurtosis of values for points within each bin.
+)__doc__")
+      .def("max", &Binning3D::max,
+           R"__doc__(
+Compute the maximum of values for points within each bin.
+
+Returns:
+    numpy.ndarray: maximum of values for points within each bin.
+)__doc__")
+      .def("mean", &Binning3D::mean,
+           R"__doc__(
+Compute the mean of values for points within each bin.
+
+Returns:
+    numpy.ndarray: mean of values for points within each bin.
+)__doc__")
+      .def("min", &Binning3D::min,
+           R"__doc__(
+Compute the minimum of values for points within each bin.
+
+Returns:
+    numpy.ndarray: minimum of values for points within each bin.
+)__doc__")
+      .def("push", &Binning3D::push, py::arg("x"), py::arg("y"), py::arg("z"),
+           py::arg("values"), py::arg("simple") = true,
+           py::arg("num_threads") = 0,
+           R"__doc__(
+Push new samples into the defined bins.
+
+The samples are spread over the X and Y axes and binned in the nearest bin of
+the Z axis.
+
+Args:
+    x (numpy.ndarray): X coordinates of the values to push.
+    y (numpy.ndarray): Y coordinates of the values to push.
+    z (numpy.ndarray): Z coordinates of the values to push.
+    values (numpy.ndarray): New samples to push.
+    simple (bool, optional):  If true, a simple binning 2D is used
+    otherwise a linear binning 2d is applied.
+    num_threads (int, optional): The number of threads to use for the
+        computation. If 0 all CPUs are used. If 1 is given, no parallel
+        computing code is used at all, which is useful for debugging.
+        Defaults to ``0``.
+)__doc__")
+      .def("sum", &Binning3D::sum,
+           R"__doc__(
+Compute the sum of values for points within each bin.
+
+Returns:
+    numpy.ndarray: sum of values for points within each bin.
+)__doc__")
+      .def("sum_of_weights", &Binning3D::sum_of_weights,
+           R"__doc__(
+Compute the sum of weights for points within each bin.
+
+Returns:
+    numpy.ndarray: sum of weights for points within each bin.
+)__doc__")
+      .def("skewness", &Binning3D::skewness,
+           R"__doc__(
+Compute the skewness of values for points within each bin.
+
+Returns:
+    numpy.ndarray: skewness of values for points within each bin.
+)__doc__")
+      .def("variance", &Binning3D::variance, py::arg("ddof") = 0,
+           R"__doc__(
+Compute the variance of values for points within each bin.
+
+Args:
+    ddof (int, optional): Means Delta Degrees of Freedom. The divisor used in
+        calculations is N - ddof, where N represents the number of elements.
+        By default ddof is zero.
+
+Returns:
+    numpy.ndarray: variance of values for points within each bin.
+)__doc__")
+      .def("__iadd__", &Binning3D::operator+=,
+           py::call_guard<py::gil_scoped_release>())
+      .def("merge", &Binning3D::merge, py::arg("state"),
+           R"__doc__(
+Merges the statistics of another instance from its pickled state, without
+creating the instance.
+
+Args:
+    state (tuple): State of the other instance, returned by ``__getstate__``.
+)__doc__")
+      .def(py::pickle(
+          [](const Binning3D& self) { return self.getstate(); },
+          [](const py::tuple& state) { return Binning3D::setstate(state); }));
+}
+
 void init_binning(py::module& m) {
   implement_binning_2d<double>(m, "Float64");
   implement_binning_2d<float>(m, "Float32");
+  // Grids calculating only some of the statistics, whose bins are smaller.
+  implement_binning_2d<double, StatisticsLevel::kCount>(m, "CountFloat64");
+  implement_binning_2d<float, StatisticsLevel::kCount>(m, "CountFloat32");
+  implement_binning_2d<double, StatisticsLevel::kMean>(m, "MeanFloat64");
+  implement_binning_2d<float, StatisticsLevel::kMean>(m, "MeanFloat32");
+  implement_binning_2d<double, StatisticsLevel::kVariance>(m,
+                                                           "VarianceFloat64");
+  implement_binning_2d<float, StatisticsLevel::kVariance>(m,
+                                                          "VarianceFloat32");
+  implement_binning_3d<double, double>(m, "", "Float64");
+  implement_binning_3d<float, double>(m, "", "Float32");
+  implement_binning_3d<double, int64_t>(m, "Temporal", "Float64");
+  implement_binning_3d<float, int64_t>(m, "Temporal", "Float32");
 }
@@ -6,14 +6,88 @@
 
 #include <pybind11/pybind11.h>
 
+#include "pyinterp/packed_grid.hpp"
+#include "pyinterp/tiled_grid.hpp"
+
 namespace py = pybind11;
 namespace geometry = pyinterp::detail::geometry;
 
+/// Implements the bivariate interpolation of a type of grid, and the
+/// preparation of this interpolation.
+template <typename Coordinate, typename Type,
+          typename Grid = pyinterp::Grid2D<Type>>
+void implement_bivariate(py::module& m,
+                         py::class_<pyinterp::PreparedBivariate>& prepared,
+                         const std::string& suffix) {
+  pyinterp::implement_bivariate<geometry::EquatorialPoint2D, Coordinate, Type,
+                                Grid>(m, suffix);
+  // The grid and the interpolator are referenced by the instance created.
+  prepared.def(
+      py::init(&pyinterp::PreparedBivariate::make<geometry::EquatorialPoint2D,
+                                                   Coordinate, Type, Grid>),
+      py::arg("grid"), py::arg("interpolator"),
+      py::arg("bounds_error") = false, py::arg("num_threads") = 0,
+      py::arg("fill_holes") = py::none(), py::keep_alive<1, 2>(),
+      py::keep_alive<1, 3>());
+}
+
 void init_bivariate(py::module& m) {
-  pyinterp::implement_bivariate<geometry::EquatorialPoint2D, double, double>(
-      m, "Float64");
-  pyinterp::implement_bivariate<geometry::EquatorialPoint2D, double, float>(
-      m, "Float32");
-  pyinterp::implement_bivariate<geometry::EquatorialPoint2D, double, int8_t>(
-      m, "Int8");
+  auto prepared = py::class_<pyinterp::PreparedBivariate>(
+      m, "PreparedBivariate", R"__doc__(
+Bivariate interpolation of a grid prepared once.
+
+The grid, the interpolator and the options of the interpolation are bound
+when the instance is created. Each call then interpolates a set of points
+with a single call to the library, which matters for the small queries.
+
+Args:
+    grid (pyinterp.core.Grid2DFloat64): Grid containing the values to be
+        interpolated, of any type handled by the bivariate interpolation.
+    interpolator (pyinterp.core.BivariateInterpolator2D): 2D interpolator
+        used to interpolate, or an interpolator of float32 values for the
+        single precision interpolation of a float32 grid.
+    bounds_error (bool, optional): If True, when interpolated values are
+        requested outside of the domain of the input axes (x,y), a ValueError
+        is raised. If False, then value is set to NaN.
+    num_threads (int, optional): The number of threads to use for the
+        computation. If 0 all CPUs are used. If 1 is given, no parallel
+        computing code is used at all, which is useful for debugging.
+        Defaults to ``0``.
+    fill_holes (tuple, optional): Half-windows ``(nx, ny)`` of the LOESS
+        filter estimating the undefined values read by the interpolation.
+        Defaults to ``None``.
+)__doc__");
+  prepared.def("__call__", &pyinterp::PreparedBivariate::operator(),
+               py::arg("x"), py::arg("y"), py::arg("out") = py::none(),
+               R"__doc__(
+Interpolate the points (x, y).
+
+Args:
+    x (numpy.ndarray): X-values.
+    y (numpy.ndarray): Y-values.
+    out (numpy.ndarray, optional): C-contiguous array of shape ``(n, )`` in
+        which the interpolated values are written. If None, a new array is
+        allocated. Defaults to ``None``.
+Returns:
+    numpy.ndarray: Values interpolated, i.e. ``out`` if provided.
+)__doc__");
+
+  implement_bivariate<double, double>(m, prepared, "Float64");
+  implement_bivariate<double, float>(m, prepared, "Float32");
+  implement_bivariate<double, int8_t>(m, prepared, "Int8");
+  implement_bivariate<double, int16_t,
+                      pyinterp::PackedGrid2D<pyinterp::ScaledInt16>>(
+      m, prepared, "Int16");
+  implement_bivariate<double, uint16_t,
+                      pyinterp::PackedGrid2D<pyinterp::Float16>>(
+      m, prepared, "Float16");
+  implement_bivariate<double, double, pyinterp::TiledGrid2D<double>>(
+      m, prepared, "Float64");
+  implement_bivariate<double, float, pyinterp::TiledGrid2D<float>>(
+      m, prepared, "Float32");
+  // Float32 grids interpolated in single precision, selected by the
+  // interpolators of float32 values.
+  implement_bivariate<float, float>(m, prepared, "Float32");
+  implement_bivariate<float, float, pyinterp::TiledGrid2D<float>>(
+      m, prepared, "Float32");
 }
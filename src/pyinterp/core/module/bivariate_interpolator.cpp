@@ -12,6 +12,8 @@ namespace geometry = pyinterp::detail::geometry;
 void init_bivariate_interpolator(py::module& m) {
   pyinterp::implement_bivariate_interpolator<geometry::EquatorialPoint2D,
                                              double>(m, "", "2D");
+  pyinterp::implement_bivariate_interpolator<geometry::EquatorialPoint2D,
+                                             float>(m, "", "2DFloat32");
   pyinterp::implement_bivariate_interpolator<geometry::EquatorialPoint3D,
                                              double>(m, "", "3D");
   pyinterp::implement_bivariate_interpolator<geometry::TemporalEquatorial2D,
@@ -11,6 +11,9 @@
 
 #include <iomanip>
 #include <sstream>
+#include <type_traits>
+
+#include "pyinterp/detail/thread.hpp"
 
 namespace py = pybind11;
 namespace dateutils = pyinterp::dateutils;
@@ -29,7 +32,40 @@ static auto fractional_seconds_from_dtype(const pybind11::dtype& dtype)
       pybind11::str(static_cast<pybind11::handle>(dtype))));
 }
 
-static auto date(const py::array& array) -> py::array_t<dateutils::Date> {
+/// Applies a function to the number of days, seconds and the fractional part
+/// elapsed since 1970 of the dates of an array, splitting the work between
+/// threads. The nanosecond and microsecond resolutions, the most common
+/// ones, are decoded by dedicated loops dividing by constants.
+template <typename Function>
+static auto for_each_date(
+    const py::detail::unchecked_reference<int64_t, 1>& dates,
+    const dateutils::FractionalSeconds& frac, const size_t num_threads,
+    const Function& function) -> void {
+  auto loop = [&](const auto& order_of_magnitude) {
+    pyinterp::detail::dispatch(
+        [&](const size_t start, const size_t end) {
+          for (auto ix = start; ix < end; ++ix) {
+            function(ix, dateutils::FractionalSeconds::days_since_epoch(
+                             dates[ix], order_of_magnitude()));
+          }
+        },
+        dates.size(), num_threads);
+  };
+
+  switch (frac.order_of_magnitude()) {
+    case dateutils::kNanosecond:
+      loop(std::integral_constant<int64_t, dateutils::kNanosecond>());
+      break;
+    case dateutils::kMicrosecond:
+      loop(std::integral_constant<int64_t, dateutils::kMicrosecond>());
+      break;
+    default:
+      loop([&]() { return frac.order_of_magnitude(); });
+  }
+}
+
+static auto date(const py::array& array, const size_t num_threads)
+    -> py::array_t<dateutils::Date> {
   auto frac = fractional_seconds_from_dtype(array.dtype());
   auto result =
       py::array_t<dateutils::Date>(py::array::ShapeContainer({array.size()}));
@@ -39,15 +75,16 @@ static auto date(const py::array& array) -> py::array_t<dateutils::Date> {
   {
     auto gil = py::gil_scoped_release();
 
-    for (auto ix = 0; ix < array.size(); ++ix) {
-      _result[ix] = dateutils::date_from_days(
-          std::get<0>(frac.days_since_epoch(_array[ix])));
-    }
+    for_each_date(_array, frac, num_threads,
+                  [&](const size_t ix, const auto& epoch) {
+                    _result[ix] = dateutils::date_from_days(std::get<0>(epoch));
+                  });
   }
   return result;
 }
 
-static auto time(const py::array& array) -> py::array_t<dateutils::Time> {
+static auto time(const py::array& array, const size_t num_threads)
+    -> py::array_t<dateutils::Time> {
   auto frac = fractional_seconds_from_dtype(array.dtype());
   auto result =
       py::array_t<dateutils::Time>(py::array::ShapeContainer({array.size()}));
@@ -57,15 +94,15 @@ static auto time(const py::array& array) -> py::array_t<dateutils::Time> {
   {
     auto gil = py::gil_scoped_release();
 
-    for (auto ix = 0; ix < array.size(); ++ix) {
-      _result[ix] = dateutils::time_from_seconds(
-          std::get<1>(frac.days_since_epoch(_array[ix])));
-    }
+    for_each_date(
+        _array, frac, num_threads, [&](const size_t ix, const auto& epoch) {
+          _result[ix] = dateutils::time_from_seconds(std::get<1>(epoch));
+        });
   }
   return result;
 }
 
-static auto isocalendar(const py::array& array)
+static auto isocalendar(const py::array& array, const size_t num_threads)
     -> py::array_t<dateutils::ISOCalendar> {
   auto frac = fractional_seconds_from_dtype(array.dtype());
   auto result = py::array_t<dateutils::ISOCalendar>(
@@ -76,15 +113,16 @@ static auto isocalendar(const py::array& array)
   {
     auto gil = py::gil_scoped_release();
 
-    for (auto ix = 0; ix < array.size(); ++ix) {
-      _result[ix] = dateutils::isocalendar(
-          std::get<0>(frac.days_since_epoch(_array[ix])));
-    }
+    for_each_date(_array, frac, num_threads,
+                  [&](const size_t ix, const auto& epoch) {
+                    _result[ix] = dateutils::isocalendar(std::get<0>(epoch));
+                  });
   }
   return result;
 }
 
-static auto weekday(const py::array& array) -> py::array_t<unsigned> {
+static auto weekday(const py::array& array, const size_t num_threads)
+    -> py::array_t<unsigned> {
   auto frac = fractional_seconds_from_dtype(array.dtype());
   auto result =
       py::array_t<unsigned>(py::array::ShapeContainer({array.size()}));
@@ -94,15 +132,16 @@ static auto weekday(const py::array& array) -> py::array_t<unsigned> {
   {
     auto gil = py::gil_scoped_release();
 
-    for (auto ix = 0; ix < array.size(); ++ix) {
-      _result[ix] =
-          dateutils::weekday(std::get<0>(frac.days_since_epoch(_array[ix])));
-    }
+    for_each_date(_array, frac, num_threads,
+                  [&](const size_t ix, const auto& epoch) {
+                    _result[ix] = dateutils::weekday(std::get<0>(epoch));
+                  });
   }
   return result;
 }
 
-static auto timedelta_since_january(const py::array& array) -> py::array {
+static auto timedelta_since_january(const py::array& array,
+                                    const size_t num_threads) -> py::array {
   auto frac = fractional_seconds_from_dtype(array.dtype());
   auto result =
       py::array(py::dtype(static_cast<std::string>(dateutils::DType(
@@ -114,16 +153,17 @@ static auto timedelta_since_january(const py::array& array) -> py::array {
   {
     auto gil = py::gil_scoped_release();
 
-    for (auto ix = 0; ix < array.size(); ++ix) {
-      auto [days, seconds, fractional_part] = frac.days_since_epoch(_array[ix]);
-      auto days_since_january =
-          dateutils::days_since_january(dateutils::date_from_days(days));
-      auto hms = dateutils::time_from_seconds(seconds);
-      _result[ix] = (days_since_january * 86400LL + hms.hour * 3600LL +
-                     hms.minute * 60LL + hms.second) *
-                        frac.order_of_magnitude() +
-                    fractional_part;
-    }
+    for_each_date(
+        _array, frac, num_threads, [&](const size_t ix, const auto& epoch) {
+          auto [days, seconds, fractional_part] = epoch;
+          auto days_since_january =
+              dateutils::days_since_january(dateutils::date_from_days(days));
+          auto hms = dateutils::time_from_seconds(seconds);
+          _result[ix] = (days_since_january * 86400LL + hms.hour * 3600LL +
+                         hms.minute * 60LL + hms.second) *
+                            frac.order_of_magnitude() +
+                        fractional_part;
+        });
   }
   return result;
 }
@@ -161,11 +201,16 @@ void init_dateutils(py::module& m) {
   PYBIND11_NUMPY_DTYPE(dateutils::Time, hour, minute, second);
   PYBIND11_NUMPY_DTYPE(dateutils::ISOCalendar, year, week, weekday);
 
-  m.def("date", &detail::date, py::arg("array"), R"__doc__(
+  m.def("date", &detail::date, py::arg("array"), py::arg("num_threads") = 0,
+        R"__doc__(
 Return the date part of the dates.
 
 Args:
     array (numpy.ndarray): Numpy array of datetime64 to process.
+    num_threads (int, optional): The number of threads to use for the
+        computation. If 0 all CPUs are used. If 1 is given, no parallel
+        computing code is used at all, which is useful for debugging.
+        Defaults to ``0``.
 
 Returns:
     numpy.ndarray: A structured numpy array containing three fields: ``year``,
@@ -181,23 +226,32 @@ Returns:
     numpy.ndarray: Object dtype array containing native Python datetime objects.
 )__doc__")
       .def("timedelta_since_january", &detail::timedelta_since_january,
-           py::arg("array"),
+           py::arg("array"), py::arg("num_threads") = 0,
            R"__doc__(
 Return the number the timedelta since the first January.
 
 Args:
     array (numpy.ndarray): Numpy array of datetime64 to process.
+    num_threads (int, optional): The number of threads to use for the
+        computation. If 0 all CPUs are used. If 1 is given, no parallel
+        computing code is used at all, which is useful for debugging.
+        Defaults to ``0``.
 
 Returns:
     numpy.ndarray: timedelta64 dtype array containing the time delta since the
     first January.
 )__doc__")
       .def("isocalendar", &detail::isocalendar, py::arg("array"),
+           py::arg("num_threads") = 0,
            R"__doc__(
 Return the ISO calendar of dates.
 
 Args:
     array (numpy.ndarray): Numpy array of datetime64 to process.
+    num_threads (int, optional): The number of threads to use for the
+        computation. If 0 all CPUs are used. If 1 is given, no parallel
+        computing code is used at all, which is useful for debugging.
+        Defaults to ``0``.
 
 Returns:
     numpy.ndarray: A structured numpy array containing three fields: ``year``,
@@ -205,21 +259,32 @@ Returns:
 
 .. seealso:: datetime.date.isocalendar.
 )__doc__")
-      .def("time", &detail::time, py::arg("array"), R"__doc__(
+      .def("time", &detail::time, py::arg("array"), py::arg("num_threads") = 0,
+           R"__doc__(
 Return the time part of the dates.
 
 Args:
     array (numpy.ndarray): Numpy array of datetime64 to process.
+    num_threads (int, optional): The number of threads to use for the
+        computation. If 0 all CPUs are used. If 1 is given, no parallel
+        computing code is used at all, which is useful for debugging.
+        Defaults to ``0``.
 
 Returns:
     numpy.ndarray: A structured numpy array containing three fields: ``hour``,
     ``minute`` and ``second``.
 )__doc__")
-      .def("weekday", &detail::weekday, py::arg("array"), R"__doc__(
+      .def("weekday", &detail::weekday, py::arg("array"),
+           py::arg("num_threads") = 0,
+           R"__doc__(
 Return the weekday of the dates; Sunday is 0 ... Saturday is 6.
 
 Args:
     array (numpy.ndarray): Numpy array of datetime64 to process.
+    num_threads (int, optional): The number of threads to use for the
+        computation. If 0 all CPUs are used. If 1 is given, no parallel
+        computing code is used at all, which is useful for debugging.
+        Defaults to ``0``.
 
 Returns:
     numpy.ndarray: int dtype array containing weekday of the dates.
@@ -11,17 +11,57 @@
 
 namespace py = pybind11;
 
+template <typename Type, typename AxisType>
+void implement_rolling(py::class_<pyinterp::DescriptiveStatistics<Type>>& cls,
+                       const std::string& prefix, const std::string& suffix) {
+  cls.def_static(
+      "rolling",
+      &pyinterp::DescriptiveStatistics<Type>::template rolling<AxisType>,
+      py::arg("grid"), py::arg("window"), py::arg("center") = false,
+      py::arg("min_periods") = 1, py::arg("num_threads") = 0,
+      (R"__doc__(
+Calculates the statistics of the values of a 3D grid within a window sliding
+along its third axis, for example a time axis.
+
+The values entering and leaving the window update its statistics
+incrementally: the cost does not depend on the size of the window. The
+series of the cells of the grid are processed in parallel.
+
+Args:
+    grid (pyinterp.core.)__doc__" +
+       prefix + "Grid3D" + suffix +
+       R"__doc__(): Grid whose values are processed. NaNs are
+        ignored.
+    window (int): Number of values of the window along the third axis.
+    center (bool, optional): If true, the window is centered on each value,
+        otherwise it ends at each value. Defaults to ``False``.
+    min_periods (int, optional): Minimum number of valid values of a window
+        for its statistics to be defined. Defaults to ``1``.
+    num_threads (int, optional): The number of threads to use for the
+        computation. If 0 all CPUs are used. If 1 is given, no parallel
+        computing code is used at all, which is useful for debugging.
+        Defaults to ``0``.
+
+Returns:
+    DescriptiveStatistics: The statistics of the window of each value of the
+    grid, whose shape is the shape of the grid.
+)__doc__")
+          .c_str());
+}
+
 template <typename Type>
 void implement_descriptive_statistics(py::module& m,
                                       const std::string& suffix) {
-  py::class_<pyinterp::DescriptiveStatistics<Type>>(
+  auto cls = py::class_<pyinterp::DescriptiveStatistics<Type>>(
       m, ("DescriptiveStatistics" + suffix).c_str(),
-      "Univariate descriptive statistics.")
+      "Univariate descriptive statistics.");
+  cls
       .def(py::init<py::array_t<Type, py::array::c_style>&,
                     std::optional<py::array_t<Type, py::array::c_style>>&,
-                    std::optional<std::list<py::ssize_t>>&>(),
+                    std::optional<std::list<py::ssize_t>>&, const size_t>(),
            py::arg("values"), py::arg("weights") = py::none(),
-           py::arg("axis") = py::none(), R"__doc__(
+           py::arg("axis") = py::none(), py::arg("num_threads") = 0,
+           R"__doc__(
 Default constructor
 
 Args:
@@ -32,6 +72,9 @@ Args:
     axes (iterable, optional): Axis or axes along which to compute the
         statistics. If not provided, the statistics are computed over the
         flattened array.
+    num_threads (int, optional): The number of threads to use for the
+        computation. If 0 all CPUs are used. If 1 is given, no parallel computing code is used at all,
+        which is useful for debugging. Defaults to ``0``.
 )__doc__")
       .def("count", &pyinterp::DescriptiveStatistics<Type>::count,
            R"__doc__(
@@ -121,6 +164,8 @@ Returns:
           [](const py::tuple& state) {
             return pyinterp::DescriptiveStatistics<Type>::setstate(state);
           }));
+  implement_rolling<Type, double>(cls, "", suffix);
+  implement_rolling<Type, int64_t>(cls, "Temporal", suffix);
 }
 
 void init_descriptive_statistics(py::module& m) {
@@ -4,19 +4,22 @@
 // BSD-style license that can be found in the LICENSE file.
 #include "pyinterp/fill.hpp"
 
+#include <pybind11/functional.h>
 #include <pybind11/pybind11.h>
 
 #include <cctype>
 
 namespace py = pybind11;
 
-template <typename Type>
-void implement_fill_functions(py::module& m, const std::string& suffix) {
+template <typename Type, typename Grid>
+void implement_loess(py::module& m, const std::string& prefix,
+                     const std::string& suffix) {
   auto function_suffix = suffix;
   function_suffix[0] = static_cast<char>(std::tolower(function_suffix[0]));
 
-  m.def(("loess_" + function_suffix).c_str(), &pyinterp::fill::loess<Type>,
-        py::arg("grid"), py::arg("nx") = 3, py::arg("ny") = 3,
+  m.def(("loess_" + function_suffix).c_str(),
+        &pyinterp::fill::loess_2d<Type, Grid>, py::arg("grid"),
+        py::arg("nx") = 3, py::arg("ny") = 3,
         py::arg("value_type") = pyinterp::fill::kUndefined,
         py::arg("num_threads") = 0,
         (R"__doc__(
@@ -25,8 +28,8 @@ LOESS. The weight function used for LOESS is the tri-cube weight function,
 :math:`w(x)=(1-|d|^3)^3`.
 
 Args:
-    grid (pyinterp.core.Grid2D)__doc__" +
-         suffix +
+    grid (pyinterp.core.)__doc__" +
+         prefix + "Grid2D" + suffix +
          R"__doc__() : Grid function on a uniform 2-dimensional grid to be
         filled.
     nx (int, optional): Number of points of the half-window to be taken into
@@ -45,13 +48,23 @@ Returns:
     values.
 )__doc__")
             .c_str());
+}
+
+template <typename Type>
+void implement_fill_functions(py::module& m, const std::string& suffix) {
+  auto function_suffix = suffix;
+  function_suffix[0] = static_cast<char>(std::tolower(function_suffix[0]));
+
+  implement_loess<Type, pyinterp::Grid2D<Type>>(m, "", suffix);
 
   m.def(("gauss_seidel_" + function_suffix).c_str(),
         &pyinterp::fill::gauss_seidel<Type>, py::arg("grid"),
         py::arg("first_guess") = pyinterp::fill::kZonalAverage,
         py::arg("is_circle") = true, py::arg("max_iterations") = 2000,
         py::arg("epsilon") = 1e-4, py::arg("relaxation") = 1.0,
-        py::arg("num_thread") = 0,
+        py::arg("ordering") = pyinterp::fill::kLexicographic,
+        py::arg("retire") = false, py::arg("callback") = nullptr,
+        py::arg("callback_interval") = 1, py::arg("num_thread") = 0,
         R"__doc__(
 Replaces all undefined values (NaN) in a grid using the Gauss-Seidel
 method by relaxation.
@@ -66,6 +79,124 @@ Args:
     epsilon (float, optional): Tolerance for ending relaxation before the
         maximum number of iterations limit. Defaults to ``1e-4``.
     relaxation (float, opional): Relaxation constant. Defaults to ``1``.
+    ordering (pyinterp.core.fill.Ordering, optional): Order in which the
+        undefined values are updated. Defaults to ``Lexicographic``.
+    retire (bool, optional): If true, the undefined values whose residual is
+        lower than ``epsilon`` are no longer updated by the next iterations.
+        Once all the values updated have converged, a last iteration over all
+        the undefined values checks the result. Defaults to ``False``.
+    callback (callable, optional): Function called every
+        ``callback_interval`` iterations, and after the last one, with the
+        state of the iterations (:py:class:`pyinterp.core.fill.Iteration`).
+        If it returns ``True``, the iterations are stopped. Defaults to
+        ``None``.
+    callback_interval (int, optional): Number of iterations between two calls
+        of the callback. Defaults to ``1``.
+    num_threads (int, optional): The number of threads to use for the
+        computation. If 0 all CPUs are used. If 1 is given, no parallel
+        computing code is used at all, which is useful for debugging.
+        Defaults to ``0``.
+
+Returns:
+    tuple: the number of iterations performed and the maximum residual value.
+)__doc__",
+        py::call_guard<py::gil_scoped_release>());
+
+  m.def(("gauss_seidel_tile_" + function_suffix).c_str(),
+        &pyinterp::fill::gauss_seidel_tile<Type>, py::arg("tile"),
+        py::arg("exchange"), py::arg("origin"), py::arg("shape"),
+        py::arg("reduce") = nullptr,
+        py::arg("first_guess") = pyinterp::fill::kZonalAverage,
+        py::arg("is_circle") = true, py::arg("max_iterations") = 2000,
+        py::arg("epsilon") = 1e-4, py::arg("relaxation") = 1.0,
+        py::arg("num_thread") = 0,
+        R"__doc__(
+Replaces all undefined values (NaN) in a tile of a grid decomposed into
+tiles using the Gauss-Seidel method by relaxation, with the red-black
+ordering.
+
+Args:
+    tile (numpy.ndarray): Tile to be filled, surrounded by a halo of one
+        pixel along each side.
+    exchange (callable): Function writing the halo of the tile from the
+        neighboring tiles, called after the first guess and after each color
+        of the red-black ordering.
+    origin (tuple): Position of the first pixel of the tile in the grid.
+    shape (tuple): Number of pixels of the grid along the X and Y axes.
+    reduce (callable, optional): Function returning the maximum residual of
+        all the tiles from the maximum residual of this tile. Defaults to
+        ``None``.
+    first_guess (pyinterp.core.fill.FirstGuess, optional): Type of first
+        guess, computed from the pixels of the tile. Defaults to
+        ``ZonalAverage``.
+    is_circle (bool, optional): True if the X axis of the grid defines a
+        circle. Defaults to ``True``.
+    max_iterations (int, optional): Maximum number of iterations to be used by
+        relaxation. Defaults to ``2000``.
+    epsilon (float, optional): Tolerance for ending relaxation before the
+        maximum number of iterations limit. Defaults to ``1e-4``.
+    relaxation (float, opional): Relaxation constant. Defaults to ``1``.
+    num_threads (int, optional): The number of threads to use for the
+        computation. If 0 all CPUs are used. If 1 is given, no parallel
+        computing code is used at all, which is useful for debugging.
+        Defaults to ``0``.
+
+Returns:
+    tuple: the number of iterations performed and the maximum residual value.
+)__doc__",
+        py::call_guard<py::gil_scoped_release>());
+
+  m.def(("multigrid_" + function_suffix).c_str(),
+        &pyinterp::fill::multigrid<Type>, py::arg("grid"),
+        py::arg("first_guess") = pyinterp::fill::kZonalAverage,
+        py::arg("is_circle") = true, py::arg("max_iterations") = 100,
+        py::arg("epsilon") = 1e-4, py::arg("num_thread") = 0,
+        R"__doc__(
+Replaces all undefined values (NaN) in a grid by solving the Laplace
+equation with a multigrid method.
+
+Args:
+    grid (numpy.ndarray): Grid function on a uniform 2-dimensional grid to be
+        filled.
+    first_guess (pyinterp.core.fill.FirstGuess, optional): Type of first
+        guess. Defaults to ``ZonalAverage``.
+    is_circle (bool, optional): True if the X axis of the grid defines a
+        circle. Defaults to ``True``.
+    max_iterations (int, optional): Maximum number of V-cycles. Defaults to
+        ``100``.
+    epsilon (float, optional): Tolerance for ending the cycles before the
+        maximum number of iterations limit. Defaults to ``1e-4``.
+    num_threads (int, optional): The number of threads to use for the
+        computation. If 0 all CPUs are used. If 1 is given, no parallel
+        computing code is used at all, which is useful for debugging.
+        Defaults to ``0``.
+
+Returns:
+    tuple: the number of iterations performed and the maximum residual value.
+)__doc__",
+        py::call_guard<py::gil_scoped_release>());
+
+  m.def(("spectral_" + function_suffix).c_str(),
+        &pyinterp::fill::spectral<Type>, py::arg("grid"),
+        py::arg("first_guess") = pyinterp::fill::kZonalAverage,
+        py::arg("is_circle") = true, py::arg("max_iterations") = 100,
+        py::arg("epsilon") = 1e-4, py::arg("num_thread") = 0,
+        R"__doc__(
+Replaces all undefined values (NaN) in a grid by solving the Laplace
+equation with the conjugate gradient method, preconditioned by a fast
+Poisson solver using Fourier transforms along the X axis.
+
+Args:
+    grid (numpy.ndarray): Grid function on a uniform 2-dimensional grid to be
+        filled.
+    first_guess (pyinterp.core.fill.FirstGuess, optional): Type of first
+        guess. Defaults to ``ZonalAverage``.
+    is_circle (bool, optional): True if the X axis of the grid defines a
+        circle. Defaults to ``True``.
+    max_iterations (int, optional): Maximum number of iterations. Defaults to
+        ``100``.
+    epsilon (float, optional): Tolerance for ending the iterations before the
+        maximum number of iterations limit. Defaults to ``1e-4``.
     num_threads (int, optional): The number of threads to use for the
         computation. If 0 all CPUs are used. If 1 is given, no parallel
         computing code is used at all, which is useful for debugging.
@@ -111,6 +242,100 @@ Args:
 Returns:
     numpy.ndarray: the grid will have all the NaN filled with extrapolated
     values.
+)__doc__")
+            .c_str());
+
+  m.def(("loess_3d_" + function_suffix).c_str(),
+        &pyinterp::fill::loess_3d<Type, AxisType>, py::arg("grid"),
+        py::arg("nx") = 3, py::arg("ny") = 3, py::arg("nz") = 3,
+        py::arg("value_type") = pyinterp::fill::kUndefined,
+        py::arg("separable") = true, py::arg("num_threads") = 0,
+        (R"__doc__(
+Filters values using a spatio-temporal LOESS: the window of each pixel
+extends along the X, Y and Z axes. The weight function used is the tri-cube
+weight function, :math:`w(x)=(1-|d|^3)^3`.
+
+Args:
+    grid (pyinterp.core.)__doc__" +
+         prefix + "Grid3D" + suffix +
+         R"__doc__(): Grid containing the values to be filtered.
+    nx (int, optional): Number of points of the half-window to be taken into
+        account along the X-axis. Defaults to ``3``.
+    ny (int, optional): Number of points of the half-window to be taken into
+        account along the Y-axis. Defaults to ``3``.
+    nz (int, optional): Number of points of the half-window to be taken into
+        account along the Z-axis. The distance along this axis is the number
+        of steps between the pixels. Defaults to ``3``.
+    value_type (pyinterp.core.fill.ValueType, optional): Type of values
+        processed by the filter
+    separable (bool, optional): If true, the weight of a pixel is the product
+        of the weights of its distances along each axis, which is computed
+        in three one-dimensional passes; otherwise, it is the weight of its
+        distance to the processed pixel. Defaults to ``True``.
+    num_threads (int, optional): The number of threads to use for the
+        computation. If 0 all CPUs are used. If 1 is given, no parallel
+        computing code is used at all, which is useful for debugging.
+        Defaults to ``0``.
+
+Returns:
+    numpy.ndarray: the filtered grid.
+)__doc__")
+            .c_str());
+}
+
+template <typename Type, typename AxisType>
+void implement_gauss_seidel_3d(py::module& m, const std::string& prefix,
+                               const std::string& suffix) {
+  auto function_suffix = suffix;
+  function_suffix[0] = static_cast<char>(std::tolower(function_suffix[0]));
+
+  m.def(("gauss_seidel_" + function_suffix).c_str(),
+        &pyinterp::fill::gauss_seidel<Type, AxisType>, py::arg("grid"),
+        py::arg("first_guess") = pyinterp::fill::kZonalAverage,
+        py::arg("max_iterations") = 2000, py::arg("epsilon") = 1e-4,
+        py::arg("relaxation") = 1.0,
+        py::arg("ordering") = pyinterp::fill::kLexicographic,
+        py::arg("retire") = false, py::arg("warm_start") = false,
+        py::arg("callback") = nullptr, py::arg("callback_interval") = 1,
+        py::arg("num_thread") = 0,
+        (R"__doc__(
+Replaces all undefined values (NaN) in the layers of a 3D grid using the
+Gauss-Seidel method by relaxation. The layers are filled independently of each
+other, in parallel.
+
+Args:
+    grid (pyinterp.core.)__doc__" +
+         prefix + "Grid3D" + suffix +
+         R"__doc__(): Grid containing the values to be filled.
+    first_guess (pyinterp.core.fill.FirstGuess, optional): Type of first
+        guess. Defaults to ``ZonalAverage``.
+    max_iterations (int, optional): Maximum number of iterations to be used by
+        relaxation for each layer. Defaults to ``2000``.
+    epsilon (float, optional): Tolerance for ending relaxation before the
+        maximum number of iterations limit. Defaults to ``1e-4``.
+    relaxation (float, opional): Relaxation constant. Defaults to ``1``.
+    ordering (pyinterp.core.fill.Ordering, optional): Order in which the
+        undefined values are updated. Defaults to ``Lexicographic``.
+    retire (bool, optional): If true, the undefined values whose residual is
+        lower than ``epsilon`` are no longer updated by the next iterations.
+        Defaults to ``False``.
+    warm_start (bool, optional): If true, the first guess of a layer is the
+        solution found for the previous layer. The layers are then split into
+        one contiguous block per thread. Defaults to ``False``.
+    callback (callable, optional): Function called between the iterations of
+        each layer with the state of the iterations
+        (:py:class:`pyinterp.core.fill.Iteration`). If it returns ``True``,
+        the iterations of the layer are stopped. Defaults to ``None``.
+    callback_interval (int, optional): Number of iterations between two calls
+        of the callback. Defaults to ``1``.
+    num_threads (int, optional): The number of threads to use for the
+        computation. If 0 all CPUs are used. If 1 is given, no parallel
+        computing code is used at all, which is useful for debugging.
+        Defaults to ``0``.
+
+Returns:
+    tuple: the grid filled, the number of iterations performed and the
+    maximum residual value for each layer.
 )__doc__")
             .c_str());
 }
@@ -122,6 +347,26 @@ void init_fill(py::module& m) {
       .value("ZonalAverage", pyinterp::fill::kZonalAverage,
              "Use zonal average in x direction");
 
+  py::enum_<pyinterp::fill::Ordering>(
+      m, "Ordering", "Order in which the Gauss-Seidel method updates the grid.")
+      .value("Lexicographic", pyinterp::fill::kLexicographic,
+             "Row by row, the rows being processed in a pipeline")
+      .value("RedBlack", pyinterp::fill::kRedBlack,
+             "By color of a checkerboard, each color being processed in "
+             "parallel");
+
+  py::class_<pyinterp::fill::Iteration>(
+      m, "Iteration", "State of the Gauss-Seidel method after an iteration.")
+      .def_readonly("iteration", &pyinterp::fill::Iteration::iteration,
+                    "Number of iterations performed.")
+      .def_readonly("max_residual", &pyinterp::fill::Iteration::max_residual,
+                    "Maximum residual value of the iteration.")
+      .def_readonly("unconverged", &pyinterp::fill::Iteration::unconverged,
+                    "Number of undefined values whose residual is not lower "
+                    "than epsilon.")
+      .def_readonly("elapsed", &pyinterp::fill::Iteration::elapsed,
+                    "Wall time spent by the iteration, in seconds.");
+
   py::enum_<pyinterp::fill::ValueType>(m, "ValueType",
                                        R"__doc__(
 Type of values processed by the loess filter
@@ -134,8 +379,14 @@ Type of values processed by the loess filter
 
   implement_fill_functions<double>(m, "Float64");
   implement_fill_functions<float>(m, "Float32");
+  implement_loess<double, pyinterp::TiledGrid2D<double>>(m, "Tiled", "Float64");
+  implement_loess<float, pyinterp::TiledGrid2D<float>>(m, "Tiled", "Float32");
   implement_loess_3d<double, double>(m, "", "Float64");
   implement_loess_3d<double, int64_t>(m, "Temporal", "Float64");
   implement_loess_3d<float, double>(m, "", "Float32");
   implement_loess_3d<float, int64_t>(m, "Temporal", "Float32");
+  implement_gauss_seidel_3d<double, double>(m, "", "Float64");
+  implement_gauss_seidel_3d<double, int64_t>(m, "Temporal", "Float64");
+  implement_gauss_seidel_3d<float, double>(m, "", "Float32");
+  implement_gauss_seidel_3d<float, int64_t>(m, "Temporal", "Float32");
 }
@@ -10,8 +10,11 @@
 #include "pyinterp/geodetic/algorithm.hpp"
 #include "pyinterp/geodetic/box.hpp"
 #include "pyinterp/geodetic/coordinates.hpp"
+#include "pyinterp/geodetic/crossover.hpp"
+#include "pyinterp/geodetic/multipolygon.hpp"
 #include "pyinterp/geodetic/point.hpp"
 #include "pyinterp/geodetic/polygon.hpp"
+#include "pyinterp/geodetic/prepared_polygon.hpp"
 #include "pyinterp/geodetic/system.hpp"
 
 namespace geodetic = pyinterp::geodetic;
@@ -28,6 +31,12 @@ static inline auto parse_distance_strategy(const std::string& strategy)
   if (strategy == "vincenty") {
     return geodetic::kVincenty;
   }
+  if (strategy == "haversine") {
+    return geodetic::kHaversine;
+  }
+  if (strategy == "flat") {
+    return geodetic::kFlat;
+  }
   throw std::invalid_argument("Invalid strategy: " + strategy);
 }
 
@@ -71,12 +80,22 @@ Calculate the distance between the two points.
 Args:
     other (pyinterp.core.geodetic.Point): The other point to consider.
     strategy (str): The calculation method used to calculate the distance. This
-        parameter can take the values "andoyer", "thomas" or "vincenty".
+        parameter can take the values "andoyer", "thomas", "vincenty",
+        "haversine" or "flat". See the notes below.
     wgs (pyinterp.core.geodetic.System, optional): WGS system used for the
         calculation, default to WGS84.
 
 Returns:
     float: the distance between the two points in meters.
+.. note::
+
+    "andoyer", "thomas" and "vincenty" compute the geodesic distance on the
+    ellipsoid, from the fastest and least accurate method to the slowest and
+    most accurate one. "haversine" computes the great circle
+    distance on the sphere having the mean radius of the ellipsoid, with a
+    relative error up to 0.5%. "flat" uses an equirectangular approximation
+    on the same sphere: it is the fastest method, but it is only accurate
+    for points a few tens of kilometers apart.
 )__doc__")
       .def(
           "wkt",
@@ -452,6 +471,226 @@ Returns:
           }));
 }
 
+static void init_geodetic_prepared_polygon(py::module& m) {
+  py::class_<geodetic::PreparedPolygon>(m, "PreparedPolygon", R"__doc__(
+Polygon prepared for testing the location of many points.
+
+The edges of the polygon are distributed in slabs of longitude when the
+instance is created, so testing a point only visits the edges whose longitude
+range contains the longitude of the point, instead of all the edges of the
+polygon. The results are identical to those of
+:py:meth:`pyinterp.core.geodetic.Polygon.covered_by`.
+)__doc__")
+      .def(py::init<geodetic::Polygon>(), py::arg("polygon"), R"__doc__(
+Builds the index of the edges of the polygon.
+
+Args:
+    polygon (pyinterp.core.geodetic.Polygon): The polygon to prepare.
+)__doc__")
+      .def_property_readonly("polygon", &geodetic::PreparedPolygon::polygon,
+                             "The prepared polygon.")
+      .def(
+          "covered_by",
+          [](const geodetic::PreparedPolygon& self,
+             const geodetic::Point& point) -> bool {
+            return self.covered_by(point);
+          },
+          py::arg("point"), R"__doc__(
+Test if the given point is inside or on border of the polygon.
+
+Args:
+    point (pyinterp.core.geodetic.Point): point to test.
+Returns:
+    bool: True if the given point is inside or on border of the polygon.
+)__doc__")
+      .def(
+          "covered_by",
+          [](const geodetic::PreparedPolygon& self,
+             const Eigen::Ref<const Eigen::VectorXd>& lon,
+             const Eigen::Ref<const Eigen::VectorXd>& lat,
+             const size_t num_threads) -> py::array_t<int8_t> {
+            return self.covered_by(lon, lat, num_threads);
+          },
+          py::arg("lon"), py::arg("lat"), py::arg("num_threads") = 1,
+          R"__doc__(
+Test if the coordinates of the points provided are located inside or at the
+edge of the polygon.
+
+Args:
+    lon (numpy.ndarray): Longitudes coordinates in degrees to check.
+    lat (numpy.ndarray): Latitude coordinates in degrees to check.
+    num_threads (int, optional): The number of threads to use for the
+        computation. If 0 all CPUs are used. If 1 is given, no parallel
+        computing code is used at all, which is useful for debugging.
+        Default to 1.
+Returns:
+    numpy.ndarray: a vector containing a flag equal to 1 if the coordinate
+    is located in the polygon or at the edge otherwise 0.
+)__doc__")
+      .def(py::pickle(
+          [](const geodetic::PreparedPolygon& self) { return self.getstate(); },
+          [](const py::tuple& state) {
+            return geodetic::PreparedPolygon::setstate(state);
+          }));
+}
+
+static void init_geodetic_multipolygon(py::module& m) {
+  py::class_<geodetic::MultiPolygon>(m, "MultiPolygon",
+                                     "A collection of polygons.")
+      .def(py::init([](std::optional<const py::list>& polygons) {
+             return geodetic::MultiPolygon(polygons.value_or(py::list()));
+           }),
+           py::arg("polygons") = py::none(), R"__doc__(
+Constructor filling the collection.
+
+Args:
+  polygons (list, optional): list of polygons.
+Raises:
+  ValueError: if polygons is not a list of pyinterp.geodetic.Polygon.
+)__doc__")
+      .def("__len__", &geodetic::MultiPolygon::size,
+           "Called to implement the built-in function ``len()``")
+      .def("__getitem__", &geodetic::MultiPolygon::get, py::arg("index"),
+           "Returns the polygon at the given index.")
+      .def("append", &geodetic::MultiPolygon::append, py::arg("polygon"),
+           R"__doc__(
+Appends a polygon to the collection.
+
+Args:
+    polygon (pyinterp.core.geodetic.Polygon): The polygon to append.
+)__doc__")
+      .def(
+          "__eq__",
+          [](const geodetic::MultiPolygon& self,
+             const geodetic::MultiPolygon& rhs) -> bool {
+            return boost::geometry::equals(self, rhs);
+          },
+          py::arg("other"),
+          "Overrides the default behavior of the ``==`` operator.")
+      .def(
+          "__ne__",
+          [](const geodetic::MultiPolygon& self,
+             const geodetic::MultiPolygon& rhs) -> bool {
+            return !boost::geometry::equals(self, rhs);
+          },
+          py::arg("other"),
+          "Overrides the default behavior of the ``!=`` operator.")
+      .def("__repr__", &geodetic::MultiPolygon::to_string,
+           "Called by the ``repr()`` built-in function to compute the string "
+           "representation of the polygons.")
+      .def("envelope", &geodetic::MultiPolygon::envelope,
+           R"__doc__(
+Calculates the envelope of the polygons.
+
+Returns:
+  pyinterp.geodetic.Box: The envelope of this instance.
+)__doc__")
+      .def(
+          "covered_by",
+          [](const geodetic::MultiPolygon& self, const geodetic::Point& point)
+              -> bool { return self.covered_by(point); },
+          py::arg("point"), R"__doc__(
+Test if the given point is inside or on border of one of the polygons.
+
+Args:
+    point (pyinterp.core.geodetic.Point): point to test.
+Returns:
+    bool: True if the given point is inside or on border of one of the
+    polygons.
+)__doc__")
+      .def(
+          "covered_by",
+          [](const geodetic::MultiPolygon& self,
+             const Eigen::Ref<const Eigen::VectorXd>& lon,
+             const Eigen::Ref<const Eigen::VectorXd>& lat,
+             const size_t num_threads) -> py::array_t<int8_t> {
+            return self.covered_by(lon, lat, num_threads);
+          },
+          py::arg("lon"), py::arg("lat"), py::arg("num_threads") = 1,
+          R"__doc__(
+Test if the coordinates of the points provided are located inside or at the
+edge of one of the polygons.
+
+Args:
+    lon (numpy.ndarray): Longitudes coordinates in degrees to check.
+    lat (numpy.ndarray): Latitude coordinates in degrees to check.
+    num_threads (int, optional): The number of threads to use for the
+        computation. If 0 all CPUs are used. If 1 is given, no parallel
+        computing code is used at all, which is useful for debugging.
+        Default to 1.
+Returns:
+    numpy.ndarray: a vector containing a flag equal to 1 if the coordinate
+    is located in one of the polygons or at its edge otherwise 0.
+)__doc__")
+      .def("which_polygon", &geodetic::MultiPolygon::which_polygon,
+           py::arg("lon"), py::arg("lat"), py::arg("num_threads") = 0,
+           R"__doc__(
+Locates the points provided among the polygons of the collection.
+
+The envelopes of the polygons are indexed by an R*Tree and the edges of each
+polygon are distributed in slabs of longitude, as done by
+:py:class:`pyinterp.core.geodetic.PreparedPolygon`, so the points are located
+in a single pass. The results are identical to those of
+:py:meth:`pyinterp.core.geodetic.Polygon.covered_by` called on each polygon.
+
+Args:
+    lon (numpy.ndarray): Longitudes coordinates in degrees to locate.
+    lat (numpy.ndarray): Latitude coordinates in degrees to locate.
+    num_threads (int, optional): The number of threads to use for the
+        computation. If 0 all CPUs are used. If 1 is given, no parallel
+        computing code is used at all, which is useful for debugging.
+        Default to 0.
+Returns:
+    numpy.ndarray: a vector containing, for each point, the index of the
+    first polygon covering the point, or -1 if no polygon covers it.
+)__doc__")
+      .def("area", &geodetic::MultiPolygon::area, py::arg("wgs") = py::none(),
+           R"__doc__(
+Calculates the area.
+
+Args:
+    (pyinterp.core.geodetic.System, optional): WGS system used for the
+        calculation, default to WGS84.
+
+Returns:
+    float: The calculated area.
+)__doc__")
+      .def(
+          "wkt",
+          [](const geodetic::MultiPolygon& self) -> std::string {
+            auto ss = std::stringstream();
+            ss << boost::geometry::wkt(self);
+            return ss.str();
+          },
+          R"__doc__(
+Gets the OGC Well-Known Text (WKT) representation of this instance.
+
+Returns:
+    str: the WKT representation.
+)__doc__")
+      .def_static(
+          "read_wkt",
+          [](const std::string& wkt) -> geodetic::MultiPolygon {
+            auto multipolygon = geodetic::MultiPolygon();
+            boost::geometry::read_wkt(wkt, multipolygon);
+            return multipolygon;
+          },
+          py::arg("wkt"), R"__doc__(
+Parses OGC Well-Known Text (WKT) into a multi-polygon.
+
+Args:
+    wkt (str): the WKT representation of the multi-polygon.
+Returns:
+    pyinterp.geodetic.MultiPolygon: The multi-polygon defined by the WKT
+    representation.
+)__doc__")
+      .def(py::pickle(
+          [](const geodetic::MultiPolygon& self) { return self.getstate(); },
+          [](const py::tuple& state) {
+            return geodetic::MultiPolygon::setstate(state);
+          }));
+}
+
 void init_geodetic(py::module& m) {
   auto _system = py::class_<pyinterp::detail::geodetic::System>(
       m, "_System", "C++ implementation of the WGS system.");
@@ -648,6 +887,8 @@ Returns:
   init_geodetic_point(m);
   init_geodetic_box(m);
   init_geodetic_polygon(m);
+  init_geodetic_prepared_polygon(m);
+  init_geodetic_multipolygon(m);
 
   m.def(
       "normalize_longitudes",
@@ -688,7 +929,8 @@ Args:
     lon2 (numpy.ndarray): Longitudes in degrees.
     lat2 (numpy.ndarray): Latitudes in degrees.
     strategy (str): The calculation method used to calculate the distance. This
-        parameter can take the values "andoyer", "thomas" or "vincenty".
+        parameter can take the values "andoyer", "thomas", "vincenty",
+        "haversine" or "flat". See the notes below.
     wgs (pyinterp.core.geodetic.System, optional): WGS system used for the
         calculation, default to WGS84.
     num_threads (int, optional): The number of threads to use for the
@@ -699,5 +941,74 @@ Returns:
     numpy.ndarray: an array containing the distances ``[..., distance_i, ...]``,
         corresponding to the distances between the coordinates
         ``[..., (Point(lon1_i, lat1_i), Point(lon2_i, lat2_i)), ...]``.
+
+.. note::
+
+    "andoyer", "thomas" and "vincenty" compute the geodesic distance on the
+    ellipsoid, from the fastest and least accurate method to the slowest and
+    most accurate one. "haversine" computes the great circle
+    distance on the sphere having the mean radius of the ellipsoid, with a
+    relative error up to 0.5%. "flat" uses an equirectangular approximation
+    on the same sphere: it is the fastest method, but it is only accurate
+    for points a few tens of kilometers apart.
 )__doc__");
+
+  m.def(
+      "crossovers",
+      [](const Eigen::Ref<const Eigen::VectorXd>& lon1,
+         const Eigen::Ref<const Eigen::VectorXd>& lat1,
+         const Eigen::Ref<const Eigen::VectorXd>& lon2,
+         const Eigen::Ref<const Eigen::VectorXd>& lat2) {
+        return geodetic::crossovers(lon1, lat1, lon2, lat2);
+      },
+      py::arg("lon1"), py::arg("lat1"), py::arg("lon2"), py::arg("lat2"),
+      R"__doc__(
+Searches for the crossover points between two tracks.
+
+The tracks are polylines whose segments follow the great circles joining
+consecutive points. A sweep line moves from south to north over the latitude
+ranges of the segments: a segment is only intersected with the segments of
+the other track having overlapping latitude and longitude ranges. The
+undefined points split the tracks.
+
+Args:
+    lon1 (numpy.ndarray): Longitudes of the first track, in degrees.
+    lat1 (numpy.ndarray): Latitudes of the first track, in degrees.
+    lon2 (numpy.ndarray): Longitudes of the second track, in degrees.
+    lat2 (numpy.ndarray): Latitudes of the second track, in degrees.
+Returns:
+    tuple: The longitudes and latitudes of the crossovers, in degrees, and
+    their positions along the first and second tracks. The integer part of a
+    position is the index of the first point of the segment crossed, its
+    fractional part is the position of the crossover within the segment. The
+    crossovers are sorted by position along the first track.
+)__doc__",
+      py::call_guard<py::gil_scoped_release>());
+
+  m.def(
+      "crossovers",
+      [](const std::vector<geodetic::Track>& tracks,
+         const Eigen::Ref<const pyinterp::Matrix<int64_t>>& pairs,
+         const size_t num_threads) {
+        return geodetic::crossovers(tracks, pairs, num_threads);
+      },
+      py::arg("tracks"), py::arg("pairs"), py::arg("num_threads") = 0,
+      R"__doc__(
+Searches for the crossover points between pairs of tracks, in parallel.
+
+Args:
+    tracks (list): Longitudes and latitudes of the tracks, in degrees.
+    pairs (numpy.ndarray): Matrix of shape ``(n, 2)`` holding the indices of
+        the tracks to intersect.
+    num_threads (int, optional): The number of threads to use for the
+        computation. If 0 all CPUs are used. If 1 is given, no parallel
+        computing code is used at all, which is useful for debugging.
+        Defaults to ``0``.
+Returns:
+    tuple: The index of the pair of each crossover, followed by the
+    longitudes, latitudes and positions of the crossovers along both tracks.
+    The crossovers are sorted by pair, then by position along the first
+    track.
+)__doc__",
+      py::call_guard<py::gil_scoped_release>());
 }
@@ -0,0 +1,156 @@
+// Copyright (c) 2022 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+#include "pyinterp/geohash/index.hpp"
+
+#include <pybind11/eigen.h>
+#include <pybind11/numpy.h>
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+namespace py = pybind11;
+namespace geohash = pyinterp::geohash;
+
+template <typename Type>
+static void implement_index(py::module& m, const char* const suffix) {
+  py::class_<geohash::Index<Type>>(m, (std::string("Index") + suffix).c_str(),
+                                   R"__doc__(
+Spatial index storing points in the cells of a geohash grid.
+)__doc__")
+      .def(py::init<uint32_t, std::optional<pyinterp::geodetic::System>>(),
+           py::arg("precision"), py::arg("system"),
+           R"__doc__(
+Default constructor
+
+Args:
+    precision (int): Number of bits of the geohash codes defining the cells
+        of the index.
+    system (pyinterp.core.geodetic.System, optional): WGS of the
+        coordinate system used to transform the positions into ECEF
+        coordinates. If not set the geodetic system used is WGS-84.
+Raises:
+    ValueError: If the given precision is not within [1, 64].
+)__doc__")
+      .def_property_readonly("precision", &geohash::Index<Type>::precision,
+                             R"__doc__(
+Number of bits of the geohash codes defining the cells of the index.
+)__doc__")
+      .def("cells", &geohash::Index<Type>::cells, R"__doc__(
+Returns the number of cells holding at least one point.
+
+Returns:
+    int: The number of cells holding at least one point.
+)__doc__")
+      .def("__len__", &geohash::Index<Type>::size,
+           "Called to implement the built-in function ``len()``")
+      .def(
+          "__bool__",
+          [](const geohash::Index<Type>& self) { return self.size() != 0; },
+          "Called to implement truth value testing and the built-in "
+          "operation ``bool()``.")
+      .def("packing", &geohash::Index<Type>::packing, py::arg("lon"),
+           py::arg("lat"), py::arg("values"), py::arg("num_threads") = 0,
+           R"__doc__(
+Builds the index from the provided points. The old data is erased.
+
+The points are sorted by the geohash code of the cell containing them, then
+stored contiguously: the build costs one parallel sort.
+
+Args:
+    lon (numpy.ndarray): Longitudes of the points, in degrees.
+    lat (numpy.ndarray): Latitudes of the points, in degrees.
+    values (numpy.ndarray): Values associated with the points.
+    num_threads (int, optional): The number of threads to use for the
+        computation. If 0 all CPUs are used. If 1 is given, no parallel
+        computing code is used. This is useful for debugging.
+)__doc__",
+           py::call_guard<py::gil_scoped_release>())
+      .def("query", &geohash::Index<Type>::query, py::arg("lon"),
+           py::arg("lat"), py::arg("k") = 4, py::arg("radius") = py::none(),
+           py::arg("num_threads") = 0,
+           R"__doc__(
+Search for the nearest K nearest neighbors of the given points.
+
+The cell containing a point is explored first, then the rings of cells
+surrounding it, until the cells not explored are farther than the K-th
+neighbor found. The distances are the Euclidean distances between the ECEF
+coordinates of the points, as computed by :py:class:`pyinterp.RTree`.
+
+Args:
+    lon (numpy.ndarray): Longitudes of the points, in degrees.
+    lat (numpy.ndarray): Latitudes of the points, in degrees.
+    k (int, optional): The number of nearest neighbors to be searched.
+        Defaults to ``4``.
+    radius (float, optional): The maximum distance between a point and its
+        neighbors, in meters. By default, the distance is not limited.
+    num_threads (int, optional): The number of threads to use for the
+        computation. If 0 all CPUs are used. If 1 is given, no parallel
+        computing code is used. This is useful for debugging.
+Returns:
+    tuple: A tuple containing a matrix describing for each provided position,
+    the distance, in meters, between the provided position and the found
+    neighbors and a matrix containing the value of the different neighbors
+    found for all provided positions. The missing neighbors are set to -1.
+)__doc__",
+           py::call_guard<py::gil_scoped_release>())
+      .def("within", &geohash::Index<Type>::within, py::arg("lon"),
+           py::arg("lat"), py::arg("radius"), py::arg("num_threads") = 0,
+           R"__doc__(
+Search for all the points located within a radius of the given points.
+
+The cells surrounding a point are explored until the cells not explored are
+farther than the radius. The distances are the Euclidean distances between
+the ECEF coordinates of the points, as computed by :py:meth:`query`.
+
+Args:
+    lon (numpy.ndarray): Longitudes of the points, in degrees.
+    lat (numpy.ndarray): Latitudes of the points, in degrees.
+    radius (float): The maximum distance between a point and its neighbors,
+        in meters.
+    num_threads (int, optional): The number of threads to use for the
+        computation. If 0 all CPUs are used. If 1 is given, no parallel
+        computing code is used. This is useful for debugging.
+Returns:
+    tuple: A tuple containing, for each pair found, the index of the provided
+    point, the value of the neighbor and the distance, in meters, between
+    them. The pairs are sorted by index, then by increasing distance.
+)__doc__",
+           py::call_guard<py::gil_scoped_release>())
+      .def("save", &geohash::Index<Type>::save, py::arg("path"), R"__doc__(
+Writes the index to a file that can be mapped in memory by :py:meth:`load`.
+
+Args:
+    path (str): Path to the file to create.
+
+.. note::
+
+    The file stores the memory representation of the index: it can only be
+    loaded on a machine with the same architecture.
+)__doc__",
+           py::call_guard<py::gil_scoped_release>())
+      .def_static("load", &geohash::Index<Type>::load, py::arg("path"),
+                  R"__doc__(
+Opens an index written by :py:meth:`save`.
+
+The file is mapped read-only in memory instead of being read. The file must
+not be modified while the index is in use.
+
+Args:
+    path (str): Path to the file to open.
+Returns:
+    The index stored in the file.
+)__doc__",
+                  py::call_guard<py::gil_scoped_release>())
+      .def(py::pickle(
+          [](const geohash::Index<Type>& self) { return self.getstate(); },
+          [](const py::tuple& state) {
+            return geohash::Index<Type>::setstate(state);
+          }));
+}
+
+void init_geohash_index(py::module& m) {
+  implement_index<double>(m, "Float64");
+  implement_index<float>(m, "Float32");
+  implement_index<int64_t>(m, "Int64");
+}
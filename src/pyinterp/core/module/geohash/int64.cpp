@@ -13,6 +13,7 @@
 
 #include "pyinterp/geodetic/box.hpp"
 #include "pyinterp/geodetic/point.hpp"
+#include "pyinterp/geodetic/polygon.hpp"
 
 namespace py = pybind11;
 namespace geohash = pyinterp::geohash;
@@ -29,11 +30,13 @@ void init_geohash_int64(py::module& m) {
        "encode",
        [](const Eigen::Ref<const Eigen::VectorXd>& lon,
           const Eigen::Ref<const Eigen::VectorXd>& lat,
-          const uint32_t precision) -> pyinterp::Vector<uint64_t> {
+          const uint32_t precision,
+          const size_t num_threads) -> pyinterp::Vector<uint64_t> {
          check_range(precision);
-         return geohash::int64::encode(lon, lat, precision);
+         return geohash::int64::encode(lon, lat, precision, num_threads);
        },
        py::arg("lon"), py::arg("lat"), py::arg("precision") = 64,
+       py::arg("num_threads") = 0,
        R"__doc__(
 Encode coordinates into geohash with the given precision.
 
@@ -41,21 +44,28 @@ Args:
   lon (numpy.ndarray) Longitudes in degrees.
   lat (numpy.ndarray) Latitudes in degrees.
   precision (int, optional) Number of bits used to encode the geohash code.
+  num_threads (int, optional): The number of threads to use for the
+    computation. If 0 all CPUs are used. If 1 is given, no parallel
+    computing code is used at all, which is useful for debugging.
+    Defaults to ``0``.
 Returns:
   numpy.ndarray: geohash codes.
 Raises:
   ValueError: If the given precision is not within [1, 64].
   ValueError: If the lon and lat vectors have different sizes.
-)__doc__")
+)__doc__",
+       py::call_guard<py::gil_scoped_release>())
       .def(
           "decode",
           [](const Eigen::Ref<const pyinterp::Vector<uint64_t>>& hash,
              const uint32_t precision,
-             const bool round) -> std::tuple<Eigen::VectorXd, Eigen::VectorXd> {
+             const bool round, const size_t num_threads)
+              -> std::tuple<Eigen::VectorXd, Eigen::VectorXd> {
             check_range(precision);
-            return geohash::int64::decode(hash, precision, round);
+            return geohash::int64::decode(hash, precision, round, num_threads);
           },
           py::arg("hash"), py::arg("precision") = 64, py::arg("round") = false,
+          py::arg("num_threads") = 0,
           R"__doc__(
 Decode hash into a geographic points with the given precision.
 
@@ -64,11 +74,16 @@ Args:
   precision (int, optional): Required accuracy.
   round (optional, bool): If true, the coordinates of the point will be
     rounded to the accuracy defined by the GeoHash."
+  num_threads (int, optional): The number of threads to use for the
+    computation. If 0 all CPUs are used. If 1 is given, no parallel
+    computing code is used at all, which is useful for debugging.
+    Defaults to ``0``.
 Returns:
   tuple: longitudes/latitudes of the decoded points.
 Raises:
     ValueError: If the given precision is not within [1, 64].
-)__doc__")
+)__doc__",
+          py::call_guard<py::gil_scoped_release>())
       .def(
           "neighbors",
           [](const uint64_t hash,
@@ -88,5 +103,109 @@ Returns:
   numpy.ndarray: Geohash codes.
 Raises:
   ValueError: If the given precision is not within [1, 64].
+)__doc__")
+      .def(
+          "neighbors",
+          [](const Eigen::Ref<const pyinterp::Vector<uint64_t>>& hash,
+             const uint32_t precision, const uint32_t rings,
+             const size_t num_threads)
+              -> Eigen::Matrix<uint64_t, Eigen::Dynamic, Eigen::Dynamic,
+                               Eigen::RowMajor> {
+            check_range(precision);
+            return geohash::int64::neighbors(hash, precision, rings,
+                                             num_threads);
+          },
+          py::arg("hash"), py::arg("precision") = 64, py::arg("rings") = 1,
+          py::arg("num_threads") = 0,
+          R"__doc__(
+Returns the cells surrounding each of the given geohash codes.
+
+The neighbors are computed from the bits of the codes, without decoding
+them.
+
+Args:
+  hash (numpy.ndarray): Geohash codes.
+  precision (int, optional): Required accuracy.
+  rings (int, optional): Number of rings of cells around each code: the
+    cells located at most ``rings`` cells away in longitude and latitude
+    are returned. Defaults to ``1``.
+  num_threads (int, optional): The number of threads to use for the
+    computation. If 0 all CPUs are used. If 1 is given, no parallel
+    computing code is used at all, which is useful for debugging.
+    Defaults to ``0``.
+Returns:
+  numpy.ndarray: A matrix ``(n, (2 * rings + 1) ** 2)`` holding, for each
+  code, the sorted codes of the cells surrounding it, the code itself
+  included. The cells counted more than once, when the rings go around the
+  globe, and the cells beyond the poles are removed: the unused items at the
+  end of the rows are set to the largest 64-bit unsigned integer.
+Raises:
+  ValueError: If the given precision is not within [1, 64].
+)__doc__",
+          py::call_guard<py::gil_scoped_release>())
+      .def(
+          "area",
+          [](const Eigen::Ref<const pyinterp::Vector<uint64_t>>& hash,
+             const uint32_t precision,
+             const std::optional<pyinterp::geodetic::System>& wgs,
+             const size_t num_threads) -> Eigen::VectorXd {
+            check_range(precision);
+            return geohash::int64::area(hash, precision, wgs, num_threads);
+          },
+          py::arg("hash"), py::arg("precision") = 64,
+          py::arg("wgs") = py::none(), py::arg("num_threads") = 0,
+          R"__doc__(
+Calculates the area covered by the geohash codes.
+
+The cells being bounded by meridians and parallels, their area on the
+spheroid is calculated in closed form from their latitudes and their
+longitude span.
+
+Args:
+  hash (numpy.ndarray): Geohash codes.
+  precision (int, optional): Required accuracy.
+  wgs (optional, pyinterp.geodetic.System): WGS used to calculate the area.
+    Defaults to WGS84.
+  num_threads (int, optional): The number of threads to use for the
+    computation. If 0 all CPUs are used. If 1 is given, no parallel
+    computing code is used at all, which is useful for debugging.
+    Defaults to ``0``.
+Returns:
+  numpy.ndarray: The areas of the cells, in square meters.
+Raises:
+  ValueError: If the given precision is not within [1, 64].
+)__doc__",
+          py::call_guard<py::gil_scoped_release>())
+      .def(
+          "bounding_boxes",
+          [](const pyinterp::geodetic::Polygon& polygon,
+             const uint32_t precision,
+             const size_t num_threads) -> pyinterp::Vector<uint64_t> {
+            check_range(precision);
+            return geohash::int64::bounding_boxes(polygon, precision,
+                                                  num_threads);
+          },
+          py::arg("polygon"), py::arg("precision") = 5,
+          py::arg("num_threads") = 0,
+          R"__doc__(
+Returns the sorted geohash codes of the cells intersecting the polygon.
+
+The cells crossed by the edges of the polygon are refined from a coarse grid
+up to the required accuracy, while the cells entirely inside or outside the
+polygon are kept or discarded at once.
+
+Args:
+  polygon (pyinterp.geodetic.Polygon): Polygon.
+  precision (int, optional): Number of bits of the geohash codes.
+    Defaults to 5.
+  num_threads (int, optional): The number of threads to use for the
+    computation. If 0 all CPUs are used. If 1 is given, no parallel
+    computing code is used at all, which is useful for debugging.
+    Defaults to ``0``.
+Returns:
+  numpy.ndarray: Geohash codes.
+Raises:
+  ValueError: If the given precision is not within [1, 64].
+  MemoryError: If the memory is not sufficient to store the result.
 )__doc__");
 }
\ No newline at end of file
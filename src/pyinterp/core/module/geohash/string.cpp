@@ -29,11 +29,13 @@ void init_geohash_string(py::module& m) {
        "encode",
        [](const Eigen::Ref<const Eigen::VectorXd>& lon,
           const Eigen::Ref<const Eigen::VectorXd>& lat,
-          const uint32_t precision) -> pybind11::array {
+          const uint32_t precision,
+          const size_t num_threads) -> pybind11::array {
          check_range(precision);
-         return geohash::string::encode(lon, lat, precision);
+         return geohash::string::encode(lon, lat, precision, num_threads);
        },
        py::arg("lon"), py::arg("lat"), py::arg("precision") = 12,
+       py::arg("num_threads") = 0,
        R"__doc__(
 Encode coordinates into geohash with the given precision.
 
@@ -42,6 +44,10 @@ Args:
   lat (numpy.ndarray) Latitudes in degrees.
   precision (int, optional) Number of bits used to encode the geohash code.
     Defaults to 12.
+  num_threads (int, optional): The number of threads to use for the
+    computation. If 0 all CPUs are used. If 1 is given, no parallel
+    computing code is used at all, which is useful for debugging.
+    Defaults to ``0``.
 Returns:
   numpy.ndarray: geohash codes.
 Raises:
@@ -50,11 +56,13 @@ Raises:
 )__doc__")
       .def(
           "decode",
-          [](const pybind11::array& hash,
-             const bool round) -> std::tuple<Eigen::VectorXd, Eigen::VectorXd> {
-            return geohash::string::decode(hash, round);
+          [](const pybind11::array& hash, const bool round,
+             const size_t num_threads)
+              -> std::tuple<Eigen::VectorXd, Eigen::VectorXd> {
+            return geohash::string::decode(hash, round, num_threads);
           },
           py::arg("hash"), py::arg("round") = false,
+          py::arg("num_threads") = 0,
           R"__doc__(
 Decode hashes into a geographic points.
 
@@ -62,35 +70,51 @@ Args:
   hash (numpy.ndarray): GeoHash codes.
   round (optional, bool): If true, the coordinates of the point will be
     rounded to the accuracy defined by the GeoHash. Defaults to False.
+  num_threads (int, optional): The number of threads to use for the
+    computation. If 0 all CPUs are used. If 1 is given, no parallel
+    computing code is used at all, which is useful for debugging.
+    Defaults to ``0``.
 Returns:
   tuple: longitudes/latitudes of the decoded points.
 )__doc__")
       .def(
           "area",
           [](const pybind11::array& hash,
-             const std::optional<geodetic::System>& wgs) -> Eigen::VectorXd {
-            return geohash::string::area(hash, wgs);
+             const std::optional<geodetic::System>& wgs,
+             const size_t num_threads) -> Eigen::VectorXd {
+            return geohash::string::area(hash, wgs, num_threads);
           },
           py::arg("hash"), py::arg("wgs") = py::none(),
+          py::arg("num_threads") = 0,
           R"__doc__(
-Calculated the area caovered by the GeoHash codes.
+Calculated the area covered by the GeoHash codes.
+
+The cells being bounded by meridians and parallels, their area on the
+spheroid is calculated in closed form from their latitudes and their
+longitude span.
 
 Args:
   hash (numpy.ndarray): GeoHash codes.
   wgs (optional, pyinterp.geodetic.System): WGS used to calculate the area.
     Defaults to WGS84.
+  num_threads (int, optional): The number of threads to use for the
+    computation. If 0 all CPUs are used. If 1 is given, no parallel
+    computing code is used at all, which is useful for debugging.
+    Defaults to ``0``.
 
 Returns:
-  double: calculated areas.
+  numpy.ndarray: calculated areas, in square meters.
 )__doc__")
       .def(
           "bounding_boxes",
-          [](const std::optional<geodetic::Box>& box,
-             const uint32_t precision) -> py::array {
+          [](const std::optional<geodetic::Box>& box, const uint32_t precision,
+             const size_t num_threads) -> py::array {
             check_range(precision);
-            return geohash::string::bounding_boxes(box, precision);
+            return geohash::string::bounding_boxes(box, precision,
+                                                   num_threads);
           },
           py::arg("box") = py::none(), py::arg("precision") = 1,
+          py::arg("num_threads") = 0,
           R"__doc__(
 Returns all geohash codes contained in the defined bounding box.
 
@@ -98,6 +122,10 @@ Args:
   box (pyinterp.geohash.Box, optional): Bounding box. Default to the
     global bounding box.
   precision (int, optional): Required accuracy. Defaults to 1.
+  num_threads (int, optional): The number of threads to use for the
+    computation. If 0 all CPUs are used. If 1 is given, no parallel
+    computing code is used at all, which is useful for debugging.
+    Defaults to ``0``.
 Returns:
   numpy.ndarray: GeoHash codes.
 Raises:
@@ -117,6 +145,10 @@ Raises:
           R"__doc__(
 Returns all geohash codes contained in the defined polygon.
 
+The cells crossed by the edges of the polygon are refined from a coarse grid
+up to the required accuracy, while the cells entirely inside or outside the
+polygon are kept or discarded at once. The codes are returned sorted.
+
 Args:
   polygon (pyinterp.geodetic.Polygon): Polygon.
   precision (int, optional): Required accuracy.
@@ -152,6 +184,22 @@ Args:
 Returns:
   dict: dictionary between successive identical geohash codes and start and
     end indexes in the table provided as input.
+)__doc__")
+      .def("where_arrays", &geohash::string::where_arrays, py::arg("hash"),
+           R"__doc__(
+Returns the start and end indexes of the different GeoHash boxes as arrays.
+
+The codes are identified without building a string for each of them, and the
+runs of identical codes, frequent in the arrays sorted by time and space, are
+detected without any lookup.
+
+Args:
+  hash (numpy.ndarray): GeoHash codes.
+Returns:
+  tuple: the different geohash codes, in the order of their first
+    occurrence, and a matrix of shape ``(n, 4)`` holding for each of them
+    the first and last rows and the first and last columns where it occurs
+    in the table provided as input.
 )__doc__")
       .def(
           "transform",
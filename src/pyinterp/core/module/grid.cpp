@@ -6,10 +6,22 @@
 
 #include <pybind11/pybind11.h>
 
+#include "pyinterp/chunked_grid.hpp"
+#include "pyinterp/packed_grid.hpp"
+#include "pyinterp/tiled_grid.hpp"
+
 namespace py = pybind11;
 
 void init_grid(py::module& m) {
   pyinterp::implement_grid<double>(m, "Float64");
   pyinterp::implement_grid<float>(m, "Float32");
   pyinterp::implement_grid<int8_t>(m, "Int8");
+  pyinterp::implement_packed_grid<int16_t>(m, "Int16");
+  pyinterp::implement_packed_grid<uint16_t>(m, "Float16");
+  pyinterp::implement_tiled_grid<double>(m, "Float64");
+  pyinterp::implement_tiled_grid<float>(m, "Float32");
+  pyinterp::implement_chunked_grid<double, double>(m, "", "Float64");
+  pyinterp::implement_chunked_grid<float, double>(m, "", "Float32");
+  pyinterp::implement_chunked_grid<double, int64_t>(m, "Temporal", "Float64");
+  pyinterp::implement_chunked_grid<float, int64_t>(m, "Temporal", "Float32");
 }
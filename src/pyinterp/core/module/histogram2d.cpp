@@ -20,8 +20,9 @@ Group a number of more or less continuous values into a smaller number of
 )__doc__")
       .def(py::init<std::shared_ptr<pyinterp::Axis<double>>,
                     std::shared_ptr<pyinterp::Axis<double>>,
-                    const std::optional<size_t>&>(),
+                    const std::optional<size_t>&, const bool>(),
            py::arg("x"), py::arg("y"), py::arg("bins") = py::none(),
+           py::arg("sparse") = false,
            R"__doc__(
 Default constructor.
 
@@ -32,6 +33,9 @@ Args:
         the grid.
     bins (int, optional): Maximum number of bins per pixel to use to calculate
         the histogram.
+    sparse (bool, optional): If true, only the histograms holding values are
+        stored, which saves memory when most of the bins of the grid stay
+        empty. Defaults to ``False``.
 )__doc__")
       .def_property_readonly(
           "x", [](const pyinterp::Histogram2D<Type>& self) { return self.x(); },
@@ -48,6 +52,15 @@ Gets the bin centers for the Y Axis of the grid.
 
 Returns:
     pyinterp.core.Axis: Y-Axis.
+)__doc__")
+      .def_property_readonly(
+          "sparse",
+          [](const pyinterp::Histogram2D<Type>& self) { return self.sparse(); },
+          R"__doc__(
+True if only the histograms holding values are stored.
+
+Returns:
+    bool: Storage mode of the histograms.
 )__doc__")
       .def("clear", &pyinterp::Histogram2D<Type>::clear, "Reset the statistics")
       .def("count", &pyinterp::Histogram2D<Type>::count,
@@ -82,6 +95,23 @@ Returns:
     numpy.ndarray: quantile of points within each bin.
 )__doc__",
            py::arg("q") = 0.5)
+      .def("quantiles", &pyinterp::Histogram2D<Type>::quantiles,
+           py::arg("q"), py::arg("num_threads") = 0,
+           R"__doc__(
+Compute several quantiles of points within each bin, in a single pass over
+the histogram of each bin.
+
+Args:
+    q (numpy.ndarray): Quantiles to compute.
+    num_threads (int, optional): The number of threads to use for the
+        computation. If 0 all CPUs are used. If 1 is given, no parallel
+        computing code is used at all, which is useful for debugging.
+        Defaults to ``0``.
+
+Returns:
+    numpy.ndarray: quantiles of points within each bin, of shape
+    ``(nx, ny, len(q))``.
+)__doc__")
       .def("max", &pyinterp::Histogram2D<Type>::max,
            R"__doc__(
 Compute the maximum of values for points within each bin.
@@ -104,13 +134,17 @@ Returns:
     numpy.ndarray: minimum of values for points within each bin.
 )__doc__")
       .def("push", &pyinterp::Histogram2D<Type>::push, py::arg("x"),
-           py::arg("y"), py::arg("z"), R"__doc__(
+           py::arg("y"), py::arg("z"), py::arg("num_threads") = 0, R"__doc__(
 Push new samples into the defined bins.
 
 Args:
     x (numpy.ndarray): X coordinates of the values to push.
     y (numpy.ndarray): Y coordinates of the values to push.
     z (numpy.ndarray): New samples to push.
+    num_threads (int, optional): The number of threads to use for the
+        computation. If 0 all CPUs are used. If 1 is given, no parallel
+        computing code is used at all, which is useful for debugging.
+        Defaults to ``0``.
 )__doc__")
       .def("sum_of_weights", &pyinterp::Histogram2D<Type>::sum_of_weights,
            R"__doc__(
@@ -135,6 +169,14 @@ Returns:
 )__doc__")
       .def("__iadd__", &pyinterp::Histogram2D<Type>::operator+=,
            py::call_guard<py::gil_scoped_release>())
+      .def("merge", &pyinterp::Histogram2D<Type>::merge, py::arg("state"),
+           R"__doc__(
+Merges the statistics of another instance from its pickled state, without
+creating the instance.
+
+Args:
+    state (tuple): State of the other instance, returned by ``__getstate__``.
+)__doc__")
       .def(py::pickle(
           [](const pyinterp::Histogram2D<Type>& self) {
             return self.getstate();
@@ -0,0 +1,185 @@
+// Copyright (c) 2022 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+#include "pyinterp/interpolation_plan.hpp"
+
+#include <pybind11/pybind11.h>
+
+namespace py = pybind11;
+namespace geometry = pyinterp::detail::geometry;
+
+void init_interpolation_plan(py::module& m) {
+  using InterpolationPlan = pyinterp::InterpolationPlan;
+
+  py::class_<InterpolationPlan>(m, "InterpolationPlan", R"__doc__(
+Interpolation of a fixed set of points from the values of grids sharing the
+same axes.
+
+The plan holds, for each point, the indexes of the grid values used by the
+interpolation and their weights, as the rows of a sparse matrix in CSR format.
+Applying the plan to the values of a grid is a sparse matrix-vector product:
+the cells framing the points are searched, and the weights computed, once for
+all the grids interpolated.
+
+The matrix can be handled by other libraries, e.g. ``scipy.sparse.csr_matrix(
+(plan.weights, plan.indices, plan.indptr), shape=(len(plan), nx * ny))``.
+)__doc__")
+      .def(py::init<int64_t, int64_t, pyinterp::Vector<int64_t>,
+                    pyinterp::Vector<int64_t>, pyinterp::Vector<double>>(),
+           py::arg("nx"), py::arg("ny"), py::arg("indptr"), py::arg("indices"),
+           py::arg("weights"), R"__doc__(
+Create a plan from its CSR representation.
+
+Args:
+    nx (int): Number of values of the grids along the X axis.
+    ny (int): Number of values of the grids along the Y axis.
+    indptr (numpy.ndarray): Positions of the first entry of each point, and
+        of the end of the last point.
+    indices (numpy.ndarray): Flat indexes, ``ix * ny + iy``, of the grid
+        values used by the interpolation.
+    weights (numpy.ndarray): Weights of the grid values.
+)__doc__")
+      .def("__len__", &InterpolationPlan::size,
+           R"__doc__(
+Get the number of points interpolated.
+)__doc__")
+      .def_property_readonly("shape", &InterpolationPlan::shape,
+                             R"__doc__(
+Get the shape of the grids handled by the plan.
+
+Returns:
+    tuple: The number of values along the X and Y axes.
+)__doc__")
+      .def_property_readonly(
+          "indptr",
+          [](const InterpolationPlan& self) -> pyinterp::Vector<int64_t> {
+            return self.indptr();
+          },
+          R"__doc__(
+Get the positions of the first entry of each point.
+
+Returns:
+    numpy.ndarray: The row pointers of the CSR matrix.
+)__doc__")
+      .def_property_readonly(
+          "indices",
+          [](const InterpolationPlan& self) -> pyinterp::Vector<int64_t> {
+            return self.indices();
+          },
+          R"__doc__(
+Get the flat indexes of the grid values.
+
+Returns:
+    numpy.ndarray: The column indexes of the CSR matrix.
+)__doc__")
+      .def_property_readonly(
+          "weights",
+          [](const InterpolationPlan& self) -> pyinterp::Vector<double> {
+            return self.weights();
+          },
+          R"__doc__(
+Get the weights of the grid values.
+
+Returns:
+    numpy.ndarray: The values of the CSR matrix.
+)__doc__")
+      .def("apply", &InterpolationPlan::apply<double>, py::arg("array"),
+           py::arg("normalize") = false, py::arg("num_threads") = 0,
+           py::arg("out") = py::none(),
+           R"__doc__(
+Interpolate the values of a grid.
+
+Args:
+    array (numpy.ndarray): Values of the grid, of the shape of the grids
+        handled by the plan.
+    normalize (bool, optional): If true, the undefined values of the grid are
+        ignored: the weights of the defined values are divided by their sum.
+        The points using only undefined values are set to NaN. Defaults to
+        ``False``.
+    num_threads (int, optional): The number of threads to use for the
+        computation. If 0 all CPUs are used. If 1 is given, no parallel
+        computing code is used at all, which is useful for debugging.
+        Defaults to ``0``.
+    out (numpy.ndarray, optional): C-contiguous array of shape ``(n, )`` and
+        of type float64 in which the interpolated values are written. If
+        None, a new array is allocated. Defaults to ``None``.
+Returns:
+    numpy.ndarray: Values interpolated, NaN for the points outside the grid,
+    i.e. ``out`` if provided.
+)__doc__")
+      .def("apply", &InterpolationPlan::apply<float>, py::arg("array"),
+           py::arg("normalize") = false, py::arg("num_threads") = 0,
+           py::arg("out") = py::none(),
+           R"__doc__(
+Interpolate the values of a grid stored in single precision, read without
+conversion.
+)__doc__")
+      .def(py::pickle(
+          [](const InterpolationPlan& self) { return self.getstate(); },
+          [](const py::tuple& state) {
+            return InterpolationPlan::setstate(state);
+          }));
+
+  m.def("bivariate_plan",
+        &pyinterp::bivariate_plan<geometry::EquatorialPoint2D, double>,
+        py::arg("x_axis"), py::arg("y_axis"), py::arg("x"), py::arg("y"),
+        py::arg("interpolator"), py::arg("bounds_error") = false,
+        py::arg("num_threads") = 0,
+        R"__doc__(
+Compute the plan of the bivariate interpolation of points on the grids
+defined by the given axes.
+
+Args:
+    x_axis (pyinterp.core.Axis): X-Axis of the grids.
+    y_axis (pyinterp.core.Axis): Y-Axis of the grids.
+    x (numpy.ndarray): X-values.
+    y (numpy.ndarray): Y-values.
+    interpolator (pyinterp.core.BivariateInterpolator2D): 2D interpolator,
+        which must be linear in the values of the grid, as the built-in
+        interpolators are.
+    bounds_error (bool, optional): If True, when interpolated values are
+        requested outside of the domain of the input axes (x,y), a ValueError
+        is raised. If False, then value is set to NaN.
+    num_threads (int, optional): The number of threads to use for the
+        computation. If 0 all CPUs are used. If 1 is given, no parallel
+        computing code is used at all, which is useful for debugging.
+        Defaults to ``0``.
+Returns:
+    pyinterp.core.InterpolationPlan: The interpolation plan.
+)__doc__");
+
+  m.def("conservative_plan", &pyinterp::conservative_plan, py::arg("source_x"),
+        py::arg("source_y"), py::arg("target_x"), py::arg("target_y"),
+        py::arg("wgs") = std::optional<pyinterp::geodetic::System>(),
+        py::arg("num_threads") = 0,
+        R"__doc__(
+Compute the plan of the first-order conservative regridding between two grids.
+
+The values of a grid are the means of the field over cells centered on the
+values of its axes and bounded by the middles of the consecutive values. The
+value of a target cell is the mean of the values of the source cells it
+intersects, weighted by the areas of the intersections. The weights of a target
+cell partially covered by the source grid sum to the covered fraction of its
+area; apply the plan with ``normalize=True`` to divide by this fraction.
+
+Args:
+    source_x (pyinterp.core.Axis): X-Axis of the source grid, sorted in
+        ascending order.
+    source_y (pyinterp.core.Axis): Y-Axis of the source grid, sorted in
+        ascending order.
+    target_x (pyinterp.core.Axis): X-Axis of the target grid.
+    target_y (pyinterp.core.Axis): Y-Axis of the target grid.
+    wgs (pyinterp.geodetic.System, optional): If given, the axes are
+        longitudes and latitudes, and the areas are computed on the spheroid
+        of this geodetic system. Otherwise, the areas are computed in the
+        Cartesian plane.
+    num_threads (int, optional): The number of threads to use for the
+        computation. If 0 all CPUs are used. If 1 is given, no parallel
+        computing code is used at all, which is useful for debugging.
+        Defaults to ``0``.
+Returns:
+    pyinterp.core.InterpolationPlan: The regridding plan, computing the values
+    of the flattened target grid.
+)__doc__");
+}
@@ -4,6 +4,11 @@
 // BSD-style license that can be found in the LICENSE file.
 #include <pybind11/pybind11.h>
 
+#include <algorithm>
+#include <functional>
+#include <string>
+#include <vector>
+
 #include "pyinterp/detail/gsl/error_handler.hpp"
 
 namespace py = pybind11;
@@ -18,26 +23,140 @@ extern void init_descriptive_statistics(py::module&);
 extern void init_fill(py::module&);
 extern void init_geodetic(py::module&);
 extern void init_geohash_class(py::module&);
+extern void init_geohash_index(py::module&);
 extern void init_geohash_int64(py::module&);
 extern void init_geohash_string(py::module&);
 extern void init_grid(py::module&);
 extern void init_histogram2d(py::module&);
+extern void init_interpolation_plan(py::module&);
+extern void init_pipeline(py::module&);
+extern void init_profiling(py::module&);
 extern void init_quadrivariate(py::module&);
 extern void init_rtree(py::module&);
 extern void init_spline(py::module&);
 extern void init_streaming_histogram(py::module&);
+extern void init_thread(py::module&);
 extern void init_trivariate(py::module&);
 
 static void init_geohash(py::module& m) {
-  auto int64 = m.def_submodule("int64", R"__doc__(
-GeoHash encoded as integer 64 bits
-----------------------------------
-)__doc__");
-
+  auto int64 = py::reinterpret_borrow<py::module>(m.attr("int64"));
   init_geohash_int64(int64);
   init_geohash_string(m);
+  init_geohash_index(m);
+}
+
+namespace {
+
+/// Registrations of a group of classes and functions of the module, run when
+/// one of their attributes is accessed for the first time: importing the
+/// module only costs the registrations of the groups used.
+struct Group {
+  /// Names of the attributes of the module defined by the group. A trailing
+  /// "*" matches any suffix.
+  std::vector<std::string> patterns;
+  /// Groups to register before this one.
+  std::vector<size_t> dependencies;
+  /// Registers the group.
+  std::function<void()> init;
+  /// True if the group has been registered.
+  bool loaded{false};
+
+  /// Returns true if the attribute "name" may be defined by this group.
+  [[nodiscard]] auto matches(const std::string& name) const -> bool {
+    return std::any_of(
+        patterns.begin(), patterns.end(), [&](const std::string& pattern) {
+          if (!pattern.empty() && pattern.back() == '*') {
+            return name.compare(0, pattern.size() - 1, pattern, 0,
+                                pattern.size() - 1) == 0;
+          }
+          return name == pattern;
+        });
+  }
+};
+
+/// Groups of the module. They are only accessed with the GIL held.
+auto groups() -> std::vector<Group>& {
+  static auto result = std::vector<Group>();
+  return result;
+}
+
+/// Registers a group, after the groups it depends on.
+auto load(const size_t index) -> void {
+  auto& group = groups()[index];
+  if (group.loaded) {
+    return;
+  }
+  group.loaded = true;
+  for (const auto& item : group.dependencies) {
+    load(item);
+  }
+  group.init();
+}
+
+/// Registers all the groups.
+auto load_all() -> void {
+  for (size_t ix = 0; ix < groups().size(); ++ix) {
+    load(ix);
+  }
+}
+
+/// Adds a group registering the attributes of the module "m" with the
+/// function "init". The module is referenced without being owned: it lives
+/// as long as the interpreter.
+auto add_group(py::module& m, void (*init)(py::module&),
+               std::vector<std::string> patterns = {},
+               std::vector<size_t> dependencies = {}) -> size_t {
+  auto handle = py::handle(m);
+  groups().push_back(Group{std::move(patterns), std::move(dependencies),
+                           [handle, init]() {
+                             auto module =
+                                 py::reinterpret_borrow<py::module>(handle);
+                             init(module);
+                           }});
+  return groups().size() - 1;
+}
+
+/// Raises the error reported when an attribute does not exist.
+[[noreturn]] auto attribute_error(const py::module& m, const std::string& name)
+    -> void {
+  throw py::attribute_error("module '" +
+                            m.attr("__name__").cast<std::string>() +
+                            "' has no attribute '" + name + "'");
 }
 
+/// Returns true if the attribute "name" of a module is defined. Unlike
+/// hasattr, the attributes registered on demand are not looked up.
+auto defined(const py::module& m, const std::string& name) -> bool {
+  return py::dict(m.attr("__dict__")).contains(name);
+}
+
+/// Lists the attributes of a module.
+auto attributes(const py::module& m) -> py::list {
+  return py::list(m.attr("__dict__"));
+}
+
+/// Registers the attributes of a submodule on first access.
+auto lazy_submodule(py::module& m, const size_t group) -> void {
+  auto handle = py::handle(m);
+  m.def("__getattr__", [handle, group](const std::string& name) {
+    auto module = py::reinterpret_borrow<py::module>(handle);
+    // The attributes looked up by the import system are not registered.
+    if (name.compare(0, 2, "__") != 0) {
+      load(group);
+      if (defined(module, name)) {
+        return py::object(module.attr(name.c_str()));
+      }
+    }
+    attribute_error(module, name);
+  });
+  m.def("__dir__", [handle, group]() {
+    load(group);
+    return attributes(py::reinterpret_borrow<py::module>(handle));
+  });
+}
+
+}  // namespace
+
 PYBIND11_MODULE(core, m) {
   m.doc() = R"__doc__(
 Core module
@@ -57,33 +176,110 @@ Geographic coordinate system
   auto geohash = m.def_submodule("geohash", R"__doc__(
 GeoHash encoding/decoding
 -------------------------
+)__doc__");
+
+  // The submodules are created when the module is imported, so that the
+  // import system finds them.
+  auto geohash_int64 = geohash.def_submodule("int64", R"__doc__(
+GeoHash encoded as integer 64 bits
+----------------------------------
 )__doc__");
 
   auto fill = m.def_submodule("fill", R"__doc__(
 Replace undefined values
 ------------------------
+)__doc__");
+
+  auto profiling = m.def_submodule("profiling", R"__doc__(
+Profiling of the hot paths of the library
+-----------------------------------------
 )__doc__");
 
   pyinterp::detail::gsl::set_error_handler();
 
+  // The axes and the utilities are registered when the module is imported.
   init_dateutils(dateutils);
-  init_geodetic(geodetic);
-
   init_axis(m);
-  init_binning(m);
-  init_histogram2d(m);
-  init_bivariate_interpolator(m);
-  init_descriptive_statistics(m);
-  init_grid(m);
-  init_bivariate(m);
-  init_trivariate(m);
-  init_quadrivariate(m);
-  init_bicubic(m);
-  init_fill(fill);
-  init_rtree(m);
-  init_streaming_histogram(m);
-
-  // geohash
-  init_geohash(geohash);
-  init_geohash_class(m);
+  init_profiling(profiling);
+  init_thread(m);
+
+  // The other classes and functions, most of them instantiated for several
+  // types, are registered by groups, on first access.
+  auto geodetic_group = add_group(geodetic, init_geodetic);
+  auto grid_group = add_group(
+      m,
+      [](py::module& module) {
+        init_bivariate_interpolator(module);
+        init_grid(module);
+      },
+      {"Grid*", "TemporalGrid*", "ChunkedGrid*", "TemporalChunkedGrid*",
+       "TiledGrid*", "Bilinear*", "BivariateInterpolator*",
+       "InverseDistanceWeighting*", "Nearest*", "TemporalBilinear*",
+       "TemporalBivariateInterpolator*", "TemporalInverseDistanceWeighting*",
+       "TemporalNearest*"});
+  add_group(m, init_bivariate,
+            {"bivariate_float*", "bivariate_int*", "bilinear_gradient_*",
+             "PreparedBivariate"},
+            {grid_group});
+  add_group(
+      m,
+      [](py::module& module) {
+        init_trivariate(module);
+        init_quadrivariate(module);
+      },
+      {"trivariate_*", "quadrivariate_*"}, {grid_group});
+  add_group(m, init_bicubic, {"bicubic_*", "spline_*"}, {grid_group});
+  add_group(m, init_interpolation_plan,
+            {"InterpolationPlan", "bivariate_plan", "conservative_plan"},
+            {grid_group, geodetic_group});
+  add_group(
+      m,
+      [](py::module& module) {
+        init_binning(module);
+        init_histogram2d(module);
+        init_pipeline(module);
+        init_descriptive_statistics(module);
+        init_streaming_histogram(module);
+      },
+      {"Binning*", "TemporalBinning*", "Histogram2D*", "Pipeline*",
+       "DescriptiveStatistics*", "StreamingHistogram*"},
+      {grid_group, geodetic_group});
+  add_group(m, init_rtree,
+            {"RTree*", "ShardedRTree*", "TemporalRTree*", "RadialBasisFunction",
+             "WindowFunction", "CovarianceFunction"},
+            {geodetic_group});
+  auto geohash_group = add_group(geohash, init_geohash, {}, {geodetic_group});
+  add_group(m, init_geohash_class, {"GeoHash"}, {geohash_group});
+  auto fill_group = add_group(fill, init_fill, {}, {grid_group});
+
+  lazy_submodule(geodetic, geodetic_group);
+  lazy_submodule(geohash, geohash_group);
+  lazy_submodule(geohash_int64, geohash_group);
+  lazy_submodule(fill, fill_group);
+
+#if PY_VERSION_HEX < 0x03070000
+  // The attributes of a module can be defined on demand from Python 3.7
+  // (PEP 562).
+  load_all();
+#else
+  auto handle = py::handle(m);
+  m.def("__getattr__", [handle](const std::string& name) {
+    auto module = py::reinterpret_borrow<py::module>(handle);
+    if (name.compare(0, 2, "__") != 0) {
+      for (size_t ix = 0; ix < groups().size(); ++ix) {
+        if (!groups()[ix].loaded && groups()[ix].matches(name)) {
+          load(ix);
+          if (defined(module, name)) {
+            return py::object(module.attr(name.c_str()));
+          }
+        }
+      }
+    }
+    attribute_error(module, name);
+  });
+  m.def("__dir__", [handle]() {
+    load_all();
+    return attributes(py::reinterpret_borrow<py::module>(handle));
+  });
+#endif
 }
@@ -0,0 +1,60 @@
+// Copyright (c) 2022 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+#include "pyinterp/pipeline.hpp"
+
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+namespace py = pybind11;
+
+template <typename Type>
+void implement_pipeline(py::module& m, const std::string& suffix) {
+  py::class_<pyinterp::Pipeline<Type>>(m, ("Pipeline" + suffix).c_str(),
+                                       R"__doc__(
+Feeds the samples of a sequence of chunks into several binned statistics and
+histograms.
+
+While a chunk is ingested, without the GIL, the next one is read from the
+iterator and converted. All the statistics are updated concurrently from the
+same chunk.
+)__doc__")
+      .def(py::init<std::vector<pyinterp::Binning2D<Type>*>,
+                    std::vector<pyinterp::Histogram2D<Type>*>, const bool,
+                    const size_t>(),
+           py::arg("binning") = std::vector<pyinterp::Binning2D<Type>*>(),
+           py::arg("histograms") = std::vector<pyinterp::Histogram2D<Type>*>(),
+           py::arg("simple") = true, py::arg("num_threads") = 0,
+           py::keep_alive<1, 2>(), py::keep_alive<1, 3>(),
+           R"__doc__(
+Default constructor.
+
+Args:
+    binning (list, optional): Binned statistics updated by the pipeline.
+    histograms (list, optional): Histograms updated by the pipeline.
+    simple (bool, optional): If true, a simple binning is used by the binned
+        statistics, otherwise a linear binning. Defaults to ``True``.
+    num_threads (int, optional): The number of threads to use for the
+        computation. If 0 all CPUs are used. If 1 is given, no parallel
+        computing code is used at all, which is useful for debugging.
+        Defaults to ``0``.
+)__doc__")
+      .def("__len__", &pyinterp::Pipeline<Type>::size,
+           R"__doc__(
+Gets the number of statistics updated by the pipeline.
+)__doc__")
+      .def("run", &pyinterp::Pipeline<Type>::run, py::arg("chunks"),
+           R"__doc__(
+Ingests all the chunks of samples.
+
+Args:
+    chunks (iterable): Chunks of samples: tuples of three one-dimensional
+        arrays, the X and Y coordinates and the values of the samples.
+)__doc__");
+}
+
+void init_pipeline(py::module& m) {
+  implement_pipeline<double>(m, "Float64");
+  implement_pipeline<float>(m, "Float32");
+}
@@ -0,0 +1,70 @@
+// Copyright (c) 2022 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+#include "pyinterp/detail/profiling.hpp"
+
+#include <pybind11/pybind11.h>
+
+namespace py = pybind11;
+namespace profiling = pyinterp::detail::profiling;
+
+void init_profiling(py::module& m) {
+  m.def(
+      "enable", [](const bool value) { profiling::enable(value); },
+      py::arg("value") = true,
+      R"__doc__(
+Turn on or off the profiling of the library.
+
+When the profiling is off, which is the default, the instrumented functions
+only check its state.
+
+Args:
+    value (bool, optional): True to turn on the profiling, False to turn it
+        off. Defaults to ``True``.
+)__doc__")
+      .def("is_enabled", &profiling::enabled, R"__doc__(
+Return True if the profiling of the library is turned on.
+)__doc__")
+      .def("reset", &profiling::reset, R"__doc__(
+Set all the counters to zero.
+)__doc__")
+      .def(
+          "snapshot",
+          []() -> py::dict {
+            auto result = py::dict();
+            auto values = profiling::snapshot();
+            for (size_t ix = 0; ix < profiling::kCounterCount; ++ix) {
+              const auto& item = values[ix];
+              auto counter = py::dict();
+              counter["calls"] = item.calls;
+              counter["seconds"] = item.seconds;
+              counter["ticks"] = item.ticks;
+              counter["allocations"] = item.allocations;
+              counter["bytes"] = item.bytes;
+              counter["peak_bytes"] = item.peak_bytes;
+              result[profiling::name(static_cast<profiling::Counter>(ix))] =
+                  counter;
+            }
+            return result;
+          },
+          R"__doc__(
+Get the values of the counters, summed over all the threads, since the last
+reset.
+
+The timings are inclusive: the time spent in a function includes the time
+spent in the instrumented functions it calls (e.g. ``load_frame`` includes
+``axis.find_indexes``).
+
+The memory is accounted for the buffers allocated by the instrumented
+functions: the number of ``allocations``, the ``bytes`` allocated, and the
+largest number of bytes held at the same time by all the threads,
+``peak_bytes``. After a reset, the peak starts from the memory still held.
+
+Returns:
+    dict: A dictionary whose keys are the names of the instrumented hot
+    paths, and whose values are dictionaries holding the number of ``calls``,
+    the time spent, in ``seconds``, this time in ``ticks`` of the timer, and
+    the memory allocated: ``allocations``, ``bytes`` and ``peak_bytes``.
+)__doc__");
+}
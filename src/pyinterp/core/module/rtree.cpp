@@ -11,6 +11,9 @@
 
 #include <sstream>
 
+#include "pyinterp/sharded_rtree.hpp"
+#include "pyinterp/temporal_rtree.hpp"
+
 namespace py = pybind11;
 
 template <size_t N>
@@ -84,6 +87,7 @@ Returns:
            "Removes all values stored in the container.")
       .def("packing", &pyinterp::RTree<CoordinateType, Type, N>::packing,
            py::arg("coordinates"), py::arg("values"),
+           py::arg("num_threads") = 0,
            (R"__doc__(
 The tree is created using packing algorithm (The old data is erased
 before construction.)
@@ -93,11 +97,23 @@ Args:
             coordinates_help<N>() + R"__doc__(
     values (numpy.ndarray): An array of size ``(n)`` containing the values
         associated with the coordinates provided.
+    num_threads (int, optional): The number of threads to use for the
+        computation. If 0 all CPUs are used. If 1 is given, no parallel
+        computing code is used at all, which is useful for debugging.
+        Defaults to ``0``.
+
+.. note::
+
+    The packed points are stored in a static index, faster to query than the
+    tree built by :py:meth:`insert`. The points inserted or removed afterwards
+    are buffered and merged into the queries, until they are numerous enough
+    to repack the whole index.
 )__doc__")
                .c_str(),
            py::call_guard<py::gil_scoped_release>())
       .def("insert", &pyinterp::RTree<CoordinateType, Type, N>::insert,
            py::arg("coordinates"), py::arg("values"),
+           py::arg("num_threads") = 0,
            (R"__doc__(
 Insert new data into the search tree.
 
@@ -106,18 +122,42 @@ Args:
             coordinates_help<N>() + R"__doc__(
     values (numpy.ndarray): An array of size ``(n)`` containing the values
         associated with the coordinates provided.
+    num_threads (int, optional): The number of threads to use for the
+        computation. If 0 all CPUs are used. If 1 is given, no parallel
+        computing code is used at all, which is useful for debugging.
+        Defaults to ``0``.
 )__doc__")
                .c_str(),
            py::call_guard<py::gil_scoped_release>())
+      .def("remove", &pyinterp::RTree<CoordinateType, Type, N>::remove,
+           py::arg("predicate"), py::arg("num_threads") = 0,
+           R"__doc__(
+Removes the values selected by a predicate.
+
+Args:
+    predicate (callable): Function called with a matrix ``(n, ndims)``
+        containing the coordinates of the values stored (longitudes,
+        latitudes, altitudes and other coordinates) and a vector ``(n)``
+        containing the values, returning a boolean vector ``(n)`` flagging
+        the values to remove.
+    num_threads (int, optional): The number of threads to use for the
+        computation. If 0 all CPUs are used. If 1 is given, no parallel
+        computing code is used at all, which is useful for debugging.
+        Defaults to ``0``.
+Returns:
+    int: The number of values removed.
+)__doc__")
       .def(
           "query",
           [](const pyinterp::RTree<CoordinateType, Type, N>& self,
-             const py::array_t<CoordinateType>& coordinates, const uint32_t k,
-             const bool within, const size_t num_threads) -> py::tuple {
-            return self.query(coordinates, k, within, num_threads);
+             const py::array& coordinates, const uint32_t k,
+             const bool within, const size_t num_threads,
+             const pyinterp::OutputPair& out, const double eps) -> py::tuple {
+            return self.query(coordinates, k, within, num_threads, out, eps);
           },
           py::arg("coordinates"), py::arg("k") = 4, py::arg("within") = false,
-          py::arg("num_threads") = 0,
+          py::arg("num_threads") = 0, py::arg("out") = py::none(),
+          py::arg("eps") = 0.0,
           (R"__doc__(
 Search for the nearest K nearest neighbors of a given point.
 
@@ -133,11 +173,21 @@ Args:
         computation. If 0 all CPUs are used. If 1 is given, no parallel
         computing code is used at all, which is useful for debugging.
         Defaults to ``0``.
+    out (tuple, optional): Pair of C-contiguous matrices of shape ``(n, k)``,
+        of the types of the matrices returned, in which the distances and
+        the values of the neighbors are written. If None, new matrices are
+        allocated. Defaults to ``None``.
+    eps (float, optional): Tolerance of an approximate search of the
+        neighbors. The parts of the index that cannot contain a point closer
+        than the worst neighbor found divided by ``1 + eps`` are not
+        explored: the i-th neighbor returned is at most ``1 + eps`` times
+        farther than the true i-th nearest neighbor. Defaults to ``0``, an
+        exact search.
 Returns:
     tuple: A tuple containing a matrix describing for each provided position,
     the distance, in meters, between the provided position and the found
     neighbors and a matrix containing the value of the different neighbors
-    found for all provided positions.
+    found for all provided positions (``out`` if provided).
 )__doc__")
               .c_str())
       .def(
@@ -145,7 +195,8 @@ Returns:
           &pyinterp::RTree<CoordinateType, Type, N>::inverse_distance_weighting,
           py::arg("coordinates"), py::arg("radius"), py::arg("k") = 9,
           py::arg("p") = 2, py::arg("within") = true,
-          py::arg("num_threads") = 0,
+          py::arg("num_threads") = 0, py::arg("out") = py::none(),
+          py::arg("eps") = 0.0,
           (R"__doc__(
 Interpolation of the value at the requested position by inverse distance
 weighting method.
@@ -166,9 +217,19 @@ Args:
         computation. If 0 all CPUs are used. If 1 is given, no parallel
         computing code is used at all, which is useful for debugging.
         Defaults to ``0``.
+    out (tuple, optional): Pair of C-contiguous vectors of shape ``(n, )``,
+        of the types of the vectors returned, in which the interpolated
+        values and the number of neighbors used are written. If None, new
+        vectors are allocated. Defaults to ``None``.
+    eps (float, optional): Tolerance of an approximate search of the
+        neighbors. The parts of the index that cannot contain a point closer
+        than the worst neighbor found divided by ``1 + eps`` are not
+        explored: the i-th neighbor returned is at most ``1 + eps`` times
+        farther than the true i-th nearest neighbor. Defaults to ``0``, an
+        exact search.
 Returns:
     tuple: The interpolated value and the number of neighbors used in the
-    calculation.
+    calculation (``out`` if provided).
 )__doc__")
               .c_str())
       .def(
@@ -200,6 +261,11 @@ Args:
         of the approximation.
     within (bool, optional): If true, the method ensures that the neighbors
         found are located around the point of interest. Defaults to ``true``.
+    table_size (int, optional): If not zero, the window function is
+        tabulated over its support with this number of intervals, then
+        evaluated by linear interpolation, which is faster. The error
+        decreases with the square of the size of the table. Defaults to
+        ``0``: the window function is evaluated for each neighbor.
     num_threads (int, optional): The number of threads to use for the
         computation. If 0 all CPUs are used. If 1 is given, no parallel
         computing code is used at all, which is useful for debugging.
@@ -209,12 +275,81 @@ Returns:
     calculation.
 )__doc__")
               .c_str())
+      .def("kriging", &pyinterp::RTree<CoordinateType, Type, N>::kriging,
+           py::arg("coordinates"), py::arg("radius"), py::arg("k") = 9,
+           py::arg("covariance") = pyinterp::CovarianceFunction::kMatern32,
+           py::arg("sigma") = 1, py::arg("lambda_") = 1,
+           py::arg("nugget") = 0, py::arg("within") = true,
+           py::arg("num_threads") = 0,
+           (R"__doc__(
+Estimation of the value at the requested position by ordinary kriging.
+
+Args:
+    )__doc__" +
+            coordinates_help<N>() + R"__doc__(
+    radius (float, optional): The maximum radius of the search (m).
+        Default to the largest value that can be represented on a float.
+    k (int, optional): The number of nearest neighbors to be used for
+        calculating the estimated value. Defaults to ``9``.
+    covariance (pyinterp.core.CovarianceFunction, optional): The covariance
+        function, based on the distance between points. Default to
+        :py:attr:`pyinterp.core.CovarianceFunction.Matern32`.
+    sigma (float, optional): The variance of the process (sill of the
+        covariance function). Defaults to ``1``.
+    lambda_ (float, optional): The length scale of the covariance function
+        (m). Defaults to ``1``.
+    nugget (float, optional): The variance of the measurement noise.
+        Defaults to ``0``.
+    within (bool, optional): If true, the method ensures that the neighbors
+        found are located around the point of interest. Defaults to ``true``.
+    num_threads (int, optional): The number of threads to use for the
+        computation. If 0 all CPUs are used. If 1 is given, no parallel
+        computing code is used at all, which is useful for debugging.
+        Defaults to ``0``.
+Returns:
+    tuple: The estimated value, the variance of the estimation error and the
+    number of neighbors used for the calculation.
+)__doc__")
+               .c_str())
+      .def("compact_radial_basis_function",
+           &pyinterp::RTree<CoordinateType, Type, N>::
+               compact_radial_basis_function,
+           py::arg("coordinates"), py::arg("radius"), py::arg("smooth") = 0,
+           py::arg("max_iterations") = 1000, py::arg("tolerance") = 1e-10,
+           py::arg("num_threads") = 0,
+           (R"__doc__(
+Interpolation of the value at the requested position by a radial basis
+function with compact support, solved over all the points of the tree.
+
+The Wendland function used is zero beyond the support radius: the linear system
+is sparse, and is solved once for all the requested positions.
+
+Args:
+    )__doc__" +
+            coordinates_help<N>() + R"__doc__(
+    radius (float): The radius of the support of the function (m).
+    smooth (float, optional): Values greater than zero increase the smoothness
+        of the approximation. Defaults to ``0``.
+    max_iterations (int, optional): Maximum number of iterations of the
+        conjugate gradient. Defaults to ``1000``.
+    tolerance (float, optional): Relative residual error below which the
+        solution is accepted. Defaults to ``1e-10``.
+    num_threads (int, optional): The number of threads to use for the
+        computation. If 0 all CPUs are used. If 1 is given, no parallel
+        computing code is used at all, which is useful for debugging.
+        Defaults to ``0``.
+Returns:
+    tuple: The interpolated value and the number of neighbors used for the
+    calculation.
+)__doc__")
+               .c_str())
       .def("window_function",
            &pyinterp::RTree<CoordinateType, Type, N>::window_function,
            py::arg("coordinates"), py::arg("radius"), py::arg("k") = 9,
            py::arg("wf") = pyinterp::WindowFunction::kHamming,
            py::arg("arg") = py::none(), py::arg("within") = true,
-           py::arg("num_threads") = 0,
+           py::arg("table_size") = 0, py::arg("num_threads") = 0,
+           py::arg("eps") = 0.0,
            (R"__doc__(
 Interpolation of the value at the requested position by window function.
 
@@ -235,11 +370,45 @@ Args:
         computation. If 0 all CPUs are used. If 1 is given, no parallel
         computing code is used at all, which is useful for debugging.
         Defaults to ``0``.
+    eps (float, optional): Tolerance of an approximate search of the
+        neighbors. The parts of the index that cannot contain a point closer
+        than the worst neighbor found divided by ``1 + eps`` are not
+        explored: the i-th neighbor returned is at most ``1 + eps`` times
+        farther than the true i-th nearest neighbor. Defaults to ``0``, an
+        exact search.
 Returns:
     tuple: The interpolated value and the number of neighbors used for the
     calculation.
 )__doc__")
                .c_str())
+      .def("save", &pyinterp::RTree<CoordinateType, Type, N>::save,
+           py::arg("path"), R"__doc__(
+Writes the index to a file that can be mapped in memory by :py:meth:`load`.
+
+Args:
+    path (str): Path to the file to create.
+
+.. note::
+
+    The file stores the memory representation of the index: it can only be
+    loaded on a machine with the same architecture.
+)__doc__",
+           py::call_guard<py::gil_scoped_release>())
+      .def_static("load", &pyinterp::RTree<CoordinateType, Type, N>::load,
+                  py::arg("path"), R"__doc__(
+Opens an index written by :py:meth:`save`.
+
+The file is mapped read-only in memory instead of being read: the index is
+usable immediately and the memory pages holding it are shared between the
+processes opening the same file. The file must not be modified while the index
+is in use.
+
+Args:
+    path (str): Path to the file to open.
+Returns:
+    The index stored in the file.
+)__doc__",
+                  py::call_guard<py::gil_scoped_release>())
       .def(py::pickle(
           [](const pyinterp::RTree<CoordinateType, Type, N>& self) {
             return self.getstate();
@@ -249,6 +418,242 @@ Returns:
           }));
 }
 
+template <typename CoordinateType, typename Type>
+static void implement_temporal_rtree(py::module& m,
+                                     const char* const suffix) {
+  using TemporalRTree = pyinterp::TemporalRTree<CoordinateType, Type>;
+  auto name = "TemporalRTree3D" + std::string(suffix);
+  py::class_<TemporalRTree>(m, name.c_str(), R"__doc__(
+Spatio-temporal index for geodetic scalar values
+)__doc__")
+      .def(py::init<std::optional<pyinterp::geodetic::System>, int64_t>(),
+           py::arg("system"), py::arg("period"),
+           R"__doc__(
+Default constructor
+
+Args:
+    system (pyinterp.core.geodetic.System, optional): WGS of the
+        coordinate system used to transform equatorial spherical positions
+        (longitudes, latitudes, altitude) into ECEF coordinates. If not set
+        the geodetic system used is WGS-84.
+    period (int): Duration of the partitions of the index, in the unit of
+        the times handled.
+)__doc__")
+      .def_property_readonly("period", &TemporalRTree::period,
+                             "Duration of the partitions of the index.")
+      .def("partitions", &TemporalRTree::partitions,
+           "Returns the number of partitions of the index.")
+      .def("__len__", &TemporalRTree::size,
+           "Called to implement the built-in function ``len()``")
+      .def(
+          "__bool__",
+          [](const TemporalRTree& self) { return !self.empty(); },
+          "Called to implement truth value testing and the built-in operation "
+          "``bool()``.")
+      .def("clear", &TemporalRTree::clear,
+           "Removes all values stored in the container.")
+      .def("packing", &TemporalRTree::packing, py::arg("coordinates"),
+           py::arg("times"), py::arg("values"), py::arg("num_threads") = 0,
+           (R"__doc__(
+Replaces the content of the index by the observations provided.
+
+Args:
+    )__doc__" +
+            coordinates_help<3>() + R"__doc__(
+    times (numpy.ndarray): An array of size ``(n)`` containing the times of
+        the observations, as integers.
+    values (numpy.ndarray): An array of size ``(n)`` containing the values
+        associated with the coordinates provided.
+    num_threads (int, optional): The number of threads to use for the
+        computation. If 0 all CPUs are used. If 1 is given, no parallel
+        computing code is used at all, which is useful for debugging.
+        Defaults to ``0``.
+)__doc__")
+               .c_str())
+      .def("query", &TemporalRTree::query, py::arg("coordinates"),
+           py::arg("times"), py::arg("window"), py::arg("k") = 4,
+           py::arg("num_threads") = 0,
+           (R"__doc__(
+Search for the K nearest neighbors of the given points, observed within a
+time window.
+
+Args:
+    )__doc__" +
+            coordinates_help<3>() + R"__doc__(
+    times (numpy.ndarray): An array of size ``(n)`` containing the times of
+        the points of interest.
+    window (int): Half-width of the time window: the neighbors of a point
+        observed at ``t`` are searched among the observations made between
+        ``t - window`` and ``t + window``.
+    k (int, optional): The number of nearest neighbors to be searched.
+        Defaults to ``4``.
+    num_threads (int, optional): The number of threads to use for the
+        computation. If 0 all CPUs are used. If 1 is given, no parallel
+        computing code is used at all, which is useful for debugging.
+        Defaults to ``0``.
+Returns:
+    tuple: The distances, in meters, between the points and their
+    neighbors, and the values of the neighbors. The missing neighbors are
+    set to ``-1``.
+)__doc__")
+               .c_str())
+      .def("inverse_distance_weighting",
+           &TemporalRTree::inverse_distance_weighting, py::arg("coordinates"),
+           py::arg("times"), py::arg("window"), py::arg("radius") = py::none(),
+           py::arg("k") = 9, py::arg("p") = 2, py::arg("num_threads") = 0,
+           (R"__doc__(
+Interpolation of the values at the requested positions and times by inverse
+distance weighting of the observations made within a time window.
+
+Args:
+    )__doc__" +
+            coordinates_help<3>() + R"__doc__(
+    times (numpy.ndarray): An array of size ``(n)`` containing the times of
+        the points of interest.
+    window (int): Half-width of the time window.
+    radius (float, optional): The maximum radius of the search (m).
+        Defaults The maximum distance between two points.
+    k (int, optional): The number of nearest neighbors to be used for
+        calculating the interpolated value. Defaults to ``9``.
+    p (float, optional): The power parameters. Defaults to ``2``.
+    num_threads (int, optional): The number of threads to use for the
+        computation. If 0 all CPUs are used. If 1 is given, no parallel
+        computing code is used at all, which is useful for debugging.
+        Defaults to ``0``.
+Returns:
+    tuple: The interpolated value and the number of neighbors used in the
+    calculation.
+)__doc__")
+               .c_str());
+}
+
+template <typename CoordinateType, typename Type>
+static void implement_sharded_rtree(py::module& m, const char* const suffix) {
+  using ShardedRTree = pyinterp::ShardedRTree<CoordinateType, Type>;
+  auto name = "ShardedRTree3D" + std::string(suffix);
+  py::class_<ShardedRTree>(m, name.c_str(), R"__doc__(
+Spatial index for geodetic scalar values sharded by geohash
+)__doc__")
+      .def(py::init<std::optional<pyinterp::geodetic::System>, uint32_t>(),
+           py::arg("system"), py::arg("precision"),
+           R"__doc__(
+Default constructor
+
+Args:
+    system (pyinterp.core.geodetic.System, optional): WGS of the
+        coordinate system used to transform equatorial spherical positions
+        (longitudes, latitudes, altitude) into ECEF coordinates. If not set
+        the geodetic system used is WGS-84.
+    precision (int): Number of bits of the geohash identifying the shards,
+        within ``[1, 64]``.
+)__doc__")
+      .def_property_readonly("precision", &ShardedRTree::precision,
+                             "Number of bits of the geohash identifying the "
+                             "shards.")
+      .def("shards", &ShardedRTree::shards,
+           "Returns the number of shards of the index.")
+      .def("keys", &ShardedRTree::keys,
+           "Returns the geohash of the shards, sorted in ascending order.")
+      .def("shard_size", &ShardedRTree::shard_size, py::arg("key"),
+           "Returns the number of values stored in a shard.")
+      .def("__len__", &ShardedRTree::size,
+           "Called to implement the built-in function ``len()``")
+      .def(
+          "__bool__",
+          [](const ShardedRTree& self) { return !self.empty(); },
+          "Called to implement truth value testing and the built-in operation "
+          "``bool()``.")
+      .def("clear", &ShardedRTree::clear,
+           "Removes all values stored in the container.")
+      .def("packing", &ShardedRTree::packing, py::arg("coordinates"),
+           py::arg("values"), py::arg("num_threads") = 0,
+           (R"__doc__(
+Replaces the content of the index by the values provided, split into shards
+by the geohash of their position.
+
+Args:
+    )__doc__" +
+            coordinates_help<3>() + R"__doc__(
+    values (numpy.ndarray): An array of size ``(n)`` containing the values
+        associated with the coordinates provided.
+    num_threads (int, optional): The number of threads to use for the
+        computation. If 0 all CPUs are used. If 1 is given, no parallel
+        computing code is used at all, which is useful for debugging.
+        Defaults to ``0``.
+)__doc__")
+               .c_str())
+      .def("query", &ShardedRTree::query, py::arg("coordinates"),
+           py::arg("k") = 4, py::arg("radius") = py::none(),
+           py::arg("num_threads") = 0,
+           (R"__doc__(
+Search for the K nearest neighbors of the given points in the shard of the
+cell containing each point and, if the neighbors can be located beyond its
+edges, in the shards of the adjacent cells.
+
+Args:
+    )__doc__" +
+            coordinates_help<3>() + R"__doc__(
+    k (int, optional): The number of nearest neighbors to be searched.
+        Defaults to ``4``.
+    radius (float, optional): The maximum radius of the search (m).
+        Defaults The maximum distance between two points.
+    num_threads (int, optional): The number of threads to use for the
+        computation. If 0 all CPUs are used. If 1 is given, no parallel
+        computing code is used at all, which is useful for debugging.
+        Defaults to ``0``.
+Returns:
+    tuple: The distances, in meters, between the points and their
+    neighbors, and the values of the neighbors. The missing neighbors are
+    set to ``-1``.
+)__doc__")
+               .c_str())
+      .def("inverse_distance_weighting",
+           &ShardedRTree::inverse_distance_weighting, py::arg("coordinates"),
+           py::arg("radius") = py::none(), py::arg("k") = 9,
+           py::arg("p") = 2, py::arg("num_threads") = 0,
+           (R"__doc__(
+Interpolation of the values at the requested positions by inverse distance
+weighting of the neighbors found in the shards.
+
+Args:
+    )__doc__" +
+            coordinates_help<3>() + R"__doc__(
+    radius (float, optional): The maximum radius of the search (m).
+        Defaults The maximum distance between two points.
+    k (int, optional): The number of nearest neighbors to be used for
+        calculating the interpolated value. Defaults to ``9``.
+    p (float, optional): The power parameters. Defaults to ``2``.
+    num_threads (int, optional): The number of threads to use for the
+        computation. If 0 all CPUs are used. If 1 is given, no parallel
+        computing code is used at all, which is useful for debugging.
+        Defaults to ``0``.
+Returns:
+    tuple: The interpolated value and the number of neighbors used in the
+    calculation.
+)__doc__")
+               .c_str())
+      .def("save", &ShardedRTree::save, py::arg("key"), py::arg("path"),
+           R"__doc__(
+Writes a shard to a file that can be mapped in memory by :py:meth:`load`.
+
+Args:
+    key (int): Geohash of the shard to write.
+    path (str): Path to the file to create.
+)__doc__",
+           py::call_guard<py::gil_scoped_release>())
+      .def("load", &ShardedRTree::load, py::arg("key"), py::arg("path"),
+           R"__doc__(
+Opens a shard written by :py:meth:`save`, replacing the shard of the same
+geohash. The file is mapped read-only in memory and must not be modified while
+the index is in use.
+
+Args:
+    key (int): Geohash of the shard to open.
+    path (str): Path to the file to open.
+)__doc__",
+           py::call_guard<py::gil_scoped_release>());
+}
+
 void init_rtree(py::module& m) {
   py::enum_<pyinterp::RadialBasisFunction>(m, "RadialBasisFunction",
                                            "Radial basis functions")
@@ -267,6 +672,23 @@ void init_rtree(py::module& m) {
       .value("ThinPlate", pyinterp::RadialBasisFunction::ThinPlate,
              R"(:math:`\varphi(r) = r^2 \ln(r)`.)");
 
+  py::enum_<pyinterp::CovarianceFunction>(m, "CovarianceFunction",
+                                          "Covariance functions")
+      .value("Matern12", pyinterp::CovarianceFunction::kMatern12,
+             R"(:math:`C(d) = \sigma e^{-\frac{d}{\lambda}}`)")
+      .value("Matern32", pyinterp::CovarianceFunction::kMatern32,
+             R"(:math:`C(d) = \sigma (1 + \frac{\sqrt{3} d}{\lambda}) )"
+             R"(e^{-\frac{\sqrt{3} d}{\lambda}}`)")
+      .value("Matern52", pyinterp::CovarianceFunction::kMatern52,
+             R"(:math:`C(d) = \sigma (1 + \frac{\sqrt{5} d}{\lambda} + )"
+             R"(\frac{5 d^2}{3 \lambda^2}) e^{-\frac{\sqrt{5} d}{\lambda}}`)")
+      .value("Gaussian", pyinterp::CovarianceFunction::kGaussian,
+             R"(:math:`C(d) = \sigma e^{-\frac{d^2}{2 \lambda^2}}`)")
+      .value("Spherical", pyinterp::CovarianceFunction::kSpherical,
+             R"(:math:`C(d) = \left\{\begin{array}{ll} )"
+             R"(\sigma (1 - \frac{3 d}{2 \lambda} + \frac{d^3}{2 \lambda^3}), )"
+             R"(& d \lt \lambda \\ 0, & d \ge \lambda \end{array} \right\}`)");
+
   py::enum_<pyinterp::WindowFunction>(m, "WindowFunction", "Window functions")
       .value("Blackman", pyinterp::WindowFunction::kBlackman,
              R"(:math:`w(d) = 0.42659 - 0.49656 \cos(\frac{\pi (d + r)}{r}) + "
@@ -282,6 +704,10 @@ void init_rtree(py::module& m) {
              "0.277263158 \cos(\frac{2 \pi (d + r)}{r}) - "
              "0.083578947 \cos(\frac{3 \pi (d + r)}{r}) + "
              "0.006947368 \cos(\frac{4 \pi (d + r)}{r})`)")
+      .value("Gaussian", pyinterp::WindowFunction::kGaussian,
+             R"(:math:`w(d) = \exp(-\frac{d^2}{2 \sigma^2})`, with )"
+             R"(:math:`\sigma` the optional argument, :math:`\frac{r}{2}` )"
+             R"(by default)")
       .value("Hamming", pyinterp::WindowFunction::kHamming,
              R"(:math:`w(d) = 0.53836 - 0.46164 \cos(\frac{\pi (d + r)}{r})`)")
       .value("Lanczos", pyinterp::WindowFunction::kLanczos,
@@ -312,4 +738,9 @@ void init_rtree(py::module& m) {
 
   implement_rtree<double, double, 3>(m, "Float64");
   implement_rtree<float, float, 3>(m, "Float32");
+  implement_rtree<float, double, 3>(m, "Float32Float64");
+  implement_temporal_rtree<double, double>(m, "Float64");
+  implement_temporal_rtree<float, float>(m, "Float32");
+  implement_sharded_rtree<double, double>(m, "Float64");
+  implement_sharded_rtree<float, float>(m, "Float32");
 }
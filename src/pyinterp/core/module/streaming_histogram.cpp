@@ -84,6 +84,22 @@ Args:
     q (float): Quantile to compute.
 Returns:
     numpy.ndarray: sum of samples.
+      )__doc__")
+      .def("quantiles", &pyinterp::StreamingHistogram<Type>::quantiles,
+           py::arg("q"), py::arg("num_threads") = 0,
+           R"__doc__(
+Returns several quantiles of samples, computed in a single pass over each
+histogram.
+
+Args:
+    q (numpy.ndarray): Quantiles to compute.
+    num_threads (int, optional): The number of threads to use for the
+        computation. If 0 all CPUs are used. If 1 is given, no parallel
+        computing code is used at all, which is useful for debugging.
+        Defaults to ``0``.
+Returns:
+    numpy.ndarray: quantiles of samples, along a last dimension of the
+    size of ``q``.
       )__doc__")
       .def("resize", &pyinterp::StreamingHistogram<Type>::resize,
            "Resize the maximum number of bins.")
@@ -0,0 +1,57 @@
+// Copyright (c) 2022 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+#include "pyinterp/detail/thread.hpp"
+
+#include <pybind11/pybind11.h>
+
+namespace py = pybind11;
+namespace detail = pyinterp::detail;
+
+void init_thread(py::module& m) {
+  m.def("available_cpus", &detail::available_cpus, R"__doc__(
+Get the number of CPUs the process may run on.
+
+This is the number of CPUs of the affinity mask of the process, limited by the
+CPU quota of its control group (e.g. the CPU limit of a Kubernetes pod), if
+any.
+
+Returns:
+    int: The number of CPUs available.
+)__doc__")
+      .def("get_num_threads", &detail::get_num_threads, R"__doc__(
+Get the number of threads used by the functions called with
+``num_threads=0``.
+
+Returns:
+    int: The number of threads.
+)__doc__")
+      .def(
+          "set_num_threads",
+          [](const size_t num_threads, const bool pin) {
+            py::gil_scoped_release release;
+            detail::set_num_threads(num_threads, pin);
+          },
+          py::arg("num_threads") = 0, py::arg("pin") = false, R"__doc__(
+Set the number of threads used by the functions called with
+``num_threads=0``.
+
+The pool of threads shared by the library is resized accordingly. Lower this
+number when several processes share the CPUs of a node, for example several
+Dask workers.
+
+Args:
+    num_threads (int, optional): The number of threads. If 0, the number of
+        CPUs available is used. Defaults to ``0``.
+    pin (bool, optional): If true, each thread of the pool is bound to one
+        of the CPUs available, the threads being spread over the NUMA nodes.
+        This option is only supported on Linux. Defaults to ``False``.
+)__doc__")
+      .def(
+          "threads_pinned",
+          []() -> bool { return detail::ThreadPool::instance()->pinned(); },
+          R"__doc__(
+Return True if the threads of the pool are bound to CPUs.
+)__doc__");
+}
@@ -6,6 +6,8 @@
 
 #include <pybind11/pybind11.h>
 
+#include "pyinterp/packed_grid.hpp"
+
 namespace py = pybind11;
 namespace geometry = pyinterp::detail::geometry;
 
@@ -18,4 +20,19 @@ void init_trivariate(py::module& m) {
                                  int64_t, double>(m, "Temporal", "Float64");
   pyinterp::implement_trivariate<geometry::TemporalEquatorial2D, double,
                                  int64_t, float>(m, "Temporal", "Float32");
+
+  pyinterp::implement_trivariate<
+      geometry::EquatorialPoint3D, double, double, int16_t,
+      pyinterp::PackedGrid3D<pyinterp::ScaledInt16, double>>(m, "", "Int16");
+  pyinterp::implement_trivariate<
+      geometry::EquatorialPoint3D, double, double, uint16_t,
+      pyinterp::PackedGrid3D<pyinterp::Float16, double>>(m, "", "Float16");
+  pyinterp::implement_trivariate<
+      geometry::TemporalEquatorial2D, double, int64_t, int16_t,
+      pyinterp::PackedGrid3D<pyinterp::ScaledInt16, int64_t>>(m, "Temporal",
+                                                               "Int16");
+  pyinterp::implement_trivariate<
+      geometry::TemporalEquatorial2D, double, int64_t, uint16_t,
+      pyinterp::PackedGrid3D<pyinterp::Float16, int64_t>>(m, "Temporal",
+                                                           "Float16");
 }
@@ -0,0 +1,17 @@
+from typing import Dict, Union
+
+
+def enable(value: bool = ...) -> None:
+    ...
+
+
+def is_enabled() -> bool:
+    ...
+
+
+def reset() -> None:
+    ...
+
+
+def snapshot() -> Dict[str, Dict[str, Union[float, int]]]:
+    ...
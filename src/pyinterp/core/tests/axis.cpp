@@ -6,7 +6,10 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <limits>
 #include <memory>
+#include <vector>
 
 namespace detail = pyinterp::detail;
 
@@ -734,3 +737,304 @@ TYPED_TEST(AxisTest, find_nearest_index) {
   EXPECT_EQ(axis.find_nearest_index(-182, false), 0);
   EXPECT_EQ(axis.find_nearest_index(-184, false), 71);
 }
+
+TEST(axis, find_cells) {
+  // The cells found on a regular axis must be consistent with the indexes
+  // returned by find_indexes for all the points framed by two elements.
+  for (auto is_circle : {false, true}) {
+    auto axis = detail::Axis<double>(-180, 179, 360, 1e-6, is_circle);
+    const auto* container = axis.regular_container();
+    ASSERT_NE(container, nullptr);
+
+    auto coordinates = std::vector<double>();
+    for (auto x = -181.0; x <= 181.0; x += 0.25) {
+      coordinates.push_back(axis.normalize_coordinate(x));
+    }
+    coordinates.push_back(179.0);
+    auto cells = std::vector<int64_t>(coordinates.size());
+    container->find_cells(coordinates.data(), cells.data(), coordinates.size());
+
+    for (size_t ix = 0; ix < coordinates.size(); ++ix) {
+      auto indexes = axis.find_indexes(coordinates[ix]);
+      if (cells[ix] == -1) {
+        EXPECT_TRUE(!indexes.has_value() ||
+                    std::get<0>(*indexes) + 1 != std::get<1>(*indexes));
+      } else {
+        ASSERT_TRUE(indexes.has_value());
+        EXPECT_EQ(std::get<0>(*indexes), cells[ix]);
+        EXPECT_EQ(std::get<1>(*indexes), cells[ix] + 1);
+      }
+    }
+  }
+  auto axis = detail::Axis<double>(0, 1, 1, 1e-6, false);
+  auto value = 0.0;
+  auto cell = int64_t(0);
+  axis.regular_container()->find_cells(&value, &cell, 1);
+  EXPECT_EQ(cell, -1);
+  EXPECT_EQ(detail::Axis<double>().regular_container(), nullptr);
+
+  // The undefined and out of range coordinates are not framed.
+  axis = detail::Axis<double>(0, 9, 10, 1e-6, false);
+  auto coordinates = std::vector<double>{
+      std::numeric_limits<double>::quiet_NaN(),
+      1e300,
+      -1e300,
+      std::numeric_limits<double>::infinity(),
+      -std::numeric_limits<double>::infinity(),
+      4.5};
+  auto cells = std::vector<int64_t>(coordinates.size());
+  axis.regular_container()->find_cells(coordinates.data(), cells.data(),
+                                       coordinates.size());
+  EXPECT_EQ(cells, (std::vector<int64_t>{-1, -1, -1, -1, -1, 4}));
+}
+
+TEST(axis, find_indexes_batch) {
+  // The batch search must give the same results as the search performed point
+  // by point, for regular and irregular axes.
+  auto values = pyinterp::Vector<double>(200);
+  for (auto ix = 0; ix < values.size(); ++ix) {
+    values[ix] = ix * ix * 0.01;
+  }
+  auto axes = std::vector<detail::Axis<double>>{
+      detail::Axis<double>(values, 1e-6, false),
+      detail::Axis<double>(-180, 179, 360, 1e-6, true),
+      detail::Axis<double>(0, 358, 180, 1e-6, false)};
+  axes.push_back(axes[0]);
+  axes.back().flip();
+
+  // Sorted coordinates followed by shuffled ones.
+  auto coordinates = pyinterp::Vector<double>(2000);
+  for (auto ix = 0; ix < 1000; ++ix) {
+    coordinates[ix] = -200 + ix * 0.6;
+    coordinates[ix + 1000] = -200 + ((ix * 7919) % 1000) * 0.6;
+  }
+
+  for (auto& axis : axes) {
+    auto i0 = pyinterp::Vector<int64_t>(coordinates.size());
+    auto i1 = pyinterp::Vector<int64_t>(coordinates.size());
+    axis.find_indexes(coordinates, i0, i1);
+    for (auto ix = 0; ix < coordinates.size(); ++ix) {
+      auto indexes = axis.find_indexes(coordinates[ix]);
+      if (indexes) {
+        EXPECT_EQ(i0[ix], std::get<0>(*indexes));
+        EXPECT_EQ(i1[ix], std::get<1>(*indexes));
+      } else {
+        EXPECT_EQ(i0[ix], -1);
+        EXPECT_EQ(i1[ix], -1);
+      }
+    }
+  }
+
+  // Results written in the columns of a matrix.
+  auto matrix = Eigen::Matrix<int64_t, -1, 2, Eigen::RowMajor>(3, 2);
+  auto& axis = axes[2];
+  axis.find_indexes(
+      Eigen::Map<const pyinterp::Vector<double>>(coordinates.data() + 500, 3),
+      Eigen::Map<pyinterp::Vector<int64_t>, 0, Eigen::InnerStride<2>>(
+          matrix.data(), 3),
+      Eigen::Map<pyinterp::Vector<int64_t>, 0, Eigen::InnerStride<2>>(
+          matrix.data() + 1, 3));
+  for (auto ix = 0; ix < 3; ++ix) {
+    auto indexes = axis.find_indexes(coordinates[500 + ix]);
+    ASSERT_TRUE(indexes.has_value());
+    EXPECT_EQ(matrix(ix, 0), std::get<0>(*indexes));
+    EXPECT_EQ(matrix(ix, 1), std::get<1>(*indexes));
+  }
+
+  auto i0 = pyinterp::Vector<int64_t>(1);
+  EXPECT_THROW(axis.find_indexes(coordinates, i0, i0), std::invalid_argument);
+}
+
+TEST(axis, window_indexes) {
+  // The window written in a reused buffer must match the one allocated by
+  // find_indexes, whatever the boundary handling.
+  auto axis = detail::Axis<double>(0, 9, 10, 1e-6, false);
+  auto buffer = std::vector<int64_t>(8);
+  for (auto boundary : {pyinterp::axis::kExpand, pyinterp::axis::kWrap,
+                        pyinterp::axis::kSym, pyinterp::axis::kUndef}) {
+    for (auto coordinate : {0.5, 1.5, 4.5, 8.5}) {
+      auto expected = axis.find_indexes(coordinate, 4, boundary);
+      auto indexes = axis.find_indexes(coordinate);
+      ASSERT_TRUE(indexes.has_value());
+      EXPECT_EQ(axis.window_indexes(*indexes, 4, boundary, buffer.data()),
+                !expected.empty());
+      if (!expected.empty()) {
+        EXPECT_EQ(buffer, expected);
+      }
+    }
+  }
+}
+
+TEST(axis, boundary_tables) {
+  // Windows built by reflecting or wrapping each index outside the axis.
+  auto expected = [](const int64_t len, const bool is_circle,
+                     const std::tuple<int64_t, int64_t>& indexes,
+                     const int64_t size,
+                     const pyinterp::axis::Boundary boundary,
+                     std::vector<int64_t>& result) -> bool {
+    result.resize(size * 2);
+    std::tie(result[size - 1], result[size]) = indexes;
+    for (int64_t shift = 1; shift < size; ++shift) {
+      auto before = std::get<0>(indexes) - shift;
+      auto after = std::get<1>(indexes) + shift;
+      for (auto* item : {&before, &after}) {
+        auto& ix = *item;
+        if (ix >= 0 && ix < len) {
+          continue;
+        }
+        if (is_circle || boundary == pyinterp::axis::kWrap) {
+          ix = detail::math::remainder(ix, len);
+        } else if (boundary == pyinterp::axis::kExpand) {
+          ix = ix < 0 ? 0 : len - 1;
+        } else if (boundary == pyinterp::axis::kSym) {
+          ix = ix < 0 ? detail::math::remainder(-ix, len)
+                      : len - 2 - detail::math::remainder(ix - len, len);
+        } else {
+          return false;
+        }
+      }
+      result[size - shift - 1] = before;
+      result[size + shift] = after;
+    }
+    // A window larger than the axis may be reflected outside the axis.
+    return std::all_of(result.begin(), result.end(),
+                       [&](auto ix) { return ix >= 0 && ix < len; });
+  };
+
+  auto lhs = std::vector<int64_t>();
+  auto rhs = std::vector<int64_t>();
+  for (auto is_circle : {false, true}) {
+    auto axis = detail::Axis<double>(0, 350, 36, 1e-6, is_circle);
+    ASSERT_EQ(axis.is_circle(), is_circle);
+    // The tables are extended when larger windows are requested.
+    for (auto size : {1, 2, 5, 3, 40, 7}) {
+      for (auto boundary : {pyinterp::axis::kExpand, pyinterp::axis::kWrap,
+                            pyinterp::axis::kSym, pyinterp::axis::kUndef}) {
+        for (int64_t ix = 0; ix < axis.size(); ++ix) {
+          // The last element of a circle is framed with the first one.
+          auto jx = ix + 1;
+          if (jx == axis.size()) {
+            if (!is_circle) {
+              continue;
+            }
+            jx = 0;
+          }
+          auto indexes = std::make_tuple(ix, jx);
+          lhs.resize(size * 2);
+          auto valid = expected(axis.size(), is_circle, indexes, size, boundary,
+                                rhs);
+          ASSERT_EQ(axis.window_indexes(indexes, size, boundary, lhs.data()),
+                    valid);
+          if (valid) {
+            EXPECT_EQ(lhs, rhs);
+          }
+        }
+      }
+    }
+  }
+}
+
+TEST(axis, intern) {
+  using Irregular = detail::axis::container::Irregular<double>;
+  auto values = Eigen::VectorXd(5);
+  values << 0, 1, 4, 8, 20;
+  auto& table = detail::axis::InternTable<double>::instance();
+  const auto size = table.size();
+
+  // The containers holding the same values are shared.
+  auto c1 = detail::axis::intern(std::make_shared<Irregular>(values));
+  auto c2 = detail::axis::intern(std::make_shared<Irregular>(values));
+  EXPECT_EQ(c1, c2);
+  EXPECT_EQ(c1->hash(), Irregular(values).hash());
+  EXPECT_EQ(table.size(), size + 1);
+  values(4) = 21;
+  auto c3 = detail::axis::intern(std::make_shared<Irregular>(values));
+  EXPECT_NE(c1, c3);
+  EXPECT_NE(c1->hash(), c3->hash());
+  EXPECT_FALSE(*c1 == *c3);
+  EXPECT_EQ(table.size(), size + 2);
+
+  // The entries expire with the last container alive.
+  c1.reset();
+  c2.reset();
+  c3.reset();
+  EXPECT_EQ(table.size(), size);
+
+  // Flipping an axis does not modify the axes sharing its container.
+  auto a1 = detail::Axis<double>(values, 1e-6, false);
+  auto a2 = detail::Axis<double>(values, 1e-6, false);
+  EXPECT_EQ(a1, a2);
+  a1.flip();
+  EXPECT_NE(a1, a2);
+  EXPECT_EQ(a1.front(), 21);
+  EXPECT_EQ(a2.front(), 0);
+  a1.flip();
+  EXPECT_EQ(a1, a2);
+}
+
+TEST(axis, narrow) {
+  auto values = Eigen::VectorXd(40);
+  for (Eigen::Index ix = 0; ix < values.size(); ++ix) {
+    values(ix) = ix * ix * 0.25 - 100;
+  }
+  auto parent = detail::Axis<double>(values, 1e-6, false);
+  ASSERT_FALSE(parent.is_regular());
+
+  // A view behaves as the axis built from the same values.
+  for (auto flip : {false, true}) {
+    auto source = parent;
+    auto data = Eigen::VectorXd(values);
+    if (flip) {
+      source.flip();
+      data.reverseInPlace();
+    }
+    for (auto [start, stop] : {std::make_tuple(0, 40), std::make_tuple(3, 12),
+                               std::make_tuple(35, 40), std::make_tuple(7, 8),
+                               std::make_tuple(20, 23)}) {
+      SCOPED_TRACE(std::to_string(flip) + ": [" + std::to_string(start) +
+                   ", " + std::to_string(stop) + ")");
+      auto view = source;
+      view.narrow(start, stop);
+      Eigen::VectorXd segment = data.segment(start, stop - start);
+      auto expected = detail::Axis<double>(segment, 1e-6, false);
+      ASSERT_EQ(view.size(), stop - start);
+      EXPECT_EQ(view, expected);
+      EXPECT_EQ(expected, view);
+      EXPECT_EQ(view.min_value(), expected.min_value());
+      EXPECT_EQ(view.max_value(), expected.max_value());
+      // The cells of an axis holding a single value are not defined.
+      if (view.size() == 1) {
+        continue;
+      }
+      EXPECT_EQ(view.is_ascending(), expected.is_ascending());
+      for (auto x = -110.0; x < 300; x += 0.37) {
+        EXPECT_EQ(view.find_index(x, false), expected.find_index(x, false));
+        EXPECT_EQ(view.find_index(x, true), expected.find_index(x, true));
+        EXPECT_EQ(view.find_indexes(x), expected.find_indexes(x));
+      }
+      // A view of a view reads the values of the same parent.
+      auto other = view;
+      other.narrow(1, view.size() - 1);
+      Eigen::VectorXd inner = segment.segment(1, segment.size() - 2);
+      EXPECT_EQ(other, detail::Axis<double>(inner, 1e-6, false));
+      other.flip();
+      EXPECT_EQ(other.front(), inner(inner.size() - 1));
+      EXPECT_EQ(view.front(), segment(0));
+    }
+  }
+
+  // The regular axes keep their step.
+  auto regular = detail::Axis<double>(-180, 179, 360, 1e-6, true);
+  ASSERT_TRUE(regular.is_circle());
+  regular.narrow(10, 20);
+  EXPECT_FALSE(regular.is_circle());
+  EXPECT_EQ(regular, detail::Axis<double>(-170, -161, 10, 1e-6, false));
+  EXPECT_EQ(regular.increment(), 1);
+  // The longitudes are still normalized.
+  EXPECT_EQ(regular.find_index(195, false), 5);
+  EXPECT_EQ(regular.find_index(0, false), -1);
+
+  EXPECT_THROW(regular.narrow(5, 5), std::invalid_argument);
+  EXPECT_THROW(regular.narrow(0, 11), std::invalid_argument);
+  EXPECT_THROW(regular.narrow(-1, 3), std::invalid_argument);
+}
@@ -78,6 +78,48 @@ TYPED_TEST(IrregularTest, irregular) {
   EXPECT_FALSE(a1 == container::Undefined<TypeParam>());
 }
 
+TYPED_TEST(IrregularTest, lookup_table) {
+  // The cells found with the lookup table of a large axis must be identical
+  // to those found by a linear search over the edges.
+  auto values = std::vector<TypeParam>();
+  auto value = TypeParam(0);
+  for (auto ix = 0; ix < 1000; ++ix) {
+    values.push_back(value);
+    // Spacing varying greatly along the axis, including clustered points.
+    value += static_cast<TypeParam>(1 + (ix % 7 == 0 ? 50 : ix % 5) +
+                                    (ix > 500 ? 20 : 0));
+  }
+  auto axis = typename TestFixture::Axis(
+      Eigen::Map<Eigen::Matrix<TypeParam, -1, 1>>(values.data(),
+                                                  values.size()));
+  auto n = static_cast<int64_t>(values.size());
+  auto step = std::is_integral_v<TypeParam> ? TypeParam(1) : TypeParam(0.75);
+
+  for (auto flipped : {false, true}) {
+    auto edges = std::vector<TypeParam>(n + 1);
+    for (int64_t ix = 1; ix < n; ++ix) {
+      edges[ix] = (axis.coordinate_value(ix - 1) + axis.coordinate_value(ix)) /
+                  static_cast<TypeParam>(2);
+    }
+    for (auto query = values.front() - 10; query <= values.back() + 10;
+         query += step) {
+      auto expected = int64_t(0);
+      for (int64_t ix = 1; ix < n; ++ix) {
+        if (flipped ? edges[ix] >= query : edges[ix] <= query) {
+          expected = ix;
+        }
+      }
+      auto index = axis.find_index(query, true);
+      if (index == 0 || index == n - 1) {
+        // The coordinates outside the axis are handled by the bounds.
+        continue;
+      }
+      ASSERT_EQ(index, expected) << query;
+    }
+    axis.flip();
+  }
+}
+
 template <typename T>
 class RegularTest : public testing::Test {
  public:
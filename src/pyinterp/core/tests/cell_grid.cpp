@@ -0,0 +1,59 @@
+// Copyright (c) 2022 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+#include <gtest/gtest.h>
+
+#include "pyinterp/detail/cell_grid.hpp"
+#include "pyinterp/detail/math/descriptive_statistics.hpp"
+
+namespace detail = pyinterp::detail;
+using DescriptiveStatistics = detail::math::DescriptiveStatistics<double>;
+
+TEST(cell_grid, dense) {
+  auto grid = detail::CellGrid<int>(3, 4, false, -1);
+  EXPECT_FALSE(grid.sparse());
+  EXPECT_EQ(grid.size(), 12);
+  EXPECT_EQ(grid.index(1, 2), 7U);
+
+  grid(1, 2) = 5;
+  EXPECT_EQ(grid[7], 5);
+  EXPECT_EQ(*grid.find(0), -1);
+  EXPECT_EQ(grid.indexes([](const int item) { return item != -1; }),
+            std::vector<uint64_t>{7});
+
+  auto count = 0;
+  grid.for_each([&](const uint64_t, const int) { ++count; });
+  EXPECT_EQ(count, 12);
+
+  grid.clear();
+  EXPECT_EQ(grid(1, 2), -1);
+}
+
+TEST(cell_grid, sparse) {
+  auto grid = detail::CellGrid<DescriptiveStatistics>(36000, 18000, true);
+  EXPECT_TRUE(grid.sparse());
+  EXPECT_EQ(grid.find(grid.index(35999, 17999)), nullptr);
+
+  grid(35999, 17999)(1);
+  grid(35999, 17999)(3);
+  grid(0, 0)(2);
+  EXPECT_EQ(grid.find(grid.index(35999, 17999))->mean(), 2);
+
+  const auto& view = grid;
+  EXPECT_EQ(view(1, 1).count(), 0U);
+  EXPECT_EQ(view(0, 0).count(), 1U);
+  EXPECT_EQ(grid.find(grid.index(1, 1)), nullptr);
+
+  auto indexes = grid.indexes(
+      [](const DescriptiveStatistics& item) { return item.count() != 0; });
+  EXPECT_EQ(indexes, (std::vector<uint64_t>{0, grid.index(35999, 17999)}));
+
+  auto count = 0;
+  grid.for_each([&](const uint64_t, const DescriptiveStatistics&) { ++count; });
+  EXPECT_EQ(count, 2);
+
+  grid.clear();
+  EXPECT_EQ(grid.indexes([](const DescriptiveStatistics&) { return true; }),
+            std::vector<uint64_t>{});
+}
@@ -0,0 +1,69 @@
+// Copyright (c) 2022 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+#include "pyinterp/detail/first_touch.hpp"
+
+#include <gtest/gtest.h>
+
+#include <numeric>
+#include <stdexcept>
+
+namespace detail = pyinterp::detail;
+
+TEST(first_touch, small) {
+  auto array = detail::FirstTouchArray<int>(10, 3);
+  ASSERT_EQ(array.size(), 10);
+  EXPECT_EQ(std::accumulate(array.begin(), array.end(), 0), 30);
+
+  auto copy = array;
+  array[1] = 5;
+  EXPECT_EQ(copy[1], 3);
+  EXPECT_EQ(array[1], 5);
+
+  auto moved = std::move(array);
+  EXPECT_EQ(array.size(), 0);
+  EXPECT_EQ(moved[1], 5);
+
+  moved.fill(-1);
+  EXPECT_EQ(std::accumulate(moved.begin(), moved.end(), 0), -10);
+
+  auto empty = detail::FirstTouchArray<int>(0, 1);
+  EXPECT_EQ(empty.size(), 0);
+  EXPECT_EQ(empty.begin(), empty.end());
+}
+
+TEST(first_touch, parallel) {
+  const auto size = size_t(1) << 18U;
+  auto array = detail::FirstTouchArray<double>(size, 1);
+  ASSERT_EQ(array.size(), size);
+  EXPECT_EQ(std::accumulate(array.begin(), array.end(), 0.0), size);
+
+  array[size - 1] = 2;
+  auto copy = array;
+  EXPECT_EQ(copy[size - 1], 2);
+  EXPECT_EQ(std::accumulate(copy.begin(), copy.end(), 0.0), size + 1);
+
+  copy.fill(0.5);
+  EXPECT_EQ(std::accumulate(copy.begin(), copy.end(), 0.0), size / 2);
+}
+
+namespace {
+
+/// Item whose copy fails after a given number of copies.
+struct Item {
+  static inline int count = 0;
+
+  Item() = default;
+  Item(const Item& /*rhs*/) {
+    if (++count == 100) {
+      throw std::runtime_error("failure");
+    }
+  }
+};
+
+}  // namespace
+
+TEST(first_touch, exception) {
+  EXPECT_THROW(detail::FirstTouchArray<Item>(1000, Item()), std::runtime_error);
+}
@@ -0,0 +1,49 @@
+// Copyright (c) 2022 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+#include <gtest/gtest.h>
+
+#include <boost/geometry.hpp>
+
+#include "pyinterp/detail/geodetic/area.hpp"
+
+namespace geodetic = pyinterp::detail::geodetic;
+namespace math = pyinterp::detail::math;
+
+TEST(geodetic_area, sphere) {
+  auto sphere = geodetic::System(6371000, 0);
+  auto area = geodetic::RectangleArea(sphere);
+  EXPECT_NEAR(area(-90, 90, 360), 4 * math::pi<double>() * math::sqr(6371000.0),
+              1e-3);
+  EXPECT_NEAR(area(0, 90, 90), math::pi<double>() * math::sqr(6371000.0) / 2,
+              1e-3);
+}
+
+TEST(geodetic_area, spheroid) {
+  auto wgs = geodetic::System();
+  auto area = geodetic::RectangleArea(wgs);
+  // The surface of the spheroid is the one of the sphere of authalic radius.
+  EXPECT_NEAR(area(-90, 90, 360) /
+                  (4 * math::pi<double>() * math::sqr(wgs.authalic_radius())),
+              1, 1e-12);
+  EXPECT_DOUBLE_EQ(area(-10, 30, 12), area(-30, 10, 12));
+  EXPECT_DOUBLE_EQ(area(0, 10, 12) + area(10, 30, 12), area(0, 30, 12));
+
+  // The edges of a small cell are almost geodesics: its area is close to the
+  // one of the polygon calculated by Boost.Geometry, whose accuracy decreases
+  // for smaller cells.
+  using point_t = boost::geometry::model::point<
+      double, 2, boost::geometry::cs::geographic<boost::geometry::degree>>;
+  auto polygon = boost::geometry::model::polygon<point_t>();
+  boost::geometry::assign_points(
+      polygon, std::vector<point_t>{{2, 45}, {2, 45.1}, {2.1, 45.1},
+                                    {2.1, 45}, {2, 45}});
+  auto strategy = boost::geometry::strategy::area::geographic<
+      boost::geometry::strategy::vincenty, 5>(
+      boost::geometry::srs::spheroid<double>(wgs.semi_major_axis(),
+                                             wgs.semi_minor_axis()));
+  EXPECT_NEAR(area(45, 45.1, 0.1) /
+                  std::abs(boost::geometry::area(polygon, strategy)),
+              1, 1e-6);
+}
@@ -67,3 +67,56 @@ TEST(geometry_geodetic_coordinates, lla_to_ecef_to_lla) {
                 1e-8);
   }
 }
+
+TEST(geometry_geodetic_coordinates, batch) {
+  // The batch conversions give the results of the scalar ones.
+  std::uniform_real_distribution<double> lat(-90, 90);
+  std::uniform_real_distribution<double> lon(-180, 180);
+  std::uniform_real_distribution<double> alt(-10'000, 100'000);
+  std::default_random_engine re;
+
+  auto coordinates = geodetic::Coordinates(geodetic::System());
+  auto target = geodetic::Coordinates(
+      geodetic::System(6'378'137, 1 / 298.257'222'101));
+
+  const Eigen::Index size = 1'000;
+  Eigen::VectorXd lon1(size), lat1(size), alt1(size);
+  for (Eigen::Index ix = 0; ix < size; ++ix) {
+    lon1(ix) = lon(re);
+    lat1(ix) = lat(re);
+    alt1(ix) = alt(re);
+  }
+  // The poles and the equator.
+  lat1.head(3) << 90, -90, 0;
+
+  Eigen::VectorXd x(size), y(size), z(size);
+  Eigen::VectorXd lon2(size), lat2(size), alt2(size);
+  coordinates.lla_to_ecef<double>(lon1, lat1, alt1, x, y, z);
+  for (Eigen::Index ix = 0; ix < size; ++ix) {
+    auto ecef = coordinates.lla_to_ecef(
+        geometry::EquatorialPoint3D<double>(lon1(ix), lat1(ix), alt1(ix)));
+    EXPECT_NEAR(boost::geometry::get<0>(ecef), x(ix), 1e-8);
+    EXPECT_NEAR(boost::geometry::get<1>(ecef), y(ix), 1e-8);
+    EXPECT_NEAR(boost::geometry::get<2>(ecef), z(ix), 1e-8);
+  }
+
+  coordinates.ecef_to_lla<double>(x, y, z, lon2, lat2, alt2);
+  for (Eigen::Index ix = 0; ix < size; ++ix) {
+    EXPECT_NEAR(lon1(ix), lon2(ix), 1e-12);
+    EXPECT_NEAR(lat1(ix), lat2(ix), 1e-12);
+    EXPECT_NEAR(alt1(ix), alt2(ix), 1e-8);
+  }
+
+  coordinates.transform<double>(target, lon1, lat1, alt1, lon2, lat2, alt2);
+  for (Eigen::Index ix = 0; ix < size; ++ix) {
+    auto lla = coordinates.transform(
+        target,
+        geometry::EquatorialPoint3D<double>(lon1(ix), lat1(ix), alt1(ix)));
+    // The longitude of the poles is undefined.
+    if (std::abs(lat1(ix)) != 90) {
+      EXPECT_NEAR(boost::geometry::get<0>(lla), lon2(ix), 1e-12);
+    }
+    EXPECT_NEAR(boost::geometry::get<1>(lla), lat2(ix), 1e-12);
+    EXPECT_NEAR(boost::geometry::get<2>(lla), alt2(ix), 1e-8);
+  }
+}
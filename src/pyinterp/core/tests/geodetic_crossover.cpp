@@ -0,0 +1,131 @@
+// Copyright (c) 2022 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <limits>
+#include <random>
+
+#include "pyinterp/detail/geodetic/crossover.hpp"
+
+namespace geodetic = pyinterp::detail::geodetic;
+
+TEST(geodetic_crossover, single) {
+  // Equator from 0 to 20 degrees, crossed by the meridian 10.
+  auto lon1 = Eigen::VectorXd(3);
+  auto lat1 = Eigen::VectorXd(3);
+  lon1 << 0, 5, 20;
+  lat1 << 0, 0, 0;
+  auto lon2 = Eigen::VectorXd(3);
+  auto lat2 = Eigen::VectorXd(3);
+  lon2 << 10, 10, 10;
+  lat2 << -10, -2, 6;
+
+  auto result = geodetic::crossovers(lon1, lat1, lon2, lat2);
+  ASSERT_EQ(result.size(), 1);
+  EXPECT_NEAR(result[0].lon, 10, 1e-12);
+  EXPECT_NEAR(result[0].lat, 0, 1e-12);
+  EXPECT_NEAR(result[0].index1, 1 + 1.0 / 3.0, 1e-12);
+  EXPECT_NEAR(result[0].index2, 1.25, 1e-12);
+
+  // The crossover located on a point of the tracks is found once.
+  lat2 << -10, 0, 6;
+  lon1(1) = 10;
+  result = geodetic::crossovers(lon1, lat1, lon2, lat2);
+  ASSERT_EQ(result.size(), 1);
+  EXPECT_NEAR(result[0].index1, 1, 1e-12);
+  EXPECT_NEAR(result[0].index2, 1, 1e-12);
+
+  // The undefined points split the tracks.
+  lat2(1) = std::numeric_limits<double>::quiet_NaN();
+  EXPECT_TRUE(geodetic::crossovers(lon1, lat1, lon2, lat2).empty());
+}
+
+TEST(geodetic_crossover, dateline) {
+  auto lon1 = Eigen::VectorXd(2);
+  auto lat1 = Eigen::VectorXd(2);
+  lon1 << 170, -170;
+  lat1 << 0, 0;
+  auto lon2 = Eigen::VectorXd(2);
+  auto lat2 = Eigen::VectorXd(2);
+  lon2 << 180, -180;
+  lat2 << -10, 10;
+  auto result = geodetic::crossovers(lon1, lat1, lon2, lat2);
+  ASSERT_EQ(result.size(), 1);
+  EXPECT_NEAR(std::abs(result[0].lon), 180, 1e-12);
+  EXPECT_NEAR(result[0].index1, 0.5, 1e-12);
+  EXPECT_NEAR(result[0].index2, 0.5, 1e-12);
+
+  // Segment passing over the north pole.
+  lon2 << 0, 180;
+  lat2 << 80, 80;
+  lon1 << 90, 90;
+  lat1 << 80, 89.9;
+  result = geodetic::crossovers(lon1, lat1, lon2, lat2);
+  EXPECT_TRUE(result.empty());
+  lon1 << 90, -90;
+  result = geodetic::crossovers(lon1, lat1, lon2, lat2);
+  ASSERT_EQ(result.size(), 1);
+  EXPECT_NEAR(result[0].lat, 90, 1e-6);
+}
+
+TEST(geodetic_crossover, random) {
+  // Ascending and descending passes of a sun-synchronous like orbit.
+  auto gen = std::mt19937(0);
+  auto uniform = std::uniform_real_distribution<>(-60, 60);
+  auto track = [](const double lon0, const double sign, const int64_t size,
+                  Eigen::VectorXd& lon, Eigen::VectorXd& lat) {
+    lon.resize(size);
+    lat.resize(size);
+    for (int64_t ix = 0; ix < size; ++ix) {
+      auto t = static_cast<double>(ix) / static_cast<double>(size - 1);
+      lat(ix) = sign * (-78 + 156 * t);
+      lon(ix) = lon0 + 60 * t +
+                20 * std::sin(t * pyinterp::detail::math::pi<double>());
+      lon(ix) = pyinterp::detail::math::normalize_angle(lon(ix), -180.0, 360.0);
+    }
+  };
+  auto total = size_t(0);
+  for (auto ix = 0; ix < 20; ++ix) {
+    auto lon1 = Eigen::VectorXd();
+    auto lat1 = Eigen::VectorXd();
+    auto lon2 = Eigen::VectorXd();
+    auto lat2 = Eigen::VectorXd();
+    track(uniform(gen), 1, 500, lon1, lat1);
+    track(uniform(gen), -1, 300, lon2, lat2);
+
+    // Brute force search.
+    auto segments1 = geodetic::track_segments(lon1, lat1);
+    auto segments2 = geodetic::track_segments(lon2, lat2);
+    auto expected = std::vector<geodetic::Crossover>();
+    auto crossover = geodetic::Crossover{};
+    for (const auto& lhs : segments1) {
+      for (const auto& rhs : segments2) {
+        if (lhs.intersection(rhs, crossover)) {
+          expected.push_back(crossover);
+        }
+      }
+    }
+    std::sort(expected.begin(), expected.end(),
+              [](const auto& lhs, const auto& rhs) {
+                return lhs.index1 < rhs.index1;
+              });
+    auto result = geodetic::crossovers(lon1, lat1, lon2, lat2);
+    ASSERT_EQ(result.size(), expected.size());
+    total += result.size();
+    for (size_t jx = 0; jx < result.size(); ++jx) {
+      EXPECT_EQ(result[jx].index1, expected[jx].index1);
+      EXPECT_EQ(result[jx].index2, expected[jx].index2);
+      // The crossover lies on both tracks.
+      auto i1 = static_cast<Eigen::Index>(result[jx].index1);
+      auto i2 = static_cast<Eigen::Index>(result[jx].index2);
+      EXPECT_GE(result[jx].lat, std::min(lat1(i1), lat1(i1 + 1)) - 1e-3);
+      EXPECT_LE(result[jx].lat, std::max(lat1(i1), lat1(i1 + 1)) + 1e-3);
+      EXPECT_GE(result[jx].lat, std::min(lat2(i2), lat2(i2 + 1)) - 1e-3);
+      EXPECT_LE(result[jx].lat, std::max(lat2(i2), lat2(i2 + 1)) + 1e-3);
+    }
+  }
+  EXPECT_GT(total, 10);
+}
@@ -0,0 +1,244 @@
+// Copyright (c) 2022 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <limits>
+#include <random>
+
+#include "pyinterp/detail/geometry/kdtree.hpp"
+#include "pyinterp/detail/geometry/rtree.hpp"
+
+namespace geometry = pyinterp::detail::geometry;
+
+using KDTree = geometry::KDTree<double, int64_t, 3>;
+using RTree = geometry::RTree<double, int64_t, 3>;
+
+static auto random_points(const size_t size) -> std::vector<KDTree::value_t> {
+  auto gen = std::mt19937(42);
+  auto uniform = std::uniform_real_distribution<>(-1, 1);
+  auto result = std::vector<KDTree::value_t>();
+  for (size_t ix = 0; ix < size; ++ix) {
+    result.emplace_back(KDTree::point_t(uniform(gen), uniform(gen),
+                                        static_cast<double>(ix % 7) * 0.1),
+                        static_cast<int64_t>(ix));
+  }
+  return result;
+}
+
+TEST(geometry_kdtree, empty) {
+  auto kdtree = KDTree();
+  EXPECT_TRUE(kdtree.empty());
+  EXPECT_EQ(kdtree.size(), 0);
+  EXPECT_TRUE(kdtree.nearest({0, 0, 0}, 3).empty());
+  EXPECT_TRUE(kdtree.within({0, 0, 0}, 1).empty());
+}
+
+TEST(geometry_kdtree, nearest) {
+  auto points = random_points(10000);
+  auto kdtree = KDTree(points);
+  ASSERT_EQ(kdtree.size(), points.size());
+
+  auto gen = std::mt19937(0);
+  auto uniform = std::uniform_real_distribution<>(-1.2, 1.2);
+  for (auto ix = 0; ix < 100; ++ix) {
+    auto point = KDTree::point_t(uniform(gen), uniform(gen), uniform(gen));
+
+    // Brute force search.
+    auto expected = std::vector<std::pair<double, int64_t>>();
+    for (const auto& item : points) {
+      expected.emplace_back(boost::geometry::distance(point, item.first),
+                            item.second);
+    }
+    std::sort(expected.begin(), expected.end());
+
+    for (auto k : {1U, 8U, 37U}) {
+      auto nearest = kdtree.nearest(point, k);
+      ASSERT_EQ(nearest.size(), k);
+      for (size_t jx = 0; jx < k; ++jx) {
+        EXPECT_EQ(nearest[jx].first, expected[jx].first);
+        EXPECT_EQ(kdtree[nearest[jx].second].second,
+                  expected[jx].second);
+      }
+    }
+
+    auto within = kdtree.within(point, 0.1);
+    auto count = static_cast<size_t>(
+        std::count_if(expected.begin(), expected.end(),
+                      [](const auto& item) { return item.first <= 0.1; }));
+    ASSERT_EQ(within.size(), count);
+    for (const auto& item : within) {
+      EXPECT_LE(item.first, 0.1);
+    }
+  }
+
+  // More neighbors requested than points stored.
+  auto small = KDTree(random_points(5));
+  EXPECT_EQ(small.nearest({0, 0, 0}, 10).size(), 5);
+}
+
+TEST(geometry_kdtree, approximate_nearest) {
+  auto points = random_points(10000);
+  auto kdtree = KDTree(points);
+  auto heap = std::vector<KDTree::result_t>();
+
+  auto gen = std::mt19937(0);
+  auto uniform = std::uniform_real_distribution<>(-1.2, 1.2);
+  for (auto ix = 0; ix < 100; ++ix) {
+    auto point = KDTree::point_t(uniform(gen), uniform(gen), uniform(gen));
+    auto expected = kdtree.nearest(point, 16);
+
+    // The search without tolerance is exact.
+    kdtree.nearest(point, 16, std::numeric_limits<double>::max(), heap,
+                   nullptr, 0);
+    ASSERT_EQ(heap.size(), expected.size());
+    for (size_t jx = 0; jx < heap.size(); ++jx) {
+      EXPECT_EQ(heap[jx], expected[jx]);
+    }
+
+    // The i-th neighbor found is at most (1 + eps) times farther than the
+    // i-th nearest neighbor.
+    for (auto eps : {0.1, 0.5, 2.0}) {
+      kdtree.nearest(point, 16, std::numeric_limits<double>::max(), heap,
+                     nullptr, eps);
+      ASSERT_EQ(heap.size(), expected.size());
+      for (size_t jx = 0; jx < heap.size(); ++jx) {
+        EXPECT_LE(heap[jx].first, expected[jx].first * (1 + eps) + 1e-12);
+        EXPECT_GE(heap[jx].first, expected[jx].first);
+      }
+    }
+  }
+}
+
+TEST(geometry_kdtree, parallel_build) {
+  // The subtrees built concurrently must be laid out as the ones built by a
+  // single thread.
+  for (auto size : {5UL, 100UL, 100000UL}) {
+    auto points = random_points(size);
+    auto expected = KDTree(points);
+    for (auto num_threads : {0UL, 2UL, 3UL}) {
+      auto kdtree = KDTree(points, num_threads);
+      ASSERT_EQ(kdtree.size(), expected.size());
+      for (size_t ix = 0; ix < size; ++ix) {
+        ASSERT_EQ(kdtree[ix].second, expected[ix].second);
+      }
+      auto nearest = kdtree.nearest({0.1, 0.2, 0.3}, 16);
+      EXPECT_EQ(nearest, expected.nearest({0.1, 0.2, 0.3}, 16));
+    }
+  }
+}
+
+TEST(geometry_kdtree, bounds) {
+  auto points = random_points(1000);
+  auto rtree = RTree();
+  for (const auto& item : points) {
+    rtree.insert(item);
+  }
+  auto expected = rtree.bounds();
+  ASSERT_TRUE(expected);
+  auto bounds = KDTree(points).bounds();
+  EXPECT_TRUE(boost::geometry::equals(*expected, bounds));
+}
+
+TEST(geometry_kdtree, rtree) {
+  // After packing, the R*Tree is queried through the K-d tree, which gives
+  // the same results as the dynamic index.
+  auto points = random_points(5000);
+  auto dynamic = RTree();
+  for (const auto& item : points) {
+    dynamic.insert(item);
+  }
+  auto packed = RTree();
+  packed.packing(points);
+  EXPECT_EQ(packed.size(), dynamic.size());
+
+  auto point = RTree::point_t(0.1, -0.2, 0.3);
+  auto lhs = packed.query(point, 16);
+  auto rhs = dynamic.query(point, 16);
+  ASSERT_EQ(lhs.size(), rhs.size());
+  for (size_t ix = 0; ix < lhs.size(); ++ix) {
+    EXPECT_EQ(lhs[ix].first, rhs[ix].first);
+    EXPECT_EQ(lhs[ix].second, rhs[ix].second);
+  }
+  EXPECT_EQ(packed.query_ball(point, 0.2).size(),
+            dynamic.query_ball(point, 0.2).size());
+  EXPECT_EQ(packed.inverse_distance_weighting(point, 1, 16, 2, false),
+            dynamic.inverse_distance_weighting(point, 1, 16, 2, false));
+
+  // Inserting a point after packing moves the points into the dynamic index.
+  packed.insert(std::make_pair(point, -1));
+  EXPECT_EQ(packed.size(), points.size() + 1);
+  auto nearest = packed.query(point, 1);
+  ASSERT_EQ(nearest.size(), 1);
+  EXPECT_EQ(nearest[0].second, -1);
+
+  packed.clear();
+  EXPECT_TRUE(packed.empty());
+}
+
+TEST(geometry_kdtree, radius) {
+  // The search bounded by a radius finds the k nearest neighbors located
+  // within the radius, in both indexes.
+  auto points = random_points(5000);
+  auto dynamic = RTree();
+  for (const auto& item : points) {
+    dynamic.insert(item);
+  }
+  auto packed = RTree();
+  packed.packing(points);
+
+  auto point = RTree::point_t(0.1, -0.2, 0.3);
+  for (auto radius : {0.05, 0.1, 0.5}) {
+    auto expected = std::vector<RTree::result_t>();
+    for (const auto& item : packed.query(point, 16)) {
+      if (item.first <= radius) {
+        expected.push_back(item);
+      }
+    }
+    for (const auto* rtree : {&packed, &dynamic}) {
+      auto result = std::vector<RTree::result_t>();
+      rtree->for_each_nearest(point, 16, radius,
+                              [&](const auto distance, const auto& item) {
+                                result.emplace_back(distance, item.second);
+                              });
+      ASSERT_EQ(result.size(), expected.size());
+      for (size_t ix = 0; ix < result.size(); ++ix) {
+        EXPECT_EQ(result[ix].first, expected[ix].first);
+        EXPECT_EQ(result[ix].second, expected[ix].second);
+      }
+    }
+    EXPECT_EQ(packed.inverse_distance_weighting(point, radius, 16, 3, false),
+              dynamic.inverse_distance_weighting(point, radius, 16, 3, false));
+  }
+}
+
+TEST(geometry_kdtree, save_load) {
+  auto points = random_points(1000);
+  auto kdtree = KDTree(points);
+  auto path = testing::TempDir() + "geometry_kdtree.idx";
+  kdtree.save(path, "metadata");
+
+  auto [other, metadata] = KDTree::load(path);
+  EXPECT_EQ(metadata, "metadata");
+  ASSERT_EQ(other.size(), kdtree.size());
+  for (size_t ix = 0; ix < kdtree.size(); ++ix) {
+    EXPECT_TRUE(boost::geometry::equals(other[ix].first, kdtree[ix].first));
+    EXPECT_EQ(other[ix].second, kdtree[ix].second);
+  }
+  auto lhs = kdtree.nearest({0.1, 0.2, 0.3}, 10);
+  auto rhs = other.nearest({0.1, 0.2, 0.3}, 10);
+  EXPECT_EQ(lhs, rhs);
+
+  // The file does not store a tree of this type.
+  EXPECT_THROW((geometry::KDTree<float, float, 3>::load(path)),
+               std::invalid_argument);
+  EXPECT_THROW(KDTree::load(path + ".missing"), std::runtime_error);
+
+  // The points are mapped in memory from the file stored by the R*Tree.
+  auto rtree = RTree();
+  EXPECT_EQ(rtree.load(path), "metadata");
+  EXPECT_EQ(rtree.size(), points.size());
+  std::remove(path.c_str());
+}
@@ -4,6 +4,12 @@
 // BSD-style license that can be found in the LICENSE file.
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <iterator>
+#include <random>
+
 #include "pyinterp/detail/geometry/rtree.hpp"
 
 namespace geometry = pyinterp::detail::geometry;
@@ -76,6 +82,36 @@ TEST(geometry_rtree, query) {
   EXPECT_EQ(nearest.size(), 3);
 }
 
+TEST(geometry_rtree, query_buffer) {
+  auto distances = std::vector<double>(4);
+  auto values = std::vector<int64_t>(4);
+
+  for (auto packing : {true, false}) {
+    auto rtree = RTree();
+    if (packing) {
+      rtree.packing(get_coordinates());
+    } else {
+      for (auto &&item : get_coordinates()) {
+        rtree.insert(item);
+      }
+    }
+    for (auto within : {false, true}) {
+      for (auto &&point : std::vector<geometry::PointND<double, 2>>{
+               {3, 4}, {4, 4}, {0, 0}, {2, 4}, {8, 8}}) {
+        auto expected =
+            within ? rtree.query_within(point, 4) : rtree.query(point, 4);
+        auto count =
+            rtree.query(point, 4, within, distances.data(), values.data());
+        ASSERT_EQ(count, expected.size());
+        for (auto ix = 0U; ix < count; ++ix) {
+          EXPECT_DOUBLE_EQ(distances[ix], expected[ix].first);
+          EXPECT_EQ(values[ix], expected[ix].second);
+        }
+      }
+    }
+  }
+}
+
 TEST(geometry_rtree, inverse_distance_weighting) {
   auto rtree = RTree();
   rtree.packing(get_coordinates());
@@ -188,4 +224,252 @@ TEST(geometry_rtree, radial_basis_function) {
       math::RBF<PromotionType>(std::numeric_limits<PromotionType>::quiet_NaN(),
                                0, math::RadialBasisFunction::Multiquadric);
   rtree.radial_basis_function({4, 4}, rbf, 4, 4, false);
+
+  // The interpolants found in the cache give the same results.
+  auto cache = RTree::rbf_cache_t(4);
+  for (auto point : {geometry::PointND<double, 2>(4, 4),
+                     geometry::PointND<double, 2>(4.1, 4),
+                     geometry::PointND<double, 2>(4, 4)}) {
+    auto expected = rtree.radial_basis_function(point, rbf, 4, 4, false);
+    auto cached = rtree.radial_basis_function(point, rbf, 4, 4, false, &cache);
+    EXPECT_NEAR(cached.first, expected.first, 1e-9);
+    EXPECT_EQ(cached.second, expected.second);
+  }
+  EXPECT_EQ(cache.size(), 1);
+}
+
+TEST(geometry_rtree, radial_basis_function_batch) {
+  auto generator = std::mt19937(42);
+  auto uniform = std::uniform_real_distribution<double>(0, 10);
+  auto coordinates = std::vector<RTree::value_t>();
+  for (int64_t ix = 0; ix < 200; ++ix) {
+    auto x = uniform(generator);
+    auto y = uniform(generator);
+    coordinates.emplace_back(geometry::PointND<double, 2>(x, y),
+                             static_cast<int64_t>(10 * std::sin(x) * y));
+  }
+  auto rtree = RTree();
+  rtree.packing(coordinates);
+
+  // The blocks solved together give the results of the points solved one by
+  // one, including the points sharing their neighbors and those without
+  // neighbors.
+  auto points = std::array<RTree::point_t, RTree::kRBFBatchSize>();
+  auto values = std::array<double, RTree::kRBFBatchSize>();
+  auto neighbors = std::array<uint32_t, RTree::kRBFBatchSize>();
+  for (auto function : {math::RadialBasisFunction::Multiquadric,
+                        math::RadialBasisFunction::ThinPlate,
+                        math::RadialBasisFunction::Gaussian}) {
+    auto rbf = math::RBF<double>(std::numeric_limits<double>::quiet_NaN(), 0,
+                                 function);
+    auto cache = RTree::rbf_cache_t(4);
+    auto batch = RTree::RBFBatch(9);
+    for (auto block = 0; block < 10; ++block) {
+      for (auto &point : points) {
+        point = RTree::point_t(uniform(generator), uniform(generator));
+      }
+      points[1] = points[0];
+      points[5] = RTree::point_t(100, 100);
+      rtree.radial_basis_function(points.data(), points.size(), rbf, 2, 9,
+                                  false, cache, batch, values.data(),
+                                  neighbors.data());
+      for (size_t ix = 0; ix < points.size(); ++ix) {
+        auto expected =
+            rtree.radial_basis_function(points[ix], rbf, 2, 9, false);
+        EXPECT_EQ(neighbors[ix], expected.second);
+        if (std::isnan(expected.first)) {
+          EXPECT_TRUE(std::isnan(values[ix]));
+        } else {
+          EXPECT_NEAR(values[ix], expected.first,
+                      1e-6 * std::max(1.0, std::abs(expected.first)));
+        }
+      }
+    }
+  }
+}
+
+TEST(geometry_rtree, window_function) {
+  auto rtree = RTree();
+  rtree.packing(get_coordinates());
+  auto wf = math::WindowFunction<double>(math::window::Function::kBlackman);
+  auto table = math::WindowFunctionTable<double>(wf, 6, 0, 1024);
+
+  // The tabulated window function gives the same results.
+  for (auto point : {geometry::PointND<double, 2>(4, 4),
+                     geometry::PointND<double, 2>(6, 3),
+                     geometry::PointND<double, 2>(8, 5)}) {
+    auto expected = rtree.window_function(point, wf, 0, 6, 4, false);
+    auto result = rtree.window_function(point, table, 4, false);
+    EXPECT_NEAR(result.first, expected.first, 1e-5);
+    EXPECT_EQ(result.second, expected.second);
+  }
+}
+
+TEST(geometry_rtree, kriging) {
+  auto rtree = RTree();
+  rtree.packing(get_coordinates());
+  auto kriging = math::Kriging<RTree::promotion_t>(
+      1, 4, 0, math::covariance::Function::kMatern32);
+
+  // The nodes are estimated exactly.
+  auto [value, variance, neighbors] =
+      rtree.kriging({5, 4}, kriging, 10, 4, false);
+  EXPECT_NEAR(value, 1, 1e-9);
+  EXPECT_NEAR(variance, 0, 1e-9);
+  EXPECT_EQ(neighbors, 4);
+
+  // The kriging systems found in the cache give the same results.
+  auto cache = RTree::kriging_cache_t(4);
+  for (auto point : {geometry::PointND<double, 2>(4, 4),
+                     geometry::PointND<double, 2>(4.1, 4),
+                     geometry::PointND<double, 2>(4, 4)}) {
+    auto expected = rtree.kriging(point, kriging, 10, 4, false);
+    auto cached = rtree.kriging(point, kriging, 10, 4, false, &cache);
+    EXPECT_NEAR(std::get<0>(cached), std::get<0>(expected), 1e-9);
+    EXPECT_NEAR(std::get<1>(cached), std::get<1>(expected), 1e-9);
+    EXPECT_EQ(std::get<2>(cached), std::get<2>(expected));
+  }
+  EXPECT_EQ(cache.size(), 1);
+
+  auto result = rtree.kriging({4, 4}, kriging, 0.1, 4, false);
+  EXPECT_TRUE(std::isnan(std::get<0>(result)));
+  EXPECT_EQ(std::get<2>(result), 0);
+}
+
+TEST(geometry_rtree, compact_radial_basis_function) {
+  auto rbf = math::CompactRBF<RTree::promotion_t>(4, 0);
+  for (auto packed : {true, false}) {
+    auto rtree = RTree();
+    if (packed) {
+      rtree.packing(get_coordinates());
+    } else {
+      for (const auto &item : get_coordinates()) {
+        rtree.insert(item);
+      }
+    }
+    auto interpolant =
+        rtree.fit_compact_radial_basis_function(rbf, 100, 1e-12, 1);
+    ASSERT_EQ(interpolant.weights.size(), 6);
+
+    // The interpolant goes through the nodal points.
+    for (const auto &item : get_coordinates()) {
+      auto result =
+          RTree::compact_radial_basis_function(item.first, rbf, interpolant);
+      EXPECT_NEAR(result.first, static_cast<double>(item.second), 1e-9);
+      EXPECT_GT(result.second, 0);
+    }
+    auto result = RTree::compact_radial_basis_function({20, 20}, rbf,
+                                                       interpolant);
+    EXPECT_TRUE(std::isnan(result.first));
+    EXPECT_EQ(result.second, 0);
+  }
+}
+
+TEST(geometry_rtree, insert_remove) {
+  auto generator = std::mt19937(42);
+  auto uniform = std::uniform_real_distribution<double>(0, 100);
+  auto points = std::vector<RTree::value_t>();
+  for (int64_t ix = 0; ix < 10000; ++ix) {
+    points.emplace_back(
+        geometry::PointND<double, 2>(uniform(generator), uniform(generator)),
+        ix);
+  }
+  auto rtree = RTree();
+  rtree.insert(std::vector<RTree::value_t>(points.begin(),
+                                           points.begin() + 8000));
+  rtree.insert(std::vector<RTree::value_t>(points.begin() + 8000,
+                                           points.begin() + 9000));
+  for (auto it = points.begin() + 9000; it != points.end(); ++it) {
+    rtree.insert(*it);
+  }
+  EXPECT_EQ(rtree.size(), 10000);
+  auto removed = rtree.remove(
+      [](const RTree::value_t &item) { return item.second % 3 == 0; });
+  EXPECT_EQ(removed, 3334);
+  EXPECT_EQ(rtree.size(), 6666);
+  EXPECT_EQ(rtree.remove([](const RTree::value_t &) { return false; }), 0);
+
+  // The queries must return the same results as the index of the remaining
+  // points.
+  auto expected = RTree();
+  auto remaining = std::vector<RTree::value_t>();
+  std::copy_if(points.begin(), points.end(), std::back_inserter(remaining),
+               [](const auto &item) { return item.second % 3 != 0; });
+  expected.packing(remaining);
+
+  auto ids = std::vector<int64_t>();
+  rtree.for_each([&ids](const auto &item) { ids.push_back(item.second); });
+  std::sort(ids.begin(), ids.end());
+  ASSERT_EQ(ids.size(), remaining.size());
+  for (size_t ix = 0; ix < ids.size(); ++ix) {
+    EXPECT_EQ(ids[ix], remaining[ix].second);
+  }
+
+  for (auto ix = 0; ix < 100; ++ix) {
+    auto point =
+        geometry::PointND<double, 2>(uniform(generator), uniform(generator));
+    auto lhs = rtree.query(point, 8);
+    auto rhs = expected.query(point, 8);
+    ASSERT_EQ(lhs.size(), rhs.size());
+    for (size_t jx = 0; jx < lhs.size(); ++jx) {
+      EXPECT_DOUBLE_EQ(lhs[jx].first, rhs[jx].first);
+    }
+    EXPECT_EQ(rtree.query_ball(point, 5).size(),
+              expected.query_ball(point, 5).size());
+  }
+
+  // Enough changes fold the delta into a new packed index.
+  rtree.remove([](const RTree::value_t &item) { return item.second < 6000; });
+  EXPECT_EQ(rtree.size(), 2666);
+  auto bounds = rtree.bounds();
+  ASSERT_TRUE(bounds);
+  rtree.clear();
+  EXPECT_TRUE(rtree.empty());
+}
+
+TEST(geometry_rtree, mixed_precision) {
+  // Points located around the Earth's surface, in ECEF coordinates.
+  auto generator = std::mt19937(42);
+  auto uniform = std::uniform_real_distribution<double>(-1e4, 1e4);
+  auto points = std::vector<std::pair<geometry::PointND<double, 3>, double>>();
+  auto compact = std::vector<std::pair<geometry::PointND<float, 3>, double>>();
+  for (auto ix = 0; ix < 1000; ++ix) {
+    auto point = geometry::PointND<double, 3>(4.5e6 + uniform(generator),
+                                              uniform(generator),
+                                              4.5e6 + uniform(generator));
+    points.emplace_back(point, ix);
+    compact.emplace_back(
+        geometry::PointND<float, 3>(static_cast<float>(point.get<0>()),
+                                    static_cast<float>(point.get<1>()),
+                                    static_cast<float>(point.get<2>())),
+        ix);
+  }
+  auto rtree = geometry::RTree<double, double, 3>();
+  rtree.packing(points);
+  auto other = geometry::RTree<float, double, 3>();
+  other.packing(compact);
+
+  // The coordinates are rounded to the resolution of a float at the surface
+  // of the Earth: the distances agree within one meter.
+  for (auto ix = 0; ix < 100; ++ix) {
+    auto x = 4.5e6 + uniform(generator);
+    auto y = uniform(generator);
+    auto z = 4.5e6 + uniform(generator);
+    auto expected = rtree.query({x, y, z}, 4);
+    auto result = other.query(
+        {static_cast<float>(x), static_cast<float>(y), static_cast<float>(z)},
+        4);
+    ASSERT_EQ(result.size(), expected.size());
+    for (size_t jx = 0; jx < result.size(); ++jx) {
+      EXPECT_NEAR(result[jx].first, expected[jx].first, 1);
+    }
+    auto idw = other.inverse_distance_weighting(
+        {static_cast<float>(x), static_cast<float>(y), static_cast<float>(z)},
+        1e4, 4, 2, false);
+    EXPECT_EQ(idw.second, 4);
+  }
+  static_assert(
+      std::is_same_v<geometry::RTree<float, double, 3>::promotion_t, double>);
+  static_assert(sizeof(geometry::RTree<float, double, 3>::value_t) <
+                sizeof(geometry::RTree<double, double, 3>::value_t));
 }
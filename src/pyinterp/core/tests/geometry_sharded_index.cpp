@@ -0,0 +1,143 @@
+// Copyright (c) 2022 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "pyinterp/detail/geometry/sharded_index.hpp"
+
+namespace geometry = pyinterp::detail::geometry;
+
+using ShardedIndex = geometry::ShardedIndex<double, double, 3>;
+
+// Returns the key of the octant containing a point.
+static auto octant(const ShardedIndex::point_t& point) -> uint64_t {
+  return static_cast<uint64_t>(boost::geometry::get<0>(point) >= 0) |
+         (static_cast<uint64_t>(boost::geometry::get<1>(point) >= 0) << 1U) |
+         (static_cast<uint64_t>(boost::geometry::get<2>(point) >= 0) << 2U);
+}
+
+static auto random_points(const size_t size, std::vector<uint64_t>& keys)
+    -> std::vector<ShardedIndex::value_t> {
+  auto gen = std::mt19937(42);
+  auto uniform = std::uniform_real_distribution<>(-1, 1);
+  auto result = std::vector<ShardedIndex::value_t>();
+  keys.clear();
+  for (size_t ix = 0; ix < size; ++ix) {
+    auto point = ShardedIndex::point_t(uniform(gen), uniform(gen),
+                                       uniform(gen));
+    result.emplace_back(point, static_cast<double>(ix));
+    keys.push_back(octant(point));
+  }
+  return result;
+}
+
+TEST(geometry_sharded_index, packing) {
+  auto keys = std::vector<uint64_t>();
+  auto points = random_points(10000, keys);
+  auto index = ShardedIndex();
+  EXPECT_TRUE(index.empty());
+  EXPECT_THROW(index.packing(points, {1, 2}, 1), std::invalid_argument);
+
+  index.packing(points, keys, 1);
+  EXPECT_EQ(index.size(), 10000);
+  EXPECT_EQ(index.shards(), 8);
+  EXPECT_EQ(index.keys(), (std::vector<uint64_t>{0, 1, 2, 3, 4, 5, 6, 7}));
+  auto total = size_t(0);
+  for (auto key : index.keys()) {
+    EXPECT_EQ(index.shard_size(key),
+              static_cast<size_t>(std::count(keys.begin(), keys.end(), key)));
+    total += index.shard_size(key);
+  }
+  EXPECT_EQ(total, 10000);
+  EXPECT_EQ(index.shard_size(8), 0);
+
+  index.clear();
+  EXPECT_TRUE(index.empty());
+  EXPECT_EQ(index.shards(), 0);
+}
+
+TEST(geometry_sharded_index, nearest) {
+  auto keys = std::vector<uint64_t>();
+  auto points = random_points(20000, keys);
+  auto index = ShardedIndex();
+  index.packing(points, keys, 1);
+  auto kdtree = ShardedIndex::kdtree_t(points, 1);
+
+  auto gen = std::mt19937(0);
+  auto uniform = std::uniform_real_distribution<>(-1, 1);
+  auto neighbors = std::vector<ShardedIndex::neighbor_t>();
+  auto shards = std::vector<uint64_t>{3, 0, 7, 1, 6, 2, 5, 4};
+  auto expected = std::vector<ShardedIndex::kdtree_t::result_t>();
+
+  for (auto ix = 0; ix < 100; ++ix) {
+    auto point =
+        ShardedIndex::point_t(uniform(gen), uniform(gen), uniform(gen));
+    for (auto radius : {0.1, 1.0, 4.0}) {
+      // The neighbors merged from all the shards are those of a single tree.
+      index.nearest(point, shards.begin(), shards.end(), 16, radius,
+                    neighbors);
+      kdtree.nearest(point, 16, radius, expected);
+      ASSERT_EQ(neighbors.size(), expected.size());
+      for (size_t jx = 0; jx < neighbors.size(); ++jx) {
+        EXPECT_EQ(neighbors[jx].first, expected[jx].first);
+        EXPECT_EQ(neighbors[jx].second->second,
+                  kdtree[expected[jx].second].second);
+      }
+    }
+
+    // Only the shards requested are explored.
+    auto key = octant(point);
+    index.nearest(point, &key, &key + 1, 16, 4.0, neighbors);
+    ASSERT_EQ(neighbors.size(), 16);
+    for (const auto& item : neighbors) {
+      EXPECT_EQ(octant(item.second->first), key);
+    }
+  }
+}
+
+TEST(geometry_sharded_index, save_load) {
+  auto keys = std::vector<uint64_t>();
+  auto points = random_points(5000, keys);
+  auto index = ShardedIndex();
+  index.packing(points, keys, 1);
+  EXPECT_THROW(index.save(8, testing::TempDir() + "shard", ""),
+               std::invalid_argument);
+
+  auto other = ShardedIndex();
+  auto paths = std::vector<std::string>();
+  for (auto key : index.keys()) {
+    paths.push_back(testing::TempDir() + "geometry_sharded_index." +
+                    std::to_string(key));
+    index.save(key, paths.back(), "metadata");
+    EXPECT_EQ(other.load(key, paths.back()), "metadata");
+  }
+  EXPECT_EQ(other.size(), index.size());
+  EXPECT_EQ(other.keys(), index.keys());
+
+  // Loading a shard again replaces it.
+  EXPECT_EQ(other.load(0, paths.front()), "metadata");
+  EXPECT_EQ(other.size(), index.size());
+
+  auto point = ShardedIndex::point_t(0.1, 0.2, 0.3);
+  auto shards = index.keys();
+  auto lhs = std::vector<ShardedIndex::neighbor_t>();
+  auto rhs = std::vector<ShardedIndex::neighbor_t>();
+  index.nearest(point, shards.begin(), shards.end(), 8, 1.0, lhs);
+  other.nearest(point, shards.begin(), shards.end(), 8, 1.0, rhs);
+  ASSERT_EQ(lhs.size(), rhs.size());
+  for (size_t ix = 0; ix < lhs.size(); ++ix) {
+    EXPECT_EQ(lhs[ix].first, rhs[ix].first);
+    EXPECT_EQ(lhs[ix].second->second, rhs[ix].second->second);
+  }
+  other.clear();
+  for (const auto& path : paths) {
+    std::remove(path.c_str());
+  }
+}
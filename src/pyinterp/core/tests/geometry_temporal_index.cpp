@@ -0,0 +1,112 @@
+// Copyright (c) 2022 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include "pyinterp/detail/geometry/temporal_index.hpp"
+
+namespace geometry = pyinterp::detail::geometry;
+
+using TemporalIndex = geometry::TemporalIndex<double, double, 3>;
+
+// Observations spread over 30 days, dated in seconds.
+static auto random_observations(const size_t size)
+    -> std::vector<TemporalIndex::value_t> {
+  auto gen = std::mt19937(42);
+  auto uniform = std::uniform_real_distribution<>(-1, 1);
+  auto date = std::uniform_int_distribution<int64_t>(-15 * 86400, 15 * 86400);
+  auto result = std::vector<TemporalIndex::value_t>();
+  for (size_t ix = 0; ix < size; ++ix) {
+    result.push_back({TemporalIndex::point_t(uniform(gen), uniform(gen),
+                                             uniform(gen)),
+                      {date(gen), static_cast<double>(ix)}});
+  }
+  return result;
+}
+
+TEST(geometry_temporal_index, packing) {
+  EXPECT_THROW(TemporalIndex(0), std::invalid_argument);
+
+  auto index = TemporalIndex(86400);
+  EXPECT_TRUE(index.empty());
+  index.packing(random_observations(10000), 1);
+  EXPECT_EQ(index.size(), 10000);
+  EXPECT_EQ(index.partitions(), 30);
+  index.clear();
+  EXPECT_TRUE(index.empty());
+  EXPECT_EQ(index.partitions(), 0);
+}
+
+TEST(geometry_temporal_index, query) {
+  auto observations = random_observations(20000);
+  auto index = TemporalIndex(86400);
+  index.packing(observations, 1);
+
+  auto gen = std::mt19937(0);
+  auto uniform = std::uniform_real_distribution<>(-1, 1);
+  auto date = std::uniform_int_distribution<int64_t>(-16 * 86400, 16 * 86400);
+  auto distances = std::vector<double>(16);
+  auto values = std::vector<double>(16);
+
+  for (auto ix = 0; ix < 100; ++ix) {
+    auto point =
+        TemporalIndex::point_t(uniform(gen), uniform(gen), uniform(gen));
+    auto time = date(gen);
+    for (auto window : {int64_t(0), int64_t(6 * 3600), int64_t(5 * 86400)}) {
+      // Brute force search.
+      auto expected = std::vector<std::pair<double, double>>();
+      for (const auto& item : observations) {
+        if (std::abs(item.second.time - time) <= window) {
+          expected.emplace_back(boost::geometry::distance(point, item.first),
+                                item.second.value);
+        }
+      }
+      std::sort(expected.begin(), expected.end());
+      expected.resize(std::min<size_t>(expected.size(), 16));
+
+      auto count = index.query(point, time, window, 16, distances.data(),
+                               values.data());
+      ASSERT_EQ(count, expected.size());
+      for (size_t jx = 0; jx < count; ++jx) {
+        EXPECT_EQ(distances[jx], expected[jx].first);
+        EXPECT_EQ(values[jx], expected[jx].second);
+      }
+    }
+  }
+}
+
+TEST(geometry_temporal_index, inverse_distance_weighting) {
+  auto index = TemporalIndex(10);
+  auto observations = std::vector<TemporalIndex::value_t>{
+      {TemporalIndex::point_t(1, 0, 0), {-5, 1}},
+      {TemporalIndex::point_t(0, 2, 0), {3, 2}},
+      {TemporalIndex::point_t(0, 0, 1), {12, 3}},
+      {TemporalIndex::point_t(0, 0, 0), {40, 4}},
+  };
+  index.packing(observations, 1);
+  auto point = TemporalIndex::point_t(0, 0, 0);
+
+  // The observation located at the point of interest is outside the window.
+  auto result = index.inverse_distance_weighting(
+      point, 0, 12, std::numeric_limits<double>::max(), 8, 1);
+  EXPECT_EQ(result.second, 3);
+  EXPECT_DOUBLE_EQ(result.first, (1 + 2 * 0.5 + 3) / (1 + 0.5 + 1));
+
+  result = index.inverse_distance_weighting(point, 0, 12, 1.5, 8, 1);
+  EXPECT_EQ(result.second, 2);
+  EXPECT_DOUBLE_EQ(result.first, 2);
+
+  result = index.inverse_distance_weighting(point, 41, 1, 1.5, 8, 1);
+  EXPECT_EQ(result.first, 4);
+
+  result = index.inverse_distance_weighting(point, 100, 10, 1.5, 8, 1);
+  EXPECT_EQ(result.second, 0);
+  EXPECT_TRUE(std::isnan(result.first));
+}
@@ -0,0 +1,116 @@
+// Copyright (c) 2022 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <random>
+
+#include "pyinterp/detail/histogram_grid.hpp"
+
+namespace detail = pyinterp::detail;
+using HistogramGrid = detail::HistogramGrid<double>;
+using StreamingHistogram = detail::math::StreamingHistogram<double>;
+
+static void check_equal(const StreamingHistogram& lhs,
+                        const StreamingHistogram& rhs) {
+  EXPECT_EQ(lhs.count(), rhs.count());
+  EXPECT_EQ(lhs.min(), rhs.min());
+  EXPECT_EQ(lhs.max(), rhs.max());
+  EXPECT_EQ(lhs.exact(), rhs.exact());
+  ASSERT_EQ(lhs.size(), rhs.size());
+  for (size_t ix = 0; ix < lhs.size(); ++ix) {
+    EXPECT_EQ(lhs.bins()[ix].value, rhs.bins()[ix].value);
+    EXPECT_EQ(lhs.bins()[ix].weight, rhs.bins()[ix].weight);
+  }
+}
+
+TEST(histogram_grid, store) {
+  for (auto sparse : {false, true}) {
+    auto grid = HistogramGrid(10, 20, sparse, 8);
+    EXPECT_EQ(grid.sparse(), sparse);
+    EXPECT_EQ(grid.size(), 200);
+    EXPECT_EQ(grid.bin_count(), 8U);
+    EXPECT_EQ(grid.slots(), 0U);
+
+    auto generator = std::mt19937(42);
+    auto distribution = std::normal_distribution<double>(0, 1);
+    auto expected =
+        std::vector<StreamingHistogram>(200, StreamingHistogram(8, false));
+    auto item = StreamingHistogram();
+    for (uint64_t index = 0; index < 200; index += 3) {
+      for (auto ix = 0; ix < static_cast<int>(index % 20); ++ix) {
+        expected[index](distribution(generator));
+      }
+      grid.load(index, item);
+      for (const auto& bin : expected[index].bins()) {
+        item.buffer(bin.value, bin.weight);
+      }
+      grid.store(index, item);
+    }
+    EXPECT_EQ(grid.slots(), 67U);
+    EXPECT_EQ(grid.indexes().size(), 63U);
+
+    for (uint64_t index = 0; index < 200; ++index) {
+      grid.load(index, item);
+      EXPECT_EQ(item.bin_count(), 8U);
+      EXPECT_EQ(item.sum_of_weights(), expected[index].sum_of_weights());
+      EXPECT_EQ(item.size(), expected[index].size());
+      if (expected[index].count() != 0 && expected[index].exact()) {
+        check_equal(item, expected[index]);
+      }
+    }
+
+    // The slots are reused once the grid is cleared.
+    grid.clear();
+    EXPECT_EQ(grid.slots(), 0U);
+    EXPECT_TRUE(grid.indexes().empty());
+    grid.load(grid.index(3, 4), item);
+    EXPECT_EQ(item.count(), 0U);
+    EXPECT_TRUE(std::isnan(item.min()));
+    EXPECT_TRUE(item.bins().empty());
+  }
+}
+
+TEST(histogram_grid, arena) {
+  // A slot per block of the arena.
+  auto grid = HistogramGrid(100, 10, false, 70000);
+  auto item = StreamingHistogram();
+  for (uint64_t index = 0; index < 1000; ++index) {
+    grid.load(index, item);
+    item(static_cast<double>(index));
+    item(static_cast<double>(index) + 0.5);
+    grid.store(index, item);
+  }
+  EXPECT_EQ(grid.slots(), 1000U);
+  for (uint64_t index = 0; index < 1000; ++index) {
+    grid.load(index, item);
+    ASSERT_EQ(item.size(), 2U);
+    EXPECT_EQ(item.count(), 2U);
+    EXPECT_EQ(item.bins()[0].value, static_cast<double>(index));
+    EXPECT_EQ(item.bins()[1].value, static_cast<double>(index) + 0.5);
+    EXPECT_EQ(item.quantile(0.5), static_cast<double>(index) + 0.25);
+  }
+}
+
+TEST(histogram_grid, resize) {
+  auto grid = HistogramGrid(2, 2, true, 4);
+  auto item = StreamingHistogram(16, false);
+  for (auto ix = 0; ix < 16; ++ix) {
+    item(static_cast<double>(ix));
+  }
+  // The histograms holding more bins than those of the grid are compressed.
+  grid.store(grid.index(1, 1), item);
+  EXPECT_EQ(item.bin_count(), 4U);
+  EXPECT_EQ(item.size(), 4U);
+  EXPECT_FALSE(item.exact());
+
+  auto other = StreamingHistogram(16, false);
+  grid.load(grid.index(1, 1), other);
+  check_equal(item, other);
+  EXPECT_EQ(other.bin_count(), 4U);
+  EXPECT_EQ(other.min(), 0);
+  EXPECT_EQ(other.max(), 15);
+  EXPECT_EQ(other.count(), 16U);
+}
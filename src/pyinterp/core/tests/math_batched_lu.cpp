@@ -0,0 +1,55 @@
+// Copyright (c) 2022 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+#include <gtest/gtest.h>
+
+#include <Eigen/LU>
+#include <random>
+
+#include "pyinterp/detail/math/batched_lu.hpp"
+
+namespace math = pyinterp::detail::math;
+
+TEST(math_batched_lu, solve) {
+  auto generator = std::mt19937(42);
+  auto uniform = std::uniform_real_distribution<double>(-1, 1);
+  auto solver = math::BatchedLU<double, 4>(6);
+
+  // Systems of different sizes, padded to the size of the solver.
+  auto matrices = std::vector<Eigen::MatrixXd>();
+  auto rhs = std::vector<Eigen::VectorXd>();
+  for (size_t lane = 0; lane < 4; ++lane) {
+    const auto n = static_cast<Eigen::Index>(3 + lane);
+    matrices.emplace_back(Eigen::MatrixXd::NullaryExpr(
+        n, n, [&]() { return uniform(generator); }));
+    rhs.emplace_back(
+        Eigen::VectorXd::NullaryExpr(n, [&]() { return uniform(generator); }));
+    // A null first pivot requires a row exchange.
+    matrices.back()(0, 0) = 0;
+    solver.set(lane, matrices.back(), rhs.back());
+  }
+  auto regular = solver.solve();
+  for (size_t lane = 0; lane < 4; ++lane) {
+    ASSERT_TRUE(regular[lane]);
+    auto expected =
+        Eigen::VectorXd(matrices[lane].fullPivLu().solve(rhs[lane]));
+    auto x = solver.solution(lane, matrices[lane].rows());
+    EXPECT_LT((x - expected).cwiseAbs().maxCoeff(), 1e-10);
+  }
+}
+
+TEST(math_batched_lu, singular) {
+  auto solver = math::BatchedLU<double, 2>(3);
+  auto A = Eigen::MatrixXd(3, 3);
+  A << 1, 2, 3, 2, 4, 6, 1, 0, 1;
+  auto b = Eigen::VectorXd(3);
+  b << 1, 2, 3;
+  solver.set(0, A, b);
+  solver.set(1, Eigen::MatrixXd::Identity(3, 3) * 2, b);
+  auto regular = solver.solve();
+  EXPECT_FALSE(regular[0]);
+  ASSERT_TRUE(regular[1]);
+  EXPECT_DOUBLE_EQ(solver.solution(1, 3)(2), 1.5);
+  EXPECT_TRUE(solver.solution(0, 3).allFinite());
+}
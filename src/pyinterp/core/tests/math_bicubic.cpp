@@ -4,7 +4,11 @@
 // BSD-style license that can be found in the LICENSE file.
 #include <gtest/gtest.h>
 
+#include <array>
+#include <cmath>
+
 #include "pyinterp/detail/math/bicubic.hpp"
+#include "pyinterp/detail/math/bicubic_coefficients.hpp"
 
 namespace math = pyinterp::detail::math;
 namespace gsl = pyinterp::detail::gsl;
@@ -37,3 +41,99 @@ TEST(math_bicubic, bicubic) {
                 1e-10);
   }
 }
+
+TEST(math_bicubic, fit) {
+  // The coefficients computed once for a frame give the same results as a
+  // fit performed for each point.
+  auto xr = math::Frame2D(2, 2);
+  for (auto ix = 0; ix < 4; ++ix) {
+    xr.x(ix) = xr.y(ix) = ix;
+    for (auto jx = 0; jx < 4; ++jx) {
+      xr.q(ix, jx) = std::sin(ix * 0.5) * std::cos(jx * 0.5);
+    }
+  }
+
+  auto interpolator = math::Bicubic(xr, "bicubic");
+  auto reference = math::Bicubic(xr, "bicubic");
+  interpolator.fit(xr);
+  for (auto ix = 0; ix < 10; ++ix) {
+    auto x = 1 + ix * 0.1;
+    auto y = 1.9 - ix * 0.1;
+    EXPECT_DOUBLE_EQ(interpolator.interpolate(x, y),
+                     reference.interpolate(x, y, xr));
+  }
+}
+
+TEST(math_bicubic, coefficients) {
+  // The polynomial fitted on the central cell of the frame reproduces the
+  // bicubic interpolation of this cell.
+  auto xr = math::Frame2D(2, 2);
+  for (auto ix = 0; ix < 4; ++ix) {
+    xr.x(ix) = ix * 0.5;
+    xr.y(ix) = ix * 2.0;
+    for (auto jx = 0; jx < 4; ++jx) {
+      xr.q(ix, jx) = std::sin(ix * 0.7) + std::cos(jx * 0.3) * ix;
+    }
+  }
+
+  auto interpolator = math::Bicubic(xr, "bicubic");
+  auto coefficients = std::array<double, 16>();
+  math::BicubicCoefficients::fit(interpolator, xr, coefficients.data());
+  for (auto ix = 0; ix <= 10; ++ix) {
+    for (auto jx = 0; jx <= 10; ++jx) {
+      auto t = ix / 10.0;
+      auto u = jx / 10.0;
+      EXPECT_NEAR(math::BicubicCoefficients::evaluate(coefficients.data(), t,
+                                                      u),
+                  interpolator.interpolate(0.5 + t * 0.5, 2 + u * 2, xr),
+                  1e-12);
+    }
+  }
+}
+
+TEST(math_bicubic, gradient) {
+  // The derivatives of the interpolated function are those of the
+  // polynomial precomputed for the cell, and match its finite differences.
+  auto xr = math::Frame2D(2, 2);
+  for (auto ix = 0; ix < 4; ++ix) {
+    xr.x(ix) = ix * 0.5;
+    xr.y(ix) = ix * 2.0;
+    for (auto jx = 0; jx < 4; ++jx) {
+      xr.q(ix, jx) = std::sin(ix * 0.7) + std::cos(jx * 0.3) * ix;
+    }
+  }
+
+  auto interpolator = math::Bicubic(xr, "bicubic");
+  auto coefficients = std::array<double, 16>();
+  math::BicubicCoefficients::fit(interpolator, xr, coefficients.data());
+  constexpr auto h = 1e-6;
+  auto dx = 0.0;
+  auto dy = 0.0;
+  auto dt = 0.0;
+  auto du = 0.0;
+  for (auto ix = 1; ix < 10; ++ix) {
+    for (auto jx = 1; jx < 10; ++jx) {
+      auto t = ix / 10.0;
+      auto u = jx / 10.0;
+      auto x = 0.5 + t * 0.5;
+      auto y = 2 + u * 2;
+      EXPECT_DOUBLE_EQ(interpolator.gradient(x, y, dx, dy),
+                       interpolator.interpolate(x, y));
+      EXPECT_NEAR(dx,
+                  (interpolator.interpolate(x + h, y) -
+                   interpolator.interpolate(x - h, y)) /
+                      (2 * h),
+                  1e-6);
+      EXPECT_NEAR(dy,
+                  (interpolator.interpolate(x, y + h) -
+                   interpolator.interpolate(x, y - h)) /
+                      (2 * h),
+                  1e-6);
+      EXPECT_NEAR(math::BicubicCoefficients::gradient(coefficients.data(), t,
+                                                      u, dt, du),
+                  interpolator.interpolate(x, y), 1e-12);
+      EXPECT_NEAR(dt / 0.5, dx, 1e-10);
+      EXPECT_NEAR(du / 2, dy, 1e-10);
+    }
+  }
+}
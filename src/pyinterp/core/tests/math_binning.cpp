@@ -165,3 +165,58 @@ TEST(math_binning, binning_spheroid) {
   EXPECT_NEAR(std::get<2>(weights), 0, 1e-6);
   EXPECT_NEAR(std::get<3>(weights), 0.9999999999, 1e-6);
 }
+
+TEST(math_binning, bilinear_binning_cartesian) {
+  auto strategy = boost::geometry::strategy::area::cartesian<>();
+  for (const auto& [x, y] : {std::make_tuple(2.0, 2.0), {1.5, 4.5},
+                             {1.0, 1.0}, {3.0, 5.0}, {2.25, 1.0}}) {
+    auto expected =
+        math::binning_2d<geometry::Point2D,
+                         boost::geometry::strategy::area::cartesian<>, double>(
+            {x, y}, {1, 1}, {3, 5}, strategy);
+    auto weights = math::bilinear_binning_2d<double>(x, y, 1, 1, 3, 5);
+    EXPECT_NEAR(std::get<0>(weights), std::get<0>(expected), 1e-12);
+    EXPECT_NEAR(std::get<1>(weights), std::get<1>(expected), 1e-12);
+    EXPECT_NEAR(std::get<2>(weights), std::get<2>(expected), 1e-12);
+    EXPECT_NEAR(std::get<3>(weights), std::get<3>(expected), 1e-12);
+  }
+}
+
+TEST(math_binning, bilinear_binning_spheroid) {
+  auto wgs84 = boost::geometry::srs::spheroid(6378137.0, 6356752.3142451793);
+  auto strategy = boost::geometry::strategy::area::geographic<>(wgs84);
+  const auto e = std::sqrt(1 - std::pow(6356752.3142451793 / 6378137.0, 2));
+
+  // For small cells, the edges of the polygons, geodesics, are close to the
+  // parallels bounding the cells.
+  auto binning = math::GeographicBinning2D<double>(e, {45.6, 45.7});
+  for (const auto& [lon, lat] :
+       {std::make_tuple(31.75, 45.65), {31.71, 45.69}, {31.8, 45.6}}) {
+    auto expected =
+        math::binning_2d<geometry::GeographicPoint2D,
+                         boost::geometry::strategy::area::geographic<>,
+                         double>({lon, lat}, {31.7, 45.6}, {31.8, 45.7},
+                                 strategy);
+    auto weights = binning(lon, lat, 31.7, 31.8, 0, 1);
+    EXPECT_NEAR(std::get<0>(weights), std::get<0>(expected), 1e-4);
+    EXPECT_NEAR(std::get<1>(weights), std::get<1>(expected), 1e-4);
+    EXPECT_NEAR(std::get<2>(weights), std::get<2>(expected), 1e-4);
+    EXPECT_NEAR(std::get<3>(weights), std::get<3>(expected), 1e-4);
+  }
+
+  // The area between the equator and the sample is larger than the area
+  // between the sample and the northern parallel of the cell.
+  binning = math::GeographicBinning2D<double>(e, {0, 60});
+  auto weights = binning(0.5, 30, 0, 1, 0, 1);
+  EXPECT_LT(std::get<0>(weights), 0.25);
+  EXPECT_NEAR(std::get<0>(weights) + std::get<1>(weights) +
+                  std::get<2>(weights) + std::get<3>(weights),
+              1, 1e-12);
+
+  // On a sphere, the area between two parallels is proportional to the
+  // difference of the sines of their latitudes.
+  binning = math::GeographicBinning2D<double>(0, {0, 90});
+  weights = binning(0.5, 30, 0, 1, 0, 1);
+  EXPECT_NEAR(std::get<0>(weights), 0.25, 1e-12);
+  EXPECT_NEAR(std::get<1>(weights), 0.25, 1e-12);
+}
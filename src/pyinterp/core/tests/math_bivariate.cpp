@@ -4,7 +4,12 @@
 // BSD-style license that can be found in the LICENSE file.
 #include <gtest/gtest.h>
 
+#include <algorithm>
 #include <boost/geometry.hpp>
+#include <cmath>
+#include <limits>
+#include <string>
+#include <type_traits>
 
 #include "pyinterp/detail/geometry/point.hpp"
 #include "pyinterp/detail/math/bivariate.hpp"
@@ -63,6 +68,45 @@ TEST(math_bivariate, nearest) {
                    95);
 }
 
+TEST(math_bivariate, bilinear_float32) {
+  // The single precision computation is bounded by the documented error of
+  // the interpolations of float32 grids.
+  auto single = math::Bilinear<geometry::EquatorialPoint2D, float>();
+  auto reference = math::Bilinear<geometry::EquatorialPoint2D, double>();
+  const auto eps = static_cast<double>(std::numeric_limits<float>::epsilon());
+  const auto dx = 0.25;
+  const auto dy = 0.25;
+
+  for (auto ix = 0; ix < 1440; ix += 7) {
+    for (auto iy = 0; iy < 720; iy += 11) {
+      const auto x0 = -180.0 + ix * dx;
+      const auto y0 = -90.0 + iy * dy;
+      // Coordinates and values representable in single precision.
+      const auto x = static_cast<double>(static_cast<float>(x0 + 0.3 * dx));
+      const auto y = static_cast<double>(static_cast<float>(y0 + 0.7 * dy));
+      const auto q00 = static_cast<float>(std::sin(x0) * 300);
+      const auto q01 = static_cast<float>(std::cos(y0) * 300);
+      const auto q10 = static_cast<float>(std::sin(x0 + y0) * 300);
+      const auto q11 = static_cast<float>(std::cos(x0 - y0) * 300);
+
+      const auto expected = reference.evaluate(
+          {x, y}, {x0, y0}, {x0 + dx, y0 + dy}, q00, q01, q10, q11);
+      const auto value = single.evaluate(
+          {static_cast<float>(x), static_cast<float>(y)},
+          {static_cast<float>(x0), static_cast<float>(y0)},
+          {static_cast<float>(x0 + dx), static_cast<float>(y0 + dy)}, q00,
+          q01, q10, q11);
+      const auto dq = std::max({q00, q01, q10, q11}) -
+                      std::min({q00, q01, q10, q11});
+      const auto q = std::max({std::fabs(q00), std::fabs(q01),
+                               std::fabs(q10), std::fabs(q11)});
+      const auto bound =
+          eps * (std::fabs(x) / dx + std::fabs(y) / dy) * dq + 4 * eps * q;
+      EXPECT_NEAR(value, expected, bound) << x << " " << y;
+    }
+  }
+}
+
 TEST(math_bivariate, idw) {
   auto interpolator =
       math::InverseDistanceWeighting<geometry::Point2D, double>();
@@ -95,3 +139,73 @@ TEST(math_bivariate, idw) {
                             geometry::Point2D<double>{1, 1}, 0, 1, 2, 3),
       1.5);
 }
+
+TEST(math_bivariate, visit) {
+  // A custom interpolator is handed over as the abstract class.
+  struct Custom : public math::Bivariate<geometry::Point2D, double> {
+    auto evaluate(const geometry::Point2D<double>& /*p*/,
+                  const geometry::Point2D<double>& /*p0*/,
+                  const geometry::Point2D<double>& /*p1*/,
+                  const double& /*q00*/, const double& /*q01*/,
+                  const double& /*q10*/, const double& /*q11*/) const
+        -> double override {
+      return 0;
+    }
+  };
+
+  using Bilinear = math::Bilinear<geometry::Point2D, double>;
+  using Nearest = math::Nearest<geometry::Point2D, double>;
+  using InverseDistanceWeighting =
+      math::InverseDistanceWeighting<geometry::Point2D, double>;
+
+  auto bilinear = Bilinear();
+  auto nearest = Nearest();
+  auto idw = InverseDistanceWeighting();
+  auto custom = Custom();
+
+  auto type_of = [](const math::Bivariate<geometry::Point2D, double>* ptr) {
+    auto result = std::string();
+    math::visit(ptr, [&](const auto* concrete) {
+      using Type = std::remove_cv_t<std::remove_pointer_t<decltype(concrete)>>;
+      if constexpr (std::is_same_v<Type, Bilinear>) {
+        result = "bilinear";
+      } else if constexpr (std::is_same_v<Type, Nearest>) {
+        result = "nearest";
+      } else if constexpr (std::is_same_v<Type, InverseDistanceWeighting>) {
+        result = "idw";
+      } else {
+        result = "abstract";
+      }
+      EXPECT_EQ(static_cast<const void*>(concrete),
+                static_cast<const void*>(ptr));
+    });
+    return result;
+  };
+  EXPECT_EQ(type_of(&bilinear), "bilinear");
+  EXPECT_EQ(type_of(&nearest), "nearest");
+  EXPECT_EQ(type_of(&idw), "idw");
+  EXPECT_EQ(type_of(&custom), "abstract");
+}
+
+TEST(math_bivariate, bilinear_gradient) {
+  auto interpolator = math::Bilinear<geometry::Point2D, double>();
+  auto p0 = geometry::Point2D<double>{14.0, 20.0};
+  auto p1 = geometry::Point2D<double>{15.0, 22.0};
+  auto dx = 0.0;
+  auto dy = 0.0;
+
+  // f(x, y) = 3x - 2y + xy is interpolated exactly.
+  auto f = [](const double x, const double y) { return 3 * x - 2 * y + x * y; };
+  for (auto x : {14.0, 14.25, 14.5, 15.0}) {
+    for (auto y : {20.0, 20.5, 21.75}) {
+      auto p = geometry::Point2D<double>{x, y};
+      EXPECT_NEAR(interpolator.gradient(p, p0, p1, f(14, 20), f(14, 22),
+                                        f(15, 20), f(15, 22), dx, dy),
+                  interpolator.evaluate(p, p0, p1, f(14, 20), f(14, 22),
+                                        f(15, 20), f(15, 22)),
+                  1e-12);
+      EXPECT_NEAR(dx, 3 + y, 1e-12);
+      EXPECT_NEAR(dy, -2 + x, 1e-12);
+    }
+  }
+}
@@ -13,6 +13,9 @@
 #include <boost/accumulators/statistics/weighted_sum.hpp>
 #include <boost/accumulators/statistics/weighted_variance.hpp>
 
+#include <random>
+#include <vector>
+
 #include "pyinterp/detail/math/descriptive_statistics.hpp"
 
 namespace math = pyinterp::detail::math;
@@ -110,3 +113,98 @@ TEST(math_descriptive_statistics, weighted) {
   EXPECT_DOUBLE_EQ(boost::accumulators::sum_of_weights(boost_acc),
                    acc.sum_of_weights());
 }
+
+TEST(math_descriptive_statistics, push) {
+  auto generator = std::mt19937(0);
+  auto distribution = std::normal_distribution<double>(10, 3);
+  auto values = std::vector<double>(1001);
+  for (auto& item : values) {
+    item = distribution(generator);
+  }
+  values[3] = values[600] = values[1000] =
+      std::numeric_limits<double>::quiet_NaN();
+
+  auto expected = math::DescriptiveStatistics<double>();
+  for (const auto& item : values) {
+    if (!std::isnan(item)) {
+      expected(item);
+    }
+  }
+
+  auto acc = math::DescriptiveStatistics<double>();
+  acc.push(values.data(), values.data() + 10);
+  acc.push(values.data() + 10, values.data() + values.size());
+
+  EXPECT_EQ(expected.count(), acc.count());
+  EXPECT_DOUBLE_EQ(expected.sum_of_weights(), acc.sum_of_weights());
+  EXPECT_DOUBLE_EQ(expected.min(), acc.min());
+  EXPECT_DOUBLE_EQ(expected.max(), acc.max());
+  EXPECT_NEAR(expected.sum(), acc.sum(), 1e-9);
+  EXPECT_NEAR(expected.mean(), acc.mean(), 1e-12);
+  EXPECT_NEAR(expected.variance(), acc.variance(), 1e-12);
+  EXPECT_NEAR(expected.skewness(), acc.skewness(), 1e-12);
+  EXPECT_NEAR(expected.kurtosis(), acc.kurtosis(), 1e-12);
+
+  // Only NaNs: the accumulator stays empty.
+  auto empty = math::DescriptiveStatistics<double>();
+  empty.push(values.data() + 3, values.data() + 4);
+  EXPECT_EQ(empty.count(), 0);
+  EXPECT_TRUE(std::isnan(empty.min()));
+
+  // Merging an empty accumulator keeps the min and max.
+  acc += empty;
+  EXPECT_DOUBLE_EQ(expected.min(), acc.min());
+  EXPECT_DOUBLE_EQ(expected.max(), acc.max());
+  empty += acc;
+  EXPECT_DOUBLE_EQ(expected.min(), empty.min());
+  EXPECT_DOUBLE_EQ(expected.max(), empty.max());
+  EXPECT_NEAR(expected.variance(), empty.variance(), 1e-12);
+}
+
+TEST(math_descriptive_statistics, level) {
+  using Level = math::StatisticsLevel;
+  auto full = math::DescriptiveStatistics<double>();
+  auto count = math::DescriptiveStatistics<double, Level::kCount>();
+  auto mean = math::DescriptiveStatistics<double, Level::kMean>();
+  auto variance = math::DescriptiveStatistics<double, Level::kVariance>();
+
+  EXPECT_LT(sizeof(count), sizeof(mean));
+  EXPECT_LT(sizeof(mean), sizeof(variance));
+  EXPECT_LT(sizeof(variance), sizeof(full));
+
+  for (auto ix = 0; ix < 10; ++ix) {
+    full(x[ix], w[ix]);
+    count(x[ix], w[ix]);
+    mean(x[ix], w[ix]);
+    variance(x[ix], w[ix]);
+  }
+  full.push(x + 10, x + 20);
+  count.push(x + 10, x + 20);
+  mean.push(x + 10, x + 20);
+  variance.push(x + 10, x + 20);
+
+  EXPECT_EQ(full.count(), count.count());
+  EXPECT_DOUBLE_EQ(full.sum_of_weights(), count.sum_of_weights());
+  EXPECT_TRUE(std::isnan(count.mean()));
+  EXPECT_TRUE(std::isnan(count.sum()));
+
+  EXPECT_EQ(full.count(), mean.count());
+  EXPECT_DOUBLE_EQ(full.sum_of_weights(), mean.sum_of_weights());
+  EXPECT_DOUBLE_EQ(full.mean(), mean.mean());
+  EXPECT_DOUBLE_EQ(full.min(), mean.min());
+  EXPECT_DOUBLE_EQ(full.max(), mean.max());
+  EXPECT_DOUBLE_EQ(full.sum(), mean.sum());
+  EXPECT_TRUE(std::isnan(mean.variance()));
+
+  EXPECT_DOUBLE_EQ(full.mean(), variance.mean());
+  EXPECT_DOUBLE_EQ(full.variance(), variance.variance());
+  EXPECT_TRUE(std::isnan(variance.skewness()));
+  EXPECT_TRUE(std::isnan(variance.kurtosis()));
+
+  auto copy = math::DescriptiveStatistics<double, Level::kVariance>(
+      static_cast<math::Accumulators<double, Level::kVariance>>(variance));
+  copy += variance;
+  EXPECT_EQ(copy.count(), 2 * full.count());
+  EXPECT_DOUBLE_EQ(copy.mean(), full.mean());
+  EXPECT_DOUBLE_EQ(copy.variance(), full.variance());
+}
@@ -0,0 +1,31 @@
+// Copyright (c) 2022 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <limits>
+
+#include "pyinterp/detail/math/float16.hpp"
+
+namespace math = pyinterp::detail::math;
+
+TEST(math_float16, float16_to_float32) {
+  EXPECT_EQ(math::float16_to_float32(0x0000), 0.0F);
+  EXPECT_TRUE(std::signbit(math::float16_to_float32(0x8000)));
+  EXPECT_EQ(math::float16_to_float32(0x3c00), 1.0F);
+  EXPECT_EQ(math::float16_to_float32(0xc000), -2.0F);
+  EXPECT_EQ(math::float16_to_float32(0x3555), 0.333251953125F);
+  // Largest normal number
+  EXPECT_EQ(math::float16_to_float32(0x7bff), 65504.0F);
+  // Smallest normal and subnormal numbers
+  EXPECT_EQ(math::float16_to_float32(0x0400), std::ldexp(1.0F, -14));
+  EXPECT_EQ(math::float16_to_float32(0x0001), std::ldexp(1.0F, -24));
+  EXPECT_EQ(math::float16_to_float32(0x83ff), -std::ldexp(1023.0F, -24));
+  EXPECT_EQ(math::float16_to_float32(0x7c00),
+            std::numeric_limits<float>::infinity());
+  EXPECT_EQ(math::float16_to_float32(0xfc00),
+            -std::numeric_limits<float>::infinity());
+  EXPECT_TRUE(std::isnan(math::float16_to_float32(0x7e00)));
+}
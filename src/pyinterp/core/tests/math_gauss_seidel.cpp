@@ -0,0 +1,310 @@
+// Copyright (c) 2022 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <limits>
+#include <random>
+#include <tuple>
+
+#include "pyinterp/detail/math/gauss_seidel.hpp"
+
+namespace math = pyinterp::detail::math;
+
+using RowMajor =
+    Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
+using GridMap =
+    Eigen::Map<pyinterp::Matrix<double>, 0,
+               Eigen::Stride<Eigen::Dynamic, Eigen::Dynamic>>;
+
+// Builds a grid with 30% of undefined values, replaced by zero.
+static auto build_grid(const int64_t x_size, const int64_t y_size,
+                       pyinterp::Matrix<bool>& mask)
+    -> pyinterp::Matrix<double> {
+  auto generator = std::mt19937(42);
+  auto distribution = std::uniform_real_distribution<double>(0, 1);
+  auto grid = pyinterp::Matrix<double>(x_size, y_size);
+  mask.resize(x_size, y_size);
+  for (int64_t iy = 0; iy < y_size; ++iy) {
+    for (int64_t ix = 0; ix < x_size; ++ix) {
+      mask(ix, iy) = distribution(generator) < 0.3;
+      grid(ix, iy) = mask(ix, iy) ? 0 : std::sin(ix * 0.2) * std::cos(iy * 0.1);
+    }
+  }
+  return grid;
+}
+
+// Reference implementation: the whole grid is scanned at each iteration.
+static auto reference(pyinterp::Matrix<double>& grid,
+                      const pyinterp::Matrix<bool>& mask, const bool is_circle,
+                      const double relaxation, const double tolerance = 0)
+    -> std::tuple<double, size_t> {
+  auto result = 0.0;
+  auto unconverged = size_t(0);
+  auto x_size = grid.rows();
+  auto y_size = grid.cols();
+  for (int64_t ix = 0; ix < x_size; ++ix) {
+    auto ix0 = math::previous_index(ix, x_size, is_circle);
+    auto ix1 = math::next_index(ix, x_size, is_circle);
+    for (int64_t iy = 0; iy < y_size; ++iy) {
+      if (mask(ix, iy)) {
+        auto iy0 = math::previous_index(iy, y_size, false);
+        auto iy1 = math::next_index(iy, y_size, false);
+        auto residual = (0.25 * (grid(ix0, iy) + grid(ix1, iy) +
+                                 grid(ix, iy0) + grid(ix, iy1)) -
+                         grid(ix, iy)) *
+                        relaxation;
+        grid(ix, iy) += residual;
+        result = std::max(result, std::fabs(residual));
+        unconverged += std::fabs(residual) < tolerance ? 0 : 1;
+      }
+    }
+  }
+  return std::make_tuple(result, unconverged);
+}
+
+TEST(math_gauss_seidel, lexicographic) {
+  for (auto is_circle : {false, true}) {
+    auto mask = pyinterp::Matrix<bool>();
+    auto grid = build_grid(41, 33, mask);
+    auto expected = pyinterp::Matrix<double>(grid);
+
+    auto strips = math::lexicographic_cells(grid, mask, is_circle, 1);
+    ASSERT_EQ(strips.size(), 1);
+    EXPECT_EQ(strips[0].cells.size(), mask.count());
+    EXPECT_EQ(strips[0].columns.size(), grid.rows() + 1);
+
+    for (auto ix = 0; ix < 10; ++ix) {
+      auto result =
+          math::lexicographic_gauss_seidel(grid, strips, 1.5, 1e-2, false);
+      EXPECT_EQ(result, reference(expected, mask, is_circle, 1.5, 1e-2));
+      EXPECT_GT(std::get<1>(result), 0);
+    }
+    EXPECT_EQ(strips[0].cells.size(), mask.count());
+    EXPECT_EQ((grid - expected).cwiseAbs().maxCoeff(), 0);
+  }
+}
+
+TEST(math_gauss_seidel, lexicographic_threads) {
+  auto mask = pyinterp::Matrix<bool>();
+  auto grid = build_grid(64, 48, mask);
+  auto expected = pyinterp::Matrix<double>(grid);
+
+  auto strips = math::lexicographic_cells(grid, mask, true, 4);
+  ASSERT_EQ(strips.size(), 4);
+  auto count = size_t(0);
+  for (auto& item : strips) {
+    count += item.cells.size();
+  }
+  EXPECT_EQ(count, mask.count());
+
+  for (auto ix = 0; ix < 2000; ++ix) {
+    if (std::get<0>(math::lexicographic_gauss_seidel(grid, strips, 1.5, 1e-12,
+                                                     false)) < 1e-12) {
+      break;
+    }
+  }
+  for (auto ix = 0; ix < 2000; ++ix) {
+    if (std::get<0>(reference(expected, mask, true, 1.5)) < 1e-12) {
+      break;
+    }
+  }
+  EXPECT_LT((grid - expected).cwiseAbs().maxCoeff(), 1e-9);
+}
+
+TEST(math_gauss_seidel, red_black) {
+  for (auto is_circle : {false, true}) {
+    for (auto x_size : {40, 41}) {
+      auto mask = pyinterp::Matrix<bool>();
+      auto grid = build_grid(x_size, 33, mask);
+      auto other = pyinterp::Matrix<double>(grid);
+      auto expected = pyinterp::Matrix<double>(grid);
+
+      auto cells = math::red_black_cells(grid, mask, is_circle);
+      auto count = size_t(0);
+      for (auto& item : cells) {
+        count += item.size();
+      }
+      EXPECT_EQ(count, mask.count());
+      // The additional colors are only used by odd circles.
+      EXPECT_EQ(cells[2].empty(), !is_circle || x_size % 2 == 0);
+
+      auto other_cells = cells;
+      for (auto ix = 0; ix < 2000; ++ix) {
+        auto result = math::red_black_gauss_seidel(grid, cells, 1.5, 1e-6,
+                                                   false, size_t(1));
+        EXPECT_EQ(result, math::red_black_gauss_seidel(other, other_cells, 1.5,
+                                                       1e-6, false, size_t(4)));
+        if (std::get<0>(result) < 1e-12) {
+          EXPECT_EQ(std::get<1>(result), 0);
+          break;
+        }
+      }
+      EXPECT_EQ((grid - other).cwiseAbs().maxCoeff(), 0);
+
+      for (auto ix = 0; ix < 2000; ++ix) {
+        if (std::get<0>(reference(expected, mask, is_circle, 1.5)) < 1e-12) {
+          break;
+        }
+      }
+      EXPECT_LT((grid - expected).cwiseAbs().maxCoeff(), 1e-9);
+    }
+  }
+}
+
+TEST(math_gauss_seidel, layout) {
+  // The grid has the memory layout of a C-contiguous numpy array.
+  auto mask = pyinterp::Matrix<bool>();
+  auto grid = build_grid(37, 29, mask);
+  auto buffer = RowMajor(grid);
+  auto view = GridMap(buffer.data(), grid.rows(), grid.cols(),
+                      Eigen::Stride<Eigen::Dynamic, Eigen::Dynamic>(1, 29));
+  EXPECT_EQ(view.innerStride(), 29);
+  EXPECT_EQ(view.outerStride(), 1);
+
+  auto strips = math::lexicographic_cells(view, mask, true, 1);
+  auto cells = math::red_black_cells(view, mask, true);
+  auto red_black = pyinterp::Matrix<double>(grid);
+  auto red_black_cells = math::red_black_cells(red_black, mask, true);
+  for (auto ix = 0; ix < 5; ++ix) {
+    EXPECT_EQ(math::lexicographic_gauss_seidel(view, strips, 1.0, 1e-3, false),
+              reference(grid, mask, true, 1.0, 1e-3));
+  }
+  EXPECT_EQ((pyinterp::Matrix<double>(view) - grid).cwiseAbs().maxCoeff(), 0);
+
+  buffer = red_black;
+  for (auto ix = 0; ix < 5; ++ix) {
+    EXPECT_EQ(
+        math::red_black_gauss_seidel(view, cells, 1.0, 1e-3, false, size_t(2)),
+        math::red_black_gauss_seidel(red_black, red_black_cells, 1.0, 1e-3,
+                                     false, size_t(1)));
+  }
+  EXPECT_EQ((pyinterp::Matrix<double>(view) - red_black).cwiseAbs().maxCoeff(),
+            0);
+}
+
+TEST(math_gauss_seidel, retire) {
+  auto mask = pyinterp::Matrix<bool>();
+  auto grid = build_grid(64, 48, mask);
+  auto expected = pyinterp::Matrix<double>(grid);
+  auto count = static_cast<size_t>(mask.count());
+
+  auto strips = math::lexicographic_cells(grid, mask, false, 2);
+  auto cells = math::red_black_cells(expected, mask, false);
+
+  // The pixels whose residual is lower than the threshold are removed.
+  auto lexicographic = std::tuple<double, size_t>();
+  auto red_black = std::tuple<double, size_t>();
+  for (auto ix = 0; ix < 100; ++ix) {
+    lexicographic =
+        math::lexicographic_gauss_seidel(grid, strips, 1.0, 1e-3, true);
+    red_black =
+        math::red_black_gauss_seidel(expected, cells, 1.0, 1e-3, true, 4);
+  }
+  auto retained = strips[0].cells.size() + strips[1].cells.size();
+  EXPECT_LT(retained, count);
+  EXPECT_EQ(retained, std::get<1>(lexicographic));
+  EXPECT_EQ(strips[0].columns.back(), strips[0].cells.size());
+  EXPECT_TRUE(std::is_sorted(
+      strips[0].columns.begin(), strips[0].columns.end()));
+  retained = 0;
+  for (auto& item : cells) {
+    retained += item.size();
+  }
+  EXPECT_LT(retained, count);
+  EXPECT_EQ(retained, std::get<1>(red_black));
+
+  // All the pixels retained are updated: with a threshold larger than any
+  // residual, the lists are emptied.
+  math::lexicographic_gauss_seidel(grid, strips, 1.0, 1e9, true);
+  math::red_black_gauss_seidel(expected, cells, 1.0, 1e9, true, size_t(4));
+  EXPECT_TRUE(strips[0].cells.empty() && strips[1].cells.empty());
+  for (auto& item : cells) {
+    EXPECT_TRUE(item.empty());
+  }
+  EXPECT_EQ(math::lexicographic_gauss_seidel(grid, strips, 1.0, 0.0, false),
+            std::make_tuple(0.0, size_t(0)));
+}
+
+TEST(math_gauss_seidel, tiles) {
+  // The grid is split into 3 x 2 tiles of uneven sizes, processed one after
+  // the other: their halos are copied from the whole grid after each color.
+  for (auto is_circle : {false, true}) {
+    for (auto x_size : {32, 31}) {
+      auto mask = pyinterp::Matrix<bool>();
+      auto grid = build_grid(x_size, 20, mask);
+      auto expected = pyinterp::Matrix<double>(grid);
+      auto x_bounds = std::array<int64_t, 4>{0, 1, 17, x_size};
+      auto y_bounds = std::array<int64_t, 3>{0, 9, 20};
+      auto shape = std::array<int64_t, 2>{x_size, 20};
+
+      struct Tile {
+        std::array<int64_t, 2> origin;
+        pyinterp::Matrix<double> values;
+        math::ColoredCells cells;
+      };
+      auto tiles = std::vector<Tile>();
+      for (size_t jx = 0; jx < 3; ++jx) {
+        for (size_t jy = 0; jy < 2; ++jy) {
+          auto origin = std::array<int64_t, 2>{x_bounds[jx], y_bounds[jy]};
+          auto nx = x_bounds[jx + 1] - x_bounds[jx];
+          auto ny = y_bounds[jy + 1] - y_bounds[jy];
+          auto values = pyinterp::Matrix<double>(nx + 2, ny + 2);
+          values.setConstant(std::numeric_limits<double>::quiet_NaN());
+          auto cells =
+              math::tile_cells(values, mask.block(origin[0], origin[1], nx, ny),
+                               origin, shape, is_circle);
+          tiles.push_back({origin, values, cells});
+        }
+      }
+
+      // Copies the pixels of the whole grid into the tiles, with their halo.
+      auto exchange = [&]() {
+        for (auto& tile : tiles) {
+          for (int64_t iy = 0; iy < tile.values.cols(); ++iy) {
+            for (int64_t ix = 0; ix < tile.values.rows(); ++ix) {
+              auto gx = ix + tile.origin[0] - 1;
+              auto gy = iy + tile.origin[1] - 1;
+              if (is_circle) {
+                gx = (gx + x_size) % x_size;
+              }
+              if (gx >= 0 && gx < x_size && gy >= 0 && gy < 20) {
+                tile.values(ix, iy) = grid(gx, gy);
+              }
+            }
+          }
+        }
+      };
+      auto gather = [&]() {
+        for (auto& tile : tiles) {
+          grid.block(tile.origin[0], tile.origin[1], tile.values.rows() - 2,
+                     tile.values.cols() - 2) =
+              tile.values.block(1, 1, tile.values.rows() - 2,
+                                tile.values.cols() - 2);
+        }
+      };
+
+      auto global = math::red_black_cells(expected, mask, is_circle);
+      auto colors = math::red_black_colors(x_size, is_circle);
+      exchange();
+      for (auto it = 0; it < 50; ++it) {
+        auto residual = 0.0;
+        for (size_t color = 0; color < colors; ++color) {
+          for (auto& tile : tiles) {
+            residual = std::max(
+                residual, std::get<0>(math::relax_color(
+                              tile.values.data(), tile.cells[color], 1.5, 0.0,
+                              false, 1)));
+          }
+          gather();
+          exchange();
+        }
+        EXPECT_EQ(residual, std::get<0>(math::red_black_gauss_seidel<double>(
+                                expected, global, 1.5, 0.0, false, 1)));
+      }
+      EXPECT_EQ((grid - expected).cwiseAbs().maxCoeff(), 0);
+    }
+  }
+}
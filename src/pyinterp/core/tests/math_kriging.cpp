@@ -0,0 +1,69 @@
+// Copyright (c) 2022 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+#include <gtest/gtest.h>
+
+#include "pyinterp/detail/math/kriging.hpp"
+
+namespace math = pyinterp::detail::math;
+
+static void test_2d(math::covariance::Function function) {
+  Eigen::Matrix<double, 2, 20> x = Eigen::Matrix<double, 2, 20>::Random();
+  Eigen::Matrix<double, 20, 1> y =
+      (x.row(0).array().pow(2) - x.row(1).array().pow(2)).array().exp();
+  auto kriging = math::Kriging<double>(1, 2, 0, function);
+  auto model = kriging.fit(x, y);
+
+  // Without nugget, the estimator goes through the nodes with a null error.
+  for (Eigen::Index ix = 0; ix < x.cols(); ++ix) {
+    auto [value, variance] = kriging.evaluate(model, x.col(ix));
+    EXPECT_NEAR(value, y(ix), 1e-6);
+    EXPECT_NEAR(variance, 0, 1e-6);
+  }
+
+  // Away from the nodes, the error grows.
+  Eigen::Vector2d xi(5, 5);
+  auto [value, variance] = kriging.evaluate(model, xi);
+  EXPECT_TRUE(std::isfinite(value));
+  EXPECT_GT(variance, 0);
+  EXPECT_LE(variance, 2);
+}
+
+TEST(math_kriging, covariance) {
+  EXPECT_DOUBLE_EQ(math::covariance::matern_12(0.0, 2.0, 1.0), 2);
+  EXPECT_DOUBLE_EQ(math::covariance::matern_32(0.0, 2.0, 1.0), 2);
+  EXPECT_DOUBLE_EQ(math::covariance::matern_52(0.0, 2.0, 1.0), 2);
+  EXPECT_DOUBLE_EQ(math::covariance::gaussian(0.0, 2.0, 1.0), 2);
+  EXPECT_DOUBLE_EQ(math::covariance::spherical(0.0, 2.0, 1.0), 2);
+  EXPECT_DOUBLE_EQ(math::covariance::spherical(1.0, 2.0, 1.0), 0);
+  EXPECT_NEAR(math::covariance::matern_12(1.0, 1.0, 1.0), std::exp(-1.0),
+              1e-15);
+  EXPECT_THROW(math::Kriging<double>(0, 1, 0, math::covariance::kGaussian),
+               std::invalid_argument);
+  EXPECT_THROW(math::Kriging<double>(1, 1, -1, math::covariance::kGaussian),
+               std::invalid_argument);
+}
+
+TEST(math_kriging, interpolate) {
+  test_2d(math::covariance::kMatern12);
+  test_2d(math::covariance::kMatern32);
+  test_2d(math::covariance::kMatern52);
+  test_2d(math::covariance::kGaussian);
+  test_2d(math::covariance::kSpherical);
+}
+
+TEST(math_kriging, nugget) {
+  Eigen::Matrix<double, 1, 5> x;
+  x << 0, 1, 2, 3, 4;
+  Eigen::Matrix<double, 5, 1> y;
+  y << 1, 2, 1, 2, 1;
+  auto kriging = math::Kriging<double>(1, 1, 0.5, math::covariance::kMatern32);
+  auto model = kriging.fit(x, y);
+
+  // With a nugget, the estimator smooths the values of the nodes.
+  auto [value, variance] =
+      kriging.evaluate(model, Eigen::Matrix<double, 1, 1>(1));
+  EXPECT_LT(value, 2);
+  EXPECT_GT(variance, 0);
+}
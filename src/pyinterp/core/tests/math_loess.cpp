@@ -0,0 +1,87 @@
+// Copyright (c) 2022 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "pyinterp/detail/math/loess.hpp"
+
+namespace math = pyinterp::detail::math;
+
+TEST(math_loess, tricube) {
+  EXPECT_DOUBLE_EQ(math::tricube(0.0), 1.0);
+  EXPECT_DOUBLE_EQ(math::tricube(0.5), std::pow(1 - std::pow(0.5, 3), 3));
+  EXPECT_DOUBLE_EQ(math::tricube(-0.5), math::tricube(0.5));
+  EXPECT_DOUBLE_EQ(math::tricube(1.0), 0.0);
+  EXPECT_DOUBLE_EQ(math::tricube(1.5), 0.0);
+}
+
+TEST(math_loess, kernel) {
+  const int64_t nx = 3;
+  const int64_t ny = 2;
+  const auto x_step = 0.25;
+  const auto y_step = 0.5;
+  auto kernel = math::LoessKernel<double>(nx, ny, x_step, y_step);
+
+  // The weights are those computed from the coordinates of the pixels,
+  // including outside the window.
+  for (int64_t dx = -nx - 2; dx <= nx + 2; ++dx) {
+    for (int64_t dy = -ny - 2; dy <= ny + 2; ++dy) {
+      auto d = std::sqrt(math::sqr(dx * x_step / nx) +
+                         math::sqr(dy * y_step / ny));
+      EXPECT_NEAR(kernel(dx, dy), math::tricube(d), 1e-15);
+    }
+  }
+}
+
+TEST(math_loess, accumulate) {
+  const int64_t nx = 2;
+  const int64_t ny = 5;
+  const auto nan = std::numeric_limits<double>::quiet_NaN();
+  auto kernel = math::LoessKernel<double>(nx, ny, 1.0, 2.0);
+
+  // Values of the column, stored every three elements.
+  auto values = std::vector<double>(ny * 2 + 1);
+  auto strided = std::vector<double>(values.size() * 3, 1e300);
+  for (size_t ix = 0; ix < values.size(); ++ix) {
+    values[ix] = ix % 3 == 1 ? nan : std::sin(static_cast<double>(ix));
+    strided[ix * 3] = values[ix];
+  }
+
+  for (int64_t dx = -nx; dx <= nx; ++dx) {
+    auto expected_value = 0.0;
+    auto expected_weight = 0.0;
+    for (int64_t dy = -ny; dy <= ny; ++dy) {
+      auto zi = values[dy + ny];
+      if (!std::isnan(zi)) {
+        expected_value += kernel(dx, dy) * zi;
+        expected_weight += kernel(dx, dy);
+      }
+    }
+
+    auto value = 1.0;
+    auto weight = 2.0;
+    kernel.accumulate(dx, values.data(), 1, value, weight);
+    EXPECT_NEAR(value, expected_value + 1, 1e-14);
+    EXPECT_NEAR(weight, expected_weight + 2, 1e-14);
+
+    value = 0.0;
+    weight = 0.0;
+    kernel.accumulate(dx, strided.data(), 3, value, weight);
+    EXPECT_NEAR(value, expected_value, 1e-14);
+    EXPECT_NEAR(weight, expected_weight, 1e-14);
+  }
+
+  // Only undefined values
+  auto undefined = std::vector<float>(ny * 2 + 1, std::nanf(""));
+  auto kernel32 = math::LoessKernel<float>(nx, ny, 1.0, 2.0);
+  auto value = 0.0F;
+  auto weight = 0.0F;
+  kernel32.accumulate(0, undefined.data(), 1, value, weight);
+  EXPECT_EQ(value, 0);
+  EXPECT_EQ(weight, 0);
+}
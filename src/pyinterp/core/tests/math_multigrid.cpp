@@ -0,0 +1,90 @@
+// Copyright (c) 2022 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+#include "pyinterp/detail/math/multigrid.hpp"
+
+namespace math = pyinterp::detail::math;
+
+// Builds a grid whose central part is undefined.
+static auto build_grid(const int64_t x_size, const int64_t y_size,
+                       pyinterp::Matrix<bool>& mask)
+    -> pyinterp::Matrix<double> {
+  auto grid = pyinterp::Matrix<double>(x_size, y_size);
+  mask.resize(x_size, y_size);
+  for (int64_t iy = 0; iy < y_size; ++iy) {
+    for (int64_t ix = 0; ix < x_size; ++ix) {
+      auto masked = ix > x_size / 8 && ix < x_size * 7 / 8 && iy > y_size / 8 &&
+                    iy < y_size * 7 / 8;
+      mask(ix, iy) = masked;
+      grid(ix, iy) = masked ? 0.0
+                            : std::sin(ix * 2 * M_PI / x_size) +
+                                  std::cos(iy * M_PI / y_size);
+    }
+  }
+  return grid;
+}
+
+TEST(math_multigrid, v_cycle) {
+  for (auto is_circle : {false, true}) {
+    for (auto x_size : {128, 97}) {
+      auto mask = pyinterp::Matrix<bool>();
+      auto grid = build_grid(x_size, 75, mask);
+      auto expected = pyinterp::Matrix<double>(grid);
+
+      auto solver = math::Multigrid<double>(grid, mask, is_circle, 0);
+      EXPECT_GT(solver.levels(), 3);
+
+      size_t cycles = 0;
+      for (; cycles < 100; ++cycles) {
+        if (solver.v_cycle(grid) < 1e-12) {
+          break;
+        }
+      }
+      EXPECT_LT(cycles, 30);
+
+      // Reference solution computed by relaxation only.
+      auto cells = math::red_black_cells(expected, mask, is_circle);
+      size_t sweeps = 0;
+      for (; sweeps < 100000; ++sweeps) {
+        if (std::get<0>(math::red_black_gauss_seidel<double>(
+                expected, cells, 1.9, 0.0, false, 0)) < 1e-13) {
+          break;
+        }
+      }
+      EXPECT_GT(sweeps, cycles * 10);
+      EXPECT_LT((grid - expected).cwiseAbs().maxCoeff(), 1e-9);
+    }
+  }
+}
+
+TEST(math_multigrid, threads) {
+  auto mask = pyinterp::Matrix<bool>();
+  auto grid = build_grid(64, 48, mask);
+  auto other = pyinterp::Matrix<double>(grid);
+
+  auto solver0 = math::Multigrid<double>(grid, mask, true, 1);
+  auto solver1 = math::Multigrid<double>(grid, mask, true, 4);
+  for (auto ix = 0; ix < 5; ++ix) {
+    EXPECT_EQ(solver0.v_cycle(grid), solver1.v_cycle(other));
+  }
+  EXPECT_EQ((grid - other).cwiseAbs().maxCoeff(), 0);
+}
+
+TEST(math_multigrid, small_grid) {
+  // The grid is too small to be coarsened: the solver relaxes it.
+  auto mask = pyinterp::Matrix<bool>();
+  auto grid = build_grid(4, 4, mask);
+  auto solver = math::Multigrid<double>(grid, mask, false, 1);
+  EXPECT_EQ(solver.levels(), 1);
+  for (auto ix = 0; ix < 100; ++ix) {
+    if (solver.v_cycle(grid) < 1e-12) {
+      break;
+    }
+  }
+  EXPECT_FALSE(grid.hasNaN());
+}
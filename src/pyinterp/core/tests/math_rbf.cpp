@@ -94,3 +94,65 @@ TEST(math_rbf, point) {
     EXPECT_NEAR(y(ix), yi(0), 1e-9);
   }
 }
+
+TEST(math_rbf, cache) {
+  Eigen::Matrix<double, 2, 10> x = Eigen::Matrix<double, 2, 10>::Random();
+  Eigen::Matrix<double, 10, 1> y =
+      (x.row(0).array().pow(2) - x.row(1).array().pow(2)).array().exp();
+  Eigen::Matrix<double, 2, 1> xi = Eigen::Matrix<double, 2, 1>::Random();
+  auto rbf = math::RBF<double>(std::numeric_limits<double>::quiet_NaN(), 0,
+                               math::RadialBasisFunction::Multiquadric);
+  auto cache = math::RBFCache<double, int>(2);
+  auto solved = 0;
+  auto solve = [&]() {
+    ++solved;
+    return rbf.fit(x, y);
+  };
+
+  const auto &interpolant = cache.get({0, 1}, solve);
+  EXPECT_NEAR(rbf.evaluate(interpolant, xi)(0), rbf.interpolate(x, y, xi)(0),
+              1e-12);
+  static_cast<void>(cache.get({0, 1}, solve));
+  EXPECT_EQ(solved, 1);
+  static_cast<void>(cache.get({0, 2}, solve));
+  static_cast<void>(cache.get({0, 1}, solve));
+  EXPECT_EQ(solved, 2);
+  // {0, 2} is the least recently used entry and is evicted.
+  static_cast<void>(cache.get({1, 2}, solve));
+  EXPECT_EQ(cache.size(), 2);
+  static_cast<void>(cache.get({0, 1}, solve));
+  EXPECT_EQ(solved, 3);
+  static_cast<void>(cache.get({0, 2}, solve));
+  EXPECT_EQ(solved, 4);
+}
+
+TEST(math_rbf, compact) {
+  auto rbf = math::CompactRBF<double>(2, 0);
+  EXPECT_DOUBLE_EQ(rbf(0), 1);
+  EXPECT_DOUBLE_EQ(rbf(2), 0);
+  EXPECT_DOUBLE_EQ(rbf(3), 0);
+  EXPECT_THROW(math::CompactRBF<double>(0, 0), std::invalid_argument);
+
+  // Nodes regularly spaced on a line: each node interacts with its two
+  // closest neighbors on each side.
+  auto x = Eigen::Matrix<double, 1, 20>::LinSpaced(20, 0, 19);
+  Eigen::Matrix<double, 20, 1> y = x.array().sin();
+  auto neighbors = std::vector<math::CompactRBF<double>::Neighbors>(20);
+  for (Eigen::Index ix = 0; ix < 20; ++ix) {
+    for (Eigen::Index jx = 0; jx < 20; ++jx) {
+      auto distance = std::abs(x(ix) - x(jx));
+      if (distance < rbf.support()) {
+        neighbors[ix].emplace_back(jx, distance);
+      }
+    }
+  }
+  auto weights = rbf.fit(neighbors, y, 100, 1e-12);
+  ASSERT_EQ(weights.size(), 20);
+  for (Eigen::Index ix = 0; ix < 20; ++ix) {
+    auto value = 0.0;
+    for (Eigen::Index jx = 0; jx < 20; ++jx) {
+      value += weights(jx) * rbf(std::abs(x(ix) - x(jx)));
+    }
+    EXPECT_NEAR(value, y(ix), 1e-9);
+  }
+}
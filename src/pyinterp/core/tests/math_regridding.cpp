@@ -0,0 +1,71 @@
+// Copyright (c) 2022 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+#include <gtest/gtest.h>
+
+#include <numeric>
+
+#include "pyinterp/detail/math/regridding.hpp"
+
+namespace math = pyinterp::detail::math;
+
+TEST(math_regridding, cell_edges) {
+  auto edges = math::cell_edges(std::vector<double>{0, 1, 2, 4});
+  ASSERT_EQ(edges.size(), 5U);
+  EXPECT_DOUBLE_EQ(edges[0], -0.5);
+  EXPECT_DOUBLE_EQ(edges[1], 0.5);
+  EXPECT_DOUBLE_EQ(edges[2], 1.5);
+  EXPECT_DOUBLE_EQ(edges[3], 3);
+  EXPECT_DOUBLE_EQ(edges[4], 5);
+
+  EXPECT_THROW(math::cell_edges(std::vector<double>{1}), std::invalid_argument);
+}
+
+TEST(math_regridding, cell_overlaps) {
+  const auto edges = std::vector<double>{0, 1, 2, 3};
+
+  auto overlaps = math::cell_overlaps<double>(edges, 0.5, 2.25, 0);
+  ASSERT_EQ(overlaps.size(), 3U);
+  EXPECT_EQ(overlaps[0].first, 0);
+  EXPECT_DOUBLE_EQ(overlaps[0].second, 0.5);
+  EXPECT_EQ(overlaps[1].first, 1);
+  EXPECT_DOUBLE_EQ(overlaps[1].second, 1);
+  EXPECT_EQ(overlaps[2].first, 2);
+  EXPECT_DOUBLE_EQ(overlaps[2].second, 0.25);
+
+  // Intervals partially or totally outside the axis.
+  overlaps = math::cell_overlaps<double>(edges, -1, 0.5, 0);
+  ASSERT_EQ(overlaps.size(), 1U);
+  EXPECT_EQ(overlaps[0].first, 0);
+  EXPECT_DOUBLE_EQ(overlaps[0].second, 0.5);
+  EXPECT_TRUE(math::cell_overlaps<double>(edges, 3, 4, 0).empty());
+  EXPECT_TRUE(math::cell_overlaps<double>(edges, -2, -1, 0).empty());
+}
+
+TEST(math_regridding, periodic_cell_overlaps) {
+  // Longitude axis of cells of 90 degrees centered on -135, -45, 45, 135.
+  const auto edges =
+      math::cell_edges(std::vector<double>{-135, -45, 45, 135});
+
+  // Interval crossing the antimeridian.
+  auto overlaps = math::cell_overlaps<double>(edges, 170, 200, 360);
+  ASSERT_EQ(overlaps.size(), 2U);
+  EXPECT_EQ(overlaps[0].first, 3);
+  EXPECT_DOUBLE_EQ(overlaps[0].second, 10);
+  EXPECT_EQ(overlaps[1].first, 0);
+  EXPECT_DOUBLE_EQ(overlaps[1].second, 20);
+
+  // Interval expressed in another period.
+  overlaps = math::cell_overlaps<double>(edges, 370, 380, 360);
+  ASSERT_EQ(overlaps.size(), 1U);
+  EXPECT_EQ(overlaps[0].first, 2);
+  EXPECT_DOUBLE_EQ(overlaps[0].second, 10);
+
+  // Interval covering the whole circle.
+  overlaps = math::cell_overlaps<double>(edges, 0, 360, 360);
+  auto total = std::accumulate(
+      overlaps.begin(), overlaps.end(), 0.0,
+      [](double sum, const auto& item) { return sum + item.second; });
+  EXPECT_DOUBLE_EQ(total, 360);
+}
@@ -0,0 +1,78 @@
+// Copyright (c) 2022 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+#include <gtest/gtest.h>
+
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "pyinterp/detail/math/rolling_statistics.hpp"
+
+namespace math = pyinterp::detail::math;
+
+TEST(math_rolling_statistics, remove) {
+  auto generator = std::mt19937(0);
+  auto distribution = std::normal_distribution<double>(10, 3);
+  auto lhs = math::DescriptiveStatistics<double>();
+  auto rhs = math::DescriptiveStatistics<double>();
+  for (auto ix = 0; ix < 100; ++ix) {
+    lhs(distribution(generator), 1 + ix % 3);
+    rhs(distribution(generator), 2 + ix % 5);
+  }
+  auto acc = lhs;
+  acc += rhs;
+  acc -= rhs;
+  EXPECT_EQ(acc.count(), lhs.count());
+  EXPECT_NEAR(acc.sum_of_weights(), lhs.sum_of_weights(), 1e-9);
+  EXPECT_NEAR(acc.sum(), lhs.sum(), 1e-9);
+  EXPECT_NEAR(acc.mean(), lhs.mean(), 1e-12);
+  EXPECT_NEAR(acc.variance(), lhs.variance(), 1e-9);
+  EXPECT_NEAR(acc.skewness(), lhs.skewness(), 1e-9);
+  EXPECT_NEAR(acc.kurtosis(), lhs.kurtosis(), 1e-9);
+
+  // Removing all the samples empties the accumulator.
+  acc -= lhs;
+  EXPECT_EQ(acc.count(), 0);
+  EXPECT_TRUE(std::isnan(acc.mean()));
+}
+
+TEST(math_rolling_statistics, window) {
+  auto generator = std::mt19937(0);
+  auto distribution = std::normal_distribution<double>(10, 3);
+  auto values = std::vector<double>(500);
+  for (auto& item : values) {
+    item = distribution(generator);
+  }
+  for (auto ix : {7, 8, 9, 10, 11, 12, 13, 200}) {
+    values[ix] = std::numeric_limits<double>::quiet_NaN();
+  }
+
+  for (auto [before, after] : {std::pair{2, 2}, {4, 0}, {0, 0}, {30, 11}}) {
+    auto rolling = math::RollingStatistics<double>(before, after, 2);
+    rolling(
+        static_cast<int64_t>(values.size()),
+        [&](const int64_t ix) { return values[ix]; },
+        [&](const int64_t ix, const math::DescriptiveStatistics<double>& acc) {
+          auto expected = math::DescriptiveStatistics<double>();
+          for (auto jx = std::max<int64_t>(ix - before, 0);
+               jx <= std::min<int64_t>(ix + after, values.size() - 1); ++jx) {
+            if (!std::isnan(values[jx])) {
+              expected(values[jx]);
+            }
+          }
+          if (expected.count() < 2) {
+            EXPECT_EQ(acc.count(), 0);
+            return;
+          }
+          EXPECT_EQ(acc.count(), expected.count());
+          EXPECT_EQ(acc.min(), expected.min());
+          EXPECT_EQ(acc.max(), expected.max());
+          EXPECT_NEAR(acc.mean(), expected.mean(), 1e-9);
+          EXPECT_NEAR(acc.variance(), expected.variance(), 1e-9);
+          EXPECT_NEAR(acc.skewness(), expected.skewness(), 1e-6);
+          EXPECT_NEAR(acc.kurtosis(), expected.kurtosis(), 1e-6);
+        });
+  }
+}
@@ -0,0 +1,91 @@
+// Copyright (c) 2022 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+#include "pyinterp/detail/math/spectral_poisson.hpp"
+
+namespace math = pyinterp::detail::math;
+
+// Builds a grid whose central part, and a band along the first row, are
+// undefined.
+static auto build_grid(const int64_t x_size, const int64_t y_size,
+                       pyinterp::Matrix<bool>& mask)
+    -> pyinterp::Matrix<double> {
+  auto grid = pyinterp::Matrix<double>(x_size, y_size);
+  mask.resize(x_size, y_size);
+  for (int64_t iy = 0; iy < y_size; ++iy) {
+    for (int64_t ix = 0; ix < x_size; ++ix) {
+      auto masked = (ix > x_size / 8 && ix < x_size * 7 / 8 &&
+                     iy > y_size / 8 && iy < y_size * 7 / 8) ||
+                    (iy == 0 && ix < x_size / 2);
+      mask(ix, iy) = masked;
+      grid(ix, iy) = masked ? 0.0
+                            : std::sin(ix * 2 * M_PI / x_size) +
+                                  std::cos(iy * M_PI / y_size);
+    }
+  }
+  return grid;
+}
+
+TEST(math_spectral_poisson, iterate) {
+  for (auto is_circle : {false, true}) {
+    for (auto x_size : {128, 97}) {
+      auto mask = pyinterp::Matrix<bool>();
+      auto grid = build_grid(x_size, 75, mask);
+      auto expected = pyinterp::Matrix<double>(grid);
+
+      auto solver = math::SpectralPoisson<double>(grid, mask, is_circle, 0);
+      EXPECT_EQ(solver.size(), mask.count());
+
+      size_t iterations = 0;
+      for (; iterations < 1000; ++iterations) {
+        if (solver.iterate(grid) < 1e-12) {
+          break;
+        }
+      }
+      EXPECT_LT(iterations, 60);
+
+      // Reference solution computed by relaxation only.
+      auto cells = math::red_black_cells(expected, mask, is_circle);
+      size_t sweeps = 0;
+      for (; sweeps < 1000000; ++sweeps) {
+        if (std::get<0>(math::red_black_gauss_seidel<double>(
+                expected, cells, 1.0, 0.0, false, 0)) < 1e-13) {
+          break;
+        }
+      }
+      EXPECT_GT(sweeps, iterations * 10);
+      EXPECT_LT((grid - expected).cwiseAbs().maxCoeff(), 1e-9);
+    }
+  }
+}
+
+TEST(math_spectral_poisson, threads) {
+  auto mask = pyinterp::Matrix<bool>();
+  auto grid = build_grid(64, 48, mask);
+  auto other = pyinterp::Matrix<double>(grid);
+
+  auto solver0 = math::SpectralPoisson<double>(grid, mask, true, 1);
+  auto solver1 = math::SpectralPoisson<double>(grid, mask, true, 4);
+  for (auto ix = 0; ix < 5; ++ix) {
+    EXPECT_EQ(solver0.iterate(grid), solver1.iterate(other));
+  }
+  EXPECT_EQ((grid - other).cwiseAbs().maxCoeff(), 0);
+}
+
+TEST(math_spectral_poisson, float) {
+  auto mask = pyinterp::Matrix<bool>();
+  auto grid = build_grid(36, 20, mask);
+  auto values = pyinterp::Matrix<float>(grid.cast<float>());
+  auto solver = math::SpectralPoisson<float>(values, mask, true, 1);
+  auto residual = 1.0F;
+  for (auto ix = 0; ix < 100 && residual >= 1e-5F; ++ix) {
+    residual = solver.iterate(values);
+  }
+  EXPECT_LT(residual, 1e-5F);
+  EXPECT_FALSE(values.hasNaN());
+}
@@ -4,6 +4,8 @@
 // BSD-style license that can be found in the LICENSE file.
 #include <gtest/gtest.h>
 
+#include <limits>
+
 #include "pyinterp/detail/math/spline2d.hpp"
 
 namespace math = pyinterp::detail::math;
@@ -162,6 +164,75 @@ TEST(math_spline2d, xarray_4d) {
   }
 }
 
+TEST(math_spline2d, fixed_size_frames) {
+  // The frames whose sizes are compile-time constants give the same results
+  // as the frames sized at runtime.
+  auto fixed = math::Frame2D<6, 6>(3, 3);
+  auto dynamic = math::Frame2D(3, 3);
+  ASSERT_EQ(fixed.nx(), 3);
+  ASSERT_EQ(fixed.ny(), 3);
+
+  for (auto ix = 0; ix < 6; ++ix) {
+    fixed.x(ix) = fixed.y(ix) = dynamic.x(ix) = dynamic.y(ix) = ix * 0.1;
+    for (auto iy = 0; iy < 6; ++iy) {
+      fixed.q(ix, iy) = dynamic.q(ix, iy) =
+          std::sin(ix * 0.1) * std::cos(iy * 0.2);
+    }
+  }
+  EXPECT_TRUE(fixed.is_valid());
+
+  for (const auto* kind : {"c_spline", "akima", "linear"}) {
+    auto interpolator = math::Spline2D(fixed, kind);
+    auto reference = math::Spline2D(dynamic, kind);
+    interpolator.fit(fixed);
+    reference.fit(dynamic);
+    for (auto ix = 0; ix < 10; ++ix) {
+      auto x = 0.2 + ix * 0.01;
+      auto y = 0.3 - ix * 0.01;
+      EXPECT_DOUBLE_EQ(interpolator.interpolate(x, y),
+                       reference.interpolate(x, y))
+          << kind;
+    }
+  }
+
+  fixed.q(2, 3) = std::numeric_limits<double>::quiet_NaN();
+  EXPECT_FALSE(fixed.is_valid());
+}
+
+TEST(math_spline2d, fixed_size_frame_3d) {
+  auto xr = math::Frame3D<int64_t, 6, 8>(3, 4, 1);
+  ASSERT_EQ(xr.nx(), 3);
+  ASSERT_EQ(xr.ny(), 4);
+  ASSERT_EQ(xr.nz(), 1);
+
+  for (auto ix = 0; ix < 6; ++ix) {
+    xr.x(ix) = ix * 2;
+  }
+
+  for (auto ix = 0; ix < 8; ++ix) {
+    xr.y(ix) = ix * 2 + 1;
+  }
+
+  for (auto ix = 0; ix < 6; ++ix) {
+    for (auto iy = 0; iy < 8; ++iy) {
+      for (auto iz = 0; iz < 2; ++iz) {
+        xr.q(ix, iy, iz) = ix * iy * (iz + 1);
+      }
+    }
+  }
+
+  for (auto iz = 0; iz < 2; ++iz) {
+    auto layer = xr.frame_2d(iz);
+    EXPECT_EQ(layer.x_values(), xr.x_values());
+    EXPECT_EQ(layer.y_values(), xr.y_values());
+    for (auto ix = 0; ix < 6; ++ix) {
+      for (auto iy = 0; iy < 8; ++iy) {
+        EXPECT_EQ(layer.q(ix, iy), ix * iy * (iz + 1));
+      }
+    }
+  }
+}
+
 TEST(math_spline2d, spline2d) {
   auto xr = math::Frame2D(3, 3);
   ASSERT_EQ(xr.nx(), 3);
@@ -183,3 +254,66 @@ TEST(math_spline2d, spline2d) {
     }
   }
 }
+
+TEST(math_spline2d, fit) {
+  // The splines computed once for a frame give the same results as a fit
+  // performed for each point.
+  auto xr = math::Frame2D(3, 3);
+  for (auto ix = 0; ix < 6; ++ix) {
+    xr.x(ix) = xr.y(ix) = ix * 0.1;
+    for (auto iy = 0; iy < 6; ++iy) {
+      xr.q(ix, iy) = std::sin(ix * 0.1) * std::cos(iy * 0.2);
+    }
+  }
+
+  auto interpolator = math::Spline2D(xr, "c_spline");
+  auto reference = math::Spline2D(xr, "c_spline");
+  interpolator.fit(xr);
+  for (auto ix = 0; ix < 10; ++ix) {
+    auto x = 0.2 + ix * 0.01;
+    auto y = 0.3 - ix * 0.01;
+    EXPECT_DOUBLE_EQ(interpolator.interpolate(x, y),
+                     reference.interpolate(x, y, xr));
+    EXPECT_DOUBLE_EQ(interpolator.derivative(x, y),
+                     reference.derivative(x, y, xr));
+  }
+}
+
+TEST(math_spline2d, gradient) {
+  // The derivatives computed with the value match the finite differences of
+  // the interpolated function, for the splines computed with or without GSL.
+  auto xr = math::Frame2D(3, 3);
+  for (auto ix = 0; ix < 6; ++ix) {
+    xr.x(ix) = xr.y(ix) = ix * 0.1;
+    for (auto iy = 0; iy < 6; ++iy) {
+      xr.q(ix, iy) = std::sin(ix * 0.1) * std::cos(iy * 0.2);
+    }
+  }
+
+  constexpr auto h = 1e-6;
+  for (const auto* kind : {"c_spline", "akima", "polynomial"}) {
+    auto interpolator = math::Spline2D(xr, kind);
+    interpolator.fit(xr);
+    auto dx = 0.0;
+    auto dy = 0.0;
+    for (auto ix = 0; ix < 10; ++ix) {
+      auto x = 0.2 + ix * 0.01;
+      auto y = 0.3 - ix * 0.01;
+      EXPECT_DOUBLE_EQ(interpolator.gradient(x, y, dx, dy),
+                       interpolator.interpolate(x, y))
+          << kind;
+      EXPECT_NEAR(dx,
+                  (interpolator.interpolate(x + h, y) -
+                   interpolator.interpolate(x - h, y)) /
+                      (2 * h),
+                  1e-6)
+          << kind;
+      EXPECT_NEAR(dy,
+                  (interpolator.interpolate(x, y + h) -
+                   interpolator.interpolate(x, y - h)) /
+                      (2 * h),
+                  1e-6)
+          << kind;
+    }
+  }
+}
@@ -0,0 +1,116 @@
+// Copyright (c) 2022 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+#include <gtest/gtest.h>
+
+#include "pyinterp/detail/math/spline1d.hpp"
+
+namespace math = pyinterp::detail::math;
+
+static const math::SplineKind kinds[] = {math::SplineKind::kCSpline,
+                                         math::SplineKind::kAkima,
+                                         math::SplineKind::kSteffen};
+
+TEST(math_spline1d, parse) {
+  EXPECT_EQ(math::Spline1D::parse("c_spline"), math::SplineKind::kCSpline);
+  EXPECT_EQ(math::Spline1D::parse("akima"), math::SplineKind::kAkima);
+  EXPECT_EQ(math::Spline1D::parse("steffen"), math::SplineKind::kSteffen);
+  EXPECT_FALSE(math::Spline1D::parse("akima_periodic").has_value());
+  EXPECT_FALSE(math::Spline1D::parse("linear").has_value());
+}
+
+TEST(math_spline1d, nodes) {
+  Eigen::VectorXd xa(6);
+  Eigen::VectorXd ya(6);
+  xa << 0, 1, 2.5, 3, 4.5, 6;
+  ya << 1, -2, 0.5, 3, 2, -1;
+  for (auto kind : kinds) {
+    auto spline = math::Spline1D(xa.size(), kind);
+    spline.init(xa, ya);
+    for (Eigen::Index ix = 0; ix < xa.size(); ++ix) {
+      EXPECT_NEAR(spline.interpolate(xa(ix)), ya(ix), 1e-12);
+    }
+  }
+}
+
+TEST(math_spline1d, linear) {
+  Eigen::VectorXd xa(6);
+  xa << 0, 1, 2.5, 3, 4.5, 6;
+  Eigen::VectorXd ya = 2 * xa.array() - 1;
+  for (auto kind : kinds) {
+    auto spline = math::Spline1D(xa.size(), kind);
+    spline.init(xa, ya);
+    for (auto x = 0.0; x <= 6; x += 0.25) {
+      EXPECT_NEAR(spline.interpolate(x), 2 * x - 1, 1e-12);
+      EXPECT_NEAR(spline.derivative(x), 2, 1e-12);
+      EXPECT_NEAR(spline.second_derivative(x), 0, 1e-12);
+    }
+  }
+}
+
+TEST(math_spline1d, cspline) {
+  Eigen::VectorXd xa(3);
+  Eigen::VectorXd ya(3);
+  xa << 0, 1, 2;
+  ya << 0, 1, 0;
+  auto spline = math::Spline1D(xa.size(), math::SplineKind::kCSpline);
+  spline.init(xa, ya);
+  EXPECT_DOUBLE_EQ(spline.interpolate(0.5), 0.6875);
+  EXPECT_DOUBLE_EQ(spline.interpolate(1.5), 0.6875);
+  EXPECT_DOUBLE_EQ(spline.derivative(0), 1.5);
+  EXPECT_DOUBLE_EQ(spline.second_derivative(1), -3);
+
+  // Natural spline: the second derivative vanishes at the ends and the first
+  // derivative is continuous.
+  xa.resize(6);
+  ya.resize(6);
+  xa << 0, 1, 2.5, 3, 4.5, 6;
+  ya << 1, -2, 0.5, 3, 2, -1;
+  spline = math::Spline1D(xa.size(), math::SplineKind::kCSpline);
+  spline.init(xa, ya);
+  EXPECT_NEAR(spline.second_derivative(0), 0, 1e-12);
+  EXPECT_NEAR(spline.second_derivative(6), 0, 1e-12);
+  for (Eigen::Index ix = 1; ix < xa.size() - 1; ++ix) {
+    EXPECT_NEAR(spline.derivative(xa(ix) - 1e-9),
+                spline.derivative(xa(ix) + 1e-9), 1e-6);
+  }
+}
+
+TEST(math_spline1d, steffen) {
+  // The Steffen spline preserves the monotonicity of the data.
+  Eigen::VectorXd xa(6);
+  Eigen::VectorXd ya(6);
+  xa << 0, 1, 2, 3, 4, 5;
+  ya << 0, 0, 0, 1, 1, 1;
+  auto spline = math::Spline1D(xa.size(), math::SplineKind::kSteffen);
+  spline.init(xa, ya);
+  auto previous = spline.interpolate(0);
+  for (auto x = 0.05; x <= 5; x += 0.05) {
+    auto value = spline.interpolate(x);
+    EXPECT_GE(value, previous);
+    EXPECT_GE(value, 0);
+    EXPECT_LE(value, 1);
+    previous = value;
+  }
+}
+
+TEST(math_spline1d, errors) {
+  EXPECT_THROW(math::Spline1D(2, math::SplineKind::kCSpline),
+               std::runtime_error);
+  EXPECT_THROW(math::Spline1D(4, math::SplineKind::kAkima),
+               std::runtime_error);
+
+  Eigen::VectorXd xa(3);
+  Eigen::VectorXd ya(3);
+  xa << 0, 1, 1;
+  ya << 0, 1, 2;
+  auto spline = math::Spline1D(xa.size(), math::SplineKind::kCSpline);
+  EXPECT_THROW(spline.init(xa, ya), std::runtime_error);
+
+  xa << 0, 1, 2;
+  spline.init(xa, ya);
+  EXPECT_THROW(static_cast<void>(spline.interpolate(-0.1)),
+               std::runtime_error);
+  EXPECT_THROW(static_cast<void>(spline.interpolate(2.1)), std::runtime_error);
+}
@@ -281,6 +281,42 @@ TEST(math_streaming_histogram, quantile_out_of_bounds) {
   EXPECT_THROW(instance.quantile(10), std::invalid_argument);
 }
 
+TEST(math_streaming_histogram, quantiles) {
+  auto generator = std::mt19937(0);
+  auto distribution = std::normal_distribution<double>(0, 1);
+  for (auto bin_count : {10, 1000}) {
+    auto instance = math::StreamingHistogram<double>(bin_count, false);
+    auto q = std::vector<double>{0, 0.01, 0.05, 0.25, 0.5, 0.5, 0.75, 0.95, 1};
+    auto result = std::vector<double>(q.size());
+    instance.quantiles(q.data(), q.size(), result.data());
+    for (auto item : result) {
+      EXPECT_TRUE(std::isnan(item));
+    }
+
+    for (auto ix = 0; ix < POINTS; ++ix) {
+      instance(distribution(generator));
+    }
+    instance.quantiles(q.data(), q.size(), result.data());
+    for (size_t ix = 0; ix < q.size(); ++ix) {
+      EXPECT_EQ(result[ix], instance.quantile(q[ix]));
+    }
+  }
+
+  auto unsorted = std::vector<double>{0.75, 0.25, 0.5};
+  auto [order, sorted] = math::sort_quantiles(unsorted.data(), 3);
+  EXPECT_EQ(order, (std::vector<size_t>{1, 2, 0}));
+  EXPECT_EQ(sorted, (std::vector<double>{0.25, 0.5, 0.75}));
+
+  auto instance = math::StreamingHistogram<double>(6, false);
+  instance(1);
+  auto q = std::vector<double>{0.5, 1.5};
+  auto result = std::vector<double>(q.size());
+  EXPECT_THROW(instance.quantiles(q.data(), q.size(), result.data()),
+               std::invalid_argument);
+  EXPECT_THROW(math::sort_quantiles(q.data(), q.size()),
+               std::invalid_argument);
+}
+
 TEST(math_streaming_histogram, serialization) {
   auto instance = math::StreamingHistogram<double>(6, false);
 
@@ -346,3 +382,121 @@ TEST(math_streaming_histogram, weighted) {
   EXPECT_NEAR(instance.variance(), acc.variance(), 1e-3);
   EXPECT_NEAR(instance.quantile(0.5), 0.5716742560345885, 1e-1);
 }
+
+TEST(math_streaming_histogram, trim) {
+  auto gen = std::mt19937(42);
+  auto uniform = std::uniform_real_distribution<>();
+
+  for (auto weighted_diff : {false, true}) {
+    auto instance = math::StreamingHistogram<double>(POINTS, weighted_diff);
+    for (auto ix = 0; ix < POINTS; ++ix) {
+      instance(uniform(gen), uniform(gen));
+    }
+
+    // Reference: the bins are merged one by one with a linear scan.
+    auto expected = instance.bins();
+    while (expected.size() > 10) {
+      auto jx = weighted_diff
+                    ? math::BinDifferences<double, true>(expected).index()
+                    : math::BinDifferences<double, false>(expected).index();
+      auto& item0 = expected[jx];
+      const auto& item1 = expected[jx + 1];
+      item0 = {(item0.value * item0.weight + item1.value * item1.weight) /
+                   (item0.weight + item1.weight),
+               item0.weight + item1.weight};
+      expected.erase(expected.begin() + jx + 1);
+    }
+
+    instance.resize(10);
+    const auto& bins = instance.bins();
+    ASSERT_EQ(bins.size(), expected.size());
+    for (size_t ix = 0; ix < bins.size(); ++ix) {
+      EXPECT_EQ(bins[ix].value, expected[ix].value);
+      EXPECT_EQ(bins[ix].weight, expected[ix].weight);
+    }
+  }
+}
+
+TEST(math_streaming_histogram, buffer) {
+  auto gen = std::mt19937(42);
+  auto normal = std::normal_distribution<>();
+  auto acc = math::DescriptiveStatistics<double>();
+  auto instance = math::StreamingHistogram<double>(40, false);
+  auto values = std::vector<double>();
+
+  for (auto ix = 0; ix < POINTS * 10; ++ix) {
+    auto value = normal(gen);
+    instance.buffer(value);
+    acc(value);
+    values.push_back(value);
+  }
+  instance.flush();
+  std::sort(values.begin(), values.end());
+
+  EXPECT_EQ(instance.size(), 40);
+  EXPECT_EQ(acc.count(), instance.count());
+  EXPECT_EQ(acc.min(), instance.min());
+  EXPECT_EQ(acc.max(), instance.max());
+  EXPECT_EQ(acc.sum_of_weights(), instance.sum_of_weights());
+  EXPECT_NEAR(acc.mean(), instance.mean(), 1e-6);
+  EXPECT_NEAR(instance.quantile(0.5), quantile(values, 0.5), 0.1);
+  EXPECT_NEAR(instance.quantile(0.8), quantile(values, 0.8), 0.1);
+
+  // Without trimming, the buffered values are stored as is.
+  instance = math::StreamingHistogram<double>(POINTS, false);
+  auto other = math::StreamingHistogram<double>(POINTS, false);
+  for (auto ix = 0; ix < POINTS; ++ix) {
+    auto value = normal(gen);
+    instance.buffer(value);
+    other(value);
+  }
+  instance.flush();
+  ASSERT_EQ(instance.size(), other.size());
+  for (size_t ix = 0; ix < instance.size(); ++ix) {
+    EXPECT_EQ(instance.bins()[ix].value, other.bins()[ix].value);
+  }
+
+  // The serialized state of a flushed histogram is unchanged.
+  auto instance2 =
+      math::StreamingHistogram<double>(static_cast<std::string>(instance));
+  EXPECT_EQ(static_cast<std::string>(instance),
+            static_cast<std::string>(instance2));
+  EXPECT_EQ(static_cast<std::string>(instance),
+            static_cast<std::string>(other));
+}
+
+TEST(math_streaming_histogram, exact) {
+  auto instance = math::StreamingHistogram<double>(4, false);
+  instance(2, 0.5);
+  instance(1, 2);
+  instance(4, 1);
+  instance(3, 0.5);
+  ASSERT_TRUE(instance.exact());
+
+  // The tails are not extrapolated to the bounds, which are weighted.
+  EXPECT_EQ(instance.quantile(0), 1);
+  EXPECT_EQ(instance.quantile(1), 4);
+  // Middles of the bins in the cumulative distribution: 1, 2.25, 2.75, 3.5
+  EXPECT_NEAR(instance.quantile(0.5), 1.8, 1e-12);
+  EXPECT_NEAR(instance.quantile(0.25), 1, 1e-12);
+
+  // The cached cumulative weights are updated with the bins.
+  instance(5, 4);
+  EXPECT_FALSE(instance.exact());
+  EXPECT_EQ(instance.size(), 4);
+  EXPECT_EQ(instance.quantile(1), 5 * 4);
+  EXPECT_NEAR(instance.quantile(0.75), 5, 1e-12);
+
+  auto other = math::StreamingHistogram<double>(
+      static_cast<std::string>(instance));
+  EXPECT_FALSE(other.exact());
+  EXPECT_EQ(other.quantile(1), instance.quantile(1));
+
+  auto merged = math::StreamingHistogram<double>(10, false);
+  merged(1);
+  merged += math::StreamingHistogram<double>(
+      static_cast<std::string>(merged));
+  EXPECT_TRUE(merged.exact());
+  merged += instance;
+  EXPECT_FALSE(merged.exact());
+}
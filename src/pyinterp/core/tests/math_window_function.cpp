@@ -148,4 +148,50 @@ TEST(math_window_function, lanczos) {
   EXPECT_NEAR(wi, 0.0, 1e-6);
   wi = math::window::lanczos(15.0, 5.0, 2.0);
   EXPECT_NEAR(wi, 0.0, 1e-6);
-}
\ No newline at end of file
+}
+
+TEST(math_window_function, gaussian) {
+  EXPECT_NEAR(math::window::gaussian(0.0, 5.0, 2.0), 1.0, 1e-12);
+  EXPECT_NEAR(math::window::gaussian(2.0, 5.0, 2.0), std::exp(-0.5), 1e-12);
+  EXPECT_NEAR(math::window::gaussian(5.0, 5.0, 0.0), std::exp(-2.0), 1e-12);
+  EXPECT_EQ(math::window::gaussian(5.1, 5.0, 2.0), 0.0);
+}
+
+TEST(math_window_function, table) {
+  for (auto item : {math::window::Function::kBlackman,
+                    math::window::Function::kBlackmanHarris,
+                    math::window::Function::kBoxcar,
+                    math::window::Function::kFlatTop,
+                    math::window::Function::kGaussian,
+                    math::window::Function::kHamming,
+                    math::window::Function::kLanczos,
+                    math::window::Function::kNuttall,
+                    math::window::Function::kParzen,
+                    math::window::Function::kParzenSWOT}) {
+    auto wf = math::WindowFunction<double>(item);
+    auto arg = item == math::window::Function::kLanczos ? 2.0 : 0.0;
+    auto table = math::WindowFunctionTable<double>(wf, 5.0, arg, 4096);
+    EXPECT_EQ(table.size(), 4096);
+    // The distances located beyond the support are evaluated exactly.
+    for (auto d = 0.0; d < 12.0; d += 0.01) {
+      EXPECT_NEAR(table(d), wf(d, 5.0, arg), 1e-5) << item << " " << d;
+    }
+  }
+
+  // The error decreases with the square of the size of the table.
+  auto wf = math::WindowFunction<double>(math::window::Function::kHamming);
+  auto error = [&](const size_t size) {
+    auto table = math::WindowFunctionTable<double>(wf, 5.0, 0.0, size);
+    auto result = 0.0;
+    for (auto d = 0.0; d <= 5.0; d += 0.001) {
+      result = std::max(result, std::abs(table(d) - wf(d, 5.0, 0.0)));
+    }
+    return result;
+  };
+  EXPECT_NEAR(error(64) / error(128), 4, 0.1);
+
+  EXPECT_THROW(math::WindowFunctionTable<double>(wf, 5.0, 0.0, 0),
+               std::invalid_argument);
+  EXPECT_THROW(math::WindowFunctionTable<double>(wf, 0.0, 0.0, 16),
+               std::invalid_argument);
+}
@@ -0,0 +1,54 @@
+// Copyright (c) 2022 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+#include "pyinterp/detail/memo_cache.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+
+#include "pyinterp/detail/thread.hpp"
+
+namespace detail = pyinterp::detail;
+
+TEST(memo_cache, get) {
+  auto cache = detail::MemoCache<double>();
+  auto calls = 0;
+  auto compute = [&calls](double value) {
+    return [&calls, value]() {
+      ++calls;
+      return value;
+    };
+  };
+
+  EXPECT_EQ(cache.size(), 0U);
+  EXPECT_EQ(cache.get(1, compute(1.5)), 1.5);
+  EXPECT_EQ(cache.get(2, compute(2.5)), 2.5);
+  EXPECT_EQ(calls, 2);
+
+  // The values cached are not computed again.
+  EXPECT_EQ(cache.get(1, compute(-1)), 1.5);
+  EXPECT_EQ(calls, 2);
+  EXPECT_EQ(cache.size(), 2U);
+}
+
+TEST(memo_cache, threads) {
+  auto cache = detail::MemoCache<int64_t>();
+  auto calls = std::atomic<int64_t>(0);
+
+  detail::dispatch(
+      [&](size_t start, size_t end) {
+        for (auto ix = start; ix < end; ++ix) {
+          auto key = static_cast<uint64_t>(ix % 100);
+          auto value = cache.get(key, [&]() {
+            ++calls;
+            return static_cast<int64_t>(key * key);
+          });
+          EXPECT_EQ(value, static_cast<int64_t>(key * key));
+        }
+      },
+      10000, 4);
+  EXPECT_EQ(cache.size(), 100U);
+  EXPECT_GE(calls.load(), 100);
+}
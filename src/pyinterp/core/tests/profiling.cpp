@@ -0,0 +1,149 @@
+// Copyright (c) 2022 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+#include "pyinterp/detail/profiling.hpp"
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "pyinterp/detail/axis.hpp"
+#include "pyinterp/detail/thread.hpp"
+
+namespace detail = pyinterp::detail;
+namespace profiling = pyinterp::detail::profiling;
+
+TEST(profiling, disabled) {
+  profiling::enable(false);
+  profiling::reset();
+  auto axis = detail::Axis<double>(0, 9, 10, 1e-6, false);
+  for (auto ix = 0; ix < 100; ++ix) {
+    EXPECT_TRUE(axis.find_indexes(ix * 0.05));
+  }
+  auto snapshot = profiling::snapshot();
+  for (const auto& item : snapshot) {
+    EXPECT_EQ(item.calls, 0);
+    EXPECT_EQ(item.ticks, 0);
+  }
+}
+
+TEST(profiling, counters) {
+  profiling::enable(true);
+  profiling::reset();
+  auto axis = detail::Axis<double>(0, 9, 10, 1e-6, false);
+  for (auto ix = 0; ix < 100; ++ix) {
+    EXPECT_TRUE(axis.find_indexes(ix * 0.05));
+  }
+  {
+    auto scope = profiling::Scope(profiling::kLoadFrame);
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  auto snapshot = profiling::snapshot();
+  profiling::enable(false);
+
+  EXPECT_EQ(snapshot[profiling::kAxisFindIndexes].calls, 100);
+  EXPECT_EQ(snapshot[profiling::kLoadFrame].calls, 1);
+  EXPECT_GE(snapshot[profiling::kLoadFrame].seconds, 0.005);
+  EXPECT_LT(snapshot[profiling::kLoadFrame].seconds, 1.0);
+  EXPECT_EQ(snapshot[profiling::kRTreeQuery].calls, 0);
+
+  profiling::reset();
+  snapshot = profiling::snapshot();
+  for (const auto& item : snapshot) {
+    EXPECT_EQ(item.calls, 0);
+    EXPECT_EQ(item.seconds, 0);
+  }
+}
+
+TEST(profiling, threads) {
+  // The values counted by all the threads are summed, including those of the
+  // threads that have exited.
+  profiling::enable(true);
+  profiling::reset();
+  detail::dispatch(
+      [](const size_t start, const size_t end) {
+        for (auto ix = start; ix < end; ++ix) {
+          auto scope = profiling::Scope(profiling::kFillLoess);
+        }
+      },
+      1000, 4);
+  auto thread = std::thread([]() {
+    for (auto ix = 0; ix < 10; ++ix) {
+      auto scope = profiling::Scope(profiling::kFillLoess);
+    }
+  });
+  thread.join();
+  auto snapshot = profiling::snapshot();
+  profiling::enable(false);
+
+  EXPECT_EQ(snapshot[profiling::kFillLoess].calls, 1010);
+  EXPECT_EQ(snapshot[profiling::kDispatch].calls, 1);
+  // A worker may start its task after the other threads have processed all
+  // the items.
+  EXPECT_LE(snapshot[profiling::kDispatchStartup].calls, 3);
+}
+
+TEST(profiling, memory) {
+  using Allocator = profiling::Allocator<double, profiling::kFillLoess>;
+  profiling::enable(false);
+  profiling::reset();
+  {
+    auto memory = profiling::Allocation(profiling::kFillLoess, 1024);
+    auto values = std::vector<double, Allocator>(16);
+  }
+  auto snapshot = profiling::snapshot();
+  EXPECT_EQ(snapshot[profiling::kFillLoess].allocations, 0);
+  EXPECT_EQ(snapshot[profiling::kFillLoess].bytes, 0);
+  EXPECT_EQ(snapshot[profiling::kFillLoess].peak_bytes, 0);
+
+  profiling::enable(true);
+  profiling::reset();
+  {
+    auto memory = profiling::Allocation(profiling::kFillLoess, 1024);
+    auto values = std::vector<double, Allocator>(16);
+    // The vector allocated before the profiler is turned off is still
+    // accounted when it is released.
+    profiling::enable(false);
+  }
+  snapshot = profiling::snapshot();
+  EXPECT_EQ(snapshot[profiling::kFillLoess].allocations, 2);
+  EXPECT_EQ(snapshot[profiling::kFillLoess].bytes, 1024 + 16 * sizeof(double));
+  EXPECT_EQ(snapshot[profiling::kFillLoess].peak_bytes,
+            1024 + 16 * sizeof(double));
+
+  // The peak is the largest memory held at the same time.
+  profiling::enable(true);
+  profiling::reset();
+  {
+    auto values = std::vector<double, Allocator>(8);
+    {
+      auto other = std::vector<double, Allocator>(4);
+    }
+    auto other = std::vector<double, Allocator>(2);
+    values = std::move(other);
+  }
+  snapshot = profiling::snapshot();
+  EXPECT_EQ(snapshot[profiling::kFillLoess].allocations, 3);
+  EXPECT_EQ(snapshot[profiling::kFillLoess].bytes, 14 * sizeof(double));
+  EXPECT_EQ(snapshot[profiling::kFillLoess].peak_bytes, 12 * sizeof(double));
+
+  // After a reset, the peak starts from the memory still held.
+  auto values = std::vector<double, Allocator>(32);
+  profiling::reset();
+  snapshot = profiling::snapshot();
+  EXPECT_EQ(snapshot[profiling::kFillLoess].allocations, 0);
+  EXPECT_EQ(snapshot[profiling::kFillLoess].peak_bytes, 32 * sizeof(double));
+  values = std::vector<double, Allocator>();
+  profiling::enable(false);
+}
+
+TEST(profiling, name) {
+  for (auto ix = 0; ix < profiling::kCounterCount; ++ix) {
+    EXPECT_NE(std::string(profiling::name(static_cast<profiling::Counter>(ix))),
+              "unknown");
+  }
+  EXPECT_EQ(std::string(profiling::name(profiling::kCounterCount)), "unknown");
+}
@@ -0,0 +1,103 @@
+// Copyright (c) 2022 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+#include <gtest/gtest.h>
+
+#include "pyinterp/detail/math/streaming_histogram.hpp"
+#include "pyinterp/detail/serialization.hpp"
+
+namespace serialization = pyinterp::detail::serialization;
+namespace math = pyinterp::detail::math;
+
+TEST(serialization, reader) {
+  auto writer = serialization::Writer();
+  const double values[] = {1, 2, 3};
+  writer.write(int32_t(-5));
+  writer.write(values, 3);
+  auto buffer = std::move(writer).str();
+  ASSERT_EQ(buffer.size(), sizeof(int32_t) + 3 * sizeof(double));
+
+  auto reader = serialization::Reader(buffer);
+  EXPECT_EQ(reader.read<int32_t>(), -5);
+  double read[3];
+  reader.read(read, 3);
+  EXPECT_EQ(read[0], 1);
+  EXPECT_EQ(read[2], 3);
+  EXPECT_TRUE(reader.empty());
+  EXPECT_THROW(reader.read<char>(), std::invalid_argument);
+}
+
+TEST(serialization, grid_header) {
+  // Sparse grid: the indexes of the cells are written.
+  auto writer = serialization::Writer();
+  serialization::write_grid_header(writer, 2, 3, {1, 4});
+  auto buffer = std::move(writer).str();
+  EXPECT_EQ(buffer.size(), 6 * sizeof(int64_t));
+
+  auto reader = serialization::Reader(buffer);
+  EXPECT_EQ(serialization::read_grid_header(reader, 2, 3),
+            (std::vector<uint64_t>{1, 4}));
+  EXPECT_TRUE(reader.empty());
+
+  reader = serialization::Reader(buffer);
+  EXPECT_THROW(serialization::read_grid_header(reader, 3, 2),
+               std::invalid_argument);
+
+  // Dense grid: only the header is written.
+  writer = serialization::Writer();
+  serialization::write_grid_header(writer, 1, 2, {0, 1});
+  buffer = std::move(writer).str();
+  EXPECT_EQ(buffer.size(), 4 * sizeof(int64_t));
+  reader = serialization::Reader(buffer);
+  EXPECT_EQ(serialization::read_grid_header(reader, 1, 2),
+            (std::vector<uint64_t>{0, 1}));
+
+  // Indexes out of the grid or not sorted.
+  for (const auto& cells : std::vector<std::vector<uint64_t>>{{6}, {2, 1}}) {
+    writer = serialization::Writer();
+    serialization::write_grid_header(writer, 2, 3, cells);
+    buffer = std::move(writer).str();
+    reader = serialization::Reader(buffer);
+    EXPECT_THROW(serialization::read_grid_header(reader, 2, 3),
+                 std::invalid_argument);
+  }
+}
+
+TEST(serialization, streaming_histogram) {
+  auto first = math::StreamingHistogram<double>(4, false);
+  auto second = math::StreamingHistogram<double>(8, false);
+  for (auto ix = 0; ix < 10; ++ix) {
+    first(ix);
+    second(-ix, 2);
+  }
+
+  // The histograms are read one after the other from the same buffer.
+  auto writer = serialization::Writer();
+  first.marshal(writer);
+  second.marshal(writer);
+  auto buffer = std::move(writer).str();
+  auto reader = serialization::Reader(buffer);
+  auto first_copy = math::StreamingHistogram<double>(reader);
+  auto second_copy = math::StreamingHistogram<double>(reader);
+  EXPECT_TRUE(reader.empty());
+
+  EXPECT_EQ(first_copy.bin_count(), 4);
+  EXPECT_FALSE(first_copy.exact());
+  EXPECT_EQ(first_copy.count(), first.count());
+  EXPECT_EQ(first_copy.quantile(0.5), first.quantile(0.5));
+  EXPECT_EQ(second_copy.bin_count(), 8);
+  EXPECT_EQ(second_copy.sum_of_weights(), second.sum_of_weights());
+  EXPECT_EQ(second_copy.min(), second.min());
+
+  // State written without the exact flag.
+  auto state = static_cast<std::string>(second);
+  state.pop_back();
+  auto previous = math::StreamingHistogram<double>(state);
+  EXPECT_FALSE(previous.exact());
+  EXPECT_EQ(previous.size(), second.size());
+
+  // Truncated state.
+  state.resize(state.size() - 1);
+  EXPECT_THROW(math::StreamingHistogram<double>{state}, std::invalid_argument);
+}
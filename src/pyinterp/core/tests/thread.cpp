@@ -6,6 +6,10 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <atomic>
+#include <stdexcept>
+
 TEST(thread, dispatch) {
   std::vector<double> src(4096);
   std::vector<double> dst(4096);
@@ -25,3 +29,136 @@ TEST(thread, dispatch) {
     EXPECT_EQ(src[ix], dst[ix]);
   }
 }
+
+TEST(thread, dispatch_coverage) {
+  // Each item must be processed exactly once, whatever the number of threads
+  // requested and the size of the range.
+  for (auto schedule : {pyinterp::detail::kStatic, pyinterp::detail::kDynamic,
+                        pyinterp::detail::kGuided}) {
+    for (auto num_threads : {0, 2, 3, 7, 64}) {
+      for (auto size : {1, 2, 5, 63, 1000}) {
+        auto counter = std::vector<std::atomic<int>>(size);
+        pyinterp::detail::dispatch(
+            [&](size_t start, size_t stop) {
+              for (auto ix = start; ix < stop; ++ix) {
+                ++counter[ix];
+              }
+            },
+            size, num_threads, schedule);
+        for (auto& item : counter) {
+          EXPECT_EQ(item, 1);
+        }
+      }
+    }
+  }
+}
+
+TEST(thread, dispatch_imbalanced) {
+  // The first items are much more expensive to compute than the others.
+  for (auto schedule : {pyinterp::detail::kStatic, pyinterp::detail::kDynamic,
+                        pyinterp::detail::kGuided}) {
+    auto dst = std::vector<double>(512);
+    pyinterp::detail::dispatch(
+        [&](size_t start, size_t stop) {
+          for (auto ix = start; ix < stop; ++ix) {
+            auto value = 0.0;
+            auto n = ix < 64 ? 20000 : 1;
+            for (auto jx = 0; jx < n; ++jx) {
+              value += 1.0;
+            }
+            dst[ix] = value;
+          }
+        },
+        dst.size(), 4, schedule);
+    for (size_t ix = 0; ix < dst.size(); ++ix) {
+      EXPECT_EQ(dst[ix], ix < 64 ? 20000 : 1);
+    }
+  }
+}
+
+TEST(thread, dispatch_nested) {
+  auto total = std::atomic<size_t>(0);
+  pyinterp::detail::dispatch(
+      [&](size_t start, size_t stop) {
+        for (auto ix = start; ix < stop; ++ix) {
+          pyinterp::detail::dispatch(
+              [&](size_t start, size_t stop) { total += stop - start; }, 100,
+              0);
+        }
+      },
+      16, 0);
+  EXPECT_EQ(total, 1600);
+}
+
+TEST(thread, dispatch_exception) {
+  EXPECT_THROW(pyinterp::detail::dispatch(
+                   [](size_t start, size_t /*stop*/) {
+                     if (start == 0) {
+                       throw std::runtime_error("error");
+                     }
+                   },
+                   1024, 0),
+               std::runtime_error);
+}
+
+TEST(thread, resize) {
+  pyinterp::detail::ThreadPool::resize(3);
+  EXPECT_EQ(pyinterp::detail::ThreadPool::instance()->size(), 3);
+
+  auto total = std::atomic<size_t>(0);
+  pyinterp::detail::dispatch(
+      [&](size_t start, size_t stop) { total += stop - start; }, 256, 0);
+  EXPECT_EQ(total, 256);
+
+  pyinterp::detail::ThreadPool::resize(0);
+  EXPECT_EQ(pyinterp::detail::ThreadPool::instance()->size(),
+            pyinterp::detail::ThreadPool::default_size());
+}
+
+TEST(thread, num_threads) {
+  const auto cpus = pyinterp::detail::available_cpus();
+  EXPECT_GE(cpus, 1);
+  EXPECT_LE(cpus, std::max<size_t>(std::thread::hardware_concurrency(), 1));
+  EXPECT_EQ(pyinterp::detail::get_num_threads(), cpus);
+
+  pyinterp::detail::set_num_threads(3);
+  EXPECT_EQ(pyinterp::detail::get_num_threads(), 3);
+  EXPECT_EQ(pyinterp::detail::ThreadPool::instance()->size(), 2);
+  EXPECT_FALSE(pyinterp::detail::ThreadPool::instance()->pinned());
+
+  pyinterp::detail::set_num_threads(1);
+  EXPECT_EQ(pyinterp::detail::ThreadPool::instance()->size(), 0);
+  auto total = std::atomic<size_t>(0);
+  pyinterp::detail::dispatch(
+      [&](size_t start, size_t stop) { total += stop - start; }, 256, 0);
+  EXPECT_EQ(total, 256);
+
+  // The workers bound to CPUs compute the same results.
+  pyinterp::detail::set_num_threads(4, true);
+  EXPECT_EQ(pyinterp::detail::ThreadPool::instance()->size(), 3);
+  total = 0;
+  pyinterp::detail::dispatch(
+      [&](size_t start, size_t stop) { total += stop - start; }, 256, 0);
+  EXPECT_EQ(total, 256);
+
+  pyinterp::detail::set_num_threads(0);
+  EXPECT_EQ(pyinterp::detail::get_num_threads(), cpus);
+  EXPECT_EQ(pyinterp::detail::ThreadPool::instance()->size(),
+            pyinterp::detail::ThreadPool::default_size());
+}
+
+TEST(thread, dispatch_cancel) {
+  // After the first error, the blocks not yet started are skipped.
+  for (auto schedule : {pyinterp::detail::kStatic, pyinterp::detail::kDynamic,
+                        pyinterp::detail::kGuided}) {
+    auto processed = std::atomic<size_t>(0);
+    EXPECT_THROW(pyinterp::detail::dispatch(
+                     [&](size_t start, size_t stop) {
+                       processed += stop - start;
+                       throw std::runtime_error("error");
+                     },
+                     100000, 4, schedule),
+                 std::runtime_error);
+    EXPECT_LT(processed, 100000);
+  }
+}
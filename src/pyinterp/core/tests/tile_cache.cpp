@@ -0,0 +1,70 @@
+// Copyright (c) 2022 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+#include "pyinterp/detail/tile_cache.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <vector>
+
+#include "pyinterp/detail/thread.hpp"
+
+namespace detail = pyinterp::detail;
+
+TEST(tile_cache, lru) {
+  auto cache = detail::TileCache<std::vector<int>>(2);
+  auto loads = 0;
+  auto load = [&loads](int value) {
+    return [&loads, value]() {
+      ++loads;
+      return std::vector<int>(4, value);
+    };
+  };
+
+  EXPECT_EQ(cache.capacity(), 2);
+  EXPECT_EQ((*cache.get(1, load(1)))[0], 1);
+  EXPECT_EQ((*cache.get(2, load(2)))[0], 2);
+  EXPECT_EQ(loads, 2);
+
+  // The tile 1 becomes the most recently used, so the tile 2 is evicted.
+  EXPECT_EQ((*cache.get(1, load(-1)))[0], 1);
+  auto tile = cache.get(3, load(3));
+  EXPECT_EQ(loads, 3);
+  EXPECT_EQ(cache.size(), 2);
+  EXPECT_EQ((*cache.get(2, load(2)))[0], 2);
+  EXPECT_EQ(loads, 4);
+
+  // An evicted tile remains valid as long as it is referenced.
+  cache.clear();
+  EXPECT_EQ(cache.size(), 0);
+  EXPECT_EQ((*tile)[3], 3);
+}
+
+TEST(tile_cache, threads) {
+  auto cache = detail::TileCache<std::vector<int64_t>>(64);
+  auto loads = std::atomic<int>(0);
+  auto errors = std::atomic<int>(0);
+
+  detail::dispatch(
+      [&](size_t start, size_t end) {
+        for (auto ix = start; ix < end; ++ix) {
+          auto key = static_cast<int64_t>(ix % 32);
+          auto tile = cache.get(key, [&]() {
+            ++loads;
+            return std::vector<int64_t>(16, key);
+          });
+          if ((*tile)[15] != key) {
+            ++errors;
+          }
+        }
+      },
+      10000, 4);
+  EXPECT_EQ(errors, 0);
+  EXPECT_EQ(cache.size(), 32);
+  // A tile can be loaded concurrently by several threads, but only once by
+  // each of them.
+  EXPECT_GE(loads, 32);
+  EXPECT_LE(loads, 32 * 4);
+}
@@ -2,7 +2,7 @@
 Replace undefined values
 ------------------------
 """
-from typing import Optional, Union
+from typing import Callable, Optional, Tuple, Union
 import concurrent.futures
 import numpy as np
 from . import core
@@ -14,11 +14,21 @@ def loess(mesh: Union[grid.Grid2D, grid.Grid3D],
           nx: int = 3,
           ny: int = 3,
           value_type: Optional[str] = None,
-          num_threads: int = 0):
+          num_threads: int = 0,
+          nz: Optional[int] = None,
+          separable: bool = True):
     """Filter values using a locally weighted regression function or LOESS.
     The weight function used for LOESS is the tri-cube weight function,
     :math:`w(x)=(1-|d|^3)^3`.
 
+    If the X and Y axes are regular, the weights of the window are computed
+    once for the whole grid, which is much faster.
+
+    By default, the values of a 3D grid are filtered layer by layer. If
+    ``nz`` is given, the window also extends along the Z-axis (for example,
+    the time axis of a spatio-temporal grid), the distance along this axis
+    being the number of steps between the pixels.
+
     Args:
         mesh (pyinterp.grid.Grid2D, pyinterp.grid.Grid3D): Grid function on
             a uniform 2-dimensional grid to be filled.
@@ -33,20 +43,36 @@ def loess(mesh: Union[grid.Grid2D, grid.Grid3D],
             computation. If 0 all CPUs are used. If 1 is given, no parallel
             computing code is used at all, which is useful for debugging.
             Defaults to ``0``.
+        nz (int, optional): Number of points of the half-window to be taken
+            into account along the Z-axis of a 3D grid. Defaults to ``None``,
+            which filters each layer of the grid independently.
+        separable (bool, optional): Only used if ``nz`` is given. If true,
+            the weight of a pixel of the window is the product of the
+            weights of its distances along each axis, which is computed in
+            three one-dimensional passes, much faster for large windows.
+            Otherwise, it is the weight of its distance to the filtered
+            pixel. Defaults to ``True``.
 
     Returns:
         numpy.ndarray: the grid will have NaN filled with extrapolated values.
     """
     value_type = value_type or "undefined"
     instance = mesh._instance
-    function = interface._core_function("loess", instance)
 
     if value_type not in ['undefined', 'defined', 'all']:
         raise ValueError(f"value type {value_type!r} is not defined")
+    value_type = getattr(core.fill.ValueType, value_type.capitalize())
 
-    return getattr(core.fill, function)(instance, nx, ny,
-                                        getattr(core.fill.ValueType,
-                                                value_type.capitalize()),
+    if nz is not None:
+        if not isinstance(mesh, grid.Grid3D):
+            raise ValueError("nz is only supported by 3D grids")
+        function = interface._core_function("loess_3d", instance)
+        return getattr(core.fill, function)(instance, nx, ny, nz,
+                                            value_type, separable,
+                                            num_threads)
+
+    function = interface._core_function("loess", instance)
+    return getattr(core.fill, function)(instance, nx, ny, value_type,
                                         num_threads)
 
 
@@ -55,7 +81,13 @@ def gauss_seidel(mesh: Union[grid.Grid2D, grid.Grid3D],
                  max_iteration: Optional[int] = None,
                  epsilon: Optional[float] = 1e-4,
                  relaxation: Optional[float] = None,
-                 num_threads: Optional[int] = 0):
+                 num_threads: Optional[int] = 0,
+                 ordering: Optional[str] = "lexicographic",
+                 retire: bool = False,
+                 callback: Optional[Callable[[core.fill.Iteration],
+                                             bool]] = None,
+                 callback_interval: int = 1,
+                 warm_start: bool = False):
     """
     Replaces all undefined values (NaN) in a grid using the Gauss-Seidel
     method by relaxation.
@@ -94,6 +126,44 @@ def gauss_seidel(mesh: Union[grid.Grid2D, grid.Grid3D],
             computation. If 0 all CPUs are used. If 1 is given, no parallel
             computing code is used at all, which is useful for debugging.
             Defaults to ``0``.
+        ordering (str, optional): Order in which the undefined values are
+            updated. Supported values are:
+
+                * ``lexicographic`` means that the grid is processed row by
+                  row, the rows being pipelined between the threads;
+                * ``red_black`` means that the undefined values are colored as
+                  a checkerboard and that all the values of a color are
+                  updated in parallel. This ordering scales better with the
+                  number of threads, but the result differs slightly from the
+                  lexicographic ordering.
+
+            Defaults to ``lexicographic``.
+        retire (bool, optional): If true, the undefined values whose residual
+            is lower than ``epsilon`` are no longer updated by the next
+            iterations, which makes the iterations much cheaper when most of
+            the values have converged or when the undefined values are
+            sparse. Once all the values updated have converged, a last
+            iteration over all the undefined values checks the result; if it
+            fails, the iterations resume from all the undefined values.
+            Defaults to ``False``.
+        callback (callable, optional): Function called every
+            ``callback_interval`` iterations, and after the last one, with the
+            state of the iterations: a :py:class:`pyinterp.core.fill.Iteration`
+            holding the number of iterations performed, the maximum residual
+            and the wall time of the last iteration, and the number of
+            undefined values that have not converged. If the function returns
+            ``True``, the iterations are stopped. For a 3D grid, the function
+            is called for each layer, from the threads filling the layers.
+            Defaults to ``None``.
+        callback_interval (int, optional): Number of iterations between two
+            calls of ``callback``. Defaults to ``1``.
+        warm_start (bool, optional): For a 3D grid, if true, the first guess
+            of a layer is the solution found for the previous layer, which
+            reduces the number of iterations when the layers are similar
+            (e.g. successive time steps). The layers are then split into one
+            contiguous block per thread, the first layer of each block being
+            initialized with ``first_guess``. Ignored for a 2D grid. Defaults
+            to ``False``.
 
     Returns:
         tuple: a boolean indicating if the calculation has converged, i. e. if
@@ -102,6 +172,8 @@ def gauss_seidel(mesh: Union[grid.Grid2D, grid.Grid3D],
     """
     if first_guess not in ['zero', 'zonal_average']:
         raise ValueError(f"first_guess type {first_guess!r} is not defined")
+    if ordering not in ['lexicographic', 'red_black']:
+        raise ValueError(f"ordering {ordering!r} is not defined")
 
     ny = len(mesh.y)
     nx = len(mesh.x)
@@ -120,23 +192,276 @@ def gauss_seidel(mesh: Union[grid.Grid2D, grid.Grid3D],
     first_guess = getattr(
         getattr(core.fill, "FirstGuess"),
         "".join(item.capitalize() for item in first_guess.split("_")))
+    ordering = getattr(
+        getattr(core.fill, "Ordering"),
+        "".join(item.capitalize() for item in ordering.split("_")))
 
     instance = mesh._instance
     function = interface._core_function("gauss_seidel", instance)
+    if nz == 0:
+        filled = np.copy(mesh.array)
+        _iterations, residual = getattr(core.fill,
+                                        function)(filled, first_guess,
+                                                  mesh.x.is_circle,
+                                                  max_iteration, epsilon,
+                                                  relaxation, ordering,
+                                                  retire, callback,
+                                                  callback_interval,
+                                                  num_threads)
+    else:
+        filled, _iterations, residuals = getattr(core.fill, function)(
+            instance, first_guess, max_iteration, epsilon, relaxation,
+            ordering, retire, warm_start, callback, callback_interval,
+            num_threads)
+        residual = residuals.max() if len(residuals) else 0
+    return residual <= epsilon, filled
+
+
+def gauss_seidel_tile(tile: np.ndarray,
+                      exchange: Callable[[], None],
+                      origin: Tuple[int, int],
+                      shape: Tuple[int, int],
+                      reduce: Optional[Callable[[float], float]] = None,
+                      first_guess: str = "zonal_average",
+                      is_circle: bool = True,
+                      max_iteration: Optional[int] = None,
+                      epsilon: float = 1e-4,
+                      relaxation: Optional[float] = None,
+                      num_threads: int = 0) -> bool:
+    """
+    Replaces all undefined values (NaN) in a tile of a grid decomposed into
+    tiles, processed by different threads or processes, using the
+    Gauss-Seidel method by relaxation.
+
+    The undefined values are updated with the red-black ordering, and the
+    halos of the tiles are exchanged after each color, by a function provided
+    by the caller (e.g. using MPI or Dask): the result is the one of the
+    red-black ordering on the whole grid. All the tiles must iterate
+    together, each call of ``exchange`` returning once the halo of the tile
+    has been received from its neighbors.
+
+    Args:
+        tile (numpy.ndarray): Tile to be filled in place, of type
+            ``float32`` or ``float64``, surrounded by a halo of one pixel
+            along each side: its shape is ``(nx + 2, ny + 2)`` for a tile of
+            ``nx`` by ``ny`` pixels.
+        exchange (callable): Function called without argument after the
+            first guess and after each color. It writes the halo of ``tile``
+            from the pixels of the neighboring tiles. If the X-axis is a
+            circle, the halos along the X-axis are read from the other end of
+            the grid, possibly from the tile itself. The halos on the other
+            edges of the grid are not used.
+        origin (tuple): Position of the first pixel of the tile (without its
+            halo) in the grid, along the X and Y axes.
+        shape (tuple): Number of pixels of the grid along the X and Y axes.
+        reduce (callable, optional): Function called once per iteration with
+            the maximum residual of the tile, returning the maximum residual
+            of all the tiles, which decides the end of the iterations. Must be
+            set if the grid is split into several tiles. Defaults to
+            ``None``.
+        first_guess (str, optional): Specifies the type of first guess grid,
+            computed from the pixels of the tile. Supported values are
+            ``zero`` and ``zonal_average``. Defaults to ``zonal_average``.
+        is_circle (bool, optional): True if the X-axis of the grid defines a
+            circle. Defaults to ``True``.
+        max_iteration (int, optional): Maximum number of iterations to be
+            used by relaxation. The default value is equal to the product of
+            the grid dimensions.
+        epsilon (float, optional): Tolerance for ending relaxation before the
+            maximum number of iterations limit. Defaults to ``1e-4``.
+        relaxation (float, optional): Relaxation constant. If this parameter
+            is not set, the optimal value for the whole grid is chosen, as
+            done by :py:func:`gauss_seidel`.
+        num_threads (int, optional): The number of threads to use for the
+            computation of the tile. If 0 all CPUs are used. If 1 is given,
+            no parallel computing code is used at all, which is useful for
+            debugging. Defaults to ``0``.
+
+    Returns:
+        bool: True if the calculation has converged, i. e. if the value of
+        the residues is lower than the ``epsilon`` limit set.
+    """
+    if first_guess not in ['zero', 'zonal_average']:
+        raise ValueError(f"first_guess type {first_guess!r} is not defined")
+    if tile.dtype not in [np.float32, np.float64]:
+        raise ValueError(f"tile data type {tile.dtype} is not supported")
+
+    nx, ny = shape
+    if relaxation is None:
+        if nx == ny:
+            N = nx
+        else:
+            N = nx * ny * np.sqrt(2 / (nx**2 + ny**2))
+        relaxation = 2 / (1 + np.pi / N)
+
+    if max_iteration is None:
+        max_iteration = nx * ny
+
+    first_guess = getattr(
+        getattr(core.fill, "FirstGuess"),
+        "".join(item.capitalize() for item in first_guess.split("_")))
+
+    function = getattr(core.fill, f"gauss_seidel_tile_{tile.dtype.name}")
+    _iterations, residual = function(tile, exchange, origin, shape, reduce,
+                                     first_guess, is_circle, max_iteration,
+                                     epsilon, relaxation, num_threads)
+    return residual <= epsilon
+
+
+def multigrid(mesh: Union[grid.Grid2D, grid.Grid3D],
+              first_guess: str = "zonal_average",
+              max_iteration: Optional[int] = None,
+              epsilon: float = 1e-4,
+              num_threads: int = 0):
+    """
+    Replaces all undefined values (NaN) in a grid by solving the Laplace
+    equation with a multigrid method.
+
+    The equation solved is the same as the one solved by
+    :py:func:`gauss_seidel`, but the low-frequency components of the error,
+    which the relaxation reduces very slowly, are eliminated on coarser grids.
+    The number of iterations needed to reach the tolerance hardly depends on
+    the size of the undefined areas, which makes this method much faster on
+    large gaps.
+
+    Args:
+        mesh (pyinterp.grid.Grid2D, pyinterp.grid.Grid3D): Grid function on
+            a uniform 2/3-dimensional grid to be filled.
+        first_guess (str, optional): Specifies the type of first guess grid.
+            Supported values are:
+
+                * ``zero`` means use ``0.0`` as an initial guess;
+                * ``zonal_average`` means that zonal averages (i.e, averages in
+                  the X-axis direction) will be used.
+
+            Defaults to ``zonal_average``.
+
+        max_iteration (int, optional): Maximum number of V-cycles performed.
+            Defaults to ``100``.
+        epsilon (float, optional): Tolerance for ending the cycles before the
+            maximum number of iterations limit: maximum change of a value
+            during the last relaxation of a cycle. Defaults to ``1e-4``.
+        num_threads (int, optional): The number of threads to use for the
+            computation. If 0 all CPUs are used. If 1 is given, no parallel
+            computing code is used at all, which is useful for debugging.
+            Defaults to ``0``.
+
+    Returns:
+        tuple: a boolean indicating if the calculation has converged, i. e. if
+        the value of the residues is lower than the ``epsilon`` limit set, and
+        the the grid will have the all NaN filled with extrapolated values.
+    """
+    if first_guess not in ['zero', 'zonal_average']:
+        raise ValueError(f"first_guess type {first_guess!r} is not defined")
+
+    nz = len(mesh.z) if isinstance(mesh, grid.Grid3D) else 0
+
+    if max_iteration is None:
+        max_iteration = 100
+
+    first_guess = getattr(
+        getattr(core.fill, "FirstGuess"),
+        "".join(item.capitalize() for item in first_guess.split("_")))
+
+    instance = mesh._instance
+    function = interface._core_function("multigrid", instance)
+    filled = np.copy(mesh.array)
+    if nz == 0:
+        _iterations, residual = getattr(core.fill,
+                                        function)(filled, first_guess,
+                                                  mesh.x.is_circle,
+                                                  max_iteration, epsilon,
+                                                  num_threads)
+    else:
+        with concurrent.futures.ThreadPoolExecutor(
+                max_workers=num_threads if num_threads else None) as executor:
+            futures = [
+                executor.submit(getattr(core.fill, function), filled[:, :, iz],
+                                first_guess, mesh.x.is_circle, max_iteration,
+                                epsilon, 1) for iz in range(nz)
+            ]
+            residuals = []
+            for future in concurrent.futures.as_completed(futures):
+                _, residual = future.result()
+                residuals.append(residual)
+            residual = max(residuals)
+    return residual <= epsilon, filled
+
+
+def spectral(mesh: Union[grid.Grid2D, grid.Grid3D],
+             first_guess: str = "zonal_average",
+             max_iteration: Optional[int] = None,
+             epsilon: float = 1e-4,
+             num_threads: int = 0):
+    """
+    Replaces all undefined values (NaN) in a grid by solving the Laplace
+    equation with the conjugate gradient method, preconditioned by a fast
+    Poisson solver.
+
+    The equation solved is the same as the one solved by
+    :py:func:`gauss_seidel`. On the whole grid, it is solved exactly by
+    Fourier transforms along the X-axis, which leave a tridiagonal system
+    along the Y-axis for each wave number; restricted to the undefined values,
+    this solution corrects the low-frequency components of the error, which
+    the relaxation reduces very slowly. A few tens of iterations are enough
+    where the relaxation needs thousands. The X-axis is best periodic, but a
+    mirrored X-axis is also supported.
+
+    Args:
+        mesh (pyinterp.grid.Grid2D, pyinterp.grid.Grid3D): Grid function on
+            a uniform 2/3-dimensional grid to be filled.
+        first_guess (str, optional): Specifies the type of first guess grid.
+            Supported values are:
+
+                * ``zero`` means use ``0.0`` as an initial guess;
+                * ``zonal_average`` means that zonal averages (i.e, averages in
+                  the X-axis direction) will be used.
+
+            Defaults to ``zonal_average``.
+
+        max_iteration (int, optional): Maximum number of iterations.
+            Defaults to ``100``.
+        epsilon (float, optional): Tolerance for ending the iterations before
+            the maximum number of iterations limit: maximum change of a value
+            that a relaxation of the grid would perform. Defaults to ``1e-4``.
+        num_threads (int, optional): The number of threads to use for the
+            computation. If 0 all CPUs are used. If 1 is given, no parallel
+            computing code is used at all, which is useful for debugging.
+            Defaults to ``0``.
+
+    Returns:
+        tuple: a boolean indicating if the calculation has converged, i. e. if
+        the value of the residues is lower than the ``epsilon`` limit set, and
+        the the grid will have the all NaN filled with extrapolated values.
+    """
+    if first_guess not in ['zero', 'zonal_average']:
+        raise ValueError(f"first_guess type {first_guess!r} is not defined")
+
+    nz = len(mesh.z) if isinstance(mesh, grid.Grid3D) else 0
+
+    if max_iteration is None:
+        max_iteration = 100
+
+    first_guess = getattr(
+        getattr(core.fill, "FirstGuess"),
+        "".join(item.capitalize() for item in first_guess.split("_")))
+
+    instance = mesh._instance
+    function = interface._core_function("spectral", instance)
     filled = np.copy(mesh.array)
     if nz == 0:
         _iterations, residual = getattr(core.fill,
                                         function)(filled, first_guess,
                                                   mesh.x.is_circle,
                                                   max_iteration, epsilon,
-                                                  relaxation, num_threads)
+                                                  num_threads)
     else:
         with concurrent.futures.ThreadPoolExecutor(
                 max_workers=num_threads if num_threads else None) as executor:
             futures = [
                 executor.submit(getattr(core.fill, function), filled[:, :, iz],
                                 first_guess, mesh.x.is_circle, max_iteration,
-                                epsilon, relaxation, 1) for iz in range(nz)
+                                epsilon, 1) for iz in range(nz)
             ]
             residuals = []
             for future in concurrent.futures.as_completed(futures):
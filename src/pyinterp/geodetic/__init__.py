@@ -4,8 +4,10 @@ Geographic coordinate system
 """
 from typing import List, Optional, Tuple
 import warnings
+import numpy
 from ..core import geodetic
-from ..core.geodetic import coordinate_distances, normalize_longitudes
+from ..core.geodetic import (coordinate_distances, crossovers,
+                             normalize_longitudes)
 
 
 class System(geodetic.System):
@@ -133,3 +135,70 @@ class Polygon(geodetic.Polygon):
             :py:class:`pyinterp.geodetic.Point`.
         """
         super().__init__(outer, inners)  # type: ignore
+
+
+class PreparedPolygon(geodetic.PreparedPolygon):
+    """Polygon prepared for testing the location of many points.
+
+    The edges of the polygon are indexed by longitude once, then the index is
+    shared by all the tests, and by the threads testing the points. The
+    results are identical to those of :py:meth:`Polygon.covered_by`.
+    """
+    def __init__(self, polygon: Polygon) -> None:
+        """Builds the index of the edges of the polygon.
+
+        Args:
+          polygon (pyinterp.geodetic.Polygon): The polygon to prepare.
+        """
+        super().__init__(polygon)
+
+
+class MultiPolygon(geodetic.MultiPolygon):
+    """A collection of polygons.
+
+    The points can be located among the polygons in a single pass with
+    :py:meth:`which_polygon`, which returns for each point the index of the
+    first polygon covering it.
+    """
+    def __init__(self, polygons: Optional[List[Polygon]] = None) -> None:
+        """Constructor filling the collection.
+
+        Args:
+          polygons (list, optional): list of polygons.
+        Raises:
+          ValueError: if polygons is not a list of
+            :py:class:`pyinterp.geodetic.Polygon`.
+        """
+        super().__init__(polygons)  # type: ignore
+
+
+def interpolate_along_track(values: numpy.ndarray,
+                            index: numpy.ndarray) -> numpy.ndarray:
+    """Interpolates linearly values measured along a track at fractional
+    positions, such as the positions of the crossovers returned by
+    :py:func:`crossovers`.
+
+    Args:
+        values (numpy.ndarray): Values measured at the points of the track.
+            The first axis is the along-track axis. The values can be dates
+            (``numpy.datetime64``).
+        index (numpy.ndarray): Positions along the track: the integer part is
+            the index of the point preceding the position, the fractional part
+            is the position between this point and the next one.
+    Returns:
+        numpy.ndarray: The values interpolated at the given positions.
+
+    Example:
+        >>> lon, lat, index1, index2 = crossovers(lon1, lat1, lon2, lat2)
+        >>> time = interpolate_along_track(time1, index1)
+    """
+    values = numpy.asarray(values)
+    index = numpy.asarray(index, dtype="float64")
+    if values.shape[0] < 2:
+        raise ValueError("the track must contain at least two points")
+    lower = numpy.clip(numpy.floor(index).astype("int64"), 0,
+                       values.shape[0] - 2)
+    weight = (index - lower).reshape(index.shape + (1, ) *
+                                     (values.ndim - 1))
+    lhs = values[lower]
+    return lhs + (values[lower + 1] - lhs) * weight
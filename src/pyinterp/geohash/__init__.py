@@ -22,5 +22,7 @@ from ..core.geohash import (
     encode,
     transform,
     where,
+    where_arrays,
 )
 from .converter import to_xarray
+from .index import Index, join
@@ -0,0 +1,284 @@
+# Copyright (c) 2022 CNES
+#
+# All rights reserved. Use of this source code is governed by a
+# BSD-style license that can be found in the LICENSE file.
+"""
+GeoHash spatial index
+---------------------
+"""
+from typing import Iterator, Optional, Tuple
+import math
+import struct
+import numpy as np
+from .. import core
+from .. import geodetic
+
+
+class Index:
+    """Spatial index storing points in the cells of a geohash grid.
+
+    The points are sorted by the geohash code of the cell containing them and
+    stored contiguously. Building the index costs one parallel sort and the
+    index uses less memory than a :py:class:`pyinterp.RTree`. It is suited to
+    quasi-uniform observation networks: the searches explore the cells
+    surrounding the points until the nearest neighbors are found, so the
+    precision should be chosen so that the cells hold a few points. Near the
+    poles, the cells are narrower and the searches explore more of them.
+    """
+    def __init__(self,
+                 precision: int,
+                 system: Optional[geodetic.System] = None,
+                 dtype: Optional[np.dtype] = None):
+        """
+        Initialize a new index.
+
+        Args:
+            precision (int): Number of bits of the geohash codes defining the
+                cells of the index, within [1, 64].
+            system (pyinterp.geodetic.System, optional): WGS of the
+                coordinate system used to transform the positions into ECEF
+                coordinates. If not set the geodetic system used is WGS-84.
+                Default to ``None``.
+            dtype (numpy.dtype, optional): Data type of the values stored in
+                the index. Defaults to ``float64``.
+        """
+        dtype = np.dtype(dtype or "float64")
+        suffix = {"float64": "Float64", "float32": "Float32"}.get(dtype.name)
+        if suffix is None:
+            raise ValueError(f"dtype {dtype} not handled by the object")
+        self._instance = getattr(core.geohash, f"Index{suffix}")(precision,
+                                                                 system)
+        self.dtype = dtype
+
+    @property
+    def precision(self) -> int:
+        """Number of bits of the geohash codes defining the cells."""
+        return self._instance.precision
+
+    def cells(self) -> int:
+        """Returns the number of cells holding at least one point."""
+        return self._instance.cells()
+
+    def __len__(self):
+        """Returns the number of points stored in the index."""
+        return self._instance.__len__()
+
+    def __bool__(self):
+        """Returns true if the index is not empty."""
+        return self._instance.__bool__()
+
+    def packing(self,
+                lon: np.ndarray,
+                lat: np.ndarray,
+                values: np.ndarray,
+                num_threads: Optional[int] = 0) -> None:
+        """Builds the index from the provided points. The old data is erased.
+
+        Args:
+            lon (numpy.ndarray): Longitudes of the points, in degrees.
+            lat (numpy.ndarray): Latitudes of the points, in degrees.
+            values (numpy.ndarray): Values associated with the points.
+            num_threads (int, optional): The number of threads to use for the
+                computation. If 0 all CPUs are used. If 1 is given, no parallel
+                computing code is used at all, which is useful for debugging.
+                Defaults to ``0``.
+        """
+        self._instance.packing(np.asarray(lon, dtype="float64"),
+                               np.asarray(lat, dtype="float64"),
+                               np.asarray(values, dtype=self.dtype),
+                               num_threads)
+
+    def query(self,
+              lon: np.ndarray,
+              lat: np.ndarray,
+              k: Optional[int] = 4,
+              radius: Optional[float] = None,
+              num_threads: Optional[int] = 0) -> Tuple[np.ndarray, np.ndarray]:
+        """Search for the nearest K nearest neighbors of the given points.
+
+        Args:
+            lon (numpy.ndarray): Longitudes of the points, in degrees.
+            lat (numpy.ndarray): Latitudes of the points, in degrees.
+            k (int, optional): The number of nearest neighbors to be searched.
+                Defaults to ``4``.
+            radius (float, optional): The maximum distance between a point and
+                its neighbors, in meters. By default, the distance is not
+                limited.
+            num_threads (int, optional): The number of threads to use for the
+                computation. If 0 all CPUs are used. If 1 is given, no parallel
+                computing code is used at all, which is useful for debugging.
+                Defaults to ``0``.
+        Returns:
+            tuple: A tuple containing a matrix describing for each provided
+            position, the distance, in meters, between the provided position
+            and the found neighbors and a matrix containing the value of the
+            different neighbors found for all provided positions. The missing
+            neighbors are set to -1.
+        """
+        return self._instance.query(np.asarray(lon, dtype="float64"),
+                                    np.asarray(lat, dtype="float64"), k,
+                                    radius, num_threads)
+
+    def within(
+            self,
+            lon: np.ndarray,
+            lat: np.ndarray,
+            radius: float,
+            num_threads: Optional[int] = 0
+    ) -> Tuple[np.ndarray, np.ndarray, np.ndarray]:
+        """Search for all the points located within a radius of the given
+        points.
+
+        Args:
+            lon (numpy.ndarray): Longitudes of the points, in degrees.
+            lat (numpy.ndarray): Latitudes of the points, in degrees.
+            radius (float): The maximum distance between a point and its
+                neighbors, in meters.
+            num_threads (int, optional): The number of threads to use for the
+                computation. If 0 all CPUs are used. If 1 is given, no parallel
+                computing code is used at all, which is useful for debugging.
+                Defaults to ``0``.
+        Returns:
+            tuple: A tuple containing, for each pair found, the index of the
+            provided point, the value of the neighbor and the distance, in
+            meters, between them. The pairs are sorted by index, then by
+            increasing distance.
+        """
+        return self._instance.within(np.asarray(lon, dtype="float64"),
+                                     np.asarray(lat, dtype="float64"), radius,
+                                     num_threads)
+
+    def save(self, path: str) -> None:
+        """Writes the index to a file that can be mapped in memory by
+        :py:meth:`load`.
+
+        Args:
+            path (str): Path to the file to create.
+
+        .. note::
+
+            The file stores the memory representation of the index: it can
+            only be loaded on a machine with the same architecture.
+        """
+        self._instance.save(path)
+
+    @staticmethod
+    def load(path: str) -> "Index":
+        """Opens an index written by :py:meth:`save`.
+
+        The file is mapped read-only in memory instead of being read. The file
+        must not be modified while the index is in use.
+
+        Args:
+            path (str): Path to the file to open.
+
+        Returns:
+            Index: The index stored in the file.
+        """
+        # The header of the file starts with an identifier, the version of
+        # the layout, the precision and the size of the values.
+        with open(path, "rb") as stream:
+            header = stream.read(20)
+        if len(header) != 20 or header[:8] != b"PYIGHIDX":
+            raise ValueError(f"invalid index file: {path}")
+        _, precision, value_size = struct.unpack("=3I", header[8:])
+        dtype = {8: np.dtype("float64"), 4: np.dtype("float32")}.get(value_size)
+        if dtype is None or not 1 <= precision <= 64:
+            raise ValueError(f"invalid index file: {path}")
+        result = Index(precision, dtype=dtype)
+        result._instance = type(result._instance).load(path)
+        return result
+
+    def __getstate__(self) -> Tuple:
+        """Return the state of the object for pickling purposes.
+
+        Returns:
+            tuple: The state of the object for pickling purposes.
+        """
+        return (self.dtype, self._instance.__getstate__())
+
+    def __setstate__(self, state: Tuple):
+        """Set the state of the object from pickling.
+
+        Args:
+            state (tuple): The state of the object for pickling purposes.
+        """
+        if len(state) != 2:
+            raise ValueError("invalid state")
+        _class = Index(1, None, state[0])
+        _class._instance.__setstate__(state[1])
+        self.dtype = _class.dtype
+        self._instance = _class._instance
+
+
+def join(lon1: np.ndarray,
+         lat1: np.ndarray,
+         lon2: np.ndarray,
+         lat2: np.ndarray,
+         radius: float,
+         precision: Optional[int] = None,
+         system: Optional[geodetic.System] = None,
+         chunk_size: Optional[int] = 1_000_000,
+         num_threads: Optional[int] = 0
+         ) -> Iterator[Tuple[np.ndarray, np.ndarray, np.ndarray]]:
+    """Finds all the pairs of points of two sets located within a radius.
+
+    The second set is stored in a geohash index, then the points of the first
+    set are searched in it, chunk by chunk: the cells containing a point and
+    the rings of cells surrounding it are explored in parallel until the
+    cells not explored are farther than the radius. The memory used by the
+    result is bounded by the number of pairs found in a chunk.
+
+    Args:
+        lon1 (numpy.ndarray): Longitudes of the first set of points, in
+            degrees.
+        lat1 (numpy.ndarray): Latitudes of the first set of points, in
+            degrees.
+        lon2 (numpy.ndarray): Longitudes of the second set of points, in
+            degrees.
+        lat2 (numpy.ndarray): Latitudes of the second set of points, in
+            degrees.
+        radius (float): The maximum distance between the points of a pair, in
+            meters.
+        precision (int, optional): Number of bits of the geohash codes
+            defining the cells of the index. By default, the cells are about
+            the size of the radius.
+        system (pyinterp.geodetic.System, optional): WGS of the coordinate
+            system used to transform the positions into ECEF coordinates. If
+            not set the geodetic system used is WGS-84.
+        chunk_size (int, optional): Number of points of the first set
+            processed at once. Defaults to ``1_000_000``.
+        num_threads (int, optional): The number of threads to use for the
+            computation. If 0 all CPUs are used. If 1 is given, no parallel
+            computing code is used at all, which is useful for debugging.
+            Defaults to ``0``.
+    Yields:
+        tuple: For each chunk of the first set, the indices of the points of
+        the first set, the indices of the points of the second set, and the
+        Euclidean distances between the ECEF coordinates of the points, in
+        meters. The pairs are sorted by index in the first set, then by
+        increasing distance.
+    """
+    lon1 = np.asarray(lon1, dtype="float64").ravel()
+    lat1 = np.asarray(lat1, dtype="float64").ravel()
+    if lon1.shape != lat1.shape:
+        raise ValueError("lon1, lat1 could not be broadcast together")
+    if chunk_size is None or chunk_size < 1:
+        raise ValueError("chunk_size must be a strictly positive integer")
+    if precision is None:
+        # Number of halvings of the meridian (about 20,000 km) giving cells
+        # taller than the radius; the cells are square at the equator.
+        lat_bits = int(math.floor(math.log2(20_000_000 / max(radius, 1))))
+        precision = 2 * min(max(lat_bits, 0), 31) + 1
+    index = core.geohash.IndexInt64(precision, system)
+    lon2 = np.asarray(lon2, dtype="float64").ravel()
+    index.packing(lon2,
+                  np.asarray(lat2, dtype="float64").ravel(),
+                  np.arange(lon2.size, dtype="int64"),
+                  num_threads)
+    for start in range(0, lon1.size, chunk_size):
+        end = min(start + chunk_size, lon1.size)
+        first, second, distances = index.within(lon1[start:end],
+                                                lat1[start:end], radius,
+                                                num_threads)
+        yield first + start, second, distances
@@ -6,4 +6,4 @@
 Geohash integer
 ---------------
 """
-from ..core.geohash.int64 import decode, encode, neighbors
\ No newline at end of file
+from ..core.geohash.int64 import bounding_boxes, decode, encode, neighbors
\ No newline at end of file
@@ -6,19 +6,51 @@
 Regular grids
 =============
 """
-from typing import Optional, Union
+from typing import Callable, Optional, Tuple, Union
 import numpy as np
 from . import core
 from . import interface
 
 
+def _packing(array: np.ndarray, scale_factor: Optional[float],
+             add_offset: Optional[float],
+             fill_value: Optional[Union[int, float]]) -> Optional[tuple]:
+    """Gets the suffix of the grid class and the arguments decoding the
+    values of the array, if the grid keeps the packed values.
+    """
+    dtype = array.dtype.type
+    if dtype != np.float16 and scale_factor is None and \
+            add_offset is None and fill_value is None:
+        return None
+    if dtype == np.float16:
+        suffix = "Float16"
+        if fill_value is not None:
+            fill_value = int(np.float16(fill_value).view(np.uint16))
+    elif dtype == np.int16:
+        suffix = "Int16"
+    else:
+        raise ValueError("the packed values must be stored as int16 or "
+                         f"float16, not {array.dtype}")
+    return suffix, dict(scale_factor=1.0 if scale_factor is None else
+                        float(scale_factor),
+                        add_offset=0.0 if add_offset is None else
+                        float(add_offset),
+                        fill_value=fill_value)
+
+
 class Grid2D:
     """2D Cartesian Grid.
     """
     #: The number of grid dimensions handled by this object
     _DIMENSIONS = 2
 
-    def __init__(self, *args, increasing_axes: Optional[str] = None):
+    def __init__(self,
+                 *args,
+                 increasing_axes: Optional[str] = None,
+                 scale_factor: Optional[float] = None,
+                 add_offset: Optional[float] = None,
+                 fill_value: Optional[Union[int, float]] = None,
+                 tiled: bool = False):
         """
         Initialize a new 2D Cartesian Grid.
 
@@ -32,6 +64,30 @@ class Grid2D:
                 axes are decreasing, the axes and grid provided will be flipped
                 in place or copied before being flipped. By default, the
                 decreasing axes are not modified.
+            scale_factor (float, optional): Factor multiplying the packed
+                values.
+            add_offset (float, optional): Offset added to the packed values.
+            fill_value (int, float, optional): Packed value of the undefined
+                items.
+            tiled (bool, optional): If true, the values of a 2D grid are
+                copied into tiles of 16 x 16 values. Defaults to ``False``.
+
+        .. note::
+
+            If the array holds ``int16`` values and one of ``scale_factor``,
+            ``add_offset`` or ``fill_value`` is given, or if the array holds
+            ``float16`` values, the grid keeps the packed values and decodes
+            them when they are read (``packed * scale_factor + add_offset``),
+            according to the CF conventions. The grid then uses a quarter of
+            the memory of the decoded values.
+
+        .. note::
+
+            The values of a tiled grid that are close in space are also close
+            in memory: the bicubic interpolations and the LOESS filter read
+            fewer cache lines than with the row-major layout of the array.
+            The grid keeps its own copy of the values, and the coefficients of
+            the bicubic interpolation cannot be precomputed for it.
 
         Examples:
 
@@ -69,8 +125,20 @@ class Grid2D:
             if isinstance(item, core.TemporalAxis):
                 prefix = "Temporal"
                 break
-        _class = f"{prefix}Grid{self._DIMENSIONS}D" + \
-            interface._core_class_suffix(args[-1], handle_integer=True)
+        packing = _packing(args[-1], scale_factor, add_offset, fill_value)
+        if packing is not None and self._DIMENSIONS > 3:
+            raise ValueError("the packed values are not handled by the 4D "
+                             "grids")
+        if tiled:
+            if self._DIMENSIONS != 2:
+                raise ValueError("only the 2D grids can be tiled")
+            if packing is not None:
+                raise ValueError("a grid of packed values cannot be tiled")
+        _class = ("Tiled" if tiled else prefix) + \
+            f"Grid{self._DIMENSIONS}D" + \
+            (packing[0] if packing is not None else
+             interface._core_class_suffix(args[-1],
+                                          handle_integer=not tiled))
         if increasing_axes is not None:
             if increasing_axes not in ['inplace', 'copy']:
                 raise ValueError("increasing_axes "
@@ -84,7 +152,14 @@ class Grid2D:
                                core.TemporalAxis)) and not item.is_ascending():
                     args[idx] = item.flip(inplace=inplace)
                     args[-1] = np.flip(args[-1], axis=idx)
-        self._instance = getattr(core, _class)(*args)
+        if packing is not None:
+            array = args[-1]
+            if array.dtype == np.float16:
+                array = array.view(np.uint16)
+            self._instance = getattr(core, _class)(*args[:-1], array,
+                                                   **packing[1])
+        else:
+            self._instance = getattr(core, _class)(*args)
         self._prefix = prefix
 
     def __repr__(self):
@@ -95,7 +170,7 @@ class Grid2D:
                                       line in enumerate(s.split("\n"))])
         result = [
             f"<{self.__module__}.{self.__class__.__name__}>",
-            repr(self.array),
+            self._repr_values(),
         ]
         result.append("Axis:")
         for item in dir(self):
@@ -105,6 +180,52 @@ class Grid2D:
                 result.append(f" {prefix}{pad(repr(attr), len(prefix))}")
         return "\n".join(result)
 
+    def _repr_values(self) -> str:
+        """Returns the representation of the values of the grid."""
+        return repr(self.array)
+
+    def view(self, x: slice, y: slice, *args: slice) -> "Grid2D":
+        """Returns a view on a region of this grid.
+
+        The view shares the values of this grid and those of its irregular
+        axes: creating it does not copy them, whatever the slices. The view
+        can be interpolated as any other grid.
+
+        Args:
+            x (slice): Indexes of the X-Axis selected.
+            y (slice): Indexes of the Y-Axis selected.
+            *args (slice): Indexes of the Z-Axis selected, for a 3D grid.
+
+        Returns:
+            Grid2D: The grid of the region selected.
+
+        Raises:
+            TypeError: If the grid does not handle views: the packed, tiled,
+                chunked and 4D grids do not.
+            ValueError: If a slice is empty or does not select contiguous
+                indexes in ascending order.
+
+        Examples:
+
+            >>> import numpy as np
+            >>> import pyinterp
+            >>> x_axis = pyinterp.Axis(np.arange(-180.0, 180.0, 1.0),
+            ...                        is_circle=True)
+            >>> y_axis = pyinterp.Axis(np.arange(-80.0, 80.0, 1.0))
+            >>> array = np.zeros((len(x_axis), len(y_axis)))
+            >>> grid = pyinterp.Grid2D(x_axis, y_axis, array)
+            >>> region = grid.view(slice(170, 200), slice(60, 100))
+            >>> region.array.base is not None
+            True
+        """
+        if not hasattr(self._instance, "view"):
+            raise TypeError(
+                f"{self.__class__.__name__} does not handle the views")
+        result = self.__class__.__new__(self.__class__)
+        result._instance = self._instance.view(x, y, *args)
+        result._prefix = self._prefix
+        return result
+
     @property
     def x(self) -> core.Axis:
         """Gets the X-Axis handled by this instance.
@@ -128,9 +249,14 @@ class Grid2D:
         """Gets the values handled by this instance.
 
         Returns:
-            numpy.ndarray: values.
+            numpy.ndarray: values, packed if the grid decodes its values.
         """
-        return self._instance.array
+        array = self._instance.array
+        if isinstance(self._instance,
+                      (core.Grid2DFloat16, core.Grid3DFloat16,
+                       core.TemporalGrid3DFloat16)):
+            return array.view(np.float16)
+        return array
 
 
 class Grid3D(Grid2D):
@@ -138,7 +264,12 @@ class Grid3D(Grid2D):
     """
     _DIMENSIONS = 3
 
-    def __init__(self, *args, increasing_axes=None):
+    def __init__(self,
+                 *args,
+                 increasing_axes=None,
+                 scale_factor: Optional[float] = None,
+                 add_offset: Optional[float] = None,
+                 fill_value: Optional[Union[int, float]] = None):
         """
         Initialize a new 3D Cartesian Grid.
 
@@ -151,6 +282,16 @@ class Grid3D(Grid2D):
             increasing_axes (bool, optional): Ensure that the axes of the grid
                 are increasing. If this is not the case, the axes and grid
                 provided will be flipped. Default to False.
+            scale_factor (float, optional): Factor multiplying the packed
+                values.
+            add_offset (float, optional): Offset added to the packed values.
+            fill_value (int, float, optional): Packed value of the undefined
+                items.
+
+        .. note::
+
+            The values packed into ``int16`` or stored as ``float16`` are
+            decoded when they are read, see :py:class:`Grid2D`.
 
         .. note::
 
@@ -171,7 +312,11 @@ class Grid3D(Grid2D):
             >>> array = np.zeros((len(x_axis), len(y_axis), len(z_axis)))
             >>> grid = pyinterp.Grid3D(x_axis, y_axis, z_axis, array)
         """
-        super().__init__(*args, increasing_axes=increasing_axes)
+        super().__init__(*args,
+                         increasing_axes=increasing_axes,
+                         scale_factor=scale_factor,
+                         add_offset=add_offset,
+                         fill_value=fill_value)
 
     @property
     def z(self) -> Union[core.Axis, core.TemporalAxis]:
@@ -221,8 +366,157 @@ class Grid4D(Grid3D):
         return self._instance.u
 
 
-def _core_variate_interpolator(instance: object, interpolator: str, **kwargs):
-    """Obtain the interpolator from the string provided."""
+def _chunked_instance(dimensions: int, *args, dtype: Optional[np.dtype],
+                      cache_size: int):
+    """Creates the core instance of a chunked grid."""
+    prefix = "Temporal" if isinstance(args[2], core.TemporalAxis) else ""
+    dtype = np.dtype(dtype or "float64")
+    suffix = {"float64": "Float64", "float32": "Float32"}.get(dtype.name)
+    if suffix is None:
+        raise ValueError(f"dtype {dtype} not handled by the object")
+    return getattr(core, f"{prefix}ChunkedGrid{dimensions}D{suffix}")(
+        *args, cache_size), prefix
+
+
+class ChunkedGrid3D(Grid3D):
+    """3D Cartesian Grid whose values are read by chunks, on demand.
+
+    The values are not held in memory: the grid is split into chunks of fixed
+    shape, read by a user-supplied function when an interpolation needs them.
+    The chunks read are kept in a cache of limited size, shared by the threads
+    performing the interpolation. The grid can be interpolated by
+    :py:func:`pyinterp.trivariate` and :py:func:`pyinterp.bicubic`.
+    """
+    def __init__(self,
+                 x: core.Axis,
+                 y: core.Axis,
+                 z: Union[core.Axis, core.TemporalAxis],
+                 chunks: Tuple[int, int, int],
+                 reader: Callable[[Tuple[slice, ...]], np.ndarray],
+                 dtype: Optional[np.dtype] = None,
+                 cache_size: int = 64):
+        """
+        Initialize a new 3D Cartesian Grid read by chunks.
+
+        Args:
+            x (pyinterp.Axis): X-Axis.
+            y (pyinterp.Axis): Y-Axis.
+            z (pyinterp.Axis, pyinterp.TemporalAxis): Z-Axis.
+            chunks (tuple): Shape of the chunks. It should match the chunks of
+                the underlying storage.
+            reader (callable): Function called with a tuple of slices
+                selecting a chunk and returning the values of this chunk,
+                for example ``lambda key: dataset["var"][key]`` for an array
+                stored with Zarr or NetCDF.
+            dtype (numpy.dtype, optional): Data type of the values of the
+                grid, ``float64`` or ``float32``. Defaults to ``float64``.
+            cache_size (int, optional): Maximum number of chunks kept in
+                memory. Defaults to ``64``.
+
+        .. note::
+
+            The reader is called from the threads performing the
+            interpolation, one call at a time, with the GIL held.
+        """
+        self._instance, self._prefix = _chunked_instance(self._DIMENSIONS,
+                                                         x,
+                                                         y,
+                                                         z,
+                                                         chunks,
+                                                         reader,
+                                                         dtype=dtype,
+                                                         cache_size=cache_size)
+
+    def _repr_values(self) -> str:
+        """Returns the representation of the values of the grid."""
+        return f"chunks: {self.chunks}"
+
+    @property
+    def array(self) -> np.ndarray:
+        """The values of a chunked grid are not held in memory."""
+        raise AttributeError("the values of a chunked grid are read on demand")
+
+    @property
+    def chunks(self) -> Tuple[int, ...]:
+        """Gets the shape of the chunks.
+
+        Returns:
+            tuple: The shape of the chunks.
+        """
+        return tuple(self._instance.chunks)
+
+    @property
+    def cache_size(self) -> int:
+        """Gets the maximum number of chunks kept in memory.
+
+        Returns:
+            int: The maximum number of chunks kept in memory.
+        """
+        return self._instance.cache_size
+
+    def cached(self) -> int:
+        """Returns the number of chunks currently held in memory."""
+        return self._instance.cached()
+
+    def clear_cache(self) -> None:
+        """Releases the chunks held in memory."""
+        self._instance.clear_cache()
+
+
+class ChunkedGrid4D(ChunkedGrid3D, Grid4D):
+    """4D Cartesian Grid whose values are read by chunks, on demand.
+
+    The grid can be interpolated by :py:func:`pyinterp.quadrivariate` and
+    :py:func:`pyinterp.bicubic`.
+    """
+    _DIMENSIONS = 4
+
+    def __init__(self,
+                 x: core.Axis,
+                 y: core.Axis,
+                 z: Union[core.Axis, core.TemporalAxis],
+                 u: core.Axis,
+                 chunks: Tuple[int, int, int, int],
+                 reader: Callable[[Tuple[slice, ...]], np.ndarray],
+                 dtype: Optional[np.dtype] = None,
+                 cache_size: int = 64):
+        """
+        Initialize a new 4D Cartesian Grid read by chunks.
+
+        Args:
+            x (pyinterp.Axis): X-Axis.
+            y (pyinterp.Axis): Y-Axis.
+            z (pyinterp.Axis, pyinterp.TemporalAxis): Z-Axis.
+            u (pyinterp.Axis): U-Axis.
+            chunks (tuple): Shape of the chunks. It should match the chunks of
+                the underlying storage.
+            reader (callable): Function called with a tuple of slices
+                selecting a chunk and returning the values of this chunk.
+            dtype (numpy.dtype, optional): Data type of the values of the
+                grid, ``float64`` or ``float32``. Defaults to ``float64``.
+            cache_size (int, optional): Maximum number of chunks kept in
+                memory. Defaults to ``64``.
+        """
+        self._instance, self._prefix = _chunked_instance(self._DIMENSIONS,
+                                                         x,
+                                                         y,
+                                                         z,
+                                                         u,
+                                                         chunks,
+                                                         reader,
+                                                         dtype=dtype,
+                                                         cache_size=cache_size)
+
+
+def _core_variate_interpolator(instance: object,
+                               interpolator: str,
+                               suffix: str = "",
+                               **kwargs):
+    """Obtain the interpolator from the string provided.
+
+    The suffix selects the interpolators of another type of values, for
+    example ``Float32`` for the interpolators of float32 values.
+    """
     if isinstance(instance, Grid2D):
         dimensions = instance._DIMENSIONS
         # 4D interpolation uses the 3D interpolator
@@ -234,11 +528,12 @@ def _core_variate_interpolator(instance: object, interpolator: str, **kwargs):
     prefix = instance._prefix
 
     if interpolator == "bilinear":
-        return getattr(core, f"{prefix}Bilinear{dimensions}D")(**kwargs)
+        return getattr(core, f"{prefix}Bilinear{dimensions}D{suffix}")(**kwargs)
     if interpolator == "nearest":
-        return getattr(core, f"{prefix}Nearest{dimensions}D")(**kwargs)
+        return getattr(core, f"{prefix}Nearest{dimensions}D{suffix}")(**kwargs)
     if interpolator == "inverse_distance_weighting":
         return getattr(
-            core, f"{prefix}InverseDistanceWeighting{dimensions}D")(**kwargs)
+            core, f"{prefix}InverseDistanceWeighting{dimensions}D{suffix}")(
+                **kwargs)
 
     raise ValueError(f"interpolator {interpolator!r} is not defined")
@@ -40,7 +40,8 @@ class Histogram2D:
                  x: core.Axis,
                  y: core.Axis,
                  bin_counts: Optional[int] = None,
-                 dtype: Optional[np.dtype] = np.dtype("float64")):
+                 dtype: Optional[np.dtype] = np.dtype("float64"),
+                 sparse: bool = False):
         """Initializes the grid used to calculate the statistics.
 
         Args:
@@ -51,6 +52,11 @@ class Histogram2D:
             bin_counts (int, optional): The number of bins to use. If not set,
                 the number of bins is 100.
             dtype (numpy.dtype, optional): Data type of the instance to create.
+            sparse (bool, optional): If true, only the histograms holding
+                values are stored, which saves memory when most of the bins of
+                the grid stay empty, for example for a global grid of very
+                high resolution. The statistics are still returned as dense
+                arrays. Defaults to ``False``.
 
         .. note ::
 
@@ -66,9 +72,9 @@ class Histogram2D:
             step, 0.5 in this example.
         """
         if dtype == np.dtype("float64"):
-            self._instance = core.Histogram2DFloat64(x, y, bin_counts)
+            self._instance = core.Histogram2DFloat64(x, y, bin_counts, sparse)
         elif dtype == np.dtype("float32"):
-            self._instance = core.Histogram2DFloat32(x, y, bin_counts)
+            self._instance = core.Histogram2DFloat32(x, y, bin_counts, sparse)
         else:
             raise ValueError(f"dtype {dtype} not handled by the object")
         self.dtype = dtype
@@ -83,6 +89,11 @@ class Histogram2D:
         """Gets the bin centers for the Y Axis of the grid."""
         return self._instance.y
 
+    @property
+    def sparse(self) -> bool:
+        """True if only the histograms holding values are stored."""
+        return self._instance.sparse
+
     def clear(self) -> None:
         """Clears the data inside each bin."""
         self._instance.clear()
@@ -106,7 +117,11 @@ class Histogram2D:
         result._instance += other._instance  # type: ignore
         return result
 
-    def push(self, x: np.ndarray, y: np.ndarray, z: np.ndarray) -> None:
+    def push(self,
+             x: np.ndarray,
+             y: np.ndarray,
+             z: np.ndarray,
+             num_threads: int = 0) -> None:
         """Push new samples into the defined bins.
 
         Args:
@@ -114,11 +129,17 @@ class Histogram2D:
             y (numpy.ndarray): Y coordinates of the samples.
             z (numpy.ndarray): New samples to push into the
                 defined bins.
+            num_threads (int, optional): The number of threads to use for the
+                computation. The bins of the grid are shared out between the
+                threads, so the result does not depend on the number of
+                threads. If 0 all CPUs are used. If 1 is given, no parallel
+                computing code is used at all, which is useful for debugging.
+                Defaults to ``0``.
         """
         x = np.asarray(x).ravel()
         y = np.asarray(y).ravel()
         z = np.asarray(z).ravel()
-        self._instance.push(x, y, z)
+        self._instance.push(x, y, z, num_threads)
 
     def push_delayed(self, x: Union[np.ndarray, da.Array], y: Union[np.ndarray,
                                                                     da.Array],
@@ -144,9 +165,9 @@ class Histogram2D:
         y = da.asarray(y)
         z = da.asarray(z)
 
-        def _process_block(x, y, z, x_axis, y_axis, dtype):
-            hist2d = Histogram2D(x_axis, y_axis, dtype=dtype)
-            hist2d.push(x, y, z)
+        def _process_block(x, y, z, x_axis, y_axis, dtype, sparse):
+            hist2d = Histogram2D(x_axis, y_axis, dtype=dtype, sparse=sparse)
+            hist2d.push(x, y, z, num_threads=1)
             return np.array([hist2d], dtype="object")
 
         return da.map_blocks(_process_block,
@@ -156,6 +177,7 @@ class Histogram2D:
                              self.x,
                              self.y,
                              self.dtype,
+                             self.sparse,
                              dtype="object").sum()
 
     def variable(self, statistics: str = 'mean', *args) -> np.ndarray:
@@ -174,6 +196,12 @@ class Histogram2D:
                       each bin.
                     * ``min`` : compute the minimum of values for points within
                       each bin.
+                    * ``quantile`` : compute a quantile of values for points
+                      within each bin.
+                    * ``quantiles`` : compute several quantiles of values for
+                      points within each bin, in a single pass over each
+                      histogram. The result has a third dimension of the size
+                      of ``q``.
                     * ``skewness`` : compute the skewness of values for points
                     * ``variance`` : compute the variance within each bin.
             args (list): Additional arguments to pass to the statistics
@@ -62,7 +62,14 @@ def _core_function(function: str, instance: object) -> str:
          core.Grid3DFloat64, core.Grid3DFloat32, core.Grid4DFloat64,
          core.Grid4DFloat32, core.TemporalGrid3DFloat64,
          core.TemporalGrid3DFloat32, core.TemporalGrid4DFloat64,
-         core.TemporalGrid4DFloat32)):
+         core.TemporalGrid4DFloat32, core.ChunkedGrid3DFloat64,
+         core.ChunkedGrid3DFloat32, core.ChunkedGrid4DFloat64,
+         core.ChunkedGrid4DFloat32, core.TemporalChunkedGrid3DFloat64,
+         core.TemporalChunkedGrid3DFloat32, core.TemporalChunkedGrid4DFloat64,
+         core.TemporalChunkedGrid4DFloat32, core.Grid2DInt16,
+         core.Grid2DFloat16, core.Grid3DInt16, core.Grid3DFloat16,
+         core.TemporalGrid3DInt16, core.TemporalGrid3DFloat16,
+         core.TiledGrid2DFloat64, core.TiledGrid2DFloat32)):
         raise TypeError("instance is not an object handling a grid.")
     name = instance.__class__.__name__
     match = PATTERN(name)
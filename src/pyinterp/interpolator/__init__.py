@@ -1,4 +1,4 @@
-from .bicubic import bicubic
+from .bicubic import bicubic, precompute_bicubic
 from .bivariate import bivariate
 from .trivariate import trivariate
 from .quadrivariate import quadrivariate
@@ -6,7 +6,7 @@
 Bicubic interpolation
 =====================
 """
-from typing import Optional, Union
+from typing import Optional, Tuple, Union
 import numpy as np
 from .. import core
 from .. import grid
@@ -23,7 +23,12 @@ def bicubic(mesh: Union[grid.Grid2D, grid.Grid3D, grid.Grid4D],
             fitting_model: str = "c_spline",
             boundary: str = "undef",
             bounds_error: bool = False,
-            num_threads: int = 0) -> np.ndarray:
+            num_threads: int = 0,
+            out: Optional[Union[np.ndarray, Tuple[np.ndarray, np.ndarray,
+                                                  np.ndarray]]] = None,
+            fill_holes: Optional[Tuple[int, int]] = None,
+            derivatives: bool = False
+            ) -> Union[np.ndarray, Tuple[np.ndarray, np.ndarray, np.ndarray]]:
     """Bicubic gridded interpolator.
 
     Args:
@@ -71,8 +76,26 @@ def bicubic(mesh: Union[grid.Grid2D, grid.Grid3D, grid.Grid4D],
             computation. If 0 all CPUs are used. If 1 is given, no parallel
             computing code is used at all, which is useful for debugging.
             Defaults to ``0``.
+        out (numpy.ndarray, optional): C-contiguous array of type float64,
+            of the shape of ``x``, in which the interpolated values are
+            written instead of a new array. Defaults to ``None``.
+        fill_holes (tuple, optional): Half-windows ``(nx, ny)`` of the LOESS
+            filter estimating the undefined values read by the interpolation
+            of a :py:class:`2D Grid <pyinterp.grid.Grid2D>`, as
+            :py:func:`pyinterp.fill.loess` would fill them, without filling
+            the whole grid. Defaults to ``None``: the undefined values are
+            used as is.
+        derivatives (bool, optional): If True, the partial derivatives of
+            the function interpolated with respect to x and y are computed
+            with the values, for a :py:class:`2D Grid
+            <pyinterp.grid.Grid2D>`: the frame framing each point is loaded
+            and fitted once for the three results. ``out`` is then a tuple
+            of three arrays. Defaults to ``False``.
     Returns:
-        numpy.ndarray: Values interpolated.
+        numpy.ndarray: Values interpolated, i.e. ``out`` if provided. If
+        ``derivatives`` is set, a tuple ``(values, dx, dy)`` holding the
+        values interpolated and their partial derivatives with respect to x
+        and y.
     """
     if not mesh.x.is_ascending():
         raise ValueError('X-axis is not increasing')
@@ -87,6 +110,10 @@ def bicubic(mesh: Union[grid.Grid2D, grid.Grid3D, grid.Grid4D],
     if boundary not in ['expand', 'wrap', 'sym', 'undef']:
         raise ValueError(f"boundary {boundary!r} is not defined")
 
+    if derivatives:
+        return _bicubic_gradient(mesh, x, y, nx, ny, fitting_model, boundary,
+                                 bounds_error, num_threads, out, fill_holes)
+
     instance = mesh._instance
     function = interface._core_function(
         "bicubic" if fitting_model == "bicubic" else "spline", instance)
@@ -106,4 +133,112 @@ def bicubic(mesh: Union[grid.Grid2D, grid.Grid3D, grid.Grid4D],
         if u is None:
             raise ValueError("You must specify the U-values for a 4D grid.")
         args.insert(4, np.asarray(u))
-    return getattr(core, function)(*args)
+    if fill_holes is not None:
+        if isinstance(mesh, (grid.Grid3D, grid.Grid4D)):
+            raise ValueError("fill_holes is only supported by 2D grids.")
+        return getattr(core, function)(*args,
+                                       out=out,
+                                       fill_holes=tuple(fill_holes))
+    return getattr(core, function)(*args, out=out)
+
+
+def _bicubic_gradient(
+    mesh: grid.Grid2D, x: np.ndarray, y: np.ndarray, nx: Optional[int],
+    ny: Optional[int], fitting_model: str, boundary: str, bounds_error: bool,
+    num_threads: int, out: Optional[Tuple[np.ndarray, np.ndarray,
+                                          np.ndarray]],
+    fill_holes: Optional[Tuple[int, int]]
+) -> Tuple[np.ndarray, np.ndarray, np.ndarray]:
+    """Bicubic interpolation of a 2D grid, computing the partial derivatives
+    of the function interpolated."""
+    if isinstance(mesh, (grid.Grid3D, grid.Grid4D)):
+        raise ValueError("the derivatives are only computed for 2D grids.")
+    out, out_dx, out_dy = (None, None, None) if out is None else out
+    instance = mesh._instance
+    function = interface._core_function(
+        "bicubic_gradient"
+        if fitting_model == "bicubic" else "spline_gradient", instance)
+    return getattr(core, function)(
+        instance,
+        np.asarray(x),
+        np.asarray(y),
+        nx,
+        ny,
+        fitting_model,
+        boundary,
+        bounds_error,
+        num_threads,
+        out=out,
+        out_dx=out_dx,
+        out_dy=out_dy,
+        fill_holes=None if fill_holes is None else tuple(fill_holes))
+
+
+def precompute_bicubic(mesh: Union[grid.Grid2D, grid.Grid3D],
+                       nx: Optional[int] = 3,
+                       ny: Optional[int] = 3,
+                       fitting_model: str = "c_spline",
+                       boundary: str = "undef",
+                       num_threads: int = 0) -> None:
+    """Precomputes the coefficients of the bicubic interpolation of a grid.
+
+    The coefficients of the polynomial interpolating each cell of the grid are
+    computed once and kept by the grid. The following calls to
+    :py:func:`bicubic` performed on this grid with the same parameters only
+    evaluate the polynomial of the cell containing each point, which is much
+    faster when the grid is queried many times. The memory used is 128 bytes
+    per grid point and per layer.
+
+    Args:
+        mesh (pyinterp.grid.Grid2D, pyinterp.grid.Grid3D): Function on a
+            uniform grid to be interpolated.
+        nx (int, optional): The number of X-coordinate values required to
+            perform the interpolation. Defaults to ``3``.
+        ny (int, optional): The number of Y-coordinate values required to
+            perform the interpolation. Defaults to ``3``.
+        fitting_model (str, optional): Type of interpolation to be performed.
+            Supported are ``linear``, ``bicubic``, ``c_spline`` and
+            ``c_spline_periodic``. Default to ``c_spline``.
+        boundary (str, optional): A flag indicating how to handle boundaries of
+            the frame. Default ``undef``.
+        num_threads (int, optional): The number of threads to use for the
+            computation. If 0 all CPUs are used. If 1 is given, no parallel
+            computing code is used at all, which is useful for debugging.
+            Defaults to ``0``.
+
+    .. note::
+
+        The coefficients must be computed again if the values of the grid are
+        modified.
+    """
+    if fitting_model not in [
+            'bicubic', 'c_spline_periodic', 'c_spline', 'linear'
+    ]:
+        raise ValueError(
+            f"the coefficients of the fitting model {fitting_model!r} cannot "
+            "be precomputed")
+    if boundary not in ['expand', 'wrap', 'sym', 'undef']:
+        raise ValueError(f"boundary {boundary!r} is not defined")
+    if isinstance(mesh, grid.Grid4D):
+        raise ValueError("the coefficients cannot be precomputed for a 4D "
+                         "grid")
+    if isinstance(mesh, grid.ChunkedGrid3D):
+        raise ValueError("the coefficients cannot be precomputed for a "
+                         "chunked grid")
+
+    instance = mesh._instance
+    if isinstance(instance,
+                  (core.Grid2DInt16, core.Grid2DFloat16, core.Grid3DInt16,
+                   core.Grid3DFloat16, core.TemporalGrid3DInt16,
+                   core.TemporalGrid3DFloat16)):
+        raise ValueError("the coefficients cannot be precomputed for a grid "
+                         "of packed values")
+    if isinstance(instance,
+                  (core.TiledGrid2DFloat64, core.TiledGrid2DFloat32)):
+        raise ValueError("the coefficients cannot be precomputed for a tiled "
+                         "grid")
+    function = interface._core_function(
+        "precompute_bicubic"
+        if fitting_model == "bicubic" else "precompute_spline", instance)
+    getattr(core, function)(instance, nx, ny, fitting_model, boundary,
+                            num_threads)
@@ -6,6 +6,7 @@
 Bivariate interpolation
 =======================
 """
+from typing import Optional, Tuple, Union
 import numpy as np
 from .. import core
 from .. import grid
@@ -18,7 +19,12 @@ def bivariate(grid2d: grid.Grid2D,
               interpolator: str = "bilinear",
               bounds_error: bool = False,
               num_threads: int = 0,
-              **kwargs) -> np.ndarray:
+              out: Optional[np.ndarray] = None,
+              fill_holes: Optional[Tuple[int, int]] = None,
+              single_precision: bool = False,
+              derivatives: bool = False,
+              **kwargs
+              ) -> Union[np.ndarray, Tuple[np.ndarray, np.ndarray, np.ndarray]]:
     """Interpolate the values provided on the defined bivariate function.
 
     Args:
@@ -39,12 +45,164 @@ def bivariate(grid2d: grid.Grid2D,
             Defaults to ``0``.
         p (int, optional): The power to be used by the interpolator
             inverse_distance_weighting. Default to ``2``.
+        out (numpy.ndarray, optional): C-contiguous array of type float64,
+            of the shape of ``x``, in which the interpolated values are
+            written instead of a new array. Defaults to ``None``.
+        fill_holes (tuple, optional): Half-windows ``(nx, ny)`` of the LOESS
+            filter estimating the undefined values read by the interpolation,
+            as :py:func:`pyinterp.fill.loess` would fill them, without
+            filling the whole grid. Defaults to ``None``: the undefined values
+            are used as is.
+        single_precision (bool, optional): If True, the values of a float32
+            grid are interpolated at float32 coordinates in single
+            precision, and the values interpolated are returned as float32.
+            The error of the interpolation is then bounded by the machine
+            epsilon of float32, see :py:func:`pyinterp.core.bivariate_float32`.
+            Defaults to ``False``.
+        derivatives (bool, optional): If True, the partial derivatives of
+            the bilinear interpolation with respect to x and y are computed
+            with the values, in the same pass. Only the ``bilinear``
+            interpolator is supported, and ``out`` is then a tuple of three
+            float64 arrays. Defaults to ``False``.
     Returns:
-        numpy.ndarray: Values interpolated.
+        numpy.ndarray: Values interpolated, i.e. ``out`` if provided. If
+        ``derivatives`` is set, a tuple ``(values, dx, dy)`` holding the
+        values interpolated and their partial derivatives with respect to x
+        and y.
     """
+    x = np.asarray(x)
+    y = np.asarray(y)
     instance = grid2d._instance
+    if derivatives:
+        if interpolator != "bilinear" or single_precision:
+            raise ValueError("the derivatives are only computed by the "
+                             "bilinear interpolation in double precision")
+        out, out_dx, out_dy = (None, None, None) if out is None else out
+        function = interface._core_function("bilinear_gradient", instance)
+        return getattr(core, function)(instance, x, y, bounds_error,
+                                       num_threads, out, out_dx, out_dy,
+                                       fill_holes)
     function = interface._core_function("bivariate", instance)
-    return getattr(core, function)(instance, np.asarray(x), np.asarray(y),
+    suffix = ""
+    if single_precision:
+        if (function != "bivariate_float32" or x.dtype != np.float32
+                or y.dtype != np.float32):
+            raise ValueError("the single precision interpolation requires a "
+                             "float32 grid and float32 coordinates")
+        suffix = "Float32"
+    return getattr(core, function)(instance, x, y,
                                    grid._core_variate_interpolator(
-                                       grid2d, interpolator, **kwargs),
-                                   bounds_error, num_threads)
+                                       grid2d, interpolator, suffix, **kwargs),
+                                   bounds_error, num_threads, out, fill_holes)
+
+
+def prepare_bivariate(grid2d: grid.Grid2D,
+                      interpolator: str = "bilinear",
+                      bounds_error: bool = False,
+                      num_threads: int = 0,
+                      fill_holes: Optional[Tuple[int, int]] = None,
+                      single_precision: bool = False,
+                      **kwargs) -> core.PreparedBivariate:
+    """Prepare the bivariate interpolation of a grid.
+
+    The function of the library handling the grid and the interpolator are
+    resolved once, when the interpolation is prepared. Calling the object
+    returned interpolates a set of points with a single call to the library,
+    which removes the overhead of :py:func:`bivariate` for the small
+    queries.
+
+    Args:
+        grid2d (pyinterp.grid.Grid2D): Function on a uniform 2-dimensional
+            grid to be interpolated.
+        interpolator (str, optional): The method of interpolation to
+            perform. Supported are ``bilinear``, ``nearest``, and
+            ``inverse_distance_weighting``. Default to ``bilinear``.
+        bounds_error (bool, optional): If True, when interpolated values
+            are requested outside of the domain of the input axes (x,y), a
+            :py:class:`ValueError` is raised. If False, then the value is set
+            to NaN. Default to ``False``.
+        num_threads (int, optional): The number of threads to use for the
+            computation. If 0 all CPUs are used. If 1 is given, no parallel
+            computing code is used at all, which is useful for debugging.
+            Defaults to ``0``.
+        p (int, optional): The power to be used by the interpolator
+            inverse_distance_weighting. Default to ``2``.
+        fill_holes (tuple, optional): Half-windows ``(nx, ny)`` of the LOESS
+            filter estimating the undefined values read by the interpolation.
+            Defaults to ``None``.
+        single_precision (bool, optional): If True, the values of a float32
+            grid are interpolated in single precision, see
+            :py:func:`bivariate`. Defaults to ``False``.
+    Returns:
+        pyinterp.core.PreparedBivariate: The interpolation prepared, called
+        with the coordinates ``(x, y)`` of the points, and optionally the
+        array ``out`` receiving the interpolated values.
+
+    .. code-block:: python
+
+        interpolate = pyinterp.prepare_bivariate(grid)
+        for lon, lat in queries:
+            values = interpolate(lon, lat)
+    """
+    instance = grid2d._instance
+    suffix = ""
+    if single_precision:
+        if interface._core_function("bivariate",
+                                    instance) != "bivariate_float32":
+            raise ValueError("the single precision interpolation requires a "
+                             "float32 grid")
+        suffix = "Float32"
+    return core.PreparedBivariate(
+        instance,
+        grid._core_variate_interpolator(grid2d, interpolator, suffix,
+                                        **kwargs), bounds_error, num_threads,
+        fill_holes)
+
+
+def bivariate_plan(grid2d: grid.Grid2D,
+                   x: np.ndarray,
+                   y: np.ndarray,
+                   interpolator: str = "bilinear",
+                   bounds_error: bool = False,
+                   num_threads: int = 0,
+                   **kwargs) -> core.InterpolationPlan:
+    """Compute the plan of the bivariate interpolation of points.
+
+    The plan stores, for each point, the indexes of the grid values used by
+    the interpolation and their weights. It can then be applied to the values
+    of any grid defined on the same axes as ``grid2d``, for example the
+    successive time steps of a model, without searching the cells framing the
+    points again.
+
+    Args:
+        grid2d (pyinterp.grid.Grid2D): Grid defining the axes of the grids
+            to be interpolated.
+        x (numpy.ndarray): X-values.
+        y (numpy.ndarray): Y-values.
+        interpolator (str, optional): The method of interpolation to
+            perform. Supported are ``bilinear``, ``nearest``, and
+            ``inverse_distance_weighting``. Default to ``bilinear``.
+        bounds_error (bool, optional): If True, when interpolated values
+            are requested outside of the domain of the input axes (x,y), a
+            :py:class:`ValueError` is raised. If False, then the value is set
+            to NaN. Default to ``False``.
+        num_threads (int, optional): The number of threads to use for the
+            computation. If 0 all CPUs are used. If 1 is given, no parallel
+            computing code is used at all, which is useful for debugging.
+            Defaults to ``0``.
+        p (int, optional): The power to be used by the interpolator
+            inverse_distance_weighting. Default to ``2``.
+    Returns:
+        pyinterp.core.InterpolationPlan: The interpolation plan, whose method
+        ``apply`` interpolates the values of a grid.
+
+    .. code-block:: python
+
+        plan = pyinterp.bivariate_plan(grid, lon, lat)
+        for item in steps:
+            values = plan.apply(item)
+    """
+    return core.bivariate_plan(
+        grid2d.x, grid2d.y, np.asarray(x), np.asarray(y),
+        grid._core_variate_interpolator(grid2d, interpolator, **kwargs),
+        bounds_error, num_threads)
@@ -6,6 +6,7 @@
 Quadrivariate interpolation
 ===========================
 """
+from typing import Optional
 import numpy as np
 from .. import core
 from .. import grid
@@ -22,6 +23,7 @@ def quadrivariate(grid4d: grid.Grid4D,
                   u_method: str = "linear",
                   bounds_error: bool = False,
                   num_threads: int = 0,
+                  out: Optional[np.ndarray] = None,
                   **kwargs) -> np.ndarray:
     """Interpolate the values provided on the defined quadrivariate function.
 
@@ -52,8 +54,11 @@ def quadrivariate(grid4d: grid.Grid4D,
             Defaults to ``0``.
         p (int, optional): The power to be used by the interpolator
             inverse_distance_weighting. Default to ``2``.
+        out (numpy.ndarray, optional): C-contiguous array of type float64,
+            of the shape of ``x``, in which the interpolated values are
+            written instead of a new array. Defaults to ``None``.
     Returns:
-        numpy.ndarray: Values interpolated.
+        numpy.ndarray: Values interpolated, i.e. ``out`` if provided.
     """
     instance = grid4d._instance
     function = interface._core_function("quadrivariate", instance)
@@ -67,4 +72,5 @@ def quadrivariate(grid4d: grid.Grid4D,
                                    z_method=z_method,
                                    u_method=u_method,
                                    bounds_error=bounds_error,
-                                   num_threads=num_threads)
+                                   num_threads=num_threads,
+                                   out=out)
@@ -0,0 +1,65 @@
+# Copyright (c) 2022 CNES
+#
+# All rights reserved. Use of this source code is governed by a
+# BSD-style license that can be found in the LICENSE file.
+"""
+Regridding
+==========
+"""
+from typing import Optional
+import numpy as np
+from .. import core
+from .. import geodetic
+from .. import grid
+
+
+def regridding_plan(source: grid.Grid2D,
+                    target_x: core.Axis,
+                    target_y: core.Axis,
+                    method: str = "bilinear",
+                    wgs: Optional[geodetic.System] = None,
+                    num_threads: int = 0) -> core.InterpolationPlan:
+    """Compute the sparse matrix regridding the values of a grid onto other
+    axes.
+
+    The plan can be applied to the values of any grid defined on the same
+    axes as ``source``: ``plan.apply(array).reshape(len(target_x),
+    len(target_y))`` returns the regridded values. Its CSR representation is
+    exposed by the properties ``indptr``, ``indices`` and ``weights``.
+
+    Args:
+        source (pyinterp.grid.Grid2D): Grid defining the source axes.
+        target_x (pyinterp.Axis): X-Axis of the target grid.
+        target_y (pyinterp.Axis): Y-Axis of the target grid.
+        method (str, optional): The regridding method. Supported are
+            ``bilinear``, which interpolates the source grid at the nodes of
+            the target grid, and ``conservative``, which computes the mean of
+            the source cells intersecting each target cell, weighted by the
+            areas of the intersections. Default to ``bilinear``.
+        wgs (pyinterp.geodetic.System, optional): Geodetic system used to
+            compute the areas of the cells of geographic grids with the
+            ``conservative`` method. If None, the areas are computed in the
+            Cartesian plane. Defaults to ``None``.
+        num_threads (int, optional): The number of threads to use for the
+            computation. If 0 all CPUs are used. If 1 is given, no parallel
+            computing code is used at all, which is useful for debugging.
+            Defaults to ``0``.
+    Returns:
+        pyinterp.core.InterpolationPlan: The regridding plan.
+    """
+    if method == "bilinear":
+        x, y = np.meshgrid(target_x[:], target_y[:], indexing="ij")
+        return core.bivariate_plan(source.x,
+                                   source.y,
+                                   x.ravel(),
+                                   y.ravel(),
+                                   core.Bilinear2D(),
+                                   num_threads=num_threads)
+    if method == "conservative":
+        return core.conservative_plan(source.x,
+                                      source.y,
+                                      target_x,
+                                      target_y,
+                                      wgs=wgs,
+                                      num_threads=num_threads)
+    raise ValueError(f"method {method!r} is not defined")
@@ -6,13 +6,14 @@
 Trivariate interpolation
 ========================
 """
+from typing import Optional, Sequence, Union
 import numpy as np
 from .. import core
 from .. import grid
 from .. import interface
 
 
-def trivariate(grid3d: grid.Grid3D,
+def trivariate(grid3d: Union[grid.Grid3D, Sequence[grid.Grid3D]],
                x: np.ndarray,
                y: np.ndarray,
                z: np.ndarray,
@@ -20,12 +21,15 @@ def trivariate(grid3d: grid.Grid3D,
                z_method: str = "linear",
                bounds_error: bool = False,
                num_threads: int = 0,
+               out: Optional[np.ndarray] = None,
                **kwargs) -> np.ndarray:
     """Interpolate the values provided on the defined trivariate function.
 
     Args:
         grid3d (pyinterp.grid.Grid3D): Function on a uniform 3-dimensional
-            grid to be interpolated.
+            grid to be interpolated, or a sequence of such grids defined on
+            the same axes. The cells framing the points are then searched
+            once for all the grids.
         x (numpy.ndarray): X-values.
         y (numpy.ndarray): Y-values.
         z (numpy.ndarray): Z-values.
@@ -46,11 +50,24 @@ def trivariate(grid3d: grid.Grid3D,
             Defaults to ``0``.
         p (int, optional): The power to be used by the interpolator
             inverse_distance_weighting. Default to ``2``.
+        out (numpy.ndarray, optional): C-contiguous array of type float64,
+            of the shape of ``x``, or ``(len(grid3d), x.size)`` if several
+            grids are interpolated, in which the interpolated values are
+            written instead of a new array. Defaults to ``None``.
     Returns:
-        numpy.ndarray: Values interpolated.
+        numpy.ndarray: Values interpolated, i.e. ``out`` if provided. If
+        several grids are interpolated, the array holds one row per grid.
     """
-    instance = grid3d._instance
-    function = interface._core_function("trivariate", instance)
+    if isinstance(grid3d, grid.Grid3D):
+        instance = grid3d._instance
+        function = interface._core_function("trivariate", instance)
+    else:
+        grids = list(grid3d)
+        if not grids:
+            raise ValueError("grid3d must not be empty")
+        instance = [item._instance for item in grids]
+        function = interface._core_function("trivariate", instance[0])
+        grid3d = grids[0]
     return getattr(core, function)(instance,
                                    np.asarray(x),
                                    np.asarray(y),
@@ -59,4 +76,5 @@ def trivariate(grid3d: grid.Grid3D,
                                        grid3d, interpolator, **kwargs),
                                    z_method=z_method,
                                    bounds_error=bounds_error,
-                                   num_threads=num_threads)
+                                   num_threads=num_threads,
+                                   out=out)
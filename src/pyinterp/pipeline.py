@@ -0,0 +1,87 @@
+# Copyright (c) 2022 CNES
+#
+# All rights reserved. Use of this source code is governed by a
+# BSD-style license that can be found in the LICENSE file.
+"""
+Statistics pipeline
+-------------------
+"""
+from typing import Iterable, Iterator, Tuple
+import numpy as np
+from . import core
+from .binning import Binning2D, Binning3D
+from .histogram2d import Histogram2D
+
+#: Chunk of samples: the X and Y coordinates and the values of the samples.
+Chunk = Tuple[np.ndarray, np.ndarray, np.ndarray]
+
+
+class Pipeline:
+    """
+    Feeds the samples of a sequence of chunks, for example read from a Zarr
+    store, into several binned statistics and histograms.
+
+    While a chunk is ingested, without the GIL, the next one is read from
+    the iterator and converted. All the statistics are updated concurrently
+    from the same chunk.
+    """
+    def __init__(self,
+                 binning: Iterable[Binning2D] = (),
+                 histograms: Iterable[Histogram2D] = (),
+                 simple: bool = True,
+                 num_threads: int = 0):
+        """
+        Initializes the pipeline.
+
+        Args:
+            binning (iterable, optional): Binned statistics updated by the
+                pipeline.
+            histograms (iterable, optional): Histograms updated by the
+                pipeline.
+            simple (bool, optional): If true, a simple binning is used by the
+                binned statistics, otherwise a linear binning. Defaults to
+                ``True``.
+            num_threads (int, optional): The number of threads to use for the
+                computation, shared between the statistics. If 0 all CPUs are
+                used. If 1 is given, no parallel computing code is used at
+                all, which is useful for debugging. Defaults to ``0``.
+        """
+        binning = list(binning)
+        histograms = list(histograms)
+        if any(isinstance(item, Binning3D) for item in binning):
+            raise TypeError("a pipeline cannot update a Binning3D")
+        if any(item.statistics != "full" for item in binning):
+            raise TypeError("a pipeline only updates the Binning2D "
+                            "calculating all the statistics")
+        dtypes = set(item.dtype for item in binning + histograms)
+        if len(dtypes) > 1:
+            raise ValueError("dtype mismatch")
+        dtype = dtypes.pop() if dtypes else np.dtype("float64")
+        if dtype == np.dtype("float64"):
+            instance = core.PipelineFloat64
+        elif dtype == np.dtype("float32"):
+            instance = core.PipelineFloat32
+        else:
+            raise ValueError(f"dtype {dtype} not handled by the object")
+        self._instance = instance([item._instance for item in binning],
+                                  [item._instance for item in histograms],
+                                  simple, num_threads)
+        self.dtype = dtype
+
+    def __len__(self) -> int:
+        """Gets the number of statistics updated by the pipeline."""
+        return len(self._instance)
+
+    def run(self, chunks: Iterable[Chunk]) -> None:
+        """Ingests all the chunks of samples.
+
+        Args:
+            chunks (iterable): Chunks of samples: tuples of the X and Y
+                coordinates and the values of the samples.
+        """
+        def flatten(chunks: Iterable[Chunk]) -> Iterator[Chunk]:
+            for x, y, z in chunks:
+                yield (np.asarray(x).ravel(), np.asarray(y).ravel(),
+                       np.asarray(z).ravel())
+
+        self._instance.run(flatten(chunks))
@@ -6,10 +6,14 @@
 RTree spatial index
 -------------------
 """
-from typing import Optional, Tuple
+from typing import Callable, Iterable, List, Optional, Tuple
+import concurrent.futures
+import os
+import struct
 import numpy as np
 from . import core
 from . import geodetic
+from .asynchronous import submit
 
 
 class RTree:
@@ -18,7 +22,8 @@ class RTree:
     def __init__(self,
                  system: Optional[geodetic.System] = None,
                  dtype: Optional[np.dtype] = None,
-                 ndims: int = 3):
+                 ndims: int = 3,
+                 ecef_dtype: Optional[np.dtype] = None):
         """
         Initialize a new R*Tree.
 
@@ -32,17 +37,27 @@ class RTree:
             ndims (int, optional): The number of dimensions of the tree. This
                 dimension must be at least equal to 3 to store the ECEF
                 coordinates of the points. Default to ``3``.
+            ecef_dtype (numpy.dtype, optional): Data type of the ECEF
+                coordinates stored in the tree. Storing ``float32``
+                coordinates with ``float64`` values reduces the memory used
+                by the index, the positions being rounded to about half a
+                meter. Defaults to ``dtype``.
         """
-        dtype = dtype or np.dtype("float64")
+        dtype = np.dtype(dtype or "float64")
+        ecef_dtype = np.dtype(ecef_dtype or dtype)
         if ndims < 3:
             raise ValueError("ndims must be >= 3")
-        if dtype == np.dtype("float64"):
-            self._instance = getattr(core, f"RTree{ndims}DFloat64")(system)
-        elif dtype == np.dtype("float32"):
-            self._instance = getattr(core, f"RTree{ndims}DFloat32")(system)
-        else:
-            raise ValueError(f"dtype {dtype} not handled by the object")
+        suffix = {
+            ("float64", "float64"): "Float64",
+            ("float32", "float32"): "Float32",
+            ("float32", "float64"): "Float32Float64",
+        }.get((ecef_dtype.name, dtype.name))
+        if suffix is None:
+            raise ValueError(f"dtype {dtype} with ecef_dtype {ecef_dtype} "
+                             "not handled by the object")
+        self._instance = getattr(core, f"RTree{ndims}D{suffix}")(system)
         self.dtype = dtype
+        self.ecef_dtype = ecef_dtype
 
     def bounds(
             self
@@ -70,7 +85,10 @@ class RTree:
         """Returns true if the tree is not empty."""
         return self._instance.__bool__()
 
-    def packing(self, coordinates: np.ndarray, values: np.ndarray) -> None:
+    def packing(self,
+                coordinates: np.ndarray,
+                values: np.ndarray,
+                num_threads: Optional[int] = 0) -> None:
         """The tree is created using packing algorithm (The old data is erased
         before construction.)
 
@@ -84,10 +102,24 @@ class RTree:
                 and equal to zero.
             values (numpy.ndarray): An array of size ``(n)`` containing the
                 values associated with the coordinates provided.
+            num_threads (int, optional): The number of threads to use for the
+                computation. If 0 all CPUs are used. If 1 is given, no parallel
+                computing code is used at all, which is useful for debugging.
+                Defaults to ``0``.
+
+        .. note::
+
+            The packed points are stored in a static index, faster to query
+            than the tree built by :py:meth:`insert`. The points inserted or
+            removed afterwards are buffered and merged into the queries, until
+            they are numerous enough to repack the whole index.
         """
-        self._instance.packing(coordinates, values)
+        self._instance.packing(coordinates, values, num_threads)
 
-    def insert(self, coordinates: np.ndarray, values: np.ndarray) -> None:
+    def insert(self,
+               coordinates: np.ndarray,
+               values: np.ndarray,
+               num_threads: Optional[int] = 0) -> None:
         """Insert new data into the search tree.
 
         Args:
@@ -100,14 +132,40 @@ class RTree:
                 and equal to zero.
             values (numpy.ndarray): An array of size ``(n)`` containing the
                 values associated with the coordinates provided.
+            num_threads (int, optional): The number of threads to use for the
+                computation. If 0 all CPUs are used. If 1 is given, no parallel
+                computing code is used at all, which is useful for debugging.
+                Defaults to ``0``.
+        """
+        self._instance.insert(coordinates, values, num_threads)
+
+    def remove(self,
+               predicate: Callable[[np.ndarray, np.ndarray], np.ndarray],
+               num_threads: Optional[int] = 0) -> int:
+        """Removes the values selected by a predicate.
+
+        Args:
+            predicate (callable): Function called with a matrix
+                ``(n, ndims)`` containing the coordinates of the values stored
+                (longitudes, latitudes, altitudes and other coordinates) and a
+                vector ``(n)`` containing the values, returning a boolean
+                vector ``(n)`` flagging the values to remove.
+            num_threads (int, optional): The number of threads to use for the
+                computation. If 0 all CPUs are used. If 1 is given, no parallel
+                computing code is used at all, which is useful for debugging.
+                Defaults to ``0``.
+        Returns:
+            int: The number of values removed.
         """
-        self._instance.insert(coordinates, values)
+        return self._instance.remove(predicate, num_threads)
 
     def query(self,
               coordinates: np.ndarray,
               k: Optional[int] = 4,
               within: Optional[bool] = True,
-              num_threads: Optional[int] = 0) -> Tuple[np.ndarray, np.ndarray]:
+              num_threads: Optional[int] = 0,
+              out: Optional[Tuple[np.ndarray, np.ndarray]] = None,
+              eps: float = 0) -> Tuple[np.ndarray, np.ndarray]:
         """Search for the nearest K nearest neighbors of a given point.
 
         Args:
@@ -127,13 +185,39 @@ class RTree:
                 computation. If 0 all CPUs are used. If 1 is given, no parallel
                 computing code is used at all, which is useful for debugging.
                 Defaults to ``0``.
+            out (tuple, optional): Pair of C-contiguous matrices of shape
+                ``(n, k)``, of the types of the matrices returned, in which the
+                distances and the values of the neighbors are written instead
+                of new matrices. Defaults to ``None``.
+            eps (float, optional): Tolerance of an approximate search of
+                the neighbors. The parts of the index that cannot contain a
+                point closer than the worst neighbor found divided by
+                ``1 + eps`` are not explored: the i-th neighbor returned is at
+                most ``1 + eps`` times farther than the true i-th nearest
+                neighbor, which is faster for large values of ``k``. Defaults
+                to ``0``: the search is exact.
         Returns:
             tuple: A tuple containing a matrix describing for each provided
             position, the distance, in meters, between the provided position
             and the found neighbors and a matrix containing the value of the
-            different neighbors found for all provided positions.
+            different neighbors found for all provided positions, i.e.
+            ``out`` if provided.
         """
-        return self._instance.query(coordinates, k, within, num_threads)
+        return self._instance.query(coordinates, k, within, num_threads, out,
+                                    eps)
+
+    def query_async(self,
+                    *args,
+                    executor: Optional[concurrent.futures.Executor] = None,
+                    **kwargs) -> concurrent.futures.Future:
+        """Calls :py:meth:`query` in the background (see
+        :py:func:`pyinterp.asynchronous.submit`).
+
+        Returns:
+            concurrent.futures.Future: The future completing with the
+            distances and the values of the neighbors.
+        """
+        return submit(self.query, *args, executor=executor, **kwargs)
 
     def inverse_distance_weighting(
             self,
@@ -142,7 +226,9 @@ class RTree:
             k: Optional[int] = 9,
             p: Optional[int] = 2,
             within: Optional[bool] = True,
-            num_threads: Optional[int] = 0) -> Tuple[np.ndarray, np.ndarray]:
+            num_threads: Optional[int] = 0,
+            out: Optional[Tuple[np.ndarray, np.ndarray]] = None,
+            eps: float = 0) -> Tuple[np.ndarray, np.ndarray]:
         """Interpolation of the value at the requested position by inverse
         distance weighting method.
 
@@ -167,12 +253,23 @@ class RTree:
                 computation. If 0 all CPUs are used. If 1 is given, no parallel
                 computing code is used at all, which is useful for debugging.
                 Defaults to ``0``.
+            out (tuple, optional): Pair of C-contiguous vectors of shape
+                ``(n, )``, of the types of the vectors returned, in which the
+                interpolated values and the number of neighbors used are
+                written instead of new vectors. Defaults to ``None``.
+            eps (float, optional): Tolerance of an approximate search of
+                the neighbors. The parts of the index that cannot contain a
+                point closer than the worst neighbor found divided by
+                ``1 + eps`` are not explored: the i-th neighbor returned is at
+                most ``1 + eps`` times farther than the true i-th nearest
+                neighbor, which is faster for large values of ``k``. Defaults
+                to ``0``: the search is exact.
         Returns:
             tuple: The interpolated value and the number of neighbors used in
-            the calculation.
+            the calculation, i.e. ``out`` if provided.
         """
         return self._instance.inverse_distance_weighting(
-            coordinates, radius, k, p, within, num_threads)
+            coordinates, radius, k, p, within, num_threads, out, eps)
 
     def radial_basis_function(
             self,
@@ -245,6 +342,151 @@ class RTree:
             coordinates, radius, k, getattr(core.RadialBasisFunction, rbf),
             epsilon, smooth, within, num_threads)
 
+    def kriging(
+        self,
+        coordinates: np.ndarray,
+        radius: Optional[float] = None,
+        k: Optional[int] = 9,
+        covariance: Optional[str] = None,
+        sigma: Optional[float] = 1,
+        lambda_: Optional[float] = 1,
+        nugget: Optional[float] = 0,
+        within: Optional[bool] = True,
+        num_threads: Optional[int] = 0
+    ) -> Tuple[np.ndarray, np.ndarray, np.ndarray]:
+        """Estimation of the value at the requested position by ordinary
+        kriging.
+
+        The value is estimated by the linear combination of the values of the
+        nearest neighbors minimizing the variance of the estimation error,
+        under the constraint that the weights sum to one. The kriging system
+        of a set of neighbors is factorized once, and reused by the
+        consecutive positions selecting the same neighbors.
+
+        Args:
+            coordinates (numpy.ndarray): a matrix ``(n, ndims)`` where ``n`` is
+                the number of observations and ``ndims`` is the number of
+                coordinates in order: longitude and latitude in degrees,
+                altitude in meters and then the other coordinates defined in
+                Euclidean space if ``dims`` > 3. If the shape of the matrix is
+                ``(n, ndims)`` then the method considers the altitude constant
+                and equal to zero.
+            radius (float, optional): The maximum radius of the search (m).
+                Defaults The maximum distance between two points.
+            k (int, optional): The number of nearest neighbors to be used for
+                calculating the estimated value. Defaults to ``9``.
+            covariance (str, optional): The covariance function, based on the
+                distance between points (:math:`d`), the variance of the
+                process (:math:`\\sigma`) and the length scale
+                (:math:`\\lambda`). This parameter can take one of the
+                following values:
+
+                * ``matern_12``: :math:`C(d) = \\sigma
+                  e^{-\\frac{d}{\\lambda}}`
+                * ``matern_32``: :math:`C(d) = \\sigma
+                  (1 + \\frac{\\sqrt{3} d}{\\lambda})
+                  e^{-\\frac{\\sqrt{3} d}{\\lambda}}`
+                * ``matern_52``: :math:`C(d) = \\sigma
+                  (1 + \\frac{\\sqrt{5} d}{\\lambda} +
+                  \\frac{5 d^2}{3 \\lambda^2})
+                  e^{-\\frac{\\sqrt{5} d}{\\lambda}}`
+                * ``gaussian``: :math:`C(d) = \\sigma
+                  e^{-\\frac{d^2}{2 \\lambda^2}}`
+                * ``spherical``: :math:`C(d) = \\sigma (1 -
+                  \\frac{3 d}{2 \\lambda} + \\frac{d^3}{2 \\lambda^3})`
+                  for :math:`d < \\lambda`, and zero beyond.
+
+                Default to ``matern_32``.
+            sigma (float, optional): The variance of the process (sill of the
+                covariance function). Defaults to ``1``.
+            lambda_ (float, optional): The length scale of the covariance
+                function (m). Defaults to ``1``.
+            nugget (float, optional): The variance of the measurement noise.
+                Defaults to ``0``.
+            within (bool, optional): If true, the method ensures that the
+                neighbors found are located around the point of interest. In
+                other words, this parameter ensures that the calculated values
+                will not be extrapolated. Defaults to ``true``.
+            num_threads (int, optional): The number of threads to use for the
+                computation. If 0 all CPUs are used. If 1 is given, no parallel
+                computing code is used at all, which is useful for debugging.
+                Defaults to ``0``.
+        Returns:
+            tuple: The estimated value, the variance of the estimation error
+            and the number of neighbors used in the calculation.
+        """
+        covariance = covariance or "matern_32"
+        if covariance not in [
+                "matern_12",
+                "matern_32",
+                "matern_52",
+                "gaussian",
+                "spherical",
+        ]:
+            raise ValueError(
+                f"Covariance function {covariance!r} is not defined")
+        covariance = "".join(item.capitalize()
+                             for item in covariance.split("_"))
+
+        return self._instance.kriging(
+            coordinates, radius, k,
+            getattr(core.CovarianceFunction, covariance), sigma, lambda_,
+            nugget, within, num_threads)
+
+    def compact_radial_basis_function(
+            self,
+            coordinates: np.ndarray,
+            radius: float,
+            smooth: Optional[float] = 0,
+            max_iterations: Optional[int] = 1000,
+            tolerance: Optional[float] = 1e-10,
+            num_threads: Optional[int] = 0) -> Tuple[np.ndarray, np.ndarray]:
+        """Interpolation of the value at the requested position by a radial
+        basis function with compact support, solved over all the points of
+        the tree.
+
+        The function used is the Wendland function:
+
+        .. math::
+
+            \\varphi(r) = (1 - \\dfrac{r}{\\rho})^4
+            (4\\dfrac{r}{\\rho} + 1)
+
+        for :math:`r < \\rho`, and zero beyond the support radius
+        :math:`\\rho`. Each point only interacts with the points of its
+        support, so the linear system defining the interpolant is sparse.
+        It is solved once, by the conjugate gradient method, for all the
+        requested positions: the cost of the method grows with the number of
+        points times the number of neighbors within the support radius.
+
+        Args:
+            coordinates (numpy.ndarray): a matrix ``(n, ndims)`` where ``n`` is
+                the number of observations and ``ndims`` is the number of
+                coordinates in order: longitude and latitude in degrees,
+                altitude in meters and then the other coordinates defined in
+                Euclidean space if ``dims`` > 3. If the shape of the matrix is
+                ``(n, ndims)`` then the method considers the altitude constant
+                and equal to zero.
+            radius (float): The radius of the support of the function (m).
+            smooth (float, optional): values greater than zero increase the
+                smoothness of the approximation. Default to 0 (interpolation).
+            max_iterations (int, optional): Maximum number of iterations of
+                the conjugate gradient. Defaults to ``1000``.
+            tolerance (float, optional): Relative residual error below which
+                the solution is accepted. Defaults to ``1e-10``.
+            num_threads (int, optional): The number of threads to use for the
+                computation. If 0 all CPUs are used. If 1 is given, no parallel
+                computing code is used at all, which is useful for debugging.
+                Defaults to ``0``.
+        Returns:
+            tuple: The interpolated value and the number of neighbors used in
+            the calculation. The value is undefined if no point is located
+            within the support radius.
+        """
+        return self._instance.compact_radial_basis_function(
+            coordinates, radius, smooth, max_iterations, tolerance,
+            num_threads)
+
     def window_function(
             self,
             coordinates: np.ndarray,
@@ -253,7 +495,9 @@ class RTree:
             wf: Optional[str] = None,
             arg: Optional[float] = None,
             within: Optional[bool] = True,
-            num_threads: Optional[int] = 0) -> Tuple[np.ndarray, np.ndarray]:
+            table_size: Optional[int] = 0,
+            num_threads: Optional[int] = 0,
+            eps: float = 0) -> Tuple[np.ndarray, np.ndarray]:
         """Interpolation of the value at the requested position by window
         function.
 
@@ -298,6 +542,9 @@ class RTree:
                   0.277263158 \\cos(\\frac{2 \\pi (d + r)}{r}) -
                   0.083578947 \\cos(\\frac{3 \\pi (d + r)}{r}) +
                   0.006947368 \\cos(\\frac{4 \\pi (d + r)}{r})`
+                * ``gaussian``: :math:`w(d) = \\exp(-\\frac{d^2}{2
+                  \\sigma^2})`, :math:`\\sigma` being the optional
+                  argument, :math:`\\frac{r}{2}` by default.
                 * ``lanczos``: :math:`w(d) = \\left\\{\\begin{array}{ll}
                   sinc(\\frac{d}{r}) \\times sinc(\\frac{d}{arg \\times r}),
                   & d \\le arg \\times r \\\\ 0,
@@ -328,10 +575,23 @@ class RTree:
                 neighbors found are located around the point of interest. In
                 other words, this parameter ensures that the calculated values
                 will not be extrapolated. Defaults to ``true``.
+            table_size (int, optional): If not zero, the window function is
+                tabulated over its support with this number of intervals, then
+                evaluated by linear interpolation, which is faster. The error
+                decreases with the square of the size of the table: with
+                ``1024`` intervals, it is about ``1e-6``. Defaults to ``0``:
+                the window function is evaluated for each neighbor.
             num_threads (int, optional): The number of threads to use for the
                 computation. If 0 all CPUs are used. If 1 is given, no parallel
                 computing code is used at all, which is useful for debugging.
                 Defaults to ``0``.
+            eps (float, optional): Tolerance of an approximate search of
+                the neighbors. The parts of the index that cannot contain a
+                point closer than the worst neighbor found divided by
+                ``1 + eps`` are not explored: the i-th neighbor returned is at
+                most ``1 + eps`` times farther than the true i-th nearest
+                neighbor, which is faster for large values of ``k``. Defaults
+                to ``0``: the search is exact.
         Returns:
             tuple: The interpolated value and the number of neighbors used in
             the calculation.
@@ -342,6 +602,7 @@ class RTree:
                 "blackman_harris",
                 "boxcar",
                 "flattop",
+                "gaussian",
                 "hamming",
                 "lanczos",
                 "nuttall",
@@ -364,6 +625,13 @@ class RTree:
                 raise ValueError(
                     f"The argument of the function {wf!r} must be "
                     "greater than 0")
+        elif wf == "gaussian":
+            if arg is None:
+                arg = 0
+            elif arg <= 0:
+                raise ValueError(
+                    f"The argument of the function {wf!r} must be "
+                    "greater than 0")
         else:
             if arg is not None:
                 raise ValueError(f"The function {wf!r} does not support the "
@@ -373,7 +641,55 @@ class RTree:
 
         return self._instance.window_function(coordinates, radius, k,
                                               getattr(core.WindowFunction, wf),
-                                              arg, within, num_threads)
+                                              arg, within, table_size,
+                                              num_threads, eps)
+
+    def save(self, path: str) -> None:
+        """Writes the index to a file that can be mapped in memory by
+        :py:meth:`load`.
+
+        Args:
+            path (str): Path to the file to create.
+
+        .. note::
+
+            The file stores the memory representation of the index: it can
+            only be loaded on a machine with the same architecture.
+        """
+        self._instance.save(path)
+
+    @staticmethod
+    def load(path: str) -> "RTree":
+        """Opens an index written by :py:meth:`save`.
+
+        The file is mapped read-only in memory instead of being read: the index
+        is usable immediately and the memory pages holding it are shared
+        between the processes opening the same file. The file must not be
+        modified while the index is in use.
+
+        Args:
+            path (str): Path to the file to open.
+
+        Returns:
+            RTree: The index stored in the file.
+        """
+        # The header of the file starts with an identifier, the version of
+        # the layout, the number of dimensions, the size of the coordinates
+        # and the size of the values.
+        with open(path, "rb") as stream:
+            header = stream.read(24)
+        if len(header) != 24 or header[:8] != b"PYIKDTRE":
+            raise ValueError(f"invalid index file: {path}")
+        _, ndims, coordinate_size, value_size = struct.unpack(
+            "=4I", header[8:])
+        dtypes = {8: np.dtype("float64"), 4: np.dtype("float32")}
+        dtype = dtypes.get(value_size)
+        ecef_dtype = dtypes.get(coordinate_size)
+        if dtype is None or ecef_dtype is None:
+            raise ValueError(f"invalid index file: {path}")
+        result = RTree(dtype=dtype, ndims=ndims, ecef_dtype=ecef_dtype)
+        result._instance = type(result._instance).load(path)
+        return result
 
     def __getstate__(self) -> Tuple:
         """Return the state of the object for pickling purposes.
@@ -381,7 +697,7 @@ class RTree:
         Returns:
             tuple: The state of the object for pickling purposes.
         """
-        return (self.dtype, self._instance.__getstate__())
+        return (self.dtype, self._instance.__getstate__(), self.ecef_dtype)
 
     def __setstate__(self, state: Tuple):
         """Set the state of the object from pickling.
@@ -389,9 +705,395 @@ class RTree:
         Args:
             state (tuple): The state of the object for pickling purposes.
         """
-        if len(state) != 2:
+        if len(state) not in (2, 3):
             raise ValueError("invalid state")
-        _class = RTree(None, state[0])
+        ecef_dtype = state[2] if len(state) == 3 else None
+        _class = RTree(None, state[0], ecef_dtype=ecef_dtype)
         self.dtype = _class.dtype
+        self.ecef_dtype = _class.ecef_dtype
         _class._instance.__setstate__(state[1])
         self._instance = _class._instance
+
+
+class TemporalRTree:
+    """Spatio-temporal index for geodetic scalar values.
+
+    The observations are split into partitions covering a fixed period of
+    time, each indexed by its own tree. The searches are restricted to a time
+    window around the date of each point of interest, and only explore the
+    partitions overlapping this window: a single index covers a long period of
+    observations without slowing down the queries.
+    """
+    #: Resolution of the dates handled by the index.
+    RESOLUTION = "ns"
+
+    def __init__(self,
+                 period: np.timedelta64 = np.timedelta64(1, "D"),
+                 system: Optional[geodetic.System] = None,
+                 dtype: Optional[np.dtype] = None):
+        """
+        Initialize a new spatio-temporal index.
+
+        Args:
+            period (numpy.timedelta64, optional): Duration of the partitions
+                of the index. The shorter the period, the fewer observations
+                are filtered by their date during the searches, but the more
+                partitions are explored for wide time windows. Defaults to
+                one day.
+            system (pyinterp.geodetic.System, optional): WGS of the
+                coordinate system used to transform equatorial spherical
+                positions (longitudes, latitudes, altitude) into ECEF
+                coordinates. If not set the geodetic system used is WGS-84.
+                Default to ``None``.
+            dtype (numpy.dtype, optional): Data type of the instance to create.
+        """
+        dtype = np.dtype(dtype or "float64")
+        if dtype.name not in ("float32", "float64"):
+            raise ValueError(f"dtype {dtype} not handled by the object")
+        self._instance = getattr(
+            core, f"TemporalRTree3D{dtype.name.capitalize()}")(
+                system, self._duration(period))
+        self.dtype = dtype
+
+    @classmethod
+    def _dates(cls, dates: np.ndarray) -> np.ndarray:
+        """Returns the dates as integers in the resolution of the index."""
+        dates = np.asarray(dates)
+        if not np.issubdtype(dates.dtype, np.datetime64):
+            raise TypeError("dates must be a numpy.datetime64 array")
+        return dates.astype(f"M8[{cls.RESOLUTION}]").view("int64")
+
+    @classmethod
+    def _duration(cls, duration: np.timedelta64) -> int:
+        """Returns a duration as an integer in the resolution of the index."""
+        if not isinstance(duration, np.timedelta64):
+            raise TypeError("the duration must be a numpy.timedelta64")
+        return int(duration.astype(f"m8[{cls.RESOLUTION}]").view("int64"))
+
+    @property
+    def period(self) -> np.timedelta64:
+        """Duration of the partitions of the index."""
+        return np.timedelta64(self._instance.period, self.RESOLUTION)
+
+    def partitions(self) -> int:
+        """Returns the number of partitions of the index."""
+        return self._instance.partitions()
+
+    def clear(self) -> None:
+        """Removes all values stored in the container.
+        """
+        return self._instance.clear()
+
+    def __len__(self):
+        """Returns the number of values stored in the index."""
+        return self._instance.__len__()
+
+    def __bool__(self):
+        """Returns true if the index is not empty."""
+        return self._instance.__bool__()
+
+    def packing(self,
+                coordinates: np.ndarray,
+                dates: np.ndarray,
+                values: np.ndarray,
+                num_threads: Optional[int] = 0) -> None:
+        """Replaces the content of the index by the observations provided.
+
+        Args:
+            coordinates (numpy.ndarray): a matrix ``(n, 3)`` of the longitudes
+                and latitudes in degrees and the altitudes in meters of the
+                observations. If the shape of the matrix is ``(n, 2)``, the
+                altitude is considered equal to zero.
+            dates (numpy.ndarray): An array of size ``(n)`` containing the
+                dates of the observations.
+            values (numpy.ndarray): An array of size ``(n)`` containing the
+                values observed.
+            num_threads (int, optional): The number of threads to use for the
+                computation. If 0 all CPUs are used. If 1 is given, no parallel
+                computing code is used at all, which is useful for debugging.
+                Defaults to ``0``.
+        """
+        self._instance.packing(coordinates, self._dates(dates), values,
+                               num_threads)
+
+    def query(self,
+              coordinates: np.ndarray,
+              dates: np.ndarray,
+              window: np.timedelta64,
+              k: Optional[int] = 4,
+              num_threads: Optional[int] = 0
+              ) -> Tuple[np.ndarray, np.ndarray]:
+        """Search for the K nearest neighbors of the given points, observed
+        within a time window.
+
+        Args:
+            coordinates (numpy.ndarray): a matrix ``(n, 3)`` of the longitudes
+                and latitudes in degrees and the altitudes in meters of the
+                points of interest. If the shape of the matrix is ``(n, 2)``,
+                the altitude is considered equal to zero.
+            dates (numpy.ndarray): An array of size ``(n)`` containing the
+                dates of the points of interest.
+            window (numpy.timedelta64): Half-width of the time window: the
+                neighbors of a point dated ``t`` are searched among the
+                observations made between ``t - window`` and ``t + window``.
+            k (int, optional): The number of nearest neighbors to be searched.
+                Defaults to ``4``.
+            num_threads (int, optional): The number of threads to use for the
+                computation. If 0 all CPUs are used. If 1 is given, no parallel
+                computing code is used at all, which is useful for debugging.
+                Defaults to ``0``.
+        Returns:
+            tuple: A matrix of the distances, in meters, between the points
+            and their neighbors and a matrix of the values of the neighbors.
+            The missing neighbors are set to ``-1``.
+        """
+        return self._instance.query(coordinates, self._dates(dates),
+                                    self._duration(window), k, num_threads)
+
+    def inverse_distance_weighting(
+            self,
+            coordinates: np.ndarray,
+            dates: np.ndarray,
+            window: np.timedelta64,
+            radius: Optional[float] = None,
+            k: Optional[int] = 9,
+            p: Optional[int] = 2,
+            num_threads: Optional[int] = 0) -> Tuple[np.ndarray, np.ndarray]:
+        """Interpolation of the values at the requested positions and dates by
+        inverse distance weighting of the observations made within a time
+        window.
+
+        Args:
+            coordinates (numpy.ndarray): a matrix ``(n, 3)`` of the longitudes
+                and latitudes in degrees and the altitudes in meters of the
+                points of interest. If the shape of the matrix is ``(n, 2)``,
+                the altitude is considered equal to zero.
+            dates (numpy.ndarray): An array of size ``(n)`` containing the
+                dates of the points of interest.
+            window (numpy.timedelta64): Half-width of the time window.
+            radius (float, optional): The maximum radius of the search (m).
+                Defaults The maximum distance between two points.
+            k (int, optional): The number of nearest neighbors to be used for
+                calculating the interpolated value. Defaults to ``9``.
+            p (float, optional): The power parameters. Defaults to ``2``.
+            num_threads (int, optional): The number of threads to use for the
+                computation. If 0 all CPUs are used. If 1 is given, no parallel
+                computing code is used at all, which is useful for debugging.
+                Defaults to ``0``.
+        Returns:
+            tuple: The interpolated value and the number of neighbors used in
+            the calculation.
+        """
+        return self._instance.inverse_distance_weighting(
+            coordinates, self._dates(dates), self._duration(window), radius, k,
+            p, num_threads)
+
+
+class ShardedRTree:
+    """Spatial index for geodetic scalar values sharded by geohash.
+
+    The values are split into shards by the geohash of the cell containing
+    them, each shard being indexed by its own tree. A search explores the
+    shard of the cell containing the point of interest, then the shards of the
+    eight adjacent cells if the neighbors can be located beyond its edges.
+    The cells must therefore be larger than the distances searched: the
+    neighbors located beyond the adjacent cells are not found.
+
+    The shards can be written to a directory, one file per shard, and mapped
+    in memory: the processes serving the queries of distinct regions only open
+    the shards they need.
+    """
+    #: Extension of the files storing the shards.
+    EXTENSION = ".idx"
+
+    def __init__(self,
+                 precision: int = 10,
+                 system: Optional[geodetic.System] = None,
+                 dtype: Optional[np.dtype] = None):
+        """
+        Initialize a new sharded index.
+
+        Args:
+            precision (int, optional): Number of bits of the geohash
+                identifying the shards, within ``[1, 64]``. Defaults to
+                ``10``, cells of about 5.6 degrees in longitude and latitude.
+            system (pyinterp.geodetic.System, optional): WGS of the
+                coordinate system used to transform equatorial spherical
+                positions (longitudes, latitudes, altitude) into ECEF
+                coordinates. If not set the geodetic system used is WGS-84.
+                Default to ``None``.
+            dtype (numpy.dtype, optional): Data type of the instance to create.
+        """
+        dtype = np.dtype(dtype or "float64")
+        if dtype.name not in ("float32", "float64"):
+            raise ValueError(f"dtype {dtype} not handled by the object")
+        self._instance = getattr(
+            core, f"ShardedRTree3D{dtype.name.capitalize()}")(system,
+                                                              precision)
+        self.dtype = dtype
+
+    @property
+    def precision(self) -> int:
+        """Number of bits of the geohash identifying the shards."""
+        return self._instance.precision
+
+    def shards(self) -> int:
+        """Returns the number of shards of the index."""
+        return self._instance.shards()
+
+    def keys(self) -> List[int]:
+        """Returns the geohash of the shards, sorted in ascending order."""
+        return self._instance.keys()
+
+    def shard_size(self, key: int) -> int:
+        """Returns the number of values stored in a shard.
+
+        Args:
+            key (int): Geohash of the shard.
+        Returns:
+            int: The number of values stored, ``0`` if the shard does not
+            exist.
+        """
+        return self._instance.shard_size(key)
+
+    def clear(self) -> None:
+        """Removes all values stored in the container.
+        """
+        return self._instance.clear()
+
+    def __len__(self):
+        """Returns the number of values stored in the index."""
+        return self._instance.__len__()
+
+    def __bool__(self):
+        """Returns true if the index is not empty."""
+        return self._instance.__bool__()
+
+    def packing(self,
+                coordinates: np.ndarray,
+                values: np.ndarray,
+                num_threads: Optional[int] = 0) -> None:
+        """Replaces the content of the index by the values provided.
+
+        Args:
+            coordinates (numpy.ndarray): a matrix ``(n, 3)`` of the longitudes
+                and latitudes in degrees and the altitudes in meters of the
+                values. If the shape of the matrix is ``(n, 2)``, the altitude
+                is considered equal to zero.
+            values (numpy.ndarray): An array of size ``(n)`` containing the
+                values associated with the coordinates provided.
+            num_threads (int, optional): The number of threads to use for the
+                computation. If 0 all CPUs are used. If 1 is given, no parallel
+                computing code is used at all, which is useful for debugging.
+                Defaults to ``0``.
+        """
+        self._instance.packing(coordinates, values, num_threads)
+
+    def query(self,
+              coordinates: np.ndarray,
+              k: Optional[int] = 4,
+              radius: Optional[float] = None,
+              num_threads: Optional[int] = 0
+              ) -> Tuple[np.ndarray, np.ndarray]:
+        """Search for the K nearest neighbors of the given points.
+
+        Args:
+            coordinates (numpy.ndarray): a matrix ``(n, 3)`` of the longitudes
+                and latitudes in degrees and the altitudes in meters of the
+                points of interest. If the shape of the matrix is ``(n, 2)``,
+                the altitude is considered equal to zero.
+            k (int, optional): The number of nearest neighbors to be searched.
+                Defaults to ``4``.
+            radius (float, optional): The maximum radius of the search (m).
+                Defaults The maximum distance between two points.
+            num_threads (int, optional): The number of threads to use for the
+                computation. If 0 all CPUs are used. If 1 is given, no parallel
+                computing code is used at all, which is useful for debugging.
+                Defaults to ``0``.
+        Returns:
+            tuple: A matrix of the distances, in meters, between the points
+            and their neighbors and a matrix of the values of the neighbors.
+            The missing neighbors are set to ``-1``.
+        """
+        return self._instance.query(coordinates, k, radius, num_threads)
+
+    def inverse_distance_weighting(
+            self,
+            coordinates: np.ndarray,
+            radius: Optional[float] = None,
+            k: Optional[int] = 9,
+            p: Optional[int] = 2,
+            num_threads: Optional[int] = 0) -> Tuple[np.ndarray, np.ndarray]:
+        """Interpolation of the values at the requested positions by inverse
+        distance weighting.
+
+        Args:
+            coordinates (numpy.ndarray): a matrix ``(n, 3)`` of the longitudes
+                and latitudes in degrees and the altitudes in meters of the
+                points of interest. If the shape of the matrix is ``(n, 2)``,
+                the altitude is considered equal to zero.
+            radius (float, optional): The maximum radius of the search (m).
+                Defaults The maximum distance between two points.
+            k (int, optional): The number of nearest neighbors to be used for
+                calculating the interpolated value. Defaults to ``9``.
+            p (float, optional): The power parameters. Defaults to ``2``.
+            num_threads (int, optional): The number of threads to use for the
+                computation. If 0 all CPUs are used. If 1 is given, no parallel
+                computing code is used at all, which is useful for debugging.
+                Defaults to ``0``.
+        Returns:
+            tuple: The interpolated value and the number of neighbors used in
+            the calculation.
+        """
+        return self._instance.inverse_distance_weighting(
+            coordinates, radius, k, p, num_threads)
+
+    def save(self, directory: str) -> None:
+        """Writes the shards to a directory, one file per shard, that can be
+        mapped in memory by :py:meth:`load`.
+
+        Args:
+            directory (str): Path to the directory receiving the files. It is
+                created if it does not exist.
+
+        .. note::
+
+            The files store the memory representation of the shards: they can
+            only be loaded on a machine with the same architecture.
+        """
+        os.makedirs(directory, exist_ok=True)
+        for key in self.keys():
+            self._instance.save(key, self._path(directory, key))
+
+    def load(self,
+             directory: str,
+             keys: Optional[Iterable[int]] = None) -> None:
+        """Opens the shards written by :py:meth:`save` to a directory.
+
+        The files are mapped read-only in memory instead of being read: the
+        shards are usable immediately and the memory pages holding them are
+        shared between the processes opening the same files. The files must
+        not be modified while the index is in use. The index must have the
+        precision and the geodetic system of the index that wrote the shards.
+
+        Args:
+            directory (str): Path to the directory containing the files.
+            keys (iterable, optional): Geohash of the shards to open. The
+                shards missing from the directory are ignored. By default, all
+                the shards of the directory are opened.
+        """
+        if keys is None:
+            keys = [
+                int(item[:-len(self.EXTENSION)], 16)
+                for item in sorted(os.listdir(directory))
+                if item.endswith(self.EXTENSION)
+            ]
+        for key in keys:
+            path = self._path(directory, key)
+            if os.path.exists(path):
+                self._instance.load(key, path)
+
+    @classmethod
+    def _path(cls, directory: str, key: int) -> str:
+        """Returns the path to the file storing a shard."""
+        return os.path.join(directory, f"{key:016x}{cls.EXTENSION}")
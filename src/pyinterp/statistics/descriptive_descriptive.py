@@ -6,6 +6,7 @@ from typing import Any, Iterable, Optional, Union
 import dask.array as da
 import numpy as np
 from .. import core
+from ..grid import Grid3D
 
 
 def _delayed(
@@ -20,7 +21,10 @@ def _delayed(
         raise ValueError("values and weights must have the same shape")
 
     def _process_block(attr, x, w, axis):
-        instance = getattr(core, attr)(values=x, weights=w, axis=axis)
+        instance = getattr(core, attr)(values=x,
+                                       weights=w,
+                                       axis=axis,
+                                       num_threads=1)
         return np.array([instance], dtype="object")
 
     drop_axis = list(range(values.ndim))[1:]
@@ -56,7 +60,8 @@ class DescriptiveStatistics:
                  values: Union[da.Array, np.ndarray],
                  weights: Optional[Union[da.Array, np.ndarray]] = None,
                  axis: Optional[Union[int, Iterable[int]]] = None,
-                 dtype: Optional[np.dtype] = None) -> None:
+                 dtype: Optional[np.dtype] = None,
+                 num_threads: int = 0) -> None:
         """Creates a new descriptive statistics container.
 
         Args:
@@ -75,6 +80,11 @@ class DescriptiveStatistics:
                 over the flattened array.    
             dtype (numpy.dtype, optional): Data type of the returned array. By
                 default, the data type is numpy.float64.
+            num_threads (int, optional): The number of threads to use for the
+                computation. If 0 all CPUs are used. If 1 is given, no
+                parallel computing code is used at all, which is useful for
+                debugging. Dask arrays are processed block by block on a
+                single thread. Defaults to ``0``.
         """
         if isinstance(axis, int):
             axis = (axis, )
@@ -92,7 +102,52 @@ class DescriptiveStatistics:
         else:
             self._instance: Union[core.DescriptiveStatisticsFloat64,
                                   core.DescriptiveStatisticsFloat32] = getattr(
-                                      core, attr)(values, weights, axis)
+                                      core, attr)(values, weights, axis,
+                                                  num_threads)
+
+    @classmethod
+    def rolling(cls,
+                grid: Grid3D,
+                window: int,
+                center: bool = False,
+                min_periods: int = 1,
+                num_threads: int = 0) -> "DescriptiveStatistics":
+        """Calculates the statistics of the values of a 3D grid within a
+        window sliding along its third axis, for example a time axis.
+
+        The values entering and leaving the window update its statistics
+        incrementally: the cost does not depend on the size of the window.
+
+        Args:
+            grid (pyinterp.grid.Grid3D): Grid whose values are processed.
+                NaNs are ignored.
+            window (int): Number of values of the window along the third
+                axis.
+            center (bool, optional): If true, the window is centered on each
+                value, otherwise it ends at each value. Defaults to
+                ``False``.
+            min_periods (int, optional): Minimum number of valid values of a
+                window for its statistics to be defined. The statistics of
+                the other windows are empty. Defaults to ``1``.
+            num_threads (int, optional): The number of threads to use for
+                the computation. The series of the cells of the grid are
+                processed in parallel. If 0 all CPUs are used. If 1 is
+                given, no parallel computing code is used at all, which is
+                useful for debugging. Defaults to ``0``.
+
+        Returns:
+            DescriptiveStatistics: The statistics of the window of each
+            value of the grid, whose shape is the shape of the grid.
+        """
+        instance = grid._instance
+        suffix = "Float32" if type(instance).__name__.endswith(
+            "Float32") else "Float64"
+        result = cls.__new__(cls)
+        result._instance = getattr(core,
+                                   f"DescriptiveStatistics{suffix}").rolling(
+                                       instance, window, center, min_periods,
+                                       num_threads)
+        return result
 
     def __iadd__(self, other: Any) -> "DescriptiveStatistics":
         """Adds a new descriptive statistics container to the current one.
@@ -231,6 +231,11 @@ class StreamingHistogram:
     def quantile(self, q: float = 0.5) -> np.ndarray:
         """Returns the q quantile of samples.
 
+        As long as a histogram has not held more values than its number of
+        bins, the quantile is interpolated between the values pushed, each one
+        placed at the middle of its weight in the cumulative distribution.
+        Once the bins are merged, the quantile is estimated.
+
         Args:
             q (float): Quantile to compute. Default is ``0.5`` (median).
 
@@ -238,3 +243,23 @@ class StreamingHistogram:
             numpy.ndarray: Returns the q quantile of samples.
         """
         return self._instance.quantile(q)
+
+    def quantiles(self, q: np.ndarray, num_threads: int = 0) -> np.ndarray:
+        """Returns several quantiles of samples.
+
+        The quantiles of each histogram are computed in a single pass over
+        its bins, which is faster than calling :py:meth:`quantile` for each
+        of them.
+
+        Args:
+            q (numpy.ndarray): Quantiles to compute, in [0, 1].
+            num_threads (int, optional): The number of threads to use for the
+                computation. If 0 all CPUs are used. If 1 is given, no parallel
+                computing code is used at all, which is useful for debugging.
+                Defaults to ``0``.
+
+        Returns:
+            numpy.ndarray: The quantiles of samples, along a last dimension of
+            the size of ``q``.
+        """
+        return self._instance.quantiles(np.asarray(q).ravel(), num_threads)
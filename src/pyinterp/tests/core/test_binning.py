@@ -161,3 +161,30 @@ def test_binning2d_iadd():
     assert np.all(other.variance() == 0)
     assert np.all(np.isnan(other.skewness()))
     assert np.all(np.isnan(other.kurtosis()))
+
+
+def test_binning2d_merge():
+    x_axis = core.Axis(np.linspace(-180, 180, 10), is_circle=True)
+    y_axis = core.Axis(np.linspace(-90, 90, 10))
+
+    binning = core.Binning2DFloat64(x_axis, y_axis, None)
+    binning.push(np.array([-180, 0]), np.array([-90, 0]), np.array([1, 2]))
+    other = core.Binning2DFloat64(x_axis, y_axis, None)
+    other.push(np.array([-180, 20]), np.array([-90, 20]), np.array([3, 4]))
+
+    # Only the cells holding values are serialized.
+    state = other.__getstate__()
+    assert isinstance(state[3], bytes)
+    assert len(state[3]) < 100 * 8
+
+    expected = copy.copy(binning)
+    expected += other
+    binning.merge(state)
+    assert np.all(binning.count() == expected.count())
+    assert np.all(binning.sum() == expected.sum())
+    assert np.array_equal(binning.mean(), expected.mean(), equal_nan=True)
+
+    other = core.Binning2DFloat64(core.Axis(np.linspace(-90, 90, 10)),
+                                  y_axis, None)
+    with pytest.raises(ValueError):
+        binning.merge(other.__getstate__())
@@ -102,6 +102,18 @@ def test_weekday(resolution):
         assert item == weekday % 7
 
 
+@pytest.mark.parametrize("resolution", ["s", "ms", "us", "ns"])
+def test_num_threads(resolution):
+    _, npdates = make_date(resolution=resolution)
+    for function in [
+            core.dateutils.date, core.dateutils.isocalendar,
+            core.dateutils.time, core.dateutils.timedelta_since_january,
+            core.dateutils.weekday
+    ]:
+        np.testing.assert_array_equal(function(npdates, num_threads=1),
+                                      function(npdates, num_threads=0))
+
+
 def test_wrong_units():
     _, npdates = make_date(10)
 
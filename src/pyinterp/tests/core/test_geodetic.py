@@ -561,6 +561,74 @@ def test_polygon_covered_by():
     assert np.all(mask2 == mask1)
 
 
+def test_prepared_polygon_covered_by():
+    generator = np.random.Generator(np.random.PCG64(0))
+    lon = generator.uniform(-180, 180, 20000)
+    lat = generator.uniform(-90, 90, 20000)
+    for polygon in [
+            core.geodetic.Polygon(
+                [core.geodetic.Point(*item) for item in POINTS]),
+            core.geodetic.Polygon.read_wkt(
+                "POLYGON((0 0,0 5,5 5,5 0,0 0),(1 1,4 1,4 4,1 4,1 1))"),
+            core.geodetic.Polygon.read_wkt(
+                "POLYGON((170 -10,170 10,-170 10,-170 -10,170 -10))"),
+    ]:
+        prepared = core.geodetic.PreparedPolygon(polygon)
+        expected = polygon.covered_by(lon, lat)
+        assert np.all(prepared.covered_by(lon, lat) == expected)
+        assert np.all(
+            prepared.covered_by(lon + 360, lat, num_threads=0) == expected)
+        for item in polygon.outer:
+            assert prepared.covered_by(item)
+        other = pickle.loads(pickle.dumps(prepared))
+        assert other.polygon == polygon
+        assert np.all(other.covered_by(lon, lat) == expected)
+
+
+def test_multipolygon_which_polygon():
+    polygons = [
+        core.geodetic.Polygon.read_wkt(
+            "POLYGON((170 -10,170 10,-170 10,-170 -10,170 -10))"),
+        core.geodetic.Polygon.read_wkt(
+            "POLYGON((0 0,0 20,20 20,20 0,0 0),(5 5,15 5,15 15,5 15,5 5))"),
+        core.geodetic.Polygon.read_wkt(
+            "POLYGON((10 10,10 30,30 30,30 10,10 10))"),
+        core.geodetic.Polygon(
+            [core.geodetic.Point(*item) for item in POINTS]),
+    ]
+    multipolygon = core.geodetic.MultiPolygon(polygons)
+    assert len(multipolygon) == 4
+    assert multipolygon[-1] == polygons[-1]
+    with pytest.raises(IndexError):
+        multipolygon[4]
+    with pytest.raises(ValueError):
+        core.geodetic.MultiPolygon([1])
+
+    generator = np.random.Generator(np.random.PCG64(0))
+    lon = generator.uniform(-180, 180, 20000)
+    lat = generator.uniform(-90, 90, 20000)
+    expected = np.full(lon.shape, -1, dtype=np.int64)
+    for ix, polygon in reversed(list(enumerate(polygons))):
+        expected[polygon.covered_by(lon, lat) == 1] = ix
+    assert np.any(expected == -1)
+    assert np.all(multipolygon.which_polygon(lon, lat) == expected)
+    assert np.all(
+        multipolygon.which_polygon(lon + 360, lat, num_threads=1) == expected)
+    assert np.all(
+        multipolygon.covered_by(lon, lat) == (expected != -1).astype(np.int8))
+
+    # The polygons overlap: the first polygon covering the point wins.
+    index = multipolygon.which_polygon(np.array([12.0, 25.0, 180.0]),
+                                       np.array([12.0, 25.0, 0.0]))
+    assert np.all(index == [2, 2, 0])
+    index = multipolygon.which_polygon(np.array([2.0]), np.array([2.0]))
+    assert index[0] == 1
+
+    other = pickle.loads(pickle.dumps(multipolygon))
+    assert other == multipolygon
+    assert core.geodetic.MultiPolygon().which_polygon(lon, lat)[0] == -1
+
+
 def test_coordinate_distance():
     lon = np.arange(0, 360, 10)
     lat = np.arange(-90, 90.5, 10)
@@ -584,3 +652,45 @@ def test_coordinate_distance():
     for ix in range(d0.shape[1]):
         delta = np.abs(d0[:, ix] - d0[0, ix])
         assert np.all(delta[delta != 0] > 1e3)
+
+
+def test_coordinate_distance_approximations():
+    generator = np.random.Generator(np.random.PCG64(0))
+    lon1 = generator.uniform(-180, 180, 10000)
+    lat1 = generator.uniform(-80, 80, 10000)
+    lon2 = lon1 + generator.uniform(-0.1, 0.1, 10000)
+    lat2 = lat1 + generator.uniform(-0.1, 0.1, 10000)
+    expected = core.geodetic.coordinate_distances(lon1,
+                                                  lat1,
+                                                  lon2,
+                                                  lat2,
+                                                  strategy="vincenty")
+    for strategy in ["haversine", "flat"]:
+        d0 = core.geodetic.coordinate_distances(lon1,
+                                                lat1,
+                                                lon2,
+                                                lat2,
+                                                strategy=strategy,
+                                                num_threads=1)
+        d1 = core.geodetic.coordinate_distances(lon1,
+                                                lat1,
+                                                lon2,
+                                                lat2,
+                                                strategy=strategy,
+                                                num_threads=0)
+        assert np.all(d0 == d1)
+        assert np.all(np.abs(d0 - expected) <= expected * 5e-3)
+
+    # The difference of longitudes crosses the antimeridian.
+    d0 = core.geodetic.coordinate_distances(np.array([179.9]),
+                                            np.array([0.0]),
+                                            np.array([-179.9]),
+                                            np.array([0.0]),
+                                            strategy="flat")
+    assert d0[0] == pytest.approx(22239, rel=1e-3)
+
+    acropolis = core.geodetic.Point(23.725750, 37.971536)
+    ulb = core.geodetic.Point(4.3826169, 50.8119483)
+    assert 2088384.36606831 == pytest.approx(acropolis.distance(
+        ulb, strategy="haversine"),
+                                             rel=5e-3)
@@ -4,7 +4,7 @@
 # BSD-style license that can be found in the LICENSE file.
 import numpy
 import pytest
-from ...core import geohash, GeoHash
+from ...core import geodetic, geohash, GeoHash
 
 testcases = [["77mkh2hcj7mz", -26.015434642, -26.173663656],
              ["wthnssq3w00x", 29.291182895, 118.331595326],
@@ -52,6 +52,23 @@ def test_string_numpy():
         indexes = geohash.where(strs)
 
 
+def test_where_arrays():
+    strs = numpy.array([[b"aa", b"aa", b"bb"], [b"aa", b"cc", b"bb"],
+                        [b"cc", b"cc", b"bb"]])
+    codes, indexes = geohash.where_arrays(strs)
+    assert list(codes) == [b"aa", b"bb", b"cc"]
+    assert indexes.tolist() == [[0, 1, 0, 1], [0, 2, 2, 2], [1, 2, 0, 1]]
+
+    # The dictionary holds the same extents.
+    expected = geohash.where(strs)
+    assert len(expected) == 3
+    for code, item in zip(codes, indexes):
+        assert expected[code] == ((item[0], item[1]), (item[2], item[3]))
+
+    with pytest.raises(ValueError):
+        geohash.where_arrays(numpy.array([[b"a!"]]))
+
+
 def test_bounding_boxes():
     bboxes = geohash.bounding_boxes(precision=1)
     assert len(bboxes) == 32
@@ -69,6 +86,36 @@ def test_bounding_boxes():
         geohash.bounding_boxes(precision=12)
 
 
+def test_bounding_boxes_polygon():
+    outer = [
+        geodetic.Point(*item) for item in ((-20, -10), (-20, 30), (40, 35),
+                                           (35, -15), (-20, -10))
+    ]
+    inner = [
+        geodetic.Point(*item) for item in ((0, 0), (10, 0), (10, 10),
+                                           (0, 10), (0, 0))
+    ]
+    polygon = geodetic.Polygon(outer, [inner])
+    codes = geohash.int64.bounding_boxes(polygon, precision=15)
+    assert len(codes) > 0
+    assert numpy.all(numpy.diff(codes.astype("int64")) > 0)
+    assert numpy.all(
+        geohash.int64.bounding_boxes(polygon, precision=15, num_threads=1) ==
+        codes)
+
+    # The cells in the hole or outside the polygon are discarded.
+    lon, lat = geohash.int64.decode(codes, precision=15)
+    assert not numpy.any((lon > 1) & (lon < 9) & (lat > 1) & (lat < 9))
+    assert numpy.all((lon > -21) & (lon < 41) & (lat > -16) & (lat < 36))
+
+    # The string codes are the same cells.
+    strs = geohash.bounding_boxes(polygon, precision=3)
+    assert numpy.all(strs[:-1] < strs[1:])
+    assert numpy.all(
+        geohash.int64.encode(*geohash.decode(strs), precision=15) ==
+        codes)
+
+
 def test_bounding_zoom():
     bboxes = geohash.bounding_boxes(precision=1)
     assert len(bboxes) == 32
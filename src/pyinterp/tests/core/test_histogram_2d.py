@@ -143,3 +143,27 @@ def test_binning2d_iadd():
     assert np.all(other.variance() == 0)
     assert np.all(np.isnan(other.skewness()))
     assert np.all(np.isnan(other.kurtosis()))
+
+
+def test_histogram2d_merge():
+    x_axis = core.Axis(np.linspace(-180, 180, 10), is_circle=True)
+    y_axis = core.Axis(np.linspace(-90, 90, 10))
+
+    hist2d = core.Histogram2DFloat64(x_axis, y_axis, 20)
+    hist2d.push(np.array([-180, 0]), np.array([-90, 0]), np.array([1, 2]))
+    other = core.Histogram2DFloat64(x_axis, y_axis, 20)
+    other.push(np.array([-180, 20]), np.array([-90, 20]), np.array([3, 4]))
+
+    expected = copy.copy(hist2d)
+    expected += other
+    hist2d.merge(other.__getstate__())
+    assert np.all(hist2d.count() == expected.count())
+    assert np.array_equal(hist2d.quantile(0.5),
+                          expected.quantile(0.5),
+                          equal_nan=True)
+
+    # The maximum number of bins of the empty cells is restored.
+    other = pickle.loads(pickle.dumps(hist2d))
+    other.push(np.full((30, ), 40.0), np.full((30, ), 40.0),
+               np.arange(30.0))
+    assert other.histograms().shape[2] == 20
@@ -0,0 +1,73 @@
+# Copyright (c) 2022 CNES
+#
+# All rights reserved. Use of this source code is governed by a
+# BSD-style license that can be found in the LICENSE file.
+import numpy as np
+from ... import core
+
+
+def test_profiling():
+    axis = core.Axis(np.arange(0, 360, 1.0), is_circle=True)
+    x = np.random.uniform(0, 359, 1000)
+
+    core.profiling.enable()
+    assert core.profiling.is_enabled()
+    try:
+        core.profiling.reset()
+        axis.find_indexes(x)
+        snapshot = core.profiling.snapshot()
+    finally:
+        core.profiling.enable(False)
+    assert not core.profiling.is_enabled()
+
+    assert set(snapshot) == {
+        "axis.find_indexes", "dispatch", "dispatch.startup",
+        "fill.gauss_seidel", "fill.loess", "fill.multigrid", "fill.spectral",
+        "load_frame", "rtree.query", "streaming_histogram.marshal"
+    }
+    counter = snapshot["axis.find_indexes"]
+    assert counter["calls"] >= 1
+    assert counter["seconds"] > 0
+    assert counter["ticks"] > 0
+    assert counter["allocations"] == 0
+    assert counter["bytes"] == 0
+    assert counter["peak_bytes"] == 0
+
+    core.profiling.reset()
+    snapshot = core.profiling.snapshot()
+    assert all(item["calls"] == 0 for item in snapshot.values())
+
+    # The counters are not updated when the profiling is off.
+    axis.find_indexes(x)
+    snapshot = core.profiling.snapshot()
+    assert snapshot["axis.find_indexes"]["calls"] == 0
+
+
+def test_profiling_memory():
+    x_axis = core.Axis(np.arange(-180, 180, 1.0), is_circle=True)
+    y_axis = core.Axis(np.arange(-90, 91, 1.0))
+    grid = core.Grid2DFloat64(x_axis, y_axis,
+                              np.random.uniform(size=(360, 181)))
+    x = np.random.uniform(-180, 180, 1000)
+    y = np.random.uniform(-80, 80, 1000)
+
+    core.profiling.enable()
+    try:
+        core.profiling.reset()
+        core.bicubic_float64(grid, x, y, num_threads=1)
+        snapshot = core.profiling.snapshot()
+    finally:
+        core.profiling.enable(False)
+
+    # The frame is allocated once, and reused for all the points.
+    counter = snapshot["load_frame"]
+    assert counter["calls"] >= len(x)
+    assert counter["allocations"] >= 1
+    assert counter["allocations"] < len(x)
+    assert counter["bytes"] >= counter["peak_bytes"] > 0
+
+    # The memory is not accounted when the profiling is off.
+    core.profiling.reset()
+    core.bicubic_float64(grid, x, y, num_threads=1)
+    snapshot = core.profiling.snapshot()
+    assert snapshot["load_frame"]["allocations"] == 0
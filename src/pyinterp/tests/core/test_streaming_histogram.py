@@ -147,6 +147,20 @@ def test_weighted():
                                           abs=1e-2)
 
 
+def test_exact_quantile():
+    """Test the quantiles of a histogram holding all the values pushed."""
+    values = np.random.random_sample(100)
+    weights = np.random.random_sample(100)
+    ds = core.StreamingHistogramFloat64(values,
+                                        weights=weights,
+                                        bin_count=100)
+    assert ds.quantile(0) == np.min(values)
+    assert ds.quantile(1) == np.max(values)
+    for q in (0.1, 0.25, 0.5, 0.75, 0.9):
+        assert ds.quantile(q) == pytest.approx(
+            weighted_quantile(values, weights, q))
+
+
 def test_axis():
     """Test axes along which the statistics are computed"""
     values = np.random.random_sample((2, 3, 4, 5, 6, 7))
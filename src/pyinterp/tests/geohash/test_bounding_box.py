@@ -2,7 +2,9 @@
 #
 # All rights reserved. Use of this source code is governed by a
 # BSD-style license that can be found in the LICENSE file.
+import numpy
 from ... import geodetic
+from ... import geohash
 from ... import GeoHash
 
 decodecases = [
@@ -8949,3 +8951,27 @@ def test_bbox():
         point = GeoHash.from_string(hash_str).center()
         assert geodetic.Box(geodetic.Point(min_lng, min_lat),
                             geodetic.Point(max_lng, max_lat)).covered_by(point)
+
+
+def test_area():
+    # The cells cover the whole Earth.
+    wgs = geodetic.System()
+    earth = 4 * numpy.pi * wgs.authalic_radius()**2
+    for precision in [1, 2]:
+        codes = geohash.bounding_boxes(precision=precision)
+        assert abs(geohash.area(codes).sum() / earth - 1) < 1e-9
+
+    generator = numpy.random.Generator(numpy.random.PCG64(0))
+    lon = generator.uniform(-180, 180, 1000)
+    lat = generator.uniform(-90, 90, 1000)
+    for precision in [1, 3, 6]:
+        codes = geohash.encode(lon, lat, precision=precision)
+        areas = geohash.area(codes, num_threads=1)
+        assert numpy.all(areas > 0)
+        # The areas of the rows of cells are computed once, or for each
+        # cell when the cells outnumber the codes.
+        codes = geohash.int64.encode(lon, lat, precision=5 * precision)
+        assert numpy.allclose(
+            geohash.int64.area(codes, 5 * precision, num_threads=4), areas)
+        assert numpy.allclose(
+            geohash.int64.area(codes[:5], 5 * precision), areas[:5])
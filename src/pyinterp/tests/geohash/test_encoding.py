@@ -4130,3 +4130,30 @@ def test_encoding_decoding():
         assert pytest.approx(point.lon, item[3])
         assert pytest.approx(point.lat, item[3])
         assert str(code) == item[1]
+
+
+def test_encoding_decoding_threads():
+    lon = numpy.array([item[3] for item in testcases])
+    lat = numpy.array([item[2] for item in testcases])
+
+    # The result does not depend on the number of threads used.
+    for precision in [1, 5, 6, 11, 12]:
+        expected = geohash.encode(lon, lat, precision=precision, num_threads=1)
+        assert numpy.all(
+            geohash.encode(lon, lat, precision=precision, num_threads=0) ==
+            expected)
+        decoded = geohash.decode(expected, num_threads=1)
+        other = geohash.decode(expected, num_threads=0)
+        assert numpy.all(decoded[0] == other[0])
+        assert numpy.all(decoded[1] == other[1])
+
+    int_hashs = geohash.int64.encode(lon, lat, num_threads=4)
+    assert numpy.all(
+        int_hashs == geohash.int64.encode(lon, lat, num_threads=1))
+    decoded = geohash.int64.decode(int_hashs, num_threads=1)
+    other = geohash.int64.decode(int_hashs, num_threads=4)
+    assert numpy.all(decoded[0] == other[0])
+    assert numpy.all(decoded[1] == other[1])
+
+    with pytest.raises(ValueError):
+        geohash.decode(numpy.array([b"0000a"] * 1000), num_threads=4)
@@ -0,0 +1,114 @@
+# Copyright (c) 2022 CNES
+#
+# All rights reserved. Use of this source code is governed by a
+# BSD-style license that can be found in the LICENSE file.
+import pickle
+import numpy
+import pytest
+from ... import geohash, RTree
+
+
+def test_index(tmp_path):
+    generator = numpy.random.Generator(numpy.random.PCG64(0))
+    lon = generator.uniform(-180, 180, 10000)
+    lat = generator.uniform(-90, 90, 10000)
+    values = numpy.arange(10000, dtype=numpy.float64)
+    index = geohash.Index(12)
+    assert index.precision == 12
+    assert not index
+    index.packing(lon, lat, values)
+    assert len(index) == 10000
+    assert 0 < index.cells() <= 4096
+
+    # The neighbors found are the ones of the RTree.
+    mesh = RTree()
+    mesh.packing(numpy.vstack((lon, lat)).T, values)
+    points_lon = generator.uniform(-180, 180, 500)
+    points_lat = generator.uniform(-90, 90, 500)
+    distances, data = index.query(points_lon, points_lat, k=4)
+    expected, _ = mesh.query(numpy.vstack((points_lon, points_lat)).T, k=4)
+    assert numpy.allclose(distances, expected)
+
+    # The missing neighbors are set to -1.
+    distances, data = index.query(points_lon, points_lat, k=4, radius=100_000)
+    assert numpy.all((distances <= 100_000) & (distances >= -1))
+    assert numpy.all((distances == -1) == (data == -1))
+
+    path = str(tmp_path / "geohash.idx")
+    index.save(path)
+    other = geohash.Index.load(path)
+    assert other.precision == 12
+    assert len(other) == len(index)
+    assert numpy.all(
+        other.query(points_lon, points_lat)[1] == index.query(
+            points_lon, points_lat)[1])
+
+    other = pickle.loads(pickle.dumps(index))
+    assert len(other) == len(index)
+    assert numpy.all(
+        other.query(points_lon, points_lat)[0] == index.query(
+            points_lon, points_lat)[0])
+
+    with open(path, "wb") as stream:
+        stream.write(b"0" * 64)
+    with pytest.raises(ValueError):
+        geohash.Index.load(path)
+    with pytest.raises(ValueError):
+        geohash.Index(0)
+    with pytest.raises(ValueError):
+        geohash.Index(12, dtype=numpy.int8)
+    with pytest.raises(ValueError):
+        index.packing(lon, lat[:10], values)
+
+
+def _ecef(lon, lat):
+    """Converts WGS-84 coordinates to ECEF coordinates."""
+    a, f = 6378137.0, 1 / 298.257223563
+    e2 = f * (2 - f)
+    lon, lat = numpy.radians(lon), numpy.radians(lat)
+    n = a / numpy.sqrt(1 - e2 * numpy.sin(lat)**2)
+    return numpy.vstack((n * numpy.cos(lat) * numpy.cos(lon),
+                         n * numpy.cos(lat) * numpy.sin(lon),
+                         n * (1 - e2) * numpy.sin(lat))).T
+
+
+def test_join():
+    generator = numpy.random.Generator(numpy.random.PCG64(0))
+    lon1 = generator.uniform(-180, 180, 500)
+    lat1 = generator.uniform(-90, 90, 500)
+    lon2 = generator.uniform(-180, 180, 2000)
+    lat2 = generator.uniform(-90, 90, 2000)
+    lon1[0], lat1[1] = 179.999, 89.999
+
+    # Brute force solution.
+    x1, x2 = _ecef(lon1, lat1), _ecef(lon2, lat2)
+    distances = numpy.sqrt(((x1[:, None, :] - x2[None, :, :])**2).sum(axis=2))
+    first, second = numpy.nonzero(distances <= 500_000)
+
+    for precision in [None, 5, 15]:
+        chunks = list(
+            geohash.join(lon1,
+                         lat1,
+                         lon2,
+                         lat2,
+                         500_000,
+                         precision=precision,
+                         chunk_size=128))
+        assert len(chunks) == 4
+        lhs = numpy.concatenate([item[0] for item in chunks])
+        rhs = numpy.concatenate([item[1] for item in chunks])
+        dist = numpy.concatenate([item[2] for item in chunks])
+        assert numpy.all(numpy.diff(lhs) >= 0)
+        assert numpy.allclose(dist, distances[lhs, rhs])
+        assert sorted(zip(lhs, rhs)) == sorted(zip(first, second))
+
+    index = geohash.Index(10)
+    index.packing(lon2, lat2, numpy.arange(2000))
+    lhs, values, dist = index.within(lon1, lat1, 500_000)
+    assert len(lhs) == len(first)
+    assert numpy.allclose(dist, distances[lhs, values.astype(int)])
+
+    with pytest.raises(ValueError):
+        list(geohash.join(lon1, lat1[:10], lon2, lat2, 1000))
+    with pytest.raises(ValueError):
+        list(geohash.join(lon1, lat1, lon2, lat2, -1))
@@ -10344,3 +10344,48 @@ def test_neighbors():
 
         code = GeoHash(lon, lat, len(hash_str))
         assert [str(item) for item in code.neighbors()] == hash_str_neighbors
+
+
+def test_neighbors_antimeridian():
+    # The east and west neighbors of the cells touching the antimeridian are
+    # on the other side of it. The neighbors are listed in the order N, NE,
+    # E, SE, S, SW, W, NW.
+    east = geohash.int64.encode(np.array([179.0]), np.array([10.0]), 10)[0]
+    west = geohash.int64.encode(np.array([-179.0]), np.array([10.0]), 10)[0]
+    assert east == 939
+    assert west == 257
+    assert list(geohash.int64.neighbors(int(east), 10)) == [
+        942, 260, 257, 256, 938, 936, 937, 940
+    ]
+    assert list(geohash.int64.neighbors(int(west), 10)) == [
+        260, 262, 259, 258, 256, 938, 939, 942
+    ]
+
+
+def test_neighbors_rings():
+    for bits in (24, 42, 48):
+        selected = [item for item in cases if item[3] == bits]
+        hashes = np.array([item[2] for item in selected], dtype="uint64")
+        result = geohash.int64.neighbors(hashes, bits, rings=1)
+        assert result.shape == (len(selected), 9)
+        for ix, item in enumerate(selected):
+            assert list(result[ix]) == sorted(set(item[4] + [item[2]]))
+
+        # The second ring is made of the neighbors of the first one.
+        result = geohash.int64.neighbors(hashes, bits, rings=2)
+        assert result.shape == (len(selected), 25)
+        for ix, item in enumerate(selected):
+            expected = set()
+            for code in item[4] + [item[2]]:
+                expected.update(geohash.int64.neighbors(int(code), bits))
+            assert list(result[ix]) == sorted(expected)
+
+    # The cells beyond the poles do not exist and the longitudes wrap around
+    # the globe.
+    hashes = geohash.int64.encode(np.array([179.9, 0.0]),
+                                  np.array([0.0, 89.9]), 10)
+    result = geohash.int64.neighbors(hashes, 10)
+    assert list(result[0]) == sorted(
+        set(geohash.int64.neighbors(int(hashes[0]), 10)) | {hashes[0]})
+    assert np.sum(result[1] != np.iinfo("uint64").max) == 6
+    assert geohash.int64.neighbors(hashes, 2, rings=4).shape == (2, 81)
@@ -8,8 +8,10 @@ import pytest
 import numpy as np
 import xarray as xr
 from ..backends import xarray as xr_backend
-from .. import core
-from .. import Axis, Grid2D, Grid3D, bicubic
+from .. import core, fill
+from .. import (Axis, Grid2D, Grid3D, Grid4D, bicubic, bivariate,
+                bivariate_plan, precompute_bicubic, prepare_bivariate,
+                trivariate)
 from . import grid2d_path, make_or_compare_reference
 
 
@@ -178,6 +180,234 @@ def test_bicubic(pytestconfig):
     assert isinstance(z, np.ndarray)
 
 
+def test_precompute_bicubic():
+    grid = xr_backend.Grid2D(xr.load_dataset(grid2d_path()).mss)
+
+    lon = np.arange(-180, 180, 1) + 1 / 3.0
+    lat = np.arange(-90, 90, 1) + 1 / 3.0
+    x, y = np.meshgrid(lon, lat, indexing="ij")
+
+    for fitting_model in ['linear', 'bicubic', 'c_spline']:
+        expected = bicubic(grid,
+                           x.ravel(),
+                           y.ravel(),
+                           fitting_model=fitting_model)
+        precompute_bicubic(grid, fitting_model=fitting_model)
+        z = bicubic(grid, x.ravel(), y.ravel(), fitting_model=fitting_model)
+        np.testing.assert_allclose(z, expected, rtol=1e-9, atol=1e-12)
+
+    with pytest.raises(ValueError):
+        precompute_bicubic(grid, fitting_model='akima')
+
+
+def test_output_buffer():
+    grid = xr_backend.Grid2D(xr.load_dataset(grid2d_path()).mss)
+
+    lon = np.arange(-180, 180, 1) + 1 / 3.0
+    lat = np.arange(-90, 90, 1) + 1 / 3.0
+    x, y = np.meshgrid(lon, lat, indexing="ij")
+    x, y = x.ravel(), y.ravel()
+
+    out = np.empty(x.shape)
+    z = bivariate(grid, x, y, out=out)
+    assert z is out
+    np.testing.assert_equal(out, bivariate(grid, x, y))
+
+    out[:] = 0
+    z = bicubic(grid, x, y, out=out)
+    assert z is out
+    np.testing.assert_equal(out, bicubic(grid, x, y))
+
+    # The buffer is not converted: it must match exactly the result.
+    with pytest.raises(ValueError):
+        bivariate(grid, x, y, out=np.empty(x.shape, dtype=np.float32))
+    with pytest.raises(ValueError):
+        bivariate(grid, x, y, out=np.empty(x.size + 1))
+    with pytest.raises(ValueError):
+        bivariate(grid, x, y, out=np.empty(x.size * 2)[::2])
+    readonly = np.empty(x.shape)
+    readonly.flags.writeable = False
+    with pytest.raises(ValueError):
+        bivariate(grid, x, y, out=readonly)
+
+
+def test_strided_inputs():
+    grid = xr_backend.Grid2D(xr.load_dataset(grid2d_path()).mss)
+
+    lon = np.arange(-180, 180, 1) + 1 / 3.0
+    lat = np.arange(-90, 90, 1) + 1 / 3.0
+    x, y = np.meshgrid(lon, lat, indexing="ij")
+    points = np.empty(x.size, dtype=[("flag", "i1"), ("lon", "f4"),
+                                     ("lat", "f8")])
+    points["lon"] = x.ravel()
+    points["lat"] = y.ravel()
+
+    # The fields of the structured array are read in place.
+    expected = bivariate(grid, points["lon"].astype("f8"),
+                         points["lat"].copy())
+    np.testing.assert_equal(
+        bivariate(grid, points["lon"], points["lat"]), expected)
+    expected = bicubic(grid, points["lon"].astype("f8"), points["lat"].copy())
+    np.testing.assert_equal(bicubic(grid, points["lon"], points["lat"]),
+                            expected)
+
+    # Integers are converted.
+    xi = np.arange(-170, 170, dtype=np.int64)
+    yi = np.zeros_like(xi)
+    np.testing.assert_equal(bivariate(grid, xi, yi),
+                            bivariate(grid, xi.astype("f8"), yi.astype("f8")))
+
+
+def test_chunked_interpolator():
+    array = xr.load_dataset(grid2d_path()).mss
+    expected = xr_backend.RegularGridInterpolator(array)
+    interpolator = xr_backend.RegularGridInterpolator(
+        array.chunk(dict(lon=100, lat=50)), chunked=True)
+    assert interpolator.ndim == 2
+    with pytest.raises(AttributeError):
+        interpolator.grid
+
+    lon = np.arange(-180, 180, 1) + 1 / 3.0
+    lat = np.arange(-90, 90, 1) + 1 / 3.0
+    x, y = np.meshgrid(lon, lat, indexing="ij")
+    coords = dict(lon=x.ravel(), lat=y.ravel())
+    for method in ["bilinear", "bicubic"]:
+        np.testing.assert_allclose(interpolator(coords, method=method),
+                                   expected(coords, method=method),
+                                   rtol=1e-10,
+                                   equal_nan=True)
+    np.testing.assert_allclose(
+        interpolator(coords,
+                     method="bicubic",
+                     bicubic_kwargs=dict(nx=5, ny=5, boundary="sym")),
+        expected(coords,
+                 method="bicubic",
+                 bicubic_kwargs=dict(nx=5, ny=5, boundary="sym")),
+        rtol=1e-10,
+        equal_nan=True)
+    assert interpolator(dict(lon=x, lat=y)).shape == x.shape
+
+
+def test_view():
+    generator = np.random.Generator(np.random.PCG64(0))
+    lon = np.arange(-180, 180, 1.0)
+    # The Y axis is irregular.
+    lat = np.sort(generator.uniform(-89, 89, 180))
+    array = generator.uniform(0, 1, (len(lon), len(lat)))
+    grid = Grid2D(Axis(lon, is_circle=True), Axis(lat), array)
+    view = grid.view(slice(100, 200), slice(30, 90))
+    assert isinstance(view, Grid2D)
+    assert np.shares_memory(view.array, array)
+    assert view.array.shape == (100, 60)
+    assert view.x == Axis(lon[100:200])
+    assert view.y == Axis(lat[30:90])
+    assert not view.x.is_circle
+
+    # Inside the region, the view is interpolated as the whole grid.
+    x, y = np.meshgrid(np.linspace(lon[105], lon[194], 50),
+                       np.linspace(lat[35], lat[84], 50),
+                       indexing="ij")
+    x, y = x.ravel(), y.ravel()
+    for interpolator in ["bilinear", "nearest"]:
+        np.testing.assert_equal(
+            bivariate(view, x, y, interpolator=interpolator),
+            bivariate(grid, x, y, interpolator=interpolator))
+    np.testing.assert_equal(bicubic(view, x, y), bicubic(grid, x, y))
+    assert np.all(np.isnan(bivariate(view, x + 180, y)))
+
+    # A view of a view.
+    other = view.view(slice(10, 20), slice(-10, None))
+    assert other.x == Axis(lon[110:120])
+    assert other.y == Axis(lat[80:90])
+    other = pickle.loads(pickle.dumps(other))
+    assert other.y == Axis(lat[80:90])
+
+    with pytest.raises(ValueError):
+        grid.view(slice(0, 10, 2), slice(None))
+    with pytest.raises(ValueError):
+        grid.view(slice(10, 10), slice(None))
+    with pytest.raises(TypeError):
+        Grid2D(grid.x, grid.y, array, tiled=True).view(slice(None),
+                                                       slice(None))
+
+    array = np.zeros((len(lon), len(lat), 4))
+    grid = Grid3D(Axis(lon, is_circle=True), Axis(lat), Axis(np.arange(4.0)),
+                  array)
+    view = grid.view(slice(None), slice(0, 2), slice(1, 3))
+    assert view.x.is_circle
+    assert view.z == Axis(np.arange(1.0, 3.0))
+    view.array[...] = 1
+    assert array.sum() == view.array.size
+
+
+def test_bivariate_plan():
+    grid = xr_backend.Grid2D(xr.load_dataset(grid2d_path()).mss)
+
+    lon = np.arange(-180, 180, 1) + 1 / 3.0
+    lat = np.arange(-90, 90, 1) + 1 / 3.0
+    x, y = np.meshgrid(lon, lat, indexing="ij")
+    x = np.append(x.ravel(), [0, 180])
+    y = np.append(y.ravel(), [1000, 0])
+
+    for interpolator in ["bilinear", "nearest", "inverse_distance_weighting"]:
+        plan = bivariate_plan(grid, x, y, interpolator=interpolator)
+        assert len(plan) == x.size
+        assert plan.shape == grid.array.shape
+        expected = bivariate(grid, x, y, interpolator=interpolator)
+        np.testing.assert_allclose(plan.apply(grid.array), expected)
+
+        # The plan is applied to other values defined on the same axes.
+        array = grid.array * 2 + 1
+        other = Grid2D(grid.x, grid.y, array)
+        np.testing.assert_allclose(
+            plan.apply(array.astype("float32")),
+            bivariate(other, x, y, interpolator=interpolator),
+            rtol=1e-6)
+
+        other = pickle.loads(pickle.dumps(plan))
+        np.testing.assert_array_equal(other.indptr, plan.indptr)
+        np.testing.assert_array_equal(other.indices, plan.indices)
+        np.testing.assert_array_equal(other.weights, plan.weights)
+
+    # The nearest neighbor uses a single value per point, and no value is
+    # used by the point outside the grid.
+    plan = bivariate_plan(grid, x, y, interpolator="nearest")
+    count = np.diff(plan.indptr)
+    assert count[-2] == 0
+    assert np.all(np.delete(count, -2) == 1)
+
+    out = np.empty(x.size)
+    assert plan.apply(grid.array, out=out) is out
+
+    with pytest.raises(ValueError):
+        plan.apply(grid.array[:-1, :])
+
+    with pytest.raises(ValueError):
+        bivariate_plan(grid, x, y, bounds_error=True)
+
+
+def test_fill_holes():
+    grid = xr_backend.Grid2D(xr.load_dataset(grid2d_path()).mss)
+    filled = Grid2D(grid.x, grid.y, fill.loess(grid, nx=3, ny=3))
+
+    lon = np.arange(-180, 180, 1) + 1 / 3.0
+    lat = np.arange(-80, 80, 1) + 1 / 3.0
+    x, y = np.meshgrid(lon, lat, indexing="ij")
+    x, y = x.ravel(), y.ravel()
+
+    # The undefined values read are filled as the whole grid would be.
+    z = bivariate(grid, x, y, fill_holes=(3, 3))
+    assert np.isnan(bivariate(grid, x, y)).any()
+    assert not np.isnan(z).any()
+    np.testing.assert_allclose(z, bivariate(filled, x, y), rtol=1e-12)
+
+    z = bicubic(grid, x, y, fill_holes=(3, 3))
+    np.testing.assert_allclose(z, bicubic(filled, x, y), rtol=1e-12)
+
+    with pytest.raises(ValueError):
+        bivariate(grid, x, y, fill_holes=(0, 3))
+
+
 def test_grid_2d_int8(pytestconfig):
     dump = pytestconfig.getoption("dump")
     mss = grid2d_path()
@@ -198,3 +428,248 @@ def test_grid_2d_int8(pytestconfig):
                      method="nearest")
     make_or_compare_reference("nearest_int8.npy", z, dump)
     assert np.mean(z) != 0
+
+
+def test_grid_packed():
+    x_axis = Axis(np.arange(-180.0, 180.0, 1.0), is_circle=True)
+    y_axis = Axis(np.arange(-80.0, 80.0, 1.0))
+    z_axis = Axis(np.arange(0.0, 4.0, 1.0))
+    generator = np.random.Generator(np.random.PCG64(0))
+    packed = generator.integers(-1000,
+                                1000,
+                                size=(len(x_axis), len(y_axis), len(z_axis)),
+                                dtype=np.int16)
+    packed[10:20, 10:20, :] = -32767
+    values = np.where(packed == -32767, np.nan, packed * 0.01 + 20.0)
+
+    grid = Grid2D(x_axis,
+                  y_axis,
+                  packed[:, :, 0],
+                  scale_factor=0.01,
+                  add_offset=20.0,
+                  fill_value=-32767)
+    assert isinstance(grid._instance, core.Grid2DInt16)
+    assert grid.array.dtype == np.int16
+    assert grid._instance.scale_factor == 0.01
+    assert grid._instance.fill_value == -32767
+    expected = Grid2D(x_axis, y_axis, values[:, :, 0])
+
+    x = generator.uniform(-180, 180, 1000)
+    y = generator.uniform(-80, 79, 1000)
+    np.testing.assert_allclose(bivariate(grid, x, y),
+                               bivariate(expected, x, y),
+                               rtol=1e-12)
+    np.testing.assert_allclose(bicubic(grid, x, y),
+                               bicubic(expected, x, y),
+                               rtol=1e-12)
+    assert np.isnan(bivariate(grid, np.array([-165.5]), np.array([-65.5])))
+
+    other = pickle.loads(pickle.dumps(grid))
+    assert isinstance(other._instance, core.Grid2DInt16)
+    np.testing.assert_array_equal(other.array, grid.array)
+    np.testing.assert_array_equal(bivariate(other, x, y),
+                                  bivariate(grid, x, y))
+
+    with pytest.raises(ValueError):
+        precompute_bicubic(grid)
+    with pytest.raises(ValueError):
+        Grid2D(x_axis, y_axis, values[:, :, 0], scale_factor=0.01)
+
+    # The half-precision values are decoded exactly.
+    grid = Grid2D(x_axis, y_axis, values[:, :, 0].astype(np.float16))
+    assert isinstance(grid._instance, core.Grid2DFloat16)
+    assert grid.array.dtype == np.float16
+    expected = Grid2D(x_axis, y_axis,
+                      values[:, :, 0].astype(np.float16).astype(np.float64))
+    np.testing.assert_array_equal(bivariate(grid, x, y),
+                                  bivariate(expected, x, y))
+
+    z = generator.uniform(0, 3, 1000)
+    grid = Grid3D(x_axis,
+                  y_axis,
+                  z_axis,
+                  packed,
+                  scale_factor=0.01,
+                  add_offset=20.0,
+                  fill_value=-32767)
+    assert isinstance(grid._instance, core.Grid3DInt16)
+    expected = Grid3D(x_axis, y_axis, z_axis, values)
+    np.testing.assert_allclose(trivariate(grid, x, y, z),
+                               trivariate(expected, x, y, z),
+                               rtol=1e-12)
+    np.testing.assert_allclose(bicubic(grid, x, y, z),
+                               bicubic(expected, x, y, z),
+                               rtol=1e-12)
+
+    with pytest.raises(ValueError):
+        Grid4D(x_axis, y_axis, z_axis, z_axis,
+               packed[..., np.newaxis].astype(np.float16))
+
+
+def test_grid_tiled():
+    x_axis = Axis(np.arange(-180.0, 180.0, 1.0), is_circle=True)
+    y_axis = Axis(np.arange(-80.0, 80.0, 1.0))
+    generator = np.random.Generator(np.random.PCG64(0))
+    values = generator.uniform(-1, 1, size=(len(x_axis), len(y_axis)))
+    values[10:20, 10:20] = np.nan
+
+    grid = Grid2D(x_axis, y_axis, values, tiled=True)
+    assert isinstance(grid._instance, core.TiledGrid2DFloat64)
+    np.testing.assert_array_equal(grid.array, values)
+    expected = Grid2D(x_axis, y_axis, values)
+
+    x = generator.uniform(-180, 180, 1000)
+    y = generator.uniform(-80, 79, 1000)
+    np.testing.assert_array_equal(bivariate(grid, x, y),
+                                  bivariate(expected, x, y))
+    np.testing.assert_array_equal(bicubic(grid, x, y),
+                                  bicubic(expected, x, y))
+    np.testing.assert_allclose(fill.loess(grid),
+                               fill.loess(expected),
+                               rtol=1e-12)
+
+    other = pickle.loads(pickle.dumps(grid))
+    assert isinstance(other._instance, core.TiledGrid2DFloat64)
+    np.testing.assert_array_equal(other.array, values)
+
+    grid = Grid2D(x_axis, y_axis, values.astype(np.float32), tiled=True)
+    assert isinstance(grid._instance, core.TiledGrid2DFloat32)
+
+    with pytest.raises(ValueError):
+        precompute_bicubic(grid)
+    with pytest.raises(ValueError):
+        Grid2D(x_axis, y_axis, values.astype(np.float16), tiled=True)
+
+
+def test_single_precision():
+    x_axis = Axis(np.arange(-180.0, 180.0, 0.25), is_circle=True)
+    y_axis = Axis(np.arange(-80.0, 80.0, 0.25))
+    generator = np.random.Generator(np.random.PCG64(0))
+    values = generator.uniform(-300, 300, size=(len(x_axis), len(y_axis)))
+    grid = Grid2D(x_axis, y_axis, values.astype(np.float32))
+
+    x = generator.uniform(-180, 180, 10000).astype(np.float32)
+    y = generator.uniform(-80, 79, 10000).astype(np.float32)
+    expected = bivariate(grid, x, y)
+    z = bivariate(grid, x, y, single_precision=True)
+    assert z.dtype == np.float32
+    # Documented bound: eps * (|x| / dx + |y| / dy) * |dq| + 4 * eps * |q|
+    eps = np.finfo(np.float32).eps
+    bound = eps * ((np.abs(x) + np.abs(y)) / 0.25 * 600 + 4 * 300)
+    assert np.all(np.abs(z - expected) <= bound)
+
+    out = np.empty(x.shape, dtype=np.float32)
+    assert bivariate(grid, x, y, out=out, single_precision=True) is out
+
+    with pytest.raises(ValueError):
+        bivariate(grid, x.astype(np.float64), y, single_precision=True)
+    with pytest.raises(ValueError):
+        bivariate(Grid2D(x_axis, y_axis, values), x, y, single_precision=True)
+
+
+def test_pickle_out_of_band():
+    x_axis = Axis(np.arange(-180.0, 180.0, 1.0), is_circle=True)
+    y_axis = Axis(np.sort(np.random.uniform(-80, 80, 100)))
+    values = np.random.random((len(x_axis), len(y_axis)))
+    grid = Grid2D(x_axis, y_axis, values)
+
+    # The values of the grid and of the irregular axis are not copied into
+    # the pickle.
+    buffers = []
+    data = pickle.dumps(grid, protocol=5, buffer_callback=buffers.append)
+    assert len(buffers) == 2
+    assert len(data) < values.nbytes
+    other = pickle.loads(data, buffers=buffers)
+    assert other.y == y_axis
+    np.testing.assert_array_equal(other.array, values)
+
+    # The buffers may be read-only, like those of a shared memory.
+    buffers = [memoryview(buffer).toreadonly() for buffer in buffers]
+    other = pickle.loads(data, buffers=buffers)
+    np.testing.assert_array_equal(other.array, values)
+    assert other.y == y_axis
+
+
+def test_prepare_bivariate():
+    grid = xr_backend.Grid2D(xr.load_dataset(grid2d_path()).mss)
+    lon = np.arange(-180, 180, 1) + 1 / 3.0
+    lat = np.arange(-80, 80, 1) + 1 / 3.0
+    x, y = np.meshgrid(lon, lat, indexing="ij")
+    x, y = x.ravel(), y.ravel()
+
+    for interpolator in ["bilinear", "nearest", "inverse_distance_weighting"]:
+        interpolate = prepare_bivariate(grid, interpolator, num_threads=1)
+        assert isinstance(interpolate, core.PreparedBivariate)
+        np.testing.assert_array_equal(
+            interpolate(x, y),
+            bivariate(grid, x, y, interpolator, num_threads=1))
+
+    # The grid is kept alive by the interpolation prepared.
+    interpolate = prepare_bivariate(
+        Grid2D(grid.x, grid.y, grid.array.astype(np.float32)),
+        single_precision=True)
+    z = interpolate(x.astype(np.float32), y.astype(np.float32))
+    assert z.dtype == np.float32
+    out = np.empty(x.shape, dtype=np.float32)
+    assert interpolate(x, y, out) is out
+
+    interpolate = prepare_bivariate(grid, fill_holes=(3, 3))
+    np.testing.assert_array_equal(interpolate(x, y),
+                                  bivariate(grid, x, y, fill_holes=(3, 3)))
+
+    with pytest.raises(ValueError):
+        prepare_bivariate(grid, single_precision=True)
+    with pytest.raises(ValueError):
+        prepare_bivariate(grid, bounds_error=True)(np.array([0.0]),
+                                                   np.array([1000.0]))
+
+
+def test_derivatives():
+    lon = np.arange(0, 10, 0.5)
+    lat = np.arange(0, 5, 0.25)
+    mx, my = np.meshgrid(lon, lat, indexing="ij")
+    grid = Grid2D(Axis(lon), Axis(lat), np.sin(mx * 0.3) * np.cos(my * 0.5))
+
+    x = np.random.uniform(2, 7, 100)
+    y = np.random.uniform(1, 3.5, 100)
+    h = 1e-6
+    for fitting_model in ["bicubic", "c_spline", "akima"]:
+        z, dx, dy = bicubic(grid, x, y, fitting_model=fitting_model,
+                            derivatives=True)
+        np.testing.assert_allclose(
+            z, bicubic(grid, x, y, fitting_model=fitting_model))
+        np.testing.assert_allclose(
+            dx, (bicubic(grid, x + h, y, fitting_model=fitting_model) -
+                 bicubic(grid, x - h, y, fitting_model=fitting_model)) /
+            (2 * h),
+            atol=1e-5)
+        np.testing.assert_allclose(
+            dy, (bicubic(grid, x, y + h, fitting_model=fitting_model) -
+                 bicubic(grid, x, y - h, fitting_model=fitting_model)) /
+            (2 * h),
+            atol=1e-5)
+        np.testing.assert_allclose(dx,
+                                   0.3 * np.cos(x * 0.3) * np.cos(y * 0.5),
+                                   atol=1e-2)
+
+    # The derivatives of the polynomials precomputed for the cells.
+    precompute_bicubic(grid)
+    z, dx, dy = bicubic(grid, x, y, derivatives=True)
+    np.testing.assert_allclose(z, bicubic(grid, x, y))
+    np.testing.assert_allclose(
+        dy, -0.5 * np.sin(x * 0.3) * np.sin(y * 0.5), atol=1e-2)
+
+    out = (np.empty(x.shape), np.empty(x.shape), np.empty(x.shape))
+    result = bivariate(grid, x, y, derivatives=True, out=out)
+    assert all(item is expected for item, expected in zip(result, out))
+    z, dx, dy = result
+    np.testing.assert_allclose(z, bivariate(grid, x, y))
+    np.testing.assert_allclose(
+        dx, (bivariate(grid, x + h, y) - bivariate(grid, x - h, y)) / (2 * h),
+        atol=1e-6)
+    np.testing.assert_allclose(
+        dy, (bivariate(grid, x, y + h) - bivariate(grid, x, y - h)) / (2 * h),
+        atol=1e-6)
+
+    with pytest.raises(ValueError):
+        bivariate(grid, x, y, interpolator="nearest", derivatives=True)
@@ -9,7 +9,8 @@ import pytest
 import numpy as np
 import xarray as xr
 from ..backends import xarray as xr_backend
-from .. import Axis, Grid3D, TemporalAxis
+from .. import (Axis, ChunkedGrid3D, Grid3D, TemporalAxis, bicubic,
+                trivariate)
 from . import grid3d_path
 
 
@@ -97,3 +98,157 @@ def test_backend():
                                 latitude=y.ravel(),
                                 time=t.ravel()))
     assert np.allclose(z0, z1)
+
+
+def test_chunked_3d():
+    x_axis = Axis(np.arange(-180.0, 180.0, 1.0), is_circle=True)
+    y_axis = Axis(np.arange(-80.0, 80.0, 1.0))
+    z_axis = Axis(np.arange(0.0, 10.0, 1.0))
+    generator = np.random.Generator(np.random.PCG64(0))
+    array = generator.normal(size=(len(x_axis), len(y_axis), len(z_axis)))
+    keys = []
+
+    def reader(key):
+        keys.append(key)
+        return array[key]
+
+    grid = Grid3D(x_axis, y_axis, z_axis, array)
+    chunked = ChunkedGrid3D(x_axis,
+                            y_axis,
+                            z_axis,
+                            chunks=(64, 64, 4),
+                            reader=reader,
+                            cache_size=8)
+    assert chunked.chunks == (64, 64, 4)
+    assert chunked.cache_size == 8
+    with pytest.raises(AttributeError):
+        chunked.array
+
+    # The points are located in a few chunks: only these chunks are read.
+    x = generator.uniform(-10, 10, 1000)
+    y = generator.uniform(-10, 10, 1000)
+    z = generator.uniform(0, 3, 1000)
+    expected = trivariate(grid, x, y, z)
+    np.testing.assert_array_equal(trivariate(chunked, x, y, z), expected)
+    np.testing.assert_array_equal(
+        trivariate(chunked, x, y, z, num_threads=1), expected)
+    assert 0 < chunked.cached() <= 8
+    assert len(keys) <= 8 * 4
+    assert all(array[key].shape == (64, 64, 4) for key in keys)
+
+    x = generator.uniform(-180, 180, 1000)
+    y = generator.uniform(-79, 79, 1000)
+    z = generator.uniform(0, 9, 1000)
+    np.testing.assert_array_equal(trivariate(chunked, x, y, z),
+                                  trivariate(grid, x, y, z))
+    np.testing.assert_array_equal(bicubic(chunked, x, y, z),
+                                  bicubic(grid, x, y, z))
+    assert chunked.cached() <= 8
+    chunked.clear_cache()
+    assert chunked.cached() == 0
+
+    with pytest.raises(ValueError):
+        trivariate(chunked, x, y, z + 20, bounds_error=True)
+
+    def broken(key):
+        raise RuntimeError("unreadable chunk")
+
+    chunked = ChunkedGrid3D(x_axis, y_axis, z_axis, (64, 64, 4), broken)
+    with pytest.raises(RuntimeError):
+        trivariate(chunked, x, y, z)
+
+
+def test_chunked_3d_order():
+    x_axis = Axis(np.arange(-180.0, 180.0, 1.0), is_circle=True)
+    y_axis = Axis(np.arange(-80.0, 80.0, 1.0))
+    z_axis = Axis(np.arange(0.0, 10.0, 1.0))
+    generator = np.random.Generator(np.random.PCG64(0))
+    array = generator.normal(size=(len(x_axis), len(y_axis), len(z_axis)))
+    keys = []
+
+    def reader(key):
+        keys.append(key)
+        return array[key]
+
+    # 6 x 3 x 3 chunks, of which only 8 are kept in memory.
+    chunked = ChunkedGrid3D(x_axis,
+                            y_axis,
+                            z_axis,
+                            chunks=(64, 64, 4),
+                            reader=reader,
+                            cache_size=8)
+    x = generator.uniform(-180, 179, 1000)
+    y = generator.uniform(-80, 79, 1000)
+    z = generator.uniform(0, 9, 1000)
+    x[::10] = np.nan
+
+    # The scattered points are interpolated chunk by chunk, so that each
+    # chunk is read about once instead of once per point.
+    expected = trivariate(Grid3D(x_axis, y_axis, z_axis, array), x, y, z)
+    np.testing.assert_array_equal(
+        trivariate(chunked, x, y, z, num_threads=1), expected)
+    assert len(keys) < 2 * 54
+
+
+def test_3d_dates():
+    grid = xr_backend.Grid3D(xr.load_dataset(grid3d_path()).tcw,
+                             increasing_axes=True)
+    lon = np.arange(-180, 180, 10) + 1 / 3.0
+    lat = np.arange(-90, 90, 10) + 1 / 3.0
+    time = np.array([
+        datetime.datetime(2002, 7, 2, 15, 0),
+        datetime.datetime(2002, 7, 2, 17, 30)
+    ],
+                    dtype="datetime64[s]")
+    x, y, t = np.meshgrid(lon, lat, time, indexing="ij")
+    x, y, t = x.ravel(), y.ravel(), t.ravel()
+
+    # The dates are converted to the resolution of the axis when they are
+    # read, as numpy does.
+    expected = trivariate(grid, x, y, grid.z.safe_cast(t).astype("int64"))
+    np.testing.assert_array_equal(trivariate(grid, x, y, t), expected)
+    z = grid.trivariate(
+        collections.OrderedDict(longitude=x, latitude=y, time=t))
+    np.testing.assert_array_equal(z, expected)
+
+    # The months cannot be converted without a calendar.
+    t = t.astype("datetime64[M]")
+    expected = trivariate(grid, x, y, grid.z.safe_cast(t).astype("int64"))
+    np.testing.assert_array_equal(trivariate(grid, x, y, t), expected)
+
+    with pytest.raises(RuntimeError):
+        trivariate(grid, x, y, t - t)
+
+
+def test_3d_fields():
+    grid = xr_backend.Grid3D(xr.load_dataset(grid3d_path()).tcw,
+                             increasing_axes=True)
+    other = Grid3D(grid.x, grid.y, grid.z, grid.array * 2 + 1)
+    lon = np.arange(-180, 180, 10) + 1 / 3.0
+    lat = np.arange(-90, 90, 10) + 1 / 3.0
+    time = np.array([datetime.datetime(2002, 7, 2, 15, 0)], dtype="datetime64")
+    x, y, t = np.meshgrid(lon, lat, time, indexing="ij")
+    x, y, t = x.ravel(), y.ravel(), t.ravel()
+
+    for interpolator in ["bilinear", "nearest", "inverse_distance_weighting"]:
+        z = trivariate([grid, other], x, y, t, interpolator=interpolator)
+        assert z.shape == (2, x.size)
+        np.testing.assert_array_equal(
+            z[0], trivariate(grid, x, y, t, interpolator=interpolator))
+        np.testing.assert_array_equal(
+            z[1], trivariate(other, x, y, t, interpolator=interpolator))
+
+    out = np.empty((2, x.size))
+    assert trivariate((grid, other), x, y, t, out=out) is out
+
+    with pytest.raises(ValueError):
+        trivariate([], x, y, t)
+
+    with pytest.raises(ValueError):
+        trivariate([grid, other], x, y, t, out=np.empty(x.size))
+
+    # The grids must share the same axes.
+    shifted = Grid3D(Axis(grid.x[:] + 0.5, is_circle=True), grid.y, grid.z,
+                     grid.array)
+    with pytest.raises(ValueError):
+        trivariate([grid, shifted], x, y, t)
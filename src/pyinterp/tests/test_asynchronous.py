@@ -0,0 +1,69 @@
+# Copyright (c) 2022 CNES
+#
+# All rights reserved. Use of this source code is governed by a
+# BSD-style license that can be found in the LICENSE file.
+import asyncio
+import concurrent.futures
+import numpy as np
+import xarray as xr
+from ..backends import xarray as xr_backend
+from .. import asynchronous, bicubic, bivariate
+from . import grid2d_path
+from .test_rtree import build_rtree
+
+
+def load_data():
+    grid = xr_backend.Grid2D(xr.load_dataset(grid2d_path()).mss)
+    lon = np.arange(-180, 180, 1) + 1 / 3.0
+    lat = np.arange(-90, 90, 1) + 1 / 3.0
+    x, y = np.meshgrid(lon, lat, indexing="ij")
+    return grid, x.ravel(), y.ravel()
+
+
+def test_interpolation():
+    grid, x, y = load_data()
+    expected = bivariate(grid, x, y)
+
+    future = asynchronous.bivariate_async(grid, x, y)
+    assert isinstance(future, concurrent.futures.Future)
+    assert np.array_equal(future.result(), expected, equal_nan=True)
+
+    out = np.empty_like(x)
+    future = asynchronous.bivariate_async(grid, x, y, out=out)
+    assert future.result() is out
+    assert np.array_equal(out, expected, equal_nan=True)
+
+    with concurrent.futures.ThreadPoolExecutor(max_workers=2) as executor:
+        futures = [
+            asynchronous.bicubic_async(grid, x, y, executor=executor)
+            for _ in range(2)
+        ]
+        expected = bicubic(grid, x, y)
+        for item in futures:
+            assert np.array_equal(item.result(), expected, equal_nan=True)
+
+
+def test_rtree():
+    mesh = build_rtree(dtype=np.float64)
+    lon = np.arange(-180, 180, 10, dtype=np.float64) + 1 / 3.0
+    lat = np.arange(-90, 90, 10, dtype=np.float64) + 1 / 3.0
+    lon, lat = np.meshgrid(lon, lat, indexing="ij")
+    coordinates = np.vstack((lon.ravel(), lat.ravel())).T
+
+    distances, values = mesh.query(coordinates, k=4)
+    future = mesh.query_async(coordinates, k=4)
+    assert np.all(future.result()[0] == distances)
+    assert np.all(future.result()[1] == values)
+
+
+def test_asyncio():
+    grid, x, y = load_data()
+    expected = bivariate(grid, x, y)
+
+    async def interpolate():
+        return await asyncio.wrap_future(
+            asynchronous.bivariate_async(grid, x, y))
+
+    assert np.array_equal(asyncio.run(interpolate()),
+                          expected,
+                          equal_nan=True)
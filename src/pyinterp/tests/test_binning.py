@@ -3,6 +3,7 @@
 # All rights reserved. Use of this source code is governed by a
 # BSD-style license that can be found in the LICENSE file.
 import os
+import pickle
 import pytest
 import dask.array as da
 try:
@@ -13,7 +14,7 @@ except ImportError:
 import numpy as np
 import xarray as xr
 from .. import geodetic
-from .. import Axis, Binning2D
+from .. import Axis, Binning2D, Binning3D, TemporalAxis
 from . import grid2d_path
 
 
@@ -52,6 +53,195 @@ def test_binning2d():
         build_instance(np.int8)
 
 
+def test_binning2d_threads():
+    generator = np.random.Generator(np.random.PCG64(0))
+    x = generator.uniform(-180, 180, 100000)
+    y = generator.uniform(-80, 80, 100000)
+    z = generator.uniform(0, 1, 100000)
+    # A coarse grid uses dense statistics per thread, a fine one hash tables.
+    for step in [20, 0.5]:
+        x_axis = Axis(np.arange(-180, 180, step), is_circle=True)
+        y_axis = Axis(np.arange(-80, 80 + step, step))
+        for simple in [True, False]:
+            binning0 = Binning2D(x_axis, y_axis)
+            binning1 = Binning2D(x_axis, y_axis)
+            binning0.push(x, y, z, simple, num_threads=1)
+            binning1.push(x, y, z, simple, num_threads=4)
+            assert np.all(
+                binning0.variable("count") == binning1.variable("count"))
+            for item in ["min", "max"]:
+                assert np.array_equal(binning0.variable(item),
+                                      binning1.variable(item),
+                                      equal_nan=True)
+            for item in ["mean", "variance", "sum"]:
+                assert np.allclose(binning0.variable(item),
+                                   binning1.variable(item),
+                                   equal_nan=True)
+
+
+def test_binning2d_sparse():
+    generator = np.random.Generator(np.random.PCG64(0))
+    x = generator.uniform(-10, 10, 100000)
+    y = generator.uniform(-10, 10, 100000)
+    z = generator.uniform(0, 1, 100000)
+    # Only a small part of the global grid receives values.
+    x_axis = Axis(np.arange(-180, 180, 0.1), is_circle=True)
+    y_axis = Axis(np.arange(-90, 90.1, 0.1))
+    for simple in [True, False]:
+        dense = Binning2D(x_axis, y_axis)
+        sparse = Binning2D(x_axis, y_axis, sparse=True)
+        assert not dense.sparse
+        assert sparse.sparse
+        dense.push(x, y, z, simple, num_threads=1)
+        sparse.push(x, y, z, simple, num_threads=4)
+        assert np.all(dense.variable("count") == sparse.variable("count"))
+        for item in ["mean", "variance", "sum"]:
+            assert np.allclose(dense.variable(item),
+                               sparse.variable(item),
+                               equal_nan=True)
+
+    other = pickle.loads(pickle.dumps(sparse))
+    assert other.sparse
+    assert np.all(other.variable("count") == sparse.variable("count"))
+    other += dense
+    assert np.all(other.variable("count") == 2 * dense.variable("count"))
+    sparse.clear()
+    assert np.all(sparse.variable("count") == 0)
+
+
+def test_binning2d_kernel():
+    x_values = np.arange(-180, 180, 1.0)
+    y_values = np.arange(-10, 11, 1.0)
+    x_axis = Axis(x_values, is_circle=True)
+    y_axis = Axis(y_values)
+    binning = Binning2D(x_axis, y_axis)
+
+    # A sample is spread over the (2r + 1)² bins around its nearest bin.
+    binning.push_kernel([179.8], [0.0], [2.0], radius=1)
+    weights = binning.variable("sum_of_weights")
+    ix, iy = np.nonzero(weights)
+    assert sorted(set(x_values[ix].tolist())) == [-180, 178, 179]
+    assert sorted(set(y_values[iy].tolist())) == [-1, 0, 1]
+    assert len(ix) == 9
+    assert np.all(binning.variable("mean")[ix, iy] == 2)
+    assert weights[-1, 10] == weights.max()
+
+    generator = np.random.Generator(np.random.PCG64(0))
+    x = generator.uniform(-180, 180, 100000)
+    y = generator.uniform(-10, 10, 100000)
+    z = generator.uniform(0, 1, 100000)
+    for wf in ["gaussian", "boxcar", "lanczos"]:
+        binning0 = Binning2D(x_axis, y_axis)
+        binning1 = Binning2D(x_axis, y_axis, sparse=True)
+        binning0.push_kernel(x, y, z, radius=2, wf=wf, num_threads=1)
+        binning1.push_kernel(x, y, z, radius=2, wf=wf, num_threads=4)
+        assert np.all(binning0.variable("count") > 0)
+        for item in ["mean", "sum_of_weights"]:
+            assert np.allclose(binning0.variable(item),
+                               binning1.variable(item),
+                               equal_nan=True)
+
+    with pytest.raises(ValueError):
+        binning.push_kernel(x, y, z, wf="_")
+    with pytest.raises(ValueError):
+        binning.push_kernel(x, y, z, radius=-1)
+
+
+def test_binning2d_statistics():
+    generator = np.random.Generator(np.random.PCG64(0))
+    x = generator.uniform(-180, 180, 10000)
+    y = generator.uniform(-80, 80, 10000)
+    z = generator.uniform(0, 1, 10000)
+    x_axis = Axis(np.arange(-180, 180, 5), is_circle=True)
+    y_axis = Axis(np.arange(-90, 95, 5))
+    full = Binning2D(x_axis, y_axis)
+    full.push(x, y, z, simple=False)
+    assert full.statistics == "full"
+
+    statistics = {
+        "count": ["count", "sum_of_weights"],
+        "mean": ["count", "sum_of_weights", "mean", "min", "max", "sum"],
+        "variance": ["count", "mean", "variance"],
+    }
+    for level, computed in statistics.items():
+        for dtype in [np.float64, np.float32]:
+            binning = Binning2D(x_axis, y_axis, dtype=dtype, statistics=level)
+            assert binning.statistics == level
+            binning.push(x, y, z, simple=False)
+            for item in computed:
+                assert np.allclose(binning.variable(item),
+                                   full.variable(item),
+                                   rtol=1e-5,
+                                   equal_nan=True)
+            # The statistics not calculated are undefined.
+            assert np.all(np.isnan(binning.variable("kurtosis")))
+
+        other = pickle.loads(pickle.dumps(binning))
+        assert other.statistics == level
+        other += binning
+        assert np.all(
+            other.variable("count") == 2 * binning.variable("count"))
+
+    with pytest.raises(ValueError):
+        Binning2D(x_axis, y_axis, statistics="median")
+
+
+def test_binning3d():
+    generator = np.random.Generator(np.random.PCG64(0))
+    x = generator.uniform(-180, 180, 100000)
+    y = generator.uniform(-80, 80, 100000)
+    z = generator.uniform(0, 1, 100000)
+    dates = np.datetime64("2000-01-01") + generator.integers(
+        0, 365, 100000).astype("timedelta64[D]")
+    months = np.arange("2000-01", "2001-01", dtype="datetime64[M]")
+
+    x_axis = Axis(np.arange(-180, 180, 10), is_circle=True)
+    y_axis = Axis(np.arange(-80, 90, 10))
+    t_axis = TemporalAxis(months.astype("datetime64[D]") + 14)
+    for simple in [True, False]:
+        binning = Binning3D(x_axis, y_axis, t_axis)
+        assert binning.z == t_axis
+        assert isinstance(str(binning), str)
+        binning.push(x, y, dates, z, simple, num_threads=4)
+        count = binning.variable("count")
+        assert count.shape == (len(x_axis), len(y_axis), len(t_axis))
+        mean = binning.variable("mean")
+
+        # Each layer matches the binning of the samples of its month.
+        index = t_axis.find_index(dates, bounded=True)
+        for ix in [0, 5, 11]:
+            mask = index == ix
+            expected = Binning2D(x_axis, y_axis)
+            expected.push(x[mask], y[mask], z[mask], simple, num_threads=1)
+            assert np.all(count[:, :, ix] == expected.variable("count"))
+            assert np.allclose(mean[:, :, ix],
+                               expected.variable("mean"),
+                               equal_nan=True)
+
+    other = pickle.loads(pickle.dumps(binning))
+    assert isinstance(other.z, TemporalAxis)
+
+    # The statistics are transferred out-of-band by the protocol 5.
+    buffers = []
+    data = pickle.dumps(binning, protocol=5, buffer_callback=buffers.append)
+    assert buffers
+    assert len(data) < sum(buffer.raw().nbytes for buffer in buffers)
+    assert np.all(
+        pickle.loads(data, buffers=buffers).variable("count") == count)
+    other += binning
+    assert np.all(other.variable("count") == 2 * count)
+    other._instance.merge(binning._instance.__getstate__())
+    assert np.all(other.variable("count") == 3 * count)
+
+    z_axis = Axis(np.linspace(0, 1, 5))
+    binning = Binning3D(x_axis, y_axis, z_axis, sparse=True)
+    binning.push(x, y, z, z)
+    assert binning.variable("count").shape == (len(x_axis), len(y_axis), 5)
+    assert binning.variable("count").sum() == len(x)
+    with pytest.raises(ValueError):
+        binning += Binning3D(x_axis, y_axis, Axis(np.linspace(0, 1, 6)))
+
+
 def test_dask():
     x_axis = Axis(np.linspace(-180, 180, 1), is_circle=True)
     y_axis = Axis(np.linspace(-80, 80, 1))
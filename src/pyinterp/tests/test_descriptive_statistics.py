@@ -3,13 +3,14 @@
 # All rights reserved. Use of this source code is governed by a
 # BSD-style license that can be found in the LICENSE file.
 import pickle
+import warnings
 #
 import dask.array as da
 import numpy as np
 import pytest
 import xarray as xr
 #
-from .. import DescriptiveStatistics
+from .. import Axis, DescriptiveStatistics, Grid3D
 from .core.test_descriptive_statistics import weighted_mom3, weighted_mom4
 from . import grid2d_path, grid3d_path, grid4d_path
 
@@ -52,6 +53,19 @@ def test_descriptive_statistics_1d(dtype, error):
     assert isinstance(str(ds), str)
 
 
+@pytest.mark.parametrize("dtype,error", [(np.float32, 1e-4),
+                                         (np.float64, 1e-6)])
+def test_descriptive_statistics_num_threads(dtype, error):
+    """The statistics must not depend on the number of threads used."""
+    values = np.random.random_sample((100000, )).astype(dtype)
+    values[::7] = np.nan
+    ds = DescriptiveStatistics(values, dtype=dtype, num_threads=1)
+    check_stats(ds, values[~np.isnan(values)], dtype, error)
+
+    other = DescriptiveStatistics(values, dtype=dtype, num_threads=0)
+    np.testing.assert_array_equal(ds.array(), other.array())
+
+
 @pytest.mark.parametrize("dtype,error", [(np.float32, 1e-4),
                                          (np.float64, 1e-6)])
 def test_descriptive_statistics_iadd(dtype, error):
@@ -97,9 +111,10 @@ def test_axis():
     """Test the computation of descriptive statistics for a reduced tensor."""
     values = np.random.random_sample((2, 3, 4, 5, 6, 7))
 
-    def check_axis(values, axis, delayed=False):
+    def check_axis(values, axis, delayed=False, num_threads=0):
         ds = DescriptiveStatistics(da.asarray(values) if delayed else values,
-                                   axis=axis)
+                                   axis=axis,
+                                   num_threads=num_threads)
         assert np.all(ds.count() == np.sum(values * 0 + 1, axis=axis))
         assert np.all(ds.max() == np.max(values, axis=axis))
         assert ds.mean() == pytest.approx(np.mean(values, axis=axis))
@@ -112,6 +127,11 @@ def test_axis():
     check_axis(values, 1)
     check_axis(values, (2, 3))
     check_axis(values, (1, 3, 5))
+    check_axis(values, (0, ))
+    check_axis(values, (4, 5))
+    check_axis(values, (0, 1, 2, 3, 4, 5))
+    check_axis(values, (0, 2), num_threads=1)
+    check_axis(values, (3, 5), num_threads=1)
 
     check_axis(values, None, delayed=True)
     check_axis(values, (1, ), delayed=True)
@@ -132,3 +152,38 @@ def test_grid():
     data = xr.load_dataset(grid4d_path()).pressure
     ds = DescriptiveStatistics(data, axis=(0, 1))
     assert ds.mean() == pytest.approx(data.mean(axis=(0, 1)))
+
+
+@pytest.mark.parametrize("center", [False, True])
+def test_rolling(center):
+    """Test the statistics of a window sliding along the third axis."""
+    generator = np.random.Generator(np.random.PCG64(0))
+    values = generator.normal(size=(4, 5, 50))
+    values[1, 2, 10:20] = np.nan
+    grid = Grid3D(Axis(np.arange(4.0)), Axis(np.arange(5.0)),
+                  Axis(np.arange(50.0)), values)
+    ds = DescriptiveStatistics.rolling(grid,
+                                       window=7,
+                                       center=center,
+                                       min_periods=2,
+                                       num_threads=2)
+    assert ds.mean().shape == values.shape
+
+    before = 3 if center else 6
+    for iz in range(50):
+        window = values[:, :, max(iz - before, 0):iz - before + 7]
+        count = np.sum(~np.isnan(window), axis=2)
+        with warnings.catch_warnings():
+            # The means of the empty windows are not defined.
+            warnings.simplefilter("ignore", RuntimeWarning)
+            mean = np.where(count >= 2, np.nanmean(window, axis=2), np.nan)
+            var = np.where(count >= 2, np.nanvar(window, axis=2), np.nan)
+            vmax = np.where(count >= 2, np.nanmax(window, axis=2), np.nan)
+        assert np.allclose(ds.mean()[:, :, iz], mean, equal_nan=True)
+        assert np.allclose(ds.var()[:, :, iz], var, equal_nan=True)
+        assert np.allclose(ds.max()[:, :, iz], vmax, equal_nan=True)
+
+    with pytest.raises(ValueError):
+        DescriptiveStatistics.rolling(grid, window=0)
+    with pytest.raises(ValueError):
+        DescriptiveStatistics.rolling(grid, window=2, min_periods=3)
@@ -2,6 +2,8 @@
 #
 # All rights reserved. Use of this source code is governed by a
 # BSD-style license that can be found in the LICENSE file.
+import concurrent.futures
+import threading
 import netCDF4
 import numpy as np
 import pytest
@@ -39,6 +41,43 @@ def test_loess():
         fill.loess(grid, value_type="x")
 
 
+def test_loess_regular():
+    # Reference computed from the coordinates of the pixels, with the
+    # symmetrical indexes used outside the grid.
+    x = np.arange(16) * 0.25
+    y = np.arange(12) * 0.5
+    data = np.random.rand(len(x), len(y))
+    data[np.random.rand(len(x), len(y)) < 0.3] = np.nan
+    nx, ny = 3, 2
+
+    def mirror(index, size):
+        index = abs(index)
+        return 2 * (size - 1) - index if index >= size else index
+
+    expected = np.copy(data)
+    for ix in range(len(x)):
+        for iy in range(len(y)):
+            value = weight = 0
+            for wx in range(ix - nx, ix + nx + 1):
+                wx = mirror(wx, len(x))
+                for wy in range(iy - ny, iy + ny + 1):
+                    wy = mirror(wy, len(y))
+                    if np.isnan(data[wx, wy]):
+                        continue
+                    d = np.sqrt(((x[wx] - x[ix]) / nx)**2 +
+                                ((y[wy] - y[iy]) / ny)**2)
+                    wi = (1 - d**3)**3 if d <= 1 else 0
+                    value += wi * data[wx, wy]
+                    weight += wi
+            if weight != 0:
+                expected[ix, iy] = value / weight
+
+    grid = Grid2D(Axis(x), Axis(y), data)
+    filled = fill.loess(grid, nx=nx, ny=ny, value_type="all", num_threads=1)
+    assert np.all(np.isnan(filled) == np.isnan(expected))
+    assert np.nanmax(np.abs(filled - expected)) < 1e-12
+
+
 def test_gauss_seidel():
     grid = load_data()
     _, filled0 = fill.gauss_seidel(grid, num_threads=0)
@@ -65,6 +104,182 @@ def test_gauss_seidel():
     assert isinstance(filled0, np.ndarray)
 
 
+def test_gauss_seidel_red_black():
+    grid = load_data()
+    converged0, filled0 = fill.gauss_seidel(grid,
+                                            epsilon=1e-6,
+                                            num_threads=0,
+                                            ordering="red_black")
+    converged1, filled1 = fill.gauss_seidel(grid,
+                                            epsilon=1e-6,
+                                            num_threads=1,
+                                            ordering="red_black")
+    converged2, filled2 = fill.gauss_seidel(grid, epsilon=1e-6, num_threads=1)
+    assert converged0 and converged1 and converged2
+    # The pixels of the same color are independent: the result does not
+    # depend on the number of threads.
+    assert np.all(np.isnan(filled0) == np.isnan(filled1))
+    assert np.nanmax(np.abs(filled0 - filled1)) == 0
+    # Both orderings converge towards the same solution.
+    assert np.nanmax(np.abs(filled0 - filled2)) < 1e-2
+    assert np.ma.fix_invalid(grid.array - filled0).mean() == 0
+
+    with pytest.raises(ValueError):
+        fill.gauss_seidel(grid, ordering="_")
+
+
+def test_gauss_seidel_retire():
+    grid = load_data()
+    converged0, filled0 = fill.gauss_seidel(grid, epsilon=1e-6)
+    for ordering in ["lexicographic", "red_black"]:
+        converged1, filled1 = fill.gauss_seidel(grid,
+                                                epsilon=1e-6,
+                                                ordering=ordering,
+                                                retire=True)
+        assert converged0 and converged1
+        assert np.all(np.isnan(filled0) == np.isnan(filled1))
+        assert np.nanmax(np.abs(filled0 - filled1)) < 1e-2
+        assert np.ma.fix_invalid(grid.array - filled1).mean() == 0
+
+
+def test_gauss_seidel_callback():
+    grid = load_data()
+    history = []
+
+    def callback(state):
+        history.append((state.iteration, state.max_residual,
+                        state.unconverged, state.elapsed))
+
+    _, filled0 = fill.gauss_seidel(grid, epsilon=1e-6, num_threads=1)
+    converged, filled1 = fill.gauss_seidel(grid,
+                                           epsilon=1e-6,
+                                           num_threads=1,
+                                           callback=callback,
+                                           callback_interval=10)
+    assert converged
+    assert np.nanmax(np.abs(filled0 - filled1)) == 0
+    iterations = [item[0] for item in history]
+    assert iterations[:-1] == list(range(10, iterations[-1], 10))
+    assert history[0][2] > 0 and history[-1][2] == 0
+    assert history[-1][1] < 1e-6
+    assert all(item[3] >= 0 for item in history)
+
+    # The callback stops the iterations.
+    history.clear()
+
+    def stop(state):
+        history.append(state.iteration)
+        return state.iteration == 5
+
+    converged, _ = fill.gauss_seidel(grid, epsilon=1e-6, callback=stop)
+    assert not converged
+    assert history == [1, 2, 3, 4, 5]
+
+    with pytest.raises(ValueError):
+        fill.gauss_seidel(grid, callback=stop, callback_interval=0)
+
+
+def test_gauss_seidel_tile():
+    grid = load_data()
+    shape = grid.array.shape
+    _, expected = fill.gauss_seidel(grid,
+                                    first_guess="zero",
+                                    epsilon=1e-6,
+                                    relaxation=1.5,
+                                    ordering="red_black",
+                                    num_threads=1)
+
+    # The grid is split into two tiles along the X-axis, filled by two
+    # threads exchanging their halos through a shared array.
+    shared = np.copy(grid.array)
+    barrier = threading.Barrier(2)
+    residuals = [0.0, 0.0]
+    bounds = [0, shape[0] // 3, shape[0]]
+    tiles = []
+    for index in range(2):
+        xs = np.arange(bounds[index] - 1, bounds[index + 1] + 1) % shape[0]
+        ys = np.clip(np.arange(-1, shape[1] + 1), 0, shape[1] - 1)
+        tiles.append((xs, ys, shared[np.ix_(xs, ys)]))
+
+    def exchange(index):
+        xs, ys, tile = tiles[index]
+        shared[xs[1:-1], :] = tile[1:-1, 1:-1]
+        barrier.wait()
+        tile[:] = shared[np.ix_(xs, ys)]
+        barrier.wait()
+
+    def reduce(index, residual):
+        residuals[index] = residual
+        barrier.wait()
+        result = max(residuals)
+        barrier.wait()
+        return result
+
+    def worker(index):
+        return fill.gauss_seidel_tile(tiles[index][2],
+                                      lambda: exchange(index),
+                                      (bounds[index], 0),
+                                      shape,
+                                      lambda value: reduce(index, value),
+                                      first_guess="zero",
+                                      epsilon=1e-6,
+                                      relaxation=1.5,
+                                      num_threads=1)
+
+    with concurrent.futures.ThreadPoolExecutor(max_workers=2) as executor:
+        converged = list(executor.map(worker, range(2)))
+    assert all(converged)
+    assert np.all(shared == expected)
+
+    with pytest.raises(ValueError):
+        fill.gauss_seidel_tile(np.zeros((4, 4), dtype=np.int32),
+                               lambda: None, (0, 0), (2, 2))
+
+
+def test_multigrid():
+    grid = load_data()
+    converged, filled0 = fill.multigrid(grid, epsilon=1e-6, num_threads=0)
+    assert converged
+    _, filled1 = fill.multigrid(grid, epsilon=1e-6, num_threads=1)
+    assert np.nanmax(np.abs(filled0 - filled1)) == 0
+    assert np.ma.fix_invalid(grid.array - filled0).mean() == 0
+
+    # Both methods solve the same equation.
+    _, filled2 = fill.gauss_seidel(grid, epsilon=1e-6, num_threads=0)
+    assert np.nanmax(np.abs(filled0 - filled2)) < 1e-2
+
+    with pytest.raises(ValueError):
+        fill.multigrid(grid, '_')
+
+
+def test_multigrid_3d():
+    grid = load_data(True)
+    _, filled0 = fill.multigrid(grid, num_threads=0)
+    assert (filled0[:, :, 0] - filled0[:, :, 1]).mean() == 0
+
+
+def test_spectral():
+    grid = load_data()
+    converged, filled0 = fill.spectral(grid, epsilon=1e-6, num_threads=0)
+    assert converged
+    _, filled1 = fill.spectral(grid, epsilon=1e-6, num_threads=1)
+    assert np.nanmax(np.abs(filled0 - filled1)) == 0
+    assert np.ma.fix_invalid(grid.array - filled0).mean() == 0
+
+    # Both methods solve the same equation.
+    _, filled2 = fill.multigrid(grid, epsilon=1e-6, num_threads=0)
+    assert np.nanmax(np.abs(filled0 - filled2)) < 1e-2
+
+    with pytest.raises(ValueError):
+        fill.spectral(grid, '_')
+
+
+def test_spectral_3d():
+    grid = load_data(True)
+    _, filled0 = fill.spectral(grid, num_threads=0)
+    assert (filled0[:, :, 0] - filled0[:, :, 1]).mean() == 0
+
+
 def test_loess_3d():
     grid = load_data(True)
     mask = np.isnan(grid.array)
@@ -79,7 +294,85 @@ def test_loess_3d():
         fill.loess(grid, num_threads=0, nx=1, ny=0)
 
 
+def test_loess_spatio_temporal():
+    # Reference computed from the coordinates of the pixels, with the
+    # symmetrical indexes used outside the grid.
+    x = np.arange(8) * 0.25
+    y = np.arange(6) * 0.5
+    z = np.arange(5)
+    data = np.random.rand(len(x), len(y), len(z))
+    data[np.random.rand(*data.shape) < 0.3] = np.nan
+    nx, ny, nz = 2, 1, 2
+
+    def mirror(index, size):
+        index = abs(index)
+        return 2 * (size - 1) - index if index >= size else index
+
+    def tricube(d):
+        return (1 - d**3)**3 if d <= 1 else 0
+
+    def expected(separable):
+        result = np.copy(data)
+        for ix, iy, iz in np.ndindex(*data.shape):
+            value = weight = 0
+            for wx in range(ix - nx, ix + nx + 1):
+                wx = mirror(wx, len(x))
+                dx = (x[wx] - x[ix]) / nx
+                for wy in range(iy - ny, iy + ny + 1):
+                    wy = mirror(wy, len(y))
+                    dy = (y[wy] - y[iy]) / ny
+                    for wz in range(iz - nz, iz + nz + 1):
+                        wz = mirror(wz, len(z))
+                        dz = (wz - iz) / nz
+                        if np.isnan(data[wx, wy, wz]):
+                            continue
+                        wi = tricube(abs(dx)) * tricube(abs(dy)) * tricube(
+                            abs(dz)) if separable else tricube(
+                                np.sqrt(dx**2 + dy**2 + dz**2))
+                        value += wi * data[wx, wy, wz]
+                        weight += wi
+            if weight != 0:
+                result[ix, iy, iz] = value / weight
+        return result
+
+    grid = Grid3D(Axis(x), Axis(y), Axis(z), data)
+    for separable in [False, True]:
+        reference = expected(separable)
+        for num_threads in [0, 1]:
+            filled = fill.loess(grid,
+                                nx=nx,
+                                ny=ny,
+                                nz=nz,
+                                value_type="all",
+                                separable=separable,
+                                num_threads=num_threads)
+            assert np.all(np.isnan(filled) == np.isnan(reference))
+            assert np.nanmax(np.abs(filled - reference)) < 1e-12
+
+    with pytest.raises(ValueError):
+        fill.loess(load_data(), nz=1)
+
+
 def test_gauss_seidel_3d():
     grid = load_data(True)
     _, filled0 = fill.gauss_seidel(grid, num_threads=0)
     assert (filled0[:, :, 0] - filled0[:, :, 1]).mean() == 0
+
+
+def test_gauss_seidel_3d_warm_start():
+    grid = load_data(True)
+    layer = Grid2D(grid.x, grid.y, grid.array[:, :, 0])
+    _, expected = fill.gauss_seidel(layer, epsilon=1e-6, num_threads=1)
+    converged0, filled0 = fill.gauss_seidel(grid, epsilon=1e-6, num_threads=0)
+    converged1, filled1 = fill.gauss_seidel(grid,
+                                            epsilon=1e-6,
+                                            num_threads=1,
+                                            warm_start=True)
+    assert converged0 and converged1
+    # Each layer is filled independently with a single thread.
+    for iz in range(filled0.shape[2]):
+        assert np.nanmax(np.abs(filled0[:, :, iz] - expected)) == 0
+    # The second layer starts from the solution of the first one.
+    assert np.nanmax(np.abs(filled1[:, :, 0] - expected)) == 0
+    assert np.nanmax(np.abs(filled1[:, :, 1] - expected)) < 1e-2
+    assert np.ma.fix_invalid(grid.array - filled1).mean() == 0
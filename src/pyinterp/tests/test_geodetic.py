@@ -2,6 +2,7 @@
 #
 # All rights reserved. Use of this source code is governed by a
 # BSD-style license that can be found in the LICENSE file.
+import numpy
 import pytest
 from .. import geodetic
 
@@ -92,3 +93,36 @@ def test_polygon():
 
     with pytest.raises(ValueError):
         polygon = geodetic.Polygon([1])  # type: ignore
+
+
+def test_crossovers():
+    # Ascending and descending passes crossing at the equator.
+    lat = numpy.linspace(-60, 60, 121)
+    lon1 = lat * 0.5 + 10
+    lon2 = -lat * 0.5 + 10
+    time1 = numpy.datetime64("2022-01-01") + numpy.arange(
+        121) * numpy.timedelta64(1, "s")
+    lon, lat_x, index1, index2 = geodetic.crossovers(lon1, lat, lon2, lat)
+    assert lon == pytest.approx([10])
+    assert lat_x == pytest.approx([0], abs=1e-9)
+    assert index1 == pytest.approx([60])
+    assert index2 == pytest.approx([60])
+    time = geodetic.interpolate_along_track(time1, index1)
+    assert abs(time[0] - numpy.datetime64("2022-01-01T00:01:00")) <= \
+        numpy.timedelta64(1, "s")
+    assert geodetic.interpolate_along_track(lat, [0.5, 119.5]) == \
+        pytest.approx([-59.5, 59.5])
+
+    # The same search for many pairs of tracks.
+    tracks = [(lon1, lat), (lon2, lat), (lon1 + 90, lat)]
+    pairs = numpy.array([[0, 1], [0, 2], [2, 1]])
+    index, lon, lat_x, index1, index2 = geodetic.crossovers(tracks,
+                                                            pairs,
+                                                            num_threads=2)
+    assert list(index) == [0]
+    assert lon == pytest.approx([10])
+
+    with pytest.raises(ValueError):
+        geodetic.crossovers(tracks, numpy.array([[0, 3]]))
+    with pytest.raises(ValueError):
+        geodetic.crossovers(lon1, lat[:10], lon2, lat)
@@ -2,6 +2,7 @@
 #
 # All rights reserved. Use of this source code is governed by a
 # BSD-style license that can be found in the LICENSE file.
+import pickle
 import pytest
 import dask.array as da
 import numpy as np
@@ -27,6 +28,18 @@ def build_instance(dtype):
     assert isinstance(mean, np.ndarray)
     median = hist2d.variable('quantile', 0.5)
     assert isinstance(median, np.ndarray)
+    q = np.array([0.95, 0.05, 0.5, 0.25, 0.75])
+    quantiles = hist2d.variable('quantiles', q)
+    assert quantiles.shape == median.shape + (5, )
+    for ix, item in enumerate(q):
+        assert np.allclose(quantiles[:, :, ix],
+                           hist2d.variable('quantile', item),
+                           equal_nan=True)
+    assert np.allclose(hist2d.variable('quantiles', q, 1),
+                       quantiles,
+                       equal_nan=True)
+    with pytest.raises(ValueError):
+        hist2d.variable('quantiles', [0.5, 2])
     kurtosis = hist2d.variable('kurtosis')
     assert isinstance(kurtosis, np.ndarray)
     skewness = hist2d.variable('skewness')
@@ -48,6 +61,66 @@ def test_histogram2d():
         build_instance(np.int8)
 
 
+def test_histogram2d_threads():
+    """Test the insertion of samples with several threads."""
+    generator = np.random.Generator(np.random.PCG64(0))
+    x = generator.uniform(-180, 180, 100000)
+    y = generator.uniform(-90, 90, 100000)
+    z = generator.uniform(0, 1, 100000)
+
+    x_axis = Axis(np.arange(-180, 180, 20), is_circle=True)
+    y_axis = Axis(np.arange(-90, 95, 20))
+    hist2d0 = Histogram2D(x_axis, y_axis, bin_counts=20)
+    hist2d1 = Histogram2D(x_axis, y_axis, bin_counts=20)
+    hist2d0.push(x, y, z, num_threads=1)
+    hist2d1.push(x, y, z, num_threads=4)
+    # Each bin is updated by a single thread, in the order of the samples.
+    for item in ['count', 'mean', 'min', 'max']:
+        assert np.array_equal(hist2d0.variable(item),
+                              hist2d1.variable(item),
+                              equal_nan=True)
+    assert np.array_equal(hist2d0.variable('quantile', 0.5),
+                          hist2d1.variable('quantile', 0.5),
+                          equal_nan=True)
+
+
+def test_histogram2d_sparse():
+    """Test the storage of the histograms holding values only."""
+    generator = np.random.Generator(np.random.PCG64(0))
+    x = generator.uniform(-10, 10, 100000)
+    y = generator.uniform(-10, 10, 100000)
+    z = generator.uniform(0, 1, 100000)
+
+    x_axis = Axis(np.arange(-180, 180, 0.5), is_circle=True)
+    y_axis = Axis(np.arange(-90, 90.5, 0.5))
+    dense = Histogram2D(x_axis, y_axis, bin_counts=20)
+    sparse = Histogram2D(x_axis, y_axis, bin_counts=20, sparse=True)
+    assert not dense.sparse
+    assert sparse.sparse
+    dense.push(x, y, z, num_threads=1)
+    sparse.push(x, y, z, num_threads=4)
+    for item in ['count', 'mean', 'min', 'max']:
+        assert np.array_equal(dense.variable(item),
+                              sparse.variable(item),
+                              equal_nan=True)
+    assert np.array_equal(dense.variable('quantile', 0.5),
+                          sparse.variable('quantile', 0.5),
+                          equal_nan=True)
+    histograms = dense.variable('histograms')
+    for field in ['value', 'weight']:
+        assert np.array_equal(histograms[field],
+                              sparse.variable('histograms')[field],
+                              equal_nan=True)
+
+    other = pickle.loads(pickle.dumps(sparse))
+    assert other.sparse
+    assert np.array_equal(other.variable('count'), sparse.variable('count'))
+    other += dense
+    assert np.all(other.variable('count') == 2 * dense.variable('count'))
+    sparse.clear()
+    assert np.all(sparse.variable('count') == 0)
+
+
 def test_dask():
     """Test Histogram2D with dask arrays."""
     x_axis = Axis(np.linspace(-180, 180, 1), is_circle=True)
@@ -0,0 +1,60 @@
+# Copyright (c) 2022 CNES
+#
+# All rights reserved. Use of this source code is governed by a
+# BSD-style license that can be found in the LICENSE file.
+import subprocess
+import sys
+import pytest
+import pyinterp
+from .. import core
+
+#: Checks, in a new interpreter, the classes and functions registered.
+SCRIPT = """
+import sys
+import pyinterp
+from pyinterp import core
+
+assert "pyinterp.grid" not in sys.modules
+assert "Grid2DFloat64" not in vars(core)
+assert "System" not in vars(core.geodetic)
+
+# Only the groups used, and the groups they depend on, are registered.
+pyinterp.geohash.encode
+assert "System" in vars(core.geodetic)
+assert "Grid2DFloat64" not in vars(core)
+
+core.bivariate_float64
+assert "Grid2DFloat64" in vars(core)
+assert "RTree3DFloat64" not in vars(core)
+assert "trivariate_float64" not in vars(core)
+"""
+
+#: Checks, in a new interpreter, that the signatures of a group name the
+#: Python classes of the groups it depends on.
+SCRIPT_SIGNATURES = """
+from pyinterp import core
+
+assert "Grid3DFloat64" not in vars(core)
+doc = core.DescriptiveStatisticsFloat64.rolling.__doc__
+assert "pyinterp.core.Grid3DFloat64" in doc, doc
+assert "pyinterp::" not in doc, doc
+"""
+
+
+def test_lazy_import():
+    subprocess.run([sys.executable, "-c", SCRIPT], check=True)
+
+
+def test_signatures():
+    subprocess.run([sys.executable, "-c", SCRIPT_SIGNATURES], check=True)
+
+
+def test_attributes():
+    assert "RTree3DFloat64" in dir(core)
+    assert "System" in dir(core.geodetic)
+    assert "Grid2D" in dir(pyinterp)
+    assert pyinterp.Grid2D is pyinterp.grid.Grid2D
+    with pytest.raises(AttributeError):
+        core.Grid2DComplex
+    with pytest.raises(AttributeError):
+        pyinterp.Grid5D
@@ -0,0 +1,74 @@
+# Copyright (c) 2022 CNES
+#
+# All rights reserved. Use of this source code is governed by a
+# BSD-style license that can be found in the LICENSE file.
+import pytest
+import numpy as np
+from .. import Axis, Binning2D, Binning3D, Histogram2D, Pipeline, geodetic
+
+
+def test_pipeline():
+    """Test the ingestion of chunks by a pipeline."""
+    generator = np.random.Generator(np.random.PCG64(0))
+    x = generator.uniform(-180, 180, 100000)
+    y = generator.uniform(-90, 90, 100000)
+    z = generator.uniform(0, 1, 100000)
+
+    x_axis = Axis(np.arange(-180, 180, 20), is_circle=True)
+    y_axis = Axis(np.arange(-90, 95, 20))
+    chunks = [(x[ix:ix + 10000], y[ix:ix + 10000], z[ix:ix + 10000])
+              for ix in range(0, x.size, 10000)]
+
+    for simple in [True, False]:
+        binning = Binning2D(x_axis, y_axis, geodetic.System())
+        histogram = Histogram2D(x_axis, y_axis)
+        pipeline = Pipeline([binning], [histogram], simple, num_threads=4)
+        assert len(pipeline) == 2
+        pipeline.run(iter(chunks))
+
+        expected_binning = Binning2D(x_axis, y_axis, geodetic.System())
+        expected_histogram = Histogram2D(x_axis, y_axis)
+        for item in chunks:
+            expected_binning.push(*item, simple=simple, num_threads=1)
+            expected_histogram.push(*item, num_threads=1)
+
+        assert np.all(
+            binning.variable("count") == expected_binning.variable("count"))
+        assert np.allclose(binning.variable("mean"),
+                           expected_binning.variable("mean"),
+                           equal_nan=True)
+        assert np.all(
+            histogram.variable("count") == expected_histogram.variable(
+                "count"))
+        assert np.allclose(histogram.variable("mean"),
+                           expected_histogram.variable("mean"),
+                           equal_nan=True)
+
+    # An empty iterator does not update the statistics.
+    binning = Binning2D(x_axis, y_axis)
+    Pipeline([binning]).run([])
+    assert np.all(binning.variable("count") == 0)
+
+    # The errors raised by the iterator are propagated.
+    def failing():
+        yield chunks[0]
+        raise RuntimeError("failure")
+
+    with pytest.raises(RuntimeError):
+        Pipeline([binning]).run(failing())
+    assert np.sum(binning.variable("count")) == 10000
+
+    with pytest.raises(ValueError):
+        Pipeline([binning]).run([(x[:10], y[:10], z[:5])])
+
+    with pytest.raises(ValueError):
+        Pipeline()
+
+    with pytest.raises(ValueError):
+        Pipeline([binning, binning])
+
+    with pytest.raises(ValueError):
+        Pipeline([binning, Binning2D(x_axis, y_axis, dtype=np.float32)])
+
+    with pytest.raises(TypeError):
+        Pipeline([Binning3D(x_axis, y_axis, Axis(np.arange(2)))])
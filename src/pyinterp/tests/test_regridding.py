@@ -0,0 +1,93 @@
+# Copyright (c) 2022 CNES
+#
+# All rights reserved. Use of this source code is governed by a
+# BSD-style license that can be found in the LICENSE file.
+import numpy as np
+import pytest
+from .. import Axis, Grid2D, bivariate, geodetic, regridding_plan
+
+
+def sum_of_weights(plan):
+    """Sum of the weights of each row of the plan."""
+    return np.array([
+        plan.weights[first:last].sum()
+        for first, last in zip(plan.indptr[:-1], plan.indptr[1:])
+    ])
+
+
+def test_conservative_cartesian():
+    source = Grid2D(Axis(np.arange(10) + 0.5), Axis(np.arange(6) + 0.5),
+                    np.random.random((10, 6)))
+    target_x = Axis(np.arange(1, 10, 2, dtype="float64"))
+    target_y = Axis(np.arange(1, 6, 2, dtype="float64"))
+
+    plan = regridding_plan(source, target_x, target_y, method="conservative")
+    assert len(plan) == 15
+    assert plan.shape == (10, 6)
+    result = plan.apply(source.array).reshape(5, 3)
+    expected = source.array.reshape(5, 2, 3, 2).mean(axis=(1, 3))
+    np.testing.assert_allclose(result, expected)
+
+    # The undefined values are ignored if the weights are normalized.
+    array = source.array.copy()
+    array[0, 0] = np.nan
+    result = plan.apply(array).reshape(5, 3)
+    assert np.isnan(result[0, 0])
+    result = plan.apply(array, normalize=True).reshape(5, 3)
+    np.testing.assert_allclose(result[0, 0], np.mean(array[0:2, 0:2][
+        ~np.isnan(array[0:2, 0:2])]))
+
+    # A target cell partially covered by the source grid.
+    plan = regridding_plan(source,
+                           Axis(np.array([10.0, 12.0])),
+                           Axis(np.array([1.0, 3.0])),
+                           method="conservative")
+    np.testing.assert_allclose(sum_of_weights(plan), [0.5, 0.5, 0.0, 0.0])
+    result = plan.apply(np.ones((10, 6)), normalize=True)
+    np.testing.assert_allclose(result[:2], 1)
+    assert np.all(np.isnan(result[2:]))
+
+
+def test_conservative_geographic():
+    wgs = geodetic.System()
+    source = Grid2D(Axis(np.arange(-179.5, 180, 1), is_circle=True),
+                    Axis(np.arange(-89.5, 90, 1)), np.random.random(
+                        (360, 180)))
+    target_x = Axis(np.arange(-177.5, 180, 5), is_circle=True)
+    target_y = Axis(np.arange(-87.5, 90, 5))
+    plan = regridding_plan(source, target_x, target_y, "conservative", wgs)
+
+    # The weights of each target cell sum to one.
+    np.testing.assert_allclose(sum_of_weights(plan), 1, rtol=1e-12)
+
+    # On a sphere, the integral of the field is preserved.
+    plan = regridding_plan(source, target_x, target_y, "conservative",
+                           geodetic.System((6371000.0, 0.0)))
+
+    def areas(step):
+        return np.diff(np.sin(np.radians(np.arange(-90, 90 + step, step))))
+
+    result = plan.apply(source.array).reshape(72, 36)
+    np.testing.assert_allclose((result * areas(5)).sum() * 5,
+                               (source.array * areas(1)).sum())
+
+    # Target cells shifted across the antimeridian.
+    target_x = Axis(np.arange(-180, 180, 5, dtype="float64"), is_circle=True)
+    plan = regridding_plan(source, target_x, target_y, "conservative", wgs)
+    result = plan.apply(np.ones((360, 180)))
+    np.testing.assert_allclose(result, 1)
+
+
+def test_bilinear():
+    source = Grid2D(Axis(np.arange(10, dtype="float64")),
+                    Axis(np.arange(6, dtype="float64")),
+                    np.random.random((10, 6)))
+    target_x = Axis(np.linspace(0, 9, 7))
+    target_y = Axis(np.linspace(0, 5, 4))
+    plan = regridding_plan(source, target_x, target_y)
+    x, y = np.meshgrid(target_x[:], target_y[:], indexing="ij")
+    np.testing.assert_allclose(plan.apply(source.array),
+                               bivariate(source, x.ravel(), y.ravel()))
+
+    with pytest.raises(ValueError):
+        regridding_plan(source, target_x, target_y, method="spline")
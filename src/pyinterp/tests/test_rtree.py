@@ -37,6 +37,12 @@ def build_rtree(dtype):
     assert len(mesh) == len(lon.ravel())
     assert isinstance(pickle.loads(pickle.dumps(mesh)), pyinterp.RTree)
 
+    # The points are transferred out-of-band by the protocol 5.
+    buffers = []
+    data = pickle.dumps(mesh, protocol=5, buffer_callback=buffers.append)
+    assert len(buffers) == 2
+    assert len(pickle.loads(data, buffers=buffers)) == len(mesh)
+
 
 def test_init():
     build_rtree(dtype=np.float32)
@@ -53,6 +59,69 @@ def test_init():
         pyinterp.RTree(ndims=1)
 
 
+def test_save_load(tmp_path):
+    mesh = load_data()
+    path = str(tmp_path / "rtree.idx")
+    mesh.save(path)
+    other = pyinterp.RTree.load(path)
+    assert isinstance(other, pyinterp.RTree)
+    assert other.dtype == mesh.dtype
+    assert len(other) == len(mesh)
+    assert other.bounds() == mesh.bounds()
+
+    lon = np.arange(-180, 180, 10, dtype=np.float64)
+    lat = np.arange(-90, 90, 10, dtype=np.float64)
+    coordinates = np.vstack((lon, lat[:len(lon) // 2].repeat(2))).T
+    distance0, value0 = mesh.query(coordinates)
+    distance1, value1 = other.query(coordinates)
+    assert np.all(distance0 == distance1)
+    assert np.all(value0 == value1)
+
+    # A dynamic tree is written in the same layout.
+    mesh = pyinterp.RTree(dtype=np.float32)
+    mesh.insert(coordinates.astype(np.float32),
+                np.arange(len(coordinates), dtype=np.float32))
+    mesh.save(path)
+    other = pyinterp.RTree.load(path)
+    assert other.dtype == np.dtype("float32")
+    assert len(other) == len(mesh)
+
+    with open(path, "wb") as stream:
+        stream.write(b"0" * 64)
+    with pytest.raises(ValueError):
+        pyinterp.RTree.load(path)
+
+
+def test_ecef_dtype(tmp_path):
+    generator = np.random.Generator(np.random.PCG64(0))
+    coordinates = np.vstack((generator.uniform(-180, 180, 1000),
+                             generator.uniform(-80, 80, 1000))).T
+    values = generator.uniform(0, 1, 1000)
+    mesh = pyinterp.RTree()
+    mesh.packing(coordinates, values)
+    other = pyinterp.RTree(ecef_dtype=np.float32)
+    assert other.dtype == np.dtype("float64")
+    assert other.ecef_dtype == np.dtype("float32")
+    other.packing(coordinates, values)
+
+    # The positions are rounded to the resolution of a float at the surface
+    # of the Earth, the values are kept in double precision.
+    points = coordinates[:100] + 0.01
+    distance0, value0 = mesh.query(points, k=1)
+    distance1, value1 = other.query(points, k=1)
+    assert np.allclose(distance0, distance1, atol=1)
+    assert np.all(value0 == value1)
+
+    path = str(tmp_path / "rtree.idx")
+    other.save(path)
+    assert pyinterp.RTree.load(path).ecef_dtype == np.dtype("float32")
+    other = pickle.loads(pickle.dumps(other))
+    assert other.ecef_dtype == np.dtype("float32")
+
+    with pytest.raises(ValueError):
+        pyinterp.RTree(dtype=np.float32, ecef_dtype=np.float64)
+
+
 def load_data():
     ds = xr.load_dataset(grid2d_path())
     z = ds.mss.T
@@ -77,6 +146,10 @@ def test_interpolate(pytestconfig):
     make_or_compare_reference("rtree_rbf.npy", data, dump)
     data, _ = mesh.window_function(coordinates, radius=2_000_000)
     make_or_compare_reference("rtree_wf.npy", data, dump)
+    other, _ = mesh.window_function(coordinates,
+                                    radius=2_000_000,
+                                    table_size=1024)
+    assert np.allclose(data, other, atol=1e-5, equal_nan=True)
 
     with pytest.raises(ValueError):
         mesh.radial_basis_function(coordinates, epsilon=1, rbf="cubic")
@@ -90,3 +163,280 @@ def test_interpolate(pytestconfig):
         mesh.window_function(coordinates, radius=1, wf="lanczos", arg=0)
     with pytest.raises(ValueError):
         mesh.window_function(coordinates, radius=1, wf="blackman", arg=2)
+
+
+def test_output_buffer():
+    mesh = load_data()
+    lon = np.arange(-180, 180, 1) + 1 / 3.0
+    lat = np.arange(-90, 90, 1) + 1 / 3.0
+    x, y = np.meshgrid(lon, lat, indexing="ij")
+    coordinates = np.vstack((x.ravel(), y.ravel())).T
+    size = coordinates.shape[0]
+
+    out = (np.empty((size, 4)), np.empty((size, 4)))
+    distance, value = mesh.query(coordinates, k=4, out=out)
+    assert distance is out[0]
+    assert value is out[1]
+    expected = mesh.query(coordinates, k=4)
+    np.testing.assert_equal(distance, expected[0])
+    np.testing.assert_equal(value, expected[1])
+
+    out = (np.empty(size), np.empty(size, dtype=np.uint32))
+    data, neighbors = mesh.inverse_distance_weighting(coordinates, out=out)
+    assert data is out[0]
+    assert neighbors is out[1]
+    expected = mesh.inverse_distance_weighting(coordinates)
+    np.testing.assert_equal(data, expected[0])
+    np.testing.assert_equal(neighbors, expected[1])
+
+    with pytest.raises(ValueError):
+        mesh.query(coordinates, k=4, out=(np.empty((size, 3)), out[0]))
+    with pytest.raises(ValueError):
+        mesh.inverse_distance_weighting(coordinates,
+                                        out=(out[0], np.empty(size)))
+
+
+def test_approximate_search():
+    mesh = load_data()
+    lon = np.arange(-180, 180, 1) + 1 / 3.0
+    lat = np.arange(-90, 90, 1) + 1 / 3.0
+    x, y = np.meshgrid(lon, lat, indexing="ij")
+    coordinates = np.vstack((x.ravel(), y.ravel())).T
+
+    expected, _ = mesh.query(coordinates, k=16)
+    distance, _ = mesh.query(coordinates, k=16, eps=0)
+    np.testing.assert_equal(distance, expected)
+
+    # The i-th neighbor found is at most (1 + eps) times farther than the
+    # i-th nearest neighbor.
+    distance, _ = mesh.query(coordinates, k=16, eps=0.5)
+    assert np.all(distance >= expected)
+    assert np.all(distance <= expected * 1.5 + 1e-6)
+
+    _, neighbors = mesh.inverse_distance_weighting(coordinates, eps=0.5)
+    assert np.all(neighbors <= 9)
+    _, neighbors = mesh.window_function(coordinates, radius=2e6, eps=0.5)
+    assert np.all(neighbors <= 9)
+
+    with pytest.raises(ValueError):
+        mesh.query(coordinates, eps=-1)
+
+
+def test_strided_inputs():
+    mesh = load_data()
+    lon = np.arange(-180, 180, 1) + 1 / 3.0
+    lat = np.arange(-90, 90, 1) + 1 / 3.0
+    x, y = np.meshgrid(lon, lat, indexing="ij")
+    coordinates = np.vstack((x.ravel(), y.ravel())).T
+
+    # Fortran ordered, float32 and column slices are read in place.
+    expected = mesh.query(coordinates)
+    for other in [
+            np.asfortranarray(coordinates),
+            np.repeat(coordinates, 2, axis=1)[:, ::2],
+    ]:
+        np.testing.assert_equal(mesh.query(other)[0], expected[0])
+        np.testing.assert_equal(mesh.query(other)[1], expected[1])
+    single = coordinates.astype("f4")
+    expected = mesh.inverse_distance_weighting(single.astype("f8"))
+    np.testing.assert_equal(
+        mesh.inverse_distance_weighting(single)[0], expected[0])
+
+
+def test_compact_radial_basis_function():
+    generator = np.random.Generator(np.random.PCG64(0))
+    lon = generator.uniform(-10, 10, 500)
+    lat = generator.uniform(-10, 10, 500)
+    values = np.cos(np.radians(lon)) * np.sin(np.radians(lat))
+    coordinates = np.vstack((lon, lat)).T
+    mesh = pyinterp.RTree()
+    mesh.packing(coordinates, values)
+
+    # The interpolant goes through the nodal points.
+    data, neighbors = mesh.compact_radial_basis_function(coordinates,
+                                                         radius=200_000)
+    assert np.all(neighbors > 0)
+    assert np.allclose(data, values, atol=1e-6)
+
+    # The points buffered after the packing give the same result.
+    other = pyinterp.RTree()
+    other.insert(coordinates[:1], values[:1])
+    other.insert(coordinates[1:], values[1:])
+    data, _ = other.compact_radial_basis_function(coordinates,
+                                                  radius=200_000)
+    assert np.allclose(data, values, atol=1e-6)
+
+    # No points are located within the support radius.
+    data, neighbors = mesh.compact_radial_basis_function(
+        np.array([[90.0, 0.0]]), radius=200_000)
+    assert np.isnan(data[0])
+    assert neighbors[0] == 0
+
+    with pytest.raises(ValueError):
+        mesh.compact_radial_basis_function(coordinates, radius=0)
+
+
+def test_kriging():
+    generator = np.random.Generator(np.random.PCG64(0))
+    lon = generator.uniform(-10, 10, 500)
+    lat = generator.uniform(-10, 10, 500)
+    values = np.cos(np.radians(lon)) * np.sin(np.radians(lat))
+    coordinates = np.vstack((lon, lat)).T
+    mesh = pyinterp.RTree()
+    mesh.packing(coordinates, values)
+
+    # The estimator goes through the nodal points with a null error.
+    for covariance in [
+            "matern_12", "matern_32", "matern_52", "gaussian", "spherical"
+    ]:
+        data, variance, neighbors = mesh.kriging(coordinates[:10],
+                                                 covariance=covariance,
+                                                 lambda_=500_000,
+                                                 within=False)
+        assert np.allclose(data, values[:10], atol=1e-6)
+        assert np.allclose(variance, 0, atol=1e-6)
+        assert np.all(neighbors == 9)
+
+    data, variance, _ = mesh.kriging(np.array([[0.05, 0.05]]),
+                                     lambda_=500_000)
+    assert np.isfinite(data[0])
+    assert 0 < variance[0] < 1
+
+    with pytest.raises(ValueError):
+        mesh.kriging(coordinates, covariance="cubic")
+    with pytest.raises(ValueError):
+        mesh.kriging(coordinates, lambda_=0)
+
+
+def test_insert_remove():
+    generator = np.random.Generator(np.random.PCG64(0))
+    lon = generator.uniform(-10, 10, 1000)
+    lat = generator.uniform(-10, 10, 1000)
+    values = np.arange(1000, dtype=np.float64)
+    coordinates = np.vstack((lon, lat)).T
+    mesh = pyinterp.RTree()
+    mesh.packing(coordinates[:800], values[:800])
+    mesh.insert(coordinates[800:], values[800:])
+    assert len(mesh) == 1000
+
+    # Remove one point out of two, in the static and the buffered points.
+    removed = mesh.remove(lambda _, values: values % 2 == 0)
+    assert removed == 500
+    assert len(mesh) == 500
+    assert mesh.remove(lambda _, values: values < 0) == 0
+
+    expected = pyinterp.RTree()
+    expected.packing(coordinates[1::2], values[1::2])
+
+    points = np.vstack((generator.uniform(-9, 9, 100),
+                        generator.uniform(-9, 9, 100))).T
+    distances, data = mesh.query(points, k=4)
+    other_distances, other_data = expected.query(points, k=4)
+    assert np.allclose(distances, other_distances)
+    assert np.all(data % 2 == 1)
+    assert np.all(np.sort(data, axis=1) == np.sort(other_data, axis=1))
+
+    # The predicate receives the geographic coordinates of the points.
+    removed = mesh.remove(lambda coordinates, _: coordinates[:, 0] < 0)
+    assert removed == np.sum(lon[1::2] < 0)
+    assert len(mesh) == 500 - removed
+
+    with pytest.raises(ValueError):
+        mesh.remove(lambda _, values: values[:1] > 0)
+
+
+def test_temporal_rtree():
+    generator = np.random.default_rng(42)
+    size = 20000
+    lon = generator.uniform(-180, 180, size)
+    lat = generator.uniform(-90, 90, size)
+    dates = np.datetime64("2022-01-01") + generator.integers(
+        0, 30 * 86400, size).astype("m8[s]")
+    values = generator.uniform(0, 1, size)
+    coordinates = np.vstack((lon, lat)).T
+
+    index = pyinterp.TemporalRTree(period=np.timedelta64(1, "D"))
+    assert not index
+    index.packing(coordinates, dates, values)
+    assert len(index) == size
+    assert index.partitions() == 30
+    assert index.period == np.timedelta64(1, "D")
+
+    window = np.timedelta64(6, "h")
+    query = coordinates[:100]
+    when = dates[:100] + np.timedelta64(1, "h")
+    distance, value = index.query(query, when, window, k=8)
+    assert distance.shape == (100, 8)
+
+    # The neighbors found are those of an index of the observations made
+    # within the window.
+    for ix in range(0, 100, 10):
+        mask = np.abs(dates - when[ix]) <= window
+        mesh = pyinterp.RTree()
+        mesh.packing(coordinates[mask], values[mask])
+        expected = mesh.query(query[ix:ix + 1], k=8, within=False)
+        np.testing.assert_allclose(distance[ix], expected[0][0])
+        np.testing.assert_equal(value[ix], expected[1][0])
+
+    # The value of an observation located at the point of interest is
+    # returned as is.
+    data, _ = index.inverse_distance_weighting(query, when, window)
+    np.testing.assert_equal(data, values[:100])
+
+    with pytest.raises(TypeError):
+        index.query(query, lon[:100], window)
+    with pytest.raises(ValueError):
+        index.query(query, when, -window)
+
+
+def test_sharded_rtree(tmp_path):
+    generator = np.random.default_rng(42)
+    size = 20000
+    lon = generator.uniform(-180, 180, size)
+    lat = np.degrees(np.arcsin(generator.uniform(-1, 1, size)))
+    values = generator.uniform(0, 1, size)
+    coordinates = np.vstack((lon, lat)).T
+
+    index = pyinterp.ShardedRTree(precision=6)
+    assert not index
+    assert index.precision == 6
+    index.packing(coordinates, values)
+    assert len(index) == size
+    assert index.shards() == 64
+    assert sum(index.shard_size(key) for key in index.keys()) == size
+
+    mesh = pyinterp.RTree()
+    mesh.packing(coordinates, values)
+
+    # The neighbors of the points located near the edges of the cells, and
+    # near the antimeridian, are found in the adjacent shards.
+    query = np.vstack((generator.uniform(-180, 180, 500),
+                       generator.uniform(-80, 80, 500))).T
+    query[:10, 0] = 179.99
+    expected = mesh.query(query, k=8, within=False)
+    distance, value = index.query(query, k=8)
+    np.testing.assert_allclose(distance, expected[0])
+    np.testing.assert_equal(value, expected[1])
+
+    distance, value = index.query(query, k=8, radius=50000)
+    bounded = mesh.query(query, k=8, radius=50000, within=False)
+    np.testing.assert_allclose(distance, bounded[0])
+    np.testing.assert_equal(value, bounded[1])
+
+    data, _ = index.inverse_distance_weighting(coordinates[:100])
+    np.testing.assert_equal(data, values[:100])
+
+    # A process can only open the shards it serves.
+    path = str(tmp_path / "shards")
+    index.save(path)
+    other = pyinterp.ShardedRTree(precision=6)
+    other.load(path, keys=index.keys()[:8])
+    assert other.shards() == 8
+    other.load(path)
+    assert len(other) == size
+    np.testing.assert_equal(other.query(query, k=8)[1], expected[1])
+
+    with pytest.raises(ValueError):
+        pyinterp.ShardedRTree(precision=8).load(path)
+    with pytest.raises(ValueError):
+        pyinterp.ShardedRTree(precision=0)
@@ -97,6 +97,11 @@ def test_axis():
             hist.sum_of_weights() == np.sum(values * 0 + 1, axis=axis))
         assert hist.quantile() == pytest.approx(
             np.quantile(values, 0.5, axis=axis))
+        quantiles = hist.quantiles([0.75, 0.5, 0.25])
+        assert quantiles.shape == hist.count().shape + (3, )
+        assert quantiles[..., 1] == pytest.approx(hist.quantile())
+        assert quantiles[..., 0] == pytest.approx(hist.quantile(0.75))
+        assert quantiles[..., 2] == pytest.approx(hist.quantile(0.25))
         assert hist.var() == pytest.approx(np.var(values, axis=axis))
 
     check_axis(values, None)
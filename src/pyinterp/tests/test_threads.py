@@ -0,0 +1,27 @@
+# Copyright (c) 2022 CNES
+#
+# All rights reserved. Use of this source code is governed by a
+# BSD-style license that can be found in the LICENSE file.
+import os
+import pyinterp
+
+
+def test_num_threads():
+    cpus = pyinterp.available_cpus()
+    assert 1 <= cpus <= (os.cpu_count() or 1)
+    default = pyinterp.get_num_threads()
+
+    with pyinterp.num_threads(2):
+        assert pyinterp.get_num_threads() == 2
+        with pyinterp.num_threads(1, pin=True):
+            assert pyinterp.get_num_threads() == 1
+        assert pyinterp.get_num_threads() == 2
+        assert not pyinterp.core.threads_pinned()
+    assert pyinterp.get_num_threads() == default
+
+    pyinterp.set_num_threads(3)
+    try:
+        assert pyinterp.get_num_threads() == 3
+    finally:
+        pyinterp.set_num_threads()
+    assert pyinterp.get_num_threads() == cpus
@@ -0,0 +1,42 @@
+# Copyright (c) 2022 CNES
+#
+# All rights reserved. Use of this source code is governed by a
+# BSD-style license that can be found in the LICENSE file.
+"""
+Thread control
+--------------
+"""
+from typing import Iterator
+import contextlib
+from . import core
+from .core import available_cpus, get_num_threads, set_num_threads
+
+
+@contextlib.contextmanager
+def num_threads(value: int = 0, pin: bool = False) -> Iterator[None]:
+    """Sets, within a ``with`` block, the number of threads used by the
+    functions called with ``num_threads=0``.
+
+    Args:
+        value: The number of threads. If 0, the number of CPUs available to
+            the process, according to its affinity mask and the CPU quota of
+            its control group, is used.
+        pin: If true, the threads of the pool are bound to CPUs, spread over
+            the NUMA nodes. Only supported on Linux.
+
+    Example:
+        >>> with pyinterp.num_threads(4):
+        ...     pyinterp.fill.gauss_seidel(grid)
+    """
+    previous = get_num_threads()
+    pinned = core.threads_pinned()
+    set_num_threads(value, pin)
+    try:
+        yield
+    finally:
+        set_num_threads(previous, pinned)
+
+
+__all__ = [
+    "available_cpus", "get_num_threads", "num_threads", "set_num_threads"
+]